@@ -0,0 +1,66 @@
+# /usr/bin/env python3
+
+import argparse
+import asyncio
+
+import dingosdk
+
+parser = argparse.ArgumentParser(description="argparse")
+parser.add_argument(
+    "--coordinator_addrs",
+    "-addrs",
+    type=str,
+    default="127.0.0.1:22001,127.0.0.1:22002,127.0.0.1:22003",
+    help="coordinator addrs, try to use like 127.0.0.1:22001,127.0.0.1:22002,127.0.0.1:22003",
+)
+parser.add_argument("--concurrency", type=int, default=64, help="in flight requests of one thread")
+args = parser.parse_args()
+
+g_start_key = "wa00000000"
+g_end_key = "wc00000000"
+
+
+def create_region():
+    s, region_creator = g_client.NewRegionCreator()
+    assert s.ok(), f"dingo region creator build fail, {s.ToString()}"
+    region_creator.SetRegionName("pysdk_async_example")
+    region_creator.SetRange(g_start_key, g_end_key)
+    region_creator.SetReplicaNum(3)
+    region_creator.Wait(True)
+    s, region_id = region_creator.Create()
+    assert s.ok(), f"create region fail, {s.ToString()}"
+    return region_id
+
+
+async def put_and_get(rawkv, i: int):
+    key = f"wb{i:08d}"
+    s = await rawkv.AsyncPut(key, f"value{i}")
+    assert s.ok(), f"put fail, {s.ToString()}"
+    s, value = await rawkv.AsyncGet(key)
+    assert s.ok(), f"get fail, {s.ToString()}"
+    assert value == f"value{i}", f"unexpected value {value}"
+
+
+async def main(rawkv):
+    # all requests are in flight at once on one python thread
+    await asyncio.gather(*(put_and_get(rawkv, i) for i in range(args.concurrency)))
+
+    keys = [f"wb{i:08d}" for i in range(args.concurrency)]
+    s, kvs = await rawkv.AsyncBatchGet(keys)
+    assert s.ok(), f"batch get fail, {s.ToString()}"
+    print(f"async batch get {len(kvs)} kvs")
+
+
+if __name__ == "__main__":
+    s, g_client = dingosdk.Client.BuildFromAddrs(args.coordinator_addrs)
+    assert s.ok(), f"client build fail, {s.ToString()}"
+
+    region_id = create_region()
+
+    s, g_rawkv = g_client.NewRawKV()
+    assert s.ok(), f"dingo raw_kv build fail, {s.ToString()}"
+
+    asyncio.run(main(g_rawkv))
+
+    s = g_client.DropRegion(region_id)
+    assert s.ok(), f"drop region fail, {s.ToString()}"
@@ -3,6 +3,8 @@
 from os.path import dirname, abspath
 import argparse
 
+import numpy as np
+
 import dingosdk 
 
 parser = argparse.ArgumentParser(description="argparse")
@@ -332,6 +334,29 @@ def raw_kv_example():
         for kv in scan_values:
             print(f"raw_kv scan key: {kv.key}, value: {kv.value}")
 
+    result = raw_kv.BatchDelete(keys)
+    print(f"raw_kv batch_delete after scan: {result.ToString()}")
+
+    # packed batch put/batch get/scan, concatenated bytes and n + 1 offsets instead of one object per kv
+    key_data = "".join(keys).encode()
+    key_offsets = np.cumsum([0] + [len(key) for key in keys], dtype=np.int64)
+    value_data = "".join(values).encode()
+    value_offsets = np.cumsum([0] + [len(value) for value in values], dtype=np.int64)
+
+    result = raw_kv.BatchPutPacked(key_data, key_offsets, value_data, value_offsets)
+    print(f"raw_kv batch_put_packed: {result.ToString()}")
+
+    result, out_keys, out_key_offsets, out_values, out_value_offsets = raw_kv.BatchGetPacked(key_data, key_offsets)
+    print(f"raw_kv batch_get_packed: {result.ToString()}, count: {len(out_key_offsets) - 1}")
+    if result.ok():
+        for i in range(len(out_key_offsets) - 1):
+            key = out_keys[out_key_offsets[i] : out_key_offsets[i + 1]].tobytes()
+            value = out_values[out_value_offsets[i] : out_value_offsets[i + 1]].tobytes()
+            print(f"raw_kv batch_get_packed key: {key}, value: {value}")
+
+    result, out_keys, out_key_offsets, out_values, out_value_offsets = raw_kv.ScanPacked("wa00000000", "wz00000000", 0)
+    print(f"raw_kv scan_packed: {result.ToString()}, count: {len(out_key_offsets) - 1}")
+
 
 if __name__ == "__main__":
     create_region("skd_example01", "wa00000000", "wc00000000", 3)
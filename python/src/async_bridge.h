@@ -0,0 +1,71 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_PYTHON_SDK_ASYNC_BRIDGE_H_
+#define DINGODB_PYTHON_SDK_ASYNC_BRIDGE_H_
+
+#include <pybind11/pybind11.h>
+
+#include <utility>
+
+// asyncio future of the running loop, completed by a sdk StatusCallback.
+// sdk invokes callbacks on its own threads, so the result is handed to the loop by call_soon_threadsafe.
+// Must be created with gil held inside a coroutine, and Complete must be called exactly once.
+class AsyncFuture {
+ public:
+  // owner is kept alive until Complete, e.g. the python RawKV whose async method is running
+  explicit AsyncFuture(pybind11::object owner)
+      : owner_(std::move(owner)),
+        loop_(pybind11::module_::import("asyncio").attr("get_running_loop")()),
+        future_(loop_.attr("create_future")()) {}
+
+  AsyncFuture(const AsyncFuture&) = delete;
+  AsyncFuture& operator=(const AsyncFuture&) = delete;
+
+  ~AsyncFuture() = default;
+
+  pybind11::object Future() const { return future_; }
+
+  // called without gil from any thread, to_python builds the result under gil
+  template <typename ToPython>
+  void Complete(ToPython&& to_python) {
+    pybind11::gil_scoped_acquire acquire;
+    try {
+      pybind11::object result = to_python();
+      loop_.attr("call_soon_threadsafe")(pybind11::cpp_function(&SetResult), future_, result);
+    } catch (pybind11::error_already_set& e) {
+      // loop is closed, nobody waits the result
+      e.discard_as_unraisable("AsyncFuture::Complete");
+    }
+
+    // drop python references under gil, this may be freed later on a sdk thread
+    future_ = pybind11::object();
+    loop_ = pybind11::object();
+    owner_ = pybind11::object();
+  }
+
+ private:
+  // runs in loop thread
+  static void SetResult(pybind11::object future, pybind11::object result) {
+    if (!future.attr("done")().cast<bool>()) {
+      future.attr("set_result")(std::move(result));
+    }
+  }
+
+  pybind11::object owner_;
+  pybind11::object loop_;
+  pybind11::object future_;
+};
+
+#endif  // DINGODB_PYTHON_SDK_ASYNC_BRIDGE_H_
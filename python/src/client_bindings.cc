@@ -15,17 +15,110 @@
 #include "client_bindings.h"
 
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <tuple>
+#include <vector>
 
+#include "async_bridge.h"
 #include "sdk/client.h"
 
+namespace py = pybind11;
+
+using OffsetNdarray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+// n binary values as concatenated data and n + 1 offsets into it, the layout of arrow (large) binary arrays, e.g.
+// pa.Array.from_buffers(pa.large_binary(), n, [None, offsets, data]), int32 offsets of pa.binary() are cast
+struct PackedBinary {
+  // pins data of a bytes, bytearray, ndarray or arrow buffer while it is read without gil
+  py::buffer_info info;
+  const char* data{nullptr};
+  const int64_t* offsets{nullptr};
+  int64_t num{0};
+
+  std::string Get(int64_t i) const { return std::string(data + offsets[i], offsets[i + 1] - offsets[i]); }
+};
+
+static PackedBinary ToPackedBinary(const py::buffer& data, const OffsetNdarray& offsets, const char* name) {
+  PackedBinary packed;
+  packed.info = data.request();
+  if (packed.info.ndim > 1 || (packed.info.ndim == 1 && packed.info.strides[0] != packed.info.itemsize)) {
+    throw py::value_error(std::string(name) + " data must be a contiguous buffer");
+  }
+  if (offsets.ndim() != 1 || offsets.shape(0) < 1) {
+    throw py::value_error(std::string(name) + " offsets must be a 1-dim int64 array of n + 1 offsets");
+  }
+
+  int64_t size = packed.info.size * packed.info.itemsize;
+  packed.data = static_cast<const char*>(packed.info.ptr);
+  packed.offsets = offsets.data();
+  packed.num = offsets.shape(0) - 1;
+  if (packed.offsets[0] < 0 || packed.offsets[packed.num] > size) {
+    throw py::value_error(std::string(name) + " offsets are out of data");
+  }
+  for (int64_t i = 0; i < packed.num; ++i) {
+    if (packed.offsets[i] > packed.offsets[i + 1]) {
+      throw py::value_error(std::string(name) + " offsets must not decrease");
+    }
+  }
+
+  return packed;
+}
+
+// kvs packed in the layout of PackedBinary, built without gil
+struct PackedKVs {
+  std::vector<uint8_t> keys;
+  std::vector<int64_t> key_offsets;
+  std::vector<uint8_t> values;
+  std::vector<int64_t> value_offsets;
+};
+
+static PackedKVs ToPackedKVs(const std::vector<dingodb::sdk::KVPair>& kvs) {
+  PackedKVs packed;
+  size_t key_size = 0;
+  size_t value_size = 0;
+  for (const auto& kv : kvs) {
+    key_size += kv.key.size();
+    value_size += kv.value.size();
+  }
+
+  packed.keys.reserve(key_size);
+  packed.values.reserve(value_size);
+  packed.key_offsets.reserve(kvs.size() + 1);
+  packed.value_offsets.reserve(kvs.size() + 1);
+  packed.key_offsets.push_back(0);
+  packed.value_offsets.push_back(0);
+  for (const auto& kv : kvs) {
+    packed.keys.insert(packed.keys.end(), kv.key.begin(), kv.key.end());
+    packed.values.insert(packed.values.end(), kv.value.begin(), kv.value.end());
+    packed.key_offsets.push_back(static_cast<int64_t>(packed.keys.size()));
+    packed.value_offsets.push_back(static_cast<int64_t>(packed.values.size()));
+  }
+
+  return packed;
+}
+
+// ndarray owns the buffer through a capsule, no copy
+template <typename T>
+static py::array_t<T> ToNdarray(std::vector<T>&& values) {
+  auto* buffer = new std::vector<T>(std::move(values));
+  py::capsule owner(buffer, [](void* ptr) { delete static_cast<std::vector<T>*>(ptr); });
+  return py::array_t<T>(static_cast<py::ssize_t>(buffer->size()), buffer->data(), owner);
+}
+
+// (status, keys uint8, key offsets int64, values uint8, value offsets int64)
+static py::tuple ToNdarray(const dingodb::sdk::Status& status, PackedKVs&& packed) {
+  return py::make_tuple(status, ToNdarray(std::move(packed.keys)), ToNdarray(std::move(packed.key_offsets)),
+                        ToNdarray(std::move(packed.values)), ToNdarray(std::move(packed.value_offsets)));
+}
+
 void DefineClientBindings(pybind11::module& m) {
   using namespace dingodb;
   using namespace dingodb::sdk;
-  namespace py = pybind11;
 
   py::class_<Client>(m, "Client")
       .def_static("BuildAndInitLog",
@@ -33,31 +126,49 @@ void DefineClientBindings(pybind11::module& m) {
                     Client* ptr;
                     Status status = Client::BuildAndInitLog(addrs, &ptr);
                     return std::make_tuple(status, ptr);
-                  })
+                  }, py::call_guard<py::gil_scoped_release>())
       .def_static("BuildFromAddrs",
                   [](std::string addrs) {
                     Client* ptr;
                     Status status = Client::BuildFromAddrs(addrs, &ptr);
                     return std::make_tuple(status, ptr);
-                  })
+                  }, py::call_guard<py::gil_scoped_release>())
       .def_static("Build",
                   [](std::string naming_service_url) {
                     Client* ptr;
                     Status status = Client::Build(naming_service_url, &ptr);
                     return std::make_tuple(status, ptr);
-                  })
+                  }, py::call_guard<py::gil_scoped_release>())
       .def("NewRawKV",
            [](Client& client) {
              RawKV* ptr;
              Status status = client.NewRawKV(&ptr);
              return std::make_tuple(status, ptr);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("NewTransaction",
            [](Client& client, const TransactionOptions& options) {
              Transaction* ptr;
              Status status = client.NewTransaction(options, &ptr);
              return std::make_tuple(status, ptr);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("NewSnapshot",
+           [](Client& client) {
+             Snapshot* ptr;
+             Status status = client.NewSnapshot(&ptr);
+             return std::make_tuple(status, ptr);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("NewSnapshotAt",
+           [](Client& client, int64_t ts) {
+             Snapshot* ptr;
+             Status status = client.NewSnapshot(ts, &ptr);
+             return std::make_tuple(status, ptr);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("NewStaleSnapshot",
+           [](Client& client, int64_t max_staleness_ms) {
+             Snapshot* ptr;
+             Status status = client.NewStaleSnapshot(max_staleness_ms, &ptr);
+             return std::make_tuple(status, ptr);
+           }, py::call_guard<py::gil_scoped_release>())
       .def("NewRegionCreator",
            [](Client& client) {
              RegionCreator* ptr;
@@ -69,14 +180,14 @@ void DefineClientBindings(pybind11::module& m) {
              bool out_create_in_progress;
              Status status = client.IsCreateRegionInProgress(region_id, out_create_in_progress);
              return std::make_tuple(status, out_create_in_progress);
-           })
-      .def("DropRegion", &Client::DropRegion)
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("DropRegion", &Client::DropRegion, py::call_guard<py::gil_scoped_release>())
       .def("NewVectorClient",
            [](Client& client) {
              VectorClient* ptr;
              Status status = client.NewVectorClient(&ptr);
              return std::make_tuple(status, ptr);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("NewVectorIndexCreator",
            [](Client& client) {
              VectorIndexCreator* ptr;
@@ -88,9 +199,9 @@ void DefineClientBindings(pybind11::module& m) {
              int64_t out_index_id;
              Status status = client.GetVectorIndexId(schema_id, index_name, out_index_id);
              return std::make_tuple(status, out_index_id);
-           })
-      .def("DropVectorIndexById", &Client::DropVectorIndexById)
-      .def("DropVectorIndexByName", &Client::DropVectorIndexByName);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("DropVectorIndexById", &Client::DropVectorIndexById, py::call_guard<py::gil_scoped_release>())
+      .def("DropVectorIndexByName", &Client::DropVectorIndexByName, py::call_guard<py::gil_scoped_release>());
 
   py::class_<KVPair>(m, "KVPair")
       .def(py::init<>())
@@ -108,57 +219,223 @@ void DefineClientBindings(pybind11::module& m) {
              std::string out_value;
              Status status = rawkv.Get(key, out_value);
              return std::make_tuple(status, out_value);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("BatchGet",
            [](RawKV& rawkv, const std::vector<std::string>& keys) {
              std::vector<KVPair> out_kvs;
              Status status = rawkv.BatchGet(keys, out_kvs);
              return std::make_tuple(status, out_kvs);
-           })
-      .def("Put", &RawKV::Put)
-      .def("BatchPut", &RawKV::BatchPut)
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("Put", &RawKV::Put, py::call_guard<py::gil_scoped_release>())
+      .def("BatchPut", py::overload_cast<const std::vector<KVPair>&>(&RawKV::BatchPut),
+           py::call_guard<py::gil_scoped_release>())
       .def("PutIfAbsent",
            [](RawKV& rawkv, const std::string& key, const std::string& value) {
              bool out_state;
              Status status = rawkv.PutIfAbsent(key, value, out_state);
              return std::make_tuple(status, out_state);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("BatchPutIfAbsent",
            [](RawKV& rawkv, const std::vector<KVPair>& kvs) {
              std::vector<KeyOpState> out_states;
              Status status = rawkv.BatchPutIfAbsent(kvs, out_states);
              return std::make_tuple(status, out_states);
-           })
-      .def("Delete", &RawKV::Delete)
-      .def("BatchDelete", &RawKV::BatchDelete)
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("Delete", &RawKV::Delete, py::call_guard<py::gil_scoped_release>())
+      .def("BatchDelete", &RawKV::BatchDelete, py::call_guard<py::gil_scoped_release>())
       .def("DeleteRangeNonContinuous",
            [](RawKV& rawkv, const std::string& start_key, const std::string& end_key) {
              int64_t out_delete_count;
              Status status = rawkv.DeleteRangeNonContinuous(start_key, end_key, out_delete_count);
              return std::make_tuple(status, out_delete_count);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("DeleteRange",
            [](RawKV& rawkv, const std::string& start_key, const std::string& end_key) {
              int64_t out_delete_count;
              Status status = rawkv.DeleteRange(start_key, end_key, out_delete_count);
              return std::make_tuple(status, out_delete_count);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("CompareAndSet",
            [](RawKV& rawkv, const std::string& key, const std::string& value, const std::string& expected_value) {
              bool out_state;
              Status status = rawkv.CompareAndSet(key, value, expected_value, out_state);
              return std::make_tuple(status, out_state);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("BatchCompareAndSet",
            [](RawKV& rawkv, const std::vector<KVPair>& kvs, const std::vector<std::string>& expected_values) {
              std::vector<KeyOpState> out_states;
              Status status = rawkv.BatchCompareAndSet(kvs, expected_values, out_states);
              return std::make_tuple(status, out_states);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("Scan",
+           [](RawKV& rawkv, const std::string& start_key, const std::string& end_key, uint64_t limit) {
+             std::vector<KVPair> out_kvs;
+             Status status = rawkv.Scan(start_key, end_key, limit, out_kvs);
+             return std::make_tuple(status, out_kvs);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("CountRange",
+           [](RawKV& rawkv, const std::string& start_key, const std::string& end_key) {
+             int64_t out_count = 0;
+             Status status = rawkv.CountRange(start_key, end_key, out_count);
+             return std::make_tuple(status, out_count);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("ReverseScan",
+           [](RawKV& rawkv, const std::string& start_key, const std::string& end_key, uint64_t limit) {
+             std::vector<KVPair> out_kvs;
+             Status status = rawkv.ReverseScan(start_key, end_key, limit, out_kvs);
+             return std::make_tuple(status, out_kvs);
+           }, py::call_guard<py::gil_scoped_release>())
+      // packed api, keys and values in the layout of PackedBinary instead of one python object per row, e.g. for etl
+      .def("BatchPutPacked",
+           [](RawKV& rawkv, const py::buffer& keys, const OffsetNdarray& key_offsets, const py::buffer& values,
+              const OffsetNdarray& value_offsets) {
+             auto packed_keys = ToPackedBinary(keys, key_offsets, "keys");
+             auto packed_values = ToPackedBinary(values, value_offsets, "values");
+             if (packed_keys.num != packed_values.num) {
+               throw py::value_error("keys and values must have the same number");
+             }
+
+             py::gil_scoped_release release;
+             std::vector<KVPair> kvs;
+             kvs.reserve(packed_keys.num);
+             for (int64_t i = 0; i < packed_keys.num; ++i) {
+               kvs.push_back({packed_keys.Get(i), packed_values.Get(i)});
+             }
+             return rawkv.BatchPut(kvs);
+           })
+      .def("BatchGetPacked",
+           [](RawKV& rawkv, const py::buffer& keys, const OffsetNdarray& key_offsets) {
+             auto packed_keys = ToPackedBinary(keys, key_offsets, "keys");
+
+             PackedKVs packed;
+             Status status;
+             {
+               py::gil_scoped_release release;
+               std::vector<std::string> str_keys;
+               str_keys.reserve(packed_keys.num);
+               for (int64_t i = 0; i < packed_keys.num; ++i) {
+                 str_keys.push_back(packed_keys.Get(i));
+               }
+               // missing keys are left out, so found keys are returned with their values
+               std::vector<KVPair> out_kvs;
+               status = rawkv.BatchGet(str_keys, out_kvs);
+               packed = ToPackedKVs(out_kvs);
+             }
+             return ToNdarray(status, std::move(packed));
+           })
+      .def("ScanPacked",
+           [](RawKV& rawkv, const std::string& start_key, const std::string& end_key, uint64_t limit) {
+             PackedKVs packed;
+             Status status;
+             {
+               py::gil_scoped_release release;
+               std::vector<KVPair> out_kvs;
+               status = rawkv.Scan(start_key, end_key, limit, out_kvs);
+               packed = ToPackedKVs(out_kvs);
+             }
+             return ToNdarray(status, std::move(packed));
            })
-      .def("Scan", [](RawKV& rawkv, const std::string& start_key, const std::string& end_key, uint64_t limit) {
-        std::vector<KVPair> out_kvs;
-        Status status = rawkv.Scan(start_key, end_key, limit, out_kvs);
-        return std::make_tuple(status, out_kvs);
+      // asyncio api, return a future of the running loop, e.g. s, value = await rawkv.AsyncGet(key)
+      .def("AsyncGet",
+           [](RawKV& rawkv, const std::string& key) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               std::string key;
+               std::string out_value;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&rawkv, py::return_value_policy::reference));
+             ctx->key = key;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               rawkv.AsyncGet(ctx->key, ctx->out_value, [ctx](Status status) {
+                 ctx->future.Complete([&]() { return py::cast(std::make_tuple(status, ctx->out_value)); });
+               });
+             }
+             return future;
+           })
+      .def("AsyncBatchGet",
+           [](RawKV& rawkv, const std::vector<std::string>& keys) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               std::vector<std::string> keys;
+               std::vector<KVPair> out_kvs;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&rawkv, py::return_value_policy::reference));
+             ctx->keys = keys;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               rawkv.AsyncBatchGet(ctx->keys, ctx->out_kvs, [ctx](Status status) {
+                 ctx->future.Complete([&]() { return py::cast(std::make_tuple(status, ctx->out_kvs)); });
+               });
+             }
+             return future;
+           })
+      .def("AsyncPut",
+           [](RawKV& rawkv, const std::string& key, const std::string& value) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               std::string key;
+               std::string value;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&rawkv, py::return_value_policy::reference));
+             ctx->key = key;
+             ctx->value = value;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               rawkv.AsyncPut(ctx->key, ctx->value, [ctx](Status status) {
+                 ctx->future.Complete([&]() { return py::cast(status); });
+               });
+             }
+             return future;
+           })
+      .def("AsyncBatchPut",
+           [](RawKV& rawkv, const std::vector<KVPair>& kvs) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               std::vector<KVPair> kvs;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&rawkv, py::return_value_policy::reference));
+             ctx->kvs = kvs;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               rawkv.AsyncBatchPut(ctx->kvs, [ctx](Status status) {
+                 ctx->future.Complete([&]() { return py::cast(status); });
+               });
+             }
+             return future;
+           })
+      .def("AsyncScan", [](RawKV& rawkv, const std::string& start_key, const std::string& end_key, uint64_t limit) {
+        struct Context {
+          explicit Context(py::object owner) : future(std::move(owner)) {}
+          AsyncFuture future;
+          std::string start_key;
+          std::string end_key;
+          std::vector<KVPair> out_kvs;
+        };
+        auto ctx = std::make_shared<Context>(py::cast(&rawkv, py::return_value_policy::reference));
+        ctx->start_key = start_key;
+        ctx->end_key = end_key;
+        py::object future = ctx->future.Future();
+
+        {
+          py::gil_scoped_release release;
+          rawkv.AsyncScan(ctx->start_key, ctx->end_key, limit, ctx->out_kvs, [ctx](Status status) {
+            ctx->future.Complete([&]() { return py::cast(std::make_tuple(status, ctx->out_kvs)); });
+          });
+        }
+        return future;
       });
 
   py::enum_<TransactionKind>(m, "TransactionKind")
@@ -173,7 +450,8 @@ void DefineClientBindings(pybind11::module& m) {
       .def(py::init<>())
       .def_readwrite("kind", &TransactionOptions::kind)
       .def_readwrite("isolation", &TransactionOptions::isolation)
-      .def_readwrite("keep_alive_ms", &TransactionOptions::keep_alive_ms);
+      .def_readwrite("keep_alive_ms", &TransactionOptions::keep_alive_ms)
+      .def_readwrite("pipelined", &TransactionOptions::pipelined);
 
   py::class_<Transaction>(m, "Transaction")
       .def("Get",
@@ -181,28 +459,62 @@ void DefineClientBindings(pybind11::module& m) {
              std::string value;
              Status status = transaction.Get(key, value);
              return std::make_tuple(status, value);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("BatchGet",
            [](Transaction& transaction, const std::vector<std::string>& keys) {
              std::vector<KVPair> kvs;
              Status status = transaction.BatchGet(keys, kvs);
              return std::make_tuple(status, kvs);
-           })
-      .def("Put", &Transaction::Put)
-      .def("BatchPut", &Transaction::BatchPut)
-      .def("PutIfAbsent", &Transaction::PutIfAbsent)
-      .def("BatchPutIfAbsent", &Transaction::BatchPutIfAbsent)
-      .def("Delete", &Transaction::Delete)
-      .def("BatchDelete", &Transaction::BatchDelete)
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("BatchGetForUpdate",
+           [](Transaction& transaction, const std::vector<std::string>& keys) {
+             std::vector<KVPair> kvs;
+             Status status = transaction.BatchGetForUpdate(keys, kvs);
+             return std::make_tuple(status, kvs);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("Put", &Transaction::Put, py::call_guard<py::gil_scoped_release>())
+      .def("BatchPut", py::overload_cast<const std::vector<KVPair>&>(&Transaction::BatchPut),
+           py::call_guard<py::gil_scoped_release>())
+      .def("PutIfAbsent", &Transaction::PutIfAbsent, py::call_guard<py::gil_scoped_release>())
+      .def("BatchPutIfAbsent", &Transaction::BatchPutIfAbsent, py::call_guard<py::gil_scoped_release>())
+      .def("Delete", &Transaction::Delete, py::call_guard<py::gil_scoped_release>())
+      .def("BatchDelete", &Transaction::BatchDelete, py::call_guard<py::gil_scoped_release>())
       .def("Scan",
            [](Transaction& transaction, const std::string& start_key, const std::string& end_key, uint64_t limit) {
              std::vector<KVPair> kvs;
              Status status = transaction.Scan(start_key, end_key, limit, kvs);
              return std::make_tuple(status, kvs);
-           })
-      .def("PreCommit", &Transaction::PreCommit)
-      .def("Commit", &Transaction::Commit)
-      .def("Rollback", &Transaction::Rollback);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("ReverseScan",
+           [](Transaction& transaction, const std::string& start_key, const std::string& end_key, uint64_t limit) {
+             std::vector<KVPair> kvs;
+             Status status = transaction.ReverseScan(start_key, end_key, limit, kvs);
+             return std::make_tuple(status, kvs);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("PreCommit", &Transaction::PreCommit, py::call_guard<py::gil_scoped_release>())
+      .def("Commit", &Transaction::Commit, py::call_guard<py::gil_scoped_release>())
+      .def("Rollback", &Transaction::Rollback, py::call_guard<py::gil_scoped_release>());
+
+  py::class_<Snapshot>(m, "Snapshot")
+      .def("GetTimestamp", &Snapshot::GetTimestamp)
+      .def("Get",
+           [](Snapshot& snapshot, const std::string& key) {
+             std::string value;
+             Status status = snapshot.Get(key, value);
+             return std::make_tuple(status, value);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("BatchGet",
+           [](Snapshot& snapshot, const std::vector<std::string>& keys) {
+             std::vector<KVPair> kvs;
+             Status status = snapshot.BatchGet(keys, kvs);
+             return std::make_tuple(status, kvs);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("Scan",
+           [](Snapshot& snapshot, const std::string& start_key, const std::string& end_key, uint64_t limit) {
+             std::vector<KVPair> kvs;
+             Status status = snapshot.Scan(start_key, end_key, limit, kvs);
+             return std::make_tuple(status, kvs);
+           }, py::call_guard<py::gil_scoped_release>());
 
   py::enum_<EngineType>(m, "EngineType")
       .value("kLSM", EngineType::kLSM)
@@ -219,5 +531,5 @@ void DefineClientBindings(pybind11::module& m) {
         int64_t out_region_id;
         Status status = regioncreator.Create(out_region_id);
         return std::make_tuple(status, out_region_id);
-      });
+      }, py::call_guard<py::gil_scoped_release>());
 }
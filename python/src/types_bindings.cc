@@ -19,9 +19,14 @@
 #include <pybind11/stl.h>
 
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <tuple>
+#include <vector>
 
+#include "sdk/filter.h"
 #include "sdk/types.h"
+#include "sdk/vector.h"
 
 void DefineTypesBindings(pybind11::module& m) {
   using namespace dingodb;
@@ -37,4 +42,50 @@ void DefineTypesBindings(pybind11::module& m) {
 
   m.def("TypeToString", &TypeToString, "description: TypeToString");
 
+  // python holder is not const, filter is still never mutated after built
+  using FilterPtr = std::shared_ptr<Filter>;
+  auto to_py = [](std::shared_ptr<const Filter> filter) { return std::const_pointer_cast<Filter>(filter); };
+  auto to_args = [](const std::vector<FilterPtr>& args) {
+    return std::vector<std::shared_ptr<const Filter>>(args.begin(), args.end());
+  };
+
+  py::class_<Filter, FilterPtr> filter(m, "Filter");
+
+  py::enum_<Filter::Comparator>(filter, "Comparator")
+      .value("kEq", Filter::kEq)
+      .value("kNe", Filter::kNe)
+      .value("kGte", Filter::kGte)
+      .value("kGt", Filter::kGt)
+      .value("kLte", Filter::kLte)
+      .value("kLt", Filter::kLt)
+      .export_values();
+
+  // bool first, python bool is also int
+  filter
+      .def_static("Compare",
+                  [to_py](Filter::Comparator comparator, const std::string& attribute, bool value) {
+                    return to_py(Filter::Compare(comparator, attribute, value));
+                  })
+      .def_static("Compare",
+                  [to_py](Filter::Comparator comparator, const std::string& attribute, int64_t value) {
+                    return to_py(Filter::Compare(comparator, attribute, value));
+                  })
+      .def_static("Compare",
+                  [to_py](Filter::Comparator comparator, const std::string& attribute, double value) {
+                    return to_py(Filter::Compare(comparator, attribute, value));
+                  })
+      .def_static("Compare",
+                  [to_py](Filter::Comparator comparator, const std::string& attribute, const std::string& value) {
+                    return to_py(Filter::Compare(comparator, attribute, value));
+                  })
+      .def_static("And",
+                  [to_py, to_args](const std::vector<FilterPtr>& args) { return to_py(Filter::And(to_args(args))); })
+      .def_static("Or",
+                  [to_py, to_args](const std::vector<FilterPtr>& args) { return to_py(Filter::Or(to_args(args))); })
+      .def_static("Not", [to_py](const FilterPtr& arg) { return to_py(Filter::Not(arg)); })
+      .def("Match", py::overload_cast<const VectorWithId&>(&Filter::Match, py::const_))
+      .def("ToString", &Filter::ToString);
+
+  m.def("ComparatorToString", &ComparatorToString, "description: ComparatorToString");
+
 }
\ No newline at end of file
@@ -16,17 +16,243 @@
 #include "vector_bindings.h"
 
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
+#include "async_bridge.h"
 #include "sdk/vector.h"
 
+namespace py = pybind11;
+
+using FloatNdarray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using IdNdarray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+static void CheckVectorNdarray(const FloatNdarray& data) {
+  if (data.ndim() != 2) {
+    throw py::value_error("vectors must be a 2-dim float32 ndarray of shape (n, dimension)");
+  }
+}
+
+static void CheckIdNdarray(const std::optional<IdNdarray>& ids, const FloatNdarray& data) {
+  if (ids.has_value() && (ids->ndim() != 1 || ids->shape(0) != data.shape(0))) {
+    throw py::value_error("ids must be a 1-dim int64 ndarray of shape (n,)");
+  }
+}
+
+// rows of data to vectors, touches no python object so it is called without gil
+static std::vector<dingodb::sdk::VectorWithId> ToVectors(const float* data, int64_t rows, int64_t dimension,
+                                                         const int64_t* ids) {
+  std::vector<dingodb::sdk::VectorWithId> vectors;
+  vectors.reserve(rows);
+  for (int64_t i = 0; i < rows; ++i) {
+    dingodb::sdk::Vector vector(dingodb::sdk::ValueType::kFloat, static_cast<int32_t>(dimension));
+    vector.float_values.assign(data + i * dimension, data + (i + 1) * dimension);
+    vectors.emplace_back(ids == nullptr ? 0 : ids[i], std::move(vector));
+  }
+  return vectors;
+}
+
+// search results flattened to contiguous buffers, built without gil
+struct SearchArrays {
+  int64_t query_num{0};
+  // most neighbors of all queries
+  int64_t k{0};
+  // 0 when no vector data is returned
+  int64_t dimension{0};
+  // (n, k), missing neighbors are -1 and max float
+  std::vector<int64_t> ids;
+  std::vector<float> distances;
+  // (n, k, dimension), missing ones are 0
+  std::vector<float> vectors;
+};
+
+static SearchArrays ToSearchArrays(const std::vector<dingodb::sdk::SearchResult>& results, int64_t query_num) {
+  SearchArrays arrays;
+  arrays.query_num = query_num;
+  for (const auto& result : results) {
+    arrays.k = std::max(arrays.k, static_cast<int64_t>(result.vector_datas.size()));
+    for (const auto& vector_with_distance : result.vector_datas) {
+      arrays.dimension =
+          std::max(arrays.dimension, static_cast<int64_t>(vector_with_distance.vector_data.vector.float_values.size()));
+    }
+  }
+
+  int64_t size = query_num * arrays.k;
+  arrays.ids.assign(size, -1);
+  arrays.distances.assign(size, std::numeric_limits<float>::max());
+  arrays.vectors.assign(size * arrays.dimension, 0.0f);
+  for (int64_t i = 0; i < std::min(query_num, static_cast<int64_t>(results.size())); ++i) {
+    const auto& vector_datas = results[i].vector_datas;
+    for (size_t j = 0; j < vector_datas.size(); ++j) {
+      int64_t offset = i * arrays.k + static_cast<int64_t>(j);
+      arrays.ids[offset] = vector_datas[j].vector_data.id;
+      arrays.distances[offset] = vector_datas[j].distance;
+      const auto& values = vector_datas[j].vector_data.vector.float_values;
+      std::copy(values.begin(), values.end(), arrays.vectors.begin() + offset * arrays.dimension);
+    }
+  }
+
+  return arrays;
+}
+
+// ndarray owns the buffer through a capsule, no copy
+template <typename T>
+static py::array_t<T> ToNdarray(std::vector<T>&& values, std::vector<py::ssize_t> shape) {
+  auto* buffer = new std::vector<T>(std::move(values));
+  py::capsule owner(buffer, [](void* ptr) { delete static_cast<std::vector<T>*>(ptr); });
+  return py::array_t<T>(std::move(shape), buffer->data(), owner);
+}
+
+// (status, ids (n, k), distances (n, k), vectors (n, k, dimension) or None)
+static py::tuple ToNdarray(const dingodb::sdk::Status& status, SearchArrays&& arrays) {
+  py::object vectors = py::none();
+  if (arrays.dimension > 0) {
+    vectors = ToNdarray(std::move(arrays.vectors), {arrays.query_num, arrays.k, arrays.dimension});
+  }
+
+  return py::make_tuple(status, ToNdarray(std::move(arrays.ids), {arrays.query_num, arrays.k}),
+                        ToNdarray(std::move(arrays.distances), {arrays.query_num, arrays.k}), vectors);
+}
+
+// vectors are added to VectorWriter in batches of it, progress is reported between batches
+static const int64_t kIngestBatchRows = 4096;
+
+enum class ArrowKind { kBool, kInt32, kInt64, kFloat, kDouble, kString, kLargeString };
+
+// one column of a pyarrow table, its buffers are pinned and read in place without gil
+struct ArrowColumn {
+  std::string name;
+  ArrowKind kind{ArrowKind::kInt64};
+  dingodb::sdk::Type type{dingodb::sdk::Type::kINT64};
+  // offset of the array into its buffers
+  int64_t offset{0};
+  // bitmap, nullptr when there is no null
+  const uint8_t* validity{nullptr};
+  // fixed width values or offsets of string and binary
+  const uint8_t* values{nullptr};
+  // string and binary data
+  const uint8_t* data{nullptr};
+  std::vector<py::buffer_info> pins;
+};
+
+static bool BitAt(const uint8_t* bitmap, int64_t index) { return ((bitmap[index >> 3] >> (index & 7)) & 1) != 0; }
+
+static void ToArrowKind(const std::string& arrow_type, ArrowColumn& column) {
+  using dingodb::sdk::Type;
+  static const std::map<std::string, std::pair<ArrowKind, Type>> kKinds = {
+      {"bool", {ArrowKind::kBool, Type::kBOOL}},
+      {"int32", {ArrowKind::kInt32, Type::kINT64}},
+      {"int64", {ArrowKind::kInt64, Type::kINT64}},
+      {"float", {ArrowKind::kFloat, Type::kDOUBLE}},
+      {"double", {ArrowKind::kDouble, Type::kDOUBLE}},
+      {"string", {ArrowKind::kString, Type::kSTRING}},
+      {"large_string", {ArrowKind::kLargeString, Type::kSTRING}},
+      {"binary", {ArrowKind::kString, Type::kBYTES}},
+      {"large_binary", {ArrowKind::kLargeString, Type::kBYTES}},
+  };
+
+  auto it = kKinds.find(arrow_type);
+  if (it == kKinds.end()) {
+    throw py::value_error("scalar column " + column.name + " has unsupported type " + arrow_type);
+  }
+  column.kind = it->second.first;
+  column.type = it->second.second;
+}
+
+// columns of a pyarrow table, e.g. pyarrow.parquet.read_table(), with the gil
+static std::vector<ArrowColumn> ToArrowColumns(const py::object& table, int64_t rows) {
+  std::vector<ArrowColumn> columns;
+  if (table.is_none()) {
+    return columns;
+  }
+  if (table.attr("num_rows").cast<int64_t>() != rows) {
+    throw py::value_error("scalars must be a pyarrow table of the same rows as vectors");
+  }
+
+  for (const auto& name : table.attr("column_names")) {
+    ArrowColumn column;
+    column.name = name.cast<std::string>();
+    py::object array = table.attr("column")(name).attr("combine_chunks")();
+    ToArrowKind(py::str(array.attr("type")).cast<std::string>(), column);
+    column.offset = array.attr("offset").cast<int64_t>();
+
+    py::list buffers = array.attr("buffers")();
+    auto pin = [&](size_t i) -> const uint8_t* {
+      if (i >= buffers.size() || buffers[i].is_none()) {
+        return nullptr;
+      }
+      column.pins.push_back(py::reinterpret_borrow<py::buffer>(buffers[i]).request());
+      return static_cast<const uint8_t*>(column.pins.back().ptr);
+    };
+    column.validity = pin(0);
+    column.values = pin(1);
+    column.data = pin(2);
+    columns.push_back(std::move(column));
+  }
+
+  return columns;
+}
+
+// nulls are left out of scalar data
+static void AppendScalars(const std::vector<ArrowColumn>& columns, int64_t row,
+                          std::map<std::string, dingodb::sdk::ScalarValue>& scalar_data) {
+  for (const auto& column : columns) {
+    int64_t index = column.offset + row;
+    if (column.validity != nullptr && !BitAt(column.validity, index)) {
+      continue;
+    }
+
+    dingodb::sdk::ScalarField field{};
+    switch (column.kind) {
+      case ArrowKind::kBool:
+        field.bool_data = BitAt(column.values, index);
+        break;
+      case ArrowKind::kInt32:
+        field.long_data = reinterpret_cast<const int32_t*>(column.values)[index];
+        break;
+      case ArrowKind::kInt64:
+        field.long_data = reinterpret_cast<const int64_t*>(column.values)[index];
+        break;
+      case ArrowKind::kFloat:
+        field.double_data = reinterpret_cast<const float*>(column.values)[index];
+        break;
+      case ArrowKind::kDouble:
+        field.double_data = reinterpret_cast<const double*>(column.values)[index];
+        break;
+      case ArrowKind::kString: {
+        const auto* offsets = reinterpret_cast<const int32_t*>(column.values);
+        field.string_data.assign(reinterpret_cast<const char*>(column.data) + offsets[index],
+                                 offsets[index + 1] - offsets[index]);
+        break;
+      }
+      case ArrowKind::kLargeString: {
+        const auto* offsets = reinterpret_cast<const int64_t*>(column.values);
+        field.string_data.assign(reinterpret_cast<const char*>(column.data) + offsets[index],
+                                 offsets[index + 1] - offsets[index]);
+        break;
+      }
+    }
+
+    auto& value = scalar_data[column.name];
+    value.type = column.type;
+    value.fields.push_back(std::move(field));
+  }
+}
+
 void DefineVectorBindings(pybind11::module& m) {
   using namespace dingodb;
   using namespace dingodb::sdk;
-  namespace py = pybind11;
 
   py::enum_<VectorIndexType>(m, "VectorIndexType")
       .value("kNoneIndexType", VectorIndexType::kNoneIndexType)
@@ -138,6 +364,31 @@ void DefineVectorBindings(pybind11::module& m) {
       .def_readwrite("vector", &VectorWithId::vector)
       .def_readwrite("scalar_data", &VectorWithId::scalar_data);
 
+  py::class_<ScalarQuantizer>(m, "ScalarQuantizer")
+      .def(py::init<>())
+      .def("Train", &ScalarQuantizer::Train)
+      .def("Init", &ScalarQuantizer::Init)
+      .def("IsTrained", &ScalarQuantizer::IsTrained)
+      .def("Dimension", &ScalarQuantizer::Dimension)
+      .def("Mins", &ScalarQuantizer::Mins)
+      .def("Scales", &ScalarQuantizer::Scales)
+      .def("Quantize",
+           [](const ScalarQuantizer& quantizer, const Vector& from) -> std::tuple<Status, Vector> {
+             Vector to;
+             Status status = quantizer.Quantize(from, to);
+             return std::make_tuple(status, to);
+           })
+      .def("QuantizeVectors",
+           [](const ScalarQuantizer& quantizer, std::vector<VectorWithId>& vectors) {
+             Status status = quantizer.Quantize(vectors);
+             return std::make_tuple(status, vectors);
+           })
+      .def("Dequantize", [](const ScalarQuantizer& quantizer, const Vector& from) -> std::tuple<Status, Vector> {
+        Vector to;
+        Status status = quantizer.Dequantize(from, to);
+        return std::make_tuple(status, to);
+      });
+
   py::enum_<FilterSource>(m, "FilterSource")
       .value("kNoneFilterSource", FilterSource::kNoneFilterSource)
       .value("kScalarFilter", FilterSource::kScalarFilter)
@@ -171,7 +422,25 @@ void DefineVectorBindings(pybind11::module& m) {
       .def_readwrite("vector_ids", &SearchParam::vector_ids)
       .def_readwrite("use_brute_force", &SearchParam::use_brute_force)
       .def_readwrite("extra_params", &SearchParam::extra_params)
-      .def_readwrite("langchain_expr_json", &SearchParam::langchain_expr_json);
+      .def_readwrite("langchain_expr_json", &SearchParam::langchain_expr_json)
+      .def_property(
+          "filter", [](const SearchParam& param) { return std::const_pointer_cast<Filter>(param.filter); },
+          [](SearchParam& param, const std::shared_ptr<Filter>& filter) { param.filter = filter; })
+      .def_readwrite("post_filter", &SearchParam::post_filter)
+      .def_readwrite("target_recall", &SearchParam::target_recall);
+
+  py::class_<RecallPoint>(m, "RecallPoint")
+      .def(py::init<>())
+      .def_readwrite("param", &RecallPoint::param)
+      .def_readwrite("recall", &RecallPoint::recall);
+
+  py::class_<RecallProfile>(m, "RecallProfile")
+      .def(py::init<>())
+      .def("PickParam", &RecallProfile::PickParam)
+      .def("ToString", &RecallProfile::ToString)
+      .def_readwrite("param_type", &RecallProfile::param_type)
+      .def_readwrite("topk", &RecallProfile::topk)
+      .def_readwrite("points", &RecallProfile::points);
 
   py::class_<VectorWithDistance>(m, "VectorWithDistance")
       .def(py::init<>())
@@ -250,7 +519,7 @@ void DefineVectorBindings(pybind11::module& m) {
         int64_t out_index_id;
         Status status = vectorindexcreator.Create(out_index_id);
         return std::make_tuple(status, out_index_id);
-      });
+      }, py::call_guard<py::gil_scoped_release>());
 
   py::class_<VectorClient>(m, "VectorClient")
       .def("AddByIndexId", 
@@ -258,20 +527,21 @@ void DefineVectorBindings(pybind11::module& m) {
                       bool is_update = false){
              Status status = vectorclient.AddByIndexId(index_id, vectors, replace_deleted, is_update);
              return std::make_tuple(status, vectors);    
-           }, py::arg(), py::arg(), py::arg()=false, py::arg()=false)
+           }, py::arg(), py::arg(), py::arg()=false, py::arg()=false, py::call_guard<py::gil_scoped_release>())
       .def("AddByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name, std::vector<VectorWithId>& vectors,
                         bool replace_deleted = false, bool is_update = false){
              Status status = vectorclient.AddByIndexName(schema_id, index_name, vectors, replace_deleted, is_update);
              return std::make_tuple(status, vectors); 
-            }, py::arg(), py::arg(), py::arg(), py::arg()=false, py::arg()=false)
+            }, py::arg(), py::arg(), py::arg(), py::arg()=false, py::arg()=false,
+            py::call_guard<py::gil_scoped_release>())
       .def("SearchByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, const SearchParam& search_param,
               const std::vector<VectorWithId>& target_vectors) {
              std::vector<SearchResult> out_result;
              Status status = vectorclient.SearchByIndexId(index_id, search_param, target_vectors, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("SearchByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
               const SearchParam& search_param, const std::vector<VectorWithId>& target_vectors) {
@@ -279,92 +549,379 @@ void DefineVectorBindings(pybind11::module& m) {
              Status status =
                  vectorclient.SearchByIndexName(schema_id, index_name, search_param, target_vectors, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("DeleteByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, const std::vector<int64_t>& vector_ids) {
              std::vector<DeleteResult> out_result;
              Status status = vectorclient.DeleteByIndexId(index_id, vector_ids, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("DeleteByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
               const std::vector<int64_t>& vector_ids) {
              std::vector<DeleteResult> out_result;
              Status status = vectorclient.DeleteByIndexName(schema_id, index_name, vector_ids, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("DeleteByRangeByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, int64_t start_vector_id, int64_t end_vector_id) {
+             int64_t out_delete_count;
+             Status status =
+                 vectorclient.DeleteByRangeByIndexId(index_id, start_vector_id, end_vector_id, out_delete_count);
+             return std::make_tuple(status, out_delete_count);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("DeleteByRangeByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name, int64_t start_vector_id,
+              int64_t end_vector_id) {
+             int64_t out_delete_count;
+             Status status = vectorclient.DeleteByRangeByIndexName(schema_id, index_name, start_vector_id,
+                                                                   end_vector_id, out_delete_count);
+             return std::make_tuple(status, out_delete_count);
+           }, py::call_guard<py::gil_scoped_release>())
       .def("BatchQueryByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, const QueryParam& query_param) {
              QueryResult out_result;
              Status status = vectorclient.BatchQueryByIndexId(index_id, query_param, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("BatchQueryByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
               const QueryParam& query_param) {
              QueryResult out_result;
              Status status = vectorclient.BatchQueryByIndexName(schema_id, index_name, query_param, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("GetBorderByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, bool is_max) {
              int64_t out_vector_id;
              Status status = vectorclient.GetBorderByIndexId(index_id, is_max, out_vector_id);
              return std::make_tuple(status, out_vector_id);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("GetBorderByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name, bool is_max) {
              int64_t out_vector_id;
              Status status = vectorclient.GetBorderByIndexName(schema_id, index_name, is_max, out_vector_id);
              return std::make_tuple(status, out_vector_id);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("ScanQueryByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, const ScanQueryParam& query_param) {
              ScanQueryResult out_result;
              Status status = vectorclient.ScanQueryByIndexId(index_id, query_param, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("ScanQueryByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
               const ScanQueryParam& query_param) {
              ScanQueryResult out_result;
              Status status = vectorclient.ScanQueryByIndexName(schema_id, index_name, query_param, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("GetIndexMetricsByIndexId",
            [](VectorClient& vectorclient, int64_t index_id) {
              IndexMetricsResult out_result;
              Status status = vectorclient.GetIndexMetricsByIndexId(index_id, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("GetIndexMetricsByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name) {
              IndexMetricsResult out_result;
              Status status = vectorclient.GetIndexMetricsByIndexName(schema_id, index_name, out_result);
              return std::make_tuple(status, out_result);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("CountAllByIndexId",
            [](VectorClient& vectorclient, int64_t index_id) {
              int64_t out_count;
              Status status = vectorclient.CountAllByIndexId(index_id, out_count);
              return std::make_tuple(status, out_count);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("CountallByIndexName",
            [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name) {
              int64_t out_count;
              Status status = vectorclient.CountallByIndexName(schema_id, index_name, out_count);
              return std::make_tuple(status, out_count);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("CountByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, int64_t start_vector_id, int64_t end_vector_id) {
              int64_t out_count;
              Status status = vectorclient.CountByIndexId(index_id, start_vector_id, end_vector_id, out_count);
              return std::make_tuple(status, out_count);
-           })
+           }, py::call_guard<py::gil_scoped_release>())
       .def("CountByIndexName", [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
                                   int64_t start_vector_id, int64_t end_vector_id) {
         int64_t out_count;
         Status status = vectorclient.CountByIndexName(schema_id, index_name, start_vector_id, end_vector_id, out_count);
         return std::make_tuple(status, out_count);
-      });
+      }, py::call_guard<py::gil_scoped_release>())
+      .def("CalibrateRecallByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const std::vector<VectorWithId>& queries,
+              const std::vector<std::vector<int64_t>>& ground_truth, int32_t topk, const std::vector<int32_t>& params) {
+             RecallProfile out_profile;
+             Status status =
+                 vectorclient.CalibrateRecallByIndexId(index_id, queries, ground_truth, topk, params, out_profile);
+             return std::make_tuple(status, out_profile);
+           }, py::call_guard<py::gil_scoped_release>())
+      .def("SetRecallProfile", &VectorClient::SetRecallProfile)
+      // ndarray entry points, no python VectorWithId objects are built
+      .def("AddNdarrayByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const FloatNdarray& data,
+              const std::optional<IdNdarray>& ids, bool replace_deleted, bool is_update) {
+             CheckVectorNdarray(data);
+             CheckIdNdarray(ids, data);
+             int64_t rows = data.shape(0);
+             int64_t dimension = data.shape(1);
+             const float* data_ptr = data.data();
+             const int64_t* ids_ptr = ids.has_value() ? ids->data() : nullptr;
+
+             std::vector<VectorWithId> vectors;
+             Status status;
+             {
+               py::gil_scoped_release release;
+               vectors = ToVectors(data_ptr, rows, dimension, ids_ptr);
+               status = vectorclient.AddByIndexId(index_id, vectors, replace_deleted, is_update);
+             }
+
+             // ids are filled by sdk when index is auto increment
+             IdNdarray out_ids(rows);
+             auto out_ids_view = out_ids.mutable_unchecked<1>();
+             for (int64_t i = 0; i < rows; ++i) {
+               out_ids_view(i) = vectors[i].id;
+             }
+             return std::make_tuple(status, std::move(out_ids));
+           }, py::arg(), py::arg(), py::arg()=py::none(), py::arg()=false, py::arg()=false)
+      .def("AddNdarrayByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name, const FloatNdarray& data,
+              const std::optional<IdNdarray>& ids, bool replace_deleted, bool is_update) {
+             CheckVectorNdarray(data);
+             CheckIdNdarray(ids, data);
+             int64_t rows = data.shape(0);
+             int64_t dimension = data.shape(1);
+             const float* data_ptr = data.data();
+             const int64_t* ids_ptr = ids.has_value() ? ids->data() : nullptr;
+
+             std::vector<VectorWithId> vectors;
+             Status status;
+             {
+               py::gil_scoped_release release;
+               vectors = ToVectors(data_ptr, rows, dimension, ids_ptr);
+               status = vectorclient.AddByIndexName(schema_id, index_name, vectors, replace_deleted, is_update);
+             }
+
+             IdNdarray out_ids(rows);
+             auto out_ids_view = out_ids.mutable_unchecked<1>();
+             for (int64_t i = 0; i < rows; ++i) {
+               out_ids_view(i) = vectors[i].id;
+             }
+             return std::make_tuple(status, std::move(out_ids));
+           }, py::arg(), py::arg(), py::arg(), py::arg()=py::none(), py::arg()=false, py::arg()=false)
+      // bulk ingest through VectorWriter, vectors and scalar columns of a pyarrow table are converted and written
+      // without gil, in flight data is bounded by FLAGS_vector_writer_max_inflight_bytes.
+      // progress(done, total) is called every progress_rows vectors added and when all are written.
+      .def("IngestNdarrayByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const FloatNdarray& data,
+              const std::optional<IdNdarray>& ids, const py::object& scalars,
+              const std::optional<py::function>& progress, int64_t progress_rows, bool replace_deleted,
+              bool is_update) {
+             CheckVectorNdarray(data);
+             CheckIdNdarray(ids, data);
+             int64_t rows = data.shape(0);
+             int64_t dimension = data.shape(1);
+             const float* data_ptr = data.data();
+             const int64_t* ids_ptr = ids.has_value() ? ids->data() : nullptr;
+             auto columns = ToArrowColumns(scalars, rows);
+
+             Status status;
+             {
+               py::gil_scoped_release release;
+               VectorWriter* tmp_writer;
+               status = vectorclient.NewVectorWriter(index_id, &tmp_writer, replace_deleted, is_update);
+               if (!status.ok()) {
+                 return status;
+               }
+               std::unique_ptr<VectorWriter> writer(tmp_writer);
+
+               int64_t next_progress = progress_rows;
+               for (int64_t start = 0; start < rows && status.ok(); start += kIngestBatchRows) {
+                 int64_t end = std::min(rows, start + kIngestBatchRows);
+                 auto vectors = ToVectors(data_ptr + start * dimension, end - start, dimension,
+                                          ids_ptr == nullptr ? nullptr : ids_ptr + start);
+                 for (int64_t i = start; i < end; ++i) {
+                   AppendScalars(columns, i, vectors[i - start].scalar_data);
+                 }
+                 status = writer->Add(std::move(vectors));
+
+                 if (progress.has_value() && progress_rows > 0 && end >= next_progress && end < rows) {
+                   next_progress = end + progress_rows;
+                   py::gil_scoped_acquire acquire;
+                   (*progress)(end, rows);
+                 }
+               }
+
+               Status flush_status = writer->Flush();
+               if (status.ok()) {
+                 status = flush_status;
+               }
+             }
+
+             if (progress.has_value() && status.ok()) {
+               (*progress)(rows, rows);
+             }
+             return status;
+           }, py::arg(), py::arg(), py::arg(), py::arg()=py::none(), py::arg()=py::none(), py::arg()=py::none(),
+           py::arg()=100000, py::arg()=false, py::arg()=false)
+      .def("SearchNdarrayByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const SearchParam& search_param,
+              const FloatNdarray& queries) {
+             CheckVectorNdarray(queries);
+             int64_t rows = queries.shape(0);
+             int64_t dimension = queries.shape(1);
+             const float* queries_ptr = queries.data();
+
+             SearchArrays arrays;
+             Status status;
+             {
+               py::gil_scoped_release release;
+               auto target_vectors = ToVectors(queries_ptr, rows, dimension, nullptr);
+               std::vector<SearchResult> out_result;
+               status = vectorclient.SearchByIndexId(index_id, search_param, target_vectors, out_result);
+               arrays = ToSearchArrays(out_result, rows);
+             }
+             return ToNdarray(status, std::move(arrays));
+           })
+      .def("SearchNdarrayByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
+              const SearchParam& search_param, const FloatNdarray& queries) {
+             CheckVectorNdarray(queries);
+             int64_t rows = queries.shape(0);
+             int64_t dimension = queries.shape(1);
+             const float* queries_ptr = queries.data();
+
+             SearchArrays arrays;
+             Status status;
+             {
+               py::gil_scoped_release release;
+               auto target_vectors = ToVectors(queries_ptr, rows, dimension, nullptr);
+               std::vector<SearchResult> out_result;
+               status = vectorclient.SearchByIndexName(schema_id, index_name, search_param, target_vectors, out_result);
+               arrays = ToSearchArrays(out_result, rows);
+             }
+             return ToNdarray(status, std::move(arrays));
+           })
+      // asyncio api, return a future of the running loop, e.g. s, result = await client.AsyncSearchByIndexId(...)
+      .def("AsyncAddByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const std::vector<VectorWithId>& vectors,
+              bool replace_deleted, bool is_update) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               std::vector<VectorWithId> vectors;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&vectorclient, py::return_value_policy::reference));
+             ctx->vectors = vectors;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               vectorclient.AsyncAddByIndexId(index_id, ctx->vectors, replace_deleted, is_update, [ctx](Status status) {
+                 ctx->future.Complete([&]() { return py::cast(std::make_tuple(status, ctx->vectors)); });
+               });
+             }
+             return future;
+           }, py::arg(), py::arg(), py::arg()=false, py::arg()=false)
+      .def("AsyncSearchByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const SearchParam& search_param,
+              const std::vector<VectorWithId>& target_vectors) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               SearchParam search_param;
+               std::vector<VectorWithId> target_vectors;
+               std::vector<SearchResult> out_result;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&vectorclient, py::return_value_policy::reference));
+             ctx->search_param = search_param;
+             ctx->target_vectors = target_vectors;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               vectorclient.AsyncSearchByIndexId(index_id, ctx->search_param, ctx->target_vectors, ctx->out_result,
+                                                 [ctx](Status status) {
+                                                   ctx->future.Complete([&]() {
+                                                     return py::cast(std::make_tuple(status, ctx->out_result));
+                                                   });
+                                                 });
+             }
+             return future;
+           })
+      .def("AsyncSearchNdarrayByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const SearchParam& search_param,
+              const FloatNdarray& queries) {
+             CheckVectorNdarray(queries);
+             int64_t rows = queries.shape(0);
+             int64_t dimension = queries.shape(1);
+             const float* queries_ptr = queries.data();
+
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               SearchParam search_param;
+               std::vector<VectorWithId> target_vectors;
+               std::vector<SearchResult> out_result;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&vectorclient, py::return_value_policy::reference));
+             ctx->search_param = search_param;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               ctx->target_vectors = ToVectors(queries_ptr, rows, dimension, nullptr);
+               vectorclient.AsyncSearchByIndexId(
+                   index_id, ctx->search_param, ctx->target_vectors, ctx->out_result, [ctx, rows](Status status) {
+                     // flatten before taking gil
+                     SearchArrays arrays = ToSearchArrays(ctx->out_result, rows);
+                     ctx->future.Complete([&]() { return ToNdarray(status, std::move(arrays)); });
+                   });
+             }
+             return future;
+           })
+      .def("AsyncDeleteByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const std::vector<int64_t>& vector_ids) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               std::vector<int64_t> vector_ids;
+               std::vector<DeleteResult> out_result;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&vectorclient, py::return_value_policy::reference));
+             ctx->vector_ids = vector_ids;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               vectorclient.AsyncDeleteByIndexId(index_id, ctx->vector_ids, ctx->out_result, [ctx](Status status) {
+                 ctx->future.Complete([&]() { return py::cast(std::make_tuple(status, ctx->out_result)); });
+               });
+             }
+             return future;
+           })
+      .def("AsyncBatchQueryByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const QueryParam& query_param) {
+             struct Context {
+               explicit Context(py::object owner) : future(std::move(owner)) {}
+               AsyncFuture future;
+               QueryParam query_param;
+               QueryResult out_result;
+             };
+             auto ctx = std::make_shared<Context>(py::cast(&vectorclient, py::return_value_policy::reference));
+             ctx->query_param = query_param;
+             py::object future = ctx->future.Future();
+
+             {
+               py::gil_scoped_release release;
+               vectorclient.AsyncBatchQueryByIndexId(index_id, ctx->query_param, ctx->out_result, [ctx](Status status) {
+                 ctx->future.Complete([&]() { return py::cast(std::make_tuple(status, ctx->out_result)); });
+               });
+             }
+             return future;
+           });
 }
\ No newline at end of file
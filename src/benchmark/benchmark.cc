@@ -14,27 +14,41 @@
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <csignal>
+#include <cstdlib>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
 #include "benchmark/color.h"
+#include "benchmark/mock_server.h"
 #include "fmt/core.h"
 #include "gflags/gflags.h"
 #include "proto/common.pb.h"
 #include "sdk/client.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/helper.h"
+#include "sdk/common/param_config.h"
+#include "sdk/common/slow_log.h"
 #include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/region.h"
+#include "sdk/rpc/rpc_client.h"
 #include "sdk/vector.h"
+#include "sdk/vector/vector_index.h"
 #include "util.h"
 
 DEFINE_string(coordinator_addrs, "127.0.0.1:22001,127.0.0.1:22002,127.0.0.1:22003", "coordinator addrs");
@@ -56,6 +70,56 @@ DEFINE_uint32(timelimit, 0, "Time limit in seconds");
 
 DEFINE_uint32(delay, 2, "Interval in seconds between intermediate reports");
 
+DEFINE_string(load_mode, "closed",
+              "closed: every thread sends the next request after the previous one is done, "
+              "open: requests start at target_qps whatever the latency is, latency counts from the start time");
+DEFINE_validator(load_mode, [](const char*, const std::string& value) -> bool {
+  return value == "closed" || value == "open";
+});
+DEFINE_uint32(target_qps, 1000, "Request rate of open load mode, shared by all threads");
+DEFINE_string(arrival, "constant", "Request arrival of open load mode, constant or poisson");
+DEFINE_validator(arrival, [](const char*, const std::string& value) -> bool {
+  return value == "constant" || value == "poisson";
+});
+
+DEFINE_bool(latency_breakdown, false,
+            "Break request latency down into client, queue, rpc, response and merge phases at cumulative report");
+
+DEFINE_string(cpu_profile_file, "",
+              "Write a cpu profile of the run to this file, needs gperftools libprofiler linked or LD_PRELOADed");
+DEFINE_string(heap_profile_prefix, "",
+              "Write heap profiles of the run to <prefix>.<seq>.heap, needs tcmalloc or jemalloc with "
+              "MALLOC_CONF=prof:true linked or LD_PRELOADed");
+DEFINE_uint32(heap_profile_interval_s, 0, "Interval in seconds between heap profile dumps, 0 means dump at end");
+DEFINE_uint32(profile_delay_s, 0, "Start profiling this many seconds after requests start, e.g. to skip warm up");
+DEFINE_uint32(profile_duration_s, 0, "Stop profiling after this many seconds, 0 means at the end of requests");
+
+DEFINE_string(report_file, "", "Also write every report to this file, empty means no file");
+DEFINE_string(report_format, "csv", "Format of report_file, csv or json, json is one object per line");
+DEFINE_validator(report_format, [](const char*, const std::string& value) -> bool {
+  return value == "csv" || value == "json";
+});
+
+DEFINE_string(background_write, "",
+              "Write benchmark run beside the requests by own threads, e.g. fillrandom or fillvectorrandom to "
+              "measure reads or searches under sustained ingest, empty means none");
+DEFINE_uint32(background_write_concurrency, 1, "Concurrency of background write");
+DEFINE_uint32(background_write_qps, 0, "Request rate of background write shared by all its threads, 0 means no limit");
+
+DEFINE_string(chaos_action, "",
+              "Fault injected every chaos_interval_s while requests run, transfer_leader moves the leader of a random "
+              "region of the benchmark to another peer, empty means none");
+DEFINE_validator(chaos_action, [](const char*, const std::string& value) -> bool {
+  return value.empty() || value == "transfer_leader";
+});
+DEFINE_string(chaos_command, "",
+              "Shell command also run at every injection, e.g. a script restarting a store, empty means none");
+DEFINE_uint32(chaos_interval_s, 30, "Interval in seconds between fault injections, the first one after it too");
+DEFINE_double(chaos_recover_latency_factor, 3.0,
+              "Requests slower than p99 latency before the fault times it are not recovered yet");
+DEFINE_uint32(chaos_recover_window_ms, 1000,
+              "Recovered after this long without failed or slow requests, time to recover ends at the last of them");
+
 DEFINE_bool(is_single_region_txn, true, "Is single region txn");
 DEFINE_uint32(replica, 3, "Replica number");
 
@@ -109,11 +173,46 @@ DEFINE_bool(vector_search_use_brute_force, false, "Vector search flag use_brute_
 DEFINE_bool(vector_search_enable_range_search, false, "Vector search flag enable_range_search");
 DEFINE_double(vector_search_radius, 0.1, "Vector search flag radius");
 
+// vector search sweep, searchvector runs once per combination of the lists
+DEFINE_string(vector_search_sweep_ef, "", "Vector search sweep ef list, e.g. 16,32,64, empty means vector_search_ef");
+DEFINE_string(vector_search_sweep_nprobe, "",
+              "Vector search sweep nprobe list, e.g. 8,16,32, empty means vector_search_nprobe");
+DEFINE_string(vector_search_sweep_topk, "",
+              "Vector search sweep topk list, e.g. 1,10,100, empty means vector_search_topk");
+DEFINE_string(vector_search_sweep_filter_type, "",
+              "Vector search sweep filter type list of none/pre/post, empty means vector_search_filter_type");
+DEFINE_validator(vector_search_sweep_filter_type, [](const char*, const std::string& value) -> bool {
+  std::vector<std::string> filter_types;
+  dingodb::benchmark::SplitString(value, ',', filter_types);
+  for (const auto& filter_type : filter_types) {
+    auto upper = dingodb::benchmark::ToUpper(filter_type);
+    if (upper != "NONE" && upper != "PRE" && upper != "POST") {
+      return false;
+    }
+  }
+  return true;
+});
+DEFINE_string(vector_sweep_result_file, "vector_sweep.csv",
+              "Vector search sweep result file, ann-benchmarks data_export like csv, empty means no file");
+
+// auto tune, every step runs req_num requests or timelimit like one benchmark
+DEFINE_bool(autotune, false,
+            "Ramp concurrency for every batch size to find the throughput plateau and the latency knee, then report "
+            "the recommended concurrency and batch size");
+DEFINE_uint32(autotune_max_concurrency, 256, "Auto tune doubles concurrency from 1 up to it");
+DEFINE_string(autotune_batch_sizes, "", "Auto tune batch size list, e.g. 1,16,64, empty means batch_size");
+DEFINE_uint32(autotune_p99_budget_us, 0,
+              "Auto tune p99 latency budget in us, a step over it stops the ramp and is not recommended, 0 means none");
+DEFINE_double(autotune_plateau_ratio, 0.05,
+              "Auto tune stops the ramp when qps grows less than this ratio over the best step, the least concurrency "
+              "within this ratio of the best qps is recommended");
+
 DECLARE_uint32(vector_put_batch_size);
 DECLARE_uint32(vector_arrange_concurrency);
 DECLARE_bool(vector_search_arrange_data);
 DECLARE_uint32(vector_search_nprobe);
 DECLARE_uint32(vector_search_ef);
+DECLARE_string(vector_search_filter_type);
 
 DECLARE_string(benchmark);
 DECLARE_uint32(key_size);
@@ -122,8 +221,37 @@ DECLARE_uint32(batch_size);
 DECLARE_bool(is_pessimistic_txn);
 DECLARE_string(txn_isolation_level);
 
+DECLARE_string(ycsb_workload);
+DECLARE_double(mixed_read_ratio);
+DECLARE_double(mixed_update_ratio);
+DECLARE_double(mixed_insert_ratio);
+DECLARE_double(mixed_scan_ratio);
+DECLARE_double(mixed_rmw_ratio);
+DECLARE_double(mixed_txn_ratio);
+DECLARE_string(mixed_key_distribution);
+DECLARE_double(zipfian_constant);
+DECLARE_uint32(mixed_scan_max_len);
+DECLARE_uint32(mixed_txn_key_num);
+DECLARE_uint32(txn_hot_key_num);
+DECLARE_uint32(txn_contention_key_num);
+DECLARE_double(txn_rmw_ratio);
+DECLARE_string(txn_key_distribution);
+DECLARE_uint32(scan_range_width);
+DECLARE_uint32(scan_limit);
+DECLARE_bool(scan_key_only);
+DECLARE_uint32(document_search_topn);
+DECLARE_string(document_search_column_names);
+DECLARE_uint32(document_scan_query_count);
+DECLARE_uint32(document_word_num);
+DECLARE_uint32(document_vocabulary_size);
+
 DECLARE_string(filter_field);
 
+DECLARE_bool(mock_server);
+DECLARE_int64(mock_server_latency_us);
+DECLARE_double(mock_server_not_leader_ratio);
+DECLARE_double(mock_server_region_version_ratio);
+
 namespace dingodb {
 namespace benchmark {
 
@@ -151,7 +279,8 @@ sdk::EngineType GetRawEngineType() {
 
 static bool IsTransactionBenchmark() {
   return (FLAGS_benchmark == "filltxnseq" || FLAGS_benchmark == "filltxnrandom" || FLAGS_benchmark == "readtxnseq" ||
-          FLAGS_benchmark == "readtxnrandom" || FLAGS_benchmark == "readtxnmissing");
+          FLAGS_benchmark == "readtxnrandom" || FLAGS_benchmark == "readtxnmissing" ||
+          FLAGS_benchmark == "scantxnseq" || FLAGS_benchmark == "scantxnrandom" || FLAGS_benchmark == "txncontention");
 }
 
 static bool IsVectorBenchmark() {
@@ -159,23 +288,60 @@ static bool IsVectorBenchmark() {
          FLAGS_benchmark == "searchvector" || FLAGS_benchmark == "queryvector";
 }
 
-Stats::Stats() {
-  latency_recorder_ = std::make_shared<bvar::LatencyRecorder>();
-  recall_recorder_ = std::make_shared<bvar::LatencyRecorder>();
+static bool IsDocumentBenchmark() {
+  return FLAGS_benchmark == "filldocumentseq" || FLAGS_benchmark == "searchdocument" ||
+         FLAGS_benchmark == "scanquerydocument";
+}
+
+static bool IsVectorSweepBenchmark() {
+  return FLAGS_benchmark == "searchvector" &&
+         (!FLAGS_vector_search_sweep_ef.empty() || !FLAGS_vector_search_sweep_nprobe.empty() ||
+          !FLAGS_vector_search_sweep_topk.empty() || !FLAGS_vector_search_sweep_filter_type.empty());
+}
+
+static std::vector<int64_t> ParseSweepList(const std::string& value, int64_t default_value) {
+  std::vector<int64_t> values;
+  dingodb::benchmark::SplitString(value, ',', values);
+  if (values.empty()) {
+    values.push_back(default_value);
+  }
+  return values;
+}
+
+// "none" means no filter, i.e. empty vector_search_filter_type
+static std::vector<std::string> ParseSweepFilterTypes() {
+  std::vector<std::string> values;
+  dingodb::benchmark::SplitString(FLAGS_vector_search_sweep_filter_type, ',', values);
+  if (values.empty()) {
+    values.push_back(FLAGS_vector_search_filter_type);
+  }
+  for (auto& value : values) {
+    if (dingodb::benchmark::ToUpper(value) == "NONE") {
+      value.clear();
+    }
+  }
+  return values;
+}
+
+const char* Stats::PhaseName(int phase) {
+  static const char* kPhaseNames[kPhaseNum] = {"client", "queue", "rpc", "response", "merge"};
+  return kPhaseNames[phase];
 }
 
+Stats::Stats() { recall_recorder_ = std::make_shared<bvar::LatencyRecorder>(); }
+
 void Stats::Add(size_t duration, size_t write_bytes, size_t read_bytes) {
   ++req_num_;
   write_bytes_ += write_bytes;
   read_bytes_ += read_bytes;
-  *latency_recorder_ << duration;
+  latency_histogram_.Record(duration);
 }
 
 void Stats::Add(size_t duration, size_t write_bytes, size_t read_bytes, const std::vector<uint32_t>& recalls) {
   ++req_num_;
   write_bytes_ += write_bytes;
   read_bytes_ += read_bytes;
-  *latency_recorder_ << duration;
+  latency_histogram_.Record(duration);
   for (auto recall : recalls) {
     *recall_recorder_ << recall;
   }
@@ -183,14 +349,72 @@ void Stats::Add(size_t duration, size_t write_bytes, size_t read_bytes, const st
 
 void Stats::AddError() { ++error_count_; }
 
+void Stats::AddPhases(const sdk::SlowLogPhases& phases) {
+  ++phase_req_num_;
+  phase_histograms_[0].Record(phases.client_us);
+  phase_histograms_[1].Record(phases.queue_us);
+  phase_histograms_[2].Record(phases.rpc_us);
+  phase_histograms_[3].Record(phases.response_us);
+  phase_histograms_[4].Record(phases.merge_us);
+}
+
 void Stats::Clear() {
   ++epoch_;
   req_num_ = 0;
   write_bytes_ = 0;
   read_bytes_ = 0;
   error_count_ = 0;
-  latency_recorder_ = std::make_shared<bvar::LatencyRecorder>();
+  latency_histogram_.Reset();
   recall_recorder_ = std::make_shared<bvar::LatencyRecorder>();
+  for (auto& histogram : phase_histograms_) {
+    histogram.Reset();
+  }
+  phase_req_num_ = 0;
+}
+
+void Stats::Merge(const Stats& other) {
+  req_num_ += other.req_num_;
+  write_bytes_ += other.write_bytes_;
+  read_bytes_ += other.read_bytes_;
+  error_count_ += other.error_count_;
+  latency_histogram_.Merge(other.latency_histogram_);
+  for (int i = 0; i < kPhaseNum; ++i) {
+    phase_histograms_[i].Merge(other.phase_histograms_[i]);
+  }
+  phase_req_num_ += other.phase_req_num_;
+}
+
+// one line of counters, then one line per histogram
+std::string Stats::Encode() const {
+  std::string text =
+      fmt::format("{} {} {} {} {}\n", req_num_, write_bytes_, read_bytes_, error_count_, phase_req_num_);
+  text += latency_histogram_.Encode() + '\n';
+  for (const auto& histogram : phase_histograms_) {
+    text += histogram.Encode() + '\n';
+  }
+  return text;
+}
+
+bool Stats::Decode(const std::string& text) {
+  std::istringstream in(text);
+  std::string line;
+  if (!std::getline(in, line)) {
+    return false;
+  }
+  std::istringstream counters(line);
+  if (!(counters >> req_num_ >> write_bytes_ >> read_bytes_ >> error_count_ >> phase_req_num_)) {
+    return false;
+  }
+
+  if (!std::getline(in, line) || !latency_histogram_.Decode(line)) {
+    return false;
+  }
+  for (auto& histogram : phase_histograms_) {
+    if (!std::getline(in, line) || !histogram.Decode(line)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void Stats::Report(bool is_cumulative, size_t milliseconds) const {
@@ -207,37 +431,131 @@ void Stats::Report(bool is_cumulative, size_t milliseconds) const {
     }
   }
 
-  if (FLAGS_vector_dataset.empty()) {
-    std::cout << fmt::format("{:>8}{:>8}{:>8}{:>8.0f}{:>8.2f}{:>16}{:>8}{:>8}{:>8}{:>8}", epoch_, req_num_,
-                             error_count_, (req_num_ / seconds), (write_bytes_ / seconds / 1048576),
-                             latency_recorder_->latency(), latency_recorder_->max_latency(),
-                             latency_recorder_->latency_percentile(0.5), latency_recorder_->latency_percentile(0.95),
-                             latency_recorder_->latency_percentile(0.99))
-              << '\n';
-  } else {
-    std::cout << fmt::format("{:>8}{:>8}{:>8}{:>8.0f}{:>8.2f}{:>16}{:>8}{:>8}{:>8}{:>8}{:>16.2f}", epoch_, req_num_,
-                             error_count_, (req_num_ / seconds), (write_bytes_ / seconds / 1048576),
-                             latency_recorder_->latency(), latency_recorder_->max_latency(),
-                             latency_recorder_->latency_percentile(0.5), latency_recorder_->latency_percentile(0.95),
-                             latency_recorder_->latency_percentile(0.99), recall_recorder_->latency() / 100.0)
+  const auto& latency = latency_histogram_;
+  std::string line = fmt::format(
+      "{:>8}{:>8}{:>8}{:>8.0f}{:>8.2f}{:>16.0f}{:>8}{:>8}{:>8}{:>8}{:>10}{:>11}", epoch_, req_num_, error_count_,
+      (req_num_ / seconds), (write_bytes_ / seconds / 1048576), latency.Mean(), latency.Max(),
+      latency.ValueAtPercentile(50), latency.ValueAtPercentile(95), latency.ValueAtPercentile(99),
+      latency.ValueAtPercentile(99.9), latency.ValueAtPercentile(99.99));
+  if (!FLAGS_vector_dataset.empty()) {
+    line += fmt::format("{:>16.2f}", recall_recorder_->latency() / 100.0);
+  }
+  std::cout << line << '\n';
+}
+
+void Stats::ReportPhases() const {
+  std::cout << COLOR_GREEN << fmt::format("Latency breakdown({} requests):", phase_req_num_) << COLOR_RESET << '\n';
+  std::cout << COLOR_GREEN
+            << fmt::format("{:>10}{:>16}{:>8}{:>8}{:>8}{:>10}{:>8}", "PHASE", "LATENCY AVG(us)", "P50(us)", "P95(us)",
+                           "P99(us)", "P999(us)", "MAX(us)")
+            << COLOR_RESET << '\n';
+  for (int i = 0; i < kPhaseNum; ++i) {
+    const auto& latency = phase_histograms_[i];
+    std::cout << fmt::format("{:>10}{:>16.0f}{:>8}{:>8}{:>8}{:>10}{:>8}", PhaseName(i), latency.Mean(),
+                             latency.ValueAtPercentile(50), latency.ValueAtPercentile(95),
+                             latency.ValueAtPercentile(99), latency.ValueAtPercentile(99.9), latency.Max())
               << '\n';
   }
 }
 
 std::string Stats::Header() {
-  if (FLAGS_vector_dataset.empty()) {
-    return fmt::format("{:>8}{:>8}{:>8}{:>8}{:>8}{:>16}{:>8}{:>8}{:>8}{:>8}", "EPOCH", "REQ_NUM", "ERRORS", "QPS",
-                       "MB/s", "LATENCY AVG(us)", "MAX(us)", "P50(us)", "P95(us)", "P99(us)");
-  } else {
-    return fmt::format("{:>8}{:>8}{:>8}{:>8}{:>8}{:>16}{:>8}{:>8}{:>8}{:>8}{:>16}", "EPOCH", "REQ_NUM", "ERRORS", "QPS",
-                       "MB/s", "LATENCY AVG(us)", "MAX(us)", "P50(us)", "P95(us)", "P99(us)", "RECALL AVG(%)");
+  std::string header =
+      fmt::format("{:>8}{:>8}{:>8}{:>8}{:>8}{:>16}{:>8}{:>8}{:>8}{:>8}{:>10}{:>11}", "EPOCH", "REQ_NUM", "ERRORS",
+                  "QPS", "MB/s", "LATENCY AVG(us)", "MAX(us)", "P50(us)", "P95(us)", "P99(us)", "P999(us)",
+                  "P9999(us)");
+  if (!FLAGS_vector_dataset.empty()) {
+    header += fmt::format("{:>16}", "RECALL AVG(%)");
+  }
+  return header;
+}
+
+std::string Stats::FormatHeader() {
+  std::string header =
+      "timestamp_ms,type,epoch,elapsed_ms,req_num,errors,qps,write_mbps,read_mbps,"
+      "latency_avg_us,latency_min_us,latency_p50_us,latency_p95_us,latency_p99_us,latency_p999_us,latency_p9999_us,"
+      "latency_max_us";
+  if (!FLAGS_vector_dataset.empty()) {
+    header += ",recall_avg";
+  }
+  return header;
+}
+
+std::string Stats::Format(bool is_cumulative, size_t milliseconds) const {
+  double seconds = std::max<size_t>(milliseconds, 1) / static_cast<double>(1000);
+  const auto& latency = latency_histogram_;
+  const char* type = is_cumulative ? "cumulative" : "interval";
+  bool with_recall = !FLAGS_vector_dataset.empty();
+
+  if (FLAGS_report_format == "json") {
+    std::string line = fmt::format(
+        "{{\"timestamp_ms\":{},\"benchmark\":\"{}\",\"type\":\"{}\",\"epoch\":{},\"elapsed_ms\":{},"
+        "\"req_num\":{},\"errors\":{},\"qps\":{:.2f},\"write_mbps\":{:.4f},\"read_mbps\":{:.4f},"
+        "\"latency_avg_us\":{:.2f},\"latency_min_us\":{},\"latency_p50_us\":{},\"latency_p95_us\":{},"
+        "\"latency_p99_us\":{},\"latency_p999_us\":{},\"latency_p9999_us\":{},\"latency_max_us\":{}",
+        dingodb::benchmark::TimestampMs(), FLAGS_benchmark, type, epoch_, milliseconds, req_num_, error_count_,
+        req_num_ / seconds, write_bytes_ / seconds / 1048576, read_bytes_ / seconds / 1048576, latency.Mean(),
+        latency.Min(), latency.ValueAtPercentile(50), latency.ValueAtPercentile(95), latency.ValueAtPercentile(99),
+        latency.ValueAtPercentile(99.9), latency.ValueAtPercentile(99.99), latency.Max());
+    if (with_recall) {
+      line += fmt::format(",\"recall_avg\":{:.2f}", recall_recorder_->latency() / 100.0);
+    }
+    // see FLAGS_latency_breakdown
+    if (phase_req_num_ > 0) {
+      line += ",\"phases\":{";
+      for (int i = 0; i < kPhaseNum; ++i) {
+        const auto& phase = phase_histograms_[i];
+        line += fmt::format(
+            "{}\"{}\":{{\"avg_us\":{:.2f},\"p50_us\":{},\"p95_us\":{},\"p99_us\":{},\"p999_us\":{}}}",
+            i == 0 ? "" : ",", PhaseName(i), phase.Mean(), phase.ValueAtPercentile(50), phase.ValueAtPercentile(95),
+            phase.ValueAtPercentile(99), phase.ValueAtPercentile(99.9));
+      }
+      line += "}";
+    }
+    line += "}";
+    return line;
+  }
+
+  std::string line = fmt::format("{},{},{},{},{},{},{:.2f},{:.4f},{:.4f},{:.2f},{},{},{},{},{},{},{}",
+                                 dingodb::benchmark::TimestampMs(), type, epoch_, milliseconds, req_num_,
+                                 error_count_, req_num_ / seconds, write_bytes_ / seconds / 1048576,
+                                 read_bytes_ / seconds / 1048576, latency.Mean(), latency.Min(),
+                                 latency.ValueAtPercentile(50), latency.ValueAtPercentile(95),
+                                 latency.ValueAtPercentile(99), latency.ValueAtPercentile(99.9),
+                                 latency.ValueAtPercentile(99.99), latency.Max());
+  if (with_recall) {
+    line += fmt::format(",{:.2f}", recall_recorder_->latency() / 100.0);
   }
+  return line;
+}
+
+ArrivalSchedule::ArrivalSchedule(uint32_t qps, bool is_poisson)
+    : next_us_(static_cast<double>(dingodb::benchmark::TimestampUs())),
+      interval_us_(1000000.0 / std::max<uint32_t>(qps, 1)),
+      is_poisson_(is_poisson),
+      gen_(std::random_device{}()),
+      exponential_(1.0 / interval_us_) {}
+
+int64_t ArrivalSchedule::WaitNext() {
+  double start_us;
+  {
+    std::lock_guard lock(mutex_);
+    start_us = next_us_;
+    next_us_ += is_poisson_ ? exponential_(gen_) : interval_us_;
+  }
+
+  // already late when every thread was busy at the start time, send at once
+  int64_t wait_us = static_cast<int64_t>(start_us) - dingodb::benchmark::TimestampUs();
+  if (wait_us > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(wait_us));
+  }
+  return static_cast<int64_t>(start_us);
 }
 
 Benchmark::Benchmark(std::shared_ptr<dingodb::sdk::ClientStub> client_stub, std::shared_ptr<sdk::Client> client)
     : client_stub_(client_stub), client_(client) {
   stats_interval_ = std::make_shared<Stats>();
   stats_cumulative_ = std::make_shared<Stats>();
+  stats_background_ = std::make_shared<Stats>();
 }
 
 std::shared_ptr<Benchmark> Benchmark::New(std::shared_ptr<dingodb::sdk::ClientStub> client_stub,
@@ -246,37 +564,347 @@ std::shared_ptr<Benchmark> Benchmark::New(std::shared_ptr<dingodb::sdk::ClientSt
 }
 
 void Benchmark::Stop() {
+  is_stopped_.store(true, std::memory_order_relaxed);
+  StopThreads();
+}
+
+void Benchmark::StopThreads() {
   for (auto& thread_entry : thread_entries_) {
     thread_entry->is_stop.store(true, std::memory_order_relaxed);
   }
 }
 
 bool Benchmark::Run() {
+  if (FLAGS_autotune && IsVectorSweepBenchmark()) {
+    std::cerr << "auto tune and vector search sweep can not run together." << '\n';
+    return false;
+  }
+
+  if (IsVectorSweepBenchmark()) {
+    // recall needs the ground truth of a dataset
+    if (FLAGS_vector_dataset.empty()) {
+      std::cerr << "vector search sweep need --vector_dataset for recall." << '\n';
+      return false;
+    }
+
+    // neighbors of test data are cut to topk at arrange, keep enough for the largest one
+    auto topks = ParseSweepList(FLAGS_vector_search_sweep_topk, FLAGS_vector_search_topk);
+    FLAGS_vector_search_topk = *std::max_element(topks.begin(), topks.end());
+  }
+
   if (!Arrange()) {
     Clean();
     return false;
   }
 
+  if (!FLAGS_report_file.empty()) {
+    report_file_.open(FLAGS_report_file, std::ios::out | std::ios::trunc);
+    if (!report_file_.is_open()) {
+      LOG(ERROR) << fmt::format("open report file {} failed", FLAGS_report_file);
+    } else if (FLAGS_report_format == "csv") {
+      report_file_ << Stats::FormatHeader() << '\n';
+    }
+  }
+
+  if (IsVectorSweepBenchmark()) {
+    RunVectorSweep();
+    Clean();
+    return true;
+  }
+
+  if (FLAGS_autotune) {
+    RunAutotune();
+    Clean();
+    return true;
+  }
+
+  RunRequests();
+
+  Clean();
+  return true;
+}
+
+bool Benchmark::RunArrange() {
+  if (IsVectorSweepBenchmark()) {
+    std::cerr << "vector search sweep is not supported by distributed benchmark." << '\n';
+    return false;
+  }
+  if (FLAGS_autotune) {
+    std::cerr << "auto tune is not supported by distributed benchmark." << '\n';
+    return false;
+  }
+
+  return Arrange();
+}
+
+size_t Benchmark::RunRequests() {
   Launch();
 
   size_t start_time = dingodb::benchmark::TimestampMs();
+  LaunchBackgroundWrite();
+  LaunchChaos(start_time);
 
   // Interval report
   IntervalReport();
 
   Wait();
+  StopChaos();
+  StopBackgroundWrite();
 
   // Cumulative report
-  Report(true, dingodb::benchmark::TimestampMs() - start_time);
+  size_t milliseconds = dingodb::benchmark::TimestampMs() - start_time;
+  Report(true, milliseconds);
+  operation_->Report();
+  ReportBackgroundWrite(milliseconds);
+  ReportChaos();
+  return milliseconds;
+}
 
-  Clean();
-  return true;
+void Benchmark::RunClean() { Clean(); }
+
+std::string Benchmark::EncodeCumulativeStats() {
+  std::lock_guard lock(mutex_);
+  return stats_cumulative_->Encode();
+}
+
+size_t Benchmark::RunRound() {
+  {
+    std::lock_guard lock(mutex_);
+    stats_interval_->Clear();
+    stats_cumulative_->Clear();
+  }
+  thread_entries_.clear();
+
+  Launch();
+  size_t start_time = dingodb::benchmark::TimestampMs();
+  IntervalReport();
+  Wait();
+  size_t milliseconds = dingodb::benchmark::TimestampMs() - start_time;
+  Report(true, milliseconds);
+  std::cout << '\n';
+  return milliseconds;
+}
+
+void Benchmark::RunVectorSweep() {
+  auto efs = ParseSweepList(FLAGS_vector_search_sweep_ef, FLAGS_vector_search_ef);
+  auto nprobes = ParseSweepList(FLAGS_vector_search_sweep_nprobe, FLAGS_vector_search_nprobe);
+  auto topks = ParseSweepList(FLAGS_vector_search_sweep_topk, FLAGS_vector_search_topk);
+  auto filter_types = ParseSweepFilterTypes();
+
+  std::vector<VectorSweepPoint> points;
+  points.reserve(efs.size() * nprobes.size() * topks.size() * filter_types.size());
+  for (const auto& filter_type : filter_types) {
+    for (auto topk : topks) {
+      for (auto nprobe : nprobes) {
+        for (auto ef : efs) {
+          if (is_stopped_.load(std::memory_order_relaxed)) {
+            break;
+          }
+
+          // search operation reads parameters from flags at every request
+          FLAGS_vector_search_ef = ef;
+          FLAGS_vector_search_nprobe = nprobe;
+          FLAGS_vector_search_topk = topk;
+          FLAGS_vector_search_filter_type = filter_type;
+
+          std::cout << COLOR_GREEN
+                    << fmt::format("Sweep ef({}) nprobe({}) topk({}) filter_type({}):", ef, nprobe, topk,
+                                   filter_type.empty() ? "none" : filter_type)
+                    << COLOR_RESET << '\n';
+
+          size_t milliseconds = RunRound();
+
+          VectorSweepPoint point;
+          point.ef = ef;
+          point.nprobe = nprobe;
+          point.topk = topk;
+          point.filter_type = filter_type;
+          {
+            std::lock_guard lock(mutex_);
+            const auto& latency = stats_cumulative_->Latency();
+            point.req_num = stats_cumulative_->ReqNum();
+            point.error_count = stats_cumulative_->ErrorCount();
+            point.qps = point.req_num * 1000.0 / std::max<size_t>(milliseconds, 1);
+            point.recall = stats_cumulative_->RecallAvg();
+            point.latency_p50 = latency.ValueAtPercentile(50);
+            point.latency_p95 = latency.ValueAtPercentile(95);
+            point.latency_p99 = latency.ValueAtPercentile(99);
+            point.latency_p999 = latency.ValueAtPercentile(99.9);
+          }
+          points.push_back(point);
+        }
+      }
+    }
+  }
+
+  ReportVectorSweep(points);
+}
+
+// points on the recall/qps pareto frontier are marked with '*'
+void Benchmark::ReportVectorSweep(const std::vector<VectorSweepPoint>& points) {
+  std::vector<bool> is_pareto(points.size(), true);
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t j = 0; j < points.size(); ++j) {
+      const auto& a = points[i];
+      const auto& b = points[j];
+      if (i != j && b.recall >= a.recall && b.qps >= a.qps && (b.recall > a.recall || b.qps > a.qps)) {
+        is_pareto[i] = false;
+        break;
+      }
+    }
+  }
+
+  std::cout << COLOR_GREEN << "Vector search sweep:" << COLOR_RESET << '\n';
+  std::cout << COLOR_GREEN
+            << fmt::format("{:>8}{:>8}{:>8}{:>8}{:>10}{:>8}{:>12}{:>16}{:>10}{:>10}{:>10}{:>10}{:>8}", "EF", "NPROBE",
+                           "TOPK", "FILTER", "REQ_NUM", "ERRORS", "QPS", "RECALL AVG(%)", "P50(us)", "P95(us)",
+                           "P99(us)", "P999(us)", "PARETO")
+            << COLOR_RESET << '\n';
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto& point = points[i];
+    std::cout << fmt::format("{:>8}{:>8}{:>8}{:>8}{:>10}{:>8}{:>12.0f}{:>16.2f}{:>10}{:>10}{:>10}{:>10}{:>8}",
+                             point.ef, point.nprobe, point.topk, point.filter_type.empty() ? "none" : point.filter_type,
+                             point.req_num, point.error_count, point.qps, point.recall, point.latency_p50,
+                             point.latency_p95, point.latency_p99, point.latency_p999, is_pareto[i] ? "*" : "")
+              << '\n';
+  }
+
+  if (FLAGS_vector_sweep_result_file.empty()) {
+    return;
+  }
+
+  // same columns as ann-benchmarks data_export.py, k-nn is recall in [0, 1] and percentiles are in ms
+  std::ofstream file(FLAGS_vector_sweep_result_file, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    LOG(ERROR) << fmt::format("open vector sweep result file {} failed", FLAGS_vector_sweep_result_file);
+    return;
+  }
+
+  std::string algorithm = fmt::format("dingodb-{}", dingodb::benchmark::ToLower(FLAGS_vector_index_type));
+  std::string dataset = std::filesystem::path(FLAGS_vector_dataset).stem().string();
+  file << "algorithm,parameters,dataset,count,k-nn,qps,p50,p95,p99,p999" << '\n';
+  for (const auto& point : points) {
+    std::string parameters = fmt::format("\"DingoDB(ef={}, nprobe={}, filter_type={})\"", point.ef, point.nprobe,
+                                         point.filter_type.empty() ? "none" : point.filter_type);
+    file << fmt::format("{},{},{},{},{:.4f},{:.2f},{:.3f},{:.3f},{:.3f},{:.3f}", algorithm, parameters, dataset,
+                        point.topk, point.recall / 100.0, point.qps, point.latency_p50 / 1000.0,
+                        point.latency_p95 / 1000.0, point.latency_p99 / 1000.0, point.latency_p999 / 1000.0)
+         << '\n';
+  }
+
+  std::cout << fmt::format("vector search sweep result write to {}", FLAGS_vector_sweep_result_file) << '\n';
+}
+
+void Benchmark::RunAutotune() {
+  auto batch_sizes = ParseSweepList(FLAGS_autotune_batch_sizes, FLAGS_batch_size);
+  uint64_t max_concurrency = std::max<uint32_t>(FLAGS_autotune_max_concurrency, 1);
+
+  std::vector<AutotunePoint> points;
+  for (auto batch_size : batch_sizes) {
+    double best_qps = 0;
+    for (uint64_t concurrency = 1; concurrency <= max_concurrency; concurrency *= 2) {
+      if (is_stopped_.load(std::memory_order_relaxed)) {
+        break;
+      }
+
+      // operations read batch size from flags at every request, threads are launched by concurrency
+      FLAGS_concurrency = static_cast<uint32_t>(concurrency);
+      FLAGS_batch_size = static_cast<uint32_t>(batch_size);
+
+      std::cout << COLOR_GREEN << fmt::format("Autotune concurrency({}) batch_size({}):", concurrency, batch_size)
+                << COLOR_RESET << '\n';
+
+      size_t milliseconds = RunRound();
+
+      AutotunePoint point;
+      point.concurrency = static_cast<uint32_t>(concurrency);
+      point.batch_size = static_cast<uint32_t>(batch_size);
+      {
+        std::lock_guard lock(mutex_);
+        const auto& latency = stats_cumulative_->Latency();
+        point.req_num = stats_cumulative_->ReqNum();
+        point.error_count = stats_cumulative_->ErrorCount();
+        point.qps = point.req_num * 1000.0 / std::max<size_t>(milliseconds, 1);
+        point.latency_p50 = latency.ValueAtPercentile(50);
+        point.latency_p99 = latency.ValueAtPercentile(99);
+      }
+      point.is_ok = point.error_count == 0 &&
+                    (FLAGS_autotune_p99_budget_us == 0 || point.latency_p99 <= FLAGS_autotune_p99_budget_us);
+      points.push_back(point);
+
+      // past the latency knee more concurrency only queues requests
+      if (!point.is_ok) {
+        break;
+      }
+      // throughput plateau
+      if (best_qps > 0 && point.qps < best_qps * (1 + FLAGS_autotune_plateau_ratio)) {
+        break;
+      }
+      best_qps = std::max(best_qps, point.qps);
+    }
+  }
+
+  ReportAutotune(points);
+}
+
+// the recommended step of every batch size is marked with '*', the overall one moves the most keys per second
+void Benchmark::ReportAutotune(const std::vector<AutotunePoint>& points) {
+  std::vector<bool> is_knee(points.size(), false);
+  int64_t recommended = -1;
+  for (size_t begin = 0; begin < points.size();) {
+    size_t end = begin;
+    double best_qps = 0;
+    for (; end < points.size() && points[end].batch_size == points[begin].batch_size; ++end) {
+      if (points[end].is_ok) {
+        best_qps = std::max(best_qps, points[end].qps);
+      }
+    }
+
+    // least concurrency near the best qps, the rest of the ramp only adds latency
+    for (size_t i = begin; i < end; ++i) {
+      if (points[i].is_ok && points[i].qps >= best_qps * (1 - FLAGS_autotune_plateau_ratio)) {
+        is_knee[i] = true;
+        if (recommended < 0 ||
+            points[i].qps * points[i].batch_size > points[recommended].qps * points[recommended].batch_size) {
+          recommended = i;
+        }
+        break;
+      }
+    }
+    begin = end;
+  }
+
+  std::cout << COLOR_GREEN << fmt::format("Autotune {}:", FLAGS_benchmark) << COLOR_RESET << '\n';
+  std::cout << COLOR_GREEN
+            << fmt::format("{:>12}{:>12}{:>10}{:>8}{:>12}{:>14}{:>10}{:>10}{:>8}{:>6}", "CONCURRENCY", "BATCH_SIZE",
+                           "REQ_NUM", "ERRORS", "QPS", "KEYS/S", "P50(us)", "P99(us)", "BUDGET", "KNEE")
+            << COLOR_RESET << '\n';
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto& point = points[i];
+    std::cout << fmt::format("{:>12}{:>12}{:>10}{:>8}{:>12.0f}{:>14.0f}{:>10}{:>10}{:>8}{:>6}", point.concurrency,
+                             point.batch_size, point.req_num, point.error_count, point.qps,
+                             point.qps * point.batch_size, point.latency_p50, point.latency_p99,
+                             point.is_ok ? "ok" : "over", is_knee[i] ? "*" : "")
+              << '\n';
+  }
+
+  if (recommended < 0) {
+    std::cout << COLOR_GREEN << "Recommended: none, every step has errors or is over p99 budget" << COLOR_RESET
+              << '\n';
+    return;
+  }
+
+  const auto& point = points[recommended];
+  std::cout << COLOR_GREEN
+            << fmt::format("Recommended: concurrency({}) batch_size({}) qps({:.0f}) p99({}us)", point.concurrency,
+                           point.batch_size, point.qps, point.latency_p99)
+            << COLOR_RESET << '\n';
 }
 
 bool Benchmark::Arrange() {
   std::cout << COLOR_GREEN << "Arrange: " << COLOR_RESET << '\n';
 
-  if (IsVectorBenchmark()) {
+  if (IsVectorBenchmark() || IsDocumentBenchmark()) {
     if (!FLAGS_vector_dataset.empty()) {
       dataset_ = Dataset::New(FLAGS_vector_dataset);
       if (dataset_ == nullptr || !dataset_->Init()) {
@@ -321,11 +949,12 @@ std::vector<RegionEntryPtr> Benchmark::ArrangeRegion(int num) {
   std::vector<RegionEntryPtr> region_entries;
 
   bool is_txn_region = IsTransactionBenchmark();
+  bool with_txn_region = IsMixedTxnBenchmark();
 
   std::vector<std::thread> threads;
   threads.reserve(num);
   for (int thread_no = 0; thread_no < num; ++thread_no) {
-    threads.emplace_back([this, is_txn_region, thread_no, &region_entries, &mutex]() {
+    threads.emplace_back([this, is_txn_region, with_txn_region, thread_no, &region_entries, &mutex]() {
       auto name = fmt::format("{}_{}_{}", kNamePrefix, dingodb::benchmark::TimestampMs(), thread_no + 1);
       std::string prefix = fmt::format("{}{:06}", FLAGS_prefix, thread_no);
       int64_t region_id = 0;
@@ -341,9 +970,24 @@ std::vector<RegionEntryPtr> Benchmark::ArrangeRegion(int num) {
 
       std::cout << fmt::format("create region name({}) id({}) prefix({}) done", name, region_id, prefix) << '\n';
 
+      int64_t txn_region_id = 0;
+      if (with_txn_region) {
+        std::string txn_name = name + "_txn";
+        txn_region_id = CreateTxnRegion(txn_name, prefix, PrefixNext(prefix), GetRawEngineType(), FLAGS_replica);
+        if (txn_region_id == 0) {
+          LOG(ERROR) << fmt::format("create txn region failed, name: {}", txn_name);
+          DropRegion(region_id);
+          return;
+        }
+
+        std::cout << fmt::format("create txn region name({}) id({}) prefix({}) done", txn_name, txn_region_id, prefix)
+                  << '\n';
+      }
+
       auto region_entry = std::make_shared<RegionEntry>();
       region_entry->prefix = prefix;
       region_entry->region_id = region_id;
+      region_entry->txn_region_id = txn_region_id;
 
       std::lock_guard lock(mutex);
       region_entries.push_back(region_entry);
@@ -366,6 +1010,23 @@ std::vector<VectorIndexEntryPtr> Benchmark::ArrangeVectorIndex(int num) {
   for (int thread_no = 0; thread_no < num; ++thread_no) {
     threads.emplace_back([this, thread_no, &vector_index_entries, &mutex]() {
       std::string name = fmt::format("{}_{}_{}", kNamePrefix, dingodb::benchmark::TimestampMs(), thread_no + 1);
+      if (IsDocumentBenchmark()) {
+        auto index_id = CreateDocumentIndex(name);
+        if (index_id == 0) {
+          LOG(ERROR) << fmt::format("create document index failed, name: {}", name);
+          return;
+        }
+
+        std::cout << fmt::format("create document index name({}) id({}) done", name, index_id) << '\n';
+
+        auto entry = std::make_shared<VectorIndexEntry>();
+        entry->index_id = index_id;
+
+        std::lock_guard lock(mutex);
+        vector_index_entries.push_back(entry);
+        return;
+      }
+
       auto index_id = CreateVectorIndex(name, FLAGS_vector_index_type);
       if (index_id == 0) {
         LOG(ERROR) << fmt::format("create vector index failed, name: {}", name);
@@ -399,7 +1060,7 @@ std::vector<VectorIndexEntryPtr> Benchmark::ArrangeExistVectorIndex(int64_t vect
     entry->index_id = vector_index_id;
     vector_index_entries.push_back(entry);
   } else if (!vector_index_name.empty()) {
-    entry->index_id = GetVectorIndex(vector_index_name);
+    entry->index_id = IsDocumentBenchmark() ? GetDocumentIndex(vector_index_name) : GetVectorIndex(vector_index_name);
     if (entry->index_id > 0) {
       vector_index_entries.push_back(entry);
     }
@@ -411,6 +1072,16 @@ std::vector<VectorIndexEntryPtr> Benchmark::ArrangeExistVectorIndex(int64_t vect
 bool Benchmark::ArrangeOperation() {
   operation_ = NewOperation(client_);
 
+  if (!FLAGS_background_write.empty()) {
+    background_operation_ = NewOperation(client_, FLAGS_background_write);
+    if (background_operation_ == nullptr) {
+      std::cerr << fmt::format("Not support background write {}, just support: {}", FLAGS_background_write,
+                               GetSupportBenchmarkType())
+                << '\n';
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -427,6 +1098,10 @@ bool Benchmark::ArrangeData() {
 }
 
 void Benchmark::Launch() {
+  if (FLAGS_load_mode == "open") {
+    arrival_schedule_ = std::make_unique<ArrivalSchedule>(FLAGS_target_qps, FLAGS_arrival == "poisson");
+  }
+
   // Create multiple thread run benchmark
   thread_entries_.reserve(FLAGS_concurrency);
   for (int i = 0; i < FLAGS_concurrency; ++i) {
@@ -452,11 +1127,18 @@ void Benchmark::Clean() {
     // Drop region
     for (auto& region_entry : region_entries_) {
       DropRegion(region_entry->region_id);
+      if (region_entry->txn_region_id != 0) {
+        DropRegion(region_entry->txn_region_id);
+      }
     }
 
     // Drop vector index
     for (auto& vector_index_entry : vector_index_entries_) {
-      DropVectorIndex(vector_index_entry->index_id);
+      if (IsDocumentBenchmark()) {
+        DropDocumentIndex(vector_index_entry->index_id);
+      } else {
+        DropVectorIndex(vector_index_entry->index_id);
+      }
     }
   }
 }
@@ -684,6 +1366,54 @@ int64_t Benchmark::GetVectorIndex(const std::string& name) {
   return vector_index_id;
 }
 
+int64_t Benchmark::CreateDocumentIndex(const std::string& name) {
+  sdk::DocumentIndexCreator* creator = nullptr;
+  auto status = client_->NewDocumentIndexCreator(&creator);
+  CHECK(status.ok()) << fmt::format("new document index creator failed, {}", status.ToString());
+
+  std::vector<int64_t> separator_id;
+  if (!FLAGS_vector_partition_vector_ids.empty()) {
+    SplitString(FLAGS_vector_partition_vector_ids, ',', separator_id);
+  }
+
+  sdk::DocumentSchema schema;
+  schema.AddColumn({"id", sdk::Type::kINT64});
+  schema.AddColumn({"title", sdk::Type::kSTRING});
+  schema.AddColumn({"text", sdk::Type::kSTRING});
+
+  creator->SetName(name)
+      .SetSchemaId(pb::meta::ReservedSchemaIds::DINGO_SCHEMA)
+      .SetRangePartitions(separator_id)
+      .SetReplicaNum(FLAGS_replica)
+      .SetSchema(schema);
+
+  int64_t document_index_id = 0;
+  status = creator->Create(document_index_id);
+  delete creator;
+  if (!status.IsOK()) {
+    LOG(ERROR) << fmt::format("create document index failed, {}", status.ToString());
+    return 0;
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(10));
+
+  return document_index_id;
+}
+
+void Benchmark::DropDocumentIndex(int64_t document_index_id) {
+  CHECK(document_index_id != 0) << "document_index_id is invalid";
+  auto status = client_->DropDocumentIndexById(document_index_id);
+  CHECK(status.IsOK()) << fmt::format("drop document index failed, {}", status.ToString());
+}
+
+int64_t Benchmark::GetDocumentIndex(const std::string& name) {
+  int64_t document_index_id = 0;
+  auto status = client_->GetDocumentIndexId(pb::meta::ReservedSchemaIds::DINGO_SCHEMA, name, document_index_id);
+  CHECK(status.ok()) << fmt::format("get document index failed, {}", status.ToString());
+
+  return document_index_id;
+}
+
 static std::vector<std::string> ExtractPrefixs(const std::vector<RegionEntryPtr>& region_entries) {
   std::vector<std::string> prefixes;
   prefixes.reserve(region_entries.size());
@@ -694,13 +1424,17 @@ static std::vector<std::string> ExtractPrefixs(const std::vector<RegionEntryPtr>
   return prefixes;
 }
 
-void Benchmark::ThreadRoutine(ThreadEntryPtr thread_entry) {
-  // Set signal
+static void BlockSignal() {
   sigset_t sig_set;
   if (sigemptyset(&sig_set) || sigaddset(&sig_set, SIGINT) || pthread_sigmask(SIG_BLOCK, &sig_set, nullptr)) {
     std::cerr << "Cannot block signal" << '\n';
     exit(1);
   }
+}
+
+void Benchmark::ThreadRoutine(ThreadEntryPtr thread_entry) {
+  // Set signal
+  BlockSignal();
 
   if (IsTransactionBenchmark()) {
     if (FLAGS_is_single_region_txn) {
@@ -709,7 +1443,7 @@ void Benchmark::ThreadRoutine(ThreadEntryPtr thread_entry) {
       ExecuteMultiRegion(thread_entry);
     }
 
-  } else if (IsVectorBenchmark()) {
+  } else if (IsVectorBenchmark() || IsDocumentBenchmark()) {
     ExecutePerVectorIndex(thread_entry);
   } else {
     ExecutePerRegion(thread_entry);
@@ -728,18 +1462,10 @@ void Benchmark::ExecutePerRegion(ThreadEntryPtr thread_entry) {
     }
 
     for (const auto& region_entry : region_entries) {
-      size_t eplased_time;
-      auto result = operation_->Execute(region_entry);
-      {
-        std::lock_guard lock(mutex_);
-        if (result.status.ok()) {
-          stats_interval_->Add(result.eplased_time, result.write_bytes, result.read_bytes);
-          stats_cumulative_->Add(result.eplased_time, result.write_bytes, result.read_bytes);
-        } else {
-          stats_interval_->AddError();
-          stats_cumulative_->AddError();
-        }
-      }
+      int64_t start_time_us = WaitArrival();
+      sdk::SlowLogPhases phases;
+      auto result = ExecuteRequest([&]() { return operation_->Execute(region_entry); }, phases);
+      AddResult(result, LatencyUs(start_time_us, result), phases);
     }
   }
 }
@@ -754,17 +1480,10 @@ void Benchmark::ExecuteMultiRegion(ThreadEntryPtr thread_entry) {
       break;
     }
 
-    auto result = operation_->Execute(region_entries);
-    {
-      std::lock_guard lock(mutex_);
-      if (result.status.ok()) {
-        stats_interval_->Add(result.eplased_time, result.write_bytes, result.read_bytes);
-        stats_cumulative_->Add(result.eplased_time, result.write_bytes, result.read_bytes);
-      } else {
-        stats_interval_->AddError();
-        stats_cumulative_->AddError();
-      }
-    }
+    int64_t start_time_us = WaitArrival();
+    sdk::SlowLogPhases phases;
+    auto result = ExecuteRequest([&]() { return operation_->Execute(region_entries); }, phases);
+    AddResult(result, LatencyUs(start_time_us, result), phases);
   }
 }
 
@@ -778,22 +1497,61 @@ void Benchmark::ExecutePerVectorIndex(ThreadEntryPtr thread_entry) {
     }
 
     for (const auto& vector_index_entry : vector_index_entries) {
-      size_t eplased_time;
-      auto result = operation_->Execute(vector_index_entry);
-      {
-        std::lock_guard lock(mutex_);
-        if (result.status.ok()) {
-          stats_interval_->Add(result.eplased_time, result.write_bytes, result.read_bytes, result.recalls);
-          stats_cumulative_->Add(result.eplased_time, result.write_bytes, result.read_bytes, result.recalls);
-        } else {
-          stats_interval_->AddError();
-          stats_cumulative_->AddError();
-        }
-      }
+      int64_t start_time_us = WaitArrival();
+      sdk::SlowLogPhases phases;
+      auto result = ExecuteRequest([&]() { return operation_->Execute(vector_index_entry); }, phases);
+      AddResult(result, LatencyUs(start_time_us, result), phases);
     }
   }
 }
 
+int64_t Benchmark::WaitArrival() { return arrival_schedule_ != nullptr ? arrival_schedule_->WaitNext() : 0; }
+
+size_t Benchmark::LatencyUs(int64_t start_time_us, const Operation::Result& result) const {
+  if (arrival_schedule_ == nullptr) {
+    return result.eplased_time;
+  }
+  return std::max<int64_t>(dingodb::benchmark::TimestampUs() - start_time_us, 0);
+}
+
+Operation::Result Benchmark::ExecuteRequest(const std::function<Operation::Result()>& execute,
+                                            sdk::SlowLogPhases& phases) {
+  if (!FLAGS_latency_breakdown) {
+    return execute();
+  }
+
+  // sdk tasks and store rpcs of the request join the recorder made current here
+  auto recorder = std::make_shared<sdk::SlowLogRecorder>();
+  Operation::Result result;
+  {
+    sdk::ScopedSlowLogRecorder scoped(recorder);
+    result = execute();
+  }
+  phases = recorder->Phases();
+  // sdk tasks are not root of the request now, keep slow log working
+  sdk::SlowLog::Global().Finish(FLAGS_benchmark, *recorder, result.eplased_time, result.status);
+  return result;
+}
+
+void Benchmark::AddResult(const Operation::Result& result, size_t latency_us, const sdk::SlowLogPhases& phases) {
+  if (chaos_inject_us_.load(std::memory_order_relaxed) > 0) {
+    RecordChaosResult(result.status.ok(), latency_us);
+  }
+
+  std::lock_guard lock(mutex_);
+  if (result.status.ok()) {
+    stats_interval_->Add(latency_us, result.write_bytes, result.read_bytes, result.recalls);
+    stats_cumulative_->Add(latency_us, result.write_bytes, result.read_bytes, result.recalls);
+    if (FLAGS_latency_breakdown) {
+      stats_interval_->AddPhases(phases);
+      stats_cumulative_->AddPhases(phases);
+    }
+  } else {
+    stats_interval_->AddError();
+    stats_cumulative_->AddError();
+  }
+}
+
 void Benchmark::IntervalReport() {
   size_t delay_ms = FLAGS_delay * 1000;
   size_t start_time = dingodb::benchmark::TimestampMs();
@@ -802,6 +1560,8 @@ void Benchmark::IntervalReport() {
   for (;;) {
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
 
+    CheckProfile(dingodb::benchmark::TimestampMs() - cumulative_start_time);
+
     size_t milliseconds = dingodb::benchmark::TimestampMs() - start_time;
     if (milliseconds > delay_ms) {
       Report(false, milliseconds);
@@ -810,13 +1570,90 @@ void Benchmark::IntervalReport() {
 
     // Check time limit
     if (FLAGS_timelimit > 0 && dingodb::benchmark::TimestampMs() - cumulative_start_time > FLAGS_timelimit * 1000) {
-      Stop();
+      StopThreads();
     }
 
     if (IsStop()) {
       break;
     }
   }
+
+  StopProfile();
+}
+
+void Benchmark::CheckProfile(size_t elapsed_ms) {
+  if (FLAGS_cpu_profile_file.empty() && FLAGS_heap_profile_prefix.empty()) {
+    return;
+  }
+
+  if (!is_profiled_ && !is_profiling_ && elapsed_ms >= FLAGS_profile_delay_s * 1000) {
+    StartProfile();
+    return;
+  }
+  if (!is_profiling_) {
+    return;
+  }
+
+  size_t profile_ms = elapsed_ms - FLAGS_profile_delay_s * 1000;
+  if (FLAGS_profile_duration_s > 0 && profile_ms >= FLAGS_profile_duration_s * 1000) {
+    StopProfile();
+    return;
+  }
+
+  size_t heap_dump_interval_ms = FLAGS_heap_profile_interval_s * 1000;
+  if (is_heap_profiling_ && heap_dump_interval_ms > 0 && profile_ms - last_heap_dump_ms_ >= heap_dump_interval_ms) {
+    auto status = client_->DumpHeapProfile();
+    if (!status.IsOK()) {
+      LOG(ERROR) << fmt::format("dump heap profile failed, error: {}", status.ToString());
+    }
+    last_heap_dump_ms_ = profile_ms;
+  }
+}
+
+void Benchmark::StartProfile() {
+  // profile only the first run, e.g. the first point of vector sweep, later runs would overwrite it
+  is_profiled_ = true;
+  is_profiling_ = true;
+  last_heap_dump_ms_ = 0;
+
+  if (!FLAGS_cpu_profile_file.empty()) {
+    auto status = client_->StartCpuProfile(FLAGS_cpu_profile_file);
+    is_cpu_profiling_ = status.IsOK();
+    if (!status.IsOK()) {
+      LOG(ERROR) << fmt::format("start cpu profile failed, error: {}", status.ToString());
+    }
+  }
+
+  if (!FLAGS_heap_profile_prefix.empty()) {
+    auto status = client_->StartHeapProfile(FLAGS_heap_profile_prefix);
+    is_heap_profiling_ = status.IsOK();
+    if (!status.IsOK()) {
+      LOG(ERROR) << fmt::format("start heap profile failed, error: {}", status.ToString());
+    }
+  }
+}
+
+void Benchmark::StopProfile() {
+  if (!is_profiling_) {
+    return;
+  }
+  is_profiling_ = false;
+
+  if (is_cpu_profiling_) {
+    client_->StopCpuProfile();
+    is_cpu_profiling_ = false;
+    std::cout << fmt::format("Cpu profile is written to {}", FLAGS_cpu_profile_file) << '\n';
+  }
+
+  if (is_heap_profiling_) {
+    auto status = client_->DumpHeapProfile();
+    if (!status.IsOK()) {
+      LOG(ERROR) << fmt::format("dump heap profile failed, error: {}", status.ToString());
+    }
+    client_->StopHeapProfile();
+    is_heap_profiling_ = false;
+    std::cout << fmt::format("Heap profiles are written to {}.*.heap", FLAGS_heap_profile_prefix) << '\n';
+  }
 }
 
 void Benchmark::Report(bool is_cumulative, size_t milliseconds) {
@@ -824,13 +1661,322 @@ void Benchmark::Report(bool is_cumulative, size_t milliseconds) {
 
   if (is_cumulative) {
     stats_cumulative_->Report(true, milliseconds);
+    if (FLAGS_latency_breakdown) {
+      stats_cumulative_->ReportPhases();
+    }
+    if (report_file_.is_open()) {
+      report_file_ << stats_cumulative_->Format(true, milliseconds) << '\n';
+      report_file_.flush();
+    }
     stats_interval_->Clear();
   } else {
     stats_interval_->Report(false, milliseconds);
+    if (report_file_.is_open()) {
+      report_file_ << stats_interval_->Format(false, milliseconds) << '\n';
+      report_file_.flush();
+    }
     stats_interval_->Clear();
   }
 }
 
+void Benchmark::LaunchBackgroundWrite() {
+  if (background_operation_ == nullptr) {
+    return;
+  }
+
+  if (FLAGS_background_write_qps > 0) {
+    background_arrival_schedule_ = std::make_unique<ArrivalSchedule>(FLAGS_background_write_qps, false);
+  }
+
+  background_thread_entries_.reserve(FLAGS_background_write_concurrency);
+  for (int i = 0; i < FLAGS_background_write_concurrency; ++i) {
+    auto thread_entry = std::make_shared<ThreadEntry>();
+    thread_entry->client = client_;
+    thread_entry->region_entries = region_entries_;
+    thread_entry->vector_index_entries = vector_index_entries_;
+
+    thread_entry->thread = std::thread(
+        [this](ThreadEntryPtr thread_entry) mutable { BackgroundWriteRoutine(thread_entry); }, thread_entry);
+    background_thread_entries_.push_back(thread_entry);
+  }
+}
+
+void Benchmark::StopBackgroundWrite() {
+  for (auto& thread_entry : background_thread_entries_) {
+    thread_entry->is_stop.store(true, std::memory_order_relaxed);
+  }
+  for (auto& thread_entry : background_thread_entries_) {
+    thread_entry->thread.join();
+  }
+}
+
+void Benchmark::BackgroundWriteRoutine(ThreadEntryPtr thread_entry) {
+  BlockSignal();
+
+  std::vector<std::function<Operation::Result()>> executes;
+  for (const auto& region_entry : thread_entry->region_entries) {
+    executes.push_back([this, region_entry]() { return background_operation_->Execute(region_entry); });
+  }
+  for (const auto& vector_index_entry : thread_entry->vector_index_entries) {
+    executes.push_back([this, vector_index_entry]() { return background_operation_->Execute(vector_index_entry); });
+  }
+
+  // runs till the requests are done, not bounded by req_num
+  while (!thread_entry->is_stop.load(std::memory_order_relaxed)) {
+    for (const auto& execute : executes) {
+      if (thread_entry->is_stop.load(std::memory_order_relaxed)) {
+        break;
+      }
+      if (background_arrival_schedule_ != nullptr) {
+        background_arrival_schedule_->WaitNext();
+      }
+
+      auto result = execute();
+      std::lock_guard lock(mutex_);
+      if (result.status.ok()) {
+        stats_background_->Add(result.eplased_time, result.write_bytes, result.read_bytes);
+      } else {
+        stats_background_->AddError();
+      }
+    }
+  }
+}
+
+void Benchmark::ReportBackgroundWrite(size_t milliseconds) {
+  if (background_operation_ == nullptr) {
+    return;
+  }
+
+  std::lock_guard lock(mutex_);
+  double seconds = std::max<size_t>(milliseconds, 1) / static_cast<double>(1000);
+  const auto& latency = stats_background_->Latency();
+  std::cout << COLOR_GREEN << fmt::format("Background write({}):", FLAGS_background_write) << COLOR_RESET << '\n';
+  std::cout << COLOR_GREEN
+            << fmt::format("{:>8}{:>8}{:>8}{:>16}{:>8}{:>8}{:>8}{:>8}", "REQ_NUM", "ERRORS", "QPS", "LATENCY AVG(us)",
+                           "P50(us)", "P95(us)", "P99(us)", "MAX(us)")
+            << COLOR_RESET << '\n';
+  std::cout << fmt::format("{:>8}{:>8}{:>8.0f}{:>16.0f}{:>8}{:>8}{:>8}{:>8}", stats_background_->ReqNum(),
+                           stats_background_->ErrorCount(), stats_background_->ReqNum() / seconds, latency.Mean(),
+                           latency.ValueAtPercentile(50), latency.ValueAtPercentile(95),
+                           latency.ValueAtPercentile(99), latency.Max())
+            << '\n';
+}
+
+void Benchmark::LaunchChaos(size_t start_time_ms) {
+  if (FLAGS_chaos_action.empty() && FLAGS_chaos_command.empty()) {
+    return;
+  }
+
+  is_chaos_stop_.store(false);
+  chaos_thread_ = std::thread([this, start_time_ms]() {
+    BlockSignal();
+    ChaosRoutine(start_time_ms);
+  });
+}
+
+void Benchmark::StopChaos() {
+  is_chaos_stop_.store(true);
+  if (chaos_thread_.joinable()) {
+    chaos_thread_.join();
+  }
+}
+
+bool Benchmark::ChaosSleep(int64_t milliseconds) {
+  int64_t end_ms = dingodb::benchmark::TimestampMs() + milliseconds;
+  while (!is_chaos_stop_.load()) {
+    if (dingodb::benchmark::TimestampMs() >= end_ms) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+void Benchmark::ChaosRoutine(size_t start_time_ms) {
+  while (ChaosSleep(FLAGS_chaos_interval_s * 1000)) {
+    int64_t slow_us = std::numeric_limits<int64_t>::max();
+    {
+      // requests before the fault set the bar of recovered
+      std::lock_guard lock(mutex_);
+      if (stats_cumulative_->ReqNum() > 0) {
+        slow_us = static_cast<int64_t>(stats_cumulative_->Latency().ValueAtPercentile(99) *
+                                       FLAGS_chaos_recover_latency_factor);
+      }
+    }
+    chaos_slow_us_.store(slow_us);
+    chaos_last_bad_us_.store(0);
+    chaos_last_good_us_.store(0);
+    chaos_errors_.store(0);
+    chaos_slow_reqs_.store(0);
+
+    ChaosEvent event;
+    event.inject_ms = dingodb::benchmark::TimestampMs() - start_time_ms;
+    // requests failing during the injection count
+    int64_t inject_us = dingodb::benchmark::TimestampUs();
+    chaos_inject_us_.store(inject_us);
+    if (!InjectChaos(event.action)) {
+      chaos_inject_us_.store(0);
+      continue;
+    }
+
+    WaitRecover(inject_us, event);
+    chaos_inject_us_.store(0);
+    event.errors = chaos_errors_.load();
+    event.slow_reqs = chaos_slow_reqs_.load();
+
+    std::string recover =
+        event.recover_ms < 0 ? "not recovered" : fmt::format("recovered in {}ms", event.recover_ms);
+    std::string line = fmt::format("Chaos: {} at {}ms, {}, errors {}, slow requests {}", event.action,
+                                   event.inject_ms, recover, event.errors, event.slow_reqs);
+    std::cout << COLOR_YELLOW << line << COLOR_RESET << '\n';
+    LOG(INFO) << line;
+    chaos_events_.push_back(event);
+  }
+}
+
+bool Benchmark::InjectChaos(std::string& action) {
+  if (FLAGS_chaos_action == "transfer_leader") {
+    TransferRandomLeader(action);
+  }
+
+  if (!FLAGS_chaos_command.empty()) {
+    int ret = std::system(FLAGS_chaos_command.c_str());
+    if (ret != 0) {
+      LOG(ERROR) << fmt::format("chaos command failed, ret: {}, command: {}", ret, FLAGS_chaos_command);
+    } else {
+      action += action.empty() ? "command" : "+command";
+    }
+  }
+
+  return !action.empty();
+}
+
+std::vector<int64_t> Benchmark::ChaosRegionIds() {
+  std::vector<int64_t> region_ids;
+  for (const auto& region_entry : region_entries_) {
+    region_ids.push_back(region_entry->region_id);
+    if (region_entry->txn_region_id != 0) {
+      region_ids.push_back(region_entry->txn_region_id);
+    }
+  }
+
+  if (IsVectorBenchmark()) {
+    for (const auto& vector_index_entry : vector_index_entries_) {
+      std::shared_ptr<sdk::VectorIndex> vector_index;
+      auto status = client_stub_->GetVectorIndexCache()->GetVectorIndexById(vector_index_entry->index_id, vector_index);
+      if (!status.ok()) {
+        LOG(ERROR) << fmt::format("get vector index {} failed, {}", vector_index_entry->index_id, status.ToString());
+        continue;
+      }
+
+      for (int64_t part_id : vector_index->GetPartitionIds()) {
+        std::vector<std::shared_ptr<sdk::Region>> regions;
+        status = vector_index->GetPartitionRegions(*client_stub_->GetMetaCache(), part_id, regions);
+        if (!status.ok()) {
+          continue;
+        }
+        for (const auto& region : regions) {
+          region_ids.push_back(region->RegionId());
+        }
+      }
+    }
+  }
+
+  return region_ids;
+}
+
+bool Benchmark::TransferRandomLeader(std::string& action) {
+  auto region_ids = ChaosRegionIds();
+  if (region_ids.empty()) {
+    LOG(ERROR) << "no region to transfer leader";
+    return false;
+  }
+  int64_t region_id = region_ids[dingodb::benchmark::GenerateRealRandomInteger(0, region_ids.size() - 1)];
+
+  sdk::QueryRegionRpc query_rpc;
+  query_rpc.MutableRequest()->set_region_id(region_id);
+  auto status = client_stub_->GetCoordinatorRpcController()->SyncCall(query_rpc);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("query region {} failed, {}", region_id, status.ToString());
+    return false;
+  }
+
+  const auto& region = query_rpc.Response()->region();
+  std::vector<int64_t> store_ids;
+  for (const auto& peer : region.definition().peers()) {
+    if (peer.store_id() != region.leader_store_id()) {
+      store_ids.push_back(peer.store_id());
+    }
+  }
+  if (store_ids.empty()) {
+    LOG(ERROR) << fmt::format("region {} has no follower to transfer leader to", region_id);
+    return false;
+  }
+  int64_t store_id = store_ids[dingodb::benchmark::GenerateRealRandomInteger(0, store_ids.size() - 1)];
+
+  sdk::TransferLeaderRegionRpc rpc;
+  rpc.MutableRequest()->set_region_id(region_id);
+  rpc.MutableRequest()->set_leader_store_id(store_id);
+  status = client_stub_->GetCoordinatorRpcController()->SyncCall(rpc);
+  if (!status.ok()) {
+    LOG(ERROR) << fmt::format("transfer leader of region {} to store {} failed, {}", region_id, store_id,
+                              status.ToString());
+    return false;
+  }
+
+  action = fmt::format("transfer_leader(region {} store {}->{})", region_id, region.leader_store_id(), store_id);
+  return true;
+}
+
+void Benchmark::RecordChaosResult(bool is_ok, size_t latency_us) {
+  int64_t now_us = dingodb::benchmark::TimestampUs();
+  if (!is_ok) {
+    chaos_errors_.fetch_add(1);
+    chaos_last_bad_us_.store(now_us);
+  } else if (static_cast<int64_t>(latency_us) > chaos_slow_us_.load()) {
+    chaos_slow_reqs_.fetch_add(1);
+    chaos_last_bad_us_.store(now_us);
+  } else {
+    chaos_last_good_us_.store(now_us);
+  }
+}
+
+void Benchmark::WaitRecover(int64_t inject_us, ChaosEvent& event) {
+  // give up at the time of the next injection
+  int64_t deadline_us = inject_us + static_cast<int64_t>(FLAGS_chaos_interval_s) * 1000000;
+  int64_t window_us = static_cast<int64_t>(FLAGS_chaos_recover_window_ms) * 1000;
+  do {
+    int64_t now_us = dingodb::benchmark::TimestampUs();
+    int64_t last_bad_us = chaos_last_bad_us_.load();
+    int64_t bad_end_us = std::max(last_bad_us, inject_us);
+    // at least one good request, threads all stuck in retry are not recovered
+    if (chaos_last_good_us_.load() > bad_end_us && now_us - bad_end_us >= window_us) {
+      event.recover_ms = last_bad_us > 0 ? (last_bad_us - inject_us) / 1000 : 0;
+      return;
+    }
+    if (now_us >= deadline_us) {
+      return;
+    }
+  } while (ChaosSleep(10));
+}
+
+void Benchmark::ReportChaos() {
+  if (chaos_events_.empty()) {
+    return;
+  }
+
+  std::cout << COLOR_GREEN << fmt::format("Chaos({} faults):", chaos_events_.size()) << COLOR_RESET << '\n';
+  std::cout << COLOR_GREEN
+            << fmt::format("{:>10}{:>14}{:>8}{:>8}  {}", "AT(ms)", "RECOVER(ms)", "ERRORS", "SLOW", "ACTION")
+            << COLOR_RESET << '\n';
+  for (const auto& event : chaos_events_) {
+    std::cout << fmt::format("{:>10}{:>14}{:>8}{:>8}  {}", event.inject_ms,
+                             event.recover_ms < 0 ? "n/a" : std::to_string(event.recover_ms), event.errors,
+                             event.slow_reqs, event.action)
+              << '\n';
+  }
+}
+
 Environment& Environment::GetInstance() {
   static Environment instance;
   return instance;
@@ -843,6 +1989,15 @@ bool Environment::Init() {
     return false;
   }
 
+  if (FLAGS_mock_server) {
+    std::string addrs;
+    if (!MockServer::GetInstance().Start(addrs)) {
+      std::cerr << "Start mock server failed, please check parameter --mock_server_port" << '\n';
+      return false;
+    }
+    FLAGS_coordinator_addrs = addrs;
+  }
+
   DINGO_LOG(INFO) << "using FLAGS_coordinator_addrs: " << FLAGS_coordinator_addrs;
 
   client_stub_ = std::make_shared<dingodb::sdk::ClientStub>();
@@ -920,6 +2075,44 @@ void Environment::PrintParam() {
   std::cout << fmt::format("{:<34}: {:>32}", "req_num", FLAGS_req_num) << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "delay(s)", FLAGS_delay) << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "timelimit(s)", FLAGS_timelimit) << '\n';
+  std::cout << fmt::format("{:<34}: {:>32}", "load_mode", FLAGS_load_mode) << '\n';
+  if (FLAGS_load_mode == "open") {
+    std::cout << fmt::format("{:<34}: {:>32}", "target_qps", FLAGS_target_qps) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "arrival", FLAGS_arrival) << '\n';
+  }
+  if (FLAGS_mock_server) {
+    std::cout << fmt::format("{:<34}: {:>32}", "mock_server", FLAGS_coordinator_addrs) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "mock_server_latency_us", FLAGS_mock_server_latency_us) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "mock_server_not_leader_ratio", FLAGS_mock_server_not_leader_ratio)
+              << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "mock_server_region_version_ratio",
+                             FLAGS_mock_server_region_version_ratio)
+              << '\n';
+  }
+  std::cout << fmt::format("{:<34}: {:>32}", "report_file", FLAGS_report_file) << '\n';
+  std::cout << fmt::format("{:<34}: {:>32}", "latency_breakdown", FLAGS_latency_breakdown ? "true" : "false") << '\n';
+  std::cout << fmt::format("{:<34}: {:>32}", "report_format", FLAGS_report_format) << '\n';
+  if (!FLAGS_background_write.empty()) {
+    std::cout << fmt::format("{:<34}: {:>32}", "background_write", FLAGS_background_write) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "background_write_concurrency", FLAGS_background_write_concurrency)
+              << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "background_write_qps", FLAGS_background_write_qps) << '\n';
+  }
+  if (!FLAGS_chaos_action.empty() || !FLAGS_chaos_command.empty()) {
+    std::cout << fmt::format("{:<34}: {:>32}", "chaos_action", FLAGS_chaos_action) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "chaos_command", FLAGS_chaos_command) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "chaos_interval_s", FLAGS_chaos_interval_s) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "chaos_recover_latency_factor", FLAGS_chaos_recover_latency_factor)
+              << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "chaos_recover_window_ms", FLAGS_chaos_recover_window_ms) << '\n';
+  }
+  // empty backend is the one sdk is built with
+  auto rpc_backend = [](const std::string& backend) -> std::string {
+    return backend.empty() ? sdk::NativeRpcBackend() : backend;
+  };
+  std::cout << fmt::format("{:<34}: {:>32}", "store_rpc_backend", rpc_backend(FLAGS_store_rpc_backend)) << '\n';
+  std::cout << fmt::format("{:<34}: {:>32}", "coordinator_rpc_backend", rpc_backend(FLAGS_coordinator_rpc_backend))
+            << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "key_size(byte)", FLAGS_key_size) << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "value_size(byte)", FLAGS_value_size) << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "batch_size", FLAGS_batch_size) << '\n';
@@ -927,6 +2120,45 @@ void Environment::PrintParam() {
             << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "is_pessimistic_txn", FLAGS_is_pessimistic_txn ? "true" : "false") << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "txn_isolation_level", FLAGS_vector_search_topk) << '\n';
+  if (FLAGS_benchmark == "mixed") {
+    std::cout << fmt::format("{:<34}: {:>32}", "ycsb_workload", FLAGS_ycsb_workload) << '\n';
+    if (FLAGS_ycsb_workload.empty()) {
+      std::cout << fmt::format("{:<34}: {:>32}", "mixed_read_ratio", FLAGS_mixed_read_ratio) << '\n';
+      std::cout << fmt::format("{:<34}: {:>32}", "mixed_update_ratio", FLAGS_mixed_update_ratio) << '\n';
+      std::cout << fmt::format("{:<34}: {:>32}", "mixed_insert_ratio", FLAGS_mixed_insert_ratio) << '\n';
+      std::cout << fmt::format("{:<34}: {:>32}", "mixed_scan_ratio", FLAGS_mixed_scan_ratio) << '\n';
+      std::cout << fmt::format("{:<34}: {:>32}", "mixed_rmw_ratio", FLAGS_mixed_rmw_ratio) << '\n';
+      std::cout << fmt::format("{:<34}: {:>32}", "mixed_txn_ratio", FLAGS_mixed_txn_ratio) << '\n';
+      std::cout << fmt::format("{:<34}: {:>32}", "mixed_key_distribution", FLAGS_mixed_key_distribution) << '\n';
+    }
+    std::cout << fmt::format("{:<34}: {:>32}", "zipfian_constant", FLAGS_zipfian_constant) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "mixed_scan_max_len", FLAGS_mixed_scan_max_len) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "mixed_txn_key_num", FLAGS_mixed_txn_key_num) << '\n';
+  }
+  bool is_scan = FLAGS_benchmark == "scanseq" || FLAGS_benchmark == "scanrandom" || FLAGS_benchmark == "scantxnseq" ||
+                 FLAGS_benchmark == "scantxnrandom";
+  if (is_scan || FLAGS_benchmark == "deleterange") {
+    std::cout << fmt::format("{:<34}: {:>32}", "scan_range_width", FLAGS_scan_range_width) << '\n';
+  }
+  if (is_scan) {
+    std::cout << fmt::format("{:<34}: {:>32}", "scan_limit", FLAGS_scan_limit) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "scan_key_only", FLAGS_scan_key_only ? "true" : "false") << '\n';
+  }
+  if (IsDocumentBenchmark()) {
+    std::cout << fmt::format("{:<34}: {:>32}", "document_search_topn", FLAGS_document_search_topn) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "document_search_column_names", FLAGS_document_search_column_names)
+              << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "document_scan_query_count", FLAGS_document_scan_query_count) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "document_word_num", FLAGS_document_word_num) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "document_vocabulary_size", FLAGS_document_vocabulary_size) << '\n';
+  }
+  if (FLAGS_benchmark == "txncontention") {
+    std::cout << fmt::format("{:<34}: {:>32}", "txn_hot_key_num", FLAGS_txn_hot_key_num) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "txn_contention_key_num", FLAGS_txn_contention_key_num) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "txn_rmw_ratio", FLAGS_txn_rmw_ratio) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "txn_key_distribution", FLAGS_txn_key_distribution) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "zipfian_constant", FLAGS_zipfian_constant) << '\n';
+  }
 
   std::cout << fmt::format("{:<34}: {:>32}", "vector_dimension", FLAGS_vector_dimension) << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "vector_value_type", FLAGS_vector_value_type) << '\n';
@@ -957,6 +2189,22 @@ void Environment::PrintParam() {
   std::cout << fmt::format("{:<34}: {:>32}", "vector_search_radius", FLAGS_vector_search_radius) << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "vector_search_nprobe", FLAGS_vector_search_nprobe) << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "vector_search_ef", FLAGS_vector_search_ef) << '\n';
+  if (IsVectorSweepBenchmark()) {
+    std::cout << fmt::format("{:<34}: {:>32}", "vector_search_sweep_ef", FLAGS_vector_search_sweep_ef) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "vector_search_sweep_nprobe", FLAGS_vector_search_sweep_nprobe)
+              << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "vector_search_sweep_topk", FLAGS_vector_search_sweep_topk) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "vector_search_sweep_filter_type",
+                             FLAGS_vector_search_sweep_filter_type)
+              << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "vector_sweep_result_file", FLAGS_vector_sweep_result_file) << '\n';
+  }
+  if (FLAGS_autotune) {
+    std::cout << fmt::format("{:<34}: {:>32}", "autotune_max_concurrency", FLAGS_autotune_max_concurrency) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "autotune_batch_sizes", FLAGS_autotune_batch_sizes) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "autotune_p99_budget_us", FLAGS_autotune_p99_budget_us) << '\n';
+    std::cout << fmt::format("{:<34}: {:>32}", "autotune_plateau_ratio", FLAGS_autotune_plateau_ratio) << '\n';
+  }
   std::cout << '\n';
 }
 
@@ -18,32 +18,62 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "benchmark/dataset.h"
+#include "benchmark/hdr_histogram.h"
 #include "benchmark/operation.h"
 #include "bvar/latency_recorder.h"
 #include "sdk/client.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/slow_log.h"
 
 namespace dingodb {
 namespace benchmark {
 
 class Stats {
  public:
+  // phases of sdk::SlowLogPhases, client/queue/rpc/response/merge
+  static constexpr int kPhaseNum = 5;
+  static const char* PhaseName(int phase);
+
   Stats();
   ~Stats() = default;
 
   void Add(size_t duration, size_t write_bytes, size_t read_bytes);
   void Add(size_t duration, size_t write_bytes, size_t read_bytes, const std::vector<uint32_t>& recalls);
   void AddError();
+  void AddPhases(const sdk::SlowLogPhases& phases);
 
   void Clear();
 
+  // counters and histograms of other, e.g. stats of distributed workers, recall is not merged
+  void Merge(const Stats& other);
+  // text of counters and histograms, shipped by distributed workers, see distributed.h
+  std::string Encode() const;
+  // counters and histograms are overwritten, false when text is not made by Encode
+  bool Decode(const std::string& text);
+
   void Report(bool is_cumulative, size_t milliseconds) const;
+  // percentiles of every phase added by AddPhases
+  void ReportPhases() const;
+
+  // one line of FLAGS_report_format
+  std::string Format(bool is_cumulative, size_t milliseconds) const;
+  static std::string FormatHeader();
+
+  size_t ReqNum() const { return req_num_; }
+  size_t ErrorCount() const { return error_count_; }
+  const HdrHistogram& Latency() const { return latency_histogram_; }
+  // percent, 0 without recall
+  double RecallAvg() const { return recall_recorder_->latency() / 100.0; }
 
  private:
   static std::string Header();
@@ -53,16 +83,89 @@ class Stats {
   size_t write_bytes_{0};
   size_t read_bytes_{0};
   size_t error_count_{0};
-  std::shared_ptr<bvar::LatencyRecorder> latency_recorder_;
+  // latency in us
+  HdrHistogram latency_histogram_;
   std::shared_ptr<bvar::LatencyRecorder> recall_recorder_;
+  // phase latency in us
+  HdrHistogram phase_histograms_[kPhaseNum];
+  size_t phase_req_num_{0};
 };
 
 using StatsPtr = std::shared_ptr<Stats>;
 using MultiStats = std::vector<StatsPtr>;
 
+// Start times of requests in open load mode, shared by all threads, see FLAGS_load_mode.
+// Latency counts from the start time rather than from the send, so a request
+// waiting for a busy thread is still measured and a slow server cannot hide its
+// latency by slowing the senders down (coordinated omission).
+class ArrivalSchedule {
+ public:
+  ArrivalSchedule(uint32_t qps, bool is_poisson);
+  ~ArrivalSchedule() = default;
+
+  // sleep until the start time of the next request, return it in us
+  int64_t WaitNext();
+
+ private:
+  std::mutex mutex_;
+  double next_us_;
+  double interval_us_;
+  bool is_poisson_;
+  std::mt19937_64 gen_;
+  std::exponential_distribution<double> exponential_;
+};
+
+// One search parameter combination of vector search sweep and what it got.
+struct VectorSweepPoint {
+  uint32_t ef{0};
+  uint32_t nprobe{0};
+  uint32_t topk{0};
+  std::string filter_type;
+
+  size_t req_num{0};
+  size_t error_count{0};
+  double qps{0};
+  // percent
+  double recall{0};
+  // latency in us
+  int64_t latency_p50{0};
+  int64_t latency_p95{0};
+  int64_t latency_p99{0};
+  int64_t latency_p999{0};
+};
+
+// One concurrency and batch size step of auto tune and what it got.
+struct AutotunePoint {
+  uint32_t concurrency{0};
+  uint32_t batch_size{0};
+
+  size_t req_num{0};
+  size_t error_count{0};
+  double qps{0};
+  // latency in us
+  int64_t latency_p50{0};
+  int64_t latency_p99{0};
+  // no error and p99 within FLAGS_autotune_p99_budget_us
+  bool is_ok{true};
+};
+
+// One fault injected by FLAGS_chaos_action or FLAGS_chaos_command and how requests recovered from it.
+struct ChaosEvent {
+  std::string action;
+  // since requests started
+  size_t inject_ms{0};
+  // from the injection to the last failed or slow request before FLAGS_chaos_recover_window_ms of good ones,
+  // -1 when not recovered before the next injection
+  int64_t recover_ms{-1};
+  size_t errors{0};
+  size_t slow_reqs{0};
+};
+
 // region info
 struct RegionEntry {
   int64_t region_id;
+  // txn region of the same prefix, only created by mixed benchmark with transaction ratio
+  int64_t txn_region_id{0};
   // range: [prefix, prefix+1)
   std::string prefix;
 
@@ -77,7 +180,7 @@ struct RegionEntry {
 };
 using RegionEntryPtr = std::shared_ptr<RegionEntry>;
 
-// vector index info
+// vector index info, document benchmarks use it for document index
 struct VectorIndexEntry {
   int64_t index_id;
 
@@ -112,6 +215,14 @@ class Benchmark {
 
   bool Run();
 
+  // steps of Run driven one by one by a distributed worker, see distributed.h
+  bool RunArrange();
+  // run requests till done, return elapsed ms
+  size_t RunRequests();
+  void RunClean();
+  // see Stats::Encode
+  std::string EncodeCumulativeStats();
+
  private:
   bool Arrange();
 
@@ -125,6 +236,18 @@ class Benchmark {
   void Launch();
   void Wait();
 
+  // clear stats and run requests of the current flags once, without background write and chaos, return elapsed ms
+  size_t RunRound();
+
+  // run searchvector once per combination of FLAGS_vector_search_sweep_*, no interval report
+  void RunVectorSweep();
+  void ReportVectorSweep(const std::vector<VectorSweepPoint>& points);
+
+  // run once per step of doubling concurrency for every batch size of FLAGS_autotune_batch_sizes, the ramp of a batch
+  // size stops at the throughput plateau or over the p99 budget
+  void RunAutotune();
+  void ReportAutotune(const std::vector<AutotunePoint>& points);
+
   void Clean();
 
   int64_t CreateRawRegion(const std::string& name, const std::string& start_key, const std::string& end_key,
@@ -137,17 +260,60 @@ class Benchmark {
   void DropVectorIndex(int64_t vector_index_id);
   int64_t GetVectorIndex(const std::string& name);
 
+  int64_t CreateDocumentIndex(const std::string& name);
+  void DropDocumentIndex(int64_t document_index_id);
+  int64_t GetDocumentIndex(const std::string& name);
+
   void ThreadRoutine(ThreadEntryPtr thread_entry);
 
   void ExecutePerRegion(ThreadEntryPtr thread_entry);
   void ExecuteMultiRegion(ThreadEntryPtr thread_entry);
   void ExecutePerVectorIndex(ThreadEntryPtr thread_entry);
 
+  // stop the running threads only, timelimit of one round
+  void StopThreads();
   bool IsStop();
 
+  // start time of the next request in us, wait for it in open load mode
+  int64_t WaitArrival();
+  // latency of open load mode counts from the start time
+  size_t LatencyUs(int64_t start_time_us, const Operation::Result& result) const;
+  // run one request, its phases are filled when FLAGS_latency_breakdown is set
+  Operation::Result ExecuteRequest(const std::function<Operation::Result()>& execute, sdk::SlowLogPhases& phases);
+  // record the result of one request into interval and cumulative stats
+  void AddResult(const Operation::Result& result, size_t latency_us, const sdk::SlowLogPhases& phases);
+
   void IntervalReport();
   void Report(bool is_cumulative, size_t milliseconds);
 
+  // write load of FLAGS_background_write run by own threads beside the requests, till the requests are done
+  void LaunchBackgroundWrite();
+  void StopBackgroundWrite();
+  void BackgroundWriteRoutine(ThreadEntryPtr thread_entry);
+  void ReportBackgroundWrite(size_t milliseconds);
+
+  // inject a fault every FLAGS_chaos_interval_s, then wait for the requests to recover from it
+  void LaunchChaos(size_t start_time_ms);
+  void StopChaos();
+  void ChaosRoutine(size_t start_time_ms);
+  // false when nothing is injected
+  bool InjectChaos(std::string& action);
+  bool TransferRandomLeader(std::string& action);
+  // regions of the benchmark, leader of one of them is transferred
+  std::vector<int64_t> ChaosRegionIds();
+  void WaitRecover(int64_t inject_us, ChaosEvent& event);
+  // false when chaos is stopped during the sleep
+  bool ChaosSleep(int64_t milliseconds);
+  // foreground requests finished since the injection
+  void RecordChaosResult(bool is_ok, size_t latency_us);
+  void ReportChaos();
+
+  // cpu and heap profiles of FLAGS_cpu_profile_file and FLAGS_heap_profile_prefix, driven by the interval report
+  // thread with the time since requests started
+  void CheckProfile(size_t elapsed_ms);
+  void StartProfile();
+  void StopProfile();
+
   std::shared_ptr<dingodb::sdk::ClientStub> client_stub_;
   std::shared_ptr<sdk::Client> client_;
   OperationPtr operation_;
@@ -158,9 +324,40 @@ class Benchmark {
   std::vector<VectorIndexEntryPtr> vector_index_entries_;
   std::vector<ThreadEntryPtr> thread_entries_;
 
+  std::unique_ptr<ArrivalSchedule> arrival_schedule_;
+
+  // set by Stop, so vector sweep and auto tune do not launch the next round
+  std::atomic<bool> is_stopped_{false};
+
+  // only touched by the interval report thread
+  bool is_profiled_{false};
+  bool is_profiling_{false};
+  bool is_cpu_profiling_{false};
+  bool is_heap_profiling_{false};
+  size_t last_heap_dump_ms_{0};
+
+  OperationPtr background_operation_;
+  std::vector<ThreadEntryPtr> background_thread_entries_;
+  std::unique_ptr<ArrivalSchedule> background_arrival_schedule_;
+
+  std::thread chaos_thread_;
+  std::atomic<bool> is_chaos_stop_{false};
+  // start time of the fault being recovered in us, 0 means none
+  std::atomic<int64_t> chaos_inject_us_{0};
+  // requests slower than it are not recovered yet
+  std::atomic<int64_t> chaos_slow_us_{0};
+  std::atomic<int64_t> chaos_last_bad_us_{0};
+  std::atomic<int64_t> chaos_last_good_us_{0};
+  std::atomic<size_t> chaos_errors_{0};
+  std::atomic<size_t> chaos_slow_reqs_{0};
+  // only touched by the chaos thread till it is joined
+  std::vector<ChaosEvent> chaos_events_;
+
   std::mutex mutex_;
+  std::ofstream report_file_;
   StatsPtr stats_interval_;
   StatsPtr stats_cumulative_;
+  StatsPtr stats_background_;
 };
 using BenchmarkPtr = std::shared_ptr<Benchmark>;
 
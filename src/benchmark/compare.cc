@@ -0,0 +1,241 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/compare.h"
+
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "benchmark/color.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "rapidjson/document.h"
+
+DEFINE_string(compare_baseline_file, "", "Baseline report file of compare, written with --report_format=json");
+DEFINE_string(compare_current_file, "", "Current report file of compare, written with --report_format=json");
+DEFINE_double(compare_threshold, 5.0, "Delta in percent below which compare treats two runs as equal");
+
+namespace dingodb {
+namespace benchmark {
+
+// |t| of Welch's t-test over about 95% confidence
+static const double kSignificantT = 2.0;
+
+static const char* kLatencyMetrics[] = {"latency_avg_us", "latency_p50_us", "latency_p95_us", "latency_p99_us",
+                                        "latency_p999_us"};
+static const char* kPhaseMetrics[] = {"p50_us", "p99_us"};
+
+// one metric of one benchmark, interval reports are the samples of the t-test
+struct MetricSamples {
+  std::vector<double> intervals;
+  bool has_cumulative{false};
+  double cumulative{0};
+
+  // cumulative report if any, it covers the whole run
+  double Value() const {
+    if (has_cumulative || intervals.empty()) {
+      return cumulative;
+    }
+    double sum = 0;
+    for (double value : intervals) {
+      sum += value;
+    }
+    return sum / intervals.size();
+  }
+};
+
+// benchmark -> metric -> samples
+using RunMetrics = std::map<std::string, std::map<std::string, MetricSamples>>;
+
+static void AddSample(MetricSamples& samples, bool is_cumulative, double value) {
+  if (is_cumulative) {
+    // the last run wins when a file holds several runs of a benchmark
+    samples.has_cumulative = true;
+    samples.cumulative = value;
+  } else {
+    samples.intervals.push_back(value);
+  }
+}
+
+static bool LoadReportFile(const std::string& filepath, RunMetrics& run_metrics) {
+  std::ifstream ifs(filepath);
+  if (!ifs.is_open()) {
+    std::cerr << fmt::format("Open report file {} failed", filepath) << '\n';
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    rapidjson::Document doc;
+    doc.Parse(line.c_str());
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("type") || !doc.HasMember("qps")) {
+      std::cerr << fmt::format("Report file {} is not written with --report_format=json", filepath) << '\n';
+      return false;
+    }
+
+    std::string benchmark = doc.HasMember("benchmark") ? doc["benchmark"].GetString() : "unknown";
+    bool is_cumulative = std::string(doc["type"].GetString()) == "cumulative";
+    auto& metrics = run_metrics[benchmark];
+
+    AddSample(metrics["qps"], is_cumulative, doc["qps"].GetDouble());
+    for (const char* name : kLatencyMetrics) {
+      if (doc.HasMember(name)) {
+        AddSample(metrics[name], is_cumulative, doc[name].GetDouble());
+      }
+    }
+
+    if (doc.HasMember("phases") && doc["phases"].IsObject()) {
+      for (const auto& phase : doc["phases"].GetObject()) {
+        for (const char* name : kPhaseMetrics) {
+          if (phase.value.HasMember(name)) {
+            AddSample(metrics[fmt::format("phase_{}_{}", phase.name.GetString(), name)], is_cumulative,
+                      phase.value[name].GetDouble());
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+static void MeanVariance(const std::vector<double>& values, double& mean, double& variance) {
+  mean = 0;
+  for (double value : values) {
+    mean += value;
+  }
+  mean /= values.size();
+
+  variance = 0;
+  for (double value : values) {
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= (values.size() - 1);
+}
+
+// Welch's t of current against baseline, false when there are too few interval reports to tell
+static bool WelchT(const MetricSamples& baseline, const MetricSamples& current, double& t) {
+  if (baseline.intervals.size() < 2 || current.intervals.size() < 2) {
+    return false;
+  }
+
+  double baseline_mean, baseline_variance, current_mean, current_variance;
+  MeanVariance(baseline.intervals, baseline_mean, baseline_variance);
+  MeanVariance(current.intervals, current_mean, current_variance);
+
+  double error = std::sqrt(baseline_variance / baseline.intervals.size() +
+                           current_variance / current.intervals.size());
+  if (error == 0) {
+    // no noise at all, any difference is real
+    t = current_mean == baseline_mean ? 0 : (current_mean > baseline_mean ? HUGE_VAL : -HUGE_VAL);
+    return true;
+  }
+
+  t = (current_mean - baseline_mean) / error;
+  return true;
+}
+
+int BenchmarkCompare::Main() {
+  if (FLAGS_compare_baseline_file.empty() || FLAGS_compare_current_file.empty()) {
+    std::cerr << "compare need --compare_baseline_file and --compare_current_file." << '\n';
+    return 2;
+  }
+
+  RunMetrics baseline_metrics;
+  RunMetrics current_metrics;
+  if (!LoadReportFile(FLAGS_compare_baseline_file, baseline_metrics) ||
+      !LoadReportFile(FLAGS_compare_current_file, current_metrics)) {
+    return 2;
+  }
+
+  std::cout << COLOR_GREEN
+            << fmt::format("Compare {} against {}, threshold {}%:", FLAGS_compare_current_file,
+                           FLAGS_compare_baseline_file, FLAGS_compare_threshold)
+            << COLOR_RESET << '\n';
+  std::cout << COLOR_GREEN
+            << fmt::format("{:<20}{:<24}{:>14}{:>14}{:>12}{:>10}  {}", "BENCHMARK", "METRIC", "BASELINE", "CURRENT",
+                           "DELTA(%)", "T", "VERDICT")
+            << COLOR_RESET << '\n';
+
+  int regressions = 0;
+  for (const auto& [benchmark, metrics] : baseline_metrics) {
+    auto current_it = current_metrics.find(benchmark);
+    if (current_it == current_metrics.end()) {
+      std::cout << fmt::format("{:<20}not in current file", benchmark) << '\n';
+      continue;
+    }
+
+    for (const auto& [metric, baseline] : metrics) {
+      auto it = current_it->second.find(metric);
+      if (it == current_it->second.end()) {
+        continue;
+      }
+      const auto& current = it->second;
+
+      double baseline_value = baseline.Value();
+      double current_value = current.Value();
+      double delta = baseline_value == 0 ? 0 : (current_value - baseline_value) * 100 / baseline_value;
+      // qps is the only metric where higher is better
+      double worse_delta = metric == "qps" ? -delta : delta;
+
+      double t = 0;
+      bool has_t = WelchT(baseline, current, t);
+      bool significant = has_t && std::abs(t) >= kSignificantT;
+
+      std::string verdict = "~";
+      if (std::abs(delta) >= FLAGS_compare_threshold) {
+        if (!has_t) {
+          verdict = worse_delta > 0 ? "worse?" : "better?";
+        } else if (!significant) {
+          verdict = "noise";
+        } else if (worse_delta > 0) {
+          verdict = "REGRESSION";
+          ++regressions;
+        } else {
+          verdict = "improved";
+        }
+      }
+
+      std::string line =
+          fmt::format("{:<20}{:<24}{:>14.2f}{:>14.2f}{:>12.2f}{:>10}  {}", benchmark, metric, baseline_value,
+                      current_value, delta, has_t ? fmt::format("{:.2f}", t) : "-", verdict);
+      if (verdict == "REGRESSION") {
+        std::cout << COLOR_RED << line << COLOR_RESET << '\n';
+      } else {
+        std::cout << line << '\n';
+      }
+    }
+  }
+
+  for (const auto& [benchmark, metrics] : current_metrics) {
+    if (baseline_metrics.find(benchmark) == baseline_metrics.end()) {
+      std::cout << fmt::format("{:<20}not in baseline file", benchmark) << '\n';
+    }
+  }
+
+  std::cout << fmt::format("{} regressions", regressions) << '\n';
+  return regressions > 0 ? 1 : 0;
+}
+
+}  // namespace benchmark
+}  // namespace dingodb
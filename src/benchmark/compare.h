@@ -0,0 +1,35 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_BENCHMARK_COMPARE_H_
+#define DINGODB_BENCHMARK_COMPARE_H_
+
+namespace dingodb {
+namespace benchmark {
+
+// --benchmark=compare, compare two report files written with --report_format=json, e.g. runs of the sdk before and
+// after a change against --mock_server. Files may hold runs of several benchmarks, they are compared benchmark by
+// benchmark on qps, latency percentiles and phases of --latency_breakdown.
+// A delta is meaningful when it is over --compare_threshold percent and the interval reports of the two runs differ
+// by Welch's t-test, so a noisy run alone does not look like a regression.
+class BenchmarkCompare {
+ public:
+  // 0 when nothing regresses, 1 when something regresses, 2 when a file can not be read
+  static int Main();
+};
+
+}  // namespace benchmark
+}  // namespace dingodb
+
+#endif  // DINGODB_BENCHMARK_COMPARE_H_
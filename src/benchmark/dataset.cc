@@ -14,9 +14,15 @@
 
 #include "benchmark/dataset.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cerrno>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -69,7 +75,11 @@ namespace dingodb {
 namespace benchmark {
 
 std::shared_ptr<Dataset> Dataset::New(std::string filepath) {
-  if (filepath.find("sift") != std::string::npos) {
+  // converted one may keep the origin name, e.g. sift-128-euclidean
+  if (BinaryDataset::IsBinaryDataset(filepath)) {
+    return std::make_shared<BinaryDataset>(filepath);
+
+  } else if (filepath.find("sift") != std::string::npos) {
     return std::make_shared<SiftDataset>(filepath);
 
   } else if (filepath.find("glove") != std::string::npos) {
@@ -371,6 +381,191 @@ std::vector<float> BaseDataset::GetDistances(uint32_t index) {
   return buf;
 }
 
+static const uint32_t kBinaryHeaderSize = 2 * sizeof(uint32_t);
+
+BinaryDataset::~BinaryDataset() {
+  Unmap(train_.file);
+  Unmap(test_.file);
+  Unmap(groundtruth_);
+}
+
+bool BinaryDataset::IsBinaryDataset(const std::string& dirpath) {
+  return dingodb::benchmark::IsExistPath(fmt::format("{}/groundtruth.bin", dirpath));
+}
+
+bool BinaryDataset::Map(const std::string& filepath, MappedFile& file) {
+  int fd = open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    DINGO_LOG(ERROR) << fmt::format("open file {} failed, error: {}", filepath, strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < kBinaryHeaderSize) {
+    DINGO_LOG(ERROR) << fmt::format("file {} is too small or stat failed", filepath);
+    close(fd);
+    return false;
+  }
+
+  void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // mapping keeps the file referenced
+  close(fd);
+  if (addr == MAP_FAILED) {
+    DINGO_LOG(ERROR) << fmt::format("mmap file {} failed, error: {}", filepath, strerror(errno));
+    return false;
+  }
+
+  file.data = static_cast<const char*>(addr);
+  file.size = st.st_size;
+  return true;
+}
+
+void BinaryDataset::Unmap(MappedFile& file) {
+  if (file.data != nullptr) {
+    munmap(const_cast<char*>(file.data), file.size);
+    file.data = nullptr;
+    file.size = 0;
+  }
+}
+
+bool BinaryDataset::MapMatrix(const std::string& name, Matrix& matrix) {
+  std::string filepath = fmt::format("{}/{}.fbin", dirpath_, name);
+  bool is_uint8 = false;
+  if (!dingodb::benchmark::IsExistPath(filepath)) {
+    filepath = fmt::format("{}/{}.u8bin", dirpath_, name);
+    is_uint8 = true;
+  }
+  if (!Map(filepath, matrix.file)) {
+    return false;
+  }
+
+  memcpy(&matrix.row_count, matrix.file.data, sizeof(uint32_t));
+  memcpy(&matrix.dimension, matrix.file.data + sizeof(uint32_t), sizeof(uint32_t));
+  matrix.values = matrix.file.data + kBinaryHeaderSize;
+
+  size_t value_size = is_uint8 ? sizeof(uint8_t) : sizeof(float);
+  size_t expect_size = kBinaryHeaderSize + static_cast<size_t>(matrix.row_count) * matrix.dimension * value_size;
+  if (matrix.file.size < expect_size) {
+    DINGO_LOG(ERROR) << fmt::format("file {} is truncated, size({}) expect({})", filepath, matrix.file.size,
+                                    expect_size);
+    return false;
+  }
+
+  if (&matrix == &train_) {
+    is_uint8_ = is_uint8;
+  } else if (is_uint8 != is_uint8_) {
+    DINGO_LOG(ERROR) << fmt::format("file {} value type is different from train", filepath);
+    return false;
+  }
+
+  std::cout << fmt::format("dataset {} data_type({}) dimensions({}x{})", name, is_uint8 ? "uint8" : "float",
+                           matrix.row_count, matrix.dimension)
+            << '\n';
+  return true;
+}
+
+bool BinaryDataset::Init() {
+  if (!MapMatrix("train", train_) || !MapMatrix("test", test_)) {
+    return false;
+  }
+  if (train_.dimension != test_.dimension) {
+    DINGO_LOG(ERROR) << fmt::format("train dimension({}) is different from test({})", train_.dimension,
+                                    test_.dimension);
+    return false;
+  }
+  // train is read once from head to tail
+  madvise(const_cast<char*>(train_.file.data), train_.file.size, MADV_SEQUENTIAL);
+
+  std::string filepath = fmt::format("{}/groundtruth.bin", dirpath_);
+  if (!Map(filepath, groundtruth_)) {
+    return false;
+  }
+
+  uint32_t row_count = 0;
+  memcpy(&row_count, groundtruth_.data, sizeof(uint32_t));
+  memcpy(&groundtruth_k_, groundtruth_.data + sizeof(uint32_t), sizeof(uint32_t));
+  size_t expect_size =
+      kBinaryHeaderSize + static_cast<size_t>(row_count) * groundtruth_k_ * (sizeof(int32_t) + sizeof(float));
+  if (row_count != test_.row_count || groundtruth_.size < expect_size) {
+    DINGO_LOG(ERROR) << fmt::format("groundtruth rows({}) size({}) not match test rows({}) expect size({})", row_count,
+                                    groundtruth_.size, test_.row_count, expect_size);
+    return false;
+  }
+
+  std::cout << fmt::format("dataset groundtruth dimensions({}x{})", row_count, groundtruth_k_) << '\n';
+  return true;
+}
+
+uint32_t BinaryDataset::GetDimension() const { return train_.dimension; }
+uint32_t BinaryDataset::GetTrainDataCount() const { return train_.row_count; }
+uint32_t BinaryDataset::GetTestDataCount() const { return test_.row_count; }
+
+sdk::VectorWithId BinaryDataset::GetVector(const Matrix& matrix, uint32_t row) const {
+  sdk::VectorWithId vector_with_id;
+  vector_with_id.vector.dimension = matrix.dimension;
+
+  size_t offset = static_cast<size_t>(row) * matrix.dimension;
+  if (is_uint8_) {
+    vector_with_id.vector.value_type = sdk::ValueType::kUint8;
+    const auto* begin = reinterpret_cast<const uint8_t*>(matrix.values) + offset;
+    vector_with_id.vector.binary_values.assign(begin, begin + matrix.dimension);
+  } else {
+    vector_with_id.vector.value_type = sdk::ValueType::kFloat;
+    vector_with_id.vector.float_values.resize(matrix.dimension);
+    memcpy(vector_with_id.vector.float_values.data(), matrix.values + offset * sizeof(float),
+           matrix.dimension * sizeof(float));
+  }
+
+  return vector_with_id;
+}
+
+void BinaryDataset::GetBatchTrainData(uint32_t batch_num, std::vector<sdk::VectorWithId>& vector_with_ids,
+                                      bool& is_eof) {
+  uint64_t row_offset = static_cast<uint64_t>(batch_num) * FLAGS_vector_put_batch_size;
+  if (row_offset >= train_.row_count) {
+    is_eof = true;
+    return;
+  }
+
+  uint32_t batch_size = std::min<uint64_t>(FLAGS_vector_put_batch_size, train_.row_count - row_offset);
+  is_eof = batch_size < FLAGS_vector_put_batch_size;
+
+  vector_with_ids.reserve(vector_with_ids.size() + batch_size);
+  for (uint32_t i = 0; i < batch_size; ++i) {
+    auto vector_with_id = GetVector(train_, row_offset + i);
+    // same as hdf5, ids of neighbors start from 0
+    vector_with_id.id = row_offset + i + 1;
+    vector_with_ids.push_back(std::move(vector_with_id));
+  }
+}
+
+std::vector<Dataset::TestEntryPtr> BinaryDataset::GetTestData() {
+  const auto* ids = reinterpret_cast<const int32_t*>(groundtruth_.data + kBinaryHeaderSize);
+  const auto* distances = reinterpret_cast<const float*>(ids + static_cast<size_t>(test_.row_count) * groundtruth_k_);
+  uint32_t size = std::min(groundtruth_k_, FLAGS_vector_search_topk);
+
+  std::vector<Dataset::TestEntryPtr> test_entries;
+  test_entries.reserve(test_.row_count);
+  for (uint32_t i = 0; i < test_.row_count; ++i) {
+    auto test_entry = std::make_shared<Dataset::TestEntry>();
+    test_entry->vector_with_id = GetVector(test_, i);
+    test_entry->vector_with_id.id = 0;
+
+    size_t offset = static_cast<size_t>(i) * groundtruth_k_;
+    for (uint32_t j = 0; j < size; ++j) {
+      int32_t id = 0;
+      float distance = 0;
+      memcpy(&id, ids + offset + j, sizeof(int32_t));
+      memcpy(&distance, distances + offset + j, sizeof(float));
+      test_entry->neighbors.insert(std::make_pair(static_cast<int64_t>(id) + 1, distance));
+    }
+
+    test_entries.push_back(test_entry);
+  }
+
+  return test_entries;
+}
+
 bool JsonDataset::Init() {
   std::lock_guard lock(mutex_);
 
@@ -996,6 +1191,19 @@ Dataset::TestEntryPtr BeirBioasqDataset::ParseTestData(const rapidjson::Value& o
     }
   }
 
+  // set query_text and qrels for document search
+  if (item.HasMember("text") && item["text"].IsString()) {
+    entry->query_text = item["text"].GetString();
+  }
+  if (item.HasMember("qrels") && item["qrels"].IsArray()) {
+    for (const auto& qrel : item["qrels"].GetArray()) {
+      const auto& qrel_obj = qrel.GetObject();
+      CHECK(qrel_obj["id"].IsInt64()) << "qrel id type is not int64_t.";
+      CHECK(qrel_obj["score"].IsInt()) << "qrel score type is not int.";
+      entry->qrels[qrel_obj["id"].GetInt64() + 1] = qrel_obj["score"].GetInt();
+    }
+  }
+
   return entry;
 }
 
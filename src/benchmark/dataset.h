@@ -44,6 +44,10 @@ class Dataset {
     std::unordered_map<int64_t, float> neighbors;
     std::string filter_json;
     std::vector<int64_t> filter_vector_ids;
+    // query of document search, empty when dataset has no query text
+    std::string query_text;
+    // graded relevance of doc id, e.g. BEIR qrels, empty when dataset has no qrels
+    std::unordered_map<int64_t, int32_t> qrels;
   };
   using TestEntryPtr = std::shared_ptr<TestEntry>;
 
@@ -138,6 +142,57 @@ class Movielens10mDataset : public BaseDataset {
   ~Movielens10mDataset() override = default;
 };
 
+// Pre-converted binary dataset, see DatasetUtils::ConvertToBinary, a directory holds
+//   train.fbin|train.u8bin and test.fbin|test.u8bin: uint32 row_count, uint32 dimension, row major values
+//   groundtruth.bin: uint32 row_count, uint32 k, int32 neighbor ids then float distances, both row major
+// same layout as big-ann-benchmarks. Files are mmap-ed and rows are at fixed offsets, so any number of
+// threads read batches at the same time without lock.
+class BinaryDataset : public Dataset {
+ public:
+  BinaryDataset(std::string dirpath) : dirpath_(dirpath) {}
+  ~BinaryDataset() override;
+
+  static bool IsBinaryDataset(const std::string& dirpath);
+
+  bool Init() override;
+
+  uint32_t GetDimension() const override;
+  uint32_t GetTrainDataCount() const override;
+  uint32_t GetTestDataCount() const override;
+
+  // Get train data by batch, lock free
+  void GetBatchTrainData(uint32_t batch_num, std::vector<sdk::VectorWithId>& vector_with_ids, bool& is_eof) override;
+
+  // Get all test data
+  std::vector<TestEntryPtr> GetTestData() override;
+
+ private:
+  struct MappedFile {
+    const char* data{nullptr};
+    size_t size{0};
+  };
+
+  struct Matrix {
+    MappedFile file;
+    uint32_t row_count{0};
+    uint32_t dimension{0};
+    const char* values{nullptr};
+  };
+
+  static bool Map(const std::string& filepath, MappedFile& file);
+  static void Unmap(MappedFile& file);
+  // map the first existing one of .fbin/.u8bin
+  bool MapMatrix(const std::string& name, Matrix& matrix);
+  sdk::VectorWithId GetVector(const Matrix& matrix, uint32_t row) const;
+
+  std::string dirpath_;
+  bool is_uint8_{false};
+  Matrix train_;
+  Matrix test_;
+  MappedFile groundtruth_;
+  uint32_t groundtruth_k_{0};
+};
+
 struct BatchVectorEntry {
   std::vector<sdk::VectorWithId> vector_with_ids;
 };
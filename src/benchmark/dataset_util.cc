@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -30,6 +31,7 @@
 #include <thread>
 #include <vector>
 
+#include "H5Cpp.h"
 #include "common/logging.h"
 #include "fmt/core.h"
 #include "gflags/gflags.h"
@@ -38,6 +40,8 @@
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_distance.h"
 #include "threadpool.h"
 #include "util.h"
 
@@ -59,6 +63,9 @@ DEFINE_double(filter_vector_id_ratio, 0.1, "filter vector id ratio");
 
 DECLARE_bool(filter_vector_id_is_negation);
 
+DEFINE_string(binary_dataset_dirpath, "", "output dirpath of convert_binary sub command");
+DEFINE_uint32(convert_batch_row_num, 100000, "row num of one batch when convert dataset");
+
 namespace dingodb {
 namespace benchmark {
 
@@ -96,17 +103,6 @@ struct VectorEntry {
   std::priority_queue<Neighbor, std::vector<Neighbor>, Neighbor> max_heap;
   std::mutex mutex;
 
-  void PutCandidateNeighbors(const VectorEntry& vector_entry) {
-    CHECK(emb.size() == vector_entry.emb.size());
-
-    float distance = DingoHnswL2Sqr(emb.data(), vector_entry.emb.data(), emb.size());
-
-    Neighbor neighbor;
-    neighbor.id = vector_entry.id;
-    neighbor.distance = distance;
-    InsertHeap(neighbor);
-  }
-
   void InsertHeap(const Neighbor& neighbor) {
     std::lock_guard lock(mutex);
 
@@ -346,6 +342,13 @@ void DatasetUtils::GenNeighbor(const std::string& dataset_name, const std::strin
     std::cout << fmt::format("test data count: {}", test_entries.size()) << std::endl;
   }
 
+  // test vectors row by row, each train vector is compared with all of them in one batch
+  std::vector<float> test_matrix;
+  test_matrix.reserve(test_entries.size() * FLAGS_vector_dimension);
+  for (const auto& entry : test_entries) {
+    test_matrix.insert(test_matrix.end(), entry.emb.begin(), entry.emb.end());
+  }
+
   int64_t tatal_count = 0;
   int64_t filter_count = 0;
 
@@ -407,11 +410,17 @@ void DatasetUtils::GenNeighbor(const std::string& dataset_name, const std::strin
         }
 
         thread_pool.ExecuteTask(
-            [&test_entries](void* arg) {
+            [&test_entries, &test_matrix](void* arg) {
               VectorEntry* train_entry = static_cast<VectorEntry*>(arg);
 
-              for (auto& entry : test_entries) {
-                entry.PutCandidateNeighbors(*train_entry);
+              std::vector<float> distances(test_entries.size());
+              sdk::vector_distance::ExactDistances(sdk::MetricType::kL2, train_entry->emb.data(), test_matrix.data(),
+                                                   test_entries.size(), train_entry->emb.size(), distances.data());
+              for (size_t i = 0; i < test_entries.size(); ++i) {
+                VectorEntry::Neighbor neighbor;
+                neighbor.id = train_entry->id;
+                neighbor.distance = distances[i];
+                test_entries[i].InsertHeap(neighbor);
               }
             },
             train_entry);
@@ -643,6 +652,119 @@ void DatasetUtils::SplitDataset(const std::string& filepath, uint32_t data_num)
   }
 }
 
+// read rows [row_offset, row_offset + row_num) of a 2-d hdf5 dataset
+template <typename T>
+static void ReadH5Rows(H5::DataSet& dataset, const H5::PredType& type, uint32_t row_offset, uint32_t row_num,
+                       uint32_t col_num, std::vector<T>& buf) {
+  H5::DataSpace dataspace = dataset.getSpace();
+  hsize_t file_offset[2] = {row_offset, 0};
+  hsize_t file_count[2] = {row_num, col_num};
+  dataspace.selectHyperslab(H5S_SELECT_SET, file_count, file_offset);
+
+  hsize_t mem_dims[2] = {row_num, col_num};
+  H5::DataSpace memspace(2, mem_dims);
+
+  buf.resize(static_cast<size_t>(row_num) * col_num);
+  dataset.read(buf.data(), type, memspace, dataspace);
+
+  memspace.close();
+  dataspace.close();
+}
+
+static void GetH5Dims(H5::DataSet& dataset, uint32_t& row_count, uint32_t& col_count) {
+  H5::DataSpace dataspace = dataset.getSpace();
+  hsize_t dims_out[2] = {0};
+  dataspace.getSimpleExtentDims(dims_out, nullptr);
+  row_count = dims_out[0];
+  col_count = dims_out[1];
+  dataspace.close();
+}
+
+// write header(row_count, dimension) and float rows, read by batch for bounding memory
+static bool ConvertH5Matrix(H5::H5File& h5file, const std::string& name, const std::string& out_filepath) {
+  H5::DataSet dataset = h5file.openDataSet(name);
+  uint32_t row_count = 0, dimension = 0;
+  GetH5Dims(dataset, row_count, dimension);
+
+  std::ofstream ofs(out_filepath, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    DINGO_LOG(ERROR) << fmt::format("open file {} failed", out_filepath);
+    return false;
+  }
+  ofs.write(reinterpret_cast<const char*>(&row_count), sizeof(row_count));
+  ofs.write(reinterpret_cast<const char*>(&dimension), sizeof(dimension));
+
+  std::vector<float> buf;
+  for (uint32_t offset = 0; offset < row_count; offset += FLAGS_convert_batch_row_num) {
+    uint32_t row_num = std::min(FLAGS_convert_batch_row_num, row_count - offset);
+    ReadH5Rows(dataset, H5::PredType::NATIVE_FLOAT, offset, row_num, dimension, buf);
+    ofs.write(reinterpret_cast<const char*>(buf.data()), buf.size() * sizeof(float));
+
+    std::cout << '\r' << fmt::format("convert {} progress [{} / {}]", name, offset + row_num, row_count) << std::flush;
+  }
+  std::cout << '\n';
+
+  dataset.close();
+  ofs.close();
+  return ofs.good();
+}
+
+bool DatasetUtils::ConvertToBinary(const std::string& h5_filepath, const std::string& out_dirpath) {
+  if (!dingodb::benchmark::IsExistPath(out_dirpath) && !std::filesystem::create_directories(out_dirpath)) {
+    DINGO_LOG(ERROR) << fmt::format("create dir {} failed", out_dirpath);
+    return false;
+  }
+
+  try {
+    H5::H5File h5file(h5_filepath, H5F_ACC_RDONLY);
+
+    if (!ConvertH5Matrix(h5file, "train", fmt::format("{}/train.fbin", out_dirpath)) ||
+        !ConvertH5Matrix(h5file, "test", fmt::format("{}/test.fbin", out_dirpath))) {
+      return false;
+    }
+
+    // groundtruth: all neighbor ids then all distances, both are small
+    H5::DataSet neighbor_dataset = h5file.openDataSet("neighbors");
+    H5::DataSet distance_dataset = h5file.openDataSet("distances");
+    uint32_t row_count = 0, k = 0;
+    GetH5Dims(neighbor_dataset, row_count, k);
+
+    std::vector<int32_t> ids;
+    std::vector<float> distances;
+    ReadH5Rows(neighbor_dataset, H5::PredType::NATIVE_INT32, 0, row_count, k, ids);
+    ReadH5Rows(distance_dataset, H5::PredType::NATIVE_FLOAT, 0, row_count, k, distances);
+    neighbor_dataset.close();
+    distance_dataset.close();
+
+    std::string groundtruth_filepath = fmt::format("{}/groundtruth.bin", out_dirpath);
+    std::ofstream ofs(groundtruth_filepath, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      DINGO_LOG(ERROR) << fmt::format("open file {} failed", groundtruth_filepath);
+      return false;
+    }
+    ofs.write(reinterpret_cast<const char*>(&row_count), sizeof(row_count));
+    ofs.write(reinterpret_cast<const char*>(&k), sizeof(k));
+    ofs.write(reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(int32_t));
+    ofs.write(reinterpret_cast<const char*>(distances.data()), distances.size() * sizeof(float));
+    ofs.close();
+    if (!ofs.good()) {
+      DINGO_LOG(ERROR) << fmt::format("write file {} failed", groundtruth_filepath);
+      return false;
+    }
+
+    std::cout << fmt::format("convert {} to {} done, groundtruth({}x{})", h5_filepath, out_dirpath, row_count, k)
+              << '\n';
+    return true;
+
+  } catch (H5::Exception& error) {
+    error.printErrorStack();
+  } catch (std::exception& e) {
+    std::cerr << "convert dataset failed, " << e.what();
+  }
+
+  return false;
+}
+
 static std::string GetDatasetName() {
   std::string dataset_name;
   if (FLAGS_vector_dataset.find("wikipedia") != std::string::npos) {
@@ -657,6 +779,12 @@ static std::string GetDatasetName() {
 }
 
 void DatasetUtils::Main() {
+  // hdf5 dataset, not json
+  if (FLAGS_sub_command == "convert_binary") {
+    ConvertToBinary(FLAGS_vector_dataset, FLAGS_binary_dataset_dirpath);
+    return;
+  }
+
   if (GetDatasetName().empty()) {
     std::cerr << "Unknown dataset name: " << FLAGS_vector_dataset << std::endl;
     return;
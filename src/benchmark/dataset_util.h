@@ -36,6 +36,8 @@ class DatasetUtils {
   // generate test dataset neighbors
   static void GenNeighbor(const std::string& dataset_name, const std::string& test_dataset_filepath,
                           const std::string& train_dataset_dirpath, const std::string& out_filepath);
+  // convert hdf5 dataset(sift/glove/gist...) to mmap-able binary dataset, see BinaryDataset
+  static bool ConvertToBinary(const std::string& h5_filepath, const std::string& out_dirpath);
 };
 
 }  // namespace benchmark
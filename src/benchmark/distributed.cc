@@ -0,0 +1,405 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/distributed.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark/color.h"
+#include "butil/endpoint.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "util.h"
+
+DEFINE_string(distributed_role, "",
+              "Role of distributed benchmark, controller or worker, empty means a local benchmark, see distributed.h");
+DEFINE_validator(distributed_role, [](const char*, const std::string& value) -> bool {
+  return value.empty() || value == "controller" || value == "worker";
+});
+DEFINE_string(distributed_controller_addr, "127.0.0.1:23000",
+              "Address the controller listens on and workers connect to");
+DEFINE_uint32(distributed_worker_num, 1, "Number of workers the controller waits for");
+DEFINE_uint32(distributed_timeout_s, 60, "Seconds to wait for workers to connect, or for the controller to listen");
+
+DECLARE_bool(latency_breakdown);
+DECLARE_string(prefix);
+DECLARE_string(report_file);
+DECLARE_string(report_format);
+
+namespace dingodb {
+namespace benchmark {
+
+static const std::string kConfigCommand = "CONFIG";
+static const std::string kArrangeCommand = "ARRANGE";
+static const std::string kRunCommand = "RUN";
+static const std::string kCleanCommand = "CLEAN";
+static const std::string kOkReply = "OK";
+static const std::string kFailReply = "FAIL";
+
+// not shipped to workers, they are about the controller itself or the command line parsing
+static bool IsLocalFlag(const std::string& name) {
+  return name.rfind("distributed_", 0) == 0 || name == "report_file" || name == "report_format" ||
+         name == "flagfile" || name == "fromenv" || name == "tryfromenv" || name == "undefok";
+}
+
+static bool WriteAll(int fd, const std::string& data) {
+  size_t offset = 0;
+  while (offset < data.size()) {
+    ssize_t n = ::write(fd, data.data() + offset, data.size() - offset);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    offset += n;
+  }
+  return true;
+}
+
+static bool ReadAll(int fd, size_t size, std::string& data) {
+  data.resize(size);
+  size_t offset = 0;
+  while (offset < size) {
+    ssize_t n = ::read(fd, data.data() + offset, size - offset);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    offset += n;
+  }
+  return true;
+}
+
+static bool SendMessage(int fd, const std::string& command, const std::string& payload) {
+  return WriteAll(fd, fmt::format("{} {}\n", command, payload.size())) && WriteAll(fd, payload);
+}
+
+// false when the peer is gone or the message is broken
+static bool RecvMessage(int fd, std::string& command, std::string& payload) {
+  // header is short, read it byte by byte so nothing of the payload is consumed
+  std::string header;
+  char c = 0;
+  for (;;) {
+    ssize_t n = ::read(fd, &c, 1);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    if (c == '\n') {
+      break;
+    }
+    header.push_back(c);
+  }
+
+  std::istringstream in(header);
+  size_t size = 0;
+  if (!(in >> command >> size)) {
+    return false;
+  }
+  return ReadAll(fd, size, payload);
+}
+
+DistributedController::~DistributedController() {
+  for (int fd : worker_fds_) {
+    ::close(fd);
+  }
+  if (listen_fd_ >= 0) {
+    ::close(listen_fd_);
+  }
+}
+
+bool DistributedController::Run() {
+  if (!AcceptWorkers()) {
+    return false;
+  }
+
+  // every worker gets its index, then one flag per line
+  std::string flags;
+  std::vector<google::CommandLineFlagInfo> all_flags;
+  google::GetAllFlags(&all_flags);
+  for (const auto& flag : all_flags) {
+    if (!flag.is_default && !IsLocalFlag(flag.name) && flag.current_value.find('\n') == std::string::npos) {
+      flags += fmt::format("{}={}\n", flag.name, flag.current_value);
+    }
+  }
+  std::vector<std::string> payloads;
+  payloads.reserve(worker_fds_.size());
+  for (size_t i = 0; i < worker_fds_.size(); ++i) {
+    payloads.push_back(fmt::format("{}\n{}", i + 1, flags));
+  }
+
+  std::vector<std::string> replies;
+  if (!Broadcast(kConfigCommand, payloads, replies)) {
+    return false;
+  }
+
+  std::cout << COLOR_GREEN << fmt::format("Arrange on {} workers:", worker_fds_.size()) << COLOR_RESET << '\n';
+  if (!Broadcast(kArrangeCommand, replies)) {
+    Broadcast(kCleanCommand, replies);
+    return false;
+  }
+
+  std::cout << COLOR_GREEN << fmt::format("Run on {} workers:", worker_fds_.size()) << COLOR_RESET << '\n';
+  bool ok = Broadcast(kRunCommand, replies);
+  if (ok) {
+    Report(replies);
+  }
+
+  std::vector<std::string> clean_replies;
+  Broadcast(kCleanCommand, clean_replies);
+  return ok;
+}
+
+bool DistributedController::AcceptWorkers() {
+  butil::EndPoint endpoint;
+  if (butil::str2endpoint(FLAGS_distributed_controller_addr.c_str(), &endpoint) != 0) {
+    std::cerr << fmt::format("Invalid --distributed_controller_addr {}", FLAGS_distributed_controller_addr) << '\n';
+    return false;
+  }
+
+  listen_fd_ = butil::tcp_listen(endpoint);
+  if (listen_fd_ < 0) {
+    std::cerr << fmt::format("Listen on {} failed, errno: {}", FLAGS_distributed_controller_addr, errno) << '\n';
+    return false;
+  }
+
+  std::cout << fmt::format("Controller listen on {}, wait for {} workers", FLAGS_distributed_controller_addr,
+                           FLAGS_distributed_worker_num)
+            << '\n';
+
+  int64_t deadline_ms = dingodb::benchmark::TimestampMs() + FLAGS_distributed_timeout_s * 1000LL;
+  while (worker_fds_.size() < FLAGS_distributed_worker_num) {
+    int64_t wait_ms = deadline_ms - dingodb::benchmark::TimestampMs();
+    if (wait_ms <= 0) {
+      std::cerr << fmt::format("Only {} of {} workers connected in {}s", worker_fds_.size(),
+                               FLAGS_distributed_worker_num, FLAGS_distributed_timeout_s)
+                << '\n';
+      return false;
+    }
+
+    struct pollfd poll_fd = {listen_fd_, POLLIN, 0};
+    int ret = ::poll(&poll_fd, 1, static_cast<int>(wait_ms));
+    if (ret < 0 && errno != EINTR) {
+      return false;
+    }
+    if (ret <= 0) {
+      continue;
+    }
+
+    int fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      LOG(WARNING) << fmt::format("accept worker failed, errno: {}", errno);
+      continue;
+    }
+    worker_fds_.push_back(fd);
+    std::cout << fmt::format("worker {} connected", worker_fds_.size()) << '\n';
+  }
+
+  return true;
+}
+
+bool DistributedController::Broadcast(const std::string& command, const std::vector<std::string>& payloads,
+                                      std::vector<std::string>& replies) {
+  bool ok = true;
+  // sent to all first, so the workers run the step at the same time
+  for (size_t i = 0; i < worker_fds_.size(); ++i) {
+    if (!SendMessage(worker_fds_[i], command, payloads[i])) {
+      std::cerr << fmt::format("Send {} to worker {} failed", command, i + 1) << '\n';
+      ok = false;
+    }
+  }
+
+  replies.clear();
+  replies.resize(worker_fds_.size());
+  for (size_t i = 0; i < worker_fds_.size(); ++i) {
+    std::string reply;
+    if (!RecvMessage(worker_fds_[i], reply, replies[i])) {
+      std::cerr << fmt::format("Worker {} is gone at {}", i + 1, command) << '\n';
+      ok = false;
+    } else if (reply != kOkReply) {
+      std::cerr << fmt::format("Worker {} {} failed: {}", i + 1, command, replies[i]) << '\n';
+      ok = false;
+    }
+  }
+
+  return ok;
+}
+
+bool DistributedController::Broadcast(const std::string& command, std::vector<std::string>& replies) {
+  return Broadcast(command, std::vector<std::string>(worker_fds_.size()), replies);
+}
+
+// reply of run is the elapsed ms of the worker followed by its stats
+void DistributedController::Report(const std::vector<std::string>& replies) {
+  Stats cluster_stats;
+  size_t milliseconds = 0;
+  for (size_t i = 0; i < replies.size(); ++i) {
+    size_t pos = replies[i].find('\n');
+    Stats stats;
+    if (pos == std::string::npos || !stats.Decode(replies[i].substr(pos + 1))) {
+      std::cerr << fmt::format("Worker {} stats is broken", i + 1) << '\n';
+      continue;
+    }
+    // workers start together, the cluster runs as long as the slowest one
+    milliseconds = std::max<size_t>(milliseconds, std::stoull(replies[i].substr(0, pos)));
+    cluster_stats.Merge(stats);
+  }
+
+  std::cout << '\n' << COLOR_GREEN << fmt::format("Cluster of {} workers:", replies.size()) << COLOR_RESET << '\n';
+  cluster_stats.Report(true, milliseconds);
+  if (FLAGS_latency_breakdown) {
+    cluster_stats.ReportPhases();
+  }
+
+  if (!FLAGS_report_file.empty()) {
+    std::ofstream report_file(FLAGS_report_file, std::ios::out | std::ios::trunc);
+    if (!report_file.is_open()) {
+      LOG(ERROR) << fmt::format("open report file {} failed", FLAGS_report_file);
+      return;
+    }
+    if (FLAGS_report_format == "csv") {
+      report_file << Stats::FormatHeader() << '\n';
+    }
+    report_file << cluster_stats.Format(true, milliseconds) << '\n';
+  }
+}
+
+DistributedWorker::~DistributedWorker() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+bool DistributedWorker::Run() {
+  if (!Connect()) {
+    return false;
+  }
+
+  std::string command;
+  std::string payload;
+  if (!RecvMessage(fd_, command, payload) || command != kConfigCommand) {
+    std::cerr << "Receive config from controller failed" << '\n';
+    return false;
+  }
+
+  std::string error = ApplyConfig(payload);
+  auto& environment = Environment::GetInstance();
+  if (error.empty() && !environment.Init()) {
+    error = "init environment failed";
+  }
+  if (!error.empty()) {
+    SendMessage(fd_, kFailReply, error);
+    return false;
+  }
+  SendMessage(fd_, kOkReply, "");
+
+  auto benchmark = Benchmark::New(environment.GetClientStub(), environment.GetClient());
+  environment.AddBenchmark(benchmark);
+
+  for (;;) {
+    if (!RecvMessage(fd_, command, payload)) {
+      // controller is gone, leave nothing behind
+      LOG(ERROR) << "controller is gone, clean and exit";
+      benchmark->RunClean();
+      return false;
+    }
+
+    if (command == kArrangeCommand) {
+      bool ok = benchmark->RunArrange();
+      SendMessage(fd_, ok ? kOkReply : kFailReply, ok ? "" : "arrange failed");
+    } else if (command == kRunCommand) {
+      size_t milliseconds = benchmark->RunRequests();
+      SendMessage(fd_, kOkReply, fmt::format("{}\n{}", milliseconds, benchmark->EncodeCumulativeStats()));
+    } else if (command == kCleanCommand) {
+      benchmark->RunClean();
+      SendMessage(fd_, kOkReply, "");
+      return true;
+    } else {
+      SendMessage(fd_, kFailReply, fmt::format("unknown command {}", command));
+    }
+  }
+}
+
+bool DistributedWorker::Connect() {
+  butil::EndPoint endpoint;
+  if (butil::str2endpoint(FLAGS_distributed_controller_addr.c_str(), &endpoint) != 0) {
+    std::cerr << fmt::format("Invalid --distributed_controller_addr {}", FLAGS_distributed_controller_addr) << '\n';
+    return false;
+  }
+
+  // controller may start later than the worker
+  int64_t deadline_ms = dingodb::benchmark::TimestampMs() + FLAGS_distributed_timeout_s * 1000LL;
+  for (;;) {
+    fd_ = butil::tcp_connect(endpoint, nullptr);
+    if (fd_ >= 0) {
+      std::cout << fmt::format("Connected to controller {}", FLAGS_distributed_controller_addr) << '\n';
+      return true;
+    }
+    if (dingodb::benchmark::TimestampMs() >= deadline_ms) {
+      std::cerr << fmt::format("Connect to controller {} failed in {}s", FLAGS_distributed_controller_addr,
+                               FLAGS_distributed_timeout_s)
+                << '\n';
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
+std::string DistributedWorker::ApplyConfig(const std::string& payload) {
+  std::istringstream in(payload);
+  std::string line;
+  if (!std::getline(in, line)) {
+    return "config without worker index";
+  }
+  std::string worker_index = line;
+
+  while (std::getline(in, line)) {
+    auto pos = line.find('=');
+    if (pos == std::string::npos) {
+      continue;
+    }
+    std::string name = line.substr(0, pos);
+    if (google::SetCommandLineOption(name.c_str(), line.substr(pos + 1).c_str()).empty()) {
+      return fmt::format("set flag {} failed", line);
+    }
+  }
+
+  // regions of workers must not overlap
+  FLAGS_prefix = fmt::format("{}W{}", FLAGS_prefix, worker_index);
+  return "";
+}
+
+}  // namespace benchmark
+}  // namespace dingodb
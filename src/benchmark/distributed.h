@@ -0,0 +1,79 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_BENCHMARK_DISTRIBUTED_H_
+#define DINGODB_BENCHMARK_DISTRIBUTED_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dingodb {
+namespace benchmark {
+
+// Multi-node load, see FLAGS_distributed_role.
+// The controller listens on FLAGS_distributed_controller_addr and waits for FLAGS_distributed_worker_num workers.
+// Every worker gets the non default flags of the controller, then all of them arrange, run and clean in lockstep:
+// the controller sends a step to every worker and waits for all of them before the next step. Workers run a normal
+// Benchmark each, with its own regions under prefix FLAGS_prefix + "W" + worker index, and ship back their
+// cumulative stats, which the controller merges into one cluster wide report.
+//
+// Messages are a header line "<command> <payload size>\n" followed by the payload, over plain tcp.
+class DistributedController {
+ public:
+  DistributedController() = default;
+  ~DistributedController();
+
+  DistributedController(const DistributedController&) = delete;
+  const DistributedController& operator=(const DistributedController&) = delete;
+
+  bool Run();
+
+ private:
+  bool AcceptWorkers();
+
+  // send command to every worker, payloads[i] to worker i, then wait for the replies of all of them
+  bool Broadcast(const std::string& command, const std::vector<std::string>& payloads,
+                 std::vector<std::string>& replies);
+  bool Broadcast(const std::string& command, std::vector<std::string>& replies);
+
+  void Report(const std::vector<std::string>& replies);
+
+  int listen_fd_{-1};
+  std::vector<int> worker_fds_;
+};
+
+class DistributedWorker {
+ public:
+  DistributedWorker() = default;
+  ~DistributedWorker();
+
+  DistributedWorker(const DistributedWorker&) = delete;
+  const DistributedWorker& operator=(const DistributedWorker&) = delete;
+
+  bool Run();
+
+ private:
+  bool Connect();
+
+  // apply flags of the controller, return the error, empty means ok
+  static std::string ApplyConfig(const std::string& payload);
+
+  int fd_{-1};
+};
+
+}  // namespace benchmark
+}  // namespace dingodb
+
+#endif  // DINGODB_BENCHMARK_DISTRIBUTED_H_
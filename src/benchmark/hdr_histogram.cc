@@ -0,0 +1,151 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/hdr_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace dingodb {
+namespace benchmark {
+
+namespace {
+int HighestBit(int64_t value) { return 63 - __builtin_clzll(static_cast<uint64_t>(value)); }
+}  // namespace
+
+HdrHistogram::HdrHistogram(int64_t max_value) : max_value_(std::max<int64_t>(max_value, kSubBucketCount)) {
+  counts_.resize(IndexOf(max_value_) + 1, 0);
+}
+
+// bucket 0 holds [0, 2048) one by one, bucket b >= 1 holds [1024 << b, 2048 << b) in 1024 sub buckets of 1 << b
+size_t HdrHistogram::IndexOf(int64_t value) {
+  if (value < kSubBucketCount) {
+    return static_cast<size_t>(value);
+  }
+
+  int bucket = HighestBit(value) - kSubBucketBits + 1;
+  int64_t sub_bucket = value >> bucket;
+  return static_cast<size_t>(kSubBucketCount + (bucket - 1) * kSubBucketHalfCount + (sub_bucket - kSubBucketHalfCount));
+}
+
+int64_t HdrHistogram::HighestEquivalentValue(size_t index) {
+  auto i = static_cast<int64_t>(index);
+  if (i < kSubBucketCount) {
+    return i;
+  }
+
+  int64_t bucket = (i - kSubBucketCount) / kSubBucketHalfCount + 1;
+  int64_t sub_bucket = (i - kSubBucketCount) % kSubBucketHalfCount + kSubBucketHalfCount;
+  return ((sub_bucket + 1) << bucket) - 1;
+}
+
+void HdrHistogram::Record(int64_t value) {
+  value = std::clamp<int64_t>(value, 0, max_value_);
+  counts_[IndexOf(value)]++;
+  if (count_ == 0 || value < min_) {
+    min_ = value;
+  }
+  max_ = std::max(max_, value);
+  sum_ += value;
+  count_++;
+}
+
+void HdrHistogram::Merge(const HdrHistogram& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+
+  size_t n = std::min(counts_.size(), other.counts_.size());
+  for (size_t i = 0; i < n; i++) {
+    counts_[i] += other.counts_[i];
+  }
+  // values beyond our range are counted as our max value
+  for (size_t i = n; i < other.counts_.size(); i++) {
+    counts_.back() += other.counts_[i];
+  }
+
+  min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+  max_ = std::max(max_, std::min(other.max_, max_value_));
+  sum_ += other.sum_;
+  count_ += other.count_;
+}
+
+void HdrHistogram::Reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  count_ = 0;
+  sum_ = 0;
+  min_ = 0;
+  max_ = 0;
+}
+
+// count sum min max followed by index and count of non empty buckets
+std::string HdrHistogram::Encode() const {
+  std::ostringstream out;
+  out << count_ << ' ' << sum_ << ' ' << min_ << ' ' << max_;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    if (counts_[i] != 0) {
+      out << ' ' << i << ' ' << counts_[i];
+    }
+  }
+  return out.str();
+}
+
+bool HdrHistogram::Decode(const std::string& text) {
+  Reset();
+
+  std::istringstream in(text);
+  if (!(in >> count_ >> sum_ >> min_ >> max_)) {
+    Reset();
+    return false;
+  }
+
+  size_t index = 0;
+  int64_t count = 0;
+  while (in >> index >> count) {
+    // values beyond our range are counted as our max value
+    counts_[std::min(index, counts_.size() - 1)] += count;
+  }
+  if (!in.eof()) {
+    Reset();
+    return false;
+  }
+
+  max_ = std::min(max_, max_value_);
+  return true;
+}
+
+int64_t HdrHistogram::ValueAtPercentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  auto target = std::max<int64_t>(static_cast<int64_t>(std::ceil(percentile / 100.0 * count_)), 1);
+  int64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    seen += counts_[i];
+    if (seen >= target) {
+      return std::min(HighestEquivalentValue(i), max_);
+    }
+  }
+
+  return max_;
+}
+
+}  // namespace benchmark
+}  // namespace dingodb
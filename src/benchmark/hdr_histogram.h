@@ -0,0 +1,82 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_BENCHMARK_HDR_HISTOGRAM_H_
+#define DINGODB_BENCHMARK_HDR_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dingodb {
+namespace benchmark {
+
+// High dynamic range histogram of non negative values, e.g. latency in us.
+// Values below 2048 are exact, larger ones share a bucket with values within
+// 1/1024 of them, so any percentile down to p99.99 is within 0.1% error
+// whatever the range is. Not thread safe.
+class HdrHistogram {
+ public:
+  // one hour in us
+  static constexpr int64_t kDefaultMaxValue = 3600LL * 1000 * 1000;
+
+  // values above max_value are recorded as max_value
+  explicit HdrHistogram(int64_t max_value = kDefaultMaxValue);
+  ~HdrHistogram() = default;
+
+  void Record(int64_t value);
+
+  void Merge(const HdrHistogram& other);
+
+  void Reset();
+
+  // one line of text, so a histogram can be shipped to another process and merged there
+  std::string Encode() const;
+  // false when text is not made by Encode, the histogram is reset first
+  bool Decode(const std::string& text);
+
+  int64_t Count() const { return count_; }
+
+  // 0 when empty
+  int64_t Min() const { return count_ == 0 ? 0 : min_; }
+
+  int64_t Max() const { return max_; }
+
+  double Mean() const { return count_ == 0 ? 0 : static_cast<double>(sum_) / count_; }
+
+  // percentile in [0, 100], e.g. 99.99, return the highest value equivalent to it, 0 when empty
+  int64_t ValueAtPercentile(double percentile) const;
+
+ private:
+  static constexpr int kSubBucketBits = 11;
+  static constexpr int64_t kSubBucketCount = 1LL << kSubBucketBits;
+  static constexpr int64_t kSubBucketHalfCount = kSubBucketCount / 2;
+
+  static size_t IndexOf(int64_t value);
+
+  static int64_t HighestEquivalentValue(size_t index);
+
+  int64_t max_value_;
+  std::vector<int64_t> counts_;
+  int64_t count_{0};
+  int64_t sum_{0};
+  int64_t min_{0};
+  int64_t max_{0};
+};
+
+}  // namespace benchmark
+}  // namespace dingodb
+
+#endif  // DINGODB_BENCHMARK_HDR_HISTOGRAM_H_
@@ -17,14 +17,17 @@
 #include <string>
 
 #include "benchmark/benchmark.h"
+#include "benchmark/compare.h"
 #include "benchmark/dataset.h"
 #include "benchmark/dataset_util.h"
+#include "benchmark/distributed.h"
 #include "fmt/core.h"
 #include "gflags/gflags.h"
 #include "glog/logging.h"
 #include "util.h"
 
 DECLARE_string(benchmark);
+DECLARE_string(distributed_role);
 
 const std::string kVersion = "0.1.0";
 
@@ -77,6 +80,31 @@ static std::string GetUsageMessage() {
   message += "\n  --vector_search_radius vector search flag radius, default(0.1)";
   message += "\n  --vector_search_nprobe vector search flag nprobe, default(80)";
   message += "\n  --vector_search_ef vector search flag ef, default(128)";
+  message += "\n  --vector_search_sweep_ef searchvector sweep ef list, e.g. 16,32,64, default()";
+  message += "\n  --vector_search_sweep_nprobe searchvector sweep nprobe list, e.g. 8,16,32, default()";
+  message += "\n  --vector_search_sweep_topk searchvector sweep topk list, e.g. 1,10,100, default()";
+  message += "\n  --vector_search_sweep_filter_type searchvector sweep filter type list none/pre/post, default()";
+  message += "\n  --vector_sweep_result_file ann-benchmarks like csv of sweep result, default(vector_sweep.csv)";
+  message += "\n  --mock_server run against in-process fake coordinator and store, measure sdk only, default(false)";
+  message += "\n  --mock_server_latency_us latency of every store request in mock server, default(0)";
+  message += "\n  --mock_server_not_leader_ratio ratio of store requests answered not leader, default(0)";
+  message += "\n  --mock_server_region_version_ratio ratio of store requests answered region version, default(0)";
+  message += "\n  --report_file also write every report to this file, default()";
+  message += "\n  --report_format format of report_file csv/json, compare needs json, default(csv)";
+  message += "\n  --latency_breakdown report client/queue/rpc/response/merge phases of requests, default(false)";
+  message += "\n  --cpu_profile_file write cpu profile of the run, needs gperftools loaded, default()";
+  message += "\n  --heap_profile_prefix write heap profiles of the run, needs tcmalloc or jemalloc loaded, default()";
+  message += "\n  --heap_profile_interval_s interval between heap profile dumps, 0 is at end, default(0)";
+  message += "\n  --profile_delay_s start profiling after requests run this long, unit(second), default(0)";
+  message += "\n  --profile_duration_s stop profiling after this long, 0 is at end, unit(second), default(0)";
+  message += "\n  --benchmark=compare compare two json report files and report regressions";
+  message += "\n  --compare_baseline_file baseline json report file of compare, default()";
+  message += "\n  --compare_current_file current json report file of compare, default()";
+  message += "\n  --compare_threshold delta in percent below which two runs are equal, default(5)";
+  message += "\n  --distributed_role run as controller or worker of a multi-node benchmark, default()";
+  message += "\n  --distributed_controller_addr controller listen address, default(127.0.0.1:23000)";
+  message += "\n  --distributed_worker_num number of workers the controller waits for, default(1)";
+  message += "\n  --distributed_timeout_s wait for workers or controller, unit(second), default(60)";
 
   return message;
 }
@@ -134,8 +162,23 @@ int main(int argc, char* argv[]) {
     return 0;
   }
 
+  if (FLAGS_benchmark == "compare") {
+    return dingodb::benchmark::BenchmarkCompare::Main();
+  }
+
+  // controller runs no requests itself, it only drives the workers
+  if (FLAGS_distributed_role == "controller") {
+    dingodb::benchmark::DistributedController controller;
+    return controller.Run() ? 0 : 1;
+  }
+
   SetupSignalHandler();
 
+  if (FLAGS_distributed_role == "worker") {
+    dingodb::benchmark::DistributedWorker worker;
+    return worker.Run() ? 0 : 1;
+  }
+
   auto& environment = dingodb::benchmark::Environment::GetInstance();
   if (!environment.Init()) {
     return 1;
@@ -0,0 +1,753 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/mock_server.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+#ifdef USE_GRPC
+#include "grpcpp/grpcpp.h"
+#include "proto/coordinator.grpc.pb.h"
+#include "proto/document.grpc.pb.h"
+#include "proto/index.grpc.pb.h"
+#include "proto/meta.grpc.pb.h"
+#include "proto/store.grpc.pb.h"
+#else
+#include "brpc/closure_guard.h"
+#include "brpc/server.h"
+#include "bthread/bthread.h"
+#endif
+
+DEFINE_bool(mock_server, false, "Run benchmark against in-process fake coordinator and store, ignore coordinator_addrs");
+DEFINE_string(mock_server_host, "127.0.0.1", "Host of mock server");
+DEFINE_int32(mock_server_port, 20001, "Port of mock server");
+DEFINE_int64(mock_server_latency_us, 0, "Latency of every store request in mock server");
+DEFINE_double(mock_server_not_leader_ratio, 0.0, "Ratio of store requests answered ERAFT_NOTLEADER in mock server");
+DEFINE_validator(mock_server_not_leader_ratio,
+                 [](const char*, double value) -> bool { return value >= 0.0 && value <= 1.0; });
+DEFINE_double(mock_server_region_version_ratio, 0.0,
+              "Ratio of store requests which bump region version in mock server, so answered EREGION_VERSION");
+DEFINE_validator(mock_server_region_version_ratio,
+                 [](const char*, double value) -> bool { return value >= 0.0 && value <= 1.0; });
+
+DECLARE_uint32(value_size);
+
+namespace dingodb {
+namespace benchmark {
+
+static const int64_t kTsoLogicalMax = 1 << 18;
+
+static void SleepUs(int64_t us) {
+#ifdef USE_GRPC
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+#else
+  bthread_usleep(us);
+#endif
+}
+
+static bool Hit(double ratio) {
+  if (ratio <= 0.0) {
+    return false;
+  }
+  thread_local std::mt19937_64 rng(std::random_device{}());
+  return std::uniform_real_distribution<double>(0.0, 1.0)(rng) < ratio;
+}
+
+static int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+MockCluster::MockCluster(std::string host, int port)
+    : host_(std::move(host)), port_(port), canned_value_(FLAGS_value_size, 'v') {}
+
+void MockCluster::FillLocation(pb::common::Location* location) const {
+  location->set_host(host_);
+  location->set_port(port_);
+}
+
+int64_t MockCluster::AddRegion(const pb::common::Range& range, pb::common::RegionType type) {
+  Region region;
+  region.id = next_id_.fetch_add(1);
+  region.range = range;
+  region.epoch.set_conf_version(1);
+  region.epoch.set_version(1);
+  region.type = type;
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  regions_[region.id] = region;
+  return region.id;
+}
+
+template <typename Context>
+bool MockCluster::PrepareStoreRequest(const Context& context, pb::error::Error* error) {
+  if (FLAGS_mock_server_latency_us > 0) {
+    SleepUs(FLAGS_mock_server_latency_us);
+  }
+
+  if (Hit(FLAGS_mock_server_not_leader_ratio)) {
+    // leader hint is self, sdk retries at once
+    error->set_errcode(pb::error::Errno::ERAFT_NOTLEADER);
+    error->set_errmsg("mock not leader");
+    FillLocation(error->mutable_leader_location());
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = regions_.find(context.region_id());
+  if (iter == regions_.end()) {
+    error->set_errcode(pb::error::EREGION_NOT_FOUND);
+    error->set_errmsg(fmt::format("mock region {} not found", context.region_id()));
+    return false;
+  }
+
+  auto& region = iter->second;
+  if (Hit(FLAGS_mock_server_region_version_ratio)) {
+    region.epoch.set_version(region.epoch.version() + 1);
+  }
+
+  if (context.has_region_epoch() && context.region_epoch().version() != region.epoch.version()) {
+    error->set_errcode(pb::error::EREGION_VERSION);
+    error->set_errmsg(fmt::format("mock region {} version {} not match {}", region.id,
+                                  context.region_epoch().version(), region.epoch.version()));
+    auto* store_region_info = error->mutable_store_region_info();
+    store_region_info->set_region_id(region.id);
+    *store_region_info->mutable_current_region_epoch() = region.epoch;
+    *store_region_info->mutable_current_range() = region.range;
+    FillLocation(store_region_info->add_peers()->mutable_server_location());
+    return false;
+  }
+
+  return true;
+}
+
+void MockCluster::Hello(const pb::coordinator::HelloRequest& /*request*/, pb::coordinator::HelloResponse* response) {
+  auto* version_info = response->mutable_version_info();
+  version_info->set_git_commit_hash("mock");
+  version_info->set_git_tag_name("mock");
+}
+
+void MockCluster::CreateRegion(const pb::coordinator::CreateRegionRequest& request,
+                               pb::coordinator::CreateRegionResponse* response) {
+  response->set_region_id(AddRegion(request.range(), pb::common::RegionType::STORE_REGION));
+}
+
+void MockCluster::DropRegion(const pb::coordinator::DropRegionRequest& request,
+                             pb::coordinator::DropRegionResponse* /*response*/) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  regions_.erase(request.region_id());
+}
+
+void MockCluster::QueryRegion(const pb::coordinator::QueryRegionRequest& request,
+                              pb::coordinator::QueryRegionResponse* response) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = regions_.find(request.region_id());
+  if (iter == regions_.end()) {
+    response->mutable_error()->set_errcode(pb::error::EREGION_NOT_FOUND);
+    response->mutable_error()->set_errmsg(fmt::format("mock region {} not found", request.region_id()));
+    return;
+  }
+
+  auto* region = response->mutable_region();
+  region->set_id(iter->first);
+  region->set_state(pb::common::REGION_NORMAL);
+}
+
+void MockCluster::ScanRegions(const pb::coordinator::ScanRegionsRequest& request,
+                              pb::coordinator::ScanRegionsResponse* response) {
+  std::vector<Region> hits;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& [id, region] : regions_) {
+      bool hit = request.range_end().empty()
+                     ? (region.range.start_key() <= request.key() && request.key() < region.range.end_key())
+                     : (region.range.start_key() < request.range_end() && request.key() < region.range.end_key());
+      if (hit) {
+        hits.push_back(region);
+      }
+    }
+  }
+
+  std::sort(hits.begin(), hits.end(),
+            [](const Region& a, const Region& b) { return a.range.start_key() < b.range.start_key(); });
+  if (request.limit() > 0 && static_cast<int64_t>(hits.size()) > request.limit()) {
+    hits.resize(request.limit());
+  }
+
+  for (const auto& region : hits) {
+    auto* info = response->add_regions();
+    info->set_region_id(region.id);
+    *info->mutable_range() = region.range;
+    *info->mutable_region_epoch() = region.epoch;
+    info->mutable_status()->set_region_type(region.type);
+    FillLocation(info->mutable_leader());
+  }
+}
+
+void MockCluster::TsoService(const pb::meta::TsoRequest& request, pb::meta::TsoResponse* response) {
+  int64_t count = std::max<int64_t>(request.count(), 1);
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  int64_t now_ms = NowMs();
+  if (now_ms > tso_physical_) {
+    tso_physical_ = now_ms;
+    tso_logical_ = 0;
+  } else if (tso_logical_ + count >= kTsoLogicalMax) {
+    tso_physical_++;
+    tso_logical_ = 0;
+  }
+
+  auto* start_timestamp = response->mutable_start_timestamp();
+  start_timestamp->set_physical(tso_physical_);
+  start_timestamp->set_logical(tso_logical_);
+  tso_logical_ += count;
+}
+
+void MockCluster::CreateTableIds(const pb::meta::CreateTableIdsRequest& request,
+                                 pb::meta::CreateTableIdsResponse* response) {
+  for (int64_t i = 0; i < request.count(); ++i) {
+    auto* table_id = response->add_table_ids();
+    table_id->set_entity_type(pb::meta::EntityType::ENTITY_TYPE_TABLE);
+    table_id->set_parent_entity_id(request.schema_id().entity_id());
+    table_id->set_entity_id(next_id_.fetch_add(1));
+  }
+}
+
+void MockCluster::CreateIndex(const pb::meta::CreateIndexRequest& request,
+                              pb::meta::CreateIndexResponse* /*response*/) {
+  const auto& definition = request.index_definition();
+  auto region_type = definition.index_parameter().index_type() == pb::common::IndexType::INDEX_TYPE_DOCUMENT
+                         ? pb::common::RegionType::DOCUMENT_REGION
+                         : pb::common::RegionType::INDEX_REGION;
+  for (const auto& partition : definition.index_partition().partitions()) {
+    AddRegion(partition.range(), region_type);
+  }
+
+  pb::meta::IndexDefinitionWithId index;
+  *index.mutable_index_id() = request.index_id();
+  *index.mutable_index_definition() = definition;
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  indexes_[request.index_id().entity_id()] = std::move(index);
+}
+
+void MockCluster::GetIndex(const pb::meta::GetIndexRequest& request, pb::meta::GetIndexResponse* response) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = indexes_.find(request.index_id().entity_id());
+  if (iter != indexes_.end()) {
+    *response->mutable_index_definition_with_id() = iter->second;
+  }
+}
+
+void MockCluster::GetIndexByName(const pb::meta::GetIndexByNameRequest& request,
+                                 pb::meta::GetIndexByNameResponse* response) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (const auto& [id, index] : indexes_) {
+    if (index.index_id().parent_entity_id() == request.schema_id().entity_id() &&
+        index.index_definition().name() == request.index_name()) {
+      *response->mutable_index_definition_with_id() = index;
+      return;
+    }
+  }
+}
+
+void MockCluster::DropIndex(const pb::meta::DropIndexRequest& request, pb::meta::DropIndexResponse* /*response*/) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = indexes_.find(request.index_id().entity_id());
+  if (iter == indexes_.end()) {
+    return;
+  }
+
+  // regions of index are the ones cover its partitions
+  for (const auto& partition : iter->second.index_definition().index_partition().partitions()) {
+    for (auto region_iter = regions_.begin(); region_iter != regions_.end();) {
+      if (region_iter->second.range.start_key() == partition.range().start_key()) {
+        region_iter = regions_.erase(region_iter);
+      } else {
+        ++region_iter;
+      }
+    }
+  }
+  indexes_.erase(iter);
+}
+
+void MockCluster::KvGet(const pb::store::KvGetRequest& request, pb::store::KvGetResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_value(canned_value_);
+}
+
+void MockCluster::KvBatchGet(const pb::store::KvBatchGetRequest& request, pb::store::KvBatchGetResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (const auto& key : request.keys()) {
+    auto* kv = response->add_kvs();
+    kv->set_key(key);
+    kv->set_value(canned_value_);
+  }
+}
+
+void MockCluster::KvPut(const pb::store::KvPutRequest& request, pb::store::KvPutResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::KvBatchPut(const pb::store::KvBatchPutRequest& request, pb::store::KvBatchPutResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::KvPutIfAbsent(const pb::store::KvPutIfAbsentRequest& request,
+                                pb::store::KvPutIfAbsentResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_key_state(true);
+}
+
+void MockCluster::KvBatchPutIfAbsent(const pb::store::KvBatchPutIfAbsentRequest& request,
+                                     pb::store::KvBatchPutIfAbsentResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int i = 0; i < request.kvs_size(); ++i) {
+    response->add_key_states(true);
+  }
+}
+
+void MockCluster::KvBatchDelete(const pb::store::KvBatchDeleteRequest& request,
+                                pb::store::KvBatchDeleteResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int i = 0; i < request.keys_size(); ++i) {
+    response->add_key_states(true);
+  }
+}
+
+void MockCluster::KvDeleteRange(const pb::store::KvDeleteRangeRequest& request,
+                                pb::store::KvDeleteRangeResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_delete_count(0);
+}
+
+void MockCluster::KvCompareAndSet(const pb::store::KvCompareAndSetRequest& request,
+                                  pb::store::KvCompareAndSetResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_key_state(true);
+}
+
+void MockCluster::KvBatchCompareAndSet(const pb::store::KvBatchCompareAndSetRequest& request,
+                                       pb::store::KvBatchCompareAndSetResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int i = 0; i < request.kvs_size(); ++i) {
+    response->add_key_states(true);
+  }
+}
+
+void MockCluster::KvScanBegin(const pb::store::KvScanBeginRequest& request, pb::store::KvScanBeginResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_scan_id(fmt::format("mock_scan_{}", next_id_.fetch_add(1)));
+}
+
+void MockCluster::KvScanContinue(const pb::store::KvScanContinueRequest& request,
+                                 pb::store::KvScanContinueResponse* response) {
+  // empty kvs ends the scan
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::KvScanRelease(const pb::store::KvScanReleaseRequest& request,
+                                pb::store::KvScanReleaseResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::TxnGet(const pb::store::TxnGetRequest& request, pb::store::TxnGetResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_value(canned_value_);
+}
+
+void MockCluster::TxnBatchGet(const pb::store::TxnBatchGetRequest& request, pb::store::TxnBatchGetResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (const auto& key : request.keys()) {
+    auto* kv = response->add_kvs();
+    kv->set_key(key);
+    kv->set_value(canned_value_);
+  }
+}
+
+void MockCluster::TxnScan(const pb::store::TxnScanRequest& request, pb::store::TxnScanResponse* response) {
+  // empty end_key ends the scan
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::TxnPrewrite(const pb::store::TxnPrewriteRequest& request, pb::store::TxnPrewriteResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::TxnCommit(const pb::store::TxnCommitRequest& request, pb::store::TxnCommitResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::TxnBatchRollback(const pb::store::TxnBatchRollbackRequest& request,
+                                   pb::store::TxnBatchRollbackResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::TxnHeartBeat(const pb::store::TxnHeartBeatRequest& request,
+                               pb::store::TxnHeartBeatResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_lock_ttl(request.advise_lock_ttl());
+}
+
+void MockCluster::TxnCheckTxnStatus(const pb::store::TxnCheckTxnStatusRequest& request,
+                                    pb::store::TxnCheckTxnStatusResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::TxnResolveLock(const pb::store::TxnResolveLockRequest& request,
+                                 pb::store::TxnResolveLockResponse* response) {
+  PrepareStoreRequest(request.context(), response->mutable_error());
+}
+
+void MockCluster::VectorAdd(const pb::index::VectorAddRequest& request, pb::index::VectorAddResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int i = 0; i < request.vectors_size(); ++i) {
+    response->add_key_states(true);
+  }
+}
+
+void MockCluster::VectorSearch(const pb::index::VectorSearchRequest& request,
+                               pb::index::VectorSearchResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  // top_n canned neighbors in ascending distance for every query vector
+  for (int i = 0; i < request.vector_with_ids_size(); ++i) {
+    auto* batch_result = response->add_batch_results();
+    for (int64_t j = 0; j < request.parameter().top_n(); ++j) {
+      auto* vector_with_distance = batch_result->add_vector_with_distances();
+      vector_with_distance->mutable_vector_with_id()->set_id(j + 1);
+      vector_with_distance->set_distance(static_cast<float>(j));
+    }
+  }
+}
+
+void MockCluster::VectorBatchQuery(const pb::index::VectorBatchQueryRequest& request,
+                                   pb::index::VectorBatchQueryResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (auto id : request.vector_ids()) {
+    response->add_vectors()->set_id(id);
+  }
+}
+
+void MockCluster::VectorDelete(const pb::index::VectorDeleteRequest& request,
+                               pb::index::VectorDeleteResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int i = 0; i < request.ids_size(); ++i) {
+    response->add_key_states(true);
+  }
+}
+
+void MockCluster::VectorCount(const pb::index::VectorCountRequest& request, pb::index::VectorCountResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_count(0);
+}
+
+void MockCluster::DocumentAdd(const pb::document::DocumentAddRequest& request,
+                              pb::document::DocumentAddResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int i = 0; i < request.documents_size(); ++i) {
+    response->add_key_states(true);
+  }
+}
+
+void MockCluster::DocumentSearch(const pb::document::DocumentSearchRequest& request,
+                                 pb::document::DocumentSearchResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int64_t i = 0; i < request.parameter().top_n(); ++i) {
+    auto* document_with_score = response->add_document_with_scores();
+    document_with_score->mutable_document_with_id()->set_id(i + 1);
+    document_with_score->set_score(static_cast<float>(request.parameter().top_n() - i));
+  }
+}
+
+void MockCluster::DocumentDelete(const pb::document::DocumentDeleteRequest& request,
+                                 pb::document::DocumentDeleteResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  for (int i = 0; i < request.ids_size(); ++i) {
+    response->add_key_states(true);
+  }
+}
+
+void MockCluster::DocumentCount(const pb::document::DocumentCountRequest& request,
+                                pb::document::DocumentCountResponse* response) {
+  if (!PrepareStoreRequest(request.context(), response->mutable_error())) {
+    return;
+  }
+  response->set_count(0);
+}
+
+// one rpc method of a service forwarded to MockCluster, same name on both sides
+#ifdef USE_GRPC
+#define MOCK_RPC_METHOD(NS, METHOD)                                                                          \
+  grpc::Status METHOD(grpc::ServerContext* /*context*/, const NS::METHOD##Request* request,                  \
+                      NS::METHOD##Response* response) override {                                             \
+    cluster_.METHOD(*request, response);                                                                     \
+    return grpc::Status::OK;                                                                                 \
+  }
+#define MOCK_RPC_SERVICE_BASE(NS, SERVICE) NS::SERVICE::Service
+#else
+#define MOCK_RPC_METHOD(NS, METHOD)                                                                          \
+  void METHOD(google::protobuf::RpcController* /*controller*/, const NS::METHOD##Request* request,           \
+              NS::METHOD##Response* response, google::protobuf::Closure* done) override {                    \
+    brpc::ClosureGuard done_guard(done);                                                                     \
+    cluster_.METHOD(*request, response);                                                                     \
+  }
+#define MOCK_RPC_SERVICE_BASE(NS, SERVICE) NS::SERVICE
+#endif
+
+class MockCoordinatorService final : public MOCK_RPC_SERVICE_BASE(pb::coordinator, CoordinatorService) {
+ public:
+  explicit MockCoordinatorService(MockCluster& cluster) : cluster_(cluster) {}
+
+  MOCK_RPC_METHOD(pb::coordinator, Hello)
+  MOCK_RPC_METHOD(pb::coordinator, CreateRegion)
+  MOCK_RPC_METHOD(pb::coordinator, DropRegion)
+  MOCK_RPC_METHOD(pb::coordinator, QueryRegion)
+  MOCK_RPC_METHOD(pb::coordinator, ScanRegions)
+
+ private:
+  MockCluster& cluster_;
+};
+
+class MockMetaService final : public MOCK_RPC_SERVICE_BASE(pb::meta, MetaService) {
+ public:
+  explicit MockMetaService(MockCluster& cluster) : cluster_(cluster) {}
+
+#ifdef USE_GRPC
+  grpc::Status TsoService(grpc::ServerContext* /*context*/, const pb::meta::TsoRequest* request,
+                          pb::meta::TsoResponse* response) override {
+    cluster_.TsoService(*request, response);
+    return grpc::Status::OK;
+  }
+#else
+  void TsoService(google::protobuf::RpcController* /*controller*/, const pb::meta::TsoRequest* request,
+                  pb::meta::TsoResponse* response, google::protobuf::Closure* done) override {
+    brpc::ClosureGuard done_guard(done);
+    cluster_.TsoService(*request, response);
+  }
+#endif
+
+  MOCK_RPC_METHOD(pb::meta, CreateTableIds)
+  MOCK_RPC_METHOD(pb::meta, CreateIndex)
+  MOCK_RPC_METHOD(pb::meta, GetIndex)
+  MOCK_RPC_METHOD(pb::meta, GetIndexByName)
+  MOCK_RPC_METHOD(pb::meta, DropIndex)
+
+ private:
+  MockCluster& cluster_;
+};
+
+class MockStoreService final : public MOCK_RPC_SERVICE_BASE(pb::store, StoreService) {
+ public:
+  explicit MockStoreService(MockCluster& cluster) : cluster_(cluster) {}
+
+  MOCK_RPC_METHOD(pb::store, KvGet)
+  MOCK_RPC_METHOD(pb::store, KvBatchGet)
+  MOCK_RPC_METHOD(pb::store, KvPut)
+  MOCK_RPC_METHOD(pb::store, KvBatchPut)
+  MOCK_RPC_METHOD(pb::store, KvPutIfAbsent)
+  MOCK_RPC_METHOD(pb::store, KvBatchPutIfAbsent)
+  MOCK_RPC_METHOD(pb::store, KvBatchDelete)
+  MOCK_RPC_METHOD(pb::store, KvDeleteRange)
+  MOCK_RPC_METHOD(pb::store, KvCompareAndSet)
+  MOCK_RPC_METHOD(pb::store, KvBatchCompareAndSet)
+  MOCK_RPC_METHOD(pb::store, KvScanBegin)
+  MOCK_RPC_METHOD(pb::store, KvScanContinue)
+  MOCK_RPC_METHOD(pb::store, KvScanRelease)
+
+  MOCK_RPC_METHOD(pb::store, TxnGet)
+  MOCK_RPC_METHOD(pb::store, TxnBatchGet)
+  MOCK_RPC_METHOD(pb::store, TxnScan)
+  MOCK_RPC_METHOD(pb::store, TxnPrewrite)
+  MOCK_RPC_METHOD(pb::store, TxnCommit)
+  MOCK_RPC_METHOD(pb::store, TxnBatchRollback)
+  MOCK_RPC_METHOD(pb::store, TxnHeartBeat)
+  MOCK_RPC_METHOD(pb::store, TxnCheckTxnStatus)
+  MOCK_RPC_METHOD(pb::store, TxnResolveLock)
+
+ private:
+  MockCluster& cluster_;
+};
+
+class MockIndexService final : public MOCK_RPC_SERVICE_BASE(pb::index, IndexService) {
+ public:
+  explicit MockIndexService(MockCluster& cluster) : cluster_(cluster) {}
+
+  MOCK_RPC_METHOD(pb::index, VectorAdd)
+  MOCK_RPC_METHOD(pb::index, VectorSearch)
+  MOCK_RPC_METHOD(pb::index, VectorBatchQuery)
+  MOCK_RPC_METHOD(pb::index, VectorDelete)
+  MOCK_RPC_METHOD(pb::index, VectorCount)
+
+ private:
+  MockCluster& cluster_;
+};
+
+class MockDocumentService final : public MOCK_RPC_SERVICE_BASE(pb::document, DocumentService) {
+ public:
+  explicit MockDocumentService(MockCluster& cluster) : cluster_(cluster) {}
+
+  MOCK_RPC_METHOD(pb::document, DocumentAdd)
+  MOCK_RPC_METHOD(pb::document, DocumentSearch)
+  MOCK_RPC_METHOD(pb::document, DocumentDelete)
+  MOCK_RPC_METHOD(pb::document, DocumentCount)
+
+ private:
+  MockCluster& cluster_;
+};
+
+class MockServer::Impl {
+ public:
+  Impl(const std::string& host, int port)
+      : cluster(host, port),
+        coordinator_service(cluster),
+        meta_service(cluster),
+        store_service(cluster),
+        index_service(cluster),
+        document_service(cluster) {}
+
+  MockCluster cluster;
+  MockCoordinatorService coordinator_service;
+  MockMetaService meta_service;
+  MockStoreService store_service;
+  MockIndexService index_service;
+  MockDocumentService document_service;
+
+#ifdef USE_GRPC
+  std::unique_ptr<grpc::Server> server;
+#else
+  brpc::Server server;
+#endif
+};
+
+MockServer::MockServer() = default;
+
+MockServer::~MockServer() = default;
+
+MockServer& MockServer::GetInstance() {
+  static MockServer instance;
+  return instance;
+}
+
+bool MockServer::Start(std::string& out_addrs) {
+  CHECK(impl_ == nullptr) << "mock server already started";
+  impl_ = std::make_unique<Impl>(FLAGS_mock_server_host, FLAGS_mock_server_port);
+  std::string addr = fmt::format("{}:{}", FLAGS_mock_server_host, FLAGS_mock_server_port);
+
+#ifdef USE_GRPC
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort(addr, grpc::InsecureServerCredentials());
+  builder.RegisterService(&impl_->coordinator_service);
+  builder.RegisterService(&impl_->meta_service);
+  builder.RegisterService(&impl_->store_service);
+  builder.RegisterService(&impl_->index_service);
+  builder.RegisterService(&impl_->document_service);
+  impl_->server = builder.BuildAndStart();
+  if (impl_->server == nullptr) {
+    LOG(ERROR) << fmt::format("Start mock server at {} failed", addr);
+    impl_.reset();
+    return false;
+  }
+#else
+  auto& server = impl_->server;
+  if (server.AddService(&impl_->coordinator_service, brpc::SERVER_DOESNT_OWN_SERVICE) != 0 ||
+      server.AddService(&impl_->meta_service, brpc::SERVER_DOESNT_OWN_SERVICE) != 0 ||
+      server.AddService(&impl_->store_service, brpc::SERVER_DOESNT_OWN_SERVICE) != 0 ||
+      server.AddService(&impl_->index_service, brpc::SERVER_DOESNT_OWN_SERVICE) != 0 ||
+      server.AddService(&impl_->document_service, brpc::SERVER_DOESNT_OWN_SERVICE) != 0) {
+    LOG(ERROR) << "Add mock service failed";
+    impl_.reset();
+    return false;
+  }
+
+  brpc::ServerOptions options;
+  if (server.Start(addr.c_str(), &options) != 0) {
+    LOG(ERROR) << fmt::format("Start mock server at {} failed", addr);
+    impl_.reset();
+    return false;
+  }
+#endif
+
+  LOG(INFO) << fmt::format("Mock server started at {}", addr);
+  out_addrs = addr;
+  return true;
+}
+
+void MockServer::Stop() {
+  if (impl_ == nullptr) {
+    return;
+  }
+
+#ifdef USE_GRPC
+  impl_->server->Shutdown();
+#else
+  impl_->server.Stop(0);
+  impl_->server.Join();
+#endif
+  impl_.reset();
+}
+
+}  // namespace benchmark
+}  // namespace dingodb
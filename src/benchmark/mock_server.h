@@ -0,0 +1,155 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_BENCHMARK_MOCK_SERVER_H_
+#define DINGODB_BENCHMARK_MOCK_SERVER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "proto/common.pb.h"
+#include "proto/coordinator.pb.h"
+#include "proto/document.pb.h"
+#include "proto/error.pb.h"
+#include "proto/index.pb.h"
+#include "proto/meta.pb.h"
+#include "proto/store.pb.h"
+
+namespace dingodb {
+namespace benchmark {
+
+// In-process fake of coordinator and store, see FLAGS_mock_server.
+// All services listen on one endpoint, which is both the coordinator and the leader of every region.
+// Store requests get canned responses after FLAGS_mock_server_latency_us, so the benchmark measures
+// how much the sdk itself costs, not the store.
+class MockCluster {
+ public:
+  MockCluster(std::string host, int port);
+  ~MockCluster() = default;
+
+  // coordinator service
+  void Hello(const pb::coordinator::HelloRequest& request, pb::coordinator::HelloResponse* response);
+  void CreateRegion(const pb::coordinator::CreateRegionRequest& request, pb::coordinator::CreateRegionResponse* response);
+  void DropRegion(const pb::coordinator::DropRegionRequest& request, pb::coordinator::DropRegionResponse* response);
+  void QueryRegion(const pb::coordinator::QueryRegionRequest& request, pb::coordinator::QueryRegionResponse* response);
+  void ScanRegions(const pb::coordinator::ScanRegionsRequest& request, pb::coordinator::ScanRegionsResponse* response);
+
+  // meta service
+  void TsoService(const pb::meta::TsoRequest& request, pb::meta::TsoResponse* response);
+  void CreateTableIds(const pb::meta::CreateTableIdsRequest& request, pb::meta::CreateTableIdsResponse* response);
+  void CreateIndex(const pb::meta::CreateIndexRequest& request, pb::meta::CreateIndexResponse* response);
+  void GetIndex(const pb::meta::GetIndexRequest& request, pb::meta::GetIndexResponse* response);
+  void GetIndexByName(const pb::meta::GetIndexByNameRequest& request, pb::meta::GetIndexByNameResponse* response);
+  void DropIndex(const pb::meta::DropIndexRequest& request, pb::meta::DropIndexResponse* response);
+
+  // store service
+  void KvGet(const pb::store::KvGetRequest& request, pb::store::KvGetResponse* response);
+  void KvBatchGet(const pb::store::KvBatchGetRequest& request, pb::store::KvBatchGetResponse* response);
+  void KvPut(const pb::store::KvPutRequest& request, pb::store::KvPutResponse* response);
+  void KvBatchPut(const pb::store::KvBatchPutRequest& request, pb::store::KvBatchPutResponse* response);
+  void KvPutIfAbsent(const pb::store::KvPutIfAbsentRequest& request, pb::store::KvPutIfAbsentResponse* response);
+  void KvBatchPutIfAbsent(const pb::store::KvBatchPutIfAbsentRequest& request,
+                          pb::store::KvBatchPutIfAbsentResponse* response);
+  void KvBatchDelete(const pb::store::KvBatchDeleteRequest& request, pb::store::KvBatchDeleteResponse* response);
+  void KvDeleteRange(const pb::store::KvDeleteRangeRequest& request, pb::store::KvDeleteRangeResponse* response);
+  void KvCompareAndSet(const pb::store::KvCompareAndSetRequest& request, pb::store::KvCompareAndSetResponse* response);
+  void KvBatchCompareAndSet(const pb::store::KvBatchCompareAndSetRequest& request,
+                            pb::store::KvBatchCompareAndSetResponse* response);
+  void KvScanBegin(const pb::store::KvScanBeginRequest& request, pb::store::KvScanBeginResponse* response);
+  void KvScanContinue(const pb::store::KvScanContinueRequest& request, pb::store::KvScanContinueResponse* response);
+  void KvScanRelease(const pb::store::KvScanReleaseRequest& request, pb::store::KvScanReleaseResponse* response);
+
+  void TxnGet(const pb::store::TxnGetRequest& request, pb::store::TxnGetResponse* response);
+  void TxnBatchGet(const pb::store::TxnBatchGetRequest& request, pb::store::TxnBatchGetResponse* response);
+  void TxnScan(const pb::store::TxnScanRequest& request, pb::store::TxnScanResponse* response);
+  void TxnPrewrite(const pb::store::TxnPrewriteRequest& request, pb::store::TxnPrewriteResponse* response);
+  void TxnCommit(const pb::store::TxnCommitRequest& request, pb::store::TxnCommitResponse* response);
+  void TxnBatchRollback(const pb::store::TxnBatchRollbackRequest& request,
+                        pb::store::TxnBatchRollbackResponse* response);
+  void TxnHeartBeat(const pb::store::TxnHeartBeatRequest& request, pb::store::TxnHeartBeatResponse* response);
+  void TxnCheckTxnStatus(const pb::store::TxnCheckTxnStatusRequest& request,
+                         pb::store::TxnCheckTxnStatusResponse* response);
+  void TxnResolveLock(const pb::store::TxnResolveLockRequest& request, pb::store::TxnResolveLockResponse* response);
+
+  // index service
+  void VectorAdd(const pb::index::VectorAddRequest& request, pb::index::VectorAddResponse* response);
+  void VectorSearch(const pb::index::VectorSearchRequest& request, pb::index::VectorSearchResponse* response);
+  void VectorBatchQuery(const pb::index::VectorBatchQueryRequest& request,
+                        pb::index::VectorBatchQueryResponse* response);
+  void VectorDelete(const pb::index::VectorDeleteRequest& request, pb::index::VectorDeleteResponse* response);
+  void VectorCount(const pb::index::VectorCountRequest& request, pb::index::VectorCountResponse* response);
+
+  // document service
+  void DocumentAdd(const pb::document::DocumentAddRequest& request, pb::document::DocumentAddResponse* response);
+  void DocumentSearch(const pb::document::DocumentSearchRequest& request,
+                      pb::document::DocumentSearchResponse* response);
+  void DocumentDelete(const pb::document::DocumentDeleteRequest& request,
+                      pb::document::DocumentDeleteResponse* response);
+  void DocumentCount(const pb::document::DocumentCountRequest& request, pb::document::DocumentCountResponse* response);
+
+ private:
+  struct Region {
+    int64_t id;
+    pb::common::Range range;
+    pb::common::RegionEpoch epoch;
+    pb::common::RegionType type;
+  };
+
+  int64_t AddRegion(const pb::common::Range& range, pb::common::RegionType type);
+
+  // sleep FLAGS_mock_server_latency_us, inject error, then check region and epoch like a store does,
+  // return false when error is set and the request should not be served
+  template <typename Context>
+  bool PrepareStoreRequest(const Context& context, pb::error::Error* error);
+
+  void FillLocation(pb::common::Location* location) const;
+
+  const std::string host_;
+  const int port_;
+  // returned as value of every read
+  const std::string canned_value_;
+
+  std::atomic<int64_t> next_id_{10000};
+
+  std::mutex mutex_;
+  std::map<int64_t, Region> regions_;
+  std::map<int64_t, pb::meta::IndexDefinitionWithId> indexes_;
+  int64_t tso_physical_{0};
+  int64_t tso_logical_{0};
+};
+
+class MockServer {
+ public:
+  static MockServer& GetInstance();
+
+  // start all services on FLAGS_mock_server_port, return coordinator addrs for sdk
+  bool Start(std::string& out_addrs);
+  void Stop();
+
+ private:
+  MockServer();
+  ~MockServer();
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace benchmark
+}  // namespace dingodb
+
+#endif  // DINGODB_BENCHMARK_MOCK_SERVER_H_
@@ -16,29 +16,38 @@
 
 #include <unistd.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <map>
 #include <memory>
 #include <random>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "benchmark/benchmark.h"
 #include "benchmark/dataset.h"
+#include "benchmark/zipfian_generator.h"
+#include "color.h"
 #include "common/logging.h"
 #include "fmt/core.h"
 #include "gflags/gflags.h"
 #include "gflags/gflags_declare.h"
 #include "glog/logging.h"
+#include "sdk/common/metrics.h"
+#include "sdk/rpc/store_rpc.h"
 #include "sdk/vector.h"
 #include "util.h"
 
 DEFINE_string(benchmark, "fillseq", "Benchmark type");
 DEFINE_validator(benchmark, [](const char*, const std::string& value) -> bool {
-  return dingodb::benchmark::IsSupportBenchmarkType(value) || value == "preprocess";
+  return dingodb::benchmark::IsSupportBenchmarkType(value) || value == "preprocess" || value == "compare";
 });
 
 DEFINE_uint32(key_size, 64, "Key size");
@@ -48,6 +57,42 @@ DEFINE_uint32(batch_size, 1, "Batch size");
 
 DEFINE_uint32(arrange_kv_num, 10000, "The number of kv for read");
 
+// mixed workload
+DEFINE_string(ycsb_workload, "", "Mixed benchmark preset, a-f as YCSB core workloads, empty means use mixed_*_ratio");
+DEFINE_validator(ycsb_workload, [](const char*, const std::string& value) -> bool {
+  return value.empty() || (value.size() == 1 && value[0] >= 'a' && value[0] <= 'f');
+});
+DEFINE_double(mixed_read_ratio, 0.5, "Mixed benchmark proportion of read");
+DEFINE_double(mixed_update_ratio, 0.5, "Mixed benchmark proportion of overwrite an existing key");
+DEFINE_double(mixed_insert_ratio, 0.0, "Mixed benchmark proportion of write a new key");
+DEFINE_double(mixed_scan_ratio, 0.0, "Mixed benchmark proportion of short range scan");
+DEFINE_double(mixed_rmw_ratio, 0.0, "Mixed benchmark proportion of read then write the same key");
+DEFINE_double(mixed_txn_ratio, 0.0, "Mixed benchmark proportion of read-modify-write transaction over a txn region");
+DEFINE_string(mixed_key_distribution, "zipfian", "Mixed benchmark key distribution, uniform/zipfian/latest");
+DEFINE_validator(mixed_key_distribution, [](const char*, const std::string& value) -> bool {
+  return value == "uniform" || value == "zipfian" || value == "latest";
+});
+DEFINE_double(zipfian_constant, dingodb::benchmark::ZipfianGenerator::kDefaultTheta,
+              "Zipfian distribution skew, in (0, 1), the bigger the hotter");
+DEFINE_validator(zipfian_constant, [](const char*, double value) -> bool { return value > 0 && value < 1; });
+DEFINE_uint32(mixed_scan_max_len, 100, "Mixed benchmark scan length is uniform in [1, mixed_scan_max_len]");
+DEFINE_uint32(mixed_txn_key_num, 4, "Mixed benchmark key number of per transaction");
+
+// txn contention workload
+DEFINE_uint32(txn_hot_key_num, 1000, "Txn contention benchmark key number of per region, the less the more conflict");
+DEFINE_uint32(txn_contention_key_num, 4, "Txn contention benchmark key number of per transaction");
+DEFINE_double(txn_rmw_ratio, 1.0, "Txn contention benchmark proportion of read-modify-write, others are blind write");
+DEFINE_validator(txn_rmw_ratio, [](const char*, double value) -> bool { return value >= 0 && value <= 1; });
+DEFINE_string(txn_key_distribution, "zipfian", "Txn contention benchmark key distribution, uniform/zipfian");
+DEFINE_validator(txn_key_distribution,
+                 [](const char*, const std::string& value) -> bool { return value == "uniform" || value == "zipfian"; });
+
+// scan and deleterange workload
+DEFINE_uint32(scan_range_width, 100, "Scan and deleterange benchmark arranged key number of per range");
+DEFINE_validator(scan_range_width, [](const char*, uint32_t value) -> bool { return value > 0; });
+DEFINE_uint32(scan_limit, 0, "Scan benchmark max kv number of per scan, 0 means no limit");
+DEFINE_bool(scan_key_only, false, "Scan benchmark only fetch keys, values are empty");
+
 DEFINE_bool(is_pessimistic_txn, false, "Optimistic or pessimistic transaction");
 DEFINE_string(txn_isolation_level, "SI", "Transaction isolation level");
 DEFINE_validator(txn_isolation_level, [](const char*, const std::string& value) -> bool {
@@ -93,6 +138,14 @@ DEFINE_bool(use_coprocessor, false, "Vector search use coprocessor");
 DEFINE_uint32(vector_search_filter_vector_id_num, 10000, "Vector search filter vector id num");
 DEFINE_bool(filter_vector_id_is_negation, false, "Use negation vector id filter");
 
+// document search
+DEFINE_uint32(document_search_topn, 10, "Document search top_n");
+DEFINE_string(document_search_column_names, "", "Document search columns separated by comma, empty means all");
+DEFINE_uint32(document_scan_query_count, 100, "Document scan query max doc number of per scan");
+DEFINE_uint32(document_word_num, 16, "Word number of per generated document text");
+DEFINE_uint32(document_vocabulary_size, 10000, "Word number of generated document vocabulary, the less the more hits");
+DEFINE_validator(document_vocabulary_size, [](const char*, uint32_t value) -> bool { return value > 0; });
+
 namespace dingodb {
 namespace benchmark {
 
@@ -151,6 +204,40 @@ static OperationBuilderMap support_operations = {
      [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
        return std::make_shared<VectorQueryOperation>(client);
      }},
+    {"filldocumentseq",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
+       return std::make_shared<DocumentFillSeqOperation>(client);
+     }},
+    {"searchdocument",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
+       return std::make_shared<DocumentSearchOperation>(client);
+     }},
+    {"scanquerydocument",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
+       return std::make_shared<DocumentScanQueryOperation>(client);
+     }},
+    {"txncontention",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
+       return std::make_shared<TxnContentionOperation>(client);
+     }},
+    {"mixed",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr { return std::make_shared<MixedOperation>(client); }},
+    {"scanseq",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr { return std::make_shared<ScanSeqOperation>(client); }},
+    {"scanrandom",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
+       return std::make_shared<ScanRandomRangeOperation>(client);
+     }},
+    {"scantxnseq",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr { return std::make_shared<TxnScanSeqOperation>(client); }},
+    {"scantxnrandom",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
+       return std::make_shared<TxnScanRandomRangeOperation>(client);
+     }},
+    {"deleterange",
+     [](std::shared_ptr<sdk::Client> client) -> OperationPtr {
+       return std::make_shared<DeleteRangeOperation>(client);
+     }},
 };
 
 static sdk::TransactionIsolation GetTxnIsolationLevel() {
@@ -285,6 +372,42 @@ Operation::Result BaseOperation::KvBatchGet(const std::vector<std::string>& keys
   return result;
 }
 
+static sdk::ScanOptions GetScanOptions() {
+  sdk::ScanOptions options;
+  options.key_only = FLAGS_scan_key_only;
+  return options;
+}
+
+Operation::Result BaseOperation::KvScan(const std::string& start_key, const std::string& end_key) {
+  Operation::Result result;
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  std::vector<sdk::KVPair> kvs;
+  result.status = raw_kv->Scan(start_key, end_key, FLAGS_scan_limit, kvs, GetScanOptions());
+
+  for (auto& kv : kvs) {
+    result.read_bytes += kv.key.size() + kv.value.size();
+  }
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+
+  return result;
+}
+
+Operation::Result BaseOperation::KvDeleteRange(const std::string& start_key, const std::string& end_key) {
+  Operation::Result result;
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  int64_t delete_count = 0;
+  result.status = raw_kv->DeleteRange(start_key, end_key, delete_count);
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+
+  return result;
+}
+
 Operation::Result BaseOperation::KvTxnPut(std::vector<RegionEntryPtr>& region_entries, bool is_random) {
   std::vector<sdk::KVPair> kvs;
   for (const auto& region_entry : region_entries) {
@@ -454,6 +577,54 @@ end:
   return result;
 }
 
+Operation::Result BaseOperation::KvTxnScan(const std::vector<std::pair<std::string, std::string>>& ranges) {
+  Operation::Result result;
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  sdk::Transaction* txn = nullptr;
+  sdk::TransactionOptions options;
+  options.kind = FLAGS_is_pessimistic_txn ? sdk::TransactionKind::kPessimistic : sdk::TransactionKind::kOptimistic;
+  options.isolation = GetTxnIsolationLevel();
+  sdk::ScanOptions scan_options = GetScanOptions();
+
+  result.status = client->NewTransaction(options, &txn);
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("new transaction failed, error: {}", result.status.ToString());
+    goto end;
+  }
+
+  for (const auto& [start_key, end_key] : ranges) {
+    std::vector<sdk::KVPair> kvs;
+    result.status = txn->Scan(start_key, end_key, FLAGS_scan_limit, kvs, scan_options);
+    if (!result.status.IsOK()) {
+      LOG(ERROR) << fmt::format("transaction scan failed, error: {}", result.status.ToString());
+      goto end;
+    }
+
+    for (auto& kv : kvs) {
+      result.read_bytes += kv.key.size() + kv.value.size();
+    }
+  }
+
+  result.status = txn->PreCommit();
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("pre commit transaction failed, error: {}", result.status.ToString());
+    goto end;
+  }
+
+  result.status = txn->Commit();
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("commit transaction failed, error: {}", result.status.ToString());
+  }
+
+end:
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+  delete txn;
+
+  return result;
+}
+
 Operation::Result BaseOperation::KvTxnBatchGet(const std::vector<std::vector<std::string>>& keys) {
   Operation::Result result;
 
@@ -598,6 +769,91 @@ Operation::Result BaseOperation::VectorBatchQuery(VectorIndexEntryPtr entry, con
   return result;
 }
 
+Operation::Result BaseOperation::DocumentAdd(VectorIndexEntryPtr entry, std::vector<sdk::DocWithId>& docs) {
+  Operation::Result result;
+
+  for (const auto& doc : docs) {
+    for (const auto& [key, value] : doc.doc.GetFields()) {
+      result.write_bytes += key.size() + (value.GetType() == sdk::Type::kSTRING ? value.StringValue().size() : 8);
+    }
+  }
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  sdk::DocumentClient* document_client = nullptr;
+  result.status = client->NewDocumentClient(&document_client);
+  if (!result.status.IsOK()) {
+    return result;
+  }
+
+  result.status = document_client->AddByIndexId(entry->index_id, docs);
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("add document failed, error: {}", result.status.ToString());
+  }
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+
+  delete document_client;
+
+  return result;
+}
+
+Operation::Result BaseOperation::DocumentSearch(VectorIndexEntryPtr entry, const sdk::DocSearchParam& search_param) {
+  Operation::Result result;
+
+  result.write_bytes = search_param.query_string.size();
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  sdk::DocumentClient* document_client = nullptr;
+  result.status = client->NewDocumentClient(&document_client);
+  if (!result.status.IsOK()) {
+    return result;
+  }
+
+  result.status = document_client->SearchByIndexId(entry->index_id, search_param, result.doc_search_result);
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("search document failed, error: {}", result.status.ToString());
+  }
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+
+  delete document_client;
+
+  return result;
+}
+
+Operation::Result BaseOperation::DocumentScanQuery(VectorIndexEntryPtr entry,
+                                                  const sdk::DocScanQueryParam& query_param) {
+  Operation::Result result;
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  sdk::DocumentClient* document_client = nullptr;
+  result.status = client->NewDocumentClient(&document_client);
+  if (!result.status.IsOK()) {
+    return result;
+  }
+
+  sdk::DocScanQueryResult query_result;
+  result.status = document_client->ScanQueryByIndexId(entry->index_id, query_param, query_result);
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("scan query document failed, error: {}", result.status.ToString());
+  }
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+
+  for (const auto& doc : query_result.docs) {
+    for (const auto& [key, value] : doc.doc.GetFields()) {
+      result.read_bytes += key.size() + (value.GetType() == sdk::Type::kSTRING ? value.StringValue().size() : 8);
+    }
+  }
+
+  delete document_client;
+
+  return result;
+}
+
 Operation::Result FillSeqOperation::Execute(RegionEntryPtr region_entry) {
   return FLAGS_batch_size == 1 ? KvPut(region_entry, false) : KvBatchPut(region_entry, false);
 }
@@ -882,6 +1138,69 @@ Operation::Result TxnReadMissingOperation::Execute(std::vector<RegionEntryPtr>&
   }
 }
 
+// arranged keys are fixed width sequence in ascending order, the range covers scan_range_width keys from index
+static std::pair<std::string, std::string> GetScanRange(const std::vector<std::string>& keys, size_t index) {
+  index %= keys.size();
+  size_t end_index = index + FLAGS_scan_range_width;
+  // past the last arranged key, end right after it
+  std::string end_key = end_index < keys.size() ? keys[end_index] : keys.back() + '\0';
+  return {keys[index], end_key};
+}
+
+static std::pair<std::string, std::string> GetSeqScanRange(RegionEntryPtr region_entry) {
+  auto range = GetScanRange(region_entry->keys, region_entry->read_index);
+  region_entry->read_index = (region_entry->read_index + FLAGS_scan_range_width) % region_entry->keys.size();
+  return range;
+}
+
+static std::pair<std::string, std::string> GetRandomScanRange(RegionEntryPtr region_entry) {
+  uint32_t index = dingodb::benchmark::GenerateRealRandomInteger(0, UINT32_MAX) % region_entry->keys.size();
+  return GetScanRange(region_entry->keys, index);
+}
+
+Operation::Result ScanSeqOperation::Execute(RegionEntryPtr region_entry) {
+  auto [start_key, end_key] = GetSeqScanRange(region_entry);
+  return KvScan(start_key, end_key);
+}
+
+Operation::Result ScanRandomRangeOperation::Execute(RegionEntryPtr region_entry) {
+  auto [start_key, end_key] = GetRandomScanRange(region_entry);
+  return KvScan(start_key, end_key);
+}
+
+Operation::Result TxnScanSeqOperation::Execute(RegionEntryPtr region_entry) {
+  return KvTxnScan({GetSeqScanRange(region_entry)});
+}
+
+Operation::Result TxnScanSeqOperation::Execute(std::vector<RegionEntryPtr>& region_entries) {
+  std::vector<std::pair<std::string, std::string>> ranges;
+  ranges.reserve(region_entries.size());
+  for (auto& region_entry : region_entries) {
+    ranges.push_back(GetSeqScanRange(region_entry));
+  }
+
+  return KvTxnScan(ranges);
+}
+
+Operation::Result TxnScanRandomRangeOperation::Execute(RegionEntryPtr region_entry) {
+  return KvTxnScan({GetRandomScanRange(region_entry)});
+}
+
+Operation::Result TxnScanRandomRangeOperation::Execute(std::vector<RegionEntryPtr>& region_entries) {
+  std::vector<std::pair<std::string, std::string>> ranges;
+  ranges.reserve(region_entries.size());
+  for (auto& region_entry : region_entries) {
+    ranges.push_back(GetRandomScanRange(region_entry));
+  }
+
+  return KvTxnScan(ranges);
+}
+
+Operation::Result DeleteRangeOperation::Execute(RegionEntryPtr region_entry) {
+  auto [start_key, end_key] = GetSeqScanRange(region_entry);
+  return KvDeleteRange(start_key, end_key);
+}
+
 template <typename T>
 static void PrintVector(const std::vector<T>& vec) {
   for (const auto& v : vec) {
@@ -1185,16 +1504,39 @@ Operation::Result VectorSearchOperation::ExecuteAutoData(VectorIndexEntryPtr ent
   return VectorSearch(entry, vector_with_ids, search_param);
 }
 
+// recall@topk, ground truth is the topk nearest of neighbors, neighbors may hold more
+// than topk when vector search sweep loads them for the largest topk
 uint32_t CalculateRecallRate(const std::unordered_map<int64_t, float>& neighbors,
-                             const std::vector<sdk::VectorWithDistance>& vector_with_distances) {
+                             const std::vector<sdk::VectorWithDistance>& vector_with_distances, uint32_t topk) {
+  if (neighbors.empty()) {
+    return 0;
+  }
+
+  std::unordered_set<int64_t> truth_ids;
+  if (topk > 0 && neighbors.size() > topk) {
+    std::vector<std::pair<float, int64_t>> distance_ids;
+    distance_ids.reserve(neighbors.size());
+    for (const auto& [id, distance] : neighbors) {
+      distance_ids.emplace_back(distance, id);
+    }
+    std::partial_sort(distance_ids.begin(), distance_ids.begin() + topk, distance_ids.end());
+    for (uint32_t i = 0; i < topk; ++i) {
+      truth_ids.insert(distance_ids[i].second);
+    }
+  } else {
+    for (const auto& [id, _] : neighbors) {
+      truth_ids.insert(id);
+    }
+  }
+
   uint32_t hit_count = 0;
   for (const auto& vector_with_distance : vector_with_distances) {
-    if (neighbors.find(vector_with_distance.vector_data.id) != neighbors.end()) {
+    if (truth_ids.count(vector_with_distance.vector_data.id) > 0) {
       ++hit_count;
     }
   }
 
-  return (hit_count * 10000) / neighbors.size();
+  return (hit_count * 10000) / truth_ids.size();
 }
 
 Operation::Result VectorSearchOperation::ExecuteManualData(VectorIndexEntryPtr entry) {
@@ -1279,7 +1621,8 @@ Operation::Result VectorSearchOperation::ExecuteManualData(VectorIndexEntryPtr e
     if (i < result.vector_search_results.size()) {
       auto& search_result = result.vector_search_results[i];
 
-      result.recalls.push_back(CalculateRecallRate(entry->neighbors, search_result.vector_datas));
+      result.recalls.push_back(
+          CalculateRecallRate(entry->neighbors, search_result.vector_datas, FLAGS_vector_search_topk));
     } else {
       result.recalls.push_back(0);
     }
@@ -1341,23 +1684,769 @@ Operation::Result VectorQueryOperation::ExecuteManualData(VectorIndexEntryPtr en
   return VectorBatchQuery(entry, query_param);
 }
 
-bool IsSupportBenchmarkType(const std::string& benchmark) {
-  auto it = support_operations.find(benchmark);
-  return it != support_operations.end();
+static std::string GenDocumentWord() {
+  return fmt::format("word{}", dingodb::benchmark::GenerateRealRandomInteger(0, FLAGS_document_vocabulary_size - 1));
 }
 
-std::string GetSupportBenchmarkType() {
-  std::string benchmarks;
-  for (auto& [benchmark, _] : support_operations) {
-    benchmarks += benchmark;
-    benchmarks += " ";
+static sdk::DocWithId GenDocWithId(int64_t doc_id) {
+  std::string text;
+  for (uint32_t i = 0; i < FLAGS_document_word_num; ++i) {
+    if (i > 0) {
+      text += ' ';
+    }
+    text += GenDocumentWord();
   }
 
-  return benchmarks;
+  sdk::Document doc;
+  doc.AddField("id", sdk::DocValue::FromInt(doc_id));
+  doc.AddField("title", sdk::DocValue::FromString(GenDocumentWord()));
+  doc.AddField("text", sdk::DocValue::FromString(text));
+
+  return sdk::DocWithId(doc_id, std::move(doc));
+}
+
+// dataset train data carries the doc fields in scalar data, only the columns of the document schema are kept
+static sdk::DocWithId ToDocWithId(const sdk::VectorWithId& vector_with_id) {
+  sdk::Document doc;
+  for (const auto& [key, scalar_value] : vector_with_id.scalar_data) {
+    if (scalar_value.fields.empty()) {
+      continue;
+    }
+
+    if (key == "id" && scalar_value.type == sdk::Type::kINT64) {
+      doc.AddField(key, sdk::DocValue::FromInt(scalar_value.fields[0].long_data));
+    } else if ((key == "title" || key == "text") && scalar_value.type == sdk::Type::kSTRING) {
+      doc.AddField(key, sdk::DocValue::FromString(scalar_value.fields[0].string_data));
+    }
+  }
+
+  return sdk::DocWithId(vector_with_id.id, std::move(doc));
+}
+
+Operation::Result DocumentFillSeqOperation::Execute(VectorIndexEntryPtr entry) {
+  uint32_t batch_size = std::max<uint32_t>(FLAGS_batch_size, 1);
+  std::vector<sdk::DocWithId> docs;
+  docs.reserve(batch_size);
+  for (uint32_t i = 0; i < batch_size; ++i) {
+    docs.push_back(GenDocWithId(entry->GenId()));
+  }
+
+  return DocumentAdd(entry, docs);
+}
+
+bool DocumentSearchOperation::Arrange(VectorIndexEntryPtr entry, DatasetPtr dataset) {
+  if (FLAGS_vector_dataset.empty()) {
+    return !FLAGS_vector_search_arrange_data || ArrangeAutoData(entry);
+  }
+
+  if (FLAGS_vector_search_arrange_data && !ArrangeManualData(entry, dataset)) {
+    return false;
+  }
+
+  // only queries with text can search
+  for (auto& test_entry : dataset->GetTestData()) {
+    if (!test_entry->query_text.empty()) {
+      entry->test_entries.push_back(test_entry);
+    }
+  }
+
+  return !entry->test_entries.empty();
+}
+
+bool DocumentSearchOperation::ArrangeAutoData(VectorIndexEntryPtr entry) {
+  std::vector<sdk::DocWithId> docs;
+  docs.reserve(FLAGS_vector_put_batch_size);
+
+  uint32_t count = 0;
+  uint32_t fail_count = 0;
+  for (uint32_t i = 0; i < FLAGS_arrange_kv_num; ++i) {
+    docs.push_back(GenDocWithId(entry->GenId()));
+    if (docs.size() < FLAGS_vector_put_batch_size && i + 1 != FLAGS_arrange_kv_num) {
+      continue;
+    }
+
+    auto result = DocumentAdd(entry, docs);
+    if (result.status.IsOK()) {
+      count += docs.size();
+    } else {
+      fail_count += docs.size();
+    }
+    docs.clear();
+
+    std::cout << '\r'
+              << fmt::format("document index({}) add data progress [{} / {} / {} {}%]", entry->index_id, count,
+                             fail_count, FLAGS_arrange_kv_num, (i + 1) * 100 / FLAGS_arrange_kv_num)
+              << std::flush;
+  }
+
+  std::cout << "\r"
+            << fmt::format("document index({}) add data success({}) fail({}) .................. done", entry->index_id,
+                           count, fail_count)
+            << '\n';
+
+  return true;
 }
 
-OperationPtr NewOperation(std::shared_ptr<sdk::Client> client) {
-  auto it = support_operations.find(FLAGS_benchmark);
+bool DocumentSearchOperation::ArrangeManualData(VectorIndexEntryPtr entry, DatasetPtr dataset) {
+  uint32_t count = 0;
+  uint32_t fail_count = 0;
+  int64_t max_doc_id = 0;
+  bool is_eof = false;
+  for (uint32_t batch_num = 0; !is_eof; ++batch_num) {
+    std::vector<sdk::VectorWithId> vector_with_ids;
+    dataset->GetBatchTrainData(batch_num, vector_with_ids, is_eof);
+    if (vector_with_ids.empty()) {
+      continue;
+    }
+
+    std::vector<sdk::DocWithId> docs;
+    docs.reserve(vector_with_ids.size());
+    for (const auto& vector_with_id : vector_with_ids) {
+      docs.push_back(ToDocWithId(vector_with_id));
+      max_doc_id = std::max(max_doc_id, vector_with_id.id);
+    }
+
+    auto result = DocumentAdd(entry, docs);
+    if (result.status.IsOK()) {
+      count += docs.size();
+    } else {
+      fail_count += docs.size();
+    }
+
+    std::cout << '\r'
+              << fmt::format("Document index({}) add data progress [{} / {} / {}]", entry->index_id, count, fail_count,
+                             dataset->GetTrainDataCount())
+              << std::flush;
+  }
+
+  std::cout << "\r"
+            << fmt::format("Document index({}) add data success({}) fail({}) .................. done", entry->index_id,
+                           count, fail_count)
+            << '\n';
+
+  // scan query picks start ids below counter
+  entry->counter.store(max_doc_id + 1);
+
+  return true;
+}
+
+static sdk::DocSearchParam GenDocSearchParam(const std::string& query_string) {
+  sdk::DocSearchParam search_param;
+  search_param.top_n = FLAGS_document_search_topn;
+  search_param.query_string = query_string;
+  search_param.with_scalar_data = FLAGS_with_scalar_data;
+  if (!FLAGS_document_search_column_names.empty()) {
+    SplitString(FLAGS_document_search_column_names, ',', search_param.column_names);
+  }
+
+  return search_param;
+}
+
+// recall@top_n against docs of positive relevance, in 1/10000 as CalculateRecallRate
+static uint32_t CalculateDocumentRecallRate(const std::unordered_map<int64_t, int32_t>& qrels,
+                                            const std::vector<sdk::DocWithStore>& doc_scores) {
+  uint32_t relevant_count = 0;
+  for (const auto& [_, relevance] : qrels) {
+    relevant_count += relevance > 0 ? 1 : 0;
+  }
+  if (relevant_count == 0) {
+    return 0;
+  }
+
+  uint32_t hit_count = 0;
+  for (const auto& doc_score : doc_scores) {
+    auto it = qrels.find(doc_score.doc_with_id.id);
+    if (it != qrels.end() && it->second > 0) {
+      ++hit_count;
+    }
+  }
+
+  return (hit_count * 10000) / relevant_count;
+}
+
+// ndcg@top_n with linear gain, results are in descending score order
+static double CalculateNdcg(const std::unordered_map<int64_t, int32_t>& qrels,
+                            const std::vector<sdk::DocWithStore>& doc_scores, uint32_t top_n) {
+  double dcg = 0;
+  for (size_t i = 0; i < doc_scores.size() && i < top_n; ++i) {
+    auto it = qrels.find(doc_scores[i].doc_with_id.id);
+    if (it != qrels.end() && it->second > 0) {
+      dcg += it->second / std::log2(i + 2);
+    }
+  }
+
+  std::vector<int32_t> relevances;
+  relevances.reserve(qrels.size());
+  for (const auto& [_, relevance] : qrels) {
+    relevances.push_back(relevance);
+  }
+  std::sort(relevances.begin(), relevances.end(), std::greater<>());
+
+  double idcg = 0;
+  for (size_t i = 0; i < relevances.size() && i < top_n && relevances[i] > 0; ++i) {
+    idcg += relevances[i] / std::log2(i + 2);
+  }
+
+  return idcg > 0 ? dcg / idcg : 0;
+}
+
+Operation::Result DocumentSearchOperation::Execute(VectorIndexEntryPtr entry) {
+  if (entry->test_entries.empty()) {
+    return DocumentSearch(entry, GenDocSearchParam(GenDocumentWord()));
+  }
+
+  auto& test_entry = entry->test_entries[entry->GenId() % entry->test_entries.size()];
+  auto result = DocumentSearch(entry, GenDocSearchParam(test_entry->query_text));
+  if (!result.status.IsOK() || test_entry->qrels.empty()) {
+    return result;
+  }
+
+  const auto& doc_scores = result.doc_search_result.doc_sores;
+  result.recalls.push_back(CalculateDocumentRecallRate(test_entry->qrels, doc_scores));
+
+  double ndcg = CalculateNdcg(test_entry->qrels, doc_scores, FLAGS_document_search_topn);
+  std::lock_guard lock(mutex_);
+  ndcg_sum_ += ndcg;
+  ++ndcg_count_;
+
+  return result;
+}
+
+void DocumentSearchOperation::Report() const {
+  std::lock_guard lock(mutex_);
+  if (ndcg_count_ == 0) {
+    return;
+  }
+
+  std::cout << fmt::format("{:>16}{:>16}", "QUERIES", fmt::format("NDCG@{}", FLAGS_document_search_topn)) << '\n';
+  std::cout << fmt::format("{:>16}{:>16.4f}", ndcg_count_, ndcg_sum_ / ndcg_count_) << '\n';
+}
+
+Operation::Result DocumentScanQueryOperation::Execute(VectorIndexEntryPtr entry) {
+  sdk::DocScanQueryParam query_param;
+  query_param.max_scan_count = FLAGS_document_scan_query_count;
+  query_param.with_scalar_data = FLAGS_with_scalar_data;
+
+  // start at a random doc of the arranged ids, counter is past the largest one
+  int64_t max_doc_id = std::max<int64_t>(entry->counter.load() - 1, 1);
+  query_param.doc_id_start = dingodb::benchmark::GenerateRealRandomInteger(1, max_doc_id);
+
+  return DocumentScanQuery(entry, query_param);
+}
+
+// ratios indexed by MixedOperation::OpType, ycsb_workload overrides mixed_*_ratio
+static std::vector<double> GetMixedRatios() {
+  static const std::map<std::string, std::vector<double>> kYcsbWorkloads = {
+      // read update insert scan rmw txn
+      {"a", {0.5, 0.5, 0, 0, 0, 0}},    // update heavy
+      {"b", {0.95, 0.05, 0, 0, 0, 0}},  // read mostly
+      {"c", {1, 0, 0, 0, 0, 0}},        // read only
+      {"d", {0.95, 0, 0.05, 0, 0, 0}},  // read latest
+      {"e", {0, 0, 0.05, 0.95, 0, 0}},  // short ranges
+      {"f", {0.5, 0, 0, 0, 0.5, 0}},    // read-modify-write
+  };
+
+  auto it = kYcsbWorkloads.find(FLAGS_ycsb_workload);
+  if (it != kYcsbWorkloads.end()) {
+    return it->second;
+  }
+
+  return {FLAGS_mixed_read_ratio, FLAGS_mixed_update_ratio, FLAGS_mixed_insert_ratio,
+          FLAGS_mixed_scan_ratio, FLAGS_mixed_rmw_ratio,    FLAGS_mixed_txn_ratio};
+}
+
+static MixedOperation::KeyDistribution GetMixedKeyDistribution() {
+  // YCSB workload d reads the latest inserted records
+  std::string distribution = FLAGS_mixed_key_distribution;
+  if (!FLAGS_ycsb_workload.empty()) {
+    distribution = FLAGS_ycsb_workload == "d" ? "latest" : "zipfian";
+  }
+  if (distribution == "uniform") {
+    return MixedOperation::KeyDistribution::kUniform;
+  } else if (distribution == "latest") {
+    return MixedOperation::KeyDistribution::kLatest;
+  }
+
+  return MixedOperation::KeyDistribution::kZipfian;
+}
+
+static std::string GenMixedKey(const std::string& prefix, size_t index) {
+  return prefix + GenSeqString(index, FLAGS_key_size - prefix.size());
+}
+
+MixedOperation::MixedOperation(std::shared_ptr<sdk::Client> client)
+    : BaseOperation(client),
+      key_distribution_(GetMixedKeyDistribution()),
+      zipfian_(FLAGS_arrange_kv_num, FLAGS_zipfian_constant) {
+  auto ratios = GetMixedRatios();
+  double total = 0;
+  for (auto ratio : ratios) {
+    CHECK(ratio >= 0) << "mixed ratio must not be negative.";
+    total += ratio;
+  }
+  CHECK(total > 0) << "mixed ratios are all zero.";
+
+  double sum = 0;
+  for (int i = 0; i < static_cast<int>(OpType::kNum); ++i) {
+    sum += ratios[i] / total;
+    op_thresholds_[i] = sum;
+  }
+}
+
+// load records [0, arrange_kv_num) of the raw region, and of the txn region if has one
+bool MixedOperation::Arrange(RegionEntryPtr region_entry) {
+  std::string& prefix = region_entry->prefix;
+  CHECK(FLAGS_arrange_kv_num > 0) << "mixed benchmark need arrange_kv_num > 0.";
+
+  uint32_t batch_size = 256;
+  std::vector<sdk::KVPair> kvs;
+  std::vector<sdk::KVPair> txn_kvs;
+  kvs.reserve(batch_size);
+  for (uint32_t i = 0; i < FLAGS_arrange_kv_num; ++i) {
+    size_t count = region_entry->counter.fetch_add(1, std::memory_order_relaxed);
+    std::string key = GenMixedKey(prefix, count);
+
+    kvs.push_back({EncodeRawKey(key), GenRandomString(FLAGS_value_size)});
+    if (region_entry->txn_region_id != 0) {
+      txn_kvs.push_back({EncodeTxnKey(key), GenRandomString(FLAGS_value_size)});
+    }
+
+    if ((i + 1) % batch_size == 0 || (i + 1 == FLAGS_arrange_kv_num)) {
+      auto status = raw_kv->BatchPut(kvs);
+      if (!status.ok()) {
+        return false;
+      }
+      kvs.clear();
+
+      if (!txn_kvs.empty()) {
+        auto result = KvTxnBatchPut(txn_kvs);
+        if (!result.status.ok()) {
+          return false;
+        }
+        txn_kvs.clear();
+      }
+
+      std::cout << '\r'
+                << fmt::format("region({}) put data({}) progress [{}%]", prefix, FLAGS_arrange_kv_num,
+                               i * 100 / FLAGS_arrange_kv_num)
+                << std::flush;
+    }
+  }
+
+  std::cout << "\r" << fmt::format("region({}) put data({}) ............ done", prefix, FLAGS_arrange_kv_num) << '\n';
+
+  return true;
+}
+
+MixedOperation::OpType MixedOperation::NextOpType() const {
+  double value = dingodb::benchmark::GenerateRealRandomInteger(0, INT32_MAX) / static_cast<double>(INT32_MAX);
+  for (int i = 0; i < static_cast<int>(OpType::kNum); ++i) {
+    if (value < op_thresholds_[i]) {
+      return static_cast<OpType>(i);
+    }
+  }
+
+  // rounding, pick the last one has ratio
+  for (int i = static_cast<int>(OpType::kNum) - 1; i > 0; --i) {
+    if (op_thresholds_[i] > op_thresholds_[i - 1]) {
+      return static_cast<OpType>(i);
+    }
+  }
+  return OpType::kRead;
+}
+
+size_t MixedOperation::NextKeyIndex(size_t record_count) const {
+  switch (key_distribution_) {
+    case KeyDistribution::kUniform:
+      return dingodb::benchmark::GenerateRealRandomInteger(0, record_count - 1);
+    case KeyDistribution::kLatest: {
+      // inserted records take the newest indexes, the hottest one is the latest
+      size_t offset = zipfian_.Next();
+      return offset < record_count ? record_count - 1 - offset : 0;
+    }
+    case KeyDistribution::kZipfian:
+    default:
+      return zipfian_.NextScrambled(record_count);
+  }
+}
+
+Operation::Result MixedOperation::Execute(RegionEntryPtr region_entry) {
+  // insert takes counter, records [0, counter) may have an insert in flight, read ones arranged is always fine
+  size_t record_count = std::max<size_t>(region_entry->counter.load(std::memory_order_relaxed), 1);
+
+  OpType op_type = NextOpType();
+  switch (op_type) {
+    case OpType::kRead:
+      return KvGet(EncodeRawKey(GenMixedKey(region_entry->prefix, NextKeyIndex(record_count))));
+    case OpType::kUpdate: {
+      Operation::Result result;
+      std::string key = EncodeRawKey(GenMixedKey(region_entry->prefix, NextKeyIndex(record_count)));
+      std::string value = GenRandomString(FLAGS_value_size);
+      result.write_bytes = key.size() + value.size();
+
+      int64_t start_time = dingodb::benchmark::TimestampUs();
+      result.status = raw_kv->Put(key, value);
+      result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+      return result;
+    }
+    case OpType::kInsert:
+      return KvPut(region_entry, false);
+    case OpType::kScan:
+      return ExecuteScan(region_entry, NextKeyIndex(record_count), record_count);
+    case OpType::kReadModifyWrite:
+      return ExecuteReadModifyWrite(EncodeRawKey(GenMixedKey(region_entry->prefix, NextKeyIndex(record_count))));
+    case OpType::kTxn:
+      CHECK(region_entry->txn_region_id != 0) << "mixed benchmark txn ratio without txn region.";
+      return ExecuteTxn(region_entry, std::min<size_t>(record_count, FLAGS_arrange_kv_num));
+    default:
+      CHECK(false) << "unknown mixed op type: " << static_cast<int>(op_type);
+  }
+
+  return {};
+}
+
+Operation::Result MixedOperation::ExecuteScan(RegionEntryPtr region_entry, size_t index, size_t record_count) {
+  Operation::Result result;
+
+  // keys are fixed width sequence, so [index, record_count) is a key range
+  std::string start_key = EncodeRawKey(GenMixedKey(region_entry->prefix, index));
+  std::string end_key = EncodeRawKey(GenMixedKey(region_entry->prefix, record_count));
+  uint64_t limit = dingodb::benchmark::GenerateRealRandomInteger(1, std::max<uint32_t>(FLAGS_mixed_scan_max_len, 1));
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  std::vector<sdk::KVPair> kvs;
+  result.status = raw_kv->Scan(start_key, end_key, limit, kvs);
+
+  for (auto& kv : kvs) {
+    result.read_bytes += kv.key.size() + kv.value.size();
+  }
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+
+  return result;
+}
+
+Operation::Result MixedOperation::ExecuteReadModifyWrite(const std::string& key) {
+  Operation::Result result;
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  std::string value;
+  result.status = raw_kv->Get(key, value);
+  if (result.status.IsOK() || result.status.IsNotFound()) {
+    result.read_bytes += value.size();
+
+    value = GenRandomString(FLAGS_value_size);
+    result.write_bytes += key.size() + value.size();
+    result.status = raw_kv->Put(key, value);
+  }
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+
+  return result;
+}
+
+Operation::Result MixedOperation::ExecuteTxn(RegionEntryPtr region_entry, size_t record_count) {
+  Operation::Result result;
+
+  std::vector<std::string> keys;
+  keys.reserve(FLAGS_mixed_txn_key_num);
+  for (uint32_t i = 0; i < FLAGS_mixed_txn_key_num; ++i) {
+    keys.push_back(EncodeTxnKey(GenMixedKey(region_entry->prefix, NextKeyIndex(record_count))));
+  }
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  sdk::Transaction* txn = nullptr;
+  sdk::TransactionOptions options;
+  options.kind = FLAGS_is_pessimistic_txn ? sdk::TransactionKind::kPessimistic : sdk::TransactionKind::kOptimistic;
+  options.isolation = GetTxnIsolationLevel();
+
+  result.status = client->NewTransaction(options, &txn);
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("new transaction failed, error: {}", result.status.ToString());
+    goto end;
+  }
+
+  for (const auto& key : keys) {
+    std::string value;
+    result.status = txn->Get(key, value);
+    if (!result.status.IsOK() && !result.status.IsNotFound()) {
+      LOG(ERROR) << fmt::format("transaction get failed, error: {}", result.status.ToString());
+      goto end;
+    }
+    result.read_bytes += value.size();
+
+    value = GenRandomString(FLAGS_value_size);
+    result.write_bytes += key.size() + value.size();
+    result.status = txn->Put(key, value);
+    if (!result.status.IsOK()) {
+      LOG(ERROR) << fmt::format("transaction put failed, error: {}", result.status.ToString());
+      goto end;
+    }
+  }
+
+  result.status = txn->PreCommit();
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("pre commit transaction failed, error: {}", result.status.ToString());
+    goto end;
+  }
+
+  result.status = txn->Commit();
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("commit transaction failed, error: {}", result.status.ToString());
+  }
+
+end:
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+  delete txn;
+
+  return result;
+}
+
+static int64_t RpcCount(const std::string& method) {
+  auto* metric = sdk::Metrics::Global().GetRpcMetric(method);
+  return metric != nullptr ? metric->latency_us.Count() : 0;
+}
+
+TxnContentionOperation::TxnContentionOperation(std::shared_ptr<sdk::Client> client)
+    : BaseOperation(client),
+      is_uniform_(FLAGS_txn_key_distribution == "uniform"),
+      zipfian_(std::max<uint32_t>(FLAGS_txn_hot_key_num, 1), FLAGS_zipfian_constant) {
+  CHECK(FLAGS_txn_hot_key_num > 0) << "txn contention benchmark need txn_hot_key_num > 0.";
+  CHECK(FLAGS_txn_contention_key_num > 0) << "txn contention benchmark need txn_contention_key_num > 0.";
+
+  base_check_status_count_ = RpcCount(sdk::TxnCheckTxnStatusRpc::ConstMethod());
+  base_resolve_lock_count_ = RpcCount(sdk::TxnResolveLockRpc::ConstMethod());
+}
+
+// load the hot keys [0, txn_hot_key_num) of the region
+bool TxnContentionOperation::Arrange(RegionEntryPtr region_entry) {
+  std::string& prefix = region_entry->prefix;
+
+  uint32_t batch_size = 256;
+  std::vector<sdk::KVPair> kvs;
+  kvs.reserve(batch_size);
+  for (uint32_t i = 0; i < FLAGS_txn_hot_key_num; ++i) {
+    size_t count = region_entry->counter.fetch_add(1, std::memory_order_relaxed);
+    kvs.push_back({EncodeTxnKey(GenMixedKey(prefix, count)), GenRandomString(FLAGS_value_size)});
+
+    if ((i + 1) % batch_size == 0 || (i + 1 == FLAGS_txn_hot_key_num)) {
+      auto result = KvTxnBatchPut(kvs);
+      if (!result.status.ok()) {
+        return false;
+      }
+      kvs.clear();
+
+      std::cout << '\r'
+                << fmt::format("region({}) put data({}) progress [{}%]", prefix, FLAGS_txn_hot_key_num,
+                               i * 100 / FLAGS_txn_hot_key_num)
+                << std::flush;
+    }
+  }
+
+  std::cout << "\r" << fmt::format("region({}) put data({}) ............ done", prefix, FLAGS_txn_hot_key_num) << '\n';
+
+  return true;
+}
+
+std::string TxnContentionOperation::NextKey(const RegionEntryPtr& region_entry) const {
+  size_t index = is_uniform_ ? dingodb::benchmark::GenerateRealRandomInteger(0, FLAGS_txn_hot_key_num - 1)
+                             : zipfian_.NextScrambled(FLAGS_txn_hot_key_num);
+  return EncodeTxnKey(GenMixedKey(region_entry->prefix, index));
+}
+
+Operation::Result TxnContentionOperation::Execute(RegionEntryPtr region_entry) {
+  std::vector<std::string> keys;
+  keys.reserve(FLAGS_txn_contention_key_num);
+  for (uint32_t i = 0; i < FLAGS_txn_contention_key_num; ++i) {
+    keys.push_back(NextKey(region_entry));
+  }
+
+  return ExecuteTxn(keys);
+}
+
+// keys are spread over the regions round robin
+Operation::Result TxnContentionOperation::Execute(std::vector<RegionEntryPtr>& region_entries) {
+  std::vector<std::string> keys;
+  keys.reserve(FLAGS_txn_contention_key_num);
+  for (uint32_t i = 0; i < FLAGS_txn_contention_key_num; ++i) {
+    keys.push_back(NextKey(region_entries[i % region_entries.size()]));
+  }
+
+  return ExecuteTxn(keys);
+}
+
+Operation::Result TxnContentionOperation::ExecuteTxn(const std::vector<std::string>& keys) {
+  Operation::Result result;
+
+  bool is_rmw = dingodb::benchmark::GenerateRealRandomInteger(0, INT32_MAX) / static_cast<double>(INT32_MAX) <
+                FLAGS_txn_rmw_ratio;
+
+  int64_t start_time = dingodb::benchmark::TimestampUs();
+
+  sdk::Transaction* txn = nullptr;
+  sdk::TransactionOptions options;
+  options.kind = FLAGS_is_pessimistic_txn ? sdk::TransactionKind::kPessimistic : sdk::TransactionKind::kOptimistic;
+  options.isolation = GetTxnIsolationLevel();
+
+  result.status = client->NewTransaction(options, &txn);
+  if (!result.status.IsOK()) {
+    LOG(ERROR) << fmt::format("new transaction failed, error: {}", result.status.ToString());
+    result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+    return result;
+  }
+
+  // get and put in pessimistic txn take locks, conflicts show up in execute phase
+  Phase phase = kExecute;
+  int64_t phase_start_time = start_time;
+  for (const auto& key : keys) {
+    std::string value;
+    if (is_rmw) {
+      result.status = txn->Get(key, value);
+      if (!result.status.IsOK() && !result.status.IsNotFound()) {
+        break;
+      }
+      result.read_bytes += value.size();
+    }
+
+    value = GenRandomString(FLAGS_value_size);
+    result.write_bytes += key.size() + value.size();
+    result.status = txn->Put(key, value);
+    if (!result.status.IsOK()) {
+      break;
+    }
+  }
+
+  if (result.status.IsOK()) {
+    RecordPhase(kExecute, dingodb::benchmark::TimestampUs() - phase_start_time, true);
+
+    phase = kPreCommit;
+    phase_start_time = dingodb::benchmark::TimestampUs();
+    result.status = txn->PreCommit();
+    if (result.status.IsOK()) {
+      RecordPhase(kPreCommit, dingodb::benchmark::TimestampUs() - phase_start_time, true);
+
+      phase = kCommit;
+      phase_start_time = dingodb::benchmark::TimestampUs();
+      result.status = txn->Commit();
+      if (result.status.IsOK()) {
+        RecordPhase(kCommit, dingodb::benchmark::TimestampUs() - phase_start_time, true);
+      }
+    }
+  }
+
+  if (!result.status.IsOK()) {
+    LOG(INFO) << fmt::format("transaction abort at phase({}), error: {}", static_cast<int>(phase),
+                             result.status.ToString());
+    RecordPhase(phase, 0, false);
+
+    // primary may be committed when commit fails, only roll back before commit
+    if (phase != kCommit) {
+      phase_start_time = dingodb::benchmark::TimestampUs();
+      auto status = txn->Rollback();
+      RecordPhase(kRollback, dingodb::benchmark::TimestampUs() - phase_start_time, status.IsOK());
+    }
+  }
+
+  result.eplased_time = dingodb::benchmark::TimestampUs() - start_time;
+  delete txn;
+
+  return result;
+}
+
+void TxnContentionOperation::RecordPhase(Phase phase, int64_t latency_us, bool is_ok) {
+  std::lock_guard lock(mutex_);
+
+  if (is_ok) {
+    phase_latencies_[phase].Record(latency_us);
+  } else {
+    ++phase_errors_[phase];
+    if (phase != kRollback) {
+      ++abort_num_;
+    }
+  }
+}
+
+void TxnContentionOperation::Report() const {
+  static const char* kPhaseNames[kPhaseNum] = {"EXECUTE", "PRECOMMIT", "COMMIT", "ROLLBACK"};
+
+  std::lock_guard lock(mutex_);
+
+  // every txn passes execute phase, ok or not
+  size_t txn_num = phase_latencies_[kExecute].Count() + phase_errors_[kExecute];
+  std::cout << COLOR_GREEN
+            << fmt::format("Txn contention({} {}):", FLAGS_is_pessimistic_txn ? "pessimistic" : "optimistic",
+                           dingodb::benchmark::ToUpper(FLAGS_txn_isolation_level))
+            << COLOR_RESET << '\n';
+  std::cout << fmt::format("{:>12}{:>12}{:>16}", "TXN_NUM", "ABORTS", "ABORT RATE(%)") << '\n';
+  std::cout << fmt::format("{:>12}{:>12}{:>16.2f}", txn_num, abort_num_,
+                           txn_num > 0 ? abort_num_ * 100.0 / txn_num : 0.0)
+            << '\n';
+
+  std::cout << fmt::format("{:>12}{:>10}{:>8}{:>16}{:>10}{:>10}{:>10}{:>10}", "PHASE", "COUNT", "ERRORS",
+                           "LATENCY AVG(us)", "P50(us)", "P95(us)", "P99(us)", "MAX(us)")
+            << '\n';
+  for (int i = 0; i < kPhaseNum; ++i) {
+    const auto& latency = phase_latencies_[i];
+    std::cout << fmt::format("{:>12}{:>10}{:>8}{:>16.0f}{:>10}{:>10}{:>10}{:>10}", kPhaseNames[i], latency.Count(),
+                             phase_errors_[i], latency.Mean(), latency.ValueAtPercentile(50),
+                             latency.ValueAtPercentile(95), latency.ValueAtPercentile(99), latency.Max())
+              << '\n';
+  }
+
+  // lock resolving is done inside sdk, take it from sdk rpc metrics
+  std::cout << fmt::format("{:<36}{:>10}{:>16}{:>10}{:>12}", "LOCK RESOLVE RPC", "COUNT", "LATENCY AVG(us)",
+                           "P99(us)", "PER TXN")
+            << '\n';
+  const std::pair<std::string, int64_t> kRpcs[] = {
+      {sdk::TxnCheckTxnStatusRpc::ConstMethod(), base_check_status_count_},
+      {sdk::TxnResolveLockRpc::ConstMethod(), base_resolve_lock_count_},
+  };
+  for (const auto& [method, base_count] : kRpcs) {
+    auto* metric = sdk::Metrics::Global().GetRpcMetric(method);
+    if (metric == nullptr) {
+      std::cout << fmt::format("{:<36}{:>10}", method, "n/a, enable_sdk_metrics is false") << '\n';
+      continue;
+    }
+
+    int64_t count = metric->latency_us.Count();
+    std::cout << fmt::format("{:<36}{:>10}{:>16.0f}{:>10}{:>12.4f}", method, count - base_count,
+                             count > 0 ? static_cast<double>(metric->latency_us.Sum()) / count : 0.0,
+                             metric->latency_us.Percentile(0.99),
+                             txn_num > 0 ? (count - base_count) / static_cast<double>(txn_num) : 0.0)
+              << '\n';
+  }
+}
+
+bool IsMixedTxnBenchmark() {
+  if (FLAGS_benchmark != "mixed") {
+    return false;
+  }
+
+  return GetMixedRatios()[static_cast<int>(MixedOperation::OpType::kTxn)] > 0;
+}
+
+bool IsSupportBenchmarkType(const std::string& benchmark) {
+  auto it = support_operations.find(benchmark);
+  return it != support_operations.end();
+}
+
+std::string GetSupportBenchmarkType() {
+  std::string benchmarks;
+  for (auto& [benchmark, _] : support_operations) {
+    benchmarks += benchmark;
+    benchmarks += " ";
+  }
+
+  return benchmarks;
+}
+
+OperationPtr NewOperation(std::shared_ptr<sdk::Client> client) { return NewOperation(client, FLAGS_benchmark); }
+
+OperationPtr NewOperation(std::shared_ptr<sdk::Client> client, const std::string& benchmark) {
+  auto it = support_operations.find(benchmark);
   if (it == support_operations.end()) {
     return nullptr;
   }
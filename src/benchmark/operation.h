@@ -18,11 +18,16 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "benchmark/dataset.h"
+#include "benchmark/hdr_histogram.h"
+#include "benchmark/zipfian_generator.h"
 #include "sdk/client.h"
+#include "sdk/document.h"
 #include "sdk/status.h"
 #include "sdk/vector.h"
 
@@ -50,6 +55,7 @@ class Operation {
     std::vector<uint32_t> recalls;
     std::vector<sdk::SearchResult> vector_search_results;
     sdk::QueryResult vector_query_result;
+    sdk::DocSearchResult doc_search_result;
   };
 
   // Do some ready work at arrange stage
@@ -63,6 +69,9 @@ class Operation {
 
   // RPC invoke, return execute result, for vector index
   virtual Result Execute(VectorIndexEntryPtr entry) = 0;
+
+  // Print operation specific statistics after the cumulative report
+  virtual void Report() const = 0;
 };
 using OperationPtr = std::shared_ptr<Operation>;
 
@@ -82,6 +91,8 @@ class BaseOperation : public Operation {
 
   Result Execute(VectorIndexEntryPtr) override { return {}; }
 
+  void Report() const override {}
+
  protected:
   Result KvPut(RegionEntryPtr region_entry, bool is_random);
   Result KvBatchPut(RegionEntryPtr region_entry, bool is_random);
@@ -89,6 +100,9 @@ class BaseOperation : public Operation {
   Result KvGet(std::string key);
   Result KvBatchGet(const std::vector<std::string>& keys);
 
+  Result KvScan(const std::string& start_key, const std::string& end_key);
+  Result KvDeleteRange(const std::string& start_key, const std::string& end_key);
+
   Result KvTxnPut(std::vector<RegionEntryPtr>& region_entries, bool is_random);
   Result KvTxnPut(const std::vector<sdk::KVPair>& kvs);
   Result KvTxnBatchPut(std::vector<RegionEntryPtr>& region_entries, bool is_random);
@@ -96,6 +110,8 @@ class BaseOperation : public Operation {
 
   Result KvTxnGet(const std::vector<std::string>& keys);
   Result KvTxnBatchGet(const std::vector<std::vector<std::string>>& keys);
+  // one transaction scans all ranges
+  Result KvTxnScan(const std::vector<std::pair<std::string, std::string>>& ranges);
 
   Result VectorPut(VectorIndexEntryPtr entry, std::vector<sdk::VectorWithId>& vector_with_ids);
   Result VectorSearch(VectorIndexEntryPtr entry, const std::vector<sdk::VectorWithId>& vector_with_ids,
@@ -103,6 +119,10 @@ class BaseOperation : public Operation {
 
   Result VectorBatchQuery(VectorIndexEntryPtr entry, const sdk::QueryParam& query_param);
 
+  Result DocumentAdd(VectorIndexEntryPtr entry, std::vector<sdk::DocWithId>& docs);
+  Result DocumentSearch(VectorIndexEntryPtr entry, const sdk::DocSearchParam& search_param);
+  Result DocumentScanQuery(VectorIndexEntryPtr entry, const sdk::DocScanQueryParam& query_param);
+
   std::shared_ptr<sdk::Client> client;
   std::shared_ptr<dingodb::sdk::RawKV> raw_kv;
 };
@@ -220,6 +240,124 @@ class TxnReadMissingOperation : public TxnReadOperation {
   Result Execute(std::vector<RegionEntryPtr>& region_entries) override;
 };
 
+// Sequence scan operation, ranges of scan_range_width arranged keys one after another
+class ScanSeqOperation : public ReadOperation {
+ public:
+  ScanSeqOperation(std::shared_ptr<sdk::Client> client) : ReadOperation(client) {}
+  ~ScanSeqOperation() override = default;
+
+  Result Execute(RegionEntryPtr region_entry) override;
+};
+
+// Random range scan operation, ranges of scan_range_width arranged keys start at a random key
+class ScanRandomRangeOperation : public ReadOperation {
+ public:
+  ScanRandomRangeOperation(std::shared_ptr<sdk::Client> client) : ReadOperation(client) {}
+  ~ScanRandomRangeOperation() override = default;
+
+  Result Execute(RegionEntryPtr region_entry) override;
+};
+
+// Transaction sequence scan operation
+class TxnScanSeqOperation : public TxnReadOperation {
+ public:
+  TxnScanSeqOperation(std::shared_ptr<sdk::Client> client) : TxnReadOperation(client) {}
+  ~TxnScanSeqOperation() override = default;
+
+  Result Execute(RegionEntryPtr region_entry) override;
+  Result Execute(std::vector<RegionEntryPtr>& region_entries) override;
+};
+
+// Transaction random range scan operation
+class TxnScanRandomRangeOperation : public TxnReadOperation {
+ public:
+  TxnScanRandomRangeOperation(std::shared_ptr<sdk::Client> client) : TxnReadOperation(client) {}
+  ~TxnScanRandomRangeOperation() override = default;
+
+  Result Execute(RegionEntryPtr region_entry) override;
+  Result Execute(std::vector<RegionEntryPtr>& region_entries) override;
+};
+
+// Delete range operation, deletes ranges of scan_range_width arranged keys one after another
+// Arranged keys are consumed, ranges are empty after the keys wrap around, so arrange_kv_num should be
+// at least the request number of per region times scan_range_width.
+class DeleteRangeOperation : public ReadOperation {
+ public:
+  DeleteRangeOperation(std::shared_ptr<sdk::Client> client) : ReadOperation(client) {}
+  ~DeleteRangeOperation() override = default;
+
+  Result Execute(RegionEntryPtr region_entry) override;
+};
+
+// Transaction contention operation, conflict heavy workload
+// Every transaction reads then writes (or blind writes) txn_contention_key_num keys drawn by zipfian/uniform
+// distribution from a small hot key space of every region, so concurrent transactions run into lock
+// conflict, lock resolving and rollback. Abort rate, lock resolving and per phase latency are reported at the end.
+class TxnContentionOperation : public BaseOperation {
+ public:
+  TxnContentionOperation(std::shared_ptr<sdk::Client> client);
+  ~TxnContentionOperation() override = default;
+
+  bool Arrange(RegionEntryPtr region_entry) override;
+
+  Result Execute(RegionEntryPtr region_entry) override;
+  Result Execute(std::vector<RegionEntryPtr>& region_entries) override;
+
+  void Report() const override;
+
+ private:
+  enum Phase : uint8_t { kExecute = 0, kPreCommit, kCommit, kRollback, kPhaseNum };
+
+  std::string NextKey(const RegionEntryPtr& region_entry) const;
+  Result ExecuteTxn(const std::vector<std::string>& keys);
+  void RecordPhase(Phase phase, int64_t latency_us, bool is_ok);
+
+  bool is_uniform_;
+  ZipfianGenerator zipfian_;
+
+  // lock resolving rpcs sent before the benchmark, not counted
+  int64_t base_check_status_count_{0};
+  int64_t base_resolve_lock_count_{0};
+
+  mutable std::mutex mutex_;
+  size_t abort_num_{0};
+  // latency in us of successful phases
+  HdrHistogram phase_latencies_[kPhaseNum];
+  // failed phases, txn abort at the first one
+  size_t phase_errors_[kPhaseNum]{};
+};
+
+// Mixed operation, YCSB like workload
+// Every Execute picks one of read/update/insert/scan/read-modify-write/transaction by the
+// configured ratios, keys are chosen by uniform/zipfian/latest distribution over the loaded records.
+class MixedOperation : public BaseOperation {
+ public:
+  MixedOperation(std::shared_ptr<sdk::Client> client);
+  ~MixedOperation() override = default;
+
+  enum class OpType : uint8_t { kRead = 0, kUpdate, kInsert, kScan, kReadModifyWrite, kTxn, kNum };
+
+  enum class KeyDistribution : uint8_t { kUniform = 0, kZipfian, kLatest };
+
+  bool Arrange(RegionEntryPtr region_entry) override;
+
+  Result Execute(RegionEntryPtr region_entry) override;
+
+ private:
+  OpType NextOpType() const;
+  // index in [0, record_count), record_count > 0
+  size_t NextKeyIndex(size_t record_count) const;
+
+  Result ExecuteScan(RegionEntryPtr region_entry, size_t index, size_t record_count);
+  Result ExecuteReadModifyWrite(const std::string& key);
+  Result ExecuteTxn(RegionEntryPtr region_entry, size_t record_count);
+
+  // prefix sum of the normalized ratios, indexed by OpType
+  double op_thresholds_[static_cast<int>(OpType::kNum)];
+  KeyDistribution key_distribution_;
+  ZipfianGenerator zipfian_;
+};
+
 class VectorFillSeqOperation : public BaseOperation {
  public:
   VectorFillSeqOperation(std::shared_ptr<sdk::Client> client) : BaseOperation(client) {}
@@ -265,9 +403,55 @@ class VectorQueryOperation : public VectorSearchOperation {
   Result ExecuteManualData(VectorIndexEntryPtr entry);
 };
 
+// Document operations run on document indexes through VectorIndexEntry, docs have columns id/title/text.
+// Without dataset docs are random words of a vocabulary, with a JSON dataset docs are its train data.
+class DocumentFillSeqOperation : public BaseOperation {
+ public:
+  DocumentFillSeqOperation(std::shared_ptr<sdk::Client> client) : BaseOperation(client) {}
+  ~DocumentFillSeqOperation() override = default;
+
+  Result Execute(VectorIndexEntryPtr entry) override;
+};
+
+// Full-text search, queries of a dataset are its test data with query text,
+// recall and NDCG are measured against the qrels of the test data where available.
+class DocumentSearchOperation : public BaseOperation {
+ public:
+  DocumentSearchOperation(std::shared_ptr<sdk::Client> client) : BaseOperation(client) {}
+  ~DocumentSearchOperation() override = default;
+
+  bool Arrange(VectorIndexEntryPtr entry, DatasetPtr dataset) override;
+
+  Result Execute(VectorIndexEntryPtr entry) override;
+
+  void Report() const override;
+
+ private:
+  bool ArrangeAutoData(VectorIndexEntryPtr entry);
+  bool ArrangeManualData(VectorIndexEntryPtr entry, DatasetPtr dataset);
+
+  mutable std::mutex mutex_;
+  double ndcg_sum_{0};
+  size_t ndcg_count_{0};
+};
+
+// Scan query from a random arranged doc id
+class DocumentScanQueryOperation : public DocumentSearchOperation {
+ public:
+  DocumentScanQueryOperation(std::shared_ptr<sdk::Client> client) : DocumentSearchOperation(client) {}
+  ~DocumentScanQueryOperation() override = default;
+
+  Result Execute(VectorIndexEntryPtr entry) override;
+};
+
+// mixed benchmark with transaction ratio, need a txn region per prefix besides the raw one
+bool IsMixedTxnBenchmark();
+
 bool IsSupportBenchmarkType(const std::string& benchmark);
 std::string GetSupportBenchmarkType();
 OperationPtr NewOperation(std::shared_ptr<sdk::Client> client);
+// operation of the given benchmark type instead of FLAGS_benchmark, nullptr when not supported
+OperationPtr NewOperation(std::shared_ptr<sdk::Client> client, const std::string& benchmark);
 
 }  // namespace benchmark
 }  // namespace dingodb
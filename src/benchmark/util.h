@@ -125,20 +125,6 @@ static std::vector<uint8_t> GenerateInt8Vector(int dimension) {
   return vec;
 }
 
-static float DingoHnswL2Sqr(const float* p_vect1v, const float* p_vect2v, size_t d) {
-  float* p_vect1 = (float*)p_vect1v;
-  float* p_vect2 = (float*)p_vect2v;
-
-  float res = 0;
-  for (size_t i = 0; i < d; i++) {
-    float t = *p_vect1 - *p_vect2;
-    p_vect1++;
-    p_vect2++;
-    res += t * t;
-  }
-  return (res);
-}
-
 static void CreateDirectories(const std::string& path) {
   std::error_code ec;
   if (std::filesystem::exists(path)) {
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/zipfian_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace dingodb {
+namespace benchmark {
+
+namespace {
+
+double Zeta(uint64_t n, double theta) {
+  double sum = 0;
+  for (uint64_t i = 1; i <= n; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i), theta);
+  }
+  return sum;
+}
+
+double RandomDouble() {
+  thread_local std::mt19937_64 rng(std::random_device{}());
+  return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+}
+
+// 64 bit FNV-1a of the value bytes
+uint64_t FnvHash64(uint64_t value) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= value & 0xff;
+    hash *= 0x100000001b3ULL;
+    value >>= 8;
+  }
+  return hash;
+}
+
+}  // namespace
+
+ZipfianGenerator::ZipfianGenerator(uint64_t item_count, double theta)
+    : item_count_(std::max<uint64_t>(item_count, 1)), theta_(theta) {
+  zeta_n_ = Zeta(item_count_, theta_);
+  double zeta_2 = Zeta(2, theta_);
+  alpha_ = 1.0 / (1.0 - theta_);
+  eta_ = (1.0 - std::pow(2.0 / item_count_, 1.0 - theta_)) / (1.0 - zeta_2 / zeta_n_);
+  half_pow_theta_ = std::pow(0.5, theta_);
+}
+
+uint64_t ZipfianGenerator::Next() const {
+  double u = RandomDouble();
+  double uz = u * zeta_n_;
+  if (uz < 1.0) {
+    return 0;
+  }
+  if (uz < 1.0 + half_pow_theta_) {
+    return std::min<uint64_t>(1, item_count_ - 1);
+  }
+
+  auto rank = static_cast<uint64_t>(item_count_ * std::pow(eta_ * u - eta_ + 1, alpha_));
+  return std::min(rank, item_count_ - 1);
+}
+
+uint64_t ZipfianGenerator::NextScrambled(uint64_t range) const { return FnvHash64(Next()) % range; }
+
+}  // namespace benchmark
+}  // namespace dingodb
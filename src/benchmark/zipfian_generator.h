@@ -0,0 +1,54 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_BENCHMARK_ZIPFIAN_GENERATOR_H_
+#define DINGODB_BENCHMARK_ZIPFIAN_GENERATOR_H_
+
+#include <cstdint>
+
+namespace dingodb {
+namespace benchmark {
+
+// Zipfian distributed ranks in [0, item_count), rank 0 is the most popular one.
+// Same algorithm as YCSB (Gray et al. "Quickly Generating Billion-Record Synthetic
+// Databases"), zeta is computed once at construction so it is O(item_count).
+// Thread safe, every thread draws from its own random engine.
+class ZipfianGenerator {
+ public:
+  static constexpr double kDefaultTheta = 0.99;
+
+  explicit ZipfianGenerator(uint64_t item_count, double theta = kDefaultTheta);
+  ~ZipfianGenerator() = default;
+
+  uint64_t ItemCount() const { return item_count_; }
+
+  uint64_t Next() const;
+
+  // popular ranks are hashed over [0, range) so hot items are not neighbours,
+  // like YCSB ScrambledZipfianGenerator, range must be > 0
+  uint64_t NextScrambled(uint64_t range) const;
+
+ private:
+  uint64_t item_count_;
+  double theta_;
+  double zeta_n_;
+  double alpha_;
+  double eta_;
+  double half_pow_theta_;
+};
+
+}  // namespace benchmark
+}  // namespace dingodb
+
+#endif  // DINGODB_BENCHMARK_ZIPFIAN_GENERATOR_H_
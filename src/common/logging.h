@@ -15,6 +15,10 @@
 #ifndef DINGODB_SDK_COMMON_LOGGING_H_
 #define DINGODB_SDK_COMMON_LOGGING_H_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <string>
 
 #include "glog/logging.h"
@@ -53,5 +57,28 @@ static constexpr int kGlobalValueOfDebug = DINGO_DEBUG;
 #define DINGO_LOG_IF_ERROR(condition) LOG_IF(ERROR, condition) << CURRENT_FUNC_NAME
 #define DINGO_LOG_IF_FATAL(condition) LOG_IF(FATAL, condition) << CURRENT_FUNC_NAME
 
+// true at most once per second for the call site owning last_ms, the stream of a suppressed log is not evaluated,
+// so error paths hit by every rpc of a failover storm neither format nor allocate
+inline bool LogEverySecond(std::atomic<int64_t>& last_ms) {
+  int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+  int64_t last = last_ms.load(std::memory_order_relaxed);
+  return now_ms - last >= 1000 && last_ms.compare_exchange_strong(last, now_ms, std::memory_order_relaxed);
+}
+
+// each expansion is a distinct lambda, so each call site has its own static
+#define DINGO_LOG_RATE_ALLOW()                                                    \
+  ::dingodb::LogEverySecond([]() -> std::atomic<int64_t>& {                       \
+    static std::atomic<int64_t> last_ms{std::numeric_limits<int64_t>::min() / 2}; \
+    return last_ms;                                                               \
+  }())
+
+#define DINGO_LOG_EVERY_SECOND(level) DINGO_LOG_EVERY_SECOND_##level
+
+#define DINGO_LOG_EVERY_SECOND_INFO LOG_IF(INFO, DINGO_LOG_RATE_ALLOW()) << CURRENT_FUNC_NAME
+#define DINGO_LOG_EVERY_SECOND_WARNING LOG_IF(WARNING, DINGO_LOG_RATE_ALLOW()) << CURRENT_FUNC_NAME
+#define DINGO_LOG_EVERY_SECOND_ERROR LOG_IF(ERROR, DINGO_LOG_RATE_ALLOW()) << CURRENT_FUNC_NAME
+
 }  // namespace dingodb
 #endif
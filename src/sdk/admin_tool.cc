@@ -14,36 +14,41 @@
 
 #include "sdk/admin_tool.h"
 
+#include <memory>
+#include <vector>
+
 #include "common/logging.h"
 #include "glog/logging.h"
 #include "rpc/coordinator_rpc.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/common.h"
+#include "sdk/common/hot_spot_detector.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/status.h"
+#include "sdk/utils/async_util.h"
 
 namespace dingodb {
 namespace sdk {
 
 Status AdminTool::GetCurrentTsoTimeStamp(pb::meta::TsoTimestamp& timestamp) {
-  TsoServiceRpc rpc;
-  rpc.MutableRequest()->set_op_type(pb::meta::TsoOpType::OP_GEN_TSO);
-  rpc.MutableRequest()->set_count(1);
-
-  Status status = stub_.GetMetaRpcController()->SyncCall(rpc);
-
-  if (!status.IsOK()) {
-    DINGO_LOG(WARNING) << "Fail tsoService request fail, status:" << status.ToString()
-                       << ", response:" << rpc.Response()->DebugString();
-  } else {
-    CHECK(rpc.Response()->has_start_timestamp());
-    timestamp = rpc.Response()->start_timestamp();
+  Status status = tso_batcher_->GetTso(timestamp);
+  if (status.IsOK()) {
     DINGO_LOG(DEBUG) << "tso timestamp: " << timestamp.DebugString();
   }
 
   return status;
 }
 
+Status AdminTool::GetStaleTsoTimeStamp(int64_t max_staleness_ms, pb::meta::TsoTimestamp& timestamp) {
+  Status status = tso_batcher_->GetStaleTso(max_staleness_ms, timestamp);
+  if (status.IsOK()) {
+    DINGO_LOG(DEBUG) << "stale tso timestamp: " << timestamp.DebugString()
+                     << ", max_staleness_ms: " << max_staleness_ms;
+  }
+
+  return status;
+}
+
 Status AdminTool::GetCurrentTimeStamp(int64_t& timestamp) {
   pb::meta::TsoTimestamp tso;
   DINGO_RETURN_NOT_OK(GetCurrentTsoTimeStamp(tso));
@@ -68,6 +73,38 @@ Status AdminTool::IsCreateRegionInProgress(int64_t region_id, bool& out_create_i
   return Status::OK();
 }
 
+Status AdminTool::IsCreateRegionsInProgress(const std::vector<int64_t>& region_ids,
+                                            std::vector<bool>& out_create_in_progress) {
+  std::vector<std::unique_ptr<QueryRegionRpc>> rpcs;
+  std::vector<Status> statuses(region_ids.size());
+  std::vector<std::unique_ptr<Synchronizer>> syncs;
+  rpcs.reserve(region_ids.size());
+  syncs.reserve(region_ids.size());
+  for (size_t i = 0; i < region_ids.size(); i++) {
+    rpcs.push_back(std::make_unique<QueryRegionRpc>());
+    rpcs[i]->MutableRequest()->set_region_id(region_ids[i]);
+    syncs.push_back(std::make_unique<Synchronizer>());
+    stub_.GetCoordinatorRpcController()->AsyncCall(*rpcs[i], syncs[i]->AsStatusCallBack(statuses[i]));
+  }
+
+  for (auto& sync : syncs) {
+    sync->Wait();
+  }
+
+  out_create_in_progress.assign(region_ids.size(), false);
+  for (size_t i = 0; i < region_ids.size(); i++) {
+    DINGO_RETURN_NOT_OK(statuses[i]);
+
+    const auto* response = rpcs[i]->Response();
+    CHECK(response->has_region()) << "query region internal error, req:" << rpcs[i]->Request()->DebugString()
+                                  << ", resp:" << response->DebugString();
+    CHECK_EQ(response->region().id(), region_ids[i]);
+    out_create_in_progress[i] = (response->region().state() == pb::common::REGION_NEW);
+  }
+
+  return Status::OK();
+}
+
 Status AdminTool::DropRegion(int64_t region_id) {
   DropRegionRpc rpc;
   rpc.MutableRequest()->set_region_id(region_id);
@@ -122,5 +159,12 @@ Status AdminTool::DropIndex(int64_t index_id) {
   return s;
 }
 
+Status AdminTool::GetHotSpots(std::vector<HotSpotDetector::HotKey>& out_keys,
+                              std::vector<HotSpotDetector::HotRegion>& out_regions) {
+  out_keys = HotSpotDetector::Global().GetHotKeys();
+  out_regions = HotSpotDetector::Global().GetHotRegions();
+  return Status::OK();
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
@@ -15,11 +15,14 @@
 #ifndef DINGODB_SDK_ADMIN_TOOL_H_
 #define DINGODB_SDK_ADMIN_TOOL_H_
 
+#include <memory>
 #include <vector>
 
 #include "proto/meta.pb.h"
+#include "sdk/common/hot_spot_detector.h"
 #include "sdk/rpc/coordinator_rpc_controller.h"
 #include "sdk/status.h"
+#include "sdk/tso_batcher.h"
 
 namespace dingodb {
 namespace sdk {
@@ -31,24 +34,37 @@ class AdminTool {
   AdminTool(const AdminTool&) = delete;
   const AdminTool& operator=(const AdminTool&) = delete;
 
-  explicit AdminTool(const ClientStub& stub) : stub_(stub) {}
+  explicit AdminTool(const ClientStub& stub) : stub_(stub), tso_batcher_(std::make_unique<TsoBatcher>(stub)) {}
 
   ~AdminTool() = default;
 
   Status GetCurrentTsoTimeStamp(pb::meta::TsoTimestamp& tso_timestamp);
 
+  // tso at most max_staleness_ms old, skip tso rpc when a fresh enough tso was got recently
+  Status GetStaleTsoTimeStamp(int64_t max_staleness_ms, pb::meta::TsoTimestamp& tso_timestamp);
+
   Status GetCurrentTimeStamp(int64_t& timestamp);
 
+  TsoBatcherMetrics GetTsoBatcherMetrics() const { return tso_batcher_->GetMetrics(); }
+
   Status IsCreateRegionInProgress(int64_t region_id, bool& out_create_in_progress);
 
+  // regions are queried concurrently, out_create_in_progress[i] is for region_ids[i], fail when any query fails
+  Status IsCreateRegionsInProgress(const std::vector<int64_t>& region_ids, std::vector<bool>& out_create_in_progress);
+
   Status DropRegion(int64_t region_id);
 
   Status CreateTableIds(int64_t count, std::vector<int64_t>& out_table_ids);
 
   Status DropIndex(int64_t index_id);
 
+  // hottest keys and regions accessed by this process in the last window, see HotSpotDetector
+  Status GetHotSpots(std::vector<HotSpotDetector::HotKey>& out_keys,
+                     std::vector<HotSpotDetector::HotRegion>& out_regions);
+
  private:
   const ClientStub& stub_;
+  std::unique_ptr<TsoBatcher> tso_batcher_;
 };
 
 }  // namespace sdk
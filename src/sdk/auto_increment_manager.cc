@@ -14,17 +14,21 @@
 
 #include "sdk/auto_increment_manager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <utility>
 
+#include "common/logging.h"
 #include "glog/logging.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/param_config.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/status.h"
+#include "sdk/utils/task_tracker.h"
 
 namespace dingodb {
 
@@ -35,6 +39,18 @@ struct AutoInrementer::Req {
   std::condition_variable cv;
 };
 
+namespace {
+// a range used up faster than this doubles next request count
+const int64_t kFastConsumeUs = 1000 * 1000;
+// a range used up slower than this halves next request count
+const int64_t kSlowConsumeUs = 10 * 1000 * 1000;
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
 Status AutoInrementer::GetNextId(int64_t& next) {
   std::vector<int64_t> ids;
   DINGO_RETURN_NOT_OK(GetNextIds(ids, 1));
@@ -49,6 +65,7 @@ Status AutoInrementer::GetNextIds(std::vector<int64_t>& to_fill, int64_t count)
 
   {
     std::unique_lock<std::mutex> lk(mutex_);
+    started_ = true;
     queue_.push_back(&req);
     while (&req != queue_.front()) {
       req.cv.wait(lk);
@@ -58,7 +75,9 @@ Status AutoInrementer::GetNextIds(std::vector<int64_t>& to_fill, int64_t count)
   Status s;
   while (s.ok() && count > 0) {
     if (id_cache_.size() < count) {
-      s = RefillCache();
+      if (!TakePrefetched()) {
+        s = RefillCache();
+      }
     } else {
       to_fill.insert(to_fill.end(), id_cache_.begin(), id_cache_.begin() + count);
       id_cache_.erase(id_cache_.begin(), id_cache_.begin() + count);
@@ -66,6 +85,10 @@ Status AutoInrementer::GetNextIds(std::vector<int64_t>& to_fill, int64_t count)
     }
   }
 
+  if (s.ok()) {
+    MaybePrefetch();
+  }
+
   {
     std::unique_lock<std::mutex> lk(mutex_);
     queue_.pop_front();
@@ -77,9 +100,117 @@ Status AutoInrementer::GetNextIds(std::vector<int64_t>& to_fill, int64_t count)
   return s;
 }
 
-Status AutoInrementer::RefillCache() {
+Status AutoInrementer::RefillCache() { return GenerateIds(NextReqCount(), id_cache_); }
+
+int64_t AutoInrementer::NextReqCount() {
+  if (!FLAGS_auto_incre_prefetch) {
+    return FLAGS_auto_incre_req_count;
+  }
+
+  int64_t now = NowUs();
+  if (req_count_ <= 0) {
+    req_count_ = FLAGS_auto_incre_req_count;
+  } else {
+    int64_t elapsed = now - last_refill_us_;
+    if (elapsed < kFastConsumeUs) {
+      req_count_ = std::min(req_count_ * 2, std::max(FLAGS_auto_incre_max_req_count, FLAGS_auto_incre_req_count));
+    } else if (elapsed > kSlowConsumeUs) {
+      req_count_ = std::max(req_count_ / 2, FLAGS_auto_incre_req_count);
+    }
+  }
+  last_refill_us_ = now;
+
+  return req_count_;
+}
+
+bool AutoInrementer::TakePrefetched() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  while (prefetching_) {
+    prefetch_cv_.wait(lk);
+  }
+
+  if (prefetched_.empty()) {
+    return false;
+  }
+
+  // prefetched range is after all ids in cache
+  id_cache_.insert(id_cache_.end(), prefetched_.begin(), prefetched_.end());
+  prefetched_.clear();
+  return true;
+}
+
+void AutoInrementer::MaybePrefetch() {
+  if (!FLAGS_auto_incre_prefetch) {
+    return;
+  }
+
+  // low watermark is half of the last range
+  int64_t low_watermark = std::max(req_count_, FLAGS_auto_incre_req_count) / 2;
+  if (static_cast<int64_t>(id_cache_.size()) >= low_watermark) {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (prefetching_ || !prefetched_.empty()) {
+      return;
+    }
+    prefetching_ = true;
+  }
+
+  StartPrefetch(NextReqCount());
+}
+
+void AutoInrementer::Prewarm() {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (started_ || prefetching_ || !prefetched_.empty()) {
+      return;
+    }
+    prefetching_ = true;
+  }
+
+  StartPrefetch(FLAGS_auto_incre_req_count);
+}
+
+void AutoInrementer::StartPrefetch(int64_t count) {
+  // the prefetch uses stub until it is done, so ~ClientStub waits for it, see TaskTracker
+  std::shared_ptr<TaskTracker> tracker = stub_.GetTaskTracker();
+  bool scheduled = tracker->Enter();
+  if (scheduled) {
+    auto self = shared_from_this();
+    scheduled = stub_.GetActuator()->Execute([self, tracker, count]() {
+      std::vector<int64_t> ids;
+      Status s = self->GenerateIds(count, ids);
+      if (!s.ok()) {
+        // caller will refill in its own thread
+        DINGO_LOG(WARNING) << "prefetch auto increment ids fail: " << s.ToString();
+      }
+
+      {
+        std::unique_lock<std::mutex> lk(self->mutex_);
+        self->prefetched_ = std::move(ids);
+        self->prefetching_ = false;
+        self->prefetch_cv_.notify_all();
+      }
+      tracker->Leave();
+    });
+    if (!scheduled) {
+      tracker->Leave();
+    }
+  }
+
+  if (!scheduled) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    prefetching_ = false;
+    prefetch_cv_.notify_all();
+  }
+}
+
+Status AutoInrementer::GenerateIds(int64_t count, std::vector<int64_t>& ids) {
   GenerateAutoIncrementRpc rpc;
   PrepareRequest(*rpc.MutableRequest());
+  rpc.MutableRequest()->set_count(count);
 
   VLOG(kSdkVlogLevel) << "GenerateAutoIncrement request:" << rpc.Request()->DebugString()
                       << " response:" << rpc.Response()->DebugString();
@@ -90,8 +221,9 @@ Status AutoInrementer::RefillCache() {
   const auto* request = rpc.Request();
   CHECK_GT(response->end_id(), response->start_id())
       << " request:" << request->DebugString() << " response: " << response->DebugString();
+  ids.reserve(ids.size() + response->end_id() - response->start_id());
   for (int64_t i = response->start_id(); i < response->end_id(); i++) {
-    id_cache_.push_back(i);
+    ids.push_back(i);
   }
   return Status::OK();
 }
@@ -138,6 +270,18 @@ std::shared_ptr<AutoInrementer> AutoIncrementerManager::GetOrCreateDocumentIndex
   }
 }
 
+void AutoIncrementerManager::MaybePrewarmVectorIndex(std::shared_ptr<VectorIndex>& index) {
+  if (FLAGS_auto_incre_prewarm && index->HasAutoIncrement()) {
+    GetOrCreateVectorIndexIncrementer(index)->Prewarm();
+  }
+}
+
+void AutoIncrementerManager::MaybePrewarmDocumentIndex(std::shared_ptr<DocumentIndex>& index) {
+  if (FLAGS_auto_incre_prewarm && index->HasAutoIncrement()) {
+    GetOrCreateDocumentIndexIncrementer(index)->Prewarm();
+  }
+}
+
 void AutoIncrementerManager::RemoveIndexIncrementerById(int64_t index_id) {
   std::unique_lock<std::mutex> lk(mutex_);
   auto iter = auto_incrementer_map_.find(index_id);
@@ -15,6 +15,7 @@
 #ifndef DINGODB_SDK_AUTO_INCREMENT_MANAGER_H_
 #define DINGODB_SDK_AUTO_INCREMENT_MANAGER_H_
 
+#include <condition_variable>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -32,7 +33,7 @@ namespace sdk {
 
 class ClientStub;
 
-class AutoInrementer {
+class AutoInrementer : public std::enable_shared_from_this<AutoInrementer> {
  public:
   AutoInrementer(const ClientStub& stub) : stub_(stub) {}
 
@@ -42,6 +43,10 @@ class AutoInrementer {
 
   Status GetNextIds(std::vector<int64_t>& to_fill, int64_t count);
 
+  // fetch the first range in background, so the first GetNextIds does not wait for coordinator,
+  // no-op once ids were asked for
+  void Prewarm();
+
  protected:
   virtual void PrepareRequest(pb::meta::GenerateAutoIncrementRequest& request) = 0;
 
@@ -49,12 +54,36 @@ class AutoInrementer {
   friend class AutoIncrementerManager;
   Status RefillCache();
 
+  Status GenerateIds(int64_t count, std::vector<int64_t>& ids);
+
+  // next request count, grow when ids are consumed fast, shrink back when slow
+  int64_t NextReqCount();
+
+  // wait in flight prefetch and move prefetched ids into id_cache_, return false when nothing prefetched
+  bool TakePrefetched();
+
+  // start background prefetch when id_cache_ is under low watermark
+  void MaybePrefetch();
+
+  // fetch count ids into prefetched_ in actuator, prefetching_ must be set by caller
+  void StartPrefetch(int64_t count);
+
   const ClientStub& stub_;
 
   std::mutex mutex_;
   struct Req;
   std::deque<Req*> queue_;
+  // only used by the front req of queue_
   std::vector<int64_t> id_cache_;
+  int64_t req_count_{0};
+  int64_t last_refill_us_{0};
+  // protected by mutex_, set by first GetNextIds, a prewarmed range may be before ids refilled after it
+  bool started_{false};
+
+  // prefetch buffer protected by mutex_
+  std::condition_variable prefetch_cv_;
+  bool prefetching_{false};
+  std::vector<int64_t> prefetched_;
 };
 
 class VectorIndexAutoInrementer : public AutoInrementer {
@@ -97,6 +126,12 @@ class AutoIncrementerManager {
 
   void RemoveIndexIncrementerById(int64_t index_id);
 
+  // called when an index is first resolved by index cache, prewarm its incrementer when FLAGS_auto_incre_prewarm
+  // is true and index has auto increment, prewarms of many indexes run concurrently in actuator
+  void MaybePrewarmVectorIndex(std::shared_ptr<VectorIndex>& index);
+
+  void MaybePrewarmDocumentIndex(std::shared_ptr<DocumentIndex>& index);
+
  private:
   const ClientStub& stub_;
   std::mutex mutex_;
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/cancel_token.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+thread_local std::shared_ptr<CancelToken> current_token;
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+void CancelToken::SetTimeoutMs(int64_t timeout_ms) {
+  deadline_us_.store(timeout_ms > 0 ? NowUs() + timeout_ms * 1000 : 0, std::memory_order_release);
+}
+
+bool CancelToken::IsExpired() const {
+  int64_t deadline_us = deadline_us_.load(std::memory_order_acquire);
+  return deadline_us != 0 && NowUs() >= deadline_us;
+}
+
+int64_t CancelToken::RemainingMs() const {
+  int64_t deadline_us = deadline_us_.load(std::memory_order_acquire);
+  if (deadline_us == 0) {
+    return -1;
+  }
+
+  int64_t remaining_us = deadline_us - NowUs();
+  if (remaining_us <= 0) {
+    return 0;
+  }
+  return (remaining_us + 999) / 1000;
+}
+
+Status CancelToken::Check() const {
+  if (IsCanceled()) {
+    return Status::Aborted("task canceled");
+  }
+  if (IsExpired()) {
+    return Status::TimedOut("deadline exceeded");
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<CancelToken> CancelToken::Current() { return current_token; }
+
+ScopedCancelToken::ScopedCancelToken(std::shared_ptr<CancelToken> token) : prev_(std::move(current_token)) {
+  current_token = std::move(token);
+}
+
+ScopedCancelToken::~ScopedCancelToken() { current_token = std::move(prev_); }
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_CANCEL_TOKEN_H_
+#define DINGODB_SDK_CANCEL_TOKEN_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Shared by caller and sdk operations. Once canceled or past its deadline, an operation stops before its next rpc
+// round, retry or phase and fails with Status::Aborted or Status::TimedOut. Rpcs already in flight are not
+// interrupted, but their timeout never exceeds the remaining time of the deadline.
+class CancelToken {
+ public:
+  CancelToken() = default;
+
+  // token with a deadline timeout_ms from now
+  explicit CancelToken(int64_t timeout_ms) { SetTimeoutMs(timeout_ms); }
+
+  void Cancel() { canceled_.store(true, std::memory_order_release); }
+
+  bool IsCanceled() const { return canceled_.load(std::memory_order_acquire); }
+
+  // set the deadline timeout_ms from now, timeout_ms <= 0 means no deadline
+  void SetTimeoutMs(int64_t timeout_ms);
+
+  // true when there is a deadline and it has passed
+  bool IsExpired() const;
+
+  // ms left before the deadline, at least 1 before it passed, 0 after it passed, -1 means no deadline
+  int64_t RemainingMs() const;
+
+  // Aborted when canceled, TimedOut when expired, otherwise OK
+  Status Check() const;
+
+  // token of the operations started by current thread, see ScopedCancelToken, nullptr when none
+  static std::shared_ptr<CancelToken> Current();
+
+ private:
+  std::atomic<bool> canceled_{false};
+  // steady clock, 0 means no deadline
+  std::atomic<int64_t> deadline_us_{0};
+};
+
+// Operations started by current thread in the scope, e.g. RawKV and Transaction calls, use token unless they are
+// given one explicitly. e.g.
+//   ScopedCancelToken scope(std::make_shared<CancelToken>(100));
+//   raw_kv->Get(key, value);  // fail with TimedOut after 100ms
+class ScopedCancelToken {
+ public:
+  explicit ScopedCancelToken(std::shared_ptr<CancelToken> token);
+  ~ScopedCancelToken();
+
+  ScopedCancelToken(const ScopedCancelToken&) = delete;
+  const ScopedCancelToken& operator=(const ScopedCancelToken&) = delete;
+
+ private:
+  std::shared_ptr<CancelToken> prev_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_CANCEL_TOKEN_H_
@@ -30,30 +30,48 @@
 #include "proto/coordinator.pb.h"
 #include "sdk/client_internal_data.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/common.h"
 #include "sdk/common/helper.h"
+#include "sdk/common/metrics.h"
+#include "sdk/common/profiler.h"
+#include "sdk/common/slow_log.h"
+#include "sdk/common/tracing.h"
 #include "sdk/common/param_config.h"
 #include "sdk/document.h"
 #include "sdk/document/document_index.h"
 #include "sdk/document/document_index_cache.h"
 #include "sdk/document/document_index_creator_internal_data.h"
+#include "sdk/hybrid/hybrid_search.h"
+#include "sdk/meta_cache_snapshot.h"
 #include "sdk/rawkv/raw_kv_batch_compare_and_set_task.h"
 #include "sdk/rawkv/raw_kv_batch_delete_task.h"
 #include "sdk/rawkv/raw_kv_batch_get_task.h"
 #include "sdk/rawkv/raw_kv_batch_put_if_absent_task.h"
 #include "sdk/rawkv/raw_kv_batch_put_task.h"
+#include "sdk/rawkv/raw_kv_batch_write_task.h"
+#include "sdk/rawkv/raw_kv_bulk_loader_internal_data.h"
 #include "sdk/rawkv/raw_kv_compare_and_set_task.h"
+#include "sdk/rawkv/raw_kv_count_range_task.h"
 #include "sdk/rawkv/raw_kv_delete_range_task.h"
 #include "sdk/rawkv/raw_kv_delete_task.h"
 #include "sdk/rawkv/raw_kv_get_task.h"
 #include "sdk/rawkv/raw_kv_internal_data.h"
 #include "sdk/rawkv/raw_kv_put_if_absent_task.h"
 #include "sdk/rawkv/raw_kv_put_task.h"
+#include "sdk/rawkv/raw_kv_reverse_scan_task.h"
+#include "sdk/rawkv/raw_kv_scan_result_set_task.h"
 #include "sdk/rawkv/raw_kv_scan_task.h"
 #include "sdk/region_creator_internal_data.h"
+#include "sdk/region_scan_iterator.h"
 #include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/scatter/scatter_get.h"
 #include "sdk/status.h"
 #include "sdk/transaction/txn_impl.h"
+#include "sdk/transaction/txn_lock_sweeper.h"
+#include "sdk/utils/async_util.h"
+#include "sdk/utils/codec.h"
 #include "sdk/utils/net_util.h"
+#include "sdk/utils/scoped_cleanup.h"
 #include "sdk/vector.h"
 #include "sdk/vector/vector_index_cache.h"
 #include "sdk/vector/vector_index_creator_internal_data.h"
@@ -78,15 +96,20 @@ Status Client::BuildFromAddrs(std::string addrs, Client** client) {
     return Status::InvalidArgument(fmt::format("invalid addrs:{}", addrs));
   }
 
-  Client* tmp = new Client();
-  Status s = tmp->Init(endpoints);
-  if (!s.ok()) {
-    delete tmp;
-    return s;
+  return BuildFromEndpoints(endpoints, nullptr, client);
+}
+
+Status Client::BuildFromAddrs(std::string addrs, const ClientRuntime& runtime, Client** client) {
+  if (addrs.empty()) {
+    return Status::InvalidArgument(fmt::format("addrs:{} is empty", addrs));
+  };
+
+  std::vector<EndPoint> endpoints = StringToEndpoints(addrs);
+  if (endpoints.empty()) {
+    return Status::InvalidArgument(fmt::format("invalid addrs:{}", addrs));
   }
 
-  *client = tmp;
-  return s;
+  return BuildFromEndpoints(endpoints, &runtime, client);
 }
 
 static bool IsServiceUrlValid(const std::string& service_url) { return service_url.substr(0, 7) == "file://"; }
@@ -100,10 +123,31 @@ Status Client::Build(std::string naming_service_url, Client** client) {
     return Status::InvalidArgument(fmt::format("invalid naming_service_url:{}", naming_service_url));
   }
 
-  std::vector<EndPoint> endpoints = FileNamingServiceUrlEndpoints(naming_service_url);
+  DINGO_RETURN_NOT_OK(BuildFromEndpoints(FileNamingServiceUrlEndpoints(naming_service_url), nullptr, client));
+  // coordinator members are reloaded from the same file when they are replaced
+  (*client)->data_->stub->GetMetaMemberRefresher()->SetNamingServiceUrl(naming_service_url);
+  return Status::OK();
+}
+
+Status Client::Build(std::string naming_service_url, const ClientRuntime& runtime, Client** client) {
+  if (naming_service_url.empty()) {
+    return Status::InvalidArgument("naming_service_url is empty");
+  };
+
+  if (!IsServiceUrlValid(naming_service_url)) {
+    return Status::InvalidArgument(fmt::format("invalid naming_service_url:{}", naming_service_url));
+  }
+
+  DINGO_RETURN_NOT_OK(BuildFromEndpoints(FileNamingServiceUrlEndpoints(naming_service_url), &runtime, client));
+  // coordinator members are reloaded from the same file when they are replaced
+  (*client)->data_->stub->GetMetaMemberRefresher()->SetNamingServiceUrl(naming_service_url);
+  return Status::OK();
+}
 
+Status Client::BuildFromEndpoints(const std::vector<EndPoint>& endpoints, const ClientRuntime* runtime,
+                                  Client** client) {
   Client* tmp = new Client();
-  Status s = tmp->Init(endpoints);
+  Status s = tmp->Init(endpoints, runtime);
   if (!s.ok()) {
     delete tmp;
     return s;
@@ -113,19 +157,59 @@ Status Client::Build(std::string naming_service_url, Client** client) {
   return s;
 }
 
+ClientRuntime::ClientRuntime() : data_(new ClientRuntime::Data()) {}
+
+ClientRuntime::~ClientRuntime() { delete data_; }
+
+Status ClientRuntime::Build(ClientRuntime** runtime) {
+  *runtime = new ClientRuntime();
+  return Status::OK();
+}
+
 Client::Client() : data_(new Client::Data()) {}
 
-Client::~Client() { delete data_; }
+Client::~Client() {
+  if (data_->init && !FLAGS_meta_cache_snapshot_path.empty()) {
+    Status s = MetaCacheSnapshot::Save(*data_->stub, FLAGS_meta_cache_snapshot_path);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "Fail save meta cache snapshot, status:" << s.ToString();
+    }
+  }
+  delete data_;
+}
 
-Status Client::Init(const std::vector<EndPoint>& endpoints) {
+Status Client::Init(const std::vector<EndPoint>& endpoints, const ClientRuntime* runtime) {
   CHECK(!endpoints.empty());
   if (data_->init) {
     return Status::IllegalState("forbidden multiple init");
   }
 
   auto tmp = std::make_unique<ClientStub>();
-  Status open = tmp->Open(endpoints);
+  Status open = runtime == nullptr ? tmp->Open(endpoints) : tmp->Open(endpoints, runtime->data_->runtime);
   if (open.IsOK()) {
+    // routes from snapshot are validated lazily, so warmup is not needed when it is loaded
+    Status loaded = Status::NotFound("meta cache snapshot disabled");
+    if (!FLAGS_meta_cache_snapshot_path.empty()) {
+      loaded = MetaCacheSnapshot::Load(*tmp, FLAGS_meta_cache_snapshot_path);
+      if (!loaded.ok() && !loaded.IsNotFound()) {
+        DINGO_LOG(WARNING) << "Fail load meta cache snapshot, status:" << loaded.ToString();
+      }
+    }
+
+    // warmup is best effort, missed routes are loaded on demand
+    if (!loaded.ok()) {
+      Status warmup = tmp->GetMetaCacheWarmer()->Warmup();
+      if (!warmup.ok()) {
+        DINGO_LOG(WARNING) << "meta cache warmup fail, status:" << warmup.ToString();
+      }
+    }
+    tmp->GetMetaCacheWarmer()->Start();
+    tmp->GetMetaCacheWatcher()->Start();
+    tmp->GetMetaMemberRefresher()->Start();
+    tmp->GetStoreConnectionManager()->Start();
+    tmp->GetVectorIndexCache()->Start();
+    tmp->GetDocumentIndexCache()->Start();
+
     data_->init = true;
     data_->stub = std::move(tmp);
   }
@@ -150,6 +234,31 @@ Status Client::NewTransaction(const TransactionOptions& options, Transaction** t
   return s;
 }
 
+Status Client::NewSnapshot(Snapshot** snapshot) {
+  pb::meta::TsoTimestamp tso;
+  DINGO_RETURN_NOT_OK(data_->stub->GetAdminTool()->GetCurrentTsoTimeStamp(tso));
+  return NewSnapshot(Tso2Timestamp(tso), snapshot);
+}
+
+Status Client::NewSnapshot(int64_t ts, Snapshot** snapshot) {
+  if (ts <= 0) {
+    return Status::InvalidArgument(fmt::format("snapshot ts must be positive, ts:{}", ts));
+  }
+
+  *snapshot = new Snapshot(new Transaction::TxnImpl(*data_->stub, ts));
+  return Status::OK();
+}
+
+Status Client::NewStaleSnapshot(int64_t max_staleness_ms, Snapshot** snapshot) {
+  if (max_staleness_ms < 0) {
+    return Status::InvalidArgument(fmt::format("max_staleness_ms must not be negative, value:{}", max_staleness_ms));
+  }
+
+  pb::meta::TsoTimestamp tso;
+  DINGO_RETURN_NOT_OK(data_->stub->GetAdminTool()->GetStaleTsoTimeStamp(max_staleness_ms, tso));
+  return NewSnapshot(Tso2Timestamp(tso), snapshot);
+}
+
 Status Client::NewRegionCreator(RegionCreator** creator) {
   *creator = new RegionCreator(new RegionCreator::Data(*data_->stub));
   return Status::OK();
@@ -234,21 +343,92 @@ Status Client::DropDocumentIndexByName(int64_t schema_id, const std::string& ind
   return DropDocumentIndexById(index_id);
 }
 
+Status Client::GetMetrics(std::string& out_metrics) {
+  out_metrics = Metrics::Global().Dump();
+  return Status::OK();
+}
+
+Status Client::GetTraces(std::string& out_traces) {
+  out_traces = Tracer::Global().Export();
+  return Status::OK();
+}
+
+Status Client::GetSlowLog(std::string& out_slow_log) {
+  out_slow_log = SlowLog::Global().Dump();
+  return Status::OK();
+}
+
+Status Client::StartCpuProfile(const std::string& file) { return Profiler::Global().StartCpuProfile(file); }
+
+Status Client::StopCpuProfile() { return Profiler::Global().StopCpuProfile(); }
+
+Status Client::StartHeapProfile(const std::string& prefix) { return Profiler::Global().StartHeapProfile(prefix); }
+
+Status Client::StopHeapProfile() { return Profiler::Global().StopHeapProfile(); }
+
+Status Client::DumpHeapProfile() { return Profiler::Global().DumpHeapProfile(); }
+
+Status Client::HybridSearch(const HybridSearchParam& param, HybridSearchResult& out_result) {
+  return sdk::HybridSearch(*data_->stub, param, out_result);
+}
+
+Status Client::ScatterGet(const ScatterGetParam& param, ScatterGetResult& out_result) {
+  return sdk::ScatterGet(*data_->stub, param, out_result);
+}
+
+Status Client::ResolveStaleLocks(const std::string& start_key, const std::string& end_key, int64_t safe_point_ts,
+                                 int64_t& out_lock_count, LockSweepProgressCallback progress) {
+  TxnLockSweeper sweeper(*data_->stub, start_key, end_key, safe_point_ts, std::move(progress));
+  return sweeper.Run(out_lock_count);
+}
+
 RawKV::RawKV(Data* data) : data_(data) {}
 
 RawKV::~RawKV() { delete data_; }
 
 Status RawKV::Get(const std::string& key, std::string& out_value) {
+  if (FLAGS_raw_kv_auto_batch) {
+    return data_->stub.GetRawKvAutoBatcher()->Get(key, out_value);
+  }
+
   RawKvGetTask task(data_->stub, key, out_value);
   return task.Run();
 }
 
+Status RawKV::Get(const std::string& key, std::string& out_value, const ReadOptions& options) {
+  if (options.replica_read == kLeaderOnly) {
+    return Get(key, out_value);
+  }
+
+  RawKvGetTask task(data_->stub, key, out_value, options);
+  return task.Run();
+}
+
 Status RawKV::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& out_kvs) {
-  RawKvBatchGetTask task(data_->stub, keys, out_kvs);
+  RawKvBatchGetTask task(data_->stub, ToKeyViews(keys), out_kvs);
+  return task.Run();
+}
+
+Status RawKV::BatchGet(const std::vector<std::string>& keys, KvResultSet& out_kvs) {
+  RawKvBatchGetTask task(data_->stub, ToKeyViews(keys), out_kvs);
+  return task.Run();
+}
+
+Status RawKV::BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& out_kvs) {
+  RawKvBatchGetTask task(data_->stub, ToKeyViews(keys, key_count), out_kvs);
+  return task.Run();
+}
+
+Status RawKV::BatchGet(const Slice* keys, size_t key_count, KvResultSet& out_kvs) {
+  RawKvBatchGetTask task(data_->stub, ToKeyViews(keys, key_count), out_kvs);
   return task.Run();
 }
 
 Status RawKV::Put(const std::string& key, const std::string& value) {
+  if (FLAGS_raw_kv_auto_batch) {
+    return data_->stub.GetRawKvAutoBatcher()->Put(key, value);
+  }
+
   RawKvPutTask task(data_->stub, key, value);
   return task.Run();
 }
@@ -258,6 +438,11 @@ Status RawKV::BatchPut(const std::vector<KVPair>& kvs) {
   return task.Run();
 }
 
+Status RawKV::BatchPut(std::vector<KVPair>&& kvs) {
+  RawKvBatchPutTask task(data_->stub, std::move(kvs));
+  return task.Run();
+}
+
 Status RawKV::PutIfAbsent(const std::string& key, const std::string& value, bool& out_state) {
   RawKvPutIfAbsentTask task(data_->stub, key, value, out_state);
   return task.Run();
@@ -274,7 +459,12 @@ Status RawKV::Delete(const std::string& key) {
 }
 
 Status RawKV::BatchDelete(const std::vector<std::string>& keys) {
-  RawKvBatchDeleteTask task(data_->stub, keys);
+  RawKvBatchDeleteTask task(data_->stub, ToKeyViews(keys));
+  return task.Run();
+}
+
+Status RawKV::BatchDelete(const Slice* keys, size_t key_count) {
+  RawKvBatchDeleteTask task(data_->stub, ToKeyViews(keys, key_count));
   return task.Run();
 }
 
@@ -322,6 +512,11 @@ Status RawKV::BatchCompareAndSet(const std::vector<KVPair>& kvs, const std::vect
   return task.Run();
 }
 
+Status RawKV::BatchWrite(const std::vector<RawKvOp>& ops, std::vector<KeyOpState>& out_states) {
+  RawKvBatchWriteTask task(data_->stub, ops, out_states);
+  return task.Run();
+}
+
 Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs) {
   if (start_key.empty() || end_key.empty()) {
     return Status::InvalidArgument("start_key and end_key must not empty, check params");
@@ -335,6 +530,177 @@ Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uin
   return task.Run();
 }
 
+Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs,
+                   const ReadOptions& options) {
+  ScanOptions scan_options;
+  scan_options.replica_read = options.replica_read;
+  return Scan(start_key, end_key, limit, kvs, scan_options);
+}
+
+Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs,
+                   const ScanOptions& options) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  RawKvScanTask task(data_->stub, start_key, end_key, limit, kvs, options);
+  return task.Run();
+}
+
+Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, KvResultSet& out_kvs) {
+  return Scan(start_key, end_key, limit, out_kvs, ScanOptions());
+}
+
+Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, KvResultSet& out_kvs,
+                   const ScanOptions& options) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  RawKvScanResultSetTask task(data_->stub, start_key, end_key, limit, out_kvs, options);
+  return task.Run();
+}
+
+Status RawKV::CountRange(const std::string& start_key, const std::string& end_key, int64_t& out_count) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  RawKvCountRangeTask task(data_->stub, start_key, end_key, out_count);
+  return task.Run();
+}
+
+Status RawKV::ReverseScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                          std::vector<KVPair>& out_kvs) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  RawKvReverseScanTask task(data_->stub, start_key, end_key, limit, out_kvs);
+  return task.Run();
+}
+
+// task is owned by callback, delete it after user cb is invoked
+template <class T>
+static void AsyncRunRawKvTask(T* task, StatusCallback cb) {
+  CHECK(cb) << "cb is invalid";
+  task->AsyncRun([task, cb = std::move(cb)](Status status) {
+    SCOPED_CLEANUP({ delete task; });
+    cb(std::move(status));
+  });
+}
+
+void RawKV::AsyncGet(const std::string& key, std::string& out_value, StatusCallback cb) {
+  AsyncRunRawKvTask(new RawKvGetTask(data_->stub, key, out_value), std::move(cb));
+}
+
+void RawKV::AsyncBatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& out_kvs, StatusCallback cb) {
+  AsyncRunRawKvTask(new RawKvBatchGetTask(data_->stub, ToKeyViews(keys), out_kvs), std::move(cb));
+}
+
+void RawKV::AsyncPut(const std::string& key, const std::string& value, StatusCallback cb) {
+  AsyncRunRawKvTask(new RawKvPutTask(data_->stub, key, value), std::move(cb));
+}
+
+void RawKV::AsyncBatchPut(const std::vector<KVPair>& kvs, StatusCallback cb) {
+  AsyncRunRawKvTask(new RawKvBatchPutTask(data_->stub, kvs), std::move(cb));
+}
+
+void RawKV::AsyncScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                      std::vector<KVPair>& out_kvs, StatusCallback cb) {
+  if (start_key.empty() || end_key.empty()) {
+    cb(Status::InvalidArgument("start_key and end_key must not empty, check params"));
+    return;
+  }
+
+  if (start_key >= end_key) {
+    cb(Status::InvalidArgument("end_key must greater than start_key, check params"));
+    return;
+  }
+
+  AsyncRunRawKvTask(new RawKvScanTask(data_->stub, start_key, end_key, limit, out_kvs), std::move(cb));
+}
+
+void RawKV::AsyncDeleteRangeNonContinuous(const std::string& start_key, const std::string& end_key,
+                                          int64_t& out_delete_count, StatusCallback cb,
+                                          DeleteRangeProgressCallback progress) {
+  if (start_key.empty() || end_key.empty()) {
+    cb(Status::InvalidArgument("start_key and end_key must not empty, check params"));
+    return;
+  }
+
+  if (start_key >= end_key) {
+    cb(Status::InvalidArgument("end_key must greater than start_key, check params"));
+    return;
+  }
+
+  AsyncRunRawKvTask(
+      new RawKvDeleteRangeTask(data_->stub, start_key, end_key, false, out_delete_count, std::move(progress)),
+      std::move(cb));
+}
+
+void RawKV::AsyncDeleteRange(const std::string& start_key, const std::string& end_key, int64_t& out_delete_count,
+                             StatusCallback cb, DeleteRangeProgressCallback progress) {
+  if (start_key.empty() || end_key.empty()) {
+    cb(Status::InvalidArgument("start_key and end_key must not empty, check params"));
+    return;
+  }
+
+  if (start_key >= end_key) {
+    cb(Status::InvalidArgument("end_key must greater than start_key, check params"));
+    return;
+  }
+
+  AsyncRunRawKvTask(
+      new RawKvDeleteRangeTask(data_->stub, start_key, end_key, true, out_delete_count, std::move(progress)),
+      std::move(cb));
+}
+
+Status RawKV::NewIterator(const std::string& start_key, const std::string& end_key, KvIterator** out_iter) {
+  return NewIterator(start_key, end_key, ScanOptions(), out_iter);
+}
+
+Status RawKV::NewIterator(const std::string& start_key, const std::string& end_key, const ScanOptions& options,
+                          KvIterator** out_iter) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  auto iter = std::make_unique<RegionScanIterator>(data_->stub, start_key, end_key, options);
+  Status s = iter->Seek(start_key);
+  if (!s.ok()) {
+    return s;
+  }
+
+  *out_iter = iter.release();
+  return Status::OK();
+}
+
+Status RawKV::NewBulkLoader(RawKvBulkLoader** out_loader) {
+  *out_loader = new RawKvBulkLoader(new RawKvBulkLoader::Data(data_->stub));
+  return Status::OK();
+}
+
 Transaction::Transaction(TxnImpl* impl) : impl_(impl) {}
 
 Transaction::~Transaction() { delete impl_; }
@@ -343,14 +709,28 @@ Status Transaction::Begin() { return impl_->Begin(); }
 
 Status Transaction::Get(const std::string& key, std::string& value) { return impl_->Get(key, value); }
 
+Status Transaction::Get(const std::string& key, std::string& value, const ReadOptions& options) {
+  return impl_->Get(key, value, options);
+}
+
 Status Transaction::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
   return impl_->BatchGet(keys, kvs);
 }
 
+Status Transaction::BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& kvs) {
+  return impl_->BatchGet(keys, key_count, kvs);
+}
+
+Status Transaction::BatchGetForUpdate(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
+  return impl_->BatchGetForUpdate(keys, kvs);
+}
+
 Status Transaction::Put(const std::string& key, const std::string& value) { return impl_->Put(key, value); }
 
 Status Transaction::BatchPut(const std::vector<KVPair>& kvs) { return impl_->BatchPut(kvs); }
 
+Status Transaction::BatchPut(std::vector<KVPair>&& kvs) { return impl_->BatchPut(std::move(kvs)); }
+
 Status Transaction::PutIfAbsent(const std::string& key, const std::string& value) {
   return impl_->PutIfAbsent(key, value);
 }
@@ -363,14 +743,88 @@ Status Transaction::BatchDelete(const std::vector<std::string>& keys) { return i
 
 Status Transaction::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit,
                          std::vector<KVPair>& kvs) {
-  return impl_->Scan(start_key, end_key, limit, kvs);
+  return impl_->Scan(start_key, end_key, limit, kvs, ScanOptions());
 }
 
-Status Transaction::PreCommit() { return impl_->PreCommit(); }
+Status Transaction::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                         std::vector<KVPair>& kvs, const ScanOptions& options) {
+  return impl_->Scan(start_key, end_key, limit, kvs, options);
+}
 
-Status Transaction::Commit() { return impl_->Commit(); }
+Status Transaction::ReverseScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                                std::vector<KVPair>& kvs) {
+  return impl_->ReverseScan(start_key, end_key, limit, kvs);
+}
+
+Status Transaction::NewIterator(const std::string& start_key, const std::string& end_key, KvIterator** out_iter) {
+  return impl_->NewIterator(start_key, end_key, ScanOptions(), out_iter);
+}
 
-Status Transaction::Rollback() { return impl_->Rollback(); }
+Status Transaction::NewIterator(const std::string& start_key, const std::string& end_key, const ScanOptions& options,
+                                KvIterator** out_iter) {
+  return impl_->NewIterator(start_key, end_key, options, out_iter);
+}
+
+Status Transaction::PreCommit() {
+  return RecordAsTask("TxnPreCommit", [this] { return impl_->PreCommit(); });
+}
+
+Status Transaction::Commit() {
+  return RecordAsTask("TxnCommit", [this] { return impl_->Commit(); });
+}
+
+Status Transaction::Rollback() {
+  return RecordAsTask("TxnRollback", [this] { return impl_->Rollback(); });
+}
+
+void Transaction::AsyncGet(const std::string& key, std::string& value, StatusCallback cb) {
+  impl_->AsyncGet(key, value, std::move(cb));
+}
+
+void Transaction::AsyncBatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs, StatusCallback cb) {
+  impl_->AsyncBatchGet(ToKeyViews(keys), kvs, std::move(cb));
+}
+
+void Transaction::AsyncPreCommit(StatusCallback cb) { impl_->AsyncPreCommit(std::move(cb)); }
+
+void Transaction::AsyncCommit(StatusCallback cb) { impl_->AsyncCommit(std::move(cb)); }
+
+void Transaction::AsyncRollback(StatusCallback cb) { impl_->AsyncRollback(std::move(cb)); }
+
+Snapshot::Snapshot(Transaction::TxnImpl* impl) : impl_(impl) { CHECK(impl_->IsReadOnly()); }
+
+Snapshot::~Snapshot() { delete impl_; }
+
+int64_t Snapshot::GetTimestamp() const { return impl_->GetStartTs(); }
+
+Status Snapshot::Get(const std::string& key, std::string& value) { return impl_->Get(key, value); }
+
+Status Snapshot::Get(const std::string& key, std::string& value, const ReadOptions& options) {
+  return impl_->Get(key, value, options);
+}
+
+Status Snapshot::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
+  return impl_->BatchGet(keys, kvs);
+}
+
+Status Snapshot::BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& kvs) {
+  return impl_->BatchGet(keys, key_count, kvs);
+}
+
+Status Snapshot::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                      std::vector<KVPair>& kvs) {
+  return impl_->Scan(start_key, end_key, limit, kvs, ScanOptions());
+}
+
+Status Snapshot::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                      std::vector<KVPair>& kvs, const ScanOptions& options) {
+  return impl_->Scan(start_key, end_key, limit, kvs, options);
+}
+
+Status Snapshot::Export(const std::vector<ExportRange>& ranges, const ExportOptions& options,
+                        const ExportBatchCallback& cb) {
+  return impl_->Export(ranges, options, cb);
+}
 
 RegionCreator::RegionCreator(Data* data) : data_(data) {}
 
@@ -464,5 +918,129 @@ Status RegionCreator::Create(int64_t& out_region_id) {
   return Status::OK();
 }
 
+Status RegionCreator::CreateRegions(const std::vector<std::string>& split_keys, std::vector<int64_t>& out_region_ids) {
+  if (data_->region_name.empty()) {
+    return Status::InvalidArgument("Missing region name");
+  }
+  if (data_->lower_bound.empty() || data_->upper_bound.empty()) {
+    return Status::InvalidArgument("lower_bound or upper_bound must not empty");
+  }
+  if (data_->replica_num <= 0) {
+    return Status::InvalidArgument("replica num must greater 0");
+  }
+
+  std::vector<std::string> bounds;
+  bounds.reserve(split_keys.size() + 2);
+  bounds.push_back(data_->lower_bound);
+  for (const auto& key : split_keys) {
+    if (key <= bounds.back() || key >= data_->upper_bound) {
+      return Status::InvalidArgument(
+          fmt::format("split key:{} is not ascending or out of range", codec::BytesToHexString(key)));
+    }
+    bounds.push_back(key);
+  }
+  bounds.push_back(data_->upper_bound);
+  size_t count = bounds.size() - 1;
+
+  std::vector<std::unique_ptr<CreateRegionRpc>> rpcs;
+  std::vector<Status> statuses(count);
+  std::vector<std::unique_ptr<Synchronizer>> syncs;
+  rpcs.reserve(count);
+  syncs.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    rpcs.push_back(std::make_unique<CreateRegionRpc>());
+    auto* request = rpcs[i]->MutableRequest();
+    request->set_region_name(fmt::format("{}-{}", data_->region_name, i));
+    request->set_replica_num(data_->replica_num);
+    request->mutable_range()->set_start_key(bounds[i]);
+    request->mutable_range()->set_end_key(bounds[i + 1]);
+    request->set_raw_engine(EngineType2RawEngine(data_->engine_type));
+
+    syncs.push_back(std::make_unique<Synchronizer>());
+    data_->stub.GetCoordinatorRpcController()->AsyncCall(*rpcs[i], syncs[i]->AsStatusCallBack(statuses[i]));
+  }
+
+  for (auto& sync : syncs) {
+    sync->Wait();
+  }
+
+  Status ret;
+  out_region_ids.assign(count, 0);
+  std::vector<int64_t> creating_ids;
+  for (size_t i = 0; i < count; i++) {
+    if (!statuses[i].ok()) {
+      DINGO_LOG(WARNING) << "create region:" << rpcs[i]->Request()->region_name()
+                         << " fail, status:" << statuses[i].ToString();
+      if (ret.ok()) {
+        // only return first fail status
+        ret = statuses[i];
+      }
+      continue;
+    }
+
+    CHECK(rpcs[i]->Response()->region_id() > 0) << "create region internal error, req:"
+                                                 << rpcs[i]->Request()->DebugString()
+                                                 << ", resp:" << rpcs[i]->Response()->DebugString();
+    out_region_ids[i] = rpcs[i]->Response()->region_id();
+    creating_ids.push_back(out_region_ids[i]);
+  }
+
+  if (!data_->wait || creating_ids.empty()) {
+    return ret;
+  }
+
+  int retry = 0;
+  while (true) {
+    std::vector<bool> creating;
+    DINGO_RETURN_NOT_OK(data_->stub.GetAdminTool()->IsCreateRegionsInProgress(creating_ids, creating));
+
+    std::vector<int64_t> next_ids;
+    for (size_t i = 0; i < creating_ids.size(); i++) {
+      if (creating[i]) {
+        next_ids.push_back(creating_ids[i]);
+      }
+    }
+    creating_ids.swap(next_ids);
+    if (creating_ids.empty()) {
+      break;
+    }
+
+    retry++;
+    if (retry >= FLAGS_coordinator_interaction_max_retry) {
+      std::string msg = fmt::format("Fail query {} regions state retry:{} exceed limit:{}, delay ms:{}",
+                                    creating_ids.size(), retry, FLAGS_coordinator_interaction_max_retry,
+                                    FLAGS_coordinator_interaction_delay_ms);
+      DINGO_LOG(INFO) << msg;
+      return Status::Incomplete(msg);
+    }
+    usleep(FLAGS_coordinator_interaction_delay_ms * 1000);
+  }
+
+  // the bulk load right after finds all regions in cache
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = data_->stub.GetMetaCache()->ScanRegionsBetweenRange(data_->lower_bound, data_->upper_bound, 0, regions);
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "load created regions into meta cache fail, status:" << s.ToString();
+  }
+
+  return ret;
+}
+
+Status RegionCreator::PreSplit(const std::string& prefix, const std::vector<std::string>& split_keys,
+                               std::vector<int64_t>& out_region_ids) {
+  // end of the prefix is the prefix with its last byte below 0xff increased
+  std::string end_key = prefix;
+  while (!end_key.empty() && static_cast<uint8_t>(end_key.back()) == 0xff) {
+    end_key.pop_back();
+  }
+  if (end_key.empty()) {
+    return Status::InvalidArgument("prefix must not be empty or all 0xff");
+  }
+  end_key.back() = static_cast<char>(static_cast<uint8_t>(end_key.back()) + 1);
+
+  SetRange(prefix, end_key);
+  return CreateRegions(split_keys, out_region_ids);
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
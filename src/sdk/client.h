@@ -16,11 +16,16 @@
 #define DINGODB_SDK_CLIENT_H_
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "sdk/document.h"
+#include "sdk/hybrid_search.h"
+#include "sdk/slice.h"
 #include "sdk/status.h"
+#include "sdk/utils/callback.h"
 #include "sdk/vector.h"
 
 namespace dingodb {
@@ -28,12 +33,41 @@ namespace sdk {
 
 class RawKV;
 class RegionCreator;
+class Snapshot;
 class TestBase;
 class TransactionOptions;
 class Transaction;
 class VectorIndexCreator;
 class VectorClient;
 class EndPoint;
+struct ScatterGetParam;
+struct ScatterGetResult;
+
+// progress of a lock sweep: locks found so far, and regions done of all regions in the range
+using LockSweepProgressCallback = std::function<void(int64_t lock_count, int64_t done_regions, int64_t total_regions)>;
+
+/// @brief Threads and store connections which many clients can share, e.g. one client per tenant in a service,
+/// each client built with it still has its own meta cache and other caches.
+/// Runtime can be deleted before the clients built with it, they keep the shared parts alive.
+class ClientRuntime {
+ public:
+  ClientRuntime(const ClientRuntime&) = delete;
+  const ClientRuntime& operator=(const ClientRuntime&) = delete;
+
+  ~ClientRuntime();
+
+  // NOTE:: Caller must delete *runtime when it is no longer needed.
+  static Status Build(ClientRuntime** runtime);
+
+ private:
+  friend class Client;
+
+  ClientRuntime();
+
+  // own
+  class Data;
+  Data* data_;
+};
 
 /// @brief Callers must keep client valid in it's lifetime in order to interact with the cluster,
 class Client {
@@ -54,12 +88,32 @@ class Client {
   // NOTE:: Caller must delete *client when it is no longer needed.
   static Status Build(std::string naming_service_url, Client** client);
 
+  // same as above, but threads and store connections of runtime are used instead of new ones
+  // NOTE:: Caller must delete *client when it is no longer needed.
+  static Status BuildFromAddrs(std::string addrs, const ClientRuntime& runtime, Client** client);
+
+  // NOTE:: Caller must delete *client when it is no longer needed.
+  static Status Build(std::string naming_service_url, const ClientRuntime& runtime, Client** client);
+
   // NOTE:: Caller must delete *raw_kv when it is no longer needed.
   Status NewRawKV(RawKV** raw_kv);
 
   // NOTE:: Caller must delete *txn when it is no longer needed.
   Status NewTransaction(const TransactionOptions& options, Transaction** txn);
 
+  // read only snapshot at a new tso, tso requests of concurrent callers share one rpc
+  // NOTE:: Caller must delete *snapshot when it is no longer needed.
+  Status NewSnapshot(Snapshot** snapshot);
+
+  // read only snapshot at ts given by caller, e.g. start ts of another txn
+  // NOTE:: Caller must delete *snapshot when it is no longer needed.
+  Status NewSnapshot(int64_t ts, Snapshot** snapshot);
+
+  // read only snapshot which maybe at most max_staleness_ms behind latest data, no tso rpc is sent when this client
+  // got a tso within max_staleness_ms
+  // NOTE:: Caller must delete *snapshot when it is no longer needed.
+  Status NewStaleSnapshot(int64_t max_staleness_ms, Snapshot** snapshot);
+
   // NOTE:: Caller must delete *raw_kv when it is no longer needed.
   Status NewRegionCreator(RegionCreator** creator);
 
@@ -95,13 +149,48 @@ class Client {
 
   Status DropDocumentIndexByName(int64_t schema_id, const std::string& index_name);
 
+  // metrics of sdk tasks, rpcs and meta cache of the whole process in prometheus text format, for scraping
+  Status GetMetrics(std::string& out_metrics);
+
+  // take spans finished since last call in OTLP/JSON format, can be posted to /v1/traces of an OpenTelemetry
+  // collector, spans are recorded only when FLAGS_enable_sdk_tracing is true
+  Status GetTraces(std::string& out_traces);
+
+  // requests slower than FLAGS_slow_log_threshold_ms with the region, endpoint, latency and bytes of every store rpc,
+  // the newest last
+  Status GetSlowLog(std::string& out_slow_log);
+
+  // cpu and heap profile of the whole process, NotSupported unless gperftools or jemalloc is linked or LD_PRELOADed,
+  // see sdk/common/profiler.h. Cpu profile is written to file when stopped, heap dumps to <prefix>.<seq>.heap
+  Status StartCpuProfile(const std::string& file);
+  Status StopCpuProfile();
+  Status StartHeapProfile(const std::string& prefix);
+  Status StopHeapProfile();
+  Status DumpHeapProfile();
+
+  // search the vector index and the document index of param concurrently and fuse results, see HybridSearchParam
+  Status HybridSearch(const HybridSearchParam& param, HybridSearchResult& out_result);
+
+  // raw kv, vector and document reads of param sent concurrently under one deadline, see ScatterGetParam
+  Status ScatterGet(const ScatterGetParam& param, ScatterGetResult& out_result);
+
+  // resolve txn locks older than safe_point_ts in [start_key, end_key), e.g. locks left by crashed writers, regions
+  // are swept concurrently. Locks of txns still alive are left. out_lock_count is the locks found, the sweep can be
+  // run again when fail. progress is called when a region is done, maybe in sdk internal thread, should not block
+  Status ResolveStaleLocks(const std::string& start_key, const std::string& end_key, int64_t safe_point_ts,
+                           int64_t& out_lock_count, LockSweepProgressCallback progress = nullptr);
+
  private:
   friend class RawKV;
   friend class TestBase;
 
   Client();
 
-  Status Init(const std::vector<EndPoint>& endpoints);
+  // runtime is nullptr means client has its own runtime
+  static Status BuildFromEndpoints(const std::vector<EndPoint>& endpoints, const ClientRuntime* runtime,
+                                   Client** client);
+
+  Status Init(const std::vector<EndPoint>& endpoints, const ClientRuntime* runtime);
 
   // own
   class Data;
@@ -113,11 +202,205 @@ struct KVPair {
   std::string value;
 };
 
+// Reads of the same entities from raw kv, a vector index and a document index, e.g. metadata, embedding and text
+// of the ids of a page. All parts fan out at the same time, so latency is the slowest part instead of the sum.
+struct ScatterGetParam {
+  // raw kv BatchGet, skipped when empty
+  std::vector<std::string> raw_kv_keys;
+  // vector BatchQueryByIndexId, skipped when vector_index_id is 0
+  int64_t vector_index_id{0};
+  QueryParam vector_query;
+  // document BatchQueryByIndexId, skipped when doc_index_id is 0
+  int64_t doc_index_id{0};
+  DocQueryParam doc_query;
+  // deadline of all parts, <= 0 means none, a shorter deadline of CancelToken::Current() applies too
+  int64_t timeout_ms{0};
+};
+
+// each part keeps its own status, so results of parts which succeed are usable when another part fails
+struct ScatterGetResult {
+  Status raw_kv_status;
+  std::vector<KVPair> kvs;
+  Status vector_status;
+  QueryResult vector_result;
+  Status doc_status;
+  DocQueryResult doc_result;
+};
+
+// kvs of scan or batch get without two strings per row, keys and values are either copied into a few large blocks
+// or views of rpc response buffers the result set keeps alive. Slices returned are valid until the result set is
+// cleared or destroyed, moving the result set keeps them valid.
+class KvResultSet {
+ public:
+  KvResultSet() = default;
+  ~KvResultSet() = default;
+
+  KvResultSet(KvResultSet&&) noexcept = default;
+  KvResultSet& operator=(KvResultSet&&) noexcept = default;
+
+  KvResultSet(const KvResultSet&) = delete;
+  KvResultSet& operator=(const KvResultSet&) = delete;
+
+  size_t Size() const { return entries_.size(); }
+
+  bool Empty() const { return entries_.empty(); }
+
+  // NOTE: index must be less than Size()
+  Slice Key(size_t index) const { return Slice(entries_[index].key, entries_[index].key_size); }
+
+  Slice Value(size_t index) const { return Slice(entries_[index].value, entries_[index].value_size); }
+
+  // copy key and value into the blocks
+  void Append(const Slice& key, const Slice& value);
+
+  // no copy, key and value must point into memory of an owner passed to Retain
+  void AppendView(const Slice& key, const Slice& value);
+
+  // keep owner alive as long as the views into it
+  void Retain(std::shared_ptr<const void> owner);
+
+  // move all kvs of other to the end, views stay valid
+  void Splice(KvResultSet&& other);
+
+  // keep the first size kvs, memory is released only by Clear
+  void Truncate(size_t size);
+
+  void Clear();
+
+  std::vector<KVPair> ToKVPairs() const;
+
+ private:
+  struct Entry {
+    const char* key;
+    size_t key_size;
+    const char* value;
+    size_t value_size;
+  };
+
+  const char* CopyToBlock(const Slice& data);
+
+  std::vector<Entry> entries_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* block_pos_{nullptr};
+  size_t block_remain_{0};
+  std::vector<std::shared_ptr<const void>> owners_;
+};
+
 struct KeyOpState {
   std::string key;
   bool state;
 };
 
+enum RawKvOpType : uint8_t { kRawKvPut, kRawKvDelete, kRawKvPutIfAbsent, kRawKvCompareAndSet };
+
+// one op of RawKV::BatchWrite
+struct RawKvOp {
+  RawKvOpType type;
+  std::string key;
+  // not used by delete
+  std::string value;
+  // only used by compare and set, empty means key not exist
+  std::string expected_value;
+};
+
+// which replica serves a read, the first attempt goes to the chosen replica and retries go to the leader,
+// when the store refuses follower read it replies not leader and the read is retried on the leader
+enum ReplicaReadPolicy : uint8_t { kLeaderOnly, kFollowerRoundRobin, kLowestLatency };
+
+struct ReadOptions {
+  ReplicaReadPolicy replica_read{kLeaderOnly};
+};
+
+// replica_read is ignored by Transaction scan, which always reads from leader
+struct ScanOptions : public ReadOptions {
+  // store only sends keys back, values are empty, for existence check and key enumeration
+  bool key_only{false};
+  // > 0: only the first value_prefix_len bytes of each value are kept, e.g. a header; ignored when key_only
+  uint32_t value_prefix_len{0};
+};
+
+// key range [start_key, end_key) of Snapshot::Export
+struct ExportRange {
+  std::string start_key;
+  std::string end_key;
+};
+
+struct ExportOptions : public ScanOptions {
+  // true: batches are passed in the order of ranges, and in key order inside a range, as one sequential scan would.
+  // batches of a sub range wait in memory until the sub ranges before it are done, so memory grows with the skew of
+  // sub ranges; false: batches are passed as they come
+  bool ordered{false};
+  // max sub ranges scanned concurrently, an idle scanner splits the rest of a busy sub range in the middle
+  int64_t parallelism{16};
+};
+
+// a batch of Snapshot::Export in ranges[range_index], kvs are in key order and can be moved away.
+// calls are one at a time, maybe in sdk internal thread, return not ok to stop export
+using ExportBatchCallback = std::function<Status(size_t range_index, std::vector<KVPair>& kvs)>;
+
+// pull based iterator over kvs in [start_key, end_key), kvs are fetched from regions batch by batch,
+// only current batch and one read ahead batch are kept in memory.
+// usage: for (; iter->Valid(); iter->Next()) { iter->key(); iter->value(); } then check iter->status()
+class KvIterator {
+ public:
+  KvIterator() = default;
+  virtual ~KvIterator() = default;
+
+  KvIterator(const KvIterator&) = delete;
+  const KvIterator& operator=(const KvIterator&) = delete;
+
+  // position at the first key >= target, target less than start_key means start_key
+  virtual Status Seek(const std::string& target) = 0;
+
+  // false when reach end or any error happened, check status() for error
+  virtual bool Valid() const = 0;
+
+  // NOTE: must be called only when Valid() is true
+  virtual Status Next() = 0;
+
+  // NOTE: must be called only when Valid() is true
+  virtual const std::string& key() const = 0;
+
+  virtual const std::string& value() const = 0;
+
+  virtual Status status() const = 0;
+};
+
+// Bulk loader of raw kvs for initial loads. Add buffers kvs, every FLAGS_raw_kv_bulk_load_sort_bytes of them are
+// sorted by key and cut by region boundaries of meta cache into chunks of about FLAGS_raw_kv_bulk_load_chunk_bytes,
+// chunks are written concurrently while later kvs are still being added. When
+// FLAGS_raw_kv_bulk_load_max_inflight_bytes are in flight, Add blocks until some chunk is done. A chunk whose region
+// splits during the load is regrouped by the new regions and written again.
+// Duplicate keys of one sort run keep the last added value, a key added again in a later run may be written in any
+// order against the previous one.
+// NOTE: not thread safe, one loader should be used by one thread
+class RawKvBulkLoader {
+ public:
+  RawKvBulkLoader(const RawKvBulkLoader&) = delete;
+  const RawKvBulkLoader& operator=(const RawKvBulkLoader&) = delete;
+
+  // finish and wait all in flight chunks
+  ~RawKvBulkLoader();
+
+  // return the first error of previous chunks if any, the kvs are not added then
+  Status Add(std::vector<KVPair> kvs);
+
+  // write all buffered kvs and wait until all chunks are done, return the first error since last Finish
+  Status Finish();
+
+ private:
+  friend class RawKV;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit RawKvBulkLoader(Data* data);
+};
+
+// progress of a range delete: keys deleted so far, and regions done of all regions in the range
+using DeleteRangeProgressCallback =
+    std::function<void(int64_t deleted_count, int64_t done_regions, int64_t total_regions)>;
+
 class RawKV {
  public:
   RawKV(const RawKV&) = delete;
@@ -127,12 +410,25 @@ class RawKV {
 
   Status Get(const std::string& key, std::string& out_value);
 
+  Status Get(const std::string& key, std::string& out_value, const ReadOptions& options);
+
   Status BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& out_kvs);
 
+  // kvs found are views into the rpc responses, no strings per row, see KvResultSet
+  Status BatchGet(const std::vector<std::string>& keys, KvResultSet& out_kvs);
+
+  // keys are views into buffers of caller, they are copied only into the requests
+  Status BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& out_kvs);
+
+  Status BatchGet(const Slice* keys, size_t key_count, KvResultSet& out_kvs);
+
   Status Put(const std::string& key, const std::string& value);
 
   Status BatchPut(const std::vector<KVPair>& kvs);
 
+  // kvs is moved, key and value buffers are handed over to the sdk instead of copied
+  Status BatchPut(std::vector<KVPair>&& kvs);
+
   Status PutIfAbsent(const std::string& key, const std::string& value, bool& out_state);
 
   Status BatchPutIfAbsent(const std::vector<KVPair>& kvs, std::vector<KeyOpState>& out_states);
@@ -141,6 +437,8 @@ class RawKV {
 
   Status BatchDelete(const std::vector<std::string>& keys);
 
+  Status BatchDelete(const Slice* keys, size_t key_count);
+
   // delete key in [start_key, end_key)
   // output_param: delete_count
   Status DeleteRangeNonContinuous(const std::string& start_key, const std::string& end_key, int64_t& out_delete_count);
@@ -157,9 +455,68 @@ class RawKV {
   Status BatchCompareAndSet(const std::vector<KVPair>& kvs, const std::vector<std::string>& expected_values,
                             std::vector<KeyOpState>& out_states);
 
+  // keys of ops must be unique, ops of each region are sent in one round, out_states[i] is the state of ops[i],
+  // put and delete are always true when done. ops are not atomic, a failed call may have applied some of them
+  Status BatchWrite(const std::vector<RawKvOp>& ops, std::vector<KeyOpState>& out_states);
+
   // limit: 0 means no limit, will scan all key in [start_key, end_key)
   Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& out_kvs);
 
+  // one region is scanned on one replica, begin, continue and release of its scanner go to the same replica
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& out_kvs,
+              const ReadOptions& options);
+
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& out_kvs,
+              const ScanOptions& options);
+
+  // kvs are views into the scan responses, no strings per row, see KvResultSet. Regions are scanned one by one,
+  // FLAGS_raw_kv_scan_parallelism is not used.
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, KvResultSet& out_kvs);
+
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, KvResultSet& out_kvs,
+              const ScanOptions& options);
+
+  // count keys in [start_key, end_key), regions are scanned key only in parallel and only counts come back to
+  // caller, see FLAGS_raw_kv_count_parallelism
+  Status CountRange(const std::string& start_key, const std::string& end_key, int64_t& out_count);
+
+  // scan from end_key back to start_key, out_kvs are in descending key order, e.g. the latest limit events
+  // limit: 0 means no limit, will scan all key in [start_key, end_key)
+  Status ReverseScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                     std::vector<KVPair>& out_kvs);
+
+  // async api, same semantics with sync version, cb is invoked once when the operation is done, maybe in sdk
+  // internal thread or in caller thread when param is invalid, so cb should not block.
+  // NOTE: caller must keep all params valid until cb is invoked
+  void AsyncGet(const std::string& key, std::string& out_value, StatusCallback cb);
+
+  void AsyncBatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& out_kvs, StatusCallback cb);
+
+  void AsyncPut(const std::string& key, const std::string& value, StatusCallback cb);
+
+  void AsyncBatchPut(const std::vector<KVPair>& kvs, StatusCallback cb);
+
+  void AsyncScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                 std::vector<KVPair>& out_kvs, StatusCallback cb);
+
+  // regions are deleted concurrently, progress is called when a region is done and should not block either
+  void AsyncDeleteRangeNonContinuous(const std::string& start_key, const std::string& end_key,
+                                     int64_t& out_delete_count, StatusCallback cb,
+                                     DeleteRangeProgressCallback progress = nullptr);
+
+  void AsyncDeleteRange(const std::string& start_key, const std::string& end_key, int64_t& out_delete_count,
+                        StatusCallback cb, DeleteRangeProgressCallback progress = nullptr);
+
+  // iterator is positioned at start_key when return ok
+  // NOTE:: Caller must delete *out_iter when it is no longer needed.
+  Status NewIterator(const std::string& start_key, const std::string& end_key, KvIterator** out_iter);
+
+  Status NewIterator(const std::string& start_key, const std::string& end_key, const ScanOptions& options,
+                     KvIterator** out_iter);
+
+  // NOTE:: Caller must delete *out_loader when it is no longer needed.
+  Status NewBulkLoader(RawKvBulkLoader** out_loader);
+
  private:
   friend class Client;
 
@@ -178,6 +535,10 @@ struct TransactionOptions {
   TransactionKind kind;
   TransactionIsolation isolation;
   uint32_t keep_alive_ms;
+  // only for kOptimistic, mutations are prewritten in background once FLAGS_txn_pipelined_flush_bytes are written,
+  // so PreCommit only prewrites the rest, primary key is the first written key and prewritten by the first flush.
+  // NOTE: a key can't be written again once it is flushed, such write fails with NotSupported
+  bool pipelined{false};
 };
 
 class Transaction {
@@ -189,12 +550,26 @@ class Transaction {
 
   Status Get(const std::string& key, std::string& value);
 
+  // options.replica_read only takes effect for kSnapshotIsolation, other isolation always read from leader
+  Status Get(const std::string& key, std::string& value, const ReadOptions& options);
+
   Status BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs);
 
+  // keys are views into buffers of caller, they are copied only into the requests and into kvs found
+  Status BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& kvs);
+
+  // only for kPessimistic, lock keys until txn end and get their latest values, keys are locked by one rpc per
+  // region, a key locked by other txn is waited for at most FLAGS_txn_pessimistic_lock_wait_timeout_ms
+  Status BatchGetForUpdate(const std::vector<std::string>& keys, std::vector<KVPair>& kvs);
+
+  // for kPessimistic, all write ops lock their keys before return
   Status Put(const std::string& key, const std::string& value);
 
   Status BatchPut(const std::vector<KVPair>& kvs);
 
+  // kvs is moved, key and value buffers are handed over to the sdk instead of copied
+  Status BatchPut(std::vector<KVPair>&& kvs);
+
   Status PutIfAbsent(const std::string& key, const std::string& value);
 
   Status BatchPutIfAbsent(const std::vector<KVPair>& kvs);
@@ -206,6 +581,23 @@ class Transaction {
   // limit: 0 means no limit, will scan all key in [start_key, end_key)
   Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs);
 
+  // values of local uncommitted mutations are projected the same way as values from store
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs,
+              const ScanOptions& options);
+
+  // scan from end_key back to start_key, kvs are in descending key order and see local uncommitted mutations
+  // limit: 0 means no limit, will scan all key in [start_key, end_key)
+  Status ReverseScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                     std::vector<KVPair>& kvs);
+
+  // iterator see local uncommitted mutations which exist when it is created, it is positioned at start_key
+  // when return ok
+  // NOTE:: Caller must delete *out_iter when it is no longer needed, and before txn is deleted.
+  Status NewIterator(const std::string& start_key, const std::string& end_key, KvIterator** out_iter);
+
+  Status NewIterator(const std::string& start_key, const std::string& end_key, const ScanOptions& options,
+                     KvIterator** out_iter);
+
   // If return status is ok, then call Commit
   // else try to precommit or rollback depends on status code
   Status PreCommit();
@@ -217,8 +609,22 @@ class Transaction {
 
   Status Rollback();
 
+  // async api, same semantics with sync version, cb is invoked once when the operation is done, maybe in sdk
+  // internal thread or in caller thread, so cb should not block.
+  // NOTE: caller must keep txn and all params valid until cb is invoked, and not call other methods of txn before
+  void AsyncGet(const std::string& key, std::string& value, StatusCallback cb);
+
+  void AsyncBatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs, StatusCallback cb);
+
+  void AsyncPreCommit(StatusCallback cb);
+
+  void AsyncCommit(StatusCallback cb);
+
+  void AsyncRollback(StatusCallback cb);
+
  private:
   friend class Client;
+  friend class Snapshot;
   friend class TestBase;
 
   Status Begin();
@@ -230,6 +636,45 @@ class Transaction {
   explicit Transaction(TxnImpl* impl);
 };
 
+// read only view at a fixed ts with snapshot isolation, nothing is buffered and nothing need commit or rollback
+class Snapshot {
+ public:
+  Snapshot(const Snapshot&) = delete;
+  const Snapshot& operator=(const Snapshot&) = delete;
+
+  ~Snapshot();
+
+  // ts all reads see
+  int64_t GetTimestamp() const;
+
+  Status Get(const std::string& key, std::string& value);
+
+  Status Get(const std::string& key, std::string& value, const ReadOptions& options);
+
+  Status BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs);
+
+  Status BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& kvs);
+
+  // limit: 0 means no limit, will scan all key in [start_key, end_key)
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs);
+
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs,
+              const ScanOptions& options);
+
+  // scan all ranges at ts of snapshot with up to options.parallelism sub ranges concurrently, e.g. a consistent
+  // backup. Regions are scanned as sub ranges, a large one is split further while scanners are idle.
+  // return ok when all kvs are passed to cb
+  Status Export(const std::vector<ExportRange>& ranges, const ExportOptions& options, const ExportBatchCallback& cb);
+
+ private:
+  friend class Client;
+
+  // own
+  Transaction::TxnImpl* impl_;
+
+  explicit Snapshot(Transaction::TxnImpl* impl);
+};
+
 enum EngineType : uint8_t { kLSM, kBTree, kXDPROCKS };
 
 class RegionCreator {
@@ -260,6 +705,17 @@ class RegionCreator {
   /// so caller should check out_region_id is set or not
   Status Create(int64_t& out_region_id);
 
+  /// Create regions covering the range of SetRange split at split_keys, e.g. before a bulk load to avoid split
+  /// storms. split_keys must be ascending and inside the range, the i-th region is named region_name-i. Create calls
+  /// are sent concurrently, with wait the regions are polled together until all are created and then loaded into
+  /// the meta cache. out_region_ids[i] is the region of the i-th range, 0 when its create call failed, the first
+  /// error is returned.
+  Status CreateRegions(const std::vector<std::string>& split_keys, std::vector<int64_t>& out_region_ids);
+
+  /// CreateRegions over all keys starting with prefix, SetRange is not needed
+  Status PreSplit(const std::string& prefix, const std::vector<std::string>& split_keys,
+                  std::vector<int64_t>& out_region_ids);
+
  private:
   friend class Client;
 
@@ -23,6 +23,18 @@
 namespace dingodb {
 namespace sdk {
 
+class ClientRuntime::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  Data() : runtime(StubRuntime::New()) {}
+
+  ~Data() = default;
+
+  StubRuntime runtime;
+};
+
 class Client::Data {
  public:
   Data(const Data&) = delete;
@@ -17,6 +17,7 @@
 #include <memory>
 #include <vector>
 
+#include "glog/logging.h"
 #include "sdk/common/param_config.h"
 #include "sdk/meta_cache.h"
 #include "sdk/rawkv/raw_kv_region_scanner_impl.h"
@@ -28,6 +29,10 @@
 #include "sdk/utils/net_util.h"
 #include "sdk/utils/thread_pool_actuator.h"
 
+#ifndef USE_GRPC
+#include "sdk/utils/bthread_actuator.h"
+#endif
+
 namespace dingodb {
 
 namespace sdk {
@@ -36,23 +41,98 @@ ClientStub::ClientStub()
     : coordinator_rpc_controller_(nullptr),
       raw_kv_region_scanner_factory_(nullptr),
       meta_cache_(nullptr),
-      admin_tool_(nullptr) {}
+      admin_tool_(nullptr),
+      task_tracker_(std::make_shared<TaskTracker>()) {}
+
+ClientStub::~ClientStub() {
+  // tasks on actuator may outlive the stub when runtime is shared, stop them before members are stopped,
+  // entered tasks may still hand blocking work to background actuator
+  task_tracker_->CancelAndWait();
+  // drain blocking tasks while the members they use are alive
+  background_actuator_.reset();
+
+  if (meta_cache_warmer_ != nullptr) {
+    meta_cache_warmer_->Stop();
+  }
+  if (meta_cache_watcher_ != nullptr) {
+    meta_cache_watcher_->Stop();
+  }
+  if (meta_member_refresher_ != nullptr) {
+    meta_member_refresher_->Stop();
+  }
+  if (store_connection_manager_ != nullptr) {
+    store_connection_manager_->Stop();
+  }
+  if (vector_index_cache_ != nullptr) {
+    vector_index_cache_->Stop();
+  }
+  if (document_index_cache_ != nullptr) {
+    document_index_cache_->Stop();
+  }
+}
+
+static std::shared_ptr<Actuator> NewActuator() {
+#ifndef USE_GRPC
+  if (FLAGS_actuator_backend == "bthread") {
+    return std::make_shared<BthreadActuator>();
+  }
+#endif
+  LOG_IF(WARNING, FLAGS_actuator_backend != "thread_pool")
+      << "unsupported actuator_backend: " << FLAGS_actuator_backend << ", use thread_pool";
+  return std::make_shared<ThreadPoolActuator>();
+}
+
+StubRuntime StubRuntime::New() {
+  StubRuntime runtime;
+
+  RpcClientOptions options;
+  options.timeout_ms = FLAGS_rpc_channel_timeout_ms;
+  options.connect_timeout_ms = FLAGS_rpc_channel_connect_timeout_ms;
+  runtime.store_rpc_client.reset(NewRpcClient(options, FLAGS_store_rpc_backend));
+  if (FLAGS_coordinator_rpc_backend == FLAGS_store_rpc_backend) {
+    runtime.coordinator_rpc_client = runtime.store_rpc_client;
+  } else {
+    runtime.coordinator_rpc_client.reset(NewRpcClient(options, FLAGS_coordinator_rpc_backend));
+  }
 
-ClientStub::~ClientStub() = default;
+  runtime.replica_selector = std::make_shared<ReplicaSelector>();
 
-Status ClientStub::Open(const std::vector<EndPoint>& endpoints) {
+  runtime.actuator = NewActuator();
+  runtime.actuator->Start(FLAGS_actuator_thread_num);
+
+  return runtime;
+}
+
+Status ClientStub::Open(const std::vector<EndPoint>& endpoints) { return Open(endpoints, StubRuntime::New()); }
+
+Status ClientStub::Open(const std::vector<EndPoint>& endpoints, const StubRuntime& runtime) {
   CHECK(!endpoints.empty());
+  CHECK_NOTNULL(runtime.store_rpc_client.get());
+  CHECK_NOTNULL(runtime.replica_selector.get());
+  CHECK_NOTNULL(runtime.actuator.get());
+
+  store_rpc_client_ = runtime.store_rpc_client;
+  coordinator_rpc_client_ =
+      runtime.coordinator_rpc_client != nullptr ? runtime.coordinator_rpc_client : runtime.store_rpc_client;
+  replica_selector_ = runtime.replica_selector;
+  actuator_ = runtime.actuator;
+
+  background_actuator_ = std::make_shared<ThreadPoolActuator>();
+  background_actuator_->Start(FLAGS_background_actuator_thread_num);
+
   coordinator_rpc_controller_ = std::make_shared<CoordinatorRpcController>(*this);
   coordinator_rpc_controller_->Open(endpoints);
 
   meta_rpc_controller_ = std::make_shared<CoordinatorRpcController>(*this);
   meta_rpc_controller_->Open(endpoints);
 
-  RpcClientOptions options;
-  options.timeout_ms = FLAGS_rpc_channel_timeout_ms;
-  options.connect_timeout_ms = FLAGS_rpc_channel_connect_timeout_ms;
+  region_circuit_breaker_ = std::make_shared<RegionCircuitBreaker>();
+
+  write_rate_limiter_ = std::make_shared<WriteRateLimiter>();
 
-  store_rpc_client_.reset(NewRpcClient(options));
+  memory_budget_ = std::make_shared<MemoryBudget>();
+
+  retry_budget_ = std::make_shared<RetryBudget>();
 
   meta_cache_ = std::make_shared<MetaCache>(coordinator_rpc_controller_);
 
@@ -60,19 +140,43 @@ Status ClientStub::Open(const std::vector<EndPoint>& endpoints) {
 
   txn_region_scanner_factory_ = std::make_shared<TxnRegionScannerFactoryImpl>();
 
+  raw_kv_get_single_flight_ = std::make_shared<RawKvGetSingleFlight>();
+
+  raw_kv_auto_batcher_ = std::make_shared<RawKvAutoBatcher>(*this);
+
+  raw_kv_read_cache_ =
+      std::make_shared<RawKvReadCache>(FLAGS_raw_kv_read_cache_capacity, FLAGS_raw_kv_read_cache_ttl_ms);
+
   admin_tool_ = std::make_shared<AdminTool>(*this);
 
   txn_lock_resolver_ = std::make_shared<TxnLockResolver>(*(this));
 
-  actuator_ = std::make_shared<ThreadPoolActuator>();
-  actuator_->Start(FLAGS_actuator_thread_num);
-
   vector_index_cache_ = std::make_shared<VectorIndexCache>(*this);
 
+  vector_search_cache_ = std::make_shared<VectorSearchCache>(FLAGS_vector_search_cache_capacity_bytes,
+                                                             FLAGS_vector_search_cache_ttl_ms);
+
+  vector_payload_cache_ =
+      std::make_shared<VectorPayloadCache>(FLAGS_vector_payload_cache_dir, FLAGS_vector_payload_cache_capacity);
+
+  vector_index_metrics_cache_ = std::make_shared<VectorIndexMetricsCache>(FLAGS_index_metrics_cache_ttl_ms);
+
+  langchain_expr_cache_ = std::make_shared<expression::LangchainExprCache>(FLAGS_langchain_expr_cache_capacity);
+
   document_index_cache_ = std::make_shared<DocumentIndexCache>(*this);
 
+  document_index_metrics_cache_ = std::make_shared<DocumentIndexMetricsCache>(FLAGS_index_metrics_cache_ttl_ms);
+
   auto_increment_manager_ = std::make_shared<AutoIncrementerManager>(*this);
 
+  meta_cache_warmer_ = std::make_shared<MetaCacheWarmer>(*this);
+
+  meta_cache_watcher_ = std::make_shared<MetaCacheWatcher>(*this);
+
+  meta_member_refresher_ = std::make_shared<MetaMemberRefresher>(*this);
+
+  store_connection_manager_ = std::make_shared<StoreConnectionManager>(*this);
+
   return Status::OK();
 }
 
@@ -20,26 +20,62 @@
 #include "glog/logging.h"
 #include "sdk/admin_tool.h"
 #include "sdk/auto_increment_manager.h"
+#include "sdk/document.h"
 #include "sdk/document/document_index_cache.h"
+#include "sdk/expression/langchain_expr_cache.h"
 #include "sdk/meta_cache.h"
+#include "sdk/meta_cache_warmer.h"
+#include "sdk/meta_cache_watcher.h"
+#include "sdk/meta_member_refresher.h"
+#include "sdk/rawkv/raw_kv_auto_batcher.h"
+#include "sdk/rawkv/raw_kv_get_single_flight.h"
+#include "sdk/rawkv/raw_kv_read_cache.h"
 #include "sdk/region_scanner.h"
 #include "sdk/rpc/coordinator_rpc_controller.h"
+#include "sdk/rpc/memory_budget.h"
+#include "sdk/rpc/region_circuit_breaker.h"
+#include "sdk/rpc/replica_selector.h"
+#include "sdk/rpc/retry_budget.h"
 #include "sdk/rpc/rpc_client.h"
+#include "sdk/rpc/store_connection_manager.h"
+#include "sdk/rpc/write_rate_limiter.h"
 #include "sdk/transaction/txn_lock_resolver.h"
+#include "sdk/utils/aggregate_cache.h"
+#include "sdk/utils/task_tracker.h"
+#include "sdk/vector.h"
 #include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_payload_cache.h"
+#include "sdk/vector/vector_search_cache.h"
 #include "utils/actuator.h"
 
 namespace dingodb {
 namespace sdk {
 
+using VectorIndexMetricsCache = AggregateCache<IndexMetricsResult>;
+using DocumentIndexMetricsCache = AggregateCache<DocIndexMetricsResult>;
+
+// threads and store connections of client stub, maybe shared by many stubs, see ClientRuntime
+struct StubRuntime {
+  std::shared_ptr<RpcClient> store_rpc_client;
+  // same as store_rpc_client unless the rpc backends differ
+  std::shared_ptr<RpcClient> coordinator_rpc_client;
+  std::shared_ptr<ReplicaSelector> replica_selector;
+  std::shared_ptr<Actuator> actuator;
+
+  static StubRuntime New();
+};
+
 class ClientStub {
  public:
   ClientStub();
 
   virtual ~ClientStub();
 
+  // stub owns a new runtime
   Status Open(const std::vector<EndPoint>& endpoints);
 
+  Status Open(const std::vector<EndPoint>& endpoints, const StubRuntime& runtime);
+
   virtual std::shared_ptr<CoordinatorRpcController> GetCoordinatorRpcController() const {
     DCHECK_NOTNULL(coordinator_rpc_controller_.get());
     return coordinator_rpc_controller_;
@@ -60,6 +96,36 @@ class ClientStub {
     return store_rpc_client_;
   }
 
+  virtual std::shared_ptr<RpcClient> GetCoordinatorRpcClient() const {
+    DCHECK_NOTNULL(coordinator_rpc_client_.get());
+    return coordinator_rpc_client_;
+  }
+
+  virtual std::shared_ptr<ReplicaSelector> GetReplicaSelector() const {
+    DCHECK_NOTNULL(replica_selector_.get());
+    return replica_selector_;
+  }
+
+  virtual std::shared_ptr<RegionCircuitBreaker> GetRegionCircuitBreaker() const {
+    DCHECK_NOTNULL(region_circuit_breaker_.get());
+    return region_circuit_breaker_;
+  }
+
+  virtual std::shared_ptr<WriteRateLimiter> GetWriteRateLimiter() const {
+    DCHECK_NOTNULL(write_rate_limiter_.get());
+    return write_rate_limiter_;
+  }
+
+  virtual std::shared_ptr<MemoryBudget> GetMemoryBudget() const {
+    DCHECK_NOTNULL(memory_budget_.get());
+    return memory_budget_;
+  }
+
+  virtual std::shared_ptr<RetryBudget> GetRetryBudget() const {
+    DCHECK_NOTNULL(retry_budget_.get());
+    return retry_budget_;
+  }
+
   virtual std::shared_ptr<RegionScannerFactory> GetRawKvRegionScannerFactory() const {
     DCHECK_NOTNULL(raw_kv_region_scanner_factory_.get());
     return raw_kv_region_scanner_factory_;
@@ -70,6 +136,26 @@ class ClientStub {
     return txn_region_scanner_factory_;
   }
 
+  virtual std::shared_ptr<StoreConnectionManager> GetStoreConnectionManager() const {
+    DCHECK_NOTNULL(store_connection_manager_.get());
+    return store_connection_manager_;
+  }
+
+  virtual std::shared_ptr<RawKvGetSingleFlight> GetRawKvGetSingleFlight() const {
+    DCHECK_NOTNULL(raw_kv_get_single_flight_.get());
+    return raw_kv_get_single_flight_;
+  }
+
+  virtual std::shared_ptr<RawKvAutoBatcher> GetRawKvAutoBatcher() const {
+    DCHECK_NOTNULL(raw_kv_auto_batcher_.get());
+    return raw_kv_auto_batcher_;
+  }
+
+  virtual std::shared_ptr<RawKvReadCache> GetRawKvReadCache() const {
+    DCHECK_NOTNULL(raw_kv_read_cache_.get());
+    return raw_kv_read_cache_;
+  }
+
   virtual std::shared_ptr<AdminTool> GetAdminTool() const {
     DCHECK_NOTNULL(admin_tool_.get());
     return admin_tool_;
@@ -85,35 +171,106 @@ class ClientStub {
     return actuator_;
   }
 
+  // own threads of the client for work blocking on rpcs, rpc retries are scheduled on actuator so blocking work
+  // there could take all its threads and wait forever. Tasks queued here are drained when the client is destroyed
+  // NOTE: tasks must not queue more tasks here
+  virtual std::shared_ptr<Actuator> GetBackgroundActuator() const {
+    DCHECK_NOTNULL(background_actuator_.get());
+    return background_actuator_;
+  }
+
+  // background tasks referring to this stub enter it, see TaskTracker, not virtual since it is built with the stub
+  const std::shared_ptr<TaskTracker>& GetTaskTracker() const { return task_tracker_; }
+
   virtual std::shared_ptr<VectorIndexCache> GetVectorIndexCache() const {
     DCHECK_NOTNULL(vector_index_cache_.get());
     return vector_index_cache_;
   }
 
+  virtual std::shared_ptr<VectorSearchCache> GetVectorSearchCache() const {
+    DCHECK_NOTNULL(vector_search_cache_.get());
+    return vector_search_cache_;
+  }
+
+  virtual std::shared_ptr<VectorPayloadCache> GetVectorPayloadCache() const {
+    DCHECK_NOTNULL(vector_payload_cache_.get());
+    return vector_payload_cache_;
+  }
+
+  virtual std::shared_ptr<VectorIndexMetricsCache> GetVectorIndexMetricsCache() const {
+    DCHECK_NOTNULL(vector_index_metrics_cache_.get());
+    return vector_index_metrics_cache_;
+  }
+
+  virtual std::shared_ptr<expression::LangchainExprCache> GetLangchainExprCache() const {
+    DCHECK_NOTNULL(langchain_expr_cache_.get());
+    return langchain_expr_cache_;
+  }
+
   virtual std::shared_ptr<DocumentIndexCache> GetDocumentIndexCache() const {
     DCHECK_NOTNULL(document_index_cache_.get());
     return document_index_cache_;
   }
 
+  virtual std::shared_ptr<DocumentIndexMetricsCache> GetDocumentIndexMetricsCache() const {
+    DCHECK_NOTNULL(document_index_metrics_cache_.get());
+    return document_index_metrics_cache_;
+  }
+
   virtual std::shared_ptr<AutoIncrementerManager> GetAutoIncrementerManager() const {
     DCHECK_NOTNULL(auto_increment_manager_.get());
     return auto_increment_manager_;
   }
 
+  virtual std::shared_ptr<MetaCacheWarmer> GetMetaCacheWarmer() const {
+    DCHECK_NOTNULL(meta_cache_warmer_.get());
+    return meta_cache_warmer_;
+  }
+
+  virtual std::shared_ptr<MetaCacheWatcher> GetMetaCacheWatcher() const {
+    DCHECK_NOTNULL(meta_cache_watcher_.get());
+    return meta_cache_watcher_;
+  }
+
+  virtual std::shared_ptr<MetaMemberRefresher> GetMetaMemberRefresher() const {
+    DCHECK_NOTNULL(meta_member_refresher_.get());
+    return meta_member_refresher_;
+  }
+
  private:
   // TODO: use unique ptr
   std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller_;
   std::shared_ptr<CoordinatorRpcController> meta_rpc_controller_;
   std::shared_ptr<MetaCache> meta_cache_;
   std::shared_ptr<RpcClient> store_rpc_client_;
+  std::shared_ptr<RpcClient> coordinator_rpc_client_;
+  std::shared_ptr<ReplicaSelector> replica_selector_;
+  std::shared_ptr<RegionCircuitBreaker> region_circuit_breaker_;
+  std::shared_ptr<WriteRateLimiter> write_rate_limiter_;
+  std::shared_ptr<MemoryBudget> memory_budget_;
+  std::shared_ptr<RetryBudget> retry_budget_;
+  std::shared_ptr<StoreConnectionManager> store_connection_manager_;
   std::shared_ptr<RegionScannerFactory> raw_kv_region_scanner_factory_;
   std::shared_ptr<RegionScannerFactory> txn_region_scanner_factory_;
+  std::shared_ptr<RawKvGetSingleFlight> raw_kv_get_single_flight_;
+  std::shared_ptr<RawKvAutoBatcher> raw_kv_auto_batcher_;
+  std::shared_ptr<RawKvReadCache> raw_kv_read_cache_;
   std::shared_ptr<AdminTool> admin_tool_;
   std::shared_ptr<TxnLockResolver> txn_lock_resolver_;
   std::shared_ptr<Actuator> actuator_;
+  std::shared_ptr<Actuator> background_actuator_;
+  std::shared_ptr<TaskTracker> task_tracker_;
   std::shared_ptr<VectorIndexCache> vector_index_cache_;
+  std::shared_ptr<VectorSearchCache> vector_search_cache_;
+  std::shared_ptr<VectorPayloadCache> vector_payload_cache_;
+  std::shared_ptr<VectorIndexMetricsCache> vector_index_metrics_cache_;
+  std::shared_ptr<expression::LangchainExprCache> langchain_expr_cache_;
   std::shared_ptr<DocumentIndexCache> document_index_cache_;
+  std::shared_ptr<DocumentIndexMetricsCache> document_index_metrics_cache_;
   std::shared_ptr<AutoIncrementerManager> auto_increment_manager_;
+  std::shared_ptr<MetaCacheWarmer> meta_cache_warmer_;
+  std::shared_ptr<MetaCacheWatcher> meta_cache_watcher_;
+  std::shared_ptr<MetaMemberRefresher> meta_member_refresher_;
 };
 
 }  // namespace sdk
@@ -15,11 +15,17 @@
 #ifndef DINGODB_SDK_COMMON_H_
 #define DINGODB_SDK_COMMON_H_
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "glog/logging.h"
 #include "google/protobuf/message.h"
 #include "proto/meta.pb.h"
 #include "proto/store.pb.h"
 #include "sdk/rpc/rpc.h"
+#include "sdk/slice.h"
+#include "sdk/status.h"
 #include "sdk/utils/net_util.h"
 
 static const int64_t kPhysicalShiftBits = 18;
@@ -108,6 +114,64 @@ static const pb::error::Error& GetRpcResponseError(Rpc& rpc) {
   return *error;
 }
 
+// nullptr if request has no store context
+static pb::store::Context* GetRpcRequestContext(Rpc& rpc) {
+  auto* request = rpc.RawMutableRequest();
+  const auto* descriptor = request->GetDescriptor();
+  const auto* reflection = request->GetReflection();
+
+  const auto* context_field = descriptor->FindFieldByName("context");
+  if (context_field == nullptr || context_field->type() != google::protobuf::FieldDescriptor::TYPE_MESSAGE) {
+    return nullptr;
+  }
+
+  auto* msg = reflection->MutableMessage(request, context_field);
+  return google::protobuf::DynamicCastToGenerated<pb::store::Context>(msg);
+}
+
+// false if request has no single key field, e.g. a batch or range request
+static bool GetRpcRequestKey(const Rpc& rpc, std::string& key) {
+  const auto* request = rpc.RawRequest();
+  const auto* descriptor = request->GetDescriptor();
+  const auto* reflection = request->GetReflection();
+
+  const auto* key_field = descriptor->FindFieldByName("key");
+  if (key_field == nullptr || key_field->is_repeated() ||
+      (key_field->type() != google::protobuf::FieldDescriptor::TYPE_BYTES &&
+       key_field->type() != google::protobuf::FieldDescriptor::TYPE_STRING)) {
+    return false;
+  }
+
+  key = reflection->GetString(*request, key_field);
+  return true;
+}
+
+// true when the region of a store rpc split, merged or is gone, the store rpc controller has cleared its route in
+// meta cache already, so a new lookup gets the current region(s)
+static bool IsRegionChanged(const Status& status) {
+  if (!status.IsIncomplete()) {
+    return false;
+  }
+
+  auto error_code = status.Errno();
+  return error_code == pb::error::EREGION_VERSION || error_code == pb::error::EREGION_NOT_FOUND ||
+         error_code == pb::error::EKEY_OUT_OF_RANGE;
+}
+
+// views of keys for tasks, keys are copied only into requests, valid as long as keys
+static std::vector<std::string_view> ToKeyViews(const std::vector<std::string>& keys) {
+  return std::vector<std::string_view>(keys.begin(), keys.end());
+}
+
+static std::vector<std::string_view> ToKeyViews(const Slice* keys, size_t key_count) {
+  std::vector<std::string_view> views;
+  views.reserve(key_count);
+  for (size_t i = 0; i < key_count; ++i) {
+    views.push_back(keys[i].ToStringView());
+  }
+  return views;
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
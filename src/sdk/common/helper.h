@@ -27,12 +27,14 @@ namespace sdk {
 
 // TODO: log in rpc when we support async
 template <class StoreClientRpc>
-static Status LogAndSendRpc(const ClientStub& stub, StoreClientRpc& rpc, std::shared_ptr<Region> region) {
+static Status LogAndSendRpc(const ClientStub& stub, StoreClientRpc& rpc, std::shared_ptr<Region> region,
+                            ReplicaReadPolicy replica_read = kLeaderOnly) {
   if (fLB::FLAGS_log_rpc_time) {
     auto start_time_ms =
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
             .count();
     StoreRpcController controller(stub, rpc, region);
+    controller.SetReplicaReadPolicy(replica_read);
     Status s = controller.Call();
 
     DINGO_LOG(INFO) << "rpc: " << rpc.Method() << " region: " << region->RegionId() << " cost: "
@@ -44,6 +46,7 @@ static Status LogAndSendRpc(const ClientStub& stub, StoreClientRpc& rpc, std::sh
     return s;
   } else {
     StoreRpcController controller(stub, rpc, region);
+    controller.SetReplicaReadPolicy(replica_read);
     Status s = controller.Call();
     return s;
   }
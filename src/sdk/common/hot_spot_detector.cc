@@ -0,0 +1,166 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/hot_spot_detector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+HotSpotTracker::HotSpotTracker() : sketch_(kDepth * kWidth, 0) {}
+
+void HotSpotTracker::Add(std::string_view key, int64_t top_k) {
+  // double hashing gives the kDepth independent rows from one hash
+  uint64_t hash = std::hash<std::string_view>()(key);
+  uint64_t step = (hash >> 32) | 1;
+  int64_t estimate = std::numeric_limits<int64_t>::max();
+  for (int i = 0; i < kDepth; i++) {
+    auto& count = sketch_[i * kWidth + (hash + i * step) % kWidth];
+    if (count < std::numeric_limits<int32_t>::max()) {
+      count++;
+    }
+    estimate = std::min<int64_t>(estimate, count);
+  }
+
+  auto iter = top_k_.find(std::string(key));
+  if (iter != top_k_.end()) {
+    iter->second = estimate;
+    return;
+  }
+  if (static_cast<int64_t>(top_k_.size()) < top_k) {
+    top_k_.emplace(key, estimate);
+    return;
+  }
+  if (top_k_.empty()) {
+    return;
+  }
+
+  auto coldest = std::min_element(top_k_.begin(), top_k_.end(),
+                                  [](const auto& a, const auto& b) { return a.second < b.second; });
+  if (estimate > coldest->second) {
+    top_k_.erase(coldest);
+    top_k_.emplace(key, estimate);
+  }
+}
+
+std::vector<HotSpotTracker::Item> HotSpotTracker::TopK() const {
+  std::vector<Item> items;
+  items.reserve(top_k_.size());
+  for (const auto& [key, count] : top_k_) {
+    items.push_back({key, count});
+  }
+  std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+    return a.count != b.count ? a.count > b.count : a.key < b.key;
+  });
+  return items;
+}
+
+void HotSpotTracker::Reset() {
+  std::fill(sketch_.begin(), sketch_.end(), 0);
+  top_k_.clear();
+}
+
+HotSpotDetector& HotSpotDetector::Global() {
+  static HotSpotDetector* detector = new HotSpotDetector();
+  return *detector;
+}
+
+bool HotSpotDetector::Sample() {
+  int64_t rate = FLAGS_sdk_hot_spot_sample_rate;
+  if (rate <= 0) {
+    return false;
+  }
+  thread_local uint64_t access_count = 0;
+  return ++access_count % rate == 0;
+}
+
+void HotSpotDetector::RecordSampledKey(std::string_view key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  MaybeRotateLocked(NowMs());
+  keys_.Add(key, FLAGS_sdk_hot_spot_top_k);
+}
+
+void HotSpotDetector::RecordSampledRegion(int64_t region_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  MaybeRotateLocked(NowMs());
+  regions_.Add(std::to_string(region_id), FLAGS_sdk_hot_spot_top_k);
+}
+
+std::vector<HotSpotDetector::HotKey> HotSpotDetector::GetHotKeys() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  MaybeRotateLocked(NowMs());
+  return last_hot_keys_;
+}
+
+std::vector<HotSpotDetector::HotRegion> HotSpotDetector::GetHotRegions() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  MaybeRotateLocked(NowMs());
+  return last_hot_regions_;
+}
+
+void HotSpotDetector::Reset() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  window_start_ms_ = 0;
+  keys_.Reset();
+  regions_.Reset();
+  last_hot_keys_.clear();
+  last_hot_regions_.clear();
+}
+
+void HotSpotDetector::MaybeRotateLocked(int64_t now_ms) {
+  if (window_start_ms_ == 0) {
+    window_start_ms_ = now_ms;
+    return;
+  }
+  int64_t elapsed_ms = now_ms - window_start_ms_;
+  if (elapsed_ms < std::max<int64_t>(FLAGS_sdk_hot_spot_window_ms, 1)) {
+    return;
+  }
+
+  // an idle gap is part of the window, so its qps fades instead of lasting until next access
+  int64_t rate = std::max<int64_t>(FLAGS_sdk_hot_spot_sample_rate, 1);
+  last_hot_keys_.clear();
+  for (auto& item : keys_.TopK()) {
+    last_hot_keys_.push_back({std::move(item.key), item.count * rate * 1000 / elapsed_ms});
+  }
+  last_hot_regions_.clear();
+  for (const auto& item : regions_.TopK()) {
+    last_hot_regions_.push_back({std::stoll(item.key), item.count * rate * 1000 / elapsed_ms});
+  }
+
+  keys_.Reset();
+  regions_.Reset();
+  window_start_ms_ = now_ms;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_COMMON_HOT_SPOT_DETECTOR_H_
+#define DINGODB_SDK_COMMON_HOT_SPOT_DETECTOR_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+
+// Approximate top k of sampled strings in a window: counts are kept in a count-min sketch, so memory does not grow
+// with distinct strings, and a string enters the top k when its estimate beats the coldest one.
+// NOTE: not thread safe
+class HotSpotTracker {
+ public:
+  struct Item {
+    std::string key;
+    // sampled count in the window, an over estimate
+    int64_t count;
+  };
+
+  static constexpr int kDepth = 4;
+  static constexpr int kWidth = 4096;
+
+  HotSpotTracker();
+
+  void Add(std::string_view key, int64_t top_k);
+
+  // hottest first
+  std::vector<Item> TopK() const;
+
+  void Reset();
+
+ private:
+  std::vector<int32_t> sketch_;
+  std::unordered_map<std::string, int64_t> top_k_;
+};
+
+// Process wide sampling of keys routed by meta cache and regions called by store rpcs, shared by all clients, to
+// find which keys and regions load the stores. One of every FLAGS_sdk_hot_spot_sample_rate accesses of a thread is
+// sampled, nothing when it is 0. Hot spots are reported for the last finished window of FLAGS_sdk_hot_spot_window_ms,
+// qps is scaled back by the sample rate.
+class HotSpotDetector {
+ public:
+  struct HotKey {
+    std::string key;
+    int64_t qps;
+  };
+
+  struct HotRegion {
+    int64_t region_id;
+    int64_t qps;
+  };
+
+  HotSpotDetector(const HotSpotDetector&) = delete;
+  const HotSpotDetector& operator=(const HotSpotDetector&) = delete;
+
+  static HotSpotDetector& Global();
+
+  // called by every access, only sampled ones take the lock
+  void RecordKey(std::string_view key) {
+    if (Sample()) {
+      RecordSampledKey(key);
+    }
+  }
+
+  void RecordRegion(int64_t region_id) {
+    if (Sample()) {
+      RecordSampledRegion(region_id);
+    }
+  }
+
+  // hottest first, at most FLAGS_sdk_hot_spot_top_k of the last finished window
+  std::vector<HotKey> GetHotKeys();
+
+  std::vector<HotRegion> GetHotRegions();
+
+  // drop windows and samples, for test
+  void Reset();
+
+ private:
+  HotSpotDetector() = default;
+
+  static bool Sample();
+
+  void RecordSampledKey(std::string_view key);
+  void RecordSampledRegion(int64_t region_id);
+
+  // finish the current window when it passed, called with mutex held
+  void MaybeRotateLocked(int64_t now_ms);
+
+  std::mutex mutex_;
+  int64_t window_start_ms_{0};
+  HotSpotTracker keys_;
+  HotSpotTracker regions_;
+  std::vector<HotKey> last_hot_keys_;
+  std::vector<HotRegion> last_hot_regions_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_COMMON_HOT_SPOT_DETECTOR_H_
@@ -0,0 +1,337 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/metrics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+#include "proto/error.pb.h"
+#include "sdk/common/hot_spot_detector.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/concurrency_limiter.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int Bucket(int64_t value) {
+  if (value <= 0) {
+    return 0;
+  }
+  int bucket = 64 - __builtin_clzll(static_cast<uint64_t>(value));
+  return std::min(bucket, MetricsHistogram::kBucketCount - 1);
+}
+
+std::string TaskMetricName(const std::string& task_name) { return task_name.substr(0, task_name.find('-')); }
+
+std::string ErrnoName(int32_t errcode) {
+  if (errcode == Metrics::kNetworkErrorCode) {
+    return "NETWORK";
+  }
+  if (pb::error::Errno_IsValid(errcode)) {
+    return pb::error::Errno_Name(static_cast<pb::error::Errno>(errcode));
+  }
+  return std::to_string(errcode);
+}
+
+// keys are binary, e.g. encoded vector ids, keep printable bytes and hex escape the others
+std::string KeyLabel(const std::string& key) {
+  std::string label;
+  label.reserve(key.size());
+  for (unsigned char c : key) {
+    if (c >= 0x20 && c < 0x7f && c != '"' && c != '\\') {
+      label.push_back(static_cast<char>(c));
+    } else {
+      label += fmt::format("\\\\x{:02x}", c);
+    }
+  }
+  return label;
+}
+
+void DumpHistogram(std::string& out, const std::string& name, const std::string& labels,
+                   const MetricsHistogram& histogram) {
+  for (double quantile : {0.5, 0.9, 0.99, 0.999}) {
+    out += fmt::format("{}{{{},quantile=\"{}\"}} {}\n", name, labels, quantile, histogram.Percentile(quantile));
+  }
+  out += fmt::format("{}_sum{{{}}} {}\n", name, labels, histogram.Sum());
+  out += fmt::format("{}_count{{{}}} {}\n", name, labels, histogram.Count());
+}
+}  // namespace
+
+void MetricsHistogram::Record(int64_t value) {
+  buckets_[Bucket(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(std::max<int64_t>(value, 0), std::memory_order_relaxed);
+}
+
+int64_t MetricsHistogram::Percentile(double quantile) const {
+  std::array<int64_t, kBucketCount> counts;
+  int64_t total = 0;
+  for (int i = 0; i < kBucketCount; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  int64_t rank = std::max<int64_t>(1, static_cast<int64_t>(quantile * total + 0.5));
+  int64_t seen = 0;
+  for (int i = 0; i < kBucketCount; i++) {
+    seen += counts[i];
+    if (seen >= rank) {
+      return i == 0 ? 0 : (int64_t{1} << i) - 1;
+    }
+  }
+  return (int64_t{1} << (kBucketCount - 1)) - 1;
+}
+
+void MetricsErrorCounter::Add(int32_t errcode) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  counts_[errcode]++;
+}
+
+std::map<int32_t, int64_t> MetricsErrorCounter::Snapshot() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return counts_;
+}
+
+#ifndef USE_GRPC
+TaskMetric::TaskMetric(const std::string& name) : recorder("dingo_sdk_task_" + name) {}
+
+RpcMetric::RpcMetric(const std::string& method) : recorder("dingo_sdk_rpc_" + method) {}
+#else
+TaskMetric::TaskMetric(const std::string& name) { (void)name; }
+
+RpcMetric::RpcMetric(const std::string& method) { (void)method; }
+#endif
+
+Metrics& Metrics::Global() {
+  // never destroyed, tasks may still finish while process exits
+  static auto* metrics = new Metrics();
+  return *metrics;
+}
+
+TaskMetric* Metrics::GetTaskMetric(const std::string& task_name) {
+  if (!FLAGS_enable_sdk_metrics) {
+    return nullptr;
+  }
+
+  std::string name = TaskMetricName(task_name);
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = tasks_.find(name);
+    if (iter != tasks_.end()) {
+      return iter->second.get();
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  auto& metric = tasks_[name];
+  if (metric == nullptr) {
+    metric = std::make_unique<TaskMetric>(name);
+  }
+  return metric.get();
+}
+
+RpcMetric* Metrics::GetRpcMetric(const std::string& method) {
+  if (!FLAGS_enable_sdk_metrics) {
+    return nullptr;
+  }
+
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = rpcs_.find(method);
+    if (iter != rpcs_.end()) {
+      return iter->second.get();
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  auto& metric = rpcs_[method];
+  if (metric == nullptr) {
+    metric = std::make_unique<RpcMetric>(method);
+  }
+  return metric.get();
+}
+
+void Metrics::RecordTask(const std::string& task_name, int64_t latency_us, const Status& status, int64_t fan_out) {
+  TaskMetric* metric = GetTaskMetric(task_name);
+  if (metric == nullptr) {
+    return;
+  }
+
+  metric->latency_us.Record(latency_us);
+  if (fan_out > 0) {
+    metric->fan_out.Record(fan_out);
+  }
+  if (!status.ok()) {
+    metric->fail_count.fetch_add(1, std::memory_order_relaxed);
+  }
+#ifndef USE_GRPC
+  metric->recorder << latency_us;
+#endif
+}
+
+void Metrics::RecordTaskRetry(const std::string& task_name, int32_t errcode) {
+  TaskMetric* metric = GetTaskMetric(task_name);
+  if (metric != nullptr) {
+    metric->retries.Add(errcode);
+  }
+}
+
+void Metrics::RecordRpc(const Rpc& rpc, int64_t latency_us, int32_t errcode) {
+  RpcMetric* metric = GetRpcMetric(rpc.Method());
+  if (metric == nullptr) {
+    return;
+  }
+
+  metric->latency_us.Record(latency_us);
+  metric->request_bytes.fetch_add(rpc.RawRequest()->ByteSizeLong(), std::memory_order_relaxed);
+  if (errcode != kNetworkErrorCode) {
+    metric->response_bytes.fetch_add(rpc.RawResponse()->ByteSizeLong(), std::memory_order_relaxed);
+  }
+  if (errcode != pb::error::Errno::OK) {
+    metric->errors.Add(errcode);
+  }
+#ifndef USE_GRPC
+  metric->recorder << latency_us;
+#endif
+}
+
+std::string Metrics::Dump() const {
+  std::string out;
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+
+  // sort by name, so output is stable between scrapes
+  std::map<std::string, const TaskMetric*> tasks;
+  for (const auto& [name, metric] : tasks_) {
+    tasks.emplace(name, metric.get());
+  }
+  std::map<std::string, const RpcMetric*> rpcs;
+  for (const auto& [method, metric] : rpcs_) {
+    rpcs.emplace(method, metric.get());
+  }
+
+  out += "# TYPE dingo_sdk_task_latency_us summary\n";
+  for (const auto& [name, metric] : tasks) {
+    DumpHistogram(out, "dingo_sdk_task_latency_us", fmt::format("task=\"{}\"", name), metric->latency_us);
+  }
+  out += "# TYPE dingo_sdk_task_fan_out summary\n";
+  for (const auto& [name, metric] : tasks) {
+    DumpHistogram(out, "dingo_sdk_task_fan_out", fmt::format("task=\"{}\"", name), metric->fan_out);
+  }
+  out += "# TYPE dingo_sdk_task_fail_total counter\n";
+  for (const auto& [name, metric] : tasks) {
+    out += fmt::format("dingo_sdk_task_fail_total{{task=\"{}\"}} {}\n", name,
+                       metric->fail_count.load(std::memory_order_relaxed));
+  }
+  out += "# TYPE dingo_sdk_task_retry_total counter\n";
+  for (const auto& [name, metric] : tasks) {
+    for (const auto& [errcode, count] : metric->retries.Snapshot()) {
+      out += fmt::format("dingo_sdk_task_retry_total{{task=\"{}\",errno=\"{}\"}} {}\n", name, ErrnoName(errcode),
+                         count);
+    }
+  }
+
+  out += "# TYPE dingo_sdk_rpc_latency_us summary\n";
+  for (const auto& [method, metric] : rpcs) {
+    DumpHistogram(out, "dingo_sdk_rpc_latency_us", fmt::format("method=\"{}\"", method), metric->latency_us);
+  }
+  out += "# TYPE dingo_sdk_rpc_request_bytes_total counter\n";
+  for (const auto& [method, metric] : rpcs) {
+    out += fmt::format("dingo_sdk_rpc_request_bytes_total{{method=\"{}\"}} {}\n", method,
+                       metric->request_bytes.load(std::memory_order_relaxed));
+  }
+  out += "# TYPE dingo_sdk_rpc_response_bytes_total counter\n";
+  for (const auto& [method, metric] : rpcs) {
+    out += fmt::format("dingo_sdk_rpc_response_bytes_total{{method=\"{}\"}} {}\n", method,
+                       metric->response_bytes.load(std::memory_order_relaxed));
+  }
+  out += "# TYPE dingo_sdk_rpc_error_total counter\n";
+  for (const auto& [method, metric] : rpcs) {
+    for (const auto& [errcode, count] : metric->errors.Snapshot()) {
+      out += fmt::format("dingo_sdk_rpc_error_total{{method=\"{}\",errno=\"{}\"}} {}\n", method, ErrnoName(errcode),
+                         count);
+    }
+  }
+
+  out += "# TYPE dingo_sdk_meta_cache_hit_total counter\n";
+  out += fmt::format("dingo_sdk_meta_cache_hit_total {}\n", meta_cache_hit_.load(std::memory_order_relaxed));
+  out += "# TYPE dingo_sdk_meta_cache_miss_total counter\n";
+  out += fmt::format("dingo_sdk_meta_cache_miss_total {}\n", meta_cache_miss_.load(std::memory_order_relaxed));
+
+  out += "# TYPE dingo_sdk_memory_budget_bytes gauge\n";
+  out += fmt::format("dingo_sdk_memory_budget_bytes {}\n", memory_budget_bytes_.load(std::memory_order_relaxed));
+  out += "# TYPE dingo_sdk_memory_budget_wait_total counter\n";
+  out += fmt::format("dingo_sdk_memory_budget_wait_total {}\n", memory_budget_wait_.load(std::memory_order_relaxed));
+  out += "# TYPE dingo_sdk_memory_budget_reject_total counter\n";
+  out += fmt::format("dingo_sdk_memory_budget_reject_total {}\n",
+                     memory_budget_reject_.load(std::memory_order_relaxed));
+  out += "# TYPE dingo_sdk_retry_budget_exhausted_total counter\n";
+  out += fmt::format("dingo_sdk_retry_budget_exhausted_total {}\n",
+                     retry_budget_exhausted_.load(std::memory_order_relaxed));
+
+  auto limits = ConcurrencyLimiter::Global().GetSnapshots();
+  if (!limits.empty()) {
+    out += "# TYPE dingo_sdk_store_concurrency_limit gauge\n";
+    for (const auto& [end_point, limit] : limits) {
+      out += fmt::format("dingo_sdk_store_concurrency_limit{{endpoint=\"{}\"}} {}\n", end_point.ToString(),
+                         limit.limit);
+    }
+    out += "# TYPE dingo_sdk_store_concurrency_in_flight gauge\n";
+    for (const auto& [end_point, limit] : limits) {
+      out += fmt::format("dingo_sdk_store_concurrency_in_flight{{endpoint=\"{}\"}} {}\n", end_point.ToString(),
+                         limit.in_flight);
+    }
+    out += "# TYPE dingo_sdk_store_concurrency_queued gauge\n";
+    for (const auto& [end_point, limit] : limits) {
+      out += fmt::format("dingo_sdk_store_concurrency_queued{{endpoint=\"{}\"}} {}\n", end_point.ToString(),
+                         limit.queued);
+    }
+    out += "# TYPE dingo_sdk_store_concurrency_rejected_total counter\n";
+    for (const auto& [end_point, limit] : limits) {
+      out += fmt::format("dingo_sdk_store_concurrency_rejected_total{{endpoint=\"{}\"}} {}\n",
+                         end_point.ToString(), limit.rejected);
+    }
+  }
+
+  auto hot_keys = HotSpotDetector::Global().GetHotKeys();
+  if (!hot_keys.empty()) {
+    out += "# TYPE dingo_sdk_hot_key_qps gauge\n";
+    for (const auto& hot_key : hot_keys) {
+      out += fmt::format("dingo_sdk_hot_key_qps{{key=\"{}\"}} {}\n", KeyLabel(hot_key.key), hot_key.qps);
+    }
+  }
+  auto hot_regions = HotSpotDetector::Global().GetHotRegions();
+  if (!hot_regions.empty()) {
+    out += "# TYPE dingo_sdk_hot_region_qps gauge\n";
+    for (const auto& hot_region : hot_regions) {
+      out += fmt::format("dingo_sdk_hot_region_qps{{region_id=\"{}\"}} {}\n", hot_region.region_id, hot_region.qps);
+    }
+  }
+
+  return out;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,207 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_COMMON_METRICS_H_
+#define DINGODB_SDK_COMMON_METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "sdk/common/param_config.h"
+#include "sdk/common/slow_log.h"
+#include "sdk/common/tracing.h"
+#include "sdk/rpc/rpc.h"
+#include "sdk/status.h"
+
+#ifndef USE_GRPC
+#include "bvar/latency_recorder.h"
+#endif
+
+namespace dingodb {
+namespace sdk {
+
+// histogram of non negative values in log2 buckets, bucket 0 holds 0 and bucket i holds [2^(i-1), 2^i)
+class MetricsHistogram {
+ public:
+  static constexpr int kBucketCount = 48;
+
+  void Record(int64_t value);
+
+  int64_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+  int64_t Sum() const { return sum_.load(std::memory_order_relaxed); }
+
+  // upper bound of the bucket holding the quantile, 0 when empty
+  int64_t Percentile(double quantile) const;
+
+ private:
+  std::array<std::atomic<int64_t>, kBucketCount> buckets_{};
+  std::atomic<int64_t> count_{0};
+  std::atomic<int64_t> sum_{0};
+};
+
+// error code to count, used on error path only
+class MetricsErrorCounter {
+ public:
+  void Add(int32_t errcode);
+
+  std::map<int32_t, int64_t> Snapshot() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<int32_t, int64_t> counts_;
+};
+
+struct TaskMetric {
+  explicit TaskMetric(const std::string& name);
+
+  MetricsHistogram latency_us;
+  // region or partition sub tasks of one run
+  MetricsHistogram fan_out;
+  std::atomic<int64_t> fail_count{0};
+  MetricsErrorCounter retries;
+
+#ifndef USE_GRPC
+  bvar::LatencyRecorder recorder;
+#endif
+};
+
+struct RpcMetric {
+  explicit RpcMetric(const std::string& method);
+
+  MetricsHistogram latency_us;
+  std::atomic<int64_t> request_bytes{0};
+  std::atomic<int64_t> response_bytes{0};
+  // response errno, kNetworkErrorCode when the rpc is not answered
+  MetricsErrorCounter errors;
+
+#ifndef USE_GRPC
+  bvar::LatencyRecorder recorder;
+#endif
+};
+
+// Process wide metrics of sdk tasks, rpcs and meta cache, shared by all clients of the process. Nothing is recorded
+// when FLAGS_enable_sdk_metrics is false. With brpc, latencies are also exposed as bvar named
+// dingo_sdk_task_<task> and dingo_sdk_rpc_<method>.
+class Metrics {
+ public:
+  static constexpr int32_t kNetworkErrorCode = -1;
+
+  Metrics(const Metrics&) = delete;
+  const Metrics& operator=(const Metrics&) = delete;
+
+  static Metrics& Global();
+
+  static int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // task_name is Name() of a task, the part from the first '-' (e.g. index id) is dropped
+  void RecordTask(const std::string& task_name, int64_t latency_us, const Status& status, int64_t fan_out);
+
+  void RecordTaskRetry(const std::string& task_name, int32_t errcode);
+
+  // errcode is the response errno or kNetworkErrorCode
+  void RecordRpc(const Rpc& rpc, int64_t latency_us, int32_t errcode);
+
+  void RecordMetaCacheHit(int64_t count) {
+    if (FLAGS_enable_sdk_metrics) {
+      meta_cache_hit_.fetch_add(count, std::memory_order_relaxed);
+    }
+  }
+
+  void RecordMetaCacheMiss(int64_t count) {
+    if (FLAGS_enable_sdk_metrics) {
+      meta_cache_miss_.fetch_add(count, std::memory_order_relaxed);
+    }
+  }
+
+  // bytes charged to memory budgets of all clients, see MemoryBudget. kept even when metrics is disabled, so the
+  // gauge stays right when metrics is enabled later
+  void RecordMemoryBudgetCharge(int64_t delta) { memory_budget_bytes_.fetch_add(delta, std::memory_order_relaxed); }
+
+  // a store rpc waits for memory budget, rejected means it fails after the wait
+  void RecordMemoryBudgetWait(bool rejected) {
+    if (FLAGS_enable_sdk_metrics) {
+      (rejected ? memory_budget_reject_ : memory_budget_wait_).fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // a retry is given up because the retry budget of its client is exhausted, see RetryBudget
+  void RecordRetryBudgetExhausted() {
+    if (FLAGS_enable_sdk_metrics) {
+      retry_budget_exhausted_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // all metrics in prometheus text exposition format
+  std::string Dump() const;
+
+  // never freed, nullptr when metrics is disabled
+  TaskMetric* GetTaskMetric(const std::string& task_name);
+
+  RpcMetric* GetRpcMetric(const std::string& method);
+
+ private:
+  Metrics() = default;
+
+  mutable std::shared_mutex rw_lock_;
+  std::unordered_map<std::string, std::unique_ptr<TaskMetric>> tasks_;
+  std::unordered_map<std::string, std::unique_ptr<RpcMetric>> rpcs_;
+
+  std::atomic<int64_t> meta_cache_hit_{0};
+  std::atomic<int64_t> meta_cache_miss_{0};
+  std::atomic<int64_t> memory_budget_bytes_{0};
+  std::atomic<int64_t> memory_budget_wait_{0};
+  std::atomic<int64_t> memory_budget_reject_{0};
+  std::atomic<int64_t> retry_budget_exhausted_{0};
+};
+
+// run func as a task named name and record it in metrics, tracing and slow log, used by operations not run as a
+// task class, e.g. txn phases
+template <class Func>
+Status RecordAsTask(const std::string& name, Func&& func) {
+  int64_t start_us = Metrics::NowUs();
+  Span span = Tracer::Global().StartSpan(name, Tracer::CurrentContext());
+  bool slow_log_root = false;
+  std::shared_ptr<SlowLogRecorder> slow_log = SlowLog::Join(slow_log_root);
+  Status s;
+  {
+    ScopedSpanContext span_scope(span.Context());
+    ScopedSlowLogRecorder slow_log_scope(slow_log);
+    s = func();
+  }
+  span.SetStatus(s);
+  int64_t latency_us = Metrics::NowUs() - start_us;
+  Metrics::Global().RecordTask(name, latency_us, s, 0);
+  if (slow_log_root) {
+    SlowLog::Global().Finish(name, *slow_log, latency_us, s);
+  }
+  return s;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_COMMON_METRICS_H_
@@ -17,36 +17,266 @@
 
 // sdk config
 DEFINE_int64(actuator_thread_num, 8, "actuator thread num");
+DEFINE_string(actuator_thread_pool_mode, "fifo",
+              "actuator thread pool mode, fifo: one shared queue, work_stealing: per worker deque with stealing");
+DEFINE_int64(actuator_interactive_reserved_threads, 1,
+             "actuator threads batch and background tasks never occupy, see RequestPriority");
+DEFINE_string(actuator_backend, "thread_pool",
+              "actuator backend, thread_pool: own threads, bthread: bthreads of the process, only in brpc builds");
+DEFINE_int64(background_actuator_thread_num, 4,
+             "threads per client for work waiting on rpcs, e.g. sync parts of async txn apis, kept off the actuator "
+             "whose threads run rpc callbacks and retries");
+DEFINE_string(sdk_thread_cpus, "",
+              "cpu list like 0-7,16 sdk threads are pinned to, caller means cpus of the thread building client, "
+              "empty means no pin");
+DEFINE_bool(sdk_thread_pin_per_core, false, "pin each sdk thread to one cpu of sdk_thread_cpus instead of all");
+DEFINE_int64(sdk_sync_wait_spin_us, 0,
+             "rpc caller spins us before sleep waiting for callback, fast completions skip wake up, 0 means no spin");
 
 // coordinator config
 DEFINE_int64(coordinator_interaction_delay_ms, 500, "coordinator interaction delay ms");
 DEFINE_int64(coordinator_interaction_max_retry, 30, "coordinator interaction max retry");
+DEFINE_bool(coordinator_rpc_coalesce, true,
+            "concurrent identical ScanRegions and GetIndex coordinator rpcs share one rpc in flight");
 DEFINE_int64(auto_incre_req_count, 1000, "raw kv max retry times");
+DEFINE_bool(auto_incre_prefetch, false, "prefetch next auto increment id range in background before cache runs out");
+DEFINE_int64(auto_incre_max_req_count, 100000, "max auto increment id count of one request when prefetch adapts");
+DEFINE_bool(auto_incre_prewarm, false, "fetch first auto increment id range in background when index is resolved");
+DEFINE_int64(tso_batch_max_size, 256, "max tso timestamps requested by one coordinator rpc");
+DEFINE_int64(tso_batch_wait_us, 0, "tso batch leader wait us for concurrent requests before send rpc, 0 means no wait");
+DEFINE_string(meta_cache_warmup_key_prefixes, "",
+              "comma separated key prefixes whose region routes are loaded into meta cache when client build");
+DEFINE_string(meta_cache_warmup_vector_index_ids, "",
+              "comma separated vector index ids whose region routes are loaded into meta cache when client build");
+DEFINE_string(meta_cache_warmup_document_index_ids, "",
+              "comma separated document index ids whose region routes are loaded into meta cache when client build");
+DEFINE_int64(meta_cache_refresh_interval_s, 0, "reload meta cache warmup ranges every seconds, 0 means disable");
+DEFINE_int64(meta_cache_watch_interval_ms, 0,
+             "re-scan ranges of cached regions from coordinator every ms to apply region changes, 0 means disable");
+DEFINE_int64(coordinator_member_refresh_interval_ms, 0,
+             "reload coordinator members from naming service or coordinator map every ms, 0 means disable");
+DEFINE_string(meta_cache_snapshot_path, "",
+              "file to load meta cache from when client build and save it to when client destroy, empty means disable");
+DEFINE_int64(index_cache_negative_ttl_ms, 0,
+             "remember vector and document index not found in coordinator for ms, 0 means disable");
+DEFINE_int64(index_cache_refresh_interval_s, 0,
+             "reload cached vector and document index definitions every seconds, 0 means disable");
 
 // ChannelOptions should set "timeout_ms > connect_timeout_ms" for circuit breaker
 DEFINE_int64(rpc_channel_timeout_ms, 500000, "rpc channel timeout ms");
 DEFINE_int64(rpc_channel_connect_timeout_ms, 3000, "rpc channel connect timeout ms");
+DEFINE_string(store_rpc_backend, "",
+              "rpc backend of store rpcs, brpc or grpc, empty is the backend sdk is built with, read by Client::Build");
+DEFINE_string(coordinator_rpc_backend, "", "rpc backend of coordinator rpcs, same values as store_rpc_backend");
 
 // only used for grpc
 DEFINE_int64(grpc_poll_thread_num, 32, "grpc poll cq thread num");
+DEFINE_bool(grpc_cq_affinity, false, "each caller thread always send grpc rpc with the same completion queue");
+DEFINE_int64(grpc_parse_thread_num, 0,
+             "threads deserializing large grpc responses off the cq threads, 0 means parse on the cq thread");
+DEFINE_int64(grpc_parse_offload_min_bytes, 1048576, "grpc responses smaller than this are parsed on the cq thread");
+DEFINE_string(grpc_parse_offload_methods, "VectorSearch,VectorBatchQuery",
+              "comma separated rpcs whose responses are parsed off the cq threads when grpc_parse_thread_num > 0");
+
+// only used for brpc
+DEFINE_string(brpc_connection_type, "single", "brpc channel connection type, single, pooled or short");
+DEFINE_int64(brpc_channels_per_endpoint, 1, "brpc channels created for one store endpoint, rpcs pick one round robin");
+DEFINE_bool(brpc_use_rdma, false, "brpc store channels use rdma, brpc must be built with rdma");
+
+DEFINE_string(rpc_local_unix_socket_path, "",
+              "unix socket path of a store on this host, {port} is replaced by the store port, e.g. "
+              "/var/run/dingo/store-{port}.sock, channels to a local store use it when the socket exists");
 
 DEFINE_int64(rpc_max_retry, 3, "rpc call max retry times");
 DEFINE_int64(rpc_time_out_ms, 500000, "rpc call timeout ms");
 
-DEFINE_int64(store_rpc_retry_delay_ms, 500, "store rpc retry delay ms");
+DEFINE_string(rpc_compress_type, "none", "store rpc request compress type, none, snappy, zstd or lz4");
+DEFINE_int64(rpc_compress_min_bytes, 4096, "store rpc requests smaller than this are not compressed");
+DEFINE_string(rpc_compress_methods, "",
+              "per method store rpc compress policy overriding rpc_compress_type, comma separated "
+              "method:type[:min_bytes], e.g. VectorAdd:lz4,DocumentAdd:zstd:65536");
+
+DEFINE_int64(rpc_pool_max_size, 256,
+             "max free rpcs kept per rpc type, their request and response are cleared and reused by batch "
+             "operations instead of allocated again, 0 disables the pool");
+
+DEFINE_int64(store_rpc_retry_delay_ms, 500, "store rpc base retry delay ms when region no leader");
+DEFINE_int64(store_rpc_request_full_retry_delay_ms, 50, "store rpc base retry delay ms when store request full");
+DEFINE_int64(store_rpc_retry_max_delay_ms, 5000, "store rpc max retry delay ms, cap of exponential backoff");
 DEFINE_int64(store_rpc_max_retry, 30, "store rpc max retry times, use case: wrong leader or request range invalid");
+DEFINE_bool(store_rpc_hedge, false,
+            "replica read rpc not answered within the endpoint p95 latency is duplicated to another replica");
+DEFINE_int64(store_rpc_hedge_min_delay_ms, 1, "min delay ms before a hedged store rpc is sent");
+DEFINE_int64(store_rpc_replica_max_error_percent, 50,
+             "replica whose recent error percent is above this is avoided by latency aware read");
+DEFINE_bool(store_rpc_concurrency_limit, false,
+            "limit in flight store rpcs of each store endpoint by an aimd adaptive limit, see ConcurrencyLimiter");
+DEFINE_int64(store_rpc_concurrency_initial_limit, 64, "initial in flight store rpcs limit of one store endpoint");
+DEFINE_int64(store_rpc_concurrency_min_limit, 4, "min in flight store rpcs limit of one store endpoint");
+DEFINE_int64(store_rpc_concurrency_max_limit, 1024, "max in flight store rpcs limit of one store endpoint");
+DEFINE_double(store_rpc_concurrency_backoff_ratio, 0.9, "limit is multiplied by this when a store is overloaded");
+DEFINE_int64(store_rpc_concurrency_slow_ms, 0,
+             "store rpc slower than this is taken as overload of the store, 0 means only errors are");
+DEFINE_int64(store_rpc_concurrency_queue_size, 1024,
+             "max store rpcs waiting for the limit of one store endpoint, more fail fast, 0 means always fail fast");
+DEFINE_int64(store_rpc_concurrency_interactive_reserve_percent, 10,
+             "percent of the limit of one store endpoint batch and background rpcs never take, see RequestPriority");
+DEFINE_int64(store_rpc_breaker_failures, 0,
+             "consecutive no leader or network failures of a region that open its breaker, 0 means disabled");
+DEFINE_int64(store_rpc_breaker_open_ms, 1000,
+             "store rpcs of a region with open breaker fail fast for this long, then a single probe is sent");
+DEFINE_int64(store_rpc_breaker_max_wait_ms, 0,
+             "store rpc waits for an open breaker instead of failing fast when it will be probed within this");
+
+DEFINE_bool(store_write_rate_limit, false,
+            "pace bulk writes, e.g. vector add and raw kv batch put, by AIMD bytes rate per region and per index");
+DEFINE_int64(store_write_rate_initial_bytes, 32 * 1024 * 1024, "initial write bytes per second of a region or index");
+DEFINE_int64(store_write_rate_min_bytes, 1024 * 1024, "min write bytes per second of a region or index");
+DEFINE_int64(store_write_rate_max_bytes, 1024 * 1024 * 1024, "max write bytes per second of a region or index");
+DEFINE_int64(store_write_rate_increase_bytes, 1024 * 1024, "write rate grows by this per answered write rpc");
+DEFINE_double(store_write_rate_backoff_ratio, 0.7, "write rate is multiplied by this when a store is overloaded");
+DEFINE_int64(store_write_rate_slow_ms, 1000, "write rpc slower than ms means its store is overloaded, 0 means never");
+DEFINE_int64(store_write_rate_burst_ms, 100, "unused write rate of at most ms is saved up for a burst");
+
+DEFINE_int64(sdk_memory_budget_bytes, 1024 * 1024 * 1024,
+             "max bytes of requests and responses held by store rpcs in flight of a client, 0 means no limit");
+DEFINE_int64(sdk_memory_budget_max_wait_ms, 1000,
+             "store rpc waits at most ms for memory budget before fail, 0 means fail fast");
+DEFINE_int64(sdk_memory_budget_retry_ms, 10, "store rpc waiting for memory budget checks it again after ms");
+
+DEFINE_bool(sdk_retry_budget, false,
+            "cap retries of store rpcs and tasks of a client by a shared budget, reroutes are not capped");
+DEFINE_double(sdk_retry_budget_ratio, 0.1, "retry tokens deposited by every store rpc call");
+DEFINE_int64(sdk_retry_budget_min_per_second, 10, "retry tokens added per second regardless of requests");
+DEFINE_int64(sdk_retry_budget_max_tokens, 100, "max retry tokens saved up, a new client starts with them");
+
+DEFINE_int64(store_connection_probe_interval_ms, 0,
+             "connect and probe store endpoints of cached regions every ms, avoid down ones, 0 means disable");
+DEFINE_int64(store_connection_probe_timeout_ms, 1000, "store endpoint not answer health probe within ms is down");
 
 DEFINE_int64(scan_batch_size, 1000, "scan batch size, use for region scanner");
+DEFINE_int64(scan_batch_max_size, 10000, "max rows of one region scanner batch");
+DEFINE_int64(scan_batch_max_bytes, 4 * 1024 * 1024,
+             "byte budget of one region scanner batch, rows of a batch follow the average row size to fit it");
+DEFINE_bool(scan_batch_adaptive, true, "region scanner batch rows adapt to observed row size");
+DEFINE_bool(scan_prefetch, false, "region scanner fetches the next batch when a batch is returned");
+DEFINE_bool(scan_prefetch_next_region, false,
+            "scan iterator opens the scanner of the next region while the current region is scanned");
 
 DEFINE_int64(txn_op_delay_ms, 200, "txn op delay ms");
 DEFINE_int64(txn_op_max_retry, 2, "txn op max retry times");
 
 DEFINE_int64(raw_kv_delay_ms, 500, "raw kv backoff delay ms");
 DEFINE_int64(raw_kv_max_retry, 10, "raw kv max retry times");
+DEFINE_bool(raw_kv_get_single_flight, false,
+            "concurrent raw kv get of the same key share one in flight rpc, follower may see a value read before it "
+            "started");
+DEFINE_bool(raw_kv_auto_batch, false, "collect concurrent single key raw kv put and get into batch rpc");
+DEFINE_int64(raw_kv_auto_batch_max_delay_us, 200, "raw kv auto batch max us the leader wait for batch to fill");
+DEFINE_int64(raw_kv_auto_batch_max_size, 128, "raw kv auto batch max ops in one batch");
+DEFINE_int64(raw_kv_auto_batch_max_inflight, 4, "raw kv auto batch max batches of put or get in flight");
+DEFINE_int64(raw_kv_read_cache_capacity, 0, "raw kv get value cache capacity, 0 means disable");
+DEFINE_int64(raw_kv_read_cache_ttl_ms, 1000, "raw kv get value cache entry ttl ms");
+DEFINE_int64(raw_kv_scan_parallelism, 1,
+             "raw kv scan max concurrent region scanners, 1 means scan regions one by one");
+DEFINE_int64(raw_kv_count_parallelism, 8, "raw kv count range max concurrent key only region scanners");
+DEFINE_int64(raw_kv_delete_range_parallelism, 16, "raw kv delete range max concurrent region delete rpcs");
+DEFINE_int64(raw_kv_bulk_load_sort_bytes, 64 * 1024 * 1024, "raw kv bulk loader bytes of kvs sorted and cut at once");
+DEFINE_int64(raw_kv_bulk_load_chunk_bytes, 4 * 1024 * 1024, "raw kv bulk loader max bytes of one chunk");
+DEFINE_int64(raw_kv_bulk_load_max_inflight_bytes, 256 * 1024 * 1024,
+             "raw kv bulk loader max bytes of chunks in flight, add blocks beyond it");
 
 DEFINE_int64(vector_op_delay_ms, 500, "vector task base backoff delay ms");
 DEFINE_int64(vector_op_max_retry, 30, "vector task max retry times");
+DEFINE_bool(enable_partition_region_cache, true,
+            "cache regions of vector and document index partitions, dropped once any of them is stale");
+DEFINE_bool(vector_search_use_arena, true, "allocate vector search rpc request and response on protobuf arena");
+DEFINE_bool(vector_search_hedge, false, "send backup vector search rpc to another replica when a region is slow");
+DEFINE_int64(vector_search_hedge_delay_ms, 0,
+             "fixed delay ms before backup vector search rpc, 0 means use observed region latency percentile");
+DEFINE_int64(vector_search_hedge_percentile, 95, "region vector search latency percentile to send backup rpc");
+DEFINE_bool(vector_search_two_phase_fetch, false,
+            "vector search without payload first, then batch query vector and scalar data of final topk only");
+DEFINE_bool(vector_search_exact_rerank, false,
+            "re-rank ivf pq search results by exact distance computed on client when vector data is requested");
+DEFINE_int64(vector_search_rerank_factor, 2, "vector search keeps topk * factor candidates for exact re-rank");
+DEFINE_int64(vector_search_cache_capacity_bytes, 0, "vector search result cache capacity bytes, 0 means disable");
+DEFINE_int64(vector_search_cache_ttl_ms, 1000, "vector search result cache entry ttl ms");
+DEFINE_int64(vector_search_cursor_ttl_ms, 60000,
+             "ms merged hits of a vector search cursor are kept, later pages search again");
+DEFINE_string(vector_payload_cache_dir, "", "dir of local vector data cache files, empty means disable");
+DEFINE_int64(vector_payload_cache_capacity, 0, "max vectors of each index in local vector data cache, 0 means disable");
+DEFINE_int64(langchain_expr_cache_capacity, 1024,
+             "max langchain filter expressions cached with their compiled coprocessor, 0 means disable");
+DEFINE_int64(vector_search_batch_max_count, 0,
+             "max target vectors in one region vector search rpc, 0 means send all target vectors in one rpc");
+DEFINE_int64(vector_search_batch_max_bytes, 0,
+             "max encoded bytes of target vectors in one region vector search rpc, 0 means no limit");
+DEFINE_int64(vector_search_client_exact_max_ids, 0,
+             "vector search restricted to at most this many vector ids queries them and computes exact topk on "
+             "client instead of searching every region, 0 means disable");
+DEFINE_double(vector_search_auto_filter_pre_max_selectivity, 0.05,
+              "auto filter type picks pre filter when estimated fraction of vectors matching filter is not above this");
+DEFINE_int64(vector_search_auto_filter_max_recall_num, 10000,
+             "max recall_num auto filter type asks post filter for, topk / selectivity candidates otherwise");
+DEFINE_int64(vector_write_batch_max_bytes, 0,
+             "max encoded bytes of vectors or ids in one region vector update/delete rpc, 0 means no limit");
+DEFINE_int64(vector_delete_range_page_size, 1000,
+             "vector delete by range and by filter scans and deletes this many ids each round");
+DEFINE_int64(vector_region_rpc_concurrency, 64,
+             "max in flight region rpcs of one partition in vector count, get border and get index metrics, and max "
+             "regions at once of vector delete by filter, 0 means no limit");
+DEFINE_int64(vector_writer_chunk_bytes, 4 * 1024 * 1024, "vector writer approximate bytes of one write chunk");
+DEFINE_int64(vector_writer_max_inflight_bytes, 64 * 1024 * 1024, "vector writer max bytes of chunks in flight");
+DEFINE_int64(vector_update_buffer_window_ms, 100, "vector update buffer max ms a write is pending before sent");
+DEFINE_int64(vector_update_buffer_max_pending, 10000,
+             "vector update buffer max pending vector ids, writers block beyond it while a batch is in flight");
+DEFINE_int64(document_writer_chunk_bytes, 4 * 1024 * 1024, "document writer approximate bytes of one write chunk");
+DEFINE_int64(document_writer_max_inflight_bytes, 64 * 1024 * 1024, "document writer max bytes of chunks in flight");
+DEFINE_int64(document_region_rpc_concurrency, 64,
+             "max in flight region rpcs of one partition in document get index metrics, 0 means no limit");
+DEFINE_int64(index_metrics_cache_ttl_ms, 5000,
+             "vector and document index metrics older than this are never served to callers accepting stale metrics, "
+             "0 to disable");
 
 DEFINE_int64(txn_max_batch_count, 1000, "txn max batch count");
+DEFINE_bool(txn_async_commit_secondary, false,
+            "commit secondary keys in background, txn commit return once primary key committed");
+DEFINE_int64(txn_secondary_commit_concurrency, 16, "max in flight rpcs when commit secondary keys in background");
+DEFINE_bool(txn_single_region_fast_commit, false,
+            "when all txn mutations are in one region, prewrite and commit all keys with one rpc each");
+DEFINE_int64(txn_status_cache_capacity, 10240,
+             "max committed or rollbacked txn status cached by lock resolver, 0 means disable cache");
+DEFINE_int64(txn_heartbeat_interval_ms, 0,
+             "interval ms to extend txn primary lock ttl, 0 means no heartbeat and lock never expire");
+DEFINE_int64(txn_heartbeat_lock_ttl_ms, 20000,
+             "txn lock ttl ms from now, used when txn heartbeat is enabled, must be greater than heartbeat interval");
+DEFINE_int64(txn_pessimistic_lock_wait_timeout_ms, 3000,
+             "max ms a pessimistic lock waits for conflicting locks of other txns before fail");
+DEFINE_int64(txn_pessimistic_lock_backoff_ms, 10,
+             "first delay ms to resend pessimistic lock which meet alive lock, doubled up to txn_op_delay_ms");
+DEFINE_int64(txn_buffer_memory_limit_bytes, 0,
+             "max bytes of txn mutations kept in memory, the rest are spilled to a temp file, 0 means no limit");
+DEFINE_string(txn_buffer_spill_dir, "/tmp", "dir of temp files for spilled txn mutations");
+DEFINE_int64(txn_read_cache_max_keys, 4096,
+             "max keys read from store cached in a snapshot isolation txn, including not found ones, 0 to disable");
+DEFINE_int64(txn_pipelined_flush_bytes, 4 * 1024 * 1024,
+             "bytes written to pipelined txn which trigger a background prewrite of them");
+DEFINE_int64(txn_lock_sweep_parallelism, 8, "max regions swept concurrently by Client::ResolveStaleLocks");
+DEFINE_int64(txn_lock_sweep_batch_size, 1024, "max locks scanned and resolved at once in a region when sweep locks");
 
 DEFINE_bool(log_rpc_time, false, "log rpc time");
+DEFINE_bool(enable_sdk_metrics, true,
+            "record latency, retry, fan out and bytes of sdk tasks and rpcs, see Client::GetMetrics");
+DEFINE_bool(enable_sdk_tracing, false, "record spans of sdk tasks, retries, store rpcs and meta cache lookups");
+DEFINE_double(sdk_trace_sample_ratio, 1.0, "ratio of sdk calls traced when tracing is enabled");
+DEFINE_int64(sdk_trace_max_spans, 10000, "max finished spans kept until exported, the oldest are dropped");
+DEFINE_string(sdk_trace_service_name, "dingo-sdk", "service.name resource attribute of exported spans");
+DEFINE_int64(slow_log_threshold_ms, 0,
+             "record requests slower than this with their store rpcs, see Client::GetSlowLog, 0 means disable");
+DEFINE_int64(slow_log_capacity, 256, "max slow requests kept, the oldest are dropped");
+DEFINE_int64(slow_log_max_rpcs, 256, "max store rpcs kept per slow request, the others are only counted");
+DEFINE_int64(sdk_hot_spot_sample_rate, 64,
+             "sample one of every n key lookups and store rpcs of a thread for hot spots, 0 means disable");
+DEFINE_int64(sdk_hot_spot_window_ms, 10000, "hot keys and regions are reported for windows of ms");
+DEFINE_int64(sdk_hot_spot_top_k, 10, "max hot keys and hot regions reported");
@@ -24,44 +24,198 @@
 // sdk config
 const int64_t kSdkVlogLevel = 60;
 DECLARE_int64(actuator_thread_num);
+DECLARE_string(actuator_thread_pool_mode);
+DECLARE_int64(actuator_interactive_reserved_threads);
+DECLARE_string(actuator_backend);
+DECLARE_int64(background_actuator_thread_num);
+DECLARE_string(sdk_thread_cpus);
+DECLARE_bool(sdk_thread_pin_per_core);
+DECLARE_int64(sdk_sync_wait_spin_us);
 
 // coordinator config
 const int64_t kPrefetchRegionCount = 3;
 DECLARE_int64(coordinator_interaction_delay_ms);
 DECLARE_int64(coordinator_interaction_max_retry);
+DECLARE_bool(coordinator_rpc_coalesce);
 DECLARE_int64(auto_incre_req_count);
+DECLARE_bool(auto_incre_prefetch);
+DECLARE_int64(auto_incre_max_req_count);
+DECLARE_bool(auto_incre_prewarm);
+DECLARE_int64(tso_batch_max_size);
+DECLARE_int64(tso_batch_wait_us);
+DECLARE_string(meta_cache_warmup_key_prefixes);
+DECLARE_string(meta_cache_warmup_vector_index_ids);
+DECLARE_string(meta_cache_warmup_document_index_ids);
+DECLARE_int64(meta_cache_refresh_interval_s);
+DECLARE_int64(meta_cache_watch_interval_ms);
+DECLARE_int64(coordinator_member_refresh_interval_ms);
+DECLARE_string(meta_cache_snapshot_path);
+DECLARE_int64(index_cache_negative_ttl_ms);
+DECLARE_int64(index_cache_refresh_interval_s);
 
 // store config
 // ChannelOptions should set "timeout_ms > connect_timeout_ms" for circuit breaker
 DECLARE_int64(rpc_channel_timeout_ms);
 DECLARE_int64(rpc_channel_connect_timeout_ms);
+DECLARE_string(store_rpc_backend);
+DECLARE_string(coordinator_rpc_backend);
 
 // each rpc call params, set for brpc::Controller
 DECLARE_int64(rpc_max_retry);
 DECLARE_int64(rpc_time_out_ms);
 
+// store rpc request compression, see RpcCompressOptions
+DECLARE_string(rpc_compress_type);
+DECLARE_int64(rpc_compress_min_bytes);
+DECLARE_string(rpc_compress_methods);
+
+// free rpcs kept per rpc type for reuse, see RpcPool
+DECLARE_int64(rpc_pool_max_size);
+
 DECLARE_int64(grpc_poll_thread_num);
+DECLARE_bool(grpc_cq_affinity);
+DECLARE_int64(grpc_parse_thread_num);
+DECLARE_int64(grpc_parse_offload_min_bytes);
+DECLARE_string(grpc_parse_offload_methods);
+
+// only used for brpc
+DECLARE_string(brpc_connection_type);
+DECLARE_int64(brpc_channels_per_endpoint);
+DECLARE_bool(brpc_use_rdma);
+
+// see LocalTransportAddress
+DECLARE_string(rpc_local_unix_socket_path);
 
 // each store rpc params, used for store rpc controller
 DECLARE_int64(store_rpc_max_retry);
 DECLARE_int64(store_rpc_retry_delay_ms);
+DECLARE_int64(store_rpc_request_full_retry_delay_ms);
+DECLARE_int64(store_rpc_retry_max_delay_ms);
+DECLARE_bool(store_rpc_hedge);
+DECLARE_int64(store_rpc_hedge_min_delay_ms);
+DECLARE_int64(store_rpc_replica_max_error_percent);
+DECLARE_bool(store_rpc_concurrency_limit);
+DECLARE_int64(store_rpc_concurrency_initial_limit);
+DECLARE_int64(store_rpc_concurrency_min_limit);
+DECLARE_int64(store_rpc_concurrency_max_limit);
+DECLARE_double(store_rpc_concurrency_backoff_ratio);
+DECLARE_int64(store_rpc_concurrency_slow_ms);
+DECLARE_int64(store_rpc_concurrency_queue_size);
+DECLARE_int64(store_rpc_concurrency_interactive_reserve_percent);
+
+DECLARE_int64(store_rpc_breaker_failures);
+DECLARE_int64(store_rpc_breaker_open_ms);
+DECLARE_int64(store_rpc_breaker_max_wait_ms);
+
+DECLARE_bool(store_write_rate_limit);
+DECLARE_int64(store_write_rate_initial_bytes);
+DECLARE_int64(store_write_rate_min_bytes);
+DECLARE_int64(store_write_rate_max_bytes);
+DECLARE_int64(store_write_rate_increase_bytes);
+DECLARE_double(store_write_rate_backoff_ratio);
+DECLARE_int64(store_write_rate_slow_ms);
+DECLARE_int64(store_write_rate_burst_ms);
+
+DECLARE_int64(sdk_memory_budget_bytes);
+DECLARE_int64(sdk_memory_budget_max_wait_ms);
+DECLARE_int64(sdk_memory_budget_retry_ms);
+
+DECLARE_bool(sdk_retry_budget);
+DECLARE_double(sdk_retry_budget_ratio);
+DECLARE_int64(sdk_retry_budget_min_per_second);
+DECLARE_int64(sdk_retry_budget_max_tokens);
+
+DECLARE_int64(store_connection_probe_interval_ms);
+DECLARE_int64(store_connection_probe_timeout_ms);
 
 // start: use for region scanner
 DECLARE_int64(scan_batch_size);
+DECLARE_int64(scan_batch_max_size);
+DECLARE_int64(scan_batch_max_bytes);
+DECLARE_bool(scan_batch_adaptive);
+DECLARE_bool(scan_prefetch);
+DECLARE_bool(scan_prefetch_next_region);
 const int64_t kMinScanBatchSize = 1;
-const int64_t kMaxScanBatchSize = 100;
 // end: use for region scanner
 
 DECLARE_int64(raw_kv_delay_ms);
 DECLARE_int64(raw_kv_max_retry);
+DECLARE_bool(raw_kv_get_single_flight);
+DECLARE_bool(raw_kv_auto_batch);
+DECLARE_int64(raw_kv_auto_batch_max_delay_us);
+DECLARE_int64(raw_kv_auto_batch_max_size);
+DECLARE_int64(raw_kv_auto_batch_max_inflight);
+DECLARE_int64(raw_kv_read_cache_capacity);
+DECLARE_int64(raw_kv_read_cache_ttl_ms);
+DECLARE_int64(raw_kv_scan_parallelism);
+DECLARE_int64(raw_kv_count_parallelism);
+DECLARE_int64(raw_kv_delete_range_parallelism);
+DECLARE_int64(raw_kv_bulk_load_sort_bytes);
+DECLARE_int64(raw_kv_bulk_load_chunk_bytes);
+DECLARE_int64(raw_kv_bulk_load_max_inflight_bytes);
 
 DECLARE_int64(txn_op_delay_ms);
 DECLARE_int64(txn_op_max_retry);
 
 DECLARE_int64(vector_op_delay_ms);
 DECLARE_int64(vector_op_max_retry);
+DECLARE_bool(enable_partition_region_cache);
+DECLARE_bool(vector_search_use_arena);
+DECLARE_bool(vector_search_hedge);
+DECLARE_int64(vector_search_hedge_delay_ms);
+DECLARE_int64(vector_search_hedge_percentile);
+DECLARE_bool(vector_search_two_phase_fetch);
+DECLARE_bool(vector_search_exact_rerank);
+DECLARE_int64(vector_search_rerank_factor);
+DECLARE_int64(vector_search_cache_capacity_bytes);
+DECLARE_int64(vector_search_cache_ttl_ms);
+DECLARE_int64(vector_search_cursor_ttl_ms);
+DECLARE_string(vector_payload_cache_dir);
+DECLARE_int64(vector_payload_cache_capacity);
+DECLARE_int64(langchain_expr_cache_capacity);
+DECLARE_int64(vector_search_batch_max_count);
+DECLARE_int64(vector_search_batch_max_bytes);
+DECLARE_int64(vector_search_client_exact_max_ids);
+DECLARE_double(vector_search_auto_filter_pre_max_selectivity);
+DECLARE_int64(vector_search_auto_filter_max_recall_num);
+DECLARE_int64(vector_write_batch_max_bytes);
+DECLARE_int64(vector_delete_range_page_size);
+DECLARE_int64(vector_region_rpc_concurrency);
+DECLARE_int64(vector_writer_chunk_bytes);
+DECLARE_int64(vector_writer_max_inflight_bytes);
+DECLARE_int64(vector_update_buffer_window_ms);
+DECLARE_int64(vector_update_buffer_max_pending);
+DECLARE_int64(document_writer_chunk_bytes);
+DECLARE_int64(document_writer_max_inflight_bytes);
+DECLARE_int64(document_region_rpc_concurrency);
+DECLARE_int64(index_metrics_cache_ttl_ms);
 
 DECLARE_int64(txn_max_batch_count);
+DECLARE_bool(txn_async_commit_secondary);
+DECLARE_int64(txn_secondary_commit_concurrency);
+DECLARE_bool(txn_single_region_fast_commit);
+DECLARE_int64(txn_status_cache_capacity);
+DECLARE_int64(txn_heartbeat_interval_ms);
+DECLARE_int64(txn_heartbeat_lock_ttl_ms);
+DECLARE_int64(txn_pessimistic_lock_wait_timeout_ms);
+DECLARE_int64(txn_pessimistic_lock_backoff_ms);
+DECLARE_int64(txn_buffer_memory_limit_bytes);
+DECLARE_string(txn_buffer_spill_dir);
+DECLARE_int64(txn_read_cache_max_keys);
+DECLARE_int64(txn_pipelined_flush_bytes);
+DECLARE_int64(txn_lock_sweep_parallelism);
+DECLARE_int64(txn_lock_sweep_batch_size);
 DECLARE_bool(log_rpc_time);
+DECLARE_bool(enable_sdk_metrics);
+DECLARE_bool(enable_sdk_tracing);
+DECLARE_double(sdk_trace_sample_ratio);
+DECLARE_int64(sdk_trace_max_spans);
+DECLARE_string(sdk_trace_service_name);
+DECLARE_int64(slow_log_threshold_ms);
+DECLARE_int64(slow_log_capacity);
+DECLARE_int64(slow_log_max_rpcs);
+DECLARE_int64(sdk_hot_spot_sample_rate);
+DECLARE_int64(sdk_hot_spot_window_ms);
+DECLARE_int64(sdk_hot_spot_top_k);
 
 #endif  // DINGODB_SDK_PARAM_CONFIG_H_
\ No newline at end of file
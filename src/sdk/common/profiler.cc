@@ -0,0 +1,160 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/profiler.h"
+
+#include <dlfcn.h>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+template <class Func>
+Func LookupSymbol(const char* name) {
+  return reinterpret_cast<Func>(dlsym(RTLD_DEFAULT, name));
+}
+}  // namespace
+
+Profiler::Profiler() {
+  profiler_start_ = LookupSymbol<ProfilerStartFunc>("ProfilerStart");
+  profiler_stop_ = LookupSymbol<ProfilerStopFunc>("ProfilerStop");
+  heap_profiler_start_ = LookupSymbol<HeapProfilerStartFunc>("HeapProfilerStart");
+  heap_profiler_stop_ = LookupSymbol<HeapProfilerStopFunc>("HeapProfilerStop");
+  heap_profiler_dump_ = LookupSymbol<HeapProfilerDumpFunc>("HeapProfilerDump");
+  mallctl_ = LookupSymbol<MallctlFunc>("mallctl");
+}
+
+bool Profiler::HasGperftoolsHeapProfiler() const {
+  return heap_profiler_start_ != nullptr && heap_profiler_stop_ != nullptr && heap_profiler_dump_ != nullptr;
+}
+
+Profiler& Profiler::Global() {
+  static Profiler profiler;
+  return profiler;
+}
+
+Status Profiler::StartCpuProfile(const std::string& file) {
+  std::lock_guard lock(mutex_);
+  if (profiler_start_ == nullptr || profiler_stop_ == nullptr) {
+    return Status::NotSupported("cpu profiler not loaded, link or LD_PRELOAD libprofiler");
+  }
+  if (cpu_profiling_) {
+    return Status::IllegalState("cpu profile already started");
+  }
+  if (profiler_start_(file.c_str()) == 0) {
+    return Status::IOError(fmt::format("start cpu profile to {} failed", file));
+  }
+
+  cpu_profiling_ = true;
+  DINGO_LOG(INFO) << fmt::format("cpu profile started, file:{}", file);
+  return Status::OK();
+}
+
+Status Profiler::StopCpuProfile() {
+  std::lock_guard lock(mutex_);
+  if (!cpu_profiling_) {
+    return Status::IllegalState("cpu profile not started");
+  }
+
+  profiler_stop_();
+  cpu_profiling_ = false;
+  DINGO_LOG(INFO) << "cpu profile stopped";
+  return Status::OK();
+}
+
+Status Profiler::StartHeapProfile(const std::string& prefix) {
+  std::lock_guard lock(mutex_);
+  if (heap_profiling_) {
+    return Status::IllegalState("heap profile already started");
+  }
+
+  if (HasGperftoolsHeapProfiler()) {
+    heap_profiler_start_(prefix.c_str());
+  } else if (mallctl_ != nullptr) {
+    bool active = true;
+    int ret = mallctl_("prof.active", nullptr, nullptr, &active, sizeof(active));
+    if (ret != 0) {
+      return Status::NotSupported(
+          fmt::format("jemalloc prof.active failed, ret: {}, run with MALLOC_CONF=prof:true", ret));
+    }
+  } else {
+    return Status::NotSupported("heap profiler not loaded, link or LD_PRELOAD tcmalloc or jemalloc");
+  }
+
+  heap_profiling_ = true;
+  heap_prefix_ = prefix;
+  heap_dump_seq_ = 0;
+  DINGO_LOG(INFO) << fmt::format("heap profile started, prefix:{}", prefix);
+  return Status::OK();
+}
+
+Status Profiler::StopHeapProfile() {
+  std::lock_guard lock(mutex_);
+  if (!heap_profiling_) {
+    return Status::IllegalState("heap profile not started");
+  }
+
+  if (HasGperftoolsHeapProfiler()) {
+    heap_profiler_stop_();
+  } else {
+    bool active = false;
+    mallctl_("prof.active", nullptr, nullptr, &active, sizeof(active));
+  }
+
+  heap_profiling_ = false;
+  DINGO_LOG(INFO) << "heap profile stopped";
+  return Status::OK();
+}
+
+Status Profiler::DumpHeapProfile() {
+  std::lock_guard lock(mutex_);
+  if (!heap_profiling_) {
+    return Status::IllegalState("heap profile not started");
+  }
+
+  if (HasGperftoolsHeapProfiler()) {
+    // gperftools names the file itself with the prefix and its own sequence
+    heap_profiler_dump_("sdk dump");
+    return Status::OK();
+  }
+
+  std::string file = fmt::format("{}.{:04}.heap", heap_prefix_, heap_dump_seq_++);
+  const char* file_ptr = file.c_str();
+  int ret = mallctl_("prof.dump", nullptr, nullptr, &file_ptr, sizeof(file_ptr));
+  if (ret != 0) {
+    return Status::IOError(fmt::format("jemalloc prof.dump to {} failed, ret: {}", file, ret));
+  }
+
+  return Status::OK();
+}
+
+bool Profiler::IsCpuProfiling() {
+  std::lock_guard lock(mutex_);
+  return cpu_profiling_;
+}
+
+bool Profiler::IsHeapProfiling() {
+  std::lock_guard lock(mutex_);
+  return heap_profiling_;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
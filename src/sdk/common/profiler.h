@@ -0,0 +1,79 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_COMMON_PROFILER_H_
+#define DINGODB_SDK_COMMON_PROFILER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Process wide cpu and heap profiling. The sdk does not link any profiler, entry points are looked up at runtime,
+// so a binary linked with or LD_PRELOADed with gperftools (libprofiler, libtcmalloc) or jemalloc built with
+// --enable-prof can be profiled without rebuilding, NotSupported otherwise.
+// jemalloc profiles only when started with MALLOC_CONF=prof:true, prof_active:false keeps it idle until started.
+class Profiler {
+ public:
+  Profiler(const Profiler&) = delete;
+  const Profiler& operator=(const Profiler&) = delete;
+
+  static Profiler& Global();
+
+  // gperftools cpu profile written to file when stopped
+  Status StartCpuProfile(const std::string& file);
+  Status StopCpuProfile();
+
+  // dumps are written to <prefix>.<seq>.heap, gperftools heap profiler is preferred over jemalloc
+  Status StartHeapProfile(const std::string& prefix);
+  Status StopHeapProfile();
+  Status DumpHeapProfile();
+
+  bool IsCpuProfiling();
+  bool IsHeapProfiling();
+
+ private:
+  Profiler();
+
+  bool HasGperftoolsHeapProfiler() const;
+
+  using ProfilerStartFunc = int (*)(const char*);
+  using ProfilerStopFunc = void (*)();
+  using HeapProfilerStartFunc = void (*)(const char*);
+  using HeapProfilerStopFunc = void (*)();
+  using HeapProfilerDumpFunc = void (*)(const char*);
+  using MallctlFunc = int (*)(const char*, void*, size_t*, void*, size_t);
+
+  ProfilerStartFunc profiler_start_{nullptr};
+  ProfilerStopFunc profiler_stop_{nullptr};
+  HeapProfilerStartFunc heap_profiler_start_{nullptr};
+  HeapProfilerStopFunc heap_profiler_stop_{nullptr};
+  HeapProfilerDumpFunc heap_profiler_dump_{nullptr};
+  MallctlFunc mallctl_{nullptr};
+
+  std::mutex mutex_;
+  bool cpu_profiling_{false};
+  bool heap_profiling_{false};
+  std::string heap_prefix_;
+  int64_t heap_dump_seq_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_COMMON_PROFILER_H_
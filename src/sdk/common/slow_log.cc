@@ -0,0 +1,162 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/slow_log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+thread_local std::shared_ptr<SlowLogRecorder> current_recorder;
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int64_t NowUnixMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+SlowLogRecorder::SlowLogRecorder() : start_us_(NowUs()) { entry_.start_ms = NowUnixMs(); }
+
+void SlowLogRecorder::AddRpc(SlowLogRpc rpc) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (first_send_us_ == 0 || rpc.send_us < first_send_us_) {
+    first_send_us_ = rpc.send_us;
+  }
+  int64_t done_us = rpc.send_us + rpc.latency_us + rpc.response_us;
+  if (done_us >= last_done_us_) {
+    last_done_us_ = done_us;
+    last_rpc_.queue_us = rpc.queue_us;
+    last_rpc_.latency_us = rpc.latency_us;
+    last_rpc_.response_us = rpc.response_us;
+  }
+  if (static_cast<int64_t>(entry_.rpcs.size()) < FLAGS_slow_log_max_rpcs) {
+    entry_.rpcs.push_back(std::move(rpc));
+  } else {
+    entry_.dropped_rpcs++;
+  }
+}
+
+void SlowLogRecorder::AddRetry() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  entry_.retries++;
+}
+
+SlowLogPhases SlowLogRecorder::Phases() {
+  int64_t now_us = NowUs();
+  std::lock_guard<std::mutex> guard(mutex_);
+  SlowLogPhases phases;
+  if (first_send_us_ == 0) {
+    phases.client_us = now_us - start_us_;
+    return phases;
+  }
+
+  phases.client_us = std::max<int64_t>(first_send_us_ - start_us_, 0);
+  phases.queue_us = last_rpc_.queue_us;
+  phases.rpc_us = last_rpc_.latency_us;
+  phases.response_us = last_rpc_.response_us;
+  phases.merge_us = std::max<int64_t>(now_us - last_done_us_, 0);
+  return phases;
+}
+
+SlowLogEntry SlowLogRecorder::TakeEntry() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return std::move(entry_);
+}
+
+SlowLog& SlowLog::Global() {
+  static SlowLog* slow_log = new SlowLog();
+  return *slow_log;
+}
+
+std::shared_ptr<SlowLogRecorder> SlowLog::CurrentRecorder() { return current_recorder; }
+
+std::shared_ptr<SlowLogRecorder> SlowLog::Join(bool& is_root) {
+  is_root = false;
+  if (current_recorder != nullptr) {
+    return current_recorder;
+  }
+
+  if (FLAGS_slow_log_threshold_ms <= 0) {
+    return nullptr;
+  }
+
+  is_root = true;
+  return std::make_shared<SlowLogRecorder>();
+}
+
+void SlowLog::Finish(const std::string& name, SlowLogRecorder& recorder, int64_t latency_us, const Status& status) {
+  if (FLAGS_slow_log_threshold_ms <= 0 || latency_us < FLAGS_slow_log_threshold_ms * 1000) {
+    return;
+  }
+
+  SlowLogEntry entry = recorder.TakeEntry();
+  entry.name = name;
+  entry.latency_us = latency_us;
+  entry.status = status.ToString();
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  entries_.push_back(std::move(entry));
+  while (static_cast<int64_t>(entries_.size()) > FLAGS_slow_log_capacity) {
+    entries_.pop_front();
+  }
+}
+
+std::vector<SlowLogEntry> SlowLog::Entries() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return {entries_.begin(), entries_.end()};
+}
+
+std::string SlowLog::Dump() {
+  std::string out;
+  for (const auto& entry : Entries()) {
+    out += fmt::format("start_ms:{} name:{} latency_us:{} status:{} retries:{} rpcs:{} dropped_rpcs:{}\n",
+                       entry.start_ms, entry.name, entry.latency_us, entry.status, entry.retries, entry.rpcs.size(),
+                       entry.dropped_rpcs);
+    for (const auto& rpc : entry.rpcs) {
+      out += fmt::format(
+          "  region:{} method:{} endpoint:{} attempt:{} latency_us:{} request_bytes:{} response_bytes:{} "
+          "status:{}\n",
+          rpc.region_id, rpc.method, rpc.end_point, rpc.attempt, rpc.latency_us, rpc.request_bytes,
+          rpc.response_bytes, rpc.status);
+    }
+  }
+  return out;
+}
+
+ScopedSlowLogRecorder::ScopedSlowLogRecorder(std::shared_ptr<SlowLogRecorder> recorder)
+    : prev_(std::move(current_recorder)) {
+  current_recorder = std::move(recorder);
+}
+
+ScopedSlowLogRecorder::~ScopedSlowLogRecorder() { current_recorder = std::move(prev_); }
+
+}  // namespace sdk
+}  // namespace dingodb
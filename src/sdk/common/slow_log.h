@@ -0,0 +1,146 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_COMMON_SLOW_LOG_H_
+#define DINGODB_SDK_COMMON_SLOW_LOG_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// one store rpc attempt of a request
+struct SlowLogRpc {
+  int64_t region_id{0};
+  std::string method;
+  std::string end_point;
+  int attempt{0};
+  // steady clock time the attempt is sent
+  int64_t send_us{0};
+  // wait before sent, e.g. admission waits and retry backoff
+  int64_t queue_us{0};
+  // sent to answered, network round trip and server time, brpc encodes and decodes in it too
+  int64_t latency_us{0};
+  // response handling of the rpc controller
+  int64_t response_us{0};
+  int64_t request_bytes{0};
+  int64_t response_bytes{0};
+  std::string status;
+};
+
+struct SlowLogEntry {
+  std::string name;
+  // unix time
+  int64_t start_ms{0};
+  int64_t latency_us{0};
+  std::string status;
+  int64_t retries{0};
+  std::vector<SlowLogRpc> rpcs;
+  // rpcs over FLAGS_slow_log_max_rpcs are only counted
+  int64_t dropped_rpcs{0};
+};
+
+// where the time of one request goes, the rpc phases are of the store rpc done last, which is on the critical path
+struct SlowLogPhases {
+  // request start to the first store rpc sent, e.g. building requests and meta cache lookup, all of it when no rpc
+  int64_t client_us{0};
+  int64_t queue_us{0};
+  int64_t rpc_us{0};
+  int64_t response_us{0};
+  // the last store rpc done to now, e.g. merge of sub task results
+  int64_t merge_us{0};
+};
+
+// Collects the rpcs and retries of one request, shared by the task of the request, its sub tasks and their store
+// rpc controllers, which may run in different threads.
+class SlowLogRecorder {
+ public:
+  SlowLogRecorder();
+
+  void AddRpc(SlowLogRpc rpc);
+
+  void AddRetry();
+
+  // phases from the creation of the recorder to now, called when the request is done
+  SlowLogPhases Phases();
+
+  // entry of the request, the rpcs are moved out
+  SlowLogEntry TakeEntry();
+
+ private:
+  std::mutex mutex_;
+  SlowLogEntry entry_;
+  // steady clock, kept even when rpcs over FLAGS_slow_log_max_rpcs are dropped
+  int64_t start_us_{0};
+  int64_t first_send_us_{0};
+  int64_t last_done_us_{0};
+  SlowLogRpc last_rpc_;
+};
+
+// Process wide ring buffer of requests slower than FLAGS_slow_log_threshold_ms, nothing is recorded when the
+// threshold is 0. Only the rpc outline of a request is kept, which is much cheaper than tracing every request.
+class SlowLog {
+ public:
+  SlowLog(const SlowLog&) = delete;
+  const SlowLog& operator=(const SlowLog&) = delete;
+
+  static SlowLog& Global();
+
+  // recorder of the request run by current thread, see ScopedSlowLogRecorder
+  static std::shared_ptr<SlowLogRecorder> CurrentRecorder();
+
+  // recorder of current thread, or a new one and is_root is set when current thread runs no request, nullptr when
+  // slow log is disabled and current thread runs no request. A recorder made current by the caller, e.g. to break
+  // down latency, is joined even when slow log is disabled.
+  static std::shared_ptr<SlowLogRecorder> Join(bool& is_root);
+
+  // called by the root of a request when it is done, kept only when latency is over the threshold
+  void Finish(const std::string& name, SlowLogRecorder& recorder, int64_t latency_us, const Status& status);
+
+  std::vector<SlowLogEntry> Entries();
+
+  // one line per request followed by one indented line per rpc, the newest request last
+  std::string Dump();
+
+ private:
+  SlowLog() = default;
+
+  std::mutex mutex_;
+  std::deque<SlowLogEntry> entries_;
+};
+
+// make recorder current for the scope, store rpcs and sub tasks started by the thread in the scope record into it
+class ScopedSlowLogRecorder {
+ public:
+  explicit ScopedSlowLogRecorder(std::shared_ptr<SlowLogRecorder> recorder);
+  ~ScopedSlowLogRecorder();
+
+  ScopedSlowLogRecorder(const ScopedSlowLogRecorder&) = delete;
+  const ScopedSlowLogRecorder& operator=(const ScopedSlowLogRecorder&) = delete;
+
+ private:
+  std::shared_ptr<SlowLogRecorder> prev_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_COMMON_SLOW_LOG_H_
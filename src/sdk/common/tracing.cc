@@ -0,0 +1,229 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/tracing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+thread_local SpanContext current_context;
+
+uint64_t RandomId() {
+  thread_local std::mt19937_64 generator(std::random_device{}());
+  uint64_t id = 0;
+  while (id == 0) {
+    id = generator();
+  }
+  return id;
+}
+
+bool Sampled() {
+  if (FLAGS_sdk_trace_sample_ratio >= 1.0) {
+    return true;
+  }
+  thread_local std::mt19937_64 generator(std::random_device{}());
+  return std::uniform_real_distribution<double>(0.0, 1.0)(generator) < FLAGS_sdk_trace_sample_ratio;
+}
+
+int64_t NowUnixNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+std::string JsonEscape(const std::string& str) {
+  std::string out;
+  out.reserve(str.size());
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+  return out;
+}
+
+std::string EncodeSpan(const SpanData& span) {
+  std::string attributes;
+  for (const auto& [key, value] : span.attributes) {
+    if (!attributes.empty()) {
+      attributes += ",";
+    }
+    attributes += fmt::format(R"({{"key":"{}","value":{{"stringValue":"{}"}}}})", JsonEscape(key), JsonEscape(value));
+  }
+
+  // status code 1 is ok and 2 is error, span kind 1 is internal
+  std::string out = fmt::format(R"({{"traceId":"{}","spanId":"{}",)", span.context.TraceIdHex(),
+                                span.context.SpanIdHex());
+  if (span.parent_span_id != 0) {
+    out += fmt::format(R"("parentSpanId":"{:016x}",)", span.parent_span_id);
+  }
+  out += fmt::format(R"("name":"{}","kind":1,"startTimeUnixNano":"{}","endTimeUnixNano":"{}","attributes":[{}],)",
+                     JsonEscape(span.name), span.start_ns, span.end_ns, attributes);
+  out += fmt::format(R"("status":{{"code":{},"message":"{}"}}}})", span.error ? 2 : 1, JsonEscape(span.status_msg));
+  return out;
+}
+}  // namespace
+
+std::string SpanContext::TraceIdHex() const { return fmt::format("{:016x}{:016x}", trace_id_high, trace_id_low); }
+
+std::string SpanContext::SpanIdHex() const { return fmt::format("{:016x}", span_id); }
+
+std::string SpanContext::TraceParent() const { return fmt::format("00-{}-{}-01", TraceIdHex(), SpanIdHex()); }
+
+void Span::SetAttribute(const std::string& key, const std::string& value) {
+  if (data_ != nullptr) {
+    data_->attributes.emplace_back(key, value);
+  }
+}
+
+void Span::SetAttribute(const std::string& key, int64_t value) {
+  if (data_ != nullptr) {
+    data_->attributes.emplace_back(key, std::to_string(value));
+  }
+}
+
+void Span::SetStatus(const Status& status) {
+  if (data_ != nullptr) {
+    data_->error = !status.ok();
+    data_->status_msg = status.ok() ? "" : status.ToString();
+  }
+}
+
+void Span::End() {
+  if (data_ != nullptr) {
+    data_->end_ns = NowUnixNs();
+    Tracer::Global().Finish(std::move(data_));
+  }
+}
+
+Tracer& Tracer::Global() {
+  static Tracer* tracer = new Tracer();
+  return *tracer;
+}
+
+SpanContext Tracer::CurrentContext() { return current_context; }
+
+Span Tracer::StartSpan(const std::string& name, const SpanContext& parent) {
+  if (!FLAGS_enable_sdk_tracing) {
+    return Span();
+  }
+
+  if (parent.IsValid()) {
+    return StartChildSpan(name, parent);
+  }
+
+  if (!Sampled()) {
+    return Span();
+  }
+
+  auto data = std::make_unique<SpanData>();
+  data->name = name;
+  data->context.trace_id_high = RandomId();
+  data->context.trace_id_low = RandomId();
+  data->context.span_id = RandomId();
+  data->start_ns = NowUnixNs();
+  return Span(std::move(data));
+}
+
+Span Tracer::StartChildSpan(const std::string& name, const SpanContext& parent) {
+  if (!FLAGS_enable_sdk_tracing || !parent.IsValid()) {
+    return Span();
+  }
+
+  auto data = std::make_unique<SpanData>();
+  data->name = name;
+  data->context.trace_id_high = parent.trace_id_high;
+  data->context.trace_id_low = parent.trace_id_low;
+  data->context.span_id = RandomId();
+  data->parent_span_id = parent.span_id;
+  data->start_ns = NowUnixNs();
+  return Span(std::move(data));
+}
+
+void Tracer::Finish(std::unique_ptr<SpanData> data) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  spans_.push_back(std::move(*data));
+  while (static_cast<int64_t>(spans_.size()) > FLAGS_sdk_trace_max_spans) {
+    spans_.pop_front();
+  }
+}
+
+std::vector<SpanData> Tracer::TakeSpans() {
+  std::deque<SpanData> spans;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    spans.swap(spans_);
+  }
+  return {std::make_move_iterator(spans.begin()), std::make_move_iterator(spans.end())};
+}
+
+std::string Tracer::Export() {
+  std::vector<SpanData> spans = TakeSpans();
+
+  std::string encoded;
+  for (const auto& span : spans) {
+    if (!encoded.empty()) {
+      encoded += ",";
+    }
+    encoded += EncodeSpan(span);
+  }
+
+  return fmt::format(
+      R"({{"resourceSpans":[{{"resource":{{"attributes":[{{"key":"service.name","value":{{"stringValue":"{}"}}}}]}},)"
+      R"("scopeSpans":[{{"scope":{{"name":"dingo-sdk"}},"spans":[{}]}}]}}]}})",
+      JsonEscape(FLAGS_sdk_trace_service_name), encoded);
+}
+
+ScopedSpanContext::ScopedSpanContext(const SpanContext& context) : prev_(current_context) {
+  current_context = context;
+}
+
+ScopedSpanContext::~ScopedSpanContext() { current_context = prev_; }
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,140 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_COMMON_TRACING_H_
+#define DINGODB_SDK_COMMON_TRACING_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// ids of a span, follow w3c trace context: 128 bit trace id and 64 bit span id, all zero means invalid
+struct SpanContext {
+  uint64_t trace_id_high{0};
+  uint64_t trace_id_low{0};
+  uint64_t span_id{0};
+
+  bool IsValid() const { return (trace_id_high != 0 || trace_id_low != 0) && span_id != 0; }
+
+  std::string TraceIdHex() const;
+
+  std::string SpanIdHex() const;
+
+  // value of w3c traceparent header, e.g. 00-<trace id>-<span id>-01
+  std::string TraceParent() const;
+};
+
+struct SpanData {
+  std::string name;
+  SpanContext context;
+  uint64_t parent_span_id{0};
+  // unix time
+  int64_t start_ns{0};
+  int64_t end_ns{0};
+  std::vector<std::pair<std::string, std::string>> attributes;
+  bool error{false};
+  std::string status_msg;
+};
+
+// A span records nothing when it is empty, that is tracing is disabled or the trace is not sampled, so callers
+// never need to check. The span is exported when End is called or it is destroyed.
+class Span {
+ public:
+  Span() = default;
+  explicit Span(std::unique_ptr<SpanData> data) : data_(std::move(data)) {}
+  ~Span() { End(); }
+
+  Span(Span&&) = default;
+  Span& operator=(Span&& other) noexcept {
+    End();
+    data_ = std::move(other.data_);
+    return *this;
+  }
+
+  bool IsRecording() const { return data_ != nullptr; }
+
+  // invalid when empty, children of an invalid context are empty
+  SpanContext Context() const { return data_ != nullptr ? data_->context : SpanContext(); }
+
+  void SetAttribute(const std::string& key, const std::string& value);
+
+  void SetAttribute(const std::string& key, int64_t value);
+
+  void SetStatus(const Status& status);
+
+  void End();
+
+ private:
+  std::unique_ptr<SpanData> data_;
+};
+
+// Process wide tracer, finished spans are kept in a bounded buffer until exported by Export, the oldest spans are
+// dropped when the buffer is full. Nothing is recorded when FLAGS_enable_sdk_tracing is false.
+class Tracer {
+ public:
+  Tracer(const Tracer&) = delete;
+  const Tracer& operator=(const Tracer&) = delete;
+
+  static Tracer& Global();
+
+  // context of the span run by current thread, see ScopedSpanContext
+  static SpanContext CurrentContext();
+
+  // start a child of parent, or a new trace sampled by FLAGS_sdk_trace_sample_ratio when parent is invalid
+  Span StartSpan(const std::string& name, const SpanContext& parent);
+
+  // start a child of parent, empty when parent is invalid
+  Span StartChildSpan(const std::string& name, const SpanContext& parent);
+
+  void Finish(std::unique_ptr<SpanData> data);
+
+  // take all finished spans and encode them as OTLP/JSON ExportTraceServiceRequest, which can be posted to the
+  // /v1/traces endpoint of an OpenTelemetry collector
+  std::string Export();
+
+  std::vector<SpanData> TakeSpans();
+
+ private:
+  Tracer() = default;
+
+  std::mutex mutex_;
+  std::deque<SpanData> spans_;
+};
+
+// make context current for the scope, spans started by the thread in the scope are its children
+class ScopedSpanContext {
+ public:
+  explicit ScopedSpanContext(const SpanContext& context);
+  ~ScopedSpanContext();
+
+  ScopedSpanContext(const ScopedSpanContext&) = delete;
+  const ScopedSpanContext& operator=(const ScopedSpanContext&) = delete;
+
+ private:
+  SpanContext prev_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_COMMON_TRACING_H_
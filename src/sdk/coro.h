@@ -0,0 +1,179 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_CORO_H_
+#define DINGODB_SDK_CORO_H_
+
+// C++20 coroutine wrappers of sdk async api, header only, so sdk itself is still built with C++17,
+// e.g. Status s = co_await coro::Get(raw_kv, key, value, executor);
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/status.h"
+#include "sdk/utils/callback.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+namespace coro {
+
+// resume the awaiting coroutine, e.g. post to the event loop of caller.
+// empty executor resumes inline in the sdk thread firing the callback, the coroutine must not block until its
+// next co_await then.
+using Executor = std::function<void(std::function<void()>)>;
+
+// awaitable of one sdk async call, start is invoked in await_suspend with the callback of the call,
+// co_await return the status of the call.
+// NOTE: params of the call must be valid until co_await return, which is natural for locals of the coroutine.
+class StatusAwaitable {
+ public:
+  StatusAwaitable(std::function<void(StatusCallback)> start, Executor executor)
+      : start_(std::move(start)), executor_(std::move(executor)) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    start_([this](Status status) {
+      status_ = std::move(status);
+      // whoever comes second resumes, callback fired before await_suspend return needs no suspend at all
+      if (done_.exchange(true, std::memory_order_acq_rel)) {
+        Resume();
+      }
+    });
+    return !done_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  Status await_resume() { return std::move(status_); }
+
+ private:
+  void Resume() {
+    if (executor_) {
+      executor_([handle = handle_] { handle.resume(); });
+    } else {
+      handle_.resume();
+    }
+  }
+
+  std::function<void(StatusCallback)> start_;
+  Executor executor_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> done_{false};
+  Status status_;
+};
+
+// blocking sdk call which has no async api, e.g. transaction commit, fn runs in executor and the coroutine is
+// resumed there, or goes on inline if fn returned before it suspended. executor must not be empty and should own
+// threads which may block
+inline StatusAwaitable Blocking(std::function<Status()> fn, Executor executor) {
+  auto start = [fn = std::move(fn), executor](StatusCallback cb) mutable {
+    executor([fn = std::move(fn), cb = std::move(cb)] { cb(fn()); });
+  };
+  // cb is invoked in executor already
+  return StatusAwaitable(std::move(start), nullptr);
+}
+
+// raw kv
+
+inline StatusAwaitable Get(RawKV& raw_kv, const std::string& key, std::string& out_value, Executor executor = nullptr) {
+  return StatusAwaitable([&](StatusCallback cb) { raw_kv.AsyncGet(key, out_value, std::move(cb)); },
+                         std::move(executor));
+}
+
+inline StatusAwaitable BatchGet(RawKV& raw_kv, const std::vector<std::string>& keys, std::vector<KVPair>& out_kvs,
+                                Executor executor = nullptr) {
+  return StatusAwaitable([&](StatusCallback cb) { raw_kv.AsyncBatchGet(keys, out_kvs, std::move(cb)); },
+                         std::move(executor));
+}
+
+inline StatusAwaitable Put(RawKV& raw_kv, const std::string& key, const std::string& value,
+                           Executor executor = nullptr) {
+  return StatusAwaitable([&](StatusCallback cb) { raw_kv.AsyncPut(key, value, std::move(cb)); }, std::move(executor));
+}
+
+inline StatusAwaitable BatchPut(RawKV& raw_kv, const std::vector<KVPair>& kvs, Executor executor = nullptr) {
+  return StatusAwaitable([&](StatusCallback cb) { raw_kv.AsyncBatchPut(kvs, std::move(cb)); }, std::move(executor));
+}
+
+inline StatusAwaitable Scan(RawKV& raw_kv, const std::string& start_key, const std::string& end_key, uint64_t limit,
+                            std::vector<KVPair>& out_kvs, Executor executor = nullptr) {
+  return StatusAwaitable(
+      [&](StatusCallback cb) { raw_kv.AsyncScan(start_key, end_key, limit, out_kvs, std::move(cb)); },
+      std::move(executor));
+}
+
+inline StatusAwaitable DeleteRange(RawKV& raw_kv, const std::string& start_key, const std::string& end_key,
+                                   int64_t& out_delete_count, Executor executor = nullptr) {
+  return StatusAwaitable(
+      [&](StatusCallback cb) { raw_kv.AsyncDeleteRange(start_key, end_key, out_delete_count, std::move(cb)); },
+      std::move(executor));
+}
+
+// vector
+
+inline StatusAwaitable Search(VectorClient& client, int64_t index_id, const SearchParam& search_param,
+                              const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result,
+                              Executor executor = nullptr, std::shared_ptr<CancelToken> cancel_token = nullptr) {
+  return StatusAwaitable(
+      [&, cancel_token](StatusCallback cb) {
+        client.AsyncSearchByIndexId(index_id, search_param, target_vectors, out_result, std::move(cb), cancel_token);
+      },
+      std::move(executor));
+}
+
+inline StatusAwaitable Add(VectorClient& client, int64_t index_id, std::vector<VectorWithId>& vectors,
+                           bool replace_deleted, bool is_update, Executor executor = nullptr,
+                           std::shared_ptr<CancelToken> cancel_token = nullptr) {
+  return StatusAwaitable(
+      [&, replace_deleted, is_update, cancel_token](StatusCallback cb) {
+        client.AsyncAddByIndexId(index_id, vectors, replace_deleted, is_update, std::move(cb), cancel_token);
+      },
+      std::move(executor));
+}
+
+inline StatusAwaitable Delete(VectorClient& client, int64_t index_id, const std::vector<int64_t>& vector_ids,
+                              std::vector<DeleteResult>& out_result, Executor executor = nullptr,
+                              std::shared_ptr<CancelToken> cancel_token = nullptr) {
+  return StatusAwaitable(
+      [&, cancel_token](StatusCallback cb) {
+        client.AsyncDeleteByIndexId(index_id, vector_ids, out_result, std::move(cb), cancel_token);
+      },
+      std::move(executor));
+}
+
+// transaction, which has no async api yet
+
+inline StatusAwaitable PreCommit(Transaction& txn, Executor executor) {
+  return Blocking([&txn] { return txn.PreCommit(); }, std::move(executor));
+}
+
+inline StatusAwaitable Commit(Transaction& txn, Executor executor) {
+  return Blocking([&txn] { return txn.Commit(); }, std::move(executor));
+}
+
+}  // namespace coro
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // __cpp_impl_coroutine
+#endif  // DINGODB_SDK_CORO_H_
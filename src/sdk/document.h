@@ -16,12 +16,14 @@
 #define DINGODB_SDK_DOCUMENT_H_
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "sdk/filter.h"
 #include "sdk/status.h"
 #include "sdk/types.h"
 
@@ -29,6 +31,7 @@ namespace dingodb {
 namespace sdk {
 
 class ClientStub;
+class DocumentSchemaTranslater;
 class DocumentTranslater;
 
 struct DocumentColumn {
@@ -74,43 +77,56 @@ class DocumentIndexCreator {
   explicit DocumentIndexCreator(Data* data);
 };
 
+// Value of a doc field, stored inline so int and double fields need no heap allocation and short strings stay
+// in the small string buffer.
 class DocValue {
  public:
-  ~DocValue();
+  // invalid value, GetType() is kTypeEnd, e.g. value of a doc without the key in DocumentBatch
+  DocValue() : int_val_(0) {}
 
-  DocValue(const DocValue&);
-  DocValue& operator=(const DocValue&);
-  DocValue(DocValue&& other) noexcept;
-  DocValue& operator=(DocValue&& other) noexcept;
+  ~DocValue() = default;
+
+  DocValue(const DocValue&) = default;
+  DocValue& operator=(const DocValue&) = default;
+  DocValue(DocValue&& other) noexcept = default;
+  DocValue& operator=(DocValue&& other) noexcept = default;
 
   static DocValue FromInt(int64_t val);
   static DocValue FromDouble(double val);
   static DocValue FromString(const std::string& val);
   static DocValue FromBytes(const std::string& val);
 
-  Type GetType() const;
-  int64_t IntValue() const;
-  double DoubleValue() const;
-  std::string StringValue() const;
+  Type GetType() const { return type_; }
+  int64_t IntValue() const { return int_val_; }
+  double DoubleValue() const { return double_val_; }
+  const std::string& StringValue() const { return string_val_; }
 
   std::string ToString() const;
 
  private:
   friend class DocumentTranslater;
-  class Data;
-  std::unique_ptr<Data> data_;
 
-  explicit DocValue();
+  Type type_{Type::kTypeEnd};
+  union {
+    int64_t int_val_;
+    double double_val_;
+  };
+  std::string string_val_;
 };
 
 class Document {
  public:
   void AddField(const std::string& key, const DocValue& value);
 
+  // nullptr when not found
+  const DocValue* GetField(const std::string& key) const;
+
+  const std::unordered_map<std::string, DocValue>& GetFields() const { return fields_; }
+
   std::string ToString() const;
 
  private:
-  friend class DocumentTranslater;
+  friend class DocumentSchemaTranslater;
   std::unordered_map<std::string, DocValue> fields_;
 };
 
@@ -127,6 +143,44 @@ struct DocWithId {
   std::string ToString() const;
 };
 
+// Columnar docs for reading many docs, values of a key are kept in one column instead of a field map per doc.
+// Every column has a value per doc, the value of a doc without the key is of type kTypeEnd.
+class DocumentBatch {
+ public:
+  int64_t Size() const { return ids_.size(); }
+
+  bool Empty() const { return ids_.empty(); }
+
+  const std::vector<int64_t>& GetIds() const { return ids_; }
+
+  // nullptr when no doc has the key
+  const std::vector<DocValue>* GetColumn(const std::string& key) const;
+
+  const std::map<std::string, std::vector<DocValue>>& GetColumns() const { return columns_; }
+
+  // row of idx as doc, fields of kTypeEnd are skipped
+  DocWithId GetDoc(int64_t idx) const;
+
+  void Append(const DocWithId& doc_with_id);
+
+  // append row idx of other
+  void AppendRow(const DocumentBatch& other, int64_t idx);
+
+  void Clear();
+
+  std::string ToString() const;
+
+ private:
+  friend class DocumentSchemaTranslater;
+
+  // value of the row being appended, FinishRow must follow the values of a row
+  void AppendValue(const std::string& key, DocValue value);
+  void FinishRow(int64_t id);
+
+  std::vector<int64_t> ids_;
+  std::map<std::string, std::vector<DocValue>> columns_;
+};
+
 struct DocQueryParam {
   std::vector<int64_t> doc_ids;
   // if true, response with scalar data
@@ -134,10 +188,13 @@ struct DocQueryParam {
   // If with_scalar_data is true, selected_keys is used to select scalar data, and if this parameter is null, all scalar
   // data will be returned.
   std::vector<std::string> selected_keys;
+  // if true, result is in DocQueryResult::batch instead of docs
+  bool columnar{false};
 };
 
 struct DocQueryResult {
   std::vector<DocWithId> docs;
+  DocumentBatch batch;
 
   std::string ToString() const;
 };
@@ -150,6 +207,12 @@ struct DocSearchParam {
   std::vector<std::string> column_names;
   bool with_scalar_data{false};
   std::vector<std::string> selected_keys;
+  // pre-built scalar filter, evaluated on client against the results since document search has no coprocessor,
+  // fields needed are fetched with the results. May return less than top_n.
+  std::shared_ptr<const Filter> filter;
+  // best effort, a partition or region failing or not answered by the deadline of the cancel token does not fail
+  // the search, the merged top_n of the rest is returned and the missing ones are listed in DocSearchResult
+  bool partial_result{false};
 };
 
 struct DocWithStore {
@@ -161,6 +224,9 @@ struct DocWithStore {
 
 struct DocSearchResult {
   std::vector<DocWithStore> doc_sores;
+  // when DocSearchParam::partial_result, partitions and regions not answered, empty when results are complete
+  std::vector<int64_t> missing_part_ids;
+  std::vector<int64_t> missing_region_ids;
   std::string ToString() const;
 };
 
@@ -186,10 +252,13 @@ struct DocScanQueryParam {
   // If with_scalar_data is true, selected_keys is used to select scalar data, and if this parameter is null, all scalar
   // data will be returned.
   std::vector<std::string> selected_keys;
+  // if true, result is in DocScanQueryResult::batch instead of docs
+  bool columnar{false};
 };
 
 struct DocScanQueryResult {
   std::vector<DocWithId> docs;
+  DocumentBatch batch;
 
   std::string ToString() const;
 };
@@ -205,6 +274,65 @@ struct DocIndexMetricsResult {
   std::string ToString() const;
 };
 
+// Bulk writer of one document index. Add buffers docs and writes them in chunks of about
+// FLAGS_document_writer_chunk_bytes, each chunk is split by region and written while later docs are still
+// being added. When FLAGS_document_writer_max_inflight_bytes are in flight, Add blocks until some chunk is done.
+// Ids allocated for auto increment index are not reported back.
+// NOTE: not thread safe, one writer should be used by one thread
+class DocumentWriter {
+ public:
+  DocumentWriter(const DocumentWriter&) = delete;
+  const DocumentWriter& operator=(const DocumentWriter&) = delete;
+
+  // flush and wait all in flight chunks
+  ~DocumentWriter();
+
+  // return the first error of previous chunks if any, the doc is not added then
+  Status Add(DocWithId doc);
+
+  Status Add(std::vector<DocWithId> docs);
+
+  // write all buffered docs and wait until all chunks are done, return the first error since last Flush
+  Status Flush();
+
+ private:
+  friend class DocumentClient;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit DocumentWriter(Data* data);
+};
+
+// Streams docs of DocScanQueryParam [doc_id_start, doc_id_end] in id order, partition by partition,
+// max_scan_count is the page size and columnar is ignored. The next page is prefetched while caller handles the
+// current one, so at most two pages are in memory however large the range is.
+// NOTE: not thread safe
+class DocumentScanCursor {
+ public:
+  DocumentScanCursor(const DocumentScanCursor&) = delete;
+  const DocumentScanCursor& operator=(const DocumentScanCursor&) = delete;
+
+  // wait in flight prefetch
+  ~DocumentScanCursor();
+
+  bool HasNext() const;
+
+  // out_docs is cleared and filled with at most max_scan_count docs, it is empty when scan is done
+  Status Next(std::vector<DocWithId>& out_docs);
+
+ private:
+  friend class DocumentClient;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit DocumentScanCursor(Data* data);
+};
+
+// consumer of one exported page, a not ok status stops the export and is returned by it
+using DocExportConsumer = std::function<Status(std::vector<DocWithId>& docs)>;
+
 class DocumentClient {
  public:
   DocumentClient(const DocumentClient&) = delete;
@@ -215,6 +343,9 @@ class DocumentClient {
   Status AddByIndexId(int64_t index_id, std::vector<DocWithId>& docs);
   Status AddByIndexName(int64_t schema_id, const std::string& index_name, std::vector<DocWithId>& docs);
 
+  // out_writer is owned by caller, is_update makes the writer update docs instead of adding
+  Status NewDocumentWriter(int64_t index_id, DocumentWriter** out_writer, bool is_update = false);
+
   Status UpdateByIndexId(int64_t index_id, std::vector<DocWithId>& docs);
   Status UpdateByIndexName(int64_t schema_id, const std::string& index_name, std::vector<DocWithId>& docs);
 
@@ -238,10 +369,25 @@ class DocumentClient {
   Status ScanQueryByIndexName(int64_t schema_id, const std::string& index_name, const DocScanQueryParam& query_param,
                               DocScanQueryResult& out_result);
 
+  // NOTE:: Caller must delete *out_cursor when it is no longer needed.
+  Status NewDocumentScanCursor(int64_t index_id, const DocScanQueryParam& query_param,
+                               DocumentScanCursor** out_cursor);
+
+  // pages of the whole scan range are handed to consumer one by one in id order, e.g. for reindex
+  Status ExportByIndexId(int64_t index_id, const DocScanQueryParam& query_param, const DocExportConsumer& consumer);
+  Status ExportByIndexName(int64_t schema_id, const std::string& index_name, const DocScanQueryParam& query_param,
+                           const DocExportConsumer& consumer);
+
   Status GetIndexMetricsByIndexId(int64_t index_id, DocIndexMetricsResult& out_result);
   Status GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name,
                                     DocIndexMetricsResult& out_result);
 
+  // for polling, metrics aggregated by this client at most max_staleness_ms ago may be returned without asking
+  // regions, concurrent calls of one index share one aggregation, 0 always asks regions
+  Status GetIndexMetricsByIndexId(int64_t index_id, int64_t max_staleness_ms, DocIndexMetricsResult& out_result);
+  Status GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name, int64_t max_staleness_ms,
+                                    DocIndexMetricsResult& out_result);
+
   Status CountAllByIndexId(int64_t index_id, int64_t& out_count);
   Status CountallByIndexName(int64_t schema_id, const std::string& index_name, int64_t& out_count);
 
@@ -23,7 +23,6 @@
 #include "sdk/document.h"
 #include "sdk/document/document_helper.h"
 #include "sdk/document/document_index.h"
-#include "sdk/document/document_translater.h"
 #include "sdk/status.h"
 
 namespace dingodb {
@@ -109,6 +108,8 @@ void DocumentAddTask::DoAsync() {
 
   controllers_.clear();
   rpcs_.clear();
+  controllers_.reserve(region_docs_to_ids.size());
+  rpcs_.reserve(region_docs_to_ids.size());
 
   for (const auto& entry : region_docs_to_ids) {
     auto region_id = entry.first;
@@ -117,16 +118,15 @@ void DocumentAddTask::DoAsync() {
     CHECK(iter != region_id_to_region.end());
     auto region = iter->second;
 
-    auto rpc = std::make_unique<DocumentAddRpc>();
+    auto rpc = RpcPool<DocumentAddRpc>::Acquire();
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
 
     for (const auto& id : entry.second) {
       int64_t idx = doc_id_to_idx_[id];
-      DocumentTranslater::FillDocumentWithIdPB(rpc->MutableRequest()->add_documents(), docs_[idx]);
+      doc_index_->GetTranslater().FillDocumentWithIdPB(rpc->MutableRequest()->add_documents(), docs_[idx]);
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -135,6 +135,7 @@ void DocumentAddTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
   sub_tasks_count_.store(region_docs_to_ids.size());
+  RecordFanOut(region_docs_to_ids.size());
 
   for (auto i = 0; i < region_docs_to_ids.size(); i++) {
     auto& controller = controllers_[i];
@@ -146,8 +147,8 @@ void DocumentAddTask::DoAsync() {
 
 void DocumentAddTask::DocumentAddRpcCallback(const Status& status, DocumentAddRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -172,4 +173,4 @@ void DocumentAddTask::DocumentAddRpcCallback(const Status& status, DocumentAddRp
 }
 
 }  // namespace sdk
-}  // namespace dingodb
\ No newline at end of file
+}  // namespace dingodb
@@ -23,6 +23,7 @@
 #include "sdk/document/document_index.h"
 #include "sdk/document/document_task.h"
 #include "sdk/rpc/document_service_rpc.h"
+#include "sdk/rpc/rpc_pool.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
 namespace dingodb {
@@ -49,7 +50,7 @@ class DocumentAddTask : public DocumentTask {
   std::shared_ptr<DocumentIndex> doc_index_;
 
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<DocumentAddRpc>> rpcs_;
+  std::vector<RpcPool<DocumentAddRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   std::unordered_map<int64_t, int64_t> doc_id_to_idx_;
@@ -17,7 +17,7 @@
 
 #include "sdk/common/common.h"
 #include "sdk/document/document_helper.h"
-#include "sdk/document/document_translater.h"
+#include "sdk/document/document_index.h"
 
 namespace dingodb {
 namespace sdk {
@@ -52,40 +52,22 @@ void DocumentBatchQueryTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<int64_t>> region_id_to_doc_ids;
-
-  auto meta_cache = stub.GetMetaCache();
-
-  for (const auto& id : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(document_helper::DocumentIdToRangeKey(*doc_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_id_to_doc_ids[tmp->RegionId()].push_back(id);
+  std::vector<int64_t> ids(next_batch.begin(), next_batch.end());
+  std::vector<document_helper::RegionDocumentIds> groups;
+  Status s = document_helper::GroupDocumentIdsByRegion(*stub.GetMetaCache(), *doc_index_, ids, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
 
-  for (const auto& entry : region_id_to_doc_ids) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
     auto rpc = std::make_unique<DocumentBatchQueryRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
     rpc->MutableRequest()->set_without_scalar_data(!query_param_.with_scalar_data);
 
     if (query_param_.with_scalar_data) {
@@ -94,22 +76,22 @@ void DocumentBatchQueryTask::DoAsync() {
       }
     }
 
-    for (const auto& id : entry.second) {
+    for (const auto& id : group.ids) {
       rpc->MutableRequest()->add_document_ids(id);
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  DCHECK_EQ(rpcs_.size(), region_id_to_doc_ids.size());
+  DCHECK_EQ(rpcs_.size(), groups.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_id_to_doc_ids.size());
+  sub_tasks_count_.store(rpcs_.size());
+  RecordFanOut(rpcs_.size());
 
-  for (auto i = 0; i < region_id_to_doc_ids.size(); i++) {
+  for (auto i = 0; i < rpcs_.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -122,8 +104,8 @@ void DocumentBatchQueryTask::DocumentBatchQueryRpcCallback(const Status& status,
                       << " response: " << rpc->Response()->DebugString();
 
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -136,10 +118,16 @@ void DocumentBatchQueryTask::DocumentBatchQueryRpcCallback(const Status& status,
         << " response vectors_size: " << rpc->Response()->doucments_size()
         << " request: " << rpc->Request()->DebugString() << " response: " << rpc->Response()->DebugString();
 
+    const auto& translater = doc_index_->GetTranslater();
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    for (const auto& doc_pb : rpc->Response()->doucments()) {
-      if (doc_pb.id() > 0) {
-        out_result_.docs.emplace_back(DocumentTranslater::InternalDocumentWithIdPB2DocWithId(doc_pb));
+    if (query_param_.columnar) {
+      translater.AppendDocsToBatch(rpc->Response()->doucments(), out_result_.batch);
+    } else {
+      out_result_.docs.reserve(out_result_.docs.size() + rpc->Response()->doucments_size());
+      for (const auto& doc_pb : rpc->Response()->doucments()) {
+        if (doc_pb.id() > 0) {
+          out_result_.docs.emplace_back(translater.DocWithIdFromPB(doc_pb));
+        }
       }
     }
 
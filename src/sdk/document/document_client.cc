@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "sdk/client_stub.h"
 #include "sdk/document.h"
@@ -23,9 +25,11 @@
 #include "sdk/document/document_get_border_task.h"
 #include "sdk/document/document_get_index_metrics_task.h"
 #include "sdk/document/document_index_cache.h"
+#include "sdk/document/document_scan_cursor_internal_data.h"
 #include "sdk/document/document_scan_query_task.h"
 #include "sdk/document/document_search_task.h"
 #include "sdk/document/document_update_task.h"
+#include "sdk/document/document_writer_internal_data.h"
 #include "sdk/status.h"
 
 namespace dingodb {
@@ -48,6 +52,11 @@ Status DocumentClient::AddByIndexName(int64_t schema_id, const std::string& inde
   return task.Run();
 }
 
+Status DocumentClient::NewDocumentWriter(int64_t index_id, DocumentWriter** out_writer, bool is_update) {
+  *out_writer = new DocumentWriter(new DocumentWriter::Data(stub_, index_id, is_update));
+  return Status::OK();
+}
+
 Status DocumentClient::UpdateByIndexId(int64_t index_id, std::vector<DocWithId>& docs) {
   DocumentUpdateTask task(stub_, index_id, docs);
   return task.Run();
@@ -144,19 +153,69 @@ Status DocumentClient::ScanQueryByIndexName(int64_t schema_id, const std::string
   return task.Run();
 }
 
+Status DocumentClient::NewDocumentScanCursor(int64_t index_id, const DocScanQueryParam& query_param,
+                                             DocumentScanCursor** out_cursor) {
+  auto data = std::make_unique<DocumentScanCursor::Data>(stub_, index_id);
+  DINGO_RETURN_NOT_OK(data->Init(query_param));
+  *out_cursor = new DocumentScanCursor(data.release());
+  return Status::OK();
+}
+
+Status DocumentClient::ExportByIndexId(int64_t index_id, const DocScanQueryParam& query_param,
+                                       const DocExportConsumer& consumer) {
+  DocumentScanCursor* tmp = nullptr;
+  DINGO_RETURN_NOT_OK(NewDocumentScanCursor(index_id, query_param, &tmp));
+  std::unique_ptr<DocumentScanCursor> cursor(tmp);
+
+  std::vector<DocWithId> docs;
+  while (cursor->HasNext()) {
+    DINGO_RETURN_NOT_OK(cursor->Next(docs));
+    if (docs.empty()) {
+      continue;
+    }
+    // next page is already prefetched while consumer handles this one
+    DINGO_RETURN_NOT_OK(consumer(docs));
+  }
+
+  return Status::OK();
+}
+
+Status DocumentClient::ExportByIndexName(int64_t schema_id, const std::string& index_name,
+                                         const DocScanQueryParam& query_param, const DocExportConsumer& consumer) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetDocumentIndexCache()->GetIndexIdByKey(EncodeDocumentIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  return ExportByIndexId(index_id, query_param, consumer);
+}
+
 Status DocumentClient::GetIndexMetricsByIndexId(int64_t index_id, DocIndexMetricsResult& out_result) {
-  DocumentGetIndexMetricsTask task(stub_, index_id, out_result);
-  return task.Run();
+  return GetIndexMetricsByIndexId(index_id, 0, out_result);
 }
 
 Status DocumentClient::GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name,
                                                   DocIndexMetricsResult& out_result) {
+  return GetIndexMetricsByIndexName(schema_id, index_name, 0, out_result);
+}
+
+Status DocumentClient::GetIndexMetricsByIndexId(int64_t index_id, int64_t max_staleness_ms,
+                                                DocIndexMetricsResult& out_result) {
+  return stub_.GetDocumentIndexMetricsCache()->Get(
+      index_id, max_staleness_ms,
+      [this, index_id](DocIndexMetricsResult& result) {
+        DocumentGetIndexMetricsTask task(stub_, index_id, result);
+        return task.Run();
+      },
+      out_result);
+}
+
+Status DocumentClient::GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name,
+                                                  int64_t max_staleness_ms, DocIndexMetricsResult& out_result) {
   int64_t index_id{0};
   DINGO_RETURN_NOT_OK(
       stub_.GetDocumentIndexCache()->GetIndexIdByKey(EncodeDocumentIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
-  DocumentGetIndexMetricsTask task(stub_, index_id, out_result);
-  return task.Run();
+  return GetIndexMetricsByIndexId(index_id, max_staleness_ms, out_result);
 }
 
 Status DocumentClient::CountAllByIndexId(int64_t index_id, int64_t& out_count) {
@@ -15,7 +15,11 @@
 #ifndef DINGODB_SDK_DOCUMENT_CODEC_H_
 #define DINGODB_SDK_DOCUMENT_CODEC_H_
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "common/logging.h"
 #include "glog/logging.h"
@@ -69,6 +73,36 @@ static int64_t DecodeDocumentId(const std::string& value) {
   return DingoSchema<std::optional<int64_t>>::InternalDecodeKey(&buf);
 }
 
+// keys of (partition_ids[i], doc_ids[i]) written back to back into out_keys,
+// kDocumentKeyMaxLenWithPrefix bytes each, same bytes with EncodeDocumentKey
+static void EncodeDocumentKeys(char prefix, const std::vector<int64_t>& partition_ids,
+                               const std::vector<int64_t>& doc_ids, std::string& out_keys) {
+  CHECK(prefix != 0) << "Encode document keys failed, prefix is 0";
+  CHECK_EQ(partition_ids.size(), doc_ids.size());
+
+  out_keys.resize(doc_ids.size() * kDocumentKeyMaxLenWithPrefix);
+  char* out = out_keys.data();
+  for (size_t i = 0; i < doc_ids.size(); ++i) {
+    out[0] = prefix;
+    codec::EncodeInt64(partition_ids[i], out + 1);
+    codec::EncodeComparableInt64(doc_ids[i], out + 9);
+    out += kDocumentKeyMaxLenWithPrefix;
+  }
+}
+
+// document ids of keys written back to back by EncodeDocumentKeys
+static void DecodeDocumentIds(std::string_view keys, std::vector<int64_t>& out_doc_ids) {
+  CHECK_EQ(keys.size() % kDocumentKeyMaxLenWithPrefix, 0) << "Decode document ids failed, size:" << keys.size();
+
+  size_t num = keys.size() / kDocumentKeyMaxLenWithPrefix;
+  out_doc_ids.resize(num);
+  const char* in = keys.data();
+  for (size_t i = 0; i < num; ++i) {
+    out_doc_ids[i] = codec::DecodeComparableInt64(in + 9);
+    in += kDocumentKeyMaxLenWithPrefix;
+  }
+}
+
 static int64_t DecodePartitionId(const std::string& value) {
   Buf buf(value);
 
@@ -59,6 +59,7 @@ void DocumentCountTask::DoAsync() {
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
     auto* sub_task = new DocumentCountPartTask(stub, doc_index_, part_id, start_doc_id_, end_doc_id_);
@@ -111,10 +112,8 @@ static void DecodeRangeToDocId(const pb::common::Range& range, int64_t& begin_ve
 }
 
 void DocumentCountPartTask::DoAsync() {
-  const auto& range = doc_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> partition_regions;
-  Status s =
-      stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), partition_regions);
+  Status s = doc_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, partition_regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -147,8 +146,7 @@ void DocumentCountPartTask::DoAsync() {
       rpc->MutableRequest()->set_document_id_start(start);
       rpc->MutableRequest()->set_document_id_end(end);
 
-      StoreRpcController controller(stub, *rpc, region);
-      controllers_.push_back(controller);
+      controllers_.emplace_back(stub, *rpc, region);
 
       rpcs_.push_back(std::move(rpc));
       regions.push_back(region);
@@ -171,6 +169,7 @@ void DocumentCountPartTask::DoAsync() {
     DoAsyncDone(Status::OK());
   } else {
     sub_tasks_count_.store(regions.size());
+    RecordFanOut(regions.size());
 
     for (auto i = 0; i < regions.size(); i++) {
       auto& controller = controllers_[i];
@@ -183,8 +182,8 @@ void DocumentCountPartTask::DoAsync() {
 
 void DocumentCountPartTask::DocumentCountRpcCallback(Status status, DocumentCountRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
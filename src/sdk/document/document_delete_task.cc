@@ -53,57 +53,39 @@ void DocumentDeleteTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<int64_t>> region_vectors_to_ids;
-
-  auto meta_cache = stub.GetMetaCache();
-
-  for (const auto& id : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(document_helper::DocumentIdToRangeKey(*doc_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+  std::vector<int64_t> ids(next_batch.begin(), next_batch.end());
+  std::vector<document_helper::RegionDocumentIds> groups;
+  Status s = document_helper::GroupDocumentIdsByRegion(*stub.GetMetaCache(), *doc_index_, ids, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
 
-  for (const auto& entry : region_vectors_to_ids) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
     auto rpc = std::make_unique<DocumentDeleteRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
 
-    for (const auto& id : entry.second) {
+    for (const auto& id : group.ids) {
       rpc->MutableRequest()->add_ids(id);
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
+  DCHECK_EQ(rpcs_.size(), groups.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
+  sub_tasks_count_.store(rpcs_.size());
+  RecordFanOut(rpcs_.size());
 
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
+  for (auto i = 0; i < rpcs_.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -113,8 +95,8 @@ void DocumentDeleteTask::DoAsync() {
 
 void DocumentDeleteTask::DocumentDeleteRpcCallback(const Status& status, DocumentDeleteRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
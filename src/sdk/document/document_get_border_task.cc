@@ -54,6 +54,7 @@ void DocumentGetBorderTask::DoAsync() {
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
     auto* sub_task = new DocumentGetBorderPartTask(stub, vector_index_, part_id, is_max_);
@@ -95,9 +96,8 @@ void DocumentGetBorderTask::SubTaskCallback(Status status, DocumentGetBorderPart
 }
 
 void DocumentGetBorderPartTask::DoAsync() {
-  const auto& range = vector_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> regions;
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -117,8 +117,7 @@ void DocumentGetBorderPartTask::DoAsync() {
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
     rpc->MutableRequest()->set_get_min(!is_max_);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -127,6 +126,7 @@ void DocumentGetBorderPartTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
   sub_tasks_count_.store(regions.size());
+  RecordFanOut(regions.size());
 
   for (auto i = 0; i < regions.size(); i++) {
     auto& controller = controllers_[i];
@@ -138,8 +138,8 @@ void DocumentGetBorderPartTask::DoAsync() {
 
 void DocumentGetBorderPartTask::DocumentGetBorderIdRpcCallback(const Status& status, DocumentGetBorderIdRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -99,6 +99,9 @@ class DocumentGetIndexMetricsPartTask : public DocumentTask {
     return fmt::format("DocumentGetIndexMetricsPartTask-{}-{}", doc_index_->GetId(), part_id_);
   }
 
+  // send rpc of next_rpc_idx_ if any left
+  void SendNextRpc();
+
   void DocumentGetRegionMetricsRpcCallback(const Status& status, DocumentGetRegionMetricsRpc* rpc);
 
   const std::shared_ptr<DocumentIndex> doc_index_;
@@ -114,6 +117,7 @@ class DocumentGetIndexMetricsPartTask : public DocumentTask {
   DocIndexMetricsResult total_metrics_;
 
   std::atomic<int> sub_tasks_count_{0};
+  std::atomic<size_t> next_rpc_idx_{0};
 };
 
 }  // namespace sdk
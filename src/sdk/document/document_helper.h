@@ -15,9 +15,20 @@
 #ifndef DINGODB_SDK_DOCUMENT_HELPER_H_
 #define DINGODB_SDK_DOCUMENT_HELPER_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "glog/logging.h"
 #include "sdk/document/document_codec.h"
 #include "sdk/document/document_index.h"
+#include "sdk/meta_cache.h"
+#include "sdk/region.h"
+#include "sdk/status.h"
 
 namespace dingodb {
 namespace sdk {
@@ -32,6 +43,71 @@ static std::string DocumentIdToRangeKey(const DocumentIndex& doc_index, int64_t
   document_codec::EncodeDocumentKey(kDocumentPrefix, part_id, doc_id, tmp_key);
   return std::move(tmp_key);
 }
+
+// range keys of doc_ids written back to back into out_keys by one batched encode,
+// key i is out_keys.substr(i * kDocumentKeyMaxLenWithPrefix, kDocumentKeyMaxLenWithPrefix)
+static void DocumentIdsToRangeKeys(const DocumentIndex& doc_index, const std::vector<int64_t>& doc_ids,
+                                   std::string& out_keys) {
+  std::vector<int64_t> part_ids;
+  part_ids.reserve(doc_ids.size());
+  for (int64_t id : doc_ids) {
+    CHECK_GT(id, 0);
+    int64_t part_id = doc_index.GetPartitionId(id);
+    CHECK_GT(part_id, 0);
+    part_ids.push_back(part_id);
+  }
+
+  document_codec::EncodeDocumentKeys(kDocumentPrefix, part_ids, doc_ids, out_keys);
+}
+
+// document ids belong to the same region, ordered by their range key
+struct RegionDocumentIds {
+  std::shared_ptr<Region> region;
+  std::vector<int64_t> ids;
+};
+
+// doc_ids must be unique, range keys of all ids are sorted and mapped to regions by one batched lookup of
+// meta cache, out_groups is ordered by region range
+static Status GroupDocumentIdsByRegion(MetaCache& meta_cache, const DocumentIndex& doc_index,
+                                       const std::vector<int64_t>& doc_ids, std::vector<RegionDocumentIds>& out_groups) {
+  out_groups.clear();
+
+  std::string keys;
+  DocumentIdsToRangeKeys(doc_index, doc_ids, keys);
+
+  std::vector<std::pair<std::string_view, int64_t>> key_ids;
+  key_ids.reserve(doc_ids.size());
+  for (size_t i = 0; i < doc_ids.size(); ++i) {
+    key_ids.emplace_back(std::string_view(keys).substr(i * kDocumentKeyMaxLenWithPrefix, kDocumentKeyMaxLenWithPrefix),
+                         doc_ids[i]);
+  }
+  std::sort(key_ids.begin(), key_ids.end());
+
+  std::vector<std::string_view> sorted_keys;
+  sorted_keys.reserve(key_ids.size());
+  for (const auto& [key, id] : key_ids) {
+    sorted_keys.emplace_back(key);
+  }
+
+  std::vector<RegionKeys> region_keys;
+  DINGO_RETURN_NOT_OK(meta_cache.LookupRegionsByKeys(sorted_keys, region_keys));
+
+  size_t pos = 0;
+  out_groups.reserve(region_keys.size());
+  for (auto& group : region_keys) {
+    RegionDocumentIds region_ids{std::move(group.region), {}};
+    region_ids.ids.reserve(group.keys.size());
+    for (const auto& key : group.keys) {
+      CHECK_LT(pos, key_ids.size());
+      DCHECK_EQ(key.data(), key_ids[pos].first.data());
+      region_ids.ids.push_back(key_ids[pos++].second);
+    }
+    out_groups.push_back(std::move(region_ids));
+  }
+  CHECK_EQ(pos, key_ids.size());
+
+  return Status::OK();
+}
 }  // namespace document_helper
 
 }  // namespace sdk
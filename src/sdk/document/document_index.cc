@@ -32,7 +32,8 @@ DocumentIndex::DocumentIndex(pb::meta::IndexDefinitionWithId index_def_with_id)
       name_(index_def_with_id.index_definition().name()),
       has_auto_increment_(index_def_with_id.index_definition().with_auto_incrment()),
       increment_start_id_(index_def_with_id.index_definition().auto_increment()),
-      index_def_with_id_(std::move(index_def_with_id)) {
+      index_def_with_id_(std::move(index_def_with_id)),
+      translater_(index_def_with_id_.index_definition().index_parameter().document_index_parameter().scalar_schema()) {
   CHECK_GT(index_def_with_id_.index_definition().index_partition().partitions_size(), 0);
   for (const auto& partition : index_def_with_id_.index_definition().index_partition().partitions()) {
     int64_t start_id = document_codec::DecodeDocumentId(partition.range().start_key());
@@ -70,6 +71,11 @@ const pb::common::Range& DocumentIndex::GetPartitionRange(int64_t part_id) const
   return iter->second;
 }
 
+Status DocumentIndex::GetPartitionRegions(MetaCache& meta_cache, int64_t part_id,
+                                  std::vector<std::shared_ptr<Region>>& regions) {
+  return part_region_cache_.GetRegions(meta_cache, part_id, GetPartitionRange(part_id), regions);
+}
+
 std::string DocumentIndex::ToString(bool verbose) const {
   std::ostringstream oss;
   for (const auto& [start_key, part_id] : start_key_to_part_id_) {
@@ -86,7 +92,7 @@ std::string DocumentIndex::ToString(bool verbose) const {
 
 void DocumentIndex::GenerateScalarSchema() {
   for (const auto& schema_item :
-       index_def_with_id_.index_definition().index_parameter().vector_index_parameter().scalar_schema().fields()) {
+       index_def_with_id_.index_definition().index_parameter().document_index_parameter().scalar_schema().fields()) {
     CHECK(schema_.insert(std::make_pair(schema_item.key(), InternalScalarFieldTypePB2Type(schema_item.field_type())))
               .second);
   }
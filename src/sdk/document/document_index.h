@@ -18,9 +18,12 @@
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "proto/meta.pb.h"
 #include "sdk/document.h"
+#include "sdk/document/document_schema_translater.h"
+#include "sdk/partition_region_cache.h"
 #include "sdk/types.h"
 
 namespace dingodb {
@@ -51,6 +54,9 @@ class DocumentIndex {
   // be sure partition id is valid
   const pb::common::Range& GetPartitionRange(int64_t part_id) const;
 
+  // be sure partition id is valid, regions are cached across requests, see PartitionRegionCache
+  Status GetPartitionRegions(MetaCache& meta_cache, int64_t part_id, std::vector<std::shared_ptr<Region>>& regions);
+
   bool IsStale() { return stale_.load(std::memory_order_relaxed); }
 
   bool HasAutoIncrement() const { return has_auto_increment_; }
@@ -59,6 +65,9 @@ class DocumentIndex {
 
   const std::unordered_map<std::string, Type>& GetSchema() const { return schema_; }
 
+  // translates docs of requests and responses by the scalar schema of index
+  const DocumentSchemaTranslater& GetTranslater() const { return translater_; }
+
   const pb::meta::IndexDefinitionWithId& GetIndexDefWithId() const { return index_def_with_id_; }
 
   std::string ToString(bool verbose = false) const;
@@ -83,8 +92,11 @@ class DocumentIndex {
   std::map<int64_t, pb::common::Range> part_id_to_range_;
 
   std::unordered_map<std::string, Type> schema_;
+  const DocumentSchemaTranslater translater_;
 
   std::atomic<bool> stale_{true};
+
+  PartitionRegionCache part_region_cache_;
 };
 }  // namespace sdk
 
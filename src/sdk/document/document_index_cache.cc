@@ -14,21 +14,61 @@
 
 #include "sdk/document/document_index_cache.h"
 
+#include <chrono>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <string>
 
 #include "glog/logging.h"
+#include "sdk/auto_increment_manager.h"
 #include "proto/meta.pb.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/status.h"
 
 namespace dingodb {
 namespace sdk {
 
-DocumentIndexCache::DocumentIndexCache(const ClientStub& stub) : stub_(stub) {}
+namespace {
+// bound memory of negative entries when many missing names are looked up
+const size_t kMaxNegativeEntries = 4096;
+
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+template <class Key>
+bool IsNegativeCachedUnlocked(const std::unordered_map<Key, int64_t>& negative_expire_ms, const Key& key) {
+  auto iter = negative_expire_ms.find(key);
+  return iter != negative_expire_ms.end() && iter->second > NowMs();
+}
+
+template <class Key>
+void AddNegativeUnlocked(std::unordered_map<Key, int64_t>& negative_expire_ms, const Key& key) {
+  if (FLAGS_index_cache_negative_ttl_ms <= 0) {
+    return;
+  }
+
+  int64_t now_ms = NowMs();
+  if (negative_expire_ms.size() >= kMaxNegativeEntries) {
+    for (auto iter = negative_expire_ms.begin(); iter != negative_expire_ms.end();) {
+      iter = iter->second <= now_ms ? negative_expire_ms.erase(iter) : std::next(iter);
+    }
+    if (negative_expire_ms.size() >= kMaxNegativeEntries) {
+      negative_expire_ms.clear();
+    }
+  }
+  negative_expire_ms[key] = now_ms + FLAGS_index_cache_negative_ttl_ms;
+}
+}  // namespace
+
+DocumentIndexCache::DocumentIndexCache(const ClientStub& stub)
+    : stub_(stub), id_snapshot_(std::make_shared<const IdToIndexMap>()) {}
 
 Status DocumentIndexCache::GetIndexIdByKey(const DocumentIndexCacheKey& index_key, int64_t& index_id) {
   {
@@ -65,9 +105,9 @@ Status DocumentIndexCache::GetDocumentIndexByKey(const DocumentIndexCacheKey& in
 
 Status DocumentIndexCache::GetDocumentIndexById(int64_t index_id, std::shared_ptr<DocumentIndex>& out_doc_index) {
   {
-    std::shared_lock<std::shared_mutex> r(rw_lock_);
-    auto iter = id_to_index_.find(index_id);
-    if (iter != id_to_index_.end()) {
+    auto snapshot = std::atomic_load(&id_snapshot_);
+    auto iter = snapshot->find(index_id);
+    if (iter != snapshot->end()) {
       out_doc_index = iter->second;
       return Status::OK();
     }
@@ -87,6 +127,7 @@ void DocumentIndexCache::RemoveDocumentIndexById(int64_t index_id) {
     id_iter->second->MarkStale();
     id_to_index_.erase(id_iter);
     index_key_to_id_.erase(name_iter);
+    PublishIdSnapshotUnlocked();
   }
 }
 
@@ -101,11 +142,118 @@ void DocumentIndexCache::RemoveDocumentIndexByKey(const DocumentIndexCacheKey& i
     id_iter->second->MarkStale();
     id_to_index_.erase(id_iter);
     index_key_to_id_.erase(name_iter);
+    PublishIdSnapshotUnlocked();
+  }
+}
+
+std::vector<pb::meta::IndexDefinitionWithId> DocumentIndexCache::ListIndexDefinitions() {
+  std::vector<pb::meta::IndexDefinitionWithId> defs;
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  defs.reserve(id_to_index_.size());
+  for (const auto& [index_id, index] : id_to_index_) {
+    defs.push_back(index->GetIndexDefWithId());
+  }
+  return defs;
+}
+
+Status DocumentIndexCache::AddIndexDefinition(const pb::meta::IndexDefinitionWithId& index_def_with_id) {
+  if (!CheckIndexDefinitionWithId(index_def_with_id)) {
+    return Status::InvalidArgument("invalid index definition");
   }
+
+  auto index_key = EncodeDocumentIndexCacheKey(index_def_with_id.index_id().parent_entity_id(),
+                                              index_def_with_id.index_definition().name());
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    // another index with the same name is cached, keep the one from coordinator
+    if (index_key_to_id_.find(index_key) != index_key_to_id_.end()) {
+      return Status::AlreadyPresent("index name already cached");
+    }
+  }
+
+  std::shared_ptr<DocumentIndex> index;
+  return ProcessIndexDefinitionWithId(index_def_with_id, index);
 }
 
 Status DocumentIndexCache::SlowGetDocumentIndexByKey(const DocumentIndexCacheKey& index_key,
-                                                     std::shared_ptr<DocumentIndex>& out_doc_index) {
+                                                 std::shared_ptr<DocumentIndex>& out_doc_index) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    if (IsNegativeCachedUnlocked(key_negative_expire_ms_, index_key)) {
+      return Status::NotFound("index not found recently");
+    }
+  }
+
+  bool is_leader = false;
+  Status s = key_flight_.Do(
+      index_key, [&]() { return LoadDocumentIndexByKey(index_key, out_doc_index); }, is_leader);
+  if (is_leader) {
+    if (s.IsNotFound()) {
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      AddNegativeUnlocked(key_negative_expire_ms_, index_key);
+    }
+    return s;
+  }
+
+  if (!s.ok()) {
+    return s;
+  }
+
+  {
+    // loaded by leader
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = index_key_to_id_.find(index_key);
+    if (iter != index_key_to_id_.end()) {
+      auto index_iter = id_to_index_.find(iter->second);
+      CHECK(index_iter != id_to_index_.end());
+      out_doc_index = index_iter->second;
+      return Status::OK();
+    }
+  }
+
+  // removed right after loaded
+  return LoadDocumentIndexByKey(index_key, out_doc_index);
+}
+
+Status DocumentIndexCache::SlowGetDocumentIndexById(int64_t index_id, std::shared_ptr<DocumentIndex>& out_doc_index) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    if (IsNegativeCachedUnlocked(id_negative_expire_ms_, index_id)) {
+      return Status::NotFound("index not found recently");
+    }
+  }
+
+  bool is_leader = false;
+  Status s = id_flight_.Do(
+      index_id, [&]() { return LoadDocumentIndexById(index_id, out_doc_index); }, is_leader);
+  if (is_leader) {
+    if (s.IsNotFound()) {
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      AddNegativeUnlocked(id_negative_expire_ms_, index_id);
+    }
+    return s;
+  }
+
+  if (!s.ok()) {
+    return s;
+  }
+
+  {
+    // loaded by leader
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = id_to_index_.find(index_id);
+    if (iter != id_to_index_.end()) {
+      out_doc_index = iter->second;
+      return Status::OK();
+    }
+  }
+
+  // removed right after loaded
+  return LoadDocumentIndexById(index_id, out_doc_index);
+}
+
+Status DocumentIndexCache::LoadDocumentIndexByKey(const DocumentIndexCacheKey& index_key,
+                                              std::shared_ptr<DocumentIndex>& out_doc_index) {
   int64_t schema_id{0};
   std::string index_name;
   DecodeDocumentIndexCacheKey(index_key, schema_id, index_name);
@@ -127,7 +275,14 @@ Status DocumentIndexCache::SlowGetDocumentIndexByKey(const DocumentIndexCacheKey
   }
 }
 
-Status DocumentIndexCache::SlowGetDocumentIndexById(int64_t index_id, std::shared_ptr<DocumentIndex>& out_doc_index) {
+Status DocumentIndexCache::LoadDocumentIndexById(int64_t index_id, std::shared_ptr<DocumentIndex>& out_doc_index) {
+  pb::meta::IndexDefinitionWithId index_def_with_id;
+  DINGO_RETURN_NOT_OK(FetchIndexDefinitionById(index_id, index_def_with_id));
+  return ProcessIndexDefinitionWithId(index_def_with_id, out_doc_index);
+}
+
+Status DocumentIndexCache::FetchIndexDefinitionById(int64_t index_id,
+                                                  pb::meta::IndexDefinitionWithId& out_index_def_with_id) {
   GetIndexRpc rpc;
   auto* index_id_pb = rpc.MutableRequest()->mutable_index_id();
   index_id_pb->set_entity_type(::dingodb::pb::meta::EntityType::ENTITY_TYPE_INDEX);
@@ -137,17 +292,113 @@ Status DocumentIndexCache::SlowGetDocumentIndexById(int64_t index_id, std::share
   DINGO_RETURN_NOT_OK(stub_.GetMetaRpcController()->SyncCall(rpc));
 
   if (CheckIndexResponse(*rpc.Response())) {
-    return ProcessIndexDefinitionWithId(rpc.Response()->index_definition_with_id(), out_doc_index);
+    out_index_def_with_id = rpc.Response()->index_definition_with_id();
+    return Status::OK();
   } else {
     return Status::NotFound("response check invalid");
   }
 }
 
+void DocumentIndexCache::UpdateIndexDefinition(const pb::meta::IndexDefinitionWithId& index_def_with_id) {
+  int64_t index_id = index_def_with_id.index_id().entity_id();
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  auto iter = id_to_index_.find(index_id);
+  if (iter == id_to_index_.end()) {
+    // removed meanwhile
+    return;
+  }
+
+  auto old_index = iter->second;
+  if (old_index->GetIndexDefWithId().SerializeAsString() == index_def_with_id.SerializeAsString()) {
+    return;
+  }
+
+  auto new_index = std::make_shared<DocumentIndex>(index_def_with_id);
+  auto new_key = GetDocumentIndexCacheKey(*new_index);
+  auto key_iter = index_key_to_id_.find(new_key);
+  if (key_iter != index_key_to_id_.end() && key_iter->second != index_id) {
+    DINGO_LOG(WARNING) << "skip refresh index_id:" << index_id << ", its name is cached by index_id:"
+                       << key_iter->second;
+    return;
+  }
+
+  index_key_to_id_.erase(GetDocumentIndexCacheKey(*old_index));
+  index_key_to_id_[new_key] = index_id;
+  iter->second = new_index;
+  PublishIdSnapshotUnlocked();
+  new_index->UnMarkStale();
+  old_index->MarkStale();
+  DINGO_LOG(INFO) << "refresh changed index definition, index_id:" << index_id;
+}
+
+void DocumentIndexCache::Refresh() {
+  std::vector<int64_t> index_ids;
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    index_ids.reserve(id_to_index_.size());
+    for (const auto& [index_id, index] : id_to_index_) {
+      index_ids.push_back(index_id);
+    }
+  }
+
+  for (int64_t index_id : index_ids) {
+    if (IsStopped()) {
+      return;
+    }
+
+    pb::meta::IndexDefinitionWithId index_def_with_id;
+    Status s = FetchIndexDefinitionById(index_id, index_def_with_id);
+    if (s.IsNotFound()) {
+      DINGO_LOG(INFO) << "index_id:" << index_id << " not found when refresh, remove it from cache";
+      RemoveDocumentIndexById(index_id);
+    } else if (!s.ok()) {
+      DINGO_LOG(WARNING) << "Fail refresh index_id:" << index_id << ", status:" << s.ToString();
+    } else {
+      UpdateIndexDefinition(index_def_with_id);
+    }
+  }
+}
+
+void DocumentIndexCache::Start() {
+  if (FLAGS_index_cache_refresh_interval_s <= 0) {
+    return;
+  }
+  ScheduleRefresh();
+}
+
+void DocumentIndexCache::ScheduleRefresh() {
+  if (IsStopped()) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [self] {
+        if (self->IsStopped()) {
+          return;
+        }
+        self->Refresh();
+        self->ScheduleRefresh();
+      },
+      FLAGS_index_cache_refresh_interval_s * 1000);
+  if (!scheduled) {
+    DINGO_LOG(WARNING) << "Fail schedule document index cache refresh";
+  }
+}
+
+void DocumentIndexCache::PublishIdSnapshotUnlocked() {
+  std::atomic_store(&id_snapshot_, std::shared_ptr<const IdToIndexMap>(std::make_shared<IdToIndexMap>(id_to_index_)));
+}
+
 Status DocumentIndexCache::ProcessIndexDefinitionWithId(const pb::meta::IndexDefinitionWithId& index_def_with_id,
                                                         std::shared_ptr<DocumentIndex>& out_doc_index) {
   int64_t index_id = index_def_with_id.index_id().entity_id();
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
+  id_negative_expire_ms_.erase(index_id);
+  key_negative_expire_ms_.erase(EncodeDocumentIndexCacheKey(index_def_with_id.index_id().parent_entity_id(),
+                                                            index_def_with_id.index_definition().name()));
   auto iter = id_to_index_.find(index_id);
   if (iter != id_to_index_.end()) {
     CHECK_EQ(iter->second->GetName(), index_def_with_id.index_definition().name());
@@ -158,8 +409,12 @@ Status DocumentIndexCache::ProcessIndexDefinitionWithId(const pb::meta::IndexDef
     auto doc_index = std::make_shared<DocumentIndex>(index_def_with_id);
     CHECK(index_key_to_id_.insert({GetDocumentIndexCacheKey(*doc_index), index_id}).second);
     CHECK(id_to_index_.insert({index_id, doc_index}).second);
+    PublishIdSnapshotUnlocked();
     doc_index->UnMarkStale();
     out_doc_index = doc_index;
+    w.unlock();
+
+    stub_.GetAutoIncrementerManager()->MaybePrewarmDocumentIndex(doc_index);
     return Status::OK();
   }
 }
@@ -15,12 +15,16 @@
 #ifndef DINGODB_SDK_DOCUMENT_INDEX_CACHE_H_
 #define DINGODB_SDK_DOCUMENT_INDEX_CACHE_H_
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "common/logging.h"
 #include "sdk/document/document_index.h"
+#include "sdk/utils/single_flight.h"
 #include "sdk/vector.h"
 
 namespace dingodb {
@@ -28,7 +32,9 @@ namespace sdk {
 
 using DocumentIndexCacheKey = std::string;
 
-class DocumentIndexCache {
+// Same loading, negative caching, refresh and lock free lookup by id as VectorIndexCache.
+// NOTE: client stub must outlive the cache
+class DocumentIndexCache : public std::enable_shared_from_this<DocumentIndexCache> {
  public:
   DocumentIndexCache(const DocumentIndexCache &) = delete;
   const DocumentIndexCache &operator=(const DocumentIndexCache &) = delete;
@@ -47,10 +53,35 @@ class DocumentIndexCache {
 
   void RemoveDocumentIndexByKey(const DocumentIndexCacheKey &index_key);
 
+  // all cached index definitions, used by meta cache snapshot
+  std::vector<pb::meta::IndexDefinitionWithId> ListIndexDefinitions();
+
+  // add index loaded from meta cache snapshot, invalid definition is refused
+  Status AddIndexDefinition(const pb::meta::IndexDefinitionWithId &index_def_with_id);
+
+  // start periodic refresh, no-op when refresh is disabled
+  void Start();
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  bool IsStopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // reload all cached index definitions
+  void Refresh();
+
  private:
   Status SlowGetDocumentIndexByKey(const DocumentIndexCacheKey &index_key,
                                    std::shared_ptr<DocumentIndex> &out_doc_index);
   Status SlowGetDocumentIndexById(int64_t index_id, std::shared_ptr<DocumentIndex> &out_doc_index);
+  // load from coordinator without dedup
+  Status LoadDocumentIndexByKey(const DocumentIndexCacheKey &index_key, std::shared_ptr<DocumentIndex> &out_doc_index);
+  Status LoadDocumentIndexById(int64_t index_id, std::shared_ptr<DocumentIndex> &out_doc_index);
+  Status FetchIndexDefinitionById(int64_t index_id, pb::meta::IndexDefinitionWithId &out_index_def_with_id);
+  // replace cached index when its definition changed
+  void UpdateIndexDefinition(const pb::meta::IndexDefinitionWithId &index_def_with_id);
+  void ScheduleRefresh();
+  // must hold write lock
+  void PublishIdSnapshotUnlocked();
   Status ProcessIndexDefinitionWithId(const pb::meta::IndexDefinitionWithId &index_def_with_id,
                                       std::shared_ptr<DocumentIndex> &out_doc_index);
 
@@ -61,7 +92,18 @@ class DocumentIndexCache {
   const ClientStub &stub_;
   mutable std::shared_mutex rw_lock_;
   std::unordered_map<DocumentIndexCacheKey, int64_t> index_key_to_id_;
-  std::unordered_map<int64_t, std::shared_ptr<DocumentIndex>> id_to_index_;
+  using IdToIndexMap = std::unordered_map<int64_t, std::shared_ptr<DocumentIndex>>;
+  IdToIndexMap id_to_index_;
+  // copy of id_to_index_, only accessed by std::atomic_load/std::atomic_store
+  std::shared_ptr<const IdToIndexMap> id_snapshot_;
+
+  SingleFlight<DocumentIndexCacheKey> key_flight_;
+  SingleFlight<int64_t> id_flight_;
+  // expire ms of recently not found index
+  std::unordered_map<DocumentIndexCacheKey, int64_t> key_negative_expire_ms_;
+  std::unordered_map<int64_t, int64_t> id_negative_expire_ms_;
+
+  std::atomic<bool> stopped_{false};
 };
 
 template <class DocumentIndexResponse>
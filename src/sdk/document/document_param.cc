@@ -19,82 +19,56 @@
 #include <memory>
 #include <sstream>
 
+#include "glog/logging.h"
 #include "sdk/document.h"
-#include "sdk/document/document_doc_value_internal.h"
 #include "sdk/types.h"
 
 namespace dingodb {
 namespace sdk {
 
-DocValue::DocValue(const DocValue& other) : data_(new Data(*other.data_)) {}
-
-DocValue& DocValue::operator=(const DocValue& other) {
-  if (this != &other) {
-    data_ = std::make_unique<Data>(*other.data_);
-  }
-  return *this;
-}
-
-DocValue::DocValue() { data_ = std::make_unique<DocValue::Data>(); }
-
-DocValue::~DocValue() = default;
-
-DocValue::DocValue(DocValue&& other) noexcept : data_(std::move(other.data_)) {}
-
-DocValue& DocValue::operator=(DocValue&& other) noexcept {
-  if (this != &other) {
-    data_ = std::move(other.data_);
-  }
-  return *this;
-}
-
 DocValue DocValue::FromInt(int64_t val) {
   DocValue value;
-  value.data_->type = Type::kINT64;
-  value.data_->int_val = val;
+  value.type_ = Type::kINT64;
+  value.int_val_ = val;
   return value;
 }
 
 DocValue DocValue::FromDouble(double val) {
   DocValue value;
-  value.data_->type = Type::kDOUBLE;
-  value.data_->double_val = val;
+  value.type_ = Type::kDOUBLE;
+  value.double_val_ = val;
   return value;
 }
 
 DocValue DocValue::FromString(const std::string& val) {
   DocValue value;
-  value.data_->type = Type::kSTRING;
-  value.data_->string_val = val;
+  value.type_ = Type::kSTRING;
+  value.string_val_ = val;
   return value;
 }
 
 DocValue DocValue::FromBytes(const std::string& val) {
   DocValue value;
-  value.data_->type = Type::kBYTES;
-  value.data_->string_val = val;
+  value.type_ = Type::kBYTES;
+  value.string_val_ = val;
   return value;
 }
 
-Type DocValue::GetType() const { return data_->type; }
-
-int64_t DocValue::IntValue() const { return data_->int_val; }
-
-double DocValue::DoubleValue() const { return data_->double_val; }
-
-std::string DocValue::StringValue() const { return data_->string_val; }
-
 std::string DocValue::ToString() const {
   std::stringstream ss;
-  ss << "DocValue { type: " << TypeToString(data_->type) << ", value: ";
+  ss << "DocValue { type: " << TypeToString(type_) << ", value: ";
 
-  switch (data_->type) {
+  switch (type_) {
     case Type::kINT64:
-      ss << std::to_string(data_->int_val);
+      ss << std::to_string(int_val_);
+      break;
     case Type::kDOUBLE:
-      ss << std::to_string(data_->double_val);
+      ss << std::to_string(double_val_);
+      break;
     case Type::kSTRING:
-      ss << data_->string_val;
+    case Type::kBYTES:
+      ss << string_val_;
+      break;
     default:
       ss << "";
   }
@@ -106,6 +80,11 @@ std::string DocValue::ToString() const {
 
 void Document::AddField(const std::string& key, const DocValue& value) { fields_.emplace(key, value); }
 
+const DocValue* Document::GetField(const std::string& key) const {
+  auto iter = fields_.find(key);
+  return iter == fields_.end() ? nullptr : &iter->second;
+}
+
 std::string Document::ToString() const {
   std::string result = "Document {";
   for (auto it = fields_.begin(); it != fields_.end();) {
@@ -122,6 +101,72 @@ std::string DocWithId::ToString() const {
   return "DocWithId{id: " + std::to_string(id) + ", doc: " + doc.ToString() + "}";
 }
 
+const std::vector<DocValue>* DocumentBatch::GetColumn(const std::string& key) const {
+  auto iter = columns_.find(key);
+  return iter == columns_.end() ? nullptr : &iter->second;
+}
+
+DocWithId DocumentBatch::GetDoc(int64_t idx) const {
+  CHECK_LT(idx, Size()) << "idx out of range";
+  DocWithId doc_with_id;
+  doc_with_id.id = ids_[idx];
+  for (const auto& [key, column] : columns_) {
+    if (column[idx].GetType() != kTypeEnd) {
+      doc_with_id.doc.AddField(key, column[idx]);
+    }
+  }
+  return doc_with_id;
+}
+
+void DocumentBatch::Append(const DocWithId& doc_with_id) {
+  for (const auto& [key, value] : doc_with_id.doc.GetFields()) {
+    AppendValue(key, value);
+  }
+  FinishRow(doc_with_id.id);
+}
+
+void DocumentBatch::AppendRow(const DocumentBatch& other, int64_t idx) {
+  CHECK_LT(idx, other.Size()) << "idx out of range";
+  for (const auto& [key, column] : other.columns_) {
+    if (column[idx].GetType() != kTypeEnd) {
+      AppendValue(key, column[idx]);
+    }
+  }
+  FinishRow(other.ids_[idx]);
+}
+
+void DocumentBatch::Clear() {
+  ids_.clear();
+  columns_.clear();
+}
+
+void DocumentBatch::AppendValue(const std::string& key, DocValue value) {
+  auto& column = columns_[key];
+  // docs before this one have no such key
+  column.resize(ids_.size());
+  column.push_back(std::move(value));
+}
+
+void DocumentBatch::FinishRow(int64_t id) {
+  ids_.push_back(id);
+  for (auto& [key, column] : columns_) {
+    column.resize(ids_.size());
+  }
+}
+
+std::string DocumentBatch::ToString() const {
+  std::ostringstream oss;
+  oss << "DocumentBatch { size: " << Size() << ", columns: [";
+  for (auto it = columns_.begin(); it != columns_.end(); ++it) {
+    if (it != columns_.begin()) {
+      oss << ", ";
+    }
+    oss << it->first;
+  }
+  oss << "] }";
+  return oss.str();
+}
+
 std::string DocQueryResult::ToString() const {
   std::string result = "DocQueryResult { docs: [";
   for (auto it = docs.begin(); it != docs.end();) {
@@ -0,0 +1,193 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "sdk/document.h"
+#include "sdk/document/document_index.h"
+#include "sdk/document/document_index_cache.h"
+#include "sdk/document/document_scan_cursor_internal_data.h"
+#include "sdk/document/document_scan_query_task.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+DocumentScanCursor::Data::~Data() {
+  std::unique_lock<std::mutex> lk(mutex);
+  cond.wait(lk, [this] { return page == nullptr || page->done; });
+}
+
+Status DocumentScanCursor::Data::Init(const DocScanQueryParam& query_param) {
+  if (query_param.max_scan_count <= 0) {
+    return Status::InvalidArgument("max_scan_count must bigger than 0");
+  }
+
+  if (query_param.is_reverse) {
+    if (!(query_param.doc_id_end < query_param.doc_id_start)) {
+      return Status::InvalidArgument("doc_id_end must be less than doc_id_start in reverse scan");
+    }
+  } else {
+    if (query_param.doc_id_end != 0 && !(query_param.doc_id_start < query_param.doc_id_end)) {
+      return Status::InvalidArgument("doc_id_end must be greater than doc_id_start in forward scan");
+    }
+  }
+
+  std::shared_ptr<DocumentIndex> doc_index;
+  DINGO_RETURN_NOT_OK(stub.GetDocumentIndexCache()->GetDocumentIndexById(index_id, doc_index));
+  DCHECK_NOTNULL(doc_index);
+
+  param = query_param;
+  // pages are moved into caller docs
+  param.columnar = false;
+  next_start = param.doc_id_start;
+
+  // partition ids are in order of their start doc id
+  int64_t min_id = param.is_reverse ? param.doc_id_end : param.doc_id_start;
+  int64_t max_id = param.is_reverse ? param.doc_id_start : param.doc_id_end;
+  int64_t first_part_id = doc_index->GetPartitionId(std::max<int64_t>(min_id, 1));
+  int64_t last_part_id = max_id > 0 ? doc_index->GetPartitionId(max_id) : -1;
+
+  bool in_range = false;
+  for (const auto& part_id : doc_index->GetPartitionIds()) {
+    if (part_id == first_part_id) {
+      in_range = true;
+    }
+    if (in_range) {
+      part_ids.push_back(part_id);
+    }
+    if (part_id == last_part_id) {
+      break;
+    }
+  }
+  CHECK(!part_ids.empty()) << "not found partition of index:" << index_id;
+
+  if (param.is_reverse) {
+    std::reverse(part_ids.begin(), part_ids.end());
+  }
+
+  return Status::OK();
+}
+
+bool DocumentScanCursor::Data::InRange(int64_t doc_id) const {
+  if (param.is_reverse) {
+    return doc_id <= param.doc_id_start && doc_id >= param.doc_id_end;
+  } else {
+    return doc_id >= param.doc_id_start && (param.doc_id_end == 0 || doc_id <= param.doc_id_end);
+  }
+}
+
+void DocumentScanCursor::Data::StartPage() {
+  CHECK(page == nullptr);
+  CHECK_LT(part_idx, part_ids.size());
+
+  auto tmp = std::make_unique<Page>();
+  tmp->param = param;
+  tmp->param.doc_id_start = next_start;
+  // range is [start, end], scan task needs start != end, ids out of range are dropped in Advance
+  if (param.is_reverse && tmp->param.doc_id_end >= next_start) {
+    tmp->param.doc_id_end = next_start - 1;
+  } else if (!param.is_reverse && tmp->param.doc_id_end != 0 && tmp->param.doc_id_end <= next_start) {
+    tmp->param.doc_id_end = next_start + 1;
+  }
+
+  tmp->task = std::make_unique<DocumentScanQueryTask>(stub, index_id, tmp->param, tmp->result,
+                                                      std::vector<int64_t>{part_ids[part_idx]});
+  Page* raw = tmp.get();
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    page = std::move(tmp);
+  }
+
+  raw->task->AsyncRun([this, raw](Status status) {
+    std::unique_lock<std::mutex> lk(mutex);
+    raw->status = std::move(status);
+    raw->done = true;
+    // notify under lock, cursor may be destroyed as soon as it sees page done
+    cond.notify_all();
+  });
+}
+
+std::unique_ptr<DocumentScanCursor::Data::Page> DocumentScanCursor::Data::WaitPage() {
+  std::unique_lock<std::mutex> lk(mutex);
+  cond.wait(lk, [this] { return page->done; });
+  return std::move(page);
+}
+
+void DocumentScanCursor::Data::Advance(Page& done_page, std::vector<DocWithId>& out_docs) {
+  auto& docs = done_page.result.docs;
+  bool full = static_cast<int64_t>(docs.size()) >= param.max_scan_count;
+  int64_t last_id = docs.empty() ? 0 : docs.back().id;
+
+  for (auto& doc : docs) {
+    if (InRange(doc.id)) {
+      out_docs.push_back(std::move(doc));
+    }
+  }
+
+  if (full) {
+    // same partition may have more
+    next_start = param.is_reverse ? last_id - 1 : last_id + 1;
+    if (next_start <= 0 || !InRange(next_start)) {
+      finished = true;
+    }
+  } else {
+    part_idx++;
+    if (part_idx >= part_ids.size()) {
+      finished = true;
+    }
+  }
+}
+
+DocumentScanCursor::DocumentScanCursor(Data* data) : data_(data) {}
+
+DocumentScanCursor::~DocumentScanCursor() { delete data_; }
+
+bool DocumentScanCursor::HasNext() const { return !data_->finished; }
+
+Status DocumentScanCursor::Next(std::vector<DocWithId>& out_docs) {
+  out_docs.clear();
+
+  while (!data_->finished) {
+    // page is only set and taken by caller thread
+    if (data_->page == nullptr) {
+      data_->StartPage();
+    }
+    std::unique_ptr<Data::Page> current = data_->WaitPage();
+
+    // position not moved, next call scans the same page again
+    DINGO_RETURN_NOT_OK(current->status);
+
+    data_->Advance(*current, out_docs);
+    if (!data_->finished) {
+      // prefetch while caller handles this page
+      data_->StartPage();
+    }
+
+    if (!out_docs.empty()) {
+      break;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -14,9 +14,12 @@
 
 #include "sdk/document/document_scan_query_task.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "glog/logging.h"
 #include "sdk/common/common.h"
-#include "sdk/document/document_translater.h"
+#include "sdk/document/document_index.h"
 #include "sdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
 
@@ -48,7 +51,7 @@ Status DocumentScanQueryTask::Init() {
   doc_index_ = std::move(tmp);
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
-  auto part_ids = doc_index_->GetPartitionIds();
+  auto part_ids = part_ids_.empty() ? doc_index_->GetPartitionIds() : part_ids_;
 
   for (const auto& part_id : part_ids) {
     next_part_ids_.emplace(part_id);
@@ -71,6 +74,7 @@ void DocumentScanQueryTask::DoAsync() {
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
     auto* sub_task = new DocumentScanQueryPartTask(stub, doc_index_, part_id, scan_query_param_);
@@ -89,6 +93,10 @@ void DocumentScanQueryTask::SubTaskCallback(Status status, DocumentScanQueryPart
       // only return first fail status
       status_ = status;
     }
+  } else if (scan_query_param_.columnar) {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    part_batches_.push_back(sub_task->GetResultBatch());
+    next_part_ids_.erase(sub_task->part_id_);
   } else {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     std::vector<DocWithId> vectors = sub_task->GetResult();
@@ -112,6 +120,11 @@ void DocumentScanQueryTask::SubTaskCallback(Status status, DocumentScanQueryPart
 }
 
 void DocumentScanQueryTask::ConstructResultUnlocked() {
+  if (scan_query_param_.columnar) {
+    ConstructBatchResultUnlocked();
+    return;
+  }
+
   if (scan_query_param_.is_reverse) {
     std::sort(result_docs_.begin(), result_docs_.end(),
               [](const DocWithId& a, const DocWithId& b) { return a.id > b.id; });
@@ -127,10 +140,42 @@ void DocumentScanQueryTask::ConstructResultUnlocked() {
   out_result_.docs = std::move(result_docs_);
 }
 
+void DocumentScanQueryTask::ConstructBatchResultUnlocked() {
+  struct RowRef {
+    int64_t id;
+    size_t batch;
+    int64_t row;
+  };
+
+  std::vector<RowRef> rows;
+  for (size_t batch = 0; batch < part_batches_.size(); batch++) {
+    const auto& ids = part_batches_[batch].GetIds();
+    for (size_t row = 0; row < ids.size(); row++) {
+      rows.push_back({ids[row], batch, static_cast<int64_t>(row)});
+    }
+  }
+
+  if (scan_query_param_.is_reverse) {
+    std::sort(rows.begin(), rows.end(), [](const RowRef& a, const RowRef& b) { return a.id > b.id; });
+  } else {
+    std::sort(rows.begin(), rows.end(), [](const RowRef& a, const RowRef& b) { return a.id < b.id; });
+  }
+
+  if (rows.size() > scan_query_param_.max_scan_count) {
+    rows.resize(scan_query_param_.max_scan_count);
+  }
+
+  // only rows kept are copied
+  out_result_.batch.Clear();
+  for (const auto& row : rows) {
+    out_result_.batch.AppendRow(part_batches_[row.batch], row.row);
+  }
+  part_batches_.clear();
+}
+
 void DocumentScanQueryPartTask::DoAsync() {
-  const auto& range = doc_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> regions;
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  Status s = doc_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -139,6 +184,7 @@ void DocumentScanQueryPartTask::DoAsync() {
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     result_docs_.clear();
+    result_batch_.Clear();
     status_ = Status::OK();
   }
 
@@ -149,8 +195,7 @@ void DocumentScanQueryPartTask::DoAsync() {
     auto rpc = std::make_unique<DocumentScanQueryRpc>();
     FillDocumentScanQueryRpcRequest(rpc->MutableRequest(), region);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -159,6 +204,7 @@ void DocumentScanQueryPartTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
   sub_tasks_count_.store(regions.size());
+  RecordFanOut(regions.size());
 
   for (auto i = 0; i < regions.size(); i++) {
     auto& controller = controllers_[i];
@@ -186,8 +232,8 @@ void DocumentScanQueryPartTask::FillDocumentScanQueryRpcRequest(pb::document::Do
 
 void DocumentScanQueryPartTask::DocumentScanQueryRpcCallback(Status status, DocumentScanQueryRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -196,9 +242,15 @@ void DocumentScanQueryPartTask::DocumentScanQueryRpcCallback(Status status, Docu
     }
   } else {
     {
+      const auto& translater = doc_index_->GetTranslater();
       std::unique_lock<std::shared_mutex> w(rw_lock_);
-      for (const auto& doc_with_id : rpc->Response()->documents()) {
-        result_docs_.emplace_back(DocumentTranslater::InternalDocumentWithIdPB2DocWithId(doc_with_id));
+      if (scan_query_param_.columnar) {
+        translater.AppendDocsToBatch(rpc->Response()->documents(), result_batch_);
+      } else {
+        result_docs_.reserve(result_docs_.size() + rpc->Response()->documents_size());
+        for (const auto& doc_with_id : rpc->Response()->documents()) {
+          result_docs_.emplace_back(translater.DocWithIdFromPB(doc_with_id));
+        }
       }
     }
   }
@@ -16,6 +16,8 @@
 #define DINGODB_SDK_DOCUMENT_SCAN_QUERY_TATSK_H_
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "sdk/client_stub.h"
 #include "sdk/document.h"
@@ -31,9 +33,14 @@ class DocumentScanQueryPartTask;
 
 class DocumentScanQueryTask : public DocumentTask {
  public:
+  // part_ids restricts scan to these partitions, empty means all partitions
   DocumentScanQueryTask(const ClientStub& stub, int64_t index_id, const DocScanQueryParam& query_param,
-                        DocScanQueryResult& out_result)
-      : DocumentTask(stub), index_id_(index_id), scan_query_param_(query_param), out_result_(out_result) {}
+                        DocScanQueryResult& out_result, std::vector<int64_t> part_ids = {})
+      : DocumentTask(stub),
+        index_id_(index_id),
+        scan_query_param_(query_param),
+        out_result_(out_result),
+        part_ids_(std::move(part_ids)) {}
 
   ~DocumentScanQueryTask() override = default;
 
@@ -46,16 +53,20 @@ class DocumentScanQueryTask : public DocumentTask {
   void SubTaskCallback(Status status, DocumentScanQueryPartTask* sub_task);
 
   void ConstructResultUnlocked();
+  void ConstructBatchResultUnlocked();
 
   const int64_t index_id_;
   const DocScanQueryParam& scan_query_param_;
 
   DocScanQueryResult& out_result_;
+  const std::vector<int64_t> part_ids_;
 
   std::shared_ptr<DocumentIndex> doc_index_;
 
   std::shared_mutex rw_lock_;
   std::vector<DocWithId> result_docs_;
+  // results of finished parts when scan_query_param_.columnar, rows are ordered and truncated at last
+  std::vector<DocumentBatch> part_batches_;
   std::set<int64_t> vector_ids_;  // for unique check
   std::set<int64_t> next_part_ids_;
   Status status_;
@@ -76,6 +87,11 @@ class DocumentScanQueryPartTask : public DocumentTask {
     return std::move(result_docs_);
   }
 
+  DocumentBatch GetResultBatch() {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    return std::move(result_batch_);
+  }
+
  private:
   friend class DocumentScanQueryTask;
 
@@ -99,6 +115,8 @@ class DocumentScanQueryPartTask : public DocumentTask {
 
   std::shared_mutex rw_lock_;
   std::vector<DocWithId> result_docs_;
+  // instead of result_docs_ when scan_query_param_.columnar
+  DocumentBatch result_batch_;
   Status status_;
 
   std::atomic<int> sub_tasks_count_{0};
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/document/document_schema_translater.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+#include "sdk/document/document_translater.h"
+
+namespace dingodb {
+namespace sdk {
+
+DocumentSchemaTranslater::DocumentSchemaTranslater(const pb::common::ScalarSchema& schema) {
+  columns_.reserve(schema.fields_size());
+  column_indexes_.reserve(schema.fields_size());
+  for (const auto& field : schema.fields()) {
+    CHECK(column_indexes_.emplace(field.key(), columns_.size()).second) << "duplicate schema key:" << field.key();
+    columns_.push_back(field.key());
+  }
+}
+
+int64_t DocumentSchemaTranslater::ColumnIndex(const std::string& key) const {
+  auto iter = column_indexes_.find(key);
+  return iter == column_indexes_.end() ? -1 : iter->second;
+}
+
+void DocumentSchemaTranslater::FillDocumentWithIdPB(pb::common::DocumentWithId* pb, const DocWithId& doc_with_id,
+                                                    bool with_id) const {
+  if (with_id) {
+    pb->set_id(doc_with_id.id);
+  }
+
+  // values are built in the map of request, no temporary DocumentValue is copied
+  auto* document_data = pb->mutable_document()->mutable_document_data();
+  for (const auto& [key, doc_value] : doc_with_id.doc.fields_) {
+    DocumentTranslater::FillInternalDocumentValuePB(&(*document_data)[key], doc_value);
+  }
+}
+
+DocWithId DocumentSchemaTranslater::DocWithIdFromPB(const pb::common::DocumentWithId& pb) const {
+  DocWithId to_return;
+  to_return.id = pb.id();
+
+  const auto& document_data = pb.document().document_data();
+  auto& fields = to_return.doc.fields_;
+  fields.reserve(document_data.size());
+  for (const auto& [key, doc_value_pb] : document_data) {
+    fields.emplace(key, DocumentTranslater::InternalDocumentValuePb2DocValue(doc_value_pb));
+  }
+
+  return to_return;
+}
+
+DocWithStore DocumentSchemaTranslater::DocWithStoreFromPB(const pb::common::DocumentWithScore& pb) const {
+  DocWithStore to_return;
+  to_return.doc_with_id = DocWithIdFromPB(pb.document_with_id());
+  to_return.score = pb.score();
+  return to_return;
+}
+
+void DocumentSchemaTranslater::AppendDocsToBatch(
+    const google::protobuf::RepeatedPtrField<pb::common::DocumentWithId>& docs, DocumentBatch& batch) const {
+  size_t rows = batch.ids_.size();
+  for (const auto& doc_pb : docs) {
+    if (doc_pb.id() > 0) {
+      rows++;
+    }
+  }
+  batch.ids_.reserve(rows);
+
+  // columns of schema are found in batch once per call, then only by column index
+  std::vector<std::vector<DocValue>*> schema_columns(columns_.size(), nullptr);
+  for (const auto& doc_pb : docs) {
+    if (doc_pb.id() <= 0) {
+      continue;
+    }
+
+    size_t row = batch.ids_.size();
+    for (const auto& [key, doc_value_pb] : doc_pb.document().document_data()) {
+      std::vector<DocValue>* column = nullptr;
+      int64_t index = ColumnIndex(key);
+      if (index < 0) {
+        column = &batch.columns_[key];
+      } else if (schema_columns[index] != nullptr) {
+        column = schema_columns[index];
+      } else {
+        column = &batch.columns_[key];
+        column->reserve(rows);
+        schema_columns[index] = column;
+      }
+
+      // docs before this one have no such key
+      column->resize(row);
+      column->push_back(DocumentTranslater::InternalDocumentValuePb2DocValue(doc_value_pb));
+    }
+    batch.ids_.push_back(doc_pb.id());
+  }
+
+  // padded once for docs at the end without the key, instead of every row
+  for (auto& [key, column] : batch.columns_) {
+    column.resize(batch.ids_.size());
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,63 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_DOCUMENT_SCHEMA_TRANSLATER_H_
+#define DINGODB_SDK_DOCUMENT_SCHEMA_TRANSLATER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "google/protobuf/repeated_ptr_field.h"
+#include "proto/common.pb.h"
+#include "sdk/document.h"
+
+namespace dingodb {
+namespace sdk {
+
+// DocumentTranslater compiled for the scalar schema of one document index, built once with the index.
+// columns are resolved from the schema up front and keyed by column index, so a response is decoded in one pass with
+// rows and columns of the result preallocated, and a request is encoded with values built in place.
+// fields not in the schema are still translated, only slower, the store checks them against the schema.
+class DocumentSchemaTranslater {
+ public:
+  explicit DocumentSchemaTranslater(const pb::common::ScalarSchema& schema);
+
+  ~DocumentSchemaTranslater() = default;
+
+  size_t ColumnCount() const { return columns_.size(); }
+
+  // -1 when key is not in schema
+  int64_t ColumnIndex(const std::string& key) const;
+
+  void FillDocumentWithIdPB(pb::common::DocumentWithId* pb, const DocWithId& doc_with_id, bool with_id = true) const;
+
+  DocWithId DocWithIdFromPB(const pb::common::DocumentWithId& pb) const;
+
+  DocWithStore DocWithStoreFromPB(const pb::common::DocumentWithScore& pb) const;
+
+  // docs with id <= 0 are the ones not found and skipped
+  void AppendDocsToBatch(const google::protobuf::RepeatedPtrField<pb::common::DocumentWithId>& docs,
+                         DocumentBatch& batch) const;
+
+ private:
+  // keys of schema in schema order
+  std::vector<std::string> columns_;
+  std::unordered_map<std::string, int64_t> column_indexes_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_DOCUMENT_SCHEMA_TRANSLATER_H_
@@ -14,9 +14,13 @@
 
 #include "sdk/document/document_search_task.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <set>
+#include <string>
 
 #include "common/logging.h"
 #include "glog/logging.h"
@@ -26,12 +30,65 @@
 #include "sdk/common/param_config.h"
 #include "sdk/document.h"
 #include "sdk/document/document_translater.h"
+#include "sdk/expression/filter_internal_data.h"
+#include "sdk/expression/langchain_expr_evaluator.h"
 #include "sdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
 
 namespace dingodb {
 namespace sdk {
 
+namespace {
+// as comparator of heap, the lowest score is on the top
+bool HigherScore(const DocWithStore& a, const DocWithStore& b) { return a.score > b.score; }
+
+bool HigherPbScore(const pb::common::DocumentWithScore* a, const pb::common::DocumentWithScore* b) {
+  return a->score() > b->score();
+}
+
+// evaluates filter on the response without converting the document
+class PbDocumentEvalRow : public expression::EvalRow {
+ public:
+  explicit PbDocumentEvalRow(const pb::common::DocumentWithScore& pb) : pb_(pb) {}
+
+  ~PbDocumentEvalRow() override = default;
+
+  bool GetValue(const std::string& name, expression::EvalValue& value) const override {
+    const auto& document_data = pb_.document_with_id().document().document_data();
+    auto iter = document_data.find(name);
+    if (iter == document_data.end()) {
+      return false;
+    }
+
+    const auto& field = iter->second.field_value();
+    switch (iter->second.field_type()) {
+      case pb::common::ScalarFieldType::INT64:
+        value.type = kINT64;
+        value.int_value = field.long_data();
+        break;
+      case pb::common::ScalarFieldType::DOUBLE:
+        value.type = kDOUBLE;
+        value.double_value = field.double_data();
+        break;
+      case pb::common::ScalarFieldType::STRING:
+        value.type = kSTRING;
+        value.string_value = field.string_data();
+        break;
+      case pb::common::ScalarFieldType::BYTES:
+        value.type = kBYTES;
+        value.string_value = field.bytes_data();
+        break;
+      default:
+        return false;
+    }
+    return true;
+  }
+
+ private:
+  const pb::common::DocumentWithScore& pb_;
+};
+}  // namespace
+
 Status DocumentSearchTask::Init() {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
 
@@ -46,7 +103,27 @@ Status DocumentSearchTask::Init() {
     next_part_ids_.emplace(part_id);
   }
 
-  DocumentTranslater::FillInternalDocSearchParams(&search_parameter_, search_param_);
+  partial_ = search_param_.partial_result;
+  missing_part_ids_.clear();
+  missing_region_ids_.clear();
+
+  {
+    std::unique_lock<std::mutex> lk(merge_mutex_);
+    merged_.clear();
+  }
+  score_threshold_.store(std::numeric_limits<float>::lowest());
+
+  auto* parameter = request_template_.Mutable()->mutable_parameter();
+  DocumentTranslater::FillInternalDocSearchParams(parameter, search_param_);
+  if (search_param_.filter != nullptr) {
+    // fields of filter are fetched with results, filter is applied by part tasks
+    parameter->set_without_scalar_data(false);
+    parameter->clear_selected_keys();
+    for (const auto& key :
+         search_param_.filter->GetData().KeysToFetch(search_param_.with_scalar_data, search_param_.selected_keys)) {
+      parameter->add_selected_keys(key);
+    }
+  }
 
   return Status::OK();
 }
@@ -65,9 +142,11 @@ void DocumentSearchTask::DoAsync() {
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
-    auto* sub_task = new DocumentSearchPartTask(stub, index_id_, part_id, search_parameter_);
+    auto* sub_task = new DocumentSearchPartTask(stub, doc_index_, part_id, request_template_, score_threshold_,
+                                                search_param_.filter.get(), partial_);
     sub_task->AsyncRun([this, sub_task](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s), sub_task); });
   }
 }
@@ -79,49 +158,120 @@ void DocumentSearchTask::SubTaskCallback(Status status, DocumentSearchPartTask*
     DINGO_LOG(WARNING) << "sub_task: " << sub_task->Name() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
+    if (partial_) {
+      // not retried, results of the other partitions are returned
+      missing_part_ids_.insert(sub_task->part_id_);
+      next_part_ids_.erase(sub_task->part_id_);
+    } else if (status_.ok()) {
       // only return first fail status
       status_ = status;
     }
   } else {
-    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    // merge without task lock, failed parts retry and merge into the same results
     std::vector<DocWithStore> sub_results = sub_task->GetDocSearchResult();
-    std::move(sub_results.begin(), sub_results.end(), std::back_inserter(out_result_.doc_sores));
+    MergeResult(sub_results);
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (!sub_task->missing_region_ids_.empty()) {
+      missing_part_ids_.insert(sub_task->part_id_);
+      missing_region_ids_.insert(sub_task->missing_region_ids_.begin(), sub_task->missing_region_ids_.end());
+    }
     next_part_ids_.erase(sub_task->part_id_);
   }
 
   if (sub_tasks_count_.fetch_sub(1) == 1) {
     Status tmp;
     {
-      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
 
-      std::sort(out_result_.doc_sores.begin(), out_result_.doc_sores.end(),
-                [](const DocWithStore& a, const DocWithStore& b) { return a.score > b.score; });
+    if (tmp.ok()) {
+      ConstructResult();
+    }
 
-      if (search_param_.top_n > 0 && search_param_.top_n < out_result_.doc_sores.size()) {
-        out_result_.doc_sores.resize(search_param_.top_n);
-      }
+    DoAsyncDone(tmp);
+  }
+}
 
-      tmp = status_;
+void DocumentSearchTask::MergeResult(std::vector<DocWithStore>& to_merge) {
+  int64_t limit = search_param_.top_n;
+
+  std::unique_lock<std::mutex> lk(merge_mutex_);
+  if (limit <= 0) {
+    merged_.reserve(merged_.size() + to_merge.size());
+    std::move(to_merge.begin(), to_merge.end(), std::back_inserter(merged_));
+    return;
+  }
+
+  for (auto& doc : to_merge) {
+    if (static_cast<int64_t>(merged_.size()) < limit) {
+      merged_.push_back(std::move(doc));
+      std::push_heap(merged_.begin(), merged_.end(), HigherScore);
+    } else if (doc.score > merged_.front().score) {
+      std::pop_heap(merged_.begin(), merged_.end(), HigherScore);
+      merged_.back() = std::move(doc);
+      std::push_heap(merged_.begin(), merged_.end(), HigherScore);
     }
+  }
 
-    DoAsyncDone(tmp);
+  if (static_cast<int64_t>(merged_.size()) == limit) {
+    score_threshold_.store(merged_.front().score);
   }
 }
 
-Status DocumentSearchPartTask::Init() {
-  std::shared_ptr<DocumentIndex> tmp;
-  DINGO_RETURN_NOT_OK(stub.GetDocumentIndexCache()->GetDocumentIndexById(index_id_, tmp));
-  DCHECK_NOTNULL(tmp);
-  doc_index_ = std::move(tmp);
+void DocumentSearchTask::ConstructResult() {
+  {
+    std::unique_lock<std::mutex> lk(merge_mutex_);
+    if (search_param_.top_n > 0) {
+      // sort_heap leaves it in descending order of score
+      std::sort_heap(merged_.begin(), merged_.end(), HigherScore);
+    } else {
+      std::sort(merged_.begin(), merged_.end(), HigherScore);
+    }
+    out_result_.doc_sores = std::move(merged_);
+    merged_.clear();
+  }
+
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    out_result_.missing_part_ids.assign(missing_part_ids_.begin(), missing_part_ids_.end());
+    out_result_.missing_region_ids.assign(missing_region_ids_.begin(), missing_region_ids_.end());
+  }
+
+  if (search_param_.filter != nullptr) {
+    StripFilterFields();
+  }
+}
+
+void DocumentSearchTask::StripFilterFields() {
+  auto& docs = out_result_.doc_sores;
+  if (search_param_.with_scalar_data && search_param_.selected_keys.empty()) {
+    return;
+  }
+
+  std::set<std::string> selected_keys(search_param_.selected_keys.begin(), search_param_.selected_keys.end());
+  for (auto& doc : docs) {
+    Document selected;
+    if (search_param_.with_scalar_data) {
+      for (const auto& [key, value] : doc.doc_with_id.doc.GetFields()) {
+        if (selected_keys.count(key) > 0) {
+          selected.AddField(key, value);
+        }
+      }
+    }
+    doc.doc_with_id.doc = std::move(selected);
+  }
+}
 
+Status DocumentSearchPartTask::Init() {
+  DCHECK_NOTNULL(doc_index_);
   return Status::OK();
 }
 
 void DocumentSearchPartTask::DoAsync() {
-  const auto& range = doc_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> regions;
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  Status s = doc_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -129,19 +279,22 @@ void DocumentSearchPartTask::DoAsync() {
 
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
+    candidates_.clear();
     search_result_.clear();
+    missing_region_ids_.clear();
     status_ = Status::OK();
   }
 
   controllers_.clear();
   rpcs_.clear();
+  controllers_.reserve(regions.size());
+  rpcs_.reserve(regions.size());
 
   for (const auto& region : regions) {
-    auto rpc = std::make_unique<DocumentSearchRpc>();
+    auto rpc = RpcPool<DocumentSearchRpc>::Acquire();
     FillDocumentSearchRpcRequest(rpc->MutableRequest(), region);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -150,6 +303,7 @@ void DocumentSearchPartTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
   sub_tasks_count_.store(regions.size());
+  RecordFanOut(regions.size());
 
   for (auto i = 0; i < regions.size(); i++) {
     auto& controller = controllers_[i];
@@ -161,26 +315,46 @@ void DocumentSearchPartTask::DoAsync() {
 
 void DocumentSearchPartTask::FillDocumentSearchRpcRequest(pb::document::DocumentSearchRequest* request,
                                                           const std::shared_ptr<Region>& region) {
-  FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
-  *(request->mutable_parameter()) = search_parameter_;
+  request_template_.FillRequest(request, region);
 }
 
 void DocumentSearchPartTask::DocumentSearchRpcCallback(const Status& status, DocumentSearchRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
+    if (partial_) {
+      // the region is reported missing, results of the other regions are kept
+      missing_region_ids_.insert(rpc->Request()->context().region_id());
+    } else if (status_.ok()) {
       // only return first fail status
       status_ = status;
     }
   } else {
-    {
-      std::unique_lock<std::shared_mutex> w(rw_lock_);
-      for (const auto& doc_with_score : rpc->Response()->document_with_scores()) {
-        DocWithStore distance = DocumentTranslater::InternalDocumentWithScore2DocWithStore(doc_with_score);
-        search_result_.push_back(std::move(distance));
+    int64_t limit = request_template_.Get().parameter().top_n();
+    float threshold = score_threshold_.load();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    for (const auto& doc_with_score : rpc->Response()->document_with_scores()) {
+      if (limit > 0 && doc_with_score.score() <= threshold) {
+        // other partitions already have top_n better ones
+        continue;
+      }
+
+      if (filter_ != nullptr && !filter_->GetData().Evaluate(PbDocumentEvalRow(doc_with_score))) {
+        continue;
+      }
+
+      if (limit <= 0) {
+        candidates_.push_back(&doc_with_score);
+      } else if (static_cast<int64_t>(candidates_.size()) < limit) {
+        candidates_.push_back(&doc_with_score);
+        std::push_heap(candidates_.begin(), candidates_.end(), HigherPbScore);
+      } else if (doc_with_score.score() > candidates_.front()->score()) {
+        std::pop_heap(candidates_.begin(), candidates_.end(), HigherPbScore);
+        candidates_.back() = &doc_with_score;
+        std::push_heap(candidates_.begin(), candidates_.end(), HigherPbScore);
       }
     }
   }
@@ -188,12 +362,24 @@ void DocumentSearchPartTask::DocumentSearchRpcCallback(const Status& status, Doc
   if (sub_tasks_count_.fetch_sub(1) == 1) {
     Status tmp;
     {
-      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok()) {
+        MaterializeCandidatesUnlocked();
+      }
       tmp = status_;
     }
     DoAsyncDone(tmp);
   }
 }
 
+void DocumentSearchPartTask::MaterializeCandidatesUnlocked() {
+  const auto& translater = doc_index_->GetTranslater();
+  search_result_.reserve(candidates_.size());
+  for (const auto* doc_with_score : candidates_) {
+    search_result_.push_back(translater.DocWithStoreFromPB(*doc_with_score));
+  }
+  candidates_.clear();
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
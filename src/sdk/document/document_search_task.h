@@ -15,9 +15,14 @@
 #ifndef DINGODB_SDK_VECTOR_SEARCH_TATSK_H_
 #define DINGODB_SDK_VECTOR_SEARCH_TATSK_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "fmt/core.h"
 #include "sdk/client_stub.h"
@@ -25,6 +30,8 @@
 #include "sdk/document/document_index.h"
 #include "sdk/document/document_task.h"
 #include "sdk/rpc/document_service_rpc.h"
+#include "sdk/rpc/rpc_pool.h"
+#include "sdk/rpc/rpc_request_template.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
 namespace dingodb {
@@ -47,14 +54,35 @@ class DocumentSearchTask : public DocumentTask {
 
   void SubTaskCallback(Status status, DocumentSearchPartTask* sub_task);
 
+  // keep the top_n highest scores of merged results, all when top_n <= 0
+  void MergeResult(std::vector<DocWithStore>& to_merge);
+
+  void ConstructResult();
+
+  // drop fields fetched only for filter of search_param_, docs not matching are dropped by part tasks
+  void StripFilterFields();
+
   const int64_t index_id_;
   const DocSearchParam& search_param_;
-  pb::common::DocumentSearchParameter search_parameter_;
+  // search parameter encoded once, copied into every region rpc request
+  RequestTemplate<pb::document::DocumentSearchRequest> request_template_;
+
+  // results merged as part tasks finish, min heap by score when bounded by top_n, parts only merge their
+  // final results so the lock is held once per part
+  std::mutex merge_mutex_;
+  std::vector<DocWithStore> merged_;
+  // lowest score kept once top_n results are merged, candidates not better than it are skipped by part tasks
+  std::atomic<float> score_threshold_;
 
   DocSearchResult& out_result_;
 
   std::shared_ptr<DocumentIndex> doc_index_;
 
+  // best effort, failed partitions and regions are recorded instead of failing the search or retried
+  bool partial_{false};
+  std::set<int64_t> missing_part_ids_;
+  std::set<int64_t> missing_region_ids_;
+
   std::shared_mutex rw_lock_;
   std::set<int64_t> next_part_ids_;
   Status status_;
@@ -64,9 +92,20 @@ class DocumentSearchTask : public DocumentTask {
 
 class DocumentSearchPartTask : public DocumentTask {
  public:
-  DocumentSearchPartTask(const ClientStub& stub, int64_t index_id, int64_t part_id,
-                         const pb::common::DocumentSearchParameter& search_param)
-      : DocumentTask(stub), index_id_(index_id), part_id_(part_id), search_parameter_(search_param) {}
+  // doc_index is the one resolved by parent task, so part task need not look up index cache again
+  // filter is nullptr when search is not filtered on client, when partial failed regions are recorded in
+  // missing_region_ids_ and the part task succeeds with results of the rest
+  DocumentSearchPartTask(const ClientStub& stub, std::shared_ptr<DocumentIndex> doc_index, int64_t part_id,
+                         const RequestTemplate<pb::document::DocumentSearchRequest>& request_template,
+                         const std::atomic<float>& score_threshold, const Filter* filter, bool partial = false)
+      : DocumentTask(stub),
+        index_id_(doc_index->GetId()),
+        part_id_(part_id),
+        request_template_(request_template),
+        score_threshold_(score_threshold),
+        filter_(filter),
+        partial_(partial),
+        doc_index_(std::move(doc_index)) {}
 
   ~DocumentSearchPartTask() override = default;
 
@@ -88,20 +127,30 @@ class DocumentSearchPartTask : public DocumentTask {
 
   void DocumentSearchRpcCallback(const Status& status, DocumentSearchRpc* rpc);
 
+  // convert the kept candidates into search_result_
+  void MaterializeCandidatesUnlocked();
+
   const int64_t index_id_;
   const int64_t part_id_;
-  const pb::common::DocumentSearchParameter& search_parameter_;
+  const RequestTemplate<pb::document::DocumentSearchRequest>& request_template_;
+  const std::atomic<float>& score_threshold_;
+  const Filter* filter_;
+  const bool partial_;
 
-  std::shared_ptr<DocumentIndex> doc_index_;
+  const std::shared_ptr<DocumentIndex> doc_index_;
 
   std::unordered_map<int64_t, std::shared_ptr<Region>> next_batch_region_;
 
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<DocumentSearchRpc>> rpcs_;
+  std::vector<RpcPool<DocumentSearchRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   Status status_;
+  // candidates point into rpcs_ responses, min heap by score when bounded by top_n, only converted when all
+  // regions are done so dropped candidates never copy their fields
+  std::vector<const pb::common::DocumentWithScore*> candidates_;
   std::vector<DocWithStore> search_result_;
+  std::set<int64_t> missing_region_ids_;
 
   std::atomic<int> sub_tasks_count_{0};
 };
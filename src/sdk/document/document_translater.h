@@ -22,7 +22,6 @@
 #include "proto/meta.pb.h"
 #include "sdk/document.h"
 #include "sdk/document/document_codec.h"
-#include "sdk/document/document_doc_value_internal.h"
 #include "sdk/types.h"
 #include "sdk/types_util.h"
 
@@ -68,29 +67,27 @@ class DocumentTranslater {
     }
   }
 
-  static pb::common::DocumentValue DocValue2InternalDocumentValuePB(const DocValue& doc_value) {
-    pb::common::DocumentValue result;
-    result.set_field_type(Type2InternalScalarFieldTypePB(doc_value.data_->type));
+  // fill in place, e.g. the value in document_data map of a request
+  static void FillInternalDocumentValuePB(pb::common::DocumentValue* pb, const DocValue& doc_value) {
+    pb->set_field_type(Type2InternalScalarFieldTypePB(doc_value.type_));
 
-    auto* pb_field = result.mutable_field_value();
-    switch (doc_value.data_->type) {
+    auto* pb_field = pb->mutable_field_value();
+    switch (doc_value.type_) {
       case kINT64:
-        pb_field->set_long_data(doc_value.data_->int_val);
+        pb_field->set_long_data(doc_value.int_val_);
         break;
       case kDOUBLE:
-        pb_field->set_double_data(doc_value.data_->double_val);
+        pb_field->set_double_data(doc_value.double_val_);
         break;
       case kSTRING:
-        pb_field->set_string_data(doc_value.data_->string_val);
+        pb_field->set_string_data(doc_value.string_val_);
         break;
       case kBYTES:
-        pb_field->set_bytes_data(doc_value.data_->string_val);
+        pb_field->set_bytes_data(doc_value.string_val_);
         break;
       default:
-        CHECK(false) << "unsupported doc value type:" << TypeToString(doc_value.data_->type);
+        CHECK(false) << "unsupported doc value type:" << TypeToString(doc_value.type_);
     }
-
-    return result;
   }
 
   static DocValue InternalDocumentValuePb2DocValue(const pb::common::DocumentValue& pb_doc_value) {
@@ -109,38 +106,6 @@ class DocumentTranslater {
     }
   }
 
-  static void FillDocumentWithIdPB(pb::common::DocumentWithId* pb, const DocWithId& doc_with_id, bool with_id = true) {
-    if (with_id) {
-      pb->set_id(doc_with_id.id);
-    }
-
-    auto* doc_pb = pb->mutable_document();
-
-    const auto& doc = doc_with_id.doc;
-    for (const auto& [key, doc_value] : doc.fields_) {
-      doc_pb->mutable_document_data()->emplace(key, DocValue2InternalDocumentValuePB(doc_value));
-    }
-  }
-
-  static DocWithId InternalDocumentWithIdPB2DocWithId(const pb::common::DocumentWithId& pb) {
-    DocWithId to_return;
-    to_return.id = pb.id();
-
-    const auto& doc_pb = pb.document();
-    for (const auto& [key, doc_value_pb] : doc_pb.document_data()) {
-      to_return.doc.AddField(key, InternalDocumentValuePb2DocValue(doc_value_pb));
-    }
-
-    return std::move(to_return);
-  }
-
-  static DocWithStore InternalDocumentWithScore2DocWithStore(const pb::common::DocumentWithScore& pb) {
-    DocWithStore to_return;
-    to_return.doc_with_id = InternalDocumentWithIdPB2DocWithId(pb.document_with_id());
-    to_return.score = pb.score();
-    return std::move(to_return);
-  }
-
   static void FillInternalDocSearchParams(pb::common::DocumentSearchParameter* pb, const DocSearchParam& param) {
     pb->set_top_n(param.top_n);
     pb->set_query_string(param.query_string);
@@ -22,7 +22,6 @@
 #include "sdk/common/common.h"
 #include "sdk/document/document_helper.h"
 #include "sdk/document/document_index.h"
-#include "sdk/document/document_translater.h"
 #include "sdk/status.h"
 
 namespace dingodb {
@@ -108,11 +107,10 @@ void DocumentUpdateTask::DoAsync() {
 
     for (const auto& id : entry.second) {
       int64_t idx = doc_id_to_idx_[id];
-      DocumentTranslater::FillDocumentWithIdPB(rpc->MutableRequest()->add_documents(), docs_[idx]);
+      doc_index_->GetTranslater().FillDocumentWithIdPB(rpc->MutableRequest()->add_documents(), docs_[idx]);
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -121,6 +119,7 @@ void DocumentUpdateTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
   sub_tasks_count_.store(region_docs_to_ids.size());
+  RecordFanOut(region_docs_to_ids.size());
 
   for (auto i = 0; i < region_docs_to_ids.size(); i++) {
     auto& controller = controllers_[i];
@@ -132,8 +131,8 @@ void DocumentUpdateTask::DoAsync() {
 
 void DocumentUpdateTask::DocumentAddRpcCallback(const Status& status, DocumentAddRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -158,4 +157,4 @@ void DocumentUpdateTask::DocumentAddRpcCallback(const Status& status, DocumentAd
 }
 
 }  // namespace sdk
-}  // namespace dingodb
\ No newline at end of file
+}  // namespace dingodb
@@ -0,0 +1,151 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/document.h"
+#include "sdk/document/document_add_task.h"
+#include "sdk/document/document_update_task.h"
+#include "sdk/document/document_writer_internal_data.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// approximate encoded size, only used to cut chunks
+int64_t EstimateDocBytes(const DocWithId& doc_with_id) {
+  int64_t bytes = sizeof(doc_with_id.id);
+  for (const auto& [key, value] : doc_with_id.doc.GetFields()) {
+    bytes += key.size() + sizeof(int64_t) + value.StringValue().size();
+  }
+  return bytes;
+}
+}  // namespace
+
+void DocumentWriter::Data::SendBuffer() {
+  if (buffer.empty()) {
+    return;
+  }
+
+  auto* chunk = new Chunk();
+  chunk->docs.swap(buffer);
+  chunk->bytes = buffer_bytes;
+  buffer_bytes = 0;
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // a chunk bigger than the limit still goes when nothing is in flight
+    cond.wait(lock, [&] {
+      return inflight_chunks == 0 || inflight_bytes + chunk->bytes <= FLAGS_document_writer_max_inflight_bytes;
+    });
+    inflight_bytes += chunk->bytes;
+    inflight_chunks++;
+  }
+
+  // id allocation and translation of this chunk overlap with rpcs of previous chunks
+  if (is_update) {
+    chunk->task = std::make_unique<DocumentUpdateTask>(stub, index_id, chunk->docs);
+  } else {
+    chunk->task = std::make_unique<DocumentAddTask>(stub, index_id, chunk->docs);
+  }
+  chunk->task->AsyncRun([this, chunk](Status status) { ChunkDone(chunk, status); });
+}
+
+void DocumentWriter::Data::ChunkDone(Chunk* chunk, const Status& status) {
+  int64_t bytes = chunk->bytes;
+  int64_t count = chunk->docs.size();
+  // task is in its callback, nothing of it is touched after callback return
+  delete chunk;
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "document writer of index:" << index_id << " write chunk of " << count
+                       << " docs fail: " << status.ToString();
+  }
+
+  std::lock_guard<std::mutex> guard(mutex);
+  if (!status.ok() && this->status.ok()) {
+    // only return first fail status
+    this->status = status;
+  }
+  inflight_bytes -= bytes;
+  inflight_chunks--;
+  // notify under lock, writer may destroy data as soon as no chunk in flight
+  cond.notify_all();
+}
+
+Status DocumentWriter::Data::WaitInflightChunks() {
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [&] { return inflight_chunks == 0; });
+  Status tmp = status;
+  status = Status::OK();
+  return tmp;
+}
+
+DocumentWriter::DocumentWriter(Data* data) : data_(data) {}
+
+DocumentWriter::~DocumentWriter() {
+  Status s = Flush();
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "document writer of index:" << data_->index_id << " flush fail: " << s.ToString();
+  }
+  delete data_;
+}
+
+Status DocumentWriter::Add(DocWithId doc) {
+  {
+    std::lock_guard<std::mutex> guard(data_->mutex);
+    DINGO_RETURN_NOT_OK(data_->status);
+  }
+
+  data_->buffer_bytes += EstimateDocBytes(doc);
+  data_->buffer.push_back(std::move(doc));
+  if (data_->buffer_bytes >= FLAGS_document_writer_chunk_bytes) {
+    data_->SendBuffer();
+  }
+
+  return Status::OK();
+}
+
+Status DocumentWriter::Add(std::vector<DocWithId> docs) {
+  {
+    std::lock_guard<std::mutex> guard(data_->mutex);
+    DINGO_RETURN_NOT_OK(data_->status);
+  }
+
+  for (auto& doc : docs) {
+    data_->buffer_bytes += EstimateDocBytes(doc);
+    data_->buffer.push_back(std::move(doc));
+    if (data_->buffer_bytes >= FLAGS_document_writer_chunk_bytes) {
+      data_->SendBuffer();
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DocumentWriter::Flush() {
+  data_->SendBuffer();
+  return data_->WaitInflightChunks();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,252 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/filter.h"
+
+#include <any>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "sdk/document.h"
+#include "sdk/expression/filter_internal_data.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_encoder.h"
+#include "sdk/expression/langchain_expr_evaluator.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/status.h"
+#include "sdk/types.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+std::shared_ptr<expression::ComparatorExpr> NewComparatorExpr(Filter::Comparator comparator) {
+  switch (comparator) {
+    case Filter::kEq:
+      return std::make_shared<expression::EqComparatorExpr>();
+    case Filter::kNe:
+      return std::make_shared<expression::NeComparatorExpr>();
+    case Filter::kGte:
+      return std::make_shared<expression::GteComparatorExpr>();
+    case Filter::kGt:
+      return std::make_shared<expression::GtComparatorExpr>();
+    case Filter::kLte:
+      return std::make_shared<expression::LteComparatorExpr>();
+    case Filter::kLt:
+      return std::make_shared<expression::LtComparatorExpr>();
+    default:
+      CHECK(false) << "Unknown comparator: " << static_cast<int>(comparator);
+  }
+}
+
+std::shared_ptr<expression::OperatorExpr> NewOperatorExpr(expression::OperatorType operator_type) {
+  switch (operator_type) {
+    case expression::kAnd:
+      return std::make_shared<expression::AndOperatorExpr>();
+    case expression::kOr:
+      return std::make_shared<expression::OrOperatorExpr>();
+    case expression::kNot:
+      return std::make_shared<expression::NotOperatorExpr>();
+    default:
+      CHECK(false) << "Unknown operator type: " << static_cast<int>(operator_type);
+  }
+}
+
+std::any ConvertValue(Type from, Type to, const std::any& value) {
+  if (from == to) {
+    return value;
+  }
+
+  // only conversion allowed by kTypeConversionMatrix
+  CHECK(from == kINT64 && to == kDOUBLE) << "unsupported conversion from " << TypeToString(from) << " to "
+                                         << TypeToString(to);
+  return static_cast<TypeOf<kDOUBLE>>(std::any_cast<TypeOf<kINT64>>(value));
+}
+
+void CheckArgs(const std::vector<std::shared_ptr<const Filter>>& args) {
+  CHECK(!args.empty()) << "filter operator must have arguments";
+  for (const auto& arg : args) {
+    CHECK(arg != nullptr) << "filter argument must not be null";
+  }
+}
+
+}  // namespace
+
+Filter::Filter(Data* data) : data_(data) {}
+
+Filter::~Filter() { delete data_; }
+
+std::shared_ptr<const Filter> Filter::Create(Data* data) { return std::shared_ptr<const Filter>(new Filter(data)); }
+
+std::shared_ptr<const Filter> Filter::Compare(Comparator comparator, const std::string& attribute, int64_t value) {
+  return Create(new Data(comparator, attribute, kINT64, TypeOf<kINT64>(value)));
+}
+
+std::shared_ptr<const Filter> Filter::Compare(Comparator comparator, const std::string& attribute, double value) {
+  return Create(new Data(comparator, attribute, kDOUBLE, TypeOf<kDOUBLE>(value)));
+}
+
+std::shared_ptr<const Filter> Filter::Compare(Comparator comparator, const std::string& attribute, bool value) {
+  return Create(new Data(comparator, attribute, kBOOL, TypeOf<kBOOL>(value)));
+}
+
+std::shared_ptr<const Filter> Filter::Compare(Comparator comparator, const std::string& attribute,
+                                              const std::string& value) {
+  return Create(new Data(comparator, attribute, kSTRING, TypeOf<kSTRING>(value)));
+}
+
+std::shared_ptr<const Filter> Filter::Compare(Comparator comparator, const std::string& attribute,
+                                              const char* value) {
+  return Compare(comparator, attribute, std::string(value));
+}
+
+std::shared_ptr<const Filter> Filter::And(std::vector<std::shared_ptr<const Filter>> args) {
+  CheckArgs(args);
+  return Create(new Data(expression::kAnd, std::move(args)));
+}
+
+std::shared_ptr<const Filter> Filter::Or(std::vector<std::shared_ptr<const Filter>> args) {
+  CheckArgs(args);
+  return Create(new Data(expression::kOr, std::move(args)));
+}
+
+std::shared_ptr<const Filter> Filter::Not(std::shared_ptr<const Filter> arg) {
+  CHECK(arg != nullptr) << "filter argument must not be null";
+  return Create(new Data(expression::kNot, {std::move(arg)}));
+}
+
+bool Filter::Match(const VectorWithId& vector_with_id) const {
+  return data_->Evaluate(expression::VectorScalarEvalRow(vector_with_id.scalar_data));
+}
+
+bool Filter::Match(const DocWithId& doc_with_id) const {
+  return data_->Evaluate(expression::DocumentEvalRow(doc_with_id.doc));
+}
+
+std::string Filter::ToString() const { return data_->ToString(); }
+
+std::string ComparatorToString(Filter::Comparator comparator) {
+  return expression::ComparatorTypeToString(static_cast<expression::ComparatorType>(comparator));
+}
+
+Status Filter::Data::BuildExpr(expression::LangchainExprFactory& expr_factory,
+                               std::shared_ptr<expression::LangchainExpr>& out_expr) const {
+  if (is_operator) {
+    auto tmp = NewOperatorExpr(operator_type);
+    for (const auto& arg : args) {
+      std::shared_ptr<expression::LangchainExpr> sub_expr;
+      DINGO_RETURN_NOT_OK(arg->GetData().BuildExpr(expr_factory, sub_expr));
+      tmp->AddArgument(sub_expr);
+    }
+    out_expr = std::move(tmp);
+    return Status::OK();
+  }
+
+  Type expr_type = type;
+  DINGO_RETURN_NOT_OK(expr_factory.MaybeRemapType(attribute, expr_type));
+
+  auto tmp = NewComparatorExpr(comparator);
+  tmp->var = std::make_shared<expression::Var>(attribute, expr_type);
+  tmp->val = std::make_shared<expression::Val>(attribute, expr_type, ConvertValue(type, expr_type, value));
+  out_expr = std::move(tmp);
+  return Status::OK();
+}
+
+Status Filter::Data::GetOrCompile(const std::string& schema_version,
+                                  const std::unordered_map<std::string, Type>* schema,
+                                  pb::common::CoprocessorV2& out_coprocessor) const {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    auto iter = compiled_.find(schema_version);
+    if (iter != compiled_.end()) {
+      out_coprocessor = *iter->second;
+      return Status::OK();
+    }
+  }
+
+  std::unique_ptr<expression::LangchainExprFactory> expr_factory;
+  if (schema != nullptr) {
+    expr_factory = std::make_unique<expression::SchemaLangchainExprFactory>(*schema);
+  } else {
+    expr_factory = std::make_unique<expression::LangchainExprFactory>();
+  }
+
+  std::shared_ptr<expression::LangchainExpr> expr;
+  DINGO_RETURN_NOT_OK(BuildExpr(*expr_factory, expr));
+
+  expression::LangChainExprEncoder encoder;
+  auto coprocessor = std::make_shared<pb::common::CoprocessorV2>(encoder.EncodeToCoprocessor(expr.get()));
+  out_coprocessor = *coprocessor;
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (compiled_.size() >= kMaxCompiledSchemas) {
+    compiled_.clear();
+  }
+  compiled_.emplace(schema_version, std::move(coprocessor));
+  return Status::OK();
+}
+
+bool Filter::Data::Evaluate(const expression::EvalRow& row) const {
+  std::call_once(eval_expr_once_, [this]() {
+    expression::LangchainExprFactory expr_factory;
+    Status s = BuildExpr(expr_factory, eval_expr_);
+    CHECK(s.ok()) << "build expr without schema fail, status: " << s.ToString();
+  });
+
+  expression::LangchainExprEvaluator evaluator;
+  return evaluator.Evaluate(eval_expr_.get(), row);
+}
+
+void Filter::Data::CollectAttributes(std::set<std::string>& out_attributes) const {
+  if (!is_operator) {
+    out_attributes.insert(attribute);
+    return;
+  }
+
+  for (const auto& arg : args) {
+    arg->GetData().CollectAttributes(out_attributes);
+  }
+}
+
+std::vector<std::string> Filter::Data::KeysToFetch(bool with_scalar_data,
+                                                   const std::vector<std::string>& selected_keys) const {
+  if (with_scalar_data && selected_keys.empty()) {
+    // all keys are fetched anyway
+    return {};
+  }
+
+  std::set<std::string> keys;
+  CollectAttributes(keys);
+  if (with_scalar_data) {
+    keys.insert(selected_keys.begin(), selected_keys.end());
+  }
+  return std::vector<std::string>(keys.begin(), keys.end());
+}
+
+std::string Filter::Data::ToString() const {
+  expression::LangchainExprFactory expr_factory;
+  std::shared_ptr<expression::LangchainExpr> expr;
+  Status s = BuildExpr(expr_factory, expr);
+  CHECK(s.ok()) << "build expr without schema fail, status: " << s.ToString();
+  return expr->ToString();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
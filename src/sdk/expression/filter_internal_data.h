@@ -0,0 +1,99 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_EXPRESSION_FILTER_INTERNAL_DATA_H_
+#define DINGODB_SDK_EXPRESSION_FILTER_INTERNAL_DATA_H_
+
+#include <any>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "proto/common.pb.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_evaluator.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/filter.h"
+#include "sdk/status.h"
+#include "sdk/types.h"
+
+namespace dingodb {
+namespace sdk {
+
+class Filter::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  Data(expression::OperatorType operator_type, std::vector<std::shared_ptr<const Filter>> args)
+      : is_operator(true), operator_type(operator_type), args(std::move(args)) {}
+
+  Data(Comparator comparator, std::string attribute, Type type, std::any value)
+      : is_operator(false),
+        comparator(comparator),
+        attribute(std::move(attribute)),
+        type(type),
+        value(std::move(value)) {}
+
+  ~Data() = default;
+
+  // attribute types are remapped by expr_factory, same as the expr created from json
+  Status BuildExpr(expression::LangchainExprFactory& expr_factory,
+                   std::shared_ptr<expression::LangchainExpr>& out_expr) const;
+
+  // encoded once per schema_version, schema is nullptr when index has no scalar schema
+  Status GetOrCompile(const std::string& schema_version, const std::unordered_map<std::string, Type>* schema,
+                      pb::common::CoprocessorV2& out_coprocessor) const;
+
+  bool Evaluate(const expression::EvalRow& row) const;
+
+  // attributes compared by this filter and its args
+  void CollectAttributes(std::set<std::string>& out_attributes) const;
+
+  // scalar keys to fetch so filter can be evaluated on client, empty means all keys
+  std::vector<std::string> KeysToFetch(bool with_scalar_data, const std::vector<std::string>& selected_keys) const;
+
+  std::string ToString() const;
+
+  const bool is_operator;
+
+  // operator
+  const expression::OperatorType operator_type{expression::kAnd};
+  const std::vector<std::shared_ptr<const Filter>> args;
+
+  // comparator
+  const Comparator comparator{kEq};
+  const std::string attribute;
+  const Type type{kBOOL};
+  const std::any value;
+
+ private:
+  // a filter is mostly used with one index, bound the encoded coprocessors when used with many schemas
+  static constexpr size_t kMaxCompiledSchemas = 8;
+
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::string, std::shared_ptr<const pb::common::CoprocessorV2>> compiled_;
+
+  // built without schema on first evaluation, values keep the types given by caller
+  mutable std::once_flag eval_expr_once_;
+  mutable std::shared_ptr<expression::LangchainExpr> eval_expr_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_EXPRESSION_FILTER_INTERNAL_DATA_H_
@@ -0,0 +1,101 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/expression/langchain_expr_cache.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_encoder.h"
+#include "sdk/expression/langchain_expr_factory.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+Status LangchainExprCache::Compile(const std::string& expr_json, const std::unordered_map<std::string, Type>* schema,
+                                   pb::common::CoprocessorV2& out_coprocessor) {
+  std::unique_ptr<LangchainExprFactory> expr_factory;
+  if (schema != nullptr) {
+    expr_factory = std::make_unique<SchemaLangchainExprFactory>(*schema);
+  } else {
+    expr_factory = std::make_unique<LangchainExprFactory>();
+  }
+
+  std::shared_ptr<LangchainExpr> expr;
+  DINGO_RETURN_NOT_OK(expr_factory->CreateExpr(expr_json, expr));
+
+  LangChainExprEncoder encoder;
+  out_coprocessor = encoder.EncodeToCoprocessor(expr.get());
+  return Status::OK();
+}
+
+std::string LangchainExprCache::EncodeKey(const std::string& expr_json, const std::string& schema_version) {
+  // length prefix keeps keys of different (schema_version, json) pairs apart
+  std::string key = std::to_string(schema_version.size());
+  key.push_back(':');
+  key.append(schema_version);
+  key.append(expr_json);
+  return key;
+}
+
+Status LangchainExprCache::GetOrCompile(const std::string& expr_json, const std::string& schema_version,
+                                        const std::unordered_map<std::string, Type>* schema,
+                                        pb::common::CoprocessorV2& out_coprocessor) {
+  if (!Enabled()) {
+    return Compile(expr_json, schema, out_coprocessor);
+  }
+
+  std::string key = EncodeKey(expr_json, schema_version);
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    auto iter = entries_.find(key);
+    if (iter != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, iter->second);
+      out_coprocessor = *iter->second->coprocessor;
+      return Status::OK();
+    }
+  }
+
+  // compile out of lock, concurrent misses of the same key may compile twice
+  auto coprocessor = std::make_shared<pb::common::CoprocessorV2>();
+  DINGO_RETURN_NOT_OK(Compile(expr_json, schema, *coprocessor));
+  out_coprocessor = *coprocessor;
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (entries_.find(key) != entries_.end()) {
+    return Status::OK();
+  }
+
+  lru_.push_front({std::move(key), std::move(coprocessor)});
+  entries_.emplace(lru_.front().key, lru_.begin());
+  while (static_cast<int64_t>(lru_.size()) > capacity_) {
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+
+  return Status::OK();
+}
+
+int64_t LangchainExprCache::Size() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  return lru_.size();
+}
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
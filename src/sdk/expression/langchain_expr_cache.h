@@ -0,0 +1,78 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_CACHE_H_
+#define DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "proto/common.pb.h"
+#include "sdk/status.h"
+#include "sdk/types.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+// LRU cache of coprocessors compiled from langchain expr json, disabled when capacity <= 0.
+// Filters are usually templated and repeat, so parse and encode are done once per json and scalar schema.
+// Key is the json and schema_version, any string identifying the scalar schema used to remap attribute types.
+class LangchainExprCache {
+ public:
+  LangchainExprCache(const LangchainExprCache&) = delete;
+  const LangchainExprCache& operator=(const LangchainExprCache&) = delete;
+
+  explicit LangchainExprCache(int64_t capacity) : capacity_(capacity) {}
+
+  ~LangchainExprCache() = default;
+
+  bool Enabled() const { return capacity_ > 0; }
+
+  // schema is nullptr when index has no scalar schema, compile errors are not cached
+  Status GetOrCompile(const std::string& expr_json, const std::string& schema_version,
+                      const std::unordered_map<std::string, Type>* schema, pb::common::CoprocessorV2& out_coprocessor);
+
+  int64_t Size();
+
+  static Status Compile(const std::string& expr_json, const std::unordered_map<std::string, Type>* schema,
+                        pb::common::CoprocessorV2& out_coprocessor);
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const pb::common::CoprocessorV2> coprocessor;
+  };
+
+  static std::string EncodeKey(const std::string& expr_json, const std::string& schema_version);
+
+  const int64_t capacity_;
+
+  std::mutex mutex_;
+  // front is the most recently used
+  std::list<Entry> lru_;
+  // key views into Entry::key
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> entries_;
+};
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_CACHE_H_
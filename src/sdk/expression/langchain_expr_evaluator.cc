@@ -0,0 +1,211 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/expression/langchain_expr_evaluator.h"
+
+#include <any>
+#include <cstdint>
+#include <string>
+
+#include "glog/logging.h"
+#include "sdk/expression/langchain_expr.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+namespace {
+bool IsNumber(Type type) { return type == kINT64 || type == kDOUBLE; }
+
+double AsDouble(const EvalValue& value) {
+  return value.type == kINT64 ? static_cast<double>(value.int_value) : value.double_value;
+}
+
+template <typename T>
+int ThreeWay(const T& a, const T& b) {
+  if (a < b) {
+    return -1;
+  }
+  return b < a ? 1 : 0;
+}
+}  // namespace
+
+bool VectorScalarEvalRow::GetValue(const std::string& name, EvalValue& value) const {
+  auto iter = scalar_data_.find(name);
+  if (iter == scalar_data_.end() || iter->second.fields.empty()) {
+    return false;
+  }
+
+  const ScalarField& field = iter->second.fields.front();
+  value.type = iter->second.type;
+  switch (value.type) {
+    case kBOOL:
+      value.bool_value = field.bool_data;
+      break;
+    case kINT64:
+      value.int_value = field.long_data;
+      break;
+    case kDOUBLE:
+      value.double_value = field.double_data;
+      break;
+    case kSTRING:
+    case kBYTES:
+      value.string_value = field.string_data;
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool DocumentEvalRow::GetValue(const std::string& name, EvalValue& value) const {
+  const DocValue* doc_value = doc_.GetField(name);
+  if (doc_value == nullptr) {
+    return false;
+  }
+
+  value.type = doc_value->GetType();
+  switch (value.type) {
+    case kINT64:
+      value.int_value = doc_value->IntValue();
+      break;
+    case kDOUBLE:
+      value.double_value = doc_value->DoubleValue();
+      break;
+    case kSTRING:
+    case kBYTES:
+      value.string_value = doc_value->StringValue();
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool LangchainExprEvaluator::Evaluate(LangchainExpr* expr, const EvalRow& row) {
+  // rows are never written by the visitor
+  return std::any_cast<bool>(Visit(expr, const_cast<EvalRow*>(&row)));
+}
+
+std::any LangchainExprEvaluator::VisitAndOperatorExpr(AndOperatorExpr* expr, void* target) {
+  for (const auto& arg : expr->args) {
+    if (!std::any_cast<bool>(Visit(arg.get(), target))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::any LangchainExprEvaluator::VisitOrOperatorExpr(OrOperatorExpr* expr, void* target) {
+  for (const auto& arg : expr->args) {
+    if (std::any_cast<bool>(Visit(arg.get(), target))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::any LangchainExprEvaluator::VisitNotOperatorExpr(NotOperatorExpr* expr, void* target) {
+  CHECK_EQ(expr->args.size(), 1) << "not operator must have one argument";
+  return !std::any_cast<bool>(Visit(expr->args[0].get(), target));
+}
+
+std::any LangchainExprEvaluator::VisitEqComparatorExpr(EqComparatorExpr* expr, void* target) {
+  int cmp;
+  return CompareVarVal(expr, target, cmp) && cmp == 0;
+}
+
+std::any LangchainExprEvaluator::VisitNeComparatorExpr(NeComparatorExpr* expr, void* target) {
+  int cmp;
+  return CompareVarVal(expr, target, cmp) && cmp != 0;
+}
+
+std::any LangchainExprEvaluator::VisitGteComparatorExpr(GteComparatorExpr* expr, void* target) {
+  int cmp;
+  return CompareVarVal(expr, target, cmp) && cmp >= 0;
+}
+
+std::any LangchainExprEvaluator::VisitGtComparatorExpr(GtComparatorExpr* expr, void* target) {
+  int cmp;
+  return CompareVarVal(expr, target, cmp) && cmp > 0;
+}
+
+std::any LangchainExprEvaluator::VisitLteComparatorExpr(LteComparatorExpr* expr, void* target) {
+  int cmp;
+  return CompareVarVal(expr, target, cmp) && cmp <= 0;
+}
+
+std::any LangchainExprEvaluator::VisitLtComparatorExpr(LtComparatorExpr* expr, void* target) {
+  int cmp;
+  return CompareVarVal(expr, target, cmp) && cmp < 0;
+}
+
+std::any LangchainExprEvaluator::VisitVar(Var* expr, void* target) {
+  const auto* row = static_cast<const EvalRow*>(target);
+  EvalValue value;
+  if (!row->GetValue(expr->name, value)) {
+    return {};
+  }
+  return value;
+}
+
+std::any LangchainExprEvaluator::VisitVal(Val* expr, void* target) {
+  (void)target;
+  EvalValue value;
+  value.type = expr->type;
+  switch (expr->type) {
+    case kBOOL:
+      value.bool_value = std::any_cast<TypeOf<kBOOL>>(expr->value);
+      break;
+    case kINT64:
+      value.int_value = std::any_cast<TypeOf<kINT64>>(expr->value);
+      break;
+    case kDOUBLE:
+      value.double_value = std::any_cast<TypeOf<kDOUBLE>>(expr->value);
+      break;
+    case kSTRING:
+      value.string_value = std::any_cast<TypeOf<kSTRING>>(expr->value);
+      break;
+    default:
+      CHECK(false) << "unsupported val type: " << TypeToString(expr->type);
+  }
+  return value;
+}
+
+bool LangchainExprEvaluator::CompareVarVal(ComparatorExpr* expr, void* target, int& out_cmp) {
+  std::any var = Visit(expr->var.get(), target);
+  if (!var.has_value()) {
+    return false;
+  }
+  std::any val = Visit(expr->val.get(), target);
+
+  const auto& a = std::any_cast<const EvalValue&>(var);
+  const auto& b = std::any_cast<const EvalValue&>(val);
+  if (a.type == kINT64 && b.type == kINT64) {
+    out_cmp = ThreeWay(a.int_value, b.int_value);
+  } else if (IsNumber(a.type) && IsNumber(b.type)) {
+    out_cmp = ThreeWay(AsDouble(a), AsDouble(b));
+  } else if (a.type == kBOOL && b.type == kBOOL) {
+    out_cmp = ThreeWay(a.bool_value, b.bool_value);
+  } else if ((a.type == kSTRING || a.type == kBYTES) && b.type == kSTRING) {
+    out_cmp = a.string_value.compare(b.string_value);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
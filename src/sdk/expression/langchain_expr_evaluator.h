@@ -0,0 +1,117 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_EVALUATOR_H_
+#define DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_EVALUATOR_H_
+
+#include <any>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "sdk/document.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_visitor.h"
+#include "sdk/types.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+struct EvalValue {
+  Type type{kTypeEnd};
+  bool bool_value{false};
+  int64_t int_value{0};
+  double double_value{0.0};
+  std::string string_value;
+};
+
+// attributes of the row a filter is evaluated against
+class EvalRow {
+ public:
+  virtual ~EvalRow() = default;
+
+  // false when the row has no such attribute
+  virtual bool GetValue(const std::string& name, EvalValue& value) const = 0;
+};
+
+// first field of each scalar value, same as what server side filter sees of a scalar
+class VectorScalarEvalRow : public EvalRow {
+ public:
+  explicit VectorScalarEvalRow(const std::map<std::string, ScalarValue>& scalar_data) : scalar_data_(scalar_data) {}
+
+  ~VectorScalarEvalRow() override = default;
+
+  bool GetValue(const std::string& name, EvalValue& value) const override;
+
+ private:
+  const std::map<std::string, ScalarValue>& scalar_data_;
+};
+
+class DocumentEvalRow : public EvalRow {
+ public:
+  explicit DocumentEvalRow(const Document& doc) : doc_(doc) {}
+
+  ~DocumentEvalRow() override = default;
+
+  bool GetValue(const std::string& name, EvalValue& value) const override;
+
+ private:
+  const Document& doc_;
+};
+
+// Evaluates expr against one row on client, e.g. to filter results already fetched without a server round trip.
+// int64 and double compare as numbers, a comparator on an absent attribute or on values of other types is false.
+class LangchainExprEvaluator : public LangchainExprVisitor {
+ public:
+  LangchainExprEvaluator() = default;
+  ~LangchainExprEvaluator() override = default;
+
+  bool Evaluate(LangchainExpr* expr, const EvalRow& row);
+
+  std::any VisitAndOperatorExpr(AndOperatorExpr* expr, void* target) override;
+
+  std::any VisitOrOperatorExpr(OrOperatorExpr* expr, void* target) override;
+
+  std::any VisitNotOperatorExpr(NotOperatorExpr* expr, void* target) override;
+
+  std::any VisitEqComparatorExpr(EqComparatorExpr* expr, void* target) override;
+
+  std::any VisitNeComparatorExpr(NeComparatorExpr* expr, void* target) override;
+
+  std::any VisitGteComparatorExpr(GteComparatorExpr* expr, void* target) override;
+
+  std::any VisitGtComparatorExpr(GtComparatorExpr* expr, void* target) override;
+
+  std::any VisitLteComparatorExpr(LteComparatorExpr* expr, void* target) override;
+
+  std::any VisitLtComparatorExpr(LtComparatorExpr* expr, void* target) override;
+
+  // EvalValue of the row, empty when absent
+  std::any VisitVar(Var* expr, void* target) override;
+
+  // EvalValue of the literal
+  std::any VisitVal(Val* expr, void* target) override;
+
+ private:
+  // false when not comparable, otherwise out_cmp is <0, 0, >0 as var is less, equal or greater than val
+  bool CompareVarVal(ComparatorExpr* expr, void* target, int& out_cmp);
+};
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_EVALUATOR_H_
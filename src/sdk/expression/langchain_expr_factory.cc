@@ -29,6 +29,9 @@ namespace sdk {
 namespace expression {
 
 namespace {
+Status CreateExprFromJson(LangchainExprFactory* expr_factory, const nlohmann::json& j,
+                          std::shared_ptr<LangchainExpr>& expr);
+
 Status CreateOperatorExpr(LangchainExprFactory* expr_factory, const nlohmann::json& j,
                           std::shared_ptr<LangchainExpr>& expr) {
   std::shared_ptr<OperatorExpr> tmp;
@@ -44,11 +47,10 @@ Status CreateOperatorExpr(LangchainExprFactory* expr_factory, const nlohmann::js
     return Status::InvalidArgument("Unknown operator type: " + operator_type);
   }
 
+  // build sub expr from the parsed json directly, dump and parse again costs O(depth) parses of nested args
   for (const auto& arg : j.at("arguments")) {
-    std::string json_str = arg.dump();
-
     std::shared_ptr<LangchainExpr> sub_expr;
-    DINGO_RETURN_NOT_OK(expr_factory->CreateExpr(json_str, sub_expr));
+    DINGO_RETURN_NOT_OK(CreateExprFromJson(expr_factory, arg, sub_expr));
     tmp->AddArgument(sub_expr);
   }
 
@@ -120,21 +122,31 @@ Status CreateComparatorExpr(LangchainExprFactory* expr_factory, const nlohmann::
   return Status::OK();
 }
 
-}  // namespace
-
-Status LangchainExprFactory::CreateExpr(const std::string& expr_json_str, std::shared_ptr<LangchainExpr>& expr) {
+Status CreateExprFromJson(LangchainExprFactory* expr_factory, const nlohmann::json& j,
+                          std::shared_ptr<LangchainExpr>& expr) {
   std::shared_ptr<LangchainExpr> tmp;
 
-  nlohmann::json j = nlohmann::json::parse(expr_json_str);
   std::string type = j.at("type");
   if (type == "operator") {
-    DINGO_RETURN_NOT_OK(CreateOperatorExpr(this, j, tmp));
+    DINGO_RETURN_NOT_OK(CreateOperatorExpr(expr_factory, j, tmp));
   } else if (type == "comparator") {
-    DINGO_RETURN_NOT_OK(CreateComparatorExpr(this, j, tmp));
+    DINGO_RETURN_NOT_OK(CreateComparatorExpr(expr_factory, j, tmp));
   } else {
     return Status::InvalidArgument("Unknown expression type: " + type);
   }
 
+  expr = std::move(tmp);
+  return Status::OK();
+}
+
+}  // namespace
+
+Status LangchainExprFactory::CreateExpr(const std::string& expr_json_str, std::shared_ptr<LangchainExpr>& expr) {
+  std::shared_ptr<LangchainExpr> tmp;
+
+  nlohmann::json j = nlohmann::json::parse(expr_json_str);
+  DINGO_RETURN_NOT_OK(CreateExprFromJson(this, j, tmp));
+
   expr = std::move(tmp);
 
   VLOG(kSdkVlogLevel) << "expr_json_str: " << expr_json_str << " expr: " << expr->ToString();
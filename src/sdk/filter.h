@@ -0,0 +1,80 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_FILTER_H_
+#define DINGODB_SDK_FILTER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+
+struct DocWithId;
+struct VectorWithId;
+
+// Typed scalar filter, the same predicates as langchain expr json without building and parsing json.
+// A filter is immutable once built and can be shared by any number of searches from any thread, it is encoded to
+// coprocessor once per scalar schema of the index searched, not per search.
+class Filter {
+ public:
+  enum Comparator : uint8_t { kEq, kNe, kGte, kGt, kLte, kLt };
+
+  Filter(const Filter&) = delete;
+  const Filter& operator=(const Filter&) = delete;
+
+  ~Filter();
+
+  // value type gives the attribute type, int64 is widened to double when scalar schema of index says so
+  static std::shared_ptr<const Filter> Compare(Comparator comparator, const std::string& attribute, int64_t value);
+  static std::shared_ptr<const Filter> Compare(Comparator comparator, const std::string& attribute, double value);
+  static std::shared_ptr<const Filter> Compare(Comparator comparator, const std::string& attribute, bool value);
+  static std::shared_ptr<const Filter> Compare(Comparator comparator, const std::string& attribute,
+                                               const std::string& value);
+  // keeps string literal from converting to bool
+  static std::shared_ptr<const Filter> Compare(Comparator comparator, const std::string& attribute,
+                                               const char* value);
+
+  static std::shared_ptr<const Filter> And(std::vector<std::shared_ptr<const Filter>> args);
+  static std::shared_ptr<const Filter> Or(std::vector<std::shared_ptr<const Filter>> args);
+  static std::shared_ptr<const Filter> Not(std::shared_ptr<const Filter> arg);
+
+  // evaluated on client against scalar data of vector or fields of doc, e.g. to check how selective a filter is
+  // or filter results already fetched. A comparator on an absent attribute is false.
+  bool Match(const VectorWithId& vector_with_id) const;
+  bool Match(const DocWithId& doc_with_id) const;
+
+  std::string ToString() const;
+
+  // internal
+  class Data;
+  const Data& GetData() const { return *data_; }
+
+ private:
+  explicit Filter(Data* data);
+
+  static std::shared_ptr<const Filter> Create(Data* data);
+
+  // own
+  Data* data_;
+};
+
+std::string ComparatorToString(Filter::Comparator comparator);
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_FILTER_H_
@@ -0,0 +1,309 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/hybrid/hybrid_search.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/document.h"
+#include "sdk/document/document_batch_query_task.h"
+#include "sdk/document/document_search_task.h"
+#include "sdk/hybrid_search.h"
+#include "sdk/status.h"
+#include "sdk/utils/async_util.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_batch_query_task.h"
+#include "sdk/vector/vector_search_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+Status CheckParam(const HybridSearchParam& param) {
+  if (param.topk <= 0) {
+    return Status::InvalidArgument("topk must be positive");
+  }
+  if (param.vector_index_id <= 0 || param.doc_index_id <= 0) {
+    return Status::InvalidArgument("vector_index_id and doc_index_id must be positive");
+  }
+  if (param.vector_topk < 0 || param.doc_top_n < 0) {
+    return Status::InvalidArgument("vector_topk and doc_top_n must not be negative");
+  }
+  if (param.fusion_type == kReciprocalRankFusion && param.rrf_k < 0) {
+    return Status::InvalidArgument("rrf_k must not be negative");
+  }
+  const auto& vector = param.target_vector.vector;
+  if (vector.float_values.empty() && vector.binary_values.empty()) {
+    return Status::InvalidArgument("target_vector is empty");
+  }
+  if (param.query_string.empty()) {
+    return Status::InvalidArgument("query_string is empty");
+  }
+  return Status::OK();
+}
+
+// score of each candidate min max normalized to [0, 1], best is 1
+std::vector<float> Normalize(const std::vector<float>& scores, bool smaller_is_better) {
+  std::vector<float> normalized(scores.size(), 1.0f);
+  if (scores.empty()) {
+    return normalized;
+  }
+
+  auto [min_iter, max_iter] = std::minmax_element(scores.begin(), scores.end());
+  float min = *min_iter;
+  float max = *max_iter;
+  if (max <= min) {
+    return normalized;
+  }
+
+  for (size_t i = 0; i < scores.size(); i++) {
+    normalized[i] = smaller_is_better ? (max - scores[i]) / (max - min) : (scores[i] - min) / (max - min);
+  }
+  return normalized;
+}
+
+}  // namespace
+
+std::string HybridSearchHit::ToString() const {
+  return fmt::format("HybridSearchHit(id: {}, score: {}, vector_rank: {}, doc_rank: {}, distance: {}, doc_score: {})",
+                     id, score, vector_rank, doc_rank, distance, doc_score);
+}
+
+std::string HybridSearchResult::ToString() const {
+  std::string result = "HybridSearchResult(hits: [";
+  for (size_t i = 0; i < hits.size(); i++) {
+    if (i > 0) {
+      result += ", ";
+    }
+    result += hits[i].ToString();
+  }
+  result += "])";
+  return result;
+}
+
+void FuseHybridResults(const HybridSearchParam& param, const std::vector<VectorWithDistance>& vector_results,
+                       const std::vector<DocWithStore>& doc_results, std::vector<HybridSearchHit>& out_hits) {
+  out_hits.clear();
+
+  // rank order of each result, results of search tasks are not necessarily sorted
+  std::vector<size_t> vector_order(vector_results.size());
+  for (size_t i = 0; i < vector_order.size(); i++) {
+    vector_order[i] = i;
+  }
+  std::stable_sort(vector_order.begin(), vector_order.end(), [&](size_t a, size_t b) {
+    return vector_results[a].distance < vector_results[b].distance;
+  });
+
+  std::vector<size_t> doc_order(doc_results.size());
+  for (size_t i = 0; i < doc_order.size(); i++) {
+    doc_order[i] = i;
+  }
+  std::stable_sort(doc_order.begin(), doc_order.end(),
+                   [&](size_t a, size_t b) { return doc_results[a].score > doc_results[b].score; });
+
+  std::vector<float> vector_scores;
+  std::vector<float> doc_scores;
+  if (param.fusion_type == kWeightedScoreFusion) {
+    std::vector<float> distances;
+    distances.reserve(vector_order.size());
+    for (size_t idx : vector_order) {
+      distances.push_back(vector_results[idx].distance);
+    }
+    vector_scores = Normalize(distances, true);
+
+    std::vector<float> scores;
+    scores.reserve(doc_order.size());
+    for (size_t idx : doc_order) {
+      scores.push_back(doc_results[idx].score);
+    }
+    doc_scores = Normalize(scores, false);
+  }
+
+  std::unordered_map<int64_t, HybridSearchHit> id_to_hit;
+  for (size_t rank = 0; rank < vector_order.size(); rank++) {
+    const auto& result = vector_results[vector_order[rank]];
+    auto& hit = id_to_hit[result.vector_data.id];
+    if (hit.vector_rank > 0) {
+      // duplicate id, keep the better one
+      continue;
+    }
+    hit.id = result.vector_data.id;
+    hit.vector_rank = static_cast<int32_t>(rank + 1);
+    hit.distance = result.distance;
+    hit.score += param.fusion_type == kWeightedScoreFusion ? param.vector_weight * vector_scores[rank]
+                                                           : param.vector_weight / (param.rrf_k + rank + 1);
+  }
+
+  for (size_t rank = 0; rank < doc_order.size(); rank++) {
+    const auto& result = doc_results[doc_order[rank]];
+    auto& hit = id_to_hit[result.doc_with_id.id];
+    if (hit.doc_rank > 0) {
+      continue;
+    }
+    hit.id = result.doc_with_id.id;
+    hit.doc_rank = static_cast<int32_t>(rank + 1);
+    hit.doc_score = result.score;
+    hit.score += param.fusion_type == kWeightedScoreFusion ? param.doc_weight * doc_scores[rank]
+                                                           : param.doc_weight / (param.rrf_k + rank + 1);
+  }
+
+  out_hits.reserve(id_to_hit.size());
+  for (auto& [id, hit] : id_to_hit) {
+    out_hits.push_back(std::move(hit));
+  }
+
+  auto better = [](const HybridSearchHit& a, const HybridSearchHit& b) {
+    return a.score != b.score ? a.score > b.score : a.id < b.id;
+  };
+  if (out_hits.size() > static_cast<size_t>(param.topk)) {
+    std::partial_sort(out_hits.begin(), out_hits.begin() + param.topk, out_hits.end(), better);
+    out_hits.resize(param.topk);
+  } else {
+    std::sort(out_hits.begin(), out_hits.end(), better);
+  }
+}
+
+Status HybridSearch(const ClientStub& stub, const HybridSearchParam& param, HybridSearchResult& out_result) {
+  DINGO_RETURN_NOT_OK(CheckParam(param));
+
+  // candidates of both searches go without payload
+  SearchParam vector_param;
+  vector_param.topk = param.vector_topk > 0 ? param.vector_topk : param.topk;
+  vector_param.with_vector_data = false;
+  vector_param.with_scalar_data = false;
+  vector_param.extra_params = param.extra_params;
+  vector_param.filter = param.vector_filter;
+  vector_param.use_brute_force = param.use_brute_force;
+  std::vector<VectorWithId> target_vectors{param.target_vector};
+  std::vector<SearchResult> vector_result;
+
+  DocSearchParam doc_param;
+  doc_param.top_n = param.doc_top_n > 0 ? param.doc_top_n : param.topk;
+  doc_param.query_string = param.query_string;
+  doc_param.column_names = param.column_names;
+  doc_param.filter = param.doc_filter;
+  DocSearchResult doc_result;
+
+  // both fan outs run on the actuator at the same time, latency is the slower one
+  Status vector_status;
+  Status doc_status;
+  {
+    VectorSearchTask vector_task(stub, param.vector_index_id, vector_param, target_vectors, vector_result);
+    DocumentSearchTask doc_task(stub, param.doc_index_id, doc_param, doc_result);
+
+    CountDownSync sync(2);
+    vector_task.AsyncRun([&](Status s) {
+      vector_status = s;
+      sync.CountDown();
+    });
+    doc_task.AsyncRun([&](Status s) {
+      doc_status = s;
+      sync.CountDown();
+    });
+    sync.Wait();
+  }
+
+  if (!vector_status.ok()) {
+    DINGO_LOG(WARNING) << "hybrid search of vector index:" << param.vector_index_id
+                       << " fail: " << vector_status.ToString();
+    return vector_status;
+  }
+  if (!doc_status.ok()) {
+    DINGO_LOG(WARNING) << "hybrid search of document index:" << param.doc_index_id
+                       << " fail: " << doc_status.ToString();
+    return doc_status;
+  }
+
+  std::vector<VectorWithDistance> vector_candidates;
+  if (!vector_result.empty()) {
+    vector_candidates = std::move(vector_result[0].vector_datas);
+  }
+  FuseHybridResults(param, vector_candidates, doc_result.doc_sores, out_result.hits);
+
+  bool fetch_vector = param.with_vector_data || param.with_scalar_data;
+  bool fetch_doc = param.with_doc_fields;
+  if (out_result.hits.empty() || (!fetch_vector && !fetch_doc)) {
+    return Status::OK();
+  }
+
+  // payload only for the fused topk, both queries at the same time
+  QueryParam vector_query;
+  vector_query.with_vector_data = param.with_vector_data;
+  vector_query.with_scalar_data = param.with_scalar_data;
+  vector_query.selected_keys = param.selected_keys;
+  DocQueryParam doc_query;
+  doc_query.with_scalar_data = true;
+  doc_query.selected_keys = param.doc_selected_keys;
+  for (const auto& hit : out_result.hits) {
+    vector_query.vector_ids.push_back(hit.id);
+    doc_query.doc_ids.push_back(hit.id);
+  }
+
+  QueryResult vector_payload;
+  DocQueryResult doc_payload;
+  Status vector_fetch_status;
+  Status doc_fetch_status;
+  {
+    VectorBatchQueryTask vector_task(stub, param.vector_index_id, vector_query, vector_payload);
+    DocumentBatchQueryTask doc_task(stub, param.doc_index_id, doc_query, doc_payload);
+
+    CountDownSync sync((fetch_vector ? 1 : 0) + (fetch_doc ? 1 : 0));
+    if (fetch_vector) {
+      vector_task.AsyncRun([&](Status s) {
+        vector_fetch_status = s;
+        sync.CountDown();
+      });
+    }
+    if (fetch_doc) {
+      doc_task.AsyncRun([&](Status s) {
+        doc_fetch_status = s;
+        sync.CountDown();
+      });
+    }
+    sync.Wait();
+  }
+
+  DINGO_RETURN_NOT_OK(vector_fetch_status);
+  DINGO_RETURN_NOT_OK(doc_fetch_status);
+
+  std::unordered_map<int64_t, size_t> id_to_idx;
+  for (size_t i = 0; i < out_result.hits.size(); i++) {
+    id_to_idx[out_result.hits[i].id] = i;
+  }
+  for (auto& vector : vector_payload.vectors) {
+    auto iter = id_to_idx.find(vector.id);
+    if (iter != id_to_idx.end()) {
+      out_result.hits[iter->second].vector = std::move(vector);
+    }
+  }
+  for (auto& doc : doc_payload.docs) {
+    auto iter = id_to_idx.find(doc.id);
+    if (iter != id_to_idx.end()) {
+      out_result.hits[iter->second].doc = std::move(doc.doc);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,40 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_HYBRID_HYBRID_SEARCH_H_
+#define DINGODB_SDK_HYBRID_HYBRID_SEARCH_H_
+
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/document.h"
+#include "sdk/hybrid_search.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+// fuse vector and document results into at most param.topk hits sorted by score, only id, score and rank fields
+// of the hits are filled
+void FuseHybridResults(const HybridSearchParam& param, const std::vector<VectorWithDistance>& vector_results,
+                       const std::vector<DocWithStore>& doc_results, std::vector<HybridSearchHit>& out_hits);
+
+// run both searches concurrently, fuse them and fetch payload of the fused hits
+Status HybridSearch(const ClientStub& stub, const HybridSearchParam& param, HybridSearchResult& out_result);
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_HYBRID_HYBRID_SEARCH_H_
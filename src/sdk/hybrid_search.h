@@ -0,0 +1,99 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_HYBRID_SEARCH_H_
+#define DINGODB_SDK_HYBRID_SEARCH_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sdk/document.h"
+#include "sdk/filter.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+enum HybridFusionType : uint8_t {
+  // score is sum of weight / (rrf_k + rank) of each result the id is in, rank starts from 1
+  kReciprocalRankFusion,
+  // score is sum of weight * score min max normalized to [0, 1] in each result, smaller distance is better
+  kWeightedScoreFusion,
+};
+
+// Searches a vector index and a document index of the same entities concurrently and fuses the results by id,
+// so both indexes must use the same id for the same entity. Both searches go without payload, payload is only
+// fetched for the fused topk.
+struct HybridSearchParam {
+  int64_t vector_index_id{0};
+  int64_t doc_index_id{0};
+  // count of fused hits returned
+  int32_t topk{0};
+  HybridFusionType fusion_type{kReciprocalRankFusion};
+  int32_t rrf_k{60};
+  float vector_weight{1.0f};
+  float doc_weight{1.0f};
+
+  // vector search, vector_topk candidates are searched, 0 means topk
+  VectorWithId target_vector;
+  int32_t vector_topk{0};
+  std::map<SearchExtraParamType, int32_t> extra_params;
+  std::shared_ptr<const Filter> vector_filter;
+  bool use_brute_force{false};
+
+  // document search, doc_top_n candidates are searched, 0 means topk
+  std::string query_string;
+  int32_t doc_top_n{0};
+  std::vector<std::string> column_names;
+  std::shared_ptr<const Filter> doc_filter;
+
+  // payload of fused hits
+  bool with_vector_data{false};
+  bool with_scalar_data{false};
+  std::vector<std::string> selected_keys;
+  bool with_doc_fields{false};
+  std::vector<std::string> doc_selected_keys;
+};
+
+struct HybridSearchHit {
+  int64_t id{0};
+  // fused score, larger is better
+  float score{0.0f};
+  // rank in vector and document results starting from 1, 0 when not in it
+  int32_t vector_rank{0};
+  int32_t doc_rank{0};
+  float distance{0.0f};
+  float doc_score{0.0f};
+  // filled when with_vector_data or with_scalar_data
+  VectorWithId vector;
+  // filled when with_doc_fields
+  Document doc;
+
+  std::string ToString() const;
+};
+
+struct HybridSearchResult {
+  // sorted by score, best first
+  std::vector<HybridSearchHit> hits;
+
+  std::string ToString() const;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_HYBRID_SEARCH_H_
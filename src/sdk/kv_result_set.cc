@@ -0,0 +1,104 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "sdk/client.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const size_t kKvResultSetBlockSize = 64 * 1024;
+
+const char* KvResultSet::CopyToBlock(const Slice& data) {
+  if (data.empty()) {
+    return "";
+  }
+
+  if (data.size() > block_remain_) {
+    // a big one gets its own block, so the tail of current block is still used by later small ones
+    if (data.size() > kKvResultSetBlockSize / 4) {
+      blocks_.push_back(std::make_unique<char[]>(data.size()));
+      memcpy(blocks_.back().get(), data.data(), data.size());
+      return blocks_.back().get();
+    }
+    blocks_.push_back(std::make_unique<char[]>(kKvResultSetBlockSize));
+    block_pos_ = blocks_.back().get();
+    block_remain_ = kKvResultSetBlockSize;
+  }
+
+  char* dst = block_pos_;
+  memcpy(dst, data.data(), data.size());
+  block_pos_ += data.size();
+  block_remain_ -= data.size();
+  return dst;
+}
+
+void KvResultSet::Append(const Slice& key, const Slice& value) {
+  const char* key_data = CopyToBlock(key);
+  const char* value_data = CopyToBlock(value);
+  entries_.push_back({key_data, key.size(), value_data, value.size()});
+}
+
+void KvResultSet::AppendView(const Slice& key, const Slice& value) {
+  entries_.push_back({key.data(), key.size(), value.data(), value.size()});
+}
+
+void KvResultSet::Retain(std::shared_ptr<const void> owner) { owners_.push_back(std::move(owner)); }
+
+void KvResultSet::Splice(KvResultSet&& other) {
+  if (entries_.empty() && blocks_.empty() && owners_.empty()) {
+    *this = std::move(other);
+    other.Clear();
+    return;
+  }
+
+  entries_.insert(entries_.end(), other.entries_.begin(), other.entries_.end());
+  // blocks are heap arrays, moving their owners does not move the bytes
+  blocks_.insert(blocks_.end(), std::make_move_iterator(other.blocks_.begin()),
+                 std::make_move_iterator(other.blocks_.end()));
+  owners_.insert(owners_.end(), std::make_move_iterator(other.owners_.begin()),
+                 std::make_move_iterator(other.owners_.end()));
+  other.Clear();
+}
+
+void KvResultSet::Truncate(size_t size) {
+  if (size < entries_.size()) {
+    entries_.resize(size);
+  }
+}
+
+void KvResultSet::Clear() {
+  entries_.clear();
+  blocks_.clear();
+  block_pos_ = nullptr;
+  block_remain_ = 0;
+  owners_.clear();
+}
+
+std::vector<KVPair> KvResultSet::ToKVPairs() const {
+  std::vector<KVPair> kvs;
+  kvs.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    kvs.push_back({std::string(entry.key, entry.key_size), std::string(entry.value, entry.value_size)});
+  }
+  return kvs;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
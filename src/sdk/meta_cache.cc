@@ -14,42 +14,247 @@
 
 #include "sdk/meta_cache.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "fmt/core.h"
 #include "glog/logging.h"
 #include "sdk/common/common.h"
 #include "common/logging.h"
+#include "sdk/common/hot_spot_detector.h"
+#include "sdk/common/metrics.h"
 #include "sdk/common/param_config.h"
+#include "sdk/common/tracing.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/status.h"
 #include "sdk/utils/async_util.h"
+#include "sdk/utils/codec.h"
 
 namespace dingodb {
 namespace sdk {
 
 using pb::coordinator::ScanRegionInfo;
 
+static std::atomic<uint64_t> meta_cache_instance_id{0};
+
+// a small table is rebuilt with its first changes, it is cheap and keeps lookups in one table
+static const size_t kMinRebuildRouteChanged = 8;
+
+MetaCache::MetaCache(std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller)
+    : coordinator_rpc_controller_(std::move(coordinator_rpc_controller)),
+      instance_id_(meta_cache_instance_id.fetch_add(1, std::memory_order_relaxed) + 1),
+      alive_(std::make_shared<const bool>(true)) {
+  auto routes = std::make_shared<RouteTable>();
+  routes->Finish();
+  routes_ = std::move(routes);
+
+  auto snapshot = std::make_shared<RouteSnapshot>();
+  snapshot->routes = routes_;
+  route_snapshot_ = std::move(snapshot);
+}
+
+static bool StartKeyLess(const std::shared_ptr<Region>& a, const std::shared_ptr<Region>& b) {
+  return a->Range().start_key() < b->Range().start_key();
+}
+
+static bool KeyLessStartKey(std::string_view key, const std::shared_ptr<Region>& region) {
+  return key < region->Range().start_key();
+}
+
+MetaCache::~MetaCache() = default;
+
+const MetaCache::RouteSnapshot* MetaCache::GetRouteSnapshot() const {
+  struct LocalRoutePin {
+    uint64_t owner;
+    std::weak_ptr<const bool> alive;
+    uint64_t version;
+    std::shared_ptr<const RouteSnapshot> snapshot;
+  };
+  // a thread uses few caches, e.g. clients sharing a runtime, a linear scan beats a hash map
+  static thread_local std::vector<LocalRoutePin> locals;
+
+  LocalRoutePin* local = nullptr;
+  for (auto& pin : locals) {
+    if (pin.owner == instance_id_) {
+      local = &pin;
+      break;
+    }
+  }
+  if (local == nullptr) {
+    // pins of destroyed caches keep their retired regions alive
+    locals.erase(std::remove_if(locals.begin(), locals.end(), [](const auto& pin) { return pin.alive.expired(); }),
+                 locals.end());
+    locals.push_back(LocalRoutePin{instance_id_, alive_, 0, nullptr});
+    local = &locals.back();
+  }
+
+  // snapshot is stored before version is increased, so the loaded one is not older than version
+  uint64_t version = route_version_.load(std::memory_order_acquire);
+  if (local->snapshot == nullptr || local->version != version) {
+    local->snapshot = std::atomic_load_explicit(&route_snapshot_, std::memory_order_acquire);
+    local->version = version;
+  }
+
+  return local->snapshot.get();
+}
+
+void MetaCache::PublishRouteSnapshotUnlocked() {
+  size_t changed = recent_regions_.size() + stale_routes_;
+  if (changed * changed > routes_->Size() && changed > kMinRebuildRouteChanged) {
+    std::vector<std::shared_ptr<Region>> regions;
+    CollectRegionsUnlocked("", "", regions);
+
+    auto routes = std::make_shared<RouteTable>();
+    routes->Reserve(regions.size());
+    for (const auto& region : regions) {
+      routes->Add(region->Range().start_key(), region->Range().end_key(), region);
+    }
+    routes->Finish();
+    routes_ = std::move(routes);
+    recent_regions_.clear();
+    stale_routes_ = 0;
+  }
+
+  auto snapshot = std::make_shared<RouteSnapshot>();
+  snapshot->routes = routes_;
+  snapshot->recent_regions = recent_regions_;
+
+  std::atomic_store_explicit(&route_snapshot_, std::shared_ptr<const RouteSnapshot>(std::move(snapshot)),
+                             std::memory_order_release);
+  route_version_.fetch_add(1, std::memory_order_release);
+}
+
+const std::shared_ptr<Region>* MetaCache::FindInRouteSnapshot(const RouteSnapshot& snapshot, std::string_view key) {
+  const RouteTable& routes = *snapshot.routes;
+  size_t pos = routes.Find(key);
+  if (pos != RouteTable::kNotFound && !routes.RegionAt(pos)->IsStale()) {
+    return &routes.RegionAt(pos);
+  }
+
+  const auto& recent_regions = snapshot.recent_regions;
+  auto iter = std::upper_bound(recent_regions.begin(), recent_regions.end(), key, KeyLessStartKey);
+  if (iter == recent_regions.begin()) {
+    return nullptr;
+  }
+  iter--;
+  if (key >= (*iter)->Range().end_key() || (*iter)->IsStale()) {
+    return nullptr;
+  }
+  return &(*iter);
+}
+
+Status MetaCache::SnapshotLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region) const {
+  const auto* found = FindInRouteSnapshot(*GetRouteSnapshot(), key);
+  if (found == nullptr) {
+    return Status::NotFound(fmt::format("not found region for key:{} in route snapshot", key));
+  }
+
+  region = *found;
+  return Status::OK();
+}
+
 Status MetaCache::LookupRegionByKey(std::string_view key, std::shared_ptr<Region>& region) {
   CHECK(!key.empty()) << "key should not empty";
-  Status s;
+  // every routed key is an access of the key
+  HotSpotDetector::Global().RecordKey(key);
+  Status s = SnapshotLookUpRegionByKey(key, region);
+  if (s.IsOK()) {
+    Metrics::Global().RecordMetaCacheHit(1);
+    return s;
+  }
+
   {
     std::shared_lock<std::shared_mutex> r(rw_lock_);
     s = FastLookUpRegionByKeyUnlocked(key, region);
     if (s.IsOK()) {
+      Metrics::Global().RecordMetaCacheHit(1);
       return s;
     }
   }
 
+  Metrics::Global().RecordMetaCacheMiss(1);
   s = SlowLookUpRegionByKey(key, region);
   return s;
 }
 
+Status MetaCache::LookupRegionsByKeys(const std::vector<std::string_view>& sorted_keys,
+                                      std::vector<RegionKeys>& out_groups) {
+  out_groups.clear();
+  if (sorted_keys.empty()) {
+    return Status::OK();
+  }
+  DCHECK(std::is_sorted(sorted_keys.begin(), sorted_keys.end())) << "keys should be sorted";
+  for (const auto& key : sorted_keys) {
+    HotSpotDetector::Global().RecordKey(key);
+  }
+
+  std::vector<std::pair<std::string_view, std::shared_ptr<Region>>> found;
+  found.reserve(sorted_keys.size());
+  std::vector<std::string_view> miss_keys;
+  SnapshotLookUpRegionsByKeys(sorted_keys, found, miss_keys);
+  Metrics::Global().RecordMetaCacheHit(found.size());
+  Metrics::Global().RecordMetaCacheMiss(miss_keys.size());
+
+  Status ret;
+  if (!miss_keys.empty()) {
+    // fetch all regions cover miss keys in one rpc, [first_miss, last_miss + '\0')
+    std::string end_key(miss_keys.back());
+    end_key.push_back('\0');
+    std::vector<std::shared_ptr<Region>> regions;
+    Status s = ScanRegionsBetweenRange(miss_keys.front(), end_key, 0, regions);
+    if (s.ok() || s.IsNotFound()) {
+      std::vector<std::string_view> still_miss_keys;
+      SnapshotLookUpRegionsByKeys(miss_keys, found, still_miss_keys);
+
+      // e.g. a region split between the scan and the lookup, one key failing must not fail the others
+      for (const auto& key : still_miss_keys) {
+        std::shared_ptr<Region> region;
+        s = SnapshotLookUpRegionByKey(key, region);
+        if (!s.ok()) {
+          s = SlowLookUpRegionByKey(key, region);
+        }
+        if (s.ok()) {
+          found.emplace_back(key, std::move(region));
+        } else if (ret.ok()) {
+          ret = s;
+        }
+      }
+    } else {
+      // coordinator is not available, a lookup per key would fail the same way
+      DINGO_LOG(WARNING) << fmt::format("scan regions fail for {} miss keys between [{},{}), status:{}",
+                                        miss_keys.size(), miss_keys.front(), miss_keys.back(), s.ToString());
+      ret = s;
+    }
+
+    std::sort(found.begin(), found.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+  }
+
+  // keys are sorted and regions are not overlapped, so keys of same region are continuous
+  for (auto& [key, region] : found) {
+    if (out_groups.empty() || out_groups.back().region->RegionId() != region->RegionId()) {
+      out_groups.push_back({std::move(region), {}});
+    }
+    out_groups.back().keys.push_back(key);
+  }
+
+  return ret;
+}
+
 Status MetaCache::LookupRegionBetweenRange(std::string_view start_key, std::string_view end_key,
                                            std::shared_ptr<Region>& region) {
   CHECK(!start_key.empty()) << "start_key should not empty";
   CHECK(!end_key.empty()) << "end_key should not empty";
-  Status s;
+  Status s = SnapshotLookUpRegionByKey(start_key, region);
+  if (s.IsOK()) {
+    return s;
+  }
+
   {
     std::shared_lock<std::shared_mutex> r(rw_lock_);
     s = FastLookUpRegionByKeyUnlocked(start_key, region);
@@ -71,7 +276,11 @@ Status MetaCache::LookupRegionBetweenRangeNoPrefetch(std::string_view start_key,
                                                      std::shared_ptr<Region>& region) {
   CHECK(!start_key.empty()) << "start_key should not empty";
   CHECK(!end_key.empty()) << "end_key should not empty";
-  Status s;
+  Status s = SnapshotLookUpRegionByKey(start_key, region);
+  if (s.IsOK()) {
+    return s;
+  }
+
   {
     std::shared_lock<std::shared_mutex> r(rw_lock_);
     s = FastLookUpRegionByKeyUnlocked(start_key, region);
@@ -100,9 +309,66 @@ Status MetaCache::ScanRegionsBetweenRange(std::string_view start_key, std::strin
   rpc.MutableRequest()->set_range_end(std::string(end_key));
   rpc.MutableRequest()->set_limit(limit);
 
+  Span span = Tracer::Global().StartChildSpan("MetaCache.ScanRegionsBetweenRange", Tracer::CurrentContext());
+  if (span.IsRecording()) {
+    span.SetAttribute("start_key", codec::BytesToHexString(std::string(start_key)));
+    span.SetAttribute("end_key", codec::BytesToHexString(std::string(end_key)));
+    span.SetAttribute("limit", limit);
+  }
+
+  Status s = coordinator_rpc_controller_->SyncCall(rpc);
+  if (s.ok()) {
+    s = ProcessScanRegionsBetweenRangeResponse(*rpc.Response(), regions);
+  }
+  span.SetStatus(s);
+  return s;
+}
+
+Status MetaCache::RefreshRegionsBetweenRange(std::string_view start_key, std::string_view end_key,
+                                             int64_t& out_changed) {
+  CHECK(!start_key.empty()) << "start_key should not empty";
+  CHECK(!end_key.empty()) << "end_key should not empty";
+  out_changed = 0;
+
+  ScanRegionsRpc rpc;
+  rpc.MutableRequest()->set_key(std::string(start_key));
+  rpc.MutableRequest()->set_range_end(std::string(end_key));
+  rpc.MutableRequest()->set_limit(0);
+
   DINGO_RETURN_NOT_OK(coordinator_rpc_controller_->SyncCall(rpc));
 
-  return ProcessScanRegionsBetweenRangeResponse(*rpc.Response(), regions);
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  for (const auto& scan_region_info : rpc.Response()->regions()) {
+    std::shared_ptr<Region> new_region;
+    ProcessScanRegionInfo(scan_region_info, new_region);
+
+    auto iter = region_by_id_.find(new_region->RegionId());
+    if (iter == region_by_id_.end() || NeedUpdateRegion(iter->second, new_region)) {
+      // split, merge or new region, overlapped old ones are removed
+      MaybeAddRegionUnlocked(new_region);
+      out_changed++;
+      continue;
+    }
+
+    if (EpochCompare(iter->second->Epoch(), new_region->Epoch()) != 0 || !scan_region_info.has_leader()) {
+      continue;
+    }
+
+    EndPoint leader = LocationToEndPoint(scan_region_info.leader());
+    if (!leader.IsValid()) {
+      continue;
+    }
+    if (!iter->second->IsLeader(leader)) {
+      iter->second->MarkLeader(leader);
+      out_changed++;
+    }
+  }
+
+  if (out_changed > 0) {
+    PublishRouteSnapshotUnlocked();
+  }
+
+  return Status::OK();
 }
 
 Status MetaCache::ScanRegionsBetweenContinuousRange(std::string_view start_key, std::string_view end_key,
@@ -110,22 +376,10 @@ Status MetaCache::ScanRegionsBetweenContinuousRange(std::string_view start_key,
   std::vector<std::shared_ptr<Region>> to_return;
   {
     std::shared_lock<std::shared_mutex> r(rw_lock_);
-    // find region start_key >= start_key
-    auto start_iter = region_by_key_.lower_bound(start_key);
-    if (start_iter != region_by_key_.end() && start_iter->first == start_key) {
-      // find region start_key >= end_key
-      auto end_iter = region_by_key_.lower_bound(end_key);
-      if (end_iter != region_by_key_.begin()) {
-        end_iter--;
-        if (end_iter->second->Range().end_key() == end_key) {
-          auto iter = start_iter;
-          while (iter != end_iter) {
-            to_return.push_back(iter->second);
-            iter++;
-          }
-          to_return.push_back(end_iter->second);
-        }
-      }
+    CollectRegionsUnlocked(start_key, end_key, to_return);
+    if (!to_return.empty() &&
+        (to_return.front()->Range().start_key() != start_key || to_return.back()->Range().end_key() != end_key)) {
+      to_return.clear();
     }
   }
 
@@ -179,12 +433,14 @@ void MetaCache::ClearRange(const std::shared_ptr<Region>& region) {
   } else {
     CHECK(iter != region_by_id_.end());
     RemoveRegionUnlocked(region->RegionId());
+    PublishRouteSnapshotUnlocked();
   }
 }
 
 void MetaCache::RemoveRegion(int64_t region_id) {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   RemoveRegionIfPresentUnlocked(region_id);
+  PublishRouteSnapshotUnlocked();
 }
 
 void MetaCache::RemoveRegionIfPresentUnlocked(int64_t region_id) {
@@ -198,13 +454,19 @@ void MetaCache::ClearCache() {
   for (const auto& [region_id, region] : region_by_id_) {
     region->MarkStale();
   }
-  region_by_key_.clear();
   region_by_id_.clear();
+  recent_regions_.clear();
+  auto routes = std::make_shared<RouteTable>();
+  routes->Finish();
+  routes_ = std::move(routes);
+  stale_routes_ = 0;
+  PublishRouteSnapshotUnlocked();
 }
 
 void MetaCache::MaybeAddRegion(const std::shared_ptr<Region>& new_region) {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   MaybeAddRegionUnlocked(new_region);
+  PublishRouteSnapshotUnlocked();
 }
 
 void MetaCache::MaybeAddRegionUnlocked(const std::shared_ptr<Region>& new_region) {
@@ -225,16 +487,66 @@ void MetaCache::MaybeAddRegionUnlocked(const std::shared_ptr<Region>& new_region
   AddRangeToCacheUnlocked(new_region);
 }
 
+std::shared_ptr<Region> MetaCache::SeekRegionUnlocked(std::string_view key) const {
+  std::shared_ptr<Region> found;
+  auto iter = std::upper_bound(recent_regions_.begin(), recent_regions_.end(), key,
+                               KeyLessStartKey);
+  if (iter != recent_regions_.begin()) {
+    found = *(iter - 1);
+  }
+
+  // live regions of routes_ before a stale one end before its start key, so they can not be nearer
+  size_t pos = routes_->Seek(key);
+  if (pos != RouteTable::kNotFound) {
+    const auto& region = routes_->RegionAt(pos);
+    if (!region->IsStale() && (found == nullptr || found->Range().start_key() < region->Range().start_key())) {
+      found = region;
+    }
+  }
+
+  return found;
+}
+
+void MetaCache::CollectRegionsUnlocked(std::string_view start_key, std::string_view end_key,
+                                       std::vector<std::shared_ptr<Region>>& out_regions) const {
+  auto overlapped = [&](const std::shared_ptr<Region>& region) {
+    return region->Range().end_key() > start_key;
+  };
+  auto before_end = [&](const std::shared_ptr<Region>& region) {
+    return end_key.empty() || region->Range().start_key() < end_key;
+  };
+
+  out_regions.clear();
+  size_t pos = routes_->Seek(start_key);
+  for (pos = (pos == RouteTable::kNotFound ? 0 : pos); pos < routes_->Size(); pos++) {
+    const auto& region = routes_->RegionAt(pos);
+    if (!before_end(region)) {
+      break;
+    }
+    if (!region->IsStale() && overlapped(region)) {
+      out_regions.push_back(region);
+    }
+  }
+
+  // recent regions are not overlapped, only the one before start_key may reach it
+  size_t middle = out_regions.size();
+  auto iter = std::upper_bound(recent_regions_.begin(), recent_regions_.end(), start_key,
+                               KeyLessStartKey);
+  if (iter != recent_regions_.begin() && overlapped(*(iter - 1))) {
+    iter--;
+  }
+  for (; iter != recent_regions_.end() && before_end(*iter); iter++) {
+    out_regions.push_back(*iter);
+  }
+  std::inplace_merge(out_regions.begin(), out_regions.begin() + middle, out_regions.end(), StartKeyLess);
+}
+
 Status MetaCache::FastLookUpRegionByKeyUnlocked(std::string_view key, std::shared_ptr<Region>& region) {
-  auto iter = region_by_key_.upper_bound(key);
-  if (iter == region_by_key_.begin()) {
+  auto found_region = SeekRegionUnlocked(key);
+  if (found_region == nullptr) {
     return Status::NotFound(fmt::format("not found region for key:{}", key));
   }
 
-  iter--;
-  auto found_region = iter->second;
-  CHECK(!found_region->IsStale());
-
   auto range = found_region->Range();
   CHECK(key >= range.start_key());
 
@@ -252,16 +564,47 @@ Status MetaCache::FastLookUpRegionByKeyUnlocked(std::string_view key, std::share
   }
 }
 
+void MetaCache::SnapshotLookUpRegionsByKeys(
+    const std::vector<std::string_view>& sorted_keys,
+    std::vector<std::pair<std::string_view, std::shared_ptr<Region>>>& out_found,
+    std::vector<std::string_view>& out_miss_keys) const {
+  const RouteSnapshot& snapshot = *GetRouteSnapshot();
+
+  // region holding previous key, adjacent keys usually in the same region
+  const std::shared_ptr<Region>* current = nullptr;
+  for (const auto& key : sorted_keys) {
+    if (current != nullptr && key < (*current)->Range().end_key()) {
+      out_found.emplace_back(key, *current);
+      continue;
+    }
+
+    current = FindInRouteSnapshot(snapshot, key);
+    if (current != nullptr) {
+      out_found.emplace_back(key, *current);
+    } else {
+      out_miss_keys.push_back(key);
+    }
+  }
+}
+
 Status MetaCache::SlowLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region) {
+  Span span = Tracer::Global().StartChildSpan("MetaCache.SlowLookUpRegionByKey", Tracer::CurrentContext());
+  if (span.IsRecording()) {
+    span.SetAttribute("key", codec::BytesToHexString(std::string(key)));
+  }
+
   ScanRegionsRpc rpc;
   rpc.MutableRequest()->set_key(std::string(key));
 
   Status send = coordinator_rpc_controller_->SyncCall(rpc);
   if (!send.IsOK()) {
+    span.SetStatus(send);
     return send;
   }
 
-  return ProcessScanRegionsByKeyResponse(*rpc.Response(), region);
+  Status s = ProcessScanRegionsByKeyResponse(*rpc.Response(), region);
+  span.SetStatus(s);
+  return s;
 }
 
 Status MetaCache::ProcessScanRegionsByKeyResponse(const pb::coordinator::ScanRegionsResponse& response,
@@ -275,6 +618,7 @@ Status MetaCache::ProcessScanRegionsByKeyResponse(const pb::coordinator::ScanReg
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
       MaybeAddRegionUnlocked(new_region);
+      PublishRouteSnapshotUnlocked();
       auto iter = region_by_id_.find(scan_region_info.region_id());
       CHECK(iter != region_by_id_.end());
       CHECK(iter->second.get() != nullptr);
@@ -287,22 +631,41 @@ Status MetaCache::ProcessScanRegionsByKeyResponse(const pb::coordinator::ScanReg
   }
 }
 
+std::vector<std::shared_ptr<Region>> MetaCache::ListRegions() {
+  std::vector<std::shared_ptr<Region>> regions;
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  CollectRegionsUnlocked("", "", regions);
+  return regions;
+}
+
+Status MetaCache::LoadRegions(const pb::coordinator::ScanRegionsResponse& response) {
+  std::vector<std::shared_ptr<Region>> regions;
+  return ProcessScanRegionsBetweenRangeResponse(response, regions);
+}
+
 Status MetaCache::ProcessScanRegionsBetweenRangeResponse(const pb::coordinator::ScanRegionsResponse& response,
                                                          std::vector<std::shared_ptr<Region>>& regions) {
   if (response.regions_size() > 0) {
-    std::vector<std::shared_ptr<Region>> tmp_regions;
-
+    std::vector<std::shared_ptr<Region>> new_regions;
+    new_regions.reserve(response.regions_size());
     for (const auto& scan_region_info : response.regions()) {
       std::shared_ptr<Region> new_region;
       ProcessScanRegionInfo(scan_region_info, new_region);
-      {
-        std::unique_lock<std::shared_mutex> w(rw_lock_);
+      new_regions.push_back(std::move(new_region));
+    }
+
+    std::vector<std::shared_ptr<Region>> tmp_regions;
+    {
+      // take write lock and publish route snapshot once for all regions
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      for (const auto& new_region : new_regions) {
         MaybeAddRegionUnlocked(new_region);
-        auto iter = region_by_id_.find(scan_region_info.region_id());
+        auto iter = region_by_id_.find(new_region->RegionId());
         CHECK(iter != region_by_id_.end());
         CHECK(iter->second.get() != nullptr);
         tmp_regions.push_back(iter->second);
       }
+      PublishRouteSnapshotUnlocked();
     }
 
     CHECK(!tmp_regions.empty());
@@ -367,44 +730,36 @@ void MetaCache::RemoveRegionUnlocked(int64_t region_id) {
   region->MarkStale();
   region_by_id_.erase(iter);
 
-  CHECK(region_by_key_.erase(region->Range().start_key()) == 1);
+  // regions of routes_ are dropped when it is rebuilt
+  auto recent_iter = std::lower_bound(recent_regions_.begin(), recent_regions_.end(), region, StartKeyLess);
+  if (recent_iter != recent_regions_.end() && *recent_iter == region) {
+    recent_regions_.erase(recent_iter);
+  } else {
+    DCHECK(routes_->Find(region->Range().start_key()) != RouteTable::kNotFound);
+    stale_routes_++;
+  }
 
   DINGO_LOG(DEBUG) << "remove region and mark stale, region_id:" << region_id << ", region: " << region->ToString();
 }
 
 void MetaCache::AddRangeToCacheUnlocked(const std::shared_ptr<Region>& region) {
-  auto region_start_key = region->Range().start_key();
-
+  // remove ranges overlapped with region
   std::vector<std::shared_ptr<Region>> to_removes;
-  auto key_iter = region_by_key_.lower_bound(region_start_key);
-
-  // remove before range when end_key > region_start_key
-  if (key_iter != region_by_key_.begin()) {
-    key_iter--;
-    auto to_remove_start_key = key_iter->second->Range().start_key();
-    CHECK(to_remove_start_key < region_start_key)
-        << "to_remove_start_key:" << to_remove_start_key << " expect le:" << region_start_key;
-
-    if (key_iter->second->Range().end_key() > region_start_key) {
-      to_removes.emplace_back(key_iter->second);
-    }
-    key_iter++;
-  }
-
-  auto region_end_key = region->Range().end_key();
-  // remove ranges which  region_start_key <= start_key < region_end_key
-  while (key_iter != region_by_key_.end() && key_iter->second->Range().start_key() < region_end_key) {
-    to_removes.emplace_back(key_iter->second);
-    key_iter++;
-  }
-
+  CollectRegionsUnlocked(region->Range().start_key(), region->Range().end_key(), to_removes);
   for (const auto& remove : to_removes) {
     RemoveRegionUnlocked(remove->RegionId());
   }
 
-  // add region to cache
+  // add region to cache, a region removed and added back may be still in routes_
   CHECK(region_by_id_.insert(std::make_pair(region->RegionId(), region)).second);
-  CHECK(region_by_key_.insert(std::make_pair(region->Range().start_key(), region)).second);
+  size_t pos = routes_->Find(region->Range().start_key());
+  if (pos == RouteTable::kNotFound || routes_->RegionAt(pos) != region) {
+    recent_regions_.insert(std::upper_bound(recent_regions_.begin(), recent_regions_.end(), region, StartKeyLess),
+                           region);
+  } else {
+    DCHECK_GT(stale_routes_, 0);
+    stale_routes_--;
+  }
 
   region->UnMarkStale();
 
@@ -422,8 +777,10 @@ void MetaCache::DumpUnlocked() {
     DINGO_LOG(INFO) << dump;
   }
 
-  for (const auto& r : region_by_key_) {
-    std::string dump = fmt::format("start_key:{}, region:{}", r.first, r.second->ToString());
+  std::vector<std::shared_ptr<Region>> regions;
+  CollectRegionsUnlocked("", "", regions);
+  for (const auto& region : regions) {
+    std::string dump = fmt::format("start_key:{}, region:{}", region->Range().start_key(), region->ToString());
     DINGO_LOG(INFO) << dump;
   }
 }
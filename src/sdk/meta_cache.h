@@ -15,8 +15,10 @@
 #ifndef DINGODB_SDK_META_CACHE_H_
 #define DINGODB_SDK_META_CACHE_H_
 
-#include <map>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
@@ -24,6 +26,7 @@
 
 #include "proto/coordinator.pb.h"
 #include "sdk/region.h"
+#include "sdk/route_table.h"
 #include "sdk/rpc/coordinator_rpc_controller.h"
 #include "sdk/status.h"
 
@@ -32,18 +35,29 @@ namespace sdk {
 
 class ClientStub;
 
+// keys belong to the same region, keys are views into caller's data and never copied
+struct RegionKeys {
+  std::shared_ptr<Region> region;
+  std::vector<std::string_view> keys;
+};
+
 class MetaCache {
  public:
   MetaCache(const MetaCache&) = delete;
   const MetaCache& operator=(const MetaCache&) = delete;
 
-  explicit MetaCache(std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller)
-      : coordinator_rpc_controller_(std::move(coordinator_rpc_controller)) {}
+  explicit MetaCache(std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller);
 
-  ~MetaCache() = default;
+  ~MetaCache();
 
   Status LookupRegionByKey(std::string_view key, std::shared_ptr<Region>& region);
 
+  // sorted_keys must be sorted and unique, out_groups is ordered by region range
+  // take lock once for all keys, and all cache misses are fetched by one ScanRegions rpc, keys still missing are
+  // looked up one by one
+  // NOTE: on error out_groups still holds the keys found, callers doing best effort work can go on with them
+  Status LookupRegionsByKeys(const std::vector<std::string_view>& sorted_keys, std::vector<RegionKeys>& out_groups);
+
   // return first region between [start_key, end_key), this will prefetch regions and put into cache
   Status LookupRegionBetweenRange(std::string_view start_key, std::string_view end_key,
                                   std::shared_ptr<Region>& region);
@@ -57,6 +71,10 @@ class MetaCache {
   Status ScanRegionsBetweenRange(std::string_view start_key, std::string_view end_key, int64_t limit,
                                  std::vector<std::shared_ptr<Region>>& regions);
 
+  // re-scan regions between [start_key, end_key) from coordinator, apply newer epochs and leader changes of
+  // cached regions, out_changed is the count of regions added or whose leader changed
+  Status RefreshRegionsBetweenRange(std::string_view start_key, std::string_view end_key, int64_t& out_changed);
+
   //  return all regions between [start_key, end_key), used for get partion regions
   Status ScanRegionsBetweenContinuousRange(std::string_view start_key, std::string_view end_key,
                                            std::vector<std::shared_ptr<Region>>& regions);
@@ -70,6 +88,13 @@ class MetaCache {
   // be sure new_region will not destroy when call this func
   void MaybeAddRegion(const std::shared_ptr<Region>& new_region);
 
+  // all cached regions ordered by start key
+  std::vector<std::shared_ptr<Region>> ListRegions();
+
+  // add regions in response as if they were returned by coordinator, used to load persistent snapshot,
+  // regions are validated lazily by region epoch errors
+  Status LoadRegions(const pb::coordinator::ScanRegionsResponse& response);
+
   Status TEST_FastLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region) {  // NOLINT
     std::shared_lock<std::shared_mutex> r(rw_lock_);
     return FastLookUpRegionByKeyUnlocked(key, region);
@@ -78,11 +103,49 @@ class MetaCache {
   void Dump();
 
  private:
+  // immutable routing table, published by writers under write lock, readers binary search it without taking
+  // rw_lock_
+  struct RouteSnapshot {
+    // shared by snapshots until it is rebuilt
+    std::shared_ptr<const RouteTable> routes;
+    // copy of recent_regions_
+    std::vector<std::shared_ptr<Region>> recent_regions;
+  };
+
+  // snapshot is pinned by each thread per cache and reloaded only when route_version_ changed, so steady state
+  // readers take no lock and never touch the shared_ptr control block. an idle thread keeps at most one retired
+  // snapshot per cache until its next lookup.
+  // NOTE: returned snapshot is valid until the calling thread gets snapshot of this cache again
+  const RouteSnapshot* GetRouteSnapshot() const;
+
+  // NOTE: must hold write lock
+  // the table is rebuilt only when regions changed since the last build are many for its size, so adding regions
+  // one by one costs O(sqrt(n)) per region instead of O(n)
+  void PublishRouteSnapshotUnlocked();
+
+  static const std::shared_ptr<Region>* FindInRouteSnapshot(const RouteSnapshot& snapshot, std::string_view key);
+
+  // return NotFound when miss or found region is stale, caller should fall back to locked lookup
+  Status SnapshotLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region) const;
+
+  // lookup sorted keys in route snapshot, found keys are appended to out_found, the others are appended to
+  // out_miss_keys
+  void SnapshotLookUpRegionsByKeys(const std::vector<std::string_view>& sorted_keys,
+                                   std::vector<std::pair<std::string_view, std::shared_ptr<Region>>>& out_found,
+                                   std::vector<std::string_view>& out_miss_keys) const;
+
   // TODO: backoff when region not ready
   Status SlowLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region);
 
   Status FastLookUpRegionByKeyUnlocked(std::string_view key, std::shared_ptr<Region>& region);
 
+  // live region with the greatest start key less than or equal to key, nullptr if none
+  std::shared_ptr<Region> SeekRegionUnlocked(std::string_view key) const;
+
+  // live regions overlapped with [start_key, end_key) ordered by start key, empty end_key means no upper bound
+  void CollectRegionsUnlocked(std::string_view start_key, std::string_view end_key,
+                              std::vector<std::shared_ptr<Region>>& out_regions) const;
+
   Status ProcessScanRegionsByKeyResponse(const pb::coordinator::ScanRegionsResponse& response,
                                          std::shared_ptr<Region>& region);
 
@@ -107,10 +170,24 @@ class MetaCache {
 
   std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller_;
 
+  // unique in process, used to identify thread local route pin owner
+  const uint64_t instance_id_;
+  // expired once cache is destroyed, so threads drop their pins of it
+  const std::shared_ptr<const bool> alive_;
+  // NOTE: access by std::atomic_load/std::atomic_store
+  std::shared_ptr<const RouteSnapshot> route_snapshot_;
+  // increased after route_snapshot_ is published
+  std::atomic<uint64_t> route_version_{0};
+
   mutable std::shared_mutex rw_lock_;
   std::unordered_map<int64_t, std::shared_ptr<Region>> region_by_id_;
-  // start-key -> region
-  std::map<std::string, std::shared_ptr<Region>, std::less<void>> region_by_key_;
+  // index of regions by start key, shared with published snapshots, removed regions are only marked stale in it,
+  // regions added after it was built are kept in recent_regions_ until it is rebuilt
+  std::shared_ptr<const RouteTable> routes_;
+  // sorted by start key, never overlapped with live regions of routes_
+  std::vector<std::shared_ptr<Region>> recent_regions_;
+  // removed regions still in routes_
+  size_t stale_routes_{0};
 };
 
 }  // namespace sdk
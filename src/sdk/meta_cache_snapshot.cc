@@ -0,0 +1,235 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/meta_cache_snapshot.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "proto/coordinator.pb.h"
+#include "proto/meta.pb.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/common.h"
+#include "sdk/meta_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+constexpr char kMagic[4] = {'D', 'M', 'C', 'S'};
+constexpr uint32_t kVersion = 1;
+
+uint64_t Fnv1a(const char* data, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+template <class T>
+void AppendFixed(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+bool ReadFixed(const std::string& data, size_t& pos, size_t end, T& value) {
+  if (end - pos < sizeof(value)) {
+    return false;
+  }
+  memcpy(&value, data.data() + pos, sizeof(value));
+  pos += sizeof(value);
+  return true;
+}
+
+void AppendRecord(std::string& out, uint8_t type, const google::protobuf::Message& message) {
+  std::string buf = message.SerializeAsString();
+  AppendFixed<uint8_t>(out, type);
+  AppendFixed<uint32_t>(out, buf.size());
+  out.append(buf);
+}
+
+void Region2ScanRegionInfo(Region& region, pb::coordinator::ScanRegionInfo* info) {
+  info->set_region_id(region.RegionId());
+  *info->mutable_range() = region.Range();
+  *info->mutable_region_epoch() = region.Epoch();
+  info->mutable_status()->set_region_type(region.RegionType());
+  for (const auto& replica : region.Replicas()) {
+    if (replica.role == kLeader) {
+      *info->mutable_leader() = EndPointToLocation(replica.end_point);
+    } else {
+      *info->add_voters() = EndPointToLocation(replica.end_point);
+    }
+  }
+}
+}  // namespace
+
+Status MetaCacheSnapshot::Encode(const ClientStub& stub, std::string& out) {
+  out.clear();
+  out.append(kMagic, sizeof(kMagic));
+  AppendFixed<uint32_t>(out, kVersion);
+  size_t count_pos = out.size();
+  AppendFixed<uint32_t>(out, 0);
+
+  uint32_t count = 0;
+  for (const auto& region : stub.GetMetaCache()->ListRegions()) {
+    // stale region is being replaced, do not persist it
+    if (region->IsStale()) {
+      continue;
+    }
+    pb::coordinator::ScanRegionInfo info;
+    Region2ScanRegionInfo(*region, &info);
+    AppendRecord(out, kRegion, info);
+    count++;
+  }
+
+  for (const auto& def : stub.GetVectorIndexCache()->ListIndexDefinitions()) {
+    AppendRecord(out, kVectorIndex, def);
+    count++;
+  }
+
+  for (const auto& def : stub.GetDocumentIndexCache()->ListIndexDefinitions()) {
+    AppendRecord(out, kDocumentIndex, def);
+    count++;
+  }
+
+  memcpy(out.data() + count_pos, &count, sizeof(count));
+  AppendFixed<uint64_t>(out, Fnv1a(out.data(), out.size()));
+  return Status::OK();
+}
+
+Status MetaCacheSnapshot::Decode(const ClientStub& stub, const std::string& data) {
+  size_t header_size = sizeof(kMagic) + sizeof(uint32_t) * 2;
+  if (data.size() < header_size + sizeof(uint64_t) || memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+    return Status::Corruption("invalid meta cache snapshot header");
+  }
+
+  size_t end = data.size() - sizeof(uint64_t);
+  uint64_t checksum = 0;
+  memcpy(&checksum, data.data() + end, sizeof(checksum));
+  if (checksum != Fnv1a(data.data(), end)) {
+    return Status::Corruption("meta cache snapshot checksum mismatch");
+  }
+
+  size_t pos = sizeof(kMagic);
+  uint32_t version = 0;
+  uint32_t count = 0;
+  ReadFixed(data, pos, end, version);
+  ReadFixed(data, pos, end, count);
+  if (version != kVersion) {
+    return Status::NotSupported(fmt::format("meta cache snapshot version:{} not supported", version));
+  }
+
+  pb::coordinator::ScanRegionsResponse regions;
+  std::vector<pb::meta::IndexDefinitionWithId> vector_defs;
+  std::vector<pb::meta::IndexDefinitionWithId> document_defs;
+  for (uint32_t i = 0; i < count; i++) {
+    uint8_t type = 0;
+    uint32_t size = 0;
+    if (!ReadFixed(data, pos, end, type) || !ReadFixed(data, pos, end, size) || end - pos < size) {
+      return Status::Corruption(fmt::format("meta cache snapshot truncated at record:{}", i));
+    }
+
+    const char* buf = data.data() + pos;
+    pos += size;
+    bool parsed = false;
+    if (type == kRegion) {
+      auto* info = regions.add_regions();
+      parsed = info->ParseFromArray(buf, size) && info->has_range() && info->has_region_epoch();
+    } else if (type == kVectorIndex) {
+      parsed = vector_defs.emplace_back().ParseFromArray(buf, size);
+    } else if (type == kDocumentIndex) {
+      parsed = document_defs.emplace_back().ParseFromArray(buf, size);
+    } else {
+      // record of newer writer, skip
+      parsed = true;
+    }
+
+    if (!parsed) {
+      return Status::Corruption(fmt::format("fail parse meta cache snapshot record:{} type:{}", i, type));
+    }
+  }
+
+  if (regions.regions_size() > 0) {
+    DINGO_RETURN_NOT_OK(stub.GetMetaCache()->LoadRegions(regions));
+  }
+
+  for (const auto& def : vector_defs) {
+    Status s = stub.GetVectorIndexCache()->AddIndexDefinition(def);
+    if (!s.ok()) {
+      DINGO_LOG(INFO) << "skip vector index in meta cache snapshot, status:" << s.ToString();
+    }
+  }
+
+  for (const auto& def : document_defs) {
+    Status s = stub.GetDocumentIndexCache()->AddIndexDefinition(def);
+    if (!s.ok()) {
+      DINGO_LOG(INFO) << "skip document index in meta cache snapshot, status:" << s.ToString();
+    }
+  }
+
+  DINGO_LOG(INFO) << fmt::format("load meta cache snapshot, regions:{}, vector indexes:{}, document indexes:{}",
+                                 regions.regions_size(), vector_defs.size(), document_defs.size());
+  return Status::OK();
+}
+
+Status MetaCacheSnapshot::Save(const ClientStub& stub, const std::string& path) {
+  std::string data;
+  DINGO_RETURN_NOT_OK(Encode(stub, data));
+
+  static std::atomic<uint64_t> seq{0};
+  std::string tmp_path = fmt::format("{}.tmp.{}.{}", path, getpid(), seq.fetch_add(1));
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return Status::IOError(fmt::format("fail open meta cache snapshot file:{}", tmp_path));
+    }
+    file.write(data.data(), data.size());
+    if (!file) {
+      std::remove(tmp_path.c_str());
+      return Status::IOError(fmt::format("fail write meta cache snapshot file:{}", tmp_path));
+    }
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return Status::IOError(fmt::format("fail rename meta cache snapshot file:{} to {}", tmp_path, path));
+  }
+  return Status::OK();
+}
+
+Status MetaCacheSnapshot::Load(const ClientStub& stub, const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return Status::NotFound(fmt::format("meta cache snapshot file:{} not exist", path));
+  }
+
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return Decode(stub, ss.str());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,57 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_META_CACHE_SNAPSHOT_H_
+#define DINGODB_SDK_META_CACHE_SNAPSHOT_H_
+
+#include <cstdint>
+#include <string>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// Persist region routes of meta cache and entries of vector/document index cache to a local file,
+// so a restarted client starts with warm caches instead of asking coordinator for every route.
+// Loaded entries are not verified, stale ones are dropped lazily when store replies region epoch errors.
+//
+// file layout, integers in host byte order:
+//   magic(4) | version(u32) | record count(u32) | records | checksum(u64, fnv1a of all bytes before)
+//   record: type(u8) | size(u32) | serialized protobuf
+class MetaCacheSnapshot {
+ public:
+  // write to a temp file then rename, concurrent writers of the same path never leave a torn file
+  static Status Save(const ClientStub& stub, const std::string& path);
+
+  // return NotFound when file not exist, Corruption when file is broken
+  static Status Load(const ClientStub& stub, const std::string& path);
+
+  static Status Encode(const ClientStub& stub, std::string& out);
+
+  static Status Decode(const ClientStub& stub, const std::string& data);
+
+ private:
+  enum RecordType : uint8_t {
+    kRegion = 1,
+    kVectorIndex = 2,
+    kDocumentIndex = 3,
+  };
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_META_CACHE_SNAPSHOT_H_
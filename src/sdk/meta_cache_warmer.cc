@@ -0,0 +1,178 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/meta_cache_warmer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
+#include "sdk/document/document_index.h"
+#include "sdk/meta_cache.h"
+#include "sdk/vector/vector_index.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+std::vector<std::string> SplitFlag(const std::string& value) {
+  std::vector<std::string> items;
+  std::stringstream ss(value);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+std::vector<int64_t> SplitIdFlag(const std::string& value) {
+  std::vector<int64_t> ids;
+  for (const auto& item : SplitFlag(value)) {
+    char* end = nullptr;
+    int64_t id = std::strtoll(item.c_str(), &end, 10);
+    if (end == item.c_str() || *end != '\0' || id <= 0) {
+      DINGO_LOG(WARNING) << "skip invalid index id:" << item << " in meta cache warmup flag";
+      continue;
+    }
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+// smallest key greater than every key with prefix, empty when no such key
+std::string PrefixEnd(const std::string& prefix) {
+  std::string end = prefix;
+  while (!end.empty()) {
+    auto& last = reinterpret_cast<unsigned char&>(end.back());
+    if (last != 0xFF) {
+      last++;
+      return end;
+    }
+    end.pop_back();
+  }
+  return end;
+}
+}  // namespace
+
+Status MetaCacheWarmer::CollectRanges(std::vector<std::pair<std::string, std::string>>& out_ranges) {
+  Status ret;
+  for (const auto& prefix : SplitFlag(FLAGS_meta_cache_warmup_key_prefixes)) {
+    std::string end = PrefixEnd(prefix);
+    if (end.empty()) {
+      DINGO_LOG(WARNING) << "skip meta cache warmup prefix without upper bound:" << prefix;
+      continue;
+    }
+    out_ranges.emplace_back(prefix, std::move(end));
+  }
+
+  for (int64_t id : SplitIdFlag(FLAGS_meta_cache_warmup_vector_index_ids)) {
+    std::shared_ptr<VectorIndex> index;
+    Status s = stub_.GetVectorIndexCache()->GetVectorIndexById(id, index);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "fail get vector index:" << id << " for meta cache warmup, status:" << s.ToString();
+      ret = ret.ok() ? s : ret;
+      continue;
+    }
+    for (int64_t part_id : index->GetPartitionIds()) {
+      const auto& range = index->GetPartitionRange(part_id);
+      out_ranges.emplace_back(range.start_key(), range.end_key());
+    }
+  }
+
+  for (int64_t id : SplitIdFlag(FLAGS_meta_cache_warmup_document_index_ids)) {
+    std::shared_ptr<DocumentIndex> index;
+    Status s = stub_.GetDocumentIndexCache()->GetDocumentIndexById(id, index);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "fail get document index:" << id << " for meta cache warmup, status:" << s.ToString();
+      ret = ret.ok() ? s : ret;
+      continue;
+    }
+    for (int64_t part_id : index->GetPartitionIds()) {
+      const auto& range = index->GetPartitionRange(part_id);
+      out_ranges.emplace_back(range.start_key(), range.end_key());
+    }
+  }
+
+  return ret;
+}
+
+Status MetaCacheWarmer::Warmup() {
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::pair<std::string, std::string>> ranges;
+  Status ret = CollectRanges(ranges);
+  if (ranges.empty()) {
+    return ret;
+  }
+
+  int64_t region_count = 0;
+  for (const auto& [start_key, end_key] : ranges) {
+    std::vector<std::shared_ptr<Region>> regions;
+    // limit 0 means all regions in range, they are put into meta cache
+    Status s = stub_.GetMetaCache()->ScanRegionsBetweenRange(start_key, end_key, 0, regions);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("fail warmup meta cache for range:[{},{}), status:{}", start_key, end_key,
+                                        s.ToString());
+      ret = ret.ok() ? s : ret;
+      continue;
+    }
+    region_count += regions.size();
+  }
+
+  auto cost_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  DINGO_LOG(INFO) << fmt::format("meta cache warmup load {} regions of {} ranges, cost:{}ms, status:{}", region_count,
+                                 ranges.size(), cost_ms, ret.ToString());
+  return ret;
+}
+
+void MetaCacheWarmer::Start() {
+  if (FLAGS_meta_cache_refresh_interval_s <= 0) {
+    return;
+  }
+  ScheduleNext();
+}
+
+void MetaCacheWarmer::ScheduleNext() {
+  if (IsStopped()) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [self] {
+        if (self->IsStopped()) {
+          return;
+        }
+        self->Warmup();
+        self->ScheduleNext();
+      },
+      FLAGS_meta_cache_refresh_interval_s * 1000);
+  if (!scheduled) {
+    DINGO_LOG(WARNING) << "Fail schedule meta cache refresh";
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
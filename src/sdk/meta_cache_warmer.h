@@ -0,0 +1,67 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_META_CACHE_WARMER_H_
+#define DINGODB_SDK_META_CACHE_WARMER_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// bulk load region routes of FLAGS_meta_cache_warmup_key_prefixes and the partitions of
+// FLAGS_meta_cache_warmup_vector_index_ids/FLAGS_meta_cache_warmup_document_index_ids into meta cache,
+// so first requests after client build do not all go to coordinator one region at a time.
+// when FLAGS_meta_cache_refresh_interval_s > 0 the same ranges are reloaded periodically in actuator.
+// NOTE: client stub must outlive the warmer
+class MetaCacheWarmer : public std::enable_shared_from_this<MetaCacheWarmer> {
+ public:
+  MetaCacheWarmer(const MetaCacheWarmer&) = delete;
+  const MetaCacheWarmer& operator=(const MetaCacheWarmer&) = delete;
+
+  explicit MetaCacheWarmer(const ClientStub& stub) : stub_(stub) {}
+
+  ~MetaCacheWarmer() = default;
+
+  // load all configured ranges, return first fail status, ranges after a failed one are still loaded
+  Status Warmup();
+
+  // start periodic refresh, no-op when refresh is disabled
+  void Start();
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  bool IsStopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // [start_key, end_key) of every configured target
+  Status CollectRanges(std::vector<std::pair<std::string, std::string>>& out_ranges);
+
+ private:
+  void ScheduleNext();
+
+  const ClientStub& stub_;
+  std::atomic<bool> stopped_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_META_CACHE_WARMER_H_
@@ -0,0 +1,106 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/meta_cache_watcher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+std::vector<std::pair<std::string, std::string>> MetaCacheWatcher::MergeRanges(
+    const std::vector<std::shared_ptr<Region>>& regions) {
+  std::vector<std::pair<std::string, std::string>> ranges;
+  for (const auto& region : regions) {
+    const auto& range = region->Range();
+    if (!ranges.empty() && ranges.back().second == range.start_key()) {
+      ranges.back().second = range.end_key();
+    } else {
+      ranges.emplace_back(range.start_key(), range.end_key());
+    }
+  }
+  return ranges;
+}
+
+Status MetaCacheWatcher::WatchOnce(int64_t& out_changed) {
+  auto start = std::chrono::steady_clock::now();
+  out_changed = 0;
+
+  auto meta_cache = stub_.GetMetaCache();
+  // one rpc per contiguous range instead of per region
+  auto ranges = MergeRanges(meta_cache->ListRegions());
+
+  Status ret;
+  for (const auto& [start_key, end_key] : ranges) {
+    int64_t changed = 0;
+    Status s = meta_cache->RefreshRegionsBetweenRange(start_key, end_key, changed);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("fail watch meta cache range:[{},{}), status:{}", start_key, end_key,
+                                        s.ToString());
+      ret = ret.ok() ? s : ret;
+      continue;
+    }
+    out_changed += changed;
+  }
+
+  if (out_changed > 0) {
+    auto cost_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    DINGO_LOG(INFO) << fmt::format("meta cache watch apply {} region changes of {} ranges, cost:{}ms", out_changed,
+                                   ranges.size(), cost_ms);
+  }
+  return ret;
+}
+
+void MetaCacheWatcher::Start() {
+  if (FLAGS_meta_cache_watch_interval_ms <= 0) {
+    return;
+  }
+  ScheduleNext();
+}
+
+void MetaCacheWatcher::ScheduleNext() {
+  if (IsStopped()) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [self] {
+        if (self->IsStopped()) {
+          return;
+        }
+        int64_t changed = 0;
+        self->WatchOnce(changed);
+        self->ScheduleNext();
+      },
+      FLAGS_meta_cache_watch_interval_ms);
+  if (!scheduled) {
+    DINGO_LOG(WARNING) << "Fail schedule meta cache watch";
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
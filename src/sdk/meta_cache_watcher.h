@@ -0,0 +1,70 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_META_CACHE_WATCHER_H_
+#define DINGODB_SDK_META_CACHE_WATCHER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdk/region.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// watch region changes of the key ranges held in meta cache, when FLAGS_meta_cache_watch_interval_ms > 0 the
+// ranges are re-scanned from coordinator in actuator, so region split, merge and leader changes are applied to
+// meta cache before requests hit the stale routes.
+// NOTE: client stub must outlive the watcher
+class MetaCacheWatcher : public std::enable_shared_from_this<MetaCacheWatcher> {
+ public:
+  MetaCacheWatcher(const MetaCacheWatcher&) = delete;
+  const MetaCacheWatcher& operator=(const MetaCacheWatcher&) = delete;
+
+  explicit MetaCacheWatcher(const ClientStub& stub) : stub_(stub) {}
+
+  ~MetaCacheWatcher() = default;
+
+  // one round of watch, return first fail status, ranges after a failed one are still watched,
+  // out_changed is the count of regions added or whose leader changed
+  Status WatchOnce(int64_t& out_changed);
+
+  // start periodic watch, no-op when watch is disabled
+  void Start();
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  bool IsStopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // regions must be ordered by start key, adjacent regions are merged into one [start_key, end_key)
+  static std::vector<std::pair<std::string, std::string>> MergeRanges(
+      const std::vector<std::shared_ptr<Region>>& regions);
+
+ private:
+  void ScheduleNext();
+
+  const ClientStub& stub_;
+  std::atomic<bool> stopped_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_META_CACHE_WATCHER_H_
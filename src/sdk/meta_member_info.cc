@@ -57,16 +57,16 @@ void MetaMemberInfo::MarkFollower(const EndPoint &end_point) {
   if (leader_ == end_point) {
     leader_.ReSet();
   }
-
-  auto it = std::find(members_.begin(), members_.end(), end_point);
-  if (it == members_.end()) {
-    members_.push_back(end_point);
-  }
+  // an endpoint not in members is dropped by SetMembers, rpcs still in flight to it must not add it back
 }
 
 void MetaMemberInfo::SetMembers(std::vector<EndPoint> members) {
+  CHECK(!members.empty());
   std::unique_lock lock(rw_lock_);
   members_ = std::move(members);
+  if (leader_.IsValid() && std::find(members_.begin(), members_.end(), leader_) == members_.end()) {
+    leader_.ReSet();
+  }
 }
 
 std::vector<EndPoint> MetaMemberInfo::GetMembers() const {
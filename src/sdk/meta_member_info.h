@@ -41,6 +41,7 @@ class MetaMemberInfo {
 
   std::vector<EndPoint> GetMembers() const;
 
+  // replace all members, leader is forgotten when it is not in members
   void SetMembers(std::vector<EndPoint> members);
 
   std::string ToString() const {
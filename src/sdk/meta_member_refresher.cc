@@ -0,0 +1,175 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/meta_member_refresher.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/common.h"
+#include "sdk/common/helper.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/coordinator_rpc_controller.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+const std::string kFileNamingServicePrefix = "file://";
+
+bool IsValidPort(const std::string& port) {
+  return !port.empty() && port.size() <= 5 && std::all_of(port.begin(), port.end(), ::isdigit) &&
+         std::stoi(port) <= 65535;
+}
+
+std::vector<EndPoint> SortedMembers(std::vector<EndPoint> members) {
+  std::sort(members.begin(), members.end());
+  return members;
+}
+}  // namespace
+
+Status MetaMemberRefresher::ReadNamingService(const std::string& naming_service_url,
+                                              std::vector<EndPoint>& out_endpoints) {
+  if (naming_service_url.compare(0, kFileNamingServicePrefix.size(), kFileNamingServicePrefix) != 0) {
+    return Status::InvalidArgument(fmt::format("invalid naming_service_url:{}", naming_service_url));
+  }
+
+  std::string file_path = naming_service_url.substr(kFileNamingServicePrefix.size());
+  std::ifstream file(file_path);
+  if (!file.is_open()) {
+    return Status::IOError(fmt::format("fail open naming service file:{}", file_path));
+  }
+
+  out_endpoints.clear();
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line.find('#') == 0) {
+      continue;
+    }
+
+    size_t pos = line.find(':');
+    if (pos == std::string::npos || pos == 0 || !IsValidPort(line.substr(pos + 1))) {
+      DINGO_LOG(WARNING) << "skip invalid naming service line:" << line << " of file:" << file_path;
+      continue;
+    }
+    EndPoint endpoint = StringToEndPoint(line);
+    if (endpoint.IsValid() &&
+        std::find(out_endpoints.begin(), out_endpoints.end(), endpoint) == out_endpoints.end()) {
+      out_endpoints.push_back(endpoint);
+    }
+  }
+
+  return Status::OK();
+}
+
+void MetaMemberRefresher::SetNamingServiceUrl(std::string naming_service_url) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  naming_service_url_ = std::move(naming_service_url);
+}
+
+Status MetaMemberRefresher::LoadFromCoordinator(std::vector<EndPoint>& out_endpoints) {
+  GetCoordinatorMapRpc rpc;
+  DINGO_RETURN_NOT_OK(stub_.GetCoordinatorRpcController()->SyncCall(rpc));
+
+  out_endpoints.clear();
+  const auto* response = rpc.Response();
+  for (const auto& location : response->coordinator_locations()) {
+    if (location.host().empty()) {
+      continue;
+    }
+    EndPoint endpoint = LocationToEndPoint(location);
+    if (std::find(out_endpoints.begin(), out_endpoints.end(), endpoint) == out_endpoints.end()) {
+      out_endpoints.push_back(endpoint);
+    }
+  }
+  return Status::OK();
+}
+
+Status MetaMemberRefresher::RefreshOnce(bool& out_changed) {
+  out_changed = false;
+
+  std::string naming_service_url;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    naming_service_url = naming_service_url_;
+  }
+
+  std::vector<EndPoint> members;
+  Status s = naming_service_url.empty() ? LoadFromCoordinator(members) : ReadNamingService(naming_service_url, members);
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "fail load coordinator members, keep current ones, status:" << s.ToString();
+    return s;
+  }
+  if (members.empty()) {
+    DINGO_LOG(WARNING) << "no coordinator member loaded, keep current ones";
+    return Status::NotFound("no coordinator member");
+  }
+
+  auto coordinator_controller = stub_.GetCoordinatorRpcController();
+  if (SortedMembers(coordinator_controller->GetMembers()) == SortedMembers(members)) {
+    return Status::OK();
+  }
+
+  std::string members_str;
+  for (const auto& member : members) {
+    members_str += member.ToString() + ",";
+  }
+  DINGO_LOG(INFO) << "coordinator members change to:" << members_str;
+
+  coordinator_controller->SetMembers(members);
+  stub_.GetMetaRpcController()->SetMembers(std::move(members));
+  out_changed = true;
+  return Status::OK();
+}
+
+void MetaMemberRefresher::Start() {
+  if (FLAGS_coordinator_member_refresh_interval_ms <= 0) {
+    return;
+  }
+  ScheduleNext();
+}
+
+void MetaMemberRefresher::ScheduleNext() {
+  if (IsStopped()) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [self] {
+        if (self->IsStopped()) {
+          return;
+        }
+        bool changed = false;
+        self->RefreshOnce(changed);
+        self->ScheduleNext();
+      },
+      FLAGS_coordinator_member_refresh_interval_ms);
+  if (!scheduled) {
+    DINGO_LOG(WARNING) << "Fail schedule coordinator member refresh";
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,76 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_META_MEMBER_REFRESHER_H_
+#define DINGODB_SDK_META_MEMBER_REFRESHER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "sdk/status.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// keep coordinator members of coordinator and meta rpc controllers up to date, when
+// FLAGS_coordinator_member_refresh_interval_ms > 0 members are reloaded in actuator from the naming service file
+// the client was built with, or from the coordinator map when it was built with addrs, so replaced coordinators
+// are dropped instead of being failed over to with full timeouts.
+// NOTE: client stub must outlive the refresher
+class MetaMemberRefresher : public std::enable_shared_from_this<MetaMemberRefresher> {
+ public:
+  MetaMemberRefresher(const MetaMemberRefresher&) = delete;
+  const MetaMemberRefresher& operator=(const MetaMemberRefresher&) = delete;
+
+  explicit MetaMemberRefresher(const ClientStub& stub) : stub_(stub) {}
+
+  ~MetaMemberRefresher() = default;
+
+  // file:// url the client was built with, empty means members are loaded from coordinator map
+  void SetNamingServiceUrl(std::string naming_service_url);
+
+  // one round of refresh, members are kept when loading fails or finds no member, out_changed is true when
+  // members are replaced
+  Status RefreshOnce(bool& out_changed);
+
+  // start periodic refresh, no-op when refresh is disabled
+  void Start();
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  bool IsStopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // endpoints of a file naming service, empty lines, comments and invalid lines are skipped
+  static Status ReadNamingService(const std::string& naming_service_url, std::vector<EndPoint>& out_endpoints);
+
+ private:
+  Status LoadFromCoordinator(std::vector<EndPoint>& out_endpoints);
+
+  void ScheduleNext();
+
+  const ClientStub& stub_;
+  std::mutex mutex_;
+  std::string naming_service_url_;
+  std::atomic<bool> stopped_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_META_MEMBER_REFRESHER_H_
@@ -0,0 +1,65 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/partition_region_cache.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+bool PartitionRegionCache::IsValid(const std::vector<std::shared_ptr<Region>>& regions) {
+  for (const auto& region : regions) {
+    if (region->IsStale()) {
+      return false;
+    }
+  }
+  return !regions.empty();
+}
+
+Status PartitionRegionCache::GetRegions(MetaCache& meta_cache, int64_t part_id, const pb::common::Range& range,
+                                        std::vector<std::shared_ptr<Region>>& regions) {
+  if (!FLAGS_enable_partition_region_cache) {
+    return meta_cache.ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto iter = part_regions_.find(part_id);
+    if (iter != part_regions_.end() && IsValid(iter->second)) {
+      regions = iter->second;
+      return Status::OK();
+    }
+  }
+
+  std::vector<std::shared_ptr<Region>> tmp_regions;
+  DINGO_RETURN_NOT_OK(meta_cache.ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), tmp_regions));
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    part_regions_[part_id] = tmp_regions;
+  }
+  regions = std::move(tmp_regions);
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
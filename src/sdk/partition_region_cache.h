@@ -0,0 +1,60 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_PARTITION_REGION_CACHE_H_
+#define DINGODB_SDK_PARTITION_REGION_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "proto/common.pb.h"
+#include "sdk/region.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class MetaCache;
+
+// Regions of every partition of a vector or document index, so part tasks do not walk the region map of MetaCache
+// on every request. The regions are the MetaCache ones, MetaCache marks a region stale when its epoch changes or it
+// is cleared on a region version, key out of range or region not found error, then the partition is looked up again.
+// Disabled by FLAGS_enable_partition_region_cache.
+// NOTE: thread safe
+class PartitionRegionCache {
+ public:
+  PartitionRegionCache() = default;
+  ~PartitionRegionCache() = default;
+
+  PartitionRegionCache(const PartitionRegionCache&) = delete;
+  const PartitionRegionCache& operator=(const PartitionRegionCache&) = delete;
+
+  // continuous regions of range of the partition, as MetaCache::ScanRegionsBetweenContinuousRange
+  Status GetRegions(MetaCache& meta_cache, int64_t part_id, const pb::common::Range& range,
+                    std::vector<std::shared_ptr<Region>>& regions);
+
+ private:
+  static bool IsValid(const std::vector<std::shared_ptr<Region>>& regions);
+
+  std::mutex mutex_;
+  std::unordered_map<int64_t, std::vector<std::shared_ptr<Region>>> part_regions_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_PARTITION_REGION_CACHE_H_
@@ -0,0 +1,185 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_auto_batcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "sdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rawkv/raw_kv_batch_get_task.h"
+#include "sdk/rawkv/raw_kv_batch_put_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+Status RawKvAutoBatcher::Put(const std::string& key, const std::string& value) {
+  PutWaiter waiter{&key, &value, CurrentRequestPriority()};
+  Submit(puts_, &waiter, [this](std::vector<PutWaiter*> batch) { FlushPuts(std::move(batch)); });
+  return waiter.status;
+}
+
+Status RawKvAutoBatcher::Get(const std::string& key, std::string& out_value) {
+  GetWaiter waiter{&key, &out_value, CurrentRequestPriority()};
+  Submit(gets_, &waiter, [this](std::vector<GetWaiter*> batch) { FlushGets(std::move(batch)); });
+  return waiter.status;
+}
+
+template <class Waiter, class Flush>
+void RawKvAutoBatcher::Submit(BatchQueue<Waiter>& queue, Waiter* waiter, Flush&& flush) {
+  size_t max_batch_size = std::max<int64_t>(FLAGS_raw_kv_auto_batch_max_size, 1);
+  int64_t max_inflight = std::max<int64_t>(FLAGS_raw_kv_auto_batch_max_inflight, 1);
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  queue.pending.push_back(waiter);
+  if (queue.pending.size() >= max_batch_size) {
+    // wake up the leader waiting for the batch to fill
+    queue.cv.notify_all();
+  }
+
+  while (!waiter->done) {
+    if (waiter->batched || queue.collecting || queue.inflight >= max_inflight) {
+      queue.cv.wait(lk);
+      continue;
+    }
+
+    queue.collecting = true;
+    if (FLAGS_raw_kv_auto_batch_max_delay_us > 0) {
+      queue.cv.wait_for(lk, std::chrono::microseconds(FLAGS_raw_kv_auto_batch_max_delay_us),
+                        [&] { return queue.pending.size() >= max_batch_size; });
+    }
+
+    // higher priority first, fifo within the same priority
+    std::stable_sort(queue.pending.begin(), queue.pending.end(),
+                     [](const Waiter* a, const Waiter* b) { return a->priority < b->priority; });
+    std::vector<Waiter*> batch;
+    batch.reserve(std::min(queue.pending.size(), max_batch_size));
+    while (!queue.pending.empty() && batch.size() < max_batch_size) {
+      Waiter* w = queue.pending.front();
+      queue.pending.pop_front();
+      w->batched = true;
+      batch.push_back(w);
+    }
+    queue.collecting = false;
+    queue.inflight++;
+    // let one of the remaining waiters lead next batch
+    queue.cv.notify_all();
+    lk.unlock();
+
+    {
+      ScopedRequestPriority scope(batch.front()->priority);
+      flush(std::move(batch));
+    }
+
+    lk.lock();
+  }
+}
+
+template <class Waiter>
+void RawKvAutoBatcher::FinishBatch(BatchQueue<Waiter>& queue, const std::vector<Waiter*>& batch) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (Waiter* w : batch) {
+    w->done = true;
+  }
+  queue.inflight--;
+  // wake up finished waiters and the waiter blocked by max inflight
+  queue.cv.notify_all();
+}
+
+void RawKvAutoBatcher::FlushPuts(std::vector<PutWaiter*> batch) {
+  // the same key may be put by concurrent callers, keep the last one
+  std::unordered_map<std::string_view, size_t> key_to_index;
+  std::vector<KVPair> kvs;
+  kvs.reserve(batch.size());
+  for (const PutWaiter* waiter : batch) {
+    auto iter = key_to_index.find(*waiter->key);
+    if (iter == key_to_index.end()) {
+      key_to_index.emplace(*waiter->key, kvs.size());
+      kvs.push_back({*waiter->key, *waiter->value});
+    } else {
+      kvs[iter->second].value = *waiter->value;
+    }
+  }
+
+  // task is owned by callback
+  auto* task = new RawKvBatchPutTask(stub_, std::move(kvs));
+  task->AsyncRun([this, task, batch = std::move(batch)](Status status) {
+    delete task;
+    put_batch_count_.fetch_add(1, std::memory_order_relaxed);
+    if (!status.ok()) {
+      DINGO_LOG(WARNING) << "auto batch put fail, batch size: " << batch.size() << ", status: " << status.ToString();
+    }
+
+    for (PutWaiter* waiter : batch) {
+      waiter->status = status;
+    }
+    FinishBatch(puts_, batch);
+  });
+}
+
+void RawKvAutoBatcher::FlushGets(std::vector<GetWaiter*> batch) {
+  // keys of waiters are valid until they are done
+  std::vector<std::string_view> keys;
+  keys.reserve(batch.size());
+  {
+    std::unordered_set<std::string_view> unique_keys;
+    for (const GetWaiter* waiter : batch) {
+      if (unique_keys.insert(*waiter->key).second) {
+        keys.push_back(*waiter->key);
+      }
+    }
+  }
+
+  // task and out_kvs are owned by callback
+  auto out_kvs = std::make_shared<std::vector<KVPair>>();
+  auto* task = new RawKvBatchGetTask(stub_, std::move(keys), *out_kvs);
+  task->AsyncRun([this, task, out_kvs, batch = std::move(batch)](Status status) {
+    delete task;
+    get_batch_count_.fetch_add(1, std::memory_order_relaxed);
+    if (!status.ok()) {
+      DINGO_LOG(WARNING) << "auto batch get fail, batch size: " << batch.size() << ", status: " << status.ToString();
+    }
+
+    std::unordered_map<std::string_view, std::string> values;
+    for (auto& kv : *out_kvs) {
+      values.emplace(kv.key, std::move(kv.value));
+    }
+
+    for (GetWaiter* waiter : batch) {
+      waiter->status = status;
+      if (status.ok()) {
+        auto iter = values.find(*waiter->key);
+        // same as RawKvGetTask, out_value is untouched when key not found
+        if (iter != values.end() && !iter->second.empty()) {
+          *waiter->out_value = iter->second;
+        }
+      }
+    }
+    FinishBatch(gets_, batch);
+  });
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,118 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_AUTO_BATCHER_H_
+#define DINGODB_SDK_RAW_KV_AUTO_BATCHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "sdk/request_priority.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// Concurrent single key RawKV::Put/Get are collected for at most
+// FLAGS_raw_kv_auto_batch_max_delay_us or FLAGS_raw_kv_auto_batch_max_size
+// ops, then the first caller (the leader) sends them async with
+// RawKvBatchPutTask or RawKvBatchGetTask, which split keys by region, and the
+// rpc callback hands the result back to every caller of the batch. Once a batch
+// is sent the next waiter leads the next one, up to
+// FLAGS_raw_kv_auto_batch_max_inflight batches of put or get are in flight.
+// NOTE: one batch put or get fails as a whole, every caller of the batch get
+// the first failed status even if its own region succeeded.
+// Waiters of higher RequestPriority are taken into a batch first, and a batch is
+// sent at the priority of its highest waiter.
+class RawKvAutoBatcher {
+ public:
+  RawKvAutoBatcher(const RawKvAutoBatcher&) = delete;
+  const RawKvAutoBatcher& operator=(const RawKvAutoBatcher&) = delete;
+
+  explicit RawKvAutoBatcher(const ClientStub& stub) : stub_(stub) {}
+
+  ~RawKvAutoBatcher() = default;
+
+  Status Put(const std::string& key, const std::string& value);
+
+  Status Get(const std::string& key, std::string& out_value);
+
+  int64_t PutRpcBatchCount() const { return put_batch_count_.load(std::memory_order_relaxed); }
+
+  int64_t GetRpcBatchCount() const { return get_batch_count_.load(std::memory_order_relaxed); }
+
+ private:
+  struct PutWaiter {
+    const std::string* key;
+    const std::string* value;
+    RequestPriority priority;
+    Status status;
+    // taken into a batch
+    bool batched{false};
+    bool done{false};
+  };
+
+  struct GetWaiter {
+    const std::string* key;
+    std::string* out_value;
+    RequestPriority priority;
+    Status status;
+    // taken into a batch
+    bool batched{false};
+    bool done{false};
+  };
+
+  template <class Waiter>
+  struct BatchQueue {
+    std::deque<Waiter*> pending;
+    // a leader is waiting for the batch to fill
+    bool collecting{false};
+    int64_t inflight{0};
+    std::condition_variable cv;
+  };
+
+  // enqueue waiter and block until its batch is done, lead the next batch when no one is collecting and less than
+  // FLAGS_raw_kv_auto_batch_max_inflight batches are in flight
+  template <class Waiter, class Flush>
+  void Submit(BatchQueue<Waiter>& queue, Waiter* waiter, Flush&& flush);
+
+  // called by rpc callback after status of waiters is set
+  template <class Waiter>
+  void FinishBatch(BatchQueue<Waiter>& queue, const std::vector<Waiter*>& batch);
+
+  // send batch async, waiters are done in rpc callback
+  void FlushPuts(std::vector<PutWaiter*> batch);
+
+  void FlushGets(std::vector<GetWaiter*> batch);
+
+  const ClientStub& stub_;
+
+  std::mutex mutex_;
+  BatchQueue<PutWaiter> puts_;
+  BatchQueue<GetWaiter> gets_;
+
+  std::atomic<int64_t> put_batch_count_{0};
+  std::atomic<int64_t> get_batch_count_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RAW_KV_AUTO_BATCHER_H_
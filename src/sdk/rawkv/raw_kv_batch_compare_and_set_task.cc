@@ -18,6 +18,7 @@
 
 #include "glog/logging.h"
 #include "sdk/common/common.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
 #include "sdk/rawkv/raw_kv_task.h"
 
 namespace dingodb {
@@ -31,13 +32,14 @@ RawKvBatchCompareAndSetTask::RawKvBatchCompareAndSetTask(const ClientStub& stub,
 Status RawKvBatchCompareAndSetTask::Init() {
   CHECK_EQ(kvs_.size(), expected_values_.size()) << "kvs size must equal expected_values size";
   std::unique_lock<std::shared_mutex> w(rw_lock_);
+  std::string_view dup_key;
+  CHECK(BuildKeyIndex(
+      kvs_, [](const KVPair& kv) -> std::string_view { return kv.key; }, key_index_, dup_key))
+      << "duplicate key: " << dup_key;
+
   next_keys_.clear();
-  for (auto i = 0; i < kvs_.size(); i++) {
-    const auto& kv = kvs_[i];
-    const auto& expected_value = expected_values_[i];
-    CHECK(next_keys_.insert(kv.key).second) << "next_keys_ exist duplicate key: " << kv.key;
-    CHECK(compare_and_set_contexts_.insert({kv.key, {kv, expected_value}}).second)
-        << "compare_and_set_contexts_ exist duplicate key: " << kv.key;
+  for (const auto& kv : kvs_) {
+    next_keys_.insert(kv.key);
   }
 
   return Status::OK();
@@ -56,63 +58,49 @@ void RawKvBatchCompareAndSetTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<std::string_view>> region_keys;
-
-  auto meta_cache = stub.GetMetaCache();
-
-  for (const auto& key : next_batch) {
-    std::shared_ptr<Region> region;
-    Status s = meta_cache->LookupRegionByKey(key, region);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    }
-    auto iter = region_id_to_region.find(region->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(region->RegionId(), region));
-    }
-
-    region_keys[region->RegionId()].push_back(key);
+  std::vector<RegionKeys> groups;
+  Status s = PartitionKeysByRegion(*stub.GetMetaCache(), next_batch, groups);
+  if (!s.ok()) {
+    // TODO: continue
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
+  controllers_.reserve(groups.size());
+  rpcs_.reserve(groups.size());
 
-  for (const auto& entry : region_keys) {
-    auto region_id = entry.first;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+    auto region_id = region->RegionId();
 
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
-
-    auto rpc = std::make_unique<KvBatchCompareAndSetRpc>();
+    auto rpc = RpcPool<KvBatchCompareAndSetRpc>::Acquire();
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
     rpc->MutableRequest()->set_is_atomic(false);
-    for (const auto& key : entry.second) {
-      const auto& key_context = compare_and_set_contexts_.find(key);
-      CHECK(key_context != compare_and_set_contexts_.end()) << "can't find key:" << key;
+    for (const auto& key : group.keys) {
+      auto iter = key_index_.find(key);
+      CHECK(iter != key_index_.end()) << "can't find key:" << key;
 
       auto* kv = rpc->MutableRequest()->add_kvs();
-      const KVPair& kv_pair = key_context->second.kv_pair;
+      const KVPair& kv_pair = kvs_[iter->second];
       kv->set_key(kv_pair.key);
       kv->set_value(kv_pair.value);
-      *(rpc->MutableRequest()->add_expect_values()) = key_context->second.expected_value;
+      *(rpc->MutableRequest()->add_expect_values()) = expected_values_[iter->second];
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  CHECK_EQ(rpcs_.size(), region_keys.size());
+  CHECK_EQ(rpcs_.size(), groups.size());
   CHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_keys.size());
+  sub_tasks_count_.store(groups.size());
+  RecordFanOut(groups.size());
 
-  for (auto i = 0; i < region_keys.size(); i++) {
+  for (auto i = 0; i < groups.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -122,8 +110,8 @@ void RawKvBatchCompareAndSetTask::DoAsync() {
 
 void RawKvBatchCompareAndSetTask::KvBatchCompareAndSetRpcCallback(const Status& status, KvBatchCompareAndSetRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -156,6 +144,16 @@ void RawKvBatchCompareAndSetTask::PostProcess() {
   out_states_.swap(tmp_out_states_);
 }
 
+void RawKvBatchCompareAndSetTask::InvalidateReadCache() {
+  auto read_cache = stub.GetRawKvReadCache();
+  if (!read_cache->Enabled()) {
+    return;
+  }
+  for (const auto& kv : kvs_) {
+    read_cache->Invalidate(kv.key);
+  }
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
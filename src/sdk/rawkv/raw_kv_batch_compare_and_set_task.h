@@ -20,7 +20,9 @@
 #include <vector>
 
 #include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
 #include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/rpc/rpc_pool.h"
 #include "sdk/status.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
@@ -40,23 +42,20 @@ class RawKvBatchCompareAndSetTask : public RawKvTask {
 
   std::string Name() const override { return "RawKvBatchCompareAndSetTask"; }
 
-  void KvBatchCompareAndSetRpcCallback(const Status& status, KvBatchCompareAndSetRpc* rpc);
+  void InvalidateReadCache() override;
 
-  struct CompareAndSetContext {
-    const KVPair& kv_pair;
-    const std::string& expected_value;
-  };
+  void KvBatchCompareAndSetRpcCallback(const Status& status, KvBatchCompareAndSetRpc* rpc);
 
   const std::vector<KVPair>& kvs_;
   const std::vector<std::string>& expected_values_;
   std::vector<KeyOpState>& out_states_;
   std::vector<KeyOpState> tmp_out_states_;
 
-  // should not change
-  std::map<std::string_view, CompareAndSetContext> compare_and_set_contexts_;
+  // should not change after Init, index into both kvs_ and expected_values_
+  KeyIndexMap key_index_;
 
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<KvBatchCompareAndSetRpc>> rpcs_;
+  std::vector<RpcPool<KvBatchCompareAndSetRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   std::set<std::string_view> next_keys_;
@@ -14,19 +14,23 @@
 
 #include "sdk/rawkv/raw_kv_batch_delete_task.h"
 
+#include <string>
+#include <utility>
+
 #include "sdk/common/common.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
 #include "sdk/rawkv/raw_kv_task.h"
 
 namespace dingodb {
 namespace sdk {
-RawKvBatchDeleteTask::RawKvBatchDeleteTask(const ClientStub& stub, const std::vector<std::string>& keys)
-    : RawKvTask(stub), keys_(keys) {}
+RawKvBatchDeleteTask::RawKvBatchDeleteTask(const ClientStub& stub, std::vector<std::string_view> keys)
+    : RawKvTask(stub), keys_(std::move(keys)) {}
 
 Status RawKvBatchDeleteTask::Init() {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   next_keys_.clear();
-  for (const auto& str : keys_) {
-    CHECK(next_keys_.insert(str).second) << "duplicate key: " << str;
+  for (const auto& key : keys_) {
+    CHECK(next_keys_.insert(key).second) << "duplicate key: " << key;
   }
   return Status::OK();
 }
@@ -44,54 +48,41 @@ void RawKvBatchDeleteTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<std::string_view>> region_keys;
-
-  auto meta_cache = stub.GetMetaCache();
-  for (const auto& key : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(key, tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    }
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_keys[tmp->RegionId()].push_back(key);
+  std::vector<RegionKeys> groups;
+  Status s = PartitionKeysByRegion(*stub.GetMetaCache(), next_batch, groups);
+  if (!s.ok()) {
+    // TODO: continue
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
+  controllers_.reserve(groups.size());
+  rpcs_.reserve(groups.size());
 
-  for (const auto& entry : region_keys) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+    auto region_id = region->RegionId();
 
-    auto rpc = std::make_unique<KvBatchDeleteRpc>();
+    auto rpc = RpcPool<KvBatchDeleteRpc>::Acquire();
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-    for (const auto& key : entry.second) {
+    for (const auto& key : group.keys) {
       *(rpc->MutableRequest()->add_keys()) = key;
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  CHECK_EQ(rpcs_.size(), region_keys.size());
+  CHECK_EQ(rpcs_.size(), groups.size());
   CHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_keys.size());
+  sub_tasks_count_.store(groups.size());
+  RecordFanOut(groups.size());
 
-  for (auto i = 0; i < region_keys.size(); i++) {
+  for (auto i = 0; i < groups.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -101,8 +92,8 @@ void RawKvBatchDeleteTask::DoAsync() {
 
 void RawKvBatchDeleteTask::KvBatchDeleteRpcCallback(const Status& status, KvBatchDeleteRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -126,6 +117,16 @@ void RawKvBatchDeleteTask::KvBatchDeleteRpcCallback(const Status& status, KvBatc
   }
 }
 
+void RawKvBatchDeleteTask::InvalidateReadCache() {
+  auto read_cache = stub.GetRawKvReadCache();
+  if (!read_cache->Enabled()) {
+    return;
+  }
+  for (const auto& key : keys_) {
+    read_cache->Invalidate(std::string(key));
+  }
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -15,10 +15,12 @@
 #ifndef DINGODB_SDK_RAW_KV_BATCH_DELETE_TASK_H_
 #define DINGODB_SDK_RAW_KV_BATCH_DELETE_TASK_H_
 
+#include <string_view>
 #include <vector>
 
 #include "sdk/client_stub.h"
 #include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/rpc/rpc_pool.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
@@ -26,7 +28,8 @@ namespace dingodb {
 namespace sdk {
 class RawKvBatchDeleteTask : public RawKvTask {
  public:
-  RawKvBatchDeleteTask(const ClientStub& stub, const std::vector<std::string>& keys);
+  // keys are views, the buffers they refer to must be valid until the task is done, see ToKeyViews
+  RawKvBatchDeleteTask(const ClientStub& stub, std::vector<std::string_view> keys);
 
   ~RawKvBatchDeleteTask() override = default;
 
@@ -36,11 +39,13 @@ class RawKvBatchDeleteTask : public RawKvTask {
 
   std::string Name() const override { return "RawKvBatchDeleteTask"; }
 
+  void InvalidateReadCache() override;
+
   void KvBatchDeleteRpcCallback(const Status& status, KvBatchDeleteRpc* rpc);
 
-  const std::vector<std::string>& keys_;
+  const std::vector<std::string_view> keys_;
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<KvBatchDeleteRpc>> rpcs_;
+  std::vector<RpcPool<KvBatchDeleteRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   std::set<std::string_view> next_keys_;
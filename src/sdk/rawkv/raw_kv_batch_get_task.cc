@@ -17,23 +17,29 @@
 #include <mutex>
 #include <shared_mutex>
 #include <string_view>
+#include <utility>
 
 #include "glog/logging.h"
 #include "sdk/common/common.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
+#include "sdk/rawkv/raw_kv_read_cache.h"
 #include "sdk/rawkv/raw_kv_task.h"
 
 namespace dingodb {
 namespace sdk {
 
-RawKvBatchGetTask::RawKvBatchGetTask(const ClientStub& stub, const std::vector<std::string>& keys,
+RawKvBatchGetTask::RawKvBatchGetTask(const ClientStub& stub, std::vector<std::string_view> keys,
                                      std::vector<KVPair>& out_kvs)
-    : RawKvTask(stub), keys_(keys), out_kvs_(out_kvs), sub_tasks_count_(0) {}
+    : RawKvTask(stub), keys_(std::move(keys)), out_kvs_(&out_kvs), sub_tasks_count_(0) {}
+
+RawKvBatchGetTask::RawKvBatchGetTask(const ClientStub& stub, std::vector<std::string_view> keys, KvResultSet& out_kvs)
+    : RawKvTask(stub), keys_(std::move(keys)), out_set_(&out_kvs), sub_tasks_count_(0) {}
 
 Status RawKvBatchGetTask::Init() {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   next_keys_.clear();
-  for (const auto& str : keys_) {
-    CHECK(next_keys_.insert(str).second) << "duplicate key: " << str;
+  for (const auto& key : keys_) {
+    CHECK(next_keys_.insert(key).second) << "duplicate key: " << key;
   }
   return Status::OK();
 }
@@ -46,77 +52,104 @@ void RawKvBatchGetTask::DoAsync() {
     status_ = Status::OK();
   }
 
+  std::shared_ptr<RawKvReadCache> read_cache = stub.GetRawKvReadCache();
+  if (read_cache->Enabled()) {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    for (auto iter = next_batch.begin(); iter != next_batch.end();) {
+      std::string key(*iter);
+      std::string value;
+      if (read_cache->Get(key, value)) {
+        next_keys_.erase(*iter);
+        if (out_set_ != nullptr) {
+          tmp_out_set_.Append(key, value);
+        } else {
+          tmp_out_kvs_.push_back({std::move(key), std::move(value)});
+        }
+        iter = next_batch.erase(iter);
+      } else {
+        iter++;
+      }
+    }
+    read_seq_ = read_cache->WriteSeq();
+  }
+
   if (next_batch.empty()) {
     DoAsyncDone(Status::OK());
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<std::string_view>> region_keys;
-
-  auto meta_cache = stub.GetMetaCache();
-  for (const auto& key : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(key, tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    }
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_keys[tmp->RegionId()].push_back(key);
+  std::vector<RegionKeys> groups;
+  Status s = PartitionKeysByRegion(*stub.GetMetaCache(), next_batch, groups);
+  if (!s.ok()) {
+    // TODO: continue
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
+  controllers_.reserve(groups.size());
+  rpcs_.reserve(groups.size());
 
-  for (const auto& entry : region_keys) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+    auto region_id = region->RegionId();
 
-    auto rpc = std::make_unique<KvBatchGetRpc>();
+    std::shared_ptr<KvBatchGetRpc> rpc = RpcPool<KvBatchGetRpc>::Acquire();
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-    for (const auto& key : entry.second) {
+    for (const auto& key : group.keys) {
       auto* fill = rpc->MutableRequest()->add_keys();
       *fill = key;
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  CHECK_EQ(rpcs_.size(), region_keys.size());
+  CHECK_EQ(rpcs_.size(), groups.size());
   CHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_keys.size());
+  sub_tasks_count_.store(groups.size());
+  RecordFanOut(groups.size());
 
-  for (auto i = 0; i < region_keys.size(); i++) {
+  for (auto i = 0; i < groups.size(); i++) {
     auto& controller = controllers_[i];
 
-    controller.AsyncCall(
-        [this, rpc = rpcs_[i].get()](auto&& s) { BatchGetRpcCallback(std::forward<decltype(s)>(s), rpc); });
+    controller.AsyncCall([this, rpc = rpcs_[i], region = groups[i].region](auto&& s) {
+      BatchGetRpcCallback(std::forward<decltype(s)>(s), rpc, region);
+    });
   }
 }
 
-void RawKvBatchGetTask::BatchGetRpcCallback(const Status& status, KvBatchGetRpc* rpc) {
+void RawKvBatchGetTask::BatchGetRpcCallback(const Status& status, std::shared_ptr<KvBatchGetRpc> rpc,
+                                            const std::shared_ptr<Region>& region) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
       // only return first fail status
       status_ = status;
     }
+  } else if (out_set_ != nullptr) {
+    std::shared_ptr<RawKvReadCache> read_cache = stub.GetRawKvReadCache();
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    bool found = false;
+    for (const auto& kv : rpc->Response()->kvs()) {
+      next_keys_.erase(kv.key());
+      if (!kv.value().empty()) {
+        tmp_out_set_.AppendView(kv.key(), kv.value());
+        found = true;
+        if (read_cache->Enabled()) {
+          read_cache->Put(kv.key(), kv.value(), region, read_seq_);
+        }
+      }
+    }
+    if (found) {
+      tmp_out_set_.Retain(std::move(rpc));
+    }
   } else {
     std::vector<KVPair> result;
     for (const auto& kv : rpc->Response()->kvs()) {
@@ -126,6 +159,15 @@ void RawKvBatchGetTask::BatchGetRpcCallback(const Status& status, KvBatchGetRpc*
       }
     }
 
+    std::shared_ptr<RawKvReadCache> read_cache = stub.GetRawKvReadCache();
+    if (read_cache->Enabled()) {
+      for (const auto& kv : result) {
+        if (!kv.value.empty()) {
+          read_cache->Put(kv.key, kv.value, region, read_seq_);
+        }
+      }
+    }
+
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     for (auto& kv : result) {
       next_keys_.erase(kv.key);
@@ -147,7 +189,11 @@ void RawKvBatchGetTask::BatchGetRpcCallback(const Status& status, KvBatchGetRpc*
 
 void RawKvBatchGetTask::PostProcess() {
   std::shared_lock<std::shared_mutex> r(rw_lock_);
-  out_kvs_.swap(tmp_out_kvs_);
+  if (out_set_ != nullptr) {
+    *out_set_ = std::move(tmp_out_set_);
+  } else {
+    out_kvs_->swap(tmp_out_kvs_);
+  }
 }
 
 }  // namespace sdk
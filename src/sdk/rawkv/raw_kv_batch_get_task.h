@@ -18,10 +18,12 @@
 #include <atomic>
 #include <shared_mutex>
 #include <string_view>
+#include <vector>
 
 #include "sdk/client.h"
 #include "sdk/client_stub.h"
 #include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/rpc/rpc_pool.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
@@ -30,7 +32,11 @@ namespace sdk {
 
 class RawKvBatchGetTask : public RawKvTask {
  public:
-  RawKvBatchGetTask(const ClientStub& stub, const std::vector<std::string>& keys, std::vector<KVPair>& out_kvs);
+  // keys are views, the buffers they refer to must be valid until the task is done, see ToKeyViews
+  RawKvBatchGetTask(const ClientStub& stub, std::vector<std::string_view> keys, std::vector<KVPair>& out_kvs);
+
+  // found kvs are views into the batch get responses, which out_kvs keeps
+  RawKvBatchGetTask(const ClientStub& stub, std::vector<std::string_view> keys, KvResultSet& out_kvs);
 
   ~RawKvBatchGetTask() override = default;
 
@@ -41,20 +47,27 @@ class RawKvBatchGetTask : public RawKvTask {
 
   std::string Name() const override { return "RawKvBatchGetTask"; }
 
-  void BatchGetRpcCallback(const Status& status, KvBatchGetRpc* rpc);
+  void BatchGetRpcCallback(const Status& status, std::shared_ptr<KvBatchGetRpc> rpc,
+                           const std::shared_ptr<Region>& region);
 
-  const std::vector<std::string>& keys_;
-  std::vector<KVPair>& out_kvs_;
+  const std::vector<std::string_view> keys_;
+  // only one of them is set
+  std::vector<KVPair>* out_kvs_{nullptr};
+  KvResultSet* out_set_{nullptr};
 
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<KvBatchGetRpc>> rpcs_;
+  // shared with tmp_out_set_ when it keeps views into the response
+  std::vector<std::shared_ptr<KvBatchGetRpc>> rpcs_;
 
   std::shared_mutex rw_lock_;
   std::vector<KVPair> tmp_out_kvs_;
+  KvResultSet tmp_out_set_;
   std::set<std::string_view> next_keys_;
   Status status_;
 
   std::atomic<int> sub_tasks_count_;
+  // read cache write seq before rpc
+  uint64_t read_seq_{0};
 };
 
 }  // namespace sdk
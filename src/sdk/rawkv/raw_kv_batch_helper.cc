@@ -0,0 +1,30 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_batch_helper.h"
+
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+
+Status PartitionKeysByRegion(MetaCache& meta_cache, const std::set<std::string_view>& keys,
+                             std::vector<RegionKeys>& out_groups) {
+  // std::set is already sorted and unique
+  std::vector<std::string_view> sorted_keys(keys.begin(), keys.end());
+  return meta_cache.LookupRegionsByKeys(sorted_keys, out_groups);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,57 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_BATCH_HELPER_H_
+#define DINGODB_SDK_RAW_KV_BATCH_HELPER_H_
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "sdk/meta_cache.h"
+#include "sdk/region.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// key -> position in caller's input vector
+using KeyIndexMap = std::unordered_map<std::string_view, size_t>;
+
+// group keys by region, use batched lookup of meta cache
+Status PartitionKeysByRegion(MetaCache& meta_cache, const std::set<std::string_view>& keys,
+                             std::vector<RegionKeys>& out_groups);
+
+// build key index for input, return false if input has duplicate key, out_dup_key will be set
+template <class T, class KeyFn>
+inline bool BuildKeyIndex(const std::vector<T>& input, KeyFn&& key_fn, KeyIndexMap& out_index,
+                          std::string_view& out_dup_key) {
+  out_index.clear();
+  out_index.reserve(input.size());
+  for (size_t i = 0; i < input.size(); i++) {
+    std::string_view key = key_fn(input[i]);
+    if (!out_index.emplace(key, i).second) {
+      out_dup_key = key;
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RAW_KV_BATCH_HELPER_H_
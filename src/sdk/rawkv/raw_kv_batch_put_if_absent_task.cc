@@ -15,6 +15,7 @@
 #include "sdk/rawkv/raw_kv_batch_put_if_absent_task.h"
 
 #include "sdk/common/common.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
 #include "sdk/rawkv/raw_kv_task.h"
 
 namespace dingodb {
@@ -26,9 +27,14 @@ RawKvBatchPutIfAbsentTask::RawKvBatchPutIfAbsentTask(const ClientStub& stub, con
 
 Status RawKvBatchPutIfAbsentTask::Init() {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
+  std::string_view dup_key;
+  CHECK(BuildKeyIndex(
+      kvs_, [](const KVPair& kv) -> std::string_view { return kv.key; }, key_index_, dup_key))
+      << "duplicate key: " << dup_key;
+
   next_keys_.clear();
   for (const auto& kv : kvs_) {
-    CHECK(next_keys_.insert(kv.key).second) << "duplicate key: " << kv.key;
+    next_keys_.insert(kv.key);
   }
   return Status::OK();
 }
@@ -46,60 +52,47 @@ void RawKvBatchPutIfAbsentTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<std::string_view>> region_keys;
-
-  auto meta_cache = stub.GetMetaCache();
-
-  for (const auto& key : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(key, tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    }
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_keys[tmp->RegionId()].push_back(key);
+  std::vector<RegionKeys> groups;
+  Status s = PartitionKeysByRegion(*stub.GetMetaCache(), next_batch, groups);
+  if (!s.ok()) {
+    // TODO: continue
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
+  controllers_.reserve(groups.size());
+  rpcs_.reserve(groups.size());
 
-  for (const auto& entry : region_keys) {
-    auto region_id = entry.first;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+    auto region_id = region->RegionId();
 
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
-
-    auto rpc = std::make_unique<KvBatchPutIfAbsentRpc>();
+    auto rpc = RpcPool<KvBatchPutIfAbsentRpc>::Acquire();
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
     rpc->MutableRequest()->set_is_atomic(false);
-    for (const auto& key : entry.second) {
-      auto kv = std::find_if(kvs_.begin(), kvs_.end(), [&](const KVPair& kv) { return kv.key == key; });
-      CHECK(kv != kvs_.end()) << "can't find key:" << key;
+    for (const auto& key : group.keys) {
+      auto iter = key_index_.find(key);
+      CHECK(iter != key_index_.end()) << "can't find key:" << key;
+      const KVPair& kv = kvs_[iter->second];
       auto* fill = rpc->MutableRequest()->add_kvs();
-      fill->set_key(kv->key);
-      fill->set_value(kv->value);
+      fill->set_key(kv.key);
+      fill->set_value(kv.value);
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  CHECK_EQ(rpcs_.size(), region_keys.size());
+  CHECK_EQ(rpcs_.size(), groups.size());
   CHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_keys.size());
+  sub_tasks_count_.store(groups.size());
+  RecordFanOut(groups.size());
 
-  for (auto i = 0; i < region_keys.size(); i++) {
+  for (auto i = 0; i < groups.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -109,8 +102,8 @@ void RawKvBatchPutIfAbsentTask::DoAsync() {
 
 void RawKvBatchPutIfAbsentTask::KvBatchPutIfAbsentRpcCallback(const Status& status, KvBatchPutIfAbsentRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -143,6 +136,16 @@ void RawKvBatchPutIfAbsentTask::PostProcess() {
   out_states_.swap(tmp_out_states_);
 }
 
+void RawKvBatchPutIfAbsentTask::InvalidateReadCache() {
+  auto read_cache = stub.GetRawKvReadCache();
+  if (!read_cache->Enabled()) {
+    return;
+  }
+  for (const auto& kv : kvs_) {
+    read_cache->Invalidate(kv.key);
+  }
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
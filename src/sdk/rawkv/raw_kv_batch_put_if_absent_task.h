@@ -19,7 +19,9 @@
 
 #include "sdk/client.h"
 #include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
 #include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/rpc/rpc_pool.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 namespace dingodb {
@@ -39,14 +41,18 @@ class RawKvBatchPutIfAbsentTask : public RawKvTask {
 
   std::string Name() const override { return "RawKvBatchPutIfAbsentTask"; }
 
+  void InvalidateReadCache() override;
+
   void KvBatchPutIfAbsentRpcCallback(const Status& status, KvBatchPutIfAbsentRpc* rpc);
 
   const std::vector<KVPair>& kvs_;
+  // should not change after Init
+  KeyIndexMap key_index_;
   std::vector<KeyOpState>& out_states_;
   std::vector<KeyOpState> tmp_out_states_;
 
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<KvBatchPutIfAbsentRpc>> rpcs_;
+  std::vector<RpcPool<KvBatchPutIfAbsentRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   std::set<std::string_view> next_keys_;
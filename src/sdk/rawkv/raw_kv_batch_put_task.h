@@ -18,7 +18,9 @@
 #include <vector>
 
 #include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
 #include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/rpc/rpc_pool.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
@@ -29,6 +31,9 @@ class RawKvBatchPutTask : public RawKvTask {
  public:
   RawKvBatchPutTask(const ClientStub& stub, const std::vector<KVPair>& kvs);
 
+  // take kvs, values are moved into rpc requests instead of copied, and moved back when rpc fail for retry
+  RawKvBatchPutTask(const ClientStub& stub, std::vector<KVPair>&& kvs);
+
   ~RawKvBatchPutTask() override = default;
 
  private:
@@ -37,11 +42,18 @@ class RawKvBatchPutTask : public RawKvTask {
 
   std::string Name() const override { return "RawKvBatchPutTask"; }
 
+  void InvalidateReadCache() override;
+
   void KvBatchPutRpcCallback(const Status& status, KvBatchPutRpc* rpc);
 
+  // only used when task own kvs, must declare before kvs_
+  std::vector<KVPair> owned_kvs_;
+  const bool own_kvs_;
   const std::vector<KVPair>& kvs_;
+  // should not change after Init
+  KeyIndexMap key_index_;
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<KvBatchPutRpc>> rpcs_;
+  std::vector<RpcPool<KvBatchPutRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   std::set<std::string_view> next_keys_;
@@ -0,0 +1,248 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_batch_write_task.h"
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/client.h"
+#include "sdk/common/common.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+RawKvBatchWriteTask::RawKvBatchWriteTask(const ClientStub& stub, const std::vector<RawKvOp>& ops,
+                                         std::vector<KeyOpState>& out_states)
+    : RawKvTask(stub), ops_(ops), out_states_(out_states) {}
+
+Status RawKvBatchWriteTask::Init() {
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  std::string_view dup_key;
+  if (!BuildKeyIndex(
+          ops_, [](const RawKvOp& op) -> std::string_view { return op.key; }, key_index_, dup_key)) {
+    return Status::InvalidArgument(fmt::format("duplicate key: {}", dup_key));
+  }
+
+  tmp_states_.assign(ops_.size(), false);
+  next_keys_.clear();
+  for (const auto& op : ops_) {
+    next_keys_.insert(op.key);
+  }
+
+  return Status::OK();
+}
+
+void RawKvBatchWriteTask::DoAsync() {
+  std::set<std::string_view> next_batch;
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    next_batch = next_keys_;
+    status_ = Status::OK();
+  }
+
+  if (next_batch.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  std::vector<RegionKeys> groups;
+  Status s = PartitionKeysByRegion(*stub.GetMetaCache(), next_batch, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
+  }
+
+  put_controllers_.clear();
+  put_rpcs_.clear();
+  delete_controllers_.clear();
+  delete_rpcs_.clear();
+  cas_controllers_.clear();
+  cas_rpcs_.clear();
+  put_controllers_.reserve(groups.size());
+  delete_controllers_.reserve(groups.size());
+  cas_controllers_.reserve(groups.size());
+
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+    auto region_id = region->RegionId();
+
+    RpcPool<KvBatchPutRpc>::Ptr put_rpc;
+    RpcPool<KvBatchDeleteRpc>::Ptr delete_rpc;
+    RpcPool<KvBatchCompareAndSetRpc>::Ptr cas_rpc;
+    for (const auto& key : group.keys) {
+      auto iter = key_index_.find(key);
+      CHECK(iter != key_index_.end()) << "can't find key:" << key;
+      const RawKvOp& op = ops_[iter->second];
+
+      switch (op.type) {
+        case kRawKvPut: {
+          if (put_rpc == nullptr) {
+            put_rpc = RpcPool<KvBatchPutRpc>::Acquire();
+            FillRpcContext(*put_rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+          }
+          auto* fill = put_rpc->MutableRequest()->add_kvs();
+          fill->set_key(op.key);
+          fill->set_value(op.value);
+          break;
+        }
+        case kRawKvDelete: {
+          if (delete_rpc == nullptr) {
+            delete_rpc = RpcPool<KvBatchDeleteRpc>::Acquire();
+            FillRpcContext(*delete_rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+          }
+          *(delete_rpc->MutableRequest()->add_keys()) = op.key;
+          break;
+        }
+        case kRawKvPutIfAbsent:
+        case kRawKvCompareAndSet: {
+          if (cas_rpc == nullptr) {
+            cas_rpc = RpcPool<KvBatchCompareAndSetRpc>::Acquire();
+            FillRpcContext(*cas_rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+            cas_rpc->MutableRequest()->set_is_atomic(false);
+          }
+          auto* fill = cas_rpc->MutableRequest()->add_kvs();
+          fill->set_key(op.key);
+          fill->set_value(op.value);
+          // expected empty means key not exist
+          *(cas_rpc->MutableRequest()->add_expect_values()) =
+              op.type == kRawKvCompareAndSet ? op.expected_value : std::string();
+          break;
+        }
+        default:
+          CHECK(false) << "unknown raw kv op type:" << static_cast<int>(op.type) << ", key:" << op.key;
+      }
+    }
+
+    if (put_rpc != nullptr) {
+      put_controllers_.emplace_back(stub, *put_rpc, region);
+      put_controllers_.back().SetWriteRateLimit();
+      put_rpcs_.push_back(std::move(put_rpc));
+    }
+    if (delete_rpc != nullptr) {
+      delete_controllers_.emplace_back(stub, *delete_rpc, region);
+      delete_rpcs_.push_back(std::move(delete_rpc));
+    }
+    if (cas_rpc != nullptr) {
+      cas_controllers_.emplace_back(stub, *cas_rpc, region);
+      cas_rpcs_.push_back(std::move(cas_rpc));
+    }
+  }
+
+  sub_tasks_count_.store(put_rpcs_.size() + delete_rpcs_.size() + cas_rpcs_.size());
+  RecordFanOut(groups.size());
+
+  for (size_t i = 0; i < put_rpcs_.size(); i++) {
+    put_controllers_[i].AsyncCall(
+        [this, rpc = put_rpcs_[i].get()](auto&& s) { KvBatchPutRpcCallback(std::forward<decltype(s)>(s), rpc); });
+  }
+  for (size_t i = 0; i < delete_rpcs_.size(); i++) {
+    delete_controllers_[i].AsyncCall([this, rpc = delete_rpcs_[i].get()](auto&& s) {
+      KvBatchDeleteRpcCallback(std::forward<decltype(s)>(s), rpc);
+    });
+  }
+  for (size_t i = 0; i < cas_rpcs_.size(); i++) {
+    cas_controllers_[i].AsyncCall([this, rpc = cas_rpcs_[i].get()](auto&& s) {
+      KvBatchCompareAndSetRpcCallback(std::forward<decltype(s)>(s), rpc);
+    });
+  }
+}
+
+void RawKvBatchWriteTask::KvBatchPutRpcCallback(const Status& status, KvBatchPutRpc* rpc) {
+  if (status.ok()) {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    for (const auto& kv : rpc->Request()->kvs()) {
+      tmp_states_[key_index_.at(kv.key())] = true;
+      next_keys_.erase(kv.key());
+    }
+  }
+
+  SubTaskDone(status, *rpc);
+}
+
+void RawKvBatchWriteTask::KvBatchDeleteRpcCallback(const Status& status, KvBatchDeleteRpc* rpc) {
+  if (status.ok()) {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    for (const auto& key : rpc->Request()->keys()) {
+      tmp_states_[key_index_.at(key)] = true;
+      next_keys_.erase(key);
+    }
+  }
+
+  SubTaskDone(status, *rpc);
+}
+
+void RawKvBatchWriteTask::KvBatchCompareAndSetRpcCallback(const Status& status, KvBatchCompareAndSetRpc* rpc) {
+  if (status.ok()) {
+    CHECK_EQ(rpc->Request()->kvs_size(), rpc->Response()->key_states_size());
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    for (auto i = 0; i < rpc->Request()->kvs_size(); i++) {
+      const std::string& key = rpc->Request()->kvs(i).key();
+      tmp_states_[key_index_.at(key)] = rpc->Response()->key_states(i);
+      next_keys_.erase(key);
+    }
+  }
+
+  SubTaskDone(status, *rpc);
+}
+
+void RawKvBatchWriteTask::SubTaskDone(const Status& status, const Rpc& rpc) {
+  if (!status.ok()) {
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc.Method() << " fail: " << status.ToString();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  }
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+    DoAsyncDone(tmp);
+  }
+}
+
+void RawKvBatchWriteTask::PostProcess() {
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  std::vector<KeyOpState> states;
+  states.reserve(ops_.size());
+  for (size_t i = 0; i < ops_.size(); i++) {
+    states.push_back({ops_[i].key, tmp_states_[i]});
+  }
+  out_states_.swap(states);
+}
+
+void RawKvBatchWriteTask::InvalidateReadCache() {
+  auto read_cache = stub.GetRawKvReadCache();
+  if (!read_cache->Enabled()) {
+    return;
+  }
+  for (const auto& op : ops_) {
+    read_cache->Invalidate(op.key);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
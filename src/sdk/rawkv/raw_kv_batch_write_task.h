@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_BATCH_WRITE_TASK_H_
+#define DINGODB_SDK_RAW_KV_BATCH_WRITE_TASK_H_
+
+#include <set>
+#include <string_view>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
+#include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/rpc/rpc_pool.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Mixed raw kv writes in one round: ops of each region are sent together as one KvBatchPut, one KvBatchDelete and
+// one KvBatchCompareAndSet carrying put-if-absent (expected value empty) and compare-and-set ops.
+class RawKvBatchWriteTask : public RawKvTask {
+ public:
+  RawKvBatchWriteTask(const ClientStub& stub, const std::vector<RawKvOp>& ops, std::vector<KeyOpState>& out_states);
+
+  ~RawKvBatchWriteTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+  void PostProcess() override;
+
+  std::string Name() const override { return "RawKvBatchWriteTask"; }
+
+  void InvalidateReadCache() override;
+
+  void KvBatchPutRpcCallback(const Status& status, KvBatchPutRpc* rpc);
+  void KvBatchDeleteRpcCallback(const Status& status, KvBatchDeleteRpc* rpc);
+  void KvBatchCompareAndSetRpcCallback(const Status& status, KvBatchCompareAndSetRpc* rpc);
+  // keep first fail status, the last rpc of the round calls DoAsyncDone
+  void SubTaskDone(const Status& status, const Rpc& rpc);
+
+  const std::vector<RawKvOp>& ops_;
+  std::vector<KeyOpState>& out_states_;
+  // state of each op, index into ops_
+  std::vector<bool> tmp_states_;
+
+  // should not change after Init, index into ops_
+  KeyIndexMap key_index_;
+
+  std::vector<StoreRpcController> put_controllers_;
+  std::vector<RpcPool<KvBatchPutRpc>::Ptr> put_rpcs_;
+  std::vector<StoreRpcController> delete_controllers_;
+  std::vector<RpcPool<KvBatchDeleteRpc>::Ptr> delete_rpcs_;
+  std::vector<StoreRpcController> cas_controllers_;
+  std::vector<RpcPool<KvBatchCompareAndSetRpc>::Ptr> cas_rpcs_;
+
+  std::shared_mutex rw_lock_;
+  std::set<std::string_view> next_keys_;
+  Status status_;
+
+  std::atomic<int> sub_tasks_count_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RAW_KV_BATCH_WRITE_TASK_H_
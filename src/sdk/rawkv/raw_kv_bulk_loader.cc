@@ -0,0 +1,190 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/client.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+#include "sdk/rawkv/raw_kv_batch_put_task.h"
+#include "sdk/rawkv/raw_kv_bulk_loader_internal_data.h"
+#include "sdk/region.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t EstimateKvBytes(const KVPair& kv) { return kv.key.size() + kv.value.size(); }
+}  // namespace
+
+void RawKvBulkLoader::Data::SortAndDedup(std::vector<KVPair>& kvs) {
+  std::stable_sort(kvs.begin(), kvs.end(), [](const KVPair& a, const KVPair& b) { return a.key < b.key; });
+
+  // keep the last kv of equal keys, batch put task does not accept duplicate keys
+  size_t out = 0;
+  for (size_t i = 0; i < kvs.size(); i++) {
+    if (i + 1 < kvs.size() && kvs[i + 1].key == kvs[i].key) {
+      continue;
+    }
+    if (out != i) {
+      kvs[out] = std::move(kvs[i]);
+    }
+    out++;
+  }
+  kvs.resize(out);
+}
+
+Status RawKvBulkLoader::Data::SortAndSend() {
+  if (buffer.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<KVPair> kvs;
+  kvs.swap(buffer);
+  buffer_bytes = 0;
+  SortAndDedup(kvs);
+
+  // sorted kvs of a region are contiguous, so each chunk is one rpc unless the region splits meanwhile
+  size_t begin = 0;
+  while (begin < kvs.size()) {
+    std::shared_ptr<Region> region;
+    Status s = stub.GetMetaCache()->LookupRegionByKey(kvs[begin].key, region);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "raw kv bulk loader lookup region of key:" << kvs[begin].key << " fail: " << s.ToString();
+      std::lock_guard<std::mutex> guard(mutex);
+      if (status.ok()) {
+        status = s;
+      }
+      return s;
+    }
+
+    const std::string& end_key = region->Range().end_key();
+    size_t end = begin;
+    int64_t bytes = 0;
+    while (end < kvs.size() && (end_key.empty() || kvs[end].key < end_key) &&
+           bytes < FLAGS_raw_kv_bulk_load_chunk_bytes) {
+      bytes += EstimateKvBytes(kvs[end]);
+      end++;
+    }
+    CHECK_GT(end, begin) << "region:" << region->RegionId() << " not contain key:" << kvs[begin].key;
+
+    std::vector<KVPair> chunk_kvs(std::make_move_iterator(kvs.begin() + begin),
+                                  std::make_move_iterator(kvs.begin() + end));
+    SendChunk(std::move(chunk_kvs), bytes);
+    begin = end;
+  }
+
+  return Status::OK();
+}
+
+void RawKvBulkLoader::Data::SendChunk(std::vector<KVPair> kvs, int64_t bytes) {
+  auto* chunk = new Chunk();
+  chunk->bytes = bytes;
+  chunk->count = kvs.size();
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // a chunk bigger than the limit still goes when nothing is in flight
+    cond.wait(lock, [&] {
+      return inflight_chunks == 0 || inflight_bytes + chunk->bytes <= FLAGS_raw_kv_bulk_load_max_inflight_bytes;
+    });
+    inflight_bytes += chunk->bytes;
+    inflight_chunks++;
+  }
+
+  // task regroups keys by the new regions and retries when the region split or merged
+  chunk->task = std::make_unique<RawKvBatchPutTask>(stub, std::move(kvs));
+  chunk->task->AsyncRun([this, chunk](Status status) { ChunkDone(chunk, status); });
+}
+
+void RawKvBulkLoader::Data::ChunkDone(Chunk* chunk, const Status& status) {
+  int64_t bytes = chunk->bytes;
+  int64_t count = chunk->count;
+  // task is in its callback, nothing of it is touched after callback return
+  delete chunk;
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "raw kv bulk loader write chunk of " << count << " kvs fail: " << status.ToString();
+  }
+
+  std::lock_guard<std::mutex> guard(mutex);
+  if (!status.ok() && this->status.ok()) {
+    // only return first fail status
+    this->status = status;
+  }
+  inflight_bytes -= bytes;
+  inflight_chunks--;
+  // notify under lock, loader may destroy data as soon as no chunk in flight
+  cond.notify_all();
+}
+
+Status RawKvBulkLoader::Data::WaitInflightChunks() {
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [&] { return inflight_chunks == 0; });
+  Status tmp = status;
+  status = Status::OK();
+  return tmp;
+}
+
+RawKvBulkLoader::RawKvBulkLoader(Data* data) : data_(data) {}
+
+RawKvBulkLoader::~RawKvBulkLoader() {
+  Status s = Finish();
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "raw kv bulk loader finish fail: " << s.ToString();
+  }
+  delete data_;
+}
+
+Status RawKvBulkLoader::Add(std::vector<KVPair> kvs) {
+  {
+    std::lock_guard<std::mutex> guard(data_->mutex);
+    DINGO_RETURN_NOT_OK(data_->status);
+  }
+
+  for (auto& kv : kvs) {
+    if (kv.key.empty()) {
+      return Status::InvalidArgument("key must not empty");
+    }
+  }
+
+  for (auto& kv : kvs) {
+    data_->buffer_bytes += EstimateKvBytes(kv);
+    data_->buffer.push_back(std::move(kv));
+  }
+  if (data_->buffer_bytes >= FLAGS_raw_kv_bulk_load_sort_bytes) {
+    return data_->SortAndSend();
+  }
+
+  return Status::OK();
+}
+
+Status RawKvBulkLoader::Finish() {
+  Status s = data_->SortAndSend();
+  // always wait, chunks sent before the error are still in flight
+  Status tmp = data_->WaitInflightChunks();
+  return s.ok() ? tmp : s;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
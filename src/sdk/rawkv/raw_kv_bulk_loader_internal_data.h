@@ -0,0 +1,79 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_BULK_LOADER_DATA_H_
+#define DINGODB_SDK_RAW_KV_BULK_LOADER_DATA_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_batch_put_task.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class RawKvBulkLoader::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  explicit Data(const ClientStub& stub) : stub(stub) {}
+
+  ~Data() = default;
+
+  // kvs of one region being written, owned by its batch put task callback
+  struct Chunk {
+    int64_t bytes{0};
+    int64_t count{0};
+    std::unique_ptr<RawKvBatchPutTask> task;
+  };
+
+  // stable sort by key and drop all but the last added kv of a key
+  static void SortAndDedup(std::vector<KVPair>& kvs);
+
+  // sort buffer, cut it into chunks by region and write them, block while too many bytes are in flight
+  Status SortAndSend();
+
+  void SendChunk(std::vector<KVPair> kvs, int64_t bytes);
+
+  void ChunkDone(Chunk* chunk, const Status& status);
+
+  // wait all in flight chunks, return and reset the first error
+  Status WaitInflightChunks();
+
+  const ClientStub& stub;
+
+  // only used by loader thread
+  std::vector<KVPair> buffer;
+  int64_t buffer_bytes{0};
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  // protected by mutex
+  int64_t inflight_bytes{0};
+  int64_t inflight_chunks{0};
+  // first error of chunks since last Finish
+  Status status;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RAW_KV_BULK_LOADER_DATA_H_
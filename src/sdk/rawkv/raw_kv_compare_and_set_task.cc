@@ -58,6 +58,8 @@ void RawKvCompareAndSetTask::KvCompareAndSetRpcCallback(const Status& status) {
   DoAsyncDone(status);
 }
 
+void RawKvCompareAndSetTask::InvalidateReadCache() { stub.GetRawKvReadCache()->Invalidate(key_); }
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -35,6 +35,8 @@ class RawKvCompareAndSetTask : public RawKvTask {
   void KvCompareAndSetRpcCallback(const Status& status);
 
   std::string Name() const override { return "RawKvCompareAndSetTask"; }
+
+  void InvalidateReadCache() override;
   std::string ErrorMsg() const override { return fmt::format("key: {}, value:{}", key_, value_); }
 
   const std::string& key_;
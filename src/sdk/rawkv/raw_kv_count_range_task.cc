@@ -0,0 +1,205 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_count_range_task.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "sdk/common/param_config.h"
+#include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/region_scanner.h"
+
+namespace dingodb {
+namespace sdk {
+
+RawKvCountRangeTask::RawKvCountRangeTask(const ClientStub& stub, const std::string& start_key,
+                                         const std::string& end_key, int64_t& out_count)
+    : RawKvTask(stub), start_key_(start_key), end_key_(end_key), out_count_(out_count) {}
+
+Status RawKvCountRangeTask::Init() {
+  // precheck: return not found if no region in [start, end_key)
+  std::shared_ptr<Region> region;
+  Status ret = stub.GetMetaCache()->LookupRegionBetweenRange(start_key_, end_key_, region);
+  if (!ret.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("lookup region fail between [{},{}), status:{}", start_key_, end_key_,
+                                      ret.ToString());
+  }
+  return ret;
+}
+
+void RawKvCountRangeTask::DoAsync() {
+  // reset state, DoAsync maybe called again when retry
+  parts_.clear();
+  count_.store(0);
+  next_part_ = 0;
+  inflight_parts_ = 0;
+  status_ = Status::OK();
+
+  Status s = CollectParts();
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
+  }
+
+  if (parts_.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  RecordFanOut(parts_.size());
+
+  std::vector<size_t> to_start;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    size_t parallelism = std::max<int64_t>(FLAGS_raw_kv_count_parallelism, 1);
+    size_t concurrency = std::min(parts_.size(), parallelism);
+    for (size_t i = 0; i < concurrency; i++) {
+      to_start.push_back(next_part_++);
+      inflight_parts_++;
+    }
+  }
+
+  // start outside lock, scanner callback maybe run in current thread
+  for (size_t index : to_start) {
+    StartPart(index);
+  }
+}
+
+Status RawKvCountRangeTask::CollectParts() {
+  auto meta_cache = stub.GetMetaCache();
+
+  std::string next_start_key = start_key_;
+  while (next_start_key < end_key_) {
+    std::shared_ptr<Region> region;
+    Status s = meta_cache->LookupRegionBetweenRange(next_start_key, end_key_, region);
+    if (s.IsNotFound()) {
+      break;
+    }
+
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start_key,
+                                        end_key_, start_key_, s.ToString());
+      return s;
+    }
+
+    CountPart part;
+    part.start_key = std::max(next_start_key, region->Range().start_key());
+    part.end_key = std::min(end_key_, region->Range().end_key());
+    part.region = std::move(region);
+    next_start_key = part.region->Range().end_key();
+    parts_.push_back(std::move(part));
+  }
+
+  return Status::OK();
+}
+
+void RawKvCountRangeTask::StartPart(size_t index) {
+  auto& part = parts_[index];
+  ScannerOptions options(stub, part.region, part.start_key, part.end_key);
+  options.prefetch = FLAGS_scan_prefetch;
+  options.key_only = true;
+
+  std::shared_ptr<RegionScanner> scanner;
+  CHECK(stub.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner).IsOK());
+
+  scanner->AsyncOpen(
+      [this, index, scanner](auto&& s) { PartOpenCallback(std::forward<decltype(s)>(s), index, scanner); });
+}
+
+void RawKvCountRangeTask::PartOpenCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner open fail, region:{}, status:{}",
+                                      parts_[index].region->RegionId(), status.ToString());
+    PartDone(status);
+    return;
+  }
+
+  PartNext(index, std::move(scanner));
+}
+
+void RawKvCountRangeTask::PartNext(size_t index, std::shared_ptr<RegionScanner> scanner) {
+  if (!scanner->HasMore()) {
+    PartDone(Status::OK());
+    return;
+  }
+
+  auto& part = parts_[index];
+  part.batch_kvs.clear();
+  scanner->AsyncNextBatch(part.batch_kvs, [this, index, scanner](auto&& s) {
+    PartNextBatchCallback(std::forward<decltype(s)>(s), index, scanner);
+  });
+}
+
+void RawKvCountRangeTask::PartNextBatchCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner) {
+  auto& part = parts_[index];
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner NextBatch fail, region:{}, status:{}", part.region->RegionId(),
+                                      status.ToString());
+    PartDone(status);
+    return;
+  }
+
+  count_.fetch_add(part.batch_kvs.size());
+  part.batch_kvs.clear();
+
+  bool other_fail = false;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    other_fail = !status_.ok();
+  }
+
+  if (other_fail) {
+    // the count is useless, stop this part
+    PartDone(Status::OK());
+    return;
+  }
+
+  PartNext(index, std::move(scanner));
+}
+
+void RawKvCountRangeTask::PartDone(Status status) {
+  int64_t next = -1;
+  bool all_done = false;
+  Status done_status;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    inflight_parts_--;
+    if (!status.ok() && status_.ok()) {
+      status_ = status;
+    }
+
+    if (status_.ok() && next_part_ < parts_.size()) {
+      next = next_part_++;
+      inflight_parts_++;
+    }
+
+    all_done = (inflight_parts_ == 0);
+    done_status = status_;
+  }
+
+  if (next >= 0) {
+    StartPart(next);
+  } else if (all_done) {
+    DoAsyncDone(done_status);
+  }
+}
+
+void RawKvCountRangeTask::PostProcess() { out_count_ = count_.load(); }
+
+}  // namespace sdk
+
+}  // namespace dingodb
@@ -0,0 +1,82 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_COUNT_RANGE_TASK_H_
+#define DINGODB_SDK_RAW_KV_COUNT_RANGE_TASK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/region.h"
+#include "sdk/region_scanner.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// count keys in [start_key, end_key), regions are scanned key only by at most FLAGS_raw_kv_count_parallelism
+// scanners concurrently, every batch is counted and dropped at once, so no kv is kept on client
+class RawKvCountRangeTask : public RawKvTask {
+ public:
+  RawKvCountRangeTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key,
+                      int64_t& out_count);
+
+  ~RawKvCountRangeTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+  void PostProcess() override;
+
+  Status CollectParts();
+  void StartPart(size_t index);
+  void PartOpenCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner);
+  void PartNext(size_t index, std::shared_ptr<RegionScanner> scanner);
+  void PartNextBatchCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner);
+  void PartDone(Status status);
+
+  std::string Name() const override { return "RawKvCountRangeTask"; }
+  std::string ErrorMsg() const override { return fmt::format("start_key: {}, end_key:{}", start_key_, end_key_); }
+
+  const std::string& start_key_;
+  const std::string& end_key_;
+  int64_t& out_count_;
+
+  struct CountPart {
+    std::shared_ptr<Region> region;
+    std::string start_key;
+    std::string end_key;
+    std::vector<KVPair> batch_kvs;
+  };
+
+  // NOTE: parts_ size is fixed before any part start, each part is only touched by its own scanner callback
+  std::vector<CountPart> parts_;
+  std::atomic<int64_t> count_{0};
+
+  std::mutex mutex_;
+  size_t next_part_{0};
+  size_t inflight_parts_{0};
+  // first failure, stop to start new part
+  Status status_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RAW_KV_COUNT_RANGE_TASK_H_
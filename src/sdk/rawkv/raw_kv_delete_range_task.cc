@@ -14,22 +14,27 @@
 
 #include "sdk/rawkv/raw_kv_delete_range_task.h"
 
+#include <algorithm>
+
 #include "common/logging.h"
 #include "fmt/core.h"
 #include "glog/logging.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rawkv/raw_kv_task.h"
 
 namespace dingodb {
 namespace sdk {
 
 RawKvDeleteRangeTask::RawKvDeleteRangeTask(const ClientStub& stub, const std::string& start_key,
-                                           const std::string& end_key, bool continuous, int64_t& out_delete_count)
+                                           const std::string& end_key, bool continuous, int64_t& out_delete_count,
+                                           DeleteRangeProgressCallback progress)
     : RawKvTask(stub),
       start_key_(start_key),
       end_key_(end_key),
       continuous_(continuous),
       out_delete_count_(out_delete_count),
+      progress_(std::move(progress)),
       tmp_out_delete_count_(0) {}
 
 Status RawKvDeleteRangeTask::Init() {
@@ -68,39 +73,84 @@ Status RawKvDeleteRangeTask::Init() {
     }
   }
 
-  next_start_key_ = start_key_;
+  parts_.clear();
+  for (const auto& region : regions) {
+    DeletePart part;
+    part.next_start_key = std::max(start_key_, region->Range().start_key());
+    part.end_key = std::min(end_key_, region->Range().end_key());
+    if (part.next_start_key < part.end_key) {
+      parts_.push_back(std::move(part));
+    }
+  }
+
+  RecordFanOut(parts_.size());
   return Status::OK();
 }
 
-void RawKvDeleteRangeTask::DoAsync() { DeleteNextRange(); }
+void RawKvDeleteRangeTask::DoAsync() {
+  std::vector<size_t> to_start;
+  {
+    // DoAsync is called again when retry, parts done by last run are skipped
+    std::unique_lock<std::mutex> lk(mutex_);
+    status_ = Status::OK();
+    pending_.clear();
+    next_pending_ = 0;
+    inflight_parts_ = 0;
+    for (size_t i = 0; i < parts_.size(); i++) {
+      if (!parts_[i].done) {
+        pending_.push_back(i);
+      }
+    }
 
-void RawKvDeleteRangeTask::DeleteNextRange() {
-  CHECK(!next_start_key_.empty()) << "next_start_key_ should not empty";
-  CHECK(next_start_key_ <= end_key_) << fmt::format(
-      "next_start_key_:{} should less than or equal to end_key_:", next_start_key_, end_key_);
+    size_t parallelism = std::max<int64_t>(FLAGS_raw_kv_delete_range_parallelism, 1);
+    size_t concurrency = std::min(pending_.size(), parallelism);
+    for (size_t i = 0; i < concurrency; i++) {
+      to_start.push_back(pending_[next_pending_++]);
+      inflight_parts_++;
+    }
+  }
+
+  if (to_start.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  // start outside lock, rpc callback maybe run in current thread
+  for (size_t index : to_start) {
+    DeletePartNextRange(index);
+  }
+}
+
+void RawKvDeleteRangeTask::DeletePartNextRange(size_t index) {
+  auto& part = parts_[index];
+  if (part.next_start_key >= part.end_key) {
+    PartDone(index, Status::OK());
+    return;
+  }
 
   auto meta_cache = stub.GetMetaCache();
 
   std::shared_ptr<Region> region;
-  status_ = meta_cache->LookupRegionBetweenRange(next_start_key_, end_key_, region);
-  if (status_.IsNotFound()) {
-    DINGO_LOG(INFO) << fmt::format("region not found  between [{},{}), start_key:{} status:{}", next_start_key_,
-                                   end_key_, start_key_, status_.ToString());
-    DoAsyncDone(Status::OK());
+  Status s = meta_cache->LookupRegionBetweenRange(part.next_start_key, part.end_key, region);
+  if (s.IsNotFound()) {
+    DINGO_LOG(INFO) << fmt::format("region not found  between [{},{}), start_key:{} status:{}", part.next_start_key,
+                                   part.end_key, start_key_, s.ToString());
+    part.next_start_key = part.end_key;
+    PartDone(index, Status::OK());
     return;
   }
 
-  if (!status_.ok()) {
-    DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start_key_,
-                                      end_key_, start_key_, status_.ToString());
-    DoAsyncDone(status_);
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", part.next_start_key,
+                                      part.end_key, start_key_, s.ToString());
+    PartDone(index, s);
     return;
   }
 
   CHECK_NOTNULL(region.get());
   const auto& range = region->Range();
-  auto start = (range.start_key() <= next_start_key_ ? next_start_key_ : range.start_key());
-  auto end = (range.end_key() <= end_key_) ? range.end_key() : end_key_;
+  auto start = (range.start_key() <= part.next_start_key ? part.next_start_key : range.start_key());
+  auto end = (range.end_key() <= part.end_key) ? range.end_key() : part.end_key;
 
   //  fill rpc
   auto rpc = std::make_unique<KvDeleteRangeRpc>();
@@ -114,40 +164,86 @@ void RawKvDeleteRangeTask::DeleteNextRange() {
 
   auto controller = std::make_unique<StoreRpcController>(stub, *rpc.get(), region);
 
-  controller->AsyncCall([this, r = rpc.release(), c = controller.release()](auto&& s) {
-    KvDeleteRangeRpcCallback(std::forward<decltype(s)>(s), r, c);
+  controller->AsyncCall([this, index, r = rpc.release(), c = controller.release()](auto&& s) {
+    KvDeleteRangeRpcCallback(std::forward<decltype(s)>(s), index, r, c);
   });
 }
 
-void RawKvDeleteRangeTask::KvDeleteRangeRpcCallback(Status status, KvDeleteRangeRpc* rpc,
+void RawKvDeleteRangeTask::KvDeleteRangeRpcCallback(Status status, size_t index, KvDeleteRangeRpc* rpc,
                                                     StoreRpcController* controller) {
-  status_ = status;
+  std::unique_ptr<KvDeleteRangeRpc> rpc_guard(rpc);
+  std::unique_ptr<StoreRpcController> controller_guard(controller);
 
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString() << ", rpc req:" << rpc->Request()->DebugString()
-                       << " rpc resp:" << rpc->Response()->DebugString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString()
+                                    << ", rpc req:" << rpc->Request()->DebugString() << " rpc resp:"
+                                    << rpc->Response()->DebugString();
+    PartDone(index, status);
+    return;
+  }
+
+  const auto& end_key = rpc->Request()->range().range().end_key();
+  CHECK(!end_key.empty()) << "illegal request:" << rpc->Request()->DebugString()
+                          << ", resp:" << rpc->Response()->DebugString();
+
+  tmp_out_delete_count_.fetch_add(rpc->Response()->delete_count());
+  parts_[index].next_start_key = end_key;
+
+  bool stop = false;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    stop = !status_.ok();
+  }
+
+  if (stop) {
+    // other part fail, this part continues from next_start_key when retry
+    PartDone(index, Status::OK());
   } else {
-    const auto& end_key = rpc->Request()->range().range().end_key();
-    CHECK(!end_key.empty()) << "illegal request:" << rpc->Request()->DebugString()
-                            << ", resp:" << rpc->Response()->DebugString();
+    stub.GetActuator()->Execute([this, index] { DeletePartNextRange(index); });
+  }
+}
 
-    tmp_out_delete_count_.fetch_add(rpc->Response()->delete_count());
-    next_start_key_ = end_key;
+void RawKvDeleteRangeTask::PartDone(size_t index, Status status) {
+  int64_t next = -1;
+  bool all_done = false;
+  Status done_status;
+  int64_t done_parts = -1;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    inflight_parts_--;
+    if (status.ok() && parts_[index].next_start_key >= parts_[index].end_key) {
+      parts_[index].done = true;
+      done_parts_++;
+      done_parts = done_parts_;
+    }
+    if (!status.ok() && status_.ok()) {
+      status_ = status;
+    }
+
+    if (status_.ok() && next_pending_ < pending_.size()) {
+      next = pending_[next_pending_++];
+      inflight_parts_++;
+    }
+
+    all_done = (inflight_parts_ == 0);
+    done_status = status_;
   }
 
-  delete controller;
-  delete rpc;
+  if (done_parts >= 0 && progress_) {
+    progress_(tmp_out_delete_count_.load(), done_parts, parts_.size());
+  }
 
-  if (next_start_key_ >= end_key_) {
-    DoAsyncDone(Status::OK());
-    return;
-  } else {
-    stub.GetActuator()->Execute([this] { DeleteNextRange(); });
+  if (next >= 0) {
+    DeletePartNextRange(next);
+  } else if (all_done) {
+    DoAsyncDone(done_status);
   }
 }
 
 void RawKvDeleteRangeTask::PostProcess() { out_delete_count_ = tmp_out_delete_count_.load(); }
 
+void RawKvDeleteRangeTask::InvalidateReadCache() { stub.GetRawKvReadCache()->InvalidateRange(start_key_, end_key_); }
+
 }  // namespace sdk
 }  // namespace dingodb
@@ -17,19 +17,29 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
+#include "sdk/client.h"
 #include "sdk/client_stub.h"
 #include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/region.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
 namespace dingodb {
 namespace sdk {
 
+// regions in range are cut into parts by the region list from coordinator, at most
+// FLAGS_raw_kv_delete_range_parallelism parts are deleted concurrently, a part walks its range region by region so
+// a region split after Init is still covered. A part keeps its progress when the task retries.
 class RawKvDeleteRangeTask : public RawKvTask {
  public:
+  // progress: called when a part is done, maybe in sdk internal thread, should not block
   RawKvDeleteRangeTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key,
-                       bool continuous, int64_t& out_delete_count);
+                       bool continuous, int64_t& out_delete_count, DeleteRangeProgressCallback progress = nullptr);
 
   ~RawKvDeleteRangeTask() override = default;
 
@@ -37,22 +47,44 @@ class RawKvDeleteRangeTask : public RawKvTask {
   Status Init() override;
   void DoAsync() override;
   void PostProcess() override;
-  void DeleteNextRange();
-  void KvDeleteRangeRpcCallback(Status status, KvDeleteRangeRpc* rpc, StoreRpcController* controller);
+
+  void DeletePartNextRange(size_t index);
+  void KvDeleteRangeRpcCallback(Status status, size_t index, KvDeleteRangeRpc* rpc, StoreRpcController* controller);
+  // start next pending part, report progress, finish task when no part in flight
+  void PartDone(size_t index, Status status);
 
   std::string Name() const override { return "RawKvDeleteRangeTask"; }
+
+  void InvalidateReadCache() override;
   std::string ErrorMsg() const override { return fmt::format("start_key: {}, end_key:{}", start_key_, end_key_); }
 
   const std::string& start_key_;
   const std::string& end_key_;
   const bool continuous_;
   int64_t& out_delete_count_;
+  DeleteRangeProgressCallback progress_;
 
-  Status status_;
+  struct DeletePart {
+    std::string next_start_key;
+    std::string end_key;
+    bool done{false};
+  };
+
+  // NOTE: parts_ is fixed in Init, next_start_key of a part is only touched by its own rpc callback, done is
+  // guarded by mutex_
+  std::vector<DeletePart> parts_;
   std::atomic<int64_t> tmp_out_delete_count_;
-  std::string next_start_key_;
+
+  std::mutex mutex_;
+  // parts not done, in order, started by next_pending_
+  std::vector<size_t> pending_;
+  size_t next_pending_{0};
+  size_t inflight_parts_{0};
+  int64_t done_parts_{0};
+  // first failure of current run, stop to start new part
+  Status status_;
 };
 
 }  // namespace sdk
 }  // namespace dingodb
-#endif  // DINGODB_SDK_RAW_KV_DELETE_RANGE_TASK_H_
\ No newline at end of file
+#endif  // DINGODB_SDK_RAW_KV_DELETE_RANGE_TASK_H_
@@ -43,13 +43,15 @@ void RawKvDeleteTask::DoAsync() {
 
 void RawKvDeleteTask::KvDeleteRpcCallback(const Status& status) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc_.Method() << " send to region: " << rpc_.Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc_.Method() << " send to region: "
+                                    << rpc_.Request()->context().region_id() << " fail: " << status.ToString();
   }
 
   DoAsyncDone(status);
 }
 
+void RawKvDeleteTask::InvalidateReadCache() { stub.GetRawKvReadCache()->Invalidate(key_); }
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -37,6 +37,8 @@ class RawKvDeleteTask : public RawKvTask {
   void KvDeleteRpcCallback(const Status& status);
 
   std::string Name() const override { return "RawKvDeleteTask"; }
+
+  void InvalidateReadCache() override;
   std::string ErrorMsg() const override { return fmt::format("key: {}", key_); }
 
   const std::string& key_;
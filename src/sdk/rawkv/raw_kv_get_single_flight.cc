@@ -0,0 +1,57 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_get_single_flight.h"
+
+#include <utility>
+
+namespace dingodb {
+namespace sdk {
+
+bool RawKvGetSingleFlight::Join(const std::string& key, GetCallback cb) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto iter = flights_.find(key);
+  if (iter == flights_.end()) {
+    flights_.emplace(key, std::make_unique<Flight>());
+    return true;
+  }
+
+  iter->second->followers.push_back(std::move(cb));
+  return false;
+}
+
+void RawKvGetSingleFlight::Done(const std::string& key, const Status& status, const std::string& value) {
+  std::unique_ptr<Flight> flight;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto iter = flights_.find(key);
+    if (iter == flights_.end()) {
+      return;
+    }
+    flight = std::move(iter->second);
+    flights_.erase(iter);
+  }
+
+  for (auto& cb : flight->followers) {
+    cb(status, value);
+  }
+}
+
+int64_t RawKvGetSingleFlight::InflightCount() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return flights_.size();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,63 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_GET_SINGLE_FLIGHT_H_
+#define DINGODB_SDK_RAW_KV_GET_SINGLE_FLIGHT_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Coalesce concurrent raw kv gets of the same key, only the first caller (the
+// leader) sends KvGetRpc, others wait for the leader result.
+// NOTE: a follower may observe a value read before its own call started, so
+// this is only for callers that accept the result of any concurrent get.
+class RawKvGetSingleFlight {
+ public:
+  using GetCallback = std::function<void(const Status& status, const std::string& value)>;
+
+  RawKvGetSingleFlight() = default;
+
+  ~RawKvGetSingleFlight() = default;
+
+  // return true if the caller becomes the leader, then it must send the rpc and call Done.
+  // return false if a get for the key is in flight, `cb` will be called when it is done.
+  bool Join(const std::string& key, GetCallback cb);
+
+  // called by the leader, fire all followers waiting for the key
+  void Done(const std::string& key, const Status& status, const std::string& value);
+
+  int64_t InflightCount();
+
+ private:
+  struct Flight {
+    std::vector<GetCallback> followers;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<Flight>> flights_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RAW_KV_GET_SINGLE_FLIGHT_H_
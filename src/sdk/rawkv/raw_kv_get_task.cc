@@ -15,20 +15,45 @@
 #include "sdk/rawkv/raw_kv_get_task.h"
 
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rawkv/raw_kv_read_cache.h"
 #include "sdk/rawkv/raw_kv_task.h"
 #include "sdk/status.h"
 
 namespace dingodb {
 namespace sdk {
 
-RawKvGetTask::RawKvGetTask(const ClientStub& stub, const std::string& key, std::string& out_value)
-    : RawKvTask(stub), key_(key), out_value_(out_value), store_rpc_controller_(stub, rpc_) {}
+RawKvGetTask::RawKvGetTask(const ClientStub& stub, const std::string& key, std::string& out_value,
+                           const ReadOptions& options)
+    : RawKvTask(stub), key_(key), out_value_(out_value), options_(options), store_rpc_controller_(stub, rpc_) {
+  store_rpc_controller_.SetReplicaReadPolicy(options_.replica_read);
+}
 
 void RawKvGetTask::DoAsync() {
+  std::shared_ptr<RawKvReadCache> read_cache = stub.GetRawKvReadCache();
+  if (read_cache->Get(key_, result_)) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+  read_seq_ = read_cache->WriteSeq();
+
+  if (FLAGS_raw_kv_get_single_flight) {
+    flight_leader_ = stub.GetRawKvGetSingleFlight()->Join(
+        key_, [this](const Status& status, const std::string& value) { SingleFlightCallback(status, value); });
+    if (!flight_leader_) {
+      return;
+    }
+  }
+
   std::shared_ptr<MetaCache> meta_cache = stub.GetMetaCache();
   std::shared_ptr<Region> region;
   Status s = meta_cache->LookupRegionByKey(key_, region);
+  region_ = region;
   if (!s.ok()) {
+    if (flight_leader_) {
+      flight_leader_ = false;
+      stub.GetRawKvGetSingleFlight()->Done(key_, s, "");
+    }
     DoAsyncDone(s);
     return;
   }
@@ -44,6 +69,22 @@ void RawKvGetTask::DoAsync() {
 void RawKvGetTask::KvGetRpcCallback(Status status) {
   if (status.ok()) {
     result_ = rpc_.Response()->value();
+    if (!result_.empty()) {
+      stub.GetRawKvReadCache()->Put(key_, result_, region_, read_seq_);
+    }
+  }
+
+  if (flight_leader_) {
+    flight_leader_ = false;
+    stub.GetRawKvGetSingleFlight()->Done(key_, status, result_);
+  }
+
+  DoAsyncDone(status);
+}
+
+void RawKvGetTask::SingleFlightCallback(const Status& status, const std::string& value) {
+  if (status.ok()) {
+    result_ = value;
   }
 
   DoAsyncDone(status);
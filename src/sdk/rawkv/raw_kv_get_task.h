@@ -27,7 +27,8 @@ namespace sdk {
 
 class RawKvGetTask : public RawKvTask {
  public:
-  RawKvGetTask(const ClientStub& stub, const std::string& key, std::string& out_value);
+  RawKvGetTask(const ClientStub& stub, const std::string& key, std::string& out_value,
+               const ReadOptions& options = ReadOptions());
 
   ~RawKvGetTask() override = default;
 
@@ -36,6 +37,8 @@ class RawKvGetTask : public RawKvTask {
 
   void KvGetRpcCallback(Status status);
 
+  void SingleFlightCallback(const Status& status, const std::string& value);
+
   void PostProcess() override;
 
   std::string Name() const override { return "RawKvGetTask"; }
@@ -43,8 +46,14 @@ class RawKvGetTask : public RawKvTask {
 
   const std::string& key_;
   std::string& out_value_;
+  const ReadOptions options_;
 
   std::string result_;
+  // region the rpc is sent to and read cache write seq before rpc, used to fill read cache
+  std::shared_ptr<Region> region_;
+  uint64_t read_seq_{0};
+  // leader of the single flight for key_, must call Done when rpc finish
+  bool flight_leader_{false};
   KvGetRpc rpc_;
   StoreRpcController store_rpc_controller_;
 };
@@ -51,5 +51,7 @@ void RawKvPutIfAbsentTask::KvPutIfAbsentRpcCallback(const Status& status) {
   DoAsyncDone(status);
 }
 
+void RawKvPutIfAbsentTask::InvalidateReadCache() { stub.GetRawKvReadCache()->Invalidate(key_); }
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
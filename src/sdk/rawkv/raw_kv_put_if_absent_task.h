@@ -34,6 +34,8 @@ class RawKvPutIfAbsentTask : public RawKvTask {
   void KvPutIfAbsentRpcCallback(const Status& status);
 
   std::string Name() const override { return "RawKvPutIfAbsentTask"; }
+
+  void InvalidateReadCache() override;
   std::string ErrorMsg() const override { return fmt::format("key: {}", key_); }
 
   const std::string& key_;
@@ -45,6 +45,8 @@ void RawKvPutTask::DoAsync() {
 
 void RawKvPutTask::KvPutRpcCallback(const Status& status) { DoAsyncDone(status); }
 
+void RawKvPutTask::InvalidateReadCache() { stub.GetRawKvReadCache()->Invalidate(key_); }
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -35,6 +35,8 @@ class RawKvPutTask : public RawKvTask {
   void KvPutRpcCallback(const Status& status);
 
   std::string Name() const override { return "RawKvPutTask"; }
+
+  void InvalidateReadCache() override;
   std::string ErrorMsg() const override { return fmt::format("key: {}", key_); }
 
   const std::string& key_;
@@ -0,0 +1,130 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_read_cache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+bool RawKvReadCache::IsValid(const Entry& entry, int64_t now_ms) const {
+  if (entry.expire_ms <= now_ms) {
+    return false;
+  }
+  // meta cache mark old region stale when region epoch changed or range cleared
+  return !entry.region->IsStale();
+}
+
+void RawKvReadCache::EraseUnlocked(std::map<std::string, EntryList::iterator, std::less<void>>::iterator iter) {
+  lru_.erase(iter->second);
+  index_.erase(iter);
+}
+
+bool RawKvReadCache::Get(const std::string& key, std::string& value) {
+  if (!Enabled()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = index_.find(key);
+  if (iter == index_.end()) {
+    return false;
+  }
+
+  if (!IsValid(*iter->second, NowMs())) {
+    EraseUnlocked(iter);
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, iter->second);
+  value = iter->second->value;
+  return true;
+}
+
+void RawKvReadCache::Put(const std::string& key, const std::string& value, const std::shared_ptr<Region>& region,
+                         uint64_t seq) {
+  if (!Enabled()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  // check under lock, Invalidate bump seq before erase under the same lock
+  if (seq != write_seq_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  int64_t expire_ms = NowMs() + ttl_ms_;
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    Entry& entry = *iter->second;
+    entry.value = value;
+    entry.region = region;
+    entry.expire_ms = expire_ms;
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    return;
+  }
+
+  lru_.push_front({key, value, region, expire_ms});
+  index_.emplace(key, lru_.begin());
+
+  if (static_cast<int64_t>(lru_.size()) > capacity_) {
+    index_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+}
+
+void RawKvReadCache::Invalidate(const std::string& key) {
+  if (!Enabled()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  write_seq_.fetch_add(1, std::memory_order_acq_rel);
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    EraseUnlocked(iter);
+  }
+}
+
+void RawKvReadCache::InvalidateRange(const std::string& start_key, const std::string& end_key) {
+  if (!Enabled()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  write_seq_.fetch_add(1, std::memory_order_acq_rel);
+  auto iter = index_.lower_bound(start_key);
+  while (iter != index_.end() && iter->first < end_key) {
+    lru_.erase(iter->second);
+    iter = index_.erase(iter);
+  }
+}
+
+int64_t RawKvReadCache::Size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return lru_.size();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
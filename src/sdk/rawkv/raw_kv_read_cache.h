@@ -0,0 +1,91 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_READ_CACHE_H_
+#define DINGODB_SDK_RAW_KV_READ_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "sdk/region.h"
+
+namespace dingodb {
+namespace sdk {
+
+// LRU value cache in front of raw kv get and batch get, disabled when capacity <= 0.
+// Every entry is tagged with the region (id and epoch) it was read from, the entry
+// is dropped when the region is marked stale by MetaCache (epoch change, ClearRange),
+// or when ttl expired. Writes through the same client invalidate the written keys,
+// and bump write seq so that reads in flight during a write are not cached.
+class RawKvReadCache {
+ public:
+  RawKvReadCache(const RawKvReadCache&) = delete;
+  const RawKvReadCache& operator=(const RawKvReadCache&) = delete;
+
+  RawKvReadCache(int64_t capacity, int64_t ttl_ms) : capacity_(capacity), ttl_ms_(ttl_ms) {}
+
+  ~RawKvReadCache() = default;
+
+  bool Enabled() const { return capacity_ > 0; }
+
+  bool Get(const std::string& key, std::string& value);
+
+  // reader must take seq before sending rpc and pass it to Put
+  uint64_t WriteSeq() const { return write_seq_.load(std::memory_order_acquire); }
+
+  // ignored when any write happened after `seq`
+  void Put(const std::string& key, const std::string& value, const std::shared_ptr<Region>& region, uint64_t seq);
+
+  void Invalidate(const std::string& key);
+
+  // invalidate keys in [start_key, end_key)
+  void InvalidateRange(const std::string& start_key, const std::string& end_key);
+
+  int64_t Size();
+
+ private:
+  struct Entry {
+    std::string key;
+    std::string value;
+    // region id and epoch the value was read from, region is immutable except stale flag
+    std::shared_ptr<Region> region;
+    int64_t expire_ms;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  bool IsValid(const Entry& entry, int64_t now_ms) const;
+
+  void EraseUnlocked(std::map<std::string, EntryList::iterator, std::less<void>>::iterator iter);
+
+  const int64_t capacity_;
+  const int64_t ttl_ms_;
+
+  std::atomic<uint64_t> write_seq_{0};
+
+  std::mutex mutex_;
+  // front is the most recently used
+  EntryList lru_;
+  // ordered for range invalidation
+  std::map<std::string, EntryList::iterator, std::less<void>> index_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RAW_KV_READ_CACHE_H_
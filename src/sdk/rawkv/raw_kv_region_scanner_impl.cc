@@ -30,19 +30,33 @@ namespace dingodb {
 namespace sdk {
 
 RawKvRegionScannerImpl::RawKvRegionScannerImpl(const ClientStub& stub, std::shared_ptr<Region> region,
-                                               std::string start_key, std::string end_key)
+                                               std::string start_key, std::string end_key,
+                                               ReplicaReadPolicy replica_read, bool prefetch, bool key_only,
+                                               uint32_t value_prefix_len)
     : RegionScanner(stub, std::move(region)),
       start_key_(std::move(start_key)),
       end_key_(std::move(end_key)),
       opened_(false),
       has_more_(false),
-      batch_size_(FLAGS_scan_batch_size) {}
+      batch_sizer_(FLAGS_scan_batch_size),
+      replica_read_(replica_read),
+      key_only_(key_only),
+      value_prefix_len_(value_prefix_len) {
+  if (prefetch) {
+    prefetcher_ = std::make_unique<ScanBatchPrefetcher>(
+        [this](std::vector<KVPair>& kvs, StatusCallback cb) { FetchBatch(kvs, std::move(cb)); },
+        [this] { return has_more_.load(); });
+  }
+}
 
 static void RawKvRegionScannerImplDeleted(Status status, std::string scan_id) {
   VLOG(kSdkVlogLevel) << "RawKvRegionScannerImpl deleted, scanner id: " << scan_id << " status:" << status.ToString();
 }
 
 RawKvRegionScannerImpl::~RawKvRegionScannerImpl() {
+  if (prefetcher_ != nullptr) {
+    prefetcher_->Wait();
+  }
   std::string scan_id = scan_id_;
   AsyncClose([scan_id](auto&& s) { return RawKvRegionScannerImplDeleted(std::forward<decltype(s)>(s), scan_id); });
 }
@@ -57,7 +71,7 @@ void RawKvRegionScannerImpl::PrepareScanBegionRpc(KvScanBeginRpc& rpc) {
   range_with_option->set_with_end(false);
 
   request->set_max_fetch_cnt(0);
-  request->set_key_only(false);
+  request->set_key_only(key_only_);
   // TODO: maybe we should support scan keep_alive
   request->set_disable_auto_release(false);
   request->set_disable_coprocessor(true);
@@ -69,6 +83,7 @@ void RawKvRegionScannerImpl::AsyncOpen(StatusCallback cb) {
   PrepareScanBegionRpc(*rpc);
 
   auto* controller = new StoreRpcController(stub, *rpc, region);
+  controller->SetReplicaReadPolicy(replica_read_);
   controller->AsyncCall(
       [this, controller, rpc, cb](auto&& s) { AsyncOpenCallback(std::forward<decltype(s)>(s), controller, rpc, cb); });
 }
@@ -83,6 +98,9 @@ void RawKvRegionScannerImpl::AsyncOpenCallback(Status status, StoreRpcController
   if (status.ok()) {
     CHECK_EQ(0, rpc->Response()->kvs_size());
     scan_id_ = rpc->Response()->scan_id();
+    if (replica_read_ != kLeaderOnly) {
+      scan_end_point_ = rpc->GetEndPoint();
+    }
     has_more_ = true;
     opened_ = true;
   } else {
@@ -103,12 +121,20 @@ void RawKvRegionScannerImpl::PrepareScanReleaseRpc(KvScanReleaseRpc& rpc) {
 }
 
 void RawKvRegionScannerImpl::AsyncClose(StatusCallback cb) {
+  if (prefetcher_ != nullptr) {
+    // release after the in flight continue, which uses the same scan id
+    prefetcher_->Wait();
+  }
+
   if (opened_) {
     CHECK(!scan_id_.empty());
     auto* rpc = new KvScanReleaseRpc();
     PrepareScanReleaseRpc(*rpc);
 
     auto* controller = new StoreRpcController(stub, *rpc, region);
+    if (scan_end_point_.IsValid()) {
+      controller->PinEndPoint(scan_end_point_);
+    }
 
     opened_ = false;
     std::string scan_id = scan_id_;
@@ -140,22 +166,37 @@ void RawKvRegionScannerImpl::Close() {
                << ", scan_id:" << scan_id_;
 }
 
-bool RawKvRegionScannerImpl::HasMore() const { return has_more_; }
+bool RawKvRegionScannerImpl::HasMore() const {
+  // rows of a prefetched batch are not handed to caller yet
+  return has_more_.load() || (prefetcher_ != nullptr && prefetcher_->HasPending());
+}
 
 void RawKvRegionScannerImpl::PrepareScanContinueRpc(KvScanContinueRpc& rpc) {
   auto* request = rpc.MutableRequest();
   FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
   request->set_scan_id(scan_id_);
-  request->set_max_fetch_cnt(batch_size_);
+  request->set_max_fetch_cnt(batch_sizer_.Rows());
 }
 
 void RawKvRegionScannerImpl::AsyncNextBatch(std::vector<KVPair>& kvs, StatusCallback cb) {
   CHECK(opened_);
   CHECK(!scan_id_.empty());
+  if (prefetcher_ != nullptr) {
+    prefetcher_->AsyncNext(kvs, std::move(cb));
+    return;
+  }
+
+  FetchBatch(kvs, std::move(cb));
+}
+
+void RawKvRegionScannerImpl::FetchBatch(std::vector<KVPair>& kvs, StatusCallback cb) {
   auto rpc = std::make_unique<KvScanContinueRpc>();
   PrepareScanContinueRpc(*rpc);
 
   auto controller = std::make_unique<StoreRpcController>(stub, *rpc, region);
+  if (scan_end_point_.IsValid()) {
+    controller->PinEndPoint(scan_end_point_);
+  }
   controller->AsyncCall([this, c = controller.release(), r = rpc.release(), &kvs, cb](auto&& s) {
     KvScanContinueRpcCallback(std::forward<decltype(s)>(s), c, r, kvs, cb);
   });
@@ -176,13 +217,16 @@ void RawKvRegionScannerImpl::KvScanContinueRpcCallback(Status status, StoreRpcCo
       // scan to region end_key
       has_more_ = false;
     } else {
+      int64_t bytes = 0;
       for (const auto& kv : response->kvs()) {
+        bytes += kv.key().size() + kv.value().size();
         if (kv.key() < end_key_) {
-          tmp_kvs.push_back({kv.key(), kv.value()});
+          tmp_kvs.push_back({kv.key(), ProjectScanValue(kv.value(), key_only_, value_prefix_len_)});
         } else {
           has_more_ = false;
         }
       }
+      batch_sizer_.Record(response->kvs_size(), bytes);
     }
 
     kvs = std::move(tmp_kvs);
@@ -194,6 +238,62 @@ void RawKvRegionScannerImpl::KvScanContinueRpcCallback(Status status, StoreRpcCo
   cb(status);
 }
 
+void RawKvRegionScannerImpl::AsyncNextBatchInto(KvResultSet& out, StatusCallback cb) {
+  CHECK(opened_);
+  CHECK(!scan_id_.empty());
+  if (prefetcher_ != nullptr) {
+    // prefetched batches are vectors already
+    RegionScanner::AsyncNextBatchInto(out, std::move(cb));
+    return;
+  }
+
+  auto rpc = std::make_shared<KvScanContinueRpc>();
+  PrepareScanContinueRpc(*rpc);
+
+  auto controller = std::make_unique<StoreRpcController>(stub, *rpc, region);
+  if (scan_end_point_.IsValid()) {
+    controller->PinEndPoint(scan_end_point_);
+  }
+  controller->AsyncCall([this, c = controller.release(), rpc, &out, cb](auto&& s) {
+    KvScanContinueRpcIntoCallback(std::forward<decltype(s)>(s), c, rpc, out, cb);
+  });
+}
+
+void RawKvRegionScannerImpl::KvScanContinueRpcIntoCallback(Status status, StoreRpcController* controller,
+                                                           std::shared_ptr<KvScanContinueRpc> rpc, KvResultSet& out,
+                                                           StatusCallback cb) {
+  SCOPED_CLEANUP({ delete controller; });
+
+  if (status.ok()) {
+    const auto* response = rpc->Response();
+    if (response->kvs_size() == 0) {
+      // scan to region end_key
+      has_more_ = false;
+    } else {
+      int64_t bytes = 0;
+      int64_t count = 0;
+      for (const auto& kv : response->kvs()) {
+        bytes += kv.key().size() + kv.value().size();
+        if (kv.key() < end_key_) {
+          out.AppendView(kv.key(), ProjectScanValueView(kv.value(), key_only_, value_prefix_len_));
+          count++;
+        } else {
+          has_more_ = false;
+        }
+      }
+      batch_sizer_.Record(response->kvs_size(), bytes);
+      if (count > 0) {
+        out.Retain(std::move(rpc));
+      }
+    }
+  } else {
+    DINGO_LOG(WARNING) << "scanner_id:" << scan_id_ << " scan continue fail region:" << region->RegionId()
+                       << ", fail:" << status.ToString();
+  }
+
+  cb(status);
+}
+
 Status RawKvRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
   Synchronizer sync;
   Status status;
@@ -203,16 +303,7 @@ Status RawKvRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
 }
 
 Status RawKvRegionScannerImpl::SetBatchSize(int64_t size) {
-  uint64_t to_size = size;
-  if (size <= kMinScanBatchSize) {
-    to_size = kMinScanBatchSize;
-  }
-
-  if (size > kMaxScanBatchSize) {
-    to_size = kMaxScanBatchSize;
-  }
-
-  batch_size_ = to_size;
+  batch_sizer_.SetRows(size);
   return Status::OK();
 }
 
@@ -222,6 +313,10 @@ RawKvRegionScannerFactoryImpl::~RawKvRegionScannerFactoryImpl() = default;
 
 Status RawKvRegionScannerFactoryImpl::NewRegionScanner(const ScannerOptions& options,
                                                        std::shared_ptr<RegionScanner>& scanner) {
+  if (options.reverse) {
+    return Status::NotSupported("raw kv region scanner not support reverse scan");
+  }
+
   CHECK(options.start_key < options.end_key);
   CHECK(options.start_key >= options.region->Range().start_key())
       << fmt::format("start_key:{} should greater than region range start_key:{}", options.start_key,
@@ -229,8 +324,10 @@ Status RawKvRegionScannerFactoryImpl::NewRegionScanner(const ScannerOptions& opt
   CHECK(options.end_key <= options.region->Range().end_key()) << fmt::format(
       "end_key:{} should little than region range end_key:{}", options.end_key, options.region->Range().end_key());
 
-  std::shared_ptr<RegionScanner> tmp(
-      new RawKvRegionScannerImpl(options.stub, options.region, options.start_key, options.end_key));
+  std::shared_ptr<RegionScanner> tmp(new RawKvRegionScannerImpl(options.stub, options.region, options.start_key,
+                                                                options.end_key, options.replica_read,
+                                                                options.prefetch, options.key_only,
+                                                                options.value_prefix_len));
   scanner = std::move(tmp);
 
   return Status::OK();
@@ -16,6 +16,7 @@
 #ifndef DINGODB_SDK_REGON_SCANNER_IMPL_H_
 #define DINGODB_SDK_REGON_SCANNER_IMPL_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -26,6 +27,8 @@
 #include "sdk/region_scanner.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/scan_batch_prefetcher.h"
+#include "sdk/utils/scan_batch_sizer.h"
 
 namespace dingodb {
 namespace sdk {
@@ -34,8 +37,11 @@ class TestBase;
 
 class RawKvRegionScannerImpl : public RegionScanner {
  public:
+  // prefetch: the next batch is fetched when a batch is returned, see ScanBatchPrefetcher
+  // key_only, value_prefix_len: see ScanOptions
   explicit RawKvRegionScannerImpl(const ClientStub& stub, std::shared_ptr<Region> region, std::string start_key,
-                             std::string end_key);
+                             std::string end_key, ReplicaReadPolicy replica_read = kLeaderOnly, bool prefetch = false,
+                             bool key_only = false, uint32_t value_prefix_len = 0);
 
   ~RawKvRegionScannerImpl() override;
 
@@ -52,11 +58,14 @@ class RawKvRegionScannerImpl : public RegionScanner {
 
   void AsyncNextBatch(std::vector<KVPair>& kvs, StatusCallback cb) override;
 
+  // views into the scan continue response, which out keeps, no copy of kvs
+  void AsyncNextBatchInto(KvResultSet& out, StatusCallback cb) override;
+
   bool HasMore() const override;
 
   Status SetBatchSize(int64_t size) override;
 
-  int64_t GetBatchSize() const override { return batch_size_; }
+  int64_t GetBatchSize() const override { return batch_sizer_.Rows(); }
 
   bool TEST_IsOpen() {  // NOLINT
     return opened_;
@@ -68,19 +77,32 @@ class RawKvRegionScannerImpl : public RegionScanner {
 
   void PrepareScanContinueRpc(KvScanContinueRpc& rpc);
 
+  // send one KvScanContinueRpc
+  void FetchBatch(std::vector<KVPair>& kvs, StatusCallback cb);
+
   void KvScanContinueRpcCallback(Status status, StoreRpcController* controller, KvScanContinueRpc* rpc,
                                  std::vector<KVPair>& kvs, StatusCallback cb);
 
+  void KvScanContinueRpcIntoCallback(Status status, StoreRpcController* controller,
+                                     std::shared_ptr<KvScanContinueRpc> rpc, KvResultSet& out, StatusCallback cb);
+
   void PrepareScanReleaseRpc(KvScanReleaseRpc& rpc);
   static void AsyncCloseCallback(Status status, std::string scan_id, StoreRpcController* controller,
                                  KvScanReleaseRpc* rpc, StatusCallback cb);
 
   std::string start_key_;
   std::string end_key_;
-  int64_t batch_size_;
+  ScanBatchSizer batch_sizer_;
   bool opened_;
   std::string scan_id_;
-  bool has_more_;
+  // written by rpc callback, read by caller when prefetch
+  std::atomic<bool> has_more_;
+  ReplicaReadPolicy replica_read_;
+  bool key_only_;
+  uint32_t value_prefix_len_;
+  // replica the scanner is opened on, continue and release must go to the same replica
+  EndPoint scan_end_point_;
+  std::unique_ptr<ScanBatchPrefetcher> prefetcher_;
 };
 
 class RawKvRegionScannerFactoryImpl final : public RegionScannerFactory {
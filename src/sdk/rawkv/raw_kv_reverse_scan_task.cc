@@ -0,0 +1,166 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_reverse_scan_task.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+#include "sdk/common/param_config.h"
+#include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/region_scanner.h"
+
+namespace dingodb {
+namespace sdk {
+
+RawKvReverseScanTask::RawKvReverseScanTask(const ClientStub& stub, const std::string& start_key,
+                                           const std::string& end_key, uint64_t limit, std::vector<KVPair>& out_kvs)
+    : RawKvTask(stub), start_key_(start_key), end_key_(end_key), limit_(limit), out_kvs_(out_kvs) {}
+
+Status RawKvReverseScanTask::Init() {
+  // precheck: return not found if no region in [start, end_key)
+  std::shared_ptr<Region> region;
+  Status ret = stub.GetMetaCache()->LookupRegionBetweenRange(start_key_, end_key_, region);
+  if (!ret.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("lookup region fail between [{},{}), status:{}", start_key_, end_key_,
+                                      ret.ToString());
+  }
+  return ret;
+}
+
+void RawKvReverseScanTask::DoAsync() {
+  // reset state, DoAsync maybe called again when retry
+  regions_.clear();
+  scanned_regions_ = 0;
+  region_kvs_.clear();
+  tmp_out_kvs_.clear();
+
+  status_ = CollectRegions();
+  if (!status_.ok()) {
+    DoAsyncDone(status_);
+    return;
+  }
+
+  ScanPrevRegion();
+}
+
+Status RawKvReverseScanTask::CollectRegions() {
+  // meta cache only looks up forward, regions are mostly cached or prefetched
+  auto meta_cache = stub.GetMetaCache();
+  std::string next_start_key = start_key_;
+  while (next_start_key < end_key_) {
+    std::shared_ptr<Region> region;
+    Status s = meta_cache->LookupRegionBetweenRange(next_start_key, end_key_, region);
+    if (s.IsNotFound()) {
+      break;
+    }
+
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start_key,
+                                        end_key_, start_key_, s.ToString());
+      return s;
+    }
+
+    next_start_key = region->Range().end_key();
+    regions_.push_back(std::move(region));
+  }
+
+  return Status::OK();
+}
+
+void RawKvReverseScanTask::ScanPrevRegion() {
+  if (ReachLimit() || scanned_regions_ >= regions_.size()) {
+    DINGO_LOG(INFO) << fmt::format("reverse scan end between [{},{}), limit:{}, scan_cnt:{}, region_cnt:{}",
+                                   start_key_, end_key_, limit_, tmp_out_kvs_.size(), scanned_regions_);
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  const auto& region = regions_[regions_.size() - 1 - scanned_regions_];
+  std::string scanner_start_key = std::max(start_key_, region->Range().start_key());
+  std::string scanner_end_key = std::min(end_key_, region->Range().end_key());
+  ScannerOptions options(stub, region, scanner_start_key, scanner_end_key);
+  options.prefetch = FLAGS_scan_prefetch;
+
+  std::shared_ptr<RegionScanner> scanner;
+  CHECK(stub.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner).IsOK());
+
+  region_kvs_.clear();
+  scanner->AsyncOpen([this, scanner](auto&& s) { ScannerOpenCallback(std::forward<decltype(s)>(s), scanner); });
+}
+
+void RawKvReverseScanTask::ScannerOpenCallback(Status status, std::shared_ptr<RegionScanner> scanner) {
+  status_ = status;
+  if (!status_.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner open fail, region:{}, status:{}",
+                                      scanner->GetRegion()->RegionId(), status_.ToString());
+    DoAsyncDone(status_);
+    return;
+  }
+
+  ScanNextWithScanner(std::move(scanner));
+}
+
+void RawKvReverseScanTask::ScanNextWithScanner(std::shared_ptr<RegionScanner> scanner) {
+  if (scanner->HasMore()) {
+    batch_kvs_.clear();
+    scanner->AsyncNextBatch(batch_kvs_,
+                            [this, scanner](auto&& s) { NextBatchCallback(std::forward<decltype(s)>(s), scanner); });
+  } else {
+    FinishRegion();
+    ScanPrevRegion();
+  }
+}
+
+void RawKvReverseScanTask::NextBatchCallback(const Status& status, std::shared_ptr<RegionScanner> scanner) {
+  status_ = status;
+  if (!status_.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner NextBatch fail, region:{}, status:{}",
+                                      scanner->GetRegion()->RegionId(), status_.ToString());
+    DoAsyncDone(status_);
+    return;
+  }
+
+  region_kvs_.insert(region_kvs_.end(), std::make_move_iterator(batch_kvs_.begin()),
+                     std::make_move_iterator(batch_kvs_.end()));
+
+  // only the biggest Need() rows of the region can be returned, drop the rest in chunks to bound memory
+  uint64_t need = Need();
+  if (need != 0 && region_kvs_.size() >= 2 * need) {
+    region_kvs_.erase(region_kvs_.begin(), region_kvs_.end() - need);
+  }
+
+  ScanNextWithScanner(std::move(scanner));
+}
+
+void RawKvReverseScanTask::FinishRegion() {
+  uint64_t need = Need();
+  size_t count = need == 0 ? region_kvs_.size() : std::min<size_t>(need, region_kvs_.size());
+  tmp_out_kvs_.insert(tmp_out_kvs_.end(), std::make_move_iterator(region_kvs_.rbegin()),
+                      std::make_move_iterator(region_kvs_.rbegin() + count));
+  region_kvs_.clear();
+  scanned_regions_++;
+}
+
+uint64_t RawKvReverseScanTask::Need() const { return limit_ == 0 ? 0 : limit_ - tmp_out_kvs_.size(); }
+
+bool RawKvReverseScanTask::ReachLimit() const { return limit_ != 0 && tmp_out_kvs_.size() >= limit_; }
+
+void RawKvReverseScanTask::PostProcess() { out_kvs_ = std::move(tmp_out_kvs_); }
+
+}  // namespace sdk
+
+}  // namespace dingodb
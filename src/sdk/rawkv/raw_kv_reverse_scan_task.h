@@ -0,0 +1,82 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_REVERSE_SCAN_TASK_H_
+#define DINGODB_SDK_RAW_KV_REVERSE_SCAN_TASK_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/region.h"
+#include "sdk/region_scanner.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// walk regions from end_key back to start_key and stop at the first region which fills limit, out_kvs are in
+// descending key order. Raw kv scanner of store only scans forward, so a region is scanned forward and only its
+// last rows which are still needed are kept.
+class RawKvReverseScanTask : public RawKvTask {
+ public:
+  RawKvReverseScanTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key,
+                       uint64_t limit, std::vector<KVPair>& out_kvs);
+
+  ~RawKvReverseScanTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+  void PostProcess() override;
+
+  Status CollectRegions();
+
+  void ScanPrevRegion();
+  void ScannerOpenCallback(Status status, std::shared_ptr<RegionScanner> scanner);
+  void ScanNextWithScanner(std::shared_ptr<RegionScanner> scanner);
+  void NextBatchCallback(const Status& status, std::shared_ptr<RegionScanner> scanner);
+  // move region rows to out in descending order
+  void FinishRegion();
+
+  // rows still needed, 0 means no limit
+  uint64_t Need() const;
+  bool ReachLimit() const;
+
+  std::string Name() const override { return "RawKvReverseScanTask"; }
+  std::string ErrorMsg() const override {
+    return fmt::format("start_key: {}, end_key:{}, limit:{}", start_key_, end_key_, limit_);
+  }
+
+  const std::string& start_key_;
+  const std::string& end_key_;
+  const uint64_t limit_;
+  std::vector<KVPair>& out_kvs_;
+
+  Status status_;
+  // regions in [start_key, end_key) by start key, scanned from the back
+  std::vector<std::shared_ptr<Region>> regions_;
+  size_t scanned_regions_{0};
+  // ascending rows of current region, front is dropped once more than Need() rows are kept
+  std::vector<KVPair> region_kvs_;
+  std::vector<KVPair> batch_kvs_;
+  std::vector<KVPair> tmp_out_kvs_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RAW_KV_REVERSE_SCAN_TASK_H_
@@ -0,0 +1,133 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_scan_result_set_task.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+RawKvScanResultSetTask::RawKvScanResultSetTask(const ClientStub& stub, const std::string& start_key,
+                                               const std::string& end_key, uint64_t limit, KvResultSet& out_kvs,
+                                               const ScanOptions& options)
+    : RawKvTask(stub), start_key_(start_key), end_key_(end_key), limit_(limit), out_kvs_(out_kvs), options_(options) {}
+
+Status RawKvScanResultSetTask::Init() {
+  std::shared_ptr<Region> region;
+  Status ret = stub.GetMetaCache()->LookupRegionBetweenRange(start_key_, end_key_, region);
+  if (!ret.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("lookup region fail between [{},{}), status:{}", start_key_, end_key_,
+                                      ret.ToString());
+    return ret;
+  }
+
+  next_start_key_ = start_key_;
+  return Status::OK();
+}
+
+void RawKvScanResultSetTask::DoAsync() {
+  // kvs returned already are kept, a retry after region split or merge goes on from next_start_key_
+  ScanNext();
+}
+
+void RawKvScanResultSetTask::ScanNext() {
+  if (ReachLimit()) {
+    tmp_out_kvs_.Truncate(limit_);
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  if (next_start_key_ >= end_key_) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  std::shared_ptr<Region> region;
+  Status s = stub.GetMetaCache()->LookupRegionBetweenRange(next_start_key_, end_key_, region);
+  if (s.IsNotFound()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start_key_,
+                                      end_key_, start_key_, s.ToString());
+    DoAsyncDone(s);
+    return;
+  }
+
+  std::string scanner_start_key = std::max(next_start_key_, region->Range().start_key());
+  std::string scanner_end_key = std::min(end_key_, region->Range().end_key());
+  ScannerOptions options(stub, region, scanner_start_key, scanner_end_key);
+  options.replica_read = options_.replica_read;
+  options.key_only = options_.key_only;
+  options.value_prefix_len = options_.value_prefix_len;
+
+  std::shared_ptr<RegionScanner> scanner;
+  CHECK(stub.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner).IsOK());
+
+  scanner->AsyncOpen([this, scanner](auto&& s) { ScannerOpenCallback(std::forward<decltype(s)>(s), scanner); });
+}
+
+void RawKvScanResultSetTask::ScannerOpenCallback(Status status, std::shared_ptr<RegionScanner> scanner) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner open fail, region:{}, status:{}",
+                                      scanner->GetRegion()->RegionId(), status.ToString());
+    DoAsyncDone(status);
+    return;
+  }
+
+  ScanNextWithScanner(std::move(scanner));
+}
+
+void RawKvScanResultSetTask::ScanNextWithScanner(std::shared_ptr<RegionScanner> scanner) {
+  if (scanner->HasMore() && !ReachLimit()) {
+    size_t size = tmp_out_kvs_.Size();
+    scanner->AsyncNextBatchInto(tmp_out_kvs_, [this, scanner, size](auto&& s) {
+      NextBatchCallback(std::forward<decltype(s)>(s), scanner, size);
+    });
+  } else {
+    next_start_key_ = scanner->GetRegion()->Range().end_key();
+    ScanNext();
+  }
+}
+
+void RawKvScanResultSetTask::NextBatchCallback(const Status& status, std::shared_ptr<RegionScanner> scanner,
+                                               size_t prev_size) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner NextBatch fail, region:{}, status:{}",
+                                      scanner->GetRegion()->RegionId(), status.ToString());
+    DoAsyncDone(status);
+    return;
+  }
+
+  if (tmp_out_kvs_.Size() > prev_size) {
+    next_start_key_ = tmp_out_kvs_.Key(tmp_out_kvs_.Size() - 1).ToString();
+    next_start_key_.push_back('\0');
+  }
+
+  ScanNextWithScanner(std::move(scanner));
+}
+
+void RawKvScanResultSetTask::PostProcess() { out_kvs_ = std::move(tmp_out_kvs_); }
+
+}  // namespace sdk
+}  // namespace dingodb
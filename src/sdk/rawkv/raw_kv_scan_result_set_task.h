@@ -0,0 +1,70 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_SCAN_RESULT_SET_TASK_H_
+#define DINGODB_SDK_RAW_KV_SCAN_RESULT_SET_TASK_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "sdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/region_scanner.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// scan into KvResultSet, regions are scanned one by one and their scan responses are kept by the result set
+// instead of copied into strings, FLAGS_raw_kv_scan_parallelism and FLAGS_scan_prefetch are not used
+class RawKvScanResultSetTask : public RawKvTask {
+ public:
+  RawKvScanResultSetTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key,
+                         uint64_t limit, KvResultSet& out_kvs, const ScanOptions& options = ScanOptions());
+
+  ~RawKvScanResultSetTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+  void PostProcess() override;
+
+  void ScanNext();
+  void ScannerOpenCallback(Status status, std::shared_ptr<RegionScanner> scanner);
+  void ScanNextWithScanner(std::shared_ptr<RegionScanner> scanner);
+  // prev_size: size of tmp_out_kvs_ before the batch
+  void NextBatchCallback(const Status& status, std::shared_ptr<RegionScanner> scanner, size_t prev_size);
+
+  bool ReachLimit() const { return limit_ != 0 && tmp_out_kvs_.Size() >= limit_; }
+
+  std::string Name() const override { return "RawKvScanResultSetTask"; }
+  std::string ErrorMsg() const override {
+    return fmt::format("start_key: {}, end_key:{}, limit:{}", start_key_, end_key_, limit_);
+  }
+
+  const std::string& start_key_;
+  const std::string& end_key_;
+  const uint64_t limit_;
+  KvResultSet& out_kvs_;
+  const ScanOptions options_;
+
+  std::string next_start_key_;
+  KvResultSet tmp_out_kvs_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RAW_KV_SCAN_RESULT_SET_TASK_H_
@@ -14,8 +14,13 @@
 
 #include "sdk/rawkv/raw_kv_scan_task.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rawkv/raw_kv_task.h"
 #include "sdk/region_scanner.h"
 
@@ -23,8 +28,8 @@ namespace dingodb {
 namespace sdk {
 
 RawKvScanTask::RawKvScanTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key,
-                             uint64_t limit, std::vector<KVPair>& out_kvs)
-    : RawKvTask(stub), start_key_(start_key), end_key_(end_key), limit_(limit), out_kvs_(out_kvs) {}
+                             uint64_t limit, std::vector<KVPair>& out_kvs, const ScanOptions& options)
+    : RawKvTask(stub), start_key_(start_key), end_key_(end_key), limit_(limit), out_kvs_(out_kvs), options_(options) {}
 
 Status RawKvScanTask::Init() {
   auto meta_cache = stub.GetMetaCache();
@@ -48,10 +53,13 @@ Status RawKvScanTask::Init() {
 }
 
 void RawKvScanTask::DoAsync() {
+  // a retry after region split or merge goes on from next_start_key_, kvs returned already are kept
   CHECK(!next_start_key_.empty()) << "next_start_key_ should not empty";
-  CHECK(next_start_key_ < end_key_) << fmt::format("next_start_key_:{} should less than end_key_:{}", next_start_key_,
-                                                   end_key_);
-  ScanNext();
+  if (FLAGS_raw_kv_scan_parallelism > 1) {
+    ParallelScan();
+  } else {
+    ScanNext();
+  }
 }
 
 void RawKvScanTask::ScanNext() {
@@ -92,6 +100,10 @@ void RawKvScanTask::ScanNext() {
       next_start_key_ <= region->Range().start_key() ? region->Range().start_key() : next_start_key_;
   std::string scanner_end_key = end_key_ <= region->Range().end_key() ? end_key_ : region->Range().end_key();
   ScannerOptions options(stub, region, scanner_start_key, scanner_end_key);
+  options.replica_read = options_.replica_read;
+  options.prefetch = FLAGS_scan_prefetch;
+  options.key_only = options_.key_only;
+  options.value_prefix_len = options_.value_prefix_len;
 
   std::shared_ptr<RegionScanner> scanner;
   CHECK(stub.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner).IsOK());
@@ -142,6 +154,8 @@ void RawKvScanTask::NextBatchCallback(const Status& status, std::shared_ptr<Regi
   }
 
   if (!tmp_scanner_scan_kvs_.empty()) {
+    next_start_key_ = tmp_scanner_scan_kvs_.back().key;
+    next_start_key_.push_back('\0');
     tmp_out_kvs_.insert(tmp_out_kvs_.end(), std::make_move_iterator(tmp_scanner_scan_kvs_.begin()),
                         std::make_move_iterator(tmp_scanner_scan_kvs_.end()));
   } else {
@@ -152,6 +166,276 @@ void RawKvScanTask::NextBatchCallback(const Status& status, std::shared_ptr<Regi
   ScanNextWithScanner(std::move(scanner));
 }
 
+Status RawKvScanTask::CollectScanParts() {
+  auto meta_cache = stub.GetMetaCache();
+
+  std::string next_start_key = next_start_key_;
+  while (next_start_key < end_key_) {
+    std::shared_ptr<Region> region;
+    Status s = meta_cache->LookupRegionBetweenRange(next_start_key, end_key_, region);
+    if (s.IsNotFound()) {
+      DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), start_key:{} status:{}", next_start_key,
+                                     end_key_, start_key_, s.ToString());
+      break;
+    }
+
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start_key,
+                                        end_key_, start_key_, s.ToString());
+      return s;
+    }
+
+    ScanPart part;
+    part.next_key = std::max(next_start_key, region->Range().start_key());
+    part.end_key = std::min(end_key_, region->Range().end_key());
+    part.region = std::move(region);
+    next_start_key = part.region->Range().end_key();
+    parts_.push_back(std::move(part));
+  }
+
+  return Status::OK();
+}
+
+void RawKvScanTask::ParallelScan() {
+  // reset state, DoAsync maybe called again when retry
+  parts_.clear();
+  next_part_ = 0;
+  inflight_parts_ = 0;
+  done_prefix_ = 0;
+  done_prefix_count_ = 0;
+  cancelled_.store(false);
+  tmp_out_kvs_.clear();
+
+  Status s = CollectScanParts();
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
+  }
+
+  if (parts_.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  std::vector<size_t> to_start;
+  {
+    std::unique_lock<std::mutex> lk(parts_mutex_);
+    size_t concurrency = std::min(parts_.size(), static_cast<size_t>(FLAGS_raw_kv_scan_parallelism));
+    for (size_t i = 0; i < concurrency; i++) {
+      to_start.push_back(next_part_++);
+      inflight_parts_++;
+    }
+  }
+
+  // start outside lock, scanner callback maybe run in current thread
+  for (size_t index : to_start) {
+    StartScanPart(index);
+  }
+}
+
+void RawKvScanTask::StartScanPart(size_t index) {
+  auto& part = parts_[index];
+  std::string start_key = std::max(part.next_key, part.region->Range().start_key());
+  std::string end_key = std::min(part.end_key, part.region->Range().end_key());
+  ScannerOptions options(stub, part.region, start_key, end_key);
+  options.replica_read = options_.replica_read;
+  options.prefetch = FLAGS_scan_prefetch;
+  options.key_only = options_.key_only;
+  options.value_prefix_len = options_.value_prefix_len;
+
+  std::shared_ptr<RegionScanner> scanner;
+  CHECK(stub.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner).IsOK());
+
+  scanner->AsyncOpen([this, index, scanner](auto&& s) {
+    ScanPartOpenCallback(std::forward<decltype(s)>(s), index, scanner);
+  });
+}
+
+void RawKvScanTask::ScanPartOpenCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner open fail, region:{}, status:{}",
+                                      parts_[index].region->RegionId(), status.ToString());
+    if (!MaybeResumeScanPart(index, status)) {
+      ScanPartDone(index, status, false);
+    }
+    return;
+  }
+
+  ScanPartNext(index, std::move(scanner));
+}
+
+void RawKvScanTask::ScanPartNext(size_t index, std::shared_ptr<RegionScanner> scanner) {
+  auto& part = parts_[index];
+  if (limit_ != 0 && part.kvs.size() >= limit_) {
+    ScanPartDone(index, Status::OK(), true);
+    return;
+  }
+
+  if (!scanner->HasMore()) {
+    part.next_key = std::min(part.end_key, part.region->Range().end_key());
+    if (part.next_key < part.end_key) {
+      // region split during scan, the rest of part is in following regions
+      ScanPartNextRegion(index);
+    } else {
+      ScanPartDone(index, Status::OK(), true);
+    }
+    return;
+  }
+
+  if (cancelled_.load()) {
+    ScanPartDone(index, Status::OK(), false);
+    return;
+  }
+
+  part.batch_kvs.clear();
+  scanner->AsyncNextBatch(part.batch_kvs, [this, index, scanner](auto&& s) {
+    ScanPartNextBatchCallback(std::forward<decltype(s)>(s), index, scanner);
+  });
+}
+
+void RawKvScanTask::ScanPartNextBatchCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner) {
+  auto& part = parts_[index];
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner NextBatch fail, region:{}, status:{}", part.region->RegionId(),
+                                      status.ToString());
+    if (!MaybeResumeScanPart(index, status)) {
+      ScanPartDone(index, status, false);
+    }
+    return;
+  }
+
+  if (!part.batch_kvs.empty()) {
+    part.next_key = part.batch_kvs.back().key;
+    part.next_key.push_back('\0');
+    part.kvs.insert(part.kvs.end(), std::make_move_iterator(part.batch_kvs.begin()),
+                    std::make_move_iterator(part.batch_kvs.end()));
+  } else {
+    CHECK(!scanner->HasMore());
+  }
+
+  ScanPartNext(index, std::move(scanner));
+}
+
+void RawKvScanTask::ScanPartNextRegion(size_t index) {
+  auto& part = parts_[index];
+  if (part.next_key >= part.end_key) {
+    ScanPartDone(index, Status::OK(), true);
+    return;
+  }
+
+  std::shared_ptr<Region> region;
+  Status s = stub.GetMetaCache()->LookupRegionBetweenRange(part.next_key, part.end_key, region);
+  if (s.IsNotFound()) {
+    DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), start_key:{} status:{}", part.next_key,
+                                   part.end_key, start_key_, s.ToString());
+    ScanPartDone(index, Status::OK(), true);
+    return;
+  }
+
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", part.next_key,
+                                      part.end_key, start_key_, s.ToString());
+    ScanPartDone(index, s, false);
+    return;
+  }
+
+  part.region = std::move(region);
+  StartScanPart(index);
+}
+
+bool RawKvScanTask::MaybeResumeScanPart(size_t index, const Status& status) {
+  auto& part = parts_[index];
+  // region change is a reroute, not charged to the retry budget
+  if (!IsRegionChanged(status) || cancelled_.load() || part.retry >= FLAGS_raw_kv_max_retry) {
+    return false;
+  }
+
+  part.retry++;
+  DINGO_LOG(INFO) << fmt::format("region:{} changed during scan, resume part from:{}, retry:{}",
+                                 part.region->RegionId(), part.next_key, part.retry);
+  stub.GetActuator()->Schedule([this, index] { ScanPartNextRegion(index); }, FLAGS_raw_kv_delay_ms);
+  return true;
+}
+
+void RawKvScanTask::ScanPartDone(size_t index, Status status, bool complete) {
+  int64_t next = -1;
+  bool all_done = false;
+  {
+    std::unique_lock<std::mutex> lk(parts_mutex_);
+    auto& part = parts_[index];
+    part.status = status;
+    part.complete = complete;
+    part.done = true;
+    inflight_parts_--;
+
+    if (!status.ok()) {
+      cancelled_.store(true);
+    }
+
+    while (done_prefix_ < parts_.size() && parts_[done_prefix_].done) {
+      done_prefix_count_ += parts_[done_prefix_].kvs.size();
+      done_prefix_++;
+    }
+    if (limit_ != 0 && done_prefix_count_ >= limit_) {
+      // following parts are not needed any more
+      cancelled_.store(true);
+    }
+
+    if (!cancelled_.load() && next_part_ < parts_.size()) {
+      next = next_part_++;
+      inflight_parts_++;
+    }
+
+    all_done = (inflight_parts_ == 0);
+  }
+
+  if (next >= 0) {
+    StartScanPart(next);
+  } else if (all_done) {
+    DoAsyncDone(MergeScanParts());
+  }
+}
+
+Status RawKvScanTask::MergeScanParts() {
+  Status first_error;
+  for (const auto& part : parts_) {
+    if (!part.status.ok()) {
+      first_error = part.status;
+      break;
+    }
+  }
+
+  for (auto& part : parts_) {
+    if (ReachLimit()) {
+      break;
+    }
+
+    if (!part.status.ok()) {
+      return part.status;
+    }
+
+    if (!part.done) {
+      // not started because of cancelled
+      CHECK(!first_error.ok() || ReachLimit());
+      return first_error;
+    }
+
+    tmp_out_kvs_.insert(tmp_out_kvs_.end(), std::make_move_iterator(part.kvs.begin()),
+                        std::make_move_iterator(part.kvs.end()));
+    if (!part.complete && !ReachLimit()) {
+      // stopped early because other part fail, following kvs are not continuous
+      CHECK(!first_error.ok());
+      return first_error;
+    }
+  }
+
+  if (ReachLimit()) {
+    tmp_out_kvs_.resize(limit_);
+  }
+
+  return Status::OK();
+}
+
 bool RawKvScanTask::ReachLimit() { return limit_ != 0 && (tmp_out_kvs_.size() >= limit_); }
 
 void RawKvScanTask::PostProcess() { out_kvs_ = std::move(tmp_out_kvs_); }
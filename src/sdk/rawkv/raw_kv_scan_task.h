@@ -15,7 +15,12 @@
 #ifndef DINGODB_SDK_RAW_KV_SCAN_TASK_H_
 #define DINGODB_SDK_RAW_KV_SCAN_TASK_H_
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "sdk/client_stub.h"
 #include "sdk/rawkv/raw_kv_task.h"
@@ -27,7 +32,7 @@ namespace sdk {
 class RawKvScanTask : public RawKvTask {
  public:
   RawKvScanTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key, uint64_t limit,
-                std::vector<KVPair>& out_kvs);
+                std::vector<KVPair>& out_kvs, const ScanOptions& options = ScanOptions());
 
   ~RawKvScanTask() override = default;
 
@@ -43,6 +48,37 @@ class RawKvScanTask : public RawKvTask {
 
   bool ReachLimit();
 
+  // parallel mode: scan at most FLAGS_raw_kv_scan_parallelism regions concurrently, every region fills its own
+  // part, parts are concatenated in region order when all done, so result is still in key order.
+  // a part is a key range, when its region splits or merges mid-scan the part looks up the current region(s) and
+  // goes on from next_key, kvs returned already are kept
+  struct ScanPart {
+    // region being scanned, its range maybe not cover [next_key, end_key) after a split
+    std::shared_ptr<Region> region;
+    std::string end_key;
+    std::string next_key;
+    int retry{0};
+    std::vector<KVPair> kvs;
+    std::vector<KVPair> batch_kvs;
+    Status status;
+    // true when region is drained or kvs is enough for limit
+    bool complete{false};
+    bool done{false};
+  };
+
+  Status CollectScanParts();
+  void ParallelScan();
+  void StartScanPart(size_t index);
+  void ScanPartOpenCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner);
+  void ScanPartNext(size_t index, std::shared_ptr<RegionScanner> scanner);
+  void ScanPartNextBatchCallback(Status status, size_t index, std::shared_ptr<RegionScanner> scanner);
+  // look up region of the rest of part and scan it
+  void ScanPartNextRegion(size_t index);
+  // true when the part goes on in the new region(s) later
+  bool MaybeResumeScanPart(size_t index, const Status& status);
+  void ScanPartDone(size_t index, Status status, bool complete);
+  Status MergeScanParts();
+
   std::string Name() const override { return "RawKvScanTask"; }
   std::string ErrorMsg() const override {
     return fmt::format("start_key: {}, end_key:{}, limit:{}", start_key_, end_key_, limit_);
@@ -52,12 +88,25 @@ class RawKvScanTask : public RawKvTask {
   const std::string& end_key_;
   const uint64_t limit_;
   std::vector<KVPair>& out_kvs_;
+  const ScanOptions options_;
 
   Status status_;
   std::string next_start_key_;
   std::vector<KVPair> tmp_out_kvs_;
 
   std::vector<KVPair> tmp_scanner_scan_kvs_;
+
+  // NOTE: parts_ size is fixed before any part start, each part is only touched by its own scanner callback before
+  // done, and done/complete/status are guarded by parts_mutex_
+  std::vector<ScanPart> parts_;
+  std::mutex parts_mutex_;
+  size_t next_part_{0};
+  size_t inflight_parts_{0};
+  // parts_[0, done_prefix_) are done, done_prefix_count_ is their kvs count
+  size_t done_prefix_{0};
+  uint64_t done_prefix_count_{0};
+  // stop to start new part or read next batch, set when limit reached or any part fail
+  std::atomic<bool> cancelled_{false};
 };
 
 }  // namespace sdk
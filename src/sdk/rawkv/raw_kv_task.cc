@@ -14,7 +14,14 @@
 
 #include "sdk/rawkv/raw_kv_task.h"
 
+#include <algorithm>
+#include <cstdint>
+
+#include "sdk/common/common.h"
+#include "sdk/common/metrics.h"
 #include "sdk/common/param_config.h"
+#include "sdk/common/slow_log.h"
+#include "sdk/common/tracing.h"
 #include "sdk/utils/async_util.h"
 
 namespace dingodb {
@@ -30,10 +37,32 @@ Status RawKvTask::Run() {
 
 void RawKvTask::AsyncRun(StatusCallback cb) {
   CHECK(cb) << "cb is invalid";
+  start_us_ = Metrics::NowUs();
+  if (FLAGS_enable_sdk_tracing) {
+    span_ = Tracer::Global().StartSpan(Name(), Tracer::CurrentContext());
+  }
+  // rpcs and sub tasks started by Init and DoAsync are children of the task span
+  ScopedSpanContext span_scope(span_.Context());
+  slow_log_ = SlowLog::Join(slow_log_root_);
+  ScopedSlowLogRecorder slow_log_scope(slow_log_);
+  if (cancel_token_ == nullptr) {
+    cancel_token_ = CancelToken::Current();
+  }
+  // store rpcs and sub tasks started by Init and DoAsync stop at the same deadline
+  ScopedCancelToken cancel_scope(cancel_token_);
+  priority_ = CurrentRequestPriority();
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     call_back_.swap(cb);
   }
+
+  if (IsCanceled()) {
+    status_ = cancel_token_->Check();
+    FireCallback();
+    return;
+  }
+
+  InvalidateReadCache();
   Status status = Init();
   if (status.ok()) {
     DoAsync();
@@ -57,7 +86,11 @@ void RawKvTask::DoAsyncDone(const Status& status) {
 }
 
 void RawKvTask::FailOrRetry() {
-  if (NeedRetry()) {
+  if (IsCanceled()) {
+    DINGO_LOG_EVERY_SECOND(INFO) << "Task:" << Name() << " stop retry, last status:" << status_.ToString();
+    status_ = cancel_token_->Check();
+    FireCallback();
+  } else if (NeedRetry()) {
     BackoffAndRetry();
   } else {
     FireCallback();
@@ -65,18 +98,15 @@ void RawKvTask::FailOrRetry() {
 }
 
 bool RawKvTask::NeedRetry() {
-  if (status_.IsIncomplete()) {
-    auto error_code = status_.Errno();
-    if (error_code == pb::error::EREGION_VERSION || error_code == pb::error::EREGION_NOT_FOUND ||
-        error_code == pb::error::EKEY_OUT_OF_RANGE) {
-      retry_count_++;
-      if (retry_count_ < FLAGS_raw_kv_max_retry) {
-        return true;
-      } else {
-        std::string msg =
-            fmt::format("Fail task:{} retry too times:{}, last err:{}", Name(), retry_count_, status_.ToString());
-        status_ = Status::Aborted(status_.Errno(), msg);
-      }
+  // region change is a reroute, not charged to the retry budget
+  if (IsRegionChanged(status_)) {
+    retry_count_++;
+    if (retry_count_ < FLAGS_raw_kv_max_retry) {
+      return true;
+    } else {
+      std::string msg =
+          fmt::format("Fail task:{} retry too times:{}, last err:{}", Name(), retry_count_, status_.ToString());
+      status_ = Status::Aborted(status_.Errno(), msg);
     }
   }
 
@@ -84,16 +114,65 @@ bool RawKvTask::NeedRetry() {
 }
 
 void RawKvTask::BackoffAndRetry() {
-  stub.GetActuator()->Schedule([this] { DoAsync(); }, FLAGS_raw_kv_delay_ms);
+  if (FLAGS_enable_sdk_metrics) {
+    Metrics::Global().RecordTaskRetry(Name(), status_.Errno());
+  }
+  int64_t delay = FLAGS_raw_kv_delay_ms;
+  if (cancel_token_ != nullptr && cancel_token_->RemainingMs() >= 0) {
+    // wake up at the deadline at the latest, the retry fails fast then
+    delay = std::min<int64_t>(delay, cancel_token_->RemainingMs());
+  }
+  if (slow_log_ != nullptr) {
+    slow_log_->AddRetry();
+  }
+  if (span_.IsRecording()) {
+    // every retry is a child span covering the backoff and the rpcs of the retry
+    retry_span_.SetStatus(status_);
+    retry_span_ = Tracer::Global().StartChildSpan(Name() + ".retry", span_.Context());
+    retry_span_.SetAttribute("retry", retry_count_);
+    retry_span_.SetAttribute("reason", status_.ToString());
+    retry_span_.SetAttribute("delay_ms", delay);
+  }
+  // the timer dispatches the retry at the priority of the task
+  ScopedRequestPriority priority_scope(priority_);
+  stub.GetActuator()->Schedule(
+      [this] {
+        ScopedSpanContext span_scope(retry_span_.Context());
+        ScopedSlowLogRecorder slow_log_scope(slow_log_);
+        ScopedCancelToken cancel_scope(cancel_token_);
+        if (IsCanceled()) {
+          status_ = cancel_token_->Check();
+          FireCallback();
+          return;
+        }
+        DoAsync();
+      },
+      delay);
 }
 
 void RawKvTask::FireCallback() {
+  InvalidateReadCache();
   PostProcess();
 
   if (!status_.ok()) {
-    DINGO_LOG(WARNING) << "Fail task:" << Name() << ", status:" << status_.ToString() << ", error_msg:" << ErrorMsg();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "Fail task:" << Name() << ", status:" << status_.ToString() << ", error_msg:"
+                                    << ErrorMsg();
+  }
+
+  if (FLAGS_enable_sdk_metrics) {
+    Metrics::Global().RecordTask(Name(), Metrics::NowUs() - start_us_, status_, fan_out_);
+  }
+
+  if (slow_log_root_) {
+    SlowLog::Global().Finish(Name(), *slow_log_, Metrics::NowUs() - start_us_, status_);
   }
 
+  retry_span_.SetStatus(status_);
+  retry_span_.End();
+  span_.SetAttribute("fan_out", fan_out_);
+  span_.SetStatus(status_);
+  span_.End();
+
   StatusCallback cb;
   {
     std::shared_lock<std::shared_mutex> r(rw_lock_);
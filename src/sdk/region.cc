@@ -27,85 +27,108 @@ Region::Region(int64_t id, pb::common::Range range, pb::common::RegionEpoch epoc
       range_(std::move(range)),
       epoch_(std::move(epoch)),
       region_type_(type),
-      replicas_(std::move(replicas)),
+      end_points_(ToEndPoints(replicas)),
       stale_(true) {
-  for (auto& r : replicas_) {
-    if (r.role == kLeader) {
-      leader_addr_ = r.end_point;
+  for (size_t i = 0; i < replicas.size(); ++i) {
+    if (replicas[i].role == kLeader) {
+      leader_index_.store(static_cast<int32_t>(i), std::memory_order_relaxed);
       break;
     }
   }
 }
 
-std::vector<Replica> Region::Replicas() {
-  std::shared_lock<std::shared_mutex> r(rw_lock_);
-  return replicas_;
-}
-
-std::vector<EndPoint> Region::ReplicaEndPoint() {
-  std::shared_lock<std::shared_mutex> r(rw_lock_);
-
+std::vector<EndPoint> Region::ToEndPoints(const std::vector<Replica>& replicas) {
   std::vector<EndPoint> end_points;
-  end_points.reserve(replicas_.size());
-  for (const auto& r : replicas_) {
+  end_points.reserve(replicas.size());
+  for (const auto& r : replicas) {
     end_points.push_back(r.end_point);
   }
-
   return end_points;
 }
 
-void Region::MarkLeader(const EndPoint& end_point) {
-  std::unique_lock<std::shared_mutex> w(rw_lock_);
-  for (auto& r : replicas_) {
-    if (r.end_point == end_point) {
-      r.role = kLeader;
-    } else {
-      r.role = kFollower;
+int32_t Region::FindReplica(const EndPoint& end_point) const {
+  for (size_t i = 0; i < end_points_.size(); ++i) {
+    if (end_points_[i] == end_point) {
+      return static_cast<int32_t>(i);
     }
   }
+  return kNoLeader;
+}
 
-  leader_addr_ = end_point;
+std::vector<Replica> Region::Replicas() const {
+  int32_t leader_index = leader_index_.load(std::memory_order_acquire);
 
-  DINGO_LOG(INFO) << "region:" << region_id_ << " replicas:" << ReplicasAsStringUnlocked();
+  std::vector<Replica> replicas;
+  replicas.reserve(end_points_.size());
+  for (size_t i = 0; i < end_points_.size(); ++i) {
+    replicas.push_back({end_points_[i], static_cast<int32_t>(i) == leader_index ? kLeader : kFollower});
+  }
+  return replicas;
 }
 
-void Region::MarkFollower(const EndPoint& end_point) {
-  std::unique_lock<std::shared_mutex> w(rw_lock_);
-  for (auto& r : replicas_) {
-    if (r.end_point == end_point) {
-      r.role = kFollower;
-    }
+void Region::MarkLeader(const EndPoint& end_point) {
+  int32_t index = FindReplica(end_point);
+  if (index == kNoLeader) {
+    std::lock_guard<std::mutex> guard(outside_leader_mutex_);
+    outside_leader_ = end_point;
+    index = kOutsideLeader;
   }
+  leader_index_.store(index, std::memory_order_release);
+
+  DINGO_LOG(INFO) << "region:" << region_id_ << " replicas:" << ReplicasAsString();
+}
 
-  if (leader_addr_ == end_point) {
-    leader_addr_.ReSet();
+void Region::MarkFollower(const EndPoint& end_point) {
+  int32_t index = FindReplica(end_point);
+  if (index != kNoLeader) {
+    // only reset when it is still the leader, a concurrent MarkLeader of another replica wins
+    leader_index_.compare_exchange_strong(index, kNoLeader, std::memory_order_acq_rel);
+  } else if (leader_index_.load(std::memory_order_acquire) == kOutsideLeader) {
+    std::lock_guard<std::mutex> guard(outside_leader_mutex_);
+    if (outside_leader_ == end_point) {
+      int32_t expected = kOutsideLeader;
+      leader_index_.compare_exchange_strong(expected, kNoLeader, std::memory_order_acq_rel);
+    }
   }
 
   DINGO_LOG(INFO) << "region:" << region_id_ << " mark replica:" << end_point.ToString()
-                  << " follower, current replicas:" << ReplicasAsStringUnlocked();
+                  << " follower, current replicas:" << ReplicasAsString();
 }
 
-Status Region::GetLeader(EndPoint& leader) {
-  std::shared_lock<std::shared_mutex> r(rw_lock_);
+Status Region::GetLeader(EndPoint& leader) const {
+  int32_t leader_index = leader_index_.load(std::memory_order_acquire);
+  if (leader_index >= 0) {
+    leader = end_points_[leader_index];
+    return Status::OK();
+  }
 
-  if (leader_addr_.IsValid()) {
-    leader = leader_addr_;
+  if (leader_index == kOutsideLeader) {
+    std::lock_guard<std::mutex> guard(outside_leader_mutex_);
+    leader = outside_leader_;
     return Status::OK();
   }
 
   std::string msg = fmt::format("region:{} not found leader", region_id_);
-  DINGO_LOG(WARNING) << msg << " replicas:" << ReplicasAsStringUnlocked();
+  DINGO_LOG(WARNING) << msg << " replicas:" << ReplicasAsString();
   return Status::NotFound(msg);
 }
 
-std::string Region::ReplicasAsString() const {
-  std::shared_lock<std::shared_mutex> r(rw_lock_);
-  return ReplicasAsStringUnlocked();
+bool Region::IsLeader(const EndPoint& end_point) const {
+  int32_t leader_index = leader_index_.load(std::memory_order_acquire);
+  if (leader_index >= 0) {
+    return end_points_[leader_index] == end_point;
+  }
+
+  if (leader_index == kOutsideLeader) {
+    std::lock_guard<std::mutex> guard(outside_leader_mutex_);
+    return outside_leader_ == end_point;
+  }
+  return false;
 }
 
-std::string Region::ReplicasAsStringUnlocked() const {
+std::string Region::ReplicasAsString() const {
   std::string replicas_str;
-  for (const auto& r : replicas_) {
+  for (const auto& r : Replicas()) {
     if (!replicas_str.empty()) {
       replicas_str.append(", ");
     }
@@ -113,6 +136,11 @@ std::string Region::ReplicasAsStringUnlocked() const {
     std::string msg = fmt::format("({},{})", r.end_point.ToString(), RaftRoleName(r.role));
     replicas_str.append(msg);
   }
+
+  if (leader_index_.load(std::memory_order_acquire) == kOutsideLeader) {
+    std::lock_guard<std::mutex> guard(outside_leader_mutex_);
+    replicas_str.append(fmt::format(", leader:{}", outside_leader_.ToString()));
+  }
   return replicas_str;
 }
 
@@ -15,8 +15,10 @@
 #ifndef DINGODB_SDK_REGION_H_
 #define DINGODB_SDK_REGION_H_
 
+#include <atomic>
 #include <cstdint>
-#include <shared_mutex>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "fmt/core.h"
@@ -55,26 +57,29 @@ class Region {
 
   pb::common::RegionType RegionType() const { return region_type_; }
 
-  std::vector<Replica> Replicas();
+  // roles as of the call
+  std::vector<Replica> Replicas() const;
 
-  std::vector<EndPoint> ReplicaEndPoint();
+  // replicas never change during the life of a region, a new epoch comes with a new region
+  const std::vector<EndPoint>& ReplicaEndPoint() const { return end_points_; }
 
   void MarkLeader(const EndPoint& end_point);
 
   void MarkFollower(const EndPoint& end_point);
 
-  Status GetLeader(EndPoint& leader);
+  // one atomic load when the leader is one of the replicas
+  Status GetLeader(EndPoint& leader) const;
+
+  bool IsLeader(const EndPoint& end_point) const;
 
   bool IsStale() { return stale_.load(std::memory_order_relaxed); }
 
   std::string ReplicasAsString() const;
 
   std::string ToString() const {
-    std::shared_lock<std::shared_mutex> r(rw_lock_);
     // region_id, start_key-end_key, version, config_version, type, replicas
     return fmt::format("({}, [{}-{}], [{},{}], {}, {})", region_id_, range_.start_key(), range_.end_key(),
-                       epoch_.version(), epoch_.conf_version(), RegionType_Name(region_type_),
-                       ReplicasAsStringUnlocked());
+                       epoch_.version(), epoch_.conf_version(), RegionType_Name(region_type_), ReplicasAsString());
   }
 
   void TEST_MarkStale() {  // NOLINT
@@ -92,16 +97,25 @@ class Region {
 
   void UnMarkStale() { stale_.store(false, std::memory_order_relaxed); }
 
-  std::string ReplicasAsStringUnlocked() const;
+  // leader_index_ when the leader is not one of the replicas, e.g. a leader hint of a newer conf
+  static constexpr int32_t kOutsideLeader = -2;
+  static constexpr int32_t kNoLeader = -1;
+
+  static std::vector<EndPoint> ToEndPoints(const std::vector<Replica>& replicas);
+
+  int32_t FindReplica(const EndPoint& end_point) const;
 
   const int64_t region_id_;
   const pb::common::Range range_;
   const pb::common::RegionEpoch epoch_;
   const pb::common::RegionType region_type_;
+  const std::vector<EndPoint> end_points_;
 
-  mutable std::shared_mutex rw_lock_;
-  EndPoint leader_addr_;
-  std::vector<Replica> replicas_;
+  // index of the leader in end_points_, or kNoLeader, or kOutsideLeader
+  std::atomic<int32_t> leader_index_{kNoLeader};
+  // only for kOutsideLeader, which is rare
+  mutable std::mutex outside_leader_mutex_;
+  EndPoint outside_leader_;
 
   std::atomic<bool> stale_;
 };
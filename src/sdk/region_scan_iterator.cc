@@ -0,0 +1,260 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/region_scan_iterator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+RegionScanIterator::RegionScanIterator(const ClientStub& stub, std::string start_key, std::string end_key,
+                                       const ScanOptions& scan_options)
+    : stub_(stub), start_key_(std::move(start_key)), end_key_(std::move(end_key)), scan_options_(scan_options) {}
+
+RegionScanIterator::RegionScanIterator(const ClientStub& stub, std::string start_key, std::string end_key,
+                                       const TransactionOptions& txn_options, int64_t start_ts,
+                                       const ScanOptions& scan_options)
+    : stub_(stub),
+      start_key_(std::move(start_key)),
+      end_key_(std::move(end_key)),
+      txn_options_(txn_options),
+      start_ts_(start_ts),
+      scan_options_(scan_options) {}
+
+RegionScanIterator::~RegionScanIterator() {
+  // prefetch callback reference this
+  WaitPrefetch();
+}
+
+Status RegionScanIterator::Seek(const std::string& target) {
+  WaitPrefetch();
+
+  status_ = Status::OK();
+  current_kvs_.clear();
+  pos_ = 0;
+  scanner_.reset();
+  ahead_.reset();
+  next_start_key_ = std::max(target, start_key_);
+  if (next_start_key_ >= end_key_) {
+    return Status::OK();
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    prefetching_ = true;
+  }
+  StartPrefetch();
+
+  return LoadNextBatch();
+}
+
+Status RegionScanIterator::Next() {
+  CHECK(Valid()) << "iterator is invalid";
+  pos_++;
+  if (pos_ < current_kvs_.size()) {
+    return Status::OK();
+  }
+
+  return LoadNextBatch();
+}
+
+Status RegionScanIterator::LoadNextBatch() {
+  WaitPrefetch();
+
+  current_kvs_.clear();
+  pos_ = 0;
+  if (!prefetch_status_.ok()) {
+    status_ = prefetch_status_;
+    DINGO_LOG(WARNING) << fmt::format("iterator fetch batch fail between [{},{}), next_start:{}, status:{}",
+                                      start_key_, end_key_, next_start_key_, status_.ToString());
+    return status_;
+  }
+
+  current_kvs_.swap(prefetch_kvs_);
+  if (!prefetch_reach_end_) {
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      prefetching_ = true;
+    }
+    StartPrefetch();
+  }
+
+  return Status::OK();
+}
+
+void RegionScanIterator::StartPrefetch() {
+  prefetch_kvs_.clear();
+  if (scanner_ != nullptr && scanner_->HasMore()) {
+    // callback hold scanner, keep it alive until callback return
+    scanner_->AsyncNextBatch(prefetch_kvs_, [this, scanner = scanner_](auto&& s) {
+      PrefetchBatchCallback(std::forward<decltype(s)>(s));
+    });
+  } else {
+    OpenNextScanner();
+  }
+}
+
+void RegionScanIterator::OpenNextScanner() {
+  scanner_.reset();
+  if (ahead_ != nullptr) {
+    auto ahead = std::move(ahead_);
+    scanner_ = ahead->scanner;
+    next_start_key_ = ahead->next_start_key;
+
+    std::unique_lock<std::mutex> lk(ahead->mutex);
+    if (!ahead->opened) {
+      ahead->then = [this](Status s) { PrefetchOpenCallback(std::move(s)); };
+      return;
+    }
+    Status status = ahead->status;
+    lk.unlock();
+
+    PrefetchOpenCallback(std::move(status));
+    return;
+  }
+
+  if (next_start_key_ >= end_key_) {
+    FinishPrefetch(Status::OK(), true);
+    return;
+  }
+
+  std::shared_ptr<Region> region;
+  Status s = stub_.GetMetaCache()->LookupRegionBetweenRange(next_start_key_, end_key_, region);
+  if (s.IsNotFound()) {
+    DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), start_key:{} status:{}", next_start_key_,
+                                   end_key_, start_key_, s.ToString());
+    FinishPrefetch(Status::OK(), true);
+    return;
+  }
+
+  if (!s.ok()) {
+    FinishPrefetch(s, false);
+    return;
+  }
+
+  std::string scanner_start_key = std::max(next_start_key_, region->Range().start_key());
+  std::string scanner_end_key = std::min(end_key_, region->Range().end_key());
+  next_start_key_ = region->Range().end_key();
+
+  std::shared_ptr<RegionScanner> scanner;
+  CHECK(NewScanner(std::move(region), std::move(scanner_start_key), std::move(scanner_end_key), scanner).IsOK());
+  scanner_ = scanner;
+  scanner->AsyncOpen([this, scanner](auto&& s) { PrefetchOpenCallback(std::forward<decltype(s)>(s)); });
+}
+
+void RegionScanIterator::PrefetchOpenCallback(Status status) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner open fail, region:{}, status:{}",
+                                      scanner_->GetRegion()->RegionId(), status.ToString());
+    FinishPrefetch(status, false);
+    return;
+  }
+
+  OpenAheadScanner();
+  StartPrefetch();
+}
+
+void RegionScanIterator::OpenAheadScanner() {
+  if (!FLAGS_scan_prefetch_next_region || next_start_key_ >= end_key_) {
+    return;
+  }
+
+  std::shared_ptr<Region> region;
+  Status s = stub_.GetMetaCache()->LookupRegionBetweenRange(next_start_key_, end_key_, region);
+  if (!s.ok()) {
+    // opened on demand by OpenNextScanner, which handles the error
+    return;
+  }
+
+  auto ahead = std::make_shared<AheadScanner>();
+  std::string scanner_start_key = std::max(next_start_key_, region->Range().start_key());
+  std::string scanner_end_key = std::min(end_key_, region->Range().end_key());
+  ahead->next_start_key = region->Range().end_key();
+  CHECK(NewScanner(std::move(region), std::move(scanner_start_key), std::move(scanner_end_key), ahead->scanner).IsOK());
+  ahead_ = ahead;
+
+  // callback hold ahead only, it may outlive this iterator when not taken
+  ahead->scanner->AsyncOpen([ahead](auto&& s) {
+    std::function<void(Status)> then;
+    {
+      std::unique_lock<std::mutex> lk(ahead->mutex);
+      ahead->opened = true;
+      ahead->status = s;
+      then = std::move(ahead->then);
+    }
+    if (then) {
+      then(s);
+    }
+  });
+}
+
+void RegionScanIterator::PrefetchBatchCallback(Status status) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("region scanner NextBatch fail, region:{}, status:{}",
+                                      scanner_->GetRegion()->RegionId(), status.ToString());
+    FinishPrefetch(status, false);
+    return;
+  }
+
+  if (prefetch_kvs_.empty()) {
+    // current region is drained, go on with next region
+    CHECK(!scanner_->HasMore());
+    StartPrefetch();
+    return;
+  }
+
+  FinishPrefetch(Status::OK(), false);
+}
+
+void RegionScanIterator::FinishPrefetch(Status status, bool reach_end) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  prefetch_status_ = std::move(status);
+  prefetch_reach_end_ = reach_end;
+  prefetching_ = false;
+  cv_.notify_all();
+}
+
+void RegionScanIterator::WaitPrefetch() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  cv_.wait(lk, [this] { return !prefetching_; });
+}
+
+Status RegionScanIterator::NewScanner(std::shared_ptr<Region> region, std::string start_key, std::string end_key,
+                                      std::shared_ptr<RegionScanner>& scanner) {
+  if (txn_options_.has_value()) {
+    ScannerOptions options(stub_, std::move(region), std::move(start_key), std::move(end_key), txn_options_.value(),
+                           start_ts_.value());
+    options.prefetch = FLAGS_scan_prefetch;
+    options.key_only = scan_options_.key_only;
+    options.value_prefix_len = scan_options_.value_prefix_len;
+    return stub_.GetTxnRegionScannerFactory()->NewRegionScanner(options, scanner);
+  } else {
+    ScannerOptions options(stub_, std::move(region), std::move(start_key), std::move(end_key));
+    options.replica_read = scan_options_.replica_read;
+    options.prefetch = FLAGS_scan_prefetch;
+    options.key_only = scan_options_.key_only;
+    options.value_prefix_len = scan_options_.value_prefix_len;
+    return stub_.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
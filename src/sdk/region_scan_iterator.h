@@ -0,0 +1,122 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_REGION_SCAN_ITERATOR_H_
+#define DINGODB_SDK_REGION_SCAN_ITERATOR_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/region.h"
+#include "sdk/region_scanner.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// walk regions in [start_key, end_key) with region scanner, when current batch is handed to caller the next batch
+// is fetched asynchronously, so caller consume current batch while next batch is on the way. With
+// FLAGS_scan_prefetch_next_region the scanner of the next region is opened once the current one is open, so
+// crossing a region boundary does not wait for the open rpc
+class RegionScanIterator : public KvIterator {
+ public:
+  // raw kv scan
+  RegionScanIterator(const ClientStub& stub, std::string start_key, std::string end_key,
+                     const ScanOptions& scan_options = ScanOptions());
+
+  // txn scan, scan_options.replica_read is ignored
+  RegionScanIterator(const ClientStub& stub, std::string start_key, std::string end_key,
+                     const TransactionOptions& txn_options, int64_t start_ts,
+                     const ScanOptions& scan_options = ScanOptions());
+
+  ~RegionScanIterator() override;
+
+  Status Seek(const std::string& target) override;
+
+  bool Valid() const override { return status_.ok() && pos_ < current_kvs_.size(); }
+
+  Status Next() override;
+
+  const std::string& key() const override { return current_kvs_[pos_].key; }
+
+  const std::string& value() const override { return current_kvs_[pos_].value; }
+
+  Status status() const override { return status_; }
+
+ private:
+  // wait prefetch batch and make it current, then start to prefetch next batch
+  Status LoadNextBatch();
+
+  // prefetch chain, call FinishPrefetch exactly once
+  void StartPrefetch();
+  void OpenNextScanner();
+  void PrefetchOpenCallback(Status status);
+  void PrefetchBatchCallback(Status status);
+  void FinishPrefetch(Status status, bool reach_end);
+
+  // open scanner of the region from next_start_key_ ahead, taken by OpenNextScanner
+  void OpenAheadScanner();
+
+  void WaitPrefetch();
+
+  Status NewScanner(std::shared_ptr<Region> region, std::string start_key, std::string end_key,
+                    std::shared_ptr<RegionScanner>& scanner);
+
+  const ClientStub& stub_;
+  const std::string start_key_;
+  const std::string end_key_;
+  const std::optional<const TransactionOptions> txn_options_;
+  const std::optional<int64_t> start_ts_;
+  const ScanOptions scan_options_;
+
+  Status status_;
+  std::vector<KVPair> current_kvs_;
+  size_t pos_{0};
+
+  // only touched by prefetch chain when prefetching_ is true
+  std::shared_ptr<RegionScanner> scanner_;
+  std::string next_start_key_;
+  std::vector<KVPair> prefetch_kvs_;
+
+  struct AheadScanner {
+    std::shared_ptr<RegionScanner> scanner;
+    // next_start_key_ after the region of scanner
+    std::string next_start_key;
+
+    std::mutex mutex;
+    bool opened{false};
+    Status status;
+    // run by open callback when the prefetch chain takes the scanner before it is opened
+    std::function<void(Status)> then;
+  };
+  std::shared_ptr<AheadScanner> ahead_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool prefetching_{false};
+  bool prefetch_reach_end_{false};
+  Status prefetch_status_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_REGION_SCAN_ITERATOR_H_
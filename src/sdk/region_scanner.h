@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "sdk/client.h"
@@ -48,6 +49,20 @@ class RegionScanner {
 
   virtual void AsyncNextBatch(std::vector<KVPair>& kvs, StatusCallback cb) = 0;
 
+  // append the next batch to out instead of replacing a vector, this one copies a vector batch into out, scanners
+  // able to hand their rpc responses over to out override it
+  virtual void AsyncNextBatchInto(KvResultSet& out, StatusCallback cb) {
+    auto batch = std::make_shared<std::vector<KVPair>>();
+    AsyncNextBatch(*batch, [batch, &out, cb = std::move(cb)](Status status) {
+      if (status.ok()) {
+        for (const auto& kv : *batch) {
+          out.Append(kv.key, kv.value);
+        }
+      }
+      cb(status);
+    });
+  }
+
   virtual bool HasMore() const = 0;
 
   virtual Status SetBatchSize(int64_t size) = 0;
@@ -68,6 +83,14 @@ struct ScannerOptions {
   std::string end_key;
   std::optional<const TransactionOptions> txn_options;
   std::optional<int64_t> start_ts;
+  ReplicaReadPolicy replica_read{kLeaderOnly};
+  // fetch the next batch when a batch is returned, see ScanBatchPrefetcher
+  bool prefetch{false};
+  // see ScanOptions
+  bool key_only{false};
+  uint32_t value_prefix_len{0};
+  // scan from end_key to start_key, only supported by txn region scanner
+  bool reverse{false};
 
   explicit ScannerOptions(const ClientStub& p_stub, std::shared_ptr<Region> p_region, std::string p_start_key,
                           std::string p_end_key)
@@ -83,6 +106,28 @@ struct ScannerOptions {
         start_ts(p_start_ts) {}
 };
 
+// value of a scanned kv handed to caller, key_only gives empty value
+inline std::string ProjectScanValue(const std::string& value, bool key_only, uint32_t value_prefix_len) {
+  if (key_only) {
+    return "";
+  }
+  if (value_prefix_len == 0 || value.size() <= value_prefix_len) {
+    return value;
+  }
+  return value.substr(0, value_prefix_len);
+}
+
+// same as ProjectScanValue, but a view into value
+inline Slice ProjectScanValueView(const std::string& value, bool key_only, uint32_t value_prefix_len) {
+  if (key_only) {
+    return Slice();
+  }
+  if (value_prefix_len == 0 || value.size() <= value_prefix_len) {
+    return Slice(value);
+  }
+  return Slice(value.data(), value_prefix_len);
+}
+
 class RegionScannerFactory {
  public:
   RegionScannerFactory(const RegionScannerFactory&) = delete;
@@ -12,30 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef DINGODB_SDK_DOCUMENT_DOC_VALUE_INTERNAL_DATA_H_
-#define DINGODB_SDK_DOCUMENT_DOC_VALUE_INTERNAL_DATA_H_
-
-#include <optional>
-#include <utility>
-
-#include "sdk/document.h"
-#include "sdk/types.h"
+#include "sdk/request_priority.h"
 
 namespace dingodb {
 namespace sdk {
 
-class DocValue::Data {
- public:
-  Type type{Type::kTypeEnd};
+namespace {
+thread_local RequestPriority current_priority = kInteractive;
+}  // namespace
+
+RequestPriority CurrentRequestPriority() { return current_priority; }
 
-  union {
-    int64_t int_val;
-    double double_val;
-  };
-  std::string string_val;
-};
+ScopedRequestPriority::ScopedRequestPriority(RequestPriority priority) : prev_(current_priority) {
+  current_priority = priority;
+}
+
+ScopedRequestPriority::~ScopedRequestPriority() { current_priority = prev_; }
 
 }  // namespace sdk
 }  // namespace dingodb
-
-#endif  // DINGODB_SDK_DOCUMENT_DOC_VALUE_INTERNAL_DATA_H_
\ No newline at end of file
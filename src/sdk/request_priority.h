@@ -0,0 +1,58 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_REQUEST_PRIORITY_H_
+#define DINGODB_SDK_REQUEST_PRIORITY_H_
+
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+// Class of the work an operation causes in the sdk: actuator tasks, queued store rpcs of the client concurrency
+// limit and RawKV auto batches. Higher class work is always taken first, and batch or background tasks never
+// occupy more than FLAGS_actuator_thread_num - FLAGS_actuator_interactive_reserved_threads actuator threads.
+enum RequestPriority : uint8_t {
+  // latency sensitive, e.g. search and point read, the default
+  kInteractive = 0,
+  // bulk work a user waits for as a whole, e.g. import
+  kBatch = 1,
+  // work nobody waits for, e.g. backfill
+  kBackground = 2,
+};
+
+static constexpr int kRequestPriorityNum = 3;
+
+// priority of the operations started by current thread, see ScopedRequestPriority
+RequestPriority CurrentRequestPriority();
+
+// Operations started by current thread in the scope run at priority, including their retries and callbacks. e.g.
+//   ScopedRequestPriority scope(kBatch);
+//   vector_client->AddByIndexId(index_id, vectors);  // never starve interactive searches of the process
+class ScopedRequestPriority {
+ public:
+  explicit ScopedRequestPriority(RequestPriority priority);
+  ~ScopedRequestPriority();
+
+  ScopedRequestPriority(const ScopedRequestPriority&) = delete;
+  const ScopedRequestPriority& operator=(const ScopedRequestPriority&) = delete;
+
+ private:
+  RequestPriority prev_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_REQUEST_PRIORITY_H_
@@ -0,0 +1,217 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/route_table.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+static void EncodeVarint32(uint32_t value, std::string& dst) {
+  while (value >= 0x80) {
+    dst.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  dst.push_back(static_cast<char>(value));
+}
+
+static size_t DecodeVarint32(const std::string& src, size_t offset, uint32_t& value) {
+  value = 0;
+  for (uint32_t shift = 0;; shift += 7) {
+    auto byte = static_cast<uint8_t>(src[offset++]);
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return offset;
+    }
+  }
+}
+
+void RouteTable::Reserve(size_t count) {
+  entries_.reserve(count);
+  regions_.reserve(count);
+  block_offsets_.reserve((count + kBlockSize - 1) / kBlockSize);
+}
+
+void RouteTable::Add(std::string_view start_key, std::string_view end_key, std::shared_ptr<Region> region) {
+  if (!entries_.empty()) {
+    DCHECK_LE(pending_end_, start_key) << "ranges must be sorted and not overlapped";
+    if (pending_end_ != start_key) {
+      SetEnd(entries_.back(), pending_end_);
+    }
+  }
+
+  size_t shared = 0;
+  if (entries_.size() % kBlockSize == 0) {
+    CHECK_LE(keys_.size(), UINT32_MAX) << "route table keys too large";
+    block_offsets_.push_back(keys_.size());
+  } else {
+    size_t limit = std::min(last_key_.size(), start_key.size());
+    while (shared < limit && last_key_[shared] == start_key[shared]) {
+      shared++;
+    }
+  }
+
+  EncodeVarint32(shared, keys_);
+  EncodeVarint32(start_key.size() - shared, keys_);
+  keys_.append(start_key.data() + shared, start_key.size() - shared);
+
+  last_key_.assign(start_key.data(), start_key.size());
+  pending_end_.assign(end_key.data(), end_key.size());
+  entries_.push_back(Entry{});
+  regions_.push_back(std::move(region));
+}
+
+void RouteTable::Finish() {
+  if (!entries_.empty()) {
+    SetEnd(entries_.back(), pending_end_);
+  }
+
+  std::string().swap(last_key_);
+  std::string().swap(pending_end_);
+  keys_.shrink_to_fit();
+  end_keys_.shrink_to_fit();
+}
+
+void RouteTable::SetEnd(Entry& entry, std::string_view end_key) {
+  CHECK_LE(end_keys_.size() + end_key.size(), UINT32_MAX) << "route table end keys too large";
+  entry.end_offset = end_keys_.size();
+  entry.end_size = end_key.size();
+  end_keys_.append(end_key.data(), end_key.size());
+}
+
+size_t RouteTable::ReadKey(size_t offset, uint32_t& shared, std::string_view& non_shared) const {
+  uint32_t non_shared_size = 0;
+  offset = DecodeVarint32(keys_, offset, shared);
+  offset = DecodeVarint32(keys_, offset, non_shared_size);
+  non_shared = std::string_view(keys_.data() + offset, non_shared_size);
+  return offset + non_shared_size;
+}
+
+size_t RouteTable::DecodeKey(size_t offset, std::string& key) const {
+  uint32_t shared = 0;
+  std::string_view non_shared;
+  offset = ReadKey(offset, shared, non_shared);
+  key.resize(shared);
+  key.append(non_shared.data(), non_shared.size());
+  return offset;
+}
+
+std::string_view RouteTable::BlockHead(size_t block) const {
+  uint32_t shared = 0;
+  std::string_view head;
+  ReadKey(block_offsets_[block], shared, head);
+  DCHECK_EQ(shared, 0);
+  return head;
+}
+
+static size_t CommonPrefixSize(std::string_view a, std::string_view b) {
+  size_t limit = std::min(a.size(), b.size());
+  size_t i = 0;
+  while (i < limit && a[i] == b[i]) {
+    i++;
+  }
+  return i;
+}
+
+size_t RouteTable::Seek(std::string_view key) const {
+  // first block whose head is greater than key
+  size_t low = 0;
+  size_t high = block_offsets_.size();
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (key < BlockHead(mid)) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  if (low == 0) {
+    return kNotFound;
+  }
+
+  // keys in block are compared without decoding them, matched is the common prefix size of key and the start key
+  // at pos, which is less than or equal to key
+  size_t block = low - 1;
+  size_t pos = block * kBlockSize;
+  size_t block_end = std::min(pos + kBlockSize, entries_.size());
+  uint32_t shared = 0;
+  std::string_view non_shared;
+  size_t offset = ReadKey(block_offsets_[block], shared, non_shared);
+  size_t matched = CommonPrefixSize(non_shared, key);
+  while (pos + 1 < block_end) {
+    offset = ReadKey(offset, shared, non_shared);
+    if (shared < matched) {
+      // next key leaves previous key at shared with a greater byte, where previous key still equals key
+      break;
+    }
+    if (shared == matched) {
+      // next key is key[0, matched) + non_shared
+      std::string_view rest = key.substr(matched);
+      if (rest < non_shared) {
+        break;
+      }
+      matched += CommonPrefixSize(non_shared, rest);
+    }
+    // shared > matched: next key equals previous key at matched, where previous key is less than key
+    pos++;
+  }
+
+  return pos;
+}
+
+size_t RouteTable::Find(std::string_view key) const {
+  size_t pos = Seek(key);
+  if (pos == kNotFound) {
+    return kNotFound;
+  }
+
+  // start key of next range is greater than key, only a stored end key can be passed
+  const auto& entry = entries_[pos];
+  if (entry.end_offset != kEndIsNextStart && key >= EndKeyView(entry)) {
+    return kNotFound;
+  }
+  return pos;
+}
+
+std::string RouteTable::StartKey(size_t pos) const {
+  DCHECK_LT(pos, entries_.size());
+  size_t block = pos / kBlockSize;
+  std::string decoded;
+  size_t offset = block_offsets_[block];
+  for (size_t i = block * kBlockSize; i <= pos; i++) {
+    offset = DecodeKey(offset, decoded);
+  }
+  return decoded;
+}
+
+std::string RouteTable::EndKey(size_t pos) const {
+  DCHECK_LT(pos, entries_.size());
+  const auto& entry = entries_[pos];
+  if (entry.end_offset != kEndIsNextStart) {
+    return std::string(EndKeyView(entry));
+  }
+  return StartKey(pos + 1);
+}
+
+size_t RouteTable::MemoryUsage() const {
+  return keys_.capacity() + end_keys_.capacity() + block_offsets_.capacity() * sizeof(uint32_t) +
+         entries_.capacity() * sizeof(Entry) + regions_.capacity() * sizeof(std::shared_ptr<Region>);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,115 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_ROUTE_TABLE_H_
+#define DINGODB_SDK_ROUTE_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sdk/region.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Compact routing table of ranges sorted by start key and not overlapped, built once by Add in order then Finish,
+// read only afterwards.
+// Start keys are prefix compressed in blocks of kBlockSize keys kept in one buffer, the first key of each block is
+// stored whole, so a lookup binary searches the block heads and scans at most one block, comparing keys in their
+// compressed form. An end key equal to the start key of the next range, the usual case of a cluster, is not stored.
+// Regions are kept in an array parallel to the entries, so the entries scanned by a lookup hold only end key
+// positions. NOTE: each region still keeps its own copy of its range, so the per region memory is dominated by
+// the Region objects shared with the rest of MetaCache, not by this table.
+class RouteTable {
+ public:
+  static constexpr size_t kBlockSize = 16;
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  RouteTable(const RouteTable&) = delete;
+  const RouteTable& operator=(const RouteTable&) = delete;
+
+  RouteTable() = default;
+
+  ~RouteTable() = default;
+
+  void Reserve(size_t count);
+
+  // start_key must be greater than or equal to the end key of the range added before
+  void Add(std::string_view start_key, std::string_view end_key, std::shared_ptr<Region> region);
+
+  // NOTE: must be called once after the last Add
+  void Finish();
+
+  // position of the range holding key, kNotFound if none
+  size_t Find(std::string_view key) const;
+
+  // position of the last range whose start key is less than or equal to key, kNotFound if none
+  size_t Seek(std::string_view key) const;
+
+  const std::shared_ptr<Region>& RegionAt(size_t pos) const { return regions_[pos]; }
+
+  size_t Size() const { return entries_.size(); }
+
+  // bytes of keys, entries and region pointers, regions excluded
+  size_t MemoryUsage() const;
+
+  // decoded keys of range at pos, callers checking many sorted keys against one range keep the end key
+  std::string StartKey(size_t pos) const;
+
+  std::string EndKey(size_t pos) const;
+
+ private:
+  static constexpr uint32_t kEndIsNextStart = UINT32_MAX;
+
+  struct Entry {
+    // offset in end_keys_ of the end key, kEndIsNextStart if the end key is the start key of next range
+    uint32_t end_offset{kEndIsNextStart};
+    uint32_t end_size{0};
+  };
+
+  // read key at offset of keys_, return offset of the next key
+  size_t ReadKey(size_t offset, uint32_t& shared, std::string_view& non_shared) const;
+
+  // decode key at offset of keys_ into key, prefix of key is shared with the key before it in the block,
+  // return offset of the next key
+  size_t DecodeKey(size_t offset, std::string& key) const;
+
+  // whole key at head of block
+  std::string_view BlockHead(size_t block) const;
+
+  void SetEnd(Entry& entry, std::string_view end_key);
+
+  std::string_view EndKeyView(const Entry& entry) const {
+    return std::string_view(end_keys_.data() + entry.end_offset, entry.end_size);
+  }
+
+  // per key: varint32 shared size, varint32 non shared size, non shared bytes
+  std::string keys_;
+  std::vector<uint32_t> block_offsets_;
+  std::string end_keys_;
+  std::vector<Entry> entries_;
+  std::vector<std::shared_ptr<Region>> regions_;
+
+  // state of Add, released by Finish
+  std::string last_key_;
+  std::string pending_end_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_ROUTE_TABLE_H_
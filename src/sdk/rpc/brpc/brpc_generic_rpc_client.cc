@@ -0,0 +1,139 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/brpc/brpc_generic_rpc_client.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "brpc/callback.h"
+#include "brpc/controller.h"
+#include "butil/fast_rand.h"
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/concurrency_limiter.h"
+#include "sdk/rpc/local_transport.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+struct BrpcGenericCall {
+  Rpc* rpc;
+  RpcCallback cb;
+  brpc::Controller controller;
+};
+
+// same mapping as the typed brpc rpcs, brpc has no zstd
+brpc::CompressType ToCompressType(RpcCompressType type) {
+  switch (type) {
+    case kRpcCompressSnappy:
+      return brpc::COMPRESS_TYPE_SNAPPY;
+    case kRpcCompressZstd:
+      return brpc::COMPRESS_TYPE_ZLIB;
+    case kRpcCompressLz4:
+      return brpc::COMPRESS_TYPE_LZ4;
+    default:
+      return brpc::COMPRESS_TYPE_NONE;
+  }
+}
+
+void OnBrpcGenericCallDone(BrpcGenericCall* call) {
+  std::unique_ptr<BrpcGenericCall> guard(call);
+  Rpc* rpc = call->rpc;
+  if (call->controller.Failed()) {
+    DINGO_LOG(WARNING) << "Fail send rpc: " << rpc->Method() << ", log_id:" << call->controller.log_id()
+                       << " endpoint:" << rpc->GetEndPoint().ToString()
+                       << " error_code:" << call->controller.ErrorCode()
+                       << " error_text:" << call->controller.ErrorText();
+    rpc->SetStatus(Status::NetworkError(call->controller.ErrorCode(), call->controller.ErrorText()));
+  }
+
+  RpcCallback cb = std::move(call->cb);
+  guard.reset();
+  cb();
+}
+
+}  // namespace
+
+void BrpcGenericRpcClient::SendRpc(Rpc& rpc, RpcCallback cb) {
+  if (FLAGS_store_rpc_concurrency_limit) {
+    ConcurrencyLimiter::Global().SendRpc(rpc, std::move(cb),
+                                         [this](Rpc& rpc, RpcCallback cb) { DoSendRpc(rpc, std::move(cb)); });
+    return;
+  }
+
+  DoSendRpc(rpc, std::move(cb));
+}
+
+void BrpcGenericRpcClient::DoSendRpc(Rpc& rpc, RpcCallback cb) {
+  const auto& endpoint = rpc.GetEndPoint();
+  CHECK(endpoint.IsValid()) << "rpc endpoint not valid: " << endpoint.ToString();
+
+  const google::protobuf::MethodDescriptor* method = FindProtoMethod(rpc);
+  if (method == nullptr) {
+    rpc.SetStatus(Status::NotSupported(fmt::format("rpc {} has no proto method", rpc.Method())));
+    cb();
+    return;
+  }
+  SetCompressType(rpc);
+
+  auto* call = new BrpcGenericCall();
+  call->rpc = &rpc;
+  call->cb = std::move(cb);
+  brpc::Controller& controller = call->controller;
+  controller.set_log_id(rpc.GetTraceContext().IsValid() ? rpc.GetTraceContext().trace_id_low : butil::fast_rand());
+  controller.set_timeout_ms(rpc.GetTimeoutMs() > 0 ? rpc.GetTimeoutMs() : FLAGS_rpc_time_out_ms);
+  controller.set_max_retry(FLAGS_rpc_max_retry);
+  if (rpc.GetCompressType() != kRpcCompressNone) {
+    controller.set_request_compress_type(ToCompressType(rpc.GetCompressType()));
+  }
+
+  GetChannel(endpoint)->CallMethod(method, &controller, rpc.RawRequest(), rpc.RawMutableResponse(),
+                                   brpc::NewCallback(OnBrpcGenericCallDone, call));
+}
+
+std::shared_ptr<brpc::Channel> BrpcGenericRpcClient::GetChannel(const EndPoint& endpoint) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = channel_map_.find(endpoint);
+    if (iter != channel_map_.end()) {
+      return iter->second;
+    }
+  }
+
+  brpc::ChannelOptions options;
+  options.timeout_ms = m_options.timeout_ms;
+  options.connect_timeout_ms = m_options.connect_timeout_ms;
+  options.max_retry = m_options.max_retry;
+
+  std::string local_addr = LocalTransportAddress(endpoint);
+  auto channel = std::make_shared<brpc::Channel>();
+  int ret = local_addr.empty() ? channel->Init(endpoint.Host().c_str(), endpoint.Port(), &options)
+                               : channel->Init(local_addr.c_str(), &options);
+  CHECK_EQ(ret, 0) << "Fail init channel endpoint:" << endpoint.ToString();
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  // another thread maybe create channel for same endpoint, then use that one
+  return channel_map_.emplace(endpoint, std::move(channel)).first->second;
+}
+
+RpcClient* NewBrpcGenericRpcClient(const RpcClientOptions& options) { return new BrpcGenericRpcClient(options); }
+
+}  // namespace sdk
+}  // namespace dingodb
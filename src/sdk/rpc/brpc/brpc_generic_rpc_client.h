@@ -0,0 +1,54 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_BRPC_GENERIC_RPC_CLIENT_H_
+#define DINGODB_SDK_BRPC_GENERIC_RPC_CLIENT_H_
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+
+#include "brpc/channel.h"
+#include "sdk/rpc/rpc_client.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Sends any rpc by brpc with the descriptor of its proto method, so it does not depend on the typed rpcs of the
+// backend sdk is built with. Used to run a grpc build on brpc, see NewRpcClient(options, backend).
+class BrpcGenericRpcClient : public RpcClient {
+ public:
+  BrpcGenericRpcClient(const RpcClientOptions &options) : RpcClient(options) {}
+
+  ~BrpcGenericRpcClient() override = default;
+
+  void SendRpc(Rpc &rpc, RpcCallback cb) override;
+
+  void Connect(const EndPoint &endpoint) override { GetChannel(endpoint); }
+
+ private:
+  void DoSendRpc(Rpc &rpc, RpcCallback cb);
+
+  std::shared_ptr<brpc::Channel> GetChannel(const EndPoint &endpoint);
+
+  std::shared_mutex rw_lock_;
+  std::map<EndPoint, std::shared_ptr<brpc::Channel>> channel_map_;
+};
+
+RpcClient *NewBrpcGenericRpcClient(const RpcClientOptions &options);
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_BRPC_GENERIC_RPC_CLIENT_H_
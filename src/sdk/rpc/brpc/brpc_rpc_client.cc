@@ -14,45 +14,101 @@
 
 #include "sdk/rpc/brpc/brpc_rpc_client.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <utility>
 
+#include "common/logging.h"
+#include "fmt/core.h"
 #include "glog/logging.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rpc/brpc/unary_rpc.h"
+#include "sdk/rpc/concurrency_limiter.h"
+#include "sdk/rpc/local_transport.h"
 #include "sdk/rpc/rpc_client.h"
 
 namespace dingodb {
 namespace sdk {
 
 void BrpcRpcClient::SendRpc(Rpc &rpc, RpcCallback cb) {
+  if (FLAGS_store_rpc_concurrency_limit) {
+    ConcurrencyLimiter::Global().SendRpc(rpc, std::move(cb),
+                                         [this](Rpc &rpc, RpcCallback cb) { DoSendRpc(rpc, std::move(cb)); });
+    return;
+  }
+
+  DoSendRpc(rpc, std::move(cb));
+}
+
+void BrpcRpcClient::DoSendRpc(Rpc &rpc, RpcCallback cb) {
   auto endpoint = rpc.GetEndPoint();
   CHECK(endpoint.IsValid()) << "rpc endpoint not valid: " << endpoint.ToString();
+  SetCompressType(rpc);
 
-  std::shared_ptr<brpc::Channel> channel = std::make_shared<brpc::Channel>();
-  {
-    std::lock_guard<std::mutex> guard(lock_);
-    auto ch = channel_map_.find(endpoint);
-    if (ch == channel_map_.end()) {
-      brpc::ChannelOptions options;
-      options.timeout_ms = m_options.timeout_ms;
-      options.connect_timeout_ms = m_options.connect_timeout_ms;
-      options.max_retry = m_options.max_retry;
-
-      int ret = channel->Init(endpoint.Host().c_str(), endpoint.Port(), &options);
-
-      CHECK_EQ(ret, 0) << "Fail init channel endpoint:" << endpoint.ToString();
-      channel_map_.insert(std::make_pair(endpoint, channel));
-    } else {
-      channel = CHECK_NOTNULL(ch->second);
-    }
-  }
+  std::shared_ptr<brpc::Channel> channel = GetChannel(endpoint);
 
   CHECK_NOTNULL(channel.get());
   auto ctx = std::make_unique<BrpcContext>();
   ctx->cb = std::move(cb);
-  ctx->channel = channel;
+  ctx->channel = std::move(channel);
   rpc.Call(ctx.release());
 }
 
+std::shared_ptr<brpc::Channel> BrpcRpcClient::GetChannel(const EndPoint &endpoint) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = channel_map_.find(endpoint);
+    if (iter != channel_map_.end()) {
+      return iter->second->Pick();
+    }
+  }
+
+  auto channels = NewEndPointChannels(endpoint);
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  // another thread maybe create channels for same endpoint, then use that one
+  auto iter = channel_map_.emplace(endpoint, std::move(channels)).first;
+  return iter->second->Pick();
+}
+
+std::unique_ptr<BrpcRpcClient::EndPointChannels> BrpcRpcClient::NewEndPointChannels(const EndPoint &endpoint) const {
+  brpc::ChannelOptions options;
+  options.timeout_ms = m_options.timeout_ms;
+  options.connect_timeout_ms = m_options.connect_timeout_ms;
+  options.max_retry = m_options.max_retry;
+
+  // a store on this host is reached by its unix socket, else by rdma when enabled
+  std::string local_addr = LocalTransportAddress(endpoint);
+  if (local_addr.empty()) {
+    options.use_rdma = FLAGS_brpc_use_rdma;
+  } else {
+    DINGO_LOG(INFO) << "endpoint:" << endpoint.ToString() << " is local, use " << local_addr;
+  }
+
+  const std::string &connection_type = FLAGS_brpc_connection_type;
+  if (connection_type == "single" || connection_type == "pooled" || connection_type == "short") {
+    options.connection_type = connection_type;
+  } else {
+    DINGO_LOG(WARNING) << "unknown brpc_connection_type:" << connection_type << ", use brpc default";
+  }
+
+  int64_t channel_num = std::max<int64_t>(FLAGS_brpc_channels_per_endpoint, 1);
+  auto channels = std::make_unique<EndPointChannels>();
+  channels->channels.reserve(channel_num);
+  for (int64_t i = 0; i < channel_num; i++) {
+    // channels in different connection group not share single connection
+    options.connection_group = fmt::format("channel-{}", i);
+    auto channel = std::make_shared<brpc::Channel>();
+    int ret = local_addr.empty() ? channel->Init(endpoint.Host().c_str(), endpoint.Port(), &options)
+                                 : channel->Init(local_addr.c_str(), &options);
+    CHECK_EQ(ret, 0) << "Fail init channel endpoint:" << endpoint.ToString();
+    channels->channels.push_back(std::move(channel));
+  }
+
+  return channels;
+}
+
 RpcClient *NewRpcClient(const RpcClientOptions &options) {
   auto *client = new BrpcRpcClient(options);
   return client;
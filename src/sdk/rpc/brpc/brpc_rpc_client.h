@@ -15,8 +15,12 @@
 #ifndef DINGODB_SDK_BRPC_RPC_CLIENT_H_
 #define DINGODB_SDK_BRPC_RPC_CLIENT_H_
 
+#include <atomic>
+#include <cstdint>
 #include <map>
-#include <mutex>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
 
 #include "brpc/channel.h"
 #include "sdk/rpc/rpc_client.h"
@@ -32,9 +36,30 @@ class BrpcRpcClient : public RpcClient {
 
   void SendRpc(Rpc &rpc, RpcCallback cb) override;
 
+  // brpc connects on the first rpc of channel, so only channels are created here
+  void Connect(const EndPoint &endpoint) override { GetChannel(endpoint); }
+
  private:
-  std::mutex lock_;
-  std::map<EndPoint, std::shared_ptr<brpc::Channel>> channel_map_;
+  // send directly, SendRpc goes through ConcurrencyLimiter when FLAGS_store_rpc_concurrency_limit is true
+  void DoSendRpc(Rpc &rpc, RpcCallback cb);
+
+  // FLAGS_brpc_channels_per_endpoint channels to one endpoint, picked round robin
+  struct EndPointChannels {
+    std::vector<std::shared_ptr<brpc::Channel>> channels;
+    std::atomic<uint64_t> next{0};
+
+    std::shared_ptr<brpc::Channel> Pick() {
+      return channels[next.fetch_add(1, std::memory_order_relaxed) % channels.size()];
+    }
+  };
+
+  std::shared_ptr<brpc::Channel> GetChannel(const EndPoint &endpoint);
+
+  std::unique_ptr<EndPointChannels> NewEndPointChannels(const EndPoint &endpoint) const;
+
+  // read mostly, channels are created only when first send to an endpoint
+  std::shared_mutex rw_lock_;
+  std::map<EndPoint, std::unique_ptr<EndPointChannels>> channel_map_;
 };
 
 }  // namespace sdk
@@ -30,6 +30,8 @@ DEFINE_COORDINATOR_RPC(QueryRegion);
 DEFINE_COORDINATOR_RPC(CreateRegion);
 DEFINE_COORDINATOR_RPC(DropRegion);
 DEFINE_COORDINATOR_RPC(ScanRegions);
+DEFINE_COORDINATOR_RPC(GetCoordinatorMap);
+DEFINE_COORDINATOR_RPC(TransferLeaderRegion);
 
 DEFINE_META_RPC(GenerateAutoIncrement);
 DEFINE_META_RPC(CreateIndex);
@@ -34,6 +34,8 @@ DECLARE_COORDINATOR_RPC(QueryRegion);
 DECLARE_COORDINATOR_RPC(CreateRegion);
 DECLARE_COORDINATOR_RPC(DropRegion);
 DECLARE_COORDINATOR_RPC(ScanRegions);
+DECLARE_COORDINATOR_RPC(GetCoordinatorMap);
+DECLARE_COORDINATOR_RPC(TransferLeaderRegion);
 
 DECLARE_META_RPC(GenerateAutoIncrement);
 DECLARE_META_RPC(CreateIndex);
@@ -51,6 +53,7 @@ class TsoServiceRpc final
   explicit TsoServiceRpc(const std ::string& cmd);
   ~TsoServiceRpc() override;
   std ::string Method() const override { return ConstMethod(); }
+  std::string ProtoMethod() const override { return "TsoService"; }
   void Send(pb::meta::MetaService_Stub& stub, google::protobuf::Closure* done) override;
   static std ::string ConstMethod();
 };
@@ -18,15 +18,18 @@
 #include <sys/stat.h>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "brpc/callback.h"
 #include "brpc/channel.h"
 #include "brpc/controller.h"
+#include "brpc/options.pb.h"
 #include "butil/fast_rand.h"
 #include "common/logging.h"
 #include "fmt/core.h"
 #include "glog/logging.h"
+#include "google/protobuf/arena.h"
 #include "google/protobuf/message.h"
 #include "sdk/common/param_config.h"
 #include "sdk/rpc/rpc.h"
@@ -36,6 +39,20 @@
 namespace dingodb {
 namespace sdk {
 
+// brpc has no zstd, zlib is the nearest ratio
+static brpc::CompressType ToBrpcCompressType(RpcCompressType type) {
+  switch (type) {
+    case kRpcCompressSnappy:
+      return brpc::COMPRESS_TYPE_SNAPPY;
+    case kRpcCompressZstd:
+      return brpc::COMPRESS_TYPE_ZLIB;
+    case kRpcCompressLz4:
+      return brpc::COMPRESS_TYPE_LZ4;
+    default:
+      return brpc::COMPRESS_TYPE_NONE;
+  }
+}
+
 struct BrpcContext : public RpcContext {
   BrpcContext() = default;
   ~BrpcContext() override = default;
@@ -46,15 +63,18 @@ struct BrpcContext : public RpcContext {
 template <class RequestType, class ResponseType, class ServiceType, class StubType>
 class UnaryRpc : public Rpc {
  public:
-  UnaryRpc(const std::string& cmd) : Rpc(cmd) {
-    request = new RequestType;
-    response = new ResponseType;
+  // when arena is not null, request and response are allocated on arena and freed with it, arena must outlive rpc
+  UnaryRpc(const std::string& cmd, google::protobuf::Arena* arena = nullptr) : Rpc(cmd), arena_(arena) {
+    request = google::protobuf::Arena::CreateMessage<RequestType>(arena);
+    response = google::protobuf::Arena::CreateMessage<ResponseType>(arena);
     brpc_ctx = nullptr;
   }
 
   ~UnaryRpc() override {
-    delete request;
-    delete response;
+    if (arena_ == nullptr) {
+      delete request;
+      delete response;
+    }
     delete brpc_ctx;
   }
 
@@ -109,6 +129,13 @@ class UnaryRpc : public Rpc {
     controller.set_timeout_ms(FLAGS_rpc_time_out_ms);
     controller.set_max_retry(FLAGS_rpc_max_retry);
     status = Status::OK();
+    timeout_ms = 0;
+  }
+
+  void Recycle() override {
+    Rpc::Recycle();
+    delete brpc_ctx;
+    brpc_ctx = nullptr;
   }
 
   // virtual void Call(RpcContext* ctx) = 0;
@@ -117,6 +144,16 @@ class UnaryRpc : public Rpc {
     brpc_ctx = dynamic_cast<BrpcContext*>(ctx);
     CHECK_NOTNULL(brpc_ctx);
     CHECK_NOTNULL(brpc_ctx->channel);
+    if (timeout_ms > 0) {
+      controller.set_timeout_ms(timeout_ms);
+    }
+    if (trace_context.IsValid()) {
+      // all rpcs of one trace share the log id, so the trace can be found in store logs
+      controller.set_log_id(trace_context.trace_id_low);
+    }
+    if (compress_type != kRpcCompressNone) {
+      controller.set_request_compress_type(ToBrpcCompressType(compress_type));
+    }
     StubType stub(brpc_ctx->channel.get());
     Send(stub, brpc::NewCallback(this, &UnaryRpc::OnRpcDone));
   }
@@ -124,6 +161,7 @@ class UnaryRpc : public Rpc {
   virtual void Send(StubType& stub, google::protobuf::Closure* done) = 0;
 
  protected:
+  google::protobuf::Arena* arena_;
   RequestType* request;
   ResponseType* response;
   brpc::Controller controller;
@@ -138,8 +176,11 @@ class UnaryRpc : public Rpc {
     METHOD##Rpc& operator=(const METHOD##Rpc&) = delete;                                              \
     explicit METHOD##Rpc();                                                                           \
     explicit METHOD##Rpc(const std::string& cmd);                                                     \
+    explicit METHOD##Rpc(google::protobuf::Arena* arena);                                             \
     ~METHOD##Rpc() override;                                                                          \
     std::string Method() const override { return ConstMethod(); }                                     \
+    std::string ProtoMethod() const override { return #METHOD; }                                      \
+    std::unique_ptr<Rpc> Clone() const override;                                                      \
     void Send(NS::SERVICE##_Stub& stub, google::protobuf::Closure* done) override;                    \
     static std::string ConstMethod();                                                                 \
   };
@@ -147,10 +188,16 @@ class UnaryRpc : public Rpc {
 #define DEFINE_UNAEY_RPC(NS, SERVICE, METHOD)                                         \
   METHOD##Rpc::METHOD##Rpc() : METHOD##Rpc("") {}                                     \
   METHOD##Rpc::METHOD##Rpc(const std::string& cmd) : UnaryRpc(cmd) {}                 \
+  METHOD##Rpc::METHOD##Rpc(google::protobuf::Arena* arena) : UnaryRpc("", arena) {}   \
   METHOD##Rpc::~METHOD##Rpc() = default;                                              \
   void METHOD##Rpc::Send(NS::SERVICE##_Stub& stub, google::protobuf::Closure* done) { \
     stub.METHOD(MutableController(), request, response, done);                        \
   }                                                                                   \
+  std::unique_ptr<Rpc> METHOD##Rpc::Clone() const {                                   \
+    auto rpc = std::make_unique<METHOD##Rpc>(cmd);                                    \
+    rpc->request->CopyFrom(*request);                                                 \
+    return rpc;                                                                       \
+  }                                                                                   \
   std::string METHOD##Rpc::ConstMethod() { return fmt::format("{}.{}Rpc", NS::SERVICE::descriptor()->name(), #METHOD); }
 
 }  // namespace sdk
@@ -0,0 +1,185 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/concurrency_limiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "proto/error.pb.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+EndPointConcurrencyLimit::EndPointConcurrencyLimit()
+    : limit_(std::clamp(FLAGS_store_rpc_concurrency_initial_limit, FLAGS_store_rpc_concurrency_min_limit,
+                        std::max(FLAGS_store_rpc_concurrency_min_limit, FLAGS_store_rpc_concurrency_max_limit))) {}
+
+EndPointConcurrencyLimit::AdmitResult EndPointConcurrencyLimit::Admit(std::function<void()>& send,
+                                                                      RequestPriority priority) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  int64_t limit = static_cast<int64_t>(limit_);
+  if (priority != kInteractive) {
+    limit = std::max<int64_t>(limit - limit * FLAGS_store_rpc_concurrency_interactive_reserve_percent / 100, 1);
+  }
+  // nothing jumps over queued rpcs of its own or higher priority
+  bool queue_ahead = false;
+  for (int i = kInteractive; i <= priority; i++) {
+    queue_ahead = queue_ahead || !queues_[i].empty();
+  }
+  if (in_flight_ < limit && !queue_ahead) {
+    in_flight_++;
+    return kAdmitted;
+  }
+
+  if (queued_ < FLAGS_store_rpc_concurrency_queue_size) {
+    queues_[priority].push_back(std::move(send));
+    queued_++;
+    return kQueued;
+  }
+
+  rejected_++;
+  return kRejected;
+}
+
+std::function<void()> EndPointConcurrencyLimit::Release(bool overloaded) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (overloaded) {
+    limit_ =
+        std::max<double>(limit_ * FLAGS_store_rpc_concurrency_backoff_ratio, FLAGS_store_rpc_concurrency_min_limit);
+  } else if (in_flight_ * 2 >= static_cast<int64_t>(limit_)) {
+    limit_ = std::min<double>(limit_ + 1, FLAGS_store_rpc_concurrency_max_limit);
+  }
+
+  // the slot is handed over to the oldest queued rpc of the highest priority when still under the limit
+  if (queued_ > 0 && in_flight_ <= static_cast<int64_t>(limit_)) {
+    for (auto& queue : queues_) {
+      if (!queue.empty()) {
+        std::function<void()> next = std::move(queue.front());
+        queue.pop_front();
+        queued_--;
+        return next;
+      }
+    }
+  }
+
+  in_flight_--;
+  return nullptr;
+}
+
+EndPointConcurrencyLimit::Snapshot EndPointConcurrencyLimit::GetSnapshot() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return {static_cast<int64_t>(limit_), in_flight_, queued_, rejected_};
+}
+
+ConcurrencyLimiter& ConcurrencyLimiter::Global() {
+  static ConcurrencyLimiter* limiter = new ConcurrencyLimiter();
+  return *limiter;
+}
+
+std::shared_ptr<EndPointConcurrencyLimit> ConcurrencyLimiter::GetLimit(const EndPoint& end_point) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = limits_.find(end_point);
+    if (iter != limits_.end()) {
+      return iter->second;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  auto iter = limits_.find(end_point);
+  if (iter == limits_.end()) {
+    iter = limits_.emplace(end_point, std::make_shared<EndPointConcurrencyLimit>()).first;
+  }
+  return iter->second;
+}
+
+std::map<EndPoint, EndPointConcurrencyLimit::Snapshot> ConcurrencyLimiter::GetSnapshots() {
+  std::map<EndPoint, std::shared_ptr<EndPointConcurrencyLimit>> limits;
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    limits = limits_;
+  }
+
+  std::map<EndPoint, EndPointConcurrencyLimit::Snapshot> snapshots;
+  for (const auto& [end_point, limit] : limits) {
+    snapshots.emplace(end_point, limit->GetSnapshot());
+  }
+  return snapshots;
+}
+
+bool ConcurrencyLimiter::IsOverloaded(Rpc& rpc, int64_t latency_us) {
+  if (!rpc.GetStatus().ok()) {
+    return true;
+  }
+  if (GetRpcResponseError(rpc).errcode() == pb::error::Errno::EREQUEST_FULL) {
+    return true;
+  }
+  return FLAGS_store_rpc_concurrency_slow_ms > 0 && latency_us > FLAGS_store_rpc_concurrency_slow_ms * 1000;
+}
+
+void ConcurrencyLimiter::SendRpc(Rpc& rpc, RpcCallback cb, const SendFunc& send_func) {
+  std::shared_ptr<EndPointConcurrencyLimit> limit = GetLimit(rpc.GetEndPoint());
+
+  // NOTE: rpc maybe freed by cb, never touch it after cb
+  std::function<void()> send = [limit, &rpc, cb, send_func]() {
+    int64_t send_time_us = NowUs();
+    send_func(rpc, [limit, &rpc, cb, send_time_us] {
+      std::function<void()> next = limit->Release(IsOverloaded(rpc, NowUs() - send_time_us));
+      if (next) {
+        next();
+      }
+      cb();
+    });
+  };
+
+  switch (limit->Admit(send, rpc.GetPriority())) {
+    case EndPointConcurrencyLimit::kAdmitted:
+      send();
+      break;
+    case EndPointConcurrencyLimit::kQueued:
+      break;
+    case EndPointConcurrencyLimit::kRejected: {
+      std::string msg = fmt::format("client concurrency limit of endpoint:{} reached, rpc:{}",
+                                    rpc.GetEndPoint().ToString(), rpc.Method());
+      DINGO_LOG(DEBUG) << msg;
+      rpc.SetStatus(Status::RemoteError(pb::error::Errno::EREQUEST_FULL, msg));
+      send = nullptr;
+      cb();
+      break;
+    }
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,104 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_CONCURRENCY_LIMITER_H_
+#define DINGODB_SDK_CONCURRENCY_LIMITER_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+#include "sdk/request_priority.h"
+#include "sdk/rpc/rpc.h"
+#include "sdk/utils/callback.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+// AIMD limit of in flight rpcs to one endpoint. The limit grows by 1 when an rpc succeeds while at least half of the
+// limit is in use, and is multiplied by FLAGS_store_rpc_concurrency_backoff_ratio when the endpoint is overloaded, so
+// a slow store gets less rpcs instead of a longer queue.
+// Queued rpcs are sent in priority order, and batch or background rpcs are only admitted directly while
+// FLAGS_store_rpc_concurrency_interactive_reserve_percent of the limit is left for interactive rpcs.
+class EndPointConcurrencyLimit {
+ public:
+  enum AdmitResult : uint8_t { kAdmitted, kQueued, kRejected };
+
+  struct Snapshot {
+    int64_t limit;
+    int64_t in_flight;
+    int64_t queued;
+    int64_t rejected;
+  };
+
+  EndPointConcurrencyLimit();
+
+  // kAdmitted takes a slot and the caller sends, kQueued keeps send to run when a slot is free
+  AdmitResult Admit(std::function<void()>& send, RequestPriority priority = kInteractive);
+
+  // release a slot when an admitted rpc is done, return the queued send taking the slot, or nullptr
+  std::function<void()> Release(bool overloaded);
+
+  Snapshot GetSnapshot();
+
+ private:
+  std::mutex mutex_;
+  double limit_;
+  int64_t in_flight_{0};
+  int64_t rejected_{0};
+  // indexed by priority
+  std::deque<std::function<void()>> queues_[kRequestPriorityNum];
+  int64_t queued_{0};
+};
+
+// Process wide limits of store endpoints, shared by all clients, used by RpcClient::SendRpc when
+// FLAGS_store_rpc_concurrency_limit is true. An rpc over the limit waits in the queue of its endpoint; when the queue
+// is full it fails fast with Status::RemoteError(EREQUEST_FULL), which store rpc controller retries after a backoff
+// like a busy store.
+class ConcurrencyLimiter {
+ public:
+  using SendFunc = std::function<void(Rpc& rpc, RpcCallback cb)>;
+
+  ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+  const ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+  static ConcurrencyLimiter& Global();
+
+  // send rpc by send_func within the limit of its endpoint
+  void SendRpc(Rpc& rpc, RpcCallback cb, const SendFunc& send_func);
+
+  std::shared_ptr<EndPointConcurrencyLimit> GetLimit(const EndPoint& end_point);
+
+  std::map<EndPoint, EndPointConcurrencyLimit::Snapshot> GetSnapshots();
+
+  // true when the rpc shows its endpoint is overloaded: failed, EREQUEST_FULL or slow
+  static bool IsOverloaded(Rpc& rpc, int64_t latency_us);
+
+ private:
+  ConcurrencyLimiter() = default;
+
+  std::shared_mutex rw_lock_;
+  std::map<EndPoint, std::shared_ptr<EndPointConcurrencyLimit>> limits_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_CONCURRENCY_LIMITER_H_
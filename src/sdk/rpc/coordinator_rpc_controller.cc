@@ -14,11 +14,17 @@
 
 #include "sdk/rpc/coordinator_rpc_controller.h"
 
+#include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "sdk/client_stub.h"
 #include "sdk/common/common.h"
+#include "sdk/common/metrics.h"
 #include "sdk/common/param_config.h"
+#include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/status.h"
 #include "sdk/utils/async_util.h"
 #include "sdk/utils/net_util.h"
@@ -46,11 +52,65 @@ Status CoordinatorRpcController::SyncCall(Rpc& rpc) {
   return ret;
 }
 
+// route lookups are read only and often issued by many threads for the same key at once, e.g. on region split
+static bool CanCoalesce(const Rpc& rpc) {
+  if (!FLAGS_coordinator_rpc_coalesce) {
+    return false;
+  }
+  std::string method = rpc.Method();
+  return method == ScanRegionsRpc::ConstMethod() || method == GetIndexRpc::ConstMethod() ||
+         method == GetIndexByNameRpc::ConstMethod();
+}
+
 void CoordinatorRpcController::AsyncCall(Rpc& rpc, StatusCallback cb) {
   rpc.call_back = std::move(cb);
+
+  if (CanCoalesce(rpc)) {
+    std::string key = rpc.Method() + "/" + rpc.RawRequest()->SerializeAsString();
+    if (JoinInflightRpc(rpc, key)) {
+      return;
+    }
+
+    rpc.call_back = [this, &rpc, key = std::move(key), user_cb = std::move(rpc.call_back)](Status s) {
+      // user_cb may free rpc, finish joined rpcs first
+      FinishInflightRpc(rpc, key, s);
+      user_cb(s);
+    };
+  }
+
   DoAsyncCall(rpc);
 }
 
+bool CoordinatorRpcController::JoinInflightRpc(Rpc& rpc, const std::string& key) {
+  std::lock_guard<std::mutex> guard(inflight_mutex_);
+  auto [iter, inserted] = inflight_rpcs_.try_emplace(key);
+  if (inserted) {
+    return false;
+  }
+
+  iter->second.push_back(&rpc);
+  return true;
+}
+
+void CoordinatorRpcController::FinishInflightRpc(Rpc& rpc, const std::string& key, const Status& status) {
+  std::vector<Rpc*> waiters;
+  {
+    std::lock_guard<std::mutex> guard(inflight_mutex_);
+    auto iter = inflight_rpcs_.find(key);
+    CHECK(iter != inflight_rpcs_.end());
+    waiters.swap(iter->second);
+    inflight_rpcs_.erase(iter);
+  }
+
+  for (Rpc* waiter : waiters) {
+    if (status.ok()) {
+      waiter->RawMutableResponse()->CopyFrom(*rpc.RawResponse());
+    }
+    waiter->SetStatus(status);
+    FireCallback(*waiter);
+  }
+}
+
 void CoordinatorRpcController::DoAsyncCall(Rpc& rpc) {
   PrepareRpc(rpc);
   SendCoordinatorRpc(rpc);
@@ -61,6 +121,10 @@ static bool NeedPickLeader(Rpc& rpc) { return !rpc.GetStatus().IsRemoteError();
 void CoordinatorRpcController::PrepareRpc(Rpc& rpc) {
   if (NeedPickLeader(rpc)) {
     EndPoint next_leader = meta_member_info_.PickNextLeader();
+    // the leader is sticky until it fails, then fail over to another member at once instead of the failed one
+    if (!rpc.GetStatus().ok() && next_leader == rpc.GetEndPoint()) {
+      next_leader = meta_member_info_.PickNextLeader();
+    }
 
     CHECK(next_leader.IsValid());
     rpc.SetEndPoint(next_leader);
@@ -74,11 +138,28 @@ static bool NeedDelay(Rpc& rpc) { return rpc.GetStatus().IsRemoteError(); }
 void CoordinatorRpcController::SendCoordinatorRpc(Rpc& rpc) {
   // TODO: what error should be delay
   if (NeedDelay(rpc)) {
-    DINGO_LOG(INFO) << "try to delay:" << FLAGS_coordinator_interaction_delay_ms << "ms";
-    (void)usleep(FLAGS_coordinator_interaction_delay_ms * 1000);
+    // NOTE: never sleep, this maybe run in rpc callback thread
+    std::call_once(retry_timer_once_, [this] {
+      retry_timer_ = std::make_unique<Timer>();
+      CHECK(retry_timer_->Start(nullptr));
+    });
+    retry_timer_->Add([this, &rpc] { DoSendCoordinatorRpc(rpc); }, FLAGS_coordinator_interaction_delay_ms);
+    DINGO_LOG(INFO) << "schedule retry after:" << FLAGS_coordinator_interaction_delay_ms << "ms";
+    return;
   }
 
-  stub_.GetStoreRpcClient()->SendRpc(rpc, [this, &rpc] { SendCoordinatorRpcCallBack(rpc); });
+  DoSendCoordinatorRpc(rpc);
+}
+
+void CoordinatorRpcController::DoSendCoordinatorRpc(Rpc& rpc) {
+  int64_t send_time_us = Metrics::NowUs();
+  stub_.GetCoordinatorRpcClient()->SendRpc(rpc, [this, &rpc, send_time_us] {
+    if (FLAGS_enable_sdk_metrics) {
+      int32_t errcode = rpc.GetStatus().ok() ? GetRpcResponseError(rpc).errcode() : Metrics::kNetworkErrorCode;
+      Metrics::Global().RecordRpc(rpc, Metrics::NowUs() - send_time_us, errcode);
+    }
+    SendCoordinatorRpcCallBack(rpc);
+  });
 }
 
 void CoordinatorRpcController::SendCoordinatorRpcCallBack(Rpc& rpc) {
@@ -17,8 +17,16 @@
 
 #include <sys/types.h>
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "sdk/meta_member_info.h"
 #include "sdk/rpc/rpc.h"
+#include "sdk/utils/thread_pool_actuator.h"
 
 namespace dingodb {
 
@@ -30,6 +38,7 @@ class CoordinatorRpcController {
  public:
   CoordinatorRpcController(const ClientStub& stub) : stub_(stub) {}
 
+  // NOTE: a delayed retry still waiting is dropped
   virtual ~CoordinatorRpcController() = default;
 
   virtual Status Open(const std::vector<EndPoint>& endpoints);
@@ -38,18 +47,38 @@ class CoordinatorRpcController {
 
   virtual void AsyncCall(Rpc& rpc, StatusCallback cb);
 
+  // replace coordinator members, e.g. after coordinators are replaced, see MetaMemberRefresher
+  void SetMembers(std::vector<EndPoint> endpoints) { meta_member_info_.SetMembers(std::move(endpoints)); }
+
+  std::vector<EndPoint> GetMembers() const { return meta_member_info_.GetMembers(); }
+
  private:
   void DoAsyncCall(Rpc& rpc);
 
   // send rpc flow
   void PrepareRpc(Rpc& rpc);
   void SendCoordinatorRpc(Rpc& rpc);
+  void DoSendCoordinatorRpc(Rpc& rpc);
   void SendCoordinatorRpcCallBack(Rpc& rpc);
   void RetrySendRpcOrFireCallback(Rpc& rpc);
   static void FireCallback(Rpc& rpc);
 
+  // return true when rpc joins an identical one in flight, its callback is fired when that one is done
+  bool JoinInflightRpc(Rpc& rpc, const std::string& key);
+  // copy response and status of rpc to the rpcs joined it and fire their callbacks
+  void FinishInflightRpc(Rpc& rpc, const std::string& key, const Status& status);
+
   const ClientStub& stub_;
   MetaMemberInfo meta_member_info_;
+
+  std::mutex inflight_mutex_;
+  // method and encoded request to rpcs waiting for the one in flight
+  std::unordered_map<std::string, std::vector<Rpc*>> inflight_rpcs_;
+
+  // delayed retries are sent by the timer thread itself, sync callers running on actuator threads may take all of
+  // them, so a retry must not wait for a free actuator thread. started by the first delayed retry
+  std::once_flag retry_timer_once_;
+  std::unique_ptr<Timer> retry_timer_;
 };
 
 }  // namespace sdk
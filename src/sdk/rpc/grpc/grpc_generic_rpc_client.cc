@@ -0,0 +1,225 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/grpc/grpc_generic_rpc_client.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "grpc/compression.h"
+#include "grpcpp/client_context.h"
+#include "grpcpp/grpcpp.h"
+#include "grpcpp/impl/codegen/proto_utils.h"
+#include "grpcpp/support/byte_buffer.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/concurrency_limiter.h"
+#include "sdk/rpc/local_transport.h"
+#include "sdk/utils/thread_placement.h"
+#include "sdk/utils/thread_pool.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+struct GrpcGenericCall {
+  Rpc* rpc;
+  RpcCallback cb;
+  grpc::ClientContext context;
+  grpc::ByteBuffer request;
+  grpc::ByteBuffer response;
+  grpc::Status grpc_status;
+  std::unique_ptr<grpc::GenericClientAsyncResponseReader> reader;
+
+  // run by cq worker, or by parse pool when response is large
+  void OnDone() {
+    if (!grpc_status.ok()) {
+      DINGO_LOG(WARNING) << "Fail send rpc: " << rpc->Method() << " endpoint(peer):" << context.peer()
+                         << " grpc error_code:" << grpc_status.error_code()
+                         << " error_text:" << grpc_status.error_message();
+      rpc->SetStatus(Status::NetworkError(grpc_status.error_code(), grpc_status.error_message()));
+    } else {
+      grpc::Status s =
+          grpc::SerializationTraits<google::protobuf::Message>::Deserialize(&response, rpc->RawMutableResponse());
+      if (!s.ok()) {
+        rpc->SetStatus(Status::NetworkError(s.error_code(), s.error_message()));
+      }
+    }
+  }
+};
+
+void RunCallDone(std::unique_ptr<GrpcGenericCall> call) {
+  call->OnDone();
+  RpcCallback cb = std::move(call->cb);
+  call.reset();
+  cb();
+}
+
+}  // namespace
+
+void GrpcGenericRpcClient::Open() {
+  std::unique_lock<std::mutex> lg(lock_);
+  if (!opened_) {
+    if (FLAGS_grpc_parse_thread_num > 0) {
+      parse_pool_.reset(NewThreadPool(FLAGS_grpc_parse_thread_num));
+      parse_pool_->Start();
+    }
+
+    ThreadPlacement placement = ThreadPlacement::FromFlags();
+    ThreadPool* parse_pool = parse_pool_.get();
+    int64_t parse_min_bytes = FLAGS_grpc_parse_offload_min_bytes;
+    for (int i = 0; i < FLAGS_grpc_poll_thread_num; ++i) {
+      auto cq = std::make_unique<grpc::CompletionQueue>();
+      workers_.emplace_back(
+          [placement, parse_pool, parse_min_bytes](grpc::CompletionQueue* cq) -> void {
+            placement.PinCurrentThread();
+            void* tag;
+            bool ok;
+            while (cq->Next(&tag, &ok)) {
+              CHECK(ok) << "expect ok is always true";
+              std::unique_ptr<GrpcGenericCall> call(static_cast<GrpcGenericCall*>(tag));
+              // a large response would hold the cq thread for long, other rpcs completed on it wait behind
+              if (parse_pool != nullptr && call->grpc_status.ok() &&
+                  static_cast<int64_t>(call->response.Length()) >= parse_min_bytes) {
+                GrpcGenericCall* p_call = call.release();
+                parse_pool->Execute([p_call] { RunCallDone(std::unique_ptr<GrpcGenericCall>(p_call)); });
+                continue;
+              }
+              RunCallDone(std::move(call));
+            }
+          },
+          cq.get());
+
+      cqs_.emplace_back(std::move(cq));
+    }
+
+    opened_ = true;
+  }
+}
+
+void GrpcGenericRpcClient::Close() {
+  std::unique_lock<std::mutex> lg(lock_);
+  if (opened_) {
+    for (auto& cq : cqs_) {
+      cq->Shutdown();
+    }
+
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+
+    // run parse jobs left in queue before destroy
+    parse_pool_.reset();
+
+    opened_ = false;
+  }
+}
+
+void GrpcGenericRpcClient::SendRpc(Rpc& rpc, RpcCallback cb) {
+  if (FLAGS_store_rpc_concurrency_limit) {
+    ConcurrencyLimiter::Global().SendRpc(rpc, std::move(cb),
+                                         [this](Rpc& rpc, RpcCallback cb) { DoSendRpc(rpc, std::move(cb)); });
+    return;
+  }
+
+  DoSendRpc(rpc, std::move(cb));
+}
+
+void GrpcGenericRpcClient::DoSendRpc(Rpc& rpc, RpcCallback cb) {
+  CHECK(opened_) << "grpc generic rpc client not opened";
+  const auto& endpoint = rpc.GetEndPoint();
+  CHECK(endpoint.IsValid()) << "rpc endpoint not valid: " << endpoint.ToString();
+
+  const google::protobuf::MethodDescriptor* method = FindProtoMethod(rpc);
+  if (method == nullptr) {
+    rpc.SetStatus(Status::NotSupported(fmt::format("rpc {} has no proto method", rpc.Method())));
+    cb();
+    return;
+  }
+  SetCompressType(rpc);
+
+  auto call = std::make_unique<GrpcGenericCall>();
+  call->rpc = &rpc;
+  call->cb = std::move(cb);
+
+  bool own_buffer = false;
+  grpc::Status s =
+      grpc::SerializationTraits<google::protobuf::Message>::Serialize(*rpc.RawRequest(), &call->request, &own_buffer);
+  if (!s.ok()) {
+    rpc.SetStatus(Status::InvalidArgument(s.error_code(), s.error_message()));
+    call->cb();
+    return;
+  }
+
+  int64_t timeout_ms = rpc.GetTimeoutMs() > 0 ? rpc.GetTimeoutMs() : FLAGS_rpc_time_out_ms;
+  call->context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms));
+  if (rpc.GetTraceContext().IsValid()) {
+    call->context.AddMetadata("traceparent", rpc.GetTraceContext().TraceParent());
+  }
+  if (rpc.GetCompressType() != kRpcCompressNone) {
+    // grpc core only has gzip and deflate
+    call->context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  }
+
+  std::string path = fmt::format("/{}/{}", method->service()->full_name(), method->name());
+  grpc::CompletionQueue* cq = cqs_[next_cq_index_.fetch_add(1, std::memory_order_relaxed) % cqs_.size()].get();
+
+  GrpcGenericCall* p_call = call.release();
+  p_call->reader = GetStub(endpoint)->stub->PrepareUnaryCall(&p_call->context, path, p_call->request, cq);
+  p_call->reader->StartCall();
+  p_call->reader->Finish(&p_call->response, &p_call->grpc_status, p_call);
+}
+
+void GrpcGenericRpcClient::Connect(const EndPoint& endpoint) {
+  // try_to_connect starts connecting an idle channel in background
+  GetStub(endpoint)->channel->GetState(true);
+}
+
+GrpcGenericRpcClient::EndPointStub* GrpcGenericRpcClient::GetStub(const EndPoint& endpoint) {
+  {
+    std::shared_lock<std::shared_mutex> r(stub_lock_);
+    auto iter = stub_map_.find(endpoint);
+    if (iter != stub_map_.end()) {
+      return iter->second.get();
+    }
+  }
+
+  std::string target = LocalTransportAddress(endpoint);
+  if (target.empty()) {
+    target = endpoint.StringAddr();
+  }
+
+  auto stub = std::make_unique<EndPointStub>();
+  stub->channel = grpc::CreateChannel(target, grpc::InsecureChannelCredentials());
+  stub->stub = std::make_unique<grpc::GenericStub>(stub->channel);
+
+  std::unique_lock<std::shared_mutex> w(stub_lock_);
+  // another thread maybe create stub for same endpoint, then use that one
+  return stub_map_.emplace(endpoint, std::move(stub)).first->second.get();
+}
+
+RpcClient* NewGrpcGenericRpcClient(const RpcClientOptions& options) {
+  auto* client = new GrpcGenericRpcClient(options);
+  client->Open();
+  return client;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
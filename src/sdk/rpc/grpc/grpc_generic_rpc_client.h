@@ -0,0 +1,83 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_GRPC_GENERIC_RPC_CLIENT_H_
+#define DINGODB_SDK_GRPC_GENERIC_RPC_CLIENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "grpcpp/channel.h"
+#include "grpcpp/completion_queue.h"
+#include "grpcpp/generic/generic_stub.h"
+#include "sdk/rpc/rpc_client.h"
+#include "sdk/utils/thread_pool.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Sends any rpc by grpc generic stub with the serialized request and the path of its proto method, so it does not
+// depend on the typed rpcs of the backend sdk is built with. Used to run a brpc build on grpc, see
+// NewRpcClient(options, backend).
+// When FLAGS_grpc_parse_thread_num > 0, responses of at least FLAGS_grpc_parse_offload_min_bytes are deserialized and
+// their callbacks run in a parse pool instead of the cq thread, so completion of other rpcs is not blocked by them.
+class GrpcGenericRpcClient : public RpcClient {
+ public:
+  GrpcGenericRpcClient(const RpcClientOptions &options) : RpcClient(options) {}
+
+  ~GrpcGenericRpcClient() override { Close(); }
+
+  void Open() override;
+
+  void SendRpc(Rpc &rpc, RpcCallback cb) override;
+
+  void Connect(const EndPoint &endpoint) override;
+
+ private:
+  struct EndPointStub {
+    std::shared_ptr<grpc::Channel> channel;
+    std::unique_ptr<grpc::GenericStub> stub;
+  };
+
+  void DoSendRpc(Rpc &rpc, RpcCallback cb);
+
+  void Close();
+
+  EndPointStub *GetStub(const EndPoint &endpoint);
+
+  // protect open and close
+  std::mutex lock_;
+  std::vector<std::unique_ptr<grpc::CompletionQueue>> cqs_;
+  std::vector<std::thread> workers_;
+  bool opened_{false};
+  std::atomic<uint64_t> next_cq_index_{0};
+  std::unique_ptr<ThreadPool> parse_pool_;
+
+  // read mostly, stub is created only when first send to an endpoint and lives as long as the client
+  std::shared_mutex stub_lock_;
+  std::map<EndPoint, std::unique_ptr<EndPointStub>> stub_map_;
+};
+
+RpcClient *NewGrpcGenericRpcClient(const RpcClientOptions &options);
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_GRPC_GENERIC_RPC_CLIENT_H_
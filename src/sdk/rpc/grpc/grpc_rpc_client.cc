@@ -15,13 +15,22 @@
 #include "sdk/rpc/grpc/grpc_rpc_client.h"
 
 #include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <utility>
 
+#include "common/logging.h"
 #include "glog/logging.h"
 #include "grpcpp/grpcpp.h"
 #include "sdk/common/param_config.h"
+#include "sdk/rpc/concurrency_limiter.h"
+#include "sdk/rpc/grpc/grpc_generic_rpc_client.h"
 #include "sdk/rpc/grpc/unary_rpc.h"
+#include "sdk/rpc/local_transport.h"
 #include "sdk/rpc/rpc.h"
 #include "sdk/utils/net_util.h"
+#include "sdk/utils/thread_placement.h"
 
 namespace dingodb {
 namespace sdk {
@@ -29,10 +38,25 @@ namespace sdk {
 void GrpcRpcClient::Open() {
   std::unique_lock<std::mutex> lg(lock_);
   if (!opened_) {
+    if (FLAGS_grpc_parse_thread_num > 0) {
+      std::stringstream ss(FLAGS_grpc_parse_offload_methods);
+      std::string method;
+      while (std::getline(ss, method, ',')) {
+        if (!method.empty()) {
+          parse_methods_.insert(method);
+        }
+      }
+      if (!parse_methods_.empty()) {
+        parse_client_.reset(NewGrpcGenericRpcClient(m_options));
+      }
+    }
+
+    ThreadPlacement placement = ThreadPlacement::FromFlags();
     for (int i = 0; i < FLAGS_grpc_poll_thread_num; ++i) {
       auto cq = std::make_unique<grpc::CompletionQueue>();
       workers_.emplace_back(
-          [&](grpc::CompletionQueue* cq) -> void {
+          [placement](grpc::CompletionQueue* cq) -> void {
+            placement.PinCurrentThread();
             void* tag;
             bool ok;
             while (cq->Next(&tag, &ok)) {
@@ -61,39 +85,86 @@ void GrpcRpcClient::Close() {
       worker.join();
     }
 
+    parse_client_.reset();
+
     opened_ = false;
   }
 }
 
 void GrpcRpcClient::SendRpc(Rpc& rpc, RpcCallback cb) {
+  if (parse_client_ != nullptr && parse_methods_.count(rpc.ProtoMethod()) > 0) {
+    parse_client_->SendRpc(rpc, std::move(cb));
+    return;
+  }
+
+  if (FLAGS_store_rpc_concurrency_limit) {
+    ConcurrencyLimiter::Global().SendRpc(rpc, std::move(cb),
+                                         [this](Rpc& rpc, RpcCallback cb) { DoSendRpc(rpc, std::move(cb)); });
+    return;
+  }
+
+  DoSendRpc(rpc, std::move(cb));
+}
+
+void GrpcRpcClient::DoSendRpc(Rpc& rpc, RpcCallback cb) {
   CHECK(opened_) << "grpc rpc client not opened";
   const auto& endpoint = rpc.GetEndPoint();
   CHECK(endpoint.IsValid()) << "rpc endpoint not valid: " << endpoint.ToString();
+  SetCompressType(rpc);
 
   auto ctx = std::make_unique<GrpcContext>();
 
-  std::shared_ptr<grpc::Channel> channel;
+  std::shared_ptr<grpc::Channel> channel = GetChannel(endpoint);
+  CHECK_NOTNULL(channel.get());
+  ctx->cq = PickCq();
+  ctx->channel = std::move(channel);
+  ctx->cb = std::move(cb);
+  ctx->endpoint = endpoint;
+
+  rpc.Call(ctx.release());
+}
+
+void GrpcRpcClient::Connect(const EndPoint& endpoint) {
+  // try_to_connect starts connecting an idle channel in background
+  GetChannel(endpoint)->GetState(true);
+}
+
+std::shared_ptr<grpc::Channel> GrpcRpcClient::GetChannel(const EndPoint& endpoint) {
   {
-    std::lock_guard<std::mutex> guard(lock_);
+    std::shared_lock<std::shared_mutex> r(channel_lock_);
     auto ch = channel_map_.find(endpoint);
-    if (ch == channel_map_.end()) {
-      // TODO: maybe use custome channel
-      channel = grpc::CreateChannel(endpoint.StringAddr(), grpc::InsecureChannelCredentials());
-      channel_map_.insert(std::make_pair(endpoint, channel));
-    } else {
-      channel = CHECK_NOTNULL(ch->second);
+    if (ch != channel_map_.end()) {
+      return CHECK_NOTNULL(ch->second);
     }
+  }
 
-    ctx->cq = cqs_[next_cq_index_ % cqs_.size()].get();
-    next_cq_index_++;
+  // a store on this host is reached by its unix socket
+  std::string target = LocalTransportAddress(endpoint);
+  if (target.empty()) {
+    target = endpoint.StringAddr();
+  } else {
+    DINGO_LOG(INFO) << "endpoint:" << endpoint.ToString() << " is local, use " << target;
   }
 
-  CHECK_NOTNULL(channel.get());
-  ctx->channel = std::move(channel);
-  ctx->cb = std::move(cb);
-  ctx->endpoint = endpoint;
+  // TODO: maybe use custome channel
+  auto channel = grpc::CreateChannel(target, grpc::InsecureChannelCredentials());
 
-  rpc.Call(ctx.release());
+  std::unique_lock<std::shared_mutex> w(channel_lock_);
+  // another thread maybe create channel for same endpoint, then use that one
+  return channel_map_.emplace(endpoint, std::move(channel)).first->second;
+}
+
+grpc::CompletionQueue* GrpcRpcClient::PickCq() {
+  uint64_t index;
+  if (FLAGS_grpc_cq_affinity) {
+    // NOTE: bound once per thread, shared by all grpc rpc clients in process
+    thread_local uint64_t thread_cq_index = next_cq_index_.fetch_add(1, std::memory_order_relaxed);
+    index = thread_cq_index;
+  } else {
+    index = next_cq_index_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return cqs_[index % cqs_.size()].get();
 }
 
 RpcClient* NewRpcClient(const RpcClientOptions& options) {
@@ -15,10 +15,14 @@
 #ifndef DINGODB_SDK_GRPC_RPC_CLIENT_H_
 #define DINGODB_SDK_GRPC_RPC_CLIENT_H_
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -39,15 +43,34 @@ class GrpcRpcClient : public RpcClient {
 
   void SendRpc(Rpc &rpc, RpcCallback cb) override;
 
+  void Connect(const EndPoint &endpoint) override;
+
  private:
+  // send directly, SendRpc goes through ConcurrencyLimiter when FLAGS_store_rpc_concurrency_limit is true
+  void DoSendRpc(Rpc &rpc, RpcCallback cb);
+
   void Close();
 
+  std::shared_ptr<grpc::Channel> GetChannel(const EndPoint &endpoint);
+
+  // round robin by default, when FLAGS_grpc_cq_affinity is set each caller thread always use the same cq
+  grpc::CompletionQueue *PickCq();
+
+  // protect open and close
   std::mutex lock_;
   std::vector<std::unique_ptr<grpc::CompletionQueue>> cqs_;
   std::vector<std::thread> workers_;
-  std::map<EndPoint, std::shared_ptr<grpc::Channel>> channel_map_;
   bool opened_{false};
-  int64_t next_cq_index_{0};
+  std::atomic<uint64_t> next_cq_index_{0};
+
+  // typed rpcs deserialize response on the cq thread, so rpcs in FLAGS_grpc_parse_offload_methods are sent by a
+  // GrpcGenericRpcClient parsing large responses in its parse pool, null when FLAGS_grpc_parse_thread_num is 0
+  std::unique_ptr<RpcClient> parse_client_;
+  std::set<std::string> parse_methods_;
+
+  // read mostly, channel is created only when first send to an endpoint
+  std::shared_mutex channel_lock_;
+  std::map<EndPoint, std::shared_ptr<grpc::Channel>> channel_map_;
 };
 
 }  // namespace sdk
@@ -39,11 +39,13 @@ DEFINE_STORE_RPC(TxnBatchGet);
 DEFINE_STORE_RPC(TxnPrewrite);
 DEFINE_STORE_RPC(TxnCommit);
 DEFINE_STORE_RPC(TxnBatchRollback);
+DEFINE_STORE_RPC(TxnPessimisticLock);
 DEFINE_STORE_RPC(TxnScan);
 
 DEFINE_STORE_RPC(TxnHeartBeat);
 DEFINE_STORE_RPC(TxnCheckTxnStatus);
 DEFINE_STORE_RPC(TxnResolveLock);
+DEFINE_STORE_RPC(TxnScanLock);
 
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
@@ -43,11 +43,13 @@ DECLARE_STORE_RPC(TxnBatchGet);
 DECLARE_STORE_RPC(TxnPrewrite);
 DECLARE_STORE_RPC(TxnCommit);
 DECLARE_STORE_RPC(TxnBatchRollback);
+DECLARE_STORE_RPC(TxnPessimisticLock);
 DECLARE_STORE_RPC(TxnScan);
 
 DECLARE_STORE_RPC(TxnHeartBeat);
 DECLARE_STORE_RPC(TxnCheckTxnStatus);
 DECLARE_STORE_RPC(TxnResolveLock);
+DECLARE_STORE_RPC(TxnScanLock);
 
 }  // namespace sdk
 }  // namespace dingodb
@@ -17,6 +17,7 @@
 
 #include <sys/stat.h>
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -26,7 +27,9 @@
 #include "common/logging.h"
 #include "fmt/core.h"
 #include "glog/logging.h"
+#include "google/protobuf/arena.h"
 #include "google/protobuf/message.h"
+#include "grpc/compression.h"
 #include "grpcpp/client_context.h"
 #include "grpcpp/grpcpp.h"
 #include "grpcpp/support/async_unary_call.h"
@@ -51,15 +54,18 @@ struct GrpcContext : public RpcContext {
 template <class RequestType, class ResponseType, class ServiceType, class StubType>
 class UnaryRpc : public Rpc {
  public:
-  UnaryRpc(const std::string& cmd) : Rpc(cmd) {
-    request = new RequestType;
-    response = new ResponseType;
+  // when arena is not null, request and response are allocated on arena and freed with it, arena must outlive rpc
+  UnaryRpc(const std::string& cmd, google::protobuf::Arena* arena = nullptr) : Rpc(cmd), arena_(arena) {
+    request = google::protobuf::Arena::CreateMessage<RequestType>(arena);
+    response = google::protobuf::Arena::CreateMessage<ResponseType>(arena);
     context = std::make_unique<grpc::ClientContext>();
   }
 
   ~UnaryRpc() override {
-    delete request;
-    delete response;
+    if (arena_ == nullptr) {
+      delete request;
+      delete response;
+    }
   }
 
   RequestType* MutableRequest() { return request; }
@@ -110,6 +116,12 @@ class UnaryRpc : public Rpc {
     status = Status::OK();
     context->TryCancel();
     context = std::make_unique<grpc::ClientContext>();
+    timeout_ms = 0;
+  }
+
+  void Recycle() override {
+    Rpc::Recycle();
+    grpc_ctx.reset();
   }
 
   virtual std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>> Prepare(StubType* stub,
@@ -135,11 +147,23 @@ class UnaryRpc : public Rpc {
     }
     CHECK_NOTNULL(p_stub);
 
+    if (timeout_ms > 0) {
+      context->set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms));
+    }
+    if (trace_context.IsValid()) {
+      context->AddMetadata("traceparent", trace_context.TraceParent());
+    }
+    if (compress_type != kRpcCompressNone) {
+      // grpc core only has gzip and deflate
+      context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    }
+
     auto reader = Prepare(p_stub, grpc_ctx->cq);
     reader->Finish(response, &grpc_status, (void*)this);
   }
 
  protected:
+  google::protobuf::Arena* arena_;
   RequestType* request;
   ResponseType* response;
   std::unique_ptr<grpc::ClientContext> context;
@@ -164,8 +188,11 @@ std::mutex UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::lk;
     METHOD##Rpc& operator=(const METHOD##Rpc&) = delete;                                             \
     explicit METHOD##Rpc();                                                                          \
     explicit METHOD##Rpc(const std::string& cmd);                                                    \
+    explicit METHOD##Rpc(google::protobuf::Arena* arena);                                            \
     ~METHOD##Rpc() override;                                                                         \
     std::string Method() const override { return ConstMethod(); }                                    \
+    std::string ProtoMethod() const override { return #METHOD; }                                     \
+    std::unique_ptr<Rpc> Clone() const override;                                                     \
     std::unique_ptr<grpc::ClientAsyncResponseReader<NS::METHOD##Response>> Prepare(                  \
         NS::SERVICE::Stub* stub, grpc::CompletionQueue* cq) override;                                \
     static std::string ConstMethod();                                                                \
@@ -174,11 +201,17 @@ std::mutex UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::lk;
 #define DEFINE_UNAEY_RPC(NS, SERVICE, METHOD)                                                  \
   METHOD##Rpc::METHOD##Rpc() : METHOD##Rpc("") {}                                              \
   METHOD##Rpc::METHOD##Rpc(const std::string& cmd) : UnaryRpc(cmd) {}                          \
+  METHOD##Rpc::METHOD##Rpc(google::protobuf::Arena* arena) : UnaryRpc("", arena) {}            \
   METHOD##Rpc::~METHOD##Rpc() = default;                                                       \
   std::unique_ptr<grpc::ClientAsyncResponseReader<NS::METHOD##Response>> METHOD##Rpc::Prepare( \
       NS::SERVICE::Stub* stub, grpc::CompletionQueue* cq) {                                    \
     return stub->Async##METHOD(MutableContext(), *request, cq);                                \
   }                                                                                            \
+  std::unique_ptr<Rpc> METHOD##Rpc::Clone() const {                                            \
+    auto rpc = std::make_unique<METHOD##Rpc>(cmd);                                             \
+    rpc->request->CopyFrom(*request);                                                          \
+    return rpc;                                                                                \
+  }                                                                                            \
   std::string METHOD##Rpc::ConstMethod() { return fmt::format("{}.{}Rpc", NS::SERVICE::service_full_name(), #METHOD); }
 
 }  // namespace sdk
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/local_transport.h"
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <set>
+#include <string>
+
+#include "common/logging.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+std::set<std::string> LoadLocalAddresses() {
+  std::set<std::string> addresses{"localhost"};
+
+  struct ifaddrs* ifaddr = nullptr;
+  if (getifaddrs(&ifaddr) != 0) {
+    DINGO_LOG(WARNING) << "getifaddrs fail, errno:" << errno << ", only localhost is local";
+    return addresses;
+  }
+
+  for (struct ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next) {
+    if (ifa->ifa_addr == nullptr) {
+      continue;
+    }
+
+    char buf[INET6_ADDRSTRLEN];
+    int family = ifa->ifa_addr->sa_family;
+    if (family == AF_INET) {
+      auto* addr = reinterpret_cast<struct sockaddr_in*>(ifa->ifa_addr);
+      if (inet_ntop(AF_INET, &addr->sin_addr, buf, sizeof(buf)) != nullptr) {
+        addresses.insert(buf);
+      }
+    } else if (family == AF_INET6) {
+      auto* addr = reinterpret_cast<struct sockaddr_in6*>(ifa->ifa_addr);
+      if (inet_ntop(AF_INET6, &addr->sin6_addr, buf, sizeof(buf)) != nullptr) {
+        addresses.insert(buf);
+      }
+    }
+  }
+
+  freeifaddrs(ifaddr);
+  return addresses;
+}
+}  // namespace
+
+bool IsLocalHost(const std::string& host) {
+  if (host.rfind("127.", 0) == 0 || host == "::1") {
+    return true;
+  }
+
+  static const std::set<std::string> kLocalAddresses = LoadLocalAddresses();
+  return kLocalAddresses.count(host) > 0;
+}
+
+std::string LocalUnixSocketPath(const EndPoint& endpoint) {
+  std::string path = FLAGS_rpc_local_unix_socket_path;
+  if (path.empty()) {
+    return path;
+  }
+
+  const std::string placeholder = "{port}";
+  auto pos = path.find(placeholder);
+  if (pos != std::string::npos) {
+    path.replace(pos, placeholder.size(), std::to_string(endpoint.Port()));
+  }
+  return path;
+}
+
+std::string LocalTransportAddress(const EndPoint& endpoint) {
+  std::string path = LocalUnixSocketPath(endpoint);
+  if (path.empty() || !IsLocalHost(endpoint.Host())) {
+    return "";
+  }
+
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode)) {
+    DINGO_LOG(DEBUG) << "no unix socket:" << path << " of local endpoint:" << endpoint.ToString() << ", use tcp";
+    return "";
+  }
+
+  return "unix:" + path;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
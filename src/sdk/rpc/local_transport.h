@@ -0,0 +1,37 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RPC_LOCAL_TRANSPORT_H_
+#define DINGODB_SDK_RPC_LOCAL_TRANSPORT_H_
+
+#include <string>
+
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+// host is localhost, a loopback address or an address of a local interface, interfaces are read once per process
+bool IsLocalHost(const std::string& host);
+
+// FLAGS_rpc_local_unix_socket_path of endpoint, empty when the flag is not set
+std::string LocalUnixSocketPath(const EndPoint& endpoint);
+
+// "unix:<path>" when endpoint is on this host and its unix socket exists, so rpc clients skip the tcp stack, else
+// empty and the endpoint is reached by tcp
+std::string LocalTransportAddress(const EndPoint& endpoint);
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RPC_LOCAL_TRANSPORT_H_
@@ -0,0 +1,49 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/memory_budget.h"
+
+#include <cstdint>
+
+#include "sdk/common/metrics.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+bool MemoryBudget::TryCharge(int64_t bytes) {
+  int64_t limit = FLAGS_sdk_memory_budget_bytes;
+  int64_t used = used_bytes_.load(std::memory_order_relaxed);
+  do {
+    if (limit > 0 && used > 0 && used + bytes > limit) {
+      return false;
+    }
+  } while (!used_bytes_.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+  Metrics::Global().RecordMemoryBudgetCharge(bytes);
+  return true;
+}
+
+void MemoryBudget::ForceCharge(int64_t bytes) {
+  used_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  Metrics::Global().RecordMemoryBudgetCharge(bytes);
+}
+
+void MemoryBudget::Release(int64_t bytes) {
+  used_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+  Metrics::Global().RecordMemoryBudgetCharge(-bytes);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
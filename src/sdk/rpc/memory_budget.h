@@ -0,0 +1,55 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_MEMORY_BUDGET_H_
+#define DINGODB_SDK_MEMORY_BUDGET_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+// Client wide accountant of bytes held by store rpcs in flight, request and response protobufs of a call are charged
+// from its first attempt until its callback is fired. When FLAGS_sdk_memory_budget_bytes are charged, a new call waits
+// up to FLAGS_sdk_memory_budget_max_wait_ms for others to release and then fails fast, so a burst of large scans or
+// batch writes is throttled instead of growing the host process without bound.
+// Responses are charged when received regardless of the limit, the store has already sent them.
+class MemoryBudget {
+ public:
+  MemoryBudget(const MemoryBudget&) = delete;
+  const MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+  MemoryBudget() = default;
+
+  ~MemoryBudget() = default;
+
+  // false when bytes exceed the limit and something is charged already, a charge bigger than the whole limit still
+  // goes when nothing else is charged. always true when FLAGS_sdk_memory_budget_bytes <= 0
+  bool TryCharge(int64_t bytes);
+
+  // charge regardless of the limit
+  void ForceCharge(int64_t bytes);
+
+  void Release(int64_t bytes);
+
+  int64_t UsedBytes() const { return used_bytes_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> used_bytes_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_MEMORY_BUDGET_H_
@@ -0,0 +1,136 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/region_circuit_breaker.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "common/logging.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int64_t CeilMs(int64_t us) { return (us + 999) / 1000; }
+}  // namespace
+
+RegionCircuitBreaker::AdmitResult RegionCircuitBreaker::Admit(int64_t region_id, int64_t& retry_after_ms) {
+  retry_after_ms = 0;
+  if (FLAGS_store_rpc_breaker_failures <= 0 || size_.load(std::memory_order_relaxed) == 0) {
+    return kAllowed;
+  }
+
+  int64_t now_us = NowUs();
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = states_.find(region_id);
+  if (iter == states_.end()) {
+    return kAllowed;
+  }
+
+  RegionState& state = iter->second;
+  switch (state.state) {
+    case kClosed:
+      return kAllowed;
+    case kOpen:
+      if (now_us < state.open_until_us) {
+        retry_after_ms = CeilMs(state.open_until_us - now_us);
+        return kRejected;
+      }
+      state.state = kHalfOpen;
+      state.probe_until_us = now_us + FLAGS_store_rpc_breaker_open_ms * 1000;
+      DINGO_LOG(INFO) << "region:" << region_id << " breaker half open, send probe";
+      return kProbe;
+    case kHalfOpen:
+      if (now_us < state.probe_until_us) {
+        retry_after_ms = CeilMs(state.probe_until_us - now_us);
+        return kRejected;
+      }
+      state.probe_until_us = now_us + FLAGS_store_rpc_breaker_open_ms * 1000;
+      DINGO_LOG(INFO) << "region:" << region_id << " breaker probe not answered, send another probe";
+      return kProbe;
+    default:
+      CHECK(false) << "unknown breaker state:" << static_cast<int>(state.state);
+  }
+
+  return kAllowed;
+}
+
+void RegionCircuitBreaker::RecordResult(int64_t region_id, bool unavailable) {
+  if (FLAGS_store_rpc_breaker_failures <= 0) {
+    return;
+  }
+
+  if (!unavailable) {
+    if (size_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto iter = states_.find(region_id);
+    if (iter == states_.end()) {
+      return;
+    }
+    if (iter->second.state != kClosed) {
+      DINGO_LOG(INFO) << "region:" << region_id << " breaker closed, region recovered";
+    }
+    states_.erase(iter);
+    size_.store(states_.size(), std::memory_order_relaxed);
+    return;
+  }
+
+  int64_t now_us = NowUs();
+  std::lock_guard<std::mutex> guard(mutex_);
+  RegionState& state = states_[region_id];
+  size_.store(states_.size(), std::memory_order_relaxed);
+  state.consecutive_failures++;
+  switch (state.state) {
+    case kClosed:
+      if (state.consecutive_failures >= FLAGS_store_rpc_breaker_failures) {
+        Open(region_id, state, now_us);
+      }
+      break;
+    case kOpen:
+      // failure of rpc sent before the breaker opened
+      break;
+    case kHalfOpen:
+      Open(region_id, state, now_us);
+      break;
+    default:
+      CHECK(false) << "unknown breaker state:" << static_cast<int>(state.state);
+  }
+}
+
+RegionCircuitBreaker::State RegionCircuitBreaker::GetState(int64_t region_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = states_.find(region_id);
+  return iter == states_.end() ? kClosed : iter->second.state;
+}
+
+void RegionCircuitBreaker::Open(int64_t region_id, RegionState& state, int64_t now_us) {
+  state.state = kOpen;
+  state.open_until_us = now_us + FLAGS_store_rpc_breaker_open_ms * 1000;
+  DINGO_LOG(WARNING) << "region:" << region_id << " breaker open after " << state.consecutive_failures
+                     << " consecutive failures, fail fast for " << FLAGS_store_rpc_breaker_open_ms << "ms";
+}
+
+}  // namespace sdk
+}  // namespace dingodb
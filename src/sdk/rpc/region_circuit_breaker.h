@@ -0,0 +1,77 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_REGION_CIRCUIT_BREAKER_H_
+#define DINGODB_SDK_REGION_CIRCUIT_BREAKER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace dingodb {
+namespace sdk {
+
+// Client wide breaker of store rpcs, one per region.
+// After FLAGS_store_rpc_breaker_failures consecutive no leader or network failures
+// of a region the breaker is open, rpcs of the region fail fast for
+// FLAGS_store_rpc_breaker_open_ms, then a single probe rpc is let through,
+// the region is closed again when it is answered and reopened when it fails.
+class RegionCircuitBreaker {
+ public:
+  enum State : uint8_t { kClosed = 0, kOpen = 1, kHalfOpen = 2 };
+
+  enum AdmitResult : uint8_t {
+    kAllowed = 0,
+    // allowed as the probe of an open region, its result decides the breaker state
+    kProbe = 1,
+    kRejected = 2,
+  };
+
+  RegionCircuitBreaker(const RegionCircuitBreaker&) = delete;
+  const RegionCircuitBreaker& operator=(const RegionCircuitBreaker&) = delete;
+
+  RegionCircuitBreaker() = default;
+
+  ~RegionCircuitBreaker() = default;
+
+  // retry_after_ms is set to the ms until the region can be probed again when rejected
+  AdmitResult Admit(int64_t region_id, int64_t& retry_after_ms);
+
+  // unavailable means no leader or network error, any other answer proves the region is reachable
+  void RecordResult(int64_t region_id, bool unavailable);
+
+  State GetState(int64_t region_id);
+
+ private:
+  struct RegionState {
+    State state{kClosed};
+    int64_t consecutive_failures{0};
+    int64_t open_until_us{0};
+    // the probe is given up when it is not answered within open ms, so a lost probe never blocks the region
+    int64_t probe_until_us{0};
+  };
+
+  void Open(int64_t region_id, RegionState& state, int64_t now_us);
+
+  std::mutex mutex_;
+  // only regions with failures are kept
+  std::map<int64_t, RegionState> states_;
+  // size of states_, lets the common all regions healthy case skip the mutex
+  std::atomic<size_t> size_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_REGION_CIRCUIT_BREAKER_H_
@@ -0,0 +1,237 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/replica_selector.h"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// weight of the newest error sample
+constexpr double kEwmaAlpha = 0.2;
+// stats not updated for so long are ignored, so an avoided store is probed again
+constexpr int64_t kStatsExpireUs = 10 * 1000 * 1000;
+// samples needed before the latency distribution is trusted for hedging
+constexpr int64_t kHedgeMinSamples = 8;
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool HasLeader(const std::vector<Replica>& replicas) {
+  for (const auto& replica : replicas) {
+    if (replica.role == kLeader) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+bool ReplicaSelector::SelectReadReplica(Region& region, ReplicaReadPolicy policy, EndPoint& end_point) {
+  if (policy == kLeaderOnly) {
+    return false;
+  }
+
+  std::vector<Replica> replicas = region.Replicas();
+  // leader unknown, let the leader path discover it first
+  if (replicas.size() < 2 || !HasLeader(replicas)) {
+    return false;
+  }
+
+  switch (policy) {
+    case kFollowerRoundRobin:
+      return SelectFollowerRoundRobin(replicas, end_point);
+    case kLowestLatency:
+      return SelectLowestLatency(replicas, nullptr, end_point);
+    default:
+      return false;
+  }
+}
+
+bool ReplicaSelector::SelectHedgeReplica(Region& region, const EndPoint& exclude, EndPoint& end_point) {
+  std::vector<Replica> replicas = region.Replicas();
+  if (replicas.size() < 2 || !HasLeader(replicas)) {
+    return false;
+  }
+
+  return SelectLowestLatency(replicas, &exclude, end_point);
+}
+
+bool ReplicaSelector::SelectFollowerRoundRobin(const std::vector<Replica>& replicas, EndPoint& end_point) {
+  std::vector<const Replica*> followers;
+  followers.reserve(replicas.size());
+  for (const auto& replica : replicas) {
+    if (replica.role != kFollower) {
+      continue;
+    }
+
+    bool unhealthy = false;
+    Score(replica.end_point, unhealthy);
+    if (!unhealthy) {
+      followers.push_back(&replica);
+    }
+  }
+
+  if (followers.empty()) {
+    return false;
+  }
+
+  uint64_t index = next_follower_.fetch_add(1, std::memory_order_relaxed);
+  end_point = followers[index % followers.size()]->end_point;
+  return true;
+}
+
+bool ReplicaSelector::SelectLowestLatency(const std::vector<Replica>& replicas, const EndPoint* exclude,
+                                          EndPoint& end_point) {
+  const Replica* best = nullptr;
+  double best_score = 0;
+  bool best_unhealthy = true;
+  for (const auto& replica : replicas) {
+    if (exclude != nullptr && replica.end_point == *exclude) {
+      continue;
+    }
+
+    bool unhealthy = false;
+    double score = Score(replica.end_point, unhealthy);
+    // healthy replica always beats unhealthy one, only fall back to unhealthy when all are
+    if (best == nullptr || (best_unhealthy && !unhealthy) || (best_unhealthy == unhealthy && score < best_score)) {
+      best = &replica;
+      best_score = score;
+      best_unhealthy = unhealthy;
+    }
+  }
+
+  if (best == nullptr) {
+    return false;
+  }
+
+  end_point = best->end_point;
+  return true;
+}
+
+double ReplicaSelector::Score(const EndPoint& end_point, bool& unhealthy) {
+  Snapshot snapshot;
+  if (!GetSnapshot(end_point, snapshot)) {
+    unhealthy = IsProbeDown(end_point);
+    return 0;
+  }
+
+  unhealthy = snapshot.error_rate * 100 > FLAGS_store_rpc_replica_max_error_percent || IsProbeDown(end_point);
+  // a failing store is as good as a slow one, its answer is useless
+  return snapshot.latency_us * (1 + 10 * snapshot.error_rate);
+}
+
+ReplicaSelector::EndPointStats* ReplicaSelector::FindStats(const EndPoint& end_point) {
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  auto iter = stats_.find(end_point);
+  return iter == stats_.end() ? nullptr : iter->second.get();
+}
+
+ReplicaSelector::EndPointStats* ReplicaSelector::GetOrCreateStats(const EndPoint& end_point) {
+  EndPointStats* stats = FindStats(end_point);
+  if (stats != nullptr) {
+    return stats;
+  }
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  auto& slot = stats_[end_point];
+  if (slot == nullptr) {
+    slot = std::make_unique<EndPointStats>();
+  }
+  return slot.get();
+}
+
+bool ReplicaSelector::GetSnapshot(const EndPoint& end_point, Snapshot& snapshot) {
+  EndPointStats* stats = FindStats(end_point);
+  if (stats == nullptr) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(stats->mutex);
+  if (stats->latency.Samples() == 0 || NowUs() - stats->update_time_us > kStatsExpireUs) {
+    return false;
+  }
+
+  snapshot.latency_us = stats->latency.MeanUs();
+  snapshot.p95_us = stats->latency.QuantileUs(95);
+  snapshot.error_rate = stats->error_rate;
+  snapshot.samples = stats->latency.Samples();
+  return true;
+}
+
+void ReplicaSelector::RecordResult(const EndPoint& end_point, int64_t latency_us, bool failed) {
+  EndPointStats* stats = GetOrCreateStats(end_point);
+
+  int64_t now_us = NowUs();
+  double error = failed ? 1.0 : 0.0;
+
+  std::lock_guard<std::mutex> guard(stats->mutex);
+  if (stats->latency.Samples() == 0 || now_us - stats->update_time_us > kStatsExpireUs) {
+    // first or expired sample, restart from it
+    stats->latency.Reset();
+    stats->error_rate = error;
+  } else {
+    stats->error_rate += kEwmaAlpha * (error - stats->error_rate);
+  }
+  stats->latency.Record(latency_us);
+  stats->update_time_us = now_us;
+}
+
+void ReplicaSelector::RecordProbeResult(const EndPoint& end_point, bool alive) {
+  EndPointStats* stats = GetOrCreateStats(end_point);
+
+  std::lock_guard<std::mutex> guard(stats->mutex);
+  stats->probe_down = !alive;
+  stats->probe_time_us = NowUs();
+}
+
+bool ReplicaSelector::IsProbeDown(const EndPoint& end_point) {
+  EndPointStats* stats = FindStats(end_point);
+  if (stats == nullptr) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(stats->mutex);
+  return stats->probe_down && NowUs() - stats->probe_time_us <= kStatsExpireUs;
+}
+
+int64_t ReplicaSelector::GetLatencyUs(const EndPoint& end_point) {
+  Snapshot snapshot;
+  return GetSnapshot(end_point, snapshot) ? static_cast<int64_t>(snapshot.latency_us) : -1;
+}
+
+double ReplicaSelector::GetErrorRate(const EndPoint& end_point) {
+  Snapshot snapshot;
+  return GetSnapshot(end_point, snapshot) ? snapshot.error_rate : -1;
+}
+
+int64_t ReplicaSelector::GetHedgeDelayUs(const EndPoint& end_point) {
+  Snapshot snapshot;
+  if (!GetSnapshot(end_point, snapshot) || snapshot.samples < kHedgeMinSamples) {
+    return -1;
+  }
+
+  return snapshot.p95_us;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,111 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_REPLICA_SELECTOR_H_
+#define DINGODB_SDK_REPLICA_SELECTOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/region.h"
+#include "sdk/utils/latency_ewma.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Client wide replica choice for reads, the selected replica is only used for
+// the first attempt of a read rpc, retries always go to the leader.
+// Every store rpc result feeds per endpoint latency and error ewma, lowest
+// latency read and hedged read use them to stay away from slow or failing stores.
+class ReplicaSelector {
+ public:
+  ReplicaSelector(const ReplicaSelector&) = delete;
+  const ReplicaSelector& operator=(const ReplicaSelector&) = delete;
+
+  ReplicaSelector() = default;
+
+  ~ReplicaSelector() = default;
+
+  // return false when the read should go to the leader
+  bool SelectReadReplica(Region& region, ReplicaReadPolicy policy, EndPoint& end_point);
+
+  // pick the replica a hedged read is duplicated to, never exclude
+  bool SelectHedgeReplica(Region& region, const EndPoint& exclude, EndPoint& end_point);
+
+  // called when a store rpc to end_point finished, failed means network error or store overload
+  void RecordResult(const EndPoint& end_point, int64_t latency_us, bool failed);
+
+  // called by StoreConnectionManager when a health probe of end_point finished, a down endpoint is avoided until a
+  // later probe succeeds or the result expires
+  void RecordProbeResult(const EndPoint& end_point, bool alive);
+
+  bool IsProbeDown(const EndPoint& end_point);
+
+  // return -1 when end_point has no fresh sample
+  int64_t GetLatencyUs(const EndPoint& end_point);
+
+  // return -1 when end_point has no fresh sample
+  double GetErrorRate(const EndPoint& end_point);
+
+  // approximate p95 latency of end_point, return -1 when samples are not enough
+  int64_t GetHedgeDelayUs(const EndPoint& end_point);
+
+ private:
+  struct EndPointStats {
+    std::mutex mutex;
+    LatencyEwma latency;
+    double error_rate{0};
+    int64_t update_time_us{0};
+    bool probe_down{false};
+    int64_t probe_time_us{0};
+  };
+
+  struct Snapshot {
+    double latency_us;
+    int64_t p95_us;
+    double error_rate;
+    int64_t samples;
+  };
+
+  // stats is never erased, so the returned pointer is always valid
+  EndPointStats* FindStats(const EndPoint& end_point);
+  EndPointStats* GetOrCreateStats(const EndPoint& end_point);
+
+  // return false when end_point has no sample or the sample is too old
+  bool GetSnapshot(const EndPoint& end_point, Snapshot& snapshot);
+
+  // lower is better, replica without sample scores 0 so it is probed first
+  double Score(const EndPoint& end_point, bool& unhealthy);
+
+  bool SelectFollowerRoundRobin(const std::vector<Replica>& replicas, EndPoint& end_point);
+
+  bool SelectLowestLatency(const std::vector<Replica>& replicas, const EndPoint* exclude, EndPoint& end_point);
+
+  std::atomic<uint64_t> next_follower_{0};
+
+  // protect the map only, each stats has its own mutex
+  std::shared_mutex rw_lock_;
+  std::map<EndPoint, std::unique_ptr<EndPointStats>> stats_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_REPLICA_SELECTOR_H_
@@ -0,0 +1,95 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/retry_budget.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "sdk/common/metrics.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+constexpr int64_t kMilli = 1000;
+
+int64_t MaxMilliTokens() { return std::max<int64_t>(FLAGS_sdk_retry_budget_max_tokens, 1) * kMilli; }
+}  // namespace
+
+RetryBudget::RetryBudget() : milli_tokens_(MaxMilliTokens()), last_refill_us_(NowUs()) {}
+
+void RetryBudget::RecordRequest() {
+  if (!FLAGS_sdk_retry_budget) {
+    return;
+  }
+
+  AddMilliTokens(static_cast<int64_t>(FLAGS_sdk_retry_budget_ratio * kMilli));
+}
+
+bool RetryBudget::TryRetry() {
+  if (!FLAGS_sdk_retry_budget) {
+    return true;
+  }
+
+  Refill();
+  int64_t current = milli_tokens_.load(std::memory_order_relaxed);
+  while (current >= kMilli) {
+    if (milli_tokens_.compare_exchange_weak(current, current - kMilli, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+
+  Metrics::Global().RecordRetryBudgetExhausted();
+  return false;
+}
+
+int64_t RetryBudget::GetTokens() {
+  Refill();
+  return milli_tokens_.load(std::memory_order_relaxed) / kMilli;
+}
+
+void RetryBudget::Refill() {
+  int64_t now_us = NowUs();
+  int64_t last_us = last_refill_us_.load(std::memory_order_relaxed);
+  // refill at most once per ms, tokens of shorter intervals round down to nothing
+  if (now_us - last_us < 1000 ||
+      !last_refill_us_.compare_exchange_strong(last_us, now_us, std::memory_order_relaxed)) {
+    return;
+  }
+
+  AddMilliTokens(FLAGS_sdk_retry_budget_min_per_second * (now_us - last_us) / 1000);
+}
+
+void RetryBudget::AddMilliTokens(int64_t delta) {
+  if (delta <= 0) {
+    return;
+  }
+
+  int64_t max = MaxMilliTokens();
+  int64_t current = milli_tokens_.load(std::memory_order_relaxed);
+  while (current < max &&
+         !milli_tokens_.compare_exchange_weak(current, std::min(current + delta, max), std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,63 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RETRY_BUDGET_H_
+#define DINGODB_SDK_RETRY_BUDGET_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+// Client wide tokens of retries, shared by store rpc controller and the retry loops of tasks above it, so
+// retries of all layers together stay a fraction of the requests. Every store rpc call deposits
+// FLAGS_sdk_retry_budget_ratio token, FLAGS_sdk_retry_budget_min_per_second tokens are added per second for clients
+// with few requests, and a retry takes one token. At most FLAGS_sdk_retry_budget_max_tokens are saved up.
+// When no token is left the retry is given up and the last error is returned, so a brownout of some stores is not
+// amplified into an outage by retry storms.
+// Reroutes after a leader change or a region change, and retries after resolving txn locks, are expected after
+// every split or leader transfer and never take a token. Lock free, as every store rpc records a request.
+class RetryBudget {
+ public:
+  RetryBudget(const RetryBudget&) = delete;
+  const RetryBudget& operator=(const RetryBudget&) = delete;
+
+  // start with a full budget
+  RetryBudget();
+
+  ~RetryBudget() = default;
+
+  void RecordRequest();
+
+  // take a token for a retry, false when budget is exhausted, always true when FLAGS_sdk_retry_budget is false
+  bool TryRetry();
+
+  int64_t GetTokens();
+
+ private:
+  // add tokens of time elapsed since last refill
+  void Refill();
+
+  // add delta milli tokens, capped by max tokens
+  void AddMilliTokens(int64_t delta);
+
+  // tokens in units of 1/1000 token
+  std::atomic<int64_t> milli_tokens_;
+  std::atomic<int64_t> last_refill_us_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RETRY_BUDGET_H_
@@ -16,10 +16,14 @@
 #define DINGODB_SDK_RPC_H_
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "google/protobuf/message.h"
+#include "sdk/common/tracing.h"
+#include "sdk/request_priority.h"
+#include "sdk/rpc/rpc_compression.h"
 #include "sdk/status.h"
 #include "sdk/utils/callback.h"
 #include "sdk/utils/net_util.h"
@@ -51,6 +55,27 @@ class Rpc {
 
   int GetRetryTimes() const { return retry_times; }
 
+  // sent with the rpc when valid, as log id with brpc and traceparent metadata with grpc
+  void SetTraceContext(const SpanContext& context) { trace_context = context; }
+
+  const SpanContext& GetTraceContext() const { return trace_context; }
+
+  // timeout of the next attempt, e.g. remaining time of the call deadline, 0 means the default timeout, cleared
+  // by Reset
+  void SetTimeoutMs(int64_t p_timeout_ms) { timeout_ms = p_timeout_ms; }
+
+  int64_t GetTimeoutMs() const { return timeout_ms; }
+
+  // priority of the caller, honored by the client concurrency limit, kept by Reset
+  void SetPriority(RequestPriority p_priority) { priority = p_priority; }
+
+  RequestPriority GetPriority() const { return priority; }
+
+  // compression of the request body, set by rpc client on each send
+  void SetCompressType(RpcCompressType p_compress_type) { compress_type = p_compress_type; }
+
+  RpcCompressType GetCompressType() const { return compress_type; }
+
   virtual google::protobuf::Message* RawMutableRequest() = 0;
 
   virtual const google::protobuf::Message* RawRequest() const = 0;
@@ -65,6 +90,9 @@ class Rpc {
 
   virtual std::string Method() const = 0;
 
+  // method name in proto, e.g. KvGet, used by transports calling the method by its descriptor, see FindProtoMethod
+  virtual std::string ProtoMethod() const { return ""; }
+
   virtual void Reset() = 0;
 
   virtual void Call(RpcContext* ctx) = 0;
@@ -73,6 +101,21 @@ class Rpc {
 
   virtual uint64_t LogId() const = 0;
 
+  // new rpc with the same request, used to send duplicated rpc, return nullptr when not supported
+  virtual std::unique_ptr<Rpc> Clone() const { return nullptr; }
+
+  // back to the state of a new rpc, request and response are cleared but keep their memory, see RpcPool
+  virtual void Recycle() {
+    Reset();
+    RawMutableRequest()->Clear();
+    end_point = EndPoint();
+    retry_times = 0;
+    trace_context = SpanContext();
+    priority = kInteractive;
+    compress_type = kRpcCompressNone;
+    call_back = nullptr;
+  }
+
   StatusCallback call_back;
 
  protected:
@@ -80,6 +123,10 @@ class Rpc {
   EndPoint end_point;
   Status status;
   int retry_times{0};
+  SpanContext trace_context;
+  int64_t timeout_ms{0};
+  RequestPriority priority{kInteractive};
+  RpcCompressType compress_type{kRpcCompressNone};
 };
 
 }  // namespace sdk
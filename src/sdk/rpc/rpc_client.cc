@@ -0,0 +1,71 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/rpc_client.h"
+
+#include <string>
+
+#include "common/logging.h"
+#include "google/protobuf/descriptor.h"
+
+#if defined(USE_GRPC) && defined(SDK_WITH_BRPC)
+#include "sdk/rpc/brpc/brpc_generic_rpc_client.h"
+#endif
+
+#if !defined(USE_GRPC) && defined(SDK_WITH_GRPC)
+#include "sdk/rpc/grpc/grpc_generic_rpc_client.h"
+#endif
+
+namespace dingodb {
+namespace sdk {
+
+const char* NativeRpcBackend() {
+#ifdef USE_GRPC
+  return "grpc";
+#else
+  return "brpc";
+#endif
+}
+
+RpcClient* NewRpcClient(const RpcClientOptions& options, const std::string& backend) {
+  if (backend.empty() || backend == NativeRpcBackend()) {
+    return NewRpcClient(options);
+  }
+
+#if defined(USE_GRPC) && defined(SDK_WITH_BRPC)
+  if (backend == "brpc") {
+    return NewBrpcGenericRpcClient(options);
+  }
+#endif
+
+#if !defined(USE_GRPC) && defined(SDK_WITH_GRPC)
+  if (backend == "grpc") {
+    return NewGrpcGenericRpcClient(options);
+  }
+#endif
+
+  DINGO_LOG(WARNING) << "rpc backend " << backend << " is not built in, use " << NativeRpcBackend();
+  return NewRpcClient(options);
+}
+
+const google::protobuf::MethodDescriptor* FindProtoMethod(Rpc& rpc) {
+  std::string method = rpc.ProtoMethod();
+  if (method.empty()) {
+    return nullptr;
+  }
+  return google::protobuf::DescriptorPool::generated_pool()->FindMethodByName(rpc.ServiceFullName() + "." + method);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -15,8 +15,12 @@
 #ifndef DINGODB_SDK_RPC_CLIENT_H_
 #define DINGODB_SDK_RPC_CLIENT_H_
 
+#include <string>
+
+#include "google/protobuf/descriptor.h"
 #include "rpc.h"
 #include "sdk/common/param_config.h"
+#include "sdk/rpc/rpc_compression.h"
 #include "sdk/utils/callback.h"
 
 namespace dingodb {
@@ -26,11 +30,13 @@ struct RpcClientOptions {
   int32_t connect_timeout_ms;
   int32_t timeout_ms;
   int max_retry;
+  RpcCompressOptions compress;
 
   RpcClientOptions()
       : connect_timeout_ms(FLAGS_rpc_channel_timeout_ms),
         timeout_ms(FLAGS_rpc_channel_connect_timeout_ms),
-        max_retry(FLAGS_rpc_max_retry) {}
+        max_retry(FLAGS_rpc_max_retry),
+        compress(RpcCompressOptions::FromFlags()) {}
 };
 
 class RpcClient {
@@ -46,12 +52,31 @@ class RpcClient {
 
   virtual void SendRpc(Rpc &rpc, RpcCallback cb) = 0;
 
+  // create channel to endpoint ahead of the first rpc, connection is started in background if transport supports it
+  virtual void Connect(const EndPoint &endpoint) {}
+
  protected:
+  // called by each send, the request maybe changed between retries
+  void SetCompressType(Rpc &rpc) const {
+    rpc.SetCompressType(m_options.compress.Pick(rpc.Method(), *rpc.RawRequest()));
+  }
+
   RpcClientOptions m_options;
 };
 
+// rpc client of the backend this sdk is built with, brpc or grpc
 RpcClient *NewRpcClient(const RpcClientOptions &options);
 
+// "brpc" or "grpc", the backend of NewRpcClient(options)
+const char *NativeRpcBackend();
+
+// rpc client of backend, empty or the native backend is NewRpcClient(options). The other backend is only there when
+// sdk is built with SDK_ENABLE_ALL_RPC, its client sends any rpc by the proto method, else native one is used.
+RpcClient *NewRpcClient(const RpcClientOptions &options, const std::string &backend);
+
+// descriptor of the proto method of rpc, nullptr when rpc has no ProtoMethod or it is not in the generated pool
+const google::protobuf::MethodDescriptor *FindProtoMethod(Rpc &rpc);
+
 }  // namespace sdk
 }  // namespace dingodb
 #endif  // DINGODB_SDK_RPC_CLIENT_H_
\ No newline at end of file
@@ -0,0 +1,137 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/rpc_compression.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/logging.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+std::vector<std::string> Split(const std::string& value, char delim) {
+  std::vector<std::string> items;
+  std::stringstream ss(value);
+  std::string item;
+  while (std::getline(ss, item, delim)) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+// "IndexService.VectorAddRpc" or "dingodb.pb.index.IndexService.VectorAddRpc" -> "VectorAdd"
+std::string MethodName(const std::string& rpc_method) {
+  auto pos = rpc_method.rfind('.');
+  std::string name = (pos == std::string::npos) ? rpc_method : rpc_method.substr(pos + 1);
+  const std::string suffix = "Rpc";
+  if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+    name.resize(name.size() - suffix.size());
+  }
+  return name;
+}
+}  // namespace
+
+bool ParseRpcCompressType(const std::string& name, RpcCompressType& out_type) {
+  if (name == "none") {
+    out_type = kRpcCompressNone;
+  } else if (name == "snappy") {
+    out_type = kRpcCompressSnappy;
+  } else if (name == "zstd") {
+    out_type = kRpcCompressZstd;
+  } else if (name == "lz4") {
+    out_type = kRpcCompressLz4;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* RpcCompressTypeName(RpcCompressType type) {
+  switch (type) {
+    case kRpcCompressNone:
+      return "none";
+    case kRpcCompressSnappy:
+      return "snappy";
+    case kRpcCompressZstd:
+      return "zstd";
+    case kRpcCompressLz4:
+      return "lz4";
+    default:
+      return "unknown";
+  }
+}
+
+const RpcCompressPolicy& RpcCompressOptions::GetPolicy(const std::string& rpc_method) const {
+  if (method_policies.empty()) {
+    return default_policy;
+  }
+
+  auto iter = method_policies.find(MethodName(rpc_method));
+  return iter != method_policies.end() ? iter->second : default_policy;
+}
+
+RpcCompressType RpcCompressOptions::Pick(const std::string& rpc_method,
+                                         const google::protobuf::Message& request) const {
+  const auto& policy = GetPolicy(rpc_method);
+  if (policy.type == kRpcCompressNone) {
+    return kRpcCompressNone;
+  }
+
+  if (policy.min_bytes > 0 && static_cast<int64_t>(request.ByteSizeLong()) < policy.min_bytes) {
+    return kRpcCompressNone;
+  }
+
+  return policy.type;
+}
+
+RpcCompressOptions RpcCompressOptions::FromFlags() {
+  RpcCompressOptions options;
+  options.default_policy.min_bytes = FLAGS_rpc_compress_min_bytes;
+  if (!ParseRpcCompressType(FLAGS_rpc_compress_type, options.default_policy.type)) {
+    DINGO_LOG(WARNING) << "unknown rpc_compress_type:" << FLAGS_rpc_compress_type << ", use none";
+  }
+
+  // method:type[:min_bytes]
+  for (const auto& item : Split(FLAGS_rpc_compress_methods, ',')) {
+    auto fields = Split(item, ':');
+    RpcCompressPolicy policy;
+    policy.min_bytes = FLAGS_rpc_compress_min_bytes;
+    bool valid = (fields.size() == 2 || fields.size() == 3) && ParseRpcCompressType(fields[1], policy.type);
+    if (valid && fields.size() == 3) {
+      char* end = nullptr;
+      policy.min_bytes = std::strtoll(fields[2].c_str(), &end, 10);
+      valid = end != fields[2].c_str() && *end == '\0' && policy.min_bytes >= 0;
+    }
+
+    if (!valid) {
+      DINGO_LOG(WARNING) << "skip invalid item:" << item << " in rpc_compress_methods";
+      continue;
+    }
+    options.method_policies[fields[0]] = policy;
+  }
+
+  return options;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RPC_COMPRESSION_H_
+#define DINGODB_SDK_RPC_COMPRESSION_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "google/protobuf/message.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Compression of request body. Each transport maps it to the nearest codec it has: brpc has snappy and lz4 and
+// sends zstd as zlib, grpc only has gzip and deflate and sends every type but none as gzip.
+enum RpcCompressType : uint8_t { kRpcCompressNone, kRpcCompressSnappy, kRpcCompressZstd, kRpcCompressLz4 };
+
+// name is one of none, snappy, zstd and lz4, return false when unknown
+bool ParseRpcCompressType(const std::string& name, RpcCompressType& out_type);
+
+const char* RpcCompressTypeName(RpcCompressType type);
+
+struct RpcCompressPolicy {
+  RpcCompressType type{kRpcCompressNone};
+  // requests smaller than this are sent uncompressed, compressing small requests costs more cpu than it saves
+  int64_t min_bytes{0};
+};
+
+// Compress policy of store rpcs, picked by rpc method, e.g. "VectorAdd" of Rpc::Method() "IndexService.VectorAddRpc".
+struct RpcCompressOptions {
+  RpcCompressPolicy default_policy;
+  std::map<std::string, RpcCompressPolicy> method_policies;
+
+  const RpcCompressPolicy& GetPolicy(const std::string& rpc_method) const;
+
+  // compress type of one request, request size is only computed when the policy compresses
+  RpcCompressType Pick(const std::string& rpc_method, const google::protobuf::Message& request) const;
+
+  // default policy from FLAGS_rpc_compress_type and FLAGS_rpc_compress_min_bytes, method policies from
+  // FLAGS_rpc_compress_methods, invalid items are skipped with a warning
+  static RpcCompressOptions FromFlags();
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_RPC_COMPRESSION_H_
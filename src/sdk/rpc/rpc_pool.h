@@ -0,0 +1,101 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RPC_POOL_H_
+#define DINGODB_SDK_RPC_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Free list of rpcs of one type. A batch operation sends one rpc per region, with the pool the rpc goes back when
+// the operation is done, and its request and response are cleared instead of freed, so their repeated fields and
+// strings keep the memory for the next operation. At most FLAGS_rpc_pool_max_size free rpcs are kept per type.
+template <class RpcType>
+class RpcPool {
+ public:
+  struct Recycler {
+    // false for rpcs not from the pool, e.g. those on an arena, they are deleted
+    bool pooled{true};
+
+    void operator()(RpcType* rpc) const {
+      if (pooled) {
+        RpcPool::Release(rpc);
+      } else {
+        delete rpc;
+      }
+    }
+  };
+
+  using Ptr = std::unique_ptr<RpcType, Recycler>;
+
+  static Ptr Acquire() {
+    auto& free_list = GetFreeList();
+    {
+      std::lock_guard<std::mutex> guard(free_list.mutex);
+      if (!free_list.rpcs.empty()) {
+        RpcType* rpc = free_list.rpcs.back();
+        free_list.rpcs.pop_back();
+        return Ptr(rpc);
+      }
+    }
+    return Ptr(new RpcType());
+  }
+
+  // owned by the returned ptr but never pooled
+  static Ptr Adopt(std::unique_ptr<RpcType> rpc) { return Ptr(rpc.release(), Recycler{false}); }
+
+  static size_t FreeSize() {
+    auto& free_list = GetFreeList();
+    std::lock_guard<std::mutex> guard(free_list.mutex);
+    return free_list.rpcs.size();
+  }
+
+ private:
+  struct FreeList {
+    std::mutex mutex;
+    std::vector<RpcType*> rpcs;
+  };
+
+  // never destroyed, rpcs may go back while static objects are destroyed at exit
+  static FreeList& GetFreeList() {
+    static auto* free_list = new FreeList();
+    return *free_list;
+  }
+
+  static void Release(RpcType* rpc) {
+    if (FLAGS_rpc_pool_max_size > 0) {
+      rpc->Recycle();
+
+      auto& free_list = GetFreeList();
+      std::lock_guard<std::mutex> guard(free_list.mutex);
+      if (static_cast<int64_t>(free_list.rpcs.size()) < FLAGS_rpc_pool_max_size) {
+        free_list.rpcs.push_back(rpc);
+        return;
+      }
+    }
+    delete rpc;
+  }
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RPC_POOL_H_
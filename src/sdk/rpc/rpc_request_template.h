@@ -0,0 +1,49 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RPC_REQUEST_TEMPLATE_H_
+#define DINGODB_SDK_RPC_REQUEST_TEMPLATE_H_
+
+#include <memory>
+
+#include "sdk/common/common.h"
+#include "sdk/region.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Common part of a request that fans out to many regions, e.g. search parameter, target vectors
+// and coprocessor. It is encoded once, and every region request copies it and only fills its context.
+template <class Request>
+class RequestTemplate {
+ public:
+  RequestTemplate() = default;
+
+  Request* Mutable() { return &request_; }
+
+  const Request& Get() const { return request_; }
+
+  void FillRequest(Request* request, const std::shared_ptr<Region>& region) const {
+    request->CopyFrom(request_);
+    FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
+  }
+
+ private:
+  Request request_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RPC_REQUEST_TEMPLATE_H_
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/store_connection_manager.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/utils/async_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+std::map<EndPoint, std::shared_ptr<Region>> StoreConnectionManager::CollectEndPoints(
+    const std::vector<std::shared_ptr<Region>>& regions) {
+  std::map<EndPoint, std::shared_ptr<Region>> end_points;
+  for (const auto& region : regions) {
+    for (const auto& end_point : region->ReplicaEndPoint()) {
+      end_points.emplace(end_point, region);
+    }
+  }
+  return end_points;
+}
+
+void StoreConnectionManager::ProbeOnce(int64_t& out_down) {
+  out_down = 0;
+  auto end_points = CollectEndPoints(stub_.GetMetaCache()->ListRegions());
+  if (end_points.empty()) {
+    return;
+  }
+
+  auto rpc_client = stub_.GetStoreRpcClient();
+  std::vector<std::unique_ptr<KvGetRpc>> rpcs;
+  rpcs.reserve(end_points.size());
+  for (const auto& [end_point, region] : end_points) {
+    rpc_client->Connect(end_point);
+
+    // any answer even an error of store means the store is serving, so a cheap read of region start key is enough
+    auto rpc = std::make_unique<KvGetRpc>();
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+    rpc->MutableRequest()->set_key(region->Range().start_key());
+    rpc->SetEndPoint(end_point);
+    rpc->SetTimeoutMs(FLAGS_store_connection_probe_timeout_ms);
+    rpc->SetPriority(kBackground);
+    rpcs.push_back(std::move(rpc));
+  }
+
+  CountDownSync sync(rpcs.size());
+  std::atomic<int64_t> down{0};
+  auto selector = stub_.GetReplicaSelector();
+  for (auto& rpc : rpcs) {
+    KvGetRpc* probe = rpc.get();
+    rpc_client->SendRpc(*probe, [probe, selector, &down, &sync]() {
+      Status s = probe->GetStatus();
+      if (!s.ok()) {
+        down.fetch_add(1, std::memory_order_relaxed);
+        DINGO_LOG(WARNING) << fmt::format("store endpoint:{} probe fail, status:{}", probe->GetEndPoint().ToString(),
+                                          s.ToString());
+      }
+      selector->RecordProbeResult(probe->GetEndPoint(), s.ok());
+      sync.CountDown();
+    });
+  }
+  sync.Wait();
+
+  out_down = down.load(std::memory_order_relaxed);
+}
+
+void StoreConnectionManager::Start() {
+  if (FLAGS_store_connection_probe_interval_ms <= 0) {
+    return;
+  }
+  // first round at once, so connections are ready for the first user rpcs
+  ScheduleNext(0);
+}
+
+void StoreConnectionManager::ScheduleNext(int64_t delay_ms) {
+  if (IsStopped()) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [self] {
+        if (self->IsStopped()) {
+          return;
+        }
+        int64_t down = 0;
+        self->ProbeOnce(down);
+        self->ScheduleNext(FLAGS_store_connection_probe_interval_ms);
+      },
+      delay_ms);
+  if (!scheduled) {
+    DINGO_LOG(WARNING) << "Fail schedule store connection probe";
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
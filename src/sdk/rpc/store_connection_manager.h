@@ -0,0 +1,68 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_STORE_CONNECTION_MANAGER_H_
+#define DINGODB_SDK_STORE_CONNECTION_MANAGER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "sdk/region.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// keep connections to the store endpoints of regions held in meta cache, when
+// FLAGS_store_connection_probe_interval_ms > 0 each endpoint is connected ahead of user rpcs and probed in actuator,
+// the probe result is published to ReplicaSelector, so a down store is avoided before user rpcs time out on it.
+// NOTE: client stub must outlive the manager
+class StoreConnectionManager : public std::enable_shared_from_this<StoreConnectionManager> {
+ public:
+  StoreConnectionManager(const StoreConnectionManager&) = delete;
+  const StoreConnectionManager& operator=(const StoreConnectionManager&) = delete;
+
+  explicit StoreConnectionManager(const ClientStub& stub) : stub_(stub) {}
+
+  ~StoreConnectionManager() = default;
+
+  // one round of connect and probe, wait all probes finish, out_down is the count of endpoints not answered
+  void ProbeOnce(int64_t& out_down);
+
+  // start periodic probe, no-op when probe is disabled
+  void Start();
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  bool IsStopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // each replica endpoint of regions with one region it serves, the probe is sent in context of that region
+  static std::map<EndPoint, std::shared_ptr<Region>> CollectEndPoints(
+      const std::vector<std::shared_ptr<Region>>& regions);
+
+ private:
+  void ScheduleNext(int64_t delay_ms);
+
+  const ClientStub& stub_;
+  std::atomic<bool> stopped_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_STORE_CONNECTION_MANAGER_H_
@@ -13,6 +13,12 @@
 // limitations under the License.
 #include "sdk/rpc/store_rpc_controller.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
 #include <string>
 #include <utility>
 
@@ -21,7 +27,11 @@
 #include "glog/logging.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/common.h"
+#include "sdk/common/hot_spot_detector.h"
+#include "sdk/common/metrics.h"
 #include "sdk/common/param_config.h"
+#include "sdk/common/slow_log.h"
+#include "sdk/common/tracing.h"
 #include "proto/common.pb.h"
 #include "sdk/status.h"
 #include "sdk/utils/async_util.h"
@@ -29,6 +39,30 @@
 namespace dingodb {
 namespace sdk {
 
+namespace {
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+// Shared by the two attempts of a hedged rpc, both are clones of rpc_ so the
+// loser can still be in flight after the caller got the answer and freed rpc_.
+// It is freed when the timer and every sent attempt released it.
+struct StoreRpcController::HedgeState {
+  const ClientStub* stub;
+  // only touched by the winner, valid until the controller callback is fired
+  StoreRpcController* controller;
+  std::unique_ptr<Rpc> rpcs[2];
+  int64_t send_time_us[2]{0, 0};
+
+  std::mutex mutex;
+  bool sent[2]{false, false};
+  bool finished[2]{false, false};
+  bool done{false};
+  int refs{0};
+};
+
 StoreRpcController::StoreRpcController(const ClientStub& stub, Rpc& rpc, std::shared_ptr<Region> region)
     : stub_(stub), rpc_(rpc), region_(std::move(region)), rpc_retry_times_(0), next_replica_index_(0) {}
 
@@ -48,15 +82,49 @@ Status StoreRpcController::Call() {
 
 void StoreRpcController::AsyncCall(StatusCallback cb) {
   call_back_.swap(cb);
+  parent_context_ = Tracer::CurrentContext();
+  retry_delay_ms_ = 0;
+  breaker_waited_ = false;
+  memory_waited_ms_ = 0;
+  slow_log_ = SlowLog::CurrentRecorder();
+  cancel_token_ = CancelToken::Current();
+  priority_ = CurrentRequestPriority();
+  // retries of a call are not counted again
+  HotSpotDetector::Global().RecordRegion(region_->RegionId());
+  stub_.GetRetryBudget()->RecordRequest();
+  attempt_start_us_ = NowUs();
   DoAsyncCall();
 }
 
 void StoreRpcController::DoAsyncCall() {
+  if (cancel_token_ != nullptr) {
+    Status s = cancel_token_->Check();
+    if (!s.ok()) {
+      DINGO_LOG(INFO) << "store rpc stop, status:" << s.ToString() << ", region:" << region_->RegionId()
+                      << ", retry_times:" << rpc_retry_times_ << ", last status:" << status_.ToString();
+      status_ = s;
+      FireCallback();
+      return;
+    }
+  }
+
   if (!PreCheck()) {
     FireCallback();
     return;
   }
 
+  if (!AdmitByBreaker()) {
+    return;
+  }
+
+  if (!AdmitByWriteRate()) {
+    return;
+  }
+
+  if (!AdmitByMemory()) {
+    return;
+  }
+
   if (!PrepareRpc()) {
     FireCallback();
     return;
@@ -75,8 +143,121 @@ bool StoreRpcController::PreCheck() {
   return true;
 }
 
+bool StoreRpcController::AdmitByBreaker() {
+  int64_t retry_after_ms = 0;
+  auto admit = stub_.GetRegionCircuitBreaker()->Admit(region_->RegionId(), retry_after_ms);
+  if (admit != RegionCircuitBreaker::kRejected) {
+    return true;
+  }
+
+  int64_t remaining_ms = cancel_token_ != nullptr ? cancel_token_->RemainingMs() : -1;
+  if (!breaker_waited_ && retry_after_ms <= FLAGS_store_rpc_breaker_max_wait_ms &&
+      (remaining_ms < 0 || remaining_ms > retry_after_ms)) {
+    breaker_waited_ = true;
+    DINGO_LOG(DEBUG) << "region:" << region_->RegionId() << " breaker open, wait " << retry_after_ms << "ms";
+    ScopedRequestPriority scope(priority_);
+    stub_.GetActuator()->Schedule([this] { DoAsyncCall(); }, retry_after_ms);
+    return false;
+  }
+
+  std::string msg = fmt::format("region:{} breaker open, retry after:{}ms, last status:{}", region_->RegionId(),
+                                retry_after_ms, status_.ToString());
+  DINGO_LOG(INFO) << "store rpc fail fast, " << msg;
+  status_ = Status::ServiceUnavailable(msg);
+  FireCallback();
+  return false;
+}
+
+bool StoreRpcController::AdmitByWriteRate() {
+  if (!write_rate_limit_ || !FLAGS_store_write_rate_limit || write_rate_waited_) {
+    write_rate_waited_ = false;
+    return true;
+  }
+
+  int64_t wait_ms = stub_.GetWriteRateLimiter()->Acquire(region_->RegionId(), write_rate_index_id_,
+                                                         rpc_.RawRequest()->ByteSizeLong());
+  if (wait_ms <= 0) {
+    return true;
+  }
+  if (cancel_token_ != nullptr && cancel_token_->RemainingMs() >= 0) {
+    // wake up at the deadline at the latest, the attempt fails fast then
+    wait_ms = std::min(wait_ms, cancel_token_->RemainingMs());
+  }
+
+  write_rate_waited_ = true;
+  DINGO_LOG(DEBUG) << "region:" << region_->RegionId() << " write rate reached, wait " << wait_ms << "ms";
+  ScopedRequestPriority scope(priority_);
+  stub_.GetActuator()->Schedule([this] { DoAsyncCall(); }, wait_ms);
+  return false;
+}
+
+bool StoreRpcController::AdmitByMemory() {
+  if (memory_charged_bytes_ > 0) {
+    // charged by previous attempt
+    return true;
+  }
+
+  // never charge 0, so a charged call is told by memory_charged_bytes_
+  int64_t bytes = std::max<int64_t>(rpc_.RawRequest()->ByteSizeLong(), 1);
+  if (stub_.GetMemoryBudget()->TryCharge(bytes)) {
+    memory_charged_bytes_ = bytes;
+    return true;
+  }
+
+  int64_t delay_ms = std::max<int64_t>(FLAGS_sdk_memory_budget_retry_ms, 1);
+  int64_t remaining_ms = cancel_token_ != nullptr ? cancel_token_->RemainingMs() : -1;
+  if (memory_waited_ms_ + delay_ms <= FLAGS_sdk_memory_budget_max_wait_ms &&
+      (remaining_ms < 0 || remaining_ms > delay_ms)) {
+    if (memory_waited_ms_ == 0) {
+      Metrics::Global().RecordMemoryBudgetWait(false);
+    }
+    memory_waited_ms_ += delay_ms;
+    ScopedRequestPriority scope(priority_);
+    stub_.GetActuator()->Schedule([this] { DoAsyncCall(); }, delay_ms);
+    return false;
+  }
+
+  Metrics::Global().RecordMemoryBudgetWait(true);
+  std::string msg = fmt::format("rpc:{} region:{} memory budget exhausted, used:{} request:{} waited:{}ms",
+                                rpc_.Method(), region_->RegionId(), stub_.GetMemoryBudget()->UsedBytes(), bytes,
+                                memory_waited_ms_);
+  DINGO_LOG(WARNING) << "store rpc fail fast, " << msg;
+  status_ = Status::ServiceUnavailable(msg);
+  FireCallback();
+  return false;
+}
+
+void StoreRpcController::ChargeResponseMemory() {
+  if (memory_charged_bytes_ == 0) {
+    return;
+  }
+
+  int64_t bytes = rpc_.GetStatus().ok() ? rpc_.RawResponse()->ByteSizeLong() : 0;
+  int64_t delta = bytes - memory_response_bytes_;
+  if (delta > 0) {
+    stub_.GetMemoryBudget()->ForceCharge(delta);
+  } else if (delta < 0) {
+    stub_.GetMemoryBudget()->Release(-delta);
+  }
+  memory_response_bytes_ = bytes;
+  memory_charged_bytes_ += delta;
+}
+
+void StoreRpcController::ReleaseMemory() {
+  if (memory_charged_bytes_ == 0) {
+    return;
+  }
+
+  stub_.GetMemoryBudget()->Release(memory_charged_bytes_);
+  memory_charged_bytes_ = 0;
+  memory_response_bytes_ = 0;
+}
+
 bool StoreRpcController::PrepareRpc() {
-  if (NeedPickLeader()) {
+  EndPoint read_replica;
+  if (rpc_retry_times_ == 0 && PickReadReplica(read_replica)) {
+    rpc_.SetEndPoint(read_replica);
+  } else if (NeedPickLeader()) {
     EndPoint next_leader;
     if (!PickNextLeader(next_leader)) {
       std::string msg = fmt::format("rpc:{} no valid endpoint, region:{}", rpc_.Method(), region_->RegionId());
@@ -89,99 +270,309 @@ bool StoreRpcController::PrepareRpc() {
   }
 
   rpc_.Reset();
+  rpc_.SetPriority(priority_);
+  if (cancel_token_ != nullptr && cancel_token_->RemainingMs() > 0) {
+    rpc_.SetTimeoutMs(std::min(cancel_token_->RemainingMs(), FLAGS_rpc_time_out_ms));
+  }
 
   return true;
 }
 
 void StoreRpcController::SendStoreRpc() {
   CHECK(region_.get() != nullptr) << "region should not nullptr, please check";
-  MaybeDelay();
+  send_time_us_ = NowUs();
+  hedged_ = false;
+  attempt_span_ = Tracer::Global().StartChildSpan(rpc_.Method(), parent_context_);
+  if (attempt_span_.IsRecording()) {
+    attempt_span_.SetAttribute("region_id", region_->RegionId());
+    attempt_span_.SetAttribute("attempt", rpc_retry_times_);
+    attempt_span_.SetAttribute("backoff_ms", retry_delay_ms_);
+    rpc_.SetTraceContext(attempt_span_.Context());
+  }
+  if (MaybeSendHedgedStoreRpc()) {
+    return;
+  }
   stub_.GetStoreRpcClient()->SendRpc(rpc_, [this] { SendStoreRpcCallBack(); });
 }
 
-void StoreRpcController::MaybeDelay() {
-  if (NeedDelay()) {
-    auto delay = FLAGS_store_rpc_retry_delay_ms * rpc_retry_times_;
-    DINGO_LOG(INFO) << "try to delay:" << delay << "ms, rpr_retry_times:" << rpc_retry_times_;
-    (void)usleep(delay*1000);
+bool StoreRpcController::MaybeSendHedgedStoreRpc() {
+  if (rpc_retry_times_ != 0 || pinned_end_point_.IsValid()) {
+    return false;
+  }
+
+  auto selector = stub_.GetReplicaSelector();
+  int64_t delay_us = hedge_delay_us_;
+  if (delay_us < 0) {
+    // only replica read can be duplicated, the answer of any replica is acceptable
+    if (!FLAGS_store_rpc_hedge || replica_read_policy_ == kLeaderOnly) {
+      return false;
+    }
+    delay_us = selector->GetHedgeDelayUs(rpc_.GetEndPoint());
+  }
+
+  EndPoint hedge_end_point;
+  if (delay_us < 0 || !selector->SelectHedgeReplica(*region_, rpc_.GetEndPoint(), hedge_end_point)) {
+    return false;
+  }
+
+  auto* state = new HedgeState();
+  state->rpcs[0] = rpc_.Clone();
+  state->rpcs[1] = rpc_.Clone();
+  if (state->rpcs[0] == nullptr || state->rpcs[1] == nullptr) {
+    delete state;
+    return false;
+  }
+
+  state->stub = &stub_;
+  state->controller = this;
+  state->rpcs[0]->SetEndPoint(rpc_.GetEndPoint());
+  state->rpcs[0]->Reset();
+  state->rpcs[1]->SetEndPoint(hedge_end_point);
+  state->rpcs[1]->Reset();
+  state->rpcs[0]->SetTraceContext(rpc_.GetTraceContext());
+  state->rpcs[1]->SetTraceContext(rpc_.GetTraceContext());
+  state->rpcs[0]->SetTimeoutMs(rpc_.GetTimeoutMs());
+  state->rpcs[1]->SetTimeoutMs(rpc_.GetTimeoutMs());
+  state->rpcs[0]->SetPriority(priority_);
+  state->rpcs[1]->SetPriority(priority_);
+  attempt_span_.SetAttribute("hedge_endpoint", hedge_end_point.ToString());
+  // one for the timer, one for the primary attempt
+  state->refs = 2;
+  state->sent[0] = true;
+  hedged_ = true;
+
+  int64_t delay_ms = std::max<int64_t>((delay_us + 999) / 1000, FLAGS_store_rpc_hedge_min_delay_ms);
+  DINGO_LOG(DEBUG) << "hedge store rpc:" << rpc_.Method() << " primary:" << rpc_.GetEndPoint().ToString()
+                   << " hedge:" << hedge_end_point.ToString() << " after:" << delay_ms << "ms";
+
+  // NOTE: the primary may finish and free this controller inside SendRpc, never touch this after it
+  ScopedRequestPriority scope(priority_);
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [state] {
+        SendHedgeAttempt(state, 1);
+        ReleaseHedgeState(state);
+      },
+      delay_ms);
+  if (!scheduled) {
+    // nothing else holds state yet
+    state->refs--;
+  }
+
+  state->send_time_us[0] = NowUs();
+  state->stub->GetStoreRpcClient()->SendRpc(*state->rpcs[0], [state] { HedgeAttemptDone(state, 0); });
+  return true;
+}
+
+void StoreRpcController::SendHedgeAttempt(HedgeState* state, int index) {
+  {
+    std::lock_guard<std::mutex> guard(state->mutex);
+    if (state->done) {
+      return;
+    }
+    state->sent[index] = true;
+    state->send_time_us[index] = NowUs();
+    state->refs++;
+  }
+
+  state->stub->GetStoreRpcClient()->SendRpc(*state->rpcs[index], [state, index] { HedgeAttemptDone(state, index); });
+}
+
+void StoreRpcController::HedgeAttemptDone(HedgeState* state, int index) {
+  Rpc& rpc = *state->rpcs[index];
+  Status sent = rpc.GetStatus();
+  auto errcode = sent.ok() ? GetRpcResponseError(rpc).errcode() : pb::error::Errno::OK;
+  bool success = sent.ok() && errcode == pb::error::Errno::OK;
+  // the loser is recorded too, so a slow store is known even when the hedge saved the request
+  state->stub->GetReplicaSelector()->RecordResult(rpc.GetEndPoint(), NowUs() - state->send_time_us[index],
+                                                  !sent.ok() || errcode == pb::error::Errno::EREQUEST_FULL);
+
+  StoreRpcController* winner = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(state->mutex);
+    state->finished[index] = true;
+    int other = 1 - index;
+    bool other_pending = state->sent[other] && !state->finished[other];
+    // first success wins, an error only wins when nothing else can answer
+    if (!state->done && (success || !other_pending)) {
+      state->done = true;
+      winner = state->controller;
+    }
+  }
+
+  if (winner != nullptr) {
+    winner->rpc_.SetEndPoint(rpc.GetEndPoint());
+    winner->rpc_.RawMutableResponse()->CopyFrom(*rpc.RawResponse());
+    winner->rpc_.SetStatus(sent);
+    winner->SendStoreRpcCallBack();
+  }
+
+  ReleaseHedgeState(state);
+}
+
+void StoreRpcController::ReleaseHedgeState(HedgeState* state) {
+  bool last = false;
+  {
+    std::lock_guard<std::mutex> guard(state->mutex);
+    last = (--state->refs == 0);
+  }
+
+  if (last) {
+    delete state;
   }
 }
 
 void StoreRpcController::SendStoreRpcCallBack() {
+  int64_t answered_us = NowUs();
+  retry_with_new_region_ = false;
   Status sent = rpc_.GetStatus();
+  if (FLAGS_enable_sdk_metrics) {
+    int32_t errcode = sent.ok() ? GetRpcResponseError(rpc_).errcode() : Metrics::kNetworkErrorCode;
+    Metrics::Global().RecordRpc(rpc_, NowUs() - send_time_us_, errcode);
+  }
   if (!sent.ok()) {
-    region_->MarkFollower(rpc_.GetEndPoint());
-    DINGO_LOG(WARNING) << "Fail connect to store server, status:" << sent.ToString();
+    // remote error here means the rpc is rejected by client concurrency limit, see ConcurrencyLimiter
+    if (!sent.IsRemoteError()) {
+      region_->MarkFollower(rpc_.GetEndPoint());
+    }
+    DINGO_LOG_EVERY_SECOND(WARNING) << "Fail connect to store server, status:" << sent.ToString();
     status_ = sent;
   } else {
     auto error = GetRpcResponseError(rpc_);
     if (error.errcode() == pb::error::Errno::OK) {
       status_ = Status::OK();
     } else {
-      std::string base_msg =
-          fmt::format("log_id:{} region:{} method:{} endpoint:{}, error_code:{}, error_msg:{}", rpc_.LogId(),
-                      region_->RegionId(), rpc_.Method(), rpc_.GetEndPoint().ToString(),
-                      dingodb::pb::error::Errno_Name(error.errcode()), error.errmsg());
+      // only formatted when logged, error logs are rate limited
+      auto base_msg = [&] {
+        return fmt::format("log_id:{} region:{} method:{} endpoint:{}, error_code:{}, error_msg:{}", rpc_.LogId(),
+                           region_->RegionId(), rpc_.Method(), rpc_.GetEndPoint().ToString(),
+                           dingodb::pb::error::Errno_Name(error.errcode()), error.errmsg());
+      };
 
       if (error.errcode() == pb::error::Errno::ERAFT_NOTLEADER) {
         region_->MarkFollower(rpc_.GetEndPoint());
         if (error.has_leader_location()) {
           auto endpoint = LocationToEndPoint(error.leader_location());
           if (!endpoint.IsValid()) {
-            DINGO_LOG(WARNING) << base_msg << " not leader, but leader hint:" << error.leader_location().DebugString()
-                               << ", endpoint: " << endpoint.ToString() << " is invalid";
+            DINGO_LOG_EVERY_SECOND(WARNING) << base_msg()
+                                            << " not leader, but leader hint:" << error.leader_location().DebugString()
+                                            << ", endpoint: " << endpoint.ToString() << " is invalid";
             status_ = Status::NoLeader(error.errcode(), error.errmsg());
           } else {
             region_->MarkLeader(endpoint);
-            DINGO_LOG(WARNING) << base_msg << " not leader, leader hint:" << endpoint.ToString();
+            DINGO_LOG_EVERY_SECOND(WARNING) << base_msg() << " not leader, leader hint:" << endpoint.ToString();
             status_ = Status::NotLeader(error.errcode(), error.errmsg());
           }
         } else {
-          DINGO_LOG(WARNING) << base_msg << " not leader, no leader hint";
+          DINGO_LOG_EVERY_SECOND(WARNING) << base_msg() << " not leader, no leader hint";
           status_ = Status::NoLeader(error.errcode(), error.errmsg());
         }
-      } else if (error.errcode() == pb::error::EREGION_VERSION) {
+      } else if (error.errcode() == pb::error::EREGION_VERSION ||
+                 error.errcode() == pb::error::Errno::EKEY_OUT_OF_RANGE) {
         stub_.GetMetaCache()->ClearRange(region_);
-        if (error.has_store_region_info()) {
-          auto region = ProcessStoreRegionInfo(error.store_region_info());
+        const auto& info = error.store_region_info();
+        if (error.has_store_region_info() && info.region_id() == region_->RegionId() &&
+            info.has_current_region_epoch() && info.has_current_range()) {
+          // no coordinator lookup is needed for the new region
+          auto region = ProcessStoreRegionInfo(info);
           stub_.GetMetaCache()->MaybeAddRegion(region);
-          DINGO_LOG(WARNING) << base_msg << ", recive new version region:" << region->ToString();
+          DINGO_LOG_EVERY_SECOND(WARNING) << base_msg() << ", recive new version region:" << region->ToString();
+          retry_with_new_region_ = MaybeResetToNewRegion(region);
         } else {
-          DINGO_LOG(WARNING) << base_msg;
+          DINGO_LOG_EVERY_SECOND(WARNING) << base_msg();
         }
         status_ = Status::Incomplete(error.errcode(), error.errmsg());
       } else if (error.errcode() == pb::error::Errno::EREGION_NOT_FOUND) {
         stub_.GetMetaCache()->ClearRange(region_);
         status_ = Status::Incomplete(error.errcode(), error.errmsg());
-        DINGO_LOG(WARNING) << base_msg;
-      } else if (error.errcode() == pb::error::Errno::EKEY_OUT_OF_RANGE) {
-        stub_.GetMetaCache()->ClearRange(region_);
-        status_ = Status::Incomplete(error.errcode(), error.errmsg());
-        DINGO_LOG(WARNING) << base_msg;
+        DINGO_LOG_EVERY_SECOND(WARNING) << base_msg();
       } else if (error.errcode() == pb::error::Errno::EREQUEST_FULL) {
         status_ = Status::RemoteError(error.errcode(), error.errmsg());
-        DINGO_LOG(WARNING) << base_msg;
+        DINGO_LOG_EVERY_SECOND(WARNING) << base_msg();
       } else {
         // NOTE: other error we not clean cache, caller decide how to process
         status_ = Status::Incomplete(error.errcode(), error.errmsg());
-        DINGO_LOG(WARNING) << base_msg;
+        DINGO_LOG_EVERY_SECOND(WARNING) << base_msg();
       }
     }
   }
 
+  ChargeResponseMemory();
+  RecordRpcResult();
+  if (write_rate_limit_ && FLAGS_store_write_rate_limit) {
+    bool slow = FLAGS_store_write_rate_slow_ms > 0 && NowUs() - send_time_us_ > FLAGS_store_write_rate_slow_ms * 1000;
+    // remote error is a busy store or the client concurrency limit of it
+    stub_.GetWriteRateLimiter()->RecordResult(region_->RegionId(), write_rate_index_id_,
+                                              status_.IsRemoteError() || status_.IsNetworkError() || slow);
+  }
+  stub_.GetRegionCircuitBreaker()->RecordResult(region_->RegionId(),
+                                                status_.IsNoLeader() || status_.IsNetworkError());
+  if (attempt_span_.IsRecording()) {
+    attempt_span_.SetAttribute("endpoint", rpc_.GetEndPoint().ToString());
+    attempt_span_.SetAttribute("log_id", static_cast<int64_t>(rpc_.LogId()));
+    attempt_span_.SetStatus(status_);
+    attempt_span_.End();
+  }
+  if (slow_log_ != nullptr) {
+    SlowLogRpc record;
+    record.region_id = region_->RegionId();
+    record.method = rpc_.Method();
+    record.end_point = rpc_.GetEndPoint().ToString();
+    record.attempt = rpc_retry_times_;
+    record.send_us = send_time_us_;
+    record.queue_us = send_time_us_ - attempt_start_us_;
+    record.latency_us = answered_us - send_time_us_;
+    record.response_us = NowUs() - answered_us;
+    record.request_bytes = rpc_.RawRequest()->ByteSizeLong();
+    record.response_bytes = rpc_.RawResponse()->ByteSizeLong();
+    record.status = status_.ToString();
+    slow_log_->AddRpc(std::move(record));
+  }
   RetrySendRpcOrFireCallback();
 }
 
+void StoreRpcController::RecordRpcResult() {
+  if (hedged_) {
+    return;
+  }
+
+  // network error and store overload make the store less attractive for replica read
+  bool failed = status_.IsNetworkError() || status_.IsRemoteError();
+  stub_.GetReplicaSelector()->RecordResult(rpc_.GetEndPoint(), NowUs() - send_time_us_, failed);
+}
+
 void StoreRpcController::RetrySendRpcOrFireCallback() {
   if (status_.IsOK()) {
     FireCallback();
     return;
   }
 
-  if (status_.IsNetworkError() || status_.IsRemoteError() || status_.IsNotLeader() || status_.IsNoLeader()) {
-    if (NeedRetry()) {
+  if (status_.IsNetworkError() || status_.IsRemoteError() || status_.IsNotLeader() || status_.IsNoLeader() ||
+      retry_with_new_region_) {
+    // resend to the new leader or to the new region of a split is a reroute, not charged to the retry budget
+    bool reroute = status_.IsNotLeader() || retry_with_new_region_;
+    if (NeedRetry() && !reroute && !stub_.GetRetryBudget()->TryRetry()) {
+      DINGO_LOG_EVERY_SECOND(WARNING) << "retry budget exhausted, give up retry, region:" << region_->RegionId()
+                                      << ", rpc_retry_times:" << rpc_retry_times_ << ", status:" << status_.ToString();
+      FireCallback();
+    } else if (NeedRetry()) {
       rpc_retry_times_++;
-      DoAsyncCall();
+      attempt_start_us_ = NowUs();
+      if (NeedDelay()) {
+        // NOTE: never sleep here, this maybe run in rpc callback thread
+        auto delay = NextRetryDelayMs();
+        if (cancel_token_ != nullptr && cancel_token_->RemainingMs() >= 0) {
+          // wake up at the deadline at the latest, the next attempt fails fast then
+          delay = std::min(delay, cancel_token_->RemainingMs());
+        }
+        retry_delay_ms_ = delay;
+        DINGO_LOG_EVERY_SECOND(INFO) << "schedule retry after:" << delay << "ms, rpc_retry_times:" << rpc_retry_times_
+                                     << ", status:" << status_.ToString();
+        ScopedRequestPriority scope(priority_);
+        stub_.GetActuator()->Schedule([this] { DoAsyncCall(); }, delay);
+      } else {
+        retry_delay_ms_ = 0;
+        DoAsyncCall();
+      }
     } else {
       status_ = Status::Aborted("rpc retry times exceed");
       FireCallback();
@@ -194,13 +585,19 @@ void StoreRpcController::RetrySendRpcOrFireCallback() {
 
 void StoreRpcController::FireCallback() {
   if (!status_.ok()) {
-    DINGO_LOG(WARNING) << "Fail send store rpc status:" << status_.ToString() << ", region:" << region_->RegionId()
-                       << ", retry_times:" << rpc_retry_times_ << ", max_retry_limit:" << FLAGS_store_rpc_max_retry;
+    DINGO_LOG_EVERY_SECOND(WARNING) << "Fail send store rpc status:" << status_.ToString()
+                                    << ", region:" << region_->RegionId() << ", retry_times:" << rpc_retry_times_
+                                    << ", max_retry_limit:" << FLAGS_store_rpc_max_retry;
   }
 
+  // the caller copies what it needs out of the response in callback, and may destroy controller there
+  ReleaseMemory();
+
   if (call_back_) {
     StatusCallback cb;
     call_back_.swap(cb);
+    // usually in rpc callback thread, what the caller does next stays at its priority
+    ScopedRequestPriority scope(priority_);
     cb(status_);
   }
 }
@@ -214,9 +611,15 @@ bool StoreRpcController::PickNextLeader(EndPoint& leader) {
   }
 
   // TODO: filter old leader
-  auto endpoints = region_->ReplicaEndPoint();
+  const auto& endpoints = region_->ReplicaEndPoint();
   auto endpoint = endpoints[next_replica_index_ % endpoints.size()];
   next_replica_index_++;
+  // skip replicas found down by health probe, unless all of them are
+  auto selector = stub_.GetReplicaSelector();
+  for (size_t i = 1; i < endpoints.size() && selector->IsProbeDown(endpoint); ++i) {
+    endpoint = endpoints[next_replica_index_ % endpoints.size()];
+    next_replica_index_++;
+  }
   leader = endpoint;
   std::string msg =
       fmt::format("region:{} get leader fail, pick replica:{} as leader", region_->RegionId(), endpoint.ToString());
@@ -224,6 +627,19 @@ bool StoreRpcController::PickNextLeader(EndPoint& leader) {
   return true;
 }
 
+bool StoreRpcController::PickReadReplica(EndPoint& end_point) {
+  if (pinned_end_point_.IsValid()) {
+    end_point = pinned_end_point_;
+    return true;
+  }
+
+  if (replica_read_policy_ == kLeaderOnly) {
+    return false;
+  }
+
+  return stub_.GetReplicaSelector()->SelectReadReplica(*region_, replica_read_policy_, end_point);
+}
+
 void StoreRpcController::ResetRegion(std::shared_ptr<Region> region) {
   if (region_) {
     if (!(EpochCompare(region_->Epoch(), region->Epoch()) > 0)) {
@@ -235,6 +651,30 @@ void StoreRpcController::ResetRegion(std::shared_ptr<Region> region) {
   region_ = std::move(region);
 }
 
+bool StoreRpcController::MaybeResetToNewRegion(const std::shared_ptr<Region>& new_region) {
+  // keys of request are in the range of old region, so they are all in the new region when its range covers the old
+  // one, e.g. only conf version changed or the region merged others. after a split the region keeps part of its range,
+  // a single key request is switched when its key stays in that part, other keys are left to caller to regroup since
+  // the region holding them is only known by a lookup
+  const auto& old_range = region_->Range();
+  const auto& new_range = new_region->Range();
+  if (new_range.start_key() > old_range.start_key() || new_range.end_key() < old_range.end_key()) {
+    std::string key;
+    if (!GetRpcRequestKey(rpc_, key) || key < new_range.start_key() || key >= new_range.end_key()) {
+      return false;
+    }
+  }
+
+  auto* context = GetRpcRequestContext(rpc_);
+  if (context == nullptr || context->region_id() != new_region->RegionId()) {
+    return false;
+  }
+
+  *context->mutable_region_epoch() = new_region->Epoch();
+  ResetRegion(new_region);
+  return true;
+}
+
 std::shared_ptr<Region> StoreRpcController::ProcessStoreRegionInfo(
     const dingodb::pb::error::StoreRegionInfo& store_region_info) {
   CHECK_NOTNULL(region_);
@@ -267,6 +707,21 @@ bool StoreRpcController::NeedRetry() const { return this->rpc_retry_times_ < FLA
 
 bool StoreRpcController::NeedDelay() const { return status_.IsRemoteError() || status_.IsNoLeader(); }
 
+int64_t StoreRpcController::NextRetryDelayMs() const {
+  // no leader means raft election is in progress, wait longer than server busy
+  int64_t base_ms =
+      status_.IsNoLeader() ? FLAGS_store_rpc_retry_delay_ms : FLAGS_store_rpc_request_full_retry_delay_ms;
+  int64_t max_ms = std::max(base_ms, FLAGS_store_rpc_retry_max_delay_ms);
+
+  int shift = std::min(std::max(rpc_retry_times_ - 1, 0), 16);
+  int64_t delay_ms = std::min(base_ms << shift, max_ms);
+
+  // full jitter in [delay/2, delay] to avoid retry storms from concurrent requests
+  static thread_local std::mt19937_64 gen(std::random_device{}());
+  std::uniform_int_distribution<int64_t> dist(delay_ms / 2, delay_ms);
+  return dist(gen);
+}
+
 bool StoreRpcController::NeedPickLeader() const { return !status_.IsRemoteError(); }
 
 }  // namespace sdk
@@ -17,8 +17,12 @@
 
 #include <memory>
 
+#include "sdk/cancel_token.h"
 #include "sdk/client_stub.h"
 #include "proto/error.pb.h"
+#include "sdk/common/slow_log.h"
+#include "sdk/common/tracing.h"
+#include "sdk/request_priority.h"
 #include "sdk/status.h"
 #include "sdk/utils/callback.h"
 #include "sdk/utils/net_util.h"
@@ -26,7 +30,6 @@
 namespace dingodb {
 namespace sdk {
 
-// TODO: support backoff strategy
 class StoreRpcController {
  public:
   explicit StoreRpcController(const ClientStub& stub, Rpc& rpc);
@@ -42,24 +45,63 @@ class StoreRpcController {
 
   void ResetRegion(std::shared_ptr<Region> region);
 
+  // only for read rpc, the first attempt is sent to the replica chosen by policy
+  void SetReplicaReadPolicy(ReplicaReadPolicy policy) { replica_read_policy_ = policy; }
+
+  // the first attempt is sent to end_point, used by stateful read such as scan continue and release
+  void PinEndPoint(const EndPoint& end_point) { pinned_end_point_ = end_point; }
+
+  // only for read rpc, duplicate the first attempt to another replica when it is not answered
+  // within delay_us, works with any replica read policy and regardless of FLAGS_store_rpc_hedge
+  void SetHedgeDelayUs(int64_t delay_us) { hedge_delay_us_ = delay_us; }
+
+  // only for bulk write rpc, every attempt is paced by the write rate of its region and of index_id, 0 means the
+  // rpc belongs to no index, see WriteRateLimiter
+  void SetWriteRateLimit(int64_t index_id = 0) {
+    write_rate_limit_ = true;
+    write_rate_index_id_ = index_id;
+  }
+
  private:
   void DoAsyncCall();
 
   // send rpc flow
   bool PreCheck();
+  // false when the region breaker is open, the callback is fired or the call waits for the probe time
+  bool AdmitByBreaker();
+  bool AdmitByWriteRate();
+  // false when the memory budget is exhausted, the callback is fired or the call waits for others to release
+  bool AdmitByMemory();
+  // the response replaces the one of previous attempt in the memory budget
+  void ChargeResponseMemory();
+  void ReleaseMemory();
   bool PrepareRpc();
   void SendStoreRpc();
   void SendStoreRpcCallBack();
+  void RecordRpcResult();
   void RetrySendRpcOrFireCallback();
   void FireCallback();
 
   // backoff
-  void MaybeDelay();
   bool NeedDelay() const;
+  // jittered exponential backoff, base delay depends on the error kind
+  int64_t NextRetryDelayMs() const;
 
   bool PickNextLeader(EndPoint& leader);
 
+  bool PickReadReplica(EndPoint& end_point);
+
+  // hedged read, see FLAGS_store_rpc_hedge
+  struct HedgeState;
+  bool MaybeSendHedgedStoreRpc();
+  static void SendHedgeAttempt(HedgeState* state, int index);
+  static void HedgeAttemptDone(HedgeState* state, int index);
+  static void ReleaseHedgeState(HedgeState* state);
+
   std::shared_ptr<Region> ProcessStoreRegionInfo(const dingodb::pb::error::StoreRegionInfo& store_region_info);
+  // switch request to new region of same id, return false when keys of request maybe out of new region, e.g. a batch
+  // request to a split region
+  bool MaybeResetToNewRegion(const std::shared_ptr<Region>& new_region);
 
   bool NeedRetry() const;
 
@@ -72,8 +114,39 @@ class StoreRpcController {
   std::shared_ptr<Region> region_;
   int rpc_retry_times_;
   int next_replica_index_;
+  ReplicaReadPolicy replica_read_policy_{kLeaderOnly};
+  EndPoint pinned_end_point_;
+  int64_t send_time_us_{0};
+  // the attempt is asked for, waits before sent are its queue time
+  int64_t attempt_start_us_{0};
+  // -1 means hedge follows FLAGS_store_rpc_hedge and the endpoint p95
+  int64_t hedge_delay_us_{-1};
+  // result of the current attempt is recorded by the hedge attempts themselves
+  bool hedged_{false};
   Status status_;
   StatusCallback call_back_;
+  // span of the caller when AsyncCall, every attempt is a child span of it
+  SpanContext parent_context_;
+  Span attempt_span_;
+  // slow log of the caller request when AsyncCall, every attempt is recorded in it
+  std::shared_ptr<SlowLogRecorder> slow_log_;
+  // token of the caller when AsyncCall, bounds the timeout of every attempt and stops retry
+  std::shared_ptr<CancelToken> cancel_token_;
+  // priority of the caller when AsyncCall, every attempt and retry runs at it
+  RequestPriority priority_{kInteractive};
+  int64_t retry_delay_ms_{0};
+  // a call waits for an open region breaker at most once, see FLAGS_store_rpc_breaker_max_wait_ms
+  bool breaker_waited_{false};
+  // the attempt fail with region epoch error and request is switched to the new region, resend at once
+  bool retry_with_new_region_{false};
+  bool write_rate_limit_{false};
+  int64_t write_rate_index_id_{0};
+  // bytes of the attempt are taken from write rate already, it is sent after the wait
+  bool write_rate_waited_{false};
+  // bytes of request and response charged to memory budget, held across attempts until the callback is fired
+  int64_t memory_charged_bytes_{0};
+  int64_t memory_response_bytes_{0};
+  int64_t memory_waited_ms_{0};
 };
 
 }  // namespace sdk
@@ -0,0 +1,117 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/write_rate_limiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double MinRate() { return std::max<double>(FLAGS_store_write_rate_min_bytes, 1); }
+
+double MaxRate() { return std::max<double>(FLAGS_store_write_rate_max_bytes, MinRate()); }
+}  // namespace
+
+int64_t WriteRateLimiter::Acquire(int64_t region_id, int64_t index_id, int64_t bytes) {
+  int64_t now_us = NowUs();
+  std::lock_guard<std::mutex> guard(mutex_);
+  int64_t wait_ms = AcquireUnlocked(GetBucketUnlocked(region_buckets_, region_id, now_us), bytes, now_us);
+  if (index_id > 0) {
+    wait_ms = std::max(wait_ms, AcquireUnlocked(GetBucketUnlocked(index_buckets_, index_id, now_us), bytes, now_us));
+  }
+  return wait_ms;
+}
+
+void WriteRateLimiter::RecordResult(int64_t region_id, int64_t index_id, bool overloaded) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = region_buckets_.find(region_id);
+  if (iter != region_buckets_.end()) {
+    AdjustUnlocked(iter->second, overloaded);
+  }
+  if (index_id > 0) {
+    iter = index_buckets_.find(index_id);
+    if (iter != index_buckets_.end()) {
+      AdjustUnlocked(iter->second, overloaded);
+    }
+  }
+}
+
+WriteRateLimiter::Snapshot WriteRateLimiter::GetRegionSnapshot(int64_t region_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return SnapshotUnlocked(region_buckets_, region_id);
+}
+
+WriteRateLimiter::Snapshot WriteRateLimiter::GetIndexSnapshot(int64_t index_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return SnapshotUnlocked(index_buckets_, index_id);
+}
+
+WriteRateLimiter::Bucket& WriteRateLimiter::GetBucketUnlocked(std::map<int64_t, Bucket>& buckets, int64_t id,
+                                                              int64_t now_us) {
+  auto iter = buckets.find(id);
+  if (iter == buckets.end()) {
+    Bucket bucket;
+    bucket.rate = std::clamp<double>(FLAGS_store_write_rate_initial_bytes, MinRate(), MaxRate());
+    bucket.tokens = bucket.rate * FLAGS_store_write_rate_burst_ms / 1000;
+    bucket.last_us = now_us;
+    iter = buckets.emplace(id, bucket).first;
+  }
+  return iter->second;
+}
+
+int64_t WriteRateLimiter::AcquireUnlocked(Bucket& bucket, int64_t bytes, int64_t now_us) {
+  // refill since last acquire, at most a burst is saved up
+  double burst = bucket.rate * FLAGS_store_write_rate_burst_ms / 1000;
+  bucket.tokens = std::min(bucket.tokens + bucket.rate * (now_us - bucket.last_us) / 1000000, burst);
+  bucket.last_us = now_us;
+
+  bucket.tokens -= bytes;
+  if (bucket.tokens >= 0) {
+    return 0;
+  }
+  return static_cast<int64_t>(std::ceil(-bucket.tokens * 1000 / bucket.rate));
+}
+
+void WriteRateLimiter::AdjustUnlocked(Bucket& bucket, bool overloaded) {
+  if (overloaded) {
+    bucket.rate = std::max(bucket.rate * FLAGS_store_write_rate_backoff_ratio, MinRate());
+  } else {
+    bucket.rate = std::min(bucket.rate + FLAGS_store_write_rate_increase_bytes, MaxRate());
+  }
+}
+
+WriteRateLimiter::Snapshot WriteRateLimiter::SnapshotUnlocked(const std::map<int64_t, Bucket>& buckets, int64_t id) {
+  auto iter = buckets.find(id);
+  if (iter == buckets.end()) {
+    return {0, 0};
+  }
+  return {static_cast<int64_t>(iter->second.rate), static_cast<int64_t>(iter->second.tokens)};
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_WRITE_RATE_LIMITER_H_
+#define DINGODB_SDK_WRITE_RATE_LIMITER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace dingodb {
+namespace sdk {
+
+// Client wide token buckets of bulk write bytes, one per region and one per index, used by store rpcs marked by
+// StoreRpcController::SetWriteRateLimit when FLAGS_store_write_rate_limit is true.
+// The rate of a bucket is AIMD: it grows by FLAGS_store_write_rate_increase_bytes per answered rpc and is multiplied
+// by FLAGS_store_write_rate_backoff_ratio when the store is busy, slow or unreachable, so ingest settles at the rate
+// the stores sustain instead of pushing them into write stalls.
+class WriteRateLimiter {
+ public:
+  struct Snapshot {
+    // bytes per second
+    int64_t rate;
+    // negative when rpcs already wait for the bucket
+    int64_t tokens;
+  };
+
+  WriteRateLimiter(const WriteRateLimiter&) = delete;
+  const WriteRateLimiter& operator=(const WriteRateLimiter&) = delete;
+
+  WriteRateLimiter() = default;
+
+  ~WriteRateLimiter() = default;
+
+  // take bytes from the buckets of region and index, index_id 0 means no index, return ms the rpc should wait
+  // before sent, 0 means send now. Bytes are taken at once, so later rpcs wait behind it.
+  int64_t Acquire(int64_t region_id, int64_t index_id, int64_t bytes);
+
+  // overloaded means the store is busy, slow or unreachable, any other answer is a success
+  void RecordResult(int64_t region_id, int64_t index_id, bool overloaded);
+
+  // rate 0 when the bucket does not exist
+  Snapshot GetRegionSnapshot(int64_t region_id);
+
+  Snapshot GetIndexSnapshot(int64_t index_id);
+
+ private:
+  struct Bucket {
+    double rate{0};
+    double tokens{0};
+    int64_t last_us{0};
+  };
+
+  Bucket& GetBucketUnlocked(std::map<int64_t, Bucket>& buckets, int64_t id, int64_t now_us);
+
+  // return ms to wait
+  static int64_t AcquireUnlocked(Bucket& bucket, int64_t bytes, int64_t now_us);
+
+  static void AdjustUnlocked(Bucket& bucket, bool overloaded);
+
+  static Snapshot SnapshotUnlocked(const std::map<int64_t, Bucket>& buckets, int64_t id);
+
+  std::mutex mutex_;
+  std::map<int64_t, Bucket> region_buckets_;
+  std::map<int64_t, Bucket> index_buckets_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_WRITE_RATE_LIMITER_H_
@@ -0,0 +1,105 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/scan_batch_prefetcher.h"
+
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+ScanBatchPrefetcher::ScanBatchPrefetcher(FetchFunc fetch, MoreFunc more)
+    : fetch_(std::move(fetch)), more_(std::move(more)) {}
+
+ScanBatchPrefetcher::~ScanBatchPrefetcher() { Wait(); }
+
+void ScanBatchPrefetcher::AsyncNext(std::vector<KVPair>& kvs, StatusCallback cb) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  CHECK(waiter_cb_ == nullptr) << "only one AsyncNext is allowed at a time";
+
+  if (ready_) {
+    Status status = std::move(status_);
+    kvs = std::move(kvs_);
+    kvs_.clear();
+    ready_ = false;
+    bool start = status.ok() && more_();
+    in_flight_ = start;
+    lk.unlock();
+
+    if (start) {
+      StartFetch();
+    }
+    cb(status);
+    return;
+  }
+
+  waiter_kvs_ = &kvs;
+  waiter_cb_ = std::move(cb);
+  if (in_flight_) {
+    return;
+  }
+
+  // nothing prefetched, e.g. the first batch, fetch for caller
+  in_flight_ = true;
+  lk.unlock();
+  StartFetch();
+}
+
+bool ScanBatchPrefetcher::HasPending() const {
+  std::unique_lock<std::mutex> lk(mutex_);
+  return in_flight_ || ready_;
+}
+
+void ScanBatchPrefetcher::Wait() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  cv_.wait(lk, [this] { return !in_flight_; });
+}
+
+void ScanBatchPrefetcher::StartFetch() {
+  kvs_.clear();
+  fetch_(kvs_, [this](auto&& s) { FetchCallback(std::forward<decltype(s)>(s)); });
+}
+
+void ScanBatchPrefetcher::FetchCallback(Status status) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (waiter_cb_ == nullptr) {
+    ready_ = true;
+    status_ = std::move(status);
+    in_flight_ = false;
+    cv_.notify_all();
+    return;
+  }
+
+  StatusCallback cb = std::move(waiter_cb_);
+  waiter_cb_ = nullptr;
+  *waiter_kvs_ = std::move(kvs_);
+  waiter_kvs_ = nullptr;
+  kvs_.clear();
+
+  // keep in flight when the next fetch is started, so Wait does not return in between
+  bool start = status.ok() && more_();
+  in_flight_ = start;
+  cv_.notify_all();
+  lk.unlock();
+
+  if (start) {
+    StartFetch();
+  }
+  cb(status);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
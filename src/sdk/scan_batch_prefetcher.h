@@ -0,0 +1,76 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_SCAN_BATCH_PREFETCHER_H_
+#define DINGODB_SDK_SCAN_BATCH_PREFETCHER_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/status.h"
+#include "sdk/utils/callback.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Double buffer of a region scanner: when a batch is handed to the caller, the fetch of the next batch is already
+// in flight, so the caller processes rows while the next batch is on the way. At most one fetch is in flight, so
+// batches keep the order of the scan. Thread safe.
+class ScanBatchPrefetcher {
+ public:
+  // fetch one batch into kvs and call cb, only one call is running at a time
+  using FetchFunc = std::function<void(std::vector<KVPair>& kvs, StatusCallback cb)>;
+  // whether the region has rows after the last fetched batch, called after a fetch succeed
+  using MoreFunc = std::function<bool()>;
+
+  ScanBatchPrefetcher(FetchFunc fetch, MoreFunc more);
+
+  // wait the in flight fetch, its callback reference the owner scanner
+  ~ScanBatchPrefetcher();
+
+  // hand the prefetched batch to caller or wait for the in flight one, then start to fetch the next batch
+  void AsyncNext(std::vector<KVPair>& kvs, StatusCallback cb);
+
+  // a fetched batch not handed to caller yet, or a fetch in flight
+  bool HasPending() const;
+
+  // wait until no fetch is in flight
+  void Wait();
+
+ private:
+  // in_flight_ must be set before
+  void StartFetch();
+  void FetchCallback(Status status);
+
+  FetchFunc fetch_;
+  MoreFunc more_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool in_flight_{false};
+  // kvs_ and status_ hold a fetched batch
+  bool ready_{false};
+  Status status_;
+  std::vector<KVPair> kvs_;
+  // caller waiting for the in flight fetch
+  std::vector<KVPair>* waiter_kvs_{nullptr};
+  StatusCallback waiter_cb_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_SCAN_BATCH_PREFETCHER_H_
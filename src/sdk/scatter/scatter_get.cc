@@ -0,0 +1,106 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/scatter/scatter_get.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/cancel_token.h"
+#include "sdk/client.h"
+#include "sdk/common/common.h"
+#include "sdk/document/document_batch_query_task.h"
+#include "sdk/rawkv/raw_kv_batch_get_task.h"
+#include "sdk/status.h"
+#include "sdk/utils/async_util.h"
+#include "sdk/vector/vector_batch_query_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+Status ScatterGet(const ClientStub& stub, const ScatterGetParam& param, ScatterGetResult& out_result) {
+  bool get_kv = !param.raw_kv_keys.empty();
+  bool query_vector = param.vector_index_id > 0;
+  bool query_doc = param.doc_index_id > 0;
+  if (!get_kv && !query_vector && !query_doc) {
+    return Status::InvalidArgument("nothing to get, raw_kv_keys is empty and no vector or document index");
+  }
+
+  // one token for all parts, a retry or fan out round of any part stops once the deadline passes
+  std::shared_ptr<CancelToken> cancel_token = CancelToken::Current();
+  if (cancel_token != nullptr) {
+    DINGO_RETURN_NOT_OK(cancel_token->Check());
+  }
+  if (param.timeout_ms > 0) {
+    int64_t timeout_ms = param.timeout_ms;
+    if (cancel_token != nullptr && cancel_token->RemainingMs() >= 0) {
+      timeout_ms = std::min(timeout_ms, cancel_token->RemainingMs());
+    }
+    cancel_token = std::make_shared<CancelToken>(timeout_ms);
+  }
+
+  out_result = ScatterGetResult();
+  {
+    RawKvBatchGetTask kv_task(stub, ToKeyViews(param.raw_kv_keys), out_result.kvs);
+    VectorBatchQueryTask vector_task(stub, param.vector_index_id, param.vector_query, out_result.vector_result);
+    DocumentBatchQueryTask doc_task(stub, param.doc_index_id, param.doc_query, out_result.doc_result);
+
+    CountDownSync sync((get_kv ? 1 : 0) + (query_vector ? 1 : 0) + (query_doc ? 1 : 0));
+    if (get_kv) {
+      kv_task.SetCancelToken(cancel_token);
+      kv_task.AsyncRun([&](Status s) {
+        out_result.raw_kv_status = s;
+        sync.CountDown();
+      });
+    }
+    if (query_vector) {
+      vector_task.SetCancelToken(cancel_token);
+      vector_task.AsyncRun([&](Status s) {
+        out_result.vector_status = s;
+        sync.CountDown();
+      });
+    }
+    if (query_doc) {
+      doc_task.SetCancelToken(cancel_token);
+      doc_task.AsyncRun([&](Status s) {
+        out_result.doc_status = s;
+        sync.CountDown();
+      });
+    }
+    sync.Wait();
+  }
+
+  if (!out_result.raw_kv_status.ok()) {
+    DINGO_LOG(WARNING) << "scatter get of " << param.raw_kv_keys.size()
+                       << " raw kv keys fail: " << out_result.raw_kv_status.ToString();
+    return out_result.raw_kv_status;
+  }
+  if (!out_result.vector_status.ok()) {
+    DINGO_LOG(WARNING) << "scatter get of vector index:" << param.vector_index_id
+                       << " fail: " << out_result.vector_status.ToString();
+    return out_result.vector_status;
+  }
+  if (!out_result.doc_status.ok()) {
+    DINGO_LOG(WARNING) << "scatter get of document index:" << param.doc_index_id
+                       << " fail: " << out_result.doc_status.ToString();
+    return out_result.doc_status;
+  }
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,32 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_SCATTER_SCATTER_GET_H_
+#define DINGODB_SDK_SCATTER_SCATTER_GET_H_
+
+#include "sdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// run the parts of param concurrently and wait all of them, return the first fail status of raw kv, vector and
+// document in that order
+Status ScatterGet(const ClientStub& stub, const ScatterGetParam& param, ScatterGetResult& out_result);
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_SCATTER_SCATTER_GET_H_
@@ -19,6 +19,10 @@ std::unique_ptr<const char[]> Status::CopyState(const char* s) {
 }
 
 Status::Status(Code code, int32_t p_errno, const Slice& msg, const Slice& msg2) : code_(code), errno_(p_errno) {
+  if (msg.empty() && msg2.empty()) {
+    return;
+  }
+
   const uint32_t len1 = static_cast<uint32_t>(msg.size());
   const uint32_t len2 = static_cast<uint32_t>(msg2.size());
   const uint32_t size = len1 + (len2 ? (2 + len2) : 0);
@@ -36,7 +40,7 @@ Status::Status(Code code, int32_t p_errno, const Slice& msg, const Slice& msg2)
 }
 
 std::string Status::ToString() const {
-  if (state_ == nullptr) {
+  if (code_ == kOk && state_ == nullptr) {
     return "OK";
   } else {
     char tmp[30];
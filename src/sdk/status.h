@@ -120,7 +120,9 @@ class Status {
 
   Code code_;
   int32_t errno_;
-  // A nullptr state_ (which is at least the case for OK) means the extra message is empty.
+  // A nullptr state_ (which is at least the case for OK) means the extra message is empty, an error without
+  // message, e.g. Status::NotLeader(errno, ""), is built and copied without allocation.
+  // NOTE: layout and inline copies are part of the ABI of prebuilt consumers, keep them unchanged
   std::unique_ptr<const char[]> state_;
 };
 
@@ -14,26 +14,143 @@
 
 #include "sdk/transaction/txn_buffer.h"
 
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "common/logging.h"
 #include "fmt/core.h"
 #include "glog/logging.h"
 #include "sdk/client.h"
 #include "sdk/status.h"
+#include "sdk/transaction/txn_spill_file.h"
 
 namespace dingodb {
 namespace sdk {
 
-TxnBuffer::TxnBuffer() = default;
+// map node and string headers
+static const int64_t kMutationOverheadBytes = 64;
+
+static int64_t MutationBytes(const TxnMutation& mutation) {
+  // key is kept twice, as map key and in mutation
+  return (mutation.key.size() * 2) + mutation.value.size() + sizeof(TxnMutation) + kMutationOverheadBytes;
+}
+
+// merge mutations in memory with spilled runs in ascending key order, only the newest mutation of a key is returned
+class MutationMergeIterator {
+ public:
+  MutationMergeIterator(const TxnBuffer::MutationMap& mutations, const TxnSpillFile& file,
+                        const std::string& start_key, const std::string& end_key) {
+    mem_iter_ = start_key.empty() ? mutations.begin() : mutations.lower_bound(start_key);
+    mem_end_ = end_key.empty() ? mutations.end() : mutations.lower_bound(end_key);
+
+    // source 0 is memory, then runs from newest to oldest, smaller source wins when keys are same
+    for (size_t run = file.RunCount(); run > 0; --run) {
+      readers_.push_back(file.NewReader(run - 1, start_key, end_key));
+    }
+
+    for (size_t source = 0; source <= readers_.size(); ++source) {
+      Push(source);
+    }
+    Pick();
+  }
+
+  bool Valid() const { return current_ != nullptr; }
+
+  const TxnMutation& Mutation() const { return *current_; }
+
+  bool InMemory() const { return current_source_ == 0; }
+
+  void Next() {
+    Advance(current_source_);
+    Pick();
+  }
+
+  Status GetStatus() const {
+    for (const auto& reader : readers_) {
+      DINGO_RETURN_NOT_OK(reader->GetStatus());
+    }
+    return Status::OK();
+  }
+
+ private:
+  bool SourceValid(size_t source) const {
+    return source == 0 ? mem_iter_ != mem_end_ : readers_[source - 1]->Valid();
+  }
+
+  const TxnMutation& SourceMutation(size_t source) const {
+    return source == 0 ? mem_iter_->second : readers_[source - 1]->Mutation();
+  }
+
+  // min heap by (key, source)
+  bool Greater(size_t a, size_t b) const {
+    int cmp = SourceMutation(a).key.compare(SourceMutation(b).key);
+    return cmp > 0 || (cmp == 0 && a > b);
+  }
+
+  void Push(size_t source) {
+    if (SourceValid(source)) {
+      heap_.push_back(source);
+      std::push_heap(heap_.begin(), heap_.end(), [this](size_t a, size_t b) { return Greater(a, b); });
+    }
+  }
+
+  size_t Pop() {
+    std::pop_heap(heap_.begin(), heap_.end(), [this](size_t a, size_t b) { return Greater(a, b); });
+    size_t source = heap_.back();
+    heap_.pop_back();
+    return source;
+  }
+
+  void Advance(size_t source) {
+    if (source == 0) {
+      ++mem_iter_;
+    } else {
+      readers_[source - 1]->Next();
+    }
+    Push(source);
+  }
+
+  void Pick() {
+    current_ = nullptr;
+    if (heap_.empty()) {
+      return;
+    }
+
+    current_source_ = Pop();
+    const auto& key = SourceMutation(current_source_).key;
+    // drop older mutations of same key
+    while (!heap_.empty() && SourceMutation(heap_.front()).key == key) {
+      Advance(Pop());
+    }
+    current_ = &SourceMutation(current_source_);
+  }
+
+  TxnBuffer::MutationMap::const_iterator mem_iter_;
+  TxnBuffer::MutationMap::const_iterator mem_end_;
+  std::vector<std::unique_ptr<TxnSpillRunReader>> readers_;
+  std::vector<size_t> heap_;
+  size_t current_source_{0};
+  const TxnMutation* current_{nullptr};
+};
+
+TxnBuffer::TxnBuffer() : TxnBuffer(0, "") {}
+
+TxnBuffer::TxnBuffer(int64_t memory_limit_bytes, std::string spill_dir)
+    : memory_limit_bytes_(memory_limit_bytes), spill_dir_(std::move(spill_dir)) {}
 
 TxnBuffer::~TxnBuffer() {
   primary_key_.clear();
   mutation_map_.clear();
 }
 
-Status TxnBuffer::Get(const std::string& key, TxnMutation& mutation) {
+Status TxnBuffer::Get(std::string_view key, TxnMutation& mutation) {
   Status ret;
   auto iter = mutation_map_.find(key);
   if (iter != mutation_map_.cend()) {
     mutation = iter->second;
+  } else if (HasSpilled()) {
+    ret = spill_file_->Get(key, mutation);
   } else {
     ret = Status::NotFound(fmt::format("key:{} not found", key));
   }
@@ -41,8 +158,12 @@ Status TxnBuffer::Get(const std::string& key, TxnMutation& mutation) {
 }
 
 Status TxnBuffer::Put(const std::string& key, const std::string& value) {
-  Erase(key);
-  Emplace(key, TxnMutation::PutMutation(key, value));
+  Upsert(TxnMutation::PutMutation(key, value));
+  return Status::OK();
+}
+
+Status TxnBuffer::Put(std::string&& key, std::string&& value) {
+  Upsert(TxnMutation::PutMutation(std::move(key), std::move(value)));
   return Status::OK();
 }
 
@@ -53,18 +174,24 @@ Status TxnBuffer::BatchPut(const std::vector<KVPair>& kvs) {
   return Status::OK();
 }
 
+Status TxnBuffer::BatchPut(std::vector<KVPair>&& kvs) {
+  for (auto& kv : kvs) {
+    Put(std::move(kv.key), std::move(kv.value));
+  }
+  kvs.clear();
+  return Status::OK();
+}
+
 Status TxnBuffer::PutIfAbsent(const std::string& key, const std::string& value) {
-  TxnMutation op = TxnMutation::PutIfAbsentMutation(key, value);
-  auto iter = mutation_map_.find(key);
-  if (iter != mutation_map_.cend()) {
-    const auto& mutation = iter->second;
-    // NOTE: careful if we add more mutation type
-    if (mutation.type == kDelete) {
-      Erase(key);
-      Emplace(key, std::move(op));
-    }
-  } else {
-    Emplace(key, std::move(op));
+  TxnMutation mutation;
+  Status s = Get(key, mutation);
+  if (!s.ok() && !s.IsNotFound()) {
+    return s;
+  }
+
+  // NOTE: careful if we add more mutation type
+  if (s.IsNotFound() || mutation.type == kDelete || mutation.type == kLock) {
+    Upsert(TxnMutation::PutIfAbsentMutation(key, value));
   }
 
   return Status::OK();
@@ -78,8 +205,7 @@ Status TxnBuffer::BatchPutIfAbsent(const std::vector<KVPair>& kvs) {
 }
 
 Status TxnBuffer::Delete(const std::string& key) {
-  Erase(key);
-  Emplace(key, TxnMutation::DeleteMutation(key));
+  Upsert(TxnMutation::DeleteMutation(key));
   return Status::OK();
 }
 
@@ -90,12 +216,38 @@ Status TxnBuffer::BatchDelete(const std::vector<std::string>& keys) {
   return Status::OK();
 }
 
-Status TxnBuffer::Range(const std::string& start_key, const std::string& end_key, std::vector<TxnMutation>& mutations) {
+Status TxnBuffer::Lock(const std::string& key) {
+  if (mutation_map_.find(key) != mutation_map_.end()) {
+    return Status::OK();
+  }
+
+  if (HasSpilled()) {
+    TxnMutation mutation;
+    Status s = spill_file_->Get(key, mutation);
+    if (!s.IsNotFound()) {
+      return s;
+    }
+  }
+
+  Upsert(TxnMutation::LockMutation(key));
+  return Status::OK();
+}
+
+Status TxnBuffer::Range(const std::string& start_key, const std::string& end_key,
+                        std::vector<TxnMutation>& mutations) const {
   CHECK(start_key < end_key) << "start key must smaller than end_key";
   if (IsEmpty()) {
     return Status::OK();
   }
 
+  if (HasSpilled()) {
+    MutationMergeIterator iter(mutation_map_, *spill_file_, start_key, end_key);
+    for (; iter.Valid(); iter.Next()) {
+      mutations.push_back(iter.Mutation());
+    }
+    return iter.GetStatus();
+  }
+
   auto start_iter = mutation_map_.lower_bound(start_key);
   if (start_iter == mutation_map_.end()) {
     return Status::OK();
@@ -112,25 +264,111 @@ Status TxnBuffer::Range(const std::string& start_key, const std::string& end_key
   return Status::OK();
 }
 
+std::pair<TxnBuffer::MutationMap::const_iterator, TxnBuffer::MutationMap::const_iterator> TxnBuffer::RangeIterators(
+    const std::string& start_key, const std::string& end_key) const {
+  CHECK(start_key < end_key) << "start key must smaller than end_key";
+  return std::make_pair(mutation_map_.lower_bound(start_key), mutation_map_.lower_bound(end_key));
+}
+
+Status TxnBuffer::ForEachBatch(const BatchFn& fn) const {
+  std::vector<const TxnMutation*> batch;
+  if (!HasSpilled()) {
+    if (mutation_map_.empty()) {
+      return Status::OK();
+    }
+
+    batch.reserve(mutation_map_.size());
+    for (const auto& [key, mutation] : mutation_map_) {
+      batch.push_back(&mutation);
+    }
+    return fn(batch);
+  }
+
+  // deque keep address of mutations read back
+  std::deque<TxnMutation> read_back;
+  int64_t read_back_bytes = 0;
+  MutationMergeIterator iter(mutation_map_, *spill_file_, "", "");
+  for (; iter.Valid(); iter.Next()) {
+    if (iter.InMemory()) {
+      batch.push_back(&iter.Mutation());
+    } else {
+      read_back.push_back(iter.Mutation());
+      batch.push_back(&read_back.back());
+      read_back_bytes += MutationBytes(read_back.back());
+    }
+
+    if (read_back_bytes >= memory_limit_bytes_) {
+      DINGO_RETURN_NOT_OK(fn(batch));
+      batch.clear();
+      read_back.clear();
+      read_back_bytes = 0;
+    }
+  }
+  DINGO_RETURN_NOT_OK(iter.GetStatus());
+
+  if (!batch.empty()) {
+    return fn(batch);
+  }
+  return Status::OK();
+}
+
 std::string TxnBuffer::GetPrimaryKey() {
   CHECK(!primary_key_.empty()) << "call IsEmpty before this method";
   return primary_key_;
 }
 
-void TxnBuffer::Erase(const std::string& key) {
-  if (key == primary_key_) {
-    primary_key_.clear();
+void TxnBuffer::Upsert(TxnMutation&& mutation) {
+  auto hint = mutation_map_.end();
+  if (!mutation_map_.empty() && mutation_map_.rbegin()->first >= mutation.key) {
+    hint = mutation_map_.lower_bound(mutation.key);
+    if (hint != mutation_map_.end() && hint->first == mutation.key) {
+      // overwrite keep the key, so primary key is not changed
+      memory_bytes_ += MutationBytes(mutation) - MutationBytes(hint->second);
+      hint->second = std::move(mutation);
+      MaybeSpill();
+      return;
+    }
   }
 
-  mutation_map_.erase(key);
+  if (primary_key_.empty()) {
+    primary_key_ = mutation.key;
+  }
+
+  memory_bytes_ += MutationBytes(mutation);
+  std::string key = mutation.key;
+  mutation_map_.emplace_hint(hint, std::move(key), std::move(mutation));
+  MaybeSpill();
 }
 
-void TxnBuffer::Emplace(const std::string& key, TxnMutation&& mutation) {
-  if (primary_key_.empty()) {
-    primary_key_ = key;
+void TxnBuffer::MaybeSpill() {
+  if (memory_limit_bytes_ <= 0 || spill_disabled_ || memory_bytes_ < memory_limit_bytes_) {
+    return;
+  }
+
+  Status s;
+  if (spill_file_ == nullptr) {
+    auto file = std::make_unique<TxnSpillFile>(spill_dir_);
+    s = file->Open();
+    if (s.ok()) {
+      spill_file_ = std::move(file);
+    }
   }
 
-  CHECK(mutation_map_.insert({key, std::move(mutation)}).second);
+  if (s.ok()) {
+    s = spill_file_->AppendRun(mutation_map_);
+  }
+
+  if (!s.ok()) {
+    // mutations are still in memory, no more try
+    DINGO_LOG(WARNING) << fmt::format("spill txn buffer fail, keep {} bytes mutations in memory, status:{}",
+                                      memory_bytes_, s.ToString());
+    spill_disabled_ = true;
+    return;
+  }
+
+  spilled_count_ += mutation_map_.size();
+  mutation_map_.clear();
+  memory_bytes_ = 0;
 }
 
 }  // namespace sdk
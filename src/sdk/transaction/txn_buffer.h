@@ -16,8 +16,13 @@
 #define DINGODB_SDK_TRANSACTION_BUFFER_H_
 
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "fmt/core.h"
 #include "glog/logging.h"
@@ -28,7 +33,8 @@
 namespace dingodb {
 namespace sdk {
 
-enum TxnMutationType : uint8_t { kNone, kPut, kDelete, kPutIfAbsent };
+// kLock is a key locked by pessimistic txn without write, it is prewritten as lock and invisible to reads
+enum TxnMutationType : uint8_t { kNone, kPut, kDelete, kPutIfAbsent, kLock };
 
 static const char* TxnMutationType2Str(TxnMutationType type) {
   switch (type) {
@@ -40,6 +46,8 @@ static const char* TxnMutationType2Str(TxnMutationType type) {
       return "Delete";
     case kPutIfAbsent:
       return "PutIfAbsent";
+    case kLock:
+      return "Lock";
     default:
       CHECK(false) << "unknow txn mutation type:" << type;
   }
@@ -57,34 +65,47 @@ struct TxnMutation {
                        (value.empty() ? "NULL" : value));
   }
 
-  static TxnMutation PutMutation(const std::string& key, const std::string& value) {
-    return TxnMutation(kPut, key, value);
+  static TxnMutation PutMutation(std::string key, std::string value) {
+    return TxnMutation(kPut, std::move(key), std::move(value));
   }
 
-  static TxnMutation DeleteMutation(const std::string& key) { return TxnMutation(kDelete, key, ""); }
+  static TxnMutation DeleteMutation(std::string key) { return TxnMutation(kDelete, std::move(key), ""); }
 
-  static TxnMutation PutIfAbsentMutation(const std::string& key, const std::string& value) {
-    return TxnMutation(kPutIfAbsent, key, value);
+  static TxnMutation PutIfAbsentMutation(std::string key, std::string value) {
+    return TxnMutation(kPutIfAbsent, std::move(key), std::move(value));
   }
 
+  static TxnMutation LockMutation(std::string key) { return TxnMutation(kLock, std::move(key), ""); }
+
  private:
-  explicit TxnMutation(TxnMutationType p_type, const std::string& p_key, std::string p_value)
-      : type(p_type), key(p_key), value(p_value) {}
+  explicit TxnMutation(TxnMutationType p_type, std::string p_key, std::string p_value)
+      : type(p_type), key(std::move(p_key)), value(std::move(p_value)) {}
 };
 
+class TxnSpillFile;
+
 // NOTE: we need re think all method if we add lock or other entry type
+// when memory_limit_bytes > 0, all mutations in memory are spilled to a sorted run of a temp file in spill_dir once
+// their size exceed the limit, newer mutation overwrite older one of same key when read back.
 class TxnBuffer {
  public:
   TxnBuffer();
 
+  TxnBuffer(int64_t memory_limit_bytes, std::string spill_dir);
+
   ~TxnBuffer();
 
-  Status Get(const std::string& key, TxnMutation& mutation);
+  Status Get(std::string_view key, TxnMutation& mutation);
 
   Status Put(const std::string& key, const std::string& value);
 
+  Status Put(std::string&& key, std::string&& value);
+
   Status BatchPut(const std::vector<KVPair>& kvs);
 
+  // move key and value of kvs into buffer, kvs is cleared
+  Status BatchPut(std::vector<KVPair>&& kvs);
+
   Status PutIfAbsent(const std::string& key, const std::string& value);
 
   Status BatchPutIfAbsent(const std::vector<KVPair>& kvs);
@@ -93,24 +114,59 @@ class TxnBuffer {
 
   Status BatchDelete(const std::vector<std::string>& keys);
 
-  Status Range(const std::string& start_key, const std::string& end_key, std::vector<TxnMutation>& mutations);
+  // add lock mutation when key has no mutation yet, write of key always overwrite lock
+  Status Lock(const std::string& key);
+
+  Status Range(const std::string& start_key, const std::string& end_key, std::vector<TxnMutation>& mutations) const;
+
+  using MutationMap = std::map<std::string, TxnMutation, std::less<void>>;
 
-  bool IsEmpty() const { return mutation_map_.empty(); }
+  // [first, second) are mutations in [start_key, end_key) without copy, invalid once buffer is modified
+  // NOTE: only mutations in memory, use Range when HasSpilled
+  std::pair<MutationMap::const_iterator, MutationMap::const_iterator> RangeIterators(const std::string& start_key,
+                                                                                      const std::string& end_key) const;
 
-  int64_t MutationsSize() const { return mutation_map_.size(); }
+  using BatchFn = std::function<Status(const std::vector<const TxnMutation*>& mutations)>;
+
+  // call fn with all mutations in ascending key order, mutations read back from spill file are passed by batches of
+  // about memory_limit_bytes, all mutations are in one batch when nothing spilled. stop at the first fail of fn
+  Status ForEachBatch(const BatchFn& fn) const;
+
+  bool IsEmpty() const { return mutation_map_.empty() && spilled_count_ == 0; }
+
+  // NOTE: it is an upper bound when HasSpilled, a key overwritten after spill is counted more than once
+  int64_t MutationsSize() const { return mutation_map_.size() + spilled_count_; }
+
+  bool HasSpilled() const { return spilled_count_ > 0; }
 
   // NOTE: check IsEmpty before call this
   std::string GetPrimaryKey();
 
-  const std::map<std::string, TxnMutation>& Mutations() { return mutation_map_; }
+  // NOTE: only mutations in memory, use ForEachBatch when HasSpilled
+  const std::map<std::string, TxnMutation, std::less<void>>& Mutations() {
+    DCHECK(!HasSpilled()) << "mutations are spilled";
+    return mutation_map_;
+  }
 
  private:
-  void Erase(const std::string& key);
+  // replace mutation of same key in place or insert new one, keys appended in ascending order skip the tree search
+  void Upsert(TxnMutation&& mutation);
 
-  void Emplace(const std::string& key, TxnMutation&& mutation);
+  // write mutations in memory to spill file once they exceed memory limit
+  void MaybeSpill();
 
   std::string primary_key_;
-  std::map<std::string, TxnMutation> mutation_map_;
+  // transparent comparator, so can find by std::string_view
+  std::map<std::string, TxnMutation, std::less<void>> mutation_map_;
+
+  const int64_t memory_limit_bytes_;
+  const std::string spill_dir_;
+  // set when spill fail, then all mutations are kept in memory
+  bool spill_disabled_{false};
+  // estimated memory of mutation_map_
+  int64_t memory_bytes_{0};
+  int64_t spilled_count_{0};
+  std::unique_ptr<TxnSpillFile> spill_file_;
 };
 
 static void TxnMutation2MutationPB(const TxnMutation& mutation, pb::store::Mutation* mutation_pb) {
@@ -129,6 +185,10 @@ static void TxnMutation2MutationPB(const TxnMutation& mutation, pb::store::Mutat
       mutation_pb->set_op(pb::store::Op::Delete);
       mutation_pb->set_key(mutation.key);
       break;
+    case kLock:
+      mutation_pb->set_op(pb::store::Op::Lock);
+      mutation_pb->set_key(mutation.key);
+      break;
     default:
       CHECK(false) << "unknow txn mutation type:" << mutation.type;
   }
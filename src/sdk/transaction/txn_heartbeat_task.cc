@@ -0,0 +1,126 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/transaction/txn_heartbeat_task.h"
+
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/common.h"
+#include "sdk/common/metrics.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+#include "sdk/transaction/txn_common.h"
+#include "sdk/utils/scoped_cleanup.h"
+
+namespace dingodb {
+namespace sdk {
+
+TxnHeartbeatTask::TxnHeartbeatTask(const ClientStub& stub, pb::store::IsolationLevel isolation, int64_t start_ts,
+                                   int64_t start_us, std::string primary_key)
+    : stub_(stub),
+      tracker_(stub.GetTaskTracker()),
+      isolation_(isolation),
+      start_ts_(start_ts),
+      start_us_(start_us),
+      primary_key_(std::move(primary_key)) {}
+
+int64_t TxnHeartbeatTask::NextLockTtl(int64_t start_ts, int64_t start_us) {
+  int64_t now_ms = (start_ts >> kPhysicalShiftBits) + (Metrics::NowUs() - start_us) / 1000;
+  return now_ms + FLAGS_txn_heartbeat_lock_ttl_ms;
+}
+
+void TxnHeartbeatTask::Start() { ScheduleNext(); }
+
+void TxnHeartbeatTask::ScheduleNext() {
+  if (IsStopped()) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  bool scheduled =
+      stub_.GetActuator()->Schedule([self] { self->SendHeartbeat(); }, FLAGS_txn_heartbeat_interval_ms);
+  if (!scheduled) {
+    DINGO_LOG(WARNING) << fmt::format("Fail schedule txn heartbeat, start_ts:{}, primary_key:{}", start_ts_,
+                                      primary_key_);
+  }
+}
+
+void TxnHeartbeatTask::SendHeartbeat() {
+  if (IsStopped()) {
+    return;
+  }
+
+  if (!tracker_->Enter()) {
+    DINGO_LOG(INFO) << fmt::format("Stop txn heartbeat of closed client, start_ts:{}, primary_key:{}", start_ts_,
+                                   primary_key_);
+    Stop();
+    return;
+  }
+
+  std::shared_ptr<Region> region;
+  Status s = stub_.GetMetaCache()->LookupRegionByKey(primary_key_, region);
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("Fail lookup region for txn heartbeat, start_ts:{}, primary_key:{}, status:{}",
+                                      start_ts_, primary_key_, s.ToString());
+    ScheduleNext();
+    tracker_->Leave();
+    return;
+  }
+
+  auto* heartbeat = new HeartbeatRpc();
+  auto* request = heartbeat->rpc.MutableRequest();
+  FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch(), isolation_);
+  request->set_primary_lock(primary_key_);
+  request->set_start_ts(start_ts_);
+  request->set_advise_lock_ttl(NextLockTtl(start_ts_, start_us_));
+
+  heartbeat->controller = std::make_unique<StoreRpcController>(stub_, heartbeat->rpc, region);
+  auto self = shared_from_this();
+  heartbeat->controller->AsyncCall(
+      [self, heartbeat](Status status) { self->HeartbeatCallback(std::move(status), heartbeat); });
+}
+
+void TxnHeartbeatTask::HeartbeatCallback(Status status, HeartbeatRpc* heartbeat) {
+  SCOPED_CLEANUP({
+    delete heartbeat;
+    tracker_->Leave();
+  });
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("Fail txn heartbeat, start_ts:{}, primary_key:{}, status:{}", start_ts_,
+                                      primary_key_, status.ToString());
+    ScheduleNext();
+    return;
+  }
+
+  const auto* response = heartbeat->rpc.Response();
+  if (response->has_txn_result()) {
+    // primary lock is committed, rollbacked or not exist, no need to keep alive
+    Status ret = CheckTxnResultInfo(response->txn_result());
+    DINGO_LOG(INFO) << fmt::format("Stop txn heartbeat, start_ts:{}, primary_key:{}, status:{}", start_ts_,
+                                   primary_key_, ret.ToString());
+    Stop();
+    return;
+  }
+
+  DINGO_LOG(DEBUG) << fmt::format("txn heartbeat success, start_ts:{}, lock_ttl:{}", start_ts_, response->lock_ttl());
+  ScheduleNext();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
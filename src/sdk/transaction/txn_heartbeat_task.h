@@ -0,0 +1,82 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_TRANSACTION_HEARTBEAT_TASK_H_
+#define DINGODB_SDK_TRANSACTION_HEARTBEAT_TASK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "proto/store.pb.h"
+#include "sdk/client_stub.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/status.h"
+#include "sdk/utils/task_tracker.h"
+
+namespace dingodb {
+namespace sdk {
+
+// extend ttl of txn primary lock every FLAGS_txn_heartbeat_interval_ms in actuator until Stop is called or
+// the primary lock is gone, so txn lock ttl can be short and readers meet lock of crashed client wait less.
+// the task is shared by txn and the scheduled heartbeat, so it is safe to destroy txn before heartbeat done.
+// each heartbeat is entered in TaskTracker of client until its rpc is done, a heartbeat fired after the client is
+// destroyed ends the task.
+class TxnHeartbeatTask : public std::enable_shared_from_this<TxnHeartbeatTask> {
+ public:
+  TxnHeartbeatTask(const TxnHeartbeatTask&) = delete;
+  const TxnHeartbeatTask& operator=(const TxnHeartbeatTask&) = delete;
+
+  TxnHeartbeatTask(const ClientStub& stub, pb::store::IsolationLevel isolation, int64_t start_ts, int64_t start_us,
+                   std::string primary_key);
+
+  ~TxnHeartbeatTask() = default;
+
+  void Start();
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  bool IsStopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // absolute physical ms the lock expire at when lock is kept alive by heartbeat, counted from the physical ms of
+  // start_ts plus the steady time passed since start_ts is got at start_us, so it follows the tso clock the lock is
+  // checked against instead of the wall clock of client
+  static int64_t NextLockTtl(int64_t start_ts, int64_t start_us);
+
+ private:
+  struct HeartbeatRpc {
+    TxnHeartBeatRpc rpc;
+    std::unique_ptr<StoreRpcController> controller;
+  };
+
+  void ScheduleNext();
+  void SendHeartbeat();
+  void HeartbeatCallback(Status status, HeartbeatRpc* heartbeat);
+
+  const ClientStub& stub_;
+  const std::shared_ptr<TaskTracker> tracker_;
+  const pb::store::IsolationLevel isolation_;
+  const int64_t start_ts_;
+  const int64_t start_us_;
+  const std::string primary_key_;
+
+  std::atomic<bool> stopped_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TRANSACTION_HEARTBEAT_TASK_H_
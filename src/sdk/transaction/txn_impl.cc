@@ -14,9 +14,16 @@
 
 #include "sdk/transaction/txn_impl.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
-#include <thread>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -24,26 +31,71 @@
 #include "fmt/core.h"
 #include "gflags/gflags.h"
 #include "glog/logging.h"
+#include "sdk/cancel_token.h"
 #include "sdk/client.h"
 #include "sdk/common/common.h"
 #include "sdk/common/helper.h"
+#include "sdk/common/metrics.h"
 #include "sdk/common/param_config.h"
+#include "sdk/region_scan_iterator.h"
+#include "sdk/region_scanner.h"
 #include "sdk/rpc/store_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/status.h"
 #include "sdk/transaction/txn_buffer.h"
 #include "sdk/transaction/txn_common.h"
+#include "sdk/transaction/txn_heartbeat_task.h"
+#include "sdk/transaction/txn_kv_iterator.h"
+#include "sdk/transaction/txn_scan_merger.h"
+#include "sdk/transaction/txn_secondary_commit_task.h"
+#include "sdk/transaction/txn_snapshot_exporter.h"
+#include "sdk/utils/async_util.h"
 
 namespace dingodb {
 namespace sdk {
 
+static int64_t SteadyNowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
 Transaction::TxnImpl::TxnImpl(const ClientStub& stub, const TransactionOptions& options)
-    : stub_(stub), options_(options), state_(kInit), buffer_(new TxnBuffer()) {}
+    : stub_(stub),
+      options_(options),
+      state_(kInit),
+      buffer_(new TxnBuffer(FLAGS_txn_buffer_memory_limit_bytes, FLAGS_txn_buffer_spill_dir)) {}
+
+Transaction::TxnImpl::TxnImpl(const ClientStub& stub, int64_t read_ts)
+    : stub_(stub),
+      options_({kOptimistic, kSnapshotIsolation, 0}),
+      state_(kActive),
+      start_ts_(read_ts),
+      commit_ts_(0) {}
+
+Transaction::TxnImpl::~TxnImpl() {
+  // background flush refer to this
+  if (IsPipelined()) {
+    WaitPipelinedFlush();
+  }
+  StopHeartBeat();
+}
 
 Status Transaction::TxnImpl::Begin() {
+  if (IsPipelined() && IsPessimistic()) {
+    return Status::InvalidArgument("pipelined txn only supports optimistic txn");
+  }
+  if (FLAGS_txn_heartbeat_interval_ms > 0 && FLAGS_txn_heartbeat_interval_ms >= FLAGS_txn_heartbeat_lock_ttl_ms) {
+    // lock would expire before the next heartbeat extends it
+    return Status::InvalidArgument(fmt::format("txn heartbeat interval {}ms must be less than lock ttl {}ms",
+                                               FLAGS_txn_heartbeat_interval_ms, FLAGS_txn_heartbeat_lock_ttl_ms));
+  }
+
   pb::meta::TsoTimestamp tso;
+  int64_t start_us = Metrics::NowUs();
   Status ret = stub_.GetAdminTool()->GetCurrentTsoTimeStamp(tso);
   if (ret.ok()) {
     start_tso_ = tso;
+    start_us_ = start_us;
     start_ts_ = Tso2Timestamp(start_tso_);
     state_ = kActive;
   }
@@ -58,7 +110,7 @@ std::unique_ptr<TxnGetRpc> Transaction::TxnImpl::PrepareTxnGetRpc(const std::sha
   return std::move(rpc);
 }
 
-Status Transaction::TxnImpl::DoTxnGet(const std::string& key, std::string& value) {
+Status Transaction::TxnImpl::DoTxnGet(const std::string& key, std::string& value, ReplicaReadPolicy replica_read) {
   std::shared_ptr<Region> region;
   Status ret = stub_.GetMetaCache()->LookupRegionByKey(key, region);
   if (!ret.IsOK()) {
@@ -70,7 +122,7 @@ Status Transaction::TxnImpl::DoTxnGet(const std::string& key, std::string& value
 
   int retry = 0;
   while (true) {
-    DINGO_RETURN_NOT_OK(LogAndSendRpc(stub_, *rpc, region));
+    DINGO_RETURN_NOT_OK(LogAndSendRpc(stub_, *rpc, region, replica_read));
 
     const auto* response = rpc->Response();
     if (response->has_txn_result()) {
@@ -111,78 +163,248 @@ Status Transaction::TxnImpl::DoTxnGet(const std::string& key, std::string& value
   return ret;
 }
 
-Status Transaction::TxnImpl::Get(const std::string& key, std::string& value) {
+bool Transaction::TxnImpl::GetFromBuffer(const std::string& key, std::string& value, Status& status) {
   TxnMutation mutation;
-  Status ret = buffer_->Get(key, mutation);
-  if (ret.ok()) {
-    switch (mutation.type) {
-      case kPut:
-        value = mutation.value;
-        return Status::OK();
-      case kDelete:
-        return Status::NotFound("");
-      case kPutIfAbsent:
-        // NOTE: directy return is ok?
-        value = mutation.value;
-        return Status::OK();
-      default:
-        CHECK(false) << "unknow mutation type, mutation:" << mutation.ToString();
-    }
+  if (!buffer_->Get(key, mutation).ok()) {
+    return false;
   }
 
-  return DoTxnGet(key, value);
+  switch (mutation.type) {
+    case kPut:
+      value = mutation.value;
+      status = Status::OK();
+      return true;
+    case kDelete:
+      status = Status::NotFound("");
+      return true;
+    case kPutIfAbsent:
+      // NOTE: directy return is ok?
+      value = mutation.value;
+      status = Status::OK();
+      return true;
+    case kLock:
+      // locked only, read from store
+      return false;
+    default:
+      CHECK(false) << "unknow mutation type, mutation:" << mutation.ToString();
+  }
+  return false;
 }
 
-void Transaction::TxnImpl::ProcessTxnBatchGetSubTask(TxnSubTask* sub_task) {
-  auto* rpc = CHECK_NOTNULL(dynamic_cast<TxnBatchGetRpc*>(sub_task->rpc));
+bool Transaction::TxnImpl::ReadCacheEnabled() const {
+  return options_.isolation == kSnapshotIsolation && FLAGS_txn_read_cache_max_keys > 0;
+}
 
-  Status res;
-  int retry = 0;
-  while (true) {
-    res = LogAndSendRpc(stub_, *rpc, sub_task->region);
+bool Transaction::TxnImpl::GetFromReadCache(const std::string& key, std::string& value, Status& status) const {
+  auto iter = read_cache_.find(key);
+  if (iter == read_cache_.end()) {
+    return false;
+  }
 
-    if (!res.ok()) {
-      break;
-    }
+  if (iter->second.has_value()) {
+    value = iter->second.value();
+    status = Status::OK();
+  } else {
+    status = Status::NotFound(fmt::format("key:{} not found", key));
+  }
+  return true;
+}
 
-    const auto* response = rpc->Response();
-    if (response->has_txn_result()) {
-      res = CheckTxnResultInfo(response->txn_result());
+void Transaction::TxnImpl::GetFromReadCache(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs,
+                                            std::vector<std::string_view>& not_cached) const {
+  // one buffer reused for lookups, read cache is not keyed by views
+  std::string lookup;
+  for (const auto& key : keys) {
+    lookup.assign(key.data(), key.size());
+    auto iter = read_cache_.find(lookup);
+    if (iter == read_cache_.end()) {
+      not_cached.push_back(key);
+    } else if (iter->second.has_value()) {
+      kvs.push_back({lookup, iter->second.value()});
     }
+  }
+}
 
-    if (res.ok()) {
-      break;
-    } else if (res.IsTxnLockConflict()) {
-      res = stub_.GetTxnLockResolver()->ResolveLock(response->txn_result().locked(), start_ts_);
-      if (!res.ok()) {
-        break;
+void Transaction::TxnImpl::FillReadCache(std::string_view key, std::optional<std::string> value) {
+  // full cache keeps what it has, later keys are read from store
+  if (static_cast<int64_t>(read_cache_.size()) >= FLAGS_txn_read_cache_max_keys) {
+    return;
+  }
+  read_cache_.emplace(std::string(key), std::move(value));
+}
+
+Status Transaction::TxnImpl::CachedTxnGet(const std::string& key, std::string& value, ReplicaReadPolicy replica_read) {
+  if (!ReadCacheEnabled()) {
+    return DoTxnGet(key, value, replica_read);
+  }
+
+  Status ret;
+  if (GetFromReadCache(key, value, ret)) {
+    return ret;
+  }
+
+  ret = DoTxnGet(key, value, replica_read);
+  if (ret.ok()) {
+    FillReadCache(key, value);
+  } else if (ret.IsNotFound()) {
+    FillReadCache(key, std::nullopt);
+  }
+  return ret;
+}
+
+Status Transaction::TxnImpl::CachedTxnBatchGet(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs) {
+  if (!ReadCacheEnabled()) {
+    return DoTxnBatchGet(keys, kvs);
+  }
+
+  std::vector<std::string_view> not_cached;
+  std::vector<KVPair> to_return;
+  GetFromReadCache(keys, to_return, not_cached);
+
+  Status ret;
+  if (!not_cached.empty()) {
+    std::vector<KVPair> batch_get;
+    ret = DoTxnBatchGet(not_cached, batch_get);
+    // keys of a failed sub task are absent but not known as not found
+    if (ret.ok()) {
+      for (const auto& kv : batch_get) {
+        FillReadCache(kv.key, kv.value);
+      }
+      for (const auto& key : not_cached) {
+        FillReadCache(key, std::nullopt);
       }
-    } else {
-      DINGO_LOG(WARNING) << "unexpect txn batch get rpc response, status:" << res.ToString()
-                         << " response:" << response->DebugString();
-      break;
     }
+    to_return.insert(to_return.end(), std::make_move_iterator(batch_get.begin()),
+                     std::make_move_iterator(batch_get.end()));
+  }
 
-    if (NeedRetryAndInc(retry)) {
-      // TODO: set txn retry ms
-      DINGO_LOG(INFO) << "try to delay:" << FLAGS_txn_op_delay_ms << "ms";
-      DelayRetry(FLAGS_txn_op_delay_ms);
+  kvs = std::move(to_return);
+  return ret;
+}
+
+Status Transaction::TxnImpl::Get(const std::string& key, std::string& value) {
+  if (IsReadOnly()) {
+    return CachedTxnGet(key, value);
+  }
+
+  Status ret;
+  if (GetFromBuffer(key, value, ret)) {
+    return ret;
+  }
+
+  return CachedTxnGet(key, value);
+}
+
+Status Transaction::TxnImpl::Get(const std::string& key, std::string& value, const ReadOptions& options) {
+  // read committed read latest data, follower may lag behind leader
+  if (options.replica_read == kLeaderOnly || options_.isolation != kSnapshotIsolation) {
+    return Get(key, value);
+  }
+
+  TxnMutation mutation;
+  if (!IsReadOnly() && buffer_->Get(key, mutation).ok()) {
+    return Get(key, value);
+  }
+
+  return CachedTxnGet(key, value, options.replica_read);
+}
+
+bool Transaction::TxnImpl::ProcessTxnGetSubTask(TxnSubTask* sub_task) {
+  auto* rpc = CHECK_NOTNULL(dynamic_cast<TxnGetRpc*>(sub_task->rpc));
+  if (!sub_task->status.ok()) {
+    return false;
+  }
+
+  Status res;
+  const auto* response = rpc->Response();
+  if (response->has_txn_result()) {
+    res = CheckTxnResultInfo(response->txn_result());
+  }
+
+  if (res.IsTxnLockConflict()) {
+    res = stub_.GetTxnLockResolver()->ResolveLock(response->txn_result().locked(), start_ts_);
+    sub_task->status = res.ok() ? Status::TxnLockConflict("lock resolved, need retry") : res;
+    return res.ok();
+  } else if (!res.ok()) {
+    DINGO_LOG(WARNING) << "unexpect txn get rpc response, status:" << res.ToString()
+                       << " response:" << response->DebugString();
+    sub_task->status = res;
+  }
+
+  return false;
+}
+
+bool Transaction::TxnImpl::ProcessTxnBatchGetSubTask(TxnSubTask* sub_task) {
+  std::vector<pb::store::LockInfo> locks;
+  if (!CollectTxnBatchGetSubTask(sub_task, locks)) {
+    return false;
+  }
+  return ResolveSubTaskLocks({sub_task}, locks);
+}
+
+bool Transaction::TxnImpl::CollectTxnBatchGetSubTask(TxnSubTask* sub_task, std::vector<pb::store::LockInfo>& locks) {
+  auto* rpc = CHECK_NOTNULL(dynamic_cast<TxnBatchGetRpc*>(sub_task->rpc));
+  if (!sub_task->status.ok()) {
+    return false;
+  }
+
+  Status res;
+  const auto* response = rpc->Response();
+  if (response->has_txn_result()) {
+    res = CheckTxnResultInfo(response->txn_result());
+  }
+
+  if (!res.ok() && !res.IsTxnLockConflict()) {
+    DINGO_LOG(WARNING) << "unexpect txn batch get rpc response, status:" << res.ToString()
+                       << " response:" << response->DebugString();
+    sub_task->status = res;
+    return false;
+  }
+
+  std::unordered_set<std::string_view> read_keys;
+  for (const auto& kv : response->kvs()) {
+    if (!kv.value().empty()) {
+      sub_task->result_kvs.push_back({kv.key(), kv.value()});
+      read_keys.insert(kv.key());
     } else {
-      break;
+      DINGO_LOG(DEBUG) << "Ignore kv key:" << kv.key() << " because value is empty";
     }
   }
 
-  if (res.ok()) {
-    for (const auto& kv : rpc->Response()->kvs()) {
-      if (!kv.value().empty()) {
-        sub_task->result_kvs.push_back({kv.key(), kv.value()});
-      } else {
-        DINGO_LOG(DEBUG) << "Ignore kv key:" << kv.key() << " because value is empty";
-      }
+  if (!res.IsTxnLockConflict()) {
+    return false;
+  }
+
+  // kvs read before the lock are kept, only the other keys are read again, empty value is not known as not found
+  std::vector<std::string> unread_keys;
+  for (const auto& key : rpc->Request()->keys()) {
+    if (read_keys.count(key) == 0) {
+      unread_keys.push_back(key);
     }
   }
+  if (unread_keys.empty()) {
+    sub_task->status = Status::OK();
+    return false;
+  }
+
+  auto* keys = rpc->MutableRequest()->mutable_keys();
+  keys->Clear();
+  for (auto& key : unread_keys) {
+    *keys->Add() = std::move(key);
+  }
 
+  locks.push_back(response->txn_result().locked());
   sub_task->status = res;
+  return true;
+}
+
+bool Transaction::TxnImpl::ResolveSubTaskLocks(const std::vector<TxnSubTask*>& sub_tasks,
+                                               const std::vector<pb::store::LockInfo>& locks) {
+  Status res = stub_.GetTxnLockResolver()->ResolveLocks(locks, start_ts_);
+  for (auto* sub_task : sub_tasks) {
+    sub_task->status = res.ok() ? Status::TxnLockConflict("lock resolved, need retry") : res;
+  }
+  return res.ok();
 }
 
 std::unique_ptr<TxnBatchGetRpc> Transaction::TxnImpl::PrepareTxnBatchGetRpc(
@@ -194,71 +416,38 @@ std::unique_ptr<TxnBatchGetRpc> Transaction::TxnImpl::PrepareTxnBatchGetRpc(
   return std::move(rpc);
 }
 
-// TODO: return not found keys
-Status Transaction::TxnImpl::DoTxnBatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
-  auto meta_cache = stub_.GetMetaCache();
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<std::string>> region_keys;
-
-  for (const auto& key : keys) {
-    std::shared_ptr<Region> tmp;
-    Status got = meta_cache->LookupRegionByKey(key, tmp);
-    if (!got.IsOK()) {
-      return got;
-    }
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_keys[tmp->RegionId()].push_back(key);
-  }
+Status Transaction::TxnImpl::PrepareTxnBatchGetSubTasks(const std::vector<std::string_view>& keys,
+                                                        TxnSubTasks& tasks) const {
+  std::vector<std::string_view> sorted_keys(keys.begin(), keys.end());
+  std::sort(sorted_keys.begin(), sorted_keys.end());
+  sorted_keys.erase(std::unique(sorted_keys.begin(), sorted_keys.end()), sorted_keys.end());
 
-  std::vector<TxnSubTask> sub_tasks;
-  std::vector<std::unique_ptr<TxnBatchGetRpc>> rpcs;
+  std::vector<RegionKeys> groups;
+  DINGO_RETURN_NOT_OK(stub_.GetMetaCache()->LookupRegionsByKeys(sorted_keys, groups));
 
-  for (const auto& entry : region_keys) {
-    auto region_id = entry.first;
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
     auto rpc = PrepareTxnBatchGetRpc(region);
 
-    for (const auto& key : entry.second) {
+    for (const auto& key : group.keys) {
       auto* fill = rpc->MutableRequest()->add_keys();
       *fill = key;
     }
 
-    sub_tasks.emplace_back(rpc.get(), region);
-    rpcs.push_back(std::move(rpc));
-  }
-
-  DCHECK_EQ(rpcs.size(), region_keys.size());
-  DCHECK_EQ(rpcs.size(), sub_tasks.size());
-
-  std::vector<std::thread> thread_pool;
-  for (auto i = 1; i < sub_tasks.size(); i++) {
-    thread_pool.emplace_back(&Transaction::TxnImpl::ProcessTxnBatchGetSubTask, this, &sub_tasks[i]);
+    tasks.Add(std::move(rpc), region);
   }
 
-  ProcessTxnBatchGetSubTask(sub_tasks.data());
+  DCHECK_EQ(tasks.rpcs.size(), groups.size());
+  return Status::OK();
+}
 
-  for (auto& thread : thread_pool) {
-    thread.join();
-  }
+Status Transaction::TxnImpl::CollectTxnBatchGetResult(std::vector<TxnSubTask>& sub_tasks, std::vector<KVPair>& kvs) {
+  Status result = FirstSubTaskError(sub_tasks, "txn_batch_get_sub_task");
 
-  Status result;
   std::vector<KVPair> tmp_kvs;
   for (auto& state : sub_tasks) {
-    if (!state.status.IsOK()) {
-      DINGO_LOG(WARNING) << "Fail txn_batch_get_sub_task, rpc: " << state.rpc->Method()
-                         << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
-      if (result.ok()) {
-        // only return first fail status
-        result = state.status;
-      }
-    } else {
+    if (state.status.IsOK()) {
       tmp_kvs.insert(tmp_kvs.end(), std::make_move_iterator(state.result_kvs.begin()),
                      std::make_move_iterator(state.result_kvs.end()));
     }
@@ -268,23 +457,60 @@ Status Transaction::TxnImpl::DoTxnBatchGet(const std::vector<std::string>& keys,
   return result;
 }
 
-Status Transaction::TxnImpl::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
-  std::vector<std::string> not_found;
-  std::vector<KVPair> to_return;
-  Status ret;
+// TODO: return not found keys
+Status Transaction::TxnImpl::DoTxnBatchGet(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs) {
+  TxnSubTasks tasks;
+  DINGO_RETURN_NOT_OK(PrepareTxnBatchGetSubTasks(keys, tasks));
+
+  std::vector<TxnSubTask*> pending;
+  pending.reserve(tasks.sub_tasks.size());
+  for (auto& sub_task : tasks.sub_tasks) {
+    pending.push_back(&sub_task);
+  }
+
+  // locks met by all regions of a round are resolved together, txn of each is checked once
+  int retry = 0;
+  while (!pending.empty()) {
+    AsyncSendSubTasksAndWait(pending);
+
+    std::vector<TxnSubTask*> need_retry;
+    std::vector<pb::store::LockInfo> locks;
+    for (auto* sub_task : pending) {
+      if (CollectTxnBatchGetSubTask(sub_task, locks)) {
+        need_retry.push_back(sub_task);
+      }
+    }
+
+    if (need_retry.empty() || !ResolveSubTaskLocks(need_retry, locks) || !NeedRetryAndInc(retry)) {
+      break;
+    }
+
+    // locks are resolved, unread keys are read again without delay
+    DINGO_LOG(INFO) << "resolved " << locks.size() << " locks, retry sub task count:" << need_retry.size();
+    pending.swap(need_retry);
+  }
+
+  return CollectTxnBatchGetResult(tasks.sub_tasks, kvs);
+}
+
+void Transaction::TxnImpl::GetFromBuffer(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs,
+                                         std::vector<std::string_view>& not_found) {
   for (const auto& key : keys) {
     TxnMutation mutation;
-    ret = buffer_->Get(key, mutation);
+    Status ret = buffer_->Get(key, mutation);
     if (ret.IsOK()) {
       switch (mutation.type) {
         case kPut:
-          to_return.push_back({key, mutation.value});
+          kvs.push_back({std::string(key), mutation.value});
           continue;
         case kDelete:
           continue;
         case kPutIfAbsent:
           // NOTE: use this value is ok?
-          to_return.push_back({key, mutation.value});
+          kvs.push_back({std::string(key), mutation.value});
+          continue;
+        case kLock:
+          not_found.push_back(key);
           continue;
         default:
           CHECK(false) << "unknow mutation type, mutation:" << mutation.ToString();
@@ -294,10 +520,29 @@ Status Transaction::TxnImpl::BatchGet(const std::vector<std::string>& keys, std:
       not_found.push_back(key);
     }
   }
+}
+
+Status Transaction::TxnImpl::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
+  return BatchGetByKeyViews(ToKeyViews(keys), kvs);
+}
+
+Status Transaction::TxnImpl::BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& kvs) {
+  return BatchGetByKeyViews(ToKeyViews(keys, key_count), kvs);
+}
+
+Status Transaction::TxnImpl::BatchGetByKeyViews(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs) {
+  if (IsReadOnly()) {
+    return CachedTxnBatchGet(keys, kvs);
+  }
 
+  std::vector<std::string_view> not_found;
+  std::vector<KVPair> to_return;
+  GetFromBuffer(keys, to_return, not_found);
+
+  Status ret;
   if (!not_found.empty()) {
     std::vector<KVPair> batch_get;
-    ret = DoTxnBatchGet(not_found, batch_get);
+    ret = CachedTxnBatchGet(not_found, batch_get);
     to_return.insert(to_return.end(), std::make_move_iterator(batch_get.begin()),
                      std::make_move_iterator(batch_get.end()));
   }
@@ -307,125 +552,426 @@ Status Transaction::TxnImpl::BatchGet(const std::vector<std::string>& keys, std:
   return ret;
 }
 
-Status Transaction::TxnImpl::Put(const std::string& key, const std::string& value) { return buffer_->Put(key, value); }
+static std::vector<std::string> KeysOf(const std::vector<KVPair>& kvs) {
+  std::vector<std::string> keys;
+  keys.reserve(kvs.size());
+  for (const auto& kv : kvs) {
+    keys.push_back(kv.key);
+  }
+  return keys;
+}
 
-Status Transaction::TxnImpl::BatchPut(const std::vector<KVPair>& kvs) { return buffer_->BatchPut(kvs); }
+static int64_t BytesOf(const std::vector<KVPair>& kvs) {
+  int64_t bytes = 0;
+  for (const auto& kv : kvs) {
+    bytes += kv.key.size() + kv.value.size();
+  }
+  return bytes;
+}
 
-Status Transaction::TxnImpl::PutIfAbsent(const std::string& key, const std::string& value) {
-  return buffer_->PutIfAbsent(key, value);
+static int64_t BytesOf(const std::vector<std::string>& keys) {
+  int64_t bytes = 0;
+  for (const auto& key : keys) {
+    bytes += key.size();
+  }
+  return bytes;
 }
 
-Status Transaction::TxnImpl::BatchPutIfAbsent(const std::vector<KVPair>& kvs) { return buffer_->BatchPutIfAbsent(kvs); }
+Status Transaction::TxnImpl::Put(const std::string& key, const std::string& value) {
+  DINGO_RETURN_NOT_OK(CheckPipelinedWrite(key));
+  if (IsPessimistic()) {
+    DINGO_RETURN_NOT_OK(PessimisticLock({key}));
+  }
+  DINGO_RETURN_NOT_OK(buffer_->Put(key, value));
+  return IsPipelined() ? PipelinedWrite({key}, key.size() + value.size()) : Status::OK();
+}
 
-Status Transaction::TxnImpl::Delete(const std::string& key) { return buffer_->Delete(key); }
+Status Transaction::TxnImpl::BatchPut(const std::vector<KVPair>& kvs) {
+  for (const auto& kv : kvs) {
+    DINGO_RETURN_NOT_OK(CheckPipelinedWrite(kv.key));
+  }
+  if (IsPessimistic()) {
+    DINGO_RETURN_NOT_OK(PessimisticLock(KeysOf(kvs)));
+  }
+  DINGO_RETURN_NOT_OK(buffer_->BatchPut(kvs));
+  return IsPipelined() ? PipelinedWrite(KeysOf(kvs), BytesOf(kvs)) : Status::OK();
+}
 
-Status Transaction::TxnImpl::BatchDelete(const std::vector<std::string>& keys) { return buffer_->BatchDelete(keys); }
+Status Transaction::TxnImpl::BatchPut(std::vector<KVPair>&& kvs) {
+  for (const auto& kv : kvs) {
+    DINGO_RETURN_NOT_OK(CheckPipelinedWrite(kv.key));
+  }
+  if (IsPessimistic()) {
+    DINGO_RETURN_NOT_OK(PessimisticLock(KeysOf(kvs)));
+  }
 
-Status Transaction::TxnImpl::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit,
-                                  std::vector<KVPair>& kvs) {
-  if (start_key.empty() || end_key.empty()) {
-    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  // kvs are moved into buffer
+  std::vector<std::string> keys;
+  int64_t bytes = 0;
+  if (IsPipelined()) {
+    keys = KeysOf(kvs);
+    bytes = BytesOf(kvs);
   }
+  DINGO_RETURN_NOT_OK(buffer_->BatchPut(std::move(kvs)));
+  return IsPipelined() ? PipelinedWrite(std::move(keys), bytes) : Status::OK();
+}
 
-  if (start_key >= end_key) {
-    return Status::InvalidArgument("end_key must greater than start_key, check params");
+Status Transaction::TxnImpl::PutIfAbsent(const std::string& key, const std::string& value) {
+  DINGO_RETURN_NOT_OK(CheckPipelinedWrite(key));
+  if (IsPessimistic()) {
+    DINGO_RETURN_NOT_OK(PessimisticLock({key}));
   }
+  DINGO_RETURN_NOT_OK(buffer_->PutIfAbsent(key, value));
+  return IsPipelined() ? PipelinedWrite({key}, key.size() + value.size()) : Status::OK();
+}
 
-  auto meta_cache = stub_.GetMetaCache();
-  {
-    // precheck: return not found if no region in [start, end_key)
-    std::shared_ptr<Region> region;
-    Status ret = meta_cache->LookupRegionBetweenRange(start_key, end_key, region);
-    if (!ret.IsOK()) {
-      if (ret.IsNotFound()) {
-        DINGO_LOG(WARNING) << fmt::format("region not found between [{},{}), no need retry, status:{}", start_key,
-                                          end_key, ret.ToString());
-      } else {
-        DINGO_LOG(WARNING) << fmt::format("lookup region fail between [{},{}), need retry, status:{}", start_key,
-                                          end_key, ret.ToString());
-      }
-      return ret;
-    }
+Status Transaction::TxnImpl::BatchPutIfAbsent(const std::vector<KVPair>& kvs) {
+  for (const auto& kv : kvs) {
+    DINGO_RETURN_NOT_OK(CheckPipelinedWrite(kv.key));
   }
+  if (IsPessimistic()) {
+    DINGO_RETURN_NOT_OK(PessimisticLock(KeysOf(kvs)));
+  }
+  DINGO_RETURN_NOT_OK(buffer_->BatchPutIfAbsent(kvs));
+  return IsPipelined() ? PipelinedWrite(KeysOf(kvs), BytesOf(kvs)) : Status::OK();
+}
 
-  std::vector<TxnMutation> range_mutations;
-  CHECK(buffer_->Range(start_key, end_key, range_mutations).ok());
-
-  uint64_t redundant_limit = limit;
-  if (redundant_limit != 0) {
-    uint64_t delete_count = 0;
-    for (const auto& mutaion : range_mutations) {
-      if (mutaion.type == TxnMutationType::kDelete) {
-        delete_count++;
-      }
-    }
-    redundant_limit = limit + delete_count;
+Status Transaction::TxnImpl::Delete(const std::string& key) {
+  DINGO_RETURN_NOT_OK(CheckPipelinedWrite(key));
+  if (IsPessimistic()) {
+    DINGO_RETURN_NOT_OK(PessimisticLock({key}));
   }
+  DINGO_RETURN_NOT_OK(buffer_->Delete(key));
+  return IsPipelined() ? PipelinedWrite({key}, key.size()) : Status::OK();
+}
 
-  std::string next_start = start_key;
-  std::map<std::string, std::string> tmp_kvs;
+Status Transaction::TxnImpl::BatchDelete(const std::vector<std::string>& keys) {
+  for (const auto& key : keys) {
+    DINGO_RETURN_NOT_OK(CheckPipelinedWrite(key));
+  }
+  if (IsPessimistic()) {
+    DINGO_RETURN_NOT_OK(PessimisticLock(keys));
+  }
+  DINGO_RETURN_NOT_OK(buffer_->BatchDelete(keys));
+  return IsPipelined() ? PipelinedWrite(keys, BytesOf(keys)) : Status::OK();
+}
 
-  DINGO_LOG(INFO) << fmt::format("txn scan start between [{},{}), next_start:{}, limit:{}, redundant_limit:{}",
-                                 start_key, end_key, next_start, limit, redundant_limit);
+Status Transaction::TxnImpl::BatchGetForUpdate(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
+  if (!IsPessimistic()) {
+    return Status::NotSupported("BatchGetForUpdate only supports pessimistic txn");
+  }
 
-  while (next_start < end_key) {
-    std::shared_ptr<Region> region;
-    Status ret = meta_cache->LookupRegionBetweenRange(next_start, end_key, region);
+  std::vector<KVPair> locked_kvs;
+  DINGO_RETURN_NOT_OK(PessimisticLock(keys, &locked_kvs));
 
-    if (ret.IsNotFound()) {
-      DINGO_LOG(INFO) << fmt::format("Break scan because region not found  between [{},{}), start_key:{} status:{}",
-                                     next_start, end_key, start_key, ret.ToString());
-      break;
+  // local writes overwrite values from store
+  std::vector<KVPair> to_return;
+  for (auto& kv : locked_kvs) {
+    TxnMutation mutation;
+    if (!buffer_->Get(kv.key, mutation).ok() || mutation.type == kLock) {
+      to_return.push_back(std::move(kv));
     }
-
-    if (!ret.IsOK()) {
-      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start, end_key,
-                                        start_key, ret.ToString());
-      return ret;
+  }
+  for (const auto& key : keys) {
+    TxnMutation mutation;
+    if (buffer_->Get(key, mutation).ok() && (mutation.type == kPut || mutation.type == kPutIfAbsent)) {
+      to_return.push_back({key, mutation.value});
     }
+  }
 
-    std::string scanner_start_key =
-        next_start <= region->Range().start_key() ? region->Range().start_key() : next_start;
-    std::string scanner_end_key = end_key <= region->Range().end_key() ? end_key : region->Range().end_key();
-    ScannerOptions scan_options(stub_, region, scanner_start_key, scanner_end_key, options_, start_ts_);
-    std::shared_ptr<RegionScanner> scanner;
-    CHECK(stub_.GetTxnRegionScannerFactory()->NewRegionScanner(scan_options, scanner).IsOK());
-    ret = scanner->Open();
-    CHECK(ret.ok());
+  kvs = std::move(to_return);
+  return Status::OK();
+}
 
-    DINGO_LOG(INFO) << fmt::format("region:{} scan start, region range:({}-{})", region->RegionId(),
-                                   region->Range().start_key(), region->Range().end_key());
+Status Transaction::TxnImpl::PessimisticLock(const std::vector<std::string>& keys, std::vector<KVPair>* out_kvs) {
+  // keys already locked by this txn need no rpc unless their values are wanted
+  std::vector<std::string_view> to_lock;
+  to_lock.reserve(keys.size());
+  for (const auto& key : keys) {
+    if (out_kvs != nullptr || locked_keys_.find(key) == locked_keys_.end()) {
+      to_lock.push_back(key);
+    }
+  }
+  std::sort(to_lock.begin(), to_lock.end());
+  to_lock.erase(std::unique(to_lock.begin(), to_lock.end()), to_lock.end());
+  if (to_lock.empty()) {
+    return Status::OK();
+  }
 
-    while (scanner->HasMore()) {
-      DINGO_LOG(DEBUG) << fmt::format("start call next batch, limit:{}, redundant_limit:{}, tmp_kvs_size:{}", limit,
-                                      redundant_limit, tmp_kvs.size());
-      std::vector<KVPair> scan_kvs;
+  // lock with latest ts, so values returned are the latest committed ones
+  pb::meta::TsoTimestamp tso;
+  DINGO_RETURN_NOT_OK(stub_.GetAdminTool()->GetCurrentTsoTimeStamp(tso));
+  int64_t for_update_ts = Tso2Timestamp(tso);
+
+  if (buffer_->IsEmpty()) {
+    // first locked key is primary key
+    buffer_->Lock(std::string(to_lock.front()));
+  }
+
+  std::string pk = buffer_->GetPrimaryKey();
+  if (locked_keys_.find(pk) == locked_keys_.end()) {
+    // primary key is locked alone before others, so a reader meet any secondary lock can find its primary lock
+    auto iter = std::lower_bound(to_lock.begin(), to_lock.end(), pk);
+    bool wanted = (iter != to_lock.end() && *iter == pk);
+    DINGO_RETURN_NOT_OK(DoPessimisticLock({pk}, for_update_ts, wanted ? out_kvs : nullptr));
+    if (wanted) {
+      to_lock.erase(iter);
+    }
+    StartHeartBeat();
+  }
+
+  return DoPessimisticLock(to_lock, for_update_ts, out_kvs);
+}
+
+std::unique_ptr<TxnPessimisticLockRpc> Transaction::TxnImpl::PrepareTxnPessimisticLockRpc(
+    const std::shared_ptr<Region>& region, int64_t for_update_ts, bool return_values) const {
+  auto rpc = std::make_unique<TxnPessimisticLockRpc>();
+  rpc->MutableRequest()->set_start_ts(start_ts_);
+  rpc->MutableRequest()->set_for_update_ts(for_update_ts);
+  rpc->MutableRequest()->set_return_values(return_values);
+  FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch(),
+                 TransactionIsolation2IsolationLevel(options_.isolation));
+  rpc->MutableRequest()->set_primary_lock(buffer_->GetPrimaryKey());
+  rpc->MutableRequest()->set_lock_ttl(
+      FLAGS_txn_heartbeat_interval_ms > 0 ? TxnHeartbeatTask::NextLockTtl(start_ts_, start_us_) : INT64_MAX);
+  return std::move(rpc);
+}
+
+bool Transaction::TxnImpl::ProcessTxnPessimisticLockSubTask(TxnSubTask* sub_task) {
+  auto* rpc = CHECK_NOTNULL(dynamic_cast<TxnPessimisticLockRpc*>(sub_task->rpc));
+  if (!sub_task->status.ok()) {
+    return false;
+  }
+
+  const auto* response = rpc->Response();
+  std::vector<pb::store::LockInfo> locks;
+  for (const auto& txn_result : response->txn_result()) {
+    Status ret = CheckTxnResultInfo(txn_result);
+    if (ret.IsTxnLockConflict()) {
+      locks.push_back(txn_result.locked());
+    } else if (!ret.ok()) {
+      DINGO_LOG(WARNING) << "fail pessimistic lock, status:" << ret.ToString()
+                         << " txn_result:" << txn_result.DebugString();
+      sub_task->status = ret;
+      return false;
+    }
+  }
+
+  if (!locks.empty()) {
+    // lock of an alive txn is not resolved, wait until it is committed, rollbacked or expired
+    Status resolve = stub_.GetTxnLockResolver()->ResolveLocks(locks, start_ts_);
+    sub_task->status = Status::TxnLockConflict(fmt::format("wait {} locks, resolve status:{}", locks.size(),
+                                                           resolve.ToString()));
+    return true;
+  }
+
+  for (const auto& kv : response->kvs()) {
+    if (!kv.value().empty()) {
+      sub_task->result_kvs.push_back({kv.key(), kv.value()});
+    }
+  }
+  sub_task->status = Status::OK();
+  return false;
+}
+
+Status Transaction::TxnImpl::DoPessimisticLock(const std::vector<std::string_view>& keys, int64_t for_update_ts,
+                                               std::vector<KVPair>* out_kvs) {
+  if (keys.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<RegionKeys> groups;
+  DINGO_RETURN_NOT_OK(stub_.GetMetaCache()->LookupRegionsByKeys(keys, groups));
+
+  std::vector<TxnSubTask> sub_tasks;
+  std::vector<std::unique_ptr<TxnPessimisticLockRpc>> rpcs;
+  for (const auto& group : groups) {
+    auto rpc = PrepareTxnPessimisticLockRpc(group.region, for_update_ts, out_kvs != nullptr);
+    for (const auto& key : group.keys) {
+      auto* mutation = rpc->MutableRequest()->add_mutations();
+      mutation->set_op(pb::store::Op::Lock);
+      mutation->set_key(std::string(key));
+    }
+    sub_tasks.emplace_back(rpc.get(), group.region);
+    rpcs.push_back(std::move(rpc));
+  }
+
+  RunSubTasksWithLockWait(sub_tasks,
+                          [this](TxnSubTask* sub_task) { return ProcessTxnPessimisticLockSubTask(sub_task); });
+
+  Status result;
+  for (size_t i = 0; i < sub_tasks.size(); i++) {
+    auto& state = sub_tasks[i];
+    if (!state.status.ok()) {
+      DINGO_LOG(WARNING) << "fail txn_pessimistic_lock_sub_task, region: " << state.region->RegionId()
+                         << " status: " << state.status.ToString();
+      if (result.ok()) {
+        result = state.status;
+      }
+      continue;
+    }
+
+    // keys locked are recorded even when other regions fail, so they are released by rollback
+    for (const auto& mutation : rpcs[i]->Request()->mutations()) {
+      buffer_->Lock(mutation.key());
+      locked_keys_[mutation.key()] = for_update_ts;
+    }
+    if (out_kvs != nullptr) {
+      out_kvs->insert(out_kvs->end(), std::make_move_iterator(state.result_kvs.begin()),
+                      std::make_move_iterator(state.result_kvs.end()));
+    }
+  }
+
+  return result;
+}
+
+// scan more rows than limit, rows deleted in local buffer are dropped after scan
+static uint64_t RedundantScanLimit(uint64_t limit, const std::vector<TxnMutation>& range_mutations) {
+  if (limit == 0) {
+    return 0;
+  }
+
+  uint64_t delete_count = 0;
+  for (const auto& mutaion : range_mutations) {
+    if (mutaion.type == TxnMutationType::kDelete) {
+      delete_count++;
+    }
+  }
+  return limit + delete_count;
+}
+
+// overwide scanned kvs with local buffer, local value is projected the same way as value from store
+static void ApplyRangeMutations(const std::vector<TxnMutation>& range_mutations, const ScanOptions& scan_options,
+                                std::map<std::string, std::string>& kvs) {
+  for (const auto& mutaion : range_mutations) {
+    if (mutaion.type == TxnMutationType::kDelete) {
+      kvs.erase(mutaion.key);
+      continue;
+    }
+
+    if (mutaion.type == TxnMutationType::kLock) {
+      continue;
+    }
+
+    std::string value = ProjectScanValue(mutaion.value, scan_options.key_only, scan_options.value_prefix_len);
+    if (mutaion.type == TxnMutationType::kPut) {
+      kvs.insert_or_assign(mutaion.key, std::move(value));
+    } else if (mutaion.type == TxnMutationType::kPutIfAbsent) {
+      auto iter = kvs.find(mutaion.key);
+      if (iter == kvs.end()) {
+        CHECK(kvs.insert(std::make_pair(mutaion.key, std::move(value))).second);
+      }
+    } else {
+      CHECK(false) << "unexpect txn mutation:" << mutaion.ToString();
+    }
+  }
+}
+
+Status Transaction::TxnImpl::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                                  std::vector<KVPair>& kvs, const ScanOptions& scan_options) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  auto meta_cache = stub_.GetMetaCache();
+  {
+    // precheck: return not found if no region in [start, end_key)
+    std::shared_ptr<Region> region;
+    Status ret = meta_cache->LookupRegionBetweenRange(start_key, end_key, region);
+    if (!ret.IsOK()) {
+      if (ret.IsNotFound()) {
+        DINGO_LOG(WARNING) << fmt::format("region not found between [{},{}), no need retry, status:{}", start_key,
+                                          end_key, ret.ToString());
+      } else {
+        DINGO_LOG(WARNING) << fmt::format("lookup region fail between [{},{}), need retry, status:{}", start_key,
+                                          end_key, ret.ToString());
+      }
+      return ret;
+    }
+  }
+
+  std::string next_start = start_key;
+  // store rows are merged with local buffer batch by batch, no kv is kept besides result
+  std::vector<KVPair> to_return;
+  TxnScanMerger merger(buffer_.get(), start_key, end_key, scan_options, limit, to_return);
+  DINGO_RETURN_NOT_OK(merger.GetStatus());
+
+  DINGO_LOG(INFO) << fmt::format("txn scan start between [{},{}), next_start:{}, limit:{}", start_key, end_key,
+                                 next_start, limit);
+
+  int region_retry = 0;
+  while (next_start < end_key) {
+    std::shared_ptr<Region> region;
+    Status ret = meta_cache->LookupRegionBetweenRange(next_start, end_key, region);
+
+    if (ret.IsNotFound()) {
+      DINGO_LOG(INFO) << fmt::format("Break scan because region not found  between [{},{}), start_key:{} status:{}",
+                                     next_start, end_key, start_key, ret.ToString());
+      break;
+    }
+
+    if (!ret.IsOK()) {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start, end_key,
+                                        start_key, ret.ToString());
+      return ret;
+    }
+
+    std::string scanner_start_key =
+        next_start <= region->Range().start_key() ? region->Range().start_key() : next_start;
+    std::string scanner_end_key = end_key <= region->Range().end_key() ? end_key : region->Range().end_key();
+    ScannerOptions scanner_options(stub_, region, scanner_start_key, scanner_end_key, options_, start_ts_);
+    scanner_options.prefetch = FLAGS_scan_prefetch;
+    scanner_options.key_only = scan_options.key_only;
+    scanner_options.value_prefix_len = scan_options.value_prefix_len;
+    std::shared_ptr<RegionScanner> scanner;
+    CHECK(stub_.GetTxnRegionScannerFactory()->NewRegionScanner(scanner_options, scanner).IsOK());
+    ret = scanner->Open();
+    CHECK(ret.ok());
+
+    DINGO_LOG(INFO) << fmt::format("region:{} scan start, region range:({}-{})", region->RegionId(),
+                                   region->Range().start_key(), region->Range().end_key());
+
+    std::vector<KVPair> scan_kvs;
+    while (scanner->HasMore() && !merger.ReachLimit()) {
+      DINGO_LOG(DEBUG) << fmt::format("start call next batch, limit:{}, scan_cnt:{}", limit, to_return.size());
+      scan_kvs.clear();
       ret = scanner->NextBatch(scan_kvs);
       if (!ret.IsOK()) {
         DINGO_LOG(WARNING) << fmt::format("txn region scanner NextBatch fail, region:{}, status:{}", region->RegionId(),
                                           ret.ToString());
-        return ret;
+        break;
       }
 
       if (!scan_kvs.empty()) {
-        for (auto& scan_kv : scan_kvs) {
-          CHECK(tmp_kvs.insert(std::make_pair(std::move(scan_kv.key), std::move(scan_kv.value))).second);
-        }
-
-        if (redundant_limit != 0 && (tmp_kvs.size() >= redundant_limit)) {
-          break;
-        }
+        // a scan resumed after region split or merge goes on right after the last key
+        next_start = scan_kvs.back().key;
+        next_start.push_back('\0');
+        merger.AddBatch(scan_kvs);
       } else {
         DINGO_LOG(INFO) << fmt::format("txn region:{} scanner NextBatch is empty", region->RegionId());
         CHECK(!scanner->HasMore());
       }
     }
 
-    if (redundant_limit != 0 && (tmp_kvs.size() >= redundant_limit)) {
+    if (!ret.IsOK()) {
+      // meta cache is cleared by the store rpc controller, the lookup gets the new region(s)
+      if (IsRegionChanged(ret) && NeedRetryAndInc(region_retry)) {
+        DINGO_LOG(INFO) << fmt::format("region:{} changed during scan, resume from:{}, retry:{}", region->RegionId(),
+                                       next_start, region_retry);
+        DelayRetry(FLAGS_txn_op_delay_ms);
+        continue;
+      }
+      return ret;
+    }
+
+    if (merger.ReachLimit()) {
       DINGO_LOG(INFO) << fmt::format(
-          "region:{} scan finished, stop to scan between [{},{}), next_start:{}, limit:{}, redundant_limit:{}, "
-          "scan_cnt:{}",
-          region->RegionId(), start_key, end_key, next_start, limit, redundant_limit, tmp_kvs.size());
+          "region:{} scan finished, stop to scan between [{},{}), next_start:{}, limit:{}, scan_cnt:{}",
+          region->RegionId(), start_key, end_key, next_start, limit, to_return.size());
       break;
     } else {
       next_start = region->Range().end_key();
@@ -437,29 +983,102 @@ Status Transaction::TxnImpl::Scan(const std::string& start_key, const std::strin
 
   DINGO_LOG(INFO) << fmt::format("scan end between [{},{}), next_start:{}", start_key, end_key, next_start);
 
-  // overwide use local buffer
-  for (const auto& mutaion : range_mutations) {
-    if (mutaion.type == TxnMutationType::kDelete) {
-      tmp_kvs.erase(mutaion.key);
-    } else if (mutaion.type == TxnMutationType::kPut) {
-      tmp_kvs.insert_or_assign(mutaion.key, mutaion.value);
-    } else if (mutaion.type == TxnMutationType::kPutIfAbsent) {
-      auto iter = tmp_kvs.find(mutaion.key);
-      if (iter == tmp_kvs.end()) {
-        CHECK(tmp_kvs.insert(std::make_pair(mutaion.key, mutaion.value)).second);
+  // local mutations after the last store row
+  merger.Finish();
+
+  kvs = std::move(to_return);
+
+  return Status::OK();
+}
+
+Status Transaction::TxnImpl::Export(const std::vector<ExportRange>& ranges, const ExportOptions& options,
+                                    const ExportBatchCallback& cb) {
+  CHECK(IsReadOnly()) << "export is only for snapshot";
+  TxnSnapshotExporter exporter(stub_, options_, start_ts_, ranges, options, cb);
+  return exporter.Run();
+}
+
+Status Transaction::TxnImpl::ReverseScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                                         std::vector<KVPair>& kvs) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  // meta cache only looks up forward, collect regions first, they are mostly cached or prefetched
+  auto meta_cache = stub_.GetMetaCache();
+  std::vector<std::shared_ptr<Region>> regions;
+  std::string next_start = start_key;
+  while (next_start < end_key) {
+    std::shared_ptr<Region> region;
+    Status ret = meta_cache->LookupRegionBetweenRange(next_start, end_key, region);
+    if (ret.IsNotFound()) {
+      break;
+    }
+
+    if (!ret.IsOK()) {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_start, end_key,
+                                        start_key, ret.ToString());
+      return ret;
+    }
+
+    next_start = region->Range().end_key();
+    regions.push_back(std::move(region));
+  }
+
+  if (regions.empty()) {
+    DINGO_LOG(WARNING) << fmt::format("region not found between [{},{}), no need retry", start_key, end_key);
+    return Status::NotFound(fmt::format("region not found between [{},{})", start_key, end_key));
+  }
+
+  std::vector<TxnMutation> range_mutations;
+  if (!IsReadOnly()) {
+    DINGO_RETURN_NOT_OK(buffer_->Range(start_key, end_key, range_mutations));
+  }
+  uint64_t redundant_limit = RedundantScanLimit(limit, range_mutations);
+
+  std::map<std::string, std::string> tmp_kvs;
+  for (auto it = regions.rbegin(); it != regions.rend(); ++it) {
+    const auto& region = *it;
+    std::string scanner_start_key = std::max(start_key, region->Range().start_key());
+    std::string scanner_end_key = std::min(end_key, region->Range().end_key());
+    ScannerOptions scanner_options(stub_, region, scanner_start_key, scanner_end_key, options_, start_ts_);
+    scanner_options.reverse = true;
+    std::shared_ptr<RegionScanner> scanner;
+    CHECK(stub_.GetTxnRegionScannerFactory()->NewRegionScanner(scanner_options, scanner).IsOK());
+    CHECK(scanner->Open().ok());
+
+    while (scanner->HasMore() && (redundant_limit == 0 || tmp_kvs.size() < redundant_limit)) {
+      std::vector<KVPair> scan_kvs;
+      Status ret = scanner->NextBatch(scan_kvs);
+      if (!ret.IsOK()) {
+        DINGO_LOG(WARNING) << fmt::format("txn region scanner reverse NextBatch fail, region:{}, status:{}",
+                                          region->RegionId(), ret.ToString());
+        return ret;
       }
-    } else {
-      CHECK(false) << "unexpect txn mutation:" << mutaion.ToString();
+
+      for (auto& scan_kv : scan_kvs) {
+        CHECK(tmp_kvs.insert(std::make_pair(std::move(scan_kv.key), std::move(scan_kv.value))).second);
+      }
+    }
+
+    if (redundant_limit != 0 && tmp_kvs.size() >= redundant_limit) {
+      break;
     }
   }
 
+  ApplyRangeMutations(range_mutations, ScanOptions(), tmp_kvs);
+
   std::vector<KVPair> to_return;
   to_return.reserve(tmp_kvs.size());
-  for (auto& pair : tmp_kvs) {
-    to_return.push_back({pair.first, std::move(pair.second)});
-  }
-  if (limit != 0 && (to_return.size() >= limit)) {
-    to_return.resize(limit);
+  for (auto iter = tmp_kvs.rbegin(); iter != tmp_kvs.rend(); ++iter) {
+    if (limit != 0 && to_return.size() >= limit) {
+      break;
+    }
+    to_return.push_back({iter->first, std::move(iter->second)});
   }
 
   kvs = std::move(to_return);
@@ -467,6 +1086,36 @@ Status Transaction::TxnImpl::Scan(const std::string& start_key, const std::strin
   return Status::OK();
 }
 
+Status Transaction::TxnImpl::NewIterator(const std::string& start_key, const std::string& end_key,
+                                         const ScanOptions& scan_options, KvIterator** out_iter) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  std::vector<TxnMutation> range_mutations;
+  if (!IsReadOnly()) {
+    DINGO_RETURN_NOT_OK(buffer_->Range(start_key, end_key, range_mutations));
+  }
+  for (auto& mutation : range_mutations) {
+    mutation.value = ProjectScanValue(mutation.value, scan_options.key_only, scan_options.value_prefix_len);
+  }
+
+  auto remote_iter =
+      std::make_unique<RegionScanIterator>(stub_, start_key, end_key, options_, start_ts_, scan_options);
+  auto iter = std::make_unique<TxnKvIterator>(std::move(remote_iter), std::move(range_mutations));
+  Status s = iter->Seek(start_key);
+  if (!s.ok()) {
+    return s;
+  }
+
+  *out_iter = iter.release();
+  return Status::OK();
+}
+
 std::unique_ptr<TxnPrewriteRpc> Transaction::TxnImpl::PrepareTxnPrewriteRpc(
     const std::shared_ptr<Region>& region) const {
   auto rpc = std::make_unique<TxnPrewriteRpc>();
@@ -477,14 +1126,36 @@ std::unique_ptr<TxnPrewriteRpc> Transaction::TxnImpl::PrepareTxnPrewriteRpc(
 
   std::string pk = buffer_->GetPrimaryKey();
   rpc->MutableRequest()->set_primary_lock(pk);
-  rpc->MutableRequest()->set_txn_size(buffer_->MutationsSize());
+  // pipelined txn is prewritten while buffer is written, so use the size recorded at flush
+  rpc->MutableRequest()->set_txn_size(IsPipelined() ? pipeline_txn_size_.load() : buffer_->MutationsSize());
 
-  // FIXME: set ttl
-  rpc->MutableRequest()->set_lock_ttl(INT64_MAX);
+  // without heartbeat, lock never expire until resolved by its committed or rollbacked primary key
+  rpc->MutableRequest()->set_lock_ttl(
+      FLAGS_txn_heartbeat_interval_ms > 0 ? TxnHeartbeatTask::NextLockTtl(start_ts_, start_us_) : INT64_MAX);
 
   return std::move(rpc);
 }
 
+void Transaction::TxnImpl::AddPrewriteMutation(const TxnMutation& mutation,
+                                               pb::store::TxnPrewriteRequest* request) const {
+  TxnMutation2MutationPB(mutation, request->add_mutations());
+  if (!IsPessimistic()) {
+    return;
+  }
+
+  auto iter = locked_keys_.find(mutation.key);
+  if (iter == locked_keys_.end()) {
+    request->add_pessimistic_checks(pb::store::PessimisticCheck::SKIP_PESSIMISTIC_CHECK);
+    return;
+  }
+
+  // prewrite fail if the pessimistic lock is lost or taken again by other lock request
+  request->add_pessimistic_checks(pb::store::PessimisticCheck::DO_PESSIMISTIC_CHECK);
+  auto* check = request->add_for_update_ts_checks();
+  check->set_index(request->mutations_size() - 1);
+  check->set_expected_for_update_ts(iter->second);
+}
+
 void Transaction::TxnImpl::CheckAndLogPreCommitPrimaryKeyResponse(
     const pb::store::TxnPrewriteResponse* response) const {
   std::string pk = buffer_->GetPrimaryKey();
@@ -503,18 +1174,14 @@ void Transaction::TxnImpl::CheckAndLogPreCommitPrimaryKeyResponse(
 Status Transaction::TxnImpl::TryResolveTxnPrewriteLockConflict(const pb::store::TxnPrewriteResponse* response) const {
   Status ret;
   std::string pk = buffer_->GetPrimaryKey();
+  std::vector<pb::store::LockInfo> locks;
   for (const auto& txn_result : response->txn_result()) {
     ret = CheckTxnResultInfo(txn_result);
 
     if (ret.ok()) {
       continue;
     } else if (ret.IsTxnLockConflict()) {
-      Status resolve = stub_.GetTxnLockResolver()->ResolveLock(txn_result.locked(), start_ts_);
-      if (!resolve.ok()) {
-        DINGO_LOG(WARNING) << "fail resolve lock pk:" << pk << ", status:" << ret.ToString()
-                           << " txn_result:" << txn_result.DebugString();
-        ret = resolve;
-      }
+      locks.push_back(txn_result.locked());
     } else if (ret.IsTxnWriteConflict()) {
       DINGO_LOG(WARNING) << "write conflict pk:" << pk << ", status:" << ret.ToString()
                          << " txn_result:" << txn_result.DebugString();
@@ -525,6 +1192,15 @@ Status Transaction::TxnImpl::TryResolveTxnPrewriteLockConflict(const pb::store::
     }
   }
 
+  if (!locks.empty()) {
+    Status resolve = stub_.GetTxnLockResolver()->ResolveLocks(locks, start_ts_);
+    if (!resolve.ok()) {
+      DINGO_LOG(WARNING) << "fail resolve locks pk:" << pk << ", lock_count:" << locks.size()
+                         << ", status:" << resolve.ToString();
+      ret = resolve;
+    }
+  }
+
   return ret;
 }
 
@@ -540,7 +1216,7 @@ Status Transaction::TxnImpl::PreCommitPrimaryKey() {
   std::unique_ptr<TxnPrewriteRpc> rpc = PrepareTxnPrewriteRpc(region);
   TxnMutation mutation;
   CHECK(buffer_->Get(pk, mutation).ok());
-  TxnMutation2MutationPB(mutation, rpc->MutableRequest()->add_mutations());
+  AddPrewriteMutation(mutation, rpc->MutableRequest());
 
   int retry = 0;
   while (true) {
@@ -572,39 +1248,83 @@ Status Transaction::TxnImpl::PreCommitPrimaryKey() {
   return ret;
 }
 
-void Transaction::TxnImpl::ProcessTxnPrewriteSubTask(TxnSubTask* sub_task) {
+bool Transaction::TxnImpl::ProcessTxnPrewriteSubTask(TxnSubTask* sub_task) {
   auto* rpc = CHECK_NOTNULL(dynamic_cast<TxnPrewriteRpc*>(sub_task->rpc));
-  std::string pk = buffer_->GetPrimaryKey();
-  Status ret;
-  int retry = 0;
-  while (true) {
-    ret = LogAndSendRpc(stub_, *rpc, sub_task->region);
-    if (!ret.ok()) {
-      break;
-    }
+  if (!sub_task->status.ok()) {
+    return false;
+  }
 
-    const auto* response = rpc->Response();
-    ret = TryResolveTxnPrewriteLockConflict(response);
+  const auto* response = rpc->Response();
+  Status ret = TryResolveTxnPrewriteLockConflict(response);
+  sub_task->status = ret;
+  if (ret.ok()) {
+    return false;
+  } else if (ret.IsTxnWriteConflict()) {
+    // no need retry
+    // TODO: should we change txn state?
+    DINGO_LOG(WARNING) << "write conflict, txn need abort and restart, pre_commit_primary:" << buffer_->GetPrimaryKey();
+    return false;
+  }
 
-    if (ret.ok()) {
-      break;
-    } else if (ret.IsTxnWriteConflict()) {
-      // no need retry
-      // TODO: should we change txn state?
-      DINGO_LOG(WARNING) << "write conflict, txn need abort and restart, pre_commit_primary:" << pk;
-      break;
-    }
-    if (NeedRetryAndInc(retry)) {
-      // TODO: set txn retry ms
-      DINGO_LOG(INFO) << "try to delay:" << FLAGS_txn_op_delay_ms << "ms";
-      DelayRetry(FLAGS_txn_op_delay_ms);
-    } else {
-      // TODO: maybe set ret as meaningful status
-      break;
-    }
+  // TODO: maybe set ret as meaningful status
+  return true;
+}
+
+bool Transaction::TxnImpl::LookupSingleRegion(std::shared_ptr<Region>& region) const {
+  if (buffer_->HasSpilled()) {
+    return false;
   }
 
-  sub_task->status = ret;
+  const auto& mutations = buffer_->Mutations();
+  if (mutations.size() > static_cast<size_t>(FLAGS_txn_max_batch_count)) {
+    return false;
+  }
+
+  std::vector<std::string_view> keys;
+  keys.reserve(mutations.size());
+  for (const auto& mutaion_entry : mutations) {
+    keys.push_back(mutaion_entry.first);
+  }
+
+  std::vector<RegionKeys> groups;
+  Status s = stub_.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!s.ok() || groups.size() != 1) {
+    return false;
+  }
+
+  region = groups[0].region;
+  return true;
+}
+
+Status Transaction::TxnImpl::PreCommitSingleRegion(const std::shared_ptr<Region>& region) {
+  std::unique_ptr<TxnPrewriteRpc> rpc = PrepareTxnPrewriteRpc(region);
+  for (const auto& mutaion_entry : buffer_->Mutations()) {
+    AddPrewriteMutation(mutaion_entry.second, rpc->MutableRequest());
+  }
+
+  std::vector<TxnSubTask> sub_tasks;
+  sub_tasks.emplace_back(rpc.get(), region);
+  RunSubTasks(sub_tasks, [this](TxnSubTask* sub_task) { return ProcessTxnPrewriteSubTask(sub_task); });
+
+  const auto& state = sub_tasks[0];
+  if (!state.status.ok()) {
+    DINGO_LOG(WARNING) << "fail single region pre_commit, rpc: " << state.rpc->Method()
+                       << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
+  }
+
+  return state.status;
+}
+
+Status Transaction::TxnImpl::CommitSingleRegion(const std::shared_ptr<Region>& region) {
+  std::unique_ptr<TxnCommitRpc> rpc = PrepareTxnCommitRpc(region);
+  for (const auto& mutaion_entry : buffer_->Mutations()) {
+    rpc->MutableRequest()->add_keys(mutaion_entry.first);
+  }
+
+  DINGO_RETURN_NOT_OK(LogAndSendRpc(stub_, *rpc, region));
+
+  const auto* response = rpc->Response();
+  return ProcessTxnCommitResponse(response, true);
 }
 
 // TODO: process AlreadyExist if mutaion is PutIfAbsent
@@ -616,58 +1336,85 @@ Status Transaction::TxnImpl::PreCommit() {
     return Status::OK();
   }
 
-  DINGO_RETURN_NOT_OK(PreCommitPrimaryKey());
-
-  // TODO: start heartbeat
-
-  auto meta_cache = stub_.GetMetaCache();
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<TxnMutation>> region_mutations;
+  if (pipeline_flushed_) {
+    // primary key and most mutations are prewritten by background flushes, only prewrite the rest
+    DINGO_RETURN_NOT_OK(WaitPipelinedFlush());
+    std::vector<TxnMutation> mutations;
+    DINGO_RETURN_NOT_OK(TakeUnflushedMutations(mutations));
+    DINGO_RETURN_NOT_OK(PipelinedPrewrite(mutations, false));
+    state_ = kPreCommitted;
+    return Status::OK();
+  }
 
-  std::string pk = buffer_->GetPrimaryKey();
-  for (const auto& mutaion_entry : buffer_->Mutations()) {
-    if (mutaion_entry.first == pk) {
-      continue;
+  if (FLAGS_txn_single_region_fast_commit) {
+    std::shared_ptr<Region> region;
+    if (LookupSingleRegion(region)) {
+      Status s = PreCommitSingleRegion(region);
+      if (s.ok()) {
+        single_region_ = true;
+        state_ = kPreCommitted;
+        StartHeartBeat();
+      }
+      return s;
     }
+  }
 
-    std::shared_ptr<Region> tmp;
-    Status got = meta_cache->LookupRegionByKey(mutaion_entry.first, tmp);
-    if (!got.IsOK()) {
-      return got;
-    }
+  // primary key must be locked before any secondary key, a reader meeting a secondary lock resolves it by the
+  // status of primary key, and a missing primary lock reads as not found rather than rolled back.
+  // NOTE: async commit, where a txn counts as committed once all prewrites succeed, needs the secondary keys on
+  // the primary lock and min commit ts from store, which the store api has not, so commit still takes the tso and
+  // the primary commit round trip, txn_async_commit_secondary keeps secondary keys out of it.
+  DINGO_RETURN_NOT_OK(PreCommitPrimaryKey());
+
+  StartHeartBeat();
 
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
+  // mutations are prewritten batch by batch, so a spilled buffer is never read back into memory at once
+  std::string pk = buffer_->GetPrimaryKey();
+  Status result = buffer_->ForEachBatch([&](const std::vector<const TxnMutation*>& mutations) {
+    std::vector<const TxnMutation*> to_prewrite;
+    std::vector<std::string_view> keys;
+    to_prewrite.reserve(mutations.size());
+    keys.reserve(mutations.size());
+    for (const auto* mutation : mutations) {
+      if (mutation->key != pk) {
+        to_prewrite.push_back(mutation);
+        keys.push_back(mutation->key);
+      }
     }
+    return PreCommitMutations(to_prewrite, keys);
+  });
 
-    region_mutations[tmp->RegionId()].push_back(mutaion_entry.second);
+  if (result.ok()) {
+    state_ = kPreCommitted;
   }
 
-  std::vector<TxnSubTask> sub_tasks;
-  std::vector<std::unique_ptr<TxnPrewriteRpc>> rpcs;
+  return result;
+}
 
-  for (const auto& mutation_entry : region_mutations) {
-    auto region_id = mutation_entry.first;
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+Status Transaction::TxnImpl::PreparePrewriteSubTasks(const std::vector<const TxnMutation*>& mutations,
+                                                     const std::vector<std::string_view>& keys,
+                                                     TxnSubTasks& tasks) const {
+  std::vector<RegionKeys> groups;
+  DINGO_RETURN_NOT_OK(stub_.GetMetaCache()->LookupRegionsByKeys(keys, groups));
 
-    dingodb::pb::store::TxnPrewriteRequest txn_prewrite_request;
-    for (const auto& mutation : mutation_entry.second) {
-      TxnMutation2MutationPB(mutation, txn_prewrite_request.add_mutations());
-    }
+  // groups are in key order as mutations, so walk mutations along with group keys
+  size_t index = 0;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
     auto rpc = PrepareTxnPrewriteRpc(region);
 
     uint32_t tmp_count = 0;
-    for (int i = 0; i < txn_prewrite_request.mutations_size(); i++) {
-      *rpc->MutableRequest()->add_mutations() = txn_prewrite_request.mutations(i);
+    for (const auto& key : group.keys) {
+      while (index < mutations.size() && mutations[index]->key != key) {
+        index++;
+      }
+      CHECK(index < mutations.size()) << "not found mutation, key:" << key;
+      AddPrewriteMutation(*mutations[index], rpc->MutableRequest());
       tmp_count++;
 
       if (tmp_count == FLAGS_txn_max_batch_count) {
-        sub_tasks.emplace_back(rpc.get(), region);
-        rpcs.push_back(std::move(rpc));
+        tasks.Add(std::move(rpc), region);
         tmp_count = 0;
         rpc = PrepareTxnPrewriteRpc(region);
       }
@@ -676,41 +1423,21 @@ Status Transaction::TxnImpl::PreCommit() {
     DCHECK_NOTNULL(rpc);
 
     if (tmp_count > 0) {
-      sub_tasks.emplace_back(rpc.get(), region);
-      rpcs.push_back(std::move(rpc));
+      tasks.Add(std::move(rpc), region);
     }
   }
 
-  // DCHECK_EQ(rpcs.size(), region_mutations.size());
-  DCHECK_EQ(rpcs.size(), sub_tasks.size());
+  return Status::OK();
+}
 
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(sub_tasks.size());
-  for (auto& sub_task : sub_tasks) {
-    thread_pool.emplace_back(&Transaction::TxnImpl::ProcessTxnPrewriteSubTask, this, &sub_task);
-  }
+Status Transaction::TxnImpl::PreCommitMutations(const std::vector<const TxnMutation*>& mutations,
+                                               const std::vector<std::string_view>& keys) {
+  TxnSubTasks tasks;
+  DINGO_RETURN_NOT_OK(PreparePrewriteSubTasks(mutations, keys, tasks));
 
-  for (auto& thread : thread_pool) {
-    thread.join();
-  }
+  RunSubTasks(tasks.sub_tasks, [this](TxnSubTask* sub_task) { return ProcessTxnPrewriteSubTask(sub_task); });
 
-  Status result;
-  for (auto& state : sub_tasks) {
-    if (!state.status.IsOK()) {
-      DINGO_LOG(WARNING) << "fail txn_pre_write_sub_task, rpc: " << state.rpc->Method()
-                         << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
-      if (result.ok()) {
-        // only return first fail status
-        result = state.status;
-      }
-    }
-  }
-
-  if (result.ok()) {
-    state_ = kPreCommitted;
-  }
-
-  return result;
+  return FirstSubTaskError(tasks.sub_tasks, "txn_pre_write_sub_task");
 }
 
 std::unique_ptr<TxnCommitRpc> Transaction::TxnImpl::PrepareTxnCommitRpc(const std::shared_ptr<Region>& region) const {
@@ -776,20 +1503,15 @@ Status Transaction::TxnImpl::CommitPrimaryKey() {
   return ProcessTxnCommitResponse(response, true);
 }
 
-void Transaction::TxnImpl::ProcessTxnCommitSubTask(TxnSubTask* sub_task) {
+bool Transaction::TxnImpl::ProcessTxnCommitSubTask(TxnSubTask* sub_task) {
   auto* rpc = CHECK_NOTNULL(dynamic_cast<TxnCommitRpc*>(sub_task->rpc));
-  std::string pk = buffer_->GetPrimaryKey();
-  Status ret;
-
-  ret = LogAndSendRpc(stub_, *rpc, sub_task->region);
-  if (!ret.ok()) {
-    sub_task->status = ret;
-    return;
+  if (!sub_task->status.ok()) {
+    return false;
   }
 
   const auto* response = rpc->Response();
-  ret = ProcessTxnCommitResponse(response, true);
-  sub_task->status = ret;
+  sub_task->status = ProcessTxnCommitResponse(response, true);
+  return false;
 }
 
 Status Transaction::TxnImpl::Commit() {
@@ -812,8 +1534,26 @@ Status Transaction::TxnImpl::Commit() {
   CHECK(commit_ts_ > start_ts_) << "commit_ts:" << commit_ts_ << " must greater than start_ts:" << start_ts_
                                 << ", commit_tso:" << commit_tso_.DebugString()
                                 << ", start_tso:" << start_tso_.DebugString();
+  if (single_region_) {
+    // region maybe split after prewrite, fall back to commit primary key first
+    std::shared_ptr<Region> region;
+    if (LookupSingleRegion(region)) {
+      Status ret = CommitSingleRegion(region);
+      StopHeartBeat();
+      if (ret.ok()) {
+        state_ = kCommitted;
+      } else if (ret.IsTxnRolledBack()) {
+        state_ = kRollbackted;
+      } else {
+        DINGO_LOG(INFO) << "unexpect single region commit status:" << ret.ToString();
+      }
+      return ret;
+    }
+  }
+
   // TODO: if commit primary key and find txn is rolled back, should we rollback all the mutation?
   Status ret = CommitPrimaryKey();
+  StopHeartBeat();
   if (!ret.ok()) {
     if (ret.IsTxnRolledBack()) {
       state_ = kRollbackted;
@@ -823,85 +1563,81 @@ Status Transaction::TxnImpl::Commit() {
   } else {
     state_ = kCommitted;
 
-    {
+    if (FLAGS_txn_async_commit_secondary) {
+      // txn is committed once primary key committed, commit other keys in background
+      std::vector<std::string> keys;
+      keys.reserve(buffer_->MutationsSize());
+      Status got = ForEachSecondaryKeys([&keys](const std::vector<std::string_view>& batch_keys) {
+        keys.insert(keys.end(), batch_keys.begin(), batch_keys.end());
+      });
+      if (!got.ok()) {
+        // secondary locks will be resolved by the committed primary key
+        DINGO_LOG(WARNING) << "Fail read secondary keys but ignore, status:" << got.ToString();
+      }
+
+      if (!keys.empty()) {
+        auto* task = new TxnSecondaryCommitTask(stub_, TransactionIsolation2IsolationLevel(options_.isolation),
+                                                start_ts_, commit_ts_, std::move(keys));
+        task->Start();
+      }
+    } else {
       // we commit primary key is success, and then we try best to commit other keys, if fail we ignore
-      auto meta_cache = stub_.GetMetaCache();
-      std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-      std::unordered_map<int64_t, std::vector<std::string>> region_commit_keys;
+      Status got = ForEachSecondaryKeys(
+          [this](const std::vector<std::string_view>& keys) { CommitSecondaryKeys(keys); });
+      if (!got.ok()) {
+        DINGO_LOG(WARNING) << "Fail read secondary keys but ignore, status:" << got.ToString();
+      }
+    }
+  }
 
-      std::string pk = buffer_->GetPrimaryKey();
-      for (const auto& mutaion_entry : buffer_->Mutations()) {
-        if (mutaion_entry.first == pk) {
-          continue;
-        }
+  return ret;
+}
 
-        std::shared_ptr<Region> tmp;
-        Status got = meta_cache->LookupRegionByKey(mutaion_entry.first, tmp);
-        if (!got.IsOK()) {
-          continue;
-        }
+void Transaction::TxnImpl::PrepareTxnCommitSubTasks(const std::vector<std::string_view>& keys,
+                                                    TxnSubTasks& tasks) const {
+  std::vector<RegionKeys> groups;
+  Status got = stub_.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!got.ok()) {
+    // secondary locks will be resolved by the committed primary key
+    DINGO_LOG(WARNING) << "Fail lookup regions for some secondary keys, ignore them, status:" << got.ToString();
+  }
 
-        auto iter = region_id_to_region.find(tmp->RegionId());
-        if (iter == region_id_to_region.end()) {
-          region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-        }
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
-        region_commit_keys[tmp->RegionId()].push_back(mutaion_entry.second.key);
-      }
+    std::unique_ptr<TxnCommitRpc> rpc = PrepareTxnCommitRpc(region);
 
-      std::vector<TxnSubTask> sub_tasks;
-      std::vector<std::unique_ptr<TxnCommitRpc>> rpcs;
-      for (const auto& entry : region_commit_keys) {
-        auto region_id = entry.first;
-        auto iter = region_id_to_region.find(region_id);
-        CHECK(iter != region_id_to_region.end());
-        auto region = iter->second;
-
-        std::unique_ptr<TxnCommitRpc> rpc = PrepareTxnCommitRpc(region);
-
-        uint32_t tmp_count = 0;
-        for (const auto& key : entry.second) {
-          rpc->MutableRequest()->add_keys(key);
-          tmp_count++;
-
-          if (tmp_count == FLAGS_txn_max_batch_count) {
-            sub_tasks.emplace_back(rpc.get(), region);
-            rpcs.push_back(std::move(rpc));
-            tmp_count = 0;
-            rpc = PrepareTxnCommitRpc(region);
-          }
-        }
+    uint32_t tmp_count = 0;
+    for (const auto& key : group.keys) {
+      rpc->MutableRequest()->add_keys(std::string(key));
+      tmp_count++;
 
-        if (tmp_count > 0) {
-          sub_tasks.emplace_back(rpc.get(), region);
-          rpcs.push_back(std::move(rpc));
-        }
+      if (tmp_count == FLAGS_txn_max_batch_count) {
+        tasks.Add(std::move(rpc), region);
+        tmp_count = 0;
+        rpc = PrepareTxnCommitRpc(region);
       }
+    }
 
-      // DCHECK_EQ(rpcs.size(), region_commit_keys.size());
-      DCHECK_EQ(rpcs.size(), sub_tasks.size());
+    if (tmp_count > 0) {
+      tasks.Add(std::move(rpc), region);
+    }
+  }
+}
 
-      std::vector<std::thread> thread_pool;
-      thread_pool.reserve(sub_tasks.size());
-      for (auto& sub_task : sub_tasks) {
-        thread_pool.emplace_back(&Transaction::TxnImpl::ProcessTxnCommitSubTask, this, &sub_task);
-      }
+void Transaction::TxnImpl::CommitSecondaryKeys(const std::vector<std::string_view>& keys) {
+  TxnSubTasks tasks;
+  PrepareTxnCommitSubTasks(keys, tasks);
 
-      for (auto& thread : thread_pool) {
-        thread.join();
-      }
+  RunSubTasks(tasks.sub_tasks, [this](TxnSubTask* sub_task) { return ProcessTxnCommitSubTask(sub_task); });
 
-      for (auto& state : sub_tasks) {
-        // ignore
-        if (!state.status.IsOK()) {
-          DINGO_LOG(INFO) << "Fail txn_commit_sub_task but ignore, rpc: " << state.rpc->Method()
-                          << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
-        }
-      }
+  for (auto& state : tasks.sub_tasks) {
+    // ignore
+    if (!state.status.IsOK()) {
+      DINGO_LOG(INFO) << "Fail txn_commit_sub_task but ignore, rpc: " << state.rpc->Method()
+                      << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
     }
   }
-
-  return ret;
 }
 
 std::unique_ptr<TxnBatchRollbackRpc> Transaction::TxnImpl::PrepareTxnBatchRollbackRpc(
@@ -923,15 +1659,10 @@ void Transaction::TxnImpl::CheckAndLogTxnBatchRollbackResponse(
   }
 }
 
-void Transaction::TxnImpl::ProcessBatchRollbackSubTask(TxnSubTask* sub_task) {
+bool Transaction::TxnImpl::ProcessBatchRollbackSubTask(TxnSubTask* sub_task) {
   auto* rpc = CHECK_NOTNULL(dynamic_cast<TxnBatchRollbackRpc*>(sub_task->rpc));
-  std::string pk = buffer_->GetPrimaryKey();
-  Status ret;
-
-  ret = LogAndSendRpc(stub_, *rpc, sub_task->region);
-  if (!ret.ok()) {
-    sub_task->status = ret;
-    return;
+  if (!sub_task->status.ok()) {
+    return false;
   }
 
   const auto* response = rpc->Response();
@@ -940,22 +1671,29 @@ void Transaction::TxnImpl::ProcessBatchRollbackSubTask(TxnSubTask* sub_task) {
     const auto& txn_result = response->txn_result();
     if (txn_result.has_locked()) {
       sub_task->status = Status::TxnLockConflict("");
-      return;
     }
   }
 
-  sub_task->status = Status::OK();
+  return false;
 }
 
 Status Transaction::TxnImpl::Rollback() {
   // TODO: client txn status maybe inconsistence with server
   // so we should check txn status first and then take action
   // TODO: maybe support rollback when txn is active
-  if (state_ != kRollbacking && state_ != kPreCommitting && state_ != kPreCommitted) {
+  // active pipelined txn may have prewritten mutations by background flush
+  bool pipelined_active = (state_ == kActive && pipeline_flushed_);
+  if (state_ != kRollbacking && state_ != kPreCommitting && state_ != kPreCommitted && !pipelined_active) {
     return Status::IllegalState(fmt::format("forbid rollback, txn state is:{}", TransactionState2Str(state_)));
   }
 
+  if (IsPipelined()) {
+    // fail of flush is ignored, all keys are rollbacked
+    WaitPipelinedFlush();
+  }
+
   state_ = kRollbacking;
+  StopHeartBeat();
   {
     // rollback primary key
     std::string pk = buffer_->GetPrimaryKey();
@@ -983,82 +1721,771 @@ Status Transaction::TxnImpl::Rollback() {
   }
   state_ = kRollbackted;
 
-  {
-    // we rollback primary key is success, and then we try best to rollback other keys, if fail we ignore
-    auto meta_cache = stub_.GetMetaCache();
-    std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-    std::unordered_map<int64_t, std::vector<std::string>> region_rollback_keys;
+  // we rollback primary key is success, and then we try best to rollback other keys, if fail we ignore
+  Status got = ForEachSecondaryKeys(
+      [this](const std::vector<std::string_view>& keys) { RollbackSecondaryKeys(keys); });
+  if (!got.ok()) {
+    DINGO_LOG(WARNING) << "Fail read secondary keys but ignore, status:" << got.ToString();
+  }
 
-    std::string pk = buffer_->GetPrimaryKey();
-    for (const auto& mutaion_entry : buffer_->Mutations()) {
-      if (mutaion_entry.first == pk) {
-        continue;
-      }
+  return Status::OK();
+}
 
-      std::shared_ptr<Region> tmp;
-      Status got = meta_cache->LookupRegionByKey(mutaion_entry.first, tmp);
-      if (!got.IsOK()) {
-        continue;
-      }
+void Transaction::TxnImpl::PrepareTxnBatchRollbackSubTasks(const std::vector<std::string_view>& keys,
+                                                           TxnSubTasks& tasks) const {
+  std::vector<RegionKeys> groups;
+  Status got = stub_.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!got.ok()) {
+    DINGO_LOG(WARNING) << "Fail lookup regions for some secondary keys, ignore them, status:" << got.ToString();
+  }
+
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+
+    std::unique_ptr<TxnBatchRollbackRpc> rpc = PrepareTxnBatchRollbackRpc(region);
+    for (const auto& key : group.keys) {
+      auto* fill = rpc->MutableRequest()->add_keys();
+      *fill = key;
+    }
+    tasks.Add(std::move(rpc), region);
+  }
+
+  DCHECK_EQ(tasks.rpcs.size(), groups.size());
+}
+
+void Transaction::TxnImpl::RollbackSecondaryKeys(const std::vector<std::string_view>& keys) {
+  TxnSubTasks tasks;
+  PrepareTxnBatchRollbackSubTasks(keys, tasks);
+
+  RunSubTasks(tasks.sub_tasks, [this](TxnSubTask* sub_task) { return ProcessBatchRollbackSubTask(sub_task); });
+
+  for (auto& state : tasks.sub_tasks) {
+    // ignore
+    if (!state.status.IsOK()) {
+      DINGO_LOG(INFO) << "Fail txn_batch_rollback_sub_task, but ignore, rpc: " << state.rpc->Method()
+                      << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
+    }
+  }
+}
 
-      auto iter = region_id_to_region.find(tmp->RegionId());
-      if (iter == region_id_to_region.end()) {
-        region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
+Status Transaction::TxnImpl::ForEachSecondaryKeys(
+    const std::function<void(const std::vector<std::string_view>&)>& fn) const {
+  std::string pk = buffer_->GetPrimaryKey();
+  return buffer_->ForEachBatch([&](const std::vector<const TxnMutation*>& mutations) {
+    std::vector<std::string_view> keys;
+    keys.reserve(mutations.size());
+    for (const auto* mutation : mutations) {
+      if (mutation->key != pk) {
+        keys.push_back(mutation->key);
       }
+    }
 
-      region_rollback_keys[tmp->RegionId()].push_back(mutaion_entry.second.key);
+    if (!keys.empty()) {
+      fn(keys);
     }
+    return Status::OK();
+  });
+}
 
-    std::vector<TxnSubTask> sub_tasks;
-    std::vector<std::unique_ptr<TxnBatchRollbackRpc>> rpcs;
-    for (const auto& entry : region_rollback_keys) {
-      auto region_id = entry.first;
-      auto iter = region_id_to_region.find(region_id);
-      CHECK(iter != region_id_to_region.end());
-      auto region = iter->second;
+std::vector<std::string> Transaction::TxnImpl::SecondaryKeys() const {
+  std::vector<std::string> keys;
+  Status got = ForEachSecondaryKeys([&keys](const std::vector<std::string_view>& batch_keys) {
+    keys.insert(keys.end(), batch_keys.begin(), batch_keys.end());
+  });
+  if (!got.ok()) {
+    // secondary locks will be resolved by the primary key
+    DINGO_LOG(WARNING) << "Fail read secondary keys but ignore, status:" << got.ToString();
+  }
+  return keys;
+}
 
-      std::unique_ptr<TxnBatchRollbackRpc> rpc = PrepareTxnBatchRollbackRpc(region);
-      for (const auto& key : entry.second) {
-        auto* fill = rpc->MutableRequest()->add_keys();
-        *fill = key;
+void Transaction::TxnImpl::AsyncGet(const std::string& key, std::string& value, StatusCallback cb) {
+  Status ret;
+  if (!IsReadOnly() && GetFromBuffer(key, value, ret)) {
+    cb(ret);
+    return;
+  }
+
+  std::shared_ptr<Region> region;
+  ret = stub_.GetMetaCache()->LookupRegionByKey(key, region);
+  if (!ret.IsOK()) {
+    cb(ret);
+    return;
+  }
+
+  auto run = std::make_shared<AsyncSubTasks>();
+  std::unique_ptr<TxnGetRpc> rpc = PrepareTxnGetRpc(region);
+  rpc->MutableRequest()->set_key(key);
+  const auto* response = rpc->Response();
+  run->tasks.Add(std::move(rpc), region);
+
+  AsyncRunSubTasks(
+      run, [this](TxnSubTask* sub_task) { return ProcessTxnGetSubTask(sub_task); },
+      [run, response, &key, &value, cb]() {
+        Status ret = run->tasks.sub_tasks[0].status;
+        if (ret.ok()) {
+          if (response->value().empty()) {
+            ret = Status::NotFound(fmt::format("key:{} not found", key));
+          } else {
+            value = response->value();
+          }
+        }
+        cb(ret);
+      });
+}
+
+void Transaction::TxnImpl::AsyncBatchGet(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs,
+                                         StatusCallback cb) {
+  auto buffered = std::make_shared<std::vector<KVPair>>();
+  std::vector<std::string_view> not_found;
+  const std::vector<std::string_view>* to_read = &keys;
+  if (!IsReadOnly()) {
+    GetFromBuffer(keys, *buffered, not_found);
+    to_read = &not_found;
+  }
+
+  if (to_read->empty()) {
+    kvs = std::move(*buffered);
+    cb(Status::OK());
+    return;
+  }
+
+  auto run = std::make_shared<AsyncSubTasks>();
+  Status ret = PrepareTxnBatchGetSubTasks(*to_read, run->tasks);
+  if (!ret.ok()) {
+    cb(ret);
+    return;
+  }
+
+  AsyncRunSubTasks(
+      run, [this](TxnSubTask* sub_task) { return ProcessTxnBatchGetSubTask(sub_task); },
+      [run, buffered, &kvs, cb]() {
+        std::vector<KVPair> batch_get;
+        Status ret = CollectTxnBatchGetResult(run->tasks.sub_tasks, batch_get);
+        buffered->insert(buffered->end(), std::make_move_iterator(batch_get.begin()),
+                         std::make_move_iterator(batch_get.end()));
+        kvs = std::move(*buffered);
+        cb(ret);
+      });
+}
+
+void Transaction::TxnImpl::AsyncPreCommit(StatusCallback cb) {
+  state_ = kPreCommitting;
+
+  if (buffer_->IsEmpty()) {
+    state_ = kPreCommitted;
+    cb(Status::OK());
+    return;
+  }
+
+  if (pipeline_flushed_ || buffer_->HasSpilled()) {
+    // waiting flushes in flight and reading spilled batches back both block, so the sync one runs in background
+    stub_.GetBackgroundActuator()->Execute([this, cb] { cb(PreCommit()); });
+    return;
+  }
+
+  if (FLAGS_txn_single_region_fast_commit) {
+    std::shared_ptr<Region> region;
+    if (LookupSingleRegion(region)) {
+      auto run = std::make_shared<AsyncSubTasks>();
+      std::unique_ptr<TxnPrewriteRpc> rpc = PrepareTxnPrewriteRpc(region);
+      for (const auto& mutaion_entry : buffer_->Mutations()) {
+        AddPrewriteMutation(mutaion_entry.second, rpc->MutableRequest());
       }
-      sub_tasks.emplace_back(rpc.get(), region);
-      rpcs.push_back(std::move(rpc));
+      run->tasks.Add(std::move(rpc), region);
+
+      AsyncRunSubTasks(
+          run, [this](TxnSubTask* sub_task) { return ProcessTxnPrewriteSubTask(sub_task); },
+          [this, run, cb]() {
+            Status ret = FirstSubTaskError(run->tasks.sub_tasks, "single region pre_commit");
+            if (ret.ok()) {
+              single_region_ = true;
+              state_ = kPreCommitted;
+              StartHeartBeat();
+            }
+            cb(ret);
+          });
+      return;
     }
+  }
+
+  std::string pk = buffer_->GetPrimaryKey();
+  std::shared_ptr<Region> region;
+  Status ret = stub_.GetMetaCache()->LookupRegionByKey(pk, region);
+  if (!ret.IsOK()) {
+    cb(ret);
+    return;
+  }
 
-    DCHECK_EQ(rpcs.size(), region_rollback_keys.size());
-    DCHECK_EQ(rpcs.size(), sub_tasks.size());
+  auto run = std::make_shared<AsyncSubTasks>();
+  std::unique_ptr<TxnPrewriteRpc> rpc = PrepareTxnPrewriteRpc(region);
+  TxnMutation mutation;
+  CHECK(buffer_->Get(pk, mutation).ok());
+  AddPrewriteMutation(mutation, rpc->MutableRequest());
+  run->tasks.Add(std::move(rpc), region);
+
+  AsyncRunSubTasks(
+      run,
+      [this](TxnSubTask* sub_task) {
+        if (sub_task->status.ok()) {
+          CheckAndLogPreCommitPrimaryKeyResponse(dynamic_cast<TxnPrewriteRpc*>(sub_task->rpc)->Response());
+        }
+        return ProcessTxnPrewriteSubTask(sub_task);
+      },
+      [this, run, cb]() {
+        Status ret = run->tasks.sub_tasks[0].status;
+        if (!ret.ok()) {
+          cb(ret);
+          return;
+        }
+        StartHeartBeat();
+        AsyncPreCommitMutations(cb);
+      });
+}
+
+void Transaction::TxnImpl::AsyncPreCommitMutations(StatusCallback cb) {
+  std::string pk = buffer_->GetPrimaryKey();
+  std::vector<const TxnMutation*> to_prewrite;
+  std::vector<std::string_view> keys;
+  for (const auto& mutaion_entry : buffer_->Mutations()) {
+    if (mutaion_entry.first != pk) {
+      to_prewrite.push_back(&mutaion_entry.second);
+      keys.push_back(mutaion_entry.first);
+    }
+  }
+
+  auto run = std::make_shared<AsyncSubTasks>();
+  Status ret = PreparePrewriteSubTasks(to_prewrite, keys, run->tasks);
+  if (!ret.ok()) {
+    cb(ret);
+    return;
+  }
+
+  AsyncRunSubTasks(
+      run, [this](TxnSubTask* sub_task) { return ProcessTxnPrewriteSubTask(sub_task); },
+      [this, run, cb]() {
+        Status ret = FirstSubTaskError(run->tasks.sub_tasks, "txn_pre_write_sub_task");
+        if (ret.ok()) {
+          state_ = kPreCommitted;
+        }
+        cb(ret);
+      });
+}
 
-    std::vector<std::thread> thread_pool;
-    for (auto i = 1; i < sub_tasks.size(); i++) {
-      thread_pool.emplace_back(&Transaction::TxnImpl::ProcessBatchRollbackSubTask, this, &sub_tasks[i]);
+void Transaction::TxnImpl::AsyncCommit(StatusCallback cb) {
+  if (state_ != kPreCommitted) {
+    cb(Status::IllegalState(fmt::format("forbid commit, txn state is:{}, expect:{}", TransactionState2Str(state_),
+                                        TransactionState2Str(kPreCommitted))));
+    return;
+  }
+
+  if (buffer_->IsEmpty()) {
+    state_ = kCommitted;
+    cb(Status::OK());
+    return;
+  }
+
+  if (buffer_->HasSpilled()) {
+    stub_.GetBackgroundActuator()->Execute([this, cb] { cb(Commit()); });
+    return;
+  }
+
+  state_ = kCommitting;
+
+  // tso request waits for the batched tso rpc, so it runs in background
+  stub_.GetBackgroundActuator()->Execute([this, cb] {
+    pb::meta::TsoTimestamp tso;
+    Status ret = stub_.GetAdminTool()->GetCurrentTsoTimeStamp(tso);
+    if (!ret.ok()) {
+      cb(ret);
+      return;
+    }
+
+    commit_tso_ = tso;
+    commit_ts_ = Tso2Timestamp(commit_tso_);
+    CHECK(commit_ts_ > start_ts_) << "commit_ts:" << commit_ts_ << " must greater than start_ts:" << start_ts_
+                                  << ", commit_tso:" << commit_tso_.DebugString()
+                                  << ", start_tso:" << start_tso_.DebugString();
+    AsyncCommitWithTs(cb);
+  });
+}
+
+void Transaction::TxnImpl::AsyncCommitWithTs(StatusCallback cb) {
+  auto run = std::make_shared<AsyncSubTasks>();
+
+  // region maybe split after prewrite, fall back to commit primary key first
+  std::shared_ptr<Region> region;
+  bool single_region = single_region_ && LookupSingleRegion(region);
+  if (single_region) {
+    std::unique_ptr<TxnCommitRpc> rpc = PrepareTxnCommitRpc(region);
+    for (const auto& mutaion_entry : buffer_->Mutations()) {
+      rpc->MutableRequest()->add_keys(mutaion_entry.first);
+    }
+    run->tasks.Add(std::move(rpc), region);
+  } else {
+    std::string pk = buffer_->GetPrimaryKey();
+    Status ret = stub_.GetMetaCache()->LookupRegionByKey(pk, region);
+    if (!ret.IsOK()) {
+      cb(ret);
+      return;
     }
 
-    ProcessBatchRollbackSubTask(sub_tasks.data());
+    std::unique_ptr<TxnCommitRpc> rpc = PrepareTxnCommitRpc(region);
+    rpc->MutableRequest()->add_keys(pk);
+    run->tasks.Add(std::move(rpc), region);
+  }
+
+  AsyncRunSubTasks(
+      run, [this](TxnSubTask* sub_task) { return ProcessTxnCommitSubTask(sub_task); },
+      [this, run, single_region, cb]() {
+        Status ret = run->tasks.sub_tasks[0].status;
+        StopHeartBeat();
+        if (!ret.ok()) {
+          if (ret.IsTxnRolledBack()) {
+            state_ = kRollbackted;
+          } else {
+            DINGO_LOG(INFO) << "unexpect commit primary key status:" << ret.ToString();
+          }
+          cb(ret);
+          return;
+        }
+
+        state_ = kCommitted;
+        if (single_region) {
+          cb(ret);
+          return;
+        }
+        AsyncCommitSecondaryKeys(cb);
+      });
+}
 
-    for (auto& thread : thread_pool) {
-      thread.join();
+void Transaction::TxnImpl::AsyncCommitSecondaryKeys(StatusCallback cb) {
+  std::vector<std::string> keys = SecondaryKeys();
+  if (keys.empty()) {
+    cb(Status::OK());
+    return;
+  }
+
+  if (FLAGS_txn_async_commit_secondary) {
+    // txn is committed once primary key committed, commit other keys in background
+    auto* task = new TxnSecondaryCommitTask(stub_, TransactionIsolation2IsolationLevel(options_.isolation), start_ts_,
+                                            commit_ts_, std::move(keys));
+    task->Start();
+    cb(Status::OK());
+    return;
+  }
+
+  // try best to commit other keys, if fail we ignore
+  auto run = std::make_shared<AsyncSubTasks>();
+  PrepareTxnCommitSubTasks(std::vector<std::string_view>(keys.begin(), keys.end()), run->tasks);
+  AsyncRunSubTasks(
+      run, [this](TxnSubTask* sub_task) { return ProcessTxnCommitSubTask(sub_task); },
+      [run, cb]() {
+        Status ignored = FirstSubTaskError(run->tasks.sub_tasks, "txn_commit_sub_task but ignore");
+        cb(Status::OK());
+      });
+}
+
+void Transaction::TxnImpl::AsyncRollback(StatusCallback cb) {
+  bool pipelined_active = (state_ == kActive && pipeline_flushed_);
+  if (state_ != kRollbacking && state_ != kPreCommitting && state_ != kPreCommitted && !pipelined_active) {
+    cb(Status::IllegalState(fmt::format("forbid rollback, txn state is:{}", TransactionState2Str(state_))));
+    return;
+  }
+
+  if (IsPipelined() || buffer_->HasSpilled()) {
+    stub_.GetBackgroundActuator()->Execute([this, cb] { cb(Rollback()); });
+    return;
+  }
+
+  state_ = kRollbacking;
+  StopHeartBeat();
+
+  std::string pk = buffer_->GetPrimaryKey();
+  std::shared_ptr<Region> region;
+  Status ret = stub_.GetMetaCache()->LookupRegionByKey(pk, region);
+  if (!ret.IsOK()) {
+    cb(ret);
+    return;
+  }
+
+  auto run = std::make_shared<AsyncSubTasks>();
+  std::unique_ptr<TxnBatchRollbackRpc> rpc = PrepareTxnBatchRollbackRpc(region);
+  rpc->MutableRequest()->add_keys(pk);
+  run->tasks.Add(std::move(rpc), region);
+
+  AsyncRunSubTasks(
+      run, [this](TxnSubTask* sub_task) { return ProcessBatchRollbackSubTask(sub_task); },
+      [this, run, cb]() {
+        Status ret = run->tasks.sub_tasks[0].status;
+        if (!ret.ok()) {
+          cb(ret);
+          return;
+        }
+
+        state_ = kRollbackted;
+        AsyncRollbackSecondaryKeys(cb);
+      });
+}
+
+void Transaction::TxnImpl::AsyncRollbackSecondaryKeys(StatusCallback cb) {
+  std::vector<std::string> keys = SecondaryKeys();
+  if (keys.empty()) {
+    cb(Status::OK());
+    return;
+  }
+
+  // try best to rollback other keys, if fail we ignore
+  auto run = std::make_shared<AsyncSubTasks>();
+  PrepareTxnBatchRollbackSubTasks(std::vector<std::string_view>(keys.begin(), keys.end()), run->tasks);
+  AsyncRunSubTasks(
+      run, [this](TxnSubTask* sub_task) { return ProcessBatchRollbackSubTask(sub_task); },
+      [run, cb]() {
+        Status ignored = FirstSubTaskError(run->tasks.sub_tasks, "txn_batch_rollback_sub_task but ignore");
+        cb(Status::OK());
+      });
+}
+
+Status Transaction::TxnImpl::FirstSubTaskError(const std::vector<TxnSubTask>& sub_tasks, const char* name) {
+  Status result;
+  for (const auto& state : sub_tasks) {
+    if (!state.status.IsOK()) {
+      DINGO_LOG(WARNING) << "Fail " << name << ", rpc: " << state.rpc->Method()
+                         << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
+      if (result.ok()) {
+        // only return first fail status
+        result = state.status;
+      }
     }
+  }
+  return result;
+}
+
+void Transaction::TxnImpl::RunSubTasks(std::vector<TxnSubTask>& sub_tasks, const SubTaskProcessFn& process_fn) {
+  std::vector<TxnSubTask*> pending;
+  pending.reserve(sub_tasks.size());
+  for (auto& sub_task : sub_tasks) {
+    pending.push_back(&sub_task);
+  }
+
+  int retry = 0;
+  while (!pending.empty()) {
+    AsyncSendSubTasksAndWait(pending);
 
-    for (auto& state : sub_tasks) {
-      // ignore
-      if (!state.status.IsOK()) {
-        DINGO_LOG(INFO) << "Fail txn_batch_rollback_sub_task, but ignore, rpc: " << state.rpc->Method()
-                        << " send to region: " << state.region->RegionId() << " status: " << state.status.ToString();
+    std::vector<TxnSubTask*> need_retry;
+    for (auto* sub_task : pending) {
+      if (process_fn(sub_task)) {
+        need_retry.push_back(sub_task);
       }
     }
+
+    if (need_retry.empty() || !NeedRetryAndInc(retry)) {
+      // sub tasks which still need retry keep their last fail status
+      break;
+    }
+
+    // TODO: set txn retry ms
+    DINGO_LOG(INFO) << "try to delay:" << FLAGS_txn_op_delay_ms << "ms, retry sub task count:" << need_retry.size();
+    DelayRetry(FLAGS_txn_op_delay_ms);
+    pending.swap(need_retry);
+  }
+}
+
+void Transaction::TxnImpl::RunSubTasksWithLockWait(std::vector<TxnSubTask>& sub_tasks,
+                                                   const SubTaskProcessFn& process_fn) {
+  if (sub_tasks.empty()) {
+    return;
+  }
+
+  // actuator threads have no token of caller
+  auto cancel_token = CancelToken::Current();
+  int64_t deadline_ms = SteadyNowMs() + FLAGS_txn_pessimistic_lock_wait_timeout_ms;
+
+  struct RunState {
+    std::unique_ptr<StoreRpcController> controller;
+    int64_t backoff_ms;
+  };
+  std::vector<RunState> states(sub_tasks.size());
+  CountDownSync sync(sub_tasks.size());
+
+  std::function<void(size_t)> send;
+  auto on_done = [&](size_t i) {
+    // lock resolve send rpc synchronously, so process out of rpc callback
+    stub_.GetActuator()->Execute([&, i] {
+      auto* sub_task = &sub_tasks[i];
+      bool retry = process_fn(sub_task);
+      bool expired = SteadyNowMs() >= deadline_ms || (cancel_token != nullptr && !cancel_token->Check().ok());
+      if (!retry || expired) {
+        // sub task keep its last fail status when expired
+        sync.CountDown();
+        return;
+      }
+
+      int64_t delay_ms = states[i].backoff_ms;
+      states[i].backoff_ms = std::min(delay_ms * 2, std::max<int64_t>(FLAGS_txn_op_delay_ms, 1));
+      DINGO_LOG(DEBUG) << "region:" << sub_task->region->RegionId() << " wait lock, resend after " << delay_ms << "ms";
+      stub_.GetActuator()->Schedule([&send, i] { send(i); }, delay_ms);
+    });
+  };
+
+  send = [&](size_t i) {
+    auto* sub_task = &sub_tasks[i];
+    states[i].controller = std::make_unique<StoreRpcController>(stub_, *sub_task->rpc, sub_task->region);
+    states[i].controller->AsyncCall([&, i, sub_task](Status s) {
+      sub_task->status = std::move(s);
+      on_done(i);
+    });
+  };
+
+  for (size_t i = 0; i < sub_tasks.size(); i++) {
+    states[i].backoff_ms = std::max<int64_t>(FLAGS_txn_pessimistic_lock_backoff_ms, 1);
+    send(i);
+  }
+
+  sync.Wait();
+}
+
+void Transaction::TxnImpl::AsyncSendSubTasksAndWait(const std::vector<TxnSubTask*>& sub_tasks) {
+  if (sub_tasks.empty()) {
+    return;
+  }
+
+  std::vector<std::unique_ptr<StoreRpcController>> controllers;
+  controllers.reserve(sub_tasks.size());
+  CountDownSync sync(sub_tasks.size());
+  for (auto* sub_task : sub_tasks) {
+    controllers.push_back(std::make_unique<StoreRpcController>(stub_, *sub_task->rpc, sub_task->region));
+  }
+
+  for (size_t i = 0; i < sub_tasks.size(); i++) {
+    auto* sub_task = sub_tasks[i];
+    controllers[i]->AsyncCall([sub_task, &sync](Status s) {
+      sub_task->status = std::move(s);
+      sync.CountDown();
+    });
+  }
+
+  sync.Wait();
+}
+
+void Transaction::TxnImpl::AsyncRunSubTasks(std::shared_ptr<AsyncSubTasks> run, SubTaskProcessFn process_fn,
+                                            std::function<void()> done) {
+  run->pending.clear();
+  for (auto& sub_task : run->tasks.sub_tasks) {
+    run->pending.push_back(&sub_task);
+  }
+
+  if (run->pending.empty()) {
+    done();
+    return;
+  }
+
+  AsyncSendSubTasks(std::move(run), std::move(process_fn), std::move(done));
+}
+
+void Transaction::TxnImpl::AsyncSendSubTasks(std::shared_ptr<AsyncSubTasks> run, SubTaskProcessFn process_fn,
+                                             std::function<void()> done) {
+  // the last callback may start next round in actuator, so nothing of run is read after the last AsyncCall
+  std::vector<std::pair<StoreRpcController*, TxnSubTask*>> calls;
+  calls.reserve(run->pending.size());
+  for (auto* sub_task : run->pending) {
+    run->controllers.push_back(std::make_unique<StoreRpcController>(stub_, *sub_task->rpc, sub_task->region));
+    calls.emplace_back(run->controllers.back().get(), sub_task);
+  }
+  run->inflight.store(calls.size());
+
+  for (auto& [controller, sub_task] : calls) {
+    controller->AsyncCall([this, run, sub_task = sub_task, process_fn, done](Status s) {
+      sub_task->status = std::move(s);
+      if (run->inflight.fetch_sub(1) != 1) {
+        return;
+      }
+
+      // lock resolve send rpc synchronously, so process out of rpc callback
+      stub_.GetActuator()->Execute([this, run, process_fn, done] {
+        std::vector<TxnSubTask*> need_retry;
+        for (auto* sub_task : run->pending) {
+          if (process_fn(sub_task)) {
+            need_retry.push_back(sub_task);
+          }
+        }
+
+        if (need_retry.empty() || !NeedRetryAndInc(run->retry)) {
+          // sub tasks which still need retry keep their last fail status, controllers hold run by their callbacks
+          auto controllers = std::move(run->controllers);
+          done();
+          return;
+        }
+
+        DINGO_LOG(INFO) << "try to delay:" << FLAGS_txn_op_delay_ms
+                        << "ms, retry sub task count:" << need_retry.size();
+        run->pending.swap(need_retry);
+        stub_.GetActuator()->Schedule([this, run, process_fn, done] { AsyncSendSubTasks(run, process_fn, done); },
+                                      FLAGS_txn_op_delay_ms);
+      });
+    });
+  }
+}
+
+Status Transaction::TxnImpl::CheckPipelinedWrite(std::string_view key) const {
+  if (IsPipelined() && flushed_keys_.find(key) != flushed_keys_.end()) {
+    return Status::NotSupported(fmt::format("key:{} is flushed by pipelined txn, can't be written again", key));
+  }
+  return Status::OK();
+}
+
+Status Transaction::TxnImpl::PipelinedWrite(std::vector<std::string> keys, int64_t bytes) {
+  {
+    // txn will fail at PreCommit, fail fast
+    std::unique_lock<std::mutex> lk(pipeline_mutex_);
+    DINGO_RETURN_NOT_OK(pipeline_status_);
   }
 
+  for (auto& key : keys) {
+    unflushed_keys_.push_back(std::move(key));
+  }
+  unflushed_bytes_ += bytes;
+  if (unflushed_bytes_ < FLAGS_txn_pipelined_flush_bytes) {
+    return Status::OK();
+  }
+
+  // back pressure, caller wait when it writes faster than prewrite
+  DINGO_RETURN_NOT_OK(WaitPipelinedFlush());
+
+  auto flush = std::make_shared<PipelinedFlush>();
+  DINGO_RETURN_NOT_OK(TakeUnflushedMutations(flush->mutations));
+
+  flush->primary_first = !pipeline_flushed_;
+  pipeline_flushed_ = true;
+
+  {
+    std::unique_lock<std::mutex> lk(pipeline_mutex_);
+    pipeline_flushing_ = true;
+  }
+
+  // prewrite blocks on rpcs, so it runs in background
+  pipeline_flush_ = flush;
+  stub_.GetBackgroundActuator()->Execute([this, flush] { RunPipelinedFlush(flush); });
+
   return Status::OK();
 }
 
+Status Transaction::TxnImpl::TakeUnflushedMutations(std::vector<TxnMutation>& mutations) {
+  std::sort(unflushed_keys_.begin(), unflushed_keys_.end());
+  unflushed_keys_.erase(std::unique(unflushed_keys_.begin(), unflushed_keys_.end()), unflushed_keys_.end());
+
+  mutations.reserve(unflushed_keys_.size());
+  for (const auto& key : unflushed_keys_) {
+    TxnMutation mutation;
+    DINGO_RETURN_NOT_OK(buffer_->Get(key, mutation));
+    mutations.push_back(std::move(mutation));
+    flushed_keys_.insert(key);
+  }
+
+  unflushed_keys_.clear();
+  unflushed_bytes_ = 0;
+  pipeline_txn_size_.store(buffer_->MutationsSize());
+  return Status::OK();
+}
+
+void Transaction::TxnImpl::RunPipelinedFlush(const std::shared_ptr<PipelinedFlush>& flush) {
+  if (flush->started.exchange(true)) {
+    return;
+  }
+
+  Status s = PipelinedPrewrite(flush->mutations, flush->primary_first);
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("pipelined prewrite fail, start_ts:{}, mutations:{}, status:{}", start_ts_,
+                                      flush->mutations.size(), s.ToString());
+  }
+  std::vector<TxnMutation>().swap(flush->mutations);
+
+  std::unique_lock<std::mutex> lk(pipeline_mutex_);
+  if (!s.ok() && pipeline_status_.ok()) {
+    pipeline_status_ = s;
+  }
+  pipeline_flushing_ = false;
+  pipeline_cv_.notify_all();
+}
+
+Status Transaction::TxnImpl::PipelinedPrewrite(const std::vector<TxnMutation>& mutations, bool primary_first) {
+  std::string pk = buffer_->GetPrimaryKey();
+
+  std::vector<const TxnMutation*> to_prewrite;
+  std::vector<std::string_view> keys;
+  to_prewrite.reserve(mutations.size());
+  keys.reserve(mutations.size());
+  for (const auto& mutation : mutations) {
+    if (primary_first && mutation.key == pk) {
+      // primary key is prewritten before others, so a secondary lock never points at a missing primary lock
+      DINGO_RETURN_NOT_OK(PreCommitMutations({&mutation}, {mutation.key}));
+      // heartbeat_ is only touched by caller after it waits for the flush
+      StartHeartBeat();
+    } else {
+      to_prewrite.push_back(&mutation);
+      keys.push_back(mutation.key);
+    }
+  }
+
+  if (to_prewrite.empty()) {
+    return Status::OK();
+  }
+  return PreCommitMutations(to_prewrite, keys);
+}
+
+Status Transaction::TxnImpl::WaitPipelinedFlush() {
+  // run it here if background has not started it yet
+  if (pipeline_flush_ != nullptr) {
+    RunPipelinedFlush(pipeline_flush_);
+    pipeline_flush_.reset();
+  }
+
+  std::unique_lock<std::mutex> lk(pipeline_mutex_);
+  pipeline_cv_.wait(lk, [this] { return !pipeline_flushing_; });
+  return pipeline_status_;
+}
+
+void Transaction::TxnImpl::StartHeartBeat() {
+  if (FLAGS_txn_heartbeat_interval_ms <= 0 || heartbeat_ != nullptr) {
+    return;
+  }
+
+  heartbeat_ = std::make_shared<TxnHeartbeatTask>(stub_, TransactionIsolation2IsolationLevel(options_.isolation),
+                                                  start_ts_, start_us_, buffer_->GetPrimaryKey());
+  heartbeat_->Start();
+}
+
+void Transaction::TxnImpl::StopHeartBeat() {
+  if (heartbeat_ != nullptr) {
+    heartbeat_->Stop();
+    heartbeat_.reset();
+  }
+}
+
 bool Transaction::TxnImpl::NeedRetryAndInc(int& times) {
+  // txn ops run in the caller thread, so the token of the caller applies, see ScopedCancelToken
+  auto cancel_token = CancelToken::Current();
+  if (cancel_token != nullptr) {
+    Status s = cancel_token->Check();
+    if (!s.ok()) {
+      DINGO_LOG(INFO) << "txn op stop retry, status:" << s.ToString() << ", retry times:" << times;
+      return false;
+    }
+  }
+
+  // txn ops retry after resolving locks or after region changes, neither is charged to the retry budget
   bool retry = times < FLAGS_txn_op_max_retry;
   times++;
   return retry;
 }
 
-void Transaction::TxnImpl::DelayRetry(int64_t delay_ms) { (void)usleep(delay_ms * 1000); }
+void Transaction::TxnImpl::DelayRetry(int64_t delay_ms) {
+  auto cancel_token = CancelToken::Current();
+  if (cancel_token != nullptr && cancel_token->RemainingMs() >= 0) {
+    delay_ms = std::min(delay_ms, cancel_token->RemainingMs());
+  }
+  (void)usleep(delay_ms * 1000);
+}
 
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
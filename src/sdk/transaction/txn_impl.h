@@ -15,8 +15,19 @@
 #ifndef DINGODB_SDK_TRANSACTION_IMPL_H_
 #define DINGODB_SDK_TRANSACTION_IMPL_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "sdk/client.h"
 #include "sdk/client_stub.h"
@@ -24,11 +35,14 @@
 #include "proto/store.pb.h"
 #include "sdk/region.h"
 #include "sdk/rpc/store_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/transaction/txn_buffer.h"
 
 namespace dingodb {
 namespace sdk {
 
+class TxnHeartbeatTask;
+
 enum TransactionState : uint8_t {
   kInit,
   kActive,
@@ -63,7 +77,6 @@ static const char* TransactionState2Str(TransactionState state) {
   }
 }
 
-// TODO: support read only txn
 class Transaction::TxnImpl {
  public:
   TxnImpl(const TxnImpl&) = delete;
@@ -71,18 +84,29 @@ class Transaction::TxnImpl {
 
   explicit TxnImpl(const ClientStub& stub, const TransactionOptions& options);
 
-  ~TxnImpl() = default;
+  // read only txn at read_ts with snapshot isolation, no Begin and no buffer, only read methods can be called
+  TxnImpl(const ClientStub& stub, int64_t read_ts);
+
+  ~TxnImpl();
 
   Status Begin();
 
   Status Get(const std::string& key, std::string& value);
 
+  Status Get(const std::string& key, std::string& value, const ReadOptions& options);
+
   Status BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs);
 
+  Status BatchGet(const Slice* keys, size_t key_count, std::vector<KVPair>& kvs);
+
+  Status BatchGetForUpdate(const std::vector<std::string>& keys, std::vector<KVPair>& kvs);
+
   Status Put(const std::string& key, const std::string& value);
 
   Status BatchPut(const std::vector<KVPair>& kvs);
 
+  Status BatchPut(std::vector<KVPair>&& kvs);
+
   Status PutIfAbsent(const std::string& key, const std::string& value);
 
   Status BatchPutIfAbsent(const std::vector<KVPair>& kvs);
@@ -91,7 +115,17 @@ class Transaction::TxnImpl {
 
   Status BatchDelete(const std::vector<std::string>& keys);
 
-  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs);
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs,
+              const ScanOptions& scan_options);
+
+  Status ReverseScan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                     std::vector<KVPair>& kvs);
+
+  Status NewIterator(const std::string& start_key, const std::string& end_key, const ScanOptions& scan_options,
+                     KvIterator** out_iter);
+
+  // only for read only txn, see Snapshot::Export
+  Status Export(const std::vector<ExportRange>& ranges, const ExportOptions& options, const ExportBatchCallback& cb);
 
   Status PreCommit();
 
@@ -99,6 +133,21 @@ class Transaction::TxnImpl {
 
   Status Rollback();
 
+  // async api of Transaction, see there. Waiting for rpcs holds no thread, responses are processed by actuator
+  void AsyncGet(const std::string& key, std::string& value, StatusCallback cb);
+
+  void AsyncBatchGet(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs, StatusCallback cb);
+
+  void AsyncPreCommit(StatusCallback cb);
+
+  void AsyncCommit(StatusCallback cb);
+
+  void AsyncRollback(StatusCallback cb);
+
+  bool IsReadOnly() const { return buffer_ == nullptr; }
+
+  int64_t GetStartTs() const { return start_ts_; }
+
   TransactionState TEST_GetTransactionState() { return state_; }         // NOLINT
   int64_t TEST_GetStartTs() { return start_ts_; }                        // NOLINT
   int64_t TEST_GetCommitTs() { return commit_ts_; }                      // NOLINT
@@ -115,33 +164,162 @@ class Transaction::TxnImpl {
     TxnSubTask(Rpc* p_rpc, std::shared_ptr<Region> p_region) : rpc(p_rpc), region(std::move(p_region)) {}
   };
 
+  // sub tasks and the rpcs they point to
+  struct TxnSubTasks {
+    std::vector<std::unique_ptr<Rpc>> rpcs;
+    std::vector<TxnSubTask> sub_tasks;
+
+    void Add(std::unique_ptr<Rpc> rpc, std::shared_ptr<Region> region) {
+      sub_tasks.emplace_back(rpc.get(), std::move(region));
+      rpcs.push_back(std::move(rpc));
+    }
+  };
+
+  // one step of an async op, kept alive by the callbacks of its rpcs until done is called
+  struct AsyncSubTasks {
+    TxnSubTasks tasks;
+    // sub tasks of the current round
+    std::vector<TxnSubTask*> pending;
+    // controllers of all rounds, a controller is not freed while its AsyncCall may still be running
+    std::vector<std::unique_ptr<StoreRpcController>> controllers;
+    std::atomic<size_t> inflight{0};
+    int retry{0};
+  };
+
+  // log each failed sub task, return the first fail status
+  static Status FirstSubTaskError(const std::vector<TxnSubTask>& sub_tasks, const char* name);
+
+  // keys are views, copied only into requests and into kvs found
+  Status BatchGetByKeyViews(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs);
+
+  // buffered value of key, false when store need to be read
+  bool GetFromBuffer(const std::string& key, std::string& value, Status& status);
+  // split keys into buffered kvs and keys to read from store
+  void GetFromBuffer(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs,
+                     std::vector<std::string_view>& not_found);
+
   // txn get
   std::unique_ptr<TxnGetRpc> PrepareTxnGetRpc(const std::shared_ptr<Region>& region) const;
-  Status DoTxnGet(const std::string& key, std::string& value);
+  Status DoTxnGet(const std::string& key, std::string& value, ReplicaReadPolicy replica_read = kLeaderOnly);
 
   // txn batch get
   std::unique_ptr<TxnBatchGetRpc> PrepareTxnBatchGetRpc(const std::shared_ptr<Region>& region) const;
-  void ProcessTxnBatchGetSubTask(TxnSubTask* sub_task);
-  Status DoTxnBatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs);
+  bool ProcessTxnGetSubTask(TxnSubTask* sub_task);
+  bool ProcessTxnBatchGetSubTask(TxnSubTask* sub_task);
+  // kvs read are appended to result of sub task, on lock conflict the lock is appended to locks and request keeps
+  // only keys not read yet, return true when sub task need retry after locks are resolved
+  bool CollectTxnBatchGetSubTask(TxnSubTask* sub_task, std::vector<pb::store::LockInfo>& locks);
+  // resolve locks of sub tasks with one batched resolve, sub tasks need retry when it succeed
+  bool ResolveSubTaskLocks(const std::vector<TxnSubTask*>& sub_tasks, const std::vector<pb::store::LockInfo>& locks);
+  Status PrepareTxnBatchGetSubTasks(const std::vector<std::string_view>& keys, TxnSubTasks& tasks) const;
+  // kvs of successful sub tasks, return the first fail status
+  static Status CollectTxnBatchGetResult(std::vector<TxnSubTask>& sub_tasks, std::vector<KVPair>& kvs);
+  Status DoTxnBatchGet(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs);
+
+  // txn read cache, snapshot isolation reads the same value of a key at start_ts, so keys read from store are cached
+  // and served again without rpc, nullopt means not found. Consulted after buffer, keys written by txn never reach it.
+  bool ReadCacheEnabled() const;
+  bool GetFromReadCache(const std::string& key, std::string& value, Status& status) const;
+  void GetFromReadCache(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs,
+                        std::vector<std::string_view>& not_cached) const;
+  void FillReadCache(std::string_view key, std::optional<std::string> value);
+  Status CachedTxnGet(const std::string& key, std::string& value, ReplicaReadPolicy replica_read = kLeaderOnly);
+  Status CachedTxnBatchGet(const std::vector<std::string_view>& keys, std::vector<KVPair>& kvs);
+
+  // pessimistic lock, keys are locked before they are buffered, out_kvs is filled with latest values if not nullptr
+  bool IsPessimistic() const { return options_.kind == kPessimistic; }
+  Status PessimisticLock(const std::vector<std::string>& keys, std::vector<KVPair>* out_kvs = nullptr);
+  std::unique_ptr<TxnPessimisticLockRpc> PrepareTxnPessimisticLockRpc(const std::shared_ptr<Region>& region,
+                                                                      int64_t for_update_ts, bool return_values) const;
+  bool ProcessTxnPessimisticLockSubTask(TxnSubTask* sub_task);
+  Status DoPessimisticLock(const std::vector<std::string_view>& keys, int64_t for_update_ts,
+                           std::vector<KVPair>* out_kvs);
 
   // txn commit
   std::unique_ptr<TxnPrewriteRpc> PrepareTxnPrewriteRpc(const std::shared_ptr<Region>& region) const;
+  // add mutation, and the pessimistic check of it for pessimistic txn
+  void AddPrewriteMutation(const TxnMutation& mutation, pb::store::TxnPrewriteRequest* request) const;
   void CheckAndLogPreCommitPrimaryKeyResponse(const pb::store::TxnPrewriteResponse* response) const;
   Status TryResolveTxnPrewriteLockConflict(const pb::store::TxnPrewriteResponse* response) const;
   Status PreCommitPrimaryKey();
-  void ProcessTxnPrewriteSubTask(TxnSubTask* sub_task);
+  Status PreparePrewriteSubTasks(const std::vector<const TxnMutation*>& mutations,
+                                 const std::vector<std::string_view>& keys, TxnSubTasks& tasks) const;
+  // prewrite one batch of buffer, keys are keys of mutations
+  Status PreCommitMutations(const std::vector<const TxnMutation*>& mutations,
+                            const std::vector<std::string_view>& keys);
+  bool ProcessTxnPrewriteSubTask(TxnSubTask* sub_task);
+
+  // single region txn: all mutations are prewritten with primary key in one rpc, all keys are committed in one rpc
+  bool LookupSingleRegion(std::shared_ptr<Region>& region) const;
+  Status PreCommitSingleRegion(const std::shared_ptr<Region>& region);
+  Status CommitSingleRegion(const std::shared_ptr<Region>& region);
 
   std::unique_ptr<TxnCommitRpc> PrepareTxnCommitRpc(const std::shared_ptr<Region>& region) const;
   Status ProcessTxnCommitResponse(const pb::store::TxnCommitResponse* response, bool is_primary) const;
   Status CommitPrimaryKey();
-  void ProcessTxnCommitSubTask(TxnSubTask* sub_task);
+  void PrepareTxnCommitSubTasks(const std::vector<std::string_view>& keys, TxnSubTasks& tasks) const;
+  // best effort, fail is ignored
+  void CommitSecondaryKeys(const std::vector<std::string_view>& keys);
+  bool ProcessTxnCommitSubTask(TxnSubTask* sub_task);
 
   // txn rollback
   std::unique_ptr<TxnBatchRollbackRpc> PrepareTxnBatchRollbackRpc(const std::shared_ptr<Region>& region) const;
   void CheckAndLogTxnBatchRollbackResponse(const pb::store::TxnBatchRollbackResponse* response) const;
-  void ProcessBatchRollbackSubTask(TxnSubTask* sub_task);
-
-  Status HeartBeat();
+  bool ProcessBatchRollbackSubTask(TxnSubTask* sub_task);
+  void PrepareTxnBatchRollbackSubTasks(const std::vector<std::string_view>& keys, TxnSubTasks& tasks) const;
+  // best effort, fail is ignored
+  void RollbackSecondaryKeys(const std::vector<std::string_view>& keys);
+
+  // async steps, the buffer is in memory
+  void AsyncPreCommitMutations(StatusCallback cb);
+  void AsyncCommitWithTs(StatusCallback cb);
+  void AsyncCommitSecondaryKeys(StatusCallback cb);
+  void AsyncRollbackSecondaryKeys(StatusCallback cb);
+  std::vector<std::string> SecondaryKeys() const;
+
+  // call fn with keys except primary key by batches of TxnBuffer::ForEachBatch
+  Status ForEachSecondaryKeys(const std::function<void(const std::vector<std::string_view>&)>& fn) const;
+
+  // pipelined txn: keys of write ops are recorded, once their bytes reach FLAGS_txn_pipelined_flush_bytes, their
+  // current mutations are prewritten by background actuator while caller keep writing. only one flush is in flight.
+  // a second prewrite of a key with the same start_ts does not replace its lock, so a flushed key can't be written
+  // again
+  struct PipelinedFlush {
+    std::vector<TxnMutation> mutations;
+    bool primary_first{false};
+    // set by the first of background actuator and waiter to run it
+    std::atomic<bool> started{false};
+  };
+  bool IsPipelined() const { return options_.pipelined; }
+  Status CheckPipelinedWrite(std::string_view key) const;
+  Status PipelinedWrite(std::vector<std::string> keys, int64_t bytes);
+  // mutations of recorded keys, sorted and deduplicated, their keys are added to flushed_keys_
+  Status TakeUnflushedMutations(std::vector<TxnMutation>& mutations);
+  // run flush unless it is started, this is only touched once it is started here
+  void RunPipelinedFlush(const std::shared_ptr<PipelinedFlush>& flush);
+  // NOTE: runs in background, must not touch buffer_ except its primary key
+  Status PipelinedPrewrite(const std::vector<TxnMutation>& mutations, bool primary_first);
+  // wait flush in flight, a flush still queued runs in caller thread, so background threads waiting in PreCommit
+  // never wait for a flush queued behind them. return the first fail of flushes
+  Status WaitPipelinedFlush();
+
+  // keep primary lock alive until primary key is committed or rollbacked, called once primary lock is written
+  void StartHeartBeat();
+  void StopHeartBeat();
+
+  // send rpc of sub tasks concurrently by StoreRpcController::AsyncCall and wait all done, then process_fn check
+  // each response in caller thread, return true means the sub task should be resent, resend until retry exhausted
+  using SubTaskProcessFn = std::function<bool(TxnSubTask* sub_task)>;
+  void RunSubTasks(std::vector<TxnSubTask>& sub_tasks, const SubTaskProcessFn& process_fn);
+  // like RunSubTasks, but process_fn runs in actuator and each sub task which need retry is resent on its own by
+  // actuator after a backoff, until FLAGS_txn_pessimistic_lock_wait_timeout_ms, so caller thread never sleeps and a
+  // sub task waiting for lock never delays others
+  void RunSubTasksWithLockWait(std::vector<TxnSubTask>& sub_tasks, const SubTaskProcessFn& process_fn);
+  void AsyncSendSubTasksAndWait(const std::vector<TxnSubTask*>& sub_tasks);
+  // like RunSubTasks, but nothing waits: rpcs are sent by StoreRpcController::AsyncCall, process_fn runs in actuator
+  // once all rpcs of a round are done, a retry round is scheduled by actuator, then done is called in actuator
+  void AsyncRunSubTasks(std::shared_ptr<AsyncSubTasks> run, SubTaskProcessFn process_fn, std::function<void()> done);
+  void AsyncSendSubTasks(std::shared_ptr<AsyncSubTasks> run, SubTaskProcessFn process_fn, std::function<void()> done);
 
   static bool NeedRetryAndInc(int& times);
 
@@ -150,13 +328,41 @@ class Transaction::TxnImpl {
   const ClientStub& stub_;
   const TransactionOptions options_;
   TransactionState state_;
+  // nullptr for read only txn
   std::unique_ptr<TxnBuffer> buffer_;
 
   pb::meta::TsoTimestamp start_tso_;
   int64_t start_ts_;
+  // steady us when start_ts_ is got, lock ttl is counted from it, see TxnHeartbeatTask::NextLockTtl
+  int64_t start_us_{0};
 
   pb::meta::TsoTimestamp commit_tso_;
   int64_t commit_ts_;
+
+  // set when txn is prewritten by PreCommitSingleRegion
+  bool single_region_{false};
+
+  // pessimistic txn, key -> for_update_ts it is locked with
+  std::map<std::string, int64_t> locked_keys_;
+
+  // key -> value read from store at start_ts, nullopt means not found, at most FLAGS_txn_read_cache_max_keys
+  std::unordered_map<std::string, std::optional<std::string>> read_cache_;
+
+  std::shared_ptr<TxnHeartbeatTask> heartbeat_;
+
+  // pipelined txn, unflushed_*, flushed_keys_, pipeline_flushed_ and pipeline_flush_ are only touched by caller thread
+  std::vector<std::string> unflushed_keys_;
+  int64_t unflushed_bytes_{0};
+  std::set<std::string, std::less<void>> flushed_keys_;
+  bool pipeline_flushed_{false};
+  // last flush, it may be still queued in background
+  std::shared_ptr<PipelinedFlush> pipeline_flush_;
+  // txn_size of prewrite, recorded by caller thread at each flush
+  std::atomic<int64_t> pipeline_txn_size_{0};
+  std::mutex pipeline_mutex_;
+  std::condition_variable pipeline_cv_;
+  bool pipeline_flushing_{false};
+  Status pipeline_status_;
 };
 
 }  // namespace sdk
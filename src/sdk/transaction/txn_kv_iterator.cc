@@ -0,0 +1,121 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/transaction/txn_kv_iterator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+TxnKvIterator::TxnKvIterator(std::unique_ptr<RegionScanIterator> remote_iter, std::vector<TxnMutation> mutations)
+    : remote_iter_(std::move(remote_iter)), mutations_(std::move(mutations)) {}
+
+Status TxnKvIterator::Seek(const std::string& target) {
+  status_ = remote_iter_->Seek(target);
+  if (!status_.ok()) {
+    from_remote_ = false;
+    from_mutation_ = false;
+    return status_;
+  }
+
+  auto iter = std::lower_bound(mutations_.begin(), mutations_.end(), target,
+                               [](const TxnMutation& mutation, const std::string& k) { return mutation.key < k; });
+  mutation_pos_ = std::distance(mutations_.begin(), iter);
+
+  return FindNextVisible();
+}
+
+Status TxnKvIterator::Next() {
+  CHECK(Valid()) << "iterator is invalid";
+  if (from_remote_) {
+    status_ = remote_iter_->Next();
+  }
+  if (from_mutation_) {
+    mutation_pos_++;
+  }
+
+  from_remote_ = false;
+  from_mutation_ = false;
+  if (!status_.ok()) {
+    return status_;
+  }
+
+  return FindNextVisible();
+}
+
+const std::string& TxnKvIterator::key() const {
+  return from_mutation_ ? mutations_[mutation_pos_].key : remote_iter_->key();
+}
+
+const std::string& TxnKvIterator::value() const {
+  return use_mutation_value_ ? mutations_[mutation_pos_].value : remote_iter_->value();
+}
+
+Status TxnKvIterator::FindNextVisible() {
+  from_remote_ = false;
+  from_mutation_ = false;
+  use_mutation_value_ = false;
+
+  while (true) {
+    bool remote_valid = remote_iter_->Valid();
+    if (!remote_valid && !remote_iter_->status().ok()) {
+      status_ = remote_iter_->status();
+      return status_;
+    }
+
+    bool mutation_valid = mutation_pos_ < mutations_.size();
+    if (!remote_valid && !mutation_valid) {
+      return Status::OK();
+    }
+
+    if (!mutation_valid || (remote_valid && remote_iter_->key() < mutations_[mutation_pos_].key)) {
+      from_remote_ = true;
+      return Status::OK();
+    }
+
+    const auto& mutation = mutations_[mutation_pos_];
+    if (mutation.type == TxnMutationType::kLock) {
+      // lock only, remote kv of same key is visible as is
+      mutation_pos_++;
+      continue;
+    }
+
+    bool same_key = remote_valid && remote_iter_->key() == mutation.key;
+    if (mutation.type == TxnMutationType::kDelete) {
+      mutation_pos_++;
+      if (same_key) {
+        status_ = remote_iter_->Next();
+        if (!status_.ok()) {
+          return status_;
+        }
+      }
+      continue;
+    }
+
+    CHECK(mutation.type == TxnMutationType::kPut || mutation.type == TxnMutationType::kPutIfAbsent)
+        << "unexpect txn mutation:" << mutation.ToString();
+    from_mutation_ = true;
+    from_remote_ = same_key;
+    // put if absent take no effect when key exist in store
+    use_mutation_value_ = !(same_key && mutation.type == TxnMutationType::kPutIfAbsent);
+    return Status::OK();
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
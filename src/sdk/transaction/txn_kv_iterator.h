@@ -0,0 +1,69 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRANSACTION_KV_ITERATOR_H_
+#define DINGODB_SDK_TRANSACTION_KV_ITERATOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/region_scan_iterator.h"
+#include "sdk/status.h"
+#include "sdk/transaction/txn_buffer.h"
+
+namespace dingodb {
+namespace sdk {
+
+// merge kvs from store with local txn mutations, mutation overwrite store kv with same key
+class TxnKvIterator : public KvIterator {
+ public:
+  // mutations must be sorted by key and in [start_key, end_key)
+  TxnKvIterator(std::unique_ptr<RegionScanIterator> remote_iter, std::vector<TxnMutation> mutations);
+
+  ~TxnKvIterator() override = default;
+
+  Status Seek(const std::string& target) override;
+
+  bool Valid() const override { return status_.ok() && (from_remote_ || from_mutation_); }
+
+  Status Next() override;
+
+  const std::string& key() const override;
+
+  const std::string& value() const override;
+
+  Status status() const override { return status_; }
+
+ private:
+  // skip deleted keys and decide where current kv is from
+  Status FindNextVisible();
+
+  std::unique_ptr<RegionScanIterator> remote_iter_;
+  const std::vector<TxnMutation> mutations_;
+  size_t mutation_pos_{0};
+
+  Status status_;
+  // both are true when remote and mutation have same key
+  bool from_remote_{false};
+  bool from_mutation_{false};
+  // value from mutation if true, else from remote
+  bool use_mutation_value_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TRANSACTION_KV_ITERATOR_H_
@@ -15,20 +15,68 @@
 #include "sdk/transaction/txn_lock_resolver.h"
 
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "common/logging.h"
 #include "glog/logging.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
 #include "sdk/region.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/status.h"
+#include "sdk/utils/async_util.h"
 
 namespace dingodb {
 namespace sdk {
 
-TxnLockResolver::TxnLockResolver(const ClientStub& stub) : stub_(stub) {}
+bool TxnStatusCache::Get(int64_t lock_ts, TxnStatus& txn_status) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = index_.find(lock_ts);
+  if (iter == index_.end()) {
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, iter->second);
+  txn_status = iter->second->second;
+  return true;
+}
+
+void TxnStatusCache::Put(int64_t lock_ts, const TxnStatus& txn_status) {
+  if (capacity_ <= 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = index_.find(lock_ts);
+  if (iter != index_.end()) {
+    iter->second->second = txn_status;
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    return;
+  }
+
+  lru_.emplace_front(lock_ts, txn_status);
+  index_[lock_ts] = lru_.begin();
+
+  if (static_cast<int64_t>(lru_.size()) > capacity_) {
+    index_.erase(lru_.back().first);
+    lru_.pop_back();
+  }
+}
+
+int64_t TxnStatusCache::Size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return lru_.size();
+}
+
+TxnLockResolver::TxnLockResolver(const ClientStub& stub)
+    : stub_(stub), txn_status_cache_(FLAGS_txn_status_cache_capacity) {}
 
 // TODO: maybe support retry
 Status TxnLockResolver::ResolveLock(const pb::store::LockInfo& lock_info, int64_t caller_start_ts) {
@@ -70,9 +118,178 @@ Status TxnLockResolver::ResolveLock(const pb::store::LockInfo& lock_info, int64_
   return Status::OK();
 }
 
-// TODO: use txn status cache
+Status TxnLockResolver::ResolveLocks(const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+  std::map<int64_t, std::vector<const pb::store::LockInfo*>> txn_locks;
+  for (const auto& lock_info : lock_infos) {
+    txn_locks[lock_info.lock_ts()].push_back(&lock_info);
+  }
+
+  Status ret;
+  std::vector<ResolveGroup> primary_groups;
+  std::vector<ResolveGroup> secondary_groups;
+  for (const auto& [lock_ts, locks] : txn_locks) {
+    const std::string& primary_key = locks.front()->primary_lock();
+
+    TxnStatus txn_status;
+    Status s = CheckTxnStatus(lock_ts, primary_key, caller_start_ts, txn_status);
+    if (!s.ok()) {
+      if (s.IsNotFound()) {
+        DINGO_LOG(DEBUG) << "txn not exist when check txn status, txn:" << lock_ts << ", status:" << s.ToString();
+      } else {
+        ret = s;
+      }
+      continue;
+    }
+
+    if (txn_status.IsLocked()) {
+      ret = Status::TxnLockConflict(fmt::format("txn:{} is locked, txn_status:{}", lock_ts, txn_status.ToString()));
+      continue;
+    }
+
+    CHECK(txn_status.IsCommitted() || txn_status.IsRollbacked()) << "unexpected txn_status:" << txn_status.ToString();
+
+    std::set<std::string> keys;
+    for (const auto* lock : locks) {
+      if (lock->key() != primary_key) {
+        keys.insert(lock->key());
+      }
+    }
+
+    s = GroupKeysByRegion(lock_ts, txn_status.commit_ts, {primary_key}, primary_groups);
+    if (s.ok()) {
+      s = GroupKeysByRegion(lock_ts, txn_status.commit_ts, std::vector<std::string_view>(keys.begin(), keys.end()),
+                            secondary_groups);
+    }
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "fail group keys of txn:" << lock_ts << ", status:" << s.ToString();
+      ret = s;
+    }
+  }
+
+  // resolve primary keys first, same as ResolveLock
+  Status s = ResolveGroupsInParallel(primary_groups);
+  if (!s.ok()) {
+    return s;
+  }
+
+  s = ResolveGroupsInParallel(secondary_groups);
+  if (!s.ok()) {
+    return s;
+  }
+
+  return ret;
+}
+
+Status TxnLockResolver::GroupKeysByRegion(int64_t txn_start_ts, int64_t commit_ts,
+                                          const std::vector<std::string_view>& sorted_keys,
+                                          std::vector<ResolveGroup>& groups) {
+  std::vector<RegionKeys> region_keys;
+  DINGO_RETURN_NOT_OK(stub_.GetMetaCache()->LookupRegionsByKeys(sorted_keys, region_keys));
+
+  for (const auto& region_group : region_keys) {
+    for (size_t pos = 0; pos < region_group.keys.size(); pos++) {
+      if (pos % static_cast<size_t>(FLAGS_txn_max_batch_count) == 0) {
+        groups.push_back({txn_start_ts, commit_ts, region_group.region, {}});
+      }
+      groups.back().keys.emplace_back(region_group.keys[pos]);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status TxnLockResolver::ResolveGroupsInParallel(const std::vector<ResolveGroup>& groups) {
+  if (groups.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<std::unique_ptr<TxnResolveLockRpc>> rpcs;
+  std::vector<std::unique_ptr<StoreRpcController>> controllers;
+  std::vector<Status> status(groups.size());
+  rpcs.reserve(groups.size());
+  controllers.reserve(groups.size());
+  for (const auto& group : groups) {
+    auto rpc = std::make_unique<TxnResolveLockRpc>();
+    // NOTE: use randome isolation is ok?
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), group.region->RegionId(), group.region->Epoch(),
+                   pb::store::IsolationLevel::SnapshotIsolation);
+    rpc->MutableRequest()->set_start_ts(group.txn_start_ts);
+    rpc->MutableRequest()->set_commit_ts(group.commit_ts);
+    for (const auto& key : group.keys) {
+      *rpc->MutableRequest()->add_keys() = key;
+    }
+
+    controllers.push_back(std::make_unique<StoreRpcController>(stub_, *rpc, group.region));
+    rpcs.push_back(std::move(rpc));
+  }
+
+  CountDownSync sync(groups.size());
+  for (size_t i = 0; i < controllers.size(); i++) {
+    controllers[i]->AsyncCall([&status, i, &sync](Status s) {
+      status[i] = std::move(s);
+      sync.CountDown();
+    });
+  }
+  sync.Wait();
+
+  Status ret;
+  for (size_t i = 0; i < groups.size(); i++) {
+    Status s = status[i];
+    if (s.ok()) {
+      s = ProcessTxnResolveLockResponse(*rpcs[i]->Response());
+    }
+
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "resolve txn:" << groups[i].txn_start_ts << " region:" << groups[i].region->RegionId()
+                         << " key_count:" << groups[i].keys.size() << " fail, status:" << s.ToString();
+      ret = s;
+    }
+  }
+
+  return ret;
+}
+
 Status TxnLockResolver::CheckTxnStatus(int64_t txn_start_ts, const std::string& txn_primary_key,
                                        int64_t caller_start_ts, TxnStatus& txn_status) {
+  if (txn_status_cache_.Get(txn_start_ts, txn_status)) {
+    DINGO_LOG(DEBUG) << "hit txn status cache, txn:" << txn_start_ts << " txn_status:" << txn_status.ToString();
+    return Status::OK();
+  }
+
+  std::shared_ptr<InflightCheck> check;
+  {
+    std::unique_lock<std::mutex> lk(inflight_mutex_);
+    auto iter = inflight_checks_.find(txn_start_ts);
+    if (iter != inflight_checks_.end()) {
+      check = iter->second;
+      inflight_cv_.wait(lk, [&check]() { return check->done; });
+      txn_status = check->txn_status;
+      return check->status;
+    }
+
+    check = std::make_shared<InflightCheck>();
+    inflight_checks_.emplace(txn_start_ts, check);
+  }
+
+  Status ret = SendCheckTxnStatus(txn_start_ts, txn_primary_key, caller_start_ts, txn_status);
+  if (ret.ok() && (txn_status.IsCommitted() || txn_status.IsRollbacked())) {
+    txn_status_cache_.Put(txn_start_ts, txn_status);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(inflight_mutex_);
+    check->status = ret;
+    check->txn_status = txn_status;
+    check->done = true;
+    inflight_checks_.erase(txn_start_ts);
+  }
+  inflight_cv_.notify_all();
+
+  return ret;
+}
+
+Status TxnLockResolver::SendCheckTxnStatus(int64_t txn_start_ts, const std::string& txn_primary_key,
+                                           int64_t caller_start_ts, TxnStatus& txn_status) {
   std::shared_ptr<Region> region;
   DINGO_RETURN_NOT_OK(stub_.GetMetaCache()->LookupRegionByKey(txn_primary_key, region));
 
@@ -15,7 +15,15 @@
 #ifndef DINGODB_SDK_TRANSACTION_LOCK_RESOLVER_H_
 #define DINGODB_SDK_TRANSACTION_LOCK_RESOLVER_H_
 
+#include <condition_variable>
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "fmt/core.h"
 #include "proto/store.pb.h"
@@ -25,6 +33,7 @@ namespace dingodb {
 namespace sdk {
 
 class ClientStub;
+class Region;
 
 struct TxnStatus {
   int64_t lock_ttl;
@@ -43,6 +52,29 @@ struct TxnStatus {
   std::string ToString() const { return fmt::format("(lock_ttl:{}, commit_ts:{})", lock_ttl, commit_ts); }
 };
 
+// lru cache of finished txn status, committed and rollbacked txn status never change
+class TxnStatusCache {
+ public:
+  explicit TxnStatusCache(int64_t capacity) : capacity_(capacity) {}
+
+  ~TxnStatusCache() = default;
+
+  bool Get(int64_t lock_ts, TxnStatus& txn_status);
+
+  void Put(int64_t lock_ts, const TxnStatus& txn_status);
+
+  int64_t Size();
+
+ private:
+  using Entry = std::pair<int64_t, TxnStatus>;
+
+  const int64_t capacity_;
+  std::mutex mutex_;
+  // front is the most recently used
+  std::list<Entry> lru_;
+  std::unordered_map<int64_t, std::list<Entry>::iterator> index_;
+};
+
 class TxnLockResolver {
  public:
   explicit TxnLockResolver(const ClientStub& stub);
@@ -51,18 +83,52 @@ class TxnLockResolver {
 
   virtual Status ResolveLock(const pb::store::LockInfo& lock_info, int64_t caller_start_ts);
 
+  // group locks by txn, check each txn status once, then resolve keys of same txn and region with one rpc,
+  // rpcs of different regions are sent in parallel
+  virtual Status ResolveLocks(const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts);
+
  private:
+  // concurrent check of same txn share one TxnCheckTxnStatusRpc
+  struct InflightCheck {
+    bool done{false};
+    Status status;
+    TxnStatus txn_status;
+  };
+
+  // keys of one txn in one region, resolved by one TxnResolveLockRpc
+  struct ResolveGroup {
+    int64_t txn_start_ts;
+    int64_t commit_ts;
+    std::shared_ptr<Region> region;
+    std::vector<std::string> keys;
+  };
+
   Status CheckTxnStatus(int64_t txn_start_ts, const std::string& txn_primary_key, int64_t caller_start_ts,
                         TxnStatus& txn_status);
 
+  Status SendCheckTxnStatus(int64_t txn_start_ts, const std::string& txn_primary_key, int64_t caller_start_ts,
+                            TxnStatus& txn_status);
+
   static Status ProcessTxnCheckStatusResponse(const pb::store::TxnCheckTxnStatusResponse& response,
                                               TxnStatus& txn_status);
 
   Status ResolveLockKey(int64_t txn_start_ts, const std::string& key, int64_t commit_ts);
 
+  // sorted_keys must be sorted and unique, regions of all keys are looked up at once
+  Status GroupKeysByRegion(int64_t txn_start_ts, int64_t commit_ts, const std::vector<std::string_view>& sorted_keys,
+                           std::vector<ResolveGroup>& groups);
+
+  Status ResolveGroupsInParallel(const std::vector<ResolveGroup>& groups);
+
   static Status ProcessTxnResolveLockResponse(const pb::store::TxnResolveLockResponse& response);
 
   const ClientStub& stub_;
+
+  TxnStatusCache txn_status_cache_;
+
+  std::mutex inflight_mutex_;
+  std::condition_variable inflight_cv_;
+  std::unordered_map<int64_t, std::shared_ptr<InflightCheck>> inflight_checks_;
 };
 }  // namespace sdk
 }  // namespace dingodb
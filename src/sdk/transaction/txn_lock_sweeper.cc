@@ -0,0 +1,214 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/transaction/txn_lock_sweeper.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/common.h"
+#include "sdk/common/helper.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/transaction/txn_lock_resolver.h"
+#include "sdk/utils/thread_pool_impl.h"
+
+namespace dingodb {
+namespace sdk {
+
+TxnLockSweeper::TxnLockSweeper(const ClientStub& stub, std::string start_key, std::string end_key,
+                               int64_t safe_point_ts, LockSweepProgressCallback progress)
+    : stub_(stub),
+      start_key_(std::move(start_key)),
+      end_key_(std::move(end_key)),
+      safe_point_ts_(safe_point_ts),
+      progress_(std::move(progress)) {}
+
+Status TxnLockSweeper::Run(int64_t& out_lock_count) {
+  out_lock_count = 0;
+  if (start_key_.empty() || end_key_.empty() || start_key_ >= end_key_) {
+    return Status::InvalidArgument(fmt::format("invalid range [{}, {})", start_key_, end_key_));
+  }
+
+  if (safe_point_ts_ <= 0) {
+    return Status::InvalidArgument(fmt::format("invalid safe point ts:{}", safe_point_ts_));
+  }
+
+  DINGO_RETURN_NOT_OK(InitParts());
+
+  size_t parallelism = std::max<int64_t>(FLAGS_txn_lock_sweep_parallelism, 1);
+  size_t concurrency = std::min(parts_.size(), parallelism);
+  next_part_ = concurrency;
+
+  if (concurrency > 0) {
+    // scan and resolve wait for their rpcs, so parts are swept by own threads, actuator threads are left for rpc
+    // retries, pool is joined when all parts are done
+    ThreadPoolImpl pool(concurrency);
+    pool.Start();
+    for (size_t i = 0; i < concurrency; i++) {
+      pool.Execute([this, i] { RunParts(i); });
+    }
+  }
+
+  Status ret;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    ret = status_;
+  }
+
+  out_lock_count = lock_count_.load();
+  DINGO_LOG(INFO) << fmt::format("sweep locks before ts:{} in [{}, {}), locks:{}, parts:{}/{}, status:{}",
+                                 safe_point_ts_, start_key_, end_key_, out_lock_count, done_parts_, parts_.size(),
+                                 ret.ToString());
+  return ret;
+}
+
+Status TxnLockSweeper::InitParts() {
+  std::vector<std::shared_ptr<Region>> regions;
+  Status ret = stub_.GetMetaCache()->ScanRegionsBetweenRange(start_key_, end_key_, 0, regions);
+  if (ret.IsNotFound()) {
+    DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), no lock to sweep", start_key_, end_key_);
+    return Status::OK();
+  }
+
+  if (!ret.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("lookup region fail between [{},{}), status:{}", start_key_, end_key_,
+                                      ret.ToString());
+    return ret;
+  }
+
+  parts_.clear();
+  for (const auto& region : regions) {
+    SweepPart part;
+    part.next_start_key = std::max(start_key_, region->Range().start_key());
+    part.end_key = std::min(end_key_, region->Range().end_key());
+    if (part.next_start_key < part.end_key) {
+      parts_.push_back(std::move(part));
+    }
+  }
+
+  return Status::OK();
+}
+
+void TxnLockSweeper::RunParts(size_t index) {
+  while (true) {
+    Status s = SweepPart(parts_[index]);
+
+    bool has_next = false;
+    int64_t done_parts = -1;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      if (s.ok()) {
+        done_parts = ++done_parts_;
+      } else if (status_.ok()) {
+        status_ = s;
+      }
+
+      // stop starting parts once one part fail, the sweep can be run again
+      if (status_.ok() && next_part_ < parts_.size()) {
+        index = next_part_++;
+        has_next = true;
+      }
+    }
+
+    if (done_parts >= 0 && progress_) {
+      progress_(lock_count_.load(), done_parts, parts_.size());
+    }
+
+    if (!has_next) {
+      break;
+    }
+  }
+}
+
+Status TxnLockSweeper::SweepPart(SweepPart& part) {
+  while (part.next_start_key < part.end_key) {
+    std::shared_ptr<Region> region;
+    Status s = stub_.GetMetaCache()->LookupRegionBetweenRange(part.next_start_key, part.end_key, region);
+    if (s.IsNotFound()) {
+      DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), skip", part.next_start_key, part.end_key);
+      part.next_start_key = part.end_key;
+      break;
+    }
+
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), status:{}", part.next_start_key,
+                                        part.end_key, s.ToString());
+      return s;
+    }
+
+    const auto& range = region->Range();
+    std::string start = std::max(part.next_start_key, range.start_key());
+    std::string end = std::min(part.end_key, range.end_key());
+    DINGO_RETURN_NOT_OK(SweepRegionRange(region, start, end));
+
+    part.next_start_key = end;
+  }
+
+  return Status::OK();
+}
+
+Status TxnLockSweeper::SweepRegionRange(const std::shared_ptr<Region>& region, const std::string& start_key,
+                                        const std::string& end_key) {
+  int64_t limit = std::max<int64_t>(FLAGS_txn_lock_sweep_batch_size, 1);
+  std::string next_key = start_key;
+  while (true) {
+    TxnScanLockRpc rpc;
+    FillRpcContext(*rpc.MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+    rpc.MutableRequest()->set_max_ts(safe_point_ts_);
+    rpc.MutableRequest()->set_start_key(next_key);
+    rpc.MutableRequest()->set_end_key(end_key);
+    rpc.MutableRequest()->set_limit(limit);
+
+    DINGO_RETURN_NOT_OK(LogAndSendRpc(stub_, rpc, region));
+
+    const auto* response = rpc.Response();
+    if (response->locks_size() == 0) {
+      return Status::OK();
+    }
+
+    std::vector<pb::store::LockInfo> locks(response->locks().begin(), response->locks().end());
+    lock_count_.fetch_add(locks.size());
+
+    Status s = stub_.GetTxnLockResolver()->ResolveLocks(locks, safe_point_ts_);
+    if (s.IsTxnLockConflict()) {
+      // txn still alive, its lock is not stale, the others of the batch are resolved anyway
+      DINGO_LOG(INFO) << "skip alive locks of region:" << region->RegionId() << ", status:" << s.ToString();
+    } else if (!s.ok()) {
+      DINGO_LOG(WARNING) << "fail resolve locks of region:" << region->RegionId() << ", status:" << s.ToString();
+      return s;
+    }
+
+    if (response->locks_size() < limit) {
+      return Status::OK();
+    }
+
+    // locks are in key order, continue right after the last one
+    next_key = locks.back().key();
+    next_key.push_back('\0');
+    if (next_key >= end_key) {
+      return Status::OK();
+    }
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
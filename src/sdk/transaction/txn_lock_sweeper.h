@@ -0,0 +1,84 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRANSACTION_LOCK_SWEEPER_H_
+#define DINGODB_SDK_TRANSACTION_LOCK_SWEEPER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/region.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// resolve locks older than safe_point_ts in [start_key, end_key), e.g. locks left by crashed writers.
+// regions in range are cut into parts by the region list from coordinator as RawKvDeleteRangeTask does, at most
+// FLAGS_txn_lock_sweep_parallelism parts are swept concurrently by own threads, a part walks its range region by region
+// so a region split during sweep is still covered. A region is scanned by at most FLAGS_txn_lock_sweep_batch_size
+// locks per rpc, each batch is resolved by TxnLockResolver::ResolveLocks.
+// locks of txns still alive are left, they are not stale.
+class TxnLockSweeper {
+ public:
+  TxnLockSweeper(const TxnLockSweeper&) = delete;
+  const TxnLockSweeper& operator=(const TxnLockSweeper&) = delete;
+
+  // progress: called when a part is done, maybe in sdk internal thread, should not block
+  TxnLockSweeper(const ClientStub& stub, std::string start_key, std::string end_key, int64_t safe_point_ts,
+                 LockSweepProgressCallback progress = nullptr);
+
+  ~TxnLockSweeper() = default;
+
+  // block until all parts are swept or one part fail, out_lock_count is the locks found, also when fail
+  Status Run(int64_t& out_lock_count);
+
+ private:
+  struct SweepPart {
+    std::string next_start_key;
+    std::string end_key;
+  };
+
+  Status InitParts();
+  // sweep part index, then next pending part in the same thread, until no part is pending
+  void RunParts(size_t index);
+  Status SweepPart(SweepPart& part);
+  Status SweepRegionRange(const std::shared_ptr<Region>& region, const std::string& start_key,
+                          const std::string& end_key);
+
+  const ClientStub& stub_;
+  const std::string start_key_;
+  const std::string end_key_;
+  const int64_t safe_point_ts_;
+  LockSweepProgressCallback progress_;
+
+  // fixed in InitParts, a part is only touched by the thread sweeping it
+  std::vector<SweepPart> parts_;
+  std::atomic<int64_t> lock_count_{0};
+
+  std::mutex mutex_;
+  Status status_;
+  size_t next_part_{0};
+  int64_t done_parts_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TRANSACTION_LOCK_SWEEPER_H_
@@ -15,32 +15,52 @@
 #include "sdk/transaction/txn_region_scanner_impl.h"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "glog/logging.h"
+#include "sdk/client_stub.h"
 #include "sdk/common/common.h"
 #include "sdk/common/helper.h"
 #include "sdk/common/param_config.h"
 #include "sdk/region_scanner.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/transaction/txn_common.h"
+#include "sdk/utils/async_util.h"
 
 namespace dingodb {
 namespace sdk {
 TxnRegionScannerImpl::TxnRegionScannerImpl(const ClientStub& stub, std::shared_ptr<Region> region,
                                            const TransactionOptions& txn_options, int64_t txn_start_ts,
-                                           std::string start_key, std::string end_key)
+                                           std::string start_key, std::string end_key, bool prefetch,
+                                           bool key_only, uint32_t value_prefix_len, bool reverse)
     : RegionScanner(stub, region),
+      tracker_(stub.GetTaskTracker()),
       txn_options_(txn_options),
       txn_start_ts_(txn_start_ts),
       start_key_(std::move(start_key)),
       end_key_(std::move(end_key)),
       opened_(false),
       has_more_(false),
-      batch_size_(FLAGS_scan_batch_size),
-      next_key_(start_key_),
-      include_next_key_(true) {}
+      batch_sizer_(FLAGS_scan_batch_size),
+      next_key_(reverse ? end_key_ : start_key_),
+      include_next_key_(!reverse),
+      key_only_(key_only),
+      value_prefix_len_(value_prefix_len),
+      reverse_(reverse) {
+  if (prefetch) {
+    prefetcher_ = std::make_unique<ScanBatchPrefetcher>(
+        [this](std::vector<KVPair>& kvs, StatusCallback cb) { AsyncFetchBatch(kvs, std::move(cb)); },
+        [this] { return has_more_.load(); });
+  }
+}
 
-TxnRegionScannerImpl::~TxnRegionScannerImpl() { Close(); }
+TxnRegionScannerImpl::~TxnRegionScannerImpl() {
+  if (prefetcher_ != nullptr) {
+    prefetcher_->Wait();
+  }
+  Close();
+}
 
 Status TxnRegionScannerImpl::Open() {
   CHECK(!opened_);
@@ -56,20 +76,31 @@ void TxnRegionScannerImpl::Close() {
   }
 }
 
-bool TxnRegionScannerImpl::HasMore() const { return has_more_; }
+bool TxnRegionScannerImpl::HasMore() const {
+  // rows of a prefetched batch are not handed to caller yet
+  return has_more_.load() || (prefetcher_ != nullptr && prefetcher_->HasPending());
+}
 
 std::unique_ptr<TxnScanRpc> TxnRegionScannerImpl::PrepareTxnScanRpc() {
   auto rpc = std::make_unique<TxnScanRpc>();
   rpc->MutableRequest()->set_start_ts(txn_start_ts_);
   FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch(),
                  TransactionIsolation2IsolationLevel(txn_options_.isolation));
-  rpc->MutableRequest()->set_limit(batch_size_);
+  rpc->MutableRequest()->set_limit(batch_sizer_.Rows());
+  rpc->MutableRequest()->set_key_only(key_only_);
+  rpc->MutableRequest()->set_is_reverse(reverse_);
   auto* range_with_option = rpc->MutableRequest()->mutable_range();
   auto* range = range_with_option->mutable_range();
   CHECK(!next_key_.empty()) << "next_key should not be empty";
-  range->set_start_key(next_key_);
-  range->set_end_key(end_key_);
-  range_with_option->set_with_start(include_next_key_);
+  if (reverse_) {
+    range->set_start_key(start_key_);
+    range->set_end_key(next_key_);
+    range_with_option->set_with_start(true);
+  } else {
+    range->set_start_key(next_key_);
+    range->set_end_key(end_key_);
+    range_with_option->set_with_start(include_next_key_);
+  }
   range_with_option->set_with_end(false);
 
   return std::move(rpc);
@@ -77,7 +108,102 @@ std::unique_ptr<TxnScanRpc> TxnRegionScannerImpl::PrepareTxnScanRpc() {
 
 Status TxnRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
   CHECK(opened_);
+  if (prefetcher_ == nullptr) {
+    return FetchBatch(kvs);
+  }
+
+  Synchronizer sync;
+  Status status;
+  prefetcher_->AsyncNext(kvs, sync.AsStatusCallBack(status));
+  sync.Wait();
+  return status;
+}
+
+void TxnRegionScannerImpl::AsyncNextBatch(std::vector<KVPair>& kvs, StatusCallback cb) {
+  CHECK(opened_);
+  if (prefetcher_ != nullptr) {
+    prefetcher_->AsyncNext(kvs, std::move(cb));
+    return;
+  }
+
+  AsyncFetchBatch(kvs, std::move(cb));
+}
+
+void TxnRegionScannerImpl::AsyncFetchBatch(std::vector<KVPair>& kvs, StatusCallback cb) {
+  // a prefetch may be in flight or started by the last one when client is destroyed before scanner, so ~ClientStub
+  // waits for it and stub is not touched once client is closed
+  if (!tracker_->Enter()) {
+    cb(Status::Aborted("client is closed"));
+    return;
+  }
+
+  auto fetch = std::make_shared<AsyncFetch>();
+  fetch->kvs = &kvs;
+  fetch->cb = std::move(cb);
+  fetch->rpc = PrepareTxnScanRpc();
+  SendAsyncFetch(std::move(fetch));
+}
+
+void TxnRegionScannerImpl::SendAsyncFetch(std::shared_ptr<AsyncFetch> fetch) {
+  fetch->controllers.push_back(std::make_unique<StoreRpcController>(stub, *fetch->rpc, region));
+  auto* controller = fetch->controllers.back().get();
+  controller->AsyncCall([this, fetch = std::move(fetch)](Status status) mutable {
+    AsyncFetchCallback(std::move(fetch), std::move(status));
+  });
+}
+
+void TxnRegionScannerImpl::AsyncFetchCallback(std::shared_ptr<AsyncFetch> fetch, Status status) {
+  if (!status.ok()) {
+    FinishAsyncFetch(fetch, std::move(status));
+    return;
+  }
+
+  const auto* response = fetch->rpc->Response();
+  Status ret;
+  if (response->has_txn_result()) {
+    ret = CheckTxnResultInfo(response->txn_result());
+  }
+
+  if (ret.IsTxnLockConflict() && NeedRetryAndInc(fetch->retry)) {
+    // lock resolve sends rpc synchronously, so process out of rpc callback
+    stub.GetBackgroundActuator()->Execute([this, fetch] {
+      Status s = stub.GetTxnLockResolver()->ResolveLocks({fetch->rpc->Response()->txn_result().locked()},
+                                                          txn_start_ts_);
+      if (!s.ok()) {
+        FinishAsyncFetch(fetch, std::move(s));
+        return;
+      }
 
+      // lock of an alive txn fails resolve, so page is scanned again at once after the lock is resolved
+      SendAsyncFetch(fetch);
+    });
+    return;
+  }
+
+  if (!ret.ok() && !ret.IsTxnLockConflict()) {
+    DINGO_LOG(WARNING) << "unexpect txn scan rpc response, status:" << ret.ToString()
+                       << " response:" << response->DebugString();
+  }
+  FinishAsyncFetch(fetch, std::move(ret));
+}
+
+void TxnRegionScannerImpl::FinishAsyncFetch(const std::shared_ptr<AsyncFetch>& fetch, Status status) {
+  if (status.ok()) {
+    ProcessScanResponse(*fetch->rpc->Response(), *fetch->kvs);
+  } else {
+    DINGO_LOG(WARNING) << "Fail scan, txn start_tx:" << txn_start_ts_ << ", region:" << region->RegionId()
+                       << ", status:" << status.ToString();
+  }
+
+  // controllers refer to stub, release them before leaving
+  fetch->controllers.clear();
+  // callback may free scanner
+  StatusCallback cb = std::move(fetch->cb);
+  tracker_->Leave();
+  cb(status);
+}
+
+Status TxnRegionScannerImpl::FetchBatch(std::vector<KVPair>& kvs) {
   std::unique_ptr<TxnScanRpc> rpc = PrepareTxnScanRpc();
 
   int retry = 0;
@@ -93,7 +219,8 @@ Status TxnRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
     if (ret.ok()) {
       break;
     } else if (ret.IsTxnLockConflict()) {
-      ret = stub.GetTxnLockResolver()->ResolveLock(response->txn_result().locked(), txn_start_ts_);
+      // lock of an alive txn fails resolve, so page is scanned again at once after the lock is resolved
+      ret = stub.GetTxnLockResolver()->ResolveLocks({response->txn_result().locked()}, txn_start_ts_);
       if (!ret.ok()) {
         break;
       }
@@ -103,37 +230,13 @@ Status TxnRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
       break;
     }
 
-    if (NeedRetryAndInc(retry)) {
-      DINGO_LOG(INFO) << "try to delay:" << FLAGS_txn_op_delay_ms << "ms";
-      DelayRetry(FLAGS_txn_op_delay_ms);
-    } else {
+    if (!NeedRetryAndInc(retry)) {
       break;
     }
   }
 
   if (ret.ok()) {
-    const auto* response = rpc->Response();
-    std::vector<KVPair> tmp_kvs;
-    if (response->end_key().empty()) {
-      CHECK_EQ(response->kvs_size(), 0);
-      has_more_ = false;
-    } else {
-      CHECK_NE(response->kvs_size(), 0);
-      next_key_ = response->end_key();
-      include_next_key_ = false;
-      for (const auto& kv : response->kvs()) {
-        DINGO_LOG(DEBUG) << "Success scan, key:" << kv.key() << ", value:" << kv.value() << ", next_key:" << next_key_
-                         << ", end_key:" << end_key_;
-        if (kv.key() < end_key_) {
-          tmp_kvs.push_back({kv.key(), kv.value()});
-        } else {
-          has_more_ = false;
-          break;
-        }
-      }
-    }
-
-    kvs = std::move(tmp_kvs);
+    ProcessScanResponse(*rpc->Response(), kvs);
   } else {
     DINGO_LOG(WARNING) << "Fail scan, txn start_tx:" << txn_start_ts_ << ", region:" << region->RegionId()
                        << ", status:" << ret.ToString();
@@ -142,28 +245,51 @@ Status TxnRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
   return ret;
 }
 
-Status TxnRegionScannerImpl::SetBatchSize(int64_t size) {
-  uint64_t to_size = size;
-  if (size <= kMinScanBatchSize) {
-    to_size = kMinScanBatchSize;
+void TxnRegionScannerImpl::ProcessScanResponse(const pb::store::TxnScanResponse& response,
+                                               std::vector<KVPair>& kvs) {
+  std::vector<KVPair> tmp_kvs;
+  if (response.end_key().empty()) {
+    CHECK_EQ(response.kvs_size(), 0);
+    has_more_ = false;
+  } else {
+    CHECK_NE(response.kvs_size(), 0);
+    // reverse: the last key is the smallest one, next batch ends before it
+    next_key_ = reverse_ ? response.kvs(response.kvs_size() - 1).key() : response.end_key();
+    include_next_key_ = false;
+
+    int64_t bytes = 0;
+    for (const auto& kv : response.kvs()) {
+      bytes += kv.key().size() + kv.value().size();
+    }
+    batch_sizer_.Record(response.kvs_size(), bytes);
+
+    for (const auto& kv : response.kvs()) {
+      DINGO_LOG(DEBUG) << "Success scan, key:" << kv.key() << ", value:" << kv.value() << ", next_key:" << next_key_
+                       << ", end_key:" << end_key_;
+      if (reverse_ ? kv.key() >= start_key_ : kv.key() < end_key_) {
+        tmp_kvs.push_back({kv.key(), ProjectScanValue(kv.value(), key_only_, value_prefix_len_)});
+      } else {
+        has_more_ = false;
+        break;
+      }
+    }
   }
 
-  if (size > kMaxScanBatchSize) {
-    to_size = kMaxScanBatchSize;
-  }
+  kvs = std::move(tmp_kvs);
+}
 
-  batch_size_ = to_size;
+Status TxnRegionScannerImpl::SetBatchSize(int64_t size) {
+  batch_sizer_.SetRows(size);
   return Status::OK();
 }
 
 bool TxnRegionScannerImpl::NeedRetryAndInc(int& times) {
+  // retries after resolving locks are not charged to the retry budget, see RetryBudget
   bool retry = times < FLAGS_txn_op_max_retry;
   times++;
   return retry;
 }
 
-void TxnRegionScannerImpl::DelayRetry(int64_t delay_ms) { (void)usleep(delay_ms * 1000); }
-
 TxnRegionScannerFactoryImpl::TxnRegionScannerFactoryImpl() = default;
 
 TxnRegionScannerFactoryImpl::~TxnRegionScannerFactoryImpl() = default;
@@ -187,7 +313,8 @@ Status TxnRegionScannerFactoryImpl::NewRegionScanner(const ScannerOptions& optio
 
   std::shared_ptr<RegionScanner> tmp(new TxnRegionScannerImpl(options.stub, options.region, options.txn_options.value(),
                                                               options.start_ts.value(), options.start_key,
-                                                              options.end_key));
+                                                              options.end_key, options.prefetch, options.key_only,
+                                                              options.value_prefix_len, options.reverse));
   scanner = std::move(tmp);
 
   return Status::OK();
@@ -15,13 +15,19 @@
 #ifndef DINGODB_SDK_TXN_REGON_SCANNER_IMPL_H_
 #define DINGODB_SDK_TXN_REGON_SCANNER_IMPL_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "sdk/client.h"
 #include "sdk/region_scanner.h"
 #include "sdk/status.h"
 #include "sdk/rpc/store_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/scan_batch_prefetcher.h"
+#include "sdk/utils/scan_batch_sizer.h"
+#include "sdk/utils/task_tracker.h"
 
 namespace dingodb {
 namespace sdk {
@@ -30,33 +36,38 @@ class TestBase;
 
 class TxnRegionScannerImpl : public RegionScanner {
  public:
+  // prefetch: the next batch is fetched in background when a batch is returned, see ScanBatchPrefetcher
+  // key_only, value_prefix_len: see ScanOptions
+  // reverse: batches are returned from end_key to start_key, keys of a batch are in descending order
   explicit TxnRegionScannerImpl(const ClientStub& stub, std::shared_ptr<Region> region,
                                 const TransactionOptions& txn_options, int64_t txn_start_ts, std::string start_key,
-                                std::string end_key);
+                                std::string end_key, bool prefetch = false, bool key_only = false,
+                                uint32_t value_prefix_len = 0, bool reverse = false);
 
   ~TxnRegionScannerImpl() override;
 
   Status Open() override;
 
-  void AsyncOpen(StatusCallback cb) override { cb(Status::NotSupported("AsyncOpen is not supported")); }
+  // open and close send no rpc
+  void AsyncOpen(StatusCallback cb) override { cb(Open()); }
 
   void Close() override;
 
-  void AsyncClose(StatusCallback cb) override { cb(Status::NotSupported("AsyncClose is not supported")); }
+  void AsyncClose(StatusCallback cb) override {
+    Close();
+    cb(Status::OK());
+  }
 
   Status NextBatch(std::vector<KVPair>& kvs) override;
 
-  void AsyncNextBatch(std::vector<KVPair>& kvs, StatusCallback cb) override {
-    (void)kvs;
-    (void)cb;
-    CHECK(false) << "AsyncNextBatch is not supported";
-  }
+  // nothing waits for the TxnScanRpc, see AsyncFetchBatch
+  void AsyncNextBatch(std::vector<KVPair>& kvs, StatusCallback cb) override;
 
   bool HasMore() const override;
 
   Status SetBatchSize(int64_t size) override;
 
-  int64_t GetBatchSize() const override { return batch_size_; }
+  int64_t GetBatchSize() const override { return batch_sizer_.Rows(); }
 
   bool TEST_IsOpen() {  // NOLINT
     return opened_;
@@ -65,18 +76,48 @@ class TxnRegionScannerImpl : public RegionScanner {
  private:
   std::unique_ptr<TxnScanRpc> PrepareTxnScanRpc();
 
+  // send one TxnScanRpc, resolve lock and retry
+  Status FetchBatch(std::vector<KVPair>& kvs);
+
+  // state of one AsyncFetchBatch, held by the callbacks of its rpc
+  struct AsyncFetch {
+    std::vector<KVPair>* kvs;
+    StatusCallback cb;
+    std::unique_ptr<TxnScanRpc> rpc;
+    // one per send, kept until fetch is done, so none is destroyed while its callback still runs
+    std::vector<std::unique_ptr<StoreRpcController>> controllers;
+    int retry{0};
+  };
+
+  // like FetchBatch, but TxnScanRpc is sent by StoreRpcController::AsyncCall, only lock resolve which sends rpcs
+  // synchronously runs in background actuator
+  void AsyncFetchBatch(std::vector<KVPair>& kvs, StatusCallback cb);
+  void SendAsyncFetch(std::shared_ptr<AsyncFetch> fetch);
+  void AsyncFetchCallback(std::shared_ptr<AsyncFetch> fetch, Status status);
+  void FinishAsyncFetch(const std::shared_ptr<AsyncFetch>& fetch, Status status);
+
+  // take kvs of a successful TxnScanRpc and move to the next batch
+  void ProcessScanResponse(const pb::store::TxnScanResponse& response, std::vector<KVPair>& kvs);
+
   static bool NeedRetryAndInc(int& times);
-  static void DelayRetry(int64_t delay_ms);
 
+  // kept by scanner, it may check it after client is destroyed
+  const std::shared_ptr<TaskTracker> tracker_;
   const TransactionOptions txn_options_;
   int64_t txn_start_ts_;
   std::string start_key_;
   std::string end_key_;
-  int64_t batch_size_;
+  ScanBatchSizer batch_sizer_;
   bool opened_;
-  bool has_more_;
+  // written by actuator thread, read by caller when prefetch
+  std::atomic<bool> has_more_;
+  // forward: start of the next batch; reverse: exclusive end of the next batch
   std::string next_key_;
   bool include_next_key_;
+  bool key_only_;
+  uint32_t value_prefix_len_;
+  bool reverse_;
+  std::unique_ptr<ScanBatchPrefetcher> prefetcher_;
 };
 
 class TxnRegionScannerFactoryImpl final : public RegionScannerFactory {
@@ -0,0 +1,89 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/transaction/txn_scan_merger.h"
+
+#include <tuple>
+#include <utility>
+
+#include "glog/logging.h"
+#include "sdk/region_scanner.h"
+
+namespace dingodb {
+namespace sdk {
+
+TxnScanMerger::TxnScanMerger(const TxnBuffer* buffer, const std::string& start_key, const std::string& end_key,
+                             const ScanOptions& scan_options, uint64_t limit, std::vector<KVPair>& out)
+    : scan_options_(scan_options), limit_(limit), out_(out) {
+  if (buffer != nullptr && buffer->HasSpilled()) {
+    // spilled mutations are read back from file, merge with a copy of range
+    std::vector<TxnMutation> mutations;
+    status_ = buffer->Range(start_key, end_key, mutations);
+    for (auto& mutation : mutations) {
+      std::string key = mutation.key;
+      spilled_range_.emplace_hint(spilled_range_.end(), std::move(key), std::move(mutation));
+    }
+    mutation_iter_ = spilled_range_.cbegin();
+    mutation_end_ = spilled_range_.cend();
+  } else if (buffer != nullptr) {
+    std::tie(mutation_iter_, mutation_end_) = buffer->RangeIterators(start_key, end_key);
+  }
+}
+
+void TxnScanMerger::AddBatch(std::vector<KVPair>& batch) {
+  for (auto& kv : batch) {
+    EmitMutationsBefore(&kv.key);
+    if (ReachLimit()) {
+      return;
+    }
+
+    if (mutation_iter_ == mutation_end_ || mutation_iter_->first != kv.key) {
+      Emit(std::move(kv.key), std::move(kv.value));
+      continue;
+    }
+
+    const auto& mutation = mutation_iter_->second;
+    if (mutation.type == TxnMutationType::kPut) {
+      Emit(std::move(kv.key), ProjectScanValue(mutation.value, scan_options_.key_only, scan_options_.value_prefix_len));
+    } else if (mutation.type == TxnMutationType::kPutIfAbsent) {
+      // put if absent take no effect when key exist in store
+      Emit(std::move(kv.key), std::move(kv.value));
+    } else if (mutation.type == TxnMutationType::kLock) {
+      Emit(std::move(kv.key), std::move(kv.value));
+    } else {
+      CHECK(mutation.type == TxnMutationType::kDelete) << "unexpect txn mutation:" << mutation.ToString();
+    }
+    ++mutation_iter_;
+  }
+}
+
+void TxnScanMerger::Finish() { EmitMutationsBefore(nullptr); }
+
+void TxnScanMerger::EmitMutationsBefore(const std::string* key) {
+  while (!ReachLimit() && mutation_iter_ != mutation_end_ && (key == nullptr || mutation_iter_->first < *key)) {
+    const auto& mutation = mutation_iter_->second;
+    if (mutation.type == TxnMutationType::kPut || mutation.type == TxnMutationType::kPutIfAbsent) {
+      Emit(mutation.key, ProjectScanValue(mutation.value, scan_options_.key_only, scan_options_.value_prefix_len));
+    } else {
+      CHECK(mutation.type == TxnMutationType::kDelete || mutation.type == TxnMutationType::kLock)
+          << "unexpect txn mutation:" << mutation.ToString();
+    }
+    ++mutation_iter_;
+  }
+}
+
+void TxnScanMerger::Emit(std::string key, std::string value) { out_.push_back({std::move(key), std::move(value)}); }
+
+}  // namespace sdk
+}  // namespace dingodb
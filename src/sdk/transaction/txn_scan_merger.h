@@ -0,0 +1,68 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRANSACTION_SCAN_MERGER_H_
+#define DINGODB_SDK_TRANSACTION_SCAN_MERGER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/status.h"
+#include "sdk/transaction/txn_buffer.h"
+
+namespace dingodb {
+namespace sdk {
+
+// two way merge of ascending kv batches from store with local mutations of [start_key, end_key), merged kvs are
+// appended to out as soon as they are known, mutation overwrite store kv with same key.
+// NOTE: buffer must not be modified during merge
+class TxnScanMerger {
+ public:
+  // limit 0 means no limit, buffer maybe nullptr when there is no local mutation
+  TxnScanMerger(const TxnBuffer* buffer, const std::string& start_key, const std::string& end_key,
+                const ScanOptions& scan_options, uint64_t limit, std::vector<KVPair>& out);
+
+  ~TxnScanMerger() = default;
+
+  // batch keys must be ascending and greater than keys of previous batches, kvs of batch are moved into out
+  void AddBatch(std::vector<KVPair>& batch);
+
+  // no more kv from store, emit the rest mutations
+  void Finish();
+
+  bool ReachLimit() const { return limit_ != 0 && out_.size() >= limit_; }
+
+  // fail to read back spilled mutations of buffer, check it before merge
+  const Status& GetStatus() const { return status_; }
+
+ private:
+  // emit mutations which key is less than key, all rest mutations if key is nullptr
+  void EmitMutationsBefore(const std::string* key);
+  void Emit(std::string key, std::string value);
+
+  // range of buffer when it has spilled
+  TxnBuffer::MutationMap spilled_range_;
+  Status status_;
+  TxnBuffer::MutationMap::const_iterator mutation_iter_;
+  TxnBuffer::MutationMap::const_iterator mutation_end_;
+  const ScanOptions scan_options_;
+  const uint64_t limit_;
+  std::vector<KVPair>& out_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TRANSACTION_SCAN_MERGER_H_
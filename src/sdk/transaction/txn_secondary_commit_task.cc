@@ -0,0 +1,169 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/transaction/txn_secondary_commit_task.h"
+
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+TxnSecondaryCommitTask::TxnSecondaryCommitTask(const ClientStub& stub, pb::store::IsolationLevel isolation,
+                                               int64_t start_ts, int64_t commit_ts, std::vector<std::string> keys)
+    : stub_(stub),
+      tracker_(stub.GetTaskTracker()),
+      isolation_(isolation),
+      start_ts_(start_ts),
+      commit_ts_(commit_ts),
+      keys_(std::move(keys)) {}
+
+void TxnSecondaryCommitTask::Start() {
+  if (!tracker_->Enter()) {
+    DINGO_LOG(WARNING) << fmt::format("client is closed, skip secondary commit, start_ts:{}", start_ts_);
+    delete this;
+    return;
+  }
+
+  CHECK(stub_.GetActuator()->Execute([this] {
+    std::vector<std::string_view> keys(keys_.begin(), keys_.end());
+    AddSubTasks(keys, 0);
+    Dispatch();
+  }));
+}
+
+void TxnSecondaryCommitTask::AddSubTasks(const std::vector<std::string_view>& keys, int retry) {
+  std::vector<RegionKeys> groups;
+  Status s = stub_.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << fmt::format(
+        "Fail lookup regions for some secondary keys, ignore them, start_ts:{}, status:{}", start_ts_, s.ToString());
+  }
+
+  std::vector<std::unique_ptr<SubTask>> sub_tasks;
+  for (auto& group : groups) {
+    size_t pos = 0;
+    while (pos < group.keys.size()) {
+      auto sub_task = std::make_unique<SubTask>();
+      sub_task->region = group.region;
+      sub_task->retry = retry;
+
+      auto* request = sub_task->rpc.MutableRequest();
+      FillRpcContext(*request->mutable_context(), group.region->RegionId(), group.region->Epoch(), isolation_);
+      request->set_start_ts(start_ts_);
+      request->set_commit_ts(commit_ts_);
+      for (; pos < group.keys.size() && sub_task->keys.size() < static_cast<size_t>(FLAGS_txn_max_batch_count); pos++) {
+        sub_task->keys.push_back(group.keys[pos]);
+        request->add_keys(std::string(group.keys[pos]));
+      }
+
+      sub_tasks.push_back(std::move(sub_task));
+    }
+  }
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  for (auto& sub_task : sub_tasks) {
+    pending_.push_back(std::move(sub_task));
+  }
+}
+
+void TxnSecondaryCommitTask::Dispatch() {
+  std::vector<SubTask*> to_send;
+  bool finish = false;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (tracker_->IsCancelled() && !pending_.empty()) {
+      DINGO_LOG(WARNING) << fmt::format("client is closed, drop secondary commit, start_ts:{}, sub task count:{}",
+                                        start_ts_, pending_.size());
+      pending_.clear();
+    }
+
+    while (!pending_.empty() && running_ < FLAGS_txn_secondary_commit_concurrency) {
+      to_send.push_back(pending_.front().release());
+      pending_.pop_front();
+      running_++;
+    }
+
+    if (pending_.empty() && running_ == 0 && !done_) {
+      done_ = true;
+      finish = true;
+    }
+  }
+
+  for (auto* sub_task : to_send) {
+    SendSubTask(sub_task);
+  }
+
+  if (finish) {
+    DINGO_LOG(DEBUG) << fmt::format("secondary commit done, start_ts:{}, commit_ts:{}, key count:{}", start_ts_,
+                                    commit_ts_, keys_.size());
+    auto tracker = tracker_;
+    delete this;
+    tracker->Leave();
+  }
+}
+
+void TxnSecondaryCommitTask::SendSubTask(SubTask* sub_task) {
+  sub_task->controller = std::make_unique<StoreRpcController>(stub_, sub_task->rpc, sub_task->region);
+  sub_task->controller->AsyncCall(
+      [this, sub_task](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s), sub_task); });
+}
+
+void TxnSecondaryCommitTask::SubTaskCallback(Status status, SubTask* sub_task) {
+  std::unique_ptr<SubTask> guard(sub_task);
+
+  if (status.ok()) {
+    const auto* response = sub_task->rpc.Response();
+    if (response->has_txn_result()) {
+      DINGO_LOG(WARNING) << fmt::format("unexpect secondary commit result but ignore, start_ts:{}, region:{}, {}",
+                                        start_ts_, sub_task->region->RegionId(), response->txn_result().DebugString());
+    }
+  } else if (sub_task->retry < FLAGS_txn_op_max_retry && !tracker_->IsCancelled()) {
+    // region maybe changed, lookup again when retry
+    DINGO_LOG(INFO) << fmt::format("Fail commit secondary keys, retry:{}, start_ts:{}, region:{}, status:{}",
+                                   sub_task->retry, start_ts_, sub_task->region->RegionId(), status.ToString());
+    std::vector<std::string_view> keys = std::move(sub_task->keys);
+    int retry = sub_task->retry + 1;
+    // keep running_ until retry sub tasks are added, so task will not finish
+    CHECK(stub_.GetActuator()->Schedule(
+        [this, keys = std::move(keys), retry] {
+          AddSubTasks(keys, retry);
+          {
+            std::unique_lock<std::mutex> lk(mutex_);
+            running_--;
+          }
+          Dispatch();
+        },
+        FLAGS_txn_op_delay_ms));
+    return;
+  } else {
+    DINGO_LOG(WARNING) << fmt::format("Fail commit secondary keys but ignore, start_ts:{}, region:{}, status:{}",
+                                      start_ts_, sub_task->region->RegionId(), status.ToString());
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    running_--;
+  }
+  Dispatch();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
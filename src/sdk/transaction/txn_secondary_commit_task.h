@@ -0,0 +1,87 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRANSACTION_SECONDARY_COMMIT_TASK_H_
+#define DINGODB_SDK_TRANSACTION_SECONDARY_COMMIT_TASK_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "proto/store.pb.h"
+#include "sdk/client_stub.h"
+#include "sdk/region.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/status.h"
+#include "sdk/utils/task_tracker.h"
+
+namespace dingodb {
+namespace sdk {
+
+// commit secondary keys in background after primary key is committed, at most
+// FLAGS_txn_secondary_commit_concurrency rpcs are in flight, fail rpc is retried with FLAGS_txn_op_delay_ms delay.
+// fail is ignored finally, because secondary locks can be resolved by the committed primary key.
+// the task delete itself when done. it is entered in TaskTracker of client from Start until done, once the client
+// is destroyed pending keys are dropped and fail rpcs are not retried.
+class TxnSecondaryCommitTask {
+ public:
+  TxnSecondaryCommitTask(const TxnSecondaryCommitTask&) = delete;
+  const TxnSecondaryCommitTask& operator=(const TxnSecondaryCommitTask&) = delete;
+
+  TxnSecondaryCommitTask(const ClientStub& stub, pb::store::IsolationLevel isolation, int64_t start_ts,
+                         int64_t commit_ts, std::vector<std::string> keys);
+
+  ~TxnSecondaryCommitTask() = default;
+
+  // NOTE: caller must not touch task after Start
+  void Start();
+
+ private:
+  struct SubTask {
+    std::shared_ptr<Region> region;
+    std::vector<std::string_view> keys;
+    int retry{0};
+    TxnCommitRpc rpc;
+    std::unique_ptr<StoreRpcController> controller;
+  };
+
+  // group keys by region and append to pending_, keys which region lookup fail are dropped
+  void AddSubTasks(const std::vector<std::string_view>& keys, int retry);
+  void Dispatch();
+  void SendSubTask(SubTask* sub_task);
+  void SubTaskCallback(Status status, SubTask* sub_task);
+
+  const ClientStub& stub_;
+  const std::shared_ptr<TaskTracker> tracker_;
+  const pb::store::IsolationLevel isolation_;
+  const int64_t start_ts_;
+  const int64_t commit_ts_;
+  // sorted, owned the memory of all sub task keys
+  const std::vector<std::string> keys_;
+
+  std::mutex mutex_;
+  std::deque<std::unique_ptr<SubTask>> pending_;
+  // sub tasks in flight or waiting to retry
+  int64_t running_{0};
+  bool done_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TRANSACTION_SECONDARY_COMMIT_TASK_H_
@@ -0,0 +1,335 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/transaction/txn_snapshot_exporter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/region_scanner.h"
+#include "sdk/utils/thread_pool_impl.h"
+
+namespace dingodb {
+namespace sdk {
+
+std::string MiddleKey(const std::string& start_key, const std::string& end_key) {
+  // sum of the two keys padded with zero bytes, one more byte keeps the lowest bit of the sum
+  size_t size = std::max(start_key.size(), end_key.size()) + 1;
+  std::vector<uint32_t> sum(size, 0);
+  uint32_t carry = 0;
+  for (size_t i = size; i-- > 0;) {
+    uint32_t a = i < start_key.size() ? static_cast<uint8_t>(start_key[i]) : 0;
+    uint32_t b = i < end_key.size() ? static_cast<uint8_t>(end_key[i]) : 0;
+    uint32_t cur = a + b + carry;
+    sum[i] = cur & 0xff;
+    carry = cur >> 8;
+  }
+
+  // halve from the most significant byte, carry is the bit above it
+  std::string middle(size, '\0');
+  uint32_t remainder = carry;
+  for (size_t i = 0; i < size; i++) {
+    uint32_t cur = (remainder << 8) | sum[i];
+    middle[i] = static_cast<char>(cur >> 1);
+    remainder = cur & 1;
+  }
+
+  // trailing zero bytes only make key longer
+  while (!middle.empty() && middle.back() == '\0' &&
+         std::string_view(middle.data(), middle.size() - 1) > std::string_view(start_key)) {
+    middle.pop_back();
+  }
+
+  if (middle <= start_key || middle >= end_key) {
+    return "";
+  }
+  return middle;
+}
+
+TxnSnapshotExporter::TxnSnapshotExporter(const ClientStub& stub, const TransactionOptions& txn_options,
+                                         int64_t start_ts, const std::vector<ExportRange>& ranges,
+                                         const ExportOptions& options, const ExportBatchCallback& cb)
+    : stub_(stub), txn_options_(txn_options), start_ts_(start_ts), ranges_(ranges), options_(options), cb_(cb) {}
+
+Status TxnSnapshotExporter::Run() {
+  for (const auto& range : ranges_) {
+    if (range.start_key.empty() || range.end_key.empty() || range.start_key >= range.end_key) {
+      return Status::InvalidArgument(fmt::format("invalid range [{}, {})", range.start_key, range.end_key));
+    }
+  }
+
+  DINGO_RETURN_NOT_OK(InitParts());
+  if (parts_.empty()) {
+    return Status::OK();
+  }
+
+  {
+    // workers are joined when all parts are done
+    size_t worker_num = std::max<int64_t>(options_.parallelism, 1);
+    ThreadPoolImpl pool(worker_num);
+    pool.Start();
+    for (size_t i = 0; i < worker_num; i++) {
+      pool.Execute([this] { Work(); });
+    }
+  }
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  DINGO_LOG(INFO) << fmt::format("export {} ranges at ts:{}, status:{}", ranges_.size(), start_ts_,
+                                 status_.ToString());
+  return status_;
+}
+
+Status TxnSnapshotExporter::InitParts() {
+  for (size_t i = 0; i < ranges_.size(); i++) {
+    const auto& range = ranges_[i];
+    std::vector<std::shared_ptr<Region>> regions;
+    Status ret = stub_.GetMetaCache()->ScanRegionsBetweenRange(range.start_key, range.end_key, 0, regions);
+    if (ret.IsNotFound()) {
+      DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), nothing to export", range.start_key,
+                                     range.end_key);
+      continue;
+    }
+
+    if (!ret.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("lookup region fail between [{},{}), status:{}", range.start_key,
+                                        range.end_key, ret.ToString());
+      return ret;
+    }
+
+    for (const auto& region : regions) {
+      auto part = std::make_unique<Part>();
+      part->next_key = std::max(range.start_key, region->Range().start_key());
+      part->end_key = std::min(range.end_key, region->Range().end_key());
+      if (part->next_key >= part->end_key) {
+        continue;
+      }
+
+      part->key = {i, part->next_key};
+      pending_.push_back(part.get());
+      parts_.emplace(part->key, std::move(part));
+    }
+  }
+
+  return Status::OK();
+}
+
+void TxnSnapshotExporter::Work() {
+  while (true) {
+    Part* part = nullptr;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      idle_++;
+      // a running part maybe split, so wait until all parts are done
+      cv_.wait(lk, [this] { return !pending_.empty() || running_ == 0 || !status_.ok(); });
+      idle_--;
+      if (!status_.ok() || pending_.empty()) {
+        break;
+      }
+
+      part = pending_.front();
+      pending_.pop_front();
+      running_++;
+    }
+
+    PartDone(part, ExportPart(part));
+  }
+}
+
+Status TxnSnapshotExporter::ExportPart(Part* part) {
+  int region_retry = 0;
+  while (part->next_key < part->end_key) {
+    std::shared_ptr<Region> region;
+    Status s = stub_.GetMetaCache()->LookupRegionBetweenRange(part->next_key, part->end_key, region);
+    if (s.IsNotFound()) {
+      DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), skip", part->next_key, part->end_key);
+      break;
+    }
+
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), status:{}", part->next_key,
+                                        part->end_key, s.ToString());
+      return s;
+    }
+
+    s = ExportRegion(part, region);
+    if (IsRegionChanged(s) && region_retry < FLAGS_txn_op_max_retry) {
+      // go on right after the last exported key in the new region(s)
+      region_retry++;
+      DINGO_LOG(INFO) << fmt::format("region:{} changed during export, resume from:{}, retry:{}", region->RegionId(),
+                                     part->next_key, region_retry);
+      continue;
+    }
+    DINGO_RETURN_NOT_OK(s);
+  }
+
+  return Status::OK();
+}
+
+Status TxnSnapshotExporter::ExportRegion(Part* part, const std::shared_ptr<Region>& region) {
+  while (true) {
+    std::string start_key = std::max(part->next_key, region->Range().start_key());
+    std::string end_key = std::min(part->end_key, region->Range().end_key());
+    if (start_key >= end_key) {
+      part->next_key = end_key;
+      return Status::OK();
+    }
+
+    // no prefetch, worker threads already scan in parallel
+    ScannerOptions scanner_options(stub_, region, start_key, end_key, txn_options_, start_ts_);
+    scanner_options.key_only = options_.key_only;
+    scanner_options.value_prefix_len = options_.value_prefix_len;
+    std::shared_ptr<RegionScanner> scanner;
+    CHECK(stub_.GetTxnRegionScannerFactory()->NewRegionScanner(scanner_options, scanner).IsOK());
+    CHECK(scanner->Open().ok());
+
+    bool split = false;
+    Status ret;
+    while (scanner->HasMore()) {
+      if (stop_.load()) {
+        ret = Status::Aborted("export stopped by other part");
+        break;
+      }
+
+      std::vector<KVPair> kvs;
+      ret = scanner->NextBatch(kvs);
+      if (!ret.ok()) {
+        DINGO_LOG(WARNING) << fmt::format("txn region scanner NextBatch fail, region:{}, status:{}",
+                                          region->RegionId(), ret.ToString());
+        break;
+      }
+
+      if (!kvs.empty()) {
+        part->next_key = kvs.back().key;
+        part->next_key.push_back('\0');
+        ret = Emit(part, kvs);
+        if (!ret.ok()) {
+          break;
+        }
+      }
+
+      if (scanner->HasMore() && MaybeSplit(part)) {
+        // the rest of region inside the shrunk part is scanned by a new scanner
+        split = true;
+        break;
+      }
+    }
+    scanner->Close();
+
+    if (!ret.ok()) {
+      return ret;
+    }
+
+    if (!split) {
+      part->next_key = end_key;
+      return Status::OK();
+    }
+  }
+}
+
+bool TxnSnapshotExporter::MaybeSplit(Part* part) {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (idle_ == 0 || !pending_.empty()) {
+      return false;
+    }
+  }
+
+  std::string middle = MiddleKey(part->next_key, part->end_key);
+  if (middle.empty()) {
+    return false;
+  }
+
+  auto split = std::make_unique<Part>();
+  split->key = {part->key.first, middle};
+  split->next_key = middle;
+  split->end_key = part->end_key;
+  part->end_key = middle;
+  DINGO_LOG(DEBUG) << fmt::format("split export part at:{}, rest:[{},{})", middle, split->next_key,
+                                  split->end_key);
+
+  Part* to_pending = split.get();
+  {
+    std::unique_lock<std::mutex> lk(emit_mutex_);
+    parts_.emplace(split->key, std::move(split));
+  }
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    pending_.push_back(to_pending);
+  }
+  cv_.notify_one();
+  return true;
+}
+
+Status TxnSnapshotExporter::Emit(Part* part, std::vector<KVPair>& kvs) {
+  std::unique_lock<std::mutex> lk(emit_mutex_);
+  if (options_.ordered && parts_.begin()->second.get() != part) {
+    part->buffered.push_back(std::move(kvs));
+    return Status::OK();
+  }
+
+  return cb_(part->key.first, kvs);
+}
+
+Status TxnSnapshotExporter::FlushHead() {
+  while (!parts_.empty()) {
+    Part* head = parts_.begin()->second.get();
+    while (!head->buffered.empty()) {
+      auto kvs = std::move(head->buffered.front());
+      head->buffered.pop_front();
+      DINGO_RETURN_NOT_OK(cb_(head->key.first, kvs));
+    }
+
+    if (!head->done) {
+      break;
+    }
+    parts_.erase(parts_.begin());
+  }
+
+  return Status::OK();
+}
+
+void TxnSnapshotExporter::PartDone(Part* part, Status status) {
+  if (status.ok()) {
+    std::unique_lock<std::mutex> lk(emit_mutex_);
+    part->done = true;
+    if (options_.ordered) {
+      status = FlushHead();
+    } else {
+      parts_.erase(part->key);
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    running_--;
+    if (!status.ok() && status_.ok()) {
+      status_ = status;
+      stop_.store(true);
+    }
+  }
+  cv_.notify_all();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRANSACTION_SNAPSHOT_EXPORTER_H_
+#define DINGODB_SDK_TRANSACTION_SNAPSHOT_EXPORTER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/region.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// key in the middle of start_key and end_key when keys are taken as big-endian fractions, empty when there is no
+// short enough key strictly between them
+std::string MiddleKey(const std::string& start_key, const std::string& end_key);
+
+// scan ranges at one start_ts with many workers, see Snapshot::Export.
+// each region in a range is a part at first, a worker takes a pending part and walks it region by region with
+// TxnRegionScannerImpl, so a region split during export is still covered, a scan failed by region split or merge
+// goes on right after the last exported key. When some worker is idle and no part is pending, a worker splits the
+// rest of its part at MiddleKey and hands the upper half over, so a large region is scanned by several workers.
+// Workers are own threads, scan rpcs and lock resolving wait for responses.
+class TxnSnapshotExporter {
+ public:
+  TxnSnapshotExporter(const TxnSnapshotExporter&) = delete;
+  const TxnSnapshotExporter& operator=(const TxnSnapshotExporter&) = delete;
+
+  TxnSnapshotExporter(const ClientStub& stub, const TransactionOptions& txn_options, int64_t start_ts,
+                      const std::vector<ExportRange>& ranges, const ExportOptions& options,
+                      const ExportBatchCallback& cb);
+
+  ~TxnSnapshotExporter() = default;
+
+  // block until all ranges are exported or export fail
+  Status Run();
+
+ private:
+  // (range index, start key of part), parts in key order, a split part is right after the part split from
+  using PartKey = std::pair<size_t, std::string>;
+
+  // [next_key, end_key) of ranges_[key.first] left to scan, next_key and end_key are only touched by the worker of
+  // the part
+  struct Part {
+    PartKey key;
+    std::string next_key;
+    std::string end_key;
+    bool done{false};
+    // ordered export: batches wait here until the parts before are done, guarded by emit_mutex_
+    std::deque<std::vector<KVPair>> buffered;
+  };
+
+  Status InitParts();
+  void Work();
+  Status ExportPart(Part* part);
+  Status ExportRegion(Part* part, const std::shared_ptr<Region>& region);
+  // true when the rest of part is split for an idle worker, end_key of part is shrunk then
+  bool MaybeSplit(Part* part);
+  Status Emit(Part* part, std::vector<KVPair>& kvs);
+  // ordered export: pass batches of head parts until a part not done
+  Status FlushHead();
+  void PartDone(Part* part, Status status);
+
+  const ClientStub& stub_;
+  const TransactionOptions txn_options_;
+  const int64_t start_ts_;
+  const std::vector<ExportRange>& ranges_;
+  const ExportOptions& options_;
+  const ExportBatchCallback& cb_;
+
+  // serializes cb_, guards parts_ and buffered batches
+  std::mutex emit_mutex_;
+  // parts not done, and in ordered export done parts not passed yet
+  std::map<PartKey, std::unique_ptr<Part>> parts_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Part*> pending_;
+  size_t running_{0};
+  size_t idle_{0};
+  Status status_;
+  std::atomic<bool> stop_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TRANSACTION_SNAPSHOT_EXPORTER_H_
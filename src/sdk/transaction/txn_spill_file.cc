@@ -0,0 +1,284 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/transaction/txn_spill_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const size_t kRecordHeaderSize = sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t);
+static const size_t kWriteBufferSize = 1024 * 1024;
+
+static void EncodeRecord(const TxnMutation& mutation, std::string& out) {
+  char header[kRecordHeaderSize];
+  auto type = static_cast<uint8_t>(mutation.type);
+  auto key_size = static_cast<uint32_t>(mutation.key.size());
+  auto value_size = static_cast<uint32_t>(mutation.value.size());
+  memcpy(header, &type, sizeof(type));
+  memcpy(header + sizeof(type), &key_size, sizeof(key_size));
+  memcpy(header + sizeof(type) + sizeof(key_size), &value_size, sizeof(value_size));
+
+  out.append(header, kRecordHeaderSize);
+  out.append(mutation.key);
+  out.append(mutation.value);
+}
+
+static void DecodeHeader(const char* data, TxnMutationType& type, uint32_t& key_size, uint32_t& value_size) {
+  uint8_t raw_type;
+  memcpy(&raw_type, data, sizeof(raw_type));
+  memcpy(&key_size, data + sizeof(raw_type), sizeof(key_size));
+  memcpy(&value_size, data + sizeof(raw_type) + sizeof(key_size), sizeof(value_size));
+  type = static_cast<TxnMutationType>(raw_type);
+}
+
+TxnSpillFile::TxnSpillFile(std::string dir) : dir_(std::move(dir)) {}
+
+TxnSpillFile::~TxnSpillFile() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+Status TxnSpillFile::Open() {
+  CHECK(fd_ < 0) << "spill file already opened";
+  std::string path = fmt::format("{}/dingo_sdk_txn_spill_XXXXXX", dir_);
+  int fd = mkstemp(path.data());
+  if (fd < 0) {
+    return Status::IOError(errno, fmt::format("create txn spill file in {} fail, error:{}", dir_, strerror(errno)));
+  }
+
+  // unlink at once, space is released when fd is closed
+  unlink(path.c_str());
+  fd_ = fd;
+  DINGO_LOG(INFO) << "open txn spill file: " << path;
+  return Status::OK();
+}
+
+Status TxnSpillFile::AppendRun(const TxnBuffer::MutationMap& mutations) {
+  CHECK(fd_ >= 0) << "spill file not opened";
+
+  Run run;
+  run.offset = file_size_;
+  int64_t offset = file_size_;
+
+  std::string buf;
+  buf.reserve(kWriteBufferSize);
+  for (const auto& [key, mutation] : mutations) {
+    if (run.count % kIndexInterval == 0) {
+      run.index.emplace_back(key, offset + static_cast<int64_t>(buf.size()));
+    }
+    EncodeRecord(mutation, buf);
+    run.count++;
+
+    if (buf.size() >= kWriteBufferSize) {
+      DINGO_RETURN_NOT_OK(WriteAt(offset, buf));
+      offset += buf.size();
+      buf.clear();
+    }
+  }
+
+  if (!buf.empty()) {
+    DINGO_RETURN_NOT_OK(WriteAt(offset, buf));
+    offset += buf.size();
+  }
+
+  // a failed run is not recorded and is overwritten by next one
+  run.size = offset - run.offset;
+  file_size_ = offset;
+  runs_.push_back(std::move(run));
+  return Status::OK();
+}
+
+Status TxnSpillFile::WriteAt(int64_t offset, const std::string& data) const {
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t n = pwrite(fd_, data.data() + written, data.size() - written, offset + written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError(errno, fmt::format("write txn spill file fail, error:{}", strerror(errno)));
+    }
+    written += n;
+  }
+  return Status::OK();
+}
+
+Status TxnSpillFile::ReadAt(int64_t offset, int64_t size, std::string& out) const {
+  out.resize(size);
+  int64_t read = 0;
+  while (read < size) {
+    ssize_t n = pread(fd_, out.data() + read, size - read, offset + read);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError(errno, fmt::format("read txn spill file fail, error:{}", strerror(errno)));
+    }
+    if (n == 0) {
+      return Status::Corruption(fmt::format("txn spill file truncated, offset:{} size:{}", offset, size));
+    }
+    read += n;
+  }
+  return Status::OK();
+}
+
+int64_t TxnSpillFile::SeekOffset(const Run& run, std::string_view key, int64_t* end_offset) {
+  auto iter = std::upper_bound(run.index.begin(), run.index.end(), key,
+                               [](std::string_view k, const auto& entry) { return k < entry.first; });
+  if (iter == run.index.begin()) {
+    return -1;
+  }
+
+  if (end_offset != nullptr) {
+    *end_offset = (iter == run.index.end()) ? run.offset + run.size : iter->second;
+  }
+  return (iter - 1)->second;
+}
+
+Status TxnSpillFile::Get(std::string_view key, TxnMutation& mutation) const {
+  for (auto run = runs_.rbegin(); run != runs_.rend(); ++run) {
+    int64_t end_offset = 0;
+    int64_t offset = SeekOffset(*run, key, &end_offset);
+    if (offset < 0) {
+      continue;
+    }
+
+    // one index interval is read at once
+    std::string block;
+    DINGO_RETURN_NOT_OK(ReadAt(offset, end_offset - offset, block));
+    size_t pos = 0;
+    while (pos + kRecordHeaderSize <= block.size()) {
+      TxnMutationType type;
+      uint32_t key_size;
+      uint32_t value_size;
+      DecodeHeader(block.data() + pos, type, key_size, value_size);
+      pos += kRecordHeaderSize;
+
+      std::string_view record_key(block.data() + pos, key_size);
+      if (record_key == key) {
+        mutation.type = type;
+        mutation.key = key;
+        mutation.value.assign(block.data() + pos + key_size, value_size);
+        return Status::OK();
+      }
+
+      if (record_key > key) {
+        break;
+      }
+      pos += key_size + value_size;
+    }
+  }
+
+  return Status::NotFound(fmt::format("key:{} not found", key));
+}
+
+std::unique_ptr<TxnSpillRunReader> TxnSpillFile::NewReader(size_t run, const std::string& start_key,
+                                                           const std::string& end_key) const {
+  CHECK_LT(run, runs_.size());
+  const auto& r = runs_[run];
+
+  int64_t offset = r.offset;
+  if (!start_key.empty()) {
+    int64_t seek = SeekOffset(r, start_key, nullptr);
+    if (seek >= 0) {
+      offset = seek;
+    }
+  }
+
+  return std::make_unique<TxnSpillRunReader>(this, offset, r.offset + r.size, start_key, end_key);
+}
+
+TxnSpillRunReader::TxnSpillRunReader(const TxnSpillFile* file, int64_t offset, int64_t end_offset,
+                                     std::string start_key, std::string end_key)
+    : file_(file), file_offset_(offset), end_offset_(end_offset), end_key_(std::move(end_key)) {
+  // skip records before start_key in the first index interval
+  do {
+    Next();
+  } while (valid_ && mutation_.key < start_key);
+}
+
+void TxnSpillRunReader::Next() {
+  valid_ = ReadRecord();
+  if (valid_ && !end_key_.empty() && mutation_.key >= end_key_) {
+    valid_ = false;
+  }
+}
+
+bool TxnSpillRunReader::Fill(int64_t size) {
+  int64_t buffered = static_cast<int64_t>(buf_.size() - buf_pos_);
+  if (buffered >= size) {
+    return true;
+  }
+
+  int64_t to_read = std::min(std::max(size - buffered, kReadChunkSize), end_offset_ - file_offset_);
+  if (to_read < size - buffered) {
+    status_ = Status::Corruption(fmt::format("txn spill run truncated, offset:{}", file_offset_));
+    return false;
+  }
+
+  std::string chunk;
+  status_ = file_->ReadAt(file_offset_, to_read, chunk);
+  if (!status_.ok()) {
+    return false;
+  }
+  file_offset_ += to_read;
+
+  buf_.erase(0, buf_pos_);
+  buf_pos_ = 0;
+  buf_.append(chunk);
+  return true;
+}
+
+bool TxnSpillRunReader::ReadRecord() {
+  if (buf_pos_ == buf_.size() && file_offset_ >= end_offset_) {
+    return false;
+  }
+
+  if (!Fill(kRecordHeaderSize)) {
+    return false;
+  }
+
+  TxnMutationType type;
+  uint32_t key_size;
+  uint32_t value_size;
+  DecodeHeader(buf_.data() + buf_pos_, type, key_size, value_size);
+  if (!Fill(kRecordHeaderSize + key_size + value_size)) {
+    return false;
+  }
+
+  const char* data = buf_.data() + buf_pos_ + kRecordHeaderSize;
+  mutation_.type = type;
+  mutation_.key.assign(data, key_size);
+  mutation_.value.assign(data + key_size, value_size);
+  buf_pos_ += kRecordHeaderSize + key_size + value_size;
+  return true;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
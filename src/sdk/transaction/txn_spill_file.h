@@ -0,0 +1,121 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRANSACTION_SPILL_FILE_H_
+#define DINGODB_SDK_TRANSACTION_SPILL_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "sdk/status.h"
+#include "sdk/transaction/txn_buffer.h"
+
+namespace dingodb {
+namespace sdk {
+
+class TxnSpillRunReader;
+
+// append only temp file of sorted mutation runs spilled by TxnBuffer, the file is unlinked once created, so it is
+// removed when closed even if process crash.
+// record: | type(1) | key_size(4) | value_size(4) | key | value |
+class TxnSpillFile {
+ public:
+  struct Run {
+    int64_t offset{0};
+    int64_t size{0};
+    int64_t count{0};
+    // every kIndexInterval-th key of run and its file offset, used to seek without read the whole run
+    std::vector<std::pair<std::string, int64_t>> index;
+  };
+
+  explicit TxnSpillFile(std::string dir);
+
+  ~TxnSpillFile();
+
+  Status Open();
+
+  // write mutations as a new run, mutations must be in ascending key order
+  Status AppendRun(const TxnBuffer::MutationMap& mutations);
+
+  // newest mutation of key in all runs
+  Status Get(std::string_view key, TxnMutation& mutation) const;
+
+  // mutations of run in [start_key, end_key), empty start_key or end_key means unbounded
+  std::unique_ptr<TxnSpillRunReader> NewReader(size_t run, const std::string& start_key,
+                                               const std::string& end_key) const;
+
+  // runs are ordered from oldest to newest
+  size_t RunCount() const { return runs_.size(); }
+
+  int64_t FileSize() const { return file_size_; }
+
+ private:
+  friend class TxnSpillRunReader;
+
+  static const int64_t kIndexInterval = 64;
+
+  Status WriteAt(int64_t offset, const std::string& data) const;
+  Status ReadAt(int64_t offset, int64_t size, std::string& out) const;
+
+  // file offset of index entry before key, -1 if key is smaller than the first key of run
+  static int64_t SeekOffset(const Run& run, std::string_view key, int64_t* end_offset);
+
+  const std::string dir_;
+  int fd_{-1};
+  int64_t file_size_{0};
+  std::vector<Run> runs_;
+};
+
+// sequential reader of one run, read file by chunks
+class TxnSpillRunReader {
+ public:
+  TxnSpillRunReader(const TxnSpillFile* file, int64_t offset, int64_t end_offset, std::string start_key,
+                    std::string end_key);
+
+  ~TxnSpillRunReader() = default;
+
+  bool Valid() const { return valid_; }
+
+  const TxnMutation& Mutation() const { return mutation_; }
+
+  void Next();
+
+  // error of the last read, reader is invalid when read fail
+  const Status& GetStatus() const { return status_; }
+
+ private:
+  static const int64_t kReadChunkSize = 1024 * 1024;
+
+  bool Fill(int64_t size);
+  bool ReadRecord();
+
+  const TxnSpillFile* file_;
+  int64_t file_offset_;
+  const int64_t end_offset_;
+  const std::string end_key_;
+
+  std::string buf_;
+  size_t buf_pos_{0};
+  bool valid_{false};
+  TxnMutation mutation_;
+  Status status_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TRANSACTION_SPILL_FILE_H_
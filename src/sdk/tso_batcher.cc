@@ -0,0 +1,169 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/tso_batcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/coordinator_rpc.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void UpdateMax(std::atomic<int64_t>& max, int64_t value) {
+  int64_t cur = max.load(std::memory_order_relaxed);
+  while (value > cur && !max.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+Status TsoBatcher::GetTso(pb::meta::TsoTimestamp& tso) {
+  int64_t start_us = NowUs();
+
+  Waiter waiter;
+  std::unique_lock<std::mutex> lk(mutex_);
+  pending_.push_back(&waiter);
+
+  while (!waiter.done) {
+    if (!inflight_) {
+      LeadBatchUnlocked(lk);
+    } else {
+      cv_.wait(lk);
+    }
+  }
+  lk.unlock();
+
+  RecordWait(NowUs() - start_us);
+
+  if (waiter.status.ok()) {
+    tso = waiter.tso;
+  }
+  return waiter.status;
+}
+
+Status TsoBatcher::GetStaleTso(int64_t max_staleness_ms, pb::meta::TsoTimestamp& tso) {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (has_last_tso_ && NowUs() - last_tso_send_us_ <= max_staleness_ms * 1000) {
+      tso = last_tso_;
+      return Status::OK();
+    }
+  }
+
+  return GetTso(tso);
+}
+
+void TsoBatcher::LeadBatchUnlocked(std::unique_lock<std::mutex>& lk) {
+  CHECK(!inflight_);
+  inflight_ = true;
+
+  if (FLAGS_tso_batch_wait_us > 0) {
+    // give concurrent requests a chance to join this batch
+    lk.unlock();
+    std::this_thread::sleep_for(std::chrono::microseconds(FLAGS_tso_batch_wait_us));
+    lk.lock();
+  }
+
+  size_t max_batch_size = std::max<int64_t>(FLAGS_tso_batch_max_size, 1);
+  std::vector<Waiter*> batch;
+  batch.reserve(std::min(pending_.size(), max_batch_size));
+  while (!pending_.empty() && batch.size() < max_batch_size) {
+    batch.push_back(pending_.front());
+    pending_.pop_front();
+  }
+  lk.unlock();
+
+  pb::meta::TsoTimestamp start_tso;
+  int64_t send_us = NowUs();
+  Status status = SendTsoRpc(batch.size(), start_tso);
+
+  lk.lock();
+  if (status.ok()) {
+    has_last_tso_ = true;
+    last_tso_.set_physical(start_tso.physical());
+    last_tso_.set_logical(start_tso.logical() + static_cast<int64_t>(batch.size()) - 1);
+    last_tso_send_us_ = send_us;
+  }
+  for (size_t i = 0; i < batch.size(); i++) {
+    Waiter* waiter = batch[i];
+    waiter->status = status;
+    if (status.ok()) {
+      waiter->tso.set_physical(start_tso.physical());
+      waiter->tso.set_logical(start_tso.logical() + static_cast<int64_t>(i));
+    }
+    waiter->done = true;
+  }
+  inflight_ = false;
+  // wake up finished waiters and let one of the remaining waiters lead next batch
+  cv_.notify_all();
+}
+
+Status TsoBatcher::SendTsoRpc(int64_t count, pb::meta::TsoTimestamp& start_tso) {
+  TsoServiceRpc rpc;
+  rpc.MutableRequest()->set_op_type(pb::meta::TsoOpType::OP_GEN_TSO);
+  rpc.MutableRequest()->set_count(count);
+
+  Status status = stub_.GetMetaRpcController()->SyncCall(rpc);
+  if (!status.IsOK()) {
+    DINGO_LOG(WARNING) << "Fail tsoService request fail, count:" << count << ", status:" << status.ToString()
+                       << ", response:" << rpc.Response()->DebugString();
+    return status;
+  }
+
+  CHECK(rpc.Response()->has_start_timestamp());
+  start_tso = rpc.Response()->start_timestamp();
+
+  rpc_count_.fetch_add(1, std::memory_order_relaxed);
+  tso_count_.fetch_add(count, std::memory_order_relaxed);
+  UpdateMax(max_batch_size_, count);
+
+  DINGO_LOG(DEBUG) << "tso batch count: " << count << ", start timestamp: " << start_tso.DebugString();
+  return status;
+}
+
+void TsoBatcher::RecordWait(int64_t wait_us) {
+  total_wait_us_.fetch_add(wait_us, std::memory_order_relaxed);
+  UpdateMax(max_wait_us_, wait_us);
+}
+
+TsoBatcherMetrics TsoBatcher::GetMetrics() const {
+  TsoBatcherMetrics metrics;
+  metrics.rpc_count = rpc_count_.load(std::memory_order_relaxed);
+  metrics.tso_count = tso_count_.load(std::memory_order_relaxed);
+  metrics.max_batch_size = max_batch_size_.load(std::memory_order_relaxed);
+  metrics.total_wait_us = total_wait_us_.load(std::memory_order_relaxed);
+  metrics.max_wait_us = max_wait_us_.load(std::memory_order_relaxed);
+  return metrics;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,100 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_TSO_BATCHER_H_
+#define DINGODB_SDK_TSO_BATCHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include "proto/meta.pb.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+struct TsoBatcherMetrics {
+  int64_t rpc_count{0};
+  int64_t tso_count{0};
+  int64_t max_batch_size{0};
+  int64_t total_wait_us{0};
+  int64_t max_wait_us{0};
+
+  double AvgBatchSize() const { return rpc_count == 0 ? 0 : static_cast<double>(tso_count) / rpc_count; }
+  double AvgWaitUs() const { return tso_count == 0 ? 0 : static_cast<double>(total_wait_us) / tso_count; }
+};
+
+// Concurrent tso requests share one coordinator rpc, the leader request collect all waiting requests, ask
+// coordinator for N logical timestamps and hand them out in request order.
+// Timestamps are never prefetched, every timestamp is allocated after its request arrived, so a txn always
+// get a timestamp greater than any commit ts finished before it started.
+class TsoBatcher {
+ public:
+  TsoBatcher(const TsoBatcher&) = delete;
+  const TsoBatcher& operator=(const TsoBatcher&) = delete;
+
+  explicit TsoBatcher(const ClientStub& stub) : stub_(stub) {}
+
+  ~TsoBatcher() = default;
+
+  Status GetTso(pb::meta::TsoTimestamp& tso);
+
+  // reuse the newest tso handed out when its rpc was sent at most max_staleness_ms ago, so tso is at most
+  // max_staleness_ms older than now, else same as GetTso. Only for reads which accept stale data.
+  Status GetStaleTso(int64_t max_staleness_ms, pb::meta::TsoTimestamp& tso);
+
+  TsoBatcherMetrics GetMetrics() const;
+
+ private:
+  struct Waiter {
+    pb::meta::TsoTimestamp tso;
+    Status status;
+    bool done{false};
+  };
+
+  // mutex_ is held when called, release it while sending rpc
+  void LeadBatchUnlocked(std::unique_lock<std::mutex>& lk);
+
+  Status SendTsoRpc(int64_t count, pb::meta::TsoTimestamp& start_tso);
+
+  void RecordWait(int64_t wait_us);
+
+  const ClientStub& stub_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Waiter*> pending_;
+  bool inflight_{false};
+
+  // newest tso handed out and steady clock when its rpc was sent, protected by mutex_
+  bool has_last_tso_{false};
+  pb::meta::TsoTimestamp last_tso_;
+  int64_t last_tso_send_us_{0};
+
+  std::atomic<int64_t> rpc_count_{0};
+  std::atomic<int64_t> tso_count_{0};
+  std::atomic<int64_t> max_batch_size_{0};
+  std::atomic<int64_t> total_wait_us_{0};
+  std::atomic<int64_t> max_wait_us_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_TSO_BATCHER_H_
@@ -0,0 +1,147 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_UTILS_AGGREGATE_CACHE_H_
+#define DINGODB_SDK_UTILS_AGGREGATE_CACHE_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "sdk/status.h"
+#include "sdk/utils/single_flight.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Latest aggregate of each index, e.g. metrics summed over all regions, for callers polling it who accept a result
+// aggregated a while ago. Entries older than ttl are never served, disabled when ttl_ms <= 0.
+// Concurrent loads of one index share one aggregation.
+template <class Result>
+class AggregateCache {
+ public:
+  AggregateCache(const AggregateCache&) = delete;
+  const AggregateCache& operator=(const AggregateCache&) = delete;
+
+  explicit AggregateCache(int64_t ttl_ms) : ttl_ms_(ttl_ms) {}
+
+  ~AggregateCache() = default;
+
+  using LoadFn = std::function<Status(Result&)>;
+
+  // result aggregated at most min(max_staleness_ms, ttl) ago is returned, otherwise load is run and its result is
+  // cached, max_staleness_ms <= 0 always runs load
+  Status Get(int64_t index_id, int64_t max_staleness_ms, const LoadFn& load, Result& out_result) {
+    if (ttl_ms_ <= 0 || max_staleness_ms <= 0) {
+      return LoadAndPut(index_id, load, out_result);
+    }
+
+    int64_t max_age_ms = std::min(max_staleness_ms, ttl_ms_);
+    if (Lookup(index_id, max_age_ms, out_result)) {
+      return Status::OK();
+    }
+
+    bool is_leader = false;
+    Status s = flight_.Do(
+        index_id,
+        [&]() {
+          // another leader may put it between the lookup above and here
+          if (Lookup(index_id, max_age_ms, out_result)) {
+            return Status::OK();
+          }
+          return LoadAndPut(index_id, load, out_result);
+        },
+        is_leader);
+    if (!s.ok() || is_leader) {
+      return s;
+    }
+
+    // result of leader was just put, unless it is older than ttl at once
+    if (Lookup(index_id, ttl_ms_, out_result)) {
+      return Status::OK();
+    }
+    return LoadAndPut(index_id, load, out_result);
+  }
+
+  void Erase(int64_t index_id) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    entries_.erase(index_id);
+  }
+
+  int64_t Size() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    Result result;
+    int64_t update_ms;
+  };
+
+  static int64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  bool Lookup(int64_t index_id, int64_t max_age_ms, Result& out_result) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto iter = entries_.find(index_id);
+    if (iter == entries_.end()) {
+      return false;
+    }
+
+    int64_t age_ms = NowMs() - iter->second.update_ms;
+    if (age_ms > ttl_ms_) {
+      entries_.erase(iter);
+      return false;
+    }
+    if (age_ms > max_age_ms) {
+      return false;
+    }
+
+    out_result = iter->second.result;
+    return true;
+  }
+
+  Status LoadAndPut(int64_t index_id, const LoadFn& load, Result& out_result) {
+    Result result;
+    Status s = load(result);
+    if (!s.ok()) {
+      return s;
+    }
+
+    if (ttl_ms_ > 0) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      entries_[index_id] = Entry{result, NowMs()};
+    }
+    out_result = std::move(result);
+    return s;
+  }
+
+  const int64_t ttl_ms_;
+
+  std::mutex mutex_;
+  std::unordered_map<int64_t, Entry> entries_;
+
+  SingleFlight<int64_t> flight_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_UTILS_AGGREGATE_CACHE_H_
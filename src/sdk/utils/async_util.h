@@ -15,26 +15,103 @@
 #ifndef DINGODB_SDK_ASYNC_UTIL_H_
 #define DINGODB_SDK_ASYNC_UTIL_H_
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
+#include <thread>
 
+#include "sdk/common/param_config.h"
 #include "sdk/status.h"
 #include "sdk/utils/callback.h"
 
+#ifndef USE_GRPC
+#include "bthread/bthread.h"
+#include "bthread/countdown_event.h"
+#endif
+
 namespace dingodb {
 namespace sdk {
 
-class Synchronizer {
+// one shot event signaled by rpc callback thread and waited by caller, when FLAGS_sdk_sync_wait_spin_us > 0 the
+// waiter spins that long before park, so a fast completion skips the futex sleep and wake of the waiter.
+// Set never touches the event once the waiter may return, the waiter can destroy it as soon as Wait returns.
+// In brpc builds the waiter parks on a butex, so a caller running in bthread yields its worker instead of blocking.
+class OneShotEvent {
  public:
-  Synchronizer() = default;
+  OneShotEvent() = default;
 
   void Wait() {
+    if (FLAGS_sdk_sync_wait_spin_us > 0) {
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(FLAGS_sdk_sync_wait_spin_us);
+      while (state_.load(std::memory_order_acquire) != kSet && std::chrono::steady_clock::now() < deadline) {
+#ifdef USE_GRPC
+        std::this_thread::yield();
+#else
+        bthread_yield();
+#endif
+      }
+    }
+
+    if (state_.load(std::memory_order_acquire) == kSet) {
+      return;
+    }
+
+#ifdef USE_GRPC
     std::unique_lock<std::mutex> lk(lock_);
-    while (!fire_) {
+    int expected = kIdle;
+    if (!state_.compare_exchange_strong(expected, kParked, std::memory_order_acq_rel)) {
+      return;
+    }
+    while (!notified_) {
       cv_.wait(lk);
     }
+#else
+    int expected = kIdle;
+    if (!state_.compare_exchange_strong(expected, kParked, std::memory_order_acq_rel)) {
+      return;
+    }
+    // wait returns at once if Set already signaled
+    parked_.wait();
+#endif
   }
 
+  void Set() {
+    // only a parked waiter needs wake, it can not return before notified under lock
+    if (state_.exchange(kSet, std::memory_order_acq_rel) == kParked) {
+#ifdef USE_GRPC
+      std::unique_lock<std::mutex> lk(lock_);
+      notified_ = true;
+      cv_.notify_one();
+#else
+      // signal reads the butex before waking, it does not touch the event after the waiter may return
+      parked_.signal();
+#endif
+    }
+  }
+
+ private:
+  static constexpr int kIdle = 0;
+  static constexpr int kSet = 1;
+  static constexpr int kParked = 2;
+
+  std::atomic<int> state_{kIdle};
+#ifdef USE_GRPC
+  std::mutex lock_;
+  std::condition_variable cv_;
+  bool notified_{false};
+#else
+  bthread::CountdownEvent parked_{1};
+#endif
+};
+
+class Synchronizer {
+ public:
+  Synchronizer() = default;
+
+  void Wait() { event_.Wait(); }
+
   RpcCallback AsRpcCallBack() {
     return [&]() { Fire(); };
   }
@@ -46,16 +123,32 @@ class Synchronizer {
     };
   }
 
-  void Fire() {
-    std::unique_lock<std::mutex> lk(lock_);
-    fire_ = true;
-    cv_.notify_one();
+  void Fire() { event_.Set(); }
+
+ private:
+  OneShotEvent event_;
+};
+
+// count down latch, Wait return when CountDown is called count times
+class CountDownSync {
+ public:
+  explicit CountDownSync(int64_t count) : count_(count) {
+    if (count_.load(std::memory_order_relaxed) <= 0) {
+      event_.Set();
+    }
+  }
+
+  void Wait() { event_.Wait(); }
+
+  void CountDown() {
+    if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      event_.Set();
+    }
   }
 
  private:
-  std::mutex lock_;
-  std::condition_variable cv_;
-  bool fire_{false};
+  std::atomic<int64_t> count_;
+  OneShotEvent event_;
 };
 
 }  // namespace sdk
@@ -0,0 +1,125 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef USE_GRPC
+
+#include "sdk/utils/bthread_actuator.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "butil/time.h"
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+BthreadActuator::~BthreadActuator() { Stop(); }
+
+bool BthreadActuator::Start(int thread_num) {
+  (void)thread_num;
+  running_.store(true);
+  return true;
+}
+
+bool BthreadActuator::Stop() {
+  if (!running_.exchange(false)) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(timer_mutex_);
+    for (Task* task : timer_tasks_) {
+      // non zero means OnTimer is running, it sees running_ false and drops the task
+      if (bthread_timer_del(task->timer) == 0) {
+        FinishTask(task);
+      }
+    }
+    timer_tasks_.clear();
+  }
+
+  while (inflight_.load(std::memory_order_acquire) > 0) {
+    bthread_usleep(1000);
+  }
+  return true;
+}
+
+bool BthreadActuator::Execute(std::function<void()> func) {
+  CHECK(running_);
+  inflight_.fetch_add(1, std::memory_order_relaxed);
+  return StartTask(new Task{this, std::move(func), CurrentRequestPriority()});
+}
+
+bool BthreadActuator::Schedule(std::function<void()> func, int delay_ms) {
+  CHECK(running_);
+  inflight_.fetch_add(1, std::memory_order_relaxed);
+  auto* task = new Task{this, std::move(func), CurrentRequestPriority()};
+
+  // hold the lock so OnTimer of a short delay finds the task registered
+  std::lock_guard<std::mutex> lk(timer_mutex_);
+  if (bthread_timer_add(&task->timer, butil::milliseconds_from_now(std::max(delay_ms, 0)), OnTimer, task) != 0) {
+    LOG(WARNING) << "bthread_timer_add fail, delay_ms:" << delay_ms;
+    FinishTask(task);
+    return false;
+  }
+  timer_tasks_.insert(task);
+  return true;
+}
+
+bool BthreadActuator::StartTask(Task* task) {
+  bthread_t tid;
+  if (bthread_start_background(&tid, nullptr, RunTask, task) != 0) {
+    LOG(WARNING) << "bthread_start_background fail";
+    FinishTask(task);
+    return false;
+  }
+  return true;
+}
+
+void BthreadActuator::FinishTask(Task* task) {
+  BthreadActuator* actuator = task->actuator;
+  delete task;
+  actuator->inflight_.fetch_sub(1, std::memory_order_release);
+}
+
+void* BthreadActuator::RunTask(void* arg) {
+  auto* task = static_cast<Task*>(arg);
+  {
+    ScopedRequestPriority scope(task->priority);
+    task->fn();
+  }
+  task->actuator->FinishTask(task);
+  return nullptr;
+}
+
+void BthreadActuator::OnTimer(void* arg) {
+  auto* task = static_cast<Task*>(arg);
+  BthreadActuator* actuator = task->actuator;
+  {
+    std::lock_guard<std::mutex> lk(actuator->timer_mutex_);
+    actuator->timer_tasks_.erase(task);
+  }
+
+  // timer callbacks must be short, run the function in its own bthread
+  if (!actuator->running_.load()) {
+    actuator->FinishTask(task);
+    return;
+  }
+  actuator->StartTask(task);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // USE_GRPC
@@ -0,0 +1,87 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_BTHREAD_ACTUATOR_H_
+#define DINGODB_SDK_BTHREAD_ACTUATOR_H_
+
+// only in brpc builds
+#ifndef USE_GRPC
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "bthread/bthread.h"
+#include "sdk/request_priority.h"
+#include "sdk/utils/actuator.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Runs every function in its own bthread and delays with bthread timer, so sdk work shares the bthread workers of
+// the brpc server embedding the sdk, and a function waiting on sdk rpcs yields its worker instead of blocking it.
+// thread_num of Start is ignored, the concurrency of bthread is owned by the process.
+class BthreadActuator final : public Actuator {
+ public:
+  BthreadActuator() = default;
+
+  ~BthreadActuator() override;
+
+  bool Start(int thread_num) override;
+
+  // drop pending scheduled functions and wait running ones
+  bool Stop() override;
+
+  bool Execute(std::function<void()> func) override;
+
+  bool Schedule(std::function<void()> func, int delay_ms) override;
+
+  int ThreadNum() const override { return bthread_getconcurrency(); }
+
+  std::string Name() const override { return InternalName(); }
+
+  static std::string InternalName() { return "BthreadActuator"; }
+
+ private:
+  struct Task {
+    BthreadActuator* actuator;
+    std::function<void()> fn;
+    RequestPriority priority;
+    bthread_timer_t timer{0};
+  };
+
+  bool StartTask(Task* task);
+
+  void FinishTask(Task* task);
+
+  static void* RunTask(void* arg);
+
+  static void OnTimer(void* arg);
+
+  std::atomic<bool> running_{false};
+  // tasks started or scheduled but not finished
+  std::atomic<int64_t> inflight_{0};
+
+  std::mutex timer_mutex_;
+  std::set<Task*> timer_tasks_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // USE_GRPC
+#endif  // DINGODB_SDK_BTHREAD_ACTUATOR_H_
@@ -15,6 +15,8 @@
 #ifndef DINGODB_SDK_CODEC_H_
 #define DINGODB_SDK_CODEC_H_
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 namespace dingodb {
@@ -45,6 +47,45 @@ static std::string HexStringToBytes(const std::string& hex) {
   }
   return bytes;
 }
+
+static inline uint64_t HostToBigEndian64(uint64_t value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  // a single bswap, or pshufb when the calling loop is vectorized
+  return __builtin_bswap64(value);
+#else
+  return value;
+#endif
+}
+
+static inline uint64_t BigEndianToHost64(uint64_t value) { return HostToBigEndian64(value); }
+
+// 8 bytes big endian, same bytes with Buf::WriteLong
+static inline void EncodeInt64(int64_t value, char* out) {
+  uint64_t big_endian = HostToBigEndian64(static_cast<uint64_t>(value));
+  memcpy(out, &big_endian, sizeof(big_endian));
+}
+
+static inline int64_t DecodeInt64(const char* in) {
+  uint64_t big_endian;
+  memcpy(&big_endian, in, sizeof(big_endian));
+  return static_cast<int64_t>(BigEndianToHost64(big_endian));
+}
+
+static const uint64_t kInt64SignBit = 0x8000000000000000ULL;
+
+// 8 bytes big endian with sign bit flipped, so keys sort as signed integers,
+// same bytes with DingoSchema<std::optional<int64_t>>::InternalEncodeKey
+static inline void EncodeComparableInt64(int64_t value, char* out) {
+  uint64_t big_endian = HostToBigEndian64(static_cast<uint64_t>(value) ^ kInt64SignBit);
+  memcpy(out, &big_endian, sizeof(big_endian));
+}
+
+static inline int64_t DecodeComparableInt64(const char* in) {
+  uint64_t big_endian;
+  memcpy(&big_endian, in, sizeof(big_endian));
+  return static_cast<int64_t>(BigEndianToHost64(big_endian) ^ kInt64SignBit);
+}
+
 };  // namespace codec
 }  // namespace sdk
 }  // namespace dingodb
@@ -0,0 +1,75 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/utils/latency_ewma.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+struct ZScore {
+  int64_t percentile;
+  double z;
+};
+
+// one sided z score of standard normal distribution
+constexpr ZScore kZScores[] = {{50, 0.0}, {75, 0.6745}, {90, 1.2816}, {95, 1.6449}, {99, 2.3263}};
+
+double PercentileToZScore(int64_t percentile) {
+  percentile = std::clamp<int64_t>(percentile, 50, 99);
+  for (size_t i = 1; i < sizeof(kZScores) / sizeof(kZScores[0]); i++) {
+    const auto& lo = kZScores[i - 1];
+    const auto& hi = kZScores[i];
+    if (percentile <= hi.percentile) {
+      double ratio = static_cast<double>(percentile - lo.percentile) / (hi.percentile - lo.percentile);
+      return lo.z + ratio * (hi.z - lo.z);
+    }
+  }
+  return kZScores[sizeof(kZScores) / sizeof(kZScores[0]) - 1].z;
+}
+}  // namespace
+
+void LatencyEwma::Record(int64_t latency_us) {
+  double sample = static_cast<double>(latency_us);
+  if (samples_ == 0) {
+    mean_us_ = sample;
+    var_ = 0;
+  } else {
+    double diff = sample - mean_us_;
+    mean_us_ += alpha_ * diff;
+    var_ = (1 - alpha_) * (var_ + alpha_ * diff * diff);
+  }
+  samples_++;
+}
+
+void LatencyEwma::Reset() {
+  mean_us_ = 0;
+  var_ = 0;
+  samples_ = 0;
+}
+
+int64_t LatencyEwma::QuantileUs(int64_t percentile) const {
+  if (samples_ == 0) {
+    return -1;
+  }
+
+  return static_cast<int64_t>(mean_us_ + PercentileToZScore(percentile) * std::sqrt(var_));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,52 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_LATENCY_EWMA_H_
+#define DINGODB_SDK_LATENCY_EWMA_H_
+
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+// Exponentially weighted mean and variance of latency samples, not thread safe.
+class LatencyEwma {
+ public:
+  // alpha is the weight of the newest sample
+  explicit LatencyEwma(double alpha = 0.2) : alpha_(alpha) {}
+
+  ~LatencyEwma() = default;
+
+  void Record(int64_t latency_us);
+
+  void Reset();
+
+  int64_t Samples() const { return samples_; }
+
+  double MeanUs() const { return mean_us_; }
+
+  // approximate latency percentile, percentile is clamped to [50, 99],
+  // assume latency is roughly normal around the mean, return -1 when no sample
+  int64_t QuantileUs(int64_t percentile) const;
+
+ private:
+  double alpha_;
+  double mean_us_{0};
+  double var_{0};
+  int64_t samples_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_LATENCY_EWMA_H_
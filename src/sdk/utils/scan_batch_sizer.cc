@@ -0,0 +1,69 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/utils/scan_batch_sizer.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// weight of the newest batch in the average row size
+const double kAvgRowBytesAlpha = 0.5;
+
+int64_t ClampRows(int64_t rows) {
+  int64_t max_rows = std::max<int64_t>(FLAGS_scan_batch_max_size, kMinScanBatchSize);
+  return std::clamp<int64_t>(rows, kMinScanBatchSize, max_rows);
+}
+}  // namespace
+
+ScanBatchSizer::ScanBatchSizer(int64_t rows) : rows_(ClampRows(rows)) {}
+
+void ScanBatchSizer::SetRows(int64_t rows) {
+  rows_ = ClampRows(rows);
+  ceiling_ = rows_;
+}
+
+void ScanBatchSizer::Record(int64_t rows, int64_t bytes) {
+  if (rows <= 0) {
+    return;
+  }
+
+  double row_bytes = static_cast<double>(bytes) / rows;
+  avg_row_bytes_ =
+      avg_row_bytes_ == 0 ? row_bytes : kAvgRowBytesAlpha * row_bytes + (1 - kAvgRowBytesAlpha) * avg_row_bytes_;
+
+  if (!FLAGS_scan_batch_adaptive || FLAGS_scan_batch_max_bytes <= 0 || avg_row_bytes_ <= 0) {
+    return;
+  }
+
+  int64_t target = static_cast<int64_t>(FLAGS_scan_batch_max_bytes / avg_row_bytes_);
+  if (target < rows_) {
+    rows_ = ClampRows(target);
+  } else if (rows >= rows_) {
+    // only a full batch tells the region has more rows worth a bigger batch
+    int64_t grown = std::min(target, rows_ * 2);
+    if (ceiling_ > 0) {
+      grown = std::min(grown, ceiling_);
+    }
+    rows_ = ClampRows(grown);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
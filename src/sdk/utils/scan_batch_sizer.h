@@ -0,0 +1,52 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_SCAN_BATCH_SIZER_H_
+#define DINGODB_SDK_SCAN_BATCH_SIZER_H_
+
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+// Row limit of the next scan batch of a region scanner, not thread safe.
+// Rows are clamped to [kMinScanBatchSize, FLAGS_scan_batch_max_size]. When FLAGS_scan_batch_adaptive is true, the
+// limit follows the average row size seen so far so one response is about FLAGS_scan_batch_max_bytes: it shrinks at
+// once when rows are large, and grows at most 2x per full batch when rows are small. Rows set by SetRows are the
+// most rows of later batches, so they can still shrink for the byte budget.
+class ScanBatchSizer {
+ public:
+  explicit ScanBatchSizer(int64_t rows);
+
+  ~ScanBatchSizer() = default;
+
+  void SetRows(int64_t rows);
+
+  int64_t Rows() const { return rows_; }
+
+  // rows and bytes of keys and values returned by one batch
+  void Record(int64_t rows, int64_t bytes);
+
+  double AvgRowBytes() const { return avg_row_bytes_; }
+
+ private:
+  int64_t rows_;
+  // set by SetRows, 0 means FLAGS_scan_batch_max_size
+  int64_t ceiling_{0};
+  double avg_row_bytes_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_SCAN_BATCH_SIZER_H_
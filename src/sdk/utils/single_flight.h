@@ -0,0 +1,95 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_UTILS_SINGLE_FLIGHT_H_
+#define DINGODB_SDK_UTILS_SINGLE_FLIGHT_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Deduplicate concurrent synchronous loads of the same key. The first caller (the leader) runs fn, callers
+// arriving while it is in flight wait and get the leader status, then read the loaded value from where fn
+// stored it, e.g. a cache.
+template <class Key, class Hash = std::hash<Key>>
+class SingleFlight {
+ public:
+  SingleFlight() = default;
+
+  ~SingleFlight() = default;
+
+  // is_leader is set true when fn is run by this caller
+  Status Do(const Key& key, const std::function<Status()>& fn, bool& is_leader) {
+    std::shared_ptr<Call> call;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto iter = calls_.find(key);
+      if (iter != calls_.end()) {
+        call = iter->second;
+        is_leader = false;
+      } else {
+        call = std::make_shared<Call>();
+        calls_.emplace(key, call);
+        is_leader = true;
+      }
+    }
+
+    if (!is_leader) {
+      std::unique_lock<std::mutex> lock(call->mutex);
+      call->cv.wait(lock, [&call] { return call->done; });
+      return call->status;
+    }
+
+    Status status = fn();
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      calls_.erase(key);
+    }
+    {
+      std::lock_guard<std::mutex> lock(call->mutex);
+      call->status = status;
+      call->done = true;
+      call->cv.notify_all();
+    }
+    return status;
+  }
+
+  int64_t InflightCount() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return calls_.size();
+  }
+
+ private:
+  struct Call {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done{false};
+    Status status;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<Key, std::shared_ptr<Call>, Hash> calls_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_UTILS_SINGLE_FLIGHT_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_UTILS_TASK_TRACKER_H_
+#define DINGODB_SDK_UTILS_TASK_TRACKER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace dingodb {
+namespace sdk {
+
+// Count background tasks of a client which refer to its ClientStub, e.g. txn heartbeat or prefetch, their functions
+// may still run on a shared actuator after the client is destroyed. A task enters before it touches the stub and
+// leaves once it is done with it, a function fired after CancelAndWait fails Enter and drops the work without
+// touching the stub. A task waiting for a timer need not stay entered, it enters again when the timer fires.
+// NOTE: shared by client and its tasks, so a task checks it after the client is destroyed
+class TaskTracker {
+ public:
+  TaskTracker(const TaskTracker&) = delete;
+  const TaskTracker& operator=(const TaskTracker&) = delete;
+
+  TaskTracker() = default;
+
+  ~TaskTracker() = default;
+
+  // false once cancelled, then caller must not touch the stub
+  bool Enter() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (cancelled_) {
+      return false;
+    }
+    running_++;
+    return true;
+  }
+
+  void Leave() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (--running_ == 0 && cancelled_) {
+      cv_.notify_all();
+    }
+  }
+
+  // entered tasks check it to stop early, e.g. skip retries
+  bool IsCancelled() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return cancelled_;
+  }
+
+  // called by ~ClientStub before the members tasks use are destroyed, tasks entered before finish their rpcs in
+  // flight, so the actuator and rpc clients must be alive
+  void CancelAndWait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    cv_.wait(lock, [this] { return running_ == 0; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int64_t running_{0};
+  bool cancelled_{false};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_UTILS_TASK_TRACKER_H_
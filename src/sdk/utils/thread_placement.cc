@@ -0,0 +1,128 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/utils/thread_placement.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// spread sdk threads of all pools over the cpu set
+std::atomic<uint64_t> next_cpu{0};
+
+bool ParseInt(const std::string& str, int& out) {
+  if (str.empty() || str.size() > 6 || str.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  out = std::stoi(str);
+  return out < CPU_SETSIZE;
+}
+}  // namespace
+
+bool ThreadPlacement::ParseCpuList(const std::string& str, std::vector<int>& out) {
+  out.clear();
+  size_t start = 0;
+  while (start <= str.size()) {
+    size_t end = str.find(',', start);
+    if (end == std::string::npos) {
+      end = str.size();
+    }
+    std::string item = str.substr(start, end - start);
+    start = end + 1;
+
+    size_t dash = item.find('-');
+    int first = 0;
+    int last = 0;
+    if (dash == std::string::npos) {
+      if (!ParseInt(item, first)) {
+        return false;
+      }
+      last = first;
+    } else if (!ParseInt(item.substr(0, dash), first) || !ParseInt(item.substr(dash + 1), last) || first > last) {
+      return false;
+    }
+
+    for (int cpu = first; cpu <= last; ++cpu) {
+      out.push_back(cpu);
+    }
+  }
+  return !out.empty();
+}
+
+ThreadPlacement ThreadPlacement::FromFlags() {
+  ThreadPlacement placement;
+  const std::string& cpus = FLAGS_sdk_thread_cpus;
+  if (cpus.empty()) {
+    return placement;
+  }
+
+  if (cpus == "caller") {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    int ret = pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    if (ret != 0) {
+      DINGO_LOG(WARNING) << fmt::format("get caller thread affinity fail, error:{}, sdk threads not pinned", ret);
+      return placement;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpuset)) {
+        placement.cpus_.push_back(cpu);
+      }
+    }
+    return placement;
+  }
+
+  if (!ParseCpuList(cpus, placement.cpus_)) {
+    DINGO_LOG(WARNING) << "invalid sdk_thread_cpus:" << cpus << ", sdk threads not pinned";
+    placement.cpus_.clear();
+  }
+  return placement;
+}
+
+void ThreadPlacement::PinCurrentThread() const {
+  if (!Enabled()) {
+    return;
+  }
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  if (FLAGS_sdk_thread_pin_per_core) {
+    CPU_SET(cpus_[next_cpu.fetch_add(1, std::memory_order_relaxed) % cpus_.size()], &cpuset);
+  } else {
+    for (int cpu : cpus_) {
+      CPU_SET(cpu, &cpuset);
+    }
+  }
+
+  int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+  if (ret != 0) {
+    DINGO_LOG(WARNING) << fmt::format("pin sdk thread fail, error:{}", ret);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
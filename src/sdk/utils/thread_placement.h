@@ -0,0 +1,50 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_THREAD_PLACEMENT_H_
+#define DINGODB_SDK_THREAD_PLACEMENT_H_
+
+#include <string>
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+
+// Cpu placement of sdk threads: actuator workers, timer and grpc cq workers.
+// Each thread pins itself when it starts, so memory it touches first, e.g. its
+// own queue blocks and thread locals, is allocated on the numa node of its cpus.
+class ThreadPlacement {
+ public:
+  // FLAGS_sdk_thread_cpus is a cpu list like "0-7,16", or "caller" for the cpus the calling thread may run on,
+  // so sdk threads share the cores of the application thread building the client, empty means no pin
+  static ThreadPlacement FromFlags();
+
+  bool Enabled() const { return !cpus_.empty(); }
+
+  // pin calling thread to the cpu set, or to one cpu of it round robin by all sdk threads when
+  // FLAGS_sdk_thread_pin_per_core is true, no-op when not enabled
+  void PinCurrentThread() const;
+
+  const std::vector<int>& Cpus() const { return cpus_; }
+
+  // return false when str is not a valid cpu list
+  static bool ParseCpuList(const std::string& str, std::vector<int>& out);
+
+ private:
+  std::vector<int> cpus_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_THREAD_PLACEMENT_H_
@@ -45,6 +45,10 @@ class ThreadPool {
 // with `num_threads` background threads.
 ThreadPool* NewThreadPool(int num_threads);
 
+// NewWorkStealingThreadPool() creates a ThreadPool whose `num_threads` workers
+// each own a task deque and steal from each other when idle.
+ThreadPool* NewWorkStealingThreadPool(int num_threads);
+
 }  // namespace sdk
 
 }  // namespace dingodb
@@ -14,21 +14,33 @@
 
 #include "sdk/utils/thread_pool_actuator.h"
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/request_priority.h"
 #include "sdk/utils/actuator.h"
+#include "sdk/utils/thread_placement.h"
 #include "sdk/utils/thread_pool.h"
 
 namespace dingodb {
 namespace sdk {
 using namespace std::chrono;
 
-Timer::Timer() : thread_(nullptr), running_(false){};
+Timer::Timer() : thread_(nullptr), running_(false) {
+  wheels_.resize(kLevelNum);
+  wheels_[0].resize(kRootSize);
+  for (int i = 1; i < kLevelNum; i++) {
+    wheels_[i].resize(kLevelSize);
+  }
+};
 
 Timer::~Timer() { Stop(); }
 
@@ -39,7 +51,13 @@ bool Timer::Start(Actuator* actuator) {
   }
 
   actuator_ = actuator;
-  thread_ = std::make_unique<std::thread>(&Timer::Run, this);
+  start_time_ = steady_clock::now();
+  current_tick_ = 0;
+  ThreadPlacement placement = ThreadPlacement::FromFlags();
+  thread_ = std::make_unique<std::thread>([this, placement] {
+    placement.PinCurrentThread();
+    Run();
+  });
   running_ = true;
 
   return true;
@@ -53,10 +71,13 @@ bool Timer::Stop() {
     }
 
     running_ = false;
-    while (!heap_.empty()) {
-      // TODO: add debug log
-      heap_.pop();
+    for (auto& wheel : wheels_) {
+      for (auto& slot : wheel) {
+        // TODO: add debug log
+        slot.clear();
+      }
     }
+    timer_count_ = 0;
 
     cv_.notify_all();
   }
@@ -68,35 +89,135 @@ bool Timer::Stop() {
   return true;
 }
 
+uint64_t Timer::NowTick() const { return duration_cast<milliseconds>(steady_clock::now() - start_time_).count(); }
+
 bool Timer::Add(std::function<void()> func, int delay_ms) {
   CHECK(running_);
-  auto now = steady_clock::now().time_since_epoch();
-  uint64_t next = duration_cast<microseconds>(now + milliseconds(delay_ms)).count();
-
-  FunctionInfo fn_info(std::move(func), next);
   std::lock_guard<std::mutex> lk(mutex_);
-  heap_.push(std::move(fn_info));
-  cv_.notify_all();
+  uint64_t now = NowTick();
+  if (timer_count_ == 0 && current_tick_ < now) {
+    // no pending timer, the wheel can jump to now without cascading
+    current_tick_ = now;
+  }
+
+  // now is rounded down, so one more tick keeps func from running before delay_ms passed
+  uint64_t expire = now + std::max(delay_ms, 0) + (delay_ms > 0 ? 1 : 0);
+  bool notify = timer_count_ == 0 || expire < wake_tick_;
+  AddUnlocked(FunctionInfo(std::move(func), expire, CurrentRequestPriority()));
+  if (notify) {
+    cv_.notify_all();
+  }
   return true;
 }
 
+void Timer::AddUnlocked(FunctionInfo fn_info) {
+  uint64_t expire = std::max(fn_info.expire_tick, current_tick_);
+  uint64_t delta = expire - current_tick_;
+
+  Slot* slot = nullptr;
+  if (delta < kRootSize) {
+    slot = &wheels_[0][expire & (kRootSize - 1)];
+  } else {
+    for (int level = 1; level < kLevelNum; level++) {
+      int shift = kRootBits + level * kLevelBits;
+      if (delta < (uint64_t{1} << shift) || level == kLevelNum - 1) {
+        uint64_t max_delta = (uint64_t{1} << shift) - 1;
+        if (delta > max_delta) {
+          // beyond the last level, park in the farthest slot and re-add on cascade
+          expire = current_tick_ + max_delta;
+        }
+        slot = &wheels_[level][(expire >> (shift - kLevelBits)) & (kLevelSize - 1)];
+        break;
+      }
+    }
+  }
+
+  slot->push_back(std::move(fn_info));
+  timer_count_++;
+}
+
+uint64_t Timer::Cascade(int level, uint64_t index) {
+  Slot slot;
+  slot.swap(wheels_[level][index]);
+  timer_count_ -= slot.size();
+  for (auto& fn_info : slot) {
+    AddUnlocked(std::move(fn_info));
+  }
+  return index;
+}
+
+void Timer::Tick(Slot& expired) {
+  uint64_t index = current_tick_ & (kRootSize - 1);
+  if (index == 0) {
+    for (int level = 1; level < kLevelNum; level++) {
+      int shift = kRootBits + (level - 1) * kLevelBits;
+      if (Cascade(level, (current_tick_ >> shift) & (kLevelSize - 1)) != 0) {
+        break;
+      }
+    }
+  }
+
+  auto& slot = wheels_[0][index];
+  timer_count_ -= slot.size();
+  for (auto& fn_info : slot) {
+    expired.push_back(std::move(fn_info));
+  }
+  slot.clear();
+  current_tick_++;
+}
+
+uint64_t Timer::NextWakeTickUnlocked() const {
+  // functions in root wheel expire within kRootSize ticks, each at the tick of its slot
+  uint64_t root_count = 0;
+  uint64_t next = UINT64_MAX;
+  for (uint64_t tick = current_tick_; tick < current_tick_ + kRootSize; tick++) {
+    const auto& slot = wheels_[0][tick & (kRootSize - 1)];
+    if (!slot.empty()) {
+      root_count += slot.size();
+      next = std::min(next, tick);
+    }
+  }
+
+  if (root_count < timer_count_) {
+    // outer wheels only move down when root wheel wraps
+    uint64_t boundary = (current_tick_ + kRootSize - 1) & ~(kRootSize - 1);
+    next = std::min(next, boundary);
+  }
+  return next;
+}
+
 void Timer::Run() {
+  Slot expired;
   std::unique_lock<std::mutex> lk(mutex_);
   while (running_) {
-    if (heap_.empty()) {
+    if (timer_count_ == 0) {
       cv_.wait(lk);
       continue;
     }
 
-    const auto& cur_fn = heap_.top();
-    uint64_t now = duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
-    if (cur_fn.next_run_time_us <= now) {
-      std::function<void()> fn = cur_fn.fn;
-      CHECK(actuator_->Execute(std::move(fn)));
-      heap_.pop();
-    } else {
-      cv_.wait_for(lk, microseconds(cur_fn.next_run_time_us - now));
+    uint64_t now = NowTick();
+    while (current_tick_ <= now && timer_count_ > 0) {
+      Tick(expired);
     }
+
+    if (!expired.empty()) {
+      lk.unlock();
+      for (auto& fn_info : expired) {
+        ScopedRequestPriority scope(fn_info.priority);
+        if (actuator_ == nullptr) {
+          fn_info.fn();
+        } else {
+          CHECK(actuator_->Execute(std::move(fn_info.fn)));
+        }
+      }
+      expired.clear();
+      lk.lock();
+      continue;
+    }
+
+    wake_tick_ = NextWakeTickUnlocked();
+    cv_.wait_until(lk, start_time_ + milliseconds(wake_tick_));
+    wake_tick_ = UINT64_MAX;
   }
 }
 
@@ -109,8 +230,15 @@ ThreadPoolActuator::~ThreadPoolActuator() {
 }
 
 bool ThreadPoolActuator::Start(int thread_num) {
-  pool_.reset(NewThreadPool(thread_num));
+  if (FLAGS_actuator_thread_pool_mode == "work_stealing") {
+    pool_.reset(NewWorkStealingThreadPool(thread_num));
+  } else {
+    LOG_IF(WARNING, FLAGS_actuator_thread_pool_mode != "fifo")
+        << "unknown actuator_thread_pool_mode: " << FLAGS_actuator_thread_pool_mode << ", use fifo";
+    pool_.reset(NewThreadPool(thread_num));
+  }
   pool_->Start();
+  low_limit_ = std::max<int64_t>(thread_num - FLAGS_actuator_interactive_reserved_threads, 1);
   timer_ = std::make_unique<Timer>();
   CHECK(timer_->Start(this));
   running_.store(true);
@@ -129,10 +257,64 @@ bool ThreadPoolActuator::Stop() {
 
 bool ThreadPoolActuator::Execute(std::function<void()> func) {
   CHECK(running_);
-  pool_->Execute(std::move(func));
+  RequestPriority priority = CurrentRequestPriority();
+  if (priority == kInteractive) {
+    pool_->Execute(std::move(func));
+    return true;
+  }
+
+  LowPriorityFunction next;
+  {
+    std::lock_guard<std::mutex> lk(low_mutex_);
+    low_queues_[priority].push_back(std::move(func));
+    if (low_running_ >= low_limit_) {
+      return true;
+    }
+    low_running_++;
+    CHECK(PopLowPriorityUnlocked(next));
+  }
+
+  pool_->Execute([this, next = std::move(next)]() mutable { RunLowPriority(std::move(next)); });
   return true;
 }
 
+bool ThreadPoolActuator::PopLowPriorityUnlocked(LowPriorityFunction& func) {
+  for (int i = kInteractive + 1; i < kRequestPriorityNum; i++) {
+    auto& queue = low_queues_[i];
+    if (!queue.empty()) {
+      func.fn = std::move(queue.front());
+      func.priority = static_cast<RequestPriority>(i);
+      queue.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPoolActuator::RunLowPriority(LowPriorityFunction func) {
+  while (true) {
+    {
+      ScopedRequestPriority scope(func.priority);
+      func.fn();
+    }
+
+    {
+      std::lock_guard<std::mutex> lk(low_mutex_);
+      if (!PopLowPriorityUnlocked(func)) {
+        low_running_--;
+        return;
+      }
+    }
+
+    if (running_.load()) {
+      // queue behind the interactive functions submitted meanwhile
+      pool_->Execute([this, func = std::move(func)]() mutable { RunLowPriority(std::move(func)); });
+      return;
+    }
+    // stopping, the pool is being joined, drain inline
+  }
+}
+
 bool ThreadPoolActuator::Schedule(std::function<void()> func, int delay_ms) {
   CHECK(running_);
   timer_->Add(std::move(func), delay_ms);
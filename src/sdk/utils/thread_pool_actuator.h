@@ -17,25 +17,33 @@
 #define DINGODB_SDK_THREAD_POOL_ACTUATOR_H_
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
+#include "sdk/request_priority.h"
 #include "sdk/utils/actuator.h"
 #include "sdk/utils/thread_pool.h"
 
 namespace dingodb {
 namespace sdk {
 
+// Hierarchical timer wheel driven by one thread with 1ms tick. Add() is O(1),
+// expired functions are dispatched to the actuator. Level 0 has 256 slots of
+// one tick, each upper level has 64 slots of the whole lower level span, and
+// a slot of an upper level is cascaded down when the lower level wraps.
 class Timer {
  public:
   Timer();
   ~Timer();
 
+  // expired functions run on actuator, or on the timer thread when actuator is nullptr, then they must not block
   bool Start(Actuator* actuator);
 
   bool Stop();
@@ -48,30 +56,60 @@ class Timer {
   }
 
  private:
-  void Run();
+  static constexpr int kRootBits = 8;
+  static constexpr int kLevelBits = 6;
+  static constexpr int kLevelNum = 5;
+  static constexpr uint64_t kRootSize = 1 << kRootBits;
+  static constexpr uint64_t kLevelSize = 1 << kLevelBits;
 
   struct FunctionInfo {
     std::function<void()> fn;
-    uint64_t next_run_time_us;
+    uint64_t expire_tick;
+    // priority of the thread adding the timer, fn is dispatched with it
+    RequestPriority priority;
 
-    explicit FunctionInfo(std::function<void()> p_fn, uint64_t p_next_run_time_us)
-        : fn(std::move(p_fn)), next_run_time_us(p_next_run_time_us) {}
+    explicit FunctionInfo(std::function<void()> p_fn, uint64_t p_expire_tick, RequestPriority p_priority)
+        : fn(std::move(p_fn)), expire_tick(p_expire_tick), priority(p_priority) {}
   };
 
-  struct RunTimeOrder {
-    bool operator()(const FunctionInfo& f1, const FunctionInfo& f2) {
-      return f1.next_run_time_us > f2.next_run_time_us;
-    }
-  };
+  using Slot = std::vector<FunctionInfo>;
+
+  void Run();
+
+  uint64_t NowTick() const;
+
+  // the caller must hold mutex_
+  void AddUnlocked(FunctionInfo fn_info);
+
+  // move the functions of slot `index` in `level` down to lower levels, return index
+  uint64_t Cascade(int level, uint64_t index);
+
+  // advance one tick, move the expired functions to `expired`
+  void Tick(Slot& expired);
+
+  // first tick from current_tick_ which has expired functions or cascades a pending outer wheel slot,
+  // the caller must hold mutex_ and timer_count_ > 0
+  uint64_t NextWakeTickUnlocked() const;
 
   Actuator* actuator_;
   std::mutex mutex_;
   std::condition_variable cv_;
   std::unique_ptr<std::thread> thread_;
-  std::priority_queue<FunctionInfo, std::vector<FunctionInfo>, RunTimeOrder> heap_;
+  std::chrono::steady_clock::time_point start_time_;
+  // next tick to process
+  uint64_t current_tick_{0};
+  uint64_t timer_count_{0};
+  // tick the timer thread sleeps until, an earlier timer added wakes it up
+  uint64_t wake_tick_{UINT64_MAX};
+  // wheels_[0] has kRootSize slots, others have kLevelSize slots
+  std::vector<std::vector<Slot>> wheels_;
   bool running_;
 };
 
+// Functions are run at the priority of the thread calling Execute or Schedule, see RequestPriority.
+// Interactive functions go to the pool directly. Batch and background functions wait in their own queues and at
+// most FLAGS_actuator_thread_num - FLAGS_actuator_interactive_reserved_threads of them are in the pool, so the
+// reserved threads are always there for interactive functions.
 class ThreadPoolActuator final : public Actuator {
  public:
   ThreadPoolActuator();
@@ -93,9 +131,26 @@ class ThreadPoolActuator final : public Actuator {
   static std::string InternalName() { return "ThreadPoolActuator"; }
 
  private:
+  struct LowPriorityFunction {
+    std::function<void()> fn;
+    RequestPriority priority;
+  };
+
+  // run one low priority function, then hand its pool slot to the next one
+  void RunLowPriority(LowPriorityFunction func);
+
+  // the caller must hold low_mutex_, return false when there is nothing queued
+  bool PopLowPriorityUnlocked(LowPriorityFunction& func);
+
   std::unique_ptr<Timer> timer_;
   std::unique_ptr<ThreadPool> pool_;
   std::atomic<bool> running_;
+
+  std::mutex low_mutex_;
+  // indexed by priority, the interactive queue is never used
+  std::deque<std::function<void()>> low_queues_[kRequestPriorityNum];
+  int64_t low_running_{0};
+  int64_t low_limit_{1};
 };
 
 }  // namespace sdk
@@ -19,6 +19,7 @@
 
 #include "glog/logging.h"
 #include "sdk/common/param_config.h"
+#include "sdk/utils/thread_placement.h"
 
 namespace dingodb {
 namespace sdk {
@@ -52,8 +53,12 @@ void ThreadPoolImpl::ThreadProc(size_t thread_id) {
 void ThreadPoolImpl::Start() {
   std::unique_lock<std::mutex> lg(mutex_);
   threads_.resize(thread_num_);
+  ThreadPlacement placement = ThreadPlacement::FromFlags();
   for (size_t i = 0; i < thread_num_; i++) {
-    threads_[i] = std::thread([this, i] { ThreadProc(i); });
+    threads_[i] = std::thread([this, i, placement] {
+      placement.PinCurrentThread();
+      ThreadProc(i);
+    });
   }
 }
 
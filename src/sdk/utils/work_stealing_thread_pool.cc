@@ -0,0 +1,209 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/utils/work_stealing_thread_pool.h"
+
+#include <mutex>
+#include <utility>
+
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/utils/thread_placement.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// rounds an idle worker retries stealing before park
+constexpr int kSpinRounds = 64;
+
+// pool and worker index of the current thread, used for local push
+thread_local const void* tls_pool = nullptr;
+thread_local size_t tls_thread_id = 0;
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(int thread_num) : thread_num_(thread_num) {
+  CHECK_GT(thread_num_, 0);
+  queues_.reserve(thread_num_);
+  for (int i = 0; i < thread_num_; i++) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() { JoinThreads(); }
+
+void WorkStealingThreadPool::Start() {
+  threads_.resize(thread_num_);
+  // deque blocks of a worker are mostly allocated by its own local pushes, so they are numa local once pinned
+  ThreadPlacement placement = ThreadPlacement::FromFlags();
+  for (size_t i = 0; i < thread_num_; i++) {
+    threads_[i] = std::thread([this, i, placement] {
+      placement.PinCurrentThread();
+      ThreadProc(i);
+    });
+  }
+}
+
+void WorkStealingThreadPool::JoinThreads() {
+  {
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    if (exit_.load()) {
+      return;
+    }
+    exit_.store(true);
+    park_cv_.notify_all();
+  }
+
+  for (auto& thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+int WorkStealingThreadPool::GetBackgroundThreads() { return thread_num_; }
+
+int WorkStealingThreadPool::GetQueueLen() const { return static_cast<int>(pending_.load(std::memory_order_relaxed)); }
+
+void WorkStealingThreadPool::Execute(const std::function<void()>& task) {
+  auto cp(task);
+  Push(std::move(cp));
+}
+
+void WorkStealingThreadPool::Execute(std::function<void()>&& task) { Push(std::move(task)); }
+
+void WorkStealingThreadPool::Push(std::function<void()>&& task) {
+  size_t index;
+  if (tls_pool == this) {
+    index = tls_thread_id;
+  } else {
+    index = next_queue_.fetch_add(1, std::memory_order_relaxed) % thread_num_;
+  }
+
+  // pairs with Park(): either the parking worker sees pending_ > 0, or we see idle_ > 0 and wake it up
+  pending_.fetch_add(1);
+  {
+    auto& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+
+  // a spinning worker will pick the task up, no need to wake a parked one
+  if (spinning_.load() == 0 && idle_.load() > 0) {
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    park_cv_.notify_one();
+  }
+}
+
+bool WorkStealingThreadPool::PopLocal(size_t thread_id, std::function<void()>& task) {
+  auto& queue = *queues_[thread_id];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingThreadPool::Steal(size_t thread_id, std::function<void()>& task) {
+  for (size_t i = 1; i < thread_num_; i++) {
+    auto& queue = *queues_[(thread_id + i) % thread_num_];
+    std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || queue.tasks.empty()) {
+      continue;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::TryTake(size_t thread_id, std::function<void()>& task) {
+  if (PopLocal(thread_id, task) || Steal(thread_id, task)) {
+    pending_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::Park() {
+  std::unique_lock<std::mutex> lock(park_mutex_);
+  idle_.fetch_add(1);
+  park_cv_.wait(lock, [this] { return exit_.load() || pending_.load() > 0; });
+  idle_.fetch_sub(1);
+}
+
+void WorkStealingThreadPool::ThreadProc(size_t thread_id) {
+  VLOG(kSdkVlogLevel) << "Thread " << thread_id << " started.";
+
+  tls_pool = this;
+  tls_thread_id = thread_id;
+
+  int spin = 0;
+  while (true) {
+    std::function<void()> task;
+    if (TryTake(thread_id, task)) {
+      if (spin > 0) {
+        spin = 0;
+        // pushers skipped waking while we spun, hand the remaining tasks to a parked worker
+        if (spinning_.fetch_sub(1) == 1 && pending_.load() > 0 && idle_.load() > 0) {
+          std::lock_guard<std::mutex> lock(park_mutex_);
+          park_cv_.notify_one();
+        }
+      }
+      (task)();
+      continue;
+    }
+
+    if (pending_.load() > 0) {
+      // a task is being pushed or its deque was busy (try_lock failed), retry
+      std::this_thread::yield();
+      continue;
+    }
+
+    if (exit_.load()) {
+      if (spin > 0) {
+        spinning_.fetch_sub(1);
+      }
+      break;
+    }
+
+    if (spin < kSpinRounds) {
+      if (spin == 0) {
+        spinning_.fetch_add(1);
+      }
+      spin++;
+      std::this_thread::yield();
+      continue;
+    }
+
+    spin = 0;
+    spinning_.fetch_sub(1);
+    Park();
+  }
+
+  tls_pool = nullptr;
+
+  VLOG(kSdkVlogLevel) << "Thread " << thread_id << " exit.";
+}
+
+ThreadPool* NewWorkStealingThreadPool(int num_threads) {
+  WorkStealingThreadPool* thread_pool = new WorkStealingThreadPool(num_threads);
+  return thread_pool;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,92 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_WORK_STEALING_THREAD_POOL_H_
+#define DINGODB_SDK_WORK_STEALING_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sdk/utils/thread_pool.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Each worker owns a deque. Tasks submitted from a worker thread are pushed
+// to the back of its own deque and popped LIFO, so callbacks that fan out more
+// work stay on the same (cache warm) thread. Tasks submitted from other threads
+// are spread round robin. An idle worker steals from the front of the other
+// deques, spins for a while and only then parks on the condition variable.
+class WorkStealingThreadPool : public ThreadPool {
+ public:
+  explicit WorkStealingThreadPool(int thread_num);
+
+  ~WorkStealingThreadPool() override;
+
+  void Start() override;
+
+  void JoinThreads() override;
+
+  int GetBackgroundThreads() override;
+
+  int GetQueueLen() const override;
+
+  void Execute(const std::function<void()>& task) override;
+
+  void Execute(std::function<void()>&& task) override;
+
+ private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void ThreadProc(size_t thread_id);
+
+  void Push(std::function<void()>&& task);
+
+  bool PopLocal(size_t thread_id, std::function<void()>& task);
+
+  bool Steal(size_t thread_id, std::function<void()>& task);
+
+  bool TryTake(size_t thread_id, std::function<void()>& task);
+
+  void Park();
+
+  const int thread_num_;
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::atomic<int64_t> pending_{0};
+  std::atomic<uint64_t> next_queue_{0};
+
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+  std::atomic<int> idle_{0};
+  std::atomic<int> spinning_{0};
+  std::atomic<bool> exit_{false};
+};
+
+}  // namespace sdk
+
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_WORK_STEALING_THREAD_POOL_H_
@@ -15,13 +15,21 @@
 #ifndef DINGODB_SDK_VECTOR_H_
 #define DINGODB_SDK_VECTOR_H_
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "sdk/cancel_token.h"
+#include "sdk/filter.h"
 #include "sdk/status.h"
 #include "sdk/types.h"
+#include "sdk/utils/callback.h"
 
 namespace dingodb {
 namespace sdk {
@@ -144,7 +152,7 @@ struct Vector {
   int32_t dimension;
   ValueType value_type;
   std::vector<float> float_values;
-  // TODO: support
+  // used when value_type is kUint8, one byte per dimension
   std::vector<uint8_t> binary_values;
 
   explicit Vector() : value_type(kNoneValueType), dimension(0) {}
@@ -198,6 +206,127 @@ struct VectorWithId {
   std::string ToString() const;
 };
 
+// Columnar scalar data of many vectors, e.g. QueryResult::scalar_batch of a columnar query. Keys are interned once
+// per batch and the values of a key are kept in one column instead of a map of ScalarValue per vector, numbers take
+// no heap memory and strings of a column share one buffer. Every column has a value per row, the value of a row
+// without the key is of type kTypeEnd.
+class ScalarBatch {
+ public:
+  int64_t Size() const { return rows_; }
+
+  bool Empty() const { return rows_ == 0; }
+
+  // key index of a key is its position in keys
+  const std::vector<std::string>& GetKeys() const { return keys_; }
+
+  // -1 when no row has the key
+  int32_t KeyIndex(const std::string& key) const;
+
+  // kTypeEnd when the row has no value of the key
+  Type GetType(int32_t key_index, int64_t row) const;
+
+  // 0 when the row has no value of the key
+  int32_t FieldCount(int32_t key_index, int64_t row) const;
+
+  // NOTE: field must be less than FieldCount and of the type asked
+  bool GetBool(int32_t key_index, int64_t row, int32_t field = 0) const;
+  int64_t GetLong(int32_t key_index, int64_t row, int32_t field = 0) const;
+  double GetDouble(int32_t key_index, int64_t row, int32_t field = 0) const;
+  // valid until the batch is changed
+  std::string_view GetString(int32_t key_index, int64_t row, int32_t field = 0) const;
+
+  // compatibility view, the same as VectorWithId::scalar_data of the row
+  std::map<std::string, ScalarValue> GetScalarData(int64_t row) const;
+
+  void Append(const std::map<std::string, ScalarValue>& scalar_data);
+
+  // append row of other
+  void AppendRow(const ScalarBatch& other, int64_t row);
+
+  // value of the row being appended and then its fields, FinishRow must follow the values of a row
+  void AppendValue(const std::string& key, Type type);
+  void AppendBoolField(bool value);
+  void AppendLongField(int64_t value);
+  void AppendDoubleField(double value);
+  void AppendStringField(std::string_view value);
+  void FinishRow();
+
+  void Clear();
+
+  std::string ToString() const;
+
+ private:
+  // string in the buffer of its column
+  struct StringRef {
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  union Field {
+    bool bool_data;
+    int64_t long_data;
+    double double_data;
+    StringRef string_data;
+  };
+
+  struct Cell {
+    Type type{kTypeEnd};
+    uint32_t field_start{0};
+    uint32_t field_count{0};
+  };
+
+  struct Column {
+    std::vector<Cell> cells;
+    std::vector<Field> fields;
+    std::string strings;
+  };
+
+  const Field& GetField(int32_t key_index, int64_t row, int32_t field) const;
+  void AppendField(Field field);
+
+  std::vector<std::string> keys_;
+  std::unordered_map<std::string, int32_t> key_indexes_;
+  std::vector<Column> columns_;
+  int64_t rows_{0};
+  // column of the value being appended
+  int32_t current_{-1};
+};
+
+// Client side uint8 scalar quantizer. Value x of dimension i is encoded as round((x - min[i]) / scale[i]) clamped
+// to [0, 255], where min and scale are trained from sample float vectors. Vectors added to and searched in the same
+// kUint8 index should be quantized by the same quantizer, persist Mins and Scales and Init with them to reuse one.
+class ScalarQuantizer {
+ public:
+  ScalarQuantizer() = default;
+
+  // samples must be non empty float vectors of the same dimension
+  Status Train(const std::vector<Vector>& samples);
+
+  // restore a trained quantizer, mins and scales must have the same size and scales must be positive
+  Status Init(std::vector<float> mins, std::vector<float> scales);
+
+  bool IsTrained() const { return !mins_.empty(); }
+
+  int32_t Dimension() const { return static_cast<int32_t>(mins_.size()); }
+
+  const std::vector<float>& Mins() const { return mins_; }
+
+  const std::vector<float>& Scales() const { return scales_; }
+
+  // from must be a float vector of Dimension, to is a kUint8 vector
+  Status Quantize(const Vector& from, Vector& to) const;
+
+  // quantize vectors in place, vectors already of kUint8 are left as is
+  Status Quantize(std::vector<VectorWithId>& vectors) const;
+
+  // from must be a kUint8 vector of Dimension, to is the reconstructed float vector
+  Status Dequantize(const Vector& from, Vector& to) const;
+
+ private:
+  std::vector<float> mins_;
+  std::vector<float> scales_;
+};
+
 enum FilterSource : uint8_t {
   kNoneFilterSource,
   // filter vector scalar include post filter and pre filter
@@ -213,7 +342,10 @@ enum FilterType : uint8_t {
   // first vector search, then filter
   kQueryPost,
   // first search from rocksdb, then search vector
-  kQueryPre
+  kQueryPre,
+  // kQueryPre or kQueryPost and recall_num are picked for each search by the selectivity of its filter estimated on
+  // the scalar sample of the index, see VectorClient::SampleScalarByIndexId
+  kQueryAuto
 };
 
 enum SearchExtraParamType : uint8_t { kParallelOnQueries, kNprobe, kRecallNum, kEfSearch };
@@ -234,6 +366,22 @@ struct SearchParam {
   bool use_brute_force{false};      // use brute-force search
   std::map<SearchExtraParamType, int32_t> extra_params;  // The search method to use
   std::string langchain_expr_json;                       // must json format, will convert to coprocessor
+  // pre-built filter, takes precedence over langchain_expr_json and is not parsed or encoded per search
+  std::shared_ptr<const Filter> filter;
+  // filter is evaluated on client against the results instead of on server, scalar data needed is fetched with
+  // the results and results of search cache are shared by filters on the same keys. May return less than topk.
+  bool post_filter{false};
+  // when > 0, nprobe or ef_search not in extra_params is picked from the recall profile of the index, see
+  // VectorClient::CalibrateRecallByIndexId
+  float target_recall{0.0f};
+  // if true, scalar data of SearchResult::vector_datas[i] is row i of SearchResult::scalar_batch instead of its
+  // scalar_data
+  bool columnar{false};
+  // best effort, a partition or region failing or not answered by the deadline of the cancel token does not fail
+  // the search, the merged topk of the rest is returned and the missing ones are listed in SearchResult. Payload is
+  // searched with the candidates instead of fetched in a second phase, partial results are not cached. Not supported
+  // by SearchResultView.
+  bool partial_result{false};
 
   explicit SearchParam() = default;
 
@@ -249,7 +397,12 @@ struct SearchParam {
         vector_ids(std::move(other.vector_ids)),
         use_brute_force(other.use_brute_force),
         extra_params(std::move(other.extra_params)),
-        langchain_expr_json(std::move(other.langchain_expr_json)) {
+        langchain_expr_json(std::move(other.langchain_expr_json)),
+        filter(std::move(other.filter)),
+        post_filter(other.post_filter),
+        target_recall(other.target_recall),
+        columnar(other.columnar),
+        partial_result(other.partial_result) {
     other.topk = 0;
     other.with_vector_data = true;
     other.with_scalar_data = false;
@@ -259,6 +412,9 @@ struct SearchParam {
     other.filter_source = kNoneFilterSource;
     other.filter_type = kNoneFilterType;
     other.use_brute_force = false;
+    other.post_filter = false;
+    other.columnar = false;
+    other.partial_result = false;
   }
 
   SearchParam& operator=(SearchParam&& other) noexcept {
@@ -274,6 +430,11 @@ struct SearchParam {
     use_brute_force = other.use_brute_force;
     extra_params = std::move(other.extra_params);
     langchain_expr_json = std::move(other.langchain_expr_json);
+    filter = std::move(other.filter);
+    post_filter = other.post_filter;
+    target_recall = other.target_recall;
+    columnar = other.columnar;
+    partial_result = other.partial_result;
 
     other.topk = 0;
     other.with_vector_data = true;
@@ -284,11 +445,35 @@ struct SearchParam {
     other.filter_source = kNoneFilterSource;
     other.filter_type = kNoneFilterType;
     other.use_brute_force = false;
+    other.post_filter = false;
+    other.columnar = false;
+    other.partial_result = false;
 
     return *this;
   }
 };
 
+struct RecallPoint {
+  // nprobe or ef_search
+  int32_t param{0};
+  float recall{0.0f};
+};
+
+// Recall of one index as a function of its search param, measured against ground truth. It can be saved by caller
+// and set back with VectorClient::SetRecallProfile, so calibration runs offline.
+struct RecallProfile {
+  // kNprobe for ivf index, kEfSearch for hnsw index
+  SearchExtraParamType param_type{kNprobe};
+  int32_t topk{0};
+  // ascending by param
+  std::vector<RecallPoint> points;
+
+  // the smallest param reaching target_recall, the largest param when none reaches it, 0 when no point
+  int32_t PickParam(float target_recall) const;
+
+  std::string ToString() const;
+};
+
 struct VectorWithDistance {
   VectorWithId vector_data;
   float distance;
@@ -309,16 +494,30 @@ struct SearchResult {
   // TODO : maybe remove VectorWithId
   VectorWithId id;
   std::vector<VectorWithDistance> vector_datas;
+  // scalar data of vector_datas when SearchParam::columnar
+  ScalarBatch scalar_batch;
+  // when SearchParam::partial_result, partitions and regions not answered, vector_datas come from the rest,
+  // same for all target vectors of a search and empty when results are complete
+  std::vector<int64_t> missing_part_ids;
+  std::vector<int64_t> missing_region_ids;
 
   SearchResult() = default;
 
   explicit SearchResult(VectorWithId p_id) : id(std::move(p_id)) {}
 
-  SearchResult(SearchResult&& other) noexcept : id(std::move(other.id)), vector_datas(std::move(other.vector_datas)) {}
+  SearchResult(SearchResult&& other) noexcept
+      : id(std::move(other.id)),
+        vector_datas(std::move(other.vector_datas)),
+        scalar_batch(std::move(other.scalar_batch)),
+        missing_part_ids(std::move(other.missing_part_ids)),
+        missing_region_ids(std::move(other.missing_region_ids)) {}
 
   SearchResult& operator=(SearchResult&& other) noexcept {
     id = std::move(other.id);
     vector_datas = std::move(other.vector_datas);
+    scalar_batch = std::move(other.scalar_batch);
+    missing_part_ids = std::move(other.missing_part_ids);
+    missing_region_ids = std::move(other.missing_region_ids);
     return *this;
   }
 
@@ -328,6 +527,94 @@ struct SearchResult {
   std::string ToString() const;
 };
 
+// Search results in structure of arrays, hits of target vector i are [offsets[i], offsets[i + 1]) of ids and
+// distances, in ascending order of distance. A hit takes 12 bytes when no payload is asked for, payloads are side
+// tables filled only when SearchParam::with_vector_data or with_scalar_data, and query vectors are not copied back.
+struct CompactSearchResult {
+  // target count + 1
+  std::vector<int64_t> offsets;
+  std::vector<int64_t> ids;
+  std::vector<float> distances;
+  // vectors[j] belongs to ids[j] when with_vector_data, empty otherwise
+  std::vector<Vector> vectors;
+  // row j belongs to ids[j] when with_scalar_data, empty otherwise
+  ScalarBatch scalar_batch;
+
+  int64_t TargetCount() const { return offsets.empty() ? 0 : static_cast<int64_t>(offsets.size()) - 1; }
+  int64_t HitCount(int64_t target) const { return offsets[target + 1] - offsets[target]; }
+
+  std::string ToString() const;
+};
+
+// Search results kept as the rpc responses, fields of a hit are converted only when accessed, so callers which only
+// need ids and distances convert and copy nothing. Hits of a target vector are in ascending order of distance.
+// NOTE: not thread safe
+class SearchResultView {
+ public:
+  SearchResultView();
+  ~SearchResultView();
+
+  SearchResultView(SearchResultView&& other) noexcept;
+  SearchResultView& operator=(SearchResultView&& other) noexcept;
+
+  SearchResultView(const SearchResultView&) = delete;
+  const SearchResultView& operator=(const SearchResultView&) = delete;
+
+  // the number of target vectors
+  int64_t TargetCount() const;
+
+  int64_t HitCount(int64_t target) const;
+
+  // NOTE: hit must be less than HitCount(target)
+  int64_t GetId(int64_t target, int64_t hit) const;
+
+  float GetDistance(int64_t target, int64_t hit) const;
+
+  // converted on every call
+  Vector GetVector(int64_t target, int64_t hit) const;
+
+  std::map<std::string, ScalarValue> GetScalarData(int64_t target, int64_t hit) const;
+
+  VectorWithDistance GetHit(int64_t target, int64_t hit) const;
+
+  // all hits converted, as the result of the search api with std::vector<SearchResult>, except that
+  // SearchResult::id is empty
+  std::vector<SearchResult> ToSearchResults() const;
+
+  // ids and distances of all hits, payloads converted only when asked for
+  CompactSearchResult ToCompactSearchResult(bool with_vector_data, bool with_scalar_data) const;
+
+ private:
+  friend class VectorSearchTask;
+
+  class Data;
+  std::unique_ptr<Data> data_;
+};
+
+// hit of a search across several indexes, see VectorClient::SearchByIndexIds
+struct IndexVectorWithDistance {
+  int64_t index_id{0};
+  VectorWithDistance vector_with_distance;
+};
+
+struct MultiIndexSearchResult {
+  VectorWithId id;
+  // topk of all indexes searched, ascending by distance
+  std::vector<IndexVectorWithDistance> vector_datas;
+};
+
+// hits of one region response, hits[i] belongs to target_vectors[i] of the range search, return false to stop the
+// search, see VectorClient::RangeSearchStreamByIndexId
+using RangeSearchHandler = std::function<bool(std::vector<std::vector<VectorWithDistance>>& hits)>;
+
+struct RangeSearchStreamOption {
+  // search stops once so many hits of all target vectors are delivered, 0 means no limit
+  int64_t max_results{0};
+  // hits of a target vector in one delivery are in ascending order of distance, otherwise in the order of the
+  // response. There is no order across deliveries either way.
+  bool sorted{false};
+};
+
 struct DeleteResult {
   int64_t vector_id;
   bool deleted;
@@ -335,6 +622,23 @@ struct DeleteResult {
   std::string ToString() const;
 };
 
+// see VectorClient::DeleteByFilterByIndexId
+struct DeleteByFilterOption {
+  // regions scanned and deleted at once, 0 means the default of the client
+  int64_t region_concurrency{0};
+  // vectors scanned from a region each round, 0 means the default of the client
+  int64_t page_size{0};
+};
+
+struct DeleteByFilterRegionResult {
+  int64_t region_id{0};
+  // vectors whose scalar data is evaluated
+  int64_t scanned_count{0};
+  int64_t deleted_count{0};
+
+  std::string ToString() const;
+};
+
 struct QueryParam {
   std::vector<int64_t> vector_ids;
   // If true, response with vector data
@@ -346,10 +650,14 @@ struct QueryParam {
   std::vector<std::string> selected_keys;
   // if true, response witho table data
   bool with_table_data{false};
+  // if true, scalar data is in QueryResult::scalar_batch instead of scalar_data of the vectors
+  bool columnar{false};
 };
 
 struct QueryResult {
   std::vector<VectorWithId> vectors;
+  // row i is the scalar data of vectors[i] when QueryParam::columnar
+  ScalarBatch scalar_batch;
 
   std::string ToString() const;
 };
@@ -374,6 +682,8 @@ struct ScanQueryParam {
 
   bool use_scalar_filter{false};
   std::map<std::string, ScalarValue> scalar_data;
+  // if true, scalar data is in ScanQueryResult::scalar_batch instead of scalar_data of the vectors
+  bool columnar{false};
 
   explicit ScanQueryParam() = default;
 
@@ -387,7 +697,8 @@ struct ScanQueryParam {
         selected_keys(std::move(other.selected_keys)),
         with_table_data(other.with_table_data),
         use_scalar_filter(other.use_scalar_filter),
-        scalar_data(std::move(other.scalar_data)) {}
+        scalar_data(std::move(other.scalar_data)),
+        columnar(other.columnar) {}
 
   ScanQueryParam& operator=(ScanQueryParam&& other) noexcept {
     if (this != &other) {
@@ -401,6 +712,7 @@ struct ScanQueryParam {
       with_table_data = other.with_table_data;
       use_scalar_filter = other.use_scalar_filter;
       scalar_data = std::move(other.scalar_data);
+      columnar = other.columnar;
     }
     return *this;
   }
@@ -408,6 +720,8 @@ struct ScanQueryParam {
 
 struct ScanQueryResult {
   std::vector<VectorWithId> vectors;
+  // row i is the scalar data of vectors[i] when ScanQueryParam::columnar
+  ScalarBatch scalar_batch;
 
   std::string ToString() const;
 };
@@ -459,6 +773,123 @@ class VectorIndexCreator {
   explicit VectorIndexCreator(Data* data);
 };
 
+// Bulk writer of one vector index. Add buffers vectors and writes them in chunks of about
+// FLAGS_vector_writer_chunk_bytes, each chunk is split by region and written while later vectors are still
+// being added. When FLAGS_vector_writer_max_inflight_bytes are in flight, Add blocks until some chunk is done.
+// Ids allocated for auto increment index are not reported back.
+// NOTE: not thread safe, one writer should be used by one thread
+class VectorWriter {
+ public:
+  VectorWriter(const VectorWriter&) = delete;
+  const VectorWriter& operator=(const VectorWriter&) = delete;
+
+  // flush and wait all in flight chunks
+  ~VectorWriter();
+
+  // return the first error of previous chunks if any, the vector is not added then
+  Status Add(VectorWithId vector);
+
+  Status Add(std::vector<VectorWithId> vectors);
+
+  // write all buffered vectors and wait until all chunks are done, return the first error since last Flush
+  Status Flush();
+
+ private:
+  friend class VectorClient;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit VectorWriter(Data* data);
+};
+
+// Write-behind buffer of updates and deletes of one index, coalesced by vector id: only the latest update of an id
+// is sent, and a delete drops the pending update of the id. Pending writes are sent in the background by the
+// Update or Delete call which finds the oldest one buffered longer than FLAGS_vector_update_buffer_window_ms, one
+// batch at a time, and ids of a batch are grouped per region.
+// Writes are acknowledged only by Flush returning OK. A write not flushed yet may be lost, e.g. the batch holding it
+// fails, and the first error of background batches is returned by later calls until Flush.
+// NOTE: thread safe
+class VectorUpdateBuffer {
+ public:
+  VectorUpdateBuffer(const VectorUpdateBuffer&) = delete;
+  const VectorUpdateBuffer& operator=(const VectorUpdateBuffer&) = delete;
+
+  // flush and wait the batch in flight
+  ~VectorUpdateBuffer();
+
+  // vector.id must be positive
+  Status Update(VectorWithId vector);
+
+  Status Delete(int64_t vector_id);
+
+  // send all pending writes and wait until they are done, return the first error since last Flush
+  Status Flush();
+
+  // number of vector ids with a pending write
+  int64_t PendingCount() const;
+
+ private:
+  friend class VectorClient;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit VectorUpdateBuffer(Data* data);
+};
+
+// Streams vectors of ScanQueryParam [vector_id_start, vector_id_end] in id order, partition by partition,
+// max_scan_count is the page size. The next page is prefetched while caller handles the current one, so at most
+// one page is buffered.
+// NOTE: not thread safe
+class VectorScanCursor {
+ public:
+  VectorScanCursor(const VectorScanCursor&) = delete;
+  const VectorScanCursor& operator=(const VectorScanCursor&) = delete;
+
+  // wait in flight prefetch
+  ~VectorScanCursor();
+
+  bool HasNext() const;
+
+  // out_vectors is cleared and filled with at most max_scan_count vectors, it is empty when scan is done
+  Status Next(std::vector<VectorWithId>& out_vectors);
+
+ private:
+  friend class VectorClient;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit VectorScanCursor(Data* data);
+};
+
+// Pages of the nearest vectors of one target vector in ascending order of distance, page_size hits per page.
+// Hits merged from all regions are kept by the cursor for FLAGS_vector_search_cursor_ttl_ms, pages within them take
+// no rpc. A page past them searches again with topk raised to at least twice the last one, so every region is asked
+// for more hits only as deep as paged to. Ids returned before are skipped, pages never repeat a vector.
+// NOTE: not thread safe
+class VectorSearchCursor {
+ public:
+  VectorSearchCursor(const VectorSearchCursor&) = delete;
+  const VectorSearchCursor& operator=(const VectorSearchCursor&) = delete;
+
+  ~VectorSearchCursor();
+
+  bool HasNext() const;
+
+  // out_page is cleared and filled with at most page_size hits, it is empty when no hit is left
+  Status Next(std::vector<VectorWithDistance>& out_page);
+
+ private:
+  friend class VectorClient;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit VectorSearchCursor(Data* data);
+};
+
 class VectorClient {
  public:
   VectorClient(const VectorClient&) = delete;
@@ -479,11 +910,52 @@ class VectorClient {
   Status SearchByIndexName(int64_t schema_id, const std::string& index_name, const SearchParam& search_param,
                            const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result);
 
+  // results are kept as responses and converted on access, see SearchResultView. post_filter is not supported,
+  // and search cache, two phase fetch and exact rerank are not used.
+  Status SearchByIndexId(int64_t index_id, const SearchParam& search_param,
+                         const std::vector<VectorWithId>& target_vectors, SearchResultView& out_view);
+
+  // as the SearchResultView one, converted to CompactSearchResult and the responses released when done
+  Status SearchByIndexId(int64_t index_id, const SearchParam& search_param,
+                         const std::vector<VectorWithId>& target_vectors, CompactSearchResult& out_result);
+
+  // Search all of index_ids concurrently with the same search param, out_result[i] is the topk of target_vectors[i]
+  // across the indexes, each hit tagged with its index. Distances of the indexes must be comparable, e.g. same
+  // metric type and dimension. columnar and partial_result are not supported.
+  Status SearchByIndexIds(const std::vector<int64_t>& index_ids, const SearchParam& search_param,
+                          const std::vector<VectorWithId>& target_vectors,
+                          std::vector<MultiIndexSearchResult>& out_result);
+
+  // Range search delivering hits to handler region by region as responses arrive, nothing is buffered or merged,
+  // so memory is bounded by the responses in flight. search_param.enable_range_search must be set, and columnar,
+  // post_filter and partial_result are not supported. handler is called from sdk threads one call at a time.
+  // Regions still in flight when the search stops are ignored, and the search succeeds.
+  Status RangeSearchStreamByIndexId(int64_t index_id, const SearchParam& search_param,
+                                    const std::vector<VectorWithId>& target_vectors,
+                                    const RangeSearchStreamOption& option, RangeSearchHandler handler);
+
   Status DeleteByIndexId(int64_t index_id, const std::vector<int64_t>& vector_ids,
                          std::vector<DeleteResult>& out_result);
   Status DeleteByIndexName(int64_t schema_id, const std::string& index_name, const std::vector<int64_t>& vector_ids,
                            std::vector<DeleteResult>& out_result);
 
+  // delete all vectors of [start_vector_id, end_vector_id), ids are scanned and deleted page by page without
+  // vector data, out_delete_count is the number of vectors deleted
+  Status DeleteByRangeByIndexId(int64_t index_id, int64_t start_vector_id, int64_t end_vector_id,
+                                int64_t& out_delete_count);
+  Status DeleteByRangeByIndexName(int64_t schema_id, const std::string& index_name, int64_t start_vector_id,
+                                  int64_t end_vector_id, int64_t& out_delete_count);
+
+  // delete all vectors whose scalar data matches langchain_expr_json. Regions are scanned page by page without vector
+  // data in parallel, the expr is evaluated on client and matched ids are deleted from the region they are scanned
+  // from, deletes are paced by the write rate limiter of the client. out_result has the counts of each region.
+  Status DeleteByFilterByIndexId(int64_t index_id, const std::string& langchain_expr_json,
+                                 const DeleteByFilterOption& option,
+                                 std::vector<DeleteByFilterRegionResult>& out_result);
+  Status DeleteByFilterByIndexName(int64_t schema_id, const std::string& index_name,
+                                   const std::string& langchain_expr_json, const DeleteByFilterOption& option,
+                                   std::vector<DeleteByFilterRegionResult>& out_result);
+
   Status BatchQueryByIndexId(int64_t index_id, const QueryParam& query_param, QueryResult& out_result);
   Status BatchQueryByIndexName(int64_t schema_id, const std::string& index_name, const QueryParam& query_param,
                                QueryResult& out_result);
@@ -498,6 +970,12 @@ class VectorClient {
   Status GetIndexMetricsByIndexId(int64_t index_id, IndexMetricsResult& out_result);
   Status GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name, IndexMetricsResult& out_result);
 
+  // for polling, metrics aggregated by this client at most max_staleness_ms ago may be returned without asking
+  // regions, concurrent calls of one index share one aggregation, 0 always asks regions
+  Status GetIndexMetricsByIndexId(int64_t index_id, int64_t max_staleness_ms, IndexMetricsResult& out_result);
+  Status GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name, int64_t max_staleness_ms,
+                                    IndexMetricsResult& out_result);
+
   Status CountAllByIndexId(int64_t index_id, int64_t& out_count);
   Status CountallByIndexName(int64_t schema_id, const std::string& index_name, int64_t& out_count);
 
@@ -505,6 +983,72 @@ class VectorClient {
   Status CountByIndexName(int64_t schema_id, const std::string& index_name, int64_t start_vector_id,
                           int64_t end_vector_id, int64_t& out_count);
 
+  // async api, same semantics with sync version, cb is invoked once when the operation is done, maybe in sdk
+  // internal thread, so cb should not block. cancel_token is optional, see CancelToken.
+  // NOTE: caller must keep all params valid until cb is invoked
+  void AsyncAddByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors, bool replace_deleted, bool is_update,
+                         StatusCallback cb, std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  void AsyncUpdateByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors, StatusCallback cb,
+                            std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  void AsyncSearchByIndexId(int64_t index_id, const SearchParam& search_param,
+                            const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result,
+                            StatusCallback cb, std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  void AsyncSearchByIndexId(int64_t index_id, const SearchParam& search_param,
+                            const std::vector<VectorWithId>& target_vectors, SearchResultView& out_view,
+                            StatusCallback cb, std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  void AsyncSearchByIndexIds(const std::vector<int64_t>& index_ids, const SearchParam& search_param,
+                             const std::vector<VectorWithId>& target_vectors,
+                             std::vector<MultiIndexSearchResult>& out_result, StatusCallback cb,
+                             std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  void AsyncRangeSearchStreamByIndexId(int64_t index_id, const SearchParam& search_param,
+                                       const std::vector<VectorWithId>& target_vectors,
+                                       const RangeSearchStreamOption& option, RangeSearchHandler handler,
+                                       StatusCallback cb, std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  void AsyncDeleteByIndexId(int64_t index_id, const std::vector<int64_t>& vector_ids,
+                            std::vector<DeleteResult>& out_result, StatusCallback cb,
+                            std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  void AsyncBatchQueryByIndexId(int64_t index_id, const QueryParam& query_param, QueryResult& out_result,
+                                StatusCallback cb, std::shared_ptr<CancelToken> cancel_token = nullptr);
+
+  // Search queries once per value of params and record the fraction of ground truth topk ids found, nprobe is
+  // calibrated for ivf index and ef_search for hnsw index. ground_truth[i] is the exact nearest ids of queries[i].
+  // The profile is also kept for the index, so later searches can use SearchParam::target_recall.
+  Status CalibrateRecallByIndexId(int64_t index_id, const std::vector<VectorWithId>& queries,
+                                  const std::vector<std::vector<int64_t>>& ground_truth, int32_t topk,
+                                  const std::vector<int32_t>& params, RecallProfile& out_profile);
+
+  // set a profile calibrated before, e.g. loaded from caller storage
+  void SetRecallProfile(int64_t index_id, RecallProfile profile);
+
+  // Scan about sample_count vectors with scalar data spread over the id range of the index and keep them for the
+  // index, searches with FilterType::kQueryAuto estimate selectivity of their filter on the sample.
+  Status SampleScalarByIndexId(int64_t index_id, int64_t sample_count);
+
+  // set a sample taken before, only scalar data of the vectors is used
+  void SetScalarSample(int64_t index_id, std::vector<VectorWithId> sample);
+
+  // NOTE:: Caller must delete *out_cursor when it is no longer needed.
+  Status NewVectorScanCursor(int64_t index_id, const ScanQueryParam& query_param, VectorScanCursor** out_cursor);
+
+  // search_param.topk is ignored, range search, post_filter, partial_result and columnar are not supported.
+  // NOTE:: Caller must delete *out_cursor when it is no longer needed.
+  Status NewVectorSearchCursor(int64_t index_id, const SearchParam& search_param, const VectorWithId& target_vector,
+                               int32_t page_size, VectorSearchCursor** out_cursor);
+
+  // NOTE:: Caller must delete *out_writer when it is no longer needed.
+  Status NewVectorWriter(int64_t index_id, VectorWriter** out_writer, bool replace_deleted = false,
+                         bool is_update = false);
+
+  // NOTE:: Caller must delete *out_buffer when it is no longer needed.
+  Status NewVectorUpdateBuffer(int64_t index_id, VectorUpdateBuffer** out_buffer);
+
  private:
   friend class Client;
 
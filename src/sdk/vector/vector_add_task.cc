@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 #include "glog/logging.h"
 #include "sdk/auto_increment_manager.h"
@@ -28,7 +29,22 @@
 namespace dingodb {
 namespace sdk {
 
+namespace {
+std::vector<int64_t> VectorIds(const std::vector<VectorWithId>& vectors) {
+  std::vector<int64_t> ids;
+  ids.reserve(vectors.size());
+  for (const auto& vector : vectors) {
+    ids.push_back(vector.id);
+  }
+  return ids;
+}
+}  // namespace
+
 Status VectorAddTask::Init() {
+  // searches in flight can not be cached
+  stub.GetVectorSearchCache()->InvalidateIndex(index_id_);
+  stub.GetVectorPayloadCache()->Invalidate(index_id_, VectorIds(vectors_));
+
   if (vectors_.empty()) {
     return Status::InvalidArgument("vectors is empty, no need add vector");
   }
@@ -72,6 +88,17 @@ Status VectorAddTask::Init() {
   return Status::OK();
 }
 
+void VectorAddTask::PostProcess() {
+  stub.GetVectorSearchCache()->InvalidateIndex(index_id_);
+
+  auto payload_cache = stub.GetVectorPayloadCache();
+  payload_cache->Invalidate(index_id_, VectorIds(vectors_));
+  if (GetStatus().ok()) {
+    // vectors just written are likely to be fetched soon
+    payload_cache->Put(index_id_, vectors_, payload_cache->IndexVersion(index_id_));
+  }
+}
+
 void VectorAddTask::DoAsync() {
   std::unordered_map<int64_t, int64_t> next_batch;
   {
@@ -85,60 +112,50 @@ void VectorAddTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<int64_t>> region_vectors_to_ids;
-
-  auto meta_cache = stub.GetMetaCache();
-
+  std::vector<int64_t> ids;
+  ids.reserve(next_batch.size());
   for (const auto& [id, idx] : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
+    ids.push_back(id);
+  }
 
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+  std::vector<vector_helper::RegionVectorIds> groups;
+  Status s = vector_helper::GroupVectorIdsByRegion(*stub.GetMetaCache(), *vector_index_, ids, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
+  controllers_.reserve(groups.size());
+  rpcs_.reserve(groups.size());
 
-  for (const auto& entry : region_vectors_to_ids) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
-    auto rpc = std::make_unique<VectorAddRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+    auto rpc = RpcPool<VectorAddRpc>::Acquire();
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
     rpc->MutableRequest()->set_is_update(is_update_);
     rpc->MutableRequest()->set_replace_deleted(replace_deleted_);
 
-    for (const auto& id : entry.second) {
-      int64_t idx = vector_id_to_idx_[id];
+    for (const auto& id : group.ids) {
+      int64_t idx = next_batch[id];
       FillVectorWithIdPB(rpc->MutableRequest()->add_vectors(), vectors_[idx]);
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
+    controllers_.back().SetWriteRateLimit(index_id_);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
+  DCHECK_EQ(rpcs_.size(), groups.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
+  sub_tasks_count_.store(rpcs_.size());
+  RecordFanOut(rpcs_.size());
 
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
+  for (auto i = 0; i < rpcs_.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -148,8 +165,8 @@ void VectorAddTask::DoAsync() {
 
 void VectorAddTask::VectorAddRpcCallback(const Status& status, VectorAddRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
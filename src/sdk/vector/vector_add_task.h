@@ -21,6 +21,7 @@
 
 #include "sdk/client_stub.h"
 #include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_pool.h"
 #include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/vector/vector_index.h"
 #include "sdk/vector/vector_task.h"
@@ -45,6 +46,8 @@ class VectorAddTask : public VectorTask {
  private:
   Status Init() override;
   void DoAsync() override;
+  // invalidate search cache of the index once write is done
+  void PostProcess() override;
 
   std::string Name() const override { return fmt::format("VectorAddTask-{}", index_id_); }
 
@@ -58,7 +61,7 @@ class VectorAddTask : public VectorTask {
   std::shared_ptr<VectorIndex> vector_index_;
 
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<VectorAddRpc>> rpcs_;
+  std::vector<RpcPool<VectorAddRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   std::unordered_map<int64_t, int64_t> vector_id_to_idx_;
@@ -27,6 +27,17 @@ Status VectorBatchQueryTask::Init() {
   DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
   DCHECK_NOTNULL(tmp);
   vector_index_ = std::move(tmp);
+  payload_cache_version_ = stub.GetVectorPayloadCache()->IndexVersion(index_id_);
+
+  auto* request = request_template_.Mutable();
+  request->set_without_vector_data(!query_param_.with_vector_data);
+  request->set_without_scalar_data(!query_param_.with_scalar_data);
+  request->set_without_table_data(!query_param_.with_table_data);
+  if (query_param_.with_scalar_data) {
+    for (const auto &select : query_param_.selected_keys) {
+      request->add_selected_keys(select);
+    }
+  }
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   for (long id : query_param_.vector_ids) {
@@ -38,6 +49,12 @@ Status VectorBatchQueryTask::Init() {
   return Status::OK();
 }
 
+void VectorBatchQueryTask::PostProcess() {
+  if (GetStatus().ok() && query_param_.with_vector_data) {
+    stub.GetVectorPayloadCache()->Put(index_id_, out_result_.vectors, payload_cache_version_);
+  }
+}
+
 void VectorBatchQueryTask::DoAsync() {
   std::set<int64_t> next_batch;
   {
@@ -51,67 +68,42 @@ void VectorBatchQueryTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<int64_t>> region_id_to_vector_ids;
-
-  auto meta_cache = stub.GetMetaCache();
-
-  for (const auto &id : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_id_to_vector_ids[tmp->RegionId()].push_back(id);
+  std::vector<int64_t> ids(next_batch.begin(), next_batch.end());
+  std::vector<vector_helper::RegionVectorIds> groups;
+  Status s = vector_helper::GroupVectorIdsByRegion(*stub.GetMetaCache(), *vector_index_, ids, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
 
-  for (const auto &entry : region_id_to_vector_ids) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto &group : groups) {
+    const auto &region = group.region;
 
     auto rpc = std::make_unique<VectorBatchQueryRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-    // TODO: extract fuction
-    rpc->MutableRequest()->set_without_vector_data(!query_param_.with_vector_data);
-    rpc->MutableRequest()->set_without_scalar_data(!query_param_.with_scalar_data);
-    rpc->MutableRequest()->set_without_table_data(!query_param_.with_table_data);
-
-    if (query_param_.with_scalar_data) {
-      for (const auto &select : query_param_.selected_keys) {
-        rpc->MutableRequest()->add_selected_keys(select);
-      }
-    }
+    request_template_.FillRequest(rpc->MutableRequest(), region);
 
-    for (const auto &id : entry.second) {
+    rpc->MutableRequest()->mutable_vector_ids()->Reserve(group.ids.size());
+    for (const auto &id : group.ids) {
       rpc->MutableRequest()->add_vector_ids(id);
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  DCHECK_EQ(rpcs_.size(), region_id_to_vector_ids.size());
+  DCHECK_EQ(rpcs_.size(), groups.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_id_to_vector_ids.size());
+  size_t rpc_num = rpcs_.size();
+  sub_tasks_count_.store(rpc_num);
+  RecordFanOut(rpc_num);
 
-  for (auto i = 0; i < region_id_to_vector_ids.size(); i++) {
+  // the last callback may finish and free this task before AsyncCall returns, so the loop keeps its bound local
+  for (size_t i = 0; i < rpc_num; i++) {
     auto &controller = controllers_[i];
 
     controller.AsyncCall(
@@ -124,8 +116,8 @@ void VectorBatchQueryTask::VectorBatchQueryRpcCallback(const Status &status, Vec
                       << " response: " << rpc->Response()->DebugString();
 
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -140,7 +132,12 @@ void VectorBatchQueryTask::VectorBatchQueryRpcCallback(const Status &status, Vec
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     for (const auto &vectorid_pb : rpc->Response()->vectors()) {
-      if (vectorid_pb.id() > 0) {
+      if (vectorid_pb.id() <= 0) {
+        continue;
+      }
+      if (query_param_.columnar) {
+        out_result_.vectors.emplace_back(InternalVectorIdPB2VectorWithId(vectorid_pb, out_result_.scalar_batch));
+      } else {
         out_result_.vectors.emplace_back(InternalVectorIdPB2VectorWithId(vectorid_pb));
       }
     }
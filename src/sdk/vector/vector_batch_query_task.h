@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_request_template.h"
 #include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/status.h"
 #include "sdk/vector.h"
@@ -36,6 +37,7 @@ class VectorBatchQueryTask : public VectorTask {
  private:
   Status Init() override;
   void DoAsync() override;
+  void PostProcess() override;
 
   std::string Name() const override { return fmt::format("VectorBatchQueryTask-{}", index_id_); }
 
@@ -46,6 +48,8 @@ class VectorBatchQueryTask : public VectorTask {
   QueryResult& out_result_;
 
   std::shared_ptr<VectorIndex> vector_index_;
+  // payload options shared by all region rpcs
+  RequestTemplate<pb::index::VectorBatchQueryRequest> request_template_;
 
   std::vector<StoreRpcController> controllers_;
   std::vector<std::unique_ptr<VectorBatchQueryRpc>> rpcs_;
@@ -55,6 +59,9 @@ class VectorBatchQueryTask : public VectorTask {
   Status status_;
 
   std::atomic<int> sub_tasks_count_{0};
+
+  // version of payload cache taken before query
+  uint64_t payload_cache_version_{0};
 };
 
 }  // namespace sdk
@@ -12,27 +12,56 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
 #include "sdk/status.h"
+#include "sdk/utils/scoped_cleanup.h"
 #include "sdk/vector.h"
 #include "sdk/vector/vector_add_task.h"
 #include "sdk/vector/vector_batch_query_task.h"
 #include "sdk/vector/vector_count_task.h"
+#include "sdk/vector/vector_delete_by_filter_task.h"
 #include "sdk/vector/vector_delete_task.h"
 #include "sdk/vector/vector_get_border_task.h"
 #include "sdk/vector/vector_get_index_metrics_task.h"
 #include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_multi_search_task.h"
+#include "sdk/vector/vector_range_search_task.h"
+#include "sdk/vector/vector_scan_cursor_internal_data.h"
 #include "sdk/vector/vector_scan_query_task.h"
+#include "sdk/vector/vector_search_cursor_internal_data.h"
 #include "sdk/vector/vector_search_task.h"
+#include "sdk/vector/vector_update_buffer_internal_data.h"
 #include "sdk/vector/vector_update_task.h"
+#include "sdk/vector/vector_writer_internal_data.h"
 
 namespace dingodb {
 namespace sdk {
 
 VectorClient::VectorClient(const ClientStub &stub) : stub_(stub) {}
 
+// task is owned by callback, delete it after user cb is invoked
+template <class T>
+static void AsyncRunVectorTask(T *task, StatusCallback cb, std::shared_ptr<CancelToken> cancel_token) {
+  CHECK(cb) << "cb is invalid";
+  task->SetCancelToken(std::move(cancel_token));
+  task->AsyncRun([task, cb = std::move(cb)](Status status) {
+    SCOPED_CLEANUP({ delete task; });
+    cb(std::move(status));
+  });
+}
+
 Status VectorClient::AddByIndexId(int64_t index_id, std::vector<VectorWithId> &vectors, bool replace_deleted,
                                   bool is_update) {
   VectorAddTask task(stub_, index_id, vectors, replace_deleted, is_update);
@@ -71,6 +100,35 @@ Status VectorClient::SearchByIndexId(int64_t index_id, const SearchParam &search
   return task.Run();
 }
 
+Status VectorClient::SearchByIndexId(int64_t index_id, const SearchParam &search_param,
+                                     const std::vector<VectorWithId> &target_vectors, SearchResultView &out_view) {
+  VectorSearchTask task(stub_, index_id, search_param, target_vectors, out_view);
+  return task.Run();
+}
+
+Status VectorClient::SearchByIndexId(int64_t index_id, const SearchParam &search_param,
+                                     const std::vector<VectorWithId> &target_vectors,
+                                     CompactSearchResult &out_result) {
+  SearchResultView view;
+  DINGO_RETURN_NOT_OK(SearchByIndexId(index_id, search_param, target_vectors, view));
+  out_result = view.ToCompactSearchResult(search_param.with_vector_data, search_param.with_scalar_data);
+  return Status::OK();
+}
+
+Status VectorClient::SearchByIndexIds(const std::vector<int64_t> &index_ids, const SearchParam &search_param,
+                                      const std::vector<VectorWithId> &target_vectors,
+                                      std::vector<MultiIndexSearchResult> &out_result) {
+  VectorMultiSearchTask task(stub_, index_ids, search_param, target_vectors, out_result);
+  return task.Run();
+}
+
+Status VectorClient::RangeSearchStreamByIndexId(int64_t index_id, const SearchParam &search_param,
+                                                const std::vector<VectorWithId> &target_vectors,
+                                                const RangeSearchStreamOption &option, RangeSearchHandler handler) {
+  VectorRangeSearchTask task(stub_, index_id, search_param, target_vectors, option, std::move(handler));
+  return task.Run();
+}
+
 Status VectorClient::SearchByIndexName(int64_t schema_id, const std::string &index_name,
                                        const SearchParam &search_param, const std::vector<VectorWithId> &target_vectors,
                                        std::vector<SearchResult> &out_result) {
@@ -98,6 +156,77 @@ Status VectorClient::DeleteByIndexName(int64_t schema_id, const std::string &ind
   return task.Run();
 }
 
+Status VectorClient::DeleteByRangeByIndexId(int64_t index_id, int64_t start_vector_id, int64_t end_vector_id,
+                                            int64_t &out_delete_count) {
+  out_delete_count = 0;
+  if (start_vector_id <= 0 || start_vector_id >= end_vector_id) {
+    return Status::InvalidArgument("start_vector_id must be positive and less than end_vector_id");
+  }
+
+  // scan range is [start, end], id equal to end_vector_id is skipped
+  ScanQueryParam query_param;
+  query_param.vector_id_start = start_vector_id;
+  query_param.vector_id_end = end_vector_id;
+  query_param.max_scan_count = FLAGS_vector_delete_range_page_size;
+  query_param.with_vector_data = false;
+
+  VectorScanCursor *tmp = nullptr;
+  DINGO_RETURN_NOT_OK(NewVectorScanCursor(index_id, query_param, &tmp));
+  std::unique_ptr<VectorScanCursor> cursor(tmp);
+
+  std::vector<VectorWithId> vectors;
+  std::vector<int64_t> vector_ids;
+  while (cursor->HasNext()) {
+    DINGO_RETURN_NOT_OK(cursor->Next(vectors));
+
+    vector_ids.clear();
+    for (const auto &vector : vectors) {
+      if (vector.id < end_vector_id) {
+        vector_ids.push_back(vector.id);
+      }
+    }
+    if (vector_ids.empty()) {
+      continue;
+    }
+
+    std::vector<DeleteResult> delete_result;
+    VectorDeleteTask task(stub_, index_id, vector_ids, delete_result);
+    DINGO_RETURN_NOT_OK(task.Run());
+    out_delete_count += std::count_if(delete_result.begin(), delete_result.end(),
+                                      [](const DeleteResult &result) { return result.deleted; });
+  }
+
+  return Status::OK();
+}
+
+Status VectorClient::DeleteByRangeByIndexName(int64_t schema_id, const std::string &index_name,
+                                              int64_t start_vector_id, int64_t end_vector_id,
+                                              int64_t &out_delete_count) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  return DeleteByRangeByIndexId(index_id, start_vector_id, end_vector_id, out_delete_count);
+}
+
+Status VectorClient::DeleteByFilterByIndexId(int64_t index_id, const std::string &langchain_expr_json,
+                                             const DeleteByFilterOption &option,
+                                             std::vector<DeleteByFilterRegionResult> &out_result) {
+  VectorDeleteByFilterTask task(stub_, index_id, langchain_expr_json, option, out_result);
+  return task.Run();
+}
+
+Status VectorClient::DeleteByFilterByIndexName(int64_t schema_id, const std::string &index_name,
+                                               const std::string &langchain_expr_json,
+                                               const DeleteByFilterOption &option,
+                                               std::vector<DeleteByFilterRegionResult> &out_result) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  return DeleteByFilterByIndexId(index_id, langchain_expr_json, option, out_result);
+}
+
 Status VectorClient::BatchQueryByIndexId(int64_t index_id, const QueryParam &query_param, QueryResult &out_result) {
   VectorBatchQueryTask task(stub_, index_id, query_param, out_result);
   return task.Run();
@@ -145,18 +274,32 @@ Status VectorClient::ScanQueryByIndexName(int64_t schema_id, const std::string &
 }
 
 Status VectorClient::GetIndexMetricsByIndexId(int64_t index_id, IndexMetricsResult &out_result) {
-  VectorGetIndexMetricsTask task(stub_, index_id, out_result);
-  return task.Run();
+  return GetIndexMetricsByIndexId(index_id, 0, out_result);
 }
 
 Status VectorClient::GetIndexMetricsByIndexName(int64_t schema_id, const std::string &index_name,
                                                 IndexMetricsResult &out_result) {
+  return GetIndexMetricsByIndexName(schema_id, index_name, 0, out_result);
+}
+
+Status VectorClient::GetIndexMetricsByIndexId(int64_t index_id, int64_t max_staleness_ms,
+                                              IndexMetricsResult &out_result) {
+  return stub_.GetVectorIndexMetricsCache()->Get(
+      index_id, max_staleness_ms,
+      [this, index_id](IndexMetricsResult &result) {
+        VectorGetIndexMetricsTask task(stub_, index_id, result);
+        return task.Run();
+      },
+      out_result);
+}
+
+Status VectorClient::GetIndexMetricsByIndexName(int64_t schema_id, const std::string &index_name,
+                                                int64_t max_staleness_ms, IndexMetricsResult &out_result) {
   int64_t index_id{0};
   DINGO_RETURN_NOT_OK(
       stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
-  VectorGetIndexMetricsTask task(stub_, index_id, out_result);
-  return task.Run();
+  return GetIndexMetricsByIndexId(index_id, max_staleness_ms, out_result);
 }
 
 Status VectorClient::CountAllByIndexId(int64_t index_id, int64_t &out_count) {
@@ -191,6 +334,216 @@ Status VectorClient::CountByIndexName(int64_t schema_id, const std::string &inde
   return task.Run();
 }
 
+void VectorClient::AsyncAddByIndexId(int64_t index_id, std::vector<VectorWithId> &vectors, bool replace_deleted,
+                                     bool is_update, StatusCallback cb, std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(new VectorAddTask(stub_, index_id, vectors, replace_deleted, is_update), std::move(cb),
+                     std::move(cancel_token));
+}
+
+void VectorClient::AsyncUpdateByIndexId(int64_t index_id, std::vector<VectorWithId> &vectors, StatusCallback cb,
+                                        std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(new VectorUpdateTask(stub_, index_id, vectors), std::move(cb), std::move(cancel_token));
+}
+
+void VectorClient::AsyncSearchByIndexId(int64_t index_id, const SearchParam &search_param,
+                                        const std::vector<VectorWithId> &target_vectors,
+                                        std::vector<SearchResult> &out_result, StatusCallback cb,
+                                        std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(new VectorSearchTask(stub_, index_id, search_param, target_vectors, out_result), std::move(cb),
+                     std::move(cancel_token));
+}
+
+void VectorClient::AsyncSearchByIndexId(int64_t index_id, const SearchParam &search_param,
+                                        const std::vector<VectorWithId> &target_vectors, SearchResultView &out_view,
+                                        StatusCallback cb, std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(new VectorSearchTask(stub_, index_id, search_param, target_vectors, out_view), std::move(cb),
+                     std::move(cancel_token));
+}
+
+void VectorClient::AsyncSearchByIndexIds(const std::vector<int64_t> &index_ids, const SearchParam &search_param,
+                                         const std::vector<VectorWithId> &target_vectors,
+                                         std::vector<MultiIndexSearchResult> &out_result, StatusCallback cb,
+                                         std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(new VectorMultiSearchTask(stub_, index_ids, search_param, target_vectors, out_result),
+                     std::move(cb), std::move(cancel_token));
+}
+
+void VectorClient::AsyncRangeSearchStreamByIndexId(int64_t index_id, const SearchParam &search_param,
+                                                   const std::vector<VectorWithId> &target_vectors,
+                                                   const RangeSearchStreamOption &option, RangeSearchHandler handler,
+                                                   StatusCallback cb, std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(
+      new VectorRangeSearchTask(stub_, index_id, search_param, target_vectors, option, std::move(handler)),
+      std::move(cb), std::move(cancel_token));
+}
+
+void VectorClient::AsyncDeleteByIndexId(int64_t index_id, const std::vector<int64_t> &vector_ids,
+                                        std::vector<DeleteResult> &out_result, StatusCallback cb,
+                                        std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(new VectorDeleteTask(stub_, index_id, vector_ids, out_result), std::move(cb),
+                     std::move(cancel_token));
+}
+
+void VectorClient::AsyncBatchQueryByIndexId(int64_t index_id, const QueryParam &query_param, QueryResult &out_result,
+                                            StatusCallback cb, std::shared_ptr<CancelToken> cancel_token) {
+  AsyncRunVectorTask(new VectorBatchQueryTask(stub_, index_id, query_param, out_result), std::move(cb),
+                     std::move(cancel_token));
+}
+
+Status VectorClient::CalibrateRecallByIndexId(int64_t index_id, const std::vector<VectorWithId> &queries,
+                                              const std::vector<std::vector<int64_t>> &ground_truth, int32_t topk,
+                                              const std::vector<int32_t> &params, RecallProfile &out_profile) {
+  if (queries.empty() || queries.size() != ground_truth.size()) {
+    return Status::InvalidArgument(fmt::format("queries size:{} and ground_truth size:{} should be same and not 0",
+                                               queries.size(), ground_truth.size()));
+  }
+  if (topk <= 0 || params.empty()) {
+    return Status::InvalidArgument(fmt::format("invalid topk:{} or params size:{}", topk, params.size()));
+  }
+
+  std::shared_ptr<VectorIndex> vector_index;
+  DINGO_RETURN_NOT_OK(stub_.GetVectorIndexCache()->GetVectorIndexById(index_id, vector_index));
+
+  RecallProfile profile;
+  switch (vector_index->GetVectorIndexType()) {
+    case VectorIndexType::kIvfFlat:
+    case VectorIndexType::kIvfPq:
+      profile.param_type = SearchExtraParamType::kNprobe;
+      break;
+    case VectorIndexType::kHnsw:
+      profile.param_type = SearchExtraParamType::kEfSearch;
+      break;
+    default:
+      return Status::NotSupported(fmt::format("index type:{} has no recall param",
+                                              VectorIndexTypeToString(vector_index->GetVectorIndexType())));
+  }
+  profile.topk = topk;
+
+  std::vector<std::unordered_set<int64_t>> truth_ids(ground_truth.size());
+  int64_t truth_count = 0;
+  for (size_t i = 0; i < ground_truth.size(); i++) {
+    size_t count = std::min<size_t>(topk, ground_truth[i].size());
+    truth_ids[i].insert(ground_truth[i].begin(), ground_truth[i].begin() + count);
+    truth_count += truth_ids[i].size();
+  }
+  if (truth_count == 0) {
+    return Status::InvalidArgument("ground_truth is empty");
+  }
+
+  std::vector<int32_t> sorted_params(params);
+  std::sort(sorted_params.begin(), sorted_params.end());
+  sorted_params.erase(std::unique(sorted_params.begin(), sorted_params.end()), sorted_params.end());
+
+  for (int32_t param : sorted_params) {
+    SearchParam search_param;
+    search_param.topk = topk;
+    search_param.with_vector_data = false;
+    search_param.extra_params[profile.param_type] = param;
+
+    std::vector<SearchResult> results;
+    DINGO_RETURN_NOT_OK(SearchByIndexId(index_id, search_param, queries, results));
+    CHECK_EQ(results.size(), queries.size()) << "unexpected search result size";
+
+    int64_t hit_count = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+      for (const auto &distance : results[i].vector_datas) {
+        hit_count += truth_ids[i].count(distance.vector_data.id);
+      }
+    }
+
+    RecallPoint point;
+    point.param = param;
+    point.recall = static_cast<float>(hit_count) / truth_count;
+    profile.points.push_back(point);
+  }
+
+  DINGO_LOG(INFO) << "index_id:" << index_id << " calibrated " << profile.ToString();
+  stub_.GetVectorIndexCache()->SetRecallProfile(index_id, profile);
+  out_profile = std::move(profile);
+  return Status::OK();
+}
+
+void VectorClient::SetRecallProfile(int64_t index_id, RecallProfile profile) {
+  std::sort(profile.points.begin(), profile.points.end(),
+            [](const RecallPoint &a, const RecallPoint &b) { return a.param < b.param; });
+  stub_.GetVectorIndexCache()->SetRecallProfile(index_id, std::move(profile));
+}
+
+Status VectorClient::SampleScalarByIndexId(int64_t index_id, int64_t sample_count) {
+  if (sample_count <= 0) {
+    return Status::InvalidArgument(fmt::format("invalid sample_count:{}", sample_count));
+  }
+
+  int64_t min_id = 0;
+  int64_t max_id = 0;
+  DINGO_RETURN_NOT_OK(GetBorderByIndexId(index_id, false, min_id));
+  DINGO_RETURN_NOT_OK(GetBorderByIndexId(index_id, true, max_id));
+
+  std::vector<VectorWithId> sample;
+  if (min_id > 0 && max_id >= min_id) {
+    // scan the head of evenly spaced id slices, so sample is not all from the oldest vectors
+    const int64_t kMaxSlices = 16;
+    int64_t slices = std::min(kMaxSlices, sample_count);
+    int64_t step = (max_id - min_id) / slices + 1;
+    for (int64_t start = min_id; start <= max_id && static_cast<int64_t>(sample.size()) < sample_count;
+         start += step) {
+      ScanQueryParam query_param;
+      query_param.vector_id_start = start;
+      query_param.vector_id_end = std::min(start + step - 1, max_id);
+      query_param.max_scan_count =
+          std::min((sample_count + slices - 1) / slices, sample_count - static_cast<int64_t>(sample.size()));
+      query_param.with_vector_data = false;
+      query_param.with_scalar_data = true;
+
+      ScanQueryResult result;
+      DINGO_RETURN_NOT_OK(ScanQueryByIndexId(index_id, query_param, result));
+      std::move(result.vectors.begin(), result.vectors.end(), std::back_inserter(sample));
+    }
+  }
+
+  DINGO_LOG(INFO) << "index_id:" << index_id << " sampled " << sample.size() << " vectors in id range [" << min_id
+                  << ", " << max_id << "]";
+  SetScalarSample(index_id, std::move(sample));
+  return Status::OK();
+}
+
+void VectorClient::SetScalarSample(int64_t index_id, std::vector<VectorWithId> sample) {
+  for (auto& vector_with_id : sample) {
+    // only scalar data is evaluated by filters
+    vector_with_id.vector = Vector();
+  }
+  stub_.GetVectorIndexCache()->SetScalarSample(
+      index_id, std::make_shared<const std::vector<VectorWithId>>(std::move(sample)));
+}
+
+Status VectorClient::NewVectorScanCursor(int64_t index_id, const ScanQueryParam &query_param,
+                                         VectorScanCursor **out_cursor) {
+  auto data = std::make_unique<VectorScanCursor::Data>(stub_, index_id);
+  DINGO_RETURN_NOT_OK(data->Init(query_param));
+  *out_cursor = new VectorScanCursor(data.release());
+  return Status::OK();
+}
+
+Status VectorClient::NewVectorSearchCursor(int64_t index_id, const SearchParam &search_param,
+                                           const VectorWithId &target_vector, int32_t page_size,
+                                           VectorSearchCursor **out_cursor) {
+  auto data = std::make_unique<VectorSearchCursor::Data>(stub_, index_id, page_size);
+  DINGO_RETURN_NOT_OK(data->Init(search_param, target_vector));
+  *out_cursor = new VectorSearchCursor(data.release());
+  return Status::OK();
+}
+
+Status VectorClient::NewVectorWriter(int64_t index_id, VectorWriter **out_writer, bool replace_deleted,
+                                     bool is_update) {
+  *out_writer = new VectorWriter(new VectorWriter::Data(stub_, index_id, replace_deleted, is_update));
+  return Status::OK();
+}
+
+Status VectorClient::NewVectorUpdateBuffer(int64_t index_id, VectorUpdateBuffer **out_buffer) {
+  *out_buffer = new VectorUpdateBuffer(new VectorUpdateBuffer::Data(stub_, index_id));
+  return Status::OK();
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -15,7 +15,11 @@
 #ifndef DINGODB_SDK_VECTOR_CODEC_H_
 #define DINGODB_SDK_VECTOR_CODEC_H_
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "glog/logging.h"
 #include "common/logging.h"
@@ -72,6 +76,36 @@ static int64_t DecodeVectorId(const std::string &value) {
   return DingoSchema<std::optional<int64_t>>::InternalDecodeKey(&buf);
 }
 
+// keys of (partition_ids[i], vector_ids[i]) written back to back into out_keys,
+// kVectorKeyMaxLenWithPrefix bytes each, same bytes with EncodeVectorKey
+static void EncodeVectorKeys(char prefix, const std::vector<int64_t> &partition_ids,
+                             const std::vector<int64_t> &vector_ids, std::string &out_keys) {
+  CHECK(prefix != 0) << "Encode vector keys failed, prefix is 0";
+  CHECK_EQ(partition_ids.size(), vector_ids.size());
+
+  out_keys.resize(vector_ids.size() * kVectorKeyMaxLenWithPrefix);
+  char *out = out_keys.data();
+  for (size_t i = 0; i < vector_ids.size(); ++i) {
+    out[0] = prefix;
+    codec::EncodeInt64(partition_ids[i], out + 1);
+    codec::EncodeComparableInt64(vector_ids[i], out + 9);
+    out += kVectorKeyMaxLenWithPrefix;
+  }
+}
+
+// vector ids of keys written back to back by EncodeVectorKeys
+static void DecodeVectorIds(std::string_view keys, std::vector<int64_t> &out_vector_ids) {
+  CHECK_EQ(keys.size() % kVectorKeyMaxLenWithPrefix, 0) << "Decode vector ids failed, size:" << keys.size();
+
+  size_t num = keys.size() / kVectorKeyMaxLenWithPrefix;
+  out_vector_ids.resize(num);
+  const char *in = keys.data();
+  for (size_t i = 0; i < num; ++i) {
+    out_vector_ids[i] = codec::DecodeComparableInt64(in + 9);
+    in += kVectorKeyMaxLenWithPrefix;
+  }
+}
+
 static int64_t DecodePartitionId(const std::string &value) {
   Buf buf(value);
 
@@ -16,6 +16,7 @@
 #define DINGODB_SDK_VECTOR_COMMON_H_
 
 #include <cstdint>
+#include <vector>
 
 #include "glog/logging.h"
 #include "proto/common.pb.h"
@@ -179,6 +180,17 @@ static pb::common::ValueType ValueType2InternalValueTypePB(ValueType value_type)
   }
 }
 
+static ValueType InternalValueTypePB2ValueType(pb::common::ValueType value_type) {
+  switch (value_type) {
+    case pb::common::ValueType::FLOAT:
+      return ValueType::kFloat;
+    case pb::common::ValueType::UINT8:
+      return ValueType::kUint8;
+    default:
+      CHECK(false) << "unsupported value type:" << pb::common::ValueType_Name(value_type);
+  }
+}
+
 static pb::common::ScalarValue ScalarValue2InternalScalarValuePB(const sdk::ScalarValue& scalar_value) {
   pb::common::ScalarValue result;
   result.set_field_type(Type2InternalScalarFieldTypePB(scalar_value.type));
@@ -210,6 +222,7 @@ static sdk::ScalarValue InternalScalarValuePB2ScalarValue(const pb::common::Scal
   sdk::ScalarValue result;
   result.type = InternalScalarFieldTypePB2Type(pb.field_type());
 
+  result.fields.reserve(pb.fields_size());
   for (const auto& field : pb.fields()) {
     ScalarField value;
     switch (result.type) {
@@ -228,12 +241,39 @@ static sdk::ScalarValue InternalScalarValuePB2ScalarValue(const pb::common::Scal
       default:
         CHECK(false) << "unsupported scalar value type:" << result.type;
     }
-    result.fields.push_back(value);
+    result.fields.push_back(std::move(value));
   }
 
   return result;
 }
 
+// scalar data of one vector as a row of batch, no ScalarValue is built
+static void AppendInternalScalarDataPB2Batch(const pb::common::VectorScalardata& pb, ScalarBatch& batch) {
+  for (const auto& [key, value] : pb.scalar_data()) {
+    Type type = InternalScalarFieldTypePB2Type(value.field_type());
+    batch.AppendValue(key, type);
+    for (const auto& field : value.fields()) {
+      switch (type) {
+        case kBOOL:
+          batch.AppendBoolField(field.bool_data());
+          break;
+        case kINT64:
+          batch.AppendLongField(field.long_data());
+          break;
+        case kDOUBLE:
+          batch.AppendDoubleField(field.double_data());
+          break;
+        case kSTRING:
+          batch.AppendStringField(field.string_data());
+          break;
+        default:
+          CHECK(false) << "unsupported scalar value type:" << type;
+      }
+    }
+  }
+  batch.FinishRow();
+}
+
 static void FillScalarSchemaItem(pb::common::ScalarSchemaItem* pb, const VectorScalarColumnSchema& schema) {
   pb->set_key(schema.key);
   pb->set_field_type(Type2InternalScalarFieldTypePB(schema.type));
@@ -254,9 +294,15 @@ static void FillVectorWithIdPB(pb::common::VectorWithId* pb, const VectorWithId&
   const auto& vector = vector_with_id.vector;
   vector_pb->set_dimension(vector.dimension);
   vector_pb->set_value_type(ValueType2InternalValueTypePB(vector.value_type));
-  // TODO: support uint
-  for (const auto& float_value : vector.float_values) {
-    vector_pb->add_float_values(float_value);
+  if (vector.value_type == ValueType::kUint8) {
+    // packed into one bytes value
+    vector_pb->add_binary_values(reinterpret_cast<const char*>(vector.binary_values.data()),
+                                 vector.binary_values.size());
+  } else {
+    vector_pb->mutable_float_values()->Reserve(vector.float_values.size());
+    for (const auto& float_value : vector.float_values) {
+      vector_pb->add_float_values(float_value);
+    }
   }
 
   auto* scalar_data = pb->mutable_scalar_data();
@@ -265,25 +311,43 @@ static void FillVectorWithIdPB(pb::common::VectorWithId* pb, const VectorWithId&
   }
 }
 
-static VectorWithId InternalVectorIdPB2VectorWithId(const pb::common::VectorWithId& pb) {
+static VectorWithId InternalVectorIdPB2VectorWithIdWithoutScalar(const pb::common::VectorWithId& pb) {
   VectorWithId to_return;
   to_return.id = pb.id();
 
   const auto& vector_pb = pb.vector();
   to_return.vector.dimension = vector_pb.dimension();
-  to_return.vector.value_type = ValueType::kFloat;
-  // TODO: support uint
-  for (const auto& float_value : vector_pb.float_values()) {
-    to_return.vector.float_values.push_back(float_value);
+  to_return.vector.value_type = InternalValueTypePB2ValueType(vector_pb.value_type());
+  if (to_return.vector.value_type == ValueType::kUint8) {
+    for (const auto& binary_value : vector_pb.binary_values()) {
+      to_return.vector.binary_values.insert(to_return.vector.binary_values.end(), binary_value.begin(),
+                                            binary_value.end());
+    }
+  } else {
+    to_return.vector.float_values.reserve(vector_pb.float_values_size());
+    for (const auto& float_value : vector_pb.float_values()) {
+      to_return.vector.float_values.push_back(float_value);
+    }
   }
 
+  return to_return;
+}
+
+static VectorWithId InternalVectorIdPB2VectorWithId(const pb::common::VectorWithId& pb) {
+  VectorWithId to_return = InternalVectorIdPB2VectorWithIdWithoutScalar(pb);
   for (const auto& [key, value] : pb.scalar_data().scalar_data()) {
-    to_return.scalar_data.insert({key, InternalScalarValuePB2ScalarValue(value)});
+    to_return.scalar_data.emplace(key, InternalScalarValuePB2ScalarValue(value));
   }
 
   return to_return;
 }
 
+// scalar data is appended to scalar_batch as a row instead
+static VectorWithId InternalVectorIdPB2VectorWithId(const pb::common::VectorWithId& pb, ScalarBatch& scalar_batch) {
+  AppendInternalScalarDataPB2Batch(pb.scalar_data(), scalar_batch);
+  return InternalVectorIdPB2VectorWithIdWithoutScalar(pb);
+}
+
 static VectorWithDistance InternalVectorWithDistance2VectorWithDistance(const pb::common::VectorWithDistance& pb) {
   VectorWithDistance to_return;
   to_return.vector_data = InternalVectorIdPB2VectorWithId(pb.vector_with_id());
@@ -292,6 +356,41 @@ static VectorWithDistance InternalVectorWithDistance2VectorWithDistance(const pb
   return std::move(to_return);
 }
 
+// hits[i] of target vector i in ascending order of distance
+static CompactSearchResult InternalHitsPB2CompactSearchResult(
+    const std::vector<std::vector<const pb::common::VectorWithDistance*>>& hits, bool with_vector_data,
+    bool with_scalar_data) {
+  CompactSearchResult result;
+  size_t hit_count = 0;
+  for (const auto& target_hits : hits) {
+    hit_count += target_hits.size();
+  }
+
+  result.offsets.reserve(hits.size() + 1);
+  result.ids.reserve(hit_count);
+  result.distances.reserve(hit_count);
+  if (with_vector_data) {
+    result.vectors.reserve(hit_count);
+  }
+
+  result.offsets.push_back(0);
+  for (const auto& target_hits : hits) {
+    for (const auto* hit : target_hits) {
+      result.ids.push_back(hit->vector_with_id().id());
+      result.distances.push_back(hit->distance());
+      if (with_vector_data) {
+        result.vectors.push_back(InternalVectorIdPB2VectorWithIdWithoutScalar(hit->vector_with_id()).vector);
+      }
+      if (with_scalar_data) {
+        AppendInternalScalarDataPB2Batch(hit->vector_with_id().scalar_data(), result.scalar_batch);
+      }
+    }
+    result.offsets.push_back(static_cast<int64_t>(result.ids.size()));
+  }
+
+  return result;
+}
+
 static IndexMetricsResult InternalVectorIndexMetrics2IndexMetricsResult(const pb::common::VectorIndexMetrics& pb) {
   IndexMetricsResult to_return;
   to_return.index_type = InternalVectorIndexTypePB2VectorIndexType(pb.vector_index_type());
@@ -402,6 +501,9 @@ static void FillInternalSearchParams(pb::common::VectorSearchParameter* internal
     case FilterType::kQueryPost:
       internal_parameter->set_vector_filter_type(pb::common::VectorFilterType::QUERY_POST);
       break;
+    case FilterType::kQueryAuto:
+      // picked per search by VectorSearchTask
+      break;
     default:
       CHECK(false) << "not support filter type: " << static_cast<int>(parameter.filter_type);
       break;
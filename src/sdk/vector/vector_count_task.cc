@@ -14,11 +14,13 @@
 
 #include "sdk/vector/vector_count_task.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "common/logging.h"
 #include "glog/logging.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
 #include "sdk/vector/vector_codec.h"
@@ -38,8 +40,17 @@ Status VectorCountTask::Init() {
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   auto part_ids = vector_index_->GetPartitionIds();
-  for (const auto &part_id : part_ids) {
-    next_part_ids_.emplace(part_id);
+  // partitions are in order of start vector id, the end of one is the start of next, out of range ones need not count
+  for (size_t i = 0; i < part_ids.size(); i++) {
+    int64_t part_start_vector_id =
+        vector_codec::DecodeVectorId(vector_index_->GetPartitionRange(part_ids[i]).start_key());
+    int64_t part_end_vector_id =
+        i + 1 < part_ids.size()
+            ? vector_codec::DecodeVectorId(vector_index_->GetPartitionRange(part_ids[i + 1]).start_key())
+            : INT64_MAX;
+    if (std::max(part_start_vector_id, start_vector_id_) < std::min(part_end_vector_id, end_vector_id_)) {
+      next_part_ids_.emplace(part_ids[i]);
+    }
   }
 
   return Status::OK();
@@ -54,11 +65,14 @@ void VectorCountTask::DoAsync() {
   }
 
   if (next_part_ids.empty()) {
+    // no partition in range, or all counted before retry
+    out_count_ = tmp_count_.load();
     DoAsyncDone(Status::OK());
     return;
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto &part_id : next_part_ids) {
     auto *sub_task = new VectorCountPartTask(stub, vector_index_, part_id, start_vector_id_, end_vector_id_);
@@ -111,10 +125,8 @@ static void DecodeRangeToVectorId(const pb::common::Range &range, int64_t &begin
 }
 
 void VectorCountPartTask::DoAsync() {
-  const auto &range = vector_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> partition_regions;
-  Status s =
-      stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), partition_regions);
+  Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, partition_regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -147,8 +159,7 @@ void VectorCountPartTask::DoAsync() {
       rpc->MutableRequest()->set_vector_id_start(start);
       rpc->MutableRequest()->set_vector_id_end(end);
 
-      StoreRpcController controller(stub, *rpc, region);
-      controllers_.push_back(controller);
+      controllers_.emplace_back(stub, *rpc, region);
 
       rpcs_.push_back(std::move(rpc));
       regions.push_back(region);
@@ -171,20 +182,33 @@ void VectorCountPartTask::DoAsync() {
     DoAsyncDone(Status::OK());
   } else {
     sub_tasks_count_.store(regions.size());
-
-    for (auto i = 0; i < regions.size(); i++) {
-      auto &controller = controllers_[i];
-
-      controller.AsyncCall(
-          [this, rpc = rpcs_[i].get()](auto &&s) { VectorCountRpcCallback(std::forward<decltype(s)>(s), rpc); });
+    RecordFanOut(regions.size());
+    next_rpc_idx_.store(0);
+
+    // at most FLAGS_vector_region_rpc_concurrency rpcs in flight, each finished rpc sends the next one
+    size_t window = FLAGS_vector_region_rpc_concurrency > 0
+                        ? std::min<size_t>(FLAGS_vector_region_rpc_concurrency, regions.size())
+                        : regions.size();
+    for (size_t i = 0; i < window; i++) {
+      SendNextRpc();
     }
   }
 }
 
+void VectorCountPartTask::SendNextRpc() {
+  size_t idx = next_rpc_idx_.fetch_add(1);
+  if (idx >= rpcs_.size()) {
+    return;
+  }
+
+  controllers_[idx].AsyncCall(
+      [this, rpc = rpcs_[idx].get()](auto &&s) { VectorCountRpcCallback(std::forward<decltype(s)>(s), rpc); });
+}
+
 void VectorCountPartTask::VectorCountRpcCallback(Status status, VectorCountRpc *rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -195,6 +219,8 @@ void VectorCountPartTask::VectorCountRpcCallback(Status status, VectorCountRpc *
     ret_count_.fetch_add(rpc->Response()->count());
   }
 
+  SendNextRpc();
+
   if (sub_tasks_count_.fetch_sub(1) == 1) {
     Status tmp;
     {
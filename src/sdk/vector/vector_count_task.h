@@ -91,6 +91,9 @@ class VectorCountPartTask : public VectorTask {
 
   void VectorCountRpcCallback(Status status, VectorCountRpc* rpc);
 
+  // send rpc of next_rpc_idx_ if any left
+  void SendNextRpc();
+
   const std::shared_ptr<VectorIndex> vector_index_;
   const int64_t part_id_;
   const int64_t start_vector_id_;
@@ -104,6 +107,7 @@ class VectorCountPartTask : public VectorTask {
 
   std::atomic<int64_t> ret_count_{0};
   std::atomic<int> sub_tasks_count_{0};
+  std::atomic<size_t> next_rpc_idx_{0};
 };
 }  // namespace sdk
 
@@ -0,0 +1,242 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_delete_by_filter_task.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "glog/logging.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/vector/vector_codec.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_helper.h"
+
+namespace dingodb {
+namespace sdk {
+
+Status VectorDeleteByFilterTask::Init() {
+  if (langchain_expr_json_.empty()) {
+    return Status::InvalidArgument("langchain_expr_json must not be empty");
+  }
+
+  page_size_ = option_.page_size > 0 ? option_.page_size : FLAGS_vector_delete_range_page_size;
+  if (page_size_ <= 0) {
+    return Status::InvalidArgument("page_size must be greater than 0");
+  }
+
+  expression::LangchainExprFactory factory;
+  DINGO_RETURN_NOT_OK(factory.CreateExpr(langchain_expr_json_, expr_));
+
+  // searches in flight can not be cached
+  stub.GetVectorSearchCache()->InvalidateIndex(index_id_);
+
+  std::shared_ptr<VectorIndex> tmp;
+  DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
+  DCHECK_NOTNULL(tmp);
+  vector_index_ = std::move(tmp);
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  region_results_.clear();
+  done_region_ids_.clear();
+
+  return Status::OK();
+}
+
+void VectorDeleteByFilterTask::PostProcess() { stub.GetVectorSearchCache()->InvalidateIndex(index_id_); }
+
+void VectorDeleteByFilterTask::DoAsync() {
+  std::vector<std::shared_ptr<Region>> regions;
+  for (const auto& part_id : vector_index_->GetPartitionIds()) {
+    std::vector<std::shared_ptr<Region>> part_regions;
+    Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id, part_regions);
+    if (!s.ok()) {
+      DoAsyncDone(s);
+      return;
+    }
+    regions.insert(regions.end(), part_regions.begin(), part_regions.end());
+  }
+
+  scans_.clear();
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    status_ = Status::OK();
+
+    for (const auto& region : regions) {
+      if (done_region_ids_.find(region->RegionId()) != done_region_ids_.end()) {
+        continue;
+      }
+
+      auto scan = std::make_unique<RegionScan>();
+      scan->region = region;
+      // 0 when region starts at its partition
+      scan->next_vector_id = vector_codec::DecodeVectorId(region->Range().start_key());
+      scans_.push_back(std::move(scan));
+    }
+  }
+
+  if (scans_.empty()) {
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      ConstructResultUnlocked();
+    }
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  sub_tasks_count_.store(scans_.size());
+  RecordFanOut(scans_.size());
+  next_scan_idx_.store(0);
+
+  int64_t region_concurrency =
+      option_.region_concurrency > 0 ? option_.region_concurrency : FLAGS_vector_region_rpc_concurrency;
+  size_t window = region_concurrency > 0 ? std::min<size_t>(region_concurrency, scans_.size()) : scans_.size();
+  for (size_t i = 0; i < window; i++) {
+    StartNextRegion();
+  }
+}
+
+void VectorDeleteByFilterTask::StartNextRegion() {
+  size_t idx = next_scan_idx_.fetch_add(1);
+  if (idx >= scans_.size()) {
+    return;
+  }
+
+  SendScanRpc(scans_[idx].get());
+}
+
+void VectorDeleteByFilterTask::SendScanRpc(RegionScan* scan) {
+  // controller of the previous page may be the one calling back, it allows to be destroyed there
+  scan->scan_rpc = std::make_unique<VectorScanQueryRpc>();
+  auto* request = scan->scan_rpc->MutableRequest();
+  FillRpcContext(*request->mutable_context(), scan->region->RegionId(), scan->region->Epoch());
+  request->set_vector_id_start(scan->next_vector_id);
+  request->set_is_reverse_scan(false);
+  request->set_max_scan_count(page_size_);
+  // scan to the end of the region
+  request->set_vector_id_end(0);
+  request->set_without_vector_data(true);
+  request->set_without_scalar_data(false);
+  request->set_without_table_data(true);
+
+  scan->scan_controller = std::make_unique<StoreRpcController>(stub, *scan->scan_rpc, scan->region);
+  scan->scan_controller->AsyncCall([this, scan](auto&& s) { ScanRpcCallback(std::forward<decltype(s)>(s), scan); });
+}
+
+void VectorDeleteByFilterTask::ScanRpcCallback(const Status& status, RegionScan* scan) {
+  if (!status.ok()) {
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << scan->scan_rpc->Method() << " send to region: "
+                                    << scan->region->RegionId() << " fail: " << status.ToString();
+    RegionDone(status, scan);
+    return;
+  }
+
+  std::vector<VectorWithId> vectors;
+  vectors.reserve(scan->scan_rpc->Response()->vectors_size());
+  for (const auto& vector_with_id_pb : scan->scan_rpc->Response()->vectors()) {
+    vectors.push_back(InternalVectorIdPB2VectorWithId(vector_with_id_pb));
+    scan->next_vector_id = std::max(scan->next_vector_id, vectors.back().id + 1);
+  }
+  scan->scanned_count += vectors.size();
+  scan->last_page = static_cast<int64_t>(vectors.size()) < page_size_;
+
+  std::vector<int64_t> vector_ids;
+  vector_helper::MatchVectorIds(vectors, expr_.get(), vector_ids);
+  if (!vector_ids.empty()) {
+    SendDeleteRpc(scan, vector_ids);
+  } else if (scan->last_page) {
+    RegionDone(Status::OK(), scan);
+  } else {
+    SendScanRpc(scan);
+  }
+}
+
+void VectorDeleteByFilterTask::SendDeleteRpc(RegionScan* scan, const std::vector<int64_t>& vector_ids) {
+  stub.GetVectorPayloadCache()->Invalidate(index_id_, vector_ids);
+
+  scan->delete_rpc = std::make_unique<VectorDeleteRpc>();
+  auto* request = scan->delete_rpc->MutableRequest();
+  FillRpcContext(*request->mutable_context(), scan->region->RegionId(), scan->region->Epoch());
+  for (const auto& id : vector_ids) {
+    request->add_ids(id);
+  }
+
+  scan->delete_controller = std::make_unique<StoreRpcController>(stub, *scan->delete_rpc, scan->region);
+  scan->delete_controller->SetWriteRateLimit(index_id_);
+  scan->delete_controller->AsyncCall([this, scan](auto&& s) { DeleteRpcCallback(std::forward<decltype(s)>(s), scan); });
+}
+
+void VectorDeleteByFilterTask::DeleteRpcCallback(const Status& status, RegionScan* scan) {
+  if (!status.ok()) {
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << scan->delete_rpc->Method() << " send to region: "
+                                    << scan->region->RegionId() << " fail: " << status.ToString();
+    RegionDone(status, scan);
+    return;
+  }
+
+  const auto* request = scan->delete_rpc->Request();
+  const auto* response = scan->delete_rpc->Response();
+  CHECK_EQ(request->ids_size(), response->key_states_size());
+  std::vector<int64_t> vector_ids(request->ids().begin(), request->ids().end());
+  scan->deleted_count += std::count(response->key_states().begin(), response->key_states().end(), true);
+  stub.GetVectorPayloadCache()->Invalidate(index_id_, vector_ids);
+
+  if (scan->last_page) {
+    RegionDone(Status::OK(), scan);
+  } else {
+    SendScanRpc(scan);
+  }
+}
+
+void VectorDeleteByFilterTask::RegionDone(const Status& status, RegionScan* scan) {
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    int64_t region_id = scan->region->RegionId();
+    auto& result = region_results_[region_id];
+    result.region_id = region_id;
+    result.scanned_count += scan->scanned_count;
+    result.deleted_count += scan->deleted_count;
+
+    if (status.ok()) {
+      done_region_ids_.insert(region_id);
+    } else if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  }
+
+  StartNextRegion();
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+      ConstructResultUnlocked();
+    }
+    DoAsyncDone(tmp);
+  }
+}
+
+void VectorDeleteByFilterTask::ConstructResultUnlocked() {
+  out_result_.clear();
+  for (const auto& [region_id, result] : region_results_) {
+    out_result_.push_back(result);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,112 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_DELETE_BY_FILTER_TASK_H_
+#define DINGODB_SDK_VECTOR_DELETE_BY_FILTER_TASK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Each region runs its own loop: scan a page without vector data, match the scalar data of the page against the
+// expr, delete the matched ids from the region, then scan the next page. At most region_concurrency regions run at
+// once, each finished region starts the next one. A retry runs the regions not finished from their start again,
+// vectors deleted before are not scanned again.
+class VectorDeleteByFilterTask : public VectorTask {
+ public:
+  VectorDeleteByFilterTask(const ClientStub& stub, int64_t index_id, const std::string& langchain_expr_json,
+                           const DeleteByFilterOption& option, std::vector<DeleteByFilterRegionResult>& out_result)
+      : VectorTask(stub),
+        index_id_(index_id),
+        langchain_expr_json_(langchain_expr_json),
+        option_(option),
+        out_result_(out_result) {}
+
+  ~VectorDeleteByFilterTask() override = default;
+
+ private:
+  struct RegionScan {
+    std::shared_ptr<Region> region;
+    // first id of the next page
+    int64_t next_vector_id{0};
+    // no page after the one being deleted
+    bool last_page{false};
+    int64_t scanned_count{0};
+    int64_t deleted_count{0};
+
+    std::unique_ptr<VectorScanQueryRpc> scan_rpc;
+    std::unique_ptr<StoreRpcController> scan_controller;
+    std::unique_ptr<VectorDeleteRpc> delete_rpc;
+    std::unique_ptr<StoreRpcController> delete_controller;
+  };
+
+  Status Init() override;
+  void DoAsync() override;
+  // invalidate search cache of the index once write is done
+  void PostProcess() override;
+
+  std::string Name() const override { return fmt::format("VectorDeleteByFilterTask-{}", index_id_); }
+
+  // start region of next_scan_idx_ if any left
+  void StartNextRegion();
+
+  void SendScanRpc(RegionScan* scan);
+  void ScanRpcCallback(const Status& status, RegionScan* scan);
+
+  void SendDeleteRpc(RegionScan* scan, const std::vector<int64_t>& vector_ids);
+  void DeleteRpcCallback(const Status& status, RegionScan* scan);
+
+  void RegionDone(const Status& status, RegionScan* scan);
+
+  // counts of regions run so far, in the order of region id
+  void ConstructResultUnlocked();
+
+  const int64_t index_id_;
+  const std::string& langchain_expr_json_;
+  const DeleteByFilterOption& option_;
+  std::vector<DeleteByFilterRegionResult>& out_result_;
+
+  std::shared_ptr<VectorIndex> vector_index_;
+  std::shared_ptr<expression::LangchainExpr> expr_;
+  int64_t page_size_{0};
+
+  std::vector<std::unique_ptr<RegionScan>> scans_;
+
+  std::shared_mutex rw_lock_;
+  // counts of each region, summed over retries
+  std::map<int64_t, DeleteByFilterRegionResult> region_results_;
+  std::set<int64_t> done_region_ids_;
+  Status status_;
+
+  std::atomic<int> sub_tasks_count_{0};
+  std::atomic<size_t> next_scan_idx_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_VECTOR_DELETE_BY_FILTER_TASK_H_
@@ -17,12 +17,17 @@
 #include <cstdint>
 
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/vector/vector_helper.h"
 
 namespace dingodb {
 namespace sdk {
 
 Status VectorDeleteTask::Init() {
+  // searches in flight can not be cached
+  stub.GetVectorSearchCache()->InvalidateIndex(index_id_);
+  stub.GetVectorPayloadCache()->Invalidate(index_id_, vector_ids_);
+
   std::shared_ptr<VectorIndex> tmp;
   DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
   DCHECK_NOTNULL(tmp);
@@ -40,6 +45,11 @@ Status VectorDeleteTask::Init() {
   return Status::OK();
 }
 
+void VectorDeleteTask::PostProcess() {
+  stub.GetVectorSearchCache()->InvalidateIndex(index_id_);
+  stub.GetVectorPayloadCache()->Invalidate(index_id_, vector_ids_);
+}
+
 void VectorDeleteTask::DoAsync() {
   std::set<int64_t> next_batch;
   {
@@ -53,57 +63,43 @@ void VectorDeleteTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<int64_t>> region_vectors_to_ids;
-
-  auto meta_cache = stub.GetMetaCache();
-
-  for (const auto& id : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+  std::vector<int64_t> ids(next_batch.begin(), next_batch.end());
+  std::vector<vector_helper::RegionVectorIds> groups;
+  Status s = vector_helper::GroupVectorIdsByRegion(*stub.GetMetaCache(), *vector_index_, ids, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
 
-  for (const auto& entry : region_vectors_to_ids) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+
+    VectorDeleteRpc* rpc = nullptr;
+    int64_t batch_bytes = 0;
+    for (const auto& id : group.ids) {
+      if (rpc == nullptr ||
+          (FLAGS_vector_write_batch_max_bytes > 0 && batch_bytes >= FLAGS_vector_write_batch_max_bytes)) {
+        rpcs_.push_back(std::make_unique<VectorDeleteRpc>());
+        rpc = rpcs_.back().get();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+        controllers_.emplace_back(stub, *rpc, region);
+        batch_bytes = 0;
+      }
 
-    auto rpc = std::make_unique<VectorDeleteRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-
-    for (const auto& id : entry.second) {
       rpc->MutableRequest()->add_ids(id);
+      batch_bytes += sizeof(id);
     }
-
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
-
-    rpcs_.push_back(std::move(rpc));
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
+  sub_tasks_count_.store(rpcs_.size());
+  RecordFanOut(rpcs_.size());
 
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
+  for (auto i = 0; i < rpcs_.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -113,8 +109,8 @@ void VectorDeleteTask::DoAsync() {
 
 void VectorDeleteTask::VectorDeleteRpcCallback(const Status& status, VectorDeleteRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -127,6 +123,8 @@ void VectorDeleteTask::VectorDeleteRpcCallback(const Status& status, VectorDelet
     for (auto i = 0; i < rpc->Response()->key_states_size(); i++) {
       int64_t id = rpc->Request()->ids(i);
       out_result_.push_back({id, rpc->Response()->key_states(i)});
+      // not delete again when other region rpc fail and retry
+      next_vector_ids_.erase(id);
     }
   }
 
@@ -35,6 +35,8 @@ class VectorDeleteTask : public VectorTask {
  private:
   Status Init() override;
   void DoAsync() override;
+  // invalidate search cache of the index once write is done
+  void PostProcess() override;
 
   std::string Name() const override { return fmt::format("VectorDeleteTask-{}", index_id_); }
 
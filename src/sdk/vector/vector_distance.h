@@ -0,0 +1,190 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_DISTANCE_H_
+#define DINGODB_SDK_VECTOR_DISTANCE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "glog/logging.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+namespace vector_distance {
+
+// Loops keep kLanes independent partial sums, so the compiler can map them to simd registers without
+// reassociating one float accumulator, which it is not allowed to do without fast math.
+static constexpr size_t kLanes = 8;
+
+// Kernels take kDimension > 0 as the dimension known at compile time, the loops are then fully unrolled with no tail
+// for common embedding sizes. kDimension 0 uses the dimension passed at runtime.
+template <size_t kDimension>
+static float L2SqrKernel(const float* a, const float* b, size_t dimension) {
+  const size_t n = kDimension > 0 ? kDimension : dimension;
+  float sums[kLanes] = {0};
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    for (size_t j = 0; j < kLanes; ++j) {
+      float diff = a[i + j] - b[i + j];
+      sums[j] += diff * diff;
+    }
+  }
+
+  float sum = 0;
+  for (; i < n; ++i) {
+    float diff = a[i] - b[i];
+    sum += diff * diff;
+  }
+  for (float lane : sums) {
+    sum += lane;
+  }
+  return sum;
+}
+
+template <size_t kDimension>
+static float InnerProductKernel(const float* a, const float* b, size_t dimension) {
+  const size_t n = kDimension > 0 ? kDimension : dimension;
+  float sums[kLanes] = {0};
+  size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    for (size_t j = 0; j < kLanes; ++j) {
+      sums[j] += a[i + j] * b[i + j];
+    }
+  }
+
+  float sum = 0;
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  for (float lane : sums) {
+    sum += lane;
+  }
+  return sum;
+}
+
+// calls fn with the kernel dimension tag of dimension, std::integral_constant<size_t, 0> when it is not specialized
+template <class Fn>
+static auto DispatchDimension(size_t dimension, Fn&& fn) {
+  switch (dimension) {
+    case 128:
+      return fn(std::integral_constant<size_t, 128>());
+    case 256:
+      return fn(std::integral_constant<size_t, 256>());
+    case 768:
+      return fn(std::integral_constant<size_t, 768>());
+    case 1024:
+      return fn(std::integral_constant<size_t, 1024>());
+    case 1536:
+      return fn(std::integral_constant<size_t, 1536>());
+    default:
+      return fn(std::integral_constant<size_t, 0>());
+  }
+}
+
+static float L2Sqr(const float* a, const float* b, size_t dimension) {
+  return DispatchDimension(dimension, [&](auto tag) { return L2SqrKernel<decltype(tag)::value>(a, b, dimension); });
+}
+
+static float InnerProduct(const float* a, const float* b, size_t dimension) {
+  return DispatchDimension(dimension,
+                           [&](auto tag) { return InnerProductKernel<decltype(tag)::value>(a, b, dimension); });
+}
+
+// b_norm_sqr is InnerProduct(b, b), callers comparing one vector against many compute a_norm_sqr once
+template <size_t kDimension>
+static float CosineDistanceKernel(const float* a, float a_norm_sqr, const float* b, size_t dimension) {
+  float norm = std::sqrt(a_norm_sqr * InnerProductKernel<kDimension>(b, b, dimension));
+  if (norm == 0) {
+    return 1.0f;
+  }
+  return 1.0f - InnerProductKernel<kDimension>(a, b, dimension) / norm;
+}
+
+template <size_t kDimension>
+static void ExactDistancesKernel(MetricType metric_type, const float* query, const float* base, size_t count,
+                                 size_t dimension, float* out) {
+  switch (metric_type) {
+    case MetricType::kL2:
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = L2SqrKernel<kDimension>(query, base + i * dimension, dimension);
+      }
+      break;
+    case MetricType::kInnerProduct:
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = 1.0f - InnerProductKernel<kDimension>(query, base + i * dimension, dimension);
+      }
+      break;
+    case MetricType::kCosine: {
+      float query_norm_sqr = InnerProductKernel<kDimension>(query, query, dimension);
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = CosineDistanceKernel<kDimension>(query, query_norm_sqr, base + i * dimension, dimension);
+      }
+      break;
+    }
+    default:
+      CHECK(false) << "unsupported metric type:" << MetricTypeToString(metric_type);
+  }
+}
+
+// same convention as store, smaller is closer: squared l2, 1 - inner product and 1 - cosine similarity
+static float ExactDistance(MetricType metric_type, const float* a, const float* b, size_t dimension) {
+  switch (metric_type) {
+    case MetricType::kL2:
+      return L2Sqr(a, b, dimension);
+    case MetricType::kInnerProduct:
+      return 1.0f - InnerProduct(a, b, dimension);
+    case MetricType::kCosine:
+      return DispatchDimension(dimension, [&](auto tag) {
+        constexpr size_t kDimension = decltype(tag)::value;
+        return CosineDistanceKernel<kDimension>(a, InnerProductKernel<kDimension>(a, a, dimension), b, dimension);
+      });
+    default:
+      CHECK(false) << "unsupported metric type:" << MetricTypeToString(metric_type);
+  }
+}
+
+// one to many: out[i] is the distance of query to the i-th of count vectors stored row by row in base
+static void ExactDistances(MetricType metric_type, const float* query, const float* base, size_t count,
+                           size_t dimension, float* out) {
+  DispatchDimension(dimension, [&](auto tag) {
+    ExactDistancesKernel<decltype(tag)::value>(metric_type, query, base, count, dimension, out);
+  });
+}
+
+// rows of base compared with every query before moving on, so they are read from cache instead of memory
+static constexpr size_t kMatrixBlockBytes = 256 * 1024;
+
+// many to many: out[i * base_count + j] is the distance of the i-th query to the j-th base vector, both row by row
+static void ExactDistanceMatrix(MetricType metric_type, const float* queries, size_t query_count, const float* base,
+                                size_t base_count, size_t dimension, float* out) {
+  size_t block_rows = std::max<size_t>(1, kMatrixBlockBytes / (std::max<size_t>(1, dimension) * sizeof(float)));
+  DispatchDimension(dimension, [&](auto tag) {
+    for (size_t begin = 0; begin < base_count; begin += block_rows) {
+      size_t rows = std::min(block_rows, base_count - begin);
+      for (size_t i = 0; i < query_count; ++i) {
+        ExactDistancesKernel<decltype(tag)::value>(metric_type, queries + i * dimension, base + begin * dimension, rows,
+                                                   dimension, out + i * base_count + begin);
+      }
+    }
+  });
+}
+
+}  // namespace vector_distance
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_VECTOR_DISTANCE_H_
@@ -14,10 +14,12 @@
 
 #include "sdk/vector/vector_get_border_task.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "glog/logging.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
 
@@ -31,34 +33,32 @@ Status VectorGetBorderTask::Init() {
   vector_index_ = std::move(tmp);
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
-  auto part_ids = vector_index_->GetPartitionIds();
-
-  for (const auto& part_id : part_ids) {
-    next_part_ids_.emplace(part_id);
+  // partition ids are in order of start vector id, max id is in the last non empty partition
+  part_ids_ = vector_index_->GetPartitionIds();
+  if (is_max_) {
+    std::reverse(part_ids_.begin(), part_ids_.end());
   }
+  part_idx_ = 0;
 
   return Status::OK();
 }
 
 void VectorGetBorderTask::DoAsync() {
-  std::set<int64_t> next_part_ids;
+  int64_t part_id = 0;
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    next_part_ids = next_part_ids_;
-    status_ = Status::OK();
-  }
-
-  if (next_part_ids.empty()) {
-    DoAsyncDone(Status::OK());
-    return;
+    if (part_idx_ >= part_ids_.size()) {
+      // all partitions are empty
+      out_vector_id_ = target_vector_id_;
+      w.unlock();
+      DoAsyncDone(Status::OK());
+      return;
+    }
+    part_id = part_ids_[part_idx_];
   }
 
-  sub_tasks_count_.store(next_part_ids.size());
-
-  for (const auto& part_id : next_part_ids) {
-    auto* sub_task = new VectorGetBorderPartTask(stub, vector_index_, part_id, is_max_);
-    sub_task->AsyncRun([this, sub_task](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s), sub_task); });
-  }
+  auto* sub_task = new VectorGetBorderPartTask(stub, vector_index_, part_id, is_max_);
+  sub_task->AsyncRun([this, sub_task](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s), sub_task); });
 }
 
 void VectorGetBorderTask::SubTaskCallback(Status status, VectorGetBorderPartTask* sub_task) {
@@ -66,39 +66,32 @@ void VectorGetBorderTask::SubTaskCallback(Status status, VectorGetBorderPartTask
 
   if (!status.ok()) {
     DINGO_LOG(WARNING) << "sub_task: " << sub_task->Name() << " fail: " << status.ToString();
-
-    std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
-      // only return first fail status
-      status_ = status;
-    }
-  } else {
-    std::unique_lock<std::shared_mutex> w(rw_lock_);
-    int64_t result_vecotr_id = sub_task->GetResult();
-    target_vector_id_ =
-        is_max_ ? std::max(target_vector_id_, result_vecotr_id) : std::min(target_vector_id_, result_vecotr_id);
-
-    next_part_ids_.erase(sub_task->part_id_);
+    DoAsyncDone(status);
+    return;
   }
 
-  if (sub_tasks_count_.fetch_sub(1) == 1) {
-    Status tmp;
+  int64_t result_vector_id = sub_task->GetResult();
+  if (sub_task->Found()) {
     {
-      std::shared_lock<std::shared_mutex> r(rw_lock_);
-      tmp = status_;
-      if (tmp.ok()) {
-        out_vector_id_ = target_vector_id_;
-      }
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      target_vector_id_ = result_vector_id;
+      out_vector_id_ = target_vector_id_;
     }
+    DoAsyncDone(Status::OK());
+    return;
+  }
 
-    DoAsyncDone(tmp);
+  // partition is empty, fallback to the next one
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    part_idx_++;
   }
+  DoAsync();
 }
 
 void VectorGetBorderPartTask::DoAsync() {
-  const auto& range = vector_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> regions;
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -113,13 +106,17 @@ void VectorGetBorderPartTask::DoAsync() {
   controllers_.clear();
   rpcs_.clear();
 
+  // regions are in order of range, ask from the highest one for max id
+  if (is_max_) {
+    std::reverse(regions.begin(), regions.end());
+  }
+
   for (const auto& region : regions) {
     auto rpc = std::make_unique<VectorGetBorderIdRpc>();
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
     rpc->MutableRequest()->set_get_min(!is_max_);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -127,20 +124,39 @@ void VectorGetBorderPartTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), regions.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(regions.size());
+  if (rpcs_.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  next_rpc_idx_ = 0;
+  // most likely the first region has the border id
+  SendNextWave(1);
+}
 
-  for (auto i = 0; i < regions.size(); i++) {
-    auto& controller = controllers_[i];
+void VectorGetBorderPartTask::SendNextWave(size_t wave_size) {
+  size_t start = next_rpc_idx_;
+  size_t end = std::min(start + wave_size, rpcs_.size());
+  CHECK_LT(start, end);
+  next_rpc_idx_ = end;
+  sub_tasks_count_.store(end - start);
+  RecordFanOut(end - start);
 
-    controller.AsyncCall(
+  for (size_t i = start; i < end; i++) {
+    controllers_[i].AsyncCall(
         [this, rpc = rpcs_[i].get()](auto&& s) { VectorGetBorderIdRpcCallback(std::forward<decltype(s)>(s), rpc); });
   }
 }
 
+bool VectorGetBorderPartTask::Found() {
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  return is_max_ ? result_vector_id_ > 0 : result_vector_id_ != INT64_MAX;
+}
+
 void VectorGetBorderPartTask::VectorGetBorderIdRpcCallback(const Status& status, VectorGetBorderIdRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -161,6 +177,14 @@ void VectorGetBorderPartTask::VectorGetBorderIdRpcCallback(const Status& status,
       std::shared_lock<std::shared_mutex> r(rw_lock_);
       tmp = status_;
     }
+
+    // ids of regions in earlier waves are all beyond later ones, so later regions are asked only when earlier are
+    // all empty
+    if (tmp.ok() && !Found() && next_rpc_idx_ < rpcs_.size()) {
+      SendNextWave(FLAGS_vector_region_rpc_concurrency > 0 ? FLAGS_vector_region_rpc_concurrency : rpcs_.size());
+      return;
+    }
+
     DoAsyncDone(tmp);
   }
 }
@@ -17,6 +17,7 @@
 #define DINGODB_SDK_VECTOR_GET_BORDER_TASK_H_
 
 #include <cstdint>
+#include <vector>
 
 #include "sdk/rpc/index_service_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
@@ -51,10 +52,9 @@ class VectorGetBorderTask : public VectorTask {
   int64_t target_vector_id_;
 
   std::shared_mutex rw_lock_;
-  std::set<int64_t> next_part_ids_;
-  Status status_;
-
-  std::atomic<int> sub_tasks_count_{0};
+  // partitions are asked one by one in this order, until one is not empty
+  std::vector<int64_t> part_ids_;
+  size_t part_idx_{0};
 };
 
 class VectorGetBorderPartTask : public VectorTask {
@@ -83,6 +83,12 @@ class VectorGetBorderPartTask : public VectorTask {
 
   void VectorGetBorderIdRpcCallback(const Status& status, VectorGetBorderIdRpc* rpc);
 
+  // send rpcs of next wave_size regions, the next wave is only sent when all regions asked are empty
+  void SendNextWave(size_t wave_size);
+
+  // true if any region asked has vector
+  bool Found();
+
   const std::shared_ptr<VectorIndex> vector_index_;
   const int64_t part_id_;
   const bool is_max_;
@@ -94,6 +100,8 @@ class VectorGetBorderPartTask : public VectorTask {
   Status status_;
   int64_t result_vector_id_;
 
+  // only changed when no rpc in flight
+  size_t next_rpc_idx_{0};
   std::atomic<int> sub_tasks_count_{0};
 };
 
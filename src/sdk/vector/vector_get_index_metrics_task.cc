@@ -14,10 +14,12 @@
 
 #include "sdk/vector/vector_get_index_metrics_task.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/utils/scoped_cleanup.h"
 #include "sdk/vector/vector_common.h"
 
@@ -55,6 +57,7 @@ void VectorGetIndexMetricsTask::DoAsync() {
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
     auto* sub_task = new VectorGetIndexMetricsPartTask(stub, vector_index_, part_id);
@@ -98,9 +101,8 @@ void VectorGetIndexMetricsTask::SubTaskCallback(Status status, VectorGetIndexMet
 }
 
 void VectorGetIndexMetricsPartTask::DoAsync() {
-  const auto& range = vector_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> regions;
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -119,8 +121,7 @@ void VectorGetIndexMetricsPartTask::DoAsync() {
     auto rpc = std::make_unique<VectorGetRegionMetricsRpc>();
     FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -128,22 +129,40 @@ void VectorGetIndexMetricsPartTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), regions.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(regions.size());
+  if (regions.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
 
-  for (auto i = 0; i < regions.size(); i++) {
-    auto& controller = controllers_[i];
+  sub_tasks_count_.store(regions.size());
+  RecordFanOut(regions.size());
+  next_rpc_idx_.store(0);
+
+  // at most FLAGS_vector_region_rpc_concurrency rpcs in flight, each finished rpc sends the next one
+  size_t window = FLAGS_vector_region_rpc_concurrency > 0
+                      ? std::min<size_t>(FLAGS_vector_region_rpc_concurrency, regions.size())
+                      : regions.size();
+  for (size_t i = 0; i < window; i++) {
+    SendNextRpc();
+  }
+}
 
-    controller.AsyncCall([this, rpc = rpcs_[i].get()](auto&& s) {
-      VectorGetRegionMetricsRpcCallback(std::forward<decltype(s)>(s), rpc);
-    });
+void VectorGetIndexMetricsPartTask::SendNextRpc() {
+  size_t idx = next_rpc_idx_.fetch_add(1);
+  if (idx >= rpcs_.size()) {
+    return;
   }
+
+  controllers_[idx].AsyncCall([this, rpc = rpcs_[idx].get()](auto&& s) {
+    VectorGetRegionMetricsRpcCallback(std::forward<decltype(s)>(s), rpc);
+  });
 }
 
 void VectorGetIndexMetricsPartTask::VectorGetRegionMetricsRpcCallback(const Status& status,
                                                                       VectorGetRegionMetricsRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -157,6 +176,8 @@ void VectorGetIndexMetricsPartTask::VectorGetRegionMetricsRpcCallback(const Stat
     CHECK(region_id_to_metrics_.emplace(rpc->Request()->context().region_id(), result).second);
   }
 
+  SendNextRpc();
+
   if (sub_tasks_count_.fetch_sub(1) == 1) {
     Status tmp;
     {
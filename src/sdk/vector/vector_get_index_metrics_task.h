@@ -103,6 +103,9 @@ class VectorGetIndexMetricsPartTask : public VectorTask {
     return fmt::format("VectorGetIndexMetricsPartTask-{}-{}", vector_index_->GetId(), part_id_);
   }
 
+  // send rpc of next_rpc_idx_ if any left
+  void SendNextRpc();
+
   void VectorGetRegionMetricsRpcCallback(const Status& status, VectorGetRegionMetricsRpc* rpc);
 
   const std::shared_ptr<VectorIndex> vector_index_;
@@ -116,6 +119,7 @@ class VectorGetIndexMetricsPartTask : public VectorTask {
   std::unordered_map<int64_t, IndexMetricsResult> region_id_to_metrics_;
 
   std::atomic<int> sub_tasks_count_{0};
+  std::atomic<size_t> next_rpc_idx_{0};
 };
 
 }  // namespace sdk
@@ -15,7 +15,24 @@
 #ifndef DINGODB_SDK_VECTOR_HELPER_H_
 #define DINGODB_SDK_VECTOR_HELPER_H_
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "glog/logging.h"
+#include "sdk/expression/langchain_expr_evaluator.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/filter.h"
+#include "sdk/meta_cache.h"
+#include "sdk/region.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
 #include "sdk/vector/vector_codec.h"
 #include "sdk/vector/vector_index.h"
 
@@ -32,6 +49,155 @@ static std::string VectorIdToRangeKey(const VectorIndex& vector_index, int64_t v
   vector_codec::EncodeVectorKey(kVectorPrefix, part_id, vector_id, tmp_key);
   return std::move(tmp_key);
 }
+
+// range keys of vector_ids written back to back into out_keys by one batched encode,
+// key i is out_keys.substr(i * kVectorKeyMaxLenWithPrefix, kVectorKeyMaxLenWithPrefix)
+static void VectorIdsToRangeKeys(const VectorIndex& vector_index, const std::vector<int64_t>& vector_ids,
+                                 std::string& out_keys) {
+  std::vector<int64_t> part_ids;
+  part_ids.reserve(vector_ids.size());
+  for (int64_t id : vector_ids) {
+    CHECK_GT(id, 0);
+    int64_t part_id = vector_index.GetPartitionId(id);
+    CHECK_GT(part_id, 0);
+    part_ids.push_back(part_id);
+  }
+
+  vector_codec::EncodeVectorKeys(kVectorPrefix, part_ids, vector_ids, out_keys);
+}
+
+// vector ids belong to the same region, ordered by their range key
+struct RegionVectorIds {
+  std::shared_ptr<Region> region;
+  std::vector<int64_t> ids;
+};
+
+// vector_ids must be unique, range keys of all ids are sorted and mapped to regions by one batched lookup of
+// meta cache, out_groups is ordered by region range
+static Status GroupVectorIdsByRegion(MetaCache& meta_cache, const VectorIndex& vector_index,
+                                     const std::vector<int64_t>& vector_ids, std::vector<RegionVectorIds>& out_groups) {
+  out_groups.clear();
+
+  std::string keys;
+  VectorIdsToRangeKeys(vector_index, vector_ids, keys);
+
+  // partition id is encoded before vector id, so key order is not id order when partitions are not in id order
+  std::vector<std::pair<std::string_view, int64_t>> key_ids;
+  key_ids.reserve(vector_ids.size());
+  for (size_t i = 0; i < vector_ids.size(); ++i) {
+    key_ids.emplace_back(std::string_view(keys).substr(i * kVectorKeyMaxLenWithPrefix, kVectorKeyMaxLenWithPrefix),
+                         vector_ids[i]);
+  }
+  std::sort(key_ids.begin(), key_ids.end());
+
+  std::vector<std::string_view> sorted_keys;
+  sorted_keys.reserve(key_ids.size());
+  for (const auto& [key, id] : key_ids) {
+    sorted_keys.emplace_back(key);
+  }
+
+  std::vector<RegionKeys> region_keys;
+  DINGO_RETURN_NOT_OK(meta_cache.LookupRegionsByKeys(sorted_keys, region_keys));
+
+  // groups keep key order, so ids are taken by position
+  size_t pos = 0;
+  out_groups.reserve(region_keys.size());
+  for (auto& group : region_keys) {
+    RegionVectorIds region_ids{std::move(group.region), {}};
+    region_ids.ids.reserve(group.keys.size());
+    for (const auto& key : group.keys) {
+      CHECK_LT(pos, key_ids.size());
+      DCHECK_EQ(key.data(), key_ids[pos].first.data());
+      region_ids.ids.push_back(key_ids[pos++].second);
+    }
+    out_groups.push_back(std::move(region_ids));
+  }
+  CHECK_EQ(pos, key_ids.size());
+
+  return Status::OK();
+}
+
+// keep the limit nearest of heap and to_merge in heap, a max heap by distance whose top is the farthest kept one,
+// limit 0 means not bounded and to_merge is appended unordered, to_merge is moved from
+static void MergeTopK(std::vector<VectorWithDistance>& heap, std::vector<VectorWithDistance>& to_merge,
+                      int64_t limit) {
+  auto compare = [](const VectorWithDistance& a, const VectorWithDistance& b) { return a.distance < b.distance; };
+
+  if (limit == 0) {
+    heap.reserve(heap.size() + to_merge.size());
+    std::move(to_merge.begin(), to_merge.end(), std::back_inserter(heap));
+    return;
+  }
+
+  heap.reserve(std::min<size_t>(limit, heap.size() + to_merge.size()));
+  for (auto& distance : to_merge) {
+    if (static_cast<int64_t>(heap.size()) < limit) {
+      heap.push_back(std::move(distance));
+      std::push_heap(heap.begin(), heap.end(), compare);
+    } else if (distance.distance < heap.front().distance) {
+      std::pop_heap(heap.begin(), heap.end(), compare);
+      heap.back() = std::move(distance);
+      std::push_heap(heap.begin(), heap.end(), compare);
+    }
+  }
+}
+
+// fraction of sample whose scalar data matches filter, or expr_json when filter is nullptr, evaluated on client,
+// false when sample is empty, there is no filter or expr_json is invalid
+static bool EstimateSelectivity(const std::vector<VectorWithId>& sample, const Filter* filter,
+                                const std::string& expr_json, double& out_selectivity) {
+  if (sample.empty() || (filter == nullptr && expr_json.empty())) {
+    return false;
+  }
+
+  std::shared_ptr<expression::LangchainExpr> expr;
+  if (filter == nullptr) {
+    expression::LangchainExprFactory factory;
+    if (!factory.CreateExpr(expr_json, expr).ok()) {
+      return false;
+    }
+  }
+
+  int64_t matched = 0;
+  expression::LangchainExprEvaluator evaluator;
+  for (const auto& vector_with_id : sample) {
+    bool match = filter != nullptr
+                     ? filter->Match(vector_with_id)
+                     : evaluator.Evaluate(expr.get(), expression::VectorScalarEvalRow(vector_with_id.scalar_data));
+    matched += match ? 1 : 0;
+  }
+
+  out_selectivity = static_cast<double>(matched) / sample.size();
+  return true;
+}
+
+// ids of vectors whose scalar data matches expr, evaluated on client, in the order of vectors
+static void MatchVectorIds(const std::vector<VectorWithId>& vectors, expression::LangchainExpr* expr,
+                           std::vector<int64_t>& out_ids) {
+  out_ids.clear();
+  expression::LangchainExprEvaluator evaluator;
+  for (const auto& vector_with_id : vectors) {
+    if (evaluator.Evaluate(expr, expression::VectorScalarEvalRow(vector_with_id.scalar_data))) {
+      out_ids.push_back(vector_with_id.id);
+    }
+  }
+}
+
+// pre filter when filter is selective, vectors matching it are few and searched exactly, otherwise post filter
+// asking for enough candidates that about topk of them match, out_recall_num is 0 for pre filter or when topk <= 0
+static FilterType PickFilterType(double selectivity, int64_t topk, double pre_max_selectivity, int64_t max_recall_num,
+                                 int64_t& out_recall_num) {
+  out_recall_num = 0;
+  if (selectivity <= pre_max_selectivity) {
+    return FilterType::kQueryPre;
+  }
+
+  if (topk > 0) {
+    auto recall_num = static_cast<int64_t>(std::ceil(topk / selectivity));
+    out_recall_num = std::max(topk, std::min(recall_num, max_recall_num));
+  }
+  return FilterType::kQueryPost;
+}
 }  // namespace vector_helper
 
 }  // namespace sdk
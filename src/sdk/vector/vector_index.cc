@@ -15,6 +15,7 @@
 #include "sdk/vector/vector_index.h"
 
 #include <cstdint>
+#include <mutex>
 #include <sstream>
 
 #include "fmt/core.h"
@@ -50,6 +51,24 @@ VectorIndexType VectorIndex::GetVectorIndexType() const {
       index_def_with_id_.index_definition().index_parameter().vector_index_parameter().vector_index_type());
 }
 
+MetricType VectorIndex::GetMetricType() const {
+  const auto& parameter = index_def_with_id_.index_definition().index_parameter().vector_index_parameter();
+  switch (GetVectorIndexType()) {
+    case VectorIndexType::kFlat:
+      return InternalMetricTypePB2MetricType(parameter.flat_parameter().metric_type());
+    case VectorIndexType::kIvfFlat:
+      return InternalMetricTypePB2MetricType(parameter.ivf_flat_parameter().metric_type());
+    case VectorIndexType::kIvfPq:
+      return InternalMetricTypePB2MetricType(parameter.ivf_pq_parameter().metric_type());
+    case VectorIndexType::kHnsw:
+      return InternalMetricTypePB2MetricType(parameter.hnsw_parameter().metric_type());
+    case VectorIndexType::kBruteForce:
+      return InternalMetricTypePB2MetricType(parameter.bruteforce_parameter().metric_type());
+    default:
+      return MetricType::kNoneMetricType;
+  }
+}
+
 int64_t VectorIndex::GetPartitionId(int64_t vector_id) const {
   CHECK_GT(vector_id, 0);
   VLOG(kSdkVlogLevel) << "query  vector_id:" << vector_id << ", cache:" << ToString();
@@ -75,6 +94,11 @@ const pb::common::Range& VectorIndex::GetPartitionRange(int64_t part_id) const {
   return iter->second;
 }
 
+Status VectorIndex::GetPartitionRegions(MetaCache& meta_cache, int64_t part_id,
+                                  std::vector<std::shared_ptr<Region>>& regions) {
+  return part_region_cache_.GetRegions(meta_cache, part_id, GetPartitionRange(part_id), regions);
+}
+
 std::string VectorIndex::ToString(bool verbose) const {
   std::ostringstream oss;
   for (const auto& [start_key, part_id] : start_key_to_part_id_) {
@@ -89,9 +113,28 @@ std::string VectorIndex::ToString(bool verbose) const {
   }
 }
 
+void VectorIndex::RecordSearchLatency(int64_t region_id, int64_t latency_us) {
+  std::lock_guard<std::mutex> guard(search_latency_mutex_);
+  search_latency_[region_id].Record(latency_us);
+}
+
+int64_t VectorIndex::GetSearchLatencyPercentileUs(int64_t region_id, int64_t percentile) {
+  // too few samples give a meaningless percentile
+  static constexpr int64_t kMinSamples = 8;
+
+  std::lock_guard<std::mutex> guard(search_latency_mutex_);
+  auto iter = search_latency_.find(region_id);
+  if (iter == search_latency_.end() || iter->second.Samples() < kMinSamples) {
+    return -1;
+  }
+  return iter->second.QuantileUs(percentile);
+}
+
 void VectorIndex::MaybeGenerateScalarSchema() {
-  for (const auto& schema_item :
-       index_def_with_id_.index_definition().index_parameter().vector_index_parameter().scalar_schema().fields()) {
+  const auto& scalar_schema =
+      index_def_with_id_.index_definition().index_parameter().vector_index_parameter().scalar_schema();
+  scalar_schema_version_ = scalar_schema.SerializeAsString();
+  for (const auto& schema_item : scalar_schema.fields()) {
     CHECK(scalar_schema_
               .insert(std::make_pair(schema_item.key(), InternalScalarFieldTypePB2Type(schema_item.field_type())))
               .second);
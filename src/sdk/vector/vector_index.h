@@ -17,9 +17,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "proto/meta.pb.h"
+#include "sdk/partition_region_cache.h"
+#include "sdk/utils/latency_ewma.h"
 #include "sdk/vector.h"
 
 namespace dingodb {
@@ -43,6 +47,9 @@ class VectorIndex {
 
   VectorIndexType GetVectorIndexType() const;
 
+  // kNoneMetricType when index type has no metric type parameter
+  MetricType GetMetricType() const;
+
   int64_t GetPartitionId(int64_t vector_id) const;
 
   std::vector<int64_t> GetPartitionIds() const;
@@ -50,6 +57,9 @@ class VectorIndex {
   // be sure partition id is valid
   const pb::common::Range& GetPartitionRange(int64_t part_id) const;
 
+  // be sure partition id is valid, regions are cached across requests, see PartitionRegionCache
+  Status GetPartitionRegions(MetaCache& meta_cache, int64_t part_id, std::vector<std::shared_ptr<Region>>& regions);
+
   bool IsStale() { return stale_.load(std::memory_order_relaxed); }
 
   bool HasAutoIncrement() const { return has_auto_increment_; }
@@ -58,11 +68,19 @@ class VectorIndex {
 
   bool HasScalarSchema() const { return !scalar_schema_.empty(); }
   const std::unordered_map<std::string, Type>& GetScalarSchema() const { return scalar_schema_; }
+  // serialized scalar schema, identifies the schema in expr cache
+  const std::string& GetScalarSchemaVersion() const { return scalar_schema_version_; }
 
   const pb::meta::IndexDefinitionWithId& GetIndexDefWithId() const { return index_def_with_id_; }
 
   std::string ToString(bool verbose = false) const;
 
+  // latency of vector search rpc to region, used to decide when to send backup rpc
+  void RecordSearchLatency(int64_t region_id, int64_t latency_us);
+
+  // return -1 when region has not enough samples
+  int64_t GetSearchLatencyPercentileUs(int64_t region_id, int64_t percentile);
+
  private:
   friend class VectorIndexCache;
 
@@ -83,8 +101,14 @@ class VectorIndex {
   std::map<int64_t, pb::common::Range> part_id_to_range_;
 
   std::unordered_map<std::string, Type> scalar_schema_;
+  std::string scalar_schema_version_;
 
   std::atomic<bool> stale_{true};
+
+  PartitionRegionCache part_region_cache_;
+
+  std::mutex search_latency_mutex_;
+  std::unordered_map<int64_t, LatencyEwma> search_latency_;
 };
 }  // namespace sdk
 
@@ -14,13 +14,19 @@
 
 #include "sdk/vector/vector_index_cache.h"
 
+#include <chrono>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <string>
+#include <utility>
 
 #include "glog/logging.h"
+#include "sdk/auto_increment_manager.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
 #include "proto/meta.pb.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/status.h"
@@ -28,7 +34,42 @@
 namespace dingodb {
 namespace sdk {
 
-VectorIndexCache::VectorIndexCache(const ClientStub& stub) : stub_(stub) {}
+namespace {
+// bound memory of negative entries when many missing names are looked up
+const size_t kMaxNegativeEntries = 4096;
+
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+template <class Key>
+bool IsNegativeCachedUnlocked(const std::unordered_map<Key, int64_t>& negative_expire_ms, const Key& key) {
+  auto iter = negative_expire_ms.find(key);
+  return iter != negative_expire_ms.end() && iter->second > NowMs();
+}
+
+template <class Key>
+void AddNegativeUnlocked(std::unordered_map<Key, int64_t>& negative_expire_ms, const Key& key) {
+  if (FLAGS_index_cache_negative_ttl_ms <= 0) {
+    return;
+  }
+
+  int64_t now_ms = NowMs();
+  if (negative_expire_ms.size() >= kMaxNegativeEntries) {
+    for (auto iter = negative_expire_ms.begin(); iter != negative_expire_ms.end();) {
+      iter = iter->second <= now_ms ? negative_expire_ms.erase(iter) : std::next(iter);
+    }
+    if (negative_expire_ms.size() >= kMaxNegativeEntries) {
+      negative_expire_ms.clear();
+    }
+  }
+  negative_expire_ms[key] = now_ms + FLAGS_index_cache_negative_ttl_ms;
+}
+}  // namespace
+
+VectorIndexCache::VectorIndexCache(const ClientStub& stub)
+    : stub_(stub), id_snapshot_(std::make_shared<const IdToIndexMap>()) {}
 
 Status VectorIndexCache::GetIndexIdByKey(const VectorIndexCacheKey& index_key, int64_t& index_id) {
   {
@@ -65,9 +106,9 @@ Status VectorIndexCache::GetVectorIndexByKey(const VectorIndexCacheKey& index_ke
 
 Status VectorIndexCache::GetVectorIndexById(int64_t index_id, std::shared_ptr<VectorIndex>& out_vector_index) {
   {
-    std::shared_lock<std::shared_mutex> r(rw_lock_);
-    auto iter = id_to_index_.find(index_id);
-    if (iter != id_to_index_.end()) {
+    auto snapshot = std::atomic_load(&id_snapshot_);
+    auto iter = snapshot->find(index_id);
+    if (iter != snapshot->end()) {
       out_vector_index = iter->second;
       return Status::OK();
     }
@@ -76,6 +117,32 @@ Status VectorIndexCache::GetVectorIndexById(int64_t index_id, std::shared_ptr<Ve
   return SlowGetVectorIndexById(index_id, out_vector_index);
 }
 
+void VectorIndexCache::SetRecallProfile(int64_t index_id, RecallProfile profile) {
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  id_to_recall_profile_[index_id] = std::move(profile);
+}
+
+bool VectorIndexCache::GetRecallProfile(int64_t index_id, RecallProfile &out_profile) const {
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  auto iter = id_to_recall_profile_.find(index_id);
+  if (iter == id_to_recall_profile_.end()) {
+    return false;
+  }
+  out_profile = iter->second;
+  return true;
+}
+
+void VectorIndexCache::SetScalarSample(int64_t index_id, std::shared_ptr<const std::vector<VectorWithId>> sample) {
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  id_to_scalar_sample_[index_id] = std::move(sample);
+}
+
+std::shared_ptr<const std::vector<VectorWithId>> VectorIndexCache::GetScalarSample(int64_t index_id) const {
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  auto iter = id_to_scalar_sample_.find(index_id);
+  return iter == id_to_scalar_sample_.end() ? nullptr : iter->second;
+}
+
 void VectorIndexCache::RemoveVectorIndexById(int64_t index_id) {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   auto id_iter = id_to_index_.find(index_id);
@@ -87,6 +154,7 @@ void VectorIndexCache::RemoveVectorIndexById(int64_t index_id) {
     id_iter->second->MarkStale();
     id_to_index_.erase(id_iter);
     index_key_to_id_.erase(name_iter);
+    PublishIdSnapshotUnlocked();
   }
 }
 
@@ -101,11 +169,118 @@ void VectorIndexCache::RemoveVectorIndexByKey(const VectorIndexCacheKey& index_k
     id_iter->second->MarkStale();
     id_to_index_.erase(id_iter);
     index_key_to_id_.erase(name_iter);
+    PublishIdSnapshotUnlocked();
+  }
+}
+
+std::vector<pb::meta::IndexDefinitionWithId> VectorIndexCache::ListIndexDefinitions() {
+  std::vector<pb::meta::IndexDefinitionWithId> defs;
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  defs.reserve(id_to_index_.size());
+  for (const auto& [index_id, index] : id_to_index_) {
+    defs.push_back(index->GetIndexDefWithId());
   }
+  return defs;
+}
+
+Status VectorIndexCache::AddIndexDefinition(const pb::meta::IndexDefinitionWithId& index_def_with_id) {
+  if (!CheckIndexDefinitionWithId(index_def_with_id)) {
+    return Status::InvalidArgument("invalid index definition");
+  }
+
+  auto index_key = EncodeVectorIndexCacheKey(index_def_with_id.index_id().parent_entity_id(),
+                                              index_def_with_id.index_definition().name());
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    // another index with the same name is cached, keep the one from coordinator
+    if (index_key_to_id_.find(index_key) != index_key_to_id_.end()) {
+      return Status::AlreadyPresent("index name already cached");
+    }
+  }
+
+  std::shared_ptr<VectorIndex> index;
+  return ProcessIndexDefinitionWithId(index_def_with_id, index);
 }
 
 Status VectorIndexCache::SlowGetVectorIndexByKey(const VectorIndexCacheKey& index_key,
                                                  std::shared_ptr<VectorIndex>& out_vector_index) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    if (IsNegativeCachedUnlocked(key_negative_expire_ms_, index_key)) {
+      return Status::NotFound("index not found recently");
+    }
+  }
+
+  bool is_leader = false;
+  Status s = key_flight_.Do(
+      index_key, [&]() { return LoadVectorIndexByKey(index_key, out_vector_index); }, is_leader);
+  if (is_leader) {
+    if (s.IsNotFound()) {
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      AddNegativeUnlocked(key_negative_expire_ms_, index_key);
+    }
+    return s;
+  }
+
+  if (!s.ok()) {
+    return s;
+  }
+
+  {
+    // loaded by leader
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = index_key_to_id_.find(index_key);
+    if (iter != index_key_to_id_.end()) {
+      auto index_iter = id_to_index_.find(iter->second);
+      CHECK(index_iter != id_to_index_.end());
+      out_vector_index = index_iter->second;
+      return Status::OK();
+    }
+  }
+
+  // removed right after loaded
+  return LoadVectorIndexByKey(index_key, out_vector_index);
+}
+
+Status VectorIndexCache::SlowGetVectorIndexById(int64_t index_id, std::shared_ptr<VectorIndex>& out_vector_index) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    if (IsNegativeCachedUnlocked(id_negative_expire_ms_, index_id)) {
+      return Status::NotFound("index not found recently");
+    }
+  }
+
+  bool is_leader = false;
+  Status s = id_flight_.Do(
+      index_id, [&]() { return LoadVectorIndexById(index_id, out_vector_index); }, is_leader);
+  if (is_leader) {
+    if (s.IsNotFound()) {
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      AddNegativeUnlocked(id_negative_expire_ms_, index_id);
+    }
+    return s;
+  }
+
+  if (!s.ok()) {
+    return s;
+  }
+
+  {
+    // loaded by leader
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    auto iter = id_to_index_.find(index_id);
+    if (iter != id_to_index_.end()) {
+      out_vector_index = iter->second;
+      return Status::OK();
+    }
+  }
+
+  // removed right after loaded
+  return LoadVectorIndexById(index_id, out_vector_index);
+}
+
+Status VectorIndexCache::LoadVectorIndexByKey(const VectorIndexCacheKey& index_key,
+                                              std::shared_ptr<VectorIndex>& out_vector_index) {
   int64_t schema_id{0};
   std::string index_name;
   DecodeVectorIndexCacheKey(index_key, schema_id, index_name);
@@ -127,7 +302,14 @@ Status VectorIndexCache::SlowGetVectorIndexByKey(const VectorIndexCacheKey& inde
   }
 }
 
-Status VectorIndexCache::SlowGetVectorIndexById(int64_t index_id, std::shared_ptr<VectorIndex>& out_vector_index) {
+Status VectorIndexCache::LoadVectorIndexById(int64_t index_id, std::shared_ptr<VectorIndex>& out_vector_index) {
+  pb::meta::IndexDefinitionWithId index_def_with_id;
+  DINGO_RETURN_NOT_OK(FetchIndexDefinitionById(index_id, index_def_with_id));
+  return ProcessIndexDefinitionWithId(index_def_with_id, out_vector_index);
+}
+
+Status VectorIndexCache::FetchIndexDefinitionById(int64_t index_id,
+                                                  pb::meta::IndexDefinitionWithId& out_index_def_with_id) {
   GetIndexRpc rpc;
   auto* index_id_pb = rpc.MutableRequest()->mutable_index_id();
   index_id_pb->set_entity_type(::dingodb::pb::meta::EntityType::ENTITY_TYPE_INDEX);
@@ -137,17 +319,113 @@ Status VectorIndexCache::SlowGetVectorIndexById(int64_t index_id, std::shared_pt
   DINGO_RETURN_NOT_OK(stub_.GetMetaRpcController()->SyncCall(rpc));
 
   if (CheckIndexResponse(*rpc.Response())) {
-    return ProcessIndexDefinitionWithId(rpc.Response()->index_definition_with_id(), out_vector_index);
+    out_index_def_with_id = rpc.Response()->index_definition_with_id();
+    return Status::OK();
   } else {
     return Status::NotFound("response check invalid");
   }
 }
 
+void VectorIndexCache::UpdateIndexDefinition(const pb::meta::IndexDefinitionWithId& index_def_with_id) {
+  int64_t index_id = index_def_with_id.index_id().entity_id();
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  auto iter = id_to_index_.find(index_id);
+  if (iter == id_to_index_.end()) {
+    // removed meanwhile
+    return;
+  }
+
+  auto old_index = iter->second;
+  if (old_index->GetIndexDefWithId().SerializeAsString() == index_def_with_id.SerializeAsString()) {
+    return;
+  }
+
+  auto new_index = std::make_shared<VectorIndex>(index_def_with_id);
+  auto new_key = GetVectorIndexCacheKey(*new_index);
+  auto key_iter = index_key_to_id_.find(new_key);
+  if (key_iter != index_key_to_id_.end() && key_iter->second != index_id) {
+    DINGO_LOG(WARNING) << "skip refresh index_id:" << index_id << ", its name is cached by index_id:"
+                       << key_iter->second;
+    return;
+  }
+
+  index_key_to_id_.erase(GetVectorIndexCacheKey(*old_index));
+  index_key_to_id_[new_key] = index_id;
+  iter->second = new_index;
+  PublishIdSnapshotUnlocked();
+  new_index->UnMarkStale();
+  old_index->MarkStale();
+  DINGO_LOG(INFO) << "refresh changed index definition, index_id:" << index_id;
+}
+
+void VectorIndexCache::Refresh() {
+  std::vector<int64_t> index_ids;
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    index_ids.reserve(id_to_index_.size());
+    for (const auto& [index_id, index] : id_to_index_) {
+      index_ids.push_back(index_id);
+    }
+  }
+
+  for (int64_t index_id : index_ids) {
+    if (IsStopped()) {
+      return;
+    }
+
+    pb::meta::IndexDefinitionWithId index_def_with_id;
+    Status s = FetchIndexDefinitionById(index_id, index_def_with_id);
+    if (s.IsNotFound()) {
+      DINGO_LOG(INFO) << "index_id:" << index_id << " not found when refresh, remove it from cache";
+      RemoveVectorIndexById(index_id);
+    } else if (!s.ok()) {
+      DINGO_LOG(WARNING) << "Fail refresh index_id:" << index_id << ", status:" << s.ToString();
+    } else {
+      UpdateIndexDefinition(index_def_with_id);
+    }
+  }
+}
+
+void VectorIndexCache::Start() {
+  if (FLAGS_index_cache_refresh_interval_s <= 0) {
+    return;
+  }
+  ScheduleRefresh();
+}
+
+void VectorIndexCache::ScheduleRefresh() {
+  if (IsStopped()) {
+    return;
+  }
+
+  auto self = shared_from_this();
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [self] {
+        if (self->IsStopped()) {
+          return;
+        }
+        self->Refresh();
+        self->ScheduleRefresh();
+      },
+      FLAGS_index_cache_refresh_interval_s * 1000);
+  if (!scheduled) {
+    DINGO_LOG(WARNING) << "Fail schedule vector index cache refresh";
+  }
+}
+
+void VectorIndexCache::PublishIdSnapshotUnlocked() {
+  std::atomic_store(&id_snapshot_, std::shared_ptr<const IdToIndexMap>(std::make_shared<IdToIndexMap>(id_to_index_)));
+}
+
 Status VectorIndexCache::ProcessIndexDefinitionWithId(const pb::meta::IndexDefinitionWithId& index_def_with_id,
                                                       std::shared_ptr<VectorIndex>& out_vector_index) {
   int64_t index_id = index_def_with_id.index_id().entity_id();
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
+  id_negative_expire_ms_.erase(index_id);
+  key_negative_expire_ms_.erase(EncodeVectorIndexCacheKey(index_def_with_id.index_id().parent_entity_id(),
+                                                          index_def_with_id.index_definition().name()));
   auto iter = id_to_index_.find(index_id);
   if (iter != id_to_index_.end()) {
     CHECK_EQ(iter->second->GetName(), index_def_with_id.index_definition().name());
@@ -158,8 +436,12 @@ Status VectorIndexCache::ProcessIndexDefinitionWithId(const pb::meta::IndexDefin
     auto vector_index = std::make_shared<VectorIndex>(index_def_with_id);
     CHECK(index_key_to_id_.insert({GetVectorIndexCacheKey(*vector_index), index_id}).second);
     CHECK(id_to_index_.insert({index_id, vector_index}).second);
+    PublishIdSnapshotUnlocked();
     vector_index->UnMarkStale();
     out_vector_index = vector_index;
+    w.unlock();
+
+    stub_.GetAutoIncrementerManager()->MaybePrewarmVectorIndex(vector_index);
     return Status::OK();
   }
 }
@@ -15,11 +15,15 @@
 #ifndef DINGODB_SDK_VECTOR_INDEX_CACHE_H_
 #define DINGODB_SDK_VECTOR_INDEX_CACHE_H_
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "common/logging.h"
+#include "sdk/utils/single_flight.h"
 #include "sdk/vector.h"
 #include "sdk/vector/vector_index.h"
 
@@ -28,7 +32,13 @@ namespace sdk {
 
 using VectorIndexCacheKey = std::string;
 
-class VectorIndexCache {
+// Concurrent misses of the same index share one coordinator load, and an index not found is remembered for
+// FLAGS_index_cache_negative_ttl_ms. When FLAGS_index_cache_refresh_interval_s > 0 cached definitions are
+// reloaded periodically in actuator, changed ones are replaced and dropped ones are removed.
+// Lookup by id reads an immutable snapshot of id_to_index_ without lock, the snapshot is copied and republished
+// under the write lock on every change, index definitions change rarely compared with lookups.
+// NOTE: client stub must outlive the cache
+class VectorIndexCache : public std::enable_shared_from_this<VectorIndexCache> {
  public:
   VectorIndexCache(const VectorIndexCache &) = delete;
   const VectorIndexCache &operator=(const VectorIndexCache &) = delete;
@@ -47,9 +57,44 @@ class VectorIndexCache {
 
   void RemoveVectorIndexByKey(const VectorIndexCacheKey &index_key);
 
+  // all cached index definitions, used by meta cache snapshot
+  std::vector<pb::meta::IndexDefinitionWithId> ListIndexDefinitions();
+
+  // add index loaded from meta cache snapshot, invalid definition is refused
+  Status AddIndexDefinition(const pb::meta::IndexDefinitionWithId &index_def_with_id);
+
+  // recall profiles are kept apart from index definitions, so they survive index refresh
+  void SetRecallProfile(int64_t index_id, RecallProfile profile);
+
+  bool GetRecallProfile(int64_t index_id, RecallProfile &out_profile) const;
+
+  // scalar samples are kept apart from index definitions too, nullptr when index has no sample
+  void SetScalarSample(int64_t index_id, std::shared_ptr<const std::vector<VectorWithId>> sample);
+
+  std::shared_ptr<const std::vector<VectorWithId>> GetScalarSample(int64_t index_id) const;
+
+  // start periodic refresh, no-op when refresh is disabled
+  void Start();
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  bool IsStopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // reload all cached index definitions
+  void Refresh();
+
  private:
   Status SlowGetVectorIndexByKey(const VectorIndexCacheKey &index_key, std::shared_ptr<VectorIndex> &out_vector_index);
   Status SlowGetVectorIndexById(int64_t index_id, std::shared_ptr<VectorIndex> &out_vector_index);
+  // load from coordinator without dedup
+  Status LoadVectorIndexByKey(const VectorIndexCacheKey &index_key, std::shared_ptr<VectorIndex> &out_vector_index);
+  Status LoadVectorIndexById(int64_t index_id, std::shared_ptr<VectorIndex> &out_vector_index);
+  Status FetchIndexDefinitionById(int64_t index_id, pb::meta::IndexDefinitionWithId &out_index_def_with_id);
+  // replace cached index when its definition changed
+  void UpdateIndexDefinition(const pb::meta::IndexDefinitionWithId &index_def_with_id);
+  void ScheduleRefresh();
+  // must hold write lock
+  void PublishIdSnapshotUnlocked();
   Status ProcessIndexDefinitionWithId(const pb::meta::IndexDefinitionWithId &index_def_with_id,
                                       std::shared_ptr<VectorIndex> &out_vector_index);
 
@@ -60,7 +105,20 @@ class VectorIndexCache {
   const ClientStub &stub_;
   mutable std::shared_mutex rw_lock_;
   std::unordered_map<VectorIndexCacheKey, int64_t> index_key_to_id_;
-  std::unordered_map<int64_t, std::shared_ptr<VectorIndex>> id_to_index_;
+  using IdToIndexMap = std::unordered_map<int64_t, std::shared_ptr<VectorIndex>>;
+  IdToIndexMap id_to_index_;
+  // copy of id_to_index_, only accessed by std::atomic_load/std::atomic_store
+  std::shared_ptr<const IdToIndexMap> id_snapshot_;
+  std::unordered_map<int64_t, RecallProfile> id_to_recall_profile_;
+  std::unordered_map<int64_t, std::shared_ptr<const std::vector<VectorWithId>>> id_to_scalar_sample_;
+
+  SingleFlight<VectorIndexCacheKey> key_flight_;
+  SingleFlight<int64_t> id_flight_;
+  // expire ms of recently not found index
+  std::unordered_map<VectorIndexCacheKey, int64_t> key_negative_expire_ms_;
+  std::unordered_map<int64_t, int64_t> id_negative_expire_ms_;
+
+  std::atomic<bool> stopped_{false};
 };
 
 template <class VectorIndexResponse>
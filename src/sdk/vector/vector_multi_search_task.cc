@@ -0,0 +1,192 @@
+
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_multi_search_task.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/status.h"
+#include "sdk/utils/scoped_cleanup.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// as comparator of heap, the farthest is on the top
+bool CloserDistance(const IndexVectorWithDistance& a, const IndexVectorWithDistance& b) {
+  return a.vector_with_distance.distance < b.vector_with_distance.distance;
+}
+}  // namespace
+
+Status VectorMultiSearchTask::Init() {
+  if (index_ids_.empty()) {
+    return Status::InvalidArgument("index_ids is empty");
+  }
+  if (target_vectors_.empty()) {
+    return Status::InvalidArgument("target_vectors is empty");
+  }
+  if (search_param_.columnar || search_param_.partial_result) {
+    return Status::InvalidArgument("columnar and partial_result are not supported by multi index search");
+  }
+
+  std::unordered_set<int64_t> unique_ids(index_ids_.begin(), index_ids_.end());
+  if (unique_ids.size() != index_ids_.size()) {
+    return Status::InvalidArgument("duplicate index id in index_ids");
+  }
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  index_results_.clear();
+  index_results_.resize(index_ids_.size());
+  next_index_idxes_.clear();
+  for (size_t i = 0; i < index_ids_.size(); i++) {
+    next_index_idxes_.insert(i);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(merge_mutex_);
+    merged_.clear();
+    merged_.resize(target_vectors_.size());
+  }
+
+  return Status::OK();
+}
+
+void VectorMultiSearchTask::DoAsync() {
+  std::set<size_t> next_index_idxes;
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    next_index_idxes = next_index_idxes_;
+    status_ = Status::OK();
+  }
+
+  if (next_index_idxes.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  sub_tasks_count_.store(next_index_idxes.size());
+  RecordFanOut(next_index_idxes.size());
+
+  for (size_t index_idx : next_index_idxes) {
+    // results of a failed search are never merged, a retry searches the index again
+    index_results_[index_idx].clear();
+    auto* sub_task = new VectorSearchTask(stub, index_ids_[index_idx], search_param_, target_vectors_,
+                                          index_results_[index_idx]);
+    sub_task->SetCancelToken(cancel_token_);
+    sub_task->AsyncRun([this, sub_task, index_idx](auto&& s) {
+      SubTaskCallback(std::forward<decltype(s)>(s), sub_task, index_idx);
+    });
+  }
+}
+
+void VectorMultiSearchTask::SubTaskCallback(Status status, VectorSearchTask* sub_task, size_t index_idx) {
+  SCOPED_CLEANUP({ delete sub_task; });
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << Name() << " search index:" << index_ids_[index_idx] << " fail: " << status.ToString();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  } else {
+    MergeIndexResult(index_idx);
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    next_index_idxes_.erase(index_idx);
+  }
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+
+    if (tmp.ok()) {
+      ConstructResult();
+    }
+
+    DoAsyncDone(tmp);
+  }
+}
+
+void VectorMultiSearchTask::MergeIndexResult(size_t index_idx) {
+  int64_t limit = (search_param_.enable_range_search || search_param_.topk <= 0) ? 0 : search_param_.topk;
+  int64_t index_id = index_ids_[index_idx];
+  auto& results = index_results_[index_idx];
+  CHECK_EQ(results.size(), target_vectors_.size()) << "unexpected search result size of index:" << index_id;
+
+  std::lock_guard<std::mutex> guard(merge_mutex_);
+  for (size_t idx = 0; idx < results.size(); idx++) {
+    auto& heap = merged_[idx];
+    for (auto& distance : results[idx].vector_datas) {
+      if (limit > 0 && static_cast<int64_t>(heap.size()) == limit &&
+          distance.distance >= heap.front().vector_with_distance.distance) {
+        continue;
+      }
+
+      IndexVectorWithDistance hit;
+      hit.index_id = index_id;
+      hit.vector_with_distance = std::move(distance);
+      if (limit == 0) {
+        heap.push_back(std::move(hit));
+        continue;
+      }
+
+      if (static_cast<int64_t>(heap.size()) == limit) {
+        std::pop_heap(heap.begin(), heap.end(), CloserDistance);
+        heap.back() = std::move(hit);
+      } else {
+        heap.push_back(std::move(hit));
+      }
+      std::push_heap(heap.begin(), heap.end(), CloserDistance);
+    }
+  }
+  results.clear();
+}
+
+void VectorMultiSearchTask::ConstructResult() {
+  bool bounded = !search_param_.enable_range_search && search_param_.topk > 0;
+
+  std::lock_guard<std::mutex> guard(merge_mutex_);
+  out_result_.clear();
+  out_result_.reserve(target_vectors_.size());
+  for (size_t idx = 0; idx < target_vectors_.size(); idx++) {
+    MultiIndexSearchResult result;
+    //  NOTE: use copy
+    result.id.vector = target_vectors_[idx].vector;
+
+    auto& hits = merged_[idx];
+    if (bounded) {
+      // max heap by distance, sort_heap leaves it in ascending order
+      std::sort_heap(hits.begin(), hits.end(), CloserDistance);
+    } else {
+      std::stable_sort(hits.begin(), hits.end(), CloserDistance);
+    }
+    result.vector_datas = std::move(hits);
+    out_result_.push_back(std::move(result));
+  }
+  merged_.clear();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
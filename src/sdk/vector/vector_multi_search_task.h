@@ -0,0 +1,88 @@
+
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_MULTI_SEARCH_TASK_H_
+#define DINGODB_SDK_VECTOR_MULTI_SEARCH_TASK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+#include "fmt/ranges.h"
+#include "sdk/client_stub.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_search_task.h"
+#include "sdk/vector/vector_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Search several indexes concurrently, one VectorSearchTask per index fans out to its partitions, results of an
+// index are merged into the topk of each target vector as soon as its search is done.
+class VectorMultiSearchTask : public VectorTask {
+ public:
+  VectorMultiSearchTask(const ClientStub& stub, const std::vector<int64_t>& index_ids, const SearchParam& search_param,
+                        const std::vector<VectorWithId>& target_vectors,
+                        std::vector<MultiIndexSearchResult>& out_result)
+      : VectorTask(stub),
+        index_ids_(index_ids),
+        search_param_(search_param),
+        target_vectors_(target_vectors),
+        out_result_(out_result) {}
+
+  ~VectorMultiSearchTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+
+  std::string Name() const override { return fmt::format("VectorMultiSearchTask-{}", fmt::join(index_ids_, ",")); }
+
+  void SubTaskCallback(Status status, VectorSearchTask* sub_task, size_t index_idx);
+
+  void MergeIndexResult(size_t index_idx);
+
+  void ConstructResult();
+
+  const std::vector<int64_t>& index_ids_;
+  const SearchParam& search_param_;
+  const std::vector<VectorWithId>& target_vectors_;
+  std::vector<MultiIndexSearchResult>& out_result_;
+
+  // index_ids_ idx to results of the index, filled by its sub task
+  std::vector<std::vector<SearchResult>> index_results_;
+
+  // target_vectors_ idx to max heap by distance when bounded by topk, otherwise all hits unordered
+  std::mutex merge_mutex_;
+  std::vector<std::vector<IndexVectorWithDistance>> merged_;
+
+  std::shared_mutex rw_lock_;
+  // index_ids_ idx of indexes not searched yet
+  std::set<size_t> next_index_idxes_;
+  Status status_;
+
+  std::atomic<int> sub_tasks_count_{0};
+};
+
+}  // namespace sdk
+
+}  // namespace dingodb
+#endif  // DINGODB_SDK_VECTOR_MULTI_SEARCH_TASK_H_
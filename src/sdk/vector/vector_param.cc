@@ -22,6 +22,7 @@
 
 #include "fmt/core.h"
 #include "fmt/ranges.h"
+#include "glog/logging.h"
 #include "sdk/types.h"
 #include "sdk/vector.h"
 
@@ -39,7 +40,7 @@ std::string Vector::ToString() const {
 
   std::stringstream binary_ss;
   for (size_t i = 0; i < binary_values.size(); ++i) {
-    binary_ss << binary_values[i];
+    binary_ss << static_cast<int>(binary_values[i]);
     if (i != binary_values.size() - 1) {
       binary_ss << ", ";
     }
@@ -97,6 +98,211 @@ std::string VectorWithId::ToString() const {
   return ss.str();
 }
 
+int32_t ScalarBatch::KeyIndex(const std::string& key) const {
+  auto iter = key_indexes_.find(key);
+  return iter == key_indexes_.end() ? -1 : iter->second;
+}
+
+Type ScalarBatch::GetType(int32_t key_index, int64_t row) const {
+  CHECK_LT(row, rows_) << "row out of range";
+  return columns_[key_index].cells[row].type;
+}
+
+int32_t ScalarBatch::FieldCount(int32_t key_index, int64_t row) const {
+  CHECK_LT(row, rows_) << "row out of range";
+  return columns_[key_index].cells[row].field_count;
+}
+
+const ScalarBatch::Field& ScalarBatch::GetField(int32_t key_index, int64_t row, int32_t field) const {
+  CHECK_LT(field, FieldCount(key_index, row)) << "field out of range";
+  const Column& column = columns_[key_index];
+  return column.fields[column.cells[row].field_start + field];
+}
+
+bool ScalarBatch::GetBool(int32_t key_index, int64_t row, int32_t field) const {
+  return GetField(key_index, row, field).bool_data;
+}
+
+int64_t ScalarBatch::GetLong(int32_t key_index, int64_t row, int32_t field) const {
+  return GetField(key_index, row, field).long_data;
+}
+
+double ScalarBatch::GetDouble(int32_t key_index, int64_t row, int32_t field) const {
+  return GetField(key_index, row, field).double_data;
+}
+
+std::string_view ScalarBatch::GetString(int32_t key_index, int64_t row, int32_t field) const {
+  const StringRef& ref = GetField(key_index, row, field).string_data;
+  return std::string_view(columns_[key_index].strings.data() + ref.offset, ref.size);
+}
+
+std::map<std::string, ScalarValue> ScalarBatch::GetScalarData(int64_t row) const {
+  std::map<std::string, ScalarValue> scalar_data;
+  for (int32_t key_index = 0; key_index < columns_.size(); ++key_index) {
+    Type type = GetType(key_index, row);
+    if (type == kTypeEnd) {
+      continue;
+    }
+
+    ScalarValue value;
+    value.type = type;
+    value.fields.resize(FieldCount(key_index, row));
+    for (int32_t i = 0; i < value.fields.size(); ++i) {
+      auto& field = value.fields[i];
+      switch (type) {
+        case kBOOL:
+          field.bool_data = GetBool(key_index, row, i);
+          break;
+        case kINT64:
+          field.long_data = GetLong(key_index, row, i);
+          break;
+        case kDOUBLE:
+          field.double_data = GetDouble(key_index, row, i);
+          break;
+        default:
+          field.string_data = GetString(key_index, row, i);
+          break;
+      }
+    }
+    scalar_data.emplace(keys_[key_index], std::move(value));
+  }
+  return scalar_data;
+}
+
+void ScalarBatch::Append(const std::map<std::string, ScalarValue>& scalar_data) {
+  for (const auto& [key, value] : scalar_data) {
+    AppendValue(key, value.type);
+    for (const auto& field : value.fields) {
+      switch (value.type) {
+        case kBOOL:
+          AppendBoolField(field.bool_data);
+          break;
+        case kINT64:
+          AppendLongField(field.long_data);
+          break;
+        case kDOUBLE:
+          AppendDoubleField(field.double_data);
+          break;
+        default:
+          AppendStringField(field.string_data);
+          break;
+      }
+    }
+  }
+  FinishRow();
+}
+
+void ScalarBatch::AppendRow(const ScalarBatch& other, int64_t row) {
+  CHECK_LT(row, other.Size()) << "row out of range";
+  for (int32_t key_index = 0; key_index < other.columns_.size(); ++key_index) {
+    Type type = other.GetType(key_index, row);
+    if (type == kTypeEnd) {
+      continue;
+    }
+
+    AppendValue(other.keys_[key_index], type);
+    for (int32_t i = 0; i < other.FieldCount(key_index, row); ++i) {
+      if (type == kSTRING || type == kBYTES) {
+        AppendStringField(other.GetString(key_index, row, i));
+      } else {
+        AppendField(other.GetField(key_index, row, i));
+      }
+    }
+  }
+  FinishRow();
+}
+
+void ScalarBatch::AppendValue(const std::string& key, Type type) {
+  auto [iter, inserted] = key_indexes_.emplace(key, static_cast<int32_t>(keys_.size()));
+  if (inserted) {
+    keys_.push_back(key);
+    columns_.emplace_back();
+  }
+  current_ = iter->second;
+
+  auto& column = columns_[current_];
+  // rows before this one have no such key
+  column.cells.resize(rows_);
+  column.cells.push_back({type, static_cast<uint32_t>(column.fields.size()), 0});
+}
+
+void ScalarBatch::AppendField(Field field) {
+  CHECK_GE(current_, 0) << "AppendValue must be called before its fields";
+  auto& column = columns_[current_];
+  column.fields.push_back(field);
+  column.cells.back().field_count++;
+}
+
+void ScalarBatch::AppendBoolField(bool value) {
+  Field field{};
+  field.bool_data = value;
+  AppendField(field);
+}
+
+void ScalarBatch::AppendLongField(int64_t value) {
+  Field field{};
+  field.long_data = value;
+  AppendField(field);
+}
+
+void ScalarBatch::AppendDoubleField(double value) {
+  Field field{};
+  field.double_data = value;
+  AppendField(field);
+}
+
+void ScalarBatch::AppendStringField(std::string_view value) {
+  CHECK_GE(current_, 0) << "AppendValue must be called before its fields";
+  auto& strings = columns_[current_].strings;
+  Field field{};
+  field.string_data = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+  strings.append(value.data(), value.size());
+  AppendField(field);
+}
+
+void ScalarBatch::FinishRow() {
+  rows_++;
+  for (auto& column : columns_) {
+    column.cells.resize(rows_);
+  }
+  current_ = -1;
+}
+
+void ScalarBatch::Clear() {
+  keys_.clear();
+  key_indexes_.clear();
+  columns_.clear();
+  rows_ = 0;
+  current_ = -1;
+}
+
+std::string ScalarBatch::ToString() const {
+  return fmt::format("ScalarBatch {{ size: {}, keys: [{}] }}", rows_, fmt::join(keys_, ", "));
+}
+
+int32_t RecallProfile::PickParam(float target_recall) const {
+  for (const auto& point : points) {
+    if (point.recall >= target_recall) {
+      return point.param;
+    }
+  }
+
+  return points.empty() ? 0 : points.back().param;
+}
+
+std::string RecallProfile::ToString() const {
+  std::ostringstream oss;
+  oss << "RecallProfile: { param_type: " << static_cast<int>(param_type) << ", topk: " << topk << ", points: [";
+  for (size_t i = 0; i < points.size(); ++i) {
+    oss << "{" << points[i].param << ", " << points[i].recall << "}";
+    if (i != points.size() - 1) {
+      oss << ", ";
+    }
+  }
+  oss << "] }";
+  return oss.str();
+}
+
 std::string VectorWithDistance::ToString() const {
   return fmt::format("VectorWithDistance {{ vector: {}, distance: {}, metric_type: {} }}", vector_data.ToString(),
                      distance, MetricTypeToString(metric_type));
@@ -112,10 +318,29 @@ std::string SearchResult::ToString() const {
   return oss.str();
 }
 
+std::string CompactSearchResult::ToString() const {
+  std::ostringstream oss;
+  oss << "CompactSearchResult { targets: [";
+  for (int64_t target = 0; target < TargetCount(); ++target) {
+    oss << "[";
+    for (int64_t j = offsets[target]; j < offsets[target + 1]; ++j) {
+      oss << fmt::format("{{ id: {}, distance: {} }}, ", ids[j], distances[j]);
+    }
+    oss << "], ";
+  }
+  oss << "]}";
+  return oss.str();
+}
+
 std::string DeleteResult::ToString() const {
   return fmt::format("DeleteResult {{ vector_id: {}, deleted: {} }}", vector_id, (deleted ? "true" : "false"));
 }
 
+std::string DeleteByFilterRegionResult::ToString() const {
+  return fmt::format("DeleteByFilterRegionResult {{ region_id: {}, scanned_count: {}, deleted_count: {} }}", region_id,
+                     scanned_count, deleted_count);
+}
+
 std::string QueryResult::ToString() const {
   std::ostringstream oss;
   oss << "QueryResult: {";
@@ -0,0 +1,248 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_payload_cache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// bytes of vector data, 0 when vector has no data of its dimension
+int64_t PayloadBytes(const Vector& vector) {
+  if (vector.dimension <= 0) {
+    return 0;
+  }
+  if (vector.value_type == kFloat && static_cast<int64_t>(vector.float_values.size()) == vector.dimension) {
+    return vector.dimension * sizeof(float);
+  }
+  if (vector.value_type == kUint8 && static_cast<int64_t>(vector.binary_values.size()) == vector.dimension) {
+    return vector.dimension;
+  }
+  return 0;
+}
+}  // namespace
+
+VectorPayloadCache::IndexFile::~IndexFile() {
+  if (data != nullptr) {
+    munmap(data, record_size * slot_ids.size());
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+VectorPayloadCache::VectorPayloadCache(std::string dir, int64_t capacity) : dir_(std::move(dir)), capacity_(capacity) {}
+
+VectorPayloadCache::~VectorPayloadCache() = default;
+
+uint64_t VectorPayloadCache::IndexVersionUnlocked(int64_t index_id) const {
+  auto iter = index_versions_.find(index_id);
+  return iter == index_versions_.end() ? 0 : iter->second;
+}
+
+uint64_t VectorPayloadCache::IndexVersion(int64_t index_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return IndexVersionUnlocked(index_id);
+}
+
+bool VectorPayloadCache::OpenUnlocked(int64_t index_id, IndexFile& file, const Vector& vector) {
+  int64_t record_size = (PayloadBytes(vector) + kRecordAlign - 1) / kRecordAlign * kRecordAlign;
+  std::string path = fmt::format("{}/dingo_sdk_vector_cache_{}_XXXXXX", dir_, index_id);
+  int fd = mkstemp(path.data());
+  if (fd < 0) {
+    DINGO_LOG(WARNING) << fmt::format("create vector payload cache file in {} fail, error:{}", dir_, strerror(errno));
+    return false;
+  }
+
+  // unlink at once, space is released when fd is closed
+  unlink(path.c_str());
+  file.fd = fd;
+  if (ftruncate(fd, record_size * capacity_) != 0) {
+    DINGO_LOG(WARNING) << fmt::format("truncate vector payload cache file to {} bytes fail, error:{}",
+                                      record_size * capacity_, strerror(errno));
+    return false;
+  }
+
+  void* data = mmap(nullptr, record_size * capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    DINGO_LOG(WARNING) << fmt::format("mmap vector payload cache file of {} bytes fail, error:{}",
+                                      record_size * capacity_, strerror(errno));
+    return false;
+  }
+
+  file.data = static_cast<char*>(data);
+  file.record_size = record_size;
+  file.dimension = vector.dimension;
+  file.value_type = vector.value_type;
+  file.slot_ids.assign(capacity_, 0);
+  file.referenced.assign(capacity_, 0);
+  DINGO_LOG(INFO) << fmt::format("open vector payload cache file: {}, index_id:{}, record_size:{}, capacity:{}", path,
+                                 index_id, record_size, capacity_);
+  return true;
+}
+
+VectorPayloadCache::IndexFile* VectorPayloadCache::GetOrOpenUnlocked(int64_t index_id, const Vector& vector) {
+  auto iter = files_.find(index_id);
+  if (iter == files_.end()) {
+    auto file = std::make_unique<IndexFile>();
+    file->broken = !OpenUnlocked(index_id, *file, vector);
+    iter = files_.emplace(index_id, std::move(file)).first;
+  }
+  return iter->second->broken ? nullptr : iter->second.get();
+}
+
+int64_t VectorPayloadCache::AllocSlotUnlocked(IndexFile& file) {
+  // free slot or the first one not referenced since the hand passed it
+  while (true) {
+    int64_t slot = file.hand;
+    file.hand = (file.hand + 1) % capacity_;
+    if (file.slot_ids[slot] == 0) {
+      return slot;
+    }
+    if (file.referenced[slot] == 0) {
+      file.slots.erase(file.slot_ids[slot]);
+      file.slot_ids[slot] = 0;
+      return slot;
+    }
+    file.referenced[slot] = 0;
+  }
+}
+
+bool VectorPayloadCache::Get(int64_t index_id, int64_t vector_id, Vector& out_vector) {
+  if (!Enabled()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto file_iter = files_.find(index_id);
+  if (file_iter == files_.end() || file_iter->second->broken) {
+    return false;
+  }
+
+  IndexFile& file = *file_iter->second;
+  auto iter = file.slots.find(vector_id);
+  if (iter == file.slots.end()) {
+    return false;
+  }
+
+  file.referenced[iter->second] = 1;
+  const char* record = file.data + iter->second * file.record_size;
+  out_vector = Vector(file.value_type, file.dimension);
+  if (file.value_type == kFloat) {
+    out_vector.float_values.resize(file.dimension);
+    memcpy(out_vector.float_values.data(), record, file.dimension * sizeof(float));
+  } else {
+    out_vector.binary_values.assign(record, record + file.dimension);
+  }
+  return true;
+}
+
+void VectorPayloadCache::Put(int64_t index_id, const std::vector<VectorWithId>& vectors, uint64_t version) {
+  if (!Enabled()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (version != IndexVersionUnlocked(index_id)) {
+    return;
+  }
+
+  IndexFile* file = nullptr;
+  for (const auto& vector_with_id : vectors) {
+    const Vector& vector = vector_with_id.vector;
+    if (vector_with_id.id <= 0 || PayloadBytes(vector) == 0) {
+      continue;
+    }
+
+    if (file == nullptr) {
+      file = GetOrOpenUnlocked(index_id, vector);
+      if (file == nullptr) {
+        return;
+      }
+    }
+    if (vector.dimension != file->dimension || vector.value_type != file->value_type) {
+      continue;
+    }
+
+    int64_t slot;
+    auto iter = file->slots.find(vector_with_id.id);
+    if (iter != file->slots.end()) {
+      slot = iter->second;
+    } else {
+      slot = AllocSlotUnlocked(*file);
+      file->slots.emplace(vector_with_id.id, slot);
+      file->slot_ids[slot] = vector_with_id.id;
+    }
+
+    char* record = file->data + slot * file->record_size;
+    if (vector.value_type == kFloat) {
+      memcpy(record, vector.float_values.data(), vector.dimension * sizeof(float));
+    } else {
+      memcpy(record, vector.binary_values.data(), vector.dimension);
+    }
+  }
+}
+
+void VectorPayloadCache::Invalidate(int64_t index_id, const std::vector<int64_t>& vector_ids) {
+  if (!Enabled()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  index_versions_[index_id]++;
+
+  auto file_iter = files_.find(index_id);
+  if (file_iter == files_.end()) {
+    return;
+  }
+
+  IndexFile& file = *file_iter->second;
+  for (const auto& vector_id : vector_ids) {
+    auto iter = file.slots.find(vector_id);
+    if (iter != file.slots.end()) {
+      file.slot_ids[iter->second] = 0;
+      file.referenced[iter->second] = 0;
+      file.slots.erase(iter);
+    }
+  }
+}
+
+int64_t VectorPayloadCache::Size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  int64_t size = 0;
+  for (const auto& [index_id, file] : files_) {
+    size += file->slots.size();
+  }
+  return size;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
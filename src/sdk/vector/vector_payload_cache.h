@@ -0,0 +1,103 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_PAYLOAD_CACHE_H_
+#define DINGODB_SDK_VECTOR_PAYLOAD_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Local cache of vector data by vector id, disabled when dir is empty or capacity <= 0.
+// Each index has a file in dir mapped into memory, holding at most capacity records of fixed size aligned to
+// kRecordAlign, so hot vectors are served from page cache or local disk instead of the store. Record size follows
+// dimension and value type of the first vector put, vectors not of them are not cached. Full files evict by CLOCK.
+// Scalar and table data are not cached, they are variable size.
+// Writes through the same client erase the written ids and bump the version of the index, vectors fetched before
+// a write are never put.
+class VectorPayloadCache {
+ public:
+  VectorPayloadCache(const VectorPayloadCache&) = delete;
+  const VectorPayloadCache& operator=(const VectorPayloadCache&) = delete;
+
+  VectorPayloadCache(std::string dir, int64_t capacity);
+
+  ~VectorPayloadCache();
+
+  static const int64_t kRecordAlign = 64;
+
+  bool Enabled() const { return !dir_.empty() && capacity_ > 0; }
+
+  // reader must take version before sending rpc and pass it to Put
+  uint64_t IndexVersion(int64_t index_id);
+
+  bool Get(int64_t index_id, int64_t vector_id, Vector& out_vector);
+
+  // vectors without data are skipped, ignored when index is written after `version`
+  void Put(int64_t index_id, const std::vector<VectorWithId>& vectors, uint64_t version);
+
+  // called before and after every write to the index
+  void Invalidate(int64_t index_id, const std::vector<int64_t>& vector_ids);
+
+  int64_t Size();
+
+ private:
+  struct IndexFile {
+    ~IndexFile();
+
+    int fd{-1};
+    char* data{nullptr};
+    int64_t record_size{0};
+    int32_t dimension{0};
+    ValueType value_type{kNoneValueType};
+    // file or mmap fail, vectors of index are not cached
+    bool broken{false};
+
+    // vector id to slot
+    std::unordered_map<int64_t, int64_t> slots;
+    // vector id of each slot, 0 means free
+    std::vector<int64_t> slot_ids;
+    // CLOCK reference bit of each slot
+    std::vector<uint8_t> referenced;
+    int64_t hand{0};
+  };
+
+  IndexFile* GetOrOpenUnlocked(int64_t index_id, const Vector& vector);
+
+  bool OpenUnlocked(int64_t index_id, IndexFile& file, const Vector& vector);
+
+  int64_t AllocSlotUnlocked(IndexFile& file);
+
+  uint64_t IndexVersionUnlocked(int64_t index_id) const;
+
+  const std::string dir_;
+  const int64_t capacity_;
+
+  std::mutex mutex_;
+  std::unordered_map<int64_t, std::unique_ptr<IndexFile>> files_;
+  // index id to write version, absent means 0
+  std::unordered_map<int64_t, uint64_t> index_versions_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_VECTOR_PAYLOAD_CACHE_H_
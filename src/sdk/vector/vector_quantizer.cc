@@ -0,0 +1,144 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+static constexpr float kQuantizeMaxCode = 255.0f;
+
+Status ScalarQuantizer::Train(const std::vector<Vector>& samples) {
+  if (samples.empty()) {
+    return Status::InvalidArgument("samples is empty");
+  }
+
+  size_t dimension = samples[0].float_values.size();
+  if (dimension == 0) {
+    return Status::InvalidArgument("sample dimension is 0");
+  }
+
+  std::vector<float> mins(samples[0].float_values);
+  std::vector<float> maxs(samples[0].float_values);
+  for (const auto& sample : samples) {
+    if (sample.value_type == ValueType::kUint8 || sample.float_values.size() != dimension) {
+      return Status::InvalidArgument(
+          fmt::format("sample should be float vector of dimension:{}, sample:{}", dimension, sample.ToString()));
+    }
+
+    for (size_t i = 0; i < dimension; ++i) {
+      mins[i] = std::min(mins[i], sample.float_values[i]);
+      maxs[i] = std::max(maxs[i], sample.float_values[i]);
+    }
+  }
+
+  std::vector<float> scales(dimension);
+  for (size_t i = 0; i < dimension; ++i) {
+    // constant dimension, any positive scale encodes it as 0
+    scales[i] = maxs[i] > mins[i] ? (maxs[i] - mins[i]) / kQuantizeMaxCode : 1.0f;
+  }
+
+  mins_ = std::move(mins);
+  scales_ = std::move(scales);
+  return Status::OK();
+}
+
+Status ScalarQuantizer::Init(std::vector<float> mins, std::vector<float> scales) {
+  if (mins.empty() || mins.size() != scales.size()) {
+    return Status::InvalidArgument(
+        fmt::format("mins size:{} and scales size:{} should be same and not 0", mins.size(), scales.size()));
+  }
+
+  for (const auto& scale : scales) {
+    if (!(scale > 0)) {
+      return Status::InvalidArgument(fmt::format("scale:{} should be positive", scale));
+    }
+  }
+
+  mins_ = std::move(mins);
+  scales_ = std::move(scales);
+  return Status::OK();
+}
+
+Status ScalarQuantizer::Quantize(const Vector& from, Vector& to) const {
+  if (!IsTrained()) {
+    return Status::IllegalState("quantizer is not trained");
+  }
+
+  if (from.value_type == ValueType::kUint8 || from.float_values.size() != mins_.size()) {
+    return Status::InvalidArgument(
+        fmt::format("vector should be float vector of dimension:{}, vector:{}", mins_.size(), from.ToString()));
+  }
+
+  std::vector<uint8_t> codes(mins_.size());
+  for (size_t i = 0; i < mins_.size(); ++i) {
+    float code = std::round((from.float_values[i] - mins_[i]) / scales_[i]);
+    codes[i] = static_cast<uint8_t>(std::clamp(code, 0.0f, kQuantizeMaxCode));
+  }
+
+  to.dimension = Dimension();
+  to.value_type = ValueType::kUint8;
+  to.float_values.clear();
+  to.binary_values = std::move(codes);
+  return Status::OK();
+}
+
+Status ScalarQuantizer::Quantize(std::vector<VectorWithId>& vectors) const {
+  for (auto& vector_with_id : vectors) {
+    if (vector_with_id.vector.value_type == ValueType::kUint8) {
+      continue;
+    }
+
+    Status s = Quantize(vector_with_id.vector, vector_with_id.vector);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status ScalarQuantizer::Dequantize(const Vector& from, Vector& to) const {
+  if (!IsTrained()) {
+    return Status::IllegalState("quantizer is not trained");
+  }
+
+  if (from.value_type != ValueType::kUint8 || from.binary_values.size() != mins_.size()) {
+    return Status::InvalidArgument(
+        fmt::format("vector should be uint8 vector of dimension:{}, vector:{}", mins_.size(), from.ToString()));
+  }
+
+  std::vector<float> values(mins_.size());
+  for (size_t i = 0; i < mins_.size(); ++i) {
+    values[i] = mins_[i] + scales_[i] * from.binary_values[i];
+  }
+
+  to.dimension = Dimension();
+  to.value_type = ValueType::kFloat;
+  to.binary_values.clear();
+  to.float_values = std::move(values);
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
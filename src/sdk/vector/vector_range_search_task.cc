@@ -0,0 +1,220 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_range_search_task.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "proto/common.pb.h"
+#include "proto/index.pb.h"
+#include "sdk/common/common.h"
+#include "sdk/expression/filter_internal_data.h"
+#include "sdk/expression/langchain_expr_cache.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+Status VectorRangeSearchTask::Init() {
+  if (target_vectors_.empty()) {
+    return Status::InvalidArgument("target_vectors is empty");
+  }
+  if (!search_param_.enable_range_search) {
+    return Status::InvalidArgument("enable_range_search is not set");
+  }
+  if (search_param_.columnar || search_param_.post_filter || search_param_.partial_result) {
+    return Status::InvalidArgument("columnar, post_filter and partial_result are not supported by range search stream");
+  }
+  if (option_.max_results < 0) {
+    return Status::InvalidArgument("max_results is negative");
+  }
+  if (!handler_) {
+    return Status::InvalidArgument("handler is invalid");
+  }
+
+  std::shared_ptr<VectorIndex> tmp;
+  DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
+  DCHECK_NOTNULL(tmp);
+  vector_index_ = std::move(tmp);
+
+  auto* request = request_template_.Mutable();
+  request->Clear();
+  auto* parameter = request->mutable_parameter();
+  FillInternalSearchParams(parameter, vector_index_->GetVectorIndexType(), search_param_);
+  if (search_param_.filter != nullptr) {
+    if (search_param_.filter_type == FilterType::kQueryAuto) {
+      // no topk to pick by, pre filter is exact
+      parameter->set_vector_filter_type(pb::common::VectorFilterType::QUERY_PRE);
+    }
+    const auto* schema = vector_index_->HasScalarSchema() ? &vector_index_->GetScalarSchema() : nullptr;
+    DINGO_RETURN_NOT_OK(search_param_.filter->GetData().GetOrCompile(
+        vector_index_->GetScalarSchemaVersion(), schema, *(parameter->mutable_vector_coprocessor())));
+  } else if (!search_param_.langchain_expr_json.empty()) {
+    const auto* schema = vector_index_->HasScalarSchema() ? &vector_index_->GetScalarSchema() : nullptr;
+    DINGO_RETURN_NOT_OK(stub.GetLangchainExprCache()->GetOrCompile(search_param_.langchain_expr_json,
+                                                                  vector_index_->GetScalarSchemaVersion(), schema,
+                                                                  *(parameter->mutable_vector_coprocessor())));
+  }
+
+  for (const auto& target : target_vectors_) {
+    // NOTE* vector_id is useless
+    FillVectorWithIdPB(request->add_vector_with_ids(), target, false);
+  }
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  done_region_ids_.clear();
+  delivered_count_ = 0;
+  stopped_.store(false);
+  return Status::OK();
+}
+
+void VectorRangeSearchTask::DoAsync() {
+  std::vector<std::shared_ptr<Region>> regions;
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    for (const auto& part_id : vector_index_->GetPartitionIds()) {
+      std::vector<std::shared_ptr<Region>> part_regions;
+      Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id, part_regions);
+      if (!s.ok()) {
+        r.unlock();
+        DoAsyncDone(s);
+        return;
+      }
+
+      for (auto& region : part_regions) {
+        if (done_region_ids_.count(region->RegionId()) == 0) {
+          regions.push_back(std::move(region));
+        }
+      }
+    }
+  }
+
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    status_ = Status::OK();
+  }
+
+  if (regions.empty() || stopped_.load()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  controllers_.clear();
+  rpcs_.clear();
+  for (const auto& region : regions) {
+    auto rpc = std::make_unique<VectorSearchRpc>();
+    request_template_.FillRequest(rpc->MutableRequest(), region);
+    controllers_.emplace_back(stub, *rpc, region);
+    rpcs_.push_back(std::move(rpc));
+  }
+
+  DCHECK_EQ(rpcs_.size(), controllers_.size());
+
+  size_t rpc_num = rpcs_.size();
+  sub_tasks_count_.store(rpc_num);
+  RecordFanOut(rpc_num);
+
+  // the last callback may finish and free this task before AsyncCall returns, so the loop keeps its bound local
+  for (size_t i = 0; i < rpc_num; i++) {
+    controllers_[i].AsyncCall([this, rpc = rpcs_[i].get()](auto&& s) {
+      VectorSearchRpcCallback(std::forward<decltype(s)>(s), rpc);
+    });
+  }
+}
+
+void VectorRangeSearchTask::VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc) {
+  if (!status.ok()) {
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  } else {
+    Deliver(rpc);
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    done_region_ids_.insert(rpc->Request()->context().region_id());
+  }
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      // regions not delivered are useless once stopped
+      tmp = stopped_.load() ? Status::OK() : status_;
+    }
+    DoAsyncDone(tmp);
+  }
+}
+
+void VectorRangeSearchTask::Deliver(VectorSearchRpc* rpc) {
+  const auto& response = *rpc->Response();
+  int64_t size = std::min<int64_t>(response.batch_results_size(), target_vectors_.size());
+  if (response.batch_results_size() != rpc->Request()->vector_with_ids_size()) {
+    DINGO_LOG(INFO) << Name() << " rpc: " << rpc->Method()
+                    << " request vector_with_ids_size: " << rpc->Request()->vector_with_ids_size()
+                    << " response batch_results_size: " << response.batch_results_size();
+  }
+
+  std::lock_guard<std::mutex> guard(deliver_mutex_);
+  if (stopped_.load()) {
+    return;
+  }
+
+  // only hits within max_results are converted
+  std::vector<std::vector<VectorWithDistance>> hits(target_vectors_.size());
+  int64_t count = 0;
+  for (int64_t i = 0; i < size; i++) {
+    const auto& distances = response.batch_results(i).vector_with_distances();
+    int64_t take = distances.size();
+    if (option_.max_results > 0) {
+      take = std::min(take, option_.max_results - delivered_count_ - count);
+    }
+
+    auto& to_put = hits[i];
+    to_put.reserve(take);
+    for (int64_t j = 0; j < take; j++) {
+      to_put.push_back(InternalVectorWithDistance2VectorWithDistance(distances.Get(j)));
+    }
+    if (option_.sorted) {
+      std::sort(to_put.begin(), to_put.end(), [](const VectorWithDistance& a, const VectorWithDistance& b) {
+        return a.distance < b.distance;
+      });
+    }
+    count += take;
+  }
+
+  delivered_count_ += count;
+  if (option_.max_results > 0 && delivered_count_ >= option_.max_results) {
+    stopped_.store(true);
+  }
+
+  if (count > 0 && !handler_(hits)) {
+    stopped_.store(true);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_RANGE_SEARCH_TASK_H_
+#define DINGODB_SDK_VECTOR_RANGE_SEARCH_TASK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+#include "sdk/client_stub.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_request_template.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Range search of all regions of the index, hits of a region are handed to handler as soon as its response arrives,
+// unlike VectorSearchTask nothing is kept after the handler returns.
+class VectorRangeSearchTask : public VectorTask {
+ public:
+  VectorRangeSearchTask(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                        const std::vector<VectorWithId>& target_vectors, const RangeSearchStreamOption& option,
+                        RangeSearchHandler handler)
+      : VectorTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        target_vectors_(target_vectors),
+        option_(option),
+        handler_(std::move(handler)) {}
+
+  ~VectorRangeSearchTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+
+  std::string Name() const override { return fmt::format("VectorRangeSearchTask-{}", index_id_); }
+
+  void VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc);
+
+  // hand hits of the response to handler, the stream is stopped when handler returns false or max_results reached
+  void Deliver(VectorSearchRpc* rpc);
+
+  const int64_t index_id_;
+  const SearchParam& search_param_;
+  const std::vector<VectorWithId>& target_vectors_;
+  const RangeSearchStreamOption option_;
+  RangeSearchHandler handler_;
+
+  std::shared_ptr<VectorIndex> vector_index_;
+  // parameter and all target vectors, one rpc per region
+  RequestTemplate<pb::index::VectorSearchRequest> request_template_;
+
+  std::vector<StoreRpcController> controllers_;
+  std::vector<std::unique_ptr<VectorSearchRpc>> rpcs_;
+
+  // handler is called one at a time
+  std::mutex deliver_mutex_;
+  int64_t delivered_count_{0};
+  std::atomic<bool> stopped_{false};
+
+  std::shared_mutex rw_lock_;
+  // regions delivered already, not searched again when the task retries
+  std::set<int64_t> done_region_ids_;
+  Status status_;
+
+  std::atomic<int> sub_tasks_count_{0};
+};
+
+}  // namespace sdk
+
+}  // namespace dingodb
+#endif  // DINGODB_SDK_VECTOR_RANGE_SEARCH_TASK_H_
@@ -0,0 +1,207 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_scan_cursor_internal_data.h"
+#include "sdk/vector/vector_scan_query_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// ScanQueryParam is move only, columnar is not copied as pages are moved into caller vectors
+void CopyScanQueryParam(const ScanQueryParam& from, ScanQueryParam& to) {
+  to.vector_id_start = from.vector_id_start;
+  to.vector_id_end = from.vector_id_end;
+  to.max_scan_count = from.max_scan_count;
+  to.is_reverse = from.is_reverse;
+  to.with_vector_data = from.with_vector_data;
+  to.with_scalar_data = from.with_scalar_data;
+  to.selected_keys = from.selected_keys;
+  to.with_table_data = from.with_table_data;
+  to.use_scalar_filter = from.use_scalar_filter;
+  to.scalar_data = from.scalar_data;
+}
+}  // namespace
+
+VectorScanCursor::Data::~Data() {
+  std::unique_lock<std::mutex> lk(mutex);
+  cond.wait(lk, [this] { return page == nullptr || page->done; });
+}
+
+Status VectorScanCursor::Data::Init(const ScanQueryParam& query_param) {
+  if (query_param.max_scan_count <= 0) {
+    return Status::InvalidArgument("max_scan_count must bigger than 0");
+  }
+
+  if (query_param.is_reverse) {
+    if (!(query_param.vector_id_end < query_param.vector_id_start)) {
+      return Status::InvalidArgument("vector_id_end must be less than vector_id_start in reverse scan");
+    }
+  } else {
+    if (query_param.vector_id_end != 0 && !(query_param.vector_id_start < query_param.vector_id_end)) {
+      return Status::InvalidArgument("vector_id_end must be greater than vector_id_start in forward scan");
+    }
+  }
+
+  std::shared_ptr<VectorIndex> vector_index;
+  DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id, vector_index));
+  DCHECK_NOTNULL(vector_index);
+
+  CopyScanQueryParam(query_param, param);
+  next_start = param.vector_id_start;
+
+  // partition ids are in order of their start vector id
+  int64_t min_id = param.is_reverse ? param.vector_id_end : param.vector_id_start;
+  int64_t max_id = param.is_reverse ? param.vector_id_start : param.vector_id_end;
+  int64_t first_part_id = vector_index->GetPartitionId(std::max<int64_t>(min_id, 1));
+  int64_t last_part_id = max_id > 0 ? vector_index->GetPartitionId(max_id) : -1;
+
+  bool in_range = false;
+  for (const auto& part_id : vector_index->GetPartitionIds()) {
+    if (part_id == first_part_id) {
+      in_range = true;
+    }
+    if (in_range) {
+      part_ids.push_back(part_id);
+    }
+    if (part_id == last_part_id) {
+      break;
+    }
+  }
+  CHECK(!part_ids.empty()) << "not found partition of index:" << index_id;
+
+  if (param.is_reverse) {
+    std::reverse(part_ids.begin(), part_ids.end());
+  }
+
+  return Status::OK();
+}
+
+bool VectorScanCursor::Data::InRange(int64_t vector_id) const {
+  if (param.is_reverse) {
+    return vector_id <= param.vector_id_start && vector_id >= param.vector_id_end;
+  } else {
+    return vector_id >= param.vector_id_start && (param.vector_id_end == 0 || vector_id <= param.vector_id_end);
+  }
+}
+
+void VectorScanCursor::Data::StartPage() {
+  CHECK(page == nullptr);
+  CHECK_LT(part_idx, part_ids.size());
+
+  auto tmp = std::make_unique<Page>();
+  CopyScanQueryParam(param, tmp->param);
+  tmp->param.vector_id_start = next_start;
+  // range is [start, end], scan task needs start != end, ids out of range are dropped in Advance
+  if (param.is_reverse && tmp->param.vector_id_end >= next_start) {
+    tmp->param.vector_id_end = next_start - 1;
+  } else if (!param.is_reverse && tmp->param.vector_id_end != 0 && tmp->param.vector_id_end <= next_start) {
+    tmp->param.vector_id_end = next_start + 1;
+  }
+
+  tmp->task = std::make_unique<VectorScanQueryTask>(stub, index_id, tmp->param, tmp->result,
+                                                    std::vector<int64_t>{part_ids[part_idx]});
+  Page* raw = tmp.get();
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    page = std::move(tmp);
+  }
+
+  raw->task->AsyncRun([this, raw](Status status) {
+    std::unique_lock<std::mutex> lk(mutex);
+    raw->status = std::move(status);
+    raw->done = true;
+    // notify under lock, cursor may be destroyed as soon as it sees page done
+    cond.notify_all();
+  });
+}
+
+std::unique_ptr<VectorScanCursor::Data::Page> VectorScanCursor::Data::WaitPage() {
+  std::unique_lock<std::mutex> lk(mutex);
+  cond.wait(lk, [this] { return page->done; });
+  return std::move(page);
+}
+
+void VectorScanCursor::Data::Advance(Page& done_page, std::vector<VectorWithId>& out_vectors) {
+  auto& vectors = done_page.result.vectors;
+  bool full = static_cast<int64_t>(vectors.size()) >= param.max_scan_count;
+  int64_t last_id = vectors.empty() ? 0 : vectors.back().id;
+
+  for (auto& vector : vectors) {
+    if (InRange(vector.id)) {
+      out_vectors.push_back(std::move(vector));
+    }
+  }
+
+  if (full) {
+    // same partition may have more
+    next_start = param.is_reverse ? last_id - 1 : last_id + 1;
+    if (next_start <= 0 || !InRange(next_start)) {
+      finished = true;
+    }
+  } else {
+    part_idx++;
+    if (part_idx >= part_ids.size()) {
+      finished = true;
+    }
+  }
+}
+
+VectorScanCursor::VectorScanCursor(Data* data) : data_(data) {}
+
+VectorScanCursor::~VectorScanCursor() { delete data_; }
+
+bool VectorScanCursor::HasNext() const { return !data_->finished; }
+
+Status VectorScanCursor::Next(std::vector<VectorWithId>& out_vectors) {
+  out_vectors.clear();
+
+  while (!data_->finished) {
+    // page is only set and taken by caller thread
+    if (data_->page == nullptr) {
+      data_->StartPage();
+    }
+    std::unique_ptr<Data::Page> current = data_->WaitPage();
+
+    // position not moved, next call scans the same page again
+    DINGO_RETURN_NOT_OK(current->status);
+
+    data_->Advance(*current, out_vectors);
+    if (!data_->finished) {
+      // prefetch while caller handles this page
+      data_->StartPage();
+    }
+
+    if (!out_vectors.empty()) {
+      break;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,85 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_SCAN_CURSOR_DATA_H_
+#define DINGODB_SDK_VECTOR_SCAN_CURSOR_DATA_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_scan_query_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+class VectorScanCursor::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  Data(const ClientStub& stub, int64_t index_id) : stub(stub), index_id(index_id) {}
+
+  // wait in flight page
+  ~Data();
+
+  // check param and plan partitions to scan in id order
+  Status Init(const ScanQueryParam& query_param);
+
+  // one page scanned from one partition
+  struct Page {
+    ScanQueryParam param;
+    ScanQueryResult result;
+    std::unique_ptr<VectorScanQueryTask> task;
+    // protected by mutex
+    bool done{false};
+    Status status;
+  };
+
+  // start scan page of current position
+  void StartPage();
+
+  // wait page started and take it
+  std::unique_ptr<Page> WaitPage();
+
+  // move vectors of page into out_vectors and move position after them
+  void Advance(Page& page, std::vector<VectorWithId>& out_vectors);
+
+  bool InRange(int64_t vector_id) const;
+
+  const ClientStub& stub;
+  const int64_t index_id;
+
+  ScanQueryParam param;
+  // partitions intersect with scan range, in scan order
+  std::vector<int64_t> part_ids;
+  size_t part_idx{0};
+  int64_t next_start{0};
+  bool finished{false};
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  // in flight or done page of current position
+  std::unique_ptr<Page> page;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_SCAN_CURSOR_DATA_H_
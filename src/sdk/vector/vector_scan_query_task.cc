@@ -49,7 +49,7 @@ Status VectorScanQueryTask::Init() {
   vector_index_ = std::move(tmp);
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
-  auto part_ids = vector_index_->GetPartitionIds();
+  auto part_ids = part_ids_.empty() ? vector_index_->GetPartitionIds() : part_ids_;
 
   for (const auto& part_id : part_ids) {
     next_part_ids_.emplace(part_id);
@@ -72,6 +72,7 @@ void VectorScanQueryTask::DoAsync() {
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
     auto* sub_task = new VectorScanQueryPartTask(stub, vector_index_, part_id, scan_query_param_);
@@ -93,6 +94,12 @@ void VectorScanQueryTask::SubTaskCallback(Status status, VectorScanQueryPartTask
   } else {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     std::vector<VectorWithId> vectors = sub_task->GetResult();
+    if (scan_query_param_.columnar) {
+      for (int64_t row = 0; row < vectors.size(); ++row) {
+        result_rows_.emplace_back(part_batches_.size(), row);
+      }
+      part_batches_.push_back(sub_task->GetResultBatch());
+    }
     for (auto& result : vectors) {
       CHECK(vector_ids_.find(result.id) == vector_ids_.end()) << "scan query find duplicate vector id: " << result.id;
       result_vectors_.push_back(std::move(result));
@@ -113,6 +120,11 @@ void VectorScanQueryTask::SubTaskCallback(Status status, VectorScanQueryPartTask
 }
 
 void VectorScanQueryTask::ConstructResultUnlocked() {
+  if (scan_query_param_.columnar) {
+    ConstructColumnarResultUnlocked();
+    return;
+  }
+
   if (scan_query_param_.is_reverse) {
     std::sort(result_vectors_.begin(), result_vectors_.end(),
               [](const VectorWithId& a, const VectorWithId& b) { return a.id > b.id; });
@@ -128,10 +140,38 @@ void VectorScanQueryTask::ConstructResultUnlocked() {
   out_result_.vectors = std::move(result_vectors_);
 }
 
+void VectorScanQueryTask::ConstructColumnarResultUnlocked() {
+  // sort positions instead, so scalar rows follow their vectors
+  std::vector<size_t> order(result_vectors_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  bool is_reverse = scan_query_param_.is_reverse;
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return is_reverse ? result_vectors_[a].id > result_vectors_[b].id : result_vectors_[a].id < result_vectors_[b].id;
+  });
+
+  if (order.size() > scan_query_param_.max_scan_count) {
+    order.resize(scan_query_param_.max_scan_count);
+  }
+
+  out_result_.vectors.clear();
+  out_result_.vectors.reserve(order.size());
+  out_result_.scalar_batch.Clear();
+  for (size_t i : order) {
+    out_result_.vectors.push_back(std::move(result_vectors_[i]));
+    const auto& [batch, row] = result_rows_[i];
+    out_result_.scalar_batch.AppendRow(part_batches_[batch], row);
+  }
+
+  result_vectors_.clear();
+  result_rows_.clear();
+  part_batches_.clear();
+}
+
 void VectorScanQueryPartTask::DoAsync() {
-  const auto& range = vector_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> regions;
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -140,6 +180,7 @@ void VectorScanQueryPartTask::DoAsync() {
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     result_vectors_.clear();
+    result_batch_.Clear();
     status_ = Status::OK();
   }
 
@@ -150,8 +191,7 @@ void VectorScanQueryPartTask::DoAsync() {
     auto rpc = std::make_unique<VectorScanQueryRpc>();
     FillVectorScanQueryRpcRequest(rpc->MutableRequest(), region);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+    controllers_.emplace_back(stub, *rpc, region);
 
     rpcs_.push_back(std::move(rpc));
   }
@@ -160,6 +200,7 @@ void VectorScanQueryPartTask::DoAsync() {
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
   sub_tasks_count_.store(regions.size());
+  RecordFanOut(regions.size());
 
   for (auto i = 0; i < regions.size(); i++) {
     auto& controller = controllers_[i];
@@ -199,8 +240,8 @@ void VectorScanQueryPartTask::FillVectorScanQueryRpcRequest(pb::index::VectorSca
 
 void VectorScanQueryPartTask::VectorScanQueryRpcCallback(Status status, VectorScanQueryRpc* rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -211,7 +252,11 @@ void VectorScanQueryPartTask::VectorScanQueryRpcCallback(Status status, VectorSc
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
       for (const auto& vectorid_pb : rpc->Response()->vectors()) {
-        result_vectors_.emplace_back(InternalVectorIdPB2VectorWithId(vectorid_pb));
+        if (scan_query_param_.columnar) {
+          result_vectors_.emplace_back(InternalVectorIdPB2VectorWithId(vectorid_pb, result_batch_));
+        } else {
+          result_vectors_.emplace_back(InternalVectorIdPB2VectorWithId(vectorid_pb));
+        }
       }
     }
   }
@@ -16,6 +16,8 @@
 #define DINGODB_SDK_VECTOR_SCAN_QUERY_TATSK_H_
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "sdk/client_stub.h"
 #include "proto/index.pb.h"
@@ -32,9 +34,14 @@ class VectorScanQueryPartTask;
 
 class VectorScanQueryTask : public VectorTask {
  public:
+  // part_ids restricts scan to these partitions, empty means all partitions
   VectorScanQueryTask(const ClientStub& stub, int64_t index_id, const ScanQueryParam& query_param,
-                      ScanQueryResult& out_result)
-      : VectorTask(stub), index_id_(index_id), scan_query_param_(query_param), out_result_(out_result) {}
+                      ScanQueryResult& out_result, std::vector<int64_t> part_ids = {})
+      : VectorTask(stub),
+        index_id_(index_id),
+        scan_query_param_(query_param),
+        out_result_(out_result),
+        part_ids_(std::move(part_ids)) {}
 
   ~VectorScanQueryTask() override = default;
 
@@ -47,15 +54,20 @@ class VectorScanQueryTask : public VectorTask {
   void SubTaskCallback(Status status, VectorScanQueryPartTask* sub_task);
 
   void ConstructResultUnlocked();
+  void ConstructColumnarResultUnlocked();
 
   const int64_t index_id_;
   const ScanQueryParam& scan_query_param_;
   ScanQueryResult& out_result_;
+  const std::vector<int64_t> part_ids_;
 
   std::shared_ptr<VectorIndex> vector_index_;
 
   std::shared_mutex rw_lock_;
   std::vector<VectorWithId> result_vectors_;
+  // when scan_query_param_.columnar, scalar data of finished parts and the part batch and row of result_vectors_[i]
+  std::vector<ScalarBatch> part_batches_;
+  std::vector<std::pair<size_t, int64_t>> result_rows_;
   std::set<int64_t> vector_ids_;  // for unique check
   std::set<int64_t> next_part_ids_;
   Status status_;
@@ -76,6 +88,12 @@ class VectorScanQueryPartTask : public VectorTask {
     return result_vectors_;
   }
 
+  // row i is the scalar data of GetResult()[i] when scan_query_param_.columnar
+  ScalarBatch GetResultBatch() {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    return std::move(result_batch_);
+  }
+
  private:
   friend class VectorScanQueryTask;
 
@@ -98,6 +116,7 @@ class VectorScanQueryPartTask : public VectorTask {
 
   std::shared_mutex rw_lock_;
   std::vector<VectorWithId> result_vectors_;
+  ScalarBatch result_batch_;
   Status status_;
 
   std::atomic<int> sub_tasks_count_{0};
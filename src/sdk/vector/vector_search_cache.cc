@@ -0,0 +1,153 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_search_cache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+std::string VectorSearchCache::EncodeKey(int64_t index_id, const std::string& key) {
+  std::string encoded(sizeof(index_id), '\0');
+  memcpy(encoded.data(), &index_id, sizeof(index_id));
+  encoded.append(key);
+  return encoded;
+}
+
+int64_t VectorSearchCache::EstimateBytes(const std::vector<SearchResult>& result) {
+  int64_t bytes = 0;
+  for (const auto& search_result : result) {
+    bytes += sizeof(SearchResult) + search_result.id.vector.Size();
+    for (const auto& distance : search_result.vector_datas) {
+      bytes += sizeof(VectorWithDistance) + distance.vector_data.vector.Size();
+      for (const auto& [key, value] : distance.vector_data.scalar_data) {
+        bytes += key.size() + sizeof(ScalarValue);
+        for (const auto& field : value.fields) {
+          bytes += sizeof(ScalarField) + field.string_data.size();
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
+uint64_t VectorSearchCache::IndexVersionUnlocked(int64_t index_id) const {
+  auto iter = index_versions_.find(index_id);
+  return iter == index_versions_.end() ? 0 : iter->second;
+}
+
+uint64_t VectorSearchCache::IndexVersion(int64_t index_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return IndexVersionUnlocked(index_id);
+}
+
+void VectorSearchCache::EraseUnlocked(std::unordered_map<std::string_view, EntryList::iterator>::iterator iter) {
+  auto entry_iter = iter->second;
+  bytes_ -= entry_iter->bytes;
+  // erase index first, its key points into the entry
+  index_.erase(iter);
+  lru_.erase(entry_iter);
+}
+
+bool VectorSearchCache::Get(int64_t index_id, const std::string& key, std::vector<SearchResult>& out_result) {
+  if (!Enabled()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = index_.find(EncodeKey(index_id, key));
+  if (iter == index_.end()) {
+    return false;
+  }
+
+  const Entry& entry = *iter->second;
+  if (entry.expire_ms <= NowMs() || entry.version != IndexVersionUnlocked(index_id)) {
+    EraseUnlocked(iter);
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, iter->second);
+  out_result = entry.result;
+  return true;
+}
+
+void VectorSearchCache::Put(int64_t index_id, const std::string& key, const std::vector<SearchResult>& result,
+                            uint64_t version) {
+  if (!Enabled()) {
+    return;
+  }
+
+  std::string encoded = EncodeKey(index_id, key);
+  int64_t bytes = encoded.size() + EstimateBytes(result);
+  if (bytes > capacity_bytes_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (version != IndexVersionUnlocked(index_id)) {
+    return;
+  }
+
+  auto iter = index_.find(encoded);
+  if (iter != index_.end()) {
+    EraseUnlocked(iter);
+  }
+
+  lru_.push_front({std::move(encoded), version, result, bytes, NowMs() + ttl_ms_});
+  index_.emplace(lru_.front().key, lru_.begin());
+  bytes_ += bytes;
+
+  while (bytes_ > capacity_bytes_) {
+    bytes_ -= lru_.back().bytes;
+    index_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+}
+
+void VectorSearchCache::InvalidateIndex(int64_t index_id) {
+  if (!Enabled()) {
+    return;
+  }
+
+  // entries of old version are dropped lazily by Get or LRU
+  std::lock_guard<std::mutex> guard(mutex_);
+  index_versions_[index_id]++;
+}
+
+int64_t VectorSearchCache::Bytes() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return bytes_;
+}
+
+int64_t VectorSearchCache::Size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return lru_.size();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_SEARCH_CACHE_H_
+#define DINGODB_SDK_VECTOR_SEARCH_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+// LRU cache of vector search results, disabled when capacity_bytes <= 0.
+// Key is the index id and the encoded search request (parameter and target vectors), so only identical
+// searches hit. Entries expire after ttl, and are bounded by approximate bytes of keys and results.
+// Writes through the same client bump the version of the written index, entries and searches in flight
+// of an older version are never served.
+class VectorSearchCache {
+ public:
+  VectorSearchCache(const VectorSearchCache&) = delete;
+  const VectorSearchCache& operator=(const VectorSearchCache&) = delete;
+
+  VectorSearchCache(int64_t capacity_bytes, int64_t ttl_ms) : capacity_bytes_(capacity_bytes), ttl_ms_(ttl_ms) {}
+
+  ~VectorSearchCache() = default;
+
+  bool Enabled() const { return capacity_bytes_ > 0; }
+
+  // searcher must take version before sending rpc and pass it to Put
+  uint64_t IndexVersion(int64_t index_id);
+
+  bool Get(int64_t index_id, const std::string& key, std::vector<SearchResult>& out_result);
+
+  // ignored when index is written after `version`
+  void Put(int64_t index_id, const std::string& key, const std::vector<SearchResult>& result, uint64_t version);
+
+  // called before and after every write to the index
+  void InvalidateIndex(int64_t index_id);
+
+  int64_t Bytes();
+
+  int64_t Size();
+
+ private:
+  struct Entry {
+    std::string key;
+    uint64_t version;
+    std::vector<SearchResult> result;
+    int64_t bytes;
+    int64_t expire_ms;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  static std::string EncodeKey(int64_t index_id, const std::string& key);
+
+  static int64_t EstimateBytes(const std::vector<SearchResult>& result);
+
+  uint64_t IndexVersionUnlocked(int64_t index_id) const;
+
+  void EraseUnlocked(std::unordered_map<std::string_view, EntryList::iterator>::iterator iter);
+
+  const int64_t capacity_bytes_;
+  const int64_t ttl_ms_;
+
+  std::mutex mutex_;
+  int64_t bytes_{0};
+  // front is the most recently used
+  EntryList lru_;
+  // keys point into entries, request keys can be large
+  std::unordered_map<std::string_view, EntryList::iterator> index_;
+  // index id to write version, absent means 0
+  std::unordered_map<int64_t, uint64_t> index_versions_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_VECTOR_SEARCH_CACHE_H_
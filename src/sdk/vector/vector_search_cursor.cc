@@ -0,0 +1,144 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_search_cursor_internal_data.h"
+#include "sdk/vector/vector_search_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// SearchParam is move only, topk is set by every fetch
+void CopySearchParam(const SearchParam& from, SearchParam& to) {
+  to.with_vector_data = from.with_vector_data;
+  to.with_scalar_data = from.with_scalar_data;
+  to.selected_keys = from.selected_keys;
+  to.with_table_data = from.with_table_data;
+  to.filter_source = from.filter_source;
+  to.filter_type = from.filter_type;
+  to.is_negation = from.is_negation;
+  to.is_sorted = from.is_sorted;
+  to.vector_ids = from.vector_ids;
+  to.use_brute_force = from.use_brute_force;
+  to.extra_params = from.extra_params;
+  to.langchain_expr_json = from.langchain_expr_json;
+  to.filter = from.filter;
+  to.target_recall = from.target_recall;
+}
+}  // namespace
+
+Status VectorSearchCursor::Data::Init(const SearchParam& search_param, const VectorWithId& target_vector) {
+  if (page_size <= 0) {
+    return Status::InvalidArgument("page_size must bigger than 0");
+  }
+  // a short result must mean the index has no more hits
+  if (search_param.enable_range_search || search_param.post_filter || search_param.partial_result) {
+    return Status::InvalidArgument("range search, post_filter and partial_result are not supported by search cursor");
+  }
+  if (search_param.columnar) {
+    return Status::InvalidArgument("columnar is not supported by search cursor");
+  }
+
+  CopySearchParam(search_param, param);
+  target_vectors.push_back(target_vector);
+  return Status::OK();
+}
+
+void VectorSearchCursor::Data::ExpireHits(int64_t now_ms, int64_t ttl_ms) {
+  if (hits.empty() || now_ms - fetch_ms <= ttl_ms) {
+    return;
+  }
+
+  hits.clear();
+  exhausted = false;
+}
+
+Status VectorSearchCursor::Data::Fetch(int64_t now_ms) {
+  // doubling keeps the number of searches logarithmic in the depth paged to
+  int64_t need = static_cast<int64_t>(returned_ids.size()) + page_size;
+  int64_t next_topk = std::min<int64_t>(std::max<int64_t>(need, topk * 2LL), std::numeric_limits<int32_t>::max());
+  param.topk = static_cast<int32_t>(next_topk);
+
+  std::vector<SearchResult> results;
+  VectorSearchTask task(stub, index_id, param, target_vectors, results);
+  DINGO_RETURN_NOT_OK(task.Run());
+  CHECK_EQ(results.size(), target_vectors.size()) << "unexpected search result size";
+
+  Refill(results[0].vector_datas, param.topk, now_ms);
+  return Status::OK();
+}
+
+void VectorSearchCursor::Data::Refill(std::vector<VectorWithDistance>& search_hits, int32_t search_topk,
+                                      int64_t now_ms) {
+  topk = search_topk;
+  exhausted = static_cast<int64_t>(search_hits.size()) < search_topk;
+  fetch_ms = now_ms;
+
+  hits.clear();
+  for (auto& hit : search_hits) {
+    if (returned_ids.count(hit.vector_data.id) == 0) {
+      hits.push_back(std::move(hit));
+    }
+  }
+}
+
+void VectorSearchCursor::Data::TakePage(std::vector<VectorWithDistance>& out_page) {
+  while (!hits.empty() && static_cast<int64_t>(out_page.size()) < page_size) {
+    returned_ids.insert(hits.front().vector_data.id);
+    out_page.push_back(std::move(hits.front()));
+    hits.pop_front();
+  }
+}
+
+VectorSearchCursor::VectorSearchCursor(Data* data) : data_(data) {}
+
+VectorSearchCursor::~VectorSearchCursor() { delete data_; }
+
+bool VectorSearchCursor::HasNext() const { return !data_->Finished(); }
+
+Status VectorSearchCursor::Next(std::vector<VectorWithDistance>& out_page) {
+  out_page.clear();
+  if (data_->Finished()) {
+    return Status::OK();
+  }
+
+  int64_t now_ms = NowMs();
+  data_->ExpireHits(now_ms, FLAGS_vector_search_cursor_ttl_ms);
+  if (!data_->PageReady()) {
+    // kept hits are untouched on error, next call searches again
+    DINGO_RETURN_NOT_OK(data_->Fetch(now_ms));
+  }
+
+  data_->TakePage(out_page);
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
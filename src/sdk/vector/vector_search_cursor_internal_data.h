@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_SEARCH_CURSOR_DATA_H_
+#define DINGODB_SDK_VECTOR_SEARCH_CURSOR_DATA_H_
+
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+class VectorSearchCursor::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  Data(const ClientStub& stub, int64_t index_id, int32_t page_size)
+      : stub(stub), index_id(index_id), page_size(page_size) {}
+
+  ~Data() = default;
+
+  // check and copy param, the search is not run until the first page
+  Status Init(const SearchParam& search_param, const VectorWithId& target_vector);
+
+  // hits kept are dropped after ttl, pages after them search again
+  void ExpireHits(int64_t now_ms, int64_t ttl_ms);
+
+  // search again with topk raised to cover the next page, at least twice the last topk
+  Status Fetch(int64_t now_ms);
+
+  // hits of a search of search_topk in ascending order of distance replace the kept ones, ids returned before are
+  // skipped
+  void Refill(std::vector<VectorWithDistance>& search_hits, int32_t search_topk, int64_t now_ms);
+
+  // a page can be taken without search
+  bool PageReady() const { return static_cast<int64_t>(hits.size()) >= page_size || exhausted; }
+
+  // move at most page_size kept hits into out_page
+  void TakePage(std::vector<VectorWithDistance>& out_page);
+
+  bool Finished() const { return exhausted && hits.empty(); }
+
+  const ClientStub& stub;
+  const int64_t index_id;
+  const int32_t page_size;
+
+  SearchParam param;
+  std::vector<VectorWithId> target_vectors;
+
+  // merged hits of the last search not returned yet, in ascending order of distance
+  std::deque<VectorWithDistance> hits;
+  std::unordered_set<int64_t> returned_ids;
+  // topk of the last search, 0 before the first one
+  int32_t topk{0};
+  // the last search returned less than topk, the index has no more hits
+  bool exhausted{false};
+  int64_t fetch_ms{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_SEARCH_CURSOR_DATA_H_
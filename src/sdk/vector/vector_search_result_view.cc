@@ -0,0 +1,93 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_search_result_view_internal_data.h"
+
+namespace dingodb {
+namespace sdk {
+
+const pb::common::VectorWithDistance& SearchResultView::Data::Hit(int64_t target, int64_t hit) const {
+  CHECK_LT(target, static_cast<int64_t>(hits.size())) << "target out of range";
+  CHECK_LT(hit, static_cast<int64_t>(hits[target].size())) << "hit out of range";
+  return *hits[target][hit];
+}
+
+SearchResultView::SearchResultView() : data_(std::make_unique<Data>()) {}
+
+SearchResultView::~SearchResultView() = default;
+
+SearchResultView::SearchResultView(SearchResultView&& other) noexcept = default;
+
+SearchResultView& SearchResultView::operator=(SearchResultView&& other) noexcept = default;
+
+int64_t SearchResultView::TargetCount() const { return data_ == nullptr ? 0 : data_->hits.size(); }
+
+int64_t SearchResultView::HitCount(int64_t target) const {
+  CHECK_LT(target, TargetCount()) << "target out of range";
+  return data_->hits[target].size();
+}
+
+int64_t SearchResultView::GetId(int64_t target, int64_t hit) const {
+  return data_->Hit(target, hit).vector_with_id().id();
+}
+
+float SearchResultView::GetDistance(int64_t target, int64_t hit) const { return data_->Hit(target, hit).distance(); }
+
+Vector SearchResultView::GetVector(int64_t target, int64_t hit) const {
+  // scalar data is left in the response
+  return InternalVectorIdPB2VectorWithIdWithoutScalar(data_->Hit(target, hit).vector_with_id()).vector;
+}
+
+std::map<std::string, ScalarValue> SearchResultView::GetScalarData(int64_t target, int64_t hit) const {
+  std::map<std::string, ScalarValue> scalar_data;
+  for (const auto& [key, value] : data_->Hit(target, hit).vector_with_id().scalar_data().scalar_data()) {
+    scalar_data.emplace(key, InternalScalarValuePB2ScalarValue(value));
+  }
+  return scalar_data;
+}
+
+VectorWithDistance SearchResultView::GetHit(int64_t target, int64_t hit) const {
+  return InternalVectorWithDistance2VectorWithDistance(data_->Hit(target, hit));
+}
+
+std::vector<SearchResult> SearchResultView::ToSearchResults() const {
+  std::vector<SearchResult> results(TargetCount());
+  for (int64_t target = 0; target < TargetCount(); ++target) {
+    auto& vector_datas = results[target].vector_datas;
+    vector_datas.reserve(HitCount(target));
+    for (int64_t hit = 0; hit < HitCount(target); ++hit) {
+      vector_datas.push_back(GetHit(target, hit));
+    }
+  }
+  return results;
+}
+
+CompactSearchResult SearchResultView::ToCompactSearchResult(bool with_vector_data, bool with_scalar_data) const {
+  if (data_ == nullptr) {
+    return InternalHitsPB2CompactSearchResult({}, with_vector_data, with_scalar_data);
+  }
+  return InternalHitsPB2CompactSearchResult(data_->hits, with_vector_data, with_scalar_data);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
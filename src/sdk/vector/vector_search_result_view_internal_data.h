@@ -0,0 +1,39 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_SEARCH_RESULT_VIEW_INTERNAL_DATA_H_
+#define DINGODB_SDK_VECTOR_SEARCH_RESULT_VIEW_INTERNAL_DATA_H_
+
+#include <memory>
+#include <vector>
+
+#include "proto/common.pb.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SearchResultView::Data {
+ public:
+  const pb::common::VectorWithDistance& Hit(int64_t target, int64_t hit) const;
+
+  // target vector idx to hits, point into responses of owners
+  std::vector<std::vector<const pb::common::VectorWithDistance*>> hits;
+  // rpcs and arenas of the responses
+  std::vector<std::shared_ptr<const void>> owners;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+#endif  // DINGODB_SDK_VECTOR_SEARCH_RESULT_VIEW_INTERNAL_DATA_H_
@@ -14,9 +14,14 @@
 
 #include "sdk/vector/vector_search_task.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <set>
+#include <string>
 
 #include "common/logging.h"
 #include "glog/logging.h"
@@ -24,17 +29,53 @@
 #include "proto/index.pb.h"
 #include "sdk/common/common.h"
 #include "sdk/common/param_config.h"
-#include "sdk/expression/langchain_expr.h"
-#include "sdk/expression/langchain_expr_encoder.h"
-#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/expression/filter_internal_data.h"
+#include "sdk/expression/langchain_expr_cache.h"
 #include "sdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
 #include "sdk/vector.h"
 #include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_distance.h"
+#include "sdk/vector/vector_helper.h"
+#include "sdk/vector/vector_search_result_view_internal_data.h"
 
 namespace dingodb {
 namespace sdk {
 
+namespace {
+bool CompareDistance(const VectorWithDistance& a, const VectorWithDistance& b) { return a.distance < b.distance; }
+
+bool ComparePbDistance(const pb::common::VectorWithDistance* a, const pb::common::VectorWithDistance* b) {
+  return a->distance() < b->distance();
+}
+
+int64_t SearchResultLimit(bool enable_range_search, int64_t topk) {
+  if (enable_range_search || topk <= 0) {
+    return 0;
+  }
+  return topk;
+}
+
+SearchResult NewSearchResult(const VectorWithId& target) {
+  VectorWithId tmp;
+  {
+    //  NOTE: use copy
+    const Vector& to_copy = target.vector;
+    tmp.vector.dimension = to_copy.dimension;
+    tmp.vector.value_type = to_copy.value_type;
+    tmp.vector.float_values = to_copy.float_values;
+    tmp.vector.binary_values = to_copy.binary_values;
+  }
+
+  return SearchResult(std::move(tmp));
+}
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
 Status VectorSearchTask::Init() {
   if (target_vectors_.empty()) {
     return Status::InvalidArgument("target_vectors is empty");
@@ -47,51 +88,344 @@ Status VectorSearchTask::Init() {
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
 
-  auto part_ids = vector_index_->GetPartitionIds();
+  target_results_.clear();
+  target_results_.reserve(target_vectors_.size());
+  for (size_t i = 0; i < target_vectors_.size(); i++) {
+    target_results_.push_back(std::make_unique<TargetResult>());
+  }
+  distance_thresholds_ = std::vector<std::atomic<float>>(target_vectors_.size());
+  for (auto& threshold : distance_thresholds_) {
+    threshold.store(std::numeric_limits<float>::max());
+  }
+
+  part_id_to_filter_keys_.clear();
+  prune_by_vector_ids_ = search_param_.filter_source == FilterSource::kVectorIdFilter &&
+                         !search_param_.is_negation && !search_param_.vector_ids.empty();
+  if (prune_by_vector_ids_) {
+    // only partitions holding the filter ids can have candidates
+    for (const auto& vector_id : search_param_.vector_ids) {
+      if (vector_id <= 0) {
+        continue;
+      }
+      int64_t part_id = vector_index_->GetPartitionId(vector_id);
+      part_id_to_filter_keys_[part_id].push_back(vector_helper::VectorIdToRangeKey(*vector_index_, vector_id));
+    }
+
+    for (auto& [part_id, keys] : part_id_to_filter_keys_) {
+      std::sort(keys.begin(), keys.end());
+      next_part_ids_.emplace(part_id);
+    }
 
-  for (const auto& part_id : part_ids) {
-    next_part_ids_.emplace(part_id);
+    if (next_part_ids_.empty()) {
+      // no valid filter id, every target vector gets empty result
+      ConstructResultUnlocked();
+    }
+  } else {
+    auto part_ids = vector_index_->GetPartitionIds();
+
+    for (const auto& part_id : part_ids) {
+      next_part_ids_.emplace(part_id);
+    }
   }
 
   {
     // prepare search parameter
     FillInternalSearchParams(&search_parameter_, vector_index_->GetVectorIndexType(), search_param_);
-    if (!search_param_.langchain_expr_json.empty()) {
-      std::shared_ptr<expression::LangchainExpr> expr;
-
-      std::unique_ptr<expression::LangchainExprFactory> expr_factory;
-      if (vector_index_->HasScalarSchema()) {
-        expr_factory = std::make_unique<expression::SchemaLangchainExprFactory>(vector_index_->GetScalarSchema());
-      } else {
-        expr_factory = std::make_unique<expression::LangchainExprFactory>();
+    if (search_param_.target_recall > 0) {
+      FillSearchParamByTargetRecall();
+    }
+    post_filter_ = search_param_.post_filter && search_param_.filter != nullptr;
+    if (search_param_.filter_type == FilterType::kQueryAuto && !post_filter_) {
+      FillFilterTypeBySelectivity();
+    }
+    if (post_filter_ && out_view_ != nullptr) {
+      return Status::InvalidArgument("post_filter is not supported by search result view");
+    }
+    partial_ = search_param_.partial_result;
+    if (partial_ && out_view_ != nullptr) {
+      return Status::InvalidArgument("partial_result is not supported by search result view");
+    }
+    missing_part_ids_.clear();
+    missing_region_ids_.clear();
+    if (post_filter_) {
+      post_filter_keys_ =
+          search_param_.filter->GetData().KeysToFetch(search_param_.with_scalar_data, search_param_.selected_keys);
+      search_parameter_.set_without_scalar_data(false);
+      search_parameter_.clear_selected_keys();
+      for (const auto& key : post_filter_keys_) {
+        search_parameter_.add_selected_keys(key);
+      }
+    }
+    client_exact_ = UseClientExactSearch();
+    bool with_payload = search_param_.with_vector_data || search_param_.with_scalar_data ||
+                        search_param_.with_table_data || post_filter_;
+    // a view converts nothing, so payload of candidates not in topk costs only bytes on the wire, and a partial
+    // search has no time left for the second phase
+    two_phase_fetch_ =
+        FLAGS_vector_search_two_phase_fetch && with_payload && out_view_ == nullptr && !partial_ && !client_exact_;
+    if (two_phase_fetch_) {
+      // payload of candidates not in final topk is useless, fetch it later by vector id
+      search_parameter_.set_without_vector_data(true);
+      search_parameter_.set_without_scalar_data(true);
+      search_parameter_.set_without_table_data(true);
+      search_parameter_.clear_selected_keys();
+    }
+    metric_type_ = vector_index_->GetMetricType();
+    rerank_ = FLAGS_vector_search_exact_rerank && search_param_.with_vector_data && out_view_ == nullptr &&
+              !client_exact_ &&
+              vector_index_->GetVectorIndexType() == VectorIndexType::kIvfPq &&
+              metric_type_ != MetricType::kNoneMetricType && ResultLimit() > 0;
+    if (rerank_ && FLAGS_vector_search_rerank_factor > 1) {
+      // result limit of this task and part tasks follows top_n
+      search_parameter_.set_top_n(search_param_.topk * FLAGS_vector_search_rerank_factor);
+    }
+    if (search_param_.filter != nullptr && !post_filter_) {
+      const auto* schema = vector_index_->HasScalarSchema() ? &vector_index_->GetScalarSchema() : nullptr;
+      DINGO_RETURN_NOT_OK(search_param_.filter->GetData().GetOrCompile(
+          vector_index_->GetScalarSchemaVersion(), schema, *(search_parameter_.mutable_vector_coprocessor())));
+    } else if (!search_param_.langchain_expr_json.empty()) {
+      const auto* schema = vector_index_->HasScalarSchema() ? &vector_index_->GetScalarSchema() : nullptr;
+      DINGO_RETURN_NOT_OK(stub.GetLangchainExprCache()->GetOrCompile(
+          search_param_.langchain_expr_json, vector_index_->GetScalarSchemaVersion(), schema,
+          *(search_parameter_.mutable_vector_coprocessor())));
+    }
+  }
+
+  {
+    // encode target vectors once for all partitions and regions, a batch is sent to each region in one rpc
+    request_templates_.clear();
+    batch_offsets_.clear();
+    pb::index::VectorSearchRequest* request = nullptr;
+    int64_t batch_bytes = 0;
+    for (size_t i = 0; i < target_vectors_.size(); i++) {
+      bool batch_full =
+          request != nullptr &&
+          ((FLAGS_vector_search_batch_max_count > 0 &&
+            request->vector_with_ids_size() >= FLAGS_vector_search_batch_max_count) ||
+           (FLAGS_vector_search_batch_max_bytes > 0 && batch_bytes >= FLAGS_vector_search_batch_max_bytes));
+      if (request == nullptr || batch_full) {
+        request_templates_.emplace_back();
+        batch_offsets_.push_back(i);
+        request = request_templates_.back().Mutable();
+        *(request->mutable_parameter()) = search_parameter_;
+        batch_bytes = 0;
       }
-      DINGO_RETURN_NOT_OK(expr_factory->CreateExpr(search_param_.langchain_expr_json, expr));
 
-      expression::LangChainExprEncoder encoder;
-      *(search_parameter_.mutable_vector_coprocessor()) = encoder.EncodeToCoprocessor(expr.get());
+      // NOTE* vector_id is useless
+      auto* vector_pb = request->add_vector_with_ids();
+      FillVectorWithIdPB(vector_pb, target_vectors_[i], false);
+      batch_bytes += vector_pb->ByteSizeLong();
     }
   }
 
+  payload_cache_version_ = stub.GetVectorPayloadCache()->IndexVersion(index_id_);
+
+  if (out_view_ == nullptr && LookupCache()) {
+    // nothing to search
+    next_part_ids_.clear();
+    fetch_pending_ = false;
+  }
+
   return Status::OK();
 }
 
+bool VectorSearchTask::LookupCache() {
+  auto cache = stub.GetVectorSearchCache();
+  cache_key_.clear();
+  cache_hit_ = false;
+  if (!cache->Enabled()) {
+    return false;
+  }
+
+  // take version before search, result is not cached when index is written meanwhile
+  cache_version_ = cache->IndexVersion(index_id_);
+  for (const auto& request_template : request_templates_) {
+    request_template.Get().AppendToString(&cache_key_);
+  }
+
+  std::vector<SearchResult> cached;
+  if (!cache->Get(index_id_, cache_key_, cached)) {
+    return false;
+  }
+
+  out_result_ = std::move(cached);
+  cache_hit_ = true;
+  return true;
+}
+
+void VectorSearchTask::PostProcess() {
+  if (!GetStatus().ok()) {
+    return;
+  }
+
+  if (!cache_hit_ && !cache_key_.empty() && missing_part_ids_.empty()) {
+    // cached before post filter, the key has no filter and is shared by filters on the same keys
+    stub.GetVectorSearchCache()->Put(index_id_, cache_key_, out_result_, cache_version_);
+  }
+
+  auto payload_cache = stub.GetVectorPayloadCache();
+  if (payload_cache->Enabled() && search_param_.with_vector_data && !two_phase_fetch_ && !cache_hit_) {
+    // payload of two phase search is put by its batch query
+    std::vector<VectorWithId> vectors;
+    for (const auto& search_result : out_result_) {
+      for (const auto& distance : search_result.vector_datas) {
+        vectors.emplace_back(distance.vector_data.id, distance.vector_data.vector);
+      }
+    }
+    payload_cache->Put(index_id_, vectors, payload_cache_version_);
+  }
+
+  if (post_filter_) {
+    ApplyPostFilter();
+  }
+
+  if (search_param_.columnar) {
+    // hits are merged and cached as vectors, scalar data is moved into the batch at last
+    for (auto& search_result : out_result_) {
+      search_result.scalar_batch.Clear();
+      for (auto& distance : search_result.vector_datas) {
+        search_result.scalar_batch.Append(distance.vector_data.scalar_data);
+        distance.vector_data.scalar_data.clear();
+      }
+    }
+  }
+}
+
+void VectorSearchTask::ApplyPostFilter() {
+  const Filter& filter = *search_param_.filter;
+  std::set<std::string> selected_keys(search_param_.selected_keys.begin(), search_param_.selected_keys.end());
+  for (auto& search_result : out_result_) {
+    auto& vector_datas = search_result.vector_datas;
+    vector_datas.erase(std::remove_if(vector_datas.begin(), vector_datas.end(),
+                                      [&filter](const VectorWithDistance& distance) {
+                                        return !filter.Match(distance.vector_data);
+                                      }),
+                       vector_datas.end());
+
+    for (auto& distance : vector_datas) {
+      auto& scalar_data = distance.vector_data.scalar_data;
+      if (!search_param_.with_scalar_data) {
+        scalar_data.clear();
+        continue;
+      }
+      if (selected_keys.empty()) {
+        continue;
+      }
+      for (auto iter = scalar_data.begin(); iter != scalar_data.end();) {
+        iter = selected_keys.count(iter->first) > 0 ? std::next(iter) : scalar_data.erase(iter);
+      }
+    }
+  }
+}
+
+void VectorSearchTask::FillFilterTypeBySelectivity() {
+  if (search_param_.filter == nullptr && search_param_.langchain_expr_json.empty()) {
+    return;
+  }
+
+  // pre filter is exact, it is kept when selectivity is unknown, and is the only one of table and vector id filter
+  search_parameter_.set_vector_filter_type(pb::common::VectorFilterType::QUERY_PRE);
+  if (search_param_.filter_source != FilterSource::kNoneFilterSource &&
+      search_param_.filter_source != FilterSource::kScalarFilter) {
+    return;
+  }
+
+  auto sample = stub.GetVectorIndexCache()->GetScalarSample(index_id_);
+  double selectivity = 0;
+  if (sample == nullptr || !vector_helper::EstimateSelectivity(*sample, search_param_.filter.get(),
+                                                               search_param_.langchain_expr_json, selectivity)) {
+    DINGO_LOG(DEBUG) << Name() << " has no scalar sample to estimate filter selectivity, use pre filter";
+    return;
+  }
+
+  int64_t recall_num = 0;
+  FilterType type = vector_helper::PickFilterType(selectivity, search_param_.topk,
+                                                  FLAGS_vector_search_auto_filter_pre_max_selectivity,
+                                                  FLAGS_vector_search_auto_filter_max_recall_num, recall_num);
+  if (type == FilterType::kQueryPost) {
+    search_parameter_.set_vector_filter_type(pb::common::VectorFilterType::QUERY_POST);
+    bool explicit_recall_num =
+        search_param_.extra_params.find(SearchExtraParamType::kRecallNum) != search_param_.extra_params.end();
+    // only ivf pq search has recall_num
+    if (recall_num > 0 && !explicit_recall_num && vector_index_->GetVectorIndexType() == VectorIndexType::kIvfPq) {
+      search_parameter_.mutable_ivf_pq()->set_recall_num(recall_num);
+    }
+  }
+  DINGO_LOG(DEBUG) << Name() << " filter selectivity:" << selectivity << " of sample:" << sample->size()
+                   << " pick post filter:" << (type == FilterType::kQueryPost) << " recall_num:" << recall_num;
+}
+
+void VectorSearchTask::FillSearchParamByTargetRecall() {
+  RecallProfile profile;
+  if (!stub.GetVectorIndexCache()->GetRecallProfile(index_id_, profile)) {
+    DINGO_LOG(WARNING) << Name() << " has no recall profile, target_recall:" << search_param_.target_recall
+                       << " is ignored";
+    return;
+  }
+
+  if (search_param_.extra_params.find(profile.param_type) != search_param_.extra_params.end()) {
+    // explicit param wins
+    return;
+  }
+
+  int32_t param = profile.PickParam(search_param_.target_recall);
+  if (param <= 0) {
+    return;
+  }
+
+  VectorIndexType type = vector_index_->GetVectorIndexType();
+  if (profile.param_type == SearchExtraParamType::kNprobe && type == VectorIndexType::kIvfFlat) {
+    search_parameter_.mutable_ivf_flat()->set_nprobe(param);
+  } else if (profile.param_type == SearchExtraParamType::kNprobe && type == VectorIndexType::kIvfPq) {
+    search_parameter_.mutable_ivf_pq()->set_nprobe(param);
+  } else if (profile.param_type == SearchExtraParamType::kEfSearch && type == VectorIndexType::kHnsw) {
+    search_parameter_.mutable_hnsw()->set_efsearch(param);
+  } else {
+    DINGO_LOG(WARNING) << Name() << " recall profile not match index type:" << VectorIndexTypeToString(type)
+                       << ", profile:" << profile.ToString();
+  }
+}
+
 void VectorSearchTask::DoAsync() {
   std::set<int64_t> next_part_ids;
+  bool fetch_pending;
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     next_part_ids = next_part_ids_;
+    fetch_pending = fetch_pending_;
     status_ = Status::OK();
   }
 
   if (next_part_ids.empty()) {
-    DoAsyncDone(Status::OK());
+    if (fetch_pending) {
+      // retry fetch payload
+      FetchPayload();
+    } else {
+      DoAsyncDone(Status::OK());
+    }
+    return;
+  }
+
+  if (client_exact_) {
+    ClientExactSearch();
     return;
   }
 
   sub_tasks_count_.store(next_part_ids.size());
+  RecordFanOut(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
-    auto* sub_task = new VectorSearchPartTask(stub, index_id_, part_id, search_parameter_, target_vectors_);
+    const std::vector<std::string>* filter_keys = nullptr;
+    if (prune_by_vector_ids_) {
+      auto iter = part_id_to_filter_keys_.find(part_id);
+      CHECK(iter != part_id_to_filter_keys_.end()) << "not found filter keys of part_id:" << part_id;
+      filter_keys = &iter->second;
+    }
+
+    auto* sub_task =
+        new VectorSearchPartTask(stub, vector_index_, part_id, request_templates_, batch_offsets_,
+                                 distance_thresholds_, filter_keys, out_view_ != nullptr, partial_);
+    sub_task->SetCancelToken(cancel_token_);
     sub_task->AsyncRun([this, sub_task](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s), sub_task); });
   }
 }
@@ -103,157 +437,551 @@ void VectorSearchTask::SubTaskCallback(Status status, VectorSearchPartTask* sub_
     DINGO_LOG(WARNING) << "sub_task: " << sub_task->Name() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
+    if (partial_) {
+      // not retried, results of the other partitions are returned
+      missing_part_ids_.insert(sub_task->part_id_);
+      next_part_ids_.erase(sub_task->part_id_);
+    } else if (status_.ok()) {
       // only return first fail status
       status_ = status;
     }
-  } else {
+  } else if (out_view_ != nullptr) {
+    for (const auto& [idx, candidates] : sub_task->GetCandidates()) {
+      CHECK_LT(idx, static_cast<int64_t>(target_results_.size())) << "unexpected target vector idx:" << idx;
+      MergeViewResult(idx, candidates);
+    }
+
     std::unique_lock<std::shared_mutex> w(rw_lock_);
+    // kept even when no candidate of it is in final topk, responses are freed with the view
+    view_owners_.push_back(sub_task->TakeResponses());
+    next_part_ids_.erase(sub_task->part_id_);
+  } else {
+    // merge without task lock, only the target vector being merged is locked
     std::unordered_map<int64_t, std::vector<VectorWithDistance>>& sub_results = sub_task->GetSearchResult();
-    // merge
     for (auto& result : sub_results) {
-      auto iter = tmp_out_result_.find(result.first);
-      if (iter != tmp_out_result_.cend()) {
-        auto& origin = iter->second;
-        auto& to_put = result.second;
-        origin.reserve(origin.size() + to_put.size());
-        std::move(to_put.begin(), to_put.end(), std::back_inserter(origin));
-      } else {
-        CHECK(tmp_out_result_.insert({result.first, std::move(result.second)}).second);
-      }
+      CHECK_LT(result.first, static_cast<int64_t>(target_results_.size()))
+          << "unexpected target vector idx:" << result.first;
+      MergeQueryResult(result.first, result.second);
     }
 
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (!sub_task->missing_region_ids_.empty()) {
+      missing_part_ids_.insert(sub_task->part_id_);
+      missing_region_ids_.insert(sub_task->missing_region_ids_.begin(), sub_task->missing_region_ids_.end());
+    }
     next_part_ids_.erase(sub_task->part_id_);
   }
 
   if (sub_tasks_count_.fetch_sub(1) == 1) {
     Status tmp;
     {
-      std::shared_lock<std::shared_mutex> r(rw_lock_);
-      ConstructResultUnlocked();
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok()) {
+        // failed partitions will retry and merge into the same target results
+        ConstructResultUnlocked();
+        fetch_pending_ = two_phase_fetch_;
+      }
       tmp = status_;
     }
-    DoAsyncDone(tmp);
+
+    if (tmp.ok() && two_phase_fetch_) {
+      FetchPayload();
+    } else {
+      DoAsyncDone(tmp);
+    }
   }
 }
 
-void VectorSearchTask::ConstructResultUnlocked() {
-  for (const auto& vector_with_id : target_vectors_) {
-    VectorWithId tmp;
+void VectorSearchTask::FetchPayload() {
+  if (IsCanceled()) {
+    DoAsyncDone(cancel_token_->Check());
+    return;
+  }
+
+  std::set<int64_t> vector_ids;
+  for (const auto& search_result : out_result_) {
+    for (const auto& distance : search_result.vector_datas) {
+      if (distance.vector_data.id > 0) {
+        vector_ids.insert(distance.vector_data.id);
+      }
+    }
+  }
+
+  if (vector_ids.empty()) {
     {
-      //  NOTE: use copy
-      const Vector& to_copy = vector_with_id.vector;
-      tmp.vector.dimension = to_copy.dimension;
-      tmp.vector.value_type = to_copy.value_type;
-      tmp.vector.float_values = to_copy.float_values;
-      tmp.vector.binary_values = to_copy.binary_values;
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      fetch_pending_ = false;
     }
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  QueryParam query_param;
+  query_param.vector_ids.assign(vector_ids.begin(), vector_ids.end());
+  query_param.with_vector_data = search_param_.with_vector_data;
+  query_param.with_scalar_data = search_param_.with_scalar_data || post_filter_;
+  query_param.selected_keys = post_filter_ ? post_filter_keys_ : search_param_.selected_keys;
+  query_param.with_table_data = search_param_.with_table_data;
 
-    SearchResult search(std::move(tmp));
+  cached_vectors_.clear();
+  auto payload_cache = stub.GetVectorPayloadCache();
+  if (search_param_.with_vector_data && payload_cache->Enabled()) {
+    for (const auto& vector_id : vector_ids) {
+      Vector vector;
+      if (payload_cache->Get(index_id_, vector_id, vector)) {
+        cached_vectors_.emplace(vector_id, std::move(vector));
+      }
+    }
 
-    out_result_.push_back(std::move(search));
+    if (FetchVectorOnly()) {
+      // query only the ids not cached
+      query_param.vector_ids.clear();
+      for (const auto& vector_id : vector_ids) {
+        if (cached_vectors_.find(vector_id) == cached_vectors_.end()) {
+          query_param.vector_ids.push_back(vector_id);
+        }
+      }
+    } else if (cached_vectors_.size() == vector_ids.size()) {
+      // scalar data is still queried, vector data is not
+      query_param.with_vector_data = false;
+    } else {
+      // a query brings vector data of all ids anyway
+      cached_vectors_.clear();
+    }
   }
 
-  for (auto& iter : tmp_out_result_) {
-    auto& vec = iter.second;
-    std::sort(vec.begin(), vec.end(),
-              [](const VectorWithDistance& a, const VectorWithDistance& b) { return a.distance < b.distance; });
+  fetch_result_.vectors.clear();
+  if (query_param.vector_ids.empty()) {
+    FetchPayloadDone();
+    return;
+  }
+
+  auto* fetch_task = new VectorBatchQueryTask(stub, index_id_, query_param, fetch_result_);
+  fetch_task->SetCancelToken(cancel_token_);
+  fetch_task->AsyncRun(
+      [this, fetch_task](auto&& s) { FetchPayloadCallback(std::forward<decltype(s)>(s), fetch_task); });
+}
+
+void VectorSearchTask::FetchPayloadCallback(Status status, VectorBatchQueryTask* fetch_task) {
+  SCOPED_CLEANUP({ delete fetch_task; });
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << Name() << " fetch payload fail: " << status.ToString();
+    DoAsyncDone(status);
+    return;
+  }
+
+  FetchPayloadDone();
+}
+
+bool VectorSearchTask::FetchVectorOnly() const {
+  return !search_param_.with_scalar_data && !post_filter_ && !search_param_.with_table_data;
+}
+
+void VectorSearchTask::FetchPayloadDone() {
+  std::unordered_map<int64_t, const VectorWithId*> id_to_vector;
+  for (const auto& vector_with_id : fetch_result_.vectors) {
+    id_to_vector.emplace(vector_with_id.id, &vector_with_id);
   }
 
-  for (auto& iter : tmp_out_result_) {
-    int64_t idx = iter.first;
-    auto& vec_distance = iter.second;
-    if (!search_param_.enable_range_search && search_param_.topk > 0 && search_param_.topk < vec_distance.size()) {
-      vec_distance.resize(search_param_.topk);
+  for (auto& search_result : out_result_) {
+    for (auto& distance : search_result.vector_datas) {
+      auto cached = cached_vectors_.find(distance.vector_data.id);
+      auto iter = id_to_vector.find(distance.vector_data.id);
+      if (iter == id_to_vector.end()) {
+        // not queried as cached, or deleted between two phases then keep id and distance only
+        if (cached != cached_vectors_.end() && FetchVectorOnly()) {
+          distance.vector_data.vector = cached->second;
+        }
+        continue;
+      }
+      distance.vector_data.vector = cached != cached_vectors_.end() ? cached->second : iter->second->vector;
+      distance.vector_data.scalar_data = iter->second->scalar_data;
+    }
+  }
+
+  if (rerank_) {
+    RerankResult();
+  }
+
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    fetch_pending_ = false;
+  }
+  DoAsyncDone(Status::OK());
+}
+
+bool VectorSearchTask::UseClientExactSearch() const {
+  if (FLAGS_vector_search_client_exact_max_ids <= 0 || !prune_by_vector_ids_ ||
+      static_cast<int64_t>(search_param_.vector_ids.size()) > FLAGS_vector_search_client_exact_max_ids) {
+    return false;
+  }
+
+  // client evaluates neither scalar filter nor range, a view keeps rpc responses
+  if (search_param_.filter != nullptr || !search_param_.langchain_expr_json.empty() ||
+      search_param_.enable_range_search || search_param_.topk <= 0 || out_view_ != nullptr ||
+      vector_index_->GetMetricType() == MetricType::kNoneMetricType) {
+    return false;
+  }
+
+  return std::all_of(target_vectors_.begin(), target_vectors_.end(), [](const VectorWithId& target) {
+    return target.vector.value_type != ValueType::kUint8 && !target.vector.float_values.empty();
+  });
+}
+
+void VectorSearchTask::ClientExactSearch() {
+  // batch query refuses duplicate ids
+  std::set<int64_t> vector_ids;
+  for (const auto& vector_id : search_param_.vector_ids) {
+    if (vector_id > 0) {
+      vector_ids.insert(vector_id);
+    }
+  }
+
+  QueryParam query_param;
+  query_param.vector_ids.assign(vector_ids.begin(), vector_ids.end());
+  // distance needs vector data, it is dropped after when not requested
+  query_param.with_vector_data = true;
+  query_param.with_scalar_data = search_param_.with_scalar_data;
+  query_param.selected_keys = search_param_.selected_keys;
+  query_param.with_table_data = search_param_.with_table_data;
+
+  fetch_result_.vectors.clear();
+  RecordFanOut(1);
+  auto* query_task = new VectorBatchQueryTask(stub, index_id_, query_param, fetch_result_);
+  query_task->SetCancelToken(cancel_token_);
+  query_task->AsyncRun(
+      [this, query_task](auto&& s) { ClientExactSearchCallback(std::forward<decltype(s)>(s), query_task); });
+}
+
+void VectorSearchTask::ClientExactSearchCallback(Status status, VectorBatchQueryTask* query_task) {
+  SCOPED_CLEANUP({ delete query_task; });
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << Name() << " query vectors for client exact search fail: " << status.ToString();
+    DoAsyncDone(status);
+    return;
+  }
+
+  int64_t limit = search_param_.topk;
+  std::vector<SearchResult> results;
+  results.reserve(target_vectors_.size());
+  for (const auto& target : target_vectors_) {
+    const auto& target_values = target.vector.float_values;
+    std::vector<VectorWithDistance> candidates;
+    candidates.reserve(fetch_result_.vectors.size());
+    for (const auto& vector_with_id : fetch_result_.vectors) {
+      const auto& values = vector_with_id.vector.float_values;
+      if (values.size() != target_values.size()) {
+        continue;
+      }
+      VectorWithDistance distance;
+      distance.distance =
+          vector_distance::ExactDistance(metric_type_, target_values.data(), values.data(), values.size());
+      distance.metric_type = metric_type_;
+      distance.vector_data = vector_with_id;
+      if (!search_param_.with_vector_data) {
+        distance.vector_data.vector = Vector();
+      }
+      candidates.push_back(std::move(distance));
+    }
+
+    std::vector<VectorWithDistance> heap;
+    vector_helper::MergeTopK(heap, candidates, limit);
+    // max heap by distance, sort_heap leaves it in ascending order
+    std::sort_heap(heap.begin(), heap.end(), CompareDistance);
+
+    SearchResult search = NewSearchResult(target);
+    search.vector_datas = std::move(heap);
+    results.push_back(std::move(search));
+  }
+
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    out_result_ = std::move(results);
+    next_part_ids_.clear();
+  }
+  DoAsyncDone(Status::OK());
+}
+
+void VectorSearchTask::ConstructResultUnlocked() {
+  if (out_view_ != nullptr) {
+    ConstructViewUnlocked();
+    return;
+  }
+
+  for (const auto& vector_with_id : target_vectors_) {
+    out_result_.push_back(NewSearchResult(vector_with_id));
+  }
+
+  bool bounded = ResultLimit() > 0;
+  for (size_t idx = 0; idx < target_results_.size(); idx++) {
+    auto& vec_distance = target_results_[idx]->vector_datas;
+    if (bounded) {
+      // max heap by distance, sort_heap leaves it in ascending order
+      std::sort_heap(vec_distance.begin(), vec_distance.end(), CompareDistance);
+    } else {
+      std::sort(vec_distance.begin(), vec_distance.end(), CompareDistance);
     }
 
     out_result_[idx].vector_datas = std::move(vec_distance);
   }
+
+  if (!missing_part_ids_.empty()) {
+    for (auto& search_result : out_result_) {
+      search_result.missing_part_ids.assign(missing_part_ids_.begin(), missing_part_ids_.end());
+      search_result.missing_region_ids.assign(missing_region_ids_.begin(), missing_region_ids_.end());
+    }
+  }
+
+  if (rerank_ && !two_phase_fetch_) {
+    // with two phase fetch, vector data is ready after payload fetched
+    RerankResult();
+  }
 }
 
-Status VectorSearchPartTask::Init() {
-  std::shared_ptr<VectorIndex> tmp;
-  DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
-  DCHECK_NOTNULL(tmp);
-  vector_index_ = std::move(tmp);
+void VectorSearchTask::ConstructViewUnlocked() {
+  if (out_view_->data_ == nullptr) {
+    // moved from
+    out_view_->data_ = std::make_unique<SearchResultView::Data>();
+  }
+  auto& data = *out_view_->data_;
+  data.hits.clear();
+  data.hits.resize(target_results_.size());
+  for (size_t idx = 0; idx < target_results_.size(); idx++) {
+    auto& hits = target_results_[idx]->hits;
+    std::sort(hits.begin(), hits.end(), ComparePbDistance);
+    data.hits[idx] = std::move(hits);
+  }
+  data.owners = std::move(view_owners_);
+}
+
+void VectorSearchTask::RerankResult() {
+  for (size_t idx = 0; idx < out_result_.size(); idx++) {
+    const Vector& target = target_vectors_[idx].vector;
+    auto& vector_datas = out_result_[idx].vector_datas;
+    if (target.value_type != ValueType::kUint8 && !target.float_values.empty()) {
+      for (auto& distance : vector_datas) {
+        const auto& values = distance.vector_data.vector.float_values;
+        if (values.size() != target.float_values.size()) {
+          // no vector data, e.g. deleted between two phases, keep server distance
+          continue;
+        }
+        distance.distance =
+            vector_distance::ExactDistance(metric_type_, target.float_values.data(), values.data(), values.size());
+      }
+      std::stable_sort(vector_datas.begin(), vector_datas.end(), CompareDistance);
+    }
+
+    if (static_cast<int64_t>(vector_datas.size()) > search_param_.topk) {
+      vector_datas.erase(vector_datas.begin() + search_param_.topk, vector_datas.end());
+    }
+  }
+}
+
+int64_t VectorSearchTask::ResultLimit() const {
+  // top_n of search parameter is larger than topk when results are re-ranked
+  int64_t topk = search_parameter_.top_n() > 0 ? search_parameter_.top_n() : search_param_.topk;
+  return SearchResultLimit(search_param_.enable_range_search, topk);
+}
+
+void VectorSearchTask::MergeQueryResult(int64_t idx, std::vector<VectorWithDistance>& to_merge) {
+  int64_t limit = ResultLimit();
+  TargetResult& query_result = *target_results_[idx];
+
+  std::lock_guard<std::mutex> guard(query_result.mutex);
+  auto& heap = query_result.vector_datas;
+  // keep the topk nearest in a bounded max heap, the farthest kept one is on the top
+  vector_helper::MergeTopK(heap, to_merge, limit);
+
+  if (limit > 0 && static_cast<int64_t>(heap.size()) == limit) {
+    // only shrink under the query lock, candidates of later sub tasks not better than it are useless
+    distance_thresholds_[idx].store(heap.front().distance);
+  }
+}
 
+void VectorSearchTask::MergeViewResult(int64_t idx,
+                                       const std::vector<const pb::common::VectorWithDistance*>& to_merge) {
+  int64_t limit = ResultLimit();
+  TargetResult& query_result = *target_results_[idx];
+
+  std::lock_guard<std::mutex> guard(query_result.mutex);
+  auto& heap = query_result.hits;
+  if (limit == 0) {
+    heap.insert(heap.end(), to_merge.begin(), to_merge.end());
+    return;
+  }
+
+  // same as MergeQueryResult, a bounded max heap of the topk nearest
+  for (const auto* distancepb : to_merge) {
+    if (static_cast<int64_t>(heap.size()) < limit) {
+      heap.push_back(distancepb);
+      std::push_heap(heap.begin(), heap.end(), ComparePbDistance);
+    } else if (distancepb->distance() < heap.front()->distance()) {
+      std::pop_heap(heap.begin(), heap.end(), ComparePbDistance);
+      heap.back() = distancepb;
+      std::push_heap(heap.begin(), heap.end(), ComparePbDistance);
+    }
+  }
+
+  if (static_cast<int64_t>(heap.size()) == limit) {
+    distance_thresholds_[idx].store(heap.front()->distance());
+  }
+}
+
+Status VectorSearchPartTask::Init() {
+  DCHECK_NOTNULL(vector_index_);
   return Status::OK();
 }
 
 void VectorSearchPartTask::DoAsync() {
-  const auto& range = vector_index_->GetPartitionRange(part_id_);
   std::vector<std::shared_ptr<Region>> regions;
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions);
+  Status s = vector_index_->GetPartitionRegions(*stub.GetMetaCache(), part_id_, regions);
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
   }
 
+  if (filter_keys_ != nullptr) {
+    regions.erase(std::remove_if(regions.begin(), regions.end(),
+                                 [this](const std::shared_ptr<Region>& region) {
+                                   return !RegionContainsFilterKeys(region);
+                                 }),
+                  regions.end());
+  }
+
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
+    candidates_.clear();
     search_result_.clear();
+    missing_region_ids_.clear();
     status_ = Status::OK();
   }
 
+  if (regions.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
   controllers_.clear();
   rpcs_.clear();
+  if (FLAGS_vector_search_use_arena) {
+    arena_ = std::make_unique<google::protobuf::Arena>();
+  } else {
+    arena_.reset();
+  }
 
+  // one rpc per region and batch, so a region searches batches of one request in parallel
+  size_t rpc_num = regions.size() * request_templates_.size();
+  controllers_.reserve(rpc_num);
+  rpcs_.reserve(rpc_num);
+  std::vector<int64_t> rpc_batch_offsets;
+  rpc_batch_offsets.reserve(rpc_num);
   for (const auto& region : regions) {
-    auto rpc = std::make_unique<VectorSearchRpc>();
-    FillVectorSearchRpcRequest(rpc->MutableRequest(), region);
+    for (size_t batch = 0; batch < request_templates_.size(); batch++) {
+      // rpcs on the arena are freed with it, the others go back to the pool
+      auto rpc = arena_ != nullptr ? RpcPool<VectorSearchRpc>::Adopt(std::make_unique<VectorSearchRpc>(arena_.get()))
+                                   : RpcPool<VectorSearchRpc>::Acquire();
+      FillVectorSearchRpcRequest(rpc->MutableRequest(), region, batch);
+      rpc_batch_offsets.push_back(batch_offsets_[batch]);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+      auto& controller = controllers_.emplace_back(stub, *rpc, region);
+      if (FLAGS_vector_search_hedge) {
+        // not hedged until the region has enough latency samples
+        int64_t delay_us = FLAGS_vector_search_hedge_delay_ms > 0
+                               ? FLAGS_vector_search_hedge_delay_ms * 1000
+                               : vector_index_->GetSearchLatencyPercentileUs(region->RegionId(),
+                                                                             FLAGS_vector_search_hedge_percentile);
+        controller.SetHedgeDelayUs(delay_us);
+      }
 
-    rpcs_.push_back(std::move(rpc));
+      rpcs_.push_back(std::move(rpc));
+    }
   }
 
-  DCHECK_EQ(rpcs_.size(), regions.size());
+  DCHECK_EQ(rpcs_.size(), regions.size() * request_templates_.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(regions.size());
+  sub_tasks_count_.store(rpc_num);
+  RecordFanOut(rpc_num);
 
-  for (auto i = 0; i < regions.size(); i++) {
+  // the last callback may finish and free this task before AsyncCall returns, so the loop keeps its bound local
+  for (size_t i = 0; i < rpc_num; i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
-        [this, rpc = rpcs_[i].get()](auto&& s) { VectorSearchRpcCallback(std::forward<decltype(s)>(s), rpc); });
+        [this, rpc = rpcs_[i].get(), batch_offset = rpc_batch_offsets[i], start_time_us = NowUs()](auto&& s) {
+          VectorSearchRpcCallback(std::forward<decltype(s)>(s), rpc, batch_offset, start_time_us);
+        });
   }
 }
 
 void VectorSearchPartTask::FillVectorSearchRpcRequest(pb::index::VectorSearchRequest* request,
-                                                      const std::shared_ptr<Region>& region) {
-  FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
-  *(request->mutable_parameter()) = search_parameter_;
-  for (const auto& vector_id : target_vectors_) {
-    // NOTE* vector_id is useless
-    FillVectorWithIdPB(request->add_vector_with_ids(), vector_id, false);
-  }
+                                                      const std::shared_ptr<Region>& region, size_t batch) {
+  // copy of encoded repeated floats, no per value re-encoding
+  request_templates_[batch].FillRequest(request, region);
+}
+
+bool VectorSearchPartTask::RegionContainsFilterKeys(const std::shared_ptr<Region>& region) const {
+  const auto& range = region->Range();
+  auto iter = std::lower_bound(filter_keys_->begin(), filter_keys_->end(), range.start_key());
+  return iter != filter_keys_->end() && *iter < range.end_key();
 }
 
-void VectorSearchPartTask::VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc) {
+void VectorSearchPartTask::VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc,
+                                                   int64_t batch_offset, int64_t start_time_us) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
+    if (partial_) {
+      // the region is reported missing, results of the other regions are kept
+      missing_region_ids_.insert(rpc->Request()->context().region_id());
+    } else if (status_.ok()) {
       // only return first fail status
       status_ = status;
     }
   } else {
+    vector_index_->RecordSearchLatency(rpc->Request()->context().region_id(), NowUs() - start_time_us);
+
     if (rpc->Response()->batch_results_size() != rpc->Request()->vector_with_ids_size()) {
       DINGO_LOG(INFO) << Name() << " rpc: " << rpc->Method()
                       << " request vector_with_ids_size: " << rpc->Request()->vector_with_ids_size()
                       << " response batch_results_size: " << rpc->Response()->batch_results_size();
     }
 
+    int64_t limit = ResultLimit();
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
       for (auto i = 0; i < rpc->Response()->batch_results_size(); i++) {
+        int64_t idx = batch_offset + i;
+        auto& candidates = candidates_[idx];
+        if (limit == 0) {
+          for (const auto& distancepb : rpc->Response()->batch_results(i).vector_with_distances()) {
+            candidates.push_back(&distancepb);
+          }
+          continue;
+        }
+
+        float threshold = std::numeric_limits<float>::max();
+        if (idx < static_cast<int64_t>(distance_thresholds_.size())) {
+          threshold = distance_thresholds_[idx].load();
+        }
         for (const auto& distancepb : rpc->Response()->batch_results(i).vector_with_distances()) {
-          VectorWithDistance distance = InternalVectorWithDistance2VectorWithDistance(distancepb);
-          search_result_[i].push_back(std::move(distance));
+          if (distancepb.distance() >= threshold) {
+            // other partitions already have topk better ones
+            continue;
+          }
+
+          if (static_cast<int64_t>(candidates.size()) < limit) {
+            candidates.push_back(&distancepb);
+            std::push_heap(candidates.begin(), candidates.end(), ComparePbDistance);
+          } else if (distancepb.distance() < candidates.front()->distance()) {
+            std::pop_heap(candidates.begin(), candidates.end(), ComparePbDistance);
+            candidates.back() = &distancepb;
+            std::push_heap(candidates.begin(), candidates.end(), ComparePbDistance);
+          }
         }
       }
     }
@@ -262,12 +990,46 @@ void VectorSearchPartTask::VectorSearchRpcCallback(const Status& status, VectorS
   if (sub_tasks_count_.fetch_sub(1) == 1) {
     Status tmp;
     {
-      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok() && !keep_responses_) {
+        MaterializeCandidatesUnlocked();
+      }
       tmp = status_;
     }
     DoAsyncDone(tmp);
   }
 }
 
+int64_t VectorSearchPartTask::ResultLimit() const {
+  // all batches share the same parameter
+  const auto& parameter = request_templates_.front().Get().parameter();
+  return SearchResultLimit(parameter.enable_range_search(), parameter.top_n());
+}
+
+std::shared_ptr<const void> VectorSearchPartTask::TakeResponses() {
+  // rpcs are freed before their arena
+  struct Responses {
+    std::unique_ptr<google::protobuf::Arena> arena;
+    std::vector<RpcPool<VectorSearchRpc>::Ptr> rpcs;
+  };
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  auto responses = std::make_shared<Responses>();
+  responses->arena = std::move(arena_);
+  responses->rpcs = std::move(rpcs_);
+  return responses;
+}
+
+void VectorSearchPartTask::MaterializeCandidatesUnlocked() {
+  for (auto& iter : candidates_) {
+    auto& to_put = search_result_[iter.first];
+    to_put.reserve(iter.second.size());
+    for (const auto* distancepb : iter.second) {
+      to_put.push_back(InternalVectorWithDistance2VectorWithDistance(*distancepb));
+    }
+  }
+  candidates_.clear();
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
@@ -15,14 +15,24 @@
 #ifndef DINGODB_SDK_VECTOR_SEARCH_TATSK_H_
 #define DINGODB_SDK_VECTOR_SEARCH_TATSK_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "fmt/core.h"
+#include "google/protobuf/arena.h"
 #include "sdk/client_stub.h"
 #include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_pool.h"
+#include "sdk/rpc/rpc_request_template.h"
 #include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/vector/vector_batch_query_task.h"
 #include "sdk/vector/vector_index.h"
 #include "sdk/vector/vector_task.h"
 
@@ -40,27 +50,136 @@ class VectorSearchTask : public VectorTask {
         target_vectors_(target_vectors),
         out_result_(out_result) {}
 
+  // results are kept as rpc responses in out_view instead of converted into SearchResult
+  VectorSearchTask(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                   const std::vector<VectorWithId>& target_vectors, SearchResultView& out_view)
+      : VectorTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        target_vectors_(target_vectors),
+        out_result_(view_unused_result_),
+        out_view_(&out_view) {}
+
   ~VectorSearchTask() override = default;
 
  private:
   Status Init() override;
   void DoAsync() override;
+  void PostProcess() override;
 
   std::string Name() const override { return fmt::format("VectorSearchTask-{}", index_id_); }
 
+  // serve from search cache when an identical search is cached, return true on hit
+  bool LookupCache();
+
+  // pick nprobe or ef_search from recall profile of the index
+  void FillSearchParamByTargetRecall();
+
+  // FilterType::kQueryAuto, pick filter type and recall_num by filter selectivity estimated on scalar sample of index
+  void FillFilterTypeBySelectivity();
+
   void SubTaskCallback(Status status, VectorSearchPartTask* sub_task);
 
+  // results of one target vector, merged as sub tasks finish, each has its own lock so
+  // sub tasks finishing together only contend when they merge the same target vector
+  struct TargetResult {
+    std::mutex mutex;
+    // max heap by distance when bounded by topk, otherwise all results unordered
+    std::vector<VectorWithDistance> vector_datas;
+    // instead of vector_datas when out_view_ is set, point into responses of part tasks
+    std::vector<const pb::common::VectorWithDistance*> hits;
+  };
+
+  // return 0 when results are not bounded
+  int64_t ResultLimit() const;
+
+  void MergeQueryResult(int64_t idx, std::vector<VectorWithDistance>& to_merge);
+
+  void MergeViewResult(int64_t idx, const std::vector<const pb::common::VectorWithDistance*>& to_merge);
+
   void ConstructResultUnlocked();
 
+  void ConstructViewUnlocked();
+
+  // replace server distances with exact ones computed from returned vector data, then keep the topk
+  void RerankResult();
+
+  // drop results not matching post filter, then scalar data fetched only for the filter
+  void ApplyPostFilter();
+
+  // second phase of two phase search, query payload of the final topk by vector id
+  void FetchPayload();
+  void FetchPayloadCallback(Status status, VectorBatchQueryTask* fetch_task);
+  // fill payload of results from fetch_result_ and cached_vectors_
+  void FetchPayloadDone();
+  // only vector data is fetched, so ids found in payload cache are not queried
+  bool FetchVectorOnly() const;
+
+  // query the few filter vector ids and compute exact topk on client, no region is searched
+  bool UseClientExactSearch() const;
+  void ClientExactSearch();
+  void ClientExactSearchCallback(Status status, VectorBatchQueryTask* query_task);
+
   const int64_t index_id_;
   const SearchParam& search_param_;
   const std::vector<VectorWithId>& target_vectors_;
   pb::common::VectorSearchParameter search_parameter_;
+  // parameter and target vectors encoded once, copied into every region rpc request, target vectors are split
+  // into batches bounded by FLAGS_vector_search_batch_max_count and FLAGS_vector_search_batch_max_bytes
+  std::vector<RequestTemplate<pb::index::VectorSearchRequest>> request_templates_;
+  // target_vectors_ idx of the first vector of each batch
+  std::vector<int64_t> batch_offsets_;
 
   // target_vectors_ idx to search result
-  std::unordered_map<int64_t, std::vector<VectorWithDistance>> tmp_out_result_;
+  std::vector<std::unique_ptr<TargetResult>> target_results_;
+  // target_vectors_ idx to the kth best distance merged so far, candidates not better than it
+  // can never make the final topk, so part tasks skip them
+  std::vector<std::atomic<float>> distance_thresholds_;
 
+  // out_result_ of a view task, always empty, must declare before out_result_
+  std::vector<SearchResult> view_unused_result_;
   std::vector<SearchResult>& out_result_;
+  SearchResultView* out_view_{nullptr};
+  // responses hits of target_results_ point into
+  std::vector<std::shared_ptr<const void>> view_owners_;
+
+  // when search is restricted to vector ids, part id to sorted range keys of the ids in it,
+  // partitions and regions without any of the ids are not searched
+  bool prune_by_vector_ids_{false};
+  std::unordered_map<int64_t, std::vector<std::string>> part_id_to_filter_keys_;
+
+  // vector ids of filter are few, see UseClientExactSearch
+  bool client_exact_{false};
+
+  // search without payload first, then query payload only for the final topk
+  bool two_phase_fetch_{false};
+  // final topk is ready but payload not fetched yet
+  bool fetch_pending_{false};
+  QueryResult fetch_result_;
+  // vector data of final topk found in payload cache
+  std::unordered_map<int64_t, Vector> cached_vectors_;
+  // version of payload cache taken before search
+  uint64_t payload_cache_version_{0};
+
+  // filter is evaluated on client by ApplyPostFilter, scalar keys of post_filter_keys_ are fetched with results,
+  // empty keys means all
+  bool post_filter_{false};
+  std::vector<std::string> post_filter_keys_;
+
+  // best effort, failed partitions and regions are recorded in missing_part_ids_ and missing_region_ids_ instead of
+  // failing the search or retried
+  bool partial_{false};
+  std::set<int64_t> missing_part_ids_;
+  std::set<int64_t> missing_region_ids_;
+
+  // ivf pq distances are approximate, keep more candidates and re-rank them by exact distance
+  bool rerank_{false};
+  MetricType metric_type_{MetricType::kNoneMetricType};
+
+  // encoded request as search cache key, empty when cache is disabled
+  std::string cache_key_;
+  uint64_t cache_version_{0};
+  bool cache_hit_{false};
 
   std::shared_ptr<VectorIndex> vector_index_;
 
@@ -73,14 +192,23 @@ class VectorSearchTask : public VectorTask {
 
 class VectorSearchPartTask : public VectorTask {
  public:
-  VectorSearchPartTask(const ClientStub& stub, int64_t index_id, int64_t part_id,
-                       const pb::common::VectorSearchParameter& search_param,
-                       const std::vector<VectorWithId>& target_vectors)
+  // vector_index is the one resolved by parent task, so part task need not look up index cache again
+  VectorSearchPartTask(const ClientStub& stub, std::shared_ptr<VectorIndex> vector_index, int64_t part_id,
+                       const std::vector<RequestTemplate<pb::index::VectorSearchRequest>>& request_templates,
+                       const std::vector<int64_t>& batch_offsets,
+                       const std::vector<std::atomic<float>>& distance_thresholds,
+                       const std::vector<std::string>* filter_keys = nullptr, bool keep_responses = false,
+                       bool partial = false)
       : VectorTask(stub),
-        index_id_(index_id),
+        index_id_(vector_index->GetId()),
         part_id_(part_id),
-        search_parameter_(search_param),
-        target_vectors_(target_vectors) {}
+        request_templates_(request_templates),
+        batch_offsets_(batch_offsets),
+        distance_thresholds_(distance_thresholds),
+        filter_keys_(filter_keys),
+        keep_responses_(keep_responses),
+        partial_(partial),
+        vector_index_(std::move(vector_index)) {}
 
   ~VectorSearchPartTask() override = default;
 
@@ -89,6 +217,14 @@ class VectorSearchPartTask : public VectorTask {
     return search_result_;
   }
 
+  // candidates kept instead of search result when keep_responses, they point into TakeResponses()
+  std::unordered_map<int64_t, std::vector<const pb::common::VectorWithDistance*>>& GetCandidates() {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    return candidates_;
+  }
+
+  std::shared_ptr<const void> TakeResponses();
+
  private:
   friend class VectorSearchTask;
 
@@ -97,26 +233,53 @@ class VectorSearchPartTask : public VectorTask {
 
   std::string Name() const override { return fmt::format("VectorSearchPartTask-{}-{}", index_id_, part_id_); }
 
-  void FillVectorSearchRpcRequest(pb::index::VectorSearchRequest* request, const std::shared_ptr<Region>& region);
+  void FillVectorSearchRpcRequest(pb::index::VectorSearchRequest* request, const std::shared_ptr<Region>& region,
+                                  size_t batch);
+
+  // region can be skipped when none of filter vector ids is in its range
+  bool RegionContainsFilterKeys(const std::shared_ptr<Region>& region) const;
+
+  // batch_offset is target_vectors_ idx of the first vector in rpc request
+  void VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc, int64_t batch_offset,
+                               int64_t start_time_us);
+
+  // return 0 when results are not bounded
+  int64_t ResultLimit() const;
 
-  void VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc);
+  // convert the kept candidates into search_result_
+  void MaterializeCandidatesUnlocked();
 
   const int64_t index_id_;
   const int64_t part_id_;
-  const pb::common::VectorSearchParameter& search_parameter_;
-  const std::vector<VectorWithId>& target_vectors_;
-
-  std::shared_ptr<VectorIndex> vector_index_;
+  // parameter and target vector batches shared by all region rpcs, one rpc per region and batch
+  const std::vector<RequestTemplate<pb::index::VectorSearchRequest>>& request_templates_;
+  const std::vector<int64_t>& batch_offsets_;
+  const std::vector<std::atomic<float>>& distance_thresholds_;
+  // sorted range keys of filter vector ids in this partition, nullptr when not restricted to vector ids
+  const std::vector<std::string>* filter_keys_;
+  // candidates are not converted, the parent takes them with the responses
+  const bool keep_responses_;
+  // failed regions are recorded in missing_region_ids_, the part task succeeds with results of the rest
+  const bool partial_;
+
+  const std::shared_ptr<VectorIndex> vector_index_;
 
   std::unordered_map<int64_t, std::shared_ptr<Region>> next_batch_region_;
 
+  // rpc request and response of one DoAsync round, freed at once when next round start or task done,
+  // must declare before rpcs_
+  std::unique_ptr<google::protobuf::Arena> arena_;
   std::vector<StoreRpcController> controllers_;
-  std::vector<std::unique_ptr<VectorSearchRpc>> rpcs_;
+  std::vector<RpcPool<VectorSearchRpc>::Ptr> rpcs_;
 
   std::shared_mutex rw_lock_;
   Status status_;
+  // target_vectors_ idx to candidates point into rpcs_ responses, max heap by distance when bounded by topk,
+  // only converted when all regions are done
+  std::unordered_map<int64_t, std::vector<const pb::common::VectorWithDistance*>> candidates_;
   // target_vectors_ idx to search result
   std::unordered_map<int64_t, std::vector<VectorWithDistance>> search_result_;
+  std::set<int64_t> missing_region_ids_;
 
   std::atomic<int> sub_tasks_count_{0};
 };
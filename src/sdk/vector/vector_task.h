@@ -15,7 +15,11 @@
 #ifndef DINGODB_SDK_VECTOR_TASK_H_
 #define DINGODB_SDK_VECTOR_TASK_H_
 
+#include "sdk/cancel_token.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/slow_log.h"
+#include "sdk/common/tracing.h"
+#include "sdk/request_priority.h"
 #include "sdk/status.h"
 #include "sdk/types.h"
 #include "sdk/utils/callback.h"
@@ -31,6 +35,9 @@ class VectorTask {
   Status Run();
   void AsyncRun(StatusCallback cb);
 
+  // must set before run, sub tasks should share the token of their parent
+  void SetCancelToken(std::shared_ptr<CancelToken> cancel_token) { cancel_token_ = std::move(cancel_token); }
+
  protected:
   virtual Status Init();
   virtual void PostProcess();
@@ -41,7 +48,19 @@ class VectorTask {
   // task must call this when complete DoAsync
   void DoAsyncDone(const Status& status);
 
+  // width of the region or partition fan out of the current run, recorded in task metrics
+  void RecordFanOut(int64_t width) { fan_out_ = width; }
+
+  // canceled or deadline passed
+  bool IsCanceled() const { return cancel_token_ != nullptr && !cancel_token_->Check().ok(); }
+
+  // status passed to callback, valid in PostProcess
+  const Status& GetStatus() const { return status_; }
+
   const ClientStub& stub;
+  std::shared_ptr<CancelToken> cancel_token_;
+  // priority of the thread calling AsyncRun, retries run at it
+  RequestPriority priority_{kInteractive};
 
  private:
   void FailOrRetry();
@@ -53,6 +72,13 @@ class VectorTask {
   mutable std::shared_mutex rw_lock_;
   StatusCallback call_back_;
   int retry_count_{0};
+  int64_t start_us_{0};
+  int64_t fan_out_{0};
+  Span span_;
+  Span retry_span_;
+  // shared by the request, only the root task of the request records it
+  std::shared_ptr<SlowLogRecorder> slow_log_;
+  bool slow_log_root_{false};
 };
 
 }  // namespace sdk
@@ -0,0 +1,196 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_delete_task.h"
+#include "sdk/vector/vector_update_buffer_internal_data.h"
+#include "sdk/vector/vector_update_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+Status VectorUpdateBuffer::Data::Write(int64_t vector_id, PendingWrite write) {
+  Batch* batch = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    DINGO_RETURN_NOT_OK(status);
+
+    int64_t now_ms = NowMs();
+    if (pending.empty()) {
+      first_pending_ms = now_ms;
+    }
+    // latest write wins, a delete replaces the pending update and an update the pending delete
+    pending[vector_id] = std::move(write);
+
+    bool full = static_cast<int64_t>(pending.size()) >= FLAGS_vector_update_buffer_max_pending;
+    if (!full && now_ms - first_pending_ms < FLAGS_vector_update_buffer_window_ms) {
+      return Status::OK();
+    }
+    if (inflight) {
+      if (!full) {
+        // keep coalescing until the batch in flight is done
+        return Status::OK();
+      }
+      cond.wait(lock, [&] { return !inflight; });
+    }
+
+    batch = TakePendingLocked();
+  }
+
+  if (batch != nullptr) {
+    SendBatch(batch);
+  }
+  return Status::OK();
+}
+
+VectorUpdateBuffer::Data::Batch* VectorUpdateBuffer::Data::TakePendingLocked() {
+  if (pending.empty()) {
+    return nullptr;
+  }
+
+  auto* batch = new Batch();
+  for (auto& [vector_id, write] : pending) {
+    if (write.deleted) {
+      batch->deletes.push_back(vector_id);
+    } else {
+      batch->updates.push_back(std::move(write.vector));
+    }
+  }
+  pending.clear();
+  inflight = true;
+  return batch;
+}
+
+void VectorUpdateBuffer::Data::SendBatch(Batch* batch) {
+  bool has_updates = !batch->updates.empty();
+  bool has_deletes = !batch->deletes.empty();
+  // ids of updates and deletes are disjoint, the two tasks run concurrently
+  batch->tasks_count.store(static_cast<int>(has_updates) + static_cast<int>(has_deletes));
+
+  // NOTE: batch may be deleted by the callback of the last task
+  if (has_updates) {
+    batch->update_task = std::make_unique<VectorUpdateTask>(stub, index_id, batch->updates);
+    batch->update_task->AsyncRun([this, batch](Status status) { BatchTaskDone(batch, status); });
+  }
+  if (has_deletes) {
+    batch->delete_task = std::make_unique<VectorDeleteTask>(stub, index_id, batch->deletes, batch->delete_result);
+    batch->delete_task->AsyncRun([this, batch](Status status) { BatchTaskDone(batch, status); });
+  }
+}
+
+void VectorUpdateBuffer::Data::BatchTaskDone(Batch* batch, const Status& status) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "vector update buffer of index:" << index_id << " write batch of "
+                       << batch->updates.size() << " updates and " << batch->deletes.size()
+                       << " deletes fail: " << status.ToString();
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (!status.ok() && this->status.ok()) {
+      // only return first fail status
+      this->status = status;
+    }
+  }
+
+  if (batch->tasks_count.fetch_sub(1) != 1) {
+    return;
+  }
+
+  // tasks are in their callbacks, nothing of them is touched after callback return
+  delete batch;
+
+  std::lock_guard<std::mutex> guard(mutex);
+  inflight = false;
+  // notify under lock, buffer may destroy data as soon as no batch in flight
+  cond.notify_all();
+}
+
+Status VectorUpdateBuffer::Data::Flush() {
+  Batch* batch = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&] { return !inflight; });
+    batch = TakePendingLocked();
+  }
+
+  if (batch != nullptr) {
+    SendBatch(batch);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [&] { return !inflight; });
+  Status tmp = status;
+  status = Status::OK();
+  return tmp;
+}
+
+VectorUpdateBuffer::VectorUpdateBuffer(Data* data) : data_(data) {}
+
+VectorUpdateBuffer::~VectorUpdateBuffer() {
+  Status s = Flush();
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "vector update buffer of index:" << data_->index_id << " flush fail: " << s.ToString();
+  }
+  delete data_;
+}
+
+Status VectorUpdateBuffer::Update(VectorWithId vector) {
+  if (vector.id <= 0) {
+    return Status::InvalidArgument("vector id must be positive");
+  }
+
+  int64_t vector_id = vector.id;
+  Data::PendingWrite write;
+  write.vector = std::move(vector);
+  return data_->Write(vector_id, std::move(write));
+}
+
+Status VectorUpdateBuffer::Delete(int64_t vector_id) {
+  if (vector_id <= 0) {
+    return Status::InvalidArgument("vector id must be positive");
+  }
+
+  Data::PendingWrite write;
+  write.deleted = true;
+  return data_->Write(vector_id, std::move(write));
+}
+
+Status VectorUpdateBuffer::Flush() { return data_->Flush(); }
+
+int64_t VectorUpdateBuffer::PendingCount() const {
+  std::lock_guard<std::mutex> guard(data_->mutex);
+  return data_->pending.size();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
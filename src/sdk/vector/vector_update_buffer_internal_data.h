@@ -0,0 +1,89 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_UPDATE_BUFFER_DATA_H_
+#define DINGODB_SDK_VECTOR_UPDATE_BUFFER_DATA_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_delete_task.h"
+#include "sdk/vector/vector_update_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+class VectorUpdateBuffer::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  Data(const ClientStub& stub, int64_t index_id) : stub(stub), index_id(index_id) {}
+
+  ~Data() = default;
+
+  // latest write of a vector id
+  struct PendingWrite {
+    bool deleted{false};
+    VectorWithId vector;
+  };
+
+  // writes of one batch being sent, owned by the callbacks of its tasks
+  struct Batch {
+    std::vector<VectorWithId> updates;
+    std::vector<int64_t> deletes;
+    std::vector<DeleteResult> delete_result;
+    std::unique_ptr<VectorUpdateTask> update_task;
+    std::unique_ptr<VectorDeleteTask> delete_task;
+    std::atomic<int> tasks_count{0};
+  };
+
+  // buffer the write, send pending writes when the window passes
+  Status Write(int64_t vector_id, PendingWrite write);
+
+  // move pending writes into a batch and mark it in flight, nullptr when nothing is pending, called with mutex held
+  Batch* TakePendingLocked();
+
+  void SendBatch(Batch* batch);
+
+  void BatchTaskDone(Batch* batch, const Status& status);
+
+  Status Flush();
+
+  const ClientStub& stub;
+  const int64_t index_id;
+
+  mutable std::mutex mutex;
+  std::condition_variable cond;
+  // protected by mutex
+  std::unordered_map<int64_t, PendingWrite> pending;
+  int64_t first_pending_ms{0};
+  // one batch at a time, so writes of an id are applied in order
+  bool inflight{false};
+  // first error of batches since last Flush
+  Status status;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_UPDATE_BUFFER_DATA_H_
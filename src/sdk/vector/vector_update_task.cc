@@ -16,10 +16,12 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 #include "glog/logging.h"
 #include "sdk/auto_increment_manager.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/status.h"
 #include "sdk/vector/vector_common.h"
 #include "sdk/vector/vector_helper.h"
@@ -28,7 +30,22 @@
 namespace dingodb {
 namespace sdk {
 
+namespace {
+std::vector<int64_t> VectorIds(const std::vector<VectorWithId>& vectors) {
+  std::vector<int64_t> ids;
+  ids.reserve(vectors.size());
+  for (const auto& vector : vectors) {
+    ids.push_back(vector.id);
+  }
+  return ids;
+}
+}  // namespace
+
 Status VectorUpdateTask::Init() {
+  // searches in flight can not be cached
+  stub.GetVectorSearchCache()->InvalidateIndex(index_id_);
+  stub.GetVectorPayloadCache()->Invalidate(index_id_, VectorIds(vectors_));
+
   if (vectors_.empty()) {
     return Status::InvalidArgument("vectors is empty, no need update vector");
   }
@@ -58,6 +75,11 @@ Status VectorUpdateTask::Init() {
   return Status::OK();
 }
 
+void VectorUpdateTask::PostProcess() {
+  stub.GetVectorSearchCache()->InvalidateIndex(index_id_);
+  stub.GetVectorPayloadCache()->Invalidate(index_id_, VectorIds(vectors_));
+}
+
 void VectorUpdateTask::DoAsync() {
   std::unordered_map<int64_t, int64_t> next_batch;
   {
@@ -71,58 +93,50 @@ void VectorUpdateTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<int64_t>> region_vectors_to_ids;
-
-  auto meta_cache = stub.GetMetaCache();
-
+  std::vector<int64_t> ids;
+  ids.reserve(next_batch.size());
   for (const auto &[id, idx] : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
+    ids.push_back(id);
+  }
 
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+  std::vector<vector_helper::RegionVectorIds> groups;
+  Status s = vector_helper::GroupVectorIdsByRegion(*stub.GetMetaCache(), *vector_index_, ids, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
 
-  for (const auto &entry : region_vectors_to_ids) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
-
-    auto rpc = std::make_unique<VectorAddRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-
-    for (const auto &id : entry.second) {
-      int64_t idx = vector_id_to_idx_[id];
-      FillVectorWithIdPB(rpc->MutableRequest()->add_vectors(), vectors_[idx]);
+  for (const auto &group : groups) {
+    const auto &region = group.region;
+
+    VectorAddRpc *rpc = nullptr;
+    int64_t batch_bytes = 0;
+    for (const auto &id : group.ids) {
+      if (rpc == nullptr ||
+          (FLAGS_vector_write_batch_max_bytes > 0 && batch_bytes >= FLAGS_vector_write_batch_max_bytes)) {
+        rpcs_.push_back(std::make_unique<VectorAddRpc>());
+        rpc = rpcs_.back().get();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+        controllers_.emplace_back(stub, *rpc, region);
+        controllers_.back().SetWriteRateLimit(index_id_);
+        batch_bytes = 0;
+      }
+
+      auto *vector_pb = rpc->MutableRequest()->add_vectors();
+      FillVectorWithIdPB(vector_pb, vectors_[next_batch[id]]);
+      batch_bytes += vector_pb->ByteSizeLong();
     }
-
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
-
-    rpcs_.push_back(std::move(rpc));
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
+  sub_tasks_count_.store(rpcs_.size());
+  RecordFanOut(rpcs_.size());
 
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
+  for (auto i = 0; i < rpcs_.size(); i++) {
     auto &controller = controllers_[i];
 
     controller.AsyncCall(
@@ -132,8 +146,8 @@ void VectorUpdateTask::DoAsync() {
 
 void VectorUpdateTask::VectorAddRpcCallback(const Status &status, VectorAddRpc *rpc) {
   if (!status.ok()) {
-    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
-                       << " fail: " << status.ToString();
+    DINGO_LOG_EVERY_SECOND(WARNING) << "rpc: " << rpc->Method() << " send to region: "
+                                    << rpc->Request()->context().region_id() << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
     if (status_.ok()) {
@@ -38,6 +38,8 @@ class VectorUpdateTask : public VectorTask {
  private:
   Status Init() override;
   void DoAsync() override;
+  // invalidate search cache of the index once write is done
+  void PostProcess() override;
 
   std::string Name() const override { return fmt::format("VectorUpdateTask-{}", index_id_); }
 
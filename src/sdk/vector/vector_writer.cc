@@ -0,0 +1,149 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_add_task.h"
+#include "sdk/vector/vector_writer_internal_data.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+// approximate encoded size, only used to cut chunks
+int64_t EstimateVectorBytes(const VectorWithId& vector_with_id) {
+  int64_t bytes = sizeof(vector_with_id.id) + vector_with_id.vector.Size();
+  for (const auto& [key, value] : vector_with_id.scalar_data) {
+    bytes += key.size();
+    for (const auto& field : value.fields) {
+      bytes += sizeof(field.long_data) + field.string_data.size();
+    }
+  }
+  return bytes;
+}
+}  // namespace
+
+void VectorWriter::Data::SendBuffer() {
+  if (buffer.empty()) {
+    return;
+  }
+
+  auto* chunk = new Chunk();
+  chunk->vectors.swap(buffer);
+  chunk->bytes = buffer_bytes;
+  buffer_bytes = 0;
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // a chunk bigger than the limit still goes when nothing is in flight
+    cond.wait(lock, [&] {
+      return inflight_chunks == 0 || inflight_bytes + chunk->bytes <= FLAGS_vector_writer_max_inflight_bytes;
+    });
+    inflight_bytes += chunk->bytes;
+    inflight_chunks++;
+  }
+
+  // id allocation and encoding of this chunk overlap with rpcs of previous chunks
+  chunk->task = std::make_unique<VectorAddTask>(stub, index_id, chunk->vectors, replace_deleted, is_update);
+  chunk->task->AsyncRun([this, chunk](Status status) { ChunkDone(chunk, status); });
+}
+
+void VectorWriter::Data::ChunkDone(Chunk* chunk, const Status& status) {
+  int64_t bytes = chunk->bytes;
+  int64_t count = chunk->vectors.size();
+  // task is in its callback, nothing of it is touched after callback return
+  delete chunk;
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "vector writer of index:" << index_id << " write chunk of " << count
+                       << " vectors fail: " << status.ToString();
+  }
+
+  std::lock_guard<std::mutex> guard(mutex);
+  if (!status.ok() && this->status.ok()) {
+    // only return first fail status
+    this->status = status;
+  }
+  inflight_bytes -= bytes;
+  inflight_chunks--;
+  // notify under lock, writer may destroy data as soon as no chunk in flight
+  cond.notify_all();
+}
+
+Status VectorWriter::Data::WaitInflightChunks() {
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [&] { return inflight_chunks == 0; });
+  Status tmp = status;
+  status = Status::OK();
+  return tmp;
+}
+
+VectorWriter::VectorWriter(Data* data) : data_(data) {}
+
+VectorWriter::~VectorWriter() {
+  Status s = Flush();
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "vector writer of index:" << data_->index_id << " flush fail: " << s.ToString();
+  }
+  delete data_;
+}
+
+Status VectorWriter::Add(VectorWithId vector) {
+  {
+    std::lock_guard<std::mutex> guard(data_->mutex);
+    DINGO_RETURN_NOT_OK(data_->status);
+  }
+
+  data_->buffer_bytes += EstimateVectorBytes(vector);
+  data_->buffer.push_back(std::move(vector));
+  if (data_->buffer_bytes >= FLAGS_vector_writer_chunk_bytes) {
+    data_->SendBuffer();
+  }
+
+  return Status::OK();
+}
+
+Status VectorWriter::Add(std::vector<VectorWithId> vectors) {
+  {
+    std::lock_guard<std::mutex> guard(data_->mutex);
+    DINGO_RETURN_NOT_OK(data_->status);
+  }
+
+  for (auto& vector : vectors) {
+    data_->buffer_bytes += EstimateVectorBytes(vector);
+    data_->buffer.push_back(std::move(vector));
+    if (data_->buffer_bytes >= FLAGS_vector_writer_chunk_bytes) {
+      data_->SendBuffer();
+    }
+  }
+
+  return Status::OK();
+}
+
+Status VectorWriter::Flush() {
+  data_->SendBuffer();
+  return data_->WaitInflightChunks();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
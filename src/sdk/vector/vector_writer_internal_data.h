@@ -0,0 +1,78 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_WRITER_DATA_H_
+#define DINGODB_SDK_VECTOR_WRITER_DATA_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sdk/client_stub.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_add_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+class VectorWriter::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  Data(const ClientStub& stub, int64_t index_id, bool replace_deleted, bool is_update)
+      : stub(stub), index_id(index_id), replace_deleted(replace_deleted), is_update(is_update) {}
+
+  ~Data() = default;
+
+  // vectors of one chunk being written, owned by its add task callback
+  struct Chunk {
+    std::vector<VectorWithId> vectors;
+    int64_t bytes{0};
+    std::unique_ptr<VectorAddTask> task;
+  };
+
+  // move buffer into a chunk and write it, block while too many bytes are in flight
+  void SendBuffer();
+
+  void ChunkDone(Chunk* chunk, const Status& status);
+
+  // wait all in flight chunks, return and reset the first error
+  Status WaitInflightChunks();
+
+  const ClientStub& stub;
+  const int64_t index_id;
+  const bool replace_deleted;
+  const bool is_update;
+
+  // only used by writer thread
+  std::vector<VectorWithId> buffer;
+  int64_t buffer_bytes{0};
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  // protected by mutex
+  int64_t inflight_bytes{0};
+  int64_t inflight_chunks{0};
+  // first error of chunks since last Flush
+  Status status;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_WRITER_DATA_H_
@@ -0,0 +1,121 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_INTEGRATION_TEST_PERF_
+#define DINGODB_INTEGRATION_TEST_PERF_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+#include "gtest/gtest.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+
+namespace integration_test {
+
+// properties of timed test cases start with it, the allure and web reports pick them up
+static const std::string kPerfPropertyPrefix = "perf_";
+
+struct PerfResult {
+  int64_t req_num{0};
+  int64_t error_count{0};
+  double qps{0};
+  double avg_us{0};
+  int64_t p50_us{0};
+  int64_t p99_us{0};
+  int64_t p999_us{0};
+  // error of the first failed request
+  std::string first_error;
+};
+
+class Perf {
+ public:
+  // run func req_num times one by one, record the result as test properties
+  static PerfResult Run(int64_t req_num, const std::function<sdk::Status(int64_t)>& func) {
+    PerfResult result;
+    std::vector<int64_t> latencies;
+    latencies.reserve(req_num);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < req_num; ++i) {
+      auto req_start = std::chrono::steady_clock::now();
+      auto status = func(i);
+      latencies.push_back(
+          std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - req_start)
+              .count());
+      if (!status.IsOK() && result.error_count++ == 0) {
+        result.first_error = fmt::format("request {} failed, error: {}", i, status.ToString());
+      }
+    }
+    auto elapsed_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    result.req_num = req_num;
+    result.qps = req_num * 1000000.0 / std::max<int64_t>(elapsed_us, 1);
+    if (!latencies.empty()) {
+      int64_t sum = 0;
+      for (auto latency : latencies) {
+        sum += latency;
+      }
+      result.avg_us = static_cast<double>(sum) / latencies.size();
+
+      std::sort(latencies.begin(), latencies.end());
+      result.p50_us = Percentile(latencies, 50);
+      result.p99_us = Percentile(latencies, 99);
+      result.p999_us = Percentile(latencies, 99.9);
+    }
+
+    testing::Test::RecordProperty(kPerfPropertyPrefix + "req_num", std::to_string(result.req_num));
+    testing::Test::RecordProperty(kPerfPropertyPrefix + "errors", std::to_string(result.error_count));
+    testing::Test::RecordProperty(kPerfPropertyPrefix + "qps", fmt::format("{:.2f}", result.qps));
+    testing::Test::RecordProperty(kPerfPropertyPrefix + "avg_us", fmt::format("{:.2f}", result.avg_us));
+    testing::Test::RecordProperty(kPerfPropertyPrefix + "p50_us", std::to_string(result.p50_us));
+    testing::Test::RecordProperty(kPerfPropertyPrefix + "p99_us", std::to_string(result.p99_us));
+    testing::Test::RecordProperty(kPerfPropertyPrefix + "p999_us", std::to_string(result.p999_us));
+
+    return result;
+  }
+
+  // threshold 0 means no assertion, thresholds are recorded too, so the reports show what was asserted
+  static void ExpectThreshold(const PerfResult& result, double min_qps, int64_t max_p99_us) {
+    if (min_qps > 0) {
+      testing::Test::RecordProperty(kPerfPropertyPrefix + "min_qps", fmt::format("{:.2f}", min_qps));
+      EXPECT_GE(result.qps, min_qps) << "qps is below threshold";
+    }
+    if (max_p99_us > 0) {
+      testing::Test::RecordProperty(kPerfPropertyPrefix + "max_p99_us", std::to_string(max_p99_us));
+      EXPECT_LE(result.p99_us, max_p99_us) << "p99 latency is above threshold";
+    }
+  }
+
+ private:
+  // sorted latencies
+  static int64_t Percentile(const std::vector<int64_t>& latencies, double percentile) {
+    auto index = static_cast<size_t>(std::ceil(percentile / 100 * latencies.size()));
+    return latencies[std::clamp<size_t>(index, 1, latencies.size()) - 1];
+  }
+};
+
+}  // namespace integration_test
+
+}  // namespace dingodb
+
+#endif  // DINGODB_INTEGRATION_TEST_PERF_
@@ -31,6 +31,9 @@
 
 namespace dingodb::report::allure {
 
+// same as kPerfPropertyPrefix of integration_test/perf.h, reports are shared with unit test
+static const std::string kPerfPropertyPrefix = "perf_";
+
 static std::string TransformStatus(const testing::TestResult* test_case_result) {
   if (test_case_result->Passed()) {
     return "passed";
@@ -130,6 +133,11 @@ void Allure::GenReport(const testing::UnitTest* unit_test, const pb::common::Ver
           {"testMethod", test_case_info->name()},
       };
       allure_test_case.description = GetPropertyValue(properties, "description");
+      for (const auto& [key, value] : properties) {
+        if (key.rfind(kPerfPropertyPrefix, 0) == 0) {
+          allure_test_case.parameters.push_back({key, value, false, "default"});
+        }
+      }
 
       int total_part_count = test_case_result->total_part_count();
       for (int k = 0; k < total_part_count; ++k) {
@@ -199,6 +207,19 @@ void Allure::GenTestResultFile(std::vector<TestSuite>& test_suites, const std::s
         doc.AddMember("labels", array_value, allocator);
       }
 
+      if (!test_case.parameters.empty()) {
+        rapidjson::Value array_value(rapidjson::kArrayType);
+        for (const auto& parameter : test_case.parameters) {
+          rapidjson::Value obj_value(rapidjson::kObjectType);
+          obj_value.AddMember("name", rapidjson::StringRef(parameter.name.c_str()), allocator);
+          obj_value.AddMember("value", rapidjson::StringRef(parameter.value.c_str()), allocator);
+          obj_value.AddMember("excluded", parameter.excluded, allocator);
+          obj_value.AddMember("mode", rapidjson::StringRef(parameter.mode.c_str()), allocator);
+          array_value.PushBack(obj_value, allocator);
+        }
+        doc.AddMember("parameters", array_value, allocator);
+      }
+
       if (!test_case.steps.empty()) {
         rapidjson::Value array_value(rapidjson::kArrayType);
         for (const auto& step : test_case.steps) {
@@ -81,6 +81,8 @@ struct TestCase {
   std::vector<Step> steps;
   std::vector<Label> labels;
   std::vector<Link> links;
+  // metrics of timed test cases, see integration_test/perf.h
+  std::vector<Parameter> parameters;
 };
 
 struct TestSuite {
@@ -15,7 +15,9 @@
 #include "report/web.h"
 
 #include <fstream>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "common/helper.h"
 #include "fmt/core.h"
@@ -122,6 +124,76 @@ std::string Web::GenTestResultContent(const testing::UnitTest* unit_test) {
   return content;
 }
 
+std::string Web::GenPerformanceContent(const testing::UnitTest* unit_test) {
+  // same as kPerfPropertyPrefix of integration_test/perf.h
+  static const std::vector<std::string> kMetrics = {"qps",    "avg_us",  "p50_us",  "p99_us",
+                                                    "p999_us", "min_qps", "max_p99_us"};
+
+  std::string rows;
+  int total_count = unit_test->total_test_suite_count();
+  for (int i = 0; i < total_count; ++i) {
+    const auto* test_suite = unit_test->GetTestSuite(i);
+
+    int total_case_count = test_suite->total_test_count();
+    for (int j = 0; j < total_case_count; ++j) {
+      const auto* test_case_info = test_suite->GetTestInfo(j);
+      const auto* test_case_result = test_case_info->result();
+
+      std::map<std::string, std::string> properties;
+      for (int k = 0; k < test_case_result->test_property_count(); ++k) {
+        const auto& property = test_case_result->GetTestProperty(k);
+        properties[property.key()] = property.value();
+      }
+      if (properties.find("perf_qps") == properties.end()) {
+        continue;
+      }
+
+      std::string status = TransformStatus(test_case_result);
+      rows += R"(<tr style="height: 32px;)";
+      if (status == "failed") {
+        rows += "background-color: #CB1B45;";
+      }
+      rows += R"(">)";
+      rows += fmt::format(R"(<td>{}</td><td>{}</td>)", test_suite->name(), test_case_info->name());
+      for (const auto& metric : kMetrics) {
+        auto it = properties.find("perf_" + metric);
+        rows += fmt::format(R"(<td>{}</td>)", it == properties.end() ? "-" : it->second);
+      }
+      rows += fmt::format(R"(<td>{}</td>)", status);
+      rows += R"(</tr>)";
+    }
+  }
+
+  if (rows.empty()) {
+    return "";
+  }
+
+  std::string content = R"(
+    <h2>Performance Information:</h2>
+    <div style="padding-left: 28px;">
+    <table style="text-indent: 8px;border-collapse: collapse; width: 80%;" border="1">
+    <tbody>
+      <tr style="height: 32px;background-color: #2EA9DF;">
+        <td><strong>Test Suite</strong></td>
+        <td><strong>Test Case</strong></td>
+        <td><strong>QPS</strong></td>
+        <td><strong>Avg(us)</strong></td>
+        <td><strong>P50(us)</strong></td>
+        <td><strong>P99(us)</strong></td>
+        <td><strong>P999(us)</strong></td>
+        <td><strong>Min QPS</strong></td>
+        <td><strong>Max P99(us)</strong></td>
+        <td><strong>Result</strong></td>
+      </tr>
+  )";
+  content += rows;
+  content += R"(</tbody>)";
+  content += R"(</table>)";
+  content += R"(</div>)";
+
+  return content;
+}
+
 std::string Web::GenAllureLinkContent(const std::string& allure_url) {
   std::string content;
   content += "<div>";
@@ -159,6 +231,7 @@ void Web::GenIntegrationTestReport(const testing::UnitTest* unit_test, const pb:
   html += "<h1>Dingo-Store Integration Test Report</h1>";
   html += "<div>" + GenVersionContent(version_info) + "</div>";
   html += "<div>" + GenTestResultContent(unit_test) + "</div>";
+  html += "<div>" + GenPerformanceContent(unit_test) + "</div>";
   html += "<div>" + GenAllureLinkContent(allure_url) + "</div>";
 
   html += R"(
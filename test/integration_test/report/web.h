@@ -40,6 +40,8 @@ class Web {
  private:
   static std::string GenVersionContent(const pb::common::VersionInfo& version_info);
   static std::string GenTestResultContent(const testing::UnitTest* unit_test);
+  // metrics of timed test cases, empty when there is none
+  static std::string GenPerformanceContent(const testing::UnitTest* unit_test);
   static std::string GenAllureLinkContent(const std::string& allure_url);
   static std::string GenCoverageLinkContent(const std::string& url);
 };
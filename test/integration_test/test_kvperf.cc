@@ -0,0 +1,149 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine_type.h"
+#include "environment.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+#include "helper.h"
+#include "perf.h"
+#include "sdk/client.h"
+#include "sdk/status.h"
+
+DEFINE_int64(perf_req_num, 1000, "Request number of every timed test case");
+DEFINE_int32(perf_value_size, 256, "Value size of timed test cases");
+DEFINE_int32(perf_scan_limit, 100, "Key number of every scan of timed test cases");
+DEFINE_double(perf_put_min_qps, 0, "Min qps of timed put, 0 means no assertion");
+DEFINE_int64(perf_put_max_p99_us, 0, "Max p99 latency of timed put, 0 means no assertion");
+DEFINE_double(perf_get_min_qps, 0, "Min qps of timed get, 0 means no assertion");
+DEFINE_int64(perf_get_max_p99_us, 0, "Max p99 latency of timed get, 0 means no assertion");
+DEFINE_double(perf_scan_min_qps, 0, "Min qps of timed scan, 0 means no assertion");
+DEFINE_int64(perf_scan_max_p99_us, 0, "Max p99 latency of timed scan, 0 means no assertion");
+
+namespace dingodb {
+
+namespace integration_test {
+
+const std::string kRegionName = "Region_for_KvPerf";
+const std::string kKeyPrefix = "KVPERF00";
+
+template <class T>
+class KvPerfTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    region_id = Helper::CreateRawRegion(kRegionName, kKeyPrefix, Helper::PrefixNext(kKeyPrefix), GetEngineType<T>());
+  }
+  static void TearDownTestSuite() { Helper::DropRawRegion(region_id); }
+
+  static std::shared_ptr<dingodb::sdk::RawKV> NewRawKV() {
+    dingodb::sdk::RawKV* tmp;
+    auto status = Environment::GetInstance().GetClient()->NewRawKV(&tmp);
+    if (!status.IsOK()) {
+      LOG(FATAL) << fmt::format("New RawKv failed, error: {}", status.ToString());
+    }
+    return std::shared_ptr<dingodb::sdk::RawKV>(tmp);
+  }
+
+  // fixed width, so keys sort in index order
+  static std::string Key(int64_t index) { return Helper::EncodeRawKey(fmt::format("{}{:010}", kKeyPrefix, index)); }
+
+  static int64_t region_id;
+};
+
+template <class T>
+int64_t KvPerfTest<T>::region_id = 0;
+
+using Implementations = testing::Types<LsmEngine, BtreeEngine>;
+TYPED_TEST_SUITE(KvPerfTest, Implementations);
+
+TYPED_TEST(KvPerfTest, Put) {
+  testing::Test::RecordProperty("description", "Test put throughput and latency");
+
+  auto raw_kv = TestFixture::NewRawKV();
+  const std::string value(FLAGS_perf_value_size, 'v');
+
+  auto result = Perf::Run(FLAGS_perf_req_num, [&](int64_t i) { return raw_kv->Put(TestFixture::Key(i), value); });
+
+  EXPECT_EQ(0, result.error_count) << result.first_error;
+  Perf::ExpectThreshold(result, FLAGS_perf_put_min_qps, FLAGS_perf_put_max_p99_us);
+}
+
+TYPED_TEST(KvPerfTest, Get) {
+  testing::Test::RecordProperty("description", "Test get throughput and latency");
+
+  auto raw_kv = TestFixture::NewRawKV();
+  const std::string value(FLAGS_perf_value_size, 'v');
+
+  // Test: Ready data
+  std::vector<sdk::KVPair> kvs;
+  for (int64_t i = 0; i < FLAGS_perf_req_num; ++i) {
+    kvs.push_back({TestFixture::Key(i), value});
+  }
+  auto status = raw_kv->BatchPut(kvs);
+  ASSERT_TRUE(status.IsOK()) << status.ToString();
+
+  // Test: run
+  auto result = Perf::Run(FLAGS_perf_req_num, [&](int64_t i) {
+    std::string actual_value;
+    auto status = raw_kv->Get(TestFixture::Key(i), actual_value);
+    if (status.IsOK() && actual_value != value) {
+      return sdk::Status::Corruption("Not match value");
+    }
+    return status;
+  });
+
+  // Test: assert result
+  EXPECT_EQ(0, result.error_count) << result.first_error;
+  Perf::ExpectThreshold(result, FLAGS_perf_get_min_qps, FLAGS_perf_get_max_p99_us);
+}
+
+TYPED_TEST(KvPerfTest, Scan) {
+  testing::Test::RecordProperty("description", "Test scan throughput and latency");
+
+  auto raw_kv = TestFixture::NewRawKV();
+  const std::string value(FLAGS_perf_value_size, 'v');
+
+  // Test: Ready data
+  std::vector<sdk::KVPair> kvs;
+  for (int64_t i = 0; i < FLAGS_perf_req_num; ++i) {
+    kvs.push_back({TestFixture::Key(i), value});
+  }
+  auto status = raw_kv->BatchPut(kvs);
+  ASSERT_TRUE(status.IsOK()) << status.ToString();
+
+  // Test: run
+  int64_t scan_range = std::max<int64_t>(FLAGS_perf_req_num - FLAGS_perf_scan_limit, 1);
+  auto result = Perf::Run(FLAGS_perf_req_num, [&](int64_t i) {
+    int64_t start = i % scan_range;
+    std::vector<sdk::KVPair> out_kvs;
+    return raw_kv->Scan(TestFixture::Key(start), TestFixture::Key(start + FLAGS_perf_scan_limit),
+                        FLAGS_perf_scan_limit, out_kvs);
+  });
+
+  // Test: assert result
+  EXPECT_EQ(0, result.error_count) << result.first_error;
+  Perf::ExpectThreshold(result, FLAGS_perf_scan_min_qps, FLAGS_perf_scan_max_p99_us);
+}
+
+}  // namespace integration_test
+
+}  // namespace dingodb
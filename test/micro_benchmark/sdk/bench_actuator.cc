@@ -0,0 +1,77 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+#include "sdk/utils/thread_pool_actuator.h"
+
+namespace dingodb {
+namespace sdk {
+
+// submit batch_size empty functions and wait all of them done, args: thread num, batch size
+static void BM_ThreadPoolActuatorExecute(benchmark::State& state) {
+  int thread_num = state.range(0);
+  int64_t batch_size = state.range(1);
+
+  ThreadPoolActuator actuator;
+  CHECK(actuator.Start(thread_num));
+
+  std::atomic<int64_t> done{0};
+  for (auto _ : state) {
+    done.store(0, std::memory_order_relaxed);
+    for (int64_t i = 0; i < batch_size; ++i) {
+      actuator.Execute([&done] { done.fetch_add(1, std::memory_order_release); });
+    }
+    while (done.load(std::memory_order_acquire) < batch_size) {
+      std::this_thread::yield();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+
+  actuator.Stop();
+}
+BENCHMARK(BM_ThreadPoolActuatorExecute)->Args({4, 1024})->Args({16, 1024})->Args({16, 16})->UseRealTime();
+
+// functions submitted from several threads at once, arg: thread num of actuator
+static void BM_ThreadPoolActuatorExecuteContended(benchmark::State& state) {
+  static ThreadPoolActuator* actuator = nullptr;
+  static std::atomic<int64_t> done{0};
+  if (state.thread_index() == 0) {
+    actuator = new ThreadPoolActuator();
+    CHECK(actuator->Start(state.range(0)));
+    done.store(0);
+  }
+
+  int64_t submitted = 0;
+  for (auto _ : state) {
+    actuator->Execute([] { done.fetch_add(1, std::memory_order_relaxed); });
+    ++submitted;
+  }
+  state.SetItemsProcessed(submitted);
+
+  if (state.thread_index() == 0) {
+    // Stop waits the queued functions
+    actuator->Stop();
+    delete actuator;
+    actuator = nullptr;
+  }
+}
+BENCHMARK(BM_ThreadPoolActuatorExecuteContended)->Arg(16)->Threads(4)->Threads(16)->UseRealTime();
+
+}  // namespace sdk
+}  // namespace dingodb
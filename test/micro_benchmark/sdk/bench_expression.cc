@@ -0,0 +1,90 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+#include "proto/common.pb.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_encoder.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+static const std::string kComparatorExpr = R"({
+      "type": "comparator",
+      "comparator": "gt",
+      "attribute": "a1",
+      "value": 50,
+      "value_type": "INT64"
+    })";
+
+static const std::string kAndOperatorExpr = R"({
+      "type": "operator",
+      "operator": "and",
+      "arguments": [
+        {"type": "comparator", "comparator": "gt", "attribute": "a1", "value": 4.11, "value_type": "DOUBLE"},
+        {"type": "comparator", "comparator": "lt", "attribute": "a2", "value": 6.11, "value_type": "DOUBLE"},
+        {"type": "comparator", "comparator": "eq", "attribute": "a3", "value": "b4", "value_type": "STRING"},
+        {
+          "type": "operator",
+          "operator": "or",
+          "arguments": [
+            {"type": "comparator", "comparator": "eq", "attribute": "a4", "value": true, "value_type": "BOOL"},
+            {"type": "comparator", "comparator": "ne", "attribute": "a5", "value": 7, "value_type": "INT64"}
+          ]
+        }
+      ]
+    })";
+
+static std::shared_ptr<LangchainExpr> CreateExpr(const std::string& json_str) {
+  std::shared_ptr<LangchainExpr> expr;
+  LangchainExprFactory expr_factory;
+  Status s = expr_factory.CreateExpr(json_str, expr);
+  CHECK(s.ok()) << "create langchain expr failed: " << s.ToString();
+  return expr;
+}
+
+// encoder is created per filter, same as sdk does
+static void BM_LangChainExprEncodeToCoprocessor(benchmark::State& state, const std::string& json_str) {
+  auto expr = CreateExpr(json_str);
+
+  for (auto _ : state) {
+    LangChainExprEncoder encoder;
+    pb::common::CoprocessorV2 coprocessor = encoder.EncodeToCoprocessor(expr.get());
+    benchmark::DoNotOptimize(coprocessor);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_LangChainExprEncodeToCoprocessor, comparator, kComparatorExpr);
+BENCHMARK_CAPTURE(BM_LangChainExprEncodeToCoprocessor, and_operator, kAndOperatorExpr);
+
+// json parse is paid on every filter without expr cache
+static void BM_LangChainExprCreate(benchmark::State& state) {
+  for (auto _ : state) {
+    auto expr = CreateExpr(kAndOperatorExpr);
+    benchmark::DoNotOptimize(expr);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LangChainExprCreate);
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
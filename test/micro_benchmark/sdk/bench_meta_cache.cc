@@ -0,0 +1,147 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "fmt/core.h"
+#include "mock_client_stub.h"
+#include "mock_coordinator_rpc_controller.h"
+#include "sdk/meta_cache.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+static std::string RegionKey(int64_t i) { return fmt::format("{:012}", i); }
+
+// meta cache filled with region_num continuous regions, the coordinator is mocked and never reached
+class MetaCacheFixture {
+ public:
+  explicit MetaCacheFixture(int64_t region_num) : region_num_(region_num) {
+    coordinator_rpc_controller_ = std::make_shared<testing::NiceMock<MockCoordinatorRpcController>>(stub_);
+    meta_cache_ = std::make_shared<MetaCache>(coordinator_rpc_controller_);
+
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(1);
+    epoch.set_conf_version(1);
+    for (int64_t i = 0; i < region_num; ++i) {
+      pb::common::Range range;
+      range.set_start_key(RegionKey(i));
+      range.set_end_key(RegionKey(i + 1));
+      meta_cache_->MaybeAddRegion(GenRegion(i + 1, range, epoch, pb::common::RegionType::STORE_REGION));
+    }
+  }
+
+  // fixtures are built once per region num, building 100k regions is much slower than a lookup
+  static MetaCacheFixture& Get(int64_t region_num) {
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> guard(mutex);
+    static std::map<int64_t, std::unique_ptr<MetaCacheFixture>> fixtures;
+    auto& fixture = fixtures[region_num];
+    if (fixture == nullptr) {
+      fixture = std::make_unique<MetaCacheFixture>(region_num);
+    }
+    return *fixture;
+  }
+
+  MetaCache& Cache() { return *meta_cache_; }
+
+  int64_t RegionNum() const { return region_num_; }
+
+ private:
+  int64_t region_num_;
+  testing::NiceMock<MockClientStub> stub_;
+  std::shared_ptr<MockCoordinatorRpcController> coordinator_rpc_controller_;
+  std::shared_ptr<MetaCache> meta_cache_;
+};
+
+static void BM_MetaCacheLookupRegionByKey(benchmark::State& state) {
+  auto& fixture = MetaCacheFixture::Get(state.range(0));
+
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<int64_t> dist(0, fixture.RegionNum() - 1);
+  std::vector<std::string> keys;
+  keys.reserve(1024);
+  for (int i = 0; i < 1024; ++i) {
+    keys.push_back(RegionKey(dist(rng)) + "k");
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    std::shared_ptr<Region> region;
+    Status s = fixture.Cache().LookupRegionByKey(keys[i++ & 1023], region);
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(region);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MetaCacheLookupRegionByKey)->Arg(1000)->Arg(100000);
+
+static void BM_MetaCacheLookupRegionByKeyThreads(benchmark::State& state) {
+  auto& fixture = MetaCacheFixture::Get(state.range(0));
+
+  std::mt19937_64 rng(state.thread_index());
+  std::uniform_int_distribution<int64_t> dist(0, fixture.RegionNum() - 1);
+  std::vector<std::string> keys;
+  keys.reserve(1024);
+  for (int i = 0; i < 1024; ++i) {
+    keys.push_back(RegionKey(dist(rng)) + "k");
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    std::shared_ptr<Region> region;
+    Status s = fixture.Cache().LookupRegionByKey(keys[i++ & 1023], region);
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(region);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MetaCacheLookupRegionByKeyThreads)->Arg(100000)->Threads(1)->Threads(4)->Threads(16);
+
+// one batch of sorted keys spread over the whole key space
+static void BM_MetaCacheLookupRegionsByKeys(benchmark::State& state) {
+  auto& fixture = MetaCacheFixture::Get(state.range(0));
+  int64_t batch_size = state.range(1);
+
+  std::vector<std::string> keys;
+  keys.reserve(batch_size);
+  int64_t step = std::max<int64_t>(fixture.RegionNum() / batch_size, 1);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    keys.push_back(RegionKey((i * step) % fixture.RegionNum()) + "k");
+  }
+  std::sort(keys.begin(), keys.end());
+  std::vector<std::string_view> sorted_keys(keys.begin(), keys.end());
+
+  for (auto _ : state) {
+    std::vector<RegionKeys> groups;
+    Status s = fixture.Cache().LookupRegionsByKeys(sorted_keys, groups);
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(groups);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_MetaCacheLookupRegionsByKeys)->Args({1000, 64})->Args({100000, 64})->Args({100000, 1024});
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,127 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "fmt/core.h"
+#include "sdk/transaction/txn_buffer.h"
+
+namespace dingodb {
+namespace sdk {
+
+static std::string TxnKey(int64_t i) { return fmt::format("txn_key_{:012}", i); }
+
+// keys in ascending order take the append fast path, arg: mutation num
+static void BM_TxnBufferPutSequential(benchmark::State& state) {
+  int64_t num = state.range(0);
+  std::vector<std::string> keys;
+  keys.reserve(num);
+  for (int64_t i = 0; i < num; ++i) {
+    keys.push_back(TxnKey(i));
+  }
+  std::string value(256, 'v');
+
+  for (auto _ : state) {
+    TxnBuffer buffer;
+    for (const auto& key : keys) {
+      buffer.Put(key, value);
+    }
+    benchmark::DoNotOptimize(buffer.MutationsSize());
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_TxnBufferPutSequential)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_TxnBufferPutRandom(benchmark::State& state) {
+  int64_t num = state.range(0);
+  std::mt19937_64 rng(0);
+  std::vector<std::string> keys;
+  keys.reserve(num);
+  for (int64_t i = 0; i < num; ++i) {
+    keys.push_back(TxnKey(static_cast<int64_t>(rng() % (num * 4))));
+  }
+  std::string value(256, 'v');
+
+  for (auto _ : state) {
+    TxnBuffer buffer;
+    for (const auto& key : keys) {
+      buffer.Put(key, value);
+    }
+    benchmark::DoNotOptimize(buffer.MutationsSize());
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_TxnBufferPutRandom)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_TxnBufferBatchPut(benchmark::State& state) {
+  int64_t num = state.range(0);
+  std::vector<KVPair> kvs;
+  kvs.reserve(num);
+  for (int64_t i = 0; i < num; ++i) {
+    kvs.push_back({TxnKey(i), std::string(256, 'v')});
+  }
+
+  for (auto _ : state) {
+    TxnBuffer buffer;
+    buffer.BatchPut(kvs);
+    benchmark::DoNotOptimize(buffer.MutationsSize());
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_TxnBufferBatchPut)->Arg(1024)->Arg(65536);
+
+// iterate all mutations as precommit does
+static void BM_TxnBufferIterate(benchmark::State& state) {
+  int64_t num = state.range(0);
+  TxnBuffer buffer;
+  for (int64_t i = 0; i < num; ++i) {
+    buffer.Put(TxnKey(i), std::string(256, 'v'));
+  }
+
+  for (auto _ : state) {
+    size_t bytes = 0;
+    for (const auto& [key, mutation] : buffer.Mutations()) {
+      bytes += key.size() + mutation.value.size();
+    }
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_TxnBufferIterate)->Arg(1024)->Arg(65536);
+
+// range of 100 keys out of the buffer, as txn scan merges local mutations
+static void BM_TxnBufferRange(benchmark::State& state) {
+  int64_t num = state.range(0);
+  TxnBuffer buffer;
+  for (int64_t i = 0; i < num; ++i) {
+    buffer.Put(TxnKey(i), std::string(256, 'v'));
+  }
+
+  std::mt19937_64 rng(0);
+  for (auto _ : state) {
+    int64_t start = static_cast<int64_t>(rng() % num);
+    std::vector<TxnMutation> mutations;
+    buffer.Range(TxnKey(start), TxnKey(start + 100), mutations);
+    benchmark::DoNotOptimize(mutations);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TxnBufferRange)->Arg(65536);
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,143 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "proto/common.pb.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_codec.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_helper.h"
+
+namespace dingodb {
+namespace sdk {
+
+static VectorWithId GenVectorWithId(int64_t id, int32_t dimension, int scalar_num) {
+  std::mt19937 rng(id);
+  std::uniform_real_distribution<float> dist(0, 1);
+
+  VectorWithId vector_with_id;
+  vector_with_id.id = id;
+  vector_with_id.vector.dimension = dimension;
+  vector_with_id.vector.value_type = ValueType::kFloat;
+  vector_with_id.vector.float_values.reserve(dimension);
+  for (int32_t i = 0; i < dimension; ++i) {
+    vector_with_id.vector.float_values.push_back(dist(rng));
+  }
+
+  for (int i = 0; i < scalar_num; ++i) {
+    ScalarValue scalar_value;
+    scalar_value.type = kINT64;
+    ScalarField field;
+    field.long_data = i;
+    scalar_value.fields.push_back(field);
+    vector_with_id.scalar_data.insert({"key" + std::to_string(i), scalar_value});
+  }
+
+  return vector_with_id;
+}
+
+static void BM_VectorCodecEncodeVectorKey(benchmark::State& state) {
+  int64_t vector_id = 1;
+  for (auto _ : state) {
+    std::string key;
+    vector_codec::EncodeVectorKey(kVectorPrefix, 10001, vector_id++, key);
+    benchmark::DoNotOptimize(key);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VectorCodecEncodeVectorKey);
+
+static void BM_VectorCodecDecodeVectorId(benchmark::State& state) {
+  std::vector<std::string> keys(1024);
+  for (int64_t i = 0; i < 1024; ++i) {
+    vector_codec::EncodeVectorKey(kVectorPrefix, 10001, i + 1, keys[i]);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    int64_t vector_id = vector_codec::DecodeVectorId(keys[i++ & 1023]);
+    benchmark::DoNotOptimize(vector_id);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VectorCodecDecodeVectorId);
+
+// args: dimension, scalar num
+static void BM_FillVectorWithIdPB(benchmark::State& state) {
+  auto vector_with_id = GenVectorWithId(1, state.range(0), state.range(1));
+
+  for (auto _ : state) {
+    pb::common::VectorWithId pb;
+    FillVectorWithIdPB(&pb, vector_with_id);
+    benchmark::DoNotOptimize(pb);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FillVectorWithIdPB)->Args({128, 0})->Args({768, 0})->Args({768, 8});
+
+// search response conversion, args: dimension, scalar num
+static void BM_InternalVectorWithDistance2VectorWithDistance(benchmark::State& state) {
+  pb::common::VectorWithDistance pb;
+  FillVectorWithIdPB(pb.mutable_vector_with_id(), GenVectorWithId(1, state.range(0), state.range(1)));
+  pb.set_distance(0.5);
+  pb.set_metric_type(pb::common::MetricType::METRIC_TYPE_L2);
+
+  for (auto _ : state) {
+    auto vector_with_distance = InternalVectorWithDistance2VectorWithDistance(pb);
+    benchmark::DoNotOptimize(vector_with_distance);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InternalVectorWithDistance2VectorWithDistance)->Args({0, 0})->Args({128, 0})->Args({768, 8});
+
+// merge of VectorSearchTask, results of part_num partitions merged into topk, args: topk, part num
+static void BM_VectorSearchMergeTopK(benchmark::State& state) {
+  int64_t topk = state.range(0);
+  int64_t part_num = state.range(1);
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(0, 1);
+  std::vector<std::vector<VectorWithDistance>> part_results(part_num);
+  for (auto& part_result : part_results) {
+    for (int64_t i = 0; i < topk; ++i) {
+      VectorWithDistance distance;
+      distance.vector_data.id = i + 1;
+      distance.distance = dist(rng);
+      part_result.push_back(std::move(distance));
+    }
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto to_merges = part_results;
+    state.ResumeTiming();
+
+    std::vector<VectorWithDistance> heap;
+    for (auto& to_merge : to_merges) {
+      vector_helper::MergeTopK(heap, to_merge, topk);
+    }
+    benchmark::DoNotOptimize(heap);
+  }
+  state.SetItemsProcessed(state.iterations() * topk * part_num);
+}
+BENCHMARK(BM_VectorSearchMergeTopK)->Args({10, 16})->Args({100, 16})->Args({100, 128});
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,34 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/benchmark.h"
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+int main(int argc, char** argv) {
+  // benchmark flags are consumed first, the rest are sdk gflags
+  benchmark::Initialize(&argc, argv);
+
+  FLAGS_minloglevel = google::GLOG_WARNING;
+  FLAGS_logtostdout = true;
+  FLAGS_logbufsecs = 0;
+
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
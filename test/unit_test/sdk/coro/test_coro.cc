@@ -0,0 +1,155 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <thread>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "sdk/coro.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+// eager coroutine of the test, result is published to the future when it returns
+struct Task {
+  struct promise_type {
+    std::promise<Status> result;
+
+    Task get_return_object() { return Task{result.get_future()}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_value(Status status) { result.set_value(std::move(status)); }
+    void unhandled_exception() { result.set_exception(std::current_exception()); }
+  };
+
+  std::future<Status> future;
+};
+
+// awaitable is not movable, it is made in the coroutine frame as the sdk wrappers are used
+Task Await(std::function<coro::StatusAwaitable()> make, std::thread::id* resumed_on) {
+  Status s = co_await make();
+  *resumed_on = std::this_thread::get_id();
+  co_return s;
+}
+
+}  // namespace
+
+TEST(SDKCoroTest, InlineCallbackNotSuspend) {
+  std::thread::id resumed_on;
+  std::atomic<int> executed{0};
+  coro::Executor executor = [&](std::function<void()> fn) {
+    executed++;
+    fn();
+  };
+
+  auto start = [](StatusCallback cb) { cb(Status::NotFound("inline")); };
+  auto task = Await([&] { return coro::StatusAwaitable(start, executor); }, &resumed_on);
+
+  // completed before Await returned, without going through the executor
+  ASSERT_EQ(task.future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_TRUE(task.future.get().IsNotFound());
+  EXPECT_EQ(resumed_on, std::this_thread::get_id());
+  EXPECT_EQ(executed.load(), 0);
+}
+
+TEST(SDKCoroTest, AsyncCallbackResumeInline) {
+  std::thread::id resumed_on;
+  std::thread::id callback_on;
+  std::promise<void> go;
+  std::thread callback_thread;
+
+  auto start = [&](StatusCallback cb) {
+    callback_thread = std::thread([&, cb = std::move(cb)] {
+      go.get_future().wait();
+      callback_on = std::this_thread::get_id();
+      cb(Status::OK());
+    });
+  };
+  auto task = Await([&] { return coro::StatusAwaitable(start, nullptr); }, &resumed_on);
+
+  // suspended until the callback fires
+  EXPECT_EQ(task.future.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+  go.set_value();
+  EXPECT_TRUE(task.future.get().ok());
+  callback_thread.join();
+
+  // empty executor resumes in the thread firing the callback
+  EXPECT_EQ(resumed_on, callback_on);
+  EXPECT_NE(resumed_on, std::this_thread::get_id());
+}
+
+TEST(SDKCoroTest, AsyncCallbackResumeInExecutor) {
+  std::thread::id resumed_on;
+  std::promise<void> go;
+  std::thread callback_thread;
+  std::promise<std::function<void()>> posted;
+
+  coro::Executor executor = [&](std::function<void()> fn) { posted.set_value(std::move(fn)); };
+  auto start = [&](StatusCallback cb) {
+    callback_thread = std::thread([&, cb = std::move(cb)] {
+      go.get_future().wait();
+      cb(Status::Aborted("async"));
+    });
+  };
+  auto task = Await([&] { return coro::StatusAwaitable(start, executor); }, &resumed_on);
+
+  // callback fired after suspend resumes through the executor only
+  go.set_value();
+  auto fn = posted.get_future().get();
+  callback_thread.join();
+  EXPECT_EQ(task.future.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+
+  std::thread executor_thread(std::move(fn));
+  EXPECT_TRUE(task.future.get().IsAborted());
+  EXPECT_EQ(resumed_on, executor_thread.get_id());
+  executor_thread.join();
+}
+
+TEST(SDKCoroTest, Blocking) {
+  std::thread::id resumed_on;
+  std::thread::id fn_on;
+  std::promise<void> go;
+  std::thread executor_thread;
+
+  coro::Executor executor = [&](std::function<void()> fn) {
+    executor_thread = std::thread([&, fn = std::move(fn)] {
+      go.get_future().wait();
+      fn();
+    });
+  };
+  auto fn = [&] {
+    fn_on = std::this_thread::get_id();
+    return Status::Incomplete("blocking");
+  };
+  auto task = Await([&] { return coro::Blocking(fn, executor); }, &resumed_on);
+
+  go.set_value();
+  EXPECT_TRUE(task.future.get().IsIncomplete());
+  executor_thread.join();
+
+  // fn runs in the executor and the coroutine suspended before it returned is resumed right there
+  EXPECT_NE(fn_on, std::this_thread::get_id());
+  EXPECT_EQ(resumed_on, fn_on);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
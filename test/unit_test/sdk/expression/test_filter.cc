@@ -0,0 +1,107 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "sdk/expression/filter_internal_data.h"
+#include "sdk/expression/langchain_expr_cache.h"
+#include "sdk/filter.h"
+#include "sdk/status.h"
+#include "sdk/types.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const std::string kExprJson =
+    R"({
+          "type": "operator",
+          "operator": "and",
+          "arguments": [
+              {
+                  "type": "comparator",
+                  "comparator": "gt",
+                  "attribute": "a3",
+                  "value": 50,
+                  "value_type": "INT64"
+              },
+              {
+                  "type": "operator",
+                  "operator": "not",
+                  "arguments": [
+                      {
+                          "type": "comparator",
+                          "comparator": "eq",
+                          "attribute": "a1",
+                          "value": "b",
+                          "value_type": "STRING"
+                      }
+                  ]
+              }
+          ]
+    }
+  )";
+
+static std::shared_ptr<const Filter> BuildFilter() {
+  return Filter::And({Filter::Compare(Filter::kGt, "a3", int64_t{50}),
+                      Filter::Not(Filter::Compare(Filter::kEq, "a1", "b"))});
+}
+
+TEST(SDKFilterTest, SameAsJson) {
+  auto filter = BuildFilter();
+
+  pb::common::CoprocessorV2 expected;
+  EXPECT_TRUE(expression::LangchainExprCache::Compile(kExprJson, nullptr, expected).ok());
+
+  pb::common::CoprocessorV2 coprocessor;
+  EXPECT_TRUE(filter->GetData().GetOrCompile("", nullptr, coprocessor).ok());
+  EXPECT_EQ(coprocessor.SerializeAsString(), expected.SerializeAsString());
+
+  // compiled once, served from filter afterwards
+  pb::common::CoprocessorV2 again;
+  EXPECT_TRUE(filter->GetData().GetOrCompile("", nullptr, again).ok());
+  EXPECT_EQ(again.SerializeAsString(), expected.SerializeAsString());
+}
+
+TEST(SDKFilterTest, RemapBySchema) {
+  auto filter = BuildFilter();
+
+  std::unordered_map<std::string, Type> schema{{"a3", kDOUBLE}};
+  pb::common::CoprocessorV2 expected;
+  EXPECT_TRUE(expression::LangchainExprCache::Compile(kExprJson, &schema, expected).ok());
+
+  pb::common::CoprocessorV2 coprocessor;
+  EXPECT_TRUE(filter->GetData().GetOrCompile("v1", &schema, coprocessor).ok());
+  EXPECT_EQ(coprocessor.SerializeAsString(), expected.SerializeAsString());
+}
+
+TEST(SDKFilterTest, SchemaTypeMismatch) {
+  auto filter = Filter::Compare(Filter::kEq, "a1", "b");
+
+  std::unordered_map<std::string, Type> schema{{"a1", kINT64}};
+  pb::common::CoprocessorV2 coprocessor;
+  Status s = filter->GetData().GetOrCompile("v1", &schema, coprocessor);
+  EXPECT_TRUE(s.IsInvalidArgument());
+}
+
+TEST(SDKFilterTest, StringLiteralIsString) {
+  auto filter = Filter::Compare(Filter::kEq, "a1", "b");
+  EXPECT_EQ(filter->GetData().type, kSTRING);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,95 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "sdk/expression/langchain_expr_cache.h"
+#include "sdk/status.h"
+#include "sdk/types.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+static const std::string kExprJson =
+    R"({
+          "type": "comparator",
+          "comparator": "gt",
+          "attribute": "a3",
+          "value": 50,
+          "value_type": "INT64"
+    }
+  )";
+
+TEST(SDKLangchainExprCacheTest, SameAsCompile) {
+  LangchainExprCache cache(16);
+
+  pb::common::CoprocessorV2 expected;
+  EXPECT_TRUE(LangchainExprCache::Compile(kExprJson, nullptr, expected).ok());
+
+  for (int i = 0; i < 2; i++) {
+    pb::common::CoprocessorV2 coprocessor;
+    Status s = cache.GetOrCompile(kExprJson, "", nullptr, coprocessor);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(coprocessor.SerializeAsString(), expected.SerializeAsString());
+  }
+  EXPECT_EQ(cache.Size(), 1);
+}
+
+TEST(SDKLangchainExprCacheTest, KeyedBySchemaVersion) {
+  LangchainExprCache cache(16);
+
+  std::unordered_map<std::string, Type> schema{{"a3", kDOUBLE}};
+  pb::common::CoprocessorV2 no_schema;
+  pb::common::CoprocessorV2 with_schema;
+  EXPECT_TRUE(cache.GetOrCompile(kExprJson, "", nullptr, no_schema).ok());
+  EXPECT_TRUE(cache.GetOrCompile(kExprJson, "v1", &schema, with_schema).ok());
+
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_NE(no_schema.SerializeAsString(), with_schema.SerializeAsString());
+}
+
+TEST(SDKLangchainExprCacheTest, EvictLeastRecentlyUsed) {
+  LangchainExprCache cache(2);
+
+  pb::common::CoprocessorV2 coprocessor;
+  EXPECT_TRUE(cache.GetOrCompile(kExprJson, "v1", nullptr, coprocessor).ok());
+  EXPECT_TRUE(cache.GetOrCompile(kExprJson, "v2", nullptr, coprocessor).ok());
+  EXPECT_TRUE(cache.GetOrCompile(kExprJson, "v3", nullptr, coprocessor).ok());
+  EXPECT_EQ(cache.Size(), 2);
+}
+
+TEST(SDKLangchainExprCacheTest, ErrorNotCached) {
+  LangchainExprCache cache(16);
+
+  pb::common::CoprocessorV2 coprocessor;
+  Status s = cache.GetOrCompile(R"({"type": "unknown"})", "", nullptr, coprocessor);
+  EXPECT_FALSE(s.ok());
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST(SDKLangchainExprCacheTest, Disabled) {
+  LangchainExprCache cache(0);
+
+  pb::common::CoprocessorV2 coprocessor;
+  EXPECT_TRUE(cache.GetOrCompile(kExprJson, "", nullptr, coprocessor).ok());
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
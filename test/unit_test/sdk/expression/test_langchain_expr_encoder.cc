@@ -317,6 +317,22 @@ TEST_F(SDKLangChainExprEncoder, NotOperatorWithNestedComparator) {
   EXPECT_EQ(sdk::codec::BytesToHexString(bytes), "71350015401070A3D70A3D7191055100");
 }
 
+TEST_F(SDKLangChainExprEncoder, DeepNestedOperator) {
+  std::string comparator =
+      R"({"type": "comparator", "comparator": "gt", "attribute": "a3", "value": 50, "value_type": "INT64"})";
+  std::string json_str = comparator;
+  for (int i = 0; i < 64; i++) {
+    json_str = R"({"type": "operator", "operator": "and", "arguments": [)" + json_str + "," + comparator + "]}";
+  }
+
+  std::shared_ptr<LangchainExpr> expr;
+  Status s = CreateExpr(json_str, expr);
+  EXPECT_TRUE(s.ok());
+
+  std::string bytes = encoder->EncodeToFilter(expr.get());
+  EXPECT_FALSE(bytes.empty());
+}
+
 }  // namespace expression
 }  // namespace sdk
 }  // namespace dingodb
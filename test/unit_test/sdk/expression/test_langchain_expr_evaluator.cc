@@ -0,0 +1,137 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "sdk/document.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_evaluator.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/filter.h"
+#include "sdk/status.h"
+#include "sdk/types.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+static ScalarValue MakeScalar(Type type, const ScalarField& field) {
+  ScalarValue value;
+  value.type = type;
+  value.fields.push_back(field);
+  return value;
+}
+
+static VectorWithId MakeVector() {
+  VectorWithId vector_with_id;
+  vector_with_id.id = 1;
+
+  ScalarField int_field{};
+  int_field.long_data = 50;
+  vector_with_id.scalar_data["a3"] = MakeScalar(kINT64, int_field);
+
+  ScalarField double_field{};
+  double_field.double_data = 1.5;
+  vector_with_id.scalar_data["a2"] = MakeScalar(kDOUBLE, double_field);
+
+  ScalarField string_field{};
+  string_field.string_data = "b";
+  vector_with_id.scalar_data["a1"] = MakeScalar(kSTRING, string_field);
+
+  ScalarField bool_field{};
+  bool_field.bool_data = true;
+  vector_with_id.scalar_data["a4"] = MakeScalar(kBOOL, bool_field);
+  return vector_with_id;
+}
+
+TEST(SDKLangchainExprEvaluatorTest, Comparators) {
+  VectorWithId vector_with_id = MakeVector();
+
+  EXPECT_TRUE(Filter::Compare(Filter::kEq, "a3", int64_t{50})->Match(vector_with_id));
+  EXPECT_FALSE(Filter::Compare(Filter::kNe, "a3", int64_t{50})->Match(vector_with_id));
+  EXPECT_TRUE(Filter::Compare(Filter::kGte, "a3", int64_t{50})->Match(vector_with_id));
+  EXPECT_FALSE(Filter::Compare(Filter::kGt, "a3", int64_t{50})->Match(vector_with_id));
+  EXPECT_TRUE(Filter::Compare(Filter::kLt, "a3", int64_t{51})->Match(vector_with_id));
+  EXPECT_FALSE(Filter::Compare(Filter::kLte, "a3", int64_t{49})->Match(vector_with_id));
+
+  EXPECT_TRUE(Filter::Compare(Filter::kEq, "a1", "b")->Match(vector_with_id));
+  EXPECT_TRUE(Filter::Compare(Filter::kLt, "a1", "c")->Match(vector_with_id));
+  EXPECT_TRUE(Filter::Compare(Filter::kEq, "a4", true)->Match(vector_with_id));
+}
+
+TEST(SDKLangchainExprEvaluatorTest, NumbersCompareAcrossTypes) {
+  VectorWithId vector_with_id = MakeVector();
+
+  EXPECT_TRUE(Filter::Compare(Filter::kGt, "a3", 49.5)->Match(vector_with_id));
+  EXPECT_TRUE(Filter::Compare(Filter::kLt, "a2", int64_t{2})->Match(vector_with_id));
+}
+
+TEST(SDKLangchainExprEvaluatorTest, AbsentOrMismatchedIsFalse) {
+  VectorWithId vector_with_id = MakeVector();
+
+  EXPECT_FALSE(Filter::Compare(Filter::kEq, "absent", int64_t{1})->Match(vector_with_id));
+  EXPECT_FALSE(Filter::Compare(Filter::kNe, "absent", int64_t{1})->Match(vector_with_id));
+  EXPECT_FALSE(Filter::Compare(Filter::kEq, "a1", int64_t{1})->Match(vector_with_id));
+  EXPECT_TRUE(Filter::Not(Filter::Compare(Filter::kEq, "absent", int64_t{1}))->Match(vector_with_id));
+}
+
+TEST(SDKLangchainExprEvaluatorTest, Operators) {
+  VectorWithId vector_with_id = MakeVector();
+
+  auto gt = Filter::Compare(Filter::kGt, "a3", int64_t{10});
+  auto eq = Filter::Compare(Filter::kEq, "a1", "x");
+
+  EXPECT_FALSE(Filter::And({gt, eq})->Match(vector_with_id));
+  EXPECT_TRUE(Filter::Or({gt, eq})->Match(vector_with_id));
+  EXPECT_TRUE(Filter::And({gt, Filter::Not(eq)})->Match(vector_with_id));
+}
+
+TEST(SDKLangchainExprEvaluatorTest, JsonExpr) {
+  VectorWithId vector_with_id = MakeVector();
+
+  std::string json = R"({
+      "type": "operator",
+      "operator": "and",
+      "arguments": [
+          {"type": "comparator", "comparator": "gte", "attribute": "a3", "value": 50, "value_type": "INT64"},
+          {"type": "comparator", "comparator": "eq", "attribute": "a1", "value": "b", "value_type": "STRING"}
+      ]
+  })";
+
+  LangchainExprFactory expr_factory;
+  std::shared_ptr<LangchainExpr> expr;
+  EXPECT_TRUE(expr_factory.CreateExpr(json, expr).ok());
+
+  LangchainExprEvaluator evaluator;
+  EXPECT_TRUE(evaluator.Evaluate(expr.get(), VectorScalarEvalRow(vector_with_id.scalar_data)));
+}
+
+TEST(SDKLangchainExprEvaluatorTest, Document) {
+  Document doc;
+  doc.AddField("a3", DocValue::FromInt(50));
+  doc.AddField("a1", DocValue::FromString("b"));
+  DocWithId doc_with_id(1, doc);
+
+  EXPECT_TRUE(Filter::And({Filter::Compare(Filter::kLte, "a3", 50.0), Filter::Compare(Filter::kEq, "a1", "b")})
+                  ->Match(doc_with_id));
+  EXPECT_FALSE(Filter::Compare(Filter::kGt, "a3", int64_t{50})->Match(doc_with_id));
+}
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
@@ -26,6 +26,7 @@ int main(int argc, char** argv) {
   FLAGS_logbufsecs = 0;
 
   FLAGS_store_rpc_retry_delay_ms = 100;
+  FLAGS_store_rpc_request_full_retry_delay_ms = 10;
   FLAGS_store_rpc_max_retry = 5;
 
   google::InitGoogleLogging(argv[0]);
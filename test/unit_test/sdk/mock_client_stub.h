@@ -31,12 +31,33 @@ class MockClientStub final : public ClientStub {
   MOCK_METHOD(std::shared_ptr<CoordinatorRpcController>, GetMetaRpcController, (), (const, override));
   MOCK_METHOD(std::shared_ptr<MetaCache>, GetMetaCache, (), (const, override));
   MOCK_METHOD(std::shared_ptr<RpcClient>, GetStoreRpcClient, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RpcClient>, GetCoordinatorRpcClient, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<ReplicaSelector>, GetReplicaSelector, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RegionCircuitBreaker>, GetRegionCircuitBreaker, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<WriteRateLimiter>, GetWriteRateLimiter, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<MemoryBudget>, GetMemoryBudget, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RetryBudget>, GetRetryBudget, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<StoreConnectionManager>, GetStoreConnectionManager, (), (const, override));
   MOCK_METHOD(std::shared_ptr<RegionScannerFactory>, GetRawKvRegionScannerFactory, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RegionScannerFactory>, GetTxnRegionScannerFactory, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RawKvGetSingleFlight>, GetRawKvGetSingleFlight, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RawKvAutoBatcher>, GetRawKvAutoBatcher, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RawKvReadCache>, GetRawKvReadCache, (), (const, override));
   MOCK_METHOD(std::shared_ptr<AdminTool>, GetAdminTool, (), (const, override));
   MOCK_METHOD(std::shared_ptr<TxnLockResolver>, GetTxnLockResolver, (), (const, override));
   MOCK_METHOD(std::shared_ptr<Actuator>, GetActuator, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<Actuator>, GetBackgroundActuator, (), (const, override));
   MOCK_METHOD(std::shared_ptr<VectorIndexCache>, GetVectorIndexCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<VectorSearchCache>, GetVectorSearchCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<VectorPayloadCache>, GetVectorPayloadCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<VectorIndexMetricsCache>, GetVectorIndexMetricsCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<expression::LangchainExprCache>, GetLangchainExprCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<DocumentIndexCache>, GetDocumentIndexCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<DocumentIndexMetricsCache>, GetDocumentIndexMetricsCache, (), (const, override));
   MOCK_METHOD(std::shared_ptr<AutoIncrementerManager>, GetAutoIncrementerManager, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<MetaCacheWarmer>, GetMetaCacheWarmer, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<MetaCacheWatcher>, GetMetaCacheWatcher, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<MetaMemberRefresher>, GetMetaMemberRefresher, (), (const, override));
 
   // std::shared_ptr<AutoIncrementerManager>  auto_increment_manager_;
 };
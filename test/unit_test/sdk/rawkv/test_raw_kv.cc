@@ -12,9 +12,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -24,11 +32,13 @@
 #include "mock_region_scanner.h"
 #include "sdk/client.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "common/logging.h"
 #include "proto/error.pb.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/status.h"
+#include "sdk/utils/async_util.h"
 #include "sdk/utils/callback.h"
 #include "test_base.h"
 #include "test_common.h"
@@ -82,6 +92,68 @@ TEST_F(SDKRawKVTest, Get) {
   EXPECT_EQ(value, "pong");
 }
 
+TEST_F(SDKRawKVTest, AsyncGet) {
+  std::string key = "b";
+  std::string value;
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(kv_get_rpc);
+    EXPECT_EQ(kv_get_rpc->Request()->key(), key);
+
+    kv_get_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  Status got;
+  Synchronizer sync;
+  raw_kv->AsyncGet(key, value, sync.AsStatusCallBack(got));
+  sync.Wait();
+
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(value, "pong");
+}
+
+TEST_F(SDKRawKVTest, AsyncGetSingleFlight) {
+  bool old_single_flight = FLAGS_raw_kv_get_single_flight;
+  FLAGS_raw_kv_get_single_flight = true;
+
+  std::string key = "b";
+  KvGetRpc* inflight_rpc = nullptr;
+  std::function<void()> inflight_cb;
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    inflight_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(inflight_rpc);
+    EXPECT_EQ(inflight_rpc->Request()->key(), key);
+    inflight_cb = std::move(cb);
+  });
+
+  const int kGetNum = 3;
+  std::vector<std::string> values(kGetNum);
+  std::vector<Status> results(kGetNum);
+  std::vector<std::unique_ptr<Synchronizer>> syncs;
+  for (int i = 0; i < kGetNum; i++) {
+    syncs.push_back(std::make_unique<Synchronizer>());
+    raw_kv->AsyncGet(key, values[i], syncs[i]->AsStatusCallBack(results[i]));
+  }
+
+  // the first get is in flight, others wait for it
+  EXPECT_EQ(raw_kv_get_single_flight->InflightCount(), 1);
+  CHECK_NOTNULL(inflight_rpc);
+  inflight_rpc->MutableResponse()->set_value("pong");
+  inflight_cb();
+
+  for (int i = 0; i < kGetNum; i++) {
+    syncs[i]->Wait();
+    EXPECT_TRUE(results[i].IsOK());
+    EXPECT_EQ(values[i], "pong");
+  }
+  EXPECT_EQ(raw_kv_get_single_flight->InflightCount(), 0);
+
+  FLAGS_raw_kv_get_single_flight = old_single_flight;
+}
+
 TEST_F(SDKRawKVTest, BatchGetSuccess) {
   std::vector<std::string> keys;
   keys.emplace_back("b");
@@ -123,6 +195,106 @@ TEST_F(SDKRawKVTest, BatchGetSuccess) {
   }
 }
 
+TEST_F(SDKRawKVTest, BatchGetResultSet) {
+  std::vector<std::string> keys = {"b", "d", "f"};
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(batch_get_rpc);
+
+    EXPECT_EQ(1, batch_get_rpc->Request()->keys_size());
+    const auto& key = batch_get_rpc->Request()->keys(0);
+    // f is not found
+    if (key != "f") {
+      auto* kv = batch_get_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key + "-value");
+    }
+
+    cb();
+  });
+
+  KvResultSet kvs;
+  Status got = raw_kv->BatchGet(keys, kvs);
+  EXPECT_TRUE(got.IsOK());
+  ASSERT_EQ(kvs.Size(), 2);
+
+  std::map<std::string, std::string> found;
+  for (const auto& kv : kvs.ToKVPairs()) {
+    found[kv.key] = kv.value;
+  }
+  EXPECT_EQ(found["b"], "b-value");
+  EXPECT_EQ(found["d"], "d-value");
+}
+
+TEST_F(SDKRawKVTest, BatchGetSlice) {
+  // keys in one buffer of caller, no string per key
+  std::string buffer = "bdf";
+  std::vector<Slice> keys = {Slice(buffer.data(), 1), Slice(buffer.data() + 1, 1), Slice(buffer.data() + 2, 1)};
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(batch_get_rpc);
+
+    EXPECT_EQ(1, batch_get_rpc->Request()->keys_size());
+    const auto& key = batch_get_rpc->Request()->keys(0);
+    if (key != "f") {
+      auto* kv = batch_get_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key + "-value");
+    }
+
+    cb();
+  });
+
+  std::vector<KVPair> kvs;
+  Status got = raw_kv->BatchGet(keys.data(), keys.size(), kvs);
+  EXPECT_TRUE(got.IsOK());
+  ASSERT_EQ(kvs.size(), 2);
+
+  KvResultSet result_set;
+  got = raw_kv->BatchGet(keys.data(), keys.size(), result_set);
+  EXPECT_TRUE(got.IsOK());
+  ASSERT_EQ(result_set.Size(), 2);
+
+  std::map<std::string, std::string> found;
+  for (const auto& kv : kvs) {
+    found[kv.key] = kv.value;
+  }
+  EXPECT_EQ(found["b"], "b-value");
+  EXPECT_EQ(found["d"], "d-value");
+}
+
+TEST_F(SDKRawKVTest, ScatterGetRawKvOnly) {
+  ScatterGetParam param;
+  ScatterGetResult result;
+  EXPECT_TRUE(client->ScatterGet(param, result).IsInvalidArgument());
+
+  param.raw_kv_keys = {"b", "d"};
+  param.timeout_ms = 10000;
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(batch_get_rpc);
+
+    const auto& key = batch_get_rpc->Request()->keys(0);
+    auto* kv = batch_get_rpc->MutableResponse()->add_kvs();
+    kv->set_key(key);
+    kv->set_value(key);
+
+    cb();
+  });
+
+  Status got = client->ScatterGet(param, result);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_TRUE(result.raw_kv_status.IsOK());
+  EXPECT_EQ(result.kvs.size(), 2);
+  // parts not asked for are left empty
+  EXPECT_TRUE(result.vector_status.IsOK());
+  EXPECT_TRUE(result.vector_result.vectors.empty());
+  EXPECT_TRUE(result.doc_result.docs.empty());
+}
+
 TEST_F(SDKRawKVTest, BatchGetPartialFail) {
   std::vector<std::string> keys;
   keys.emplace_back("b");
@@ -265,6 +437,228 @@ TEST_F(SDKRawKVTest, BatchPutSuccess) {
   EXPECT_TRUE(put.IsOK());
 }
 
+TEST_F(SDKRawKVTest, BatchPutMove) {
+  std::vector<KVPair> kvs;
+  kvs.push_back({"b", std::string(4096, 'b')});
+  kvs.push_back({"d", std::string(4096, 'd')});
+  kvs.push_back({"f", std::string(4096, 'f')});
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(3).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+
+    EXPECT_EQ(1, kv_batch_put_rpc->Request()->kvs_size());
+    for (const auto& kv : kv_batch_put_rpc->Request()->kvs()) {
+      EXPECT_EQ(kv.value(), std::string(4096, kv.key()[0]));
+    }
+
+    cb();
+  });
+
+  Status put = raw_kv->BatchPut(std::move(kvs));
+  EXPECT_TRUE(put.IsOK());
+}
+
+TEST_F(SDKRawKVTest, BulkLoad) {
+  std::vector<KVPair> kvs;
+  kvs.push_back({"f", "f"});
+  kvs.push_back({"b", "old"});
+  kvs.push_back({"d", "d"});
+  kvs.push_back({"b1", "b1"});
+  kvs.push_back({"b", "b"});
+
+  std::mutex mutex;
+  std::map<std::string, std::string> written;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(3).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      for (const auto& kv : kv_batch_put_rpc->Request()->kvs()) {
+        EXPECT_TRUE(written.emplace(kv.key(), kv.value()).second);
+      }
+    }
+
+    cb();
+  });
+
+  RawKvBulkLoader* tmp;
+  Status s = raw_kv->NewBulkLoader(&tmp);
+  EXPECT_TRUE(s.IsOK());
+  std::unique_ptr<RawKvBulkLoader> loader(tmp);
+
+  EXPECT_TRUE(loader->Add(std::move(kvs)).IsOK());
+  EXPECT_TRUE(loader->Finish().IsOK());
+
+  // one chunk per region, the last added value of a duplicate key wins
+  EXPECT_EQ(written.size(), 4);
+  for (const auto& [key, value] : written) {
+    EXPECT_EQ(key, value);
+  }
+}
+
+TEST_F(SDKRawKVTest, AutoBatchPut) {
+  bool old_auto_batch = FLAGS_raw_kv_auto_batch;
+  int64_t old_max_delay_us = FLAGS_raw_kv_auto_batch_max_delay_us;
+  int64_t old_max_size = FLAGS_raw_kv_auto_batch_max_size;
+  FLAGS_raw_kv_auto_batch = true;
+  // the leader waits for the batch to fill
+  FLAGS_raw_kv_auto_batch_max_delay_us = 10 * 1000 * 1000;
+  FLAGS_raw_kv_auto_batch_max_size = 4;
+
+  std::vector<std::string> keys = {"a1", "a2", "b", "b1"};
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+
+    EXPECT_EQ(keys.size(), kv_batch_put_rpc->Request()->kvs_size());
+    for (const auto& kv : kv_batch_put_rpc->Request()->kvs()) {
+      EXPECT_EQ(kv.key(), kv.value());
+    }
+
+    cb();
+  });
+
+  std::vector<Status> results(keys.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < keys.size(); i++) {
+    threads.emplace_back([&, i]() { results[i] = raw_kv->Put(keys[i], keys[i]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& result : results) {
+    EXPECT_TRUE(result.IsOK());
+  }
+  EXPECT_EQ(raw_kv_auto_batcher->PutRpcBatchCount(), 1);
+
+  FLAGS_raw_kv_auto_batch = old_auto_batch;
+  FLAGS_raw_kv_auto_batch_max_delay_us = old_max_delay_us;
+  FLAGS_raw_kv_auto_batch_max_size = old_max_size;
+}
+
+TEST_F(SDKRawKVTest, AutoBatchGet) {
+  bool old_auto_batch = FLAGS_raw_kv_auto_batch;
+  int64_t old_max_delay_us = FLAGS_raw_kv_auto_batch_max_delay_us;
+  int64_t old_max_size = FLAGS_raw_kv_auto_batch_max_size;
+  FLAGS_raw_kv_auto_batch = true;
+  FLAGS_raw_kv_auto_batch_max_delay_us = 10 * 1000 * 1000;
+  FLAGS_raw_kv_auto_batch_max_size = 3;
+
+  // duplicate key is sent once
+  std::vector<std::string> keys = {"a1", "b", "b"};
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_get_rpc);
+
+    EXPECT_EQ(2, kv_batch_get_rpc->Request()->keys_size());
+    for (const auto& key : kv_batch_get_rpc->Request()->keys()) {
+      auto* kv = kv_batch_get_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key + "-value");
+    }
+
+    cb();
+  });
+
+  std::vector<std::string> values(keys.size());
+  std::vector<Status> results(keys.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < keys.size(); i++) {
+    threads.emplace_back([&, i]() { results[i] = raw_kv->Get(keys[i], values[i]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    EXPECT_TRUE(results[i].IsOK());
+    EXPECT_EQ(values[i], keys[i] + "-value");
+  }
+  EXPECT_EQ(raw_kv_auto_batcher->GetRpcBatchCount(), 1);
+
+  FLAGS_raw_kv_auto_batch = old_auto_batch;
+  FLAGS_raw_kv_auto_batch_max_delay_us = old_max_delay_us;
+  FLAGS_raw_kv_auto_batch_max_size = old_max_size;
+}
+
+TEST_F(SDKRawKVTest, AutoBatchPutInflight) {
+  bool old_auto_batch = FLAGS_raw_kv_auto_batch;
+  int64_t old_max_delay_us = FLAGS_raw_kv_auto_batch_max_delay_us;
+  int64_t old_max_size = FLAGS_raw_kv_auto_batch_max_size;
+  int64_t old_max_inflight = FLAGS_raw_kv_auto_batch_max_inflight;
+  FLAGS_raw_kv_auto_batch = true;
+  FLAGS_raw_kv_auto_batch_max_delay_us = 0;
+  FLAGS_raw_kv_auto_batch_max_size = 1;
+  FLAGS_raw_kv_auto_batch_max_inflight = 2;
+
+  std::vector<std::string> keys = {"a1", "b1"};
+
+  // each rpc is answered only when both batches are in flight
+  std::mutex mutex;
+  std::condition_variable cv;
+  int sent = 0;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(2).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+    EXPECT_EQ(1, kv_batch_put_rpc->Request()->kvs_size());
+
+    {
+      std::unique_lock<std::mutex> lk(mutex);
+      sent++;
+      cv.notify_all();
+      EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(10), [&] { return sent == 2; }));
+    }
+    cb();
+  });
+
+  std::vector<Status> results(keys.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < keys.size(); i++) {
+    threads.emplace_back([&, i]() { results[i] = raw_kv->Put(keys[i], keys[i]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& result : results) {
+    EXPECT_TRUE(result.IsOK());
+  }
+  EXPECT_EQ(raw_kv_auto_batcher->PutRpcBatchCount(), 2);
+
+  FLAGS_raw_kv_auto_batch = old_auto_batch;
+  FLAGS_raw_kv_auto_batch_max_delay_us = old_max_delay_us;
+  FLAGS_raw_kv_auto_batch_max_size = old_max_size;
+  FLAGS_raw_kv_auto_batch_max_inflight = old_max_inflight;
+}
+
+TEST_F(SDKRawKVTest, AsyncBatchPut) {
+  std::vector<KVPair> kvs;
+  kvs.push_back({"b", "b"});
+  kvs.push_back({"d", "d"});
+  kvs.push_back({"f", "f"});
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(3).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+    for (const auto& kv : kv_batch_put_rpc->Request()->kvs()) {
+      EXPECT_EQ(kv.key(), kv.value());
+    }
+
+    cb();
+  });
+
+  Status put;
+  Synchronizer sync;
+  raw_kv->AsyncBatchPut(kvs, sync.AsStatusCallBack(put));
+  sync.Wait();
+  EXPECT_TRUE(put.IsOK());
+}
+
 TEST_F(SDKRawKVTest, BatchPutPartialFail) {
   std::vector<KVPair> kvs;
   kvs.push_back({"b", "b"});
@@ -440,6 +834,31 @@ TEST_F(SDKRawKVTest, BatchDeleteSuccess) {
   EXPECT_TRUE(raw_kv->BatchDelete(to_delete).IsOK());
 }
 
+TEST_F(SDKRawKVTest, BatchDeleteSlice) {
+  std::string buffer = "bdf";
+  std::vector<Slice> to_delete = {Slice(buffer.data(), 1), Slice(buffer.data() + 1, 1),
+                                  Slice(buffer.data() + 2, 1)};
+
+  std::mutex mutex;
+  std::set<std::string> deleted;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_rpc = dynamic_cast<KvBatchDeleteRpc*>(&rpc);
+    CHECK_NOTNULL(kv_rpc);
+
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      for (const auto& key : kv_rpc->Request()->keys()) {
+        deleted.insert(key);
+      }
+    }
+
+    cb();
+  });
+
+  EXPECT_TRUE(raw_kv->BatchDelete(to_delete.data(), to_delete.size()).IsOK());
+  EXPECT_EQ(deleted, std::set<std::string>({"b", "d", "f"}));
+}
+
 TEST_F(SDKRawKVTest, BatchDeletePartialFail) {
   std::vector<std::string> to_delete;
   to_delete.push_back("b");
@@ -696,28 +1115,19 @@ TEST_F(SDKRawKVTest, DeleteRangeNonContinuous) {
 
   int64_t count = 100;
 
-  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
-      .WillOnce([&](Rpc& rpc) {
-        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
-        EXPECT_EQ(t_rpc->Request()->key(), start);
-        EXPECT_EQ(t_rpc->Request()->range_end(), end);
-
-        Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
-        Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
-        Region2ScanRegionInfo(RegionE2G(), t_rpc->MutableResponse()->add_regions());
-        Region2ScanRegionInfo(RegionL2N(), t_rpc->MutableResponse()->add_regions());
-
-        return Status::OK();
-      })
-      .WillOnce([&](Rpc& rpc) {
-        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+  // regions are deleted by the region list, the gap [g, l) is not looked up again
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    EXPECT_EQ(t_rpc->Request()->key(), start);
+    EXPECT_EQ(t_rpc->Request()->range_end(), end);
 
-        EXPECT_EQ(t_rpc->Request()->key(), "g");
-        EXPECT_EQ(t_rpc->Request()->range_end(), end);
-        Region2ScanRegionInfo(RegionL2N(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionE2G(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionL2N(), t_rpc->MutableResponse()->add_regions());
 
-        return Status::OK();
-      });
+    return Status::OK();
+  });
 
   EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
     auto* kv_rpc = dynamic_cast<KvDeleteRangeRpc*>(&rpc);
@@ -756,6 +1166,51 @@ TEST_F(SDKRawKVTest, DeleteRangeNonContinuous) {
   EXPECT_EQ(4 * count, delete_count);
 }
 
+TEST_F(SDKRawKVTest, AsyncDeleteRangeProgress) {
+  std::string start = "a";
+  std::string end = "g";
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionE2G(), t_rpc->MutableResponse()->add_regions());
+
+    return Status::OK();
+  });
+
+  int64_t count = 100;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_rpc = dynamic_cast<KvDeleteRangeRpc*>(&rpc);
+    CHECK_NOTNULL(kv_rpc);
+    kv_rpc->MutableResponse()->set_delete_count(count);
+    cb();
+  });
+
+  std::mutex progress_mutex;
+  std::vector<int64_t> done_regions;
+  int64_t total_regions = 0;
+  auto progress = [&](int64_t deleted_count, int64_t done, int64_t total) {
+    std::unique_lock<std::mutex> lk(progress_mutex);
+    EXPECT_GE(deleted_count, done * count);
+    done_regions.push_back(done);
+    total_regions = total;
+  };
+
+  int64_t delete_count = 0;
+  Status status;
+  Synchronizer sync;
+  raw_kv->AsyncDeleteRange(start, end, delete_count, sync.AsStatusCallBack(status), progress);
+  sync.Wait();
+
+  EXPECT_TRUE(status.IsOK());
+  EXPECT_EQ(3 * count, delete_count);
+  EXPECT_EQ(total_regions, 3);
+  EXPECT_EQ(done_regions.size(), 3);
+  std::sort(done_regions.begin(), done_regions.end());
+  EXPECT_EQ(done_regions, std::vector<int64_t>({1, 2, 3}));
+}
+
 TEST_F(SDKRawKVTest, CompareAndSet) {
   std::string key = "d";
   std::string value = "d";
@@ -934,6 +1389,87 @@ TEST_F(SDKRawKVTest, BatchCompareAndSetPartialFail) {
   }
 }
 
+TEST_F(SDKRawKVTest, BatchWrite) {
+  std::vector<RawKvOp> ops;
+  ops.push_back({kRawKvPut, "a", "ra", ""});
+  ops.push_back({kRawKvDelete, "b", "", ""});
+  ops.push_back({kRawKvPutIfAbsent, "d", "rd", ""});
+  ops.push_back({kRawKvCompareAndSet, "e", "re", "w"});
+  ops.push_back({kRawKvCompareAndSet, "f", "rf", "v"});
+
+  std::atomic<int> put_rpcs{0};
+  std::atomic<int> delete_rpcs{0};
+  std::atomic<int> cas_rpcs{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (auto* put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc); put_rpc != nullptr) {
+      put_rpcs++;
+      for (const auto& kv : put_rpc->Request()->kvs()) {
+        EXPECT_EQ(kv.key(), "a");
+        EXPECT_EQ(kv.value(), "ra");
+      }
+    } else if (auto* delete_rpc = dynamic_cast<KvBatchDeleteRpc*>(&rpc); delete_rpc != nullptr) {
+      delete_rpcs++;
+      for (const auto& key : delete_rpc->Request()->keys()) {
+        EXPECT_EQ(key, "b");
+      }
+    } else {
+      auto* kv_rpc = dynamic_cast<KvBatchCompareAndSetRpc*>(&rpc);
+      CHECK_NOTNULL(kv_rpc);
+      cas_rpcs++;
+
+      EXPECT_FALSE(kv_rpc->Request()->is_atomic());
+      EXPECT_EQ(kv_rpc->Request()->kvs_size(), kv_rpc->Request()->expect_values_size());
+      for (auto i = 0; i < kv_rpc->Request()->kvs_size(); i++) {
+        auto kv = kv_rpc->Request()->kvs(i);
+        auto expect = kv_rpc->Request()->expect_values(i);
+        if (kv.key() == "d") {
+          EXPECT_EQ("rd", kv.value());
+          EXPECT_TRUE(expect.empty());
+          kv_rpc->MutableResponse()->add_key_states(true);
+        } else if (kv.key() == "e") {
+          EXPECT_EQ("re", kv.value());
+          EXPECT_EQ("w", expect);
+          kv_rpc->MutableResponse()->add_key_states(true);
+        } else if (kv.key() == "f") {
+          EXPECT_EQ("rf", kv.value());
+          EXPECT_EQ("v", expect);
+          kv_rpc->MutableResponse()->add_key_states(false);
+        } else {
+          EXPECT_TRUE(false);
+        }
+      }
+    }
+
+    cb();
+  });
+
+  std::vector<KeyOpState> key_state;
+  Status result = raw_kv->BatchWrite(ops, key_state);
+  EXPECT_TRUE(result.IsOK());
+  EXPECT_EQ(put_rpcs.load(), 1);
+  EXPECT_EQ(delete_rpcs.load(), 1);
+  // d is in [c, e), e and f are in [e, g)
+  EXPECT_EQ(cas_rpcs.load(), 2);
+
+  ASSERT_EQ(ops.size(), key_state.size());
+  for (auto i = 0; i < ops.size(); i++) {
+    EXPECT_EQ(ops[i].key, key_state[i].key);
+    EXPECT_EQ(ops[i].key != "f", key_state[i].state);
+  }
+}
+
+TEST_F(SDKRawKVTest, BatchWriteDuplicateKey) {
+  std::vector<RawKvOp> ops;
+  ops.push_back({kRawKvPut, "a", "ra", ""});
+  ops.push_back({kRawKvDelete, "a", "", ""});
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(0);
+
+  std::vector<KeyOpState> key_state;
+  Status result = raw_kv->BatchWrite(ops, key_state);
+  EXPECT_TRUE(result.IsInvalidArgument());
+}
+
 TEST_F(SDKRawKVTest, ScanInvalid) {
   std::vector<KVPair> kvs;
   Status ret = raw_kv->Scan("a", "", 0, kvs);
@@ -949,6 +1485,15 @@ TEST_F(SDKRawKVTest, ScanInvalid) {
   EXPECT_TRUE(ret.IsInvalidArgument());
 }
 
+TEST_F(SDKRawKVTest, AsyncScanInvalid) {
+  std::vector<KVPair> kvs;
+  Status ret;
+  Synchronizer sync;
+  raw_kv->AsyncScan("b", "a", 0, kvs, sync.AsStatusCallBack(ret));
+  sync.Wait();
+  EXPECT_TRUE(ret.IsInvalidArgument());
+}
+
 TEST_F(SDKRawKVTest, ScanNotFoundRegion) {
   std::vector<KVPair> kvs;
   Status ret = raw_kv->Scan("x", "z", 0, kvs);
@@ -1256,6 +1801,344 @@ TEST_F(SDKRawKVTest, ScanTwoRegionWithLimit) {
   }
 }
 
+TEST_F(SDKRawKVTest, ScanTwoRegionWithLimitResultSet) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {{"a", {"a001", "a002", "a003"}},
+                                                                 {"c", {"c001", "c002", "c003"}}};
+  std::map<std::string, size_t> iters;
+
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .Times(2)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        auto mock_scanner =
+            std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+        std::string region_start = options.region->Range().start_key();
+        auto& datas = fake_datas[region_start];
+        auto& iter = iters[region_start];
+
+        EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([&](StatusCallback cb) { cb(Status::OK()); });
+
+        EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([&]() { return iter < datas.size(); });
+
+        EXPECT_CALL(*mock_scanner, AsyncNextBatch).WillRepeatedly([&](std::vector<KVPair>& kvs, StatusCallback cb) {
+          if (iter < datas.size()) {
+            kvs.push_back({datas[iter], datas[iter]});
+            iter++;
+          }
+          cb(Status::OK());
+        });
+
+        scanner = std::move(mock_scanner);
+        return Status::OK();
+      });
+
+  int limit = 5;
+  KvResultSet kvs;
+  Status ret = raw_kv->Scan("a", "e", limit, kvs);
+  EXPECT_TRUE(ret.IsOK());
+
+  ASSERT_EQ(kvs.Size(), limit);
+  EXPECT_EQ(kvs.Key(0).ToString(), "a001");
+  EXPECT_EQ(kvs.Key(4).ToString(), "c002");
+  for (size_t i = 0; i < kvs.Size(); ++i) {
+    EXPECT_EQ(kvs.Key(i).ToString(), kvs.Value(i).ToString());
+  }
+}
+
+TEST_F(SDKRawKVTest, ParallelScanThreeRegion) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {"c001", "c002", "c003"}}, {"e", {"e001", "e002", "e003"}}};
+  std::map<std::string, size_t> iters;
+
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        auto mock_scanner =
+            std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+        std::string region_start = options.region->Range().start_key();
+        iters[region_start] = 0;
+
+        EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([&](StatusCallback cb) { cb(Status::OK()); });
+
+        EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([&, region_start]() {
+          return iters[region_start] < fake_datas[region_start].size();
+        });
+
+        EXPECT_CALL(*mock_scanner, AsyncNextBatch)
+            .WillRepeatedly([&, region_start](std::vector<KVPair>& kvs, StatusCallback cb) {
+              auto& iter = iters[region_start];
+              const auto& datas = fake_datas[region_start];
+              if (iter < datas.size()) {
+                kvs.push_back({datas[iter], datas[iter]});
+                iter++;
+              }
+              cb(Status::OK());
+            });
+
+        scanner = std::move(mock_scanner);
+        return Status::OK();
+      });
+
+  int64_t old_parallelism = FLAGS_raw_kv_scan_parallelism;
+  FLAGS_raw_kv_scan_parallelism = 2;
+
+  {
+    std::vector<KVPair> kvs;
+    Status ret = raw_kv->Scan("a", "g", 0, kvs);
+    EXPECT_TRUE(ret.IsOK());
+
+    std::vector<std::string> expected = {"a001", "a002", "a003", "c001", "c002", "c003", "e001", "e002", "e003"};
+    ASSERT_EQ(kvs.size(), expected.size());
+    for (size_t i = 0; i < kvs.size(); i++) {
+      EXPECT_EQ(kvs[i].key, expected[i]);
+    }
+  }
+
+  {
+    std::vector<KVPair> kvs;
+    Status ret = raw_kv->Scan("a", "g", 4, kvs);
+    EXPECT_TRUE(ret.IsOK());
+
+    std::vector<std::string> expected = {"a001", "a002", "a003", "c001"};
+    ASSERT_EQ(kvs.size(), expected.size());
+    for (size_t i = 0; i < kvs.size(); i++) {
+      EXPECT_EQ(kvs[i].key, expected[i]);
+    }
+  }
+
+  FLAGS_raw_kv_scan_parallelism = old_parallelism;
+}
+
+TEST_F(SDKRawKVTest, ScanResumeAfterRegionChanged) {
+  std::vector<std::string> fake_datas = {"a001", "a002", "a003", "c001", "c002", "c003"};
+
+  for (int64_t parallelism : {1, 2}) {
+    int64_t old_parallelism = FLAGS_raw_kv_scan_parallelism;
+    FLAGS_raw_kv_scan_parallelism = parallelism;
+    int64_t old_delay_ms = FLAGS_raw_kv_delay_ms;
+    FLAGS_raw_kv_delay_ms = 1;
+
+    // region a2c changes once after the first batch, its scanner fails then
+    bool region_changed = false;
+    std::vector<std::string> start_keys;
+    std::mutex mutex;
+
+    EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+        .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+          auto mock_scanner =
+              std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+          {
+            std::unique_lock<std::mutex> lk(mutex);
+            start_keys.push_back(options.start_key);
+          }
+
+          auto iter = std::make_shared<size_t>(0);
+          auto datas = std::make_shared<std::vector<std::string>>();
+          for (const auto& key : fake_datas) {
+            if (key >= options.start_key && key < options.end_key) {
+              datas->push_back(key);
+            }
+          }
+
+          EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([](StatusCallback cb) { cb(Status::OK()); });
+
+          EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([iter, datas]() { return *iter < datas->size(); });
+
+          EXPECT_CALL(*mock_scanner, AsyncNextBatch)
+              .WillRepeatedly([&, iter, datas](std::vector<KVPair>& kvs, StatusCallback cb) {
+                {
+                  std::unique_lock<std::mutex> lk(mutex);
+                  if (*iter == 1 && (*datas)[0] < "c" && !region_changed) {
+                    region_changed = true;
+                    cb(Status::Incomplete(pb::error::EREGION_VERSION, "region version changed"));
+                    return;
+                  }
+                }
+
+                if (*iter < datas->size()) {
+                  kvs.push_back({(*datas)[*iter], (*datas)[*iter]});
+                  (*iter)++;
+                }
+                cb(Status::OK());
+              });
+
+          scanner = std::move(mock_scanner);
+          return Status::OK();
+        });
+
+    std::vector<KVPair> kvs;
+    Status ret = raw_kv->Scan("a", "e", 0, kvs);
+    EXPECT_TRUE(ret.IsOK()) << ret.ToString();
+
+    // no kv is read twice
+    ASSERT_EQ(kvs.size(), fake_datas.size());
+    for (size_t i = 0; i < kvs.size(); i++) {
+      EXPECT_EQ(kvs[i].key, fake_datas[i]);
+    }
+
+    EXPECT_TRUE(region_changed);
+    EXPECT_EQ(start_keys.size(), 3);
+    EXPECT_NE(std::find(start_keys.begin(), start_keys.end(), std::string("a001\0", 5)), start_keys.end());
+
+    FLAGS_raw_kv_scan_parallelism = old_parallelism;
+    FLAGS_raw_kv_delay_ms = old_delay_ms;
+  }
+}
+
+TEST_F(SDKRawKVTest, ReverseScanThreeRegionWithLimit) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {"c001", "c002", "c003"}}, {"e", {"e001", "e002", "e003"}}};
+  std::map<std::string, size_t> iters;
+
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        EXPECT_FALSE(options.reverse);
+        auto mock_scanner =
+            std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+        std::string region_start = options.region->Range().start_key();
+        iters[region_start] = 0;
+
+        EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([&](StatusCallback cb) { cb(Status::OK()); });
+
+        EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([&, region_start]() {
+          return iters[region_start] < fake_datas[region_start].size();
+        });
+
+        EXPECT_CALL(*mock_scanner, AsyncNextBatch)
+            .WillRepeatedly([&, region_start](std::vector<KVPair>& kvs, StatusCallback cb) {
+              auto& iter = iters[region_start];
+              const auto& datas = fake_datas[region_start];
+              if (iter < datas.size()) {
+                kvs.push_back({datas[iter], datas[iter]});
+                iter++;
+              }
+              cb(Status::OK());
+            });
+
+        scanner = std::move(mock_scanner);
+        return Status::OK();
+      });
+
+  std::vector<KVPair> kvs;
+  Status ret = raw_kv->ReverseScan("a", "g", 4, kvs);
+  EXPECT_TRUE(ret.IsOK());
+
+  std::vector<std::string> expected = {"e003", "e002", "e001", "c003"};
+  ASSERT_EQ(kvs.size(), expected.size());
+  for (size_t i = 0; i < kvs.size(); i++) {
+    EXPECT_EQ(kvs[i].key, expected[i]);
+  }
+
+  // limit is filled by the last two regions
+  EXPECT_EQ(iters.count("a"), 0);
+}
+
+TEST_F(SDKRawKVTest, CountRangeThreeRegion) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {"c001", "c002"}}, {"e", {"e001"}}};
+  std::map<std::string, size_t> iters;
+  std::mutex iters_mutex;
+
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        EXPECT_TRUE(options.key_only);
+        auto mock_scanner =
+            std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+        std::string region_start = options.region->Range().start_key();
+        {
+          std::unique_lock<std::mutex> lk(iters_mutex);
+          iters[region_start] = 0;
+        }
+
+        EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([&](StatusCallback cb) { cb(Status::OK()); });
+
+        EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([&, region_start]() {
+          std::unique_lock<std::mutex> lk(iters_mutex);
+          return iters[region_start] < fake_datas[region_start].size();
+        });
+
+        EXPECT_CALL(*mock_scanner, AsyncNextBatch)
+            .WillRepeatedly([&, region_start](std::vector<KVPair>& kvs, StatusCallback cb) {
+              {
+                std::unique_lock<std::mutex> lk(iters_mutex);
+                auto& iter = iters[region_start];
+                const auto& datas = fake_datas[region_start];
+                if (iter < datas.size()) {
+                  kvs.push_back({datas[iter], ""});
+                  iter++;
+                }
+              }
+              cb(Status::OK());
+            });
+
+        scanner = std::move(mock_scanner);
+        return Status::OK();
+      });
+
+  int64_t count = 0;
+  Status ret = raw_kv->CountRange("a", "g", count);
+  EXPECT_TRUE(ret.IsOK());
+  EXPECT_EQ(count, 6);
+}
+
+TEST_F(SDKRawKVTest, IteratorThreeRegion) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {"c001", "c002", "c003"}}, {"e", {"e001", "e002", "e003"}}};
+  std::map<std::string, size_t> iters;
+
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        auto mock_scanner =
+            std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+        std::string region_start = options.region->Range().start_key();
+        // skip fake datas before scanner start key
+        const auto& region_datas = fake_datas[region_start];
+        iters[region_start] =
+            std::lower_bound(region_datas.begin(), region_datas.end(), options.start_key) - region_datas.begin();
+
+        EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([&](StatusCallback cb) { cb(Status::OK()); });
+
+        EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([&, region_start]() {
+          return iters[region_start] < fake_datas[region_start].size();
+        });
+
+        EXPECT_CALL(*mock_scanner, AsyncNextBatch)
+            .WillRepeatedly([&, region_start](std::vector<KVPair>& kvs, StatusCallback cb) {
+              auto& iter = iters[region_start];
+              const auto& datas = fake_datas[region_start];
+              if (iter < datas.size()) {
+                kvs.push_back({datas[iter], datas[iter]});
+                iter++;
+              }
+              cb(Status::OK());
+            });
+
+        scanner = std::move(mock_scanner);
+        return Status::OK();
+      });
+
+  KvIterator* tmp;
+  Status ret = raw_kv->NewIterator("a", "g", &tmp);
+  ASSERT_TRUE(ret.IsOK());
+  std::unique_ptr<KvIterator> iter(tmp);
+
+  std::vector<std::string> expected = {"a001", "a002", "a003", "c001", "c002", "c003", "e001", "e002", "e003"};
+  std::vector<std::string> got;
+  for (; iter->Valid(); iter->Next()) {
+    EXPECT_EQ(iter->key(), iter->value());
+    got.push_back(iter->key());
+  }
+  EXPECT_TRUE(iter->status().ok());
+  EXPECT_EQ(got, expected);
+
+  ret = iter->Seek("c002");
+  EXPECT_TRUE(ret.IsOK());
+  ASSERT_TRUE(iter->Valid());
+  EXPECT_EQ(iter->key(), "c002");
+
+  ret = iter->Seek("g");
+  EXPECT_TRUE(ret.IsOK());
+  EXPECT_FALSE(iter->Valid());
+}
+
 TEST_F(SDKRawKVTest, ScanRegionDiscontinuous) {
   std::vector<std::string> a2c_fake_datas = {"a001", "a002", "a003"};
   int a2c_iter = 0;
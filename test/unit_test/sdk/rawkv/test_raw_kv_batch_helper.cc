@@ -0,0 +1,76 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/client.h"
+#include "sdk/rawkv/raw_kv_batch_helper.h"
+#include "sdk/status.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKRawKVBatchHelperTest : public TestBase {};
+
+TEST_F(SDKRawKVBatchHelperTest, PartitionKeysByRegion) {
+  std::vector<std::string> keys = {"a", "b", "c", "d", "e", "f"};
+  std::set<std::string_view> key_set(keys.begin(), keys.end());
+
+  std::vector<RegionKeys> groups;
+  Status s = PartitionKeysByRegion(*meta_cache, key_set, groups);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(groups.size(), 3);
+
+  size_t total = 0;
+  for (const auto& group : groups) {
+    EXPECT_EQ(group.keys.size(), 2);
+    for (const auto& key : group.keys) {
+      EXPECT_GE(key, group.region->Range().start_key());
+      EXPECT_LT(key, group.region->Range().end_key());
+      // key must be a view of caller's input
+      auto found = std::find_if(keys.begin(), keys.end(), [&](const std::string& k) { return k.data() == key.data(); });
+      EXPECT_NE(found, keys.end());
+    }
+    total += group.keys.size();
+  }
+  EXPECT_EQ(total, keys.size());
+}
+
+TEST_F(SDKRawKVBatchHelperTest, BuildKeyIndex) {
+  std::vector<KVPair> kvs = {{"a", "1"}, {"c", "2"}, {"b", "3"}};
+
+  KeyIndexMap index;
+  std::string_view dup_key;
+  EXPECT_TRUE(BuildKeyIndex(
+      kvs, [](const KVPair& kv) -> std::string_view { return kv.key; }, index, dup_key));
+  EXPECT_EQ(index.size(), kvs.size());
+  for (size_t i = 0; i < kvs.size(); i++) {
+    EXPECT_EQ(index.at(kvs[i].key), i);
+  }
+
+  kvs.push_back({"c", "4"});
+  EXPECT_FALSE(BuildKeyIndex(
+      kvs, [](const KVPair& kv) -> std::string_view { return kv.key; }, index, dup_key));
+  EXPECT_EQ(dup_key, "c");
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,157 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "sdk/rawkv/raw_kv_read_cache.h"
+#include "sdk/rpc/store_rpc.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKRawKVReadCacheTest : public TestBase {
+ public:
+  void SetUp() override {
+    TestBase::SetUp();
+    // default capacity is 0, replace the disabled cache
+    raw_kv_read_cache = std::make_shared<RawKvReadCache>(16, 60 * 1000);
+    ON_CALL(*stub, GetRawKvReadCache).WillByDefault(testing::Return(raw_kv_read_cache));
+
+    RawKV* tmp;
+    Status s = client->NewRawKV(&tmp);
+    CHECK(s.IsOK());
+    raw_kv.reset(tmp);
+  }
+
+  void TearDown() override { raw_kv.reset(); }
+
+  std::shared_ptr<RawKV> raw_kv;
+};
+
+TEST_F(SDKRawKVReadCacheTest, PutGetAndInvalidate) {
+  auto region = RegionA2C();
+  RawKvReadCache cache(16, 60 * 1000);
+
+  std::string value;
+  EXPECT_FALSE(cache.Get("b", value));
+
+  cache.Put("b", "v1", region, cache.WriteSeq());
+  EXPECT_TRUE(cache.Get("b", value));
+  EXPECT_EQ(value, "v1");
+
+  cache.Invalidate("b");
+  EXPECT_FALSE(cache.Get("b", value));
+}
+
+TEST_F(SDKRawKVReadCacheTest, SkipPutAfterWrite) {
+  auto region = RegionA2C();
+  RawKvReadCache cache(16, 60 * 1000);
+
+  uint64_t seq = cache.WriteSeq();
+  // a write finished while the read was in flight
+  cache.Invalidate("b");
+  cache.Put("b", "v1", region, seq);
+
+  std::string value;
+  EXPECT_FALSE(cache.Get("b", value));
+}
+
+TEST_F(SDKRawKVReadCacheTest, DropStaleRegion) {
+  auto region = RegionA2C();
+  RawKvReadCache cache(16, 60 * 1000);
+
+  cache.Put("b", "v1", region, cache.WriteSeq());
+  region->TEST_MarkStale();
+
+  std::string value;
+  EXPECT_FALSE(cache.Get("b", value));
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST_F(SDKRawKVReadCacheTest, DropExpired) {
+  auto region = RegionA2C();
+  RawKvReadCache cache(16, 1);
+
+  cache.Put("b", "v1", region, cache.WriteSeq());
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  std::string value;
+  EXPECT_FALSE(cache.Get("b", value));
+}
+
+TEST_F(SDKRawKVReadCacheTest, InvalidateRangeAndEvict) {
+  auto region = RegionA2C();
+  RawKvReadCache cache(3, 60 * 1000);
+
+  cache.Put("a1", "v", region, cache.WriteSeq());
+  cache.Put("a2", "v", region, cache.WriteSeq());
+  cache.Put("b1", "v", region, cache.WriteSeq());
+
+  std::string value;
+  // a1 becomes the most recently used, a2 is evicted next
+  EXPECT_TRUE(cache.Get("a1", value));
+  cache.Put("b2", "v", region, cache.WriteSeq());
+  EXPECT_FALSE(cache.Get("a2", value));
+  EXPECT_EQ(cache.Size(), 3);
+
+  cache.InvalidateRange("b", "c");
+  EXPECT_TRUE(cache.Get("a1", value));
+  EXPECT_FALSE(cache.Get("b1", value));
+  EXPECT_FALSE(cache.Get("b2", value));
+}
+
+TEST_F(SDKRawKVReadCacheTest, GetHitCacheAndPutInvalidate) {
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        kv_get_rpc->MutableResponse()->set_value("v1");
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_put_rpc = dynamic_cast<KvPutRpc*>(&rpc);
+        CHECK_NOTNULL(kv_put_rpc);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        kv_get_rpc->MutableResponse()->set_value("v2");
+        cb();
+      });
+
+  std::string value;
+  EXPECT_TRUE(raw_kv->Get("b", value).IsOK());
+  EXPECT_EQ(value, "v1");
+
+  // served by cache, no rpc
+  value.clear();
+  EXPECT_TRUE(raw_kv->Get("b", value).IsOK());
+  EXPECT_EQ(value, "v1");
+
+  EXPECT_TRUE(raw_kv->Put("b", "v2").IsOK());
+
+  value.clear();
+  EXPECT_TRUE(raw_kv->Get("b", value).IsOK());
+  EXPECT_EQ(value, "v2");
+}
+
+}  // namespace sdk
+}  // namespace dingodb
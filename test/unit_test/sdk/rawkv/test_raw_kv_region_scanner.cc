@@ -203,7 +203,7 @@ TEST_F(SDKRawKvRegionScannerImplTest, SetBatchSize) {
   EXPECT_EQ(scanner.GetBatchSize(), kMinScanBatchSize);
 
   scanner.SetBatchSize(INT64_MAX);
-  EXPECT_EQ(scanner.GetBatchSize(), kMaxScanBatchSize);
+  EXPECT_EQ(scanner.GetBatchSize(), FLAGS_scan_batch_max_size);
 
   scanner.SetBatchSize(20);
   EXPECT_EQ(scanner.GetBatchSize(), 20);
@@ -394,6 +394,120 @@ TEST_F(SDKRawKvRegionScannerImplTest, NextBatchWithData) {
   }
 }
 
+TEST_F(SDKRawKvRegionScannerImplTest, KeyOnly) {
+  testing::InSequence s;
+
+  std::shared_ptr<Region> region;
+  CHECK(meta_cache->LookupRegionBetweenRange("a", "c", region).ok());
+  CHECK_NOTNULL(region.get());
+
+  std::string scan_id = "101";
+
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_rpc = dynamic_cast<KvScanBeginRpc*>(&rpc);
+        CHECK_NOTNULL(kv_rpc);
+        EXPECT_TRUE(kv_rpc->Request()->key_only());
+
+        kv_rpc->MutableResponse()->set_scan_id(scan_id);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_rpc = dynamic_cast<KvScanReleaseRpc*>(&rpc);
+        CHECK_NOTNULL(kv_rpc);
+        cb();
+      });
+
+  RawKvRegionScannerImpl scanner(*stub, region, region->Range().start_key(), region->Range().end_key(), kLeaderOnly,
+                                 false, true);
+  EXPECT_TRUE(OpenScanner(scanner).ok());
+  CloseScanner(scanner);
+}
+
+TEST_F(SDKRawKvRegionScannerImplTest, ValuePrefix) {
+  std::shared_ptr<Region> region;
+  CHECK(meta_cache->LookupRegionBetweenRange("a", "c", region).ok());
+  CHECK_NOTNULL(region.get());
+
+  std::string scan_id = "101";
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (auto* begin_rpc = dynamic_cast<KvScanBeginRpc*>(&rpc); begin_rpc != nullptr) {
+      EXPECT_FALSE(begin_rpc->Request()->key_only());
+      begin_rpc->MutableResponse()->set_scan_id(scan_id);
+    } else if (auto* continue_rpc = dynamic_cast<KvScanContinueRpc*>(&rpc); continue_rpc != nullptr) {
+      auto* kv = continue_rpc->MutableResponse()->add_kvs();
+      kv->set_key("a001");
+      kv->set_value("header-body");
+      kv = continue_rpc->MutableResponse()->add_kvs();
+      kv->set_key("a002");
+      kv->set_value("hdr");
+    }
+    cb();
+  });
+
+  RawKvRegionScannerImpl scanner(*stub, region, region->Range().start_key(), region->Range().end_key(), kLeaderOnly,
+                                 false, false, 6);
+  EXPECT_TRUE(OpenScanner(scanner).ok());
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(scanner.NextBatch(kvs).ok());
+  ASSERT_EQ(kvs.size(), 2);
+  EXPECT_EQ(kvs[0].value, "header");
+  EXPECT_EQ(kvs[1].value, "hdr");
+
+  CloseScanner(scanner);
+}
+
+TEST_F(SDKRawKvRegionScannerImplTest, NextBatchInto) {
+  std::shared_ptr<Region> region;
+  CHECK(meta_cache->LookupRegionBetweenRange("a", "c", region).ok());
+  CHECK_NOTNULL(region.get());
+
+  std::string scan_id = "101";
+  int continue_count = 0;
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (auto* begin_rpc = dynamic_cast<KvScanBeginRpc*>(&rpc); begin_rpc != nullptr) {
+      begin_rpc->MutableResponse()->set_scan_id(scan_id);
+    } else if (auto* continue_rpc = dynamic_cast<KvScanContinueRpc*>(&rpc); continue_rpc != nullptr) {
+      continue_count++;
+      auto* kv = continue_rpc->MutableResponse()->add_kvs();
+      kv->set_key(continue_count == 1 ? "a001" : "a002");
+      kv->set_value("header-body");
+      if (continue_count == 2) {
+        // out of scanner range
+        kv = continue_rpc->MutableResponse()->add_kvs();
+        kv->set_key("c001");
+        kv->set_value("c001");
+      }
+    }
+    cb();
+  });
+
+  RawKvRegionScannerImpl scanner(*stub, region, region->Range().start_key(), region->Range().end_key(), kLeaderOnly,
+                                 false, false, 6);
+  EXPECT_TRUE(OpenScanner(scanner).ok());
+
+  // batches are appended, and views stay valid after the rpcs are done
+  KvResultSet out;
+  for (int i = 0; i < 2; ++i) {
+    Status status;
+    Synchronizer sync;
+    scanner.AsyncNextBatchInto(out, sync.AsStatusCallBack(status));
+    sync.Wait();
+    EXPECT_TRUE(status.ok());
+  }
+  EXPECT_FALSE(scanner.HasMore());
+
+  ASSERT_EQ(out.Size(), 2);
+  EXPECT_EQ(out.Key(0).ToString(), "a001");
+  EXPECT_EQ(out.Key(1).ToString(), "a002");
+  EXPECT_EQ(out.Value(1).ToString(), "header");
+
+  CloseScanner(scanner);
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "proto/meta.pb.h"
 #include "sdk/auto_increment_manager.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/vector/vector_common.h"
 #include "sdk/vector/vector_index.h"
@@ -202,5 +203,75 @@ TEST_F(SDKAutoInrementerTest, MultiThread) {
   t3.join();
 }
 
+TEST_F(SDKAutoInrementerTest, PrefetchNextRange) {
+  bool old_prefetch = FLAGS_auto_incre_prefetch;
+  FLAGS_auto_incre_prefetch = true;
+
+  EXPECT_CALL(*meta_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->count(), FLAGS_auto_incre_req_count);
+        t_rpc->MutableResponse()->set_start_id(1);
+        t_rpc->MutableResponse()->set_end_id(3);
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        // prefetched in background, first range used up fast so count grows
+        auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->count(), FLAGS_auto_incre_req_count * 2);
+        // big enough to stay above low watermark, no more prefetch
+        t_rpc->MutableResponse()->set_start_id(3);
+        t_rpc->MutableResponse()->set_end_id(3 + FLAGS_auto_incre_req_count * 2);
+        return Status::OK();
+      });
+
+  {
+    int64_t id = 0;
+    Status s = incrementer->GetNextId(id);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(id, 1);
+  }
+
+  {
+    std::vector<int64_t> ids;
+    Status s = incrementer->GetNextIds(ids, 3);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(ids, std::vector<int64_t>({2, 3, 4}));
+  }
+
+  FLAGS_auto_incre_prefetch = old_prefetch;
+}
+
+TEST_F(SDKAutoInrementerTest, Prewarm) {
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+    EXPECT_EQ(t_rpc->Request()->count(), FLAGS_auto_incre_req_count);
+    t_rpc->MutableResponse()->set_start_id(1);
+    t_rpc->MutableResponse()->set_end_id(3);
+    return Status::OK();
+  });
+
+  incrementer->Prewarm();
+  // in flight or done, either way no second fetch
+  incrementer->Prewarm();
+
+  {
+    int64_t id = 0;
+    Status s = incrementer->GetNextId(id);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(id, 1);
+  }
+
+  // no-op once ids were asked for
+  incrementer->Prewarm();
+
+  {
+    int64_t id = 0;
+    Status s = incrementer->GetNextId(id);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(id, 2);
+  }
+}
+
 }  // namespace sdk
-}  // namespace dingodb
\ No newline at end of file
+}  // namespace dingodb
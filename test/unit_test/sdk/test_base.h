@@ -28,12 +28,18 @@
 #include "sdk/auto_increment_manager.h"
 #include "sdk/client.h"
 #include "sdk/client_internal_data.h"
+#include "sdk/document/document_index_cache.h"
+#include "sdk/expression/langchain_expr_cache.h"
 #include "sdk/meta_cache.h"
 #include "sdk/transaction/txn_impl.h"
+#include "sdk/transaction/txn_region_scanner_impl.h"
+#include "sdk/utils/aggregate_cache.h"
 #include "sdk/utils/actuator.h"
 #include "sdk/utils/thread_pool_actuator.h"
 #include "sdk/vector.h"
 #include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_payload_cache.h"
+#include "sdk/vector/vector_search_cache.h"
 #include "test_common.h"
 #include "transaction/mock_txn_lock_resolver.h"
 
@@ -66,11 +72,55 @@ class TestBase : public ::testing::Test {
     store_rpc_client = std::make_shared<MockRpcClient>(options);
     ON_CALL(*stub, GetStoreRpcClient).WillByDefault(testing::Return(store_rpc_client));
     EXPECT_CALL(*stub, GetStoreRpcClient).Times(testing::AnyNumber());
+    // coordinator rpcs go to the same mock
+    ON_CALL(*stub, GetCoordinatorRpcClient).WillByDefault(testing::Return(store_rpc_client));
+    EXPECT_CALL(*stub, GetCoordinatorRpcClient).Times(testing::AnyNumber());
+
+    replica_selector = std::make_shared<ReplicaSelector>();
+    ON_CALL(*stub, GetReplicaSelector).WillByDefault(testing::Return(replica_selector));
+    EXPECT_CALL(*stub, GetReplicaSelector).Times(testing::AnyNumber());
+
+    region_circuit_breaker = std::make_shared<RegionCircuitBreaker>();
+    ON_CALL(*stub, GetRegionCircuitBreaker).WillByDefault(testing::Return(region_circuit_breaker));
+    EXPECT_CALL(*stub, GetRegionCircuitBreaker).Times(testing::AnyNumber());
+
+    write_rate_limiter = std::make_shared<WriteRateLimiter>();
+    ON_CALL(*stub, GetWriteRateLimiter).WillByDefault(testing::Return(write_rate_limiter));
+    EXPECT_CALL(*stub, GetWriteRateLimiter).Times(testing::AnyNumber());
+
+    memory_budget = std::make_shared<MemoryBudget>();
+    ON_CALL(*stub, GetMemoryBudget).WillByDefault(testing::Return(memory_budget));
+    EXPECT_CALL(*stub, GetMemoryBudget).Times(testing::AnyNumber());
+
+    retry_budget = std::make_shared<RetryBudget>();
+    ON_CALL(*stub, GetRetryBudget).WillByDefault(testing::Return(retry_budget));
+    EXPECT_CALL(*stub, GetRetryBudget).Times(testing::AnyNumber());
+
+    store_connection_manager = std::make_shared<StoreConnectionManager>(*stub);
+    ON_CALL(*stub, GetStoreConnectionManager).WillByDefault(testing::Return(store_connection_manager));
+    EXPECT_CALL(*stub, GetStoreConnectionManager).Times(testing::AnyNumber());
 
     region_scanner_factory = std::make_shared<MockRegionScannerFactory>();
     ON_CALL(*stub, GetRawKvRegionScannerFactory).WillByDefault(testing::Return(region_scanner_factory));
     EXPECT_CALL(*stub, GetRawKvRegionScannerFactory).Times(testing::AnyNumber());
 
+    txn_region_scanner_factory = std::make_shared<TxnRegionScannerFactoryImpl>();
+    ON_CALL(*stub, GetTxnRegionScannerFactory).WillByDefault(testing::Return(txn_region_scanner_factory));
+    EXPECT_CALL(*stub, GetTxnRegionScannerFactory).Times(testing::AnyNumber());
+
+    raw_kv_get_single_flight = std::make_shared<RawKvGetSingleFlight>();
+    ON_CALL(*stub, GetRawKvGetSingleFlight).WillByDefault(testing::Return(raw_kv_get_single_flight));
+    EXPECT_CALL(*stub, GetRawKvGetSingleFlight).Times(testing::AnyNumber());
+
+    raw_kv_auto_batcher = std::make_shared<RawKvAutoBatcher>(*stub);
+    ON_CALL(*stub, GetRawKvAutoBatcher).WillByDefault(testing::Return(raw_kv_auto_batcher));
+    EXPECT_CALL(*stub, GetRawKvAutoBatcher).Times(testing::AnyNumber());
+
+    raw_kv_read_cache =
+        std::make_shared<RawKvReadCache>(FLAGS_raw_kv_read_cache_capacity, FLAGS_raw_kv_read_cache_ttl_ms);
+    ON_CALL(*stub, GetRawKvReadCache).WillByDefault(testing::Return(raw_kv_read_cache));
+    EXPECT_CALL(*stub, GetRawKvReadCache).Times(testing::AnyNumber());
+
     admin_tool = std::make_shared<AdminTool>(*stub);
     ON_CALL(*stub, GetAdminTool).WillByDefault(testing::Return(admin_tool));
     EXPECT_CALL(*stub, GetAdminTool).Times(testing::AnyNumber());
@@ -84,14 +134,57 @@ class TestBase : public ::testing::Test {
     ON_CALL(*stub, GetActuator).WillByDefault(testing::Return(actuator));
     EXPECT_CALL(*stub, GetActuator).Times(testing::AnyNumber());
 
+    background_actuator = std::make_shared<ThreadPoolActuator>();
+    background_actuator->Start(FLAGS_background_actuator_thread_num);
+    ON_CALL(*stub, GetBackgroundActuator).WillByDefault(testing::Return(background_actuator));
+    EXPECT_CALL(*stub, GetBackgroundActuator).Times(testing::AnyNumber());
+
     index_cache = std::make_shared<VectorIndexCache>(*stub);
     ON_CALL(*stub, GetVectorIndexCache).WillByDefault(testing::Return(index_cache));
     EXPECT_CALL(*stub, GetVectorIndexCache).Times(testing::AnyNumber());
 
+    vector_search_cache = std::make_shared<VectorSearchCache>(FLAGS_vector_search_cache_capacity_bytes,
+                                                              FLAGS_vector_search_cache_ttl_ms);
+    ON_CALL(*stub, GetVectorSearchCache).WillByDefault(testing::Return(vector_search_cache));
+    EXPECT_CALL(*stub, GetVectorSearchCache).Times(testing::AnyNumber());
+
+    vector_payload_cache =
+        std::make_shared<VectorPayloadCache>(FLAGS_vector_payload_cache_dir, FLAGS_vector_payload_cache_capacity);
+    ON_CALL(*stub, GetVectorPayloadCache).WillByDefault(testing::Return(vector_payload_cache));
+    EXPECT_CALL(*stub, GetVectorPayloadCache).Times(testing::AnyNumber());
+
+    vector_index_metrics_cache = std::make_shared<VectorIndexMetricsCache>(FLAGS_index_metrics_cache_ttl_ms);
+    ON_CALL(*stub, GetVectorIndexMetricsCache).WillByDefault(testing::Return(vector_index_metrics_cache));
+    EXPECT_CALL(*stub, GetVectorIndexMetricsCache).Times(testing::AnyNumber());
+
+    langchain_expr_cache = std::make_shared<expression::LangchainExprCache>(FLAGS_langchain_expr_cache_capacity);
+    ON_CALL(*stub, GetLangchainExprCache).WillByDefault(testing::Return(langchain_expr_cache));
+    EXPECT_CALL(*stub, GetLangchainExprCache).Times(testing::AnyNumber());
+
+    document_index_cache = std::make_shared<DocumentIndexCache>(*stub);
+    ON_CALL(*stub, GetDocumentIndexCache).WillByDefault(testing::Return(document_index_cache));
+    EXPECT_CALL(*stub, GetDocumentIndexCache).Times(testing::AnyNumber());
+
+    document_index_metrics_cache = std::make_shared<DocumentIndexMetricsCache>(FLAGS_index_metrics_cache_ttl_ms);
+    ON_CALL(*stub, GetDocumentIndexMetricsCache).WillByDefault(testing::Return(document_index_metrics_cache));
+    EXPECT_CALL(*stub, GetDocumentIndexMetricsCache).Times(testing::AnyNumber());
+
     auto_increment_manager = std::make_shared<AutoIncrementerManager>(*stub);
     ON_CALL(*stub, GetAutoIncrementerManager).WillByDefault(testing::Return(auto_increment_manager));
     EXPECT_CALL(*stub, GetAutoIncrementerManager).Times(testing::AnyNumber());
 
+    meta_cache_warmer = std::make_shared<MetaCacheWarmer>(*stub);
+    ON_CALL(*stub, GetMetaCacheWarmer).WillByDefault(testing::Return(meta_cache_warmer));
+    EXPECT_CALL(*stub, GetMetaCacheWarmer).Times(testing::AnyNumber());
+
+    meta_cache_watcher = std::make_shared<MetaCacheWatcher>(*stub);
+    ON_CALL(*stub, GetMetaCacheWatcher).WillByDefault(testing::Return(meta_cache_watcher));
+    EXPECT_CALL(*stub, GetMetaCacheWatcher).Times(testing::AnyNumber());
+
+    meta_member_refresher = std::make_shared<MetaMemberRefresher>(*stub);
+    ON_CALL(*stub, GetMetaMemberRefresher).WillByDefault(testing::Return(meta_member_refresher));
+    EXPECT_CALL(*stub, GetMetaMemberRefresher).Times(testing::AnyNumber());
+
     client = new Client();
     client->data_->stub = std::move(tmp);
   }
@@ -115,12 +208,32 @@ class TestBase : public ::testing::Test {
   std::shared_ptr<MockCoordinatorRpcController> meta_rpc_controller;
   std::shared_ptr<MetaCache> meta_cache;
   std::shared_ptr<MockRpcClient> store_rpc_client;
+  std::shared_ptr<ReplicaSelector> replica_selector;
+  std::shared_ptr<RegionCircuitBreaker> region_circuit_breaker;
+  std::shared_ptr<WriteRateLimiter> write_rate_limiter;
+  std::shared_ptr<MemoryBudget> memory_budget;
+  std::shared_ptr<RetryBudget> retry_budget;
+  std::shared_ptr<StoreConnectionManager> store_connection_manager;
   std::shared_ptr<MockRegionScannerFactory> region_scanner_factory;
+  std::shared_ptr<TxnRegionScannerFactoryImpl> txn_region_scanner_factory;
+  std::shared_ptr<RawKvGetSingleFlight> raw_kv_get_single_flight;
+  std::shared_ptr<RawKvAutoBatcher> raw_kv_auto_batcher;
+  std::shared_ptr<RawKvReadCache> raw_kv_read_cache;
   std::shared_ptr<AdminTool> admin_tool;
   std::shared_ptr<MockTxnLockResolver> txn_lock_resolver;
   std::shared_ptr<Actuator> actuator;
+  std::shared_ptr<Actuator> background_actuator;
   std::shared_ptr<VectorIndexCache> index_cache;
+  std::shared_ptr<VectorSearchCache> vector_search_cache;
+  std::shared_ptr<VectorPayloadCache> vector_payload_cache;
+  std::shared_ptr<VectorIndexMetricsCache> vector_index_metrics_cache;
+  std::shared_ptr<expression::LangchainExprCache> langchain_expr_cache;
+  std::shared_ptr<DocumentIndexCache> document_index_cache;
+  std::shared_ptr<DocumentIndexMetricsCache> document_index_metrics_cache;
   std::shared_ptr<AutoIncrementerManager> auto_increment_manager;
+  std::shared_ptr<MetaCacheWarmer> meta_cache_warmer;
+  std::shared_ptr<MetaCacheWatcher> meta_cache_watcher;
+  std::shared_ptr<MetaMemberRefresher> meta_member_refresher;
 
   // client own stub
   MockClientStub* stub;
@@ -0,0 +1,78 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "sdk/cancel_token.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKCancelTokenTest, NoDeadline) {
+  CancelToken token;
+  EXPECT_FALSE(token.IsExpired());
+  EXPECT_EQ(token.RemainingMs(), -1);
+  EXPECT_TRUE(token.Check().ok());
+
+  token.Cancel();
+  EXPECT_TRUE(token.Check().IsAborted());
+}
+
+TEST(SDKCancelTokenTest, Deadline) {
+  CancelToken token(10000);
+  EXPECT_FALSE(token.IsExpired());
+  EXPECT_GT(token.RemainingMs(), 0);
+  EXPECT_LE(token.RemainingMs(), 10000);
+  EXPECT_TRUE(token.Check().ok());
+
+  token.SetTimeoutMs(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  EXPECT_TRUE(token.IsExpired());
+  EXPECT_EQ(token.RemainingMs(), 0);
+  EXPECT_TRUE(token.Check().IsTimedOut());
+
+  // cancel wins over deadline
+  token.Cancel();
+  EXPECT_TRUE(token.Check().IsAborted());
+
+  token.SetTimeoutMs(0);
+  EXPECT_FALSE(token.IsExpired());
+}
+
+TEST(SDKCancelTokenTest, Scoped) {
+  EXPECT_EQ(CancelToken::Current(), nullptr);
+
+  auto outer = std::make_shared<CancelToken>();
+  auto inner = std::make_shared<CancelToken>();
+  {
+    ScopedCancelToken outer_scope(outer);
+    EXPECT_EQ(CancelToken::Current(), outer);
+    {
+      ScopedCancelToken inner_scope(inner);
+      EXPECT_EQ(CancelToken::Current(), inner);
+    }
+    EXPECT_EQ(CancelToken::Current(), outer);
+
+    // other threads do not see the token
+    std::thread([] { EXPECT_EQ(CancelToken::Current(), nullptr); }).join();
+  }
+  EXPECT_EQ(CancelToken::Current(), nullptr);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/client_stub.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKClientStubTest, ShareRuntime) {
+  std::vector<EndPoint> endpoints = {EndPoint("127.0.0.1", 22001)};
+  StubRuntime runtime = StubRuntime::New();
+
+  {
+    ClientStub one;
+    ClientStub two;
+    ASSERT_TRUE(one.Open(endpoints, runtime).ok());
+    ASSERT_TRUE(two.Open(endpoints, runtime).ok());
+
+    EXPECT_EQ(one.GetActuator(), two.GetActuator());
+    EXPECT_EQ(one.GetStoreRpcClient(), two.GetStoreRpcClient());
+    EXPECT_EQ(one.GetReplicaSelector(), two.GetReplicaSelector());
+    // caches are not shared
+    EXPECT_NE(one.GetMetaCache(), two.GetMetaCache());
+  }
+
+  // runtime outlives stubs and is still usable
+  ClientStub three;
+  ASSERT_TRUE(three.Open(endpoints, runtime).ok());
+  EXPECT_EQ(three.GetActuator(), runtime.actuator);
+}
+
+TEST(SDKClientStubTest, OwnRuntime) {
+  std::vector<EndPoint> endpoints = {EndPoint("127.0.0.1", 22001)};
+  ClientStub one;
+  ClientStub two;
+  ASSERT_TRUE(one.Open(endpoints).ok());
+  ASSERT_TRUE(two.Open(endpoints).ok());
+
+  EXPECT_NE(one.GetActuator(), two.GetActuator());
+  EXPECT_NE(one.GetStoreRpcClient(), two.GetStoreRpcClient());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,172 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "proto/error.pb.h"
+#include "sdk/common/param_config.h"
+#include "sdk/request_priority.h"
+#include "sdk/rpc/concurrency_limiter.h"
+#include "sdk/rpc/rpc.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/status.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKConcurrencyLimiterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_store_rpc_concurrency_initial_limit = 4;
+    FLAGS_store_rpc_concurrency_min_limit = 2;
+    FLAGS_store_rpc_concurrency_max_limit = 8;
+    FLAGS_store_rpc_concurrency_queue_size = 1;
+  }
+
+  void TearDown() override {
+    FLAGS_store_rpc_concurrency_initial_limit = 64;
+    FLAGS_store_rpc_concurrency_min_limit = 4;
+    FLAGS_store_rpc_concurrency_max_limit = 1024;
+    FLAGS_store_rpc_concurrency_queue_size = 1024;
+  }
+};
+
+TEST_F(SDKConcurrencyLimiterTest, AdmitQueueAndReject) {
+  EndPointConcurrencyLimit limit;
+  for (int i = 0; i < 4; i++) {
+    std::function<void()> send = [] {};
+    EXPECT_EQ(limit.Admit(send), EndPointConcurrencyLimit::kAdmitted);
+  }
+
+  bool queued_sent = false;
+  std::function<void()> queued = [&] { queued_sent = true; };
+  EXPECT_EQ(limit.Admit(queued), EndPointConcurrencyLimit::kQueued);
+
+  std::function<void()> rejected = [] {};
+  EXPECT_EQ(limit.Admit(rejected), EndPointConcurrencyLimit::kRejected);
+
+  auto snapshot = limit.GetSnapshot();
+  EXPECT_EQ(snapshot.limit, 4);
+  EXPECT_EQ(snapshot.in_flight, 4);
+  EXPECT_EQ(snapshot.queued, 1);
+  EXPECT_EQ(snapshot.rejected, 1);
+
+  // the slot is handed over to the queued send
+  std::function<void()> next = limit.Release(false);
+  ASSERT_TRUE(next);
+  next();
+  EXPECT_TRUE(queued_sent);
+  EXPECT_EQ(limit.GetSnapshot().in_flight, 4);
+  EXPECT_EQ(limit.GetSnapshot().queued, 0);
+}
+
+TEST_F(SDKConcurrencyLimiterTest, InteractiveFirst) {
+  FLAGS_store_rpc_concurrency_queue_size = 4;
+  FLAGS_store_rpc_concurrency_interactive_reserve_percent = 50;
+
+  EndPointConcurrencyLimit limit;
+  // batch rpcs leave half of the limit to interactive rpcs
+  for (int i = 0; i < 2; i++) {
+    std::function<void()> send = [] {};
+    EXPECT_EQ(limit.Admit(send, kBatch), EndPointConcurrencyLimit::kAdmitted);
+  }
+  bool batch_sent = false;
+  std::function<void()> batch = [&] { batch_sent = true; };
+  EXPECT_EQ(limit.Admit(batch, kBatch), EndPointConcurrencyLimit::kQueued);
+
+  for (int i = 0; i < 2; i++) {
+    std::function<void()> send = [] {};
+    EXPECT_EQ(limit.Admit(send, kInteractive), EndPointConcurrencyLimit::kAdmitted);
+  }
+  bool interactive_sent = false;
+  std::function<void()> interactive = [&] { interactive_sent = true; };
+  EXPECT_EQ(limit.Admit(interactive, kInteractive), EndPointConcurrencyLimit::kQueued);
+
+  // queued interactive rpc goes first
+  std::function<void()> next = limit.Release(false);
+  ASSERT_TRUE(next);
+  next();
+  EXPECT_TRUE(interactive_sent);
+  EXPECT_FALSE(batch_sent);
+
+  next = limit.Release(false);
+  ASSERT_TRUE(next);
+  next();
+  EXPECT_TRUE(batch_sent);
+  EXPECT_EQ(limit.GetSnapshot().queued, 0);
+
+  FLAGS_store_rpc_concurrency_interactive_reserve_percent = 10;
+}
+
+TEST_F(SDKConcurrencyLimiterTest, AdditiveIncreaseMultiplicativeDecrease) {
+  EndPointConcurrencyLimit limit;
+  for (int i = 0; i < 4; i++) {
+    std::function<void()> send = [] {};
+    EXPECT_EQ(limit.Admit(send), EndPointConcurrencyLimit::kAdmitted);
+  }
+
+  // busy endpoint answers fine, limit grows
+  EXPECT_FALSE(limit.Release(false));
+  EXPECT_EQ(limit.GetSnapshot().limit, 5);
+
+  // overload shrinks limit but never below min limit
+  for (int i = 0; i < 3; i++) {
+    EXPECT_FALSE(limit.Release(true));
+  }
+  EXPECT_EQ(limit.GetSnapshot().in_flight, 0);
+  EXPECT_GE(limit.GetSnapshot().limit, 2);
+  EXPECT_LT(limit.GetSnapshot().limit, 5);
+
+  // idle endpoint does not grow limit
+  int64_t before = limit.GetSnapshot().limit;
+  std::function<void()> send = [] {};
+  EXPECT_EQ(limit.Admit(send), EndPointConcurrencyLimit::kAdmitted);
+  EXPECT_FALSE(limit.Release(false));
+  EXPECT_EQ(limit.GetSnapshot().limit, before);
+}
+
+TEST_F(SDKConcurrencyLimiterTest, SendRpcFailFast) {
+  FLAGS_store_rpc_concurrency_queue_size = 0;
+  EndPoint end_point("127.0.0.1", 30001);
+
+  std::vector<std::unique_ptr<KvGetRpc>> rpcs;
+  std::vector<RpcCallback> pending;
+  auto send_func = [&](Rpc& /*rpc*/, RpcCallback cb) { pending.push_back(std::move(cb)); };
+
+  int done = 0;
+  for (int i = 0; i < 5; i++) {
+    rpcs.push_back(std::make_unique<KvGetRpc>());
+    rpcs.back()->SetEndPoint(end_point);
+    ConcurrencyLimiter::Global().SendRpc(*rpcs.back(), [&] { done++; }, send_func);
+  }
+
+  // 4 are sent, the last one fails fast
+  EXPECT_EQ(pending.size(), 4);
+  EXPECT_EQ(done, 1);
+  EXPECT_TRUE(rpcs.back()->GetStatus().IsRemoteError());
+  EXPECT_EQ(rpcs.back()->GetStatus().Errno(), pb::error::Errno::EREQUEST_FULL);
+
+  for (auto& cb : pending) {
+    cb();
+  }
+  EXPECT_EQ(done, 5);
+  EXPECT_EQ(ConcurrencyLimiter::Global().GetLimit(end_point)->GetSnapshot().in_flight, 0);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
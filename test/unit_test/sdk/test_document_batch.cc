@@ -0,0 +1,95 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "sdk/document.h"
+#include "sdk/types.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKDocumentBatchTest, DocValueInline) {
+  DocValue int_value = DocValue::FromInt(7);
+  DocValue copy = int_value;
+  EXPECT_EQ(copy.GetType(), kINT64);
+  EXPECT_EQ(copy.IntValue(), 7);
+
+  DocValue string_value = DocValue::FromString("abc");
+  DocValue moved = std::move(string_value);
+  EXPECT_EQ(moved.GetType(), kSTRING);
+  EXPECT_EQ(moved.StringValue(), "abc");
+
+  EXPECT_EQ(DocValue().GetType(), kTypeEnd);
+}
+
+TEST(SDKDocumentBatchTest, ColumnsPaddedForAbsentKeys) {
+  DocumentBatch batch;
+
+  Document doc1;
+  doc1.AddField("a", DocValue::FromInt(1));
+  batch.Append(DocWithId(1, doc1));
+
+  Document doc2;
+  doc2.AddField("b", DocValue::FromString("x"));
+  batch.Append(DocWithId(2, doc2));
+
+  ASSERT_EQ(batch.Size(), 2);
+  const auto* a = batch.GetColumn("a");
+  const auto* b = batch.GetColumn("b");
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  ASSERT_EQ(a->size(), 2);
+  ASSERT_EQ(b->size(), 2);
+  EXPECT_EQ((*a)[0].IntValue(), 1);
+  EXPECT_EQ((*a)[1].GetType(), kTypeEnd);
+  EXPECT_EQ((*b)[0].GetType(), kTypeEnd);
+  EXPECT_EQ((*b)[1].StringValue(), "x");
+  EXPECT_EQ(batch.GetColumn("c"), nullptr);
+
+  DocWithId doc = batch.GetDoc(1);
+  EXPECT_EQ(doc.id, 2);
+  EXPECT_EQ(doc.doc.GetFields().size(), 1);
+  ASSERT_NE(doc.doc.GetField("b"), nullptr);
+  EXPECT_EQ(doc.doc.GetField("b")->StringValue(), "x");
+}
+
+TEST(SDKDocumentBatchTest, AppendRow) {
+  DocumentBatch src;
+  for (int64_t i = 1; i <= 3; i++) {
+    Document doc;
+    doc.AddField("a", DocValue::FromInt(i * 10));
+    src.Append(DocWithId(i, doc));
+  }
+
+  DocumentBatch dst;
+  dst.AppendRow(src, 2);
+  dst.AppendRow(src, 0);
+
+  ASSERT_EQ(dst.Size(), 2);
+  EXPECT_EQ(dst.GetIds()[0], 3);
+  EXPECT_EQ(dst.GetIds()[1], 1);
+  EXPECT_EQ((*dst.GetColumn("a"))[0].IntValue(), 30);
+  EXPECT_EQ((*dst.GetColumn("a"))[1].IntValue(), 10);
+
+  dst.Clear();
+  EXPECT_TRUE(dst.Empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,124 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "proto/common.pb.h"
+#include "sdk/document.h"
+#include "sdk/document/document_schema_translater.h"
+#include "sdk/document/document_translater.h"
+#include "sdk/types.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKDocumentSchemaTranslaterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    DocumentSchema schema;
+    schema.AddColumn(DocumentColumn("age", kINT64));
+    schema.AddColumn(DocumentColumn("name", kSTRING));
+    DocumentTranslater::FillScalarSchema(&schema_pb, schema);
+  }
+
+  pb::common::ScalarSchema schema_pb;
+};
+
+TEST_F(SDKDocumentSchemaTranslaterTest, ColumnIndex) {
+  DocumentSchemaTranslater translater(schema_pb);
+  EXPECT_EQ(translater.ColumnCount(), 2);
+  EXPECT_EQ(translater.ColumnIndex("age"), 0);
+  EXPECT_EQ(translater.ColumnIndex("name"), 1);
+  EXPECT_EQ(translater.ColumnIndex("unknown"), -1);
+}
+
+TEST_F(SDKDocumentSchemaTranslaterTest, RoundTrip) {
+  DocumentSchemaTranslater translater(schema_pb);
+
+  Document doc;
+  doc.AddField("age", DocValue::FromInt(18));
+  doc.AddField("name", DocValue::FromString("tom"));
+  // not in schema, still translated
+  doc.AddField("score", DocValue::FromDouble(1.5));
+
+  pb::common::DocumentWithId pb;
+  translater.FillDocumentWithIdPB(&pb, DocWithId(7, doc));
+  EXPECT_EQ(pb.id(), 7);
+  ASSERT_EQ(pb.document().document_data().size(), 3);
+  EXPECT_EQ(pb.document().document_data().at("age").field_type(), pb::common::ScalarFieldType::INT64);
+  EXPECT_EQ(pb.document().document_data().at("age").field_value().long_data(), 18);
+
+  DocWithId decoded = translater.DocWithIdFromPB(pb);
+  EXPECT_EQ(decoded.id, 7);
+  ASSERT_EQ(decoded.doc.GetFields().size(), 3);
+  EXPECT_EQ(decoded.doc.GetField("age")->IntValue(), 18);
+  EXPECT_EQ(decoded.doc.GetField("name")->StringValue(), "tom");
+  EXPECT_DOUBLE_EQ(decoded.doc.GetField("score")->DoubleValue(), 1.5);
+
+  pb::common::DocumentWithId without_id;
+  translater.FillDocumentWithIdPB(&without_id, DocWithId(7, doc), false);
+  EXPECT_EQ(without_id.id(), 0);
+}
+
+TEST_F(SDKDocumentSchemaTranslaterTest, AppendDocsToBatch) {
+  DocumentSchemaTranslater translater(schema_pb);
+
+  google::protobuf::RepeatedPtrField<pb::common::DocumentWithId> docs;
+  {
+    Document doc;
+    doc.AddField("age", DocValue::FromInt(1));
+    translater.FillDocumentWithIdPB(docs.Add(), DocWithId(1, doc));
+  }
+  {
+    // not found doc
+    docs.Add()->set_id(0);
+  }
+  {
+    Document doc;
+    doc.AddField("name", DocValue::FromString("x"));
+    doc.AddField("extra", DocValue::FromBytes("b"));
+    translater.FillDocumentWithIdPB(docs.Add(), DocWithId(2, doc));
+  }
+
+  DocumentBatch batch;
+  translater.AppendDocsToBatch(docs, batch);
+  // appended again, columns keep aligned with rows
+  translater.AppendDocsToBatch(docs, batch);
+
+  ASSERT_EQ(batch.Size(), 4);
+  EXPECT_EQ(batch.GetIds(), std::vector<int64_t>({1, 2, 1, 2}));
+
+  const auto* age = batch.GetColumn("age");
+  const auto* name = batch.GetColumn("name");
+  const auto* extra = batch.GetColumn("extra");
+  ASSERT_NE(age, nullptr);
+  ASSERT_NE(name, nullptr);
+  ASSERT_NE(extra, nullptr);
+  ASSERT_EQ(age->size(), 4);
+  ASSERT_EQ(name->size(), 4);
+  ASSERT_EQ(extra->size(), 4);
+  EXPECT_EQ((*age)[0].IntValue(), 1);
+  EXPECT_EQ((*age)[1].GetType(), kTypeEnd);
+  EXPECT_EQ((*name)[0].GetType(), kTypeEnd);
+  EXPECT_EQ((*name)[3].StringValue(), "x");
+  EXPECT_EQ((*extra)[1].StringValue(), "b");
+  EXPECT_EQ((*extra)[2].GetType(), kTypeEnd);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
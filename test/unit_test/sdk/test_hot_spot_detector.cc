@@ -0,0 +1,100 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "sdk/common/hot_spot_detector.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKHotSpotTrackerTest, TopK) {
+  HotSpotTracker tracker;
+  for (int i = 0; i < 1000; i++) {
+    tracker.Add("cold" + std::to_string(i), 3);
+  }
+  for (int i = 0; i < 100; i++) {
+    tracker.Add("hot", 3);
+  }
+  for (int i = 0; i < 50; i++) {
+    tracker.Add("warm", 3);
+  }
+
+  auto items = tracker.TopK();
+  ASSERT_EQ(items.size(), 3);
+  EXPECT_EQ(items[0].key, "hot");
+  EXPECT_GE(items[0].count, 100);
+  EXPECT_EQ(items[1].key, "warm");
+  EXPECT_GE(items[1].count, 50);
+
+  tracker.Reset();
+  EXPECT_TRUE(tracker.TopK().empty());
+}
+
+class SDKHotSpotDetectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_sdk_hot_spot_sample_rate = 1;
+    FLAGS_sdk_hot_spot_window_ms = 100;
+    HotSpotDetector::Global().Reset();
+  }
+
+  void TearDown() override {
+    FLAGS_sdk_hot_spot_sample_rate = 64;
+    FLAGS_sdk_hot_spot_window_ms = 10000;
+    HotSpotDetector::Global().Reset();
+  }
+};
+
+TEST_F(SDKHotSpotDetectorTest, ReportLastWindow) {
+  auto& detector = HotSpotDetector::Global();
+  for (int i = 0; i < 20; i++) {
+    detector.RecordKey("a");
+    detector.RecordRegion(7);
+  }
+  detector.RecordKey("b");
+  detector.RecordRegion(8);
+
+  // window not finished yet
+  EXPECT_TRUE(detector.GetHotKeys().empty());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  auto keys = detector.GetHotKeys();
+  ASSERT_EQ(keys.size(), 2);
+  EXPECT_EQ(keys[0].key, "a");
+  EXPECT_GT(keys[0].qps, keys[1].qps);
+
+  auto regions = detector.GetHotRegions();
+  ASSERT_EQ(regions.size(), 2);
+  EXPECT_EQ(regions[0].region_id, 7);
+}
+
+TEST_F(SDKHotSpotDetectorTest, Disabled) {
+  FLAGS_sdk_hot_spot_sample_rate = 0;
+  auto& detector = HotSpotDetector::Global();
+  detector.RecordKey("a");
+  detector.RecordRegion(7);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  EXPECT_TRUE(detector.GetHotKeys().empty());
+  EXPECT_TRUE(detector.GetHotRegions().empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "sdk/document.h"
+#include "sdk/hybrid/hybrid_search.h"
+#include "sdk/hybrid_search.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+VectorWithDistance MakeVectorResult(int64_t id, float distance) {
+  VectorWithDistance result;
+  result.vector_data.id = id;
+  result.distance = distance;
+  return result;
+}
+
+DocWithStore MakeDocResult(int64_t id, float score) {
+  DocWithStore result;
+  result.doc_with_id.id = id;
+  result.score = score;
+  return result;
+}
+}  // namespace
+
+TEST(SDKHybridSearchTest, ReciprocalRankFusion) {
+  HybridSearchParam param;
+  param.topk = 3;
+  param.rrf_k = 60;
+
+  // unsorted on purpose, ranks are 2, 1, 3
+  std::vector<VectorWithDistance> vector_results{MakeVectorResult(2, 0.5), MakeVectorResult(1, 0.1),
+                                                 MakeVectorResult(3, 0.9)};
+  std::vector<DocWithStore> doc_results{MakeDocResult(3, 9.0), MakeDocResult(4, 5.0)};
+
+  std::vector<HybridSearchHit> hits;
+  FuseHybridResults(param, vector_results, doc_results, hits);
+
+  ASSERT_EQ(hits.size(), 3);
+  // id 3 is rank 3 in vector and rank 1 in doc
+  EXPECT_EQ(hits[0].id, 3);
+  EXPECT_EQ(hits[0].vector_rank, 3);
+  EXPECT_EQ(hits[0].doc_rank, 1);
+  EXPECT_FLOAT_EQ(hits[0].score, 1.0f / 63 + 1.0f / 61);
+  EXPECT_FLOAT_EQ(hits[0].doc_score, 9.0f);
+
+  EXPECT_EQ(hits[1].id, 1);
+  EXPECT_EQ(hits[1].doc_rank, 0);
+  EXPECT_FLOAT_EQ(hits[1].score, 1.0f / 61);
+
+  // id 2 and 4 tie on rank 2, smaller id first
+  EXPECT_EQ(hits[2].id, 2);
+}
+
+TEST(SDKHybridSearchTest, WeightedScoreFusion) {
+  HybridSearchParam param;
+  param.topk = 10;
+  param.fusion_type = kWeightedScoreFusion;
+  param.vector_weight = 0.3f;
+  param.doc_weight = 0.7f;
+
+  std::vector<VectorWithDistance> vector_results{MakeVectorResult(1, 0.0), MakeVectorResult(2, 1.0)};
+  std::vector<DocWithStore> doc_results{MakeDocResult(2, 10.0), MakeDocResult(3, 0.0)};
+
+  std::vector<HybridSearchHit> hits;
+  FuseHybridResults(param, vector_results, doc_results, hits);
+
+  ASSERT_EQ(hits.size(), 3);
+  EXPECT_EQ(hits[0].id, 2);
+  EXPECT_FLOAT_EQ(hits[0].score, 0.7f);
+  EXPECT_EQ(hits[1].id, 1);
+  EXPECT_FLOAT_EQ(hits[1].score, 0.3f);
+  EXPECT_EQ(hits[2].id, 3);
+  EXPECT_FLOAT_EQ(hits[2].score, 0.0f);
+}
+
+TEST(SDKHybridSearchTest, EmptyResults) {
+  HybridSearchParam param;
+  param.topk = 5;
+
+  std::vector<HybridSearchHit> hits;
+  FuseHybridResults(param, {}, {MakeDocResult(7, 1.0)}, hits);
+  ASSERT_EQ(hits.size(), 1);
+  EXPECT_EQ(hits[0].id, 7);
+  EXPECT_EQ(hits[0].vector_rank, 0);
+
+  FuseHybridResults(param, {}, {}, hits);
+  EXPECT_TRUE(hits.empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
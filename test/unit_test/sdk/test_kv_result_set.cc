@@ -0,0 +1,75 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/client.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKKvResultSetTest, AppendCopy) {
+  KvResultSet kvs;
+  EXPECT_TRUE(kvs.Empty());
+
+  for (int i = 0; i < 1000; ++i) {
+    std::string key = "key" + std::to_string(i);
+    kvs.Append(key, "value" + std::to_string(i));
+  }
+  // a kv bigger than the block takes its own block
+  std::string big(1 << 20, 'x');
+  kvs.Append("big", big);
+
+  ASSERT_EQ(kvs.Size(), 1001);
+  EXPECT_EQ(kvs.Key(0).ToString(), "key0");
+  EXPECT_EQ(kvs.Value(999).ToString(), "value999");
+  EXPECT_EQ(kvs.Value(1000).size(), big.size());
+
+  auto pairs = kvs.ToKVPairs();
+  ASSERT_EQ(pairs.size(), 1001);
+  EXPECT_EQ(pairs[500].key, "key500");
+  EXPECT_EQ(pairs[500].value, "value500");
+}
+
+TEST(SDKKvResultSetTest, ViewSpliceTruncate) {
+  auto owner = std::make_shared<std::vector<std::string>>(std::vector<std::string>{"a", "1", "b", "2"});
+
+  KvResultSet other;
+  other.AppendView((*owner)[0], (*owner)[1]);
+  other.AppendView((*owner)[2], (*owner)[3]);
+  other.Retain(owner);
+  owner.reset();
+
+  KvResultSet kvs;
+  kvs.Append("0", "0");
+  kvs.Splice(std::move(other));
+
+  // views stay valid after other is gone
+  ASSERT_EQ(kvs.Size(), 3);
+  EXPECT_EQ(kvs.Key(1).ToString(), "a");
+  EXPECT_EQ(kvs.Value(2).ToString(), "2");
+
+  kvs.Truncate(2);
+  ASSERT_EQ(kvs.Size(), 2);
+  EXPECT_EQ(kvs.Key(1).ToString(), "a");
+
+  kvs.Clear();
+  EXPECT_TRUE(kvs.Empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
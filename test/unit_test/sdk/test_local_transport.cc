@@ -0,0 +1,86 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/local_transport.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKLocalTransportTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_rpc_local_unix_socket_path = "/tmp/sdk_local_transport_test-{port}.sock";
+    socket_path = "/tmp/sdk_local_transport_test-20001.sock";
+    unlink(socket_path.c_str());
+  }
+
+  void TearDown() override {
+    if (fd >= 0) {
+      close(fd);
+    }
+    unlink(socket_path.c_str());
+    FLAGS_rpc_local_unix_socket_path = "";
+  }
+
+  void Listen() {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), 0);
+  }
+
+  std::string socket_path;
+  int fd{-1};
+};
+
+TEST_F(SDKLocalTransportTest, IsLocalHost) {
+  EXPECT_TRUE(IsLocalHost("127.0.0.1"));
+  EXPECT_TRUE(IsLocalHost("localhost"));
+  EXPECT_TRUE(IsLocalHost("::1"));
+  // TEST-NET-1, never assigned to a host
+  EXPECT_FALSE(IsLocalHost("192.0.2.1"));
+}
+
+TEST_F(SDKLocalTransportTest, UnixSocketPath) {
+  EXPECT_EQ(LocalUnixSocketPath(EndPoint("127.0.0.1", 20001)), socket_path);
+
+  FLAGS_rpc_local_unix_socket_path = "";
+  EXPECT_EQ(LocalUnixSocketPath(EndPoint("127.0.0.1", 20001)), "");
+}
+
+TEST_F(SDKLocalTransportTest, TransportAddress) {
+  // no socket yet
+  EXPECT_EQ(LocalTransportAddress(EndPoint("127.0.0.1", 20001)), "");
+
+  Listen();
+  EXPECT_EQ(LocalTransportAddress(EndPoint("127.0.0.1", 20001)), "unix:" + socket_path);
+  // not local
+  EXPECT_EQ(LocalTransportAddress(EndPoint("192.0.2.1", 20001)), "");
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -12,8 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#include "fmt/core.h"
 #include "gtest/gtest.h"
 #include "mock_coordinator_rpc_controller.h"
 #include "sdk/meta_cache.h"
@@ -56,6 +62,203 @@ TEST_F(SDKMetaCacheTest, LookupRegionByKey) {
   EXPECT_EQ(tmp->Range().end_key(), region->Range().end_key());
 }
 
+TEST_F(SDKMetaCacheTest, LookupRegionsByKeys) {
+  meta_cache->MaybeAddRegion(RegionA2C());
+
+  auto c2e = RegionC2E();
+  auto e2g = RegionE2G();
+  // all miss keys should be fetched by one rpc
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    EXPECT_EQ(t_rpc->Request()->key(), "c");
+    EXPECT_EQ(t_rpc->Request()->range_end(), std::string("f\0", 2));
+    EXPECT_EQ(t_rpc->Request()->limit(), 0);
+    Region2ScanRegionInfo(c2e, t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(e2g, t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  std::vector<std::string> keys = {"a", "b", "c", "d", "e", "f"};
+  std::vector<std::string_view> sorted_keys(keys.begin(), keys.end());
+
+  std::vector<RegionKeys> groups;
+  Status got = meta_cache->LookupRegionsByKeys(sorted_keys, groups);
+  EXPECT_TRUE(got.IsOK());
+  ASSERT_EQ(groups.size(), 3);
+
+  EXPECT_EQ(groups[0].region->Range().start_key(), "a");
+  EXPECT_EQ(groups[1].region->RegionId(), c2e->RegionId());
+  EXPECT_EQ(groups[2].region->RegionId(), e2g->RegionId());
+  for (const auto& group : groups) {
+    ASSERT_EQ(group.keys.size(), 2);
+    EXPECT_GE(group.keys[0], group.region->Range().start_key());
+    EXPECT_LT(group.keys[1], group.region->Range().end_key());
+  }
+}
+
+TEST_F(SDKMetaCacheTest, LookupRegionsByKeysPartialMiss) {
+  meta_cache->MaybeAddRegion(RegionA2C());
+
+  auto c2e = RegionC2E();
+  auto e2g = RegionE2G();
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        // the scan misses e2g, e.g. it is split meanwhile
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "c");
+        Region2ScanRegionInfo(c2e, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        // e is looked up by itself, f is in the region found for e
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "e");
+        Region2ScanRegionInfo(e2g, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "x");
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "x");
+        return Status::OK();
+      });
+
+  std::vector<std::string> keys = {"a", "c", "e", "f"};
+  std::vector<std::string_view> sorted_keys(keys.begin(), keys.end());
+  std::vector<RegionKeys> groups;
+  EXPECT_TRUE(meta_cache->LookupRegionsByKeys(sorted_keys, groups).IsOK());
+  ASSERT_EQ(groups.size(), 3);
+  EXPECT_EQ(groups[2].region->RegionId(), e2g->RegionId());
+  EXPECT_EQ(groups[2].keys.size(), 2);
+
+  // a key without region fails the lookup, the others are still grouped
+  keys = {"b", "x"};
+  sorted_keys.assign(keys.begin(), keys.end());
+  EXPECT_FALSE(meta_cache->LookupRegionsByKeys(sorted_keys, groups).IsOK());
+  ASSERT_EQ(groups.size(), 1);
+  ASSERT_EQ(groups[0].keys.size(), 1);
+  EXPECT_EQ(groups[0].keys[0], "b");
+}
+
+TEST_F(SDKMetaCacheTest, LookupRegionByKeyFollowRouteUpdate) {
+  auto a2c = RegionA2C();
+  meta_cache->MaybeAddRegion(a2c);
+  meta_cache->MaybeAddRegion(RegionC2E());
+
+  {
+    // concurrent readers hit cache without rpc
+    std::atomic<int> found{0};
+    std::vector<std::thread> threads;
+    threads.reserve(4);
+    for (int i = 0; i < 4; i++) {
+      threads.emplace_back([&]() {
+        for (int j = 0; j < 100; j++) {
+          std::shared_ptr<Region> tmp;
+          if (meta_cache->LookupRegionByKey("d", tmp).IsOK() && tmp->Range().start_key() == "c") {
+            found.fetch_add(1);
+          }
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    EXPECT_EQ(found.load(), 400);
+  }
+
+  {
+    std::shared_ptr<Region> tmp;
+    Status got = meta_cache->LookupRegionByKey("b", tmp);
+    EXPECT_TRUE(got.IsOK());
+    EXPECT_EQ(tmp->RegionId(), a2c->RegionId());
+  }
+
+  // after clear, reader should not see removed region
+  meta_cache->ClearRange(a2c);
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    EXPECT_EQ(t_rpc->Request()->key(), "b");
+    Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  std::shared_ptr<Region> tmp;
+  Status got = meta_cache->LookupRegionByKey("b", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_NE(tmp.get(), a2c.get());
+  EXPECT_FALSE(tmp->IsStale());
+}
+
+TEST_F(SDKMetaCacheTest, AddRegionsOneByOne) {
+  // regions added one by one are served from snapshot before and after the route table is rebuilt
+  auto key = [](int64_t i) { return fmt::format("key_{:06d}", i); };
+  auto region = [&](int64_t i, int64_t version) {
+    pb::common::Range range;
+    range.set_start_key(key(i));
+    range.set_end_key(key(i + 1));
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(version);
+    epoch.set_conf_version(1);
+    return GenRegion(i + 1, range, epoch, pb::common::RegionType::STORE_REGION);
+  };
+
+  const int64_t count = 200;
+  for (int64_t i = 0; i < count; i++) {
+    meta_cache->MaybeAddRegion(region(i, 1));
+  }
+  for (int64_t i = 0; i < count; i += 10) {
+    meta_cache->MaybeAddRegion(region(i, 2));
+  }
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).Times(0);
+  for (int64_t i = 0; i < count; i++) {
+    std::shared_ptr<Region> tmp;
+    Status got = meta_cache->LookupRegionByKey(key(i) + "x", tmp);
+    ASSERT_TRUE(got.IsOK());
+    EXPECT_EQ(tmp->RegionId(), i + 1);
+    EXPECT_EQ(tmp->Epoch().version(), i % 10 == 0 ? 2 : 1);
+  }
+  EXPECT_EQ(meta_cache->ListRegions().size(), count);
+}
+
+TEST_F(SDKMetaCacheTest, AlternateCachesOnOneThread) {
+  // clients sharing a runtime look up their own caches on the same threads
+  auto other = std::make_shared<MetaCache>(coordinator_rpc_controller);
+  meta_cache->MaybeAddRegion(RegionA2C());
+  auto c2e = RegionC2E();
+  std::weak_ptr<Region> weak_c2e = c2e;
+  other->MaybeAddRegion(c2e);
+  c2e.reset();
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).Times(0);
+  for (int i = 0; i < 3; i++) {
+    std::shared_ptr<Region> tmp;
+    ASSERT_TRUE(meta_cache->LookupRegionByKey("b", tmp).IsOK());
+    EXPECT_EQ(tmp->RegionId(), RegionA2C()->RegionId());
+    ASSERT_TRUE(other->LookupRegionByKey("d", tmp).IsOK());
+    EXPECT_EQ(tmp->RegionId(), RegionC2E()->RegionId());
+  }
+
+  // a published change is seen by the pinned thread
+  meta_cache->MaybeAddRegion(RegionA2C(2));
+  std::shared_ptr<Region> tmp;
+  ASSERT_TRUE(meta_cache->LookupRegionByKey("b", tmp).IsOK());
+  EXPECT_EQ(tmp->Epoch().version(), 2);
+  tmp.reset();
+
+  // pin of a destroyed cache is dropped when the thread pins another cache
+  other.reset();
+  EXPECT_FALSE(weak_c2e.expired());
+  auto next = std::make_shared<MetaCache>(coordinator_rpc_controller);
+  next->MaybeAddRegion(RegionA2C());
+  ASSERT_TRUE(next->LookupRegionByKey("b", tmp).IsOK());
+  EXPECT_TRUE(weak_c2e.expired());
+}
+
 TEST_F(SDKMetaCacheTest, ClearRange) {
   auto region = RegionA2C();
 
@@ -88,6 +291,30 @@ TEST_F(SDKMetaCacheTest, ClearRange) {
   }
 }
 
+TEST_F(SDKMetaCacheTest, AddRegionAfterClearRange) {
+  auto a2c = RegionA2C();
+  meta_cache->MaybeAddRegion(a2c);
+  meta_cache->MaybeAddRegion(RegionC2E());
+
+  meta_cache->ClearRange(a2c);
+  EXPECT_TRUE(a2c->IsStale());
+  EXPECT_EQ(meta_cache->ListRegions().size(), 1);
+
+  // same region object added back
+  meta_cache->MaybeAddRegion(a2c);
+  EXPECT_FALSE(a2c->IsStale());
+
+  std::shared_ptr<Region> tmp;
+  Status got = meta_cache->LookupRegionByKey("b", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(tmp.get(), a2c.get());
+
+  auto regions = meta_cache->ListRegions();
+  ASSERT_EQ(regions.size(), 2);
+  EXPECT_EQ(regions[0].get(), a2c.get());
+  EXPECT_EQ(regions[1]->Range().start_key(), "c");
+}
+
 TEST_F(SDKMetaCacheTest, AddRegion) {
   auto region = RegionA2C();
 
@@ -0,0 +1,122 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/meta_cache.h"
+#include "sdk/meta_cache_snapshot.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_index_cache.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKMetaCacheSnapshotTest : public TestBase {
+ protected:
+  static pb::meta::IndexDefinitionWithId VectorIndexDefinition(int64_t index_id, const std::string& name) {
+    pb::meta::IndexDefinitionWithId def;
+    FillVectorIndexId(def.mutable_index_id(), index_id, 2);
+    auto* definition = def.mutable_index_definition();
+    definition->set_name(name);
+    FillRangePartitionRule(definition->mutable_index_partition(), {5, 10}, {index_id, index_id + 1, index_id + 2, index_id + 3});
+    definition->set_replica(3);
+    auto* index_parameter = definition->mutable_index_parameter();
+    index_parameter->set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+    FillFlatParmeter(index_parameter->mutable_vector_index_parameter(), FlatParam(1000, MetricType::kL2));
+    return def;
+  }
+};
+
+TEST_F(SDKMetaCacheSnapshotTest, EncodeDecodeRegions) {
+  std::string data;
+  EXPECT_TRUE(MetaCacheSnapshot::Encode(*stub, data).ok());
+
+  meta_cache->ClearCache();
+  std::shared_ptr<Region> region;
+  EXPECT_FALSE(meta_cache->TEST_FastLookUpRegionByKey("b", region).ok());
+
+  // loaded routes need no coordinator rpc
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).Times(0);
+  EXPECT_TRUE(MetaCacheSnapshot::Decode(*stub, data).ok());
+
+  for (const auto& key : {"b", "d", "f"}) {
+    EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey(key, region).ok()) << key;
+    EXPECT_FALSE(region->IsStale());
+    EndPoint leader;
+    EXPECT_TRUE(region->GetLeader(leader).ok());
+    EXPECT_EQ(leader, kAddrOne);
+    EXPECT_EQ(region->Replicas().size(), 3);
+  }
+}
+
+TEST_F(SDKMetaCacheSnapshotTest, EncodeDecodeIndexes) {
+  EXPECT_TRUE(index_cache->AddIndexDefinition(VectorIndexDefinition(10, "v1")).ok());
+  EXPECT_TRUE(index_cache->AddIndexDefinition(VectorIndexDefinition(20, "v2")).ok());
+
+  std::string data;
+  EXPECT_TRUE(MetaCacheSnapshot::Encode(*stub, data).ok());
+
+  // load into an empty cache
+  index_cache = std::make_shared<VectorIndexCache>(*stub);
+  ON_CALL(*stub, GetVectorIndexCache).WillByDefault(testing::Return(index_cache));
+  EXPECT_TRUE(MetaCacheSnapshot::Decode(*stub, data).ok());
+
+  std::shared_ptr<VectorIndex> index;
+  EXPECT_TRUE(index_cache->GetVectorIndexById(10, index).ok());
+  EXPECT_EQ(index->GetName(), "v1");
+  EXPECT_EQ(index->GetPartitionIds().size(), 3);
+  EXPECT_TRUE(index_cache->GetVectorIndexById(20, index).ok());
+  EXPECT_EQ(index->GetName(), "v2");
+
+  // cached index is kept
+  EXPECT_TRUE(MetaCacheSnapshot::Decode(*stub, data).ok());
+  EXPECT_EQ(index_cache->ListIndexDefinitions().size(), 2);
+}
+
+TEST_F(SDKMetaCacheSnapshotTest, DecodeCorruption) {
+  std::string data;
+  EXPECT_TRUE(MetaCacheSnapshot::Encode(*stub, data).ok());
+
+  std::string flipped = data;
+  flipped[flipped.size() / 2] ^= 0x1;
+  EXPECT_TRUE(MetaCacheSnapshot::Decode(*stub, flipped).IsCorruption());
+
+  EXPECT_TRUE(MetaCacheSnapshot::Decode(*stub, data.substr(0, data.size() - 1)).IsCorruption());
+  EXPECT_TRUE(MetaCacheSnapshot::Decode(*stub, "").IsCorruption());
+}
+
+TEST_F(SDKMetaCacheSnapshotTest, SaveLoad) {
+  std::string path = testing::TempDir() + "meta_cache_snapshot_test";
+  std::remove(path.c_str());
+  EXPECT_TRUE(MetaCacheSnapshot::Load(*stub, path).IsNotFound());
+
+  EXPECT_TRUE(MetaCacheSnapshot::Save(*stub, path).ok());
+  meta_cache->ClearCache();
+  EXPECT_TRUE(MetaCacheSnapshot::Load(*stub, path).ok());
+
+  std::shared_ptr<Region> region;
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("d", region).ok());
+
+  std::remove(path.c_str());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
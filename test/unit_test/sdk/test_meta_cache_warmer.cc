@@ -0,0 +1,107 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mock_coordinator_rpc_controller.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+#include "sdk/meta_cache_warmer.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKMetaCacheWarmerTest : public TestBase {
+ protected:
+  // start with empty meta cache
+  void SetUp() override {
+    old_prefixes_ = FLAGS_meta_cache_warmup_key_prefixes;
+    old_vector_index_ids_ = FLAGS_meta_cache_warmup_vector_index_ids;
+  }
+
+  void TearDown() override {
+    FLAGS_meta_cache_warmup_key_prefixes = old_prefixes_;
+    FLAGS_meta_cache_warmup_vector_index_ids = old_vector_index_ids_;
+  }
+
+ private:
+  std::string old_prefixes_;
+  std::string old_vector_index_ids_;
+};
+
+TEST_F(SDKMetaCacheWarmerTest, NothingConfigured) {
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).Times(0);
+  EXPECT_TRUE(meta_cache_warmer->Warmup().ok());
+}
+
+TEST_F(SDKMetaCacheWarmerTest, WarmupKeyPrefixes) {
+  // prefix without upper bound and invalid index id are skipped
+  FLAGS_meta_cache_warmup_key_prefixes = "b,d,\xff";
+  FLAGS_meta_cache_warmup_vector_index_ids = "abc";
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "b");
+        EXPECT_EQ(t_rpc->Request()->range_end(), "c");
+        EXPECT_EQ(t_rpc->Request()->limit(), 0);
+        Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "d");
+        EXPECT_EQ(t_rpc->Request()->range_end(), "e");
+        EXPECT_EQ(t_rpc->Request()->limit(), 0);
+        Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      });
+
+  EXPECT_TRUE(meta_cache_warmer->Warmup().ok());
+
+  std::shared_ptr<Region> region;
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("b", region).ok());
+  EXPECT_EQ(region->Range().start_key(), "a");
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("d", region).ok());
+  EXPECT_EQ(region->Range().start_key(), "c");
+  EXPECT_FALSE(meta_cache->TEST_FastLookUpRegionByKey("f", region).ok());
+}
+
+TEST_F(SDKMetaCacheWarmerTest, WarmupContinueAfterFail) {
+  FLAGS_meta_cache_warmup_key_prefixes = "b,d";
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) { return Status::NetworkError("mock error"); })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      });
+
+  Status s = meta_cache_warmer->Warmup();
+  EXPECT_TRUE(s.IsNetworkError());
+
+  std::shared_ptr<Region> region;
+  EXPECT_FALSE(meta_cache->TEST_FastLookUpRegionByKey("b", region).ok());
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("d", region).ok());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,122 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mock_coordinator_rpc_controller.h"
+#include "sdk/meta_cache.h"
+#include "sdk/meta_cache_watcher.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKMetaCacheWatcherTest : public TestBase {};
+
+namespace {
+std::shared_ptr<Region> GenRangeRegion(int64_t id, const std::string& start_key, const std::string& end_key,
+                                       int version) {
+  pb::common::Range range;
+  range.set_start_key(start_key);
+  range.set_end_key(end_key);
+  pb::common::RegionEpoch epoch;
+  epoch.set_version(version);
+  epoch.set_conf_version(1);
+  return GenRegion(id, range, epoch, pb::common::RegionType::STORE_REGION);
+}
+}  // namespace
+
+TEST_F(SDKMetaCacheWatcherTest, MergeRanges) {
+  auto ranges = MetaCacheWatcher::MergeRanges({RegionA2C(), RegionC2E(), RegionL2N()});
+  ASSERT_EQ(ranges.size(), 2);
+  EXPECT_EQ(ranges[0].first, "a");
+  EXPECT_EQ(ranges[0].second, "e");
+  EXPECT_EQ(ranges[1].first, "l");
+  EXPECT_EQ(ranges[1].second, "n");
+
+  EXPECT_TRUE(MetaCacheWatcher::MergeRanges({}).empty());
+}
+
+TEST_F(SDKMetaCacheWatcherTest, ApplySplitAndLeaderChange) {
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    // cached regions a-c, c-e, e-g are watched by one rpc
+    EXPECT_EQ(t_rpc->Request()->key(), "a");
+    EXPECT_EQ(t_rpc->Request()->range_end(), "g");
+    EXPECT_EQ(t_rpc->Request()->limit(), 0);
+
+    // a-c split into a-b and b-c
+    Region2ScanRegionInfo(GenRangeRegion('a', "a", "b", 2), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(GenRangeRegion('b', "b", "c", 2), t_rpc->MutableResponse()->add_regions());
+
+    // leader of c-e moved
+    auto c2e = RegionC2E();
+    c2e->MarkLeader(kAddrTwo);
+    Region2ScanRegionInfo(c2e, t_rpc->MutableResponse()->add_regions());
+
+    Region2ScanRegionInfo(RegionE2G(), t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  int64_t changed = 0;
+  EXPECT_TRUE(meta_cache_watcher->WatchOnce(changed).ok());
+  EXPECT_EQ(changed, 3);
+
+  std::shared_ptr<Region> region;
+  ASSERT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("a", region).ok());
+  EXPECT_EQ(region->Range().end_key(), "b");
+  ASSERT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("b", region).ok());
+  EXPECT_EQ(region->RegionId(), 'b');
+
+  ASSERT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("c", region).ok());
+  EndPoint leader;
+  ASSERT_TRUE(region->GetLeader(leader).ok());
+  EXPECT_EQ(leader, kAddrTwo);
+}
+
+TEST_F(SDKMetaCacheWatcherTest, NothingChanged) {
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionE2G(), t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  int64_t changed = 0;
+  EXPECT_TRUE(meta_cache_watcher->WatchOnce(changed).ok());
+  EXPECT_EQ(changed, 0);
+}
+
+TEST_F(SDKMetaCacheWatcherTest, WatchFail) {
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    return Status::NetworkError("mock error");
+  });
+
+  int64_t changed = 0;
+  EXPECT_TRUE(meta_cache_watcher->WatchOnce(changed).IsNetworkError());
+
+  // cache is kept as is
+  std::shared_ptr<Region> region;
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("d", region).ok());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
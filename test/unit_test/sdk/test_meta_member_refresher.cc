@@ -0,0 +1,106 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mock_coordinator_rpc_controller.h"
+#include "sdk/meta_member_refresher.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/utils/net_util.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKMetaMemberRefresherTest : public TestBase {};
+
+namespace {
+void AddLocation(pb::coordinator::GetCoordinatorMapResponse* response, const std::string& host, int port) {
+  auto* location = response->add_coordinator_locations();
+  location->set_host(host);
+  location->set_port(port);
+}
+}  // namespace
+
+TEST_F(SDKMetaMemberRefresherTest, ReadNamingService) {
+  std::string file_path = "./test_meta_member_refresher_naming";
+  {
+    std::ofstream file(file_path);
+    file << "# coordinators\n"
+         << "127.0.0.1:22001\n"
+         << "\n"
+         << "127.0.0.1:22002\n"
+         << "127.0.0.1:22001\n"
+         << "127.0.0.1:port\n"
+         << "127.0.0.1\n";
+  }
+
+  std::vector<EndPoint> endpoints;
+  Status s = MetaMemberRefresher::ReadNamingService("file://" + file_path, endpoints);
+  EXPECT_TRUE(s.ok());
+  // comment, empty, duplicate and invalid lines are skipped
+  ASSERT_EQ(endpoints.size(), 2);
+  EXPECT_EQ(endpoints[0], EndPoint("127.0.0.1", 22001));
+  EXPECT_EQ(endpoints[1], EndPoint("127.0.0.1", 22002));
+
+  EXPECT_TRUE(MetaMemberRefresher::ReadNamingService("list://127.0.0.1:22001", endpoints).IsInvalidArgument());
+  EXPECT_TRUE(MetaMemberRefresher::ReadNamingService("file://./not_exist_naming", endpoints).IsIOError());
+
+  std::remove(file_path.c_str());
+}
+
+TEST_F(SDKMetaMemberRefresherTest, RefreshFromCoordinatorMap) {
+  coordinator_rpc_controller->SetMembers({EndPoint("127.0.0.1", 22001), EndPoint("127.0.0.1", 22002)});
+  meta_rpc_controller->SetMembers({EndPoint("127.0.0.1", 22001), EndPoint("127.0.0.1", 22002)});
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<GetCoordinatorMapRpc*>(&rpc);
+        CHECK_NOTNULL(t_rpc);
+        // 22001 is replaced by 22003
+        AddLocation(t_rpc->MutableResponse(), "127.0.0.1", 22003);
+        AddLocation(t_rpc->MutableResponse(), "127.0.0.1", 22002);
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<GetCoordinatorMapRpc*>(&rpc);
+        AddLocation(t_rpc->MutableResponse(), "127.0.0.1", 22002);
+        AddLocation(t_rpc->MutableResponse(), "127.0.0.1", 22003);
+        return Status::OK();
+      })
+      .WillOnce([](Rpc&) { return Status::OK(); });
+
+  bool changed = false;
+  EXPECT_TRUE(meta_member_refresher->RefreshOnce(changed).ok());
+  EXPECT_TRUE(changed);
+  std::vector<EndPoint> expected{EndPoint("127.0.0.1", 22003), EndPoint("127.0.0.1", 22002)};
+  EXPECT_EQ(coordinator_rpc_controller->GetMembers(), expected);
+  EXPECT_EQ(meta_rpc_controller->GetMembers(), expected);
+
+  // same members in another order
+  EXPECT_TRUE(meta_member_refresher->RefreshOnce(changed).ok());
+  EXPECT_FALSE(changed);
+
+  // no member answered, current ones are kept
+  EXPECT_TRUE(meta_member_refresher->RefreshOnce(changed).IsNotFound());
+  EXPECT_FALSE(changed);
+  EXPECT_EQ(coordinator_rpc_controller->GetMembers(), expected);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sdk/common/metrics.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKMetricsTest, HistogramPercentile) {
+  MetricsHistogram histogram;
+  EXPECT_EQ(histogram.Percentile(0.99), 0);
+
+  for (int i = 0; i < 99; i++) {
+    histogram.Record(3);
+  }
+  histogram.Record(1000);
+
+  EXPECT_EQ(histogram.Count(), 100);
+  EXPECT_EQ(histogram.Sum(), 99 * 3 + 1000);
+  // 3 is in bucket [2, 4), 1000 is in bucket [512, 1024)
+  EXPECT_EQ(histogram.Percentile(0.5), 3);
+  EXPECT_EQ(histogram.Percentile(0.99), 3);
+  EXPECT_EQ(histogram.Percentile(1.0), 1023);
+}
+
+TEST(SDKMetricsTest, HistogramZeroAndHuge) {
+  MetricsHistogram histogram;
+  histogram.Record(0);
+  histogram.Record(INT64_MAX);
+  EXPECT_EQ(histogram.Percentile(0.5), 0);
+  EXPECT_GT(histogram.Percentile(1.0), 0);
+}
+
+TEST(SDKMetricsTest, RecordTask) {
+  auto& metrics = Metrics::Global();
+  metrics.RecordTask("MetricsTestTask-1", 100, Status::OK(), 4);
+  metrics.RecordTask("MetricsTestTask-2", 200, Status::Aborted("mock"), 0);
+  metrics.RecordTaskRetry("MetricsTestTask-2", 10001);
+
+  TaskMetric* metric = metrics.GetTaskMetric("MetricsTestTask");
+  ASSERT_NE(metric, nullptr);
+  // suffix after '-' is dropped, both runs are counted in one metric
+  EXPECT_EQ(metric->latency_us.Count(), 2);
+  EXPECT_EQ(metric->fan_out.Count(), 1);
+  EXPECT_EQ(metric->fail_count.load(), 1);
+  EXPECT_EQ(metric->retries.Snapshot().at(10001), 1);
+
+  std::string dump = metrics.Dump();
+  EXPECT_NE(dump.find("dingo_sdk_task_latency_us_count{task=\"MetricsTestTask\"} 2"), std::string::npos);
+  EXPECT_NE(dump.find("dingo_sdk_task_fail_total{task=\"MetricsTestTask\"} 1"), std::string::npos);
+  EXPECT_NE(dump.find("dingo_sdk_meta_cache_hit_total"), std::string::npos);
+}
+
+TEST(SDKMetricsTest, RecordAsTask) {
+  Status s = RecordAsTask("MetricsTestTxnPhase", [] { return Status::NotFound("mock"); });
+  EXPECT_TRUE(s.IsNotFound());
+
+  TaskMetric* metric = Metrics::Global().GetTaskMetric("MetricsTestTxnPhase");
+  ASSERT_NE(metric, nullptr);
+  EXPECT_EQ(metric->latency_us.Count(), 1);
+  EXPECT_EQ(metric->fail_count.load(), 1);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mock_coordinator_rpc_controller.h"
+#include "sdk/common/param_config.h"
+#include "sdk/meta_cache.h"
+#include "sdk/partition_region_cache.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKPartitionRegionCacheTest : public TestBase {
+ protected:
+  void SetUp() override {
+    coordinator_rpc_controller = std::make_shared<MockCoordinatorRpcController>(*stub);
+    meta_cache = std::make_shared<MetaCache>(coordinator_rpc_controller);
+
+    range.set_start_key("a");
+    range.set_end_key("e");
+  }
+
+  void TearDown() override { meta_cache.reset(); }
+
+  std::shared_ptr<MockCoordinatorRpcController> coordinator_rpc_controller;
+  std::shared_ptr<MetaCache> meta_cache;
+  pb::common::Range range;
+};
+
+TEST_F(SDKPartitionRegionCacheTest, ReuseUntilStale) {
+  meta_cache->MaybeAddRegion(RegionA2C());
+  meta_cache->MaybeAddRegion(RegionC2E());
+
+  PartitionRegionCache cache;
+  std::vector<std::shared_ptr<Region>> regions;
+  Status got = cache.GetRegions(*meta_cache, 1, range, regions);
+  ASSERT_TRUE(got.IsOK());
+  ASSERT_EQ(regions.size(), 2);
+
+  std::vector<std::shared_ptr<Region>> cached;
+  got = cache.GetRegions(*meta_cache, 1, range, cached);
+  ASSERT_TRUE(got.IsOK());
+  EXPECT_EQ(cached, regions);
+
+  // e.g. region version error of a store rpc
+  meta_cache->ClearRange(regions[0]);
+
+  auto a2c = RegionA2C();
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    EXPECT_EQ(t_rpc->Request()->key(), "a");
+    Region2ScanRegionInfo(a2c, t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  got = cache.GetRegions(*meta_cache, 1, range, cached);
+  ASSERT_TRUE(got.IsOK());
+  ASSERT_EQ(cached.size(), 2);
+  EXPECT_NE(cached[0], regions[0]);
+  EXPECT_FALSE(cached[0]->IsStale());
+  EXPECT_EQ(cached[1], regions[1]);
+}
+
+TEST_F(SDKPartitionRegionCacheTest, Disabled) {
+  meta_cache->MaybeAddRegion(RegionA2C());
+  meta_cache->MaybeAddRegion(RegionC2E());
+
+  FLAGS_enable_partition_region_cache = false;
+  PartitionRegionCache cache;
+  std::vector<std::shared_ptr<Region>> regions;
+  Status got = cache.GetRegions(*meta_cache, 1, range, regions);
+  FLAGS_enable_partition_region_cache = true;
+  ASSERT_TRUE(got.IsOK());
+  EXPECT_EQ(regions.size(), 2);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,57 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sdk/common/profiler.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKProfilerTest : public ::testing::Test {};
+
+TEST_F(SDKProfilerTest, StopWithoutStart) {
+  auto& profiler = Profiler::Global();
+
+  EXPECT_TRUE(profiler.StopCpuProfile().IsIllegalState());
+  EXPECT_TRUE(profiler.StopHeapProfile().IsIllegalState());
+  EXPECT_TRUE(profiler.DumpHeapProfile().IsIllegalState());
+  EXPECT_FALSE(profiler.IsCpuProfiling());
+  EXPECT_FALSE(profiler.IsHeapProfiling());
+}
+
+TEST_F(SDKProfilerTest, CpuProfile) {
+  auto& profiler = Profiler::Global();
+  std::string file = "sdk_test_profiler.prof";
+
+  auto status = profiler.StartCpuProfile(file);
+  if (status.IsNotSupported()) {
+    // the test binary is not linked with gperftools
+    EXPECT_FALSE(profiler.IsCpuProfiling());
+    return;
+  }
+  ASSERT_TRUE(status.IsOK()) << status.ToString();
+  EXPECT_TRUE(profiler.IsCpuProfiling());
+  EXPECT_TRUE(profiler.StartCpuProfile(file).IsIllegalState());
+
+  EXPECT_TRUE(profiler.StopCpuProfile().IsOK());
+  EXPECT_FALSE(profiler.IsCpuProfiling());
+  std::remove(file.c_str());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -59,7 +59,7 @@ TEST_F(SDKRegionTest, TestInit) {
   EXPECT_EQ(region->Epoch().conf_version(), 1);
   EXPECT_EQ(region->RegionType(), pb::common::STORE_REGION);
 
-  auto end_points = region->ReplicaEndPoint();
+  const auto& end_points = region->ReplicaEndPoint();
 
   for (const auto& end : end_points) {
     EXPECT_TRUE(kInitReplica.find(end) != kInitReplica.end());
@@ -96,5 +96,28 @@ TEST_F(SDKRegionTest, TestMark) {
   }
 }
 
+TEST_F(SDKRegionTest, TestMarkOutsideLeader) {
+  // e.g. leader hint of a newer conf, not one of the replicas of this region
+  EndPoint outside(kIpOne, kPort + 1);
+  region->MarkLeader(outside);
+  EndPoint leader;
+  Status got = region->GetLeader(leader);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(leader, outside);
+  EXPECT_TRUE(region->IsLeader(outside));
+  for (const auto& replica : region->Replicas()) {
+    EXPECT_EQ(replica.role, kFollower);
+  }
+
+  // stale follower mark of another replica keeps the leader
+  region->MarkFollower(kAddrTwo);
+  got = region->GetLeader(leader);
+  EXPECT_TRUE(got.IsOK());
+
+  region->MarkFollower(outside);
+  got = region->GetLeader(leader);
+  EXPECT_TRUE(got.IsNotFound());
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
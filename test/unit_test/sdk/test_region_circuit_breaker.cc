@@ -0,0 +1,116 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/region_circuit_breaker.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKRegionCircuitBreakerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_store_rpc_breaker_failures = 3;
+    FLAGS_store_rpc_breaker_open_ms = 20;
+  }
+
+  void TearDown() override {
+    FLAGS_store_rpc_breaker_failures = 0;
+    FLAGS_store_rpc_breaker_open_ms = 1000;
+  }
+
+  RegionCircuitBreaker breaker;
+};
+
+TEST_F(SDKRegionCircuitBreakerTest, DisabledAlwaysAllow) {
+  FLAGS_store_rpc_breaker_failures = 0;
+  for (int i = 0; i < 10; i++) {
+    breaker.RecordResult(1, true);
+  }
+
+  int64_t retry_after_ms = 0;
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kAllowed);
+  EXPECT_EQ(breaker.GetState(1), RegionCircuitBreaker::kClosed);
+}
+
+TEST_F(SDKRegionCircuitBreakerTest, OpenAfterConsecutiveFailures) {
+  int64_t retry_after_ms = 0;
+  breaker.RecordResult(1, true);
+  breaker.RecordResult(1, true);
+  // an answer resets the count
+  breaker.RecordResult(1, false);
+  breaker.RecordResult(1, true);
+  breaker.RecordResult(1, true);
+  EXPECT_EQ(breaker.GetState(1), RegionCircuitBreaker::kClosed);
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kAllowed);
+
+  breaker.RecordResult(1, true);
+  EXPECT_EQ(breaker.GetState(1), RegionCircuitBreaker::kOpen);
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kRejected);
+  EXPECT_GT(retry_after_ms, 0);
+  EXPECT_LE(retry_after_ms, 20);
+
+  // other regions are not affected
+  EXPECT_EQ(breaker.Admit(2, retry_after_ms), RegionCircuitBreaker::kAllowed);
+}
+
+TEST_F(SDKRegionCircuitBreakerTest, SingleProbeThenClose) {
+  for (int i = 0; i < 3; i++) {
+    breaker.RecordResult(1, true);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+
+  int64_t retry_after_ms = 0;
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kProbe);
+  EXPECT_EQ(breaker.GetState(1), RegionCircuitBreaker::kHalfOpen);
+  // only one probe in flight
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kRejected);
+
+  breaker.RecordResult(1, false);
+  EXPECT_EQ(breaker.GetState(1), RegionCircuitBreaker::kClosed);
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kAllowed);
+}
+
+TEST_F(SDKRegionCircuitBreakerTest, ProbeFailReopen) {
+  for (int i = 0; i < 3; i++) {
+    breaker.RecordResult(1, true);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+
+  int64_t retry_after_ms = 0;
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kProbe);
+  breaker.RecordResult(1, true);
+  EXPECT_EQ(breaker.GetState(1), RegionCircuitBreaker::kOpen);
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kRejected);
+}
+
+TEST_F(SDKRegionCircuitBreakerTest, LostProbeIsReplaced) {
+  for (int i = 0; i < 3; i++) {
+    breaker.RecordResult(1, true);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+
+  int64_t retry_after_ms = 0;
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kProbe);
+  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+  EXPECT_EQ(breaker.Admit(1, retry_after_ms), RegionCircuitBreaker::kProbe);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,97 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/retry_budget.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKRetryBudgetTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_sdk_retry_budget = true;
+    FLAGS_sdk_retry_budget_ratio = 0.5;
+    FLAGS_sdk_retry_budget_min_per_second = 0;
+    FLAGS_sdk_retry_budget_max_tokens = 2;
+  }
+
+  void TearDown() override {
+    FLAGS_sdk_retry_budget = false;
+    FLAGS_sdk_retry_budget_ratio = 0.1;
+    FLAGS_sdk_retry_budget_min_per_second = 10;
+    FLAGS_sdk_retry_budget_max_tokens = 100;
+  }
+};
+
+TEST_F(SDKRetryBudgetTest, Exhausted) {
+  RetryBudget budget;
+  EXPECT_EQ(budget.GetTokens(), 2);
+
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_FALSE(budget.TryRetry());
+
+  // two requests earn one retry
+  budget.RecordRequest();
+  EXPECT_FALSE(budget.TryRetry());
+  budget.RecordRequest();
+  EXPECT_TRUE(budget.TryRetry());
+
+  // saved tokens are capped
+  for (int i = 0; i < 10; i++) {
+    budget.RecordRequest();
+  }
+  EXPECT_EQ(budget.GetTokens(), 2);
+}
+
+TEST_F(SDKRetryBudgetTest, ConcurrentRetries) {
+  FLAGS_sdk_retry_budget_max_tokens = 100;
+  RetryBudget budget;
+
+  std::atomic<int> retries{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&budget, &retries] {
+      for (int j = 0; j < 50; j++) {
+        if (budget.TryRetry()) {
+          retries++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // each token is taken once
+  EXPECT_EQ(retries.load(), 100);
+  EXPECT_EQ(budget.GetTokens(), 0);
+}
+
+TEST_F(SDKRetryBudgetTest, Disabled) {
+  RetryBudget budget;
+  FLAGS_sdk_retry_budget = false;
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(budget.TryRetry());
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+#include "gtest/gtest.h"
+#include "sdk/route_table.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+static std::shared_ptr<Region> MakeRegion(int64_t id, const std::string& start_key, const std::string& end_key) {
+  pb::common::Range range;
+  range.set_start_key(start_key);
+  range.set_end_key(end_key);
+
+  pb::common::RegionEpoch epoch;
+  epoch.set_version(1);
+  epoch.set_conf_version(1);
+
+  return GenRegion(id, range, epoch, pb::common::RegionType::STORE_REGION);
+}
+
+TEST(SDKRouteTableTest, Empty) {
+  RouteTable routes;
+  routes.Finish();
+
+  EXPECT_EQ(routes.Size(), 0);
+  EXPECT_EQ(routes.Find("a"), RouteTable::kNotFound);
+}
+
+TEST(SDKRouteTableTest, FindWithGaps) {
+  // [b, d) [d, f) gap [h, j)
+  std::vector<std::shared_ptr<Region>> regions = {MakeRegion(1, "b", "d"), MakeRegion(2, "d", "f"),
+                                                  MakeRegion(3, "h", "j")};
+  RouteTable routes;
+  routes.Reserve(regions.size());
+  for (const auto& region : regions) {
+    routes.Add(region->Range().start_key(), region->Range().end_key(), region);
+  }
+  routes.Finish();
+
+  EXPECT_EQ(routes.Find("a"), RouteTable::kNotFound);
+  EXPECT_EQ(routes.Find("b"), 0);
+  EXPECT_EQ(routes.Find("cz"), 0);
+  EXPECT_EQ(routes.Find("d"), 1);
+  EXPECT_EQ(routes.Find("f"), RouteTable::kNotFound);
+  EXPECT_EQ(routes.Find("g"), RouteTable::kNotFound);
+  EXPECT_EQ(routes.Find("i"), 2);
+  EXPECT_EQ(routes.Find("j"), RouteTable::kNotFound);
+
+  EXPECT_EQ(routes.Seek("a"), RouteTable::kNotFound);
+  EXPECT_EQ(routes.Seek("g"), 1);
+  EXPECT_EQ(routes.Seek("z"), 2);
+
+  EXPECT_EQ(routes.RegionAt(2)->RegionId(), 3);
+  EXPECT_EQ(routes.EndKey(0), "d");
+  EXPECT_EQ(routes.EndKey(1), "f");
+  EXPECT_EQ(routes.EndKey(2), "j");
+}
+
+TEST(SDKRouteTableTest, ManyBlocks) {
+  // contiguous ranges sharing a long prefix, over several blocks
+  auto key = [](int64_t i) { return fmt::format("table_0001_partition_{:08d}", i * 10); };
+
+  const int64_t count = RouteTable::kBlockSize * 5 + 3;
+  RouteTable routes;
+  routes.Reserve(count);
+  for (int64_t i = 0; i < count; i++) {
+    routes.Add(key(i), key(i + 1), MakeRegion(i + 1, key(i), key(i + 1)));
+  }
+  routes.Finish();
+  EXPECT_EQ(routes.Size(), count);
+
+  for (int64_t i = 0; i < count; i++) {
+    EXPECT_EQ(routes.StartKey(i), key(i));
+    EXPECT_EQ(routes.EndKey(i), key(i + 1));
+
+    EXPECT_EQ(routes.Find(key(i)), i);
+    EXPECT_EQ(routes.Find(key(i) + "5"), i);
+    EXPECT_EQ(routes.RegionAt(i)->RegionId(), i + 1);
+  }
+  EXPECT_EQ(routes.Find(key(count)), RouteTable::kNotFound);
+  EXPECT_EQ(routes.Find("table_0000"), RouteTable::kNotFound);
+
+  // shared prefixes and end keys are not stored again
+  EXPECT_LT(routes.MemoryUsage(), count * (sizeof(std::shared_ptr<Region>) + 2 * key(0).size()));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,55 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "google/protobuf/descriptor.h"
+#include "gtest/gtest.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/rpc_client.h"
+#include "sdk/rpc/store_rpc.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKRpcClientTest, FindProtoMethod) {
+  KvGetRpc get_rpc;
+  const auto* method = FindProtoMethod(get_rpc);
+  ASSERT_NE(method, nullptr);
+  EXPECT_EQ(method->name(), "KvGet");
+  EXPECT_EQ(method->service()->full_name(), get_rpc.ServiceFullName());
+  EXPECT_EQ(method->input_type(), get_rpc.RawRequest()->GetDescriptor());
+  EXPECT_EQ(method->output_type(), get_rpc.RawResponse()->GetDescriptor());
+
+  TsoServiceRpc tso_rpc;
+  method = FindProtoMethod(tso_rpc);
+  ASSERT_NE(method, nullptr);
+  EXPECT_EQ(method->input_type(), tso_rpc.RawRequest()->GetDescriptor());
+}
+
+TEST(SDKRpcClientTest, NewRpcClientFallbackToNative) {
+  RpcClientOptions options;
+  std::unique_ptr<RpcClient> native(NewRpcClient(options, ""));
+  EXPECT_NE(native, nullptr);
+
+  std::unique_ptr<RpcClient> named(NewRpcClient(options, NativeRpcBackend()));
+  EXPECT_NE(named, nullptr);
+
+  std::unique_ptr<RpcClient> unknown(NewRpcClient(options, "unknown"));
+  EXPECT_NE(unknown, nullptr);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/rpc_compression.h"
+#include "sdk/rpc/store_rpc.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKRpcCompressionTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    FLAGS_rpc_compress_type = "none";
+    FLAGS_rpc_compress_min_bytes = 4096;
+    FLAGS_rpc_compress_methods = "";
+  }
+};
+
+TEST_F(SDKRpcCompressionTest, ParseType) {
+  RpcCompressType type;
+  EXPECT_TRUE(ParseRpcCompressType("zstd", type));
+  EXPECT_EQ(type, kRpcCompressZstd);
+  EXPECT_STREQ(RpcCompressTypeName(type), "zstd");
+  EXPECT_FALSE(ParseRpcCompressType("brotli", type));
+}
+
+TEST_F(SDKRpcCompressionTest, DefaultNone) {
+  auto options = RpcCompressOptions::FromFlags();
+
+  KvPutRpc rpc;
+  rpc.MutableRequest()->mutable_kv()->set_value(std::string(8192, 'a'));
+  EXPECT_EQ(options.Pick(rpc.Method(), *rpc.RawRequest()), kRpcCompressNone);
+}
+
+TEST_F(SDKRpcCompressionTest, MinBytes) {
+  FLAGS_rpc_compress_type = "lz4";
+  FLAGS_rpc_compress_min_bytes = 1024;
+  auto options = RpcCompressOptions::FromFlags();
+
+  KvPutRpc rpc;
+  rpc.MutableRequest()->mutable_kv()->set_value(std::string(100, 'a'));
+  EXPECT_EQ(options.Pick(rpc.Method(), *rpc.RawRequest()), kRpcCompressNone);
+
+  rpc.MutableRequest()->mutable_kv()->set_value(std::string(2048, 'a'));
+  EXPECT_EQ(options.Pick(rpc.Method(), *rpc.RawRequest()), kRpcCompressLz4);
+}
+
+TEST_F(SDKRpcCompressionTest, MethodPolicy) {
+  FLAGS_rpc_compress_type = "snappy";
+  FLAGS_rpc_compress_min_bytes = 0;
+  FLAGS_rpc_compress_methods = "KvPut:zstd:16,KvGet:none,bad,KvScan:gzip";
+  auto options = RpcCompressOptions::FromFlags();
+
+  ASSERT_EQ(options.method_policies.size(), 2);
+  EXPECT_EQ(options.GetPolicy("StoreService.KvPutRpc").type, kRpcCompressZstd);
+  EXPECT_EQ(options.GetPolicy("StoreService.KvPutRpc").min_bytes, 16);
+  EXPECT_EQ(options.GetPolicy("dingodb.pb.store.StoreService.KvGetRpc").type, kRpcCompressNone);
+  EXPECT_EQ(options.GetPolicy("StoreService.KvBatchPutRpc").type, kRpcCompressSnappy);
+
+  KvPutRpc rpc;
+  rpc.MutableRequest()->mutable_kv()->set_value(std::string(64, 'a'));
+  EXPECT_EQ(options.Pick(rpc.Method(), *rpc.RawRequest()), kRpcCompressZstd);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,64 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/rpc_pool.h"
+#include "sdk/rpc/store_rpc.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKRpcPoolTest : public ::testing::Test {
+ protected:
+  void TearDown() override { FLAGS_rpc_pool_max_size = 256; }
+};
+
+TEST_F(SDKRpcPoolTest, Reuse) {
+  KvBatchGetRpc* raw = nullptr;
+  {
+    auto rpc = RpcPool<KvBatchGetRpc>::Acquire();
+    raw = rpc.get();
+    rpc->MutableRequest()->add_keys("a");
+    rpc->MutableResponse()->add_kvs()->set_key("a");
+    rpc->SetPriority(kBackground);
+  }
+  size_t free_size = RpcPool<KvBatchGetRpc>::FreeSize();
+  EXPECT_GE(free_size, 1);
+
+  auto rpc = RpcPool<KvBatchGetRpc>::Acquire();
+  EXPECT_EQ(rpc.get(), raw);
+  EXPECT_EQ(rpc->Request()->keys_size(), 0);
+  EXPECT_EQ(rpc->Response()->kvs_size(), 0);
+  EXPECT_EQ(rpc->GetPriority(), kInteractive);
+  EXPECT_EQ(RpcPool<KvBatchGetRpc>::FreeSize(), free_size - 1);
+}
+
+TEST_F(SDKRpcPoolTest, Disabled) {
+  FLAGS_rpc_pool_max_size = 0;
+  size_t free_size = RpcPool<KvBatchPutRpc>::FreeSize();
+  { auto rpc = RpcPool<KvBatchPutRpc>::Acquire(); }
+  EXPECT_EQ(RpcPool<KvBatchPutRpc>::FreeSize(), free_size);
+}
+
+TEST_F(SDKRpcPoolTest, Adopt) {
+  size_t free_size = RpcPool<KvBatchDeleteRpc>::FreeSize();
+  { auto rpc = RpcPool<KvBatchDeleteRpc>::Adopt(std::make_unique<KvBatchDeleteRpc>()); }
+  EXPECT_EQ(RpcPool<KvBatchDeleteRpc>::FreeSize(), free_size);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
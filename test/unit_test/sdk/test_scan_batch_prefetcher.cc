@@ -0,0 +1,131 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/client.h"
+#include "sdk/scan_batch_prefetcher.h"
+#include "sdk/status.h"
+#include "sdk/utils/async_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKScanBatchPrefetcherTest : public ::testing::Test {
+ protected:
+  // one row a batch, rows 0..total-1
+  void Fetch(std::vector<KVPair>& kvs, StatusCallback cb) {
+    fetch_count++;
+    int64_t row = next_row++;
+    kvs.push_back({std::to_string(row), std::to_string(row)});
+    more = next_row < total;
+    cb(Status::OK());
+  }
+
+  Status Next(ScanBatchPrefetcher& prefetcher, std::vector<KVPair>& kvs) {
+    Synchronizer sync;
+    Status status;
+    prefetcher.AsyncNext(kvs, sync.AsStatusCallBack(status));
+    sync.Wait();
+    return status;
+  }
+
+  int64_t total{3};
+  int64_t next_row{0};
+  std::atomic<bool> more{true};
+  int64_t fetch_count{0};
+};
+
+TEST_F(SDKScanBatchPrefetcherTest, PrefetchNextBatch) {
+  ScanBatchPrefetcher prefetcher([this](std::vector<KVPair>& kvs, StatusCallback cb) { Fetch(kvs, std::move(cb)); },
+                                 [this] { return more.load(); });
+  EXPECT_FALSE(prefetcher.HasPending());
+
+  std::vector<KVPair> kvs;
+  ASSERT_TRUE(Next(prefetcher, kvs).ok());
+  ASSERT_EQ(kvs.size(), 1);
+  EXPECT_EQ(kvs[0].key, "0");
+  // row 1 is fetched before caller asks for it
+  EXPECT_EQ(fetch_count, 2);
+  EXPECT_TRUE(prefetcher.HasPending());
+
+  kvs.clear();
+  ASSERT_TRUE(Next(prefetcher, kvs).ok());
+  ASSERT_EQ(kvs.size(), 1);
+  EXPECT_EQ(kvs[0].key, "1");
+  EXPECT_EQ(fetch_count, 3);
+
+  kvs.clear();
+  ASSERT_TRUE(Next(prefetcher, kvs).ok());
+  ASSERT_EQ(kvs.size(), 1);
+  EXPECT_EQ(kvs[0].key, "2");
+  // no more rows, nothing to prefetch
+  EXPECT_EQ(fetch_count, 3);
+  EXPECT_FALSE(prefetcher.HasPending());
+}
+
+TEST_F(SDKScanBatchPrefetcherTest, AsyncFetchInOrder) {
+  total = 100;
+  std::mutex threads_mutex;
+  std::vector<std::thread> threads;
+  ScanBatchPrefetcher prefetcher(
+      [this, &threads, &threads_mutex](std::vector<KVPair>& kvs, StatusCallback cb) {
+        // new thread maybe start the next fetch before emplace_back return
+        std::unique_lock<std::mutex> lk(threads_mutex);
+        threads.emplace_back([this, &kvs, cb]() { Fetch(kvs, cb); });
+      },
+      [this] { return more.load(); });
+
+  std::vector<std::string> keys;
+  while (keys.empty() || more.load() || prefetcher.HasPending()) {
+    std::vector<KVPair> kvs;
+    ASSERT_TRUE(Next(prefetcher, kvs).ok());
+    for (const auto& kv : kvs) {
+      keys.push_back(kv.key);
+    }
+  }
+
+  prefetcher.Wait();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(keys.size(), total);
+  for (int64_t i = 0; i < total; ++i) {
+    EXPECT_EQ(keys[i], std::to_string(i));
+  }
+}
+
+TEST_F(SDKScanBatchPrefetcherTest, FailStopsPrefetch) {
+  ScanBatchPrefetcher prefetcher(
+      [this](std::vector<KVPair>& kvs, StatusCallback cb) {
+        fetch_count++;
+        cb(Status::NetworkError("mock error"));
+      },
+      [this] { return more.load(); });
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(Next(prefetcher, kvs).IsNetworkError());
+  EXPECT_EQ(fetch_count, 1);
+  EXPECT_FALSE(prefetcher.HasPending());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
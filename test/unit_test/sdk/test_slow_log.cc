@@ -0,0 +1,174 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/common/metrics.h"
+#include "sdk/common/param_config.h"
+#include "sdk/common/slow_log.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKSlowLogTest : public ::testing::Test {
+ protected:
+  void SetUp() override { FLAGS_slow_log_threshold_ms = 1; }
+
+  void TearDown() override {
+    FLAGS_slow_log_threshold_ms = 0;
+    FLAGS_slow_log_capacity = 256;
+    FLAGS_slow_log_max_rpcs = 256;
+  }
+
+  static SlowLogRpc MockRpc(int64_t region_id) {
+    SlowLogRpc rpc;
+    rpc.region_id = region_id;
+    rpc.method = "StoreService.KvGetRpc";
+    rpc.end_point = "127.0.0.1:20001";
+    rpc.latency_us = 5000;
+    rpc.request_bytes = 10;
+    rpc.response_bytes = 20;
+    rpc.status = "OK";
+    return rpc;
+  }
+};
+
+TEST_F(SDKSlowLogTest, JoinRequest) {
+  bool is_root = false;
+  std::shared_ptr<SlowLogRecorder> root = SlowLog::Join(is_root);
+  ASSERT_NE(root, nullptr);
+  EXPECT_TRUE(is_root);
+
+  {
+    ScopedSlowLogRecorder scope(root);
+    EXPECT_EQ(SlowLog::CurrentRecorder(), root);
+
+    // sub task joins the request of its parent
+    std::shared_ptr<SlowLogRecorder> sub = SlowLog::Join(is_root);
+    EXPECT_EQ(sub, root);
+    EXPECT_FALSE(is_root);
+  }
+  EXPECT_EQ(SlowLog::CurrentRecorder(), nullptr);
+
+  FLAGS_slow_log_threshold_ms = 0;
+  EXPECT_EQ(SlowLog::Join(is_root), nullptr);
+  EXPECT_FALSE(is_root);
+}
+
+TEST_F(SDKSlowLogTest, Phases) {
+  FLAGS_slow_log_threshold_ms = 0;
+  auto recorder = std::make_shared<SlowLogRecorder>();
+  {
+    // recorder made current by the caller is joined even when slow log is disabled
+    ScopedSlowLogRecorder scope(recorder);
+    bool is_root = true;
+    EXPECT_EQ(SlowLog::Join(is_root), recorder);
+    EXPECT_FALSE(is_root);
+  }
+
+  // no rpc, all of it is client time
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  SlowLogPhases phases = recorder->Phases();
+  EXPECT_GE(phases.client_us, 1000);
+  EXPECT_EQ(phases.rpc_us, 0);
+
+  int64_t start_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch())
+                         .count();
+  SlowLogRpc first = MockRpc(1);
+  first.send_us = start_us;
+  first.queue_us = 10;
+  first.latency_us = 3000;
+  first.response_us = 20;
+  SlowLogRpc last = MockRpc(2);
+  last.send_us = start_us + 100;
+  last.queue_us = 30;
+  last.latency_us = 5000;
+  last.response_us = 40;
+  recorder->AddRpc(last);
+  recorder->AddRpc(first);
+
+  // rpc phases are of the rpc done last
+  phases = recorder->Phases();
+  EXPECT_EQ(phases.queue_us, 30);
+  EXPECT_EQ(phases.rpc_us, 5000);
+  EXPECT_EQ(phases.response_us, 40);
+  EXPECT_GE(phases.client_us, 1000);
+}
+
+TEST_F(SDKSlowLogTest, FinishOverThreshold) {
+  FLAGS_slow_log_max_rpcs = 2;
+  SlowLogRecorder recorder;
+  recorder.AddRpc(MockRpc(1));
+  recorder.AddRpc(MockRpc(2));
+  recorder.AddRpc(MockRpc(3));
+  recorder.AddRetry();
+
+  size_t before = SlowLog::Global().Entries().size();
+  // fast request is not kept
+  SlowLog::Global().Finish("FastTask", recorder, 100, Status::OK());
+  EXPECT_EQ(SlowLog::Global().Entries().size(), before);
+
+  SlowLog::Global().Finish("SlowLogTestTask", recorder, 2000, Status::Aborted("mock"));
+  std::vector<SlowLogEntry> entries = SlowLog::Global().Entries();
+  ASSERT_FALSE(entries.empty());
+  const SlowLogEntry& entry = entries.back();
+  EXPECT_EQ(entry.name, "SlowLogTestTask");
+  EXPECT_EQ(entry.latency_us, 2000);
+  EXPECT_EQ(entry.retries, 1);
+  ASSERT_EQ(entry.rpcs.size(), 2);
+  EXPECT_EQ(entry.rpcs[1].region_id, 2);
+  EXPECT_EQ(entry.dropped_rpcs, 1);
+
+  std::string dump = SlowLog::Global().Dump();
+  EXPECT_NE(dump.find("name:SlowLogTestTask latency_us:2000"), std::string::npos);
+  EXPECT_NE(dump.find("  region:2 method:StoreService.KvGetRpc endpoint:127.0.0.1:20001"), std::string::npos);
+}
+
+TEST_F(SDKSlowLogTest, BoundedCapacity) {
+  FLAGS_slow_log_capacity = 2;
+  for (int i = 0; i < 4; i++) {
+    SlowLogRecorder recorder;
+    SlowLog::Global().Finish("SlowLogCapacityTask" + std::to_string(i), recorder, 2000, Status::OK());
+  }
+
+  std::vector<SlowLogEntry> entries = SlowLog::Global().Entries();
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(entries[0].name, "SlowLogCapacityTask2");
+  EXPECT_EQ(entries[1].name, "SlowLogCapacityTask3");
+}
+
+TEST_F(SDKSlowLogTest, RecordAsTask) {
+  Status s = RecordAsTask("SlowLogTestTxnCommit", [] {
+    SlowLog::CurrentRecorder()->AddRpc(MockRpc(100));
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return Status::OK();
+  });
+  EXPECT_TRUE(s.ok());
+
+  std::vector<SlowLogEntry> entries = SlowLog::Global().Entries();
+  ASSERT_FALSE(entries.empty());
+  EXPECT_EQ(entries.back().name, "SlowLogTestTxnCommit");
+  ASSERT_EQ(entries.back().rpcs.size(), 1);
+  EXPECT_EQ(entries.back().rpcs[0].region_id, 100);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
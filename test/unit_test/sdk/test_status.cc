@@ -0,0 +1,61 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "common/logging.h"
+#include "gtest/gtest.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKStatusTest, CopyKeepsMessage) {
+  Status s = Status::NotLeader(10001, "not leader", "region:1");
+  Status copy = s;
+  Status assigned;
+  assigned = copy;
+
+  EXPECT_TRUE(assigned.IsNotLeader());
+  EXPECT_EQ(assigned.Errno(), 10001);
+  EXPECT_EQ(assigned.ToString(), s.ToString());
+  EXPECT_EQ(s.ToString(), "NotLeader (errno:10001) : not leader: region:1");
+
+  Status moved = std::move(copy);
+  EXPECT_EQ(moved.ToString(), s.ToString());
+}
+
+TEST(SDKStatusTest, EmptyMessage) {
+  Status s = Status::Incomplete(10002, "");
+  EXPECT_FALSE(s.ok());
+  EXPECT_TRUE(s.IsIncomplete());
+  EXPECT_EQ(s.ToString(), "Incomplete (errno:10002) ");
+
+  EXPECT_EQ(Status::OK().ToString(), "OK");
+}
+
+TEST(SDKStatusTest, LogEverySecond) {
+  std::atomic<int64_t> last_ms{std::numeric_limits<int64_t>::min() / 2};
+  EXPECT_TRUE(LogEverySecond(last_ms));
+  EXPECT_FALSE(LogEverySecond(last_ms));
+
+  last_ms.store(last_ms.load() - 1000);
+  EXPECT_TRUE(LogEverySecond(last_ms));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <set>
+
+#include "gtest/gtest.h"
+#include "sdk/rpc/store_connection_manager.h"
+#include "sdk/rpc/store_rpc.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKStoreConnectionManagerTest : public TestBase {};
+
+TEST_F(SDKStoreConnectionManagerTest, CollectEndPoints) {
+  auto end_points = StoreConnectionManager::CollectEndPoints({RegionA2C(), RegionC2E()});
+  ASSERT_EQ(end_points.size(), 3);
+  // first region serving the endpoint is used for its probe
+  EXPECT_EQ(end_points[kAddrOne]->RegionId(), RegionA2C()->RegionId());
+
+  EXPECT_TRUE(StoreConnectionManager::CollectEndPoints({}).empty());
+}
+
+TEST_F(SDKStoreConnectionManagerTest, ProbeMarksDownEndPoint) {
+  std::set<EndPoint> probed;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(3).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    probed.insert(rpc.GetEndPoint());
+    if (rpc.GetEndPoint() == kAddrTwo) {
+      rpc.SetStatus(Status::NetworkError("connect fail"));
+    } else {
+      // an error of store still means it is alive
+      get_rpc->MutableResponse()->mutable_error()->set_errcode(pb::error::ERAFT_NOTLEADER);
+    }
+    cb();
+  });
+
+  int64_t down = 0;
+  store_connection_manager->ProbeOnce(down);
+  EXPECT_EQ(down, 1);
+  EXPECT_EQ(probed.size(), 3);
+
+  EXPECT_FALSE(replica_selector->IsProbeDown(kAddrOne));
+  EXPECT_TRUE(replica_selector->IsProbeDown(kAddrTwo));
+  EXPECT_FALSE(replica_selector->IsProbeDown(kAddrThree));
+
+  // down follower is not selected for read
+  EndPoint end_point;
+  auto region = RegionC2E();
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(replica_selector->SelectReadReplica(*region, kFollowerRoundRobin, end_point));
+    EXPECT_EQ(end_point, kAddrThree);
+  }
+
+  // a later probe success brings it back
+  replica_selector->RecordProbeResult(kAddrTwo, true);
+  EXPECT_FALSE(replica_selector->IsProbeDown(kAddrTwo));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
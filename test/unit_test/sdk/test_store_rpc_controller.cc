@@ -12,19 +12,25 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include "glog/logging.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "mock_store_rpc_controller.h"
+#include "sdk/cancel_token.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "proto/error.pb.h"
 #include "sdk/region.h"
 #include "sdk/rpc/rpc.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/status.h"
+#include "sdk/utils/async_util.h"
 #include "test_base.h"
 #include "test_common.h"
 
@@ -233,35 +239,121 @@ TEST_F(SDKStoreRpcControllerTest, RegionVersionWithStoreRegionInfo) {
   Status got = meta_cache->LookupRegionByKey(key, region);
   EXPECT_TRUE(got.IsOK());
   EXPECT_FALSE(region->IsStale());
+  FillRpcContext(*rpc.MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
 
   MockStoreRpcController controller(*stub, rpc, region);
 
   std::shared_ptr<Region> new_region = RegionC2E(2);
 
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        auto* response = kv_get_rpc->MutableResponse();
+        response->mutable_error()->set_errcode(pb::error::EREGION_VERSION);
+        auto* region_info = response->mutable_error()->mutable_store_region_info();
+
+        Region2StoreRegionInfo(new_region, region_info);
+
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        // range is not changed, resent at once with new epoch
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        EXPECT_EQ(EpochCompare(kv_get_rpc->Request()->context().region_epoch(), new_region->Epoch()), 0);
+        kv_get_rpc->MutableResponse()->Clear();
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+
+  EXPECT_TRUE(region->IsStale());
+
+  got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_FALSE(region->IsStale());
+  EXPECT_EQ(region->RegionId(), new_region->RegionId());
+  EXPECT_EQ(EpochCompare(region->Epoch(), new_region->Epoch()), 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, RegionVersionWithSplitStoreRegionInfo) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+  FillRpcContext(*rpc.MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+
+  MockStoreRpcController controller(*stub, rpc, region);
+
+  // region c2e split into [c, d) and [d, e), key may be out of region, so caller should regroup keys
+  std::shared_ptr<Region> new_region = RegionC2E(2);
+  pb::common::Range range = new_region->Range();
+  range.set_end_key("d");
+  new_region = GenRegion(new_region->RegionId(), range, new_region->Epoch(), pb::common::RegionType::STORE_REGION);
+
   EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
     auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
     CHECK_NOTNULL(kv_get_rpc);
     auto* response = kv_get_rpc->MutableResponse();
     response->mutable_error()->set_errcode(pb::error::EREGION_VERSION);
-    auto* region_info = response->mutable_error()->mutable_store_region_info();
-
-    Region2StoreRegionInfo(new_region, region_info);
-
+    Region2StoreRegionInfo(new_region, response->mutable_error()->mutable_store_region_info());
     cb();
   });
 
   Status call = controller.Call();
   EXPECT_TRUE(call.IsIncomplete());
-
   EXPECT_TRUE(region->IsStale());
 
-  got = meta_cache->LookupRegionByKey(key, region);
+  // new region is cached without coordinator lookup
+  got = meta_cache->LookupRegionByKey("c", region);
   EXPECT_TRUE(got.IsOK());
-  EXPECT_FALSE(region->IsStale());
-  EXPECT_EQ(region->RegionId(), new_region->RegionId());
   EXPECT_EQ(EpochCompare(region->Epoch(), new_region->Epoch()), 0);
 }
 
+TEST_F(SDKStoreRpcControllerTest, RegionVersionWithSplitStoreRegionInfoKeyInRegion) {
+  KvGetRpc rpc;
+  std::string key = "c1";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+  FillRpcContext(*rpc.MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+
+  MockStoreRpcController controller(*stub, rpc, region);
+
+  // region c2e split into [c, d) and [d, e), key stays in the region
+  std::shared_ptr<Region> new_region = RegionC2E(2);
+  pb::common::Range range = new_region->Range();
+  range.set_end_key("d");
+  new_region = GenRegion(new_region->RegionId(), range, new_region->Epoch(), pb::common::RegionType::STORE_REGION);
+
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        auto* response = kv_get_rpc->MutableResponse();
+        response->mutable_error()->set_errcode(pb::error::EREGION_VERSION);
+        Region2StoreRegionInfo(new_region, response->mutable_error()->mutable_store_region_info());
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        // single key in the new range, resent at once with new epoch
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        EXPECT_EQ(EpochCompare(kv_get_rpc->Request()->context().region_epoch(), new_region->Epoch()), 0);
+        kv_get_rpc->MutableResponse()->Clear();
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_TRUE(region->IsStale());
+}
+
 TEST_F(SDKStoreRpcControllerTest, RegionNotFound) {
   KvGetRpc rpc;
   std::string key = "d";
@@ -405,6 +497,389 @@ TEST_F(SDKStoreRpcControllerTest, OtherErrorCode) {
   EXPECT_FALSE(region->IsStale());
 }
 
+TEST_F(SDKStoreRpcControllerTest, NoLeaderRetryNotBlockCaller) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_FALSE(region->IsStale());
+
+  // first retry waits in [delay/2, delay]
+  int64_t old_delay_ms = FLAGS_store_rpc_retry_delay_ms;
+  FLAGS_store_rpc_retry_delay_ms = 200;
+
+  StoreRpcController controller(*stub, rpc, region);
+
+  std::thread::id caller = std::this_thread::get_id();
+  std::thread::id retry_on;
+  std::atomic<bool> retried{false};
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* kv_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_rpc);
+        kv_rpc->MutableResponse()->mutable_error()->set_errcode(pb::error::Errno::ERAFT_NOTLEADER);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        retry_on = std::this_thread::get_id();
+        retried.store(true);
+        rpc.Reset();
+        auto* kv_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_rpc);
+        kv_rpc->MutableResponse()->set_value("pong");
+        cb();
+      });
+
+  Status call;
+  Synchronizer sync;
+  // the first answer comes back in caller thread, the retry is scheduled by actuator after backoff
+  auto start = std::chrono::steady_clock::now();
+  controller.AsyncCall(sync.AsStatusCallBack(call));
+  auto return_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_FALSE(retried.load());
+  EXPECT_LT(return_ms, 100);
+  sync.Wait();
+  auto done_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "pong");
+  EXPECT_TRUE(retried.load());
+  EXPECT_NE(retry_on, caller);
+  EXPECT_GE(done_ms, 100);
+
+  FLAGS_store_rpc_retry_delay_ms = old_delay_ms;
+}
+
+TEST_F(SDKStoreRpcControllerTest, FollowerReadRoundRobin) {
+  std::string key = "d";
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  std::vector<EndPoint> sent;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(2).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    sent.push_back(rpc.GetEndPoint());
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    get_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  for (int i = 0; i < 2; i++) {
+    KvGetRpc rpc;
+    rpc.MutableRequest()->set_key(key);
+    StoreRpcController controller(*stub, rpc, region);
+    controller.SetReplicaReadPolicy(kFollowerRoundRobin);
+    Status call = controller.Call();
+    EXPECT_TRUE(call.IsOK());
+    EXPECT_EQ(rpc.Response()->value(), "pong");
+  }
+
+  ASSERT_EQ(sent.size(), 2);
+  EXPECT_NE(sent[0], kAddrOne);
+  EXPECT_NE(sent[1], kAddrOne);
+  EXPECT_NE(sent[0], sent[1]);
+}
+
+TEST_F(SDKStoreRpcControllerTest, FollowerReadNotLeaderRetryLeader) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+  controller.SetReplicaReadPolicy(kFollowerRoundRobin);
+
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_NE(rpc.GetEndPoint(), kAddrOne);
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        auto* response = kv_get_rpc->MutableResponse();
+        response->mutable_error()->set_errcode(pb::error::Errno::ERAFT_NOTLEADER);
+        *response->mutable_error()->mutable_leader_location() = EndPointToLocation(kAddrOne);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrOne);
+        rpc.Reset();
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        kv_get_rpc->MutableResponse()->set_value("pong");
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "pong");
+  EXPECT_FALSE(region->IsStale());
+}
+
+TEST_F(SDKStoreRpcControllerTest, LowestLatencyRead) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  replica_selector->RecordResult(kAddrOne, 500, false);
+  replica_selector->RecordResult(kAddrTwo, 300, false);
+  replica_selector->RecordResult(kAddrThree, 100, false);
+
+  StoreRpcController controller(*stub, rpc, region);
+  controller.SetReplicaReadPolicy(kLowestLatency);
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    EXPECT_EQ(rpc.GetEndPoint(), kAddrThree);
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    get_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "pong");
+  EXPECT_GE(replica_selector->GetLatencyUs(kAddrThree), 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, LowestLatencyAvoidFailingStore) {
+  std::string key = "d";
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  replica_selector->RecordResult(kAddrOne, 500, false);
+  replica_selector->RecordResult(kAddrTwo, 300, false);
+  // fastest but keeps failing
+  for (int i = 0; i < 5; i++) {
+    replica_selector->RecordResult(kAddrThree, 100, true);
+  }
+  EXPECT_GT(replica_selector->GetErrorRate(kAddrThree), 0.5);
+
+  EndPoint end_point;
+  EXPECT_TRUE(replica_selector->SelectReadReplica(*region, kLowestLatency, end_point));
+  EXPECT_EQ(end_point, kAddrTwo);
+
+  EXPECT_TRUE(replica_selector->SelectHedgeReplica(*region, kAddrTwo, end_point));
+  EXPECT_EQ(end_point, kAddrOne);
+}
+
+TEST_F(SDKStoreRpcControllerTest, HedgedReadFirstAnswerWins) {
+  bool old_hedge = FLAGS_store_rpc_hedge;
+  FLAGS_store_rpc_hedge = true;
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(replica_selector->GetHedgeDelayUs(kAddrThree) < 0, i < 8);
+    replica_selector->RecordResult(kAddrOne, 3000, false);
+    replica_selector->RecordResult(kAddrTwo, 2000, false);
+    replica_selector->RecordResult(kAddrThree, 1000, false);
+  }
+  EXPECT_EQ(replica_selector->GetHedgeDelayUs(kAddrThree), 1000);
+
+  StoreRpcController controller(*stub, rpc, region);
+  controller.SetReplicaReadPolicy(kLowestLatency);
+
+  std::function<void()> primary_cb;
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        // primary never answers before the hedge
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrThree);
+        EXPECT_EQ(dynamic_cast<KvGetRpc*>(&rpc)->Request()->key(), key);
+        primary_cb = std::move(cb);
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrTwo);
+        auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(get_rpc);
+        EXPECT_EQ(get_rpc->Request()->key(), key);
+        get_rpc->MutableResponse()->set_value("hedge");
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "hedge");
+  EXPECT_EQ(rpc.GetEndPoint(), kAddrTwo);
+
+  // late answer of the loser is dropped
+  ASSERT_TRUE(primary_cb);
+  primary_cb();
+  EXPECT_EQ(rpc.Response()->value(), "hedge");
+
+  FLAGS_store_rpc_hedge = old_hedge;
+}
+
+TEST_F(SDKStoreRpcControllerTest, HedgedLeaderReadAfterFixedDelay) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  // explicit delay hedges a leader read even without latency samples and FLAGS_store_rpc_hedge
+  StoreRpcController controller(*stub, rpc, region);
+  controller.SetHedgeDelayUs(1000);
+
+  std::function<void()> primary_cb;
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrOne);
+        primary_cb = std::move(cb);
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_NE(rpc.GetEndPoint(), kAddrOne);
+        auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(get_rpc);
+        get_rpc->MutableResponse()->set_value("backup");
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "backup");
+  EXPECT_NE(rpc.GetEndPoint(), kAddrOne);
+
+  ASSERT_TRUE(primary_cb);
+  primary_cb();
+}
+
+TEST_F(SDKStoreRpcControllerTest, DeadlineExceeded) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(0);
+
+  auto cancel_token = std::make_shared<CancelToken>(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  ScopedCancelToken scope(cancel_token);
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsTimedOut());
+}
+
+TEST_F(SDKStoreRpcControllerTest, DeadlineBoundsRpcTimeout) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    EXPECT_GT(rpc.GetTimeoutMs(), 0);
+    EXPECT_LE(rpc.GetTimeoutMs(), 10000);
+    cb();
+  });
+
+  ScopedCancelToken scope(std::make_shared<CancelToken>(10000));
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+}
+
+TEST_F(SDKStoreRpcControllerTest, RegionBreakerFailFast) {
+  FLAGS_store_rpc_breaker_failures = 3;
+  FLAGS_store_rpc_breaker_open_ms = 60000;
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(3).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    rpc.SetStatus(Status::NetworkError("connect fail"));
+    cb();
+  });
+
+  StoreRpcController controller(*stub, rpc, region);
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsServiceUnavailable());
+  EXPECT_EQ(region_circuit_breaker->GetState(region->RegionId()), RegionCircuitBreaker::kOpen);
+
+  // other requests of the region fail fast without rpc
+  KvGetRpc another;
+  another.MutableRequest()->set_key(key);
+  StoreRpcController another_controller(*stub, another, region);
+  call = another_controller.Call();
+  EXPECT_TRUE(call.IsServiceUnavailable());
+
+  FLAGS_store_rpc_breaker_failures = 0;
+  FLAGS_store_rpc_breaker_open_ms = 1000;
+}
+
+TEST_F(SDKStoreRpcControllerTest, MemoryBudgetHeldUntilCallback) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  int64_t charged = 0;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    charged = memory_budget->UsedBytes();
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    get_rpc->MutableResponse()->set_value(std::string(1024, 'v'));
+    cb();
+  });
+
+  StoreRpcController controller(*stub, rpc, region);
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_GT(charged, 0);
+  EXPECT_EQ(memory_budget->UsedBytes(), 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, MemoryBudgetExhaustedFailFast) {
+  int64_t old_budget_bytes = FLAGS_sdk_memory_budget_bytes;
+  int64_t old_max_wait_ms = FLAGS_sdk_memory_budget_max_wait_ms;
+  FLAGS_sdk_memory_budget_bytes = 16;
+  FLAGS_sdk_memory_budget_max_wait_ms = 0;
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  // held by other calls
+  memory_budget->ForceCharge(16);
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(0);
+
+  StoreRpcController controller(*stub, rpc, region);
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsServiceUnavailable());
+  EXPECT_EQ(memory_budget->UsedBytes(), 16);
+
+  memory_budget->Release(16);
+  FLAGS_sdk_memory_budget_bytes = old_budget_bytes;
+  FLAGS_sdk_memory_budget_max_wait_ms = old_max_wait_ms;
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
@@ -17,9 +17,13 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "common/logging.h"
 #include "gtest/gtest.h"
+#include "sdk/request_priority.h"
 #include "sdk/utils/thread_pool_actuator.h"
 
 namespace dingodb {
@@ -118,5 +122,161 @@ TEST_F(SDKThreadPoolActuatorTest, Schedule) {
   EXPECT_EQ(count.load(), 0);
 }
 
+TEST_F(SDKThreadPoolActuatorTest, ScheduleManyTimers) {
+  bool res = actuator->Start(kThreadNum);
+  EXPECT_TRUE(res);
+
+  // delays cross the first wheel level (256ms) so some timers are cascaded
+  const int kTimerNum = 2000;
+  std::atomic<int> count(kTimerNum);
+  std::atomic<int> early(0);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kTimerNum; i++) {
+    int delay_ms = (i * 7) % 600;
+    actuator->Schedule(
+        [&, delay_ms]() {
+          auto elapsed =
+              std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+          if (elapsed < delay_ms) {
+            early.fetch_add(1);
+          }
+          count.fetch_sub(1);
+        },
+        delay_ms);
+  }
+
+  while (count.load() != 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  EXPECT_EQ(early.load(), 0);
+}
+
+TEST_F(SDKThreadPoolActuatorTest, BatchNeverTakesReservedThread) {
+  // one of the two threads is reserved for interactive tasks
+  bool res = actuator->Start(2);
+  EXPECT_TRUE(res);
+
+  std::atomic<bool> release(false);
+  std::atomic<bool> first_running(false);
+  std::atomic<bool> second_done(false);
+  std::atomic<bool> second_is_batch(false);
+  {
+    ScopedRequestPriority scope(kBatch);
+    actuator->Execute([&]() {
+      first_running.store(true);
+      while (!release.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+    actuator->Execute([&]() {
+      second_is_batch.store(CurrentRequestPriority() == kBatch);
+      second_done.store(true);
+    });
+  }
+  while (!first_running.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::atomic<bool> interactive_done(false);
+  actuator->Execute([&]() { interactive_done.store(true); });
+  while (!interactive_done.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_FALSE(second_done.load());
+
+  release.store(true);
+  while (!second_done.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(second_is_batch.load());
+}
+
+TEST_F(SDKThreadPoolActuatorTest, ScheduleKeepsPriority) {
+  bool res = actuator->Start(kThreadNum);
+  EXPECT_TRUE(res);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> priority(-1);
+  {
+    ScopedRequestPriority scope(kBackground);
+    actuator->Schedule(
+        [&]() {
+          priority.store(CurrentRequestPriority());
+          done.store(true);
+        },
+        1);
+  }
+  EXPECT_EQ(CurrentRequestPriority(), kInteractive);
+
+  while (!done.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(priority.load(), kBackground);
+}
+
+TEST(SDKTimerTest, RunOnTimerThreadWithoutActuator) {
+  Timer timer;
+  EXPECT_TRUE(timer.Start(nullptr));
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::thread::id fired_on;
+  bool done = false;
+  timer.Add(
+      [&]() {
+        std::unique_lock<std::mutex> lk(mutex);
+        fired_on = std::this_thread::get_id();
+        done = true;
+        cv.notify_all();
+      },
+      1);
+
+  std::unique_lock<std::mutex> lk(mutex);
+  cv.wait(lk, [&] { return done; });
+  EXPECT_NE(fired_on, std::this_thread::get_id());
+  lk.unlock();
+  EXPECT_TRUE(timer.Stop());
+}
+
+TEST(SDKTimerTest, EarlierTimerWakesSleepingTimer) {
+  Timer timer;
+  EXPECT_TRUE(timer.Start(nullptr));
+
+  using Clock = std::chrono::steady_clock;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::pair<int, int64_t>> fired;
+  auto start = Clock::now();
+  auto add = [&](int delay_ms) {
+    timer.Add(
+        [&, delay_ms]() {
+          std::unique_lock<std::mutex> lk(mutex);
+          fired.emplace_back(delay_ms,
+                             std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+          cv.notify_all();
+        },
+        delay_ms);
+  };
+
+  // timer thread sleeps until the far timer in an outer wheel, the near timer added later wakes it up
+  add(2000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  add(10);
+  add(300);
+
+  std::unique_lock<std::mutex> lk(mutex);
+  cv.wait(lk, [&] { return fired.size() == 3; });
+  ASSERT_EQ(fired[0].first, 10);
+  EXPECT_GE(fired[0].second, 30);
+  EXPECT_LT(fired[0].second, 500);
+  ASSERT_EQ(fired[1].first, 300);
+  EXPECT_GE(fired[1].second, 320);
+  ASSERT_EQ(fired[2].first, 2000);
+  EXPECT_GE(fired[2].second, 2000);
+  lk.unlock();
+  EXPECT_TRUE(timer.Stop());
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
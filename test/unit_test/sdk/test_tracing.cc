@@ -0,0 +1,134 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/common/tracing.h"
+#include "sdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKTracingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_enable_sdk_tracing = true;
+    FLAGS_sdk_trace_sample_ratio = 1.0;
+    Tracer::Global().TakeSpans();
+  }
+
+  void TearDown() override {
+    FLAGS_enable_sdk_tracing = false;
+    FLAGS_sdk_trace_sample_ratio = 1.0;
+    FLAGS_sdk_trace_max_spans = 10000;
+    Tracer::Global().TakeSpans();
+  }
+};
+
+TEST_F(SDKTracingTest, ParentAndChild) {
+  Span root = Tracer::Global().StartSpan("root", SpanContext());
+  ASSERT_TRUE(root.IsRecording());
+  SpanContext root_context = root.Context();
+  EXPECT_TRUE(root_context.IsValid());
+
+  {
+    ScopedSpanContext scope(root_context);
+    EXPECT_EQ(Tracer::CurrentContext().span_id, root_context.span_id);
+
+    Span child = Tracer::Global().StartChildSpan("child", Tracer::CurrentContext());
+    ASSERT_TRUE(child.IsRecording());
+    child.SetAttribute("region_id", 100);
+    child.SetStatus(Status::NotLeader("mock"));
+  }
+  EXPECT_FALSE(Tracer::CurrentContext().IsValid());
+  root.End();
+  EXPECT_FALSE(root.IsRecording());
+
+  std::vector<SpanData> spans = Tracer::Global().TakeSpans();
+  ASSERT_EQ(spans.size(), 2);
+  // child ends first
+  EXPECT_EQ(spans[0].name, "child");
+  EXPECT_EQ(spans[0].parent_span_id, root_context.span_id);
+  EXPECT_EQ(spans[0].context.trace_id_low, root_context.trace_id_low);
+  EXPECT_EQ(spans[0].context.trace_id_high, root_context.trace_id_high);
+  EXPECT_TRUE(spans[0].error);
+  ASSERT_EQ(spans[0].attributes.size(), 1);
+  EXPECT_EQ(spans[0].attributes[0].second, "100");
+
+  EXPECT_EQ(spans[1].name, "root");
+  EXPECT_EQ(spans[1].parent_span_id, 0);
+  EXPECT_FALSE(spans[1].error);
+  EXPECT_LE(spans[1].start_ns, spans[1].end_ns);
+}
+
+TEST_F(SDKTracingTest, NotRecording) {
+  EXPECT_FALSE(Tracer::Global().StartChildSpan("orphan", SpanContext()).IsRecording());
+
+  FLAGS_sdk_trace_sample_ratio = 0;
+  Span unsampled = Tracer::Global().StartSpan("unsampled", SpanContext());
+  EXPECT_FALSE(unsampled.IsRecording());
+  EXPECT_FALSE(unsampled.Context().IsValid());
+  unsampled.SetAttribute("key", "value");
+  unsampled.End();
+
+  FLAGS_sdk_trace_sample_ratio = 1.0;
+  FLAGS_enable_sdk_tracing = false;
+  EXPECT_FALSE(Tracer::Global().StartSpan("disabled", SpanContext()).IsRecording());
+
+  EXPECT_TRUE(Tracer::Global().TakeSpans().empty());
+}
+
+TEST_F(SDKTracingTest, TraceParent) {
+  SpanContext context;
+  context.trace_id_high = 0x1;
+  context.trace_id_low = 0xab;
+  context.span_id = 0x10;
+  EXPECT_EQ(context.TraceParent(), "00-000000000000000100000000000000ab-0000000000000010-01");
+}
+
+TEST_F(SDKTracingTest, BoundedBuffer) {
+  FLAGS_sdk_trace_max_spans = 2;
+  for (int i = 0; i < 5; i++) {
+    Tracer::Global().StartSpan("span" + std::to_string(i), SpanContext()).End();
+  }
+
+  std::vector<SpanData> spans = Tracer::Global().TakeSpans();
+  ASSERT_EQ(spans.size(), 2);
+  EXPECT_EQ(spans[0].name, "span3");
+  EXPECT_EQ(spans[1].name, "span4");
+}
+
+TEST_F(SDKTracingTest, ExportOtlpJson) {
+  Span span = Tracer::Global().StartSpan("Store.\"Get\"", SpanContext());
+  std::string trace_id = span.Context().TraceIdHex();
+  span.SetStatus(Status::Aborted("mock"));
+  span.End();
+
+  std::string json = Tracer::Global().Export();
+  EXPECT_EQ(json.find(R"({"resourceSpans":[)"), 0);
+  EXPECT_NE(json.find(R"("traceId":")" + trace_id + "\""), std::string::npos);
+  EXPECT_NE(json.find(R"("name":"Store.\"Get\"")"), std::string::npos);
+  EXPECT_NE(json.find(R"("status":{"code":2,)"), std::string::npos);
+  EXPECT_EQ(json.find("parentSpanId"), std::string::npos);
+
+  // spans are taken by export
+  EXPECT_EQ(Tracer::Global().Export().find("traceId"), std::string::npos);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
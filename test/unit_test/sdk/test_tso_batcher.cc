@@ -0,0 +1,119 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "proto/meta.pb.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/tso_batcher.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKTsoBatcherTest : public TestBase {
+ public:
+  void SetUp() override {
+    ON_CALL(*meta_rpc_controller, SyncCall).WillByDefault([&](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<TsoServiceRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      EXPECT_EQ(t_rpc->Request()->op_type(), pb::meta::OP_GEN_TSO);
+      EXPECT_GE(t_rpc->Request()->count(), 1);
+
+      rpc_count.fetch_add(1);
+      auto* ts = t_rpc->MutableResponse()->mutable_start_timestamp();
+      ts->set_physical(100);
+      ts->set_logical(next_logical.fetch_add(t_rpc->Request()->count()));
+      return Status::OK();
+    });
+    EXPECT_CALL(*meta_rpc_controller, SyncCall).Times(testing::AnyNumber());
+  }
+
+  std::atomic<int64_t> rpc_count{0};
+  std::atomic<int64_t> next_logical{0};
+};
+
+TEST_F(SDKTsoBatcherTest, SingleRequest) {
+  TsoBatcher batcher(*stub);
+
+  pb::meta::TsoTimestamp tso;
+  Status s = batcher.GetTso(tso);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(tso.physical(), 100);
+  EXPECT_EQ(tso.logical(), 0);
+
+  auto metrics = batcher.GetMetrics();
+  EXPECT_EQ(metrics.rpc_count, 1);
+  EXPECT_EQ(metrics.tso_count, 1);
+  EXPECT_EQ(metrics.max_batch_size, 1);
+}
+
+TEST_F(SDKTsoBatcherTest, ConcurrentRequestsShareRpc) {
+  int64_t old_wait_us = FLAGS_tso_batch_wait_us;
+  FLAGS_tso_batch_wait_us = 50000;
+
+  TsoBatcher batcher(*stub);
+
+  const int thread_num = 16;
+  std::mutex mutex;
+  std::set<int64_t> timestamps;
+  std::vector<std::thread> threads;
+  threads.reserve(thread_num);
+  for (int i = 0; i < thread_num; i++) {
+    threads.emplace_back([&]() {
+      pb::meta::TsoTimestamp tso;
+      EXPECT_TRUE(batcher.GetTso(tso).ok());
+      std::lock_guard<std::mutex> guard(mutex);
+      timestamps.insert(Tso2Timestamp(tso));
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // every request get a unique timestamp
+  EXPECT_EQ(timestamps.size(), thread_num);
+  EXPECT_LT(rpc_count.load(), thread_num);
+
+  auto metrics = batcher.GetMetrics();
+  EXPECT_EQ(metrics.tso_count, thread_num);
+  EXPECT_EQ(metrics.rpc_count, rpc_count.load());
+  EXPECT_GT(metrics.max_batch_size, 1);
+
+  FLAGS_tso_batch_wait_us = old_wait_us;
+}
+
+TEST_F(SDKTsoBatcherTest, RpcFail) {
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce(testing::Return(Status::NetworkError("mock error")));
+
+  TsoBatcher batcher(*stub);
+
+  pb::meta::TsoTimestamp tso;
+  Status s = batcher.GetTso(tso);
+  EXPECT_TRUE(s.IsNetworkError());
+  EXPECT_EQ(batcher.GetMetrics().rpc_count, 0);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
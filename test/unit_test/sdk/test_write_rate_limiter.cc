@@ -0,0 +1,93 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/write_rate_limiter.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKWriteRateLimiterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_store_write_rate_initial_bytes = 1000;
+    FLAGS_store_write_rate_min_bytes = 100;
+    FLAGS_store_write_rate_max_bytes = 2000;
+    FLAGS_store_write_rate_increase_bytes = 100;
+    FLAGS_store_write_rate_backoff_ratio = 0.5;
+    FLAGS_store_write_rate_burst_ms = 1000;
+  }
+
+  void TearDown() override {
+    FLAGS_store_write_rate_initial_bytes = 32 * 1024 * 1024;
+    FLAGS_store_write_rate_min_bytes = 1024 * 1024;
+    FLAGS_store_write_rate_max_bytes = 1024 * 1024 * 1024;
+    FLAGS_store_write_rate_increase_bytes = 1024 * 1024;
+    FLAGS_store_write_rate_backoff_ratio = 0.7;
+    FLAGS_store_write_rate_burst_ms = 100;
+  }
+
+  WriteRateLimiter limiter;
+};
+
+TEST_F(SDKWriteRateLimiterTest, WaitBeyondBurst) {
+  // a burst of 1s at 1000 bytes per second
+  EXPECT_EQ(limiter.Acquire(1, 0, 600), 0);
+  EXPECT_EQ(limiter.Acquire(1, 0, 400), 0);
+
+  // 500 bytes of debt at 1000 bytes per second
+  int64_t wait_ms = limiter.Acquire(1, 0, 500);
+  EXPECT_GT(wait_ms, 400);
+  EXPECT_LE(wait_ms, 500);
+
+  // other regions have their own bucket
+  EXPECT_EQ(limiter.Acquire(2, 0, 1000), 0);
+  EXPECT_EQ(limiter.GetIndexSnapshot(7).rate, 0);
+}
+
+TEST_F(SDKWriteRateLimiterTest, IndexBucketSharedByRegions) {
+  EXPECT_EQ(limiter.Acquire(1, 7, 600), 0);
+  // the region bucket is fresh, the index one is not
+  EXPECT_GT(limiter.Acquire(2, 7, 600), 0);
+  EXPECT_EQ(limiter.GetIndexSnapshot(7).rate, 1000);
+}
+
+TEST_F(SDKWriteRateLimiterTest, AimdRate) {
+  limiter.Acquire(1, 7, 1);
+
+  limiter.RecordResult(1, 7, false);
+  EXPECT_EQ(limiter.GetRegionSnapshot(1).rate, 1100);
+  EXPECT_EQ(limiter.GetIndexSnapshot(7).rate, 1100);
+
+  limiter.RecordResult(1, 7, true);
+  EXPECT_EQ(limiter.GetRegionSnapshot(1).rate, 550);
+
+  for (int i = 0; i < 10; i++) {
+    limiter.RecordResult(1, 0, true);
+  }
+  EXPECT_EQ(limiter.GetRegionSnapshot(1).rate, 100);
+  // index is not touched without index id
+  EXPECT_EQ(limiter.GetIndexSnapshot(7).rate, 550);
+
+  for (int i = 0; i < 100; i++) {
+    limiter.RecordResult(1, 0, false);
+  }
+  EXPECT_EQ(limiter.GetRegionSnapshot(1).rate, 2000);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
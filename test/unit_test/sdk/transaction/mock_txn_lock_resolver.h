@@ -15,8 +15,10 @@
 #ifndef DINGODB_SDK_TEST_MOCK_TXN_RESOLVER_H_
 #define DINGODB_SDK_TEST_MOCK_TXN_RESOLVER_H_
 
-#include "sdk/client_stub.h"
+#include <vector>
+
 #include "gmock/gmock.h"
+#include "sdk/client_stub.h"
 #include "sdk/status.h"
 #include "sdk/transaction/txn_lock_resolver.h"
 
@@ -30,6 +32,9 @@ class MockTxnLockResolver final : public TxnLockResolver {
   ~MockTxnLockResolver() override = default;
 
   MOCK_METHOD(Status, ResolveLock, (const pb::store::LockInfo& lock_info, int64_t caller_start_ts), (override));
+
+  MOCK_METHOD(Status, ResolveLocks, (const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts),
+              (override));
 };
 
 }  // namespace sdk
@@ -12,9 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "fmt/core.h"
 #include "gtest/gtest.h"
 #include "sdk/transaction/txn_buffer.h"
 
@@ -117,6 +122,116 @@ TEST_F(SDKTxnBufferTest, Range) {
   EXPECT_TRUE(to_check.find("c") != to_check.cend());
 }
 
+TEST_F(SDKTxnBufferTest, BatchPutMove) {
+  std::vector<KVPair> kvs;
+  for (const auto& key : {"b", "c", "d"}) {
+    kvs.push_back({key, std::string(1024, key[0])});
+  }
+  // overwrite and insert before existing keys
+  kvs.push_back({"c", "rc"});
+  kvs.push_back({"a", "ra"});
+
+  Status tmp = txn_buffer->BatchPut(std::move(kvs));
+  EXPECT_TRUE(tmp.ok());
+  EXPECT_TRUE(kvs.empty());  // NOLINT
+
+  EXPECT_EQ(txn_buffer->MutationsSize(), 4);
+  EXPECT_EQ(txn_buffer->GetPrimaryKey(), "b");
+
+  TxnMutation mutation;
+  tmp = txn_buffer->Get("c", mutation);
+  EXPECT_TRUE(tmp.ok());
+  EXPECT_EQ(mutation.type, kPut);
+  EXPECT_EQ(mutation.key, "c");
+  EXPECT_EQ(mutation.value, "rc");
+
+  std::vector<std::string> keys;
+  for (const auto& [key, m] : txn_buffer->Mutations()) {
+    EXPECT_EQ(key, m.key);
+    keys.push_back(key);
+  }
+  EXPECT_EQ(keys, std::vector<std::string>({"a", "b", "c", "d"}));
+}
+
+TEST_F(SDKTxnBufferTest, SpillEveryMutation) {
+  // every mutation is spilled as a run at once
+  TxnBuffer buffer(1, "/tmp");
+  EXPECT_TRUE(buffer.Put("a", "ra").ok());
+  EXPECT_TRUE(buffer.Put("b", "rb").ok());
+  EXPECT_TRUE(buffer.Delete("a").ok());
+  // b exists in spilled run
+  EXPECT_TRUE(buffer.PutIfAbsent("b", "nb").ok());
+  EXPECT_TRUE(buffer.PutIfAbsent("c", "rc").ok());
+  EXPECT_TRUE(buffer.Lock("d").ok());
+  EXPECT_TRUE(buffer.Lock("b").ok());
+
+  EXPECT_TRUE(buffer.HasSpilled());
+  EXPECT_FALSE(buffer.IsEmpty());
+  EXPECT_EQ(buffer.GetPrimaryKey(), "a");
+
+  TxnMutation mutation;
+  EXPECT_TRUE(buffer.Get("a", mutation).ok());
+  EXPECT_EQ(mutation.type, kDelete);
+  EXPECT_TRUE(buffer.Get("b", mutation).ok());
+  EXPECT_EQ(mutation.type, kPut);
+  EXPECT_EQ(mutation.value, "rb");
+  EXPECT_TRUE(buffer.Get("e", mutation).IsNotFound());
+
+  std::vector<TxnMutation> mutations;
+  EXPECT_TRUE(buffer.Range("b", "d", mutations).ok());
+  ASSERT_EQ(mutations.size(), 2);
+  EXPECT_EQ(mutations[0].key, "b");
+  EXPECT_EQ(mutations[1].key, "c");
+  EXPECT_EQ(mutations[1].type, kPutIfAbsent);
+
+  std::vector<std::string> keys;
+  std::vector<TxnMutationType> types;
+  int batch_count = 0;
+  Status s = buffer.ForEachBatch([&](const std::vector<const TxnMutation*>& batch) {
+    batch_count++;
+    for (const auto* m : batch) {
+      keys.push_back(m->key);
+      types.push_back(m->type);
+    }
+    return Status::OK();
+  });
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(batch_count, 4);
+  EXPECT_EQ(keys, std::vector<std::string>({"a", "b", "c", "d"}));
+  EXPECT_EQ(types, std::vector<TxnMutationType>({kDelete, kPut, kPutIfAbsent, kLock}));
+}
+
+TEST_F(SDKTxnBufferTest, SpillOverwriteInMemory) {
+  TxnBuffer buffer(4096, "/tmp");
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(buffer.Put(fmt::format("k{:02}", i), std::string(1024, 'v')).ok());
+  }
+  EXPECT_TRUE(buffer.HasSpilled());
+
+  // newer mutation in memory overwrite the spilled one
+  EXPECT_TRUE(buffer.Put("k01", "new").ok());
+  TxnMutation mutation;
+  EXPECT_TRUE(buffer.Get("k01", mutation).ok());
+  EXPECT_EQ(mutation.value, "new");
+
+  std::vector<TxnMutation> mutations;
+  EXPECT_TRUE(buffer.Range("k00", "k05", mutations).ok());
+  ASSERT_EQ(mutations.size(), 5);
+  EXPECT_EQ(mutations[1].key, "k01");
+  EXPECT_EQ(mutations[1].value, "new");
+
+  std::vector<std::string> keys;
+  Status s = buffer.ForEachBatch([&](const std::vector<const TxnMutation*>& batch) {
+    for (const auto* m : batch) {
+      keys.push_back(m->key);
+    }
+    return Status::OK();
+  });
+  EXPECT_TRUE(s.ok());
+  ASSERT_EQ(keys.size(), 10);
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -12,20 +12,31 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "sdk/client.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "proto//meta.pb.h"
 #include "proto/store.pb.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/status.h"
 #include "sdk/transaction/txn_impl.h"
+#include "sdk/utils/async_util.h"
 #include "test_base.h"
 #include "test_common.h"
 
@@ -58,6 +69,7 @@ class SDKTxnImplTest : public TestBase {
     EXPECT_CALL(*meta_rpc_controller, SyncCall).Times(testing::AnyNumber());
 
     ON_CALL(*txn_lock_resolver, ResolveLock).WillByDefault(testing::Return(Status::OK()));
+    ON_CALL(*txn_lock_resolver, ResolveLocks).WillByDefault(testing::Return(Status::OK()));
   }
 
   TransactionOptions options;
@@ -76,6 +88,18 @@ TEST_F(SDKTxnImplTest, BeginFail) {
   delete txn;
 }
 
+TEST_F(SDKTxnImplTest, BeginHeartbeatIntervalNotLessThanTtl) {
+  int64_t old_interval_ms = FLAGS_txn_heartbeat_interval_ms;
+  FLAGS_txn_heartbeat_interval_ms = FLAGS_txn_heartbeat_lock_ttl_ms;
+
+  Transaction* txn = nullptr;
+  Status s = client->NewTransaction(options, &txn);
+  EXPECT_TRUE(s.IsInvalidArgument()) << s.ToString();
+  delete txn;
+
+  FLAGS_txn_heartbeat_interval_ms = old_interval_ms;
+}
+
 TEST_F(SDKTxnImplTest, BeginSuccess) {
   Transaction* txn;
   EXPECT_TRUE(client->NewTransaction(options, &txn).ok());
@@ -255,6 +279,434 @@ TEST_F(SDKTxnImplTest, BatchGetFromBuffer) {
   }
 }
 
+TEST_F(SDKTxnImplTest, BatchGetSliceFromBuffer) {
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(0);
+
+  auto txn = NewTransactionImpl(options);
+  std::vector<KVPair> kvs = {{"b", "b"}, {"d", "d"}, {"f", "f"}};
+  txn->BatchPut(kvs);
+
+  // keys are views into one buffer
+  std::string buffer = "bdf";
+  std::vector<Slice> keys;
+  for (size_t i = 0; i < buffer.size(); i++) {
+    keys.emplace_back(buffer.data() + i, 1);
+  }
+
+  std::vector<KVPair> tmp;
+  Status s = txn->BatchGet(keys.data(), keys.size(), tmp);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(keys.size(), tmp.size());
+
+  for (const auto& kv : tmp) {
+    EXPECT_EQ(kv.key, kv.value);
+  }
+}
+
+TEST_F(SDKTxnImplTest, BatchGetResolveLocksTogether) {
+  auto txn = NewTransactionImpl(options);
+
+  EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks)
+      .WillOnce([&](const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+        EXPECT_EQ(lock_infos.size(), 2);
+        EXPECT_EQ(caller_start_ts, txn->TEST_GetStartTs());
+        return Status::OK();
+      });
+
+  // b and bb are in one region, d in another
+  std::mutex mutex;
+  std::map<std::string, int> read_count;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+
+    std::lock_guard<std::mutex> guard(mutex);
+    txn_rpc->MutableResponse()->Clear();
+    for (const auto& key : txn_rpc->Request()->keys()) {
+      if (key != "b" && read_count[key]++ == 0) {
+        auto* lock_info = txn_rpc->MutableResponse()->mutable_txn_result()->mutable_locked();
+        lock_info->set_key(key);
+        lock_info->set_primary_lock("a");
+        lock_info->set_lock_ts(txn->TEST_GetStartTs() - 1);
+        continue;
+      }
+      if (key == "b") {
+        read_count[key]++;
+      }
+      auto* kv = txn_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key);
+    }
+    cb();
+  });
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(txn->BatchGet({"b", "bb", "d"}, kvs).ok());
+  EXPECT_EQ(kvs.size(), 3);
+  // b read before the lock of bb is not read again
+  EXPECT_EQ(read_count["b"], 1);
+  EXPECT_EQ(read_count["bb"], 2);
+  EXPECT_EQ(read_count["d"], 2);
+}
+
+TEST_F(SDKTxnImplTest, GetFromReadCache) {
+  auto txn = NewTransactionImpl(options);
+
+  int rpc_count = 0;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+    rpc_count++;
+    if (txn_rpc->Request()->key() == "b") {
+      txn_rpc->MutableResponse()->set_value("pong");
+    }
+    cb();
+  });
+
+  for (int i = 0; i < 2; i++) {
+    std::string value;
+    EXPECT_TRUE(txn->Get("b", value).ok());
+    EXPECT_EQ(value, "pong");
+    EXPECT_TRUE(txn->Get("a", value).IsNotFound());
+  }
+  EXPECT_EQ(rpc_count, 2);
+
+  // buffer is consulted before read cache
+  txn->Put("b", "rb");
+  std::string value;
+  EXPECT_TRUE(txn->Get("b", value).ok());
+  EXPECT_EQ(value, "rb");
+  EXPECT_EQ(rpc_count, 2);
+}
+
+TEST_F(SDKTxnImplTest, BatchGetFromReadCache) {
+  auto txn = NewTransactionImpl(options);
+
+  // sub tasks of regions may run concurrently
+  std::mutex mutex;
+  std::vector<std::string> read_keys;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+    for (const auto& key : txn_rpc->Request()->keys()) {
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        read_keys.push_back(key);
+      }
+      // d is not found
+      if (key != "d") {
+        auto* kv = txn_rpc->MutableResponse()->add_kvs();
+        kv->set_key(key);
+        kv->set_value(key);
+      }
+    }
+    cb();
+  });
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(txn->BatchGet({"b", "d"}, kvs).ok());
+  ASSERT_EQ(kvs.size(), 1);
+  EXPECT_EQ(kvs[0].key, "b");
+
+  kvs.clear();
+  EXPECT_TRUE(txn->BatchGet({"b", "d", "f"}, kvs).ok());
+  EXPECT_EQ(kvs.size(), 2);
+  std::sort(read_keys.begin(), read_keys.end());
+  EXPECT_EQ(read_keys, std::vector<std::string>({"b", "d", "f"}));
+
+  std::string value;
+  EXPECT_TRUE(txn->Get("d", value).IsNotFound());
+  EXPECT_TRUE(txn->Get("f", value).ok());
+  EXPECT_EQ(value, "f");
+  EXPECT_EQ(read_keys.size(), 3);
+}
+
+TEST_F(SDKTxnImplTest, SnapshotGet) {
+  Snapshot* snapshot = nullptr;
+  ASSERT_TRUE(client->NewSnapshot(&snapshot).ok());
+  std::unique_ptr<Snapshot> guard(snapshot);
+  EXPECT_GT(snapshot->GetTimestamp(), 0);
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+    EXPECT_EQ(txn_rpc->Request()->key(), "b");
+    EXPECT_EQ(txn_rpc->Request()->start_ts(), snapshot->GetTimestamp());
+
+    txn_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  std::string value;
+  EXPECT_TRUE(snapshot->Get("b", value).ok());
+  EXPECT_EQ(value, "pong");
+}
+
+TEST_F(SDKTxnImplTest, SnapshotAtGivenTs) {
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).Times(0);
+
+  Snapshot* snapshot = nullptr;
+  EXPECT_FALSE(client->NewSnapshot(0, &snapshot).ok());
+
+  ASSERT_TRUE(client->NewSnapshot(100, &snapshot).ok());
+  std::unique_ptr<Snapshot> guard(snapshot);
+  EXPECT_EQ(snapshot->GetTimestamp(), 100);
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+    EXPECT_EQ(txn_rpc->Request()->start_ts(), 100);
+    for (const auto& key : txn_rpc->Request()->keys()) {
+      auto* kv = txn_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key);
+    }
+    cb();
+  });
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(snapshot->BatchGet({"b", "d", "f"}, kvs).ok());
+  EXPECT_EQ(kvs.size(), 3);
+}
+
+TEST_F(SDKTxnImplTest, SnapshotScanResumeAfterRegionChanged) {
+  std::vector<std::string> keys = {"a1", "a2", "a3", "c1"};
+
+  // the route of region a2c is cleared on the epoch error, the lookup gets the regions again
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillRepeatedly([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+    Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  bool region_changed = false;
+  std::vector<std::string> start_keys;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* scan_rpc = dynamic_cast<TxnScanRpc*>(&rpc);
+    CHECK_NOTNULL(scan_rpc);
+    const auto& range_with_option = scan_rpc->Request()->range();
+    const auto& range = range_with_option.range();
+    start_keys.push_back(range.start_key());
+
+    auto* response = scan_rpc->MutableResponse();
+    if (range.start_key() == "a1" && !range_with_option.with_start() && !region_changed) {
+      region_changed = true;
+      response->mutable_error()->set_errcode(pb::error::EREGION_VERSION);
+      cb();
+      return;
+    }
+
+    // one kv per batch
+    for (const auto& key : keys) {
+      bool after_start = range_with_option.with_start() ? key >= range.start_key() : key > range.start_key();
+      if (after_start && key < range.end_key()) {
+        auto* kv = response->add_kvs();
+        kv->set_key(key);
+        kv->set_value("v" + key);
+        response->set_end_key(key);
+        break;
+      }
+    }
+    cb();
+  });
+
+  int64_t old_delay_ms = FLAGS_txn_op_delay_ms;
+  FLAGS_txn_op_delay_ms = 1;
+
+  Snapshot* tmp = nullptr;
+  ASSERT_TRUE(client->NewSnapshot(&tmp).ok());
+  std::unique_ptr<Snapshot> snapshot(tmp);
+
+  std::vector<KVPair> kvs;
+  Status s = snapshot->Scan("a", "e", 0, kvs);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+
+  // no kv is read twice, the scan goes on right after the last returned key
+  EXPECT_TRUE(region_changed);
+  ASSERT_EQ(kvs.size(), keys.size());
+  for (size_t i = 0; i < kvs.size(); i++) {
+    EXPECT_EQ(kvs[i].key, keys[i]);
+    EXPECT_EQ(kvs[i].value, "v" + keys[i]);
+  }
+  EXPECT_NE(std::find(start_keys.begin(), start_keys.end(), std::string("a1\0", 3)), start_keys.end());
+
+  FLAGS_txn_op_delay_ms = old_delay_ms;
+}
+
+TEST_F(SDKTxnImplTest, PrefetchScanResolveLock) {
+  bool old_prefetch = FLAGS_scan_prefetch;
+  FLAGS_scan_prefetch = true;
+
+  auto txn = NewTransactionImpl(options);
+
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks)
+      .WillOnce([&](const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+        EXPECT_EQ(lock_infos.size(), 1);
+        EXPECT_EQ(caller_start_ts, txn->TEST_GetStartTs());
+        return Status::OK();
+      });
+
+  // every batch is sent async, the first one of b meets a lock
+  std::vector<std::string> keys = {"a1", "a2", "b1", "b2"};
+  std::mutex mutex;
+  bool locked = false;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* scan_rpc = dynamic_cast<TxnScanRpc*>(&rpc);
+    CHECK_NOTNULL(scan_rpc);
+    const auto& range_with_option = scan_rpc->Request()->range();
+    const auto& range = range_with_option.range();
+
+    std::lock_guard<std::mutex> guard(mutex);
+    auto* response = scan_rpc->MutableResponse();
+    response->Clear();
+    for (const auto& key : keys) {
+      bool after_start = range_with_option.with_start() ? key >= range.start_key() : key > range.start_key();
+      if (after_start && key < range.end_key()) {
+        if (key == "b1" && !locked) {
+          locked = true;
+          auto* lock_info = response->mutable_txn_result()->mutable_locked();
+          lock_info->set_key(key);
+          lock_info->set_primary_lock("a");
+          lock_info->set_lock_ts(txn->TEST_GetStartTs() - 1);
+          break;
+        }
+        auto* kv = response->add_kvs();
+        kv->set_key(key);
+        kv->set_value("v" + key);
+        response->set_end_key(key);
+        break;
+      }
+    }
+    cb();
+  });
+
+  std::vector<KVPair> kvs;
+  Status s = txn->Scan("a", "c", 0, kvs, ScanOptions());
+  EXPECT_TRUE(s.ok()) << s.ToString();
+
+  EXPECT_TRUE(locked);
+  ASSERT_EQ(kvs.size(), keys.size());
+  for (size_t i = 0; i < kvs.size(); i++) {
+    EXPECT_EQ(kvs[i].key, keys[i]);
+  }
+
+  FLAGS_scan_prefetch = old_prefetch;
+}
+
+TEST_F(SDKTxnImplTest, StaleSnapshotReuseTso) {
+  int tso_rpc_count = 0;
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<TsoServiceRpc*>(&rpc);
+    tso_rpc_count++;
+    *t_rpc->MutableResponse()->mutable_start_timestamp() = CurrentFakeTso();
+    return Status::OK();
+  });
+
+  Snapshot* first = nullptr;
+  ASSERT_TRUE(client->NewStaleSnapshot(60 * 1000, &first).ok());
+  std::unique_ptr<Snapshot> first_guard(first);
+  EXPECT_EQ(tso_rpc_count, 1);
+
+  // the tso got just now is fresh enough
+  Snapshot* second = nullptr;
+  ASSERT_TRUE(client->NewStaleSnapshot(60 * 1000, &second).ok());
+  std::unique_ptr<Snapshot> second_guard(second);
+  EXPECT_EQ(tso_rpc_count, 1);
+  EXPECT_EQ(first->GetTimestamp(), second->GetTimestamp());
+
+  // strong snapshot always ask tso
+  Snapshot* third = nullptr;
+  ASSERT_TRUE(client->NewSnapshot(&third).ok());
+  std::unique_ptr<Snapshot> third_guard(third);
+  EXPECT_EQ(tso_rpc_count, 2);
+  EXPECT_GT(third->GetTimestamp(), second->GetTimestamp());
+}
+
+TEST_F(SDKTxnImplTest, PessimisticBatchPutLockByRegion) {
+  options.kind = kPessimistic;
+  auto txn = NewTransactionImpl(options);
+
+  std::mutex mutex;
+  std::vector<std::vector<std::string>> lock_rpc_keys;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnPessimisticLockRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+    EXPECT_EQ(txn_rpc->Request()->start_ts(), txn->TEST_GetStartTs());
+    EXPECT_EQ(txn_rpc->Request()->primary_lock(), "b");
+
+    std::vector<std::string> keys;
+    for (const auto& mutation : txn_rpc->Request()->mutations()) {
+      EXPECT_EQ(mutation.op(), pb::store::Op::Lock);
+      keys.push_back(mutation.key());
+    }
+    {
+      std::unique_lock<std::mutex> lk(mutex);
+      lock_rpc_keys.push_back(keys);
+    }
+    cb();
+  });
+
+  std::vector<KVPair> kvs = {{"b", "vb"}, {"c", "vc"}, {"d", "vd"}, {"f", "vf"}};
+  EXPECT_TRUE(txn->BatchPut(kvs).ok());
+  EXPECT_EQ(txn->TEST_GetPrimaryKey(), "b");
+  EXPECT_EQ(txn->TEST_MutationsSize(), 4);
+
+  // primary alone first, then one rpc per region
+  ASSERT_EQ(lock_rpc_keys.size(), 3);
+  EXPECT_EQ(lock_rpc_keys[0], std::vector<std::string>({"b"}));
+  std::sort(lock_rpc_keys.begin() + 1, lock_rpc_keys.end());
+  EXPECT_EQ(lock_rpc_keys[1], std::vector<std::string>({"c", "d"}));
+  EXPECT_EQ(lock_rpc_keys[2], std::vector<std::string>({"f"}));
+
+  // locked keys need no more rpc
+  EXPECT_TRUE(txn->Put("d", "vd2").ok());
+  EXPECT_EQ(lock_rpc_keys.size(), 3);
+}
+
+TEST_F(SDKTxnImplTest, PessimisticLockWaitConflict) {
+  options.kind = kPessimistic;
+  auto txn = NewTransactionImpl(options);
+
+  // the lock of other txn is alive at first
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).WillOnce(testing::Return(Status::TxnLockConflict("alive")));
+
+  std::atomic<int> lock_rpc_count{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnPessimisticLockRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+    EXPECT_TRUE(txn_rpc->Request()->return_values());
+
+    txn_rpc->MutableResponse()->Clear();
+    if (lock_rpc_count.fetch_add(1) == 0) {
+      auto* lock_info = txn_rpc->MutableResponse()->add_txn_result()->mutable_locked();
+      lock_info->set_key("b");
+      lock_info->set_primary_lock("b");
+      lock_info->set_lock_ts(txn->TEST_GetStartTs() - 1);
+    } else {
+      auto* kv = txn_rpc->MutableResponse()->add_kvs();
+      kv->set_key("b");
+      kv->set_value("vb");
+    }
+    cb();
+  });
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(txn->BatchGetForUpdate({"b"}, kvs).ok());
+  EXPECT_EQ(lock_rpc_count.load(), 2);
+  ASSERT_EQ(kvs.size(), 1);
+  EXPECT_EQ(kvs[0].key, "b");
+  EXPECT_EQ(kvs[0].value, "vb");
+}
+
+TEST_F(SDKTxnImplTest, BatchGetForUpdateOptimistic) {
+  auto txn = NewTransactionImpl(options);
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(txn->BatchGetForUpdate({"b"}, kvs).IsNotSupported());
+}
+
 TEST_F(SDKTxnImplTest, BatchOp) {
   std::vector<KVPair> kvs;
   kvs.push_back({"b", "b"});
@@ -384,6 +836,370 @@ TEST_F(SDKTxnImplTest, CommitWithData) {
   EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kCommitted);
 }
 
+TEST_F(SDKTxnImplTest, CommitSecondaryInBackground) {
+  auto txn = NewTransactionImpl(options);
+
+  txn->Put("a", "a");
+  txn->Put("b", "b");
+  txn->Put("d", "d");
+  txn->Put("f", "f");
+
+  std::atomic<int> secondary_commit_keys{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    TxnCommitRpc* txn_rpc = dynamic_cast<TxnCommitRpc*>(&rpc);
+    if (txn_rpc != nullptr && txn_rpc->Request()->keys(0) != txn->TEST_GetPrimaryKey()) {
+      EXPECT_EQ(txn_rpc->Request()->commit_ts(), txn->TEST_GetCommitTs());
+      int count = txn_rpc->Request()->keys_size();
+      cb();
+      // background task is done after callback
+      secondary_commit_keys.fetch_add(count);
+    } else {
+      cb();
+    }
+  });
+
+  bool old_async_commit_secondary = FLAGS_txn_async_commit_secondary;
+  FLAGS_txn_async_commit_secondary = true;
+
+  Status s = txn->PreCommit();
+  EXPECT_TRUE(s.ok());
+
+  s = txn->Commit();
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kCommitted);
+
+  for (int i = 0; i < 100 && secondary_commit_keys.load() < 3; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(secondary_commit_keys.load(), 3);
+
+  FLAGS_txn_async_commit_secondary = old_async_commit_secondary;
+}
+
+TEST_F(SDKTxnImplTest, AsyncGet) {
+  auto txn = NewTransactionImpl(options);
+  txn->Put("a", "local");
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+    EXPECT_EQ(txn_rpc->Request()->key(), "b");
+    EXPECT_EQ(txn_rpc->Request()->start_ts(), txn->TEST_GetStartTs());
+
+    txn_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  {
+    // buffered key is not read from store
+    std::string value;
+    Status got;
+    Synchronizer sync;
+    txn->AsyncGet("a", value, sync.AsStatusCallBack(got));
+    sync.Wait();
+    EXPECT_TRUE(got.ok()) << got.ToString();
+    EXPECT_EQ(value, "local");
+  }
+
+  {
+    std::string value;
+    Status got;
+    Synchronizer sync;
+    txn->AsyncGet("b", value, sync.AsStatusCallBack(got));
+    sync.Wait();
+    EXPECT_TRUE(got.ok()) << got.ToString();
+    EXPECT_EQ(value, "pong");
+  }
+}
+
+TEST_F(SDKTxnImplTest, AsyncCommitWithData) {
+  auto txn = NewTransactionImpl(options);
+
+  txn->Put("a", "a");
+  txn->Put("b", "b");
+  txn->Put("d", "d");
+
+  std::atomic<int> prewrite_keys{0};
+  std::atomic<int> commit_keys{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (auto* prewrite_rpc = dynamic_cast<TxnPrewriteRpc*>(&rpc); prewrite_rpc != nullptr) {
+      EXPECT_EQ(prewrite_rpc->Request()->start_ts(), txn->TEST_GetStartTs());
+      EXPECT_EQ(prewrite_rpc->Request()->primary_lock(), txn->TEST_GetPrimaryKey());
+      prewrite_keys.fetch_add(prewrite_rpc->Request()->mutations_size());
+    } else {
+      auto* commit_rpc = dynamic_cast<TxnCommitRpc*>(&rpc);
+      CHECK_NOTNULL(commit_rpc);
+      EXPECT_EQ(commit_rpc->Request()->commit_ts(), txn->TEST_GetCommitTs());
+      commit_keys.fetch_add(commit_rpc->Request()->keys_size());
+    }
+    cb();
+  });
+
+  Status s;
+  {
+    Synchronizer sync;
+    txn->AsyncPreCommit(sync.AsStatusCallBack(s));
+    sync.Wait();
+  }
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kPreCommitted);
+  EXPECT_EQ(prewrite_keys.load(), 3);
+
+  {
+    Synchronizer sync;
+    txn->AsyncCommit(sync.AsStatusCallBack(s));
+    sync.Wait();
+  }
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kCommitted);
+  EXPECT_EQ(commit_keys.load(), 3);
+}
+
+TEST_F(SDKTxnImplTest, AsyncCommitBeforePreCommit) {
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(0);
+
+  auto txn = NewTransactionImpl(options);
+  txn->Put("a", "a");
+
+  Status s;
+  Synchronizer sync;
+  txn->AsyncCommit(sync.AsStatusCallBack(s));
+  sync.Wait();
+  EXPECT_TRUE(s.IsIllegalState()) << s.ToString();
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kActive);
+}
+
+TEST_F(SDKTxnImplTest, AsyncRollbackWithBusyActuator) {
+  options.pipelined = true;
+  auto txn = NewTransactionImpl(options);
+
+  std::atomic<int> rollback_count{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (dynamic_cast<TxnBatchRollbackRpc*>(&rpc) != nullptr) {
+      rollback_count.fetch_add(1);
+    }
+    cb();
+  });
+
+  EXPECT_TRUE(txn->Put("a", "a").ok());
+  EXPECT_TRUE(txn->Put("d", "d").ok());
+  EXPECT_TRUE(txn->PreCommit().ok());
+
+  // sync rollback of pipelined txn must not wait for a free actuator thread
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool release = false;
+  std::atomic<int> busy{0};
+  for (int i = 0; i < FLAGS_actuator_thread_num; i++) {
+    actuator->Execute([&] {
+      busy.fetch_add(1);
+      std::unique_lock<std::mutex> lk(mutex);
+      cv.wait(lk, [&] { return release; });
+    });
+  }
+  while (busy.load() < FLAGS_actuator_thread_num) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  Status s;
+  Synchronizer sync;
+  txn->AsyncRollback(sync.AsStatusCallBack(s));
+  sync.Wait();
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kRollbackted);
+  EXPECT_EQ(rollback_count.load(), 2);
+
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    release = true;
+  }
+  cv.notify_all();
+}
+
+TEST_F(SDKTxnImplTest, HeartBeatKeepPrimaryLockAlive) {
+  auto txn = NewTransactionImpl(options);
+
+  txn->Put("a", "a");
+  txn->Put("d", "d");
+
+  std::atomic<int> heartbeat_count{0};
+  std::atomic<bool> primary_prewritten{false};
+  // lock ttl follows the tso clock of start_ts, not the wall clock of client
+  int64_t min_ttl = (txn->TEST_GetStartTs() >> kPhysicalShiftBits) + FLAGS_txn_heartbeat_lock_ttl_ms;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (auto* heartbeat_rpc = dynamic_cast<TxnHeartBeatRpc*>(&rpc); heartbeat_rpc != nullptr) {
+      const auto* request = heartbeat_rpc->Request();
+      EXPECT_TRUE(primary_prewritten.load());
+      EXPECT_EQ(request->primary_lock(), txn->TEST_GetPrimaryKey());
+      EXPECT_EQ(request->start_ts(), txn->TEST_GetStartTs());
+      EXPECT_GE(request->advise_lock_ttl(), min_ttl);
+      heartbeat_count.fetch_add(1);
+    } else if (auto* prewrite_rpc = dynamic_cast<TxnPrewriteRpc*>(&rpc); prewrite_rpc != nullptr) {
+      EXPECT_GE(prewrite_rpc->Request()->lock_ttl(), min_ttl);
+      EXPECT_LT(prewrite_rpc->Request()->lock_ttl(), INT64_MAX);
+      for (const auto& mutation : prewrite_rpc->Request()->mutations()) {
+        if (mutation.key() == txn->TEST_GetPrimaryKey()) {
+          primary_prewritten.store(true);
+        }
+      }
+    }
+    cb();
+  });
+
+  int64_t old_interval_ms = FLAGS_txn_heartbeat_interval_ms;
+  FLAGS_txn_heartbeat_interval_ms = 10;
+
+  Status s = txn->PreCommit();
+  EXPECT_TRUE(s.ok());
+
+  for (int i = 0; i < 100 && heartbeat_count.load() < 2; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_GE(heartbeat_count.load(), 2);
+
+  s = txn->Commit();
+  EXPECT_TRUE(s.ok());
+
+  // at most one heartbeat in flight when commit
+  int count = heartbeat_count.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LE(heartbeat_count.load(), count + 1);
+
+  FLAGS_txn_heartbeat_interval_ms = old_interval_ms;
+}
+
+TEST_F(SDKTxnImplTest, SingleRegionFastCommit) {
+  auto txn = NewTransactionImpl(options);
+
+  // a and b are both in region a2c
+  txn->Put("a", "a");
+  txn->Put("b", "b");
+
+  EXPECT_CALL(*store_rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        TxnPrewriteRpc* txn_rpc = dynamic_cast<TxnPrewriteRpc*>(&rpc);
+        CHECK_NOTNULL(txn_rpc);
+        EXPECT_EQ(txn_rpc->Request()->mutations_size(), 2);
+        EXPECT_EQ(txn_rpc->Request()->primary_lock(), txn->TEST_GetPrimaryKey());
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        TxnCommitRpc* txn_rpc = dynamic_cast<TxnCommitRpc*>(&rpc);
+        CHECK_NOTNULL(txn_rpc);
+        EXPECT_EQ(txn_rpc->Request()->keys_size(), 2);
+        EXPECT_EQ(txn_rpc->Request()->commit_ts(), txn->TEST_GetCommitTs());
+        cb();
+      });
+
+  bool old_fast_commit = FLAGS_txn_single_region_fast_commit;
+  FLAGS_txn_single_region_fast_commit = true;
+
+  Status s = txn->PreCommit();
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kPreCommitted);
+
+  s = txn->Commit();
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kCommitted);
+
+  FLAGS_txn_single_region_fast_commit = old_fast_commit;
+}
+
+TEST_F(SDKTxnImplTest, PipelinedPrewriteInBackground) {
+  options.pipelined = true;
+  auto txn = NewTransactionImpl(options);
+
+  std::mutex mutex;
+  std::vector<std::vector<std::string>> prewrites;
+  std::atomic<int> commit_count{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (auto* prewrite_rpc = dynamic_cast<TxnPrewriteRpc*>(&rpc); prewrite_rpc != nullptr) {
+      EXPECT_EQ(prewrite_rpc->Request()->primary_lock(), "a");
+      std::vector<std::string> keys;
+      for (const auto& mutation : prewrite_rpc->Request()->mutations()) {
+        keys.push_back(mutation.key());
+      }
+      std::unique_lock<std::mutex> lk(mutex);
+      prewrites.push_back(keys);
+    } else {
+      CHECK_NOTNULL(dynamic_cast<TxnCommitRpc*>(&rpc));
+      commit_count.fetch_add(1);
+    }
+    cb();
+  });
+
+  int64_t old_flush_bytes = FLAGS_txn_pipelined_flush_bytes;
+  // every write is flushed
+  FLAGS_txn_pipelined_flush_bytes = 1;
+
+  // a and b are in region a2c, d in region c2e
+  EXPECT_TRUE(txn->Put("a", "a").ok());
+  EXPECT_TRUE(txn->BatchPut({{"b", "b"}, {"d", "d"}}).ok());
+
+  FLAGS_txn_pipelined_flush_bytes = old_flush_bytes;
+  EXPECT_TRUE(txn->Put("c", "c").ok());
+
+  Status s = txn->PreCommit();
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kPreCommitted);
+
+  // primary key is flushed alone first, the unflushed c is prewritten by PreCommit
+  ASSERT_EQ(prewrites.size(), 4);
+  EXPECT_EQ(prewrites[0], std::vector<std::string>({"a"}));
+  std::sort(prewrites.begin() + 1, prewrites.begin() + 3);
+  EXPECT_EQ(prewrites[1], std::vector<std::string>({"b"}));
+  EXPECT_EQ(prewrites[2], std::vector<std::string>({"d"}));
+  EXPECT_EQ(prewrites[3], std::vector<std::string>({"c"}));
+
+  s = txn->Commit();
+  EXPECT_TRUE(s.ok());
+  // primary key, then secondary keys of region a2c and c2e
+  EXPECT_EQ(commit_count.load(), 3);
+}
+
+TEST_F(SDKTxnImplTest, PipelinedWriteFlushedKey) {
+  options.pipelined = true;
+  auto txn = NewTransactionImpl(options);
+
+  std::mutex mutex;
+  std::map<std::string, std::string> prewritten;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    if (auto* prewrite_rpc = dynamic_cast<TxnPrewriteRpc*>(&rpc); prewrite_rpc != nullptr) {
+      std::unique_lock<std::mutex> lk(mutex);
+      for (const auto& mutation : prewrite_rpc->Request()->mutations()) {
+        // same start_ts prewrite of a key again does not replace its lock
+        EXPECT_EQ(prewritten.count(mutation.key()), 0) << mutation.key();
+        prewritten[mutation.key()] = mutation.value();
+      }
+    }
+    cb();
+  });
+
+  int64_t old_flush_bytes = FLAGS_txn_pipelined_flush_bytes;
+  FLAGS_txn_pipelined_flush_bytes = 1;
+  EXPECT_TRUE(txn->Put("a", "a").ok());
+  EXPECT_TRUE(txn->Put("b", "b").ok());
+  FLAGS_txn_pipelined_flush_bytes = old_flush_bytes;
+
+  // unflushed c can be overwritten, flushed a and b can't
+  EXPECT_TRUE(txn->Put("c", "c1").ok());
+  EXPECT_TRUE(txn->Put("c", "c2").ok());
+  EXPECT_TRUE(txn->Put("a", "a2").IsNotSupported());
+  EXPECT_TRUE(txn->BatchPut({{"d", "d"}, {"b", "b2"}}).IsNotSupported());
+  EXPECT_TRUE(txn->Delete("b").IsNotSupported());
+
+  EXPECT_TRUE(txn->PreCommit().ok());
+  std::map<std::string, std::string> expected = {{"a", "a"}, {"b", "b"}, {"c", "c2"}};
+  EXPECT_EQ(prewritten, expected);
+}
+
+TEST_F(SDKTxnImplTest, PipelinedPessimistic) {
+  options.kind = kPessimistic;
+  options.pipelined = true;
+  Transaction::TxnImpl txn(*stub, options);
+  EXPECT_TRUE(txn.Begin().IsInvalidArgument());
+}
+
 TEST_F(SDKTxnImplTest, PrimaryKeyLockConflict) {
   auto txn = NewTransactionImpl(options);
 
@@ -446,9 +1262,10 @@ TEST_F(SDKTxnImplTest, PrimaryKeyLockConflict) {
         cb();
       });
 
-  EXPECT_CALL(*txn_lock_resolver, ResolveLock)
-      .WillOnce([&](const pb::store::LockInfo& lock_info, int64_t caller_start_ts) {
-        EXPECT_TRUE(LockInfoEqual(lock_info, mock_lock));
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks)
+      .WillOnce([&](const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+        EXPECT_EQ(lock_infos.size(), 1);
+        EXPECT_TRUE(LockInfoEqual(lock_infos[0], mock_lock));
         EXPECT_EQ(caller_start_ts, txn->TEST_GetStartTs());
         return Status::OK();
       });
@@ -502,9 +1319,10 @@ TEST_F(SDKTxnImplTest, PrimaryKeyLockConflictExceed) {
     cb();
   });
 
-  EXPECT_CALL(*txn_lock_resolver, ResolveLock)
-      .WillRepeatedly([&](const pb::store::LockInfo& lock_info, int64_t caller_start_ts) {
-        EXPECT_TRUE(LockInfoEqual(lock_info, mock_lock));
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks)
+      .WillRepeatedly([&](const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+        EXPECT_EQ(lock_infos.size(), 1);
+        EXPECT_TRUE(LockInfoEqual(lock_infos[0], mock_lock));
         EXPECT_EQ(caller_start_ts, txn->TEST_GetStartTs());
         return Status::TxnLockConflict("");
       });
@@ -618,7 +1436,7 @@ TEST_F(SDKTxnImplTest, PreWriteSecondLockConflict) {
         cb();
       });
 
-  EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(testing::AnyNumber());
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(testing::AnyNumber());
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.IsTxnLockConflict());
@@ -0,0 +1,90 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "mock_region_scanner.h"
+#include "sdk/region_scan_iterator.h"
+#include "sdk/status.h"
+#include "sdk/transaction/txn_buffer.h"
+#include "sdk/transaction/txn_kv_iterator.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKTxnKvIteratorTest : public TestBase {
+ public:
+  void SetUp() override {
+    TestBase::SetUp();
+
+    // store has a001 b001 b002 in region a2c
+    EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+        .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+          auto mock_scanner =
+              std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+          iter = 0;
+
+          EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([&](StatusCallback cb) { cb(Status::OK()); });
+
+          EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([&]() { return iter < fake_datas.size(); });
+
+          EXPECT_CALL(*mock_scanner, AsyncNextBatch).WillRepeatedly([&](std::vector<KVPair>& kvs, StatusCallback cb) {
+            if (iter < fake_datas.size()) {
+              kvs.push_back({fake_datas[iter], "store"});
+              iter++;
+            }
+            cb(Status::OK());
+          });
+
+          scanner = std::move(mock_scanner);
+          return Status::OK();
+        });
+  }
+
+  std::vector<std::string> fake_datas = {"a001", "b001", "b002"};
+  size_t iter = 0;
+};
+
+TEST_F(SDKTxnKvIteratorTest, MergeMutations) {
+  std::vector<TxnMutation> mutations;
+  mutations.push_back(TxnMutation::PutMutation("a000", "local"));
+  mutations.push_back(TxnMutation::DeleteMutation("a001"));
+  mutations.push_back(TxnMutation::PutIfAbsentMutation("b001", "local"));
+  mutations.push_back(TxnMutation::PutMutation("b002", "local"));
+  mutations.push_back(TxnMutation::PutIfAbsentMutation("b003", "local"));
+
+  auto remote_iter = std::make_unique<RegionScanIterator>(*stub, "a", "c");
+  TxnKvIterator txn_iter(std::move(remote_iter), std::move(mutations));
+  Status s = txn_iter.Seek("a");
+  EXPECT_TRUE(s.ok());
+
+  std::vector<std::pair<std::string, std::string>> got;
+  for (; txn_iter.Valid(); txn_iter.Next()) {
+    got.emplace_back(txn_iter.key(), txn_iter.value());
+  }
+  EXPECT_TRUE(txn_iter.status().ok());
+
+  std::vector<std::pair<std::string, std::string>> expected = {
+      {"a000", "local"}, {"b001", "store"}, {"b002", "local"}, {"b003", "local"}};
+  EXPECT_EQ(got, expected);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -12,7 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "sdk/common/common.h"
@@ -489,6 +494,147 @@ TEST_F(SDKTxnLockResolverTest, Rollbacked) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_F(SDKTxnLockResolverTest, CommittedTxnStatusCached) {
+  std::string key = "b";
+  auto fake_lock = PrepareLockInfo();
+  fake_lock.set_key(key);
+
+  auto fake_tso = CurrentFakeTso();
+
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<TsoServiceRpc*>(&rpc);
+    auto* ts = t_rpc->MutableResponse()->mutable_start_timestamp();
+    *ts = fake_tso;
+
+    return Status::OK();
+  });
+
+  int check_count = 0;
+  int resolve_count = 0;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* check_rpc = dynamic_cast<TxnCheckTxnStatusRpc*>(&rpc);
+    if (check_rpc != nullptr) {
+      check_count++;
+      check_rpc->MutableResponse()->set_commit_ts(check_rpc->Request()->current_ts());
+    } else {
+      auto* resolve_rpc = dynamic_cast<TxnResolveLockRpc*>(&rpc);
+      CHECK_NOTNULL(resolve_rpc);
+      EXPECT_EQ(resolve_rpc->Request()->commit_ts(), Tso2Timestamp(fake_tso));
+      resolve_count++;
+    }
+
+    cb();
+  });
+
+  EXPECT_TRUE(lock_resolver->ResolveLock(fake_lock, Tso2Timestamp(init_tso)).ok());
+
+  // another lock of same txn, txn status is from cache
+  fake_lock.set_key("b1");
+  EXPECT_TRUE(lock_resolver->ResolveLock(fake_lock, Tso2Timestamp(init_tso)).ok());
+
+  EXPECT_EQ(check_count, 1);
+  EXPECT_EQ(resolve_count, 4);
+}
+
+TEST_F(SDKTxnLockResolverTest, ResolveLocksGroupByRegion) {
+  // primary key a0000000 and b in region a2c, c1 and d in region c2e
+  std::vector<pb::store::LockInfo> locks;
+  for (const auto& key : {"b", "c1", "d", "a0000000"}) {
+    auto fake_lock = PrepareLockInfo();
+    fake_lock.set_key(key);
+    locks.push_back(fake_lock);
+  }
+
+  auto fake_tso = CurrentFakeTso();
+
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<TsoServiceRpc*>(&rpc);
+    auto* ts = t_rpc->MutableResponse()->mutable_start_timestamp();
+    *ts = fake_tso;
+
+    return Status::OK();
+  });
+
+  std::mutex mutex;
+  int check_count = 0;
+  std::vector<std::set<std::string>> resolved_keys;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* check_rpc = dynamic_cast<TxnCheckTxnStatusRpc*>(&rpc);
+    if (check_rpc != nullptr) {
+      check_count++;
+      check_rpc->MutableResponse()->set_commit_ts(check_rpc->Request()->current_ts());
+    } else {
+      auto* resolve_rpc = dynamic_cast<TxnResolveLockRpc*>(&rpc);
+      CHECK_NOTNULL(resolve_rpc);
+      const auto* request = resolve_rpc->Request();
+      EXPECT_EQ(request->start_ts(), 1);
+      EXPECT_EQ(request->commit_ts(), Tso2Timestamp(fake_tso));
+
+      std::lock_guard<std::mutex> guard(mutex);
+      resolved_keys.emplace_back(request->keys().begin(), request->keys().end());
+    }
+
+    cb();
+  });
+
+  Status s = lock_resolver->ResolveLocks(locks, Tso2Timestamp(init_tso));
+  EXPECT_TRUE(s.ok());
+
+  EXPECT_EQ(check_count, 1);
+  ASSERT_EQ(resolved_keys.size(), 3);
+  // primary key first
+  EXPECT_EQ(resolved_keys[0], std::set<std::string>({"a0000000"}));
+  std::set<std::set<std::string>> secondary(resolved_keys.begin() + 1, resolved_keys.end());
+  EXPECT_EQ(secondary, std::set<std::set<std::string>>({{"b"}, {"c1", "d"}}));
+}
+
+TEST_F(SDKTxnLockResolverTest, ResolveLocksTxnLocked) {
+  std::vector<pb::store::LockInfo> locks;
+  for (const auto& key : {"b", "d"}) {
+    auto fake_lock = PrepareLockInfo();
+    fake_lock.set_key(key);
+    locks.push_back(fake_lock);
+  }
+
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<TsoServiceRpc*>(&rpc);
+    auto* ts = t_rpc->MutableResponse()->mutable_start_timestamp();
+    *ts = CurrentFakeTso();
+
+    return Status::OK();
+  });
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* check_rpc = dynamic_cast<TxnCheckTxnStatusRpc*>(&rpc);
+    CHECK_NOTNULL(check_rpc);
+    check_rpc->MutableResponse()->set_lock_ttl(10);
+
+    cb();
+  });
+
+  Status s = lock_resolver->ResolveLocks(locks, Tso2Timestamp(init_tso));
+  EXPECT_TRUE(s.IsTxnLockConflict());
+}
+
+TEST(SDKTxnStatusCacheTest, EvictLeastRecentlyUsed) {
+  TxnStatusCache cache(2);
+
+  cache.Put(1, TxnStatus(0, 10));
+  cache.Put(2, TxnStatus(0, 0));
+
+  TxnStatus txn_status;
+  EXPECT_TRUE(cache.Get(1, txn_status));
+  EXPECT_TRUE(txn_status.IsCommitted());
+
+  // 2 is least recently used
+  cache.Put(3, TxnStatus(0, 30));
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_FALSE(cache.Get(2, txn_status));
+  EXPECT_TRUE(cache.Get(1, txn_status));
+  EXPECT_TRUE(cache.Get(3, txn_status));
+  EXPECT_EQ(txn_status.commit_ts, 30);
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -0,0 +1,161 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/transaction/txn_lock_sweeper.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const int64_t kSafePointTs = 100;
+
+class SDKTxnLockSweeperTest : public TestBase {
+ public:
+  SDKTxnLockSweeperTest() = default;
+  ~SDKTxnLockSweeperTest() override = default;
+
+  void SetUp() override {
+    TestBase::SetUp();
+
+    EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillRepeatedly([&](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+      Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+      return Status::OK();
+    });
+  }
+
+  static pb::store::LockInfo StaleLock(const std::string& key) {
+    auto lock_info = PrepareLockInfo();
+    lock_info.set_key(key);
+    return lock_info;
+  }
+};
+
+TEST_F(SDKTxnLockSweeperTest, SweepRegionsByBatch) {
+  int64_t old_batch_size = FLAGS_txn_lock_sweep_batch_size;
+  FLAGS_txn_lock_sweep_batch_size = 2;
+
+  // region a-c has 3 locks, so it is scanned by 2 batches, region c-e has 1 lock
+  std::mutex mutex;
+  std::vector<std::string> scan_starts;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* scan_rpc = dynamic_cast<TxnScanLockRpc*>(&rpc);
+    CHECK_NOTNULL(scan_rpc);
+    const auto* request = scan_rpc->Request();
+    EXPECT_EQ(request->max_ts(), kSafePointTs);
+    EXPECT_EQ(request->limit(), 2);
+
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      scan_starts.push_back(request->start_key());
+    }
+
+    std::vector<std::string> keys;
+    if (request->start_key() == "b") {
+      EXPECT_EQ(request->end_key(), "c");
+      keys = {"b1", "b2"};
+    } else if (request->start_key() == std::string("b2") + '\0') {
+      keys = {"b3"};
+    } else if (request->start_key() == "c") {
+      EXPECT_EQ(request->end_key(), "d");
+      keys = {"c1"};
+    } else {
+      ADD_FAILURE() << "unexpected scan start:" << request->start_key();
+    }
+
+    for (const auto& key : keys) {
+      *scan_rpc->MutableResponse()->add_locks() = StaleLock(key);
+    }
+    cb();
+  });
+
+  std::atomic<int64_t> resolved{0};
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks)
+      .WillRepeatedly([&](const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+        EXPECT_EQ(caller_start_ts, kSafePointTs);
+        resolved.fetch_add(lock_infos.size());
+        return Status::OK();
+      });
+
+  std::atomic<int64_t> progress_calls{0};
+  int64_t lock_count = 0;
+  Status s = client->ResolveStaleLocks("b", "d", kSafePointTs, lock_count,
+                                       [&](int64_t, int64_t done_regions, int64_t total_regions) {
+                                         EXPECT_EQ(total_regions, 2);
+                                         EXPECT_LE(done_regions, total_regions);
+                                         progress_calls.fetch_add(1);
+                                       });
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(lock_count, 4);
+  EXPECT_EQ(resolved.load(), 4);
+  EXPECT_EQ(progress_calls.load(), 2);
+  EXPECT_EQ(scan_starts.size(), 3);
+
+  FLAGS_txn_lock_sweep_batch_size = old_batch_size;
+}
+
+TEST_F(SDKTxnLockSweeperTest, AliveLockIsSkipped) {
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* scan_rpc = dynamic_cast<TxnScanLockRpc*>(&rpc);
+    CHECK_NOTNULL(scan_rpc);
+    *scan_rpc->MutableResponse()->add_locks() = StaleLock(scan_rpc->Request()->start_key());
+    cb();
+  });
+
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).WillRepeatedly(testing::Return(Status::TxnLockConflict("alive")));
+
+  int64_t lock_count = 0;
+  Status s = client->ResolveStaleLocks("b", "d", kSafePointTs, lock_count);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(lock_count, 2);
+}
+
+TEST_F(SDKTxnLockSweeperTest, ResolveFail) {
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* scan_rpc = dynamic_cast<TxnScanLockRpc*>(&rpc);
+    CHECK_NOTNULL(scan_rpc);
+    *scan_rpc->MutableResponse()->add_locks() = StaleLock(scan_rpc->Request()->start_key());
+    cb();
+  });
+
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).WillRepeatedly(testing::Return(Status::NetworkError("mock error")));
+
+  int64_t lock_count = 0;
+  Status s = client->ResolveStaleLocks("b", "d", kSafePointTs, lock_count);
+  EXPECT_TRUE(s.IsNetworkError()) << s.ToString();
+}
+
+TEST_F(SDKTxnLockSweeperTest, InvalidArgument) {
+  int64_t lock_count = 0;
+  EXPECT_TRUE(client->ResolveStaleLocks("d", "b", kSafePointTs, lock_count).IsInvalidArgument());
+  EXPECT_TRUE(client->ResolveStaleLocks("b", "d", 0, lock_count).IsInvalidArgument());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,108 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/client.h"
+#include "sdk/transaction/txn_buffer.h"
+#include "sdk/transaction/txn_scan_merger.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKTxnScanMergerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    // store rows are b c e g, put if absent e takes no effect as e exists in store
+    EXPECT_TRUE(buffer.Put("a", "la").ok());
+    EXPECT_TRUE(buffer.Put("b", "lb").ok());
+    EXPECT_TRUE(buffer.Delete("c").ok());
+    EXPECT_TRUE(buffer.PutIfAbsent("d", "ld").ok());
+    EXPECT_TRUE(buffer.PutIfAbsent("e", "le").ok());
+    EXPECT_TRUE(buffer.Put("h", "lh").ok());
+    // out of range
+    EXPECT_TRUE(buffer.Put("z", "lz").ok());
+  }
+
+  static std::vector<KVPair> Batch(const std::vector<std::string>& keys) {
+    std::vector<KVPair> kvs;
+    for (const auto& key : keys) {
+      kvs.push_back({key, "r" + key});
+    }
+    return kvs;
+  }
+
+  TxnBuffer buffer;
+};
+
+TEST_F(SDKTxnScanMergerTest, MergeBatches) {
+  std::vector<KVPair> out;
+  TxnScanMerger merger(&buffer, "a", "y", ScanOptions(), 0, out);
+
+  auto batch = Batch({"b", "c"});
+  merger.AddBatch(batch);
+  // d is only emitted once a store row after it is seen
+  ASSERT_EQ(out.size(), 2);
+
+  batch = Batch({"e", "g"});
+  merger.AddBatch(batch);
+  merger.Finish();
+
+  std::vector<KVPair> expected = {{"a", "la"}, {"b", "lb"}, {"d", "ld"}, {"e", "re"}, {"g", "rg"}, {"h", "lh"}};
+  ASSERT_EQ(out.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(out[i].key, expected[i].key);
+    EXPECT_EQ(out[i].value, expected[i].value);
+  }
+}
+
+TEST_F(SDKTxnScanMergerTest, Limit) {
+  std::vector<KVPair> out;
+  TxnScanMerger merger(&buffer, "a", "y", ScanOptions(), 3, out);
+
+  auto batch = Batch({"b", "c", "e", "g"});
+  merger.AddBatch(batch);
+  EXPECT_TRUE(merger.ReachLimit());
+  merger.Finish();
+
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_EQ(out[0].key, "a");
+  EXPECT_EQ(out[1].key, "b");
+  EXPECT_EQ(out[2].key, "d");
+}
+
+TEST_F(SDKTxnScanMergerTest, KeyOnly) {
+  std::vector<KVPair> out;
+  ScanOptions scan_options;
+  scan_options.key_only = true;
+  TxnScanMerger merger(&buffer, "a", "c", scan_options, 0, out);
+
+  auto batch = Batch({"b"});
+  for (auto& kv : batch) {
+    kv.value.clear();
+  }
+  merger.AddBatch(batch);
+  merger.Finish();
+
+  ASSERT_EQ(out.size(), 2);
+  EXPECT_EQ(out[0].key, "a");
+  EXPECT_TRUE(out[0].value.empty());
+  EXPECT_EQ(out[1].key, "b");
+  EXPECT_TRUE(out[1].value.empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,196 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/client.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/store_rpc.h"
+#include "sdk/transaction/txn_snapshot_exporter.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const int64_t kSnapshotTs = 100;
+
+class SDKTxnSnapshotExporterTest : public TestBase {
+ public:
+  SDKTxnSnapshotExporterTest() = default;
+  ~SDKTxnSnapshotExporterTest() override = default;
+
+  void SetUp() override {
+    TestBase::SetUp();
+
+    for (char prefix : {'a', 'b', 'c', 'd'}) {
+      for (int i = 0; i < 8; i++) {
+        keys.push_back(std::string(1, prefix) + std::to_string(i));
+      }
+    }
+
+    EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillRepeatedly([&](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      Region2ScanRegionInfo(RegionA2C(), t_rpc->MutableResponse()->add_regions());
+      Region2ScanRegionInfo(RegionC2E(), t_rpc->MutableResponse()->add_regions());
+      return Status::OK();
+    });
+
+    // at most 2 kvs per batch, so parts have many batches and idle workers split them
+    EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+      auto* scan_rpc = dynamic_cast<TxnScanRpc*>(&rpc);
+      CHECK_NOTNULL(scan_rpc);
+      const auto* request = scan_rpc->Request();
+      EXPECT_EQ(request->start_ts(), kSnapshotTs);
+      const auto& range = request->range().range();
+
+      auto* response = scan_rpc->MutableResponse();
+      if (change_region_at == range.start_key()) {
+        change_region_at.clear();
+        response->mutable_error()->set_errcode(pb::error::EREGION_VERSION);
+        cb();
+        return;
+      }
+
+      for (const auto& key : keys) {
+        bool after_start = request->range().with_start() ? key >= range.start_key() : key > range.start_key();
+        if (after_start && key < range.end_key() && response->kvs_size() < 2) {
+          auto* kv = response->add_kvs();
+          kv->set_key(key);
+          kv->set_value("v" + key);
+        }
+      }
+      if (response->kvs_size() > 0) {
+        response->set_end_key(response->kvs(response->kvs_size() - 1).key());
+      }
+      cb();
+    });
+
+    Snapshot* tmp = nullptr;
+    CHECK(client->NewSnapshot(kSnapshotTs, &tmp).ok());
+    snapshot.reset(tmp);
+  }
+
+  std::vector<std::string> keys;
+  std::unique_ptr<Snapshot> snapshot;
+  // scan rpc from this key fails once as the region changed
+  std::string change_region_at;
+};
+
+TEST_F(SDKTxnSnapshotExporterTest, MiddleKey) {
+  EXPECT_EQ(MiddleKey("a", "c"), "b");
+  EXPECT_EQ(MiddleKey("a", "b"), std::string("a\x80"));
+  EXPECT_EQ(MiddleKey("a", std::string("a\x01")), std::string("a\x00\x80", 3));
+
+  std::string middle = MiddleKey("abc", "abd");
+  EXPECT_GT(middle, "abc");
+  EXPECT_LT(middle, "abd");
+
+  // no key in between
+  EXPECT_EQ(MiddleKey("a", "a"), "");
+}
+
+TEST_F(SDKTxnSnapshotExporterTest, Ordered) {
+  std::vector<ExportRange> ranges = {{"a", "c"}, {"c", "e"}};
+  ExportOptions options;
+  options.ordered = true;
+  options.parallelism = 4;
+
+  std::vector<std::string> exported;
+  std::vector<size_t> range_indexes;
+  Status s = snapshot->Export(ranges, options, [&](size_t range_index, std::vector<KVPair>& kvs) {
+    for (const auto& kv : kvs) {
+      EXPECT_EQ(kv.value, "v" + kv.key);
+      exported.push_back(kv.key);
+      range_indexes.push_back(range_index);
+    }
+    return Status::OK();
+  });
+
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(exported, keys);
+  for (size_t i = 0; i < exported.size(); i++) {
+    EXPECT_EQ(range_indexes[i], exported[i] < "c" ? 0 : 1);
+  }
+}
+
+TEST_F(SDKTxnSnapshotExporterTest, Unordered) {
+  std::vector<ExportRange> ranges = {{"a", "e"}};
+  ExportOptions options;
+  options.parallelism = 8;
+  options.key_only = true;
+
+  std::vector<std::string> exported;
+  Status s = snapshot->Export(ranges, options, [&](size_t range_index, std::vector<KVPair>& kvs) {
+    EXPECT_EQ(range_index, 0);
+    EXPECT_TRUE(std::is_sorted(kvs.begin(), kvs.end(), [](const auto& a, const auto& b) { return a.key < b.key; }));
+    for (const auto& kv : kvs) {
+      EXPECT_TRUE(kv.value.empty());
+      exported.push_back(kv.key);
+    }
+    return Status::OK();
+  });
+
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  std::sort(exported.begin(), exported.end());
+  EXPECT_EQ(exported, keys);
+}
+
+TEST_F(SDKTxnSnapshotExporterTest, ResumeAfterRegionChanged) {
+  change_region_at = "a1";
+  std::vector<ExportRange> ranges = {{"a", "e"}};
+  ExportOptions options;
+  options.ordered = true;
+  options.parallelism = 1;
+
+  std::vector<std::string> exported;
+  Status s = snapshot->Export(ranges, options, [&](size_t, std::vector<KVPair>& kvs) {
+    for (const auto& kv : kvs) {
+      exported.push_back(kv.key);
+    }
+    return Status::OK();
+  });
+
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_TRUE(change_region_at.empty());
+  // no kv is exported twice
+  EXPECT_EQ(exported, keys);
+}
+
+TEST_F(SDKTxnSnapshotExporterTest, StopByCallback) {
+  std::vector<ExportRange> ranges = {{"a", "e"}};
+  ExportOptions options;
+  options.parallelism = 2;
+
+  Status s = snapshot->Export(ranges, options, [&](size_t, std::vector<KVPair>&) {
+    return Status::Aborted("disk full");
+  });
+  EXPECT_TRUE(s.IsAborted()) << s.ToString();
+}
+
+TEST_F(SDKTxnSnapshotExporterTest, InvalidRange) {
+  std::vector<ExportRange> ranges = {{"c", "a"}};
+  Status s = snapshot->Export(ranges, ExportOptions(), [&](size_t, std::vector<KVPair>&) { return Status::OK(); });
+  EXPECT_TRUE(s.IsInvalidArgument()) << s.ToString();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,111 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "sdk/status.h"
+#include "sdk/utils/aggregate_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKAggregateCacheTest, Disabled) {
+  AggregateCache<int64_t> cache(0);
+
+  int loads = 0;
+  auto load = [&loads](int64_t& result) {
+    result = ++loads;
+    return Status::OK();
+  };
+
+  int64_t result = 0;
+  EXPECT_TRUE(cache.Get(1, 1000, load, result).ok());
+  EXPECT_TRUE(cache.Get(1, 1000, load, result).ok());
+  EXPECT_EQ(result, 2);
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST(SDKAggregateCacheTest, Staleness) {
+  AggregateCache<int64_t> cache(60 * 1000);
+
+  int loads = 0;
+  auto load = [&loads](int64_t& result) {
+    result = ++loads;
+    return Status::OK();
+  };
+
+  int64_t result = 0;
+  EXPECT_TRUE(cache.Get(1, 1000, load, result).ok());
+  EXPECT_TRUE(cache.Get(1, 1000, load, result).ok());
+  EXPECT_EQ(result, 1);
+
+  // other index is loaded by itself
+  EXPECT_TRUE(cache.Get(2, 1000, load, result).ok());
+  EXPECT_EQ(result, 2);
+
+  // 0 always loads, the result is served to later callers
+  EXPECT_TRUE(cache.Get(1, 0, load, result).ok());
+  EXPECT_EQ(result, 3);
+  EXPECT_TRUE(cache.Get(1, 1000, load, result).ok());
+  EXPECT_EQ(result, 3);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_TRUE(cache.Get(1, 10, load, result).ok());
+  EXPECT_EQ(result, 4);
+}
+
+TEST(SDKAggregateCacheTest, LoadFail) {
+  AggregateCache<int64_t> cache(60 * 1000);
+
+  int64_t result = 0;
+  Status s = cache.Get(
+      1, 1000, [](int64_t& /*result*/) { return Status::NetworkError("fail"); }, result);
+  EXPECT_TRUE(s.IsNetworkError());
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST(SDKAggregateCacheTest, ConcurrentShareOneLoad) {
+  AggregateCache<int64_t> cache(60 * 1000);
+
+  std::atomic<int> loads{0};
+  auto load = [&loads](int64_t& result) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    result = loads.fetch_add(1) + 100;
+    return Status::OK();
+  };
+
+  std::vector<int64_t> results(8, 0);
+  std::vector<std::thread> threads;
+  threads.reserve(results.size());
+  for (auto& result : results) {
+    threads.emplace_back([&cache, &load, &result] { EXPECT_TRUE(cache.Get(1, 1000, load, result).ok()); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(loads.load(), 1);
+  for (const auto& result : results) {
+    EXPECT_EQ(result, 100);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
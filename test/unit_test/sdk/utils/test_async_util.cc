@@ -0,0 +1,82 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/utils/async_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKAsyncUtilTest : public testing::TestWithParam<int64_t> {
+ protected:
+  void SetUp() override {
+    old_spin_us_ = FLAGS_sdk_sync_wait_spin_us;
+    FLAGS_sdk_sync_wait_spin_us = GetParam();
+  }
+
+  void TearDown() override { FLAGS_sdk_sync_wait_spin_us = old_spin_us_; }
+
+ private:
+  int64_t old_spin_us_{0};
+};
+
+TEST_P(SDKAsyncUtilTest, FireBeforeWait) {
+  Synchronizer sync;
+  Status got;
+  sync.AsStatusCallBack(got)(Status::NotFound("mock"));
+  sync.Wait();
+  EXPECT_TRUE(got.IsNotFound());
+}
+
+TEST_P(SDKAsyncUtilTest, FireFromOtherThread) {
+  // synchronizer is destroyed as soon as wait return, like callers of rpc
+  for (int i = 0; i < 1000; ++i) {
+    auto sync = std::make_unique<Synchronizer>();
+    std::thread thread([cb = sync->AsRpcCallBack(), i] {
+      if (i % 100 == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      cb();
+    });
+    sync->Wait();
+    sync.reset();
+    thread.join();
+  }
+}
+
+TEST_P(SDKAsyncUtilTest, CountDown) {
+  CountDownSync empty(0);
+  empty.Wait();
+
+  CountDownSync sync(8);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&sync] { sync.CountDown(); });
+  }
+  sync.Wait();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SpinUs, SDKAsyncUtilTest, testing::Values(0, 50));
+
+}  // namespace sdk
+}  // namespace dingodb
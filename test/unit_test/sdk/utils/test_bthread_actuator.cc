@@ -0,0 +1,82 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef USE_GRPC
+
+#include <atomic>
+#include <memory>
+
+#include "bthread/bthread.h"
+#include "gtest/gtest.h"
+#include "sdk/request_priority.h"
+#include "sdk/utils/async_util.h"
+#include "sdk/utils/bthread_actuator.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKBthreadActuatorTest, ExecuteAndSchedule) {
+  BthreadActuator actuator;
+  ASSERT_TRUE(actuator.Start(4));
+
+  CountDownSync sync(2);
+  std::atomic<bool> in_bthread{false};
+  std::atomic<RequestPriority> priority{kInteractive};
+  {
+    ScopedRequestPriority scope(kBackground);
+    ASSERT_TRUE(actuator.Execute([&] {
+      in_bthread = bthread_self() != 0;
+      priority = CurrentRequestPriority();
+      sync.CountDown();
+    }));
+  }
+  ASSERT_TRUE(actuator.Schedule([&] { sync.CountDown(); }, 10));
+  sync.Wait();
+
+  EXPECT_TRUE(in_bthread.load());
+  EXPECT_EQ(priority.load(), kBackground);
+}
+
+TEST(SDKBthreadActuatorTest, SyncInBthread) {
+  BthreadActuator actuator;
+  ASSERT_TRUE(actuator.Start(4));
+
+  // a bthread waiting on an sdk call fired from another bthread, like a brpc server handler calling the sdk
+  Synchronizer done;
+  ASSERT_TRUE(actuator.Execute([&] {
+    Synchronizer sync;
+    Status got;
+    actuator.Schedule([cb = sync.AsStatusCallBack(got)] { cb(Status::NotFound("mock")); }, 5);
+    sync.Wait();
+    EXPECT_TRUE(got.IsNotFound());
+    done.Fire();
+  }));
+  done.Wait();
+}
+
+TEST(SDKBthreadActuatorTest, StopDropsScheduled) {
+  std::atomic<int> ran{0};
+  auto actuator = std::make_unique<BthreadActuator>();
+  ASSERT_TRUE(actuator->Start(4));
+  ASSERT_TRUE(actuator->Schedule([&] { ran++; }, 60 * 1000));
+  EXPECT_TRUE(actuator->Stop());
+  EXPECT_FALSE(actuator->Stop());
+  actuator.reset();
+  EXPECT_EQ(ran.load(), 0);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // USE_GRPC
@@ -0,0 +1,101 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "sdk/common/param_config.h"
+#include "sdk/utils/scan_batch_sizer.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKScanBatchSizerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_scan_batch_max_size = 10000;
+    FLAGS_scan_batch_max_bytes = 1024 * 1024;
+    FLAGS_scan_batch_adaptive = true;
+  }
+
+  void TearDown() override {
+    FLAGS_scan_batch_max_size = 10000;
+    FLAGS_scan_batch_max_bytes = 4 * 1024 * 1024;
+    FLAGS_scan_batch_adaptive = true;
+  }
+};
+
+TEST_F(SDKScanBatchSizerTest, Clamp) {
+  ScanBatchSizer sizer(0);
+  EXPECT_EQ(sizer.Rows(), kMinScanBatchSize);
+
+  sizer.SetRows(INT64_MAX);
+  EXPECT_EQ(sizer.Rows(), FLAGS_scan_batch_max_size);
+}
+
+TEST_F(SDKScanBatchSizerTest, GrowWithSmallRows) {
+  ScanBatchSizer sizer(100);
+
+  // 16 bytes a row, full batches double until the row cap
+  sizer.Record(100, 100 * 16);
+  EXPECT_EQ(sizer.Rows(), 200);
+  sizer.Record(200, 200 * 16);
+  EXPECT_EQ(sizer.Rows(), 400);
+  for (int i = 0; i < 10; ++i) {
+    sizer.Record(sizer.Rows(), sizer.Rows() * 16);
+  }
+  EXPECT_EQ(sizer.Rows(), FLAGS_scan_batch_max_size);
+
+  // a batch not full keeps rows
+  ScanBatchSizer partial(100);
+  partial.Record(10, 10 * 16);
+  EXPECT_EQ(partial.Rows(), 100);
+}
+
+TEST_F(SDKScanBatchSizerTest, ShrinkWithLargeRows) {
+  ScanBatchSizer sizer(1000);
+
+  // 256KB a row, 4 rows fit the 1MB budget
+  sizer.Record(10, 10 * 256 * 1024);
+  EXPECT_EQ(sizer.Rows(), 4);
+
+  // rows larger than the budget still fetch one
+  sizer.Record(4, 4 * 8 * 1024 * 1024);
+  EXPECT_EQ(sizer.Rows(), kMinScanBatchSize);
+}
+
+TEST_F(SDKScanBatchSizerTest, SetRowsIsCeiling) {
+  ScanBatchSizer sizer(1000);
+  sizer.SetRows(50);
+
+  sizer.Record(50, 50 * 16);
+  EXPECT_EQ(sizer.Rows(), 50);
+
+  sizer.Record(50, 50 * 256 * 1024);
+  EXPECT_LT(sizer.Rows(), 50);
+}
+
+TEST_F(SDKScanBatchSizerTest, NotAdaptive) {
+  FLAGS_scan_batch_adaptive = false;
+  ScanBatchSizer sizer(100);
+
+  sizer.Record(100, 100 * 16);
+  EXPECT_EQ(sizer.Rows(), 100);
+  sizer.Record(100, 100 * 1024 * 1024);
+  EXPECT_EQ(sizer.Rows(), 100);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
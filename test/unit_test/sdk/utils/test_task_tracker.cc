@@ -0,0 +1,63 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "sdk/utils/task_tracker.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKTaskTrackerTest, CancelWaitEnteredTasks) {
+  TaskTracker tracker;
+  ASSERT_TRUE(tracker.Enter());
+  ASSERT_TRUE(tracker.Enter());
+  EXPECT_FALSE(tracker.IsCancelled());
+
+  std::atomic<bool> cancelled{false};
+  std::thread canceller([&] {
+    tracker.CancelAndWait();
+    cancelled.store(true);
+  });
+
+  while (!tracker.IsCancelled()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // no task enters once cancelled
+  EXPECT_FALSE(tracker.Enter());
+
+  tracker.Leave();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(cancelled.load());
+
+  tracker.Leave();
+  canceller.join();
+  EXPECT_TRUE(cancelled.load());
+}
+
+TEST(SDKTaskTrackerTest, CancelWithoutTasks) {
+  TaskTracker tracker;
+  ASSERT_TRUE(tracker.Enter());
+  tracker.Leave();
+
+  tracker.CancelAndWait();
+  EXPECT_TRUE(tracker.IsCancelled());
+  EXPECT_FALSE(tracker.Enter());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,66 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/utils/thread_placement.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKThreadPlacementTest, ParseCpuList) {
+  std::vector<int> cpus;
+  EXPECT_TRUE(ThreadPlacement::ParseCpuList("0-3,8,10-11", cpus));
+  EXPECT_EQ(cpus, std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+
+  EXPECT_TRUE(ThreadPlacement::ParseCpuList("5", cpus));
+  EXPECT_EQ(cpus, std::vector<int>({5}));
+
+  EXPECT_FALSE(ThreadPlacement::ParseCpuList("", cpus));
+  EXPECT_FALSE(ThreadPlacement::ParseCpuList("3-1", cpus));
+  EXPECT_FALSE(ThreadPlacement::ParseCpuList("1,,2", cpus));
+  EXPECT_FALSE(ThreadPlacement::ParseCpuList("a-b", cpus));
+  EXPECT_FALSE(ThreadPlacement::ParseCpuList("-1", cpus));
+}
+
+TEST(SDKThreadPlacementTest, PinCallerCpus) {
+  FLAGS_sdk_thread_cpus = "caller";
+  ThreadPlacement placement = ThreadPlacement::FromFlags();
+  FLAGS_sdk_thread_cpus = "";
+  ASSERT_TRUE(placement.Enabled());
+
+  // a new thread pinned to the cpus of caller runs on one of them
+  std::thread thread([&placement] {
+    placement.PinCurrentThread();
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset), 0);
+    EXPECT_EQ(CPU_COUNT(&cpuset), static_cast<int>(placement.Cpus().size()));
+    for (int cpu : placement.Cpus()) {
+      EXPECT_TRUE(CPU_ISSET(cpu, &cpuset));
+    }
+  });
+  thread.join();
+
+  EXPECT_FALSE(ThreadPlacement::FromFlags().Enabled());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
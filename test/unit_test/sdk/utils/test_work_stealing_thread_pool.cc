@@ -0,0 +1,136 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/logging.h"
+#include "gtest/gtest.h"
+#include "sdk/utils/thread_pool.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const int kThreadNum = 8;
+
+static void WaitZero(std::atomic<int64_t>& count) {
+  while (count.load() != 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+TEST(SDKWorkStealingThreadPoolTest, ExecuteFromExternalThreads) {
+  std::unique_ptr<ThreadPool> pool(NewWorkStealingThreadPool(kThreadNum));
+  pool->Start();
+  EXPECT_EQ(pool->GetBackgroundThreads(), kThreadNum);
+
+  const int64_t kTaskNum = 10000;
+  std::atomic<int64_t> count(kTaskNum);
+  std::vector<std::thread> producers;
+  for (int i = 0; i < 4; i++) {
+    producers.emplace_back([&]() {
+      for (int64_t j = 0; j < kTaskNum / 4; j++) {
+        pool->Execute([&]() { count.fetch_sub(1); });
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  WaitZero(count);
+  EXPECT_EQ(count.load(), 0);
+  EXPECT_EQ(pool->GetQueueLen(), 0);
+}
+
+TEST(SDKWorkStealingThreadPoolTest, ExecuteFromWorker) {
+  std::unique_ptr<ThreadPool> pool(NewWorkStealingThreadPool(kThreadNum));
+  pool->Start();
+
+  // every task fans out two children until depth 0, all pushed from worker threads
+  const int kDepth = 12;
+  std::atomic<int64_t> count((1 << (kDepth + 1)) - 1);
+  std::function<void(int)> fan_out = [&](int depth) {
+    if (depth > 0) {
+      pool->Execute([&, depth]() { fan_out(depth - 1); });
+      pool->Execute([&, depth]() { fan_out(depth - 1); });
+    }
+    count.fetch_sub(1);
+  };
+  pool->Execute([&]() { fan_out(kDepth); });
+
+  WaitZero(count);
+  EXPECT_EQ(count.load(), 0);
+}
+
+TEST(SDKWorkStealingThreadPoolTest, JoinThreadsDrainTasks) {
+  std::atomic<int64_t> count(1000);
+  {
+    std::unique_ptr<ThreadPool> pool(NewWorkStealingThreadPool(2));
+    pool->Start();
+    for (int i = 0; i < 1000; i++) {
+      pool->Execute([&]() { count.fetch_sub(1); });
+    }
+    pool->JoinThreads();
+  }
+  EXPECT_EQ(count.load(), 0);
+}
+
+// Not a pass/fail check, prints how long 8 producers plus worker fan out take on both pools.
+TEST(SDKWorkStealingThreadPoolTest, BenchmarkAgainstFifoPool) {
+  const int kProducerNum = 8;
+  const int64_t kTaskPerProducer = 20000;
+
+  auto run = [&](ThreadPool* raw_pool) {
+    std::unique_ptr<ThreadPool> pool(raw_pool);
+    pool->Start();
+    std::atomic<int64_t> count(kProducerNum * kTaskPerProducer * 2);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (int i = 0; i < kProducerNum; i++) {
+      producers.emplace_back([&]() {
+        for (int64_t j = 0; j < kTaskPerProducer; j++) {
+          // like an rpc callback scheduling its continuation
+          pool->Execute([&]() {
+            pool->Execute([&]() { count.fetch_sub(1); });
+            count.fetch_sub(1);
+          });
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    WaitZero(count);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  };
+
+  int64_t fifo_us = run(NewThreadPool(kThreadNum));
+  int64_t work_stealing_us = run(NewWorkStealingThreadPool(kThreadNum));
+
+  DINGO_LOG(INFO) << "tasks: " << kProducerNum * kTaskPerProducer * 2 << ", fifo pool: " << fifo_us
+                  << " us, work stealing pool: " << work_stealing_us << " us";
+}
+
+}  // namespace sdk
+}  // namespace dingodb
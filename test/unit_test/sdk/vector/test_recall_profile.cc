@@ -0,0 +1,37 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKRecallProfileTest, PickParam) {
+  RecallProfile profile;
+  EXPECT_EQ(profile.PickParam(0.9f), 0);
+
+  profile.param_type = SearchExtraParamType::kNprobe;
+  profile.topk = 10;
+  profile.points = {{8, 0.80f}, {16, 0.91f}, {32, 0.96f}, {64, 0.99f}};
+
+  EXPECT_EQ(profile.PickParam(0.5f), 8);
+  EXPECT_EQ(profile.PickParam(0.91f), 16);
+  EXPECT_EQ(profile.PickParam(0.95f), 32);
+  // not reachable, use the most accurate one
+  EXPECT_EQ(profile.PickParam(0.999f), 64);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
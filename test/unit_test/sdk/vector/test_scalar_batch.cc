@@ -0,0 +1,98 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sdk/types.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+static ScalarValue MakeScalar(Type type, const ScalarField& field, int count = 1) {
+  ScalarValue value;
+  value.type = type;
+  for (int i = 0; i < count; ++i) {
+    value.fields.push_back(field);
+  }
+  return value;
+}
+
+TEST(SDKScalarBatchTest, AppendAndView) {
+  ScalarField str_field{};
+  str_field.string_data = "hello";
+  ScalarField long_field{};
+  long_field.long_data = 42;
+  ScalarField double_field{};
+  double_field.double_data = 1.5;
+
+  std::map<std::string, ScalarValue> row0 = {{"str", MakeScalar(kSTRING, str_field, 2)},
+                                             {"long", MakeScalar(kINT64, long_field)}};
+  std::map<std::string, ScalarValue> row1 = {{"double", MakeScalar(kDOUBLE, double_field)}};
+
+  ScalarBatch batch;
+  batch.Append(row0);
+  batch.Append(row1);
+  ASSERT_EQ(batch.Size(), 2);
+  ASSERT_EQ(batch.GetKeys().size(), 3);
+  EXPECT_EQ(batch.KeyIndex("none"), -1);
+
+  int32_t str = batch.KeyIndex("str");
+  EXPECT_EQ(batch.FieldCount(str, 0), 2);
+  EXPECT_EQ(batch.GetString(str, 0, 1), "hello");
+  EXPECT_EQ(batch.GetType(str, 1), kTypeEnd);
+  EXPECT_EQ(batch.FieldCount(str, 1), 0);
+  EXPECT_EQ(batch.GetLong(batch.KeyIndex("long"), 0), 42);
+  EXPECT_EQ(batch.GetType(batch.KeyIndex("double"), 0), kTypeEnd);
+  EXPECT_EQ(batch.GetDouble(batch.KeyIndex("double"), 1), 1.5);
+
+  // the compatibility view is the same as the map appended
+  auto view = batch.GetScalarData(0);
+  ASSERT_EQ(view.size(), 2);
+  ASSERT_EQ(view["str"].fields.size(), 2);
+  EXPECT_EQ(view["str"].fields[1].string_data, "hello");
+  EXPECT_EQ(view["long"].fields[0].long_data, 42);
+  EXPECT_EQ(batch.GetScalarData(1).size(), 1);
+}
+
+TEST(SDKScalarBatchTest, AppendRow) {
+  ScalarBatch from;
+  from.AppendValue("name", kSTRING);
+  from.AppendStringField("a");
+  from.FinishRow();
+  from.AppendValue("flag", kBOOL);
+  from.AppendBoolField(true);
+  from.AppendValue("name", kSTRING);
+  from.AppendStringField("b");
+  from.FinishRow();
+
+  ScalarBatch to;
+  to.AppendRow(from, 1);
+  to.AppendRow(from, 0);
+  ASSERT_EQ(to.Size(), 2);
+  EXPECT_EQ(to.GetString(to.KeyIndex("name"), 0), "b");
+  EXPECT_EQ(to.GetString(to.KeyIndex("name"), 1), "a");
+  EXPECT_TRUE(to.GetBool(to.KeyIndex("flag"), 0));
+  EXPECT_EQ(to.GetType(to.KeyIndex("flag"), 1), kTypeEnd);
+
+  to.Clear();
+  EXPECT_TRUE(to.Empty());
+  EXPECT_TRUE(to.GetKeys().empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -38,6 +38,21 @@ TEST_F(SDKVectorAddTaskTest, EmptyVectors) {
   EXPECT_TRUE(s.IsInvalidArgument());
 }
 
+TEST_F(SDKVectorAddTaskTest, CanceledBeforeRun) {
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).Times(0);
+
+  std::vector<VectorWithId> ids;
+  ids.emplace_back(1, Vector());
+  VectorAddTask task(*stub, 1, ids);
+
+  auto cancel_token = std::make_shared<CancelToken>();
+  cancel_token->Cancel();
+  task.SetCancelToken(cancel_token);
+
+  Status s = task.Run();
+  EXPECT_TRUE(s.IsAborted());
+}
+
 static std::shared_ptr<VectorIndex> CreateFakeVectorIndex(int64_t start_id = 0) {
   std::shared_ptr<VectorIndex> vector_index;
 
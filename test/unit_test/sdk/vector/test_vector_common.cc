@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "sdk/vector/vector_common.h"
@@ -228,6 +230,71 @@ TEST(SDKVectorCommonTest, TestInternalVectorIdPB2VectorWithId) {
   EXPECT_EQ(vector_with_id.vector.float_values[1], 2.0);
 }
 
+TEST(SDKVectorCommonTest, TestInternalVectorIdPB2VectorWithIdColumnar) {
+  ScalarBatch batch;
+  for (int64_t id = 1; id <= 2; ++id) {
+    pb::common::VectorWithId pb;
+    pb.set_id(id);
+    auto* vector_pb = pb.mutable_vector();
+    vector_pb->set_dimension(1);
+    vector_pb->set_value_type(pb::common::ValueType::FLOAT);
+    vector_pb->add_float_values(1.0);
+
+    pb::common::ScalarValue name;
+    name.set_field_type(pb::common::ScalarFieldType::STRING);
+    name.add_fields()->set_string_data("name" + std::to_string(id));
+    pb.mutable_scalar_data()->mutable_scalar_data()->insert({"name", name});
+    if (id == 2) {
+      pb::common::ScalarValue age;
+      age.set_field_type(pb::common::ScalarFieldType::INT64);
+      age.add_fields()->set_long_data(18);
+      pb.mutable_scalar_data()->mutable_scalar_data()->insert({"age", age});
+    }
+
+    VectorWithId vector_with_id = InternalVectorIdPB2VectorWithId(pb, batch);
+    EXPECT_EQ(vector_with_id.id, id);
+    EXPECT_TRUE(vector_with_id.scalar_data.empty());
+  }
+
+  ASSERT_EQ(batch.Size(), 2);
+  int32_t name = batch.KeyIndex("name");
+  int32_t age = batch.KeyIndex("age");
+  ASSERT_GE(name, 0);
+  ASSERT_GE(age, 0);
+  EXPECT_EQ(batch.GetString(name, 0), "name1");
+  EXPECT_EQ(batch.GetString(name, 1), "name2");
+  EXPECT_EQ(batch.GetType(age, 0), kTypeEnd);
+  EXPECT_EQ(batch.GetLong(age, 1), 18);
+
+  auto scalar_data = batch.GetScalarData(1);
+  ASSERT_EQ(scalar_data.size(), 2);
+  EXPECT_EQ(scalar_data["age"].type, kINT64);
+  EXPECT_EQ(scalar_data["age"].fields[0].long_data, 18);
+}
+
+TEST(SDKVectorCommonTest, TestFillsUint8VectorWithIdPB) {
+  VectorWithId vector_with_id;
+  vector_with_id.id = 100;
+  vector_with_id.vector.dimension = 3;
+  vector_with_id.vector.value_type = ValueType::kUint8;
+  vector_with_id.vector.binary_values = {0, 128, 255};
+
+  pb::common::VectorWithId pb;
+  FillVectorWithIdPB(&pb, vector_with_id);
+
+  EXPECT_EQ(pb.vector().dimension(), 3);
+  EXPECT_EQ(pb.vector().value_type(), pb::common::ValueType::UINT8);
+  EXPECT_EQ(pb.vector().float_values_size(), 0);
+  ASSERT_EQ(pb.vector().binary_values_size(), 1);
+  EXPECT_EQ(pb.vector().binary_values(0), std::string("\x00\x80\xff", 3));
+
+  VectorWithId decoded = InternalVectorIdPB2VectorWithId(pb);
+  EXPECT_EQ(decoded.id, 100);
+  EXPECT_EQ(decoded.vector.value_type, ValueType::kUint8);
+  EXPECT_TRUE(decoded.vector.float_values.empty());
+  EXPECT_EQ(decoded.vector.binary_values, vector_with_id.vector.binary_values);
+}
+
 TEST(SDKVectorCommonTest, TestInternalVectorWithDistance2VectorWithDistance) {
   pb::common::VectorWithDistance pb;
   auto* vector_with_id_pb = pb.mutable_vector_with_id();
@@ -252,6 +319,45 @@ TEST(SDKVectorCommonTest, TestInternalVectorWithDistance2VectorWithDistance) {
   EXPECT_EQ(vector_with_distance.metric_type, MetricType::kL2);
 }
 
+TEST(SDKVectorCommonTest, TestInternalHitsPB2CompactSearchResult) {
+  std::vector<pb::common::VectorWithDistance> pbs(3);
+  for (int64_t i = 0; i < 3; ++i) {
+    auto* vector_with_id_pb = pbs[i].mutable_vector_with_id();
+    vector_with_id_pb->set_id(100 + i);
+    auto* vector_pb = vector_with_id_pb->mutable_vector();
+    vector_pb->set_dimension(1);
+    vector_pb->set_value_type(pb::common::ValueType::FLOAT);
+    vector_pb->add_float_values(i);
+
+    pb::common::ScalarValue age;
+    age.set_field_type(pb::common::ScalarFieldType::INT64);
+    age.add_fields()->set_long_data(i);
+    vector_with_id_pb->mutable_scalar_data()->mutable_scalar_data()->insert({"age", age});
+    pbs[i].set_distance(i * 1.5);
+  }
+
+  // the second target has no hit
+  std::vector<std::vector<const pb::common::VectorWithDistance*>> hits = {{&pbs[0], &pbs[1]}, {}, {&pbs[2]}};
+
+  CompactSearchResult result = InternalHitsPB2CompactSearchResult(hits, false, false);
+  ASSERT_EQ(result.TargetCount(), 3);
+  EXPECT_EQ(result.HitCount(0), 2);
+  EXPECT_EQ(result.HitCount(1), 0);
+  EXPECT_EQ(result.HitCount(2), 1);
+  EXPECT_EQ(result.ids, std::vector<int64_t>({100, 101, 102}));
+  EXPECT_EQ(result.distances, std::vector<float>({0, 1.5, 3.0}));
+  EXPECT_TRUE(result.vectors.empty());
+  EXPECT_EQ(result.scalar_batch.Size(), 0);
+
+  result = InternalHitsPB2CompactSearchResult(hits, true, true);
+  ASSERT_EQ(result.vectors.size(), 3);
+  EXPECT_EQ(result.vectors[2].float_values, std::vector<float>({2}));
+  ASSERT_EQ(result.scalar_batch.Size(), 3);
+  EXPECT_EQ(result.scalar_batch.GetLong(result.scalar_batch.KeyIndex("age"), 1), 1);
+
+  EXPECT_EQ(InternalHitsPB2CompactSearchResult({}, false, false).TargetCount(), 0);
+}
+
 TEST(SDKVectorCommonTest, InternalVectorIndexMetrics2IndexMetricsResult) {
   pb::common::VectorIndexMetrics pb;
   pb.set_vector_index_type(pb::common::VectorIndexType::VECTOR_INDEX_TYPE_FLAT);
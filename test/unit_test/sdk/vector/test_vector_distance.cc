@@ -0,0 +1,112 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_distance.h"
+
+namespace dingodb {
+namespace sdk {
+
+static std::vector<float> MakeValues(size_t dimension, float base) {
+  std::vector<float> values(dimension);
+  for (size_t i = 0; i < dimension; i++) {
+    values[i] = base + static_cast<float>(i) * 0.5f;
+  }
+  return values;
+}
+
+TEST(SDKVectorDistanceTest, L2Sqr) {
+  // 19 covers full lanes and the tail
+  auto a = MakeValues(19, 1.0f);
+  auto b = MakeValues(19, -1.0f);
+  EXPECT_FLOAT_EQ(vector_distance::L2Sqr(a.data(), b.data(), a.size()), 19 * 4.0f);
+  EXPECT_FLOAT_EQ(vector_distance::ExactDistance(MetricType::kL2, a.data(), a.data(), a.size()), 0.0f);
+}
+
+TEST(SDKVectorDistanceTest, InnerProduct) {
+  auto a = MakeValues(19, 1.0f);
+  auto b = MakeValues(19, 2.0f);
+  float expected = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    expected += a[i] * b[i];
+  }
+  EXPECT_FLOAT_EQ(vector_distance::InnerProduct(a.data(), b.data(), a.size()), expected);
+  EXPECT_FLOAT_EQ(vector_distance::ExactDistance(MetricType::kInnerProduct, a.data(), b.data(), a.size()),
+                  1.0f - expected);
+}
+
+TEST(SDKVectorDistanceTest, Cosine) {
+  std::vector<float> a = {1.0f, 0.0f, 0.0f};
+  std::vector<float> b = {2.0f, 0.0f, 0.0f};
+  std::vector<float> c = {0.0f, 3.0f, 0.0f};
+  std::vector<float> zero = {0.0f, 0.0f, 0.0f};
+  EXPECT_NEAR(vector_distance::ExactDistance(MetricType::kCosine, a.data(), b.data(), a.size()), 0.0f, 1e-6);
+  EXPECT_NEAR(vector_distance::ExactDistance(MetricType::kCosine, a.data(), c.data(), a.size()), 1.0f, 1e-6);
+  EXPECT_FLOAT_EQ(vector_distance::ExactDistance(MetricType::kCosine, a.data(), zero.data(), a.size()), 1.0f);
+}
+
+TEST(SDKVectorDistanceTest, SpecializedDimension) {
+  for (size_t dimension : {128, 256, 768, 1024, 1536}) {
+    auto a = MakeValues(dimension, 0.25f);
+    auto b = MakeValues(dimension, -0.5f);
+    float l2 = 0;
+    float ip = 0;
+    for (size_t i = 0; i < dimension; i++) {
+      l2 += (a[i] - b[i]) * (a[i] - b[i]);
+      ip += a[i] * b[i];
+    }
+    EXPECT_NEAR(vector_distance::L2Sqr(a.data(), b.data(), dimension), l2, std::abs(l2) * 1e-5);
+    EXPECT_NEAR(vector_distance::InnerProduct(a.data(), b.data(), dimension), ip, std::abs(ip) * 1e-5);
+  }
+}
+
+TEST(SDKVectorDistanceTest, Batch) {
+  const size_t dimension = 19;
+  std::vector<float> queries;
+  std::vector<float> base;
+  for (size_t i = 0; i < 3; i++) {
+    auto values = MakeValues(dimension, static_cast<float>(i));
+    queries.insert(queries.end(), values.begin(), values.end());
+  }
+  for (size_t i = 0; i < 5; i++) {
+    auto values = MakeValues(dimension, -static_cast<float>(i));
+    base.insert(base.end(), values.begin(), values.end());
+  }
+
+  for (auto metric_type : {MetricType::kL2, MetricType::kInnerProduct, MetricType::kCosine}) {
+    std::vector<float> one_to_many(5);
+    vector_distance::ExactDistances(metric_type, queries.data(), base.data(), 5, dimension, one_to_many.data());
+
+    std::vector<float> matrix(3 * 5);
+    vector_distance::ExactDistanceMatrix(metric_type, queries.data(), 3, base.data(), 5, dimension, matrix.data());
+
+    for (size_t i = 0; i < 3; i++) {
+      for (size_t j = 0; j < 5; j++) {
+        float expected =
+            vector_distance::ExactDistance(metric_type, &queries[i * dimension], &base[j * dimension], dimension);
+        EXPECT_FLOAT_EQ(matrix[i * 5 + j], expected);
+        if (i == 0) {
+          EXPECT_FLOAT_EQ(one_to_many[j], expected);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
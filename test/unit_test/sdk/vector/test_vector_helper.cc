@@ -0,0 +1,208 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/filter.h"
+#include "sdk/vector/vector_codec.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_helper.h"
+#include "sdk/vector/vector_index.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKVectorHelperTest : public TestBase {
+ protected:
+  void SetUp() override {
+    std::vector<int64_t> index_and_part_ids{2, 6, 5, 4, 3};
+    std::vector<int64_t> range_seperator_ids = {5, 10, 20};
+    FlatParam flat_param{8, dingodb::sdk::MetricType::kL2};
+
+    pb::meta::IndexDefinitionWithId index_definition_with_id;
+    FillVectorIndexId(index_definition_with_id.mutable_index_id(), index_and_part_ids[0], 2);
+    auto* defination = index_definition_with_id.mutable_index_definition();
+    defination->set_name("test");
+    FillRangePartitionRule(defination->mutable_index_partition(), range_seperator_ids, index_and_part_ids);
+    defination->set_replica(3);
+    auto* index_parameter = defination->mutable_index_parameter();
+    index_parameter->set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+    FillFlatParmeter(index_parameter->mutable_vector_index_parameter(), flat_param);
+    vector_index = std::make_shared<VectorIndex>(index_definition_with_id);
+
+    // one region per partition
+    for (const auto& partition : defination->index_partition().partitions()) {
+      pb::common::RegionEpoch epoch;
+      epoch.set_version(1);
+      epoch.set_conf_version(1);
+      meta_cache->MaybeAddRegion(GenRegion(partition.id().entity_id() * 100, partition.range(), epoch,
+                                           pb::common::RegionType::INDEX_REGION));
+    }
+  }
+
+  std::shared_ptr<VectorIndex> vector_index;
+};
+
+TEST_F(SDKVectorHelperTest, GroupVectorIdsByRegion) {
+  // partition of ids: [1,5) -> 6, [5,10) -> 5, [10,20) -> 4, [20,) -> 3
+  std::vector<int64_t> ids{1, 6, 11, 21, 2, 25};
+
+  std::vector<vector_helper::RegionVectorIds> groups;
+  Status s = vector_helper::GroupVectorIdsByRegion(*meta_cache, *vector_index, ids, groups);
+  ASSERT_TRUE(s.ok());
+
+  // ordered by region range, which is partition id order
+  ASSERT_EQ(groups.size(), 4);
+  EXPECT_EQ(groups[0].region->RegionId(), 300);
+  EXPECT_EQ(groups[0].ids, std::vector<int64_t>({21, 25}));
+  EXPECT_EQ(groups[1].region->RegionId(), 400);
+  EXPECT_EQ(groups[1].ids, std::vector<int64_t>({11}));
+  EXPECT_EQ(groups[2].region->RegionId(), 500);
+  EXPECT_EQ(groups[2].ids, std::vector<int64_t>({6}));
+  EXPECT_EQ(groups[3].region->RegionId(), 600);
+  EXPECT_EQ(groups[3].ids, std::vector<int64_t>({1, 2}));
+}
+
+TEST_F(SDKVectorHelperTest, GroupEmptyVectorIds) {
+  std::vector<int64_t> ids;
+  std::vector<vector_helper::RegionVectorIds> groups;
+  Status s = vector_helper::GroupVectorIdsByRegion(*meta_cache, *vector_index, ids, groups);
+  EXPECT_TRUE(s.ok());
+  EXPECT_TRUE(groups.empty());
+}
+
+TEST_F(SDKVectorHelperTest, VectorIdsToRangeKeys) {
+  std::vector<int64_t> ids{1, 6, 11, 21, 2, 25};
+
+  std::string keys;
+  vector_helper::VectorIdsToRangeKeys(*vector_index, ids, keys);
+  ASSERT_EQ(keys.size(), ids.size() * kVectorKeyMaxLenWithPrefix);
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    EXPECT_EQ(keys.substr(i * kVectorKeyMaxLenWithPrefix, kVectorKeyMaxLenWithPrefix),
+              vector_helper::VectorIdToRangeKey(*vector_index, ids[i]));
+  }
+}
+
+TEST(SDKVectorCodecTest, EncodeVectorKeys) {
+  std::vector<int64_t> part_ids{1, 2, 3, INT64_MAX, 7};
+  std::vector<int64_t> ids{0, 1, -1, INT64_MAX, INT64_MIN};
+
+  std::string keys;
+  vector_codec::EncodeVectorKeys(kVectorPrefix, part_ids, ids, keys);
+  ASSERT_EQ(keys.size(), ids.size() * kVectorKeyMaxLenWithPrefix);
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    std::string key;
+    vector_codec::EncodeVectorKey(kVectorPrefix, part_ids[i], ids[i], key);
+    std::string batch_key = keys.substr(i * kVectorKeyMaxLenWithPrefix, kVectorKeyMaxLenWithPrefix);
+    EXPECT_EQ(batch_key, key);
+    EXPECT_EQ(vector_codec::DecodePartitionId(batch_key), part_ids[i]);
+    EXPECT_EQ(vector_codec::DecodeVectorId(batch_key), ids[i]);
+  }
+
+  std::vector<int64_t> decoded_ids;
+  vector_codec::DecodeVectorIds(keys, decoded_ids);
+  EXPECT_EQ(decoded_ids, ids);
+}
+
+TEST(SDKVectorCodecTest, EncodeEmptyVectorKeys) {
+  std::string keys = "stale";
+  vector_codec::EncodeVectorKeys(kVectorPrefix, {}, {}, keys);
+  EXPECT_TRUE(keys.empty());
+
+  std::vector<int64_t> decoded_ids{1};
+  vector_codec::DecodeVectorIds(keys, decoded_ids);
+  EXPECT_TRUE(decoded_ids.empty());
+}
+
+static std::vector<VectorWithId> MakeScalarSample(int64_t count) {
+  std::vector<VectorWithId> sample(count);
+  for (int64_t i = 0; i < count; ++i) {
+    ScalarField field{};
+    field.long_data = i;
+    ScalarValue value;
+    value.type = kINT64;
+    value.fields.push_back(field);
+    sample[i].id = i + 1;
+    sample[i].scalar_data["a1"] = value;
+  }
+  return sample;
+}
+
+TEST(SDKVectorHelperFilterTest, EstimateSelectivity) {
+  auto sample = MakeScalarSample(100);
+  double selectivity = 0;
+
+  auto filter = Filter::Compare(Filter::kLt, "a1", int64_t{10});
+  ASSERT_TRUE(vector_helper::EstimateSelectivity(sample, filter.get(), "", selectivity));
+  EXPECT_DOUBLE_EQ(selectivity, 0.1);
+
+  std::string json = R"({"type": "comparator", "comparator": "gte", "attribute": "a1", "value": 50,
+                         "value_type": "INT64"})";
+  ASSERT_TRUE(vector_helper::EstimateSelectivity(sample, nullptr, json, selectivity));
+  EXPECT_DOUBLE_EQ(selectivity, 0.5);
+
+  // nothing to estimate
+  EXPECT_FALSE(vector_helper::EstimateSelectivity({}, filter.get(), "", selectivity));
+  EXPECT_FALSE(vector_helper::EstimateSelectivity(sample, nullptr, "", selectivity));
+  EXPECT_FALSE(vector_helper::EstimateSelectivity(sample, nullptr, R"({"type": "unknown"})", selectivity));
+}
+
+TEST(SDKVectorHelperFilterTest, MatchVectorIds) {
+  auto sample = MakeScalarSample(100);
+
+  std::string json = R"({"type": "comparator", "comparator": "lt", "attribute": "a1", "value": 3,
+                         "value_type": "INT64"})";
+  std::shared_ptr<expression::LangchainExpr> expr;
+  ASSERT_TRUE(expression::LangchainExprFactory().CreateExpr(json, expr).ok());
+
+  std::vector<int64_t> ids{100};
+  vector_helper::MatchVectorIds(sample, expr.get(), ids);
+  ASSERT_EQ(ids.size(), 3);
+  for (int i = 0; i < ids.size(); i++) {
+    EXPECT_EQ(ids[i], sample[i].id);
+  }
+
+  vector_helper::MatchVectorIds({}, expr.get(), ids);
+  EXPECT_TRUE(ids.empty());
+}
+
+TEST(SDKVectorHelperFilterTest, PickFilterType) {
+  int64_t recall_num = -1;
+  EXPECT_EQ(vector_helper::PickFilterType(0.01, 10, 0.05, 10000, recall_num), FilterType::kQueryPre);
+  EXPECT_EQ(recall_num, 0);
+  EXPECT_EQ(vector_helper::PickFilterType(0, 10, 0.05, 10000, recall_num), FilterType::kQueryPre);
+
+  EXPECT_EQ(vector_helper::PickFilterType(0.5, 10, 0.05, 10000, recall_num), FilterType::kQueryPost);
+  EXPECT_EQ(recall_num, 20);
+  // capped, but never less than topk
+  EXPECT_EQ(vector_helper::PickFilterType(0.1, 100, 0.05, 500, recall_num), FilterType::kQueryPost);
+  EXPECT_EQ(recall_num, 500);
+  EXPECT_EQ(vector_helper::PickFilterType(0.1, 100, 0.05, 50, recall_num), FilterType::kQueryPost);
+  EXPECT_EQ(recall_num, 100);
+  // range search has no topk
+  EXPECT_EQ(vector_helper::PickFilterType(0.5, 0, 0.05, 10000, recall_num), FilterType::kQueryPost);
+  EXPECT_EQ(recall_num, 0);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -77,6 +77,25 @@ TEST_F(SDKVectorIndexTest, TestGetPartitionId) {
   EXPECT_EQ(vector_index->GetPartitionId(100), index_and_part_ids[4]);
 }
 
+TEST_F(SDKVectorIndexTest, TestSearchLatencyPercentile) {
+  int64_t region_id = 100;
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(vector_index->GetSearchLatencyPercentileUs(region_id, 95), -1);
+    vector_index->RecordSearchLatency(region_id, i % 2 == 0 ? 1000 : 3000);
+  }
+
+  int64_t p50 = vector_index->GetSearchLatencyPercentileUs(region_id, 50);
+  int64_t p95 = vector_index->GetSearchLatencyPercentileUs(region_id, 95);
+  int64_t p99 = vector_index->GetSearchLatencyPercentileUs(region_id, 99);
+  EXPECT_GT(p50, 1000);
+  EXPECT_LT(p50, 3000);
+  EXPECT_GT(p95, p50);
+  EXPECT_GT(p99, p95);
+
+  // other region has no sample
+  EXPECT_EQ(vector_index->GetSearchLatencyPercentileUs(region_id + 1, 95), -1);
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
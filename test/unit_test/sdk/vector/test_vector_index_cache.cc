@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/vector.h"
 #include "sdk/vector/vector_common.h"
@@ -259,6 +260,29 @@ TEST_F(SDKVectorIndexCacheTest, GetVectorIndexByIdOK) {
   }
 }
 
+TEST_F(SDKVectorIndexCacheTest, NegativeCacheNotFoundIndex) {
+  std::string index_name = "not_exist";
+  int64_t origin_ttl_ms = FLAGS_index_cache_negative_ttl_ms;
+  FLAGS_index_cache_negative_ttl_ms = 60 * 1000;
+
+  // empty response is not found, the second lookup must not go to coordinator
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<GetIndexByNameRpc*>(&rpc);
+    EXPECT_EQ(t_rpc->Request()->index_name(), index_name);
+    return Status::OK();
+  });
+
+  int64_t id = -1;
+  Status status = cache->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), id);
+  EXPECT_TRUE(status.IsNotFound());
+
+  status = cache->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), id);
+  EXPECT_TRUE(status.IsNotFound());
+  EXPECT_EQ(id, -1);
+
+  FLAGS_index_cache_negative_ttl_ms = origin_ttl_ms;
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_payload_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+static VectorWithId MakeFloatVector(int64_t vector_id, int32_t dimension) {
+  Vector vector(ValueType::kFloat, dimension);
+  for (int32_t i = 0; i < dimension; i++) {
+    vector.float_values.push_back(vector_id + i * 0.5f);
+  }
+  return VectorWithId(vector_id, vector);
+}
+
+TEST(SDKVectorPayloadCacheTest, Disabled) {
+  VectorPayloadCache cache("", 16);
+  EXPECT_FALSE(cache.Enabled());
+
+  cache.Put(1, {MakeFloatVector(10, 4)}, cache.IndexVersion(1));
+  Vector vector;
+  EXPECT_FALSE(cache.Get(1, 10, vector));
+}
+
+TEST(SDKVectorPayloadCacheTest, GetAndPut) {
+  VectorPayloadCache cache("/tmp", 16);
+
+  Vector vector;
+  EXPECT_FALSE(cache.Get(1, 10, vector));
+
+  VectorWithId binary(11, Vector(ValueType::kUint8, 4));
+  binary.vector.binary_values = {1, 2, 3, 4};
+  cache.Put(1, {MakeFloatVector(10, 4), binary, MakeFloatVector(12, 8), VectorWithId(13, Vector())},
+            cache.IndexVersion(1));
+  // record is of the first vector, the others are not cached
+  EXPECT_EQ(cache.Size(), 1);
+
+  ASSERT_TRUE(cache.Get(1, 10, vector));
+  EXPECT_EQ(vector.value_type, ValueType::kFloat);
+  EXPECT_EQ(vector.dimension, 4);
+  EXPECT_EQ(vector.float_values, MakeFloatVector(10, 4).vector.float_values);
+
+  EXPECT_FALSE(cache.Get(1, 11, vector));
+  EXPECT_FALSE(cache.Get(2, 10, vector));
+
+  // binary vectors of another index
+  cache.Put(2, {binary}, cache.IndexVersion(2));
+  ASSERT_TRUE(cache.Get(2, 11, vector));
+  EXPECT_EQ(vector.value_type, ValueType::kUint8);
+  EXPECT_EQ(vector.binary_values, binary.vector.binary_values);
+}
+
+TEST(SDKVectorPayloadCacheTest, Invalidate) {
+  VectorPayloadCache cache("/tmp", 16);
+
+  cache.Put(1, {MakeFloatVector(10, 4), MakeFloatVector(11, 4)}, cache.IndexVersion(1));
+  cache.Invalidate(1, {10});
+
+  Vector vector;
+  EXPECT_FALSE(cache.Get(1, 10, vector));
+  EXPECT_TRUE(cache.Get(1, 11, vector));
+
+  // query started before write is not cached
+  uint64_t version = cache.IndexVersion(1);
+  cache.Invalidate(1, {10});
+  cache.Put(1, {MakeFloatVector(10, 4)}, version);
+  EXPECT_FALSE(cache.Get(1, 10, vector));
+}
+
+TEST(SDKVectorPayloadCacheTest, Evict) {
+  VectorPayloadCache cache("/tmp", 4);
+
+  for (int64_t id = 1; id <= 4; id++) {
+    cache.Put(1, {MakeFloatVector(id, 4)}, cache.IndexVersion(1));
+  }
+  EXPECT_EQ(cache.Size(), 4);
+
+  // referenced vector survives one round of the clock
+  Vector vector;
+  ASSERT_TRUE(cache.Get(1, 1, vector));
+  cache.Put(1, {MakeFloatVector(5, 4)}, cache.IndexVersion(1));
+  EXPECT_EQ(cache.Size(), 4);
+  EXPECT_TRUE(cache.Get(1, 1, vector));
+  EXPECT_FALSE(cache.Get(1, 2, vector));
+  ASSERT_TRUE(cache.Get(1, 5, vector));
+  EXPECT_EQ(vector.float_values, MakeFloatVector(5, 4).vector.float_values);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
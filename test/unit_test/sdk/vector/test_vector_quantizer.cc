@@ -0,0 +1,89 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+static Vector MakeFloatVector(std::vector<float> values) {
+  Vector vector(ValueType::kFloat, static_cast<int32_t>(values.size()));
+  vector.float_values = std::move(values);
+  return vector;
+}
+
+TEST(SDKScalarQuantizerTest, TrainAndQuantize) {
+  ScalarQuantizer quantizer;
+  EXPECT_FALSE(quantizer.IsTrained());
+
+  std::vector<Vector> samples = {MakeFloatVector({0.0f, -1.0f, 5.0f}), MakeFloatVector({1.0f, 1.0f, 5.0f})};
+  ASSERT_TRUE(quantizer.Train(samples).ok());
+  EXPECT_TRUE(quantizer.IsTrained());
+  EXPECT_EQ(quantizer.Dimension(), 3);
+
+  Vector quantized;
+  ASSERT_TRUE(quantizer.Quantize(MakeFloatVector({0.5f, 1.0f, 5.0f}), quantized).ok());
+  EXPECT_EQ(quantized.value_type, ValueType::kUint8);
+  EXPECT_EQ(quantized.dimension, 3);
+  EXPECT_TRUE(quantized.float_values.empty());
+  EXPECT_EQ(quantized.binary_values, std::vector<uint8_t>({128, 255, 0}));
+
+  // out of trained range is clamped
+  ASSERT_TRUE(quantizer.Quantize(MakeFloatVector({-3.0f, 3.0f, 5.0f}), quantized).ok());
+  EXPECT_EQ(quantized.binary_values, std::vector<uint8_t>({0, 255, 0}));
+
+  Vector dequantized;
+  ASSERT_TRUE(quantizer.Dequantize(quantized, dequantized).ok());
+  EXPECT_EQ(dequantized.value_type, ValueType::kFloat);
+  ASSERT_EQ(dequantized.float_values.size(), 3);
+  EXPECT_FLOAT_EQ(dequantized.float_values[0], 0.0f);
+  EXPECT_FLOAT_EQ(dequantized.float_values[1], 1.0f);
+  EXPECT_FLOAT_EQ(dequantized.float_values[2], 5.0f);
+}
+
+TEST(SDKScalarQuantizerTest, QuantizeVectorsInPlace) {
+  ScalarQuantizer quantizer;
+  ASSERT_TRUE(quantizer.Init({0.0f, 0.0f}, {1.0f, 2.0f}).ok());
+
+  std::vector<VectorWithId> vectors;
+  vectors.emplace_back(1, MakeFloatVector({3.0f, 4.0f}));
+  vectors.emplace_back(2, MakeFloatVector({10.0f, 10.0f}));
+  ASSERT_TRUE(quantizer.Quantize(vectors).ok());
+
+  EXPECT_EQ(vectors[0].vector.binary_values, std::vector<uint8_t>({3, 2}));
+  EXPECT_EQ(vectors[1].vector.binary_values, std::vector<uint8_t>({10, 5}));
+}
+
+TEST(SDKScalarQuantizerTest, InvalidArgument) {
+  ScalarQuantizer quantizer;
+  Vector out;
+  EXPECT_TRUE(quantizer.Quantize(MakeFloatVector({1.0f}), out).IsIllegalState());
+
+  EXPECT_TRUE(quantizer.Train({}).IsInvalidArgument());
+  EXPECT_TRUE(quantizer.Train({MakeFloatVector({1.0f}), MakeFloatVector({1.0f, 2.0f})}).IsInvalidArgument());
+  EXPECT_TRUE(quantizer.Init({0.0f}, {0.0f}).IsInvalidArgument());
+  EXPECT_TRUE(quantizer.Init({0.0f, 1.0f}, {1.0f}).IsInvalidArgument());
+
+  ASSERT_TRUE(quantizer.Init({0.0f, 0.0f}, {1.0f, 1.0f}).ok());
+  EXPECT_TRUE(quantizer.Quantize(MakeFloatVector({1.0f}), out).IsInvalidArgument());
+  EXPECT_TRUE(quantizer.Dequantize(MakeFloatVector({1.0f, 2.0f}), out).IsInvalidArgument());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
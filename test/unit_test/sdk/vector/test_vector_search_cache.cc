@@ -0,0 +1,116 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_search_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+static std::vector<SearchResult> MakeResult(int64_t vector_id) {
+  VectorWithDistance distance;
+  distance.vector_data.id = vector_id;
+  distance.distance = 1.0f;
+
+  SearchResult search_result;
+  search_result.vector_datas.push_back(distance);
+  return {search_result};
+}
+
+TEST(SDKVectorSearchCacheTest, Disabled) {
+  VectorSearchCache cache(0, 1000);
+  EXPECT_FALSE(cache.Enabled());
+
+  cache.Put(1, "key", MakeResult(10), cache.IndexVersion(1));
+  std::vector<SearchResult> result;
+  EXPECT_FALSE(cache.Get(1, "key", result));
+}
+
+TEST(SDKVectorSearchCacheTest, GetAndPut) {
+  VectorSearchCache cache(1024 * 1024, 60 * 1000);
+
+  std::vector<SearchResult> result;
+  EXPECT_FALSE(cache.Get(1, "key", result));
+
+  cache.Put(1, "key", MakeResult(10), cache.IndexVersion(1));
+  ASSERT_TRUE(cache.Get(1, "key", result));
+  ASSERT_EQ(result.size(), 1);
+  ASSERT_EQ(result[0].vector_datas.size(), 1);
+  EXPECT_EQ(result[0].vector_datas[0].vector_data.id, 10);
+
+  // same key of another index
+  EXPECT_FALSE(cache.Get(2, "key", result));
+}
+
+TEST(SDKVectorSearchCacheTest, InvalidateIndex) {
+  VectorSearchCache cache(1024 * 1024, 60 * 1000);
+
+  cache.Put(1, "key", MakeResult(10), cache.IndexVersion(1));
+  cache.Put(2, "key", MakeResult(20), cache.IndexVersion(2));
+  cache.InvalidateIndex(1);
+
+  std::vector<SearchResult> result;
+  EXPECT_FALSE(cache.Get(1, "key", result));
+  EXPECT_TRUE(cache.Get(2, "key", result));
+
+  // search started before write is not cached
+  uint64_t version = cache.IndexVersion(1);
+  cache.InvalidateIndex(1);
+  cache.Put(1, "key", MakeResult(10), version);
+  EXPECT_FALSE(cache.Get(1, "key", result));
+}
+
+TEST(SDKVectorSearchCacheTest, Expire) {
+  VectorSearchCache cache(1024 * 1024, 10);
+
+  cache.Put(1, "key", MakeResult(10), cache.IndexVersion(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  std::vector<SearchResult> result;
+  EXPECT_FALSE(cache.Get(1, "key", result));
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST(SDKVectorSearchCacheTest, EvictByBytes) {
+  VectorSearchCache probe(1024 * 1024, 60 * 1000);
+  probe.Put(1, "key0", MakeResult(10), 0);
+  int64_t entry_bytes = probe.Bytes();
+  ASSERT_GT(entry_bytes, 0);
+
+  // room for two entries
+  VectorSearchCache cache(entry_bytes * 2, 60 * 1000);
+  cache.Put(1, "key0", MakeResult(10), 0);
+  cache.Put(1, "key1", MakeResult(11), 0);
+
+  std::vector<SearchResult> result;
+  // key0 becomes the most recently used
+  EXPECT_TRUE(cache.Get(1, "key0", result));
+  cache.Put(1, "key2", MakeResult(12), 0);
+
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_LE(cache.Bytes(), entry_bytes * 2);
+  EXPECT_TRUE(cache.Get(1, "key0", result));
+  EXPECT_FALSE(cache.Get(1, "key1", result));
+  EXPECT_TRUE(cache.Get(1, "key2", result));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
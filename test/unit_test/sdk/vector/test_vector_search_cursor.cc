@@ -0,0 +1,133 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/status.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_search_cursor_internal_data.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKVectorSearchCursorTest : public TestBase {
+ public:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+static std::vector<VectorWithDistance> MakeHits(int64_t start_id, int64_t count) {
+  std::vector<VectorWithDistance> hits;
+  for (int64_t id = start_id; id < start_id + count; id++) {
+    VectorWithDistance hit;
+    hit.vector_data.id = id;
+    hit.distance = static_cast<float>(id);
+    hits.push_back(hit);
+  }
+  return hits;
+}
+
+static std::vector<int64_t> PageIds(const std::vector<VectorWithDistance>& page) {
+  std::vector<int64_t> ids;
+  for (const auto& hit : page) {
+    ids.push_back(hit.vector_data.id);
+  }
+  return ids;
+}
+
+TEST_F(SDKVectorSearchCursorTest, InitInvalid) {
+  SearchParam param;
+  VectorWithId target(0, Vector(ValueType::kFloat, 2));
+  {
+    VectorSearchCursor::Data data(*stub, 1, 0);
+    EXPECT_TRUE(data.Init(param, target).IsInvalidArgument());
+  }
+  {
+    VectorSearchCursor::Data data(*stub, 1, 10);
+    param.enable_range_search = true;
+    EXPECT_TRUE(data.Init(param, target).IsInvalidArgument());
+  }
+  {
+    VectorSearchCursor::Data data(*stub, 1, 10);
+    param.enable_range_search = false;
+    param.columnar = true;
+    EXPECT_TRUE(data.Init(param, target).IsInvalidArgument());
+  }
+}
+
+TEST_F(SDKVectorSearchCursorTest, PagesFromKeptHits) {
+  VectorSearchCursor::Data data(*stub, 1, 3);
+  EXPECT_FALSE(data.PageReady());
+  EXPECT_FALSE(data.Finished());
+
+  auto hits = MakeHits(1, 8);
+  data.Refill(hits, 8, 0);
+  EXPECT_FALSE(data.exhausted);
+
+  std::vector<VectorWithDistance> page;
+  ASSERT_TRUE(data.PageReady());
+  data.TakePage(page);
+  EXPECT_EQ(PageIds(page), std::vector<int64_t>({1, 2, 3}));
+
+  page.clear();
+  ASSERT_TRUE(data.PageReady());
+  data.TakePage(page);
+  EXPECT_EQ(PageIds(page), std::vector<int64_t>({4, 5, 6}));
+
+  // 2 kept hits are not a page, search again
+  EXPECT_FALSE(data.PageReady());
+}
+
+TEST_F(SDKVectorSearchCursorTest, RefillSkipsReturned) {
+  VectorSearchCursor::Data data(*stub, 1, 3);
+
+  auto hits = MakeHits(1, 4);
+  data.Refill(hits, 4, 0);
+  std::vector<VectorWithDistance> page;
+  data.TakePage(page);
+
+  // deeper search returns the first hits again, less than topk means no more
+  hits = MakeHits(1, 6);
+  data.Refill(hits, 8, 0);
+  EXPECT_TRUE(data.exhausted);
+  EXPECT_TRUE(data.PageReady());
+
+  page.clear();
+  data.TakePage(page);
+  EXPECT_EQ(PageIds(page), std::vector<int64_t>({4, 5, 6}));
+  EXPECT_TRUE(data.Finished());
+}
+
+TEST_F(SDKVectorSearchCursorTest, ExpireHits) {
+  VectorSearchCursor::Data data(*stub, 1, 3);
+
+  auto hits = MakeHits(1, 2);
+  data.Refill(hits, 4, 100);
+  EXPECT_TRUE(data.exhausted);
+
+  data.ExpireHits(150, 100);
+  EXPECT_TRUE(data.PageReady());
+
+  data.ExpireHits(300, 100);
+  EXPECT_TRUE(data.hits.empty());
+  EXPECT_FALSE(data.exhausted);
+  EXPECT_FALSE(data.PageReady());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,1037 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/filter.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_request_template.h"
+#include "sdk/vector.h"
+#include "sdk/vector/vector_batch_query_task.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_distance.h"
+#include "sdk/vector/vector_helper.h"
+#include "sdk/vector/vector_multi_search_task.h"
+#include "sdk/vector/vector_range_search_task.h"
+#include "sdk/vector/vector_search_task.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const int64_t kIndexId = 2;
+
+// partition of ids: [1,5) -> 1st part, [5,10) -> 2nd part, [10,20) -> 3rd part, [20,) -> 4th part
+static std::shared_ptr<VectorIndex> CreateFakeVectorIndex(const std::string& index_name,
+                                                          const std::vector<int64_t>& index_and_part_ids) {
+  int64_t schema_id{2};
+  int64_t index_id = index_and_part_ids[0];
+  std::vector<int64_t> range_seperator_ids = {5, 10, 20};
+  FlatParam flat_param{2, dingodb::sdk::MetricType::kL2};
+
+  pb::meta::IndexDefinitionWithId index_definition_with_id;
+  FillVectorIndexId(index_definition_with_id.mutable_index_id(), index_id, schema_id);
+  auto* defination = index_definition_with_id.mutable_index_definition();
+  defination->set_name(index_name);
+  FillRangePartitionRule(defination->mutable_index_partition(), range_seperator_ids, index_and_part_ids);
+  defination->set_replica(3);
+
+  auto* index_parameter = defination->mutable_index_parameter();
+  index_parameter->set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+  FillFlatParmeter(index_parameter->mutable_vector_index_parameter(), flat_param);
+
+  return std::make_shared<VectorIndex>(index_definition_with_id);
+}
+
+// target vector i is {i, i}
+static std::vector<VectorWithId> TargetVectors(int count) {
+  std::vector<VectorWithId> targets;
+  for (int i = 0; i < count; i++) {
+    Vector vector(ValueType::kFloat, 2);
+    vector.float_values = {static_cast<float>(i), static_cast<float>(i)};
+    targets.emplace_back(vector);
+  }
+  return targets;
+}
+
+static std::vector<int64_t> HitIds(const SearchResult& result) {
+  std::vector<int64_t> ids;
+  for (const auto& distance : result.vector_datas) {
+    ids.push_back(distance.vector_data.id);
+  }
+  return ids;
+}
+
+static std::vector<float> HitDistances(const std::vector<VectorWithDistance>& hits) {
+  std::vector<float> distances;
+  for (const auto& distance : hits) {
+    distances.push_back(distance.distance);
+  }
+  return distances;
+}
+
+static std::vector<float> HitDistances(const SearchResult& result) { return HitDistances(result.vector_datas); }
+
+class SDKVectorSearchTaskTest : public TestBase {
+ public:
+  struct Hit {
+    int64_t id;
+    float distance;
+  };
+
+  void SetUp() override {
+    EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([this](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<GetIndexRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+
+      std::lock_guard<std::mutex> guard(mutex);
+      auto iter = indexes.find(t_rpc->Request()->index_id().entity_id());
+      if (iter == indexes.end()) {
+        return Status::NotFound("index not found");
+      }
+      *(t_rpc->MutableResponse()->mutable_index_definition_with_id()) = iter->second->GetIndexDefWithId();
+      return Status::OK();
+    });
+
+    EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([this](Rpc& rpc, std::function<void()> cb) {
+      auto* query_rpc = dynamic_cast<VectorBatchQueryRpc*>(&rpc);
+      if (query_rpc != nullptr) {
+        AnswerQuery(*query_rpc->Request(), query_rpc->MutableResponse());
+      } else {
+        auto* search_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+        CHECK_NOTNULL(search_rpc);
+        AnswerSearch(*search_rpc->Request(), search_rpc->MutableResponse());
+      }
+
+      // answered in another thread as rpc callbacks are
+      actuator->Execute(std::move(cb));
+    });
+
+    vector_index = CreateFakeVectorIndex("test", {kIndexId, 3, 4, 5, 6});
+    AddFakeVectorIndex(vector_index);
+  }
+
+  void TearDown() override {
+    FLAGS_vector_search_batch_max_count = 0;
+    FLAGS_vector_search_batch_max_bytes = 0;
+    FLAGS_vector_search_two_phase_fetch = false;
+    FLAGS_vector_search_client_exact_max_ids = 0;
+  }
+
+  // one region per partition, region id is part id * 100 and epoch version is region id
+  void AddFakeVectorIndex(const std::shared_ptr<VectorIndex>& index) {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      indexes[index->GetId()] = index;
+    }
+
+    for (const auto& partition : index->GetIndexDefWithId().index_definition().index_partition().partitions()) {
+      AddRegion(partition.id().entity_id() * 100, partition.range());
+    }
+  }
+
+  void AddRegion(int64_t region_id, const pb::common::Range& range) {
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(region_id);
+    epoch.set_conf_version(1);
+    meta_cache->MaybeAddRegion(GenRegion(region_id, range, epoch, pb::common::RegionType::INDEX_REGION));
+  }
+
+  // a region in failed_region_ids answers an error, otherwise every target vector of request gets region_hits of
+  // the region, distances of target vector i are shifted by i, vector data of hit id is {id, id}
+  void AnswerSearch(const pb::index::VectorSearchRequest& request, pb::index::VectorSearchResponse* response) {
+    std::lock_guard<std::mutex> guard(mutex);
+    search_requests.push_back(request);
+
+    if (failed_region_ids.count(request.context().region_id()) > 0) {
+      response->mutable_error()->set_errcode(pb::error::EINTERNAL);
+      return;
+    }
+
+    auto iter = region_hits.find(request.context().region_id());
+    for (const auto& target : request.vector_with_ids()) {
+      auto* batch_result = response->add_batch_results();
+      if (iter == region_hits.end()) {
+        continue;
+      }
+
+      float shift = target.vector().float_values(0);
+      for (const auto& hit : iter->second) {
+        auto* distance = batch_result->add_vector_with_distances();
+        auto* vector_with_id = distance->mutable_vector_with_id();
+        vector_with_id->set_id(hit.id);
+        if (!request.parameter().without_vector_data()) {
+          auto* vector = vector_with_id->mutable_vector();
+          vector->set_dimension(2);
+          vector->set_value_type(pb::common::ValueType::FLOAT);
+          vector->add_float_values(hit.id);
+          vector->add_float_values(hit.id);
+        }
+        distance->set_distance(hit.distance + shift);
+        distance->set_metric_type(pb::common::MetricType::METRIC_TYPE_L2);
+      }
+    }
+  }
+
+  // vector of id is {id, id} and scalar "key" is id, a deleted id is answered with id 0
+  void AnswerQuery(const pb::index::VectorBatchQueryRequest& request, pb::index::VectorBatchQueryResponse* response) {
+    std::lock_guard<std::mutex> guard(mutex);
+    query_requests.push_back(request);
+
+    for (const auto& id : request.vector_ids()) {
+      auto* vector_with_id = response->add_vectors();
+      if (deleted_ids.count(id) > 0) {
+        continue;
+      }
+
+      vector_with_id->set_id(id);
+      if (!request.without_vector_data()) {
+        auto* vector = vector_with_id->mutable_vector();
+        vector->set_dimension(2);
+        vector->set_value_type(pb::common::ValueType::FLOAT);
+        vector->add_float_values(id);
+        vector->add_float_values(id);
+      }
+      if (!request.without_scalar_data()) {
+        pb::common::ScalarValue value;
+        value.set_field_type(pb::common::ScalarFieldType::INT64);
+        value.add_fields()->set_long_data(id);
+        vector_with_id->mutable_scalar_data()->mutable_scalar_data()->insert({"key", value});
+      }
+    }
+  }
+
+  // replace the region of part with two regions split at vector id
+  void SplitPartitionRegion(int64_t part_id, int64_t split_id, int64_t left_region_id, int64_t right_region_id) {
+    pb::common::Range range;
+    for (const auto& partition :
+         vector_index->GetIndexDefWithId().index_definition().index_partition().partitions()) {
+      if (partition.id().entity_id() == part_id) {
+        range = partition.range();
+      }
+    }
+
+    std::string split_key = vector_helper::VectorIdToRangeKey(*vector_index, split_id);
+    pb::common::Range left = range;
+    left.set_end_key(split_key);
+    pb::common::Range right = range;
+    right.set_start_key(split_key);
+    AddRegion(left_region_id, left);
+    AddRegion(right_region_id, right);
+  }
+
+  std::set<int64_t> SearchedRegionIds() {
+    std::lock_guard<std::mutex> guard(mutex);
+    std::set<int64_t> region_ids;
+    for (const auto& request : search_requests) {
+      region_ids.insert(request.context().region_id());
+    }
+    return region_ids;
+  }
+
+  std::shared_ptr<VectorIndex> vector_index;
+
+  std::mutex mutex;
+  std::map<int64_t, std::shared_ptr<VectorIndex>> indexes;
+  std::map<int64_t, std::vector<Hit>> region_hits;
+  std::vector<pb::index::VectorSearchRequest> search_requests;
+  std::set<int64_t> failed_region_ids;
+  std::set<int64_t> deleted_ids;
+  std::vector<pb::index::VectorBatchQueryRequest> query_requests;
+};
+
+TEST_F(SDKVectorSearchTaskTest, EmptyTargetVectors) {
+  SearchParam param;
+  param.topk = 3;
+  std::vector<VectorWithId> targets;
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  EXPECT_TRUE(task.Run().IsInvalidArgument());
+  EXPECT_TRUE(search_requests.empty());
+}
+
+TEST_F(SDKVectorSearchTaskTest, FanOutToEveryPartition) {
+  region_hits = {{300, {{1, 0.3}, {2, 0.9}}},
+                 {400, {{5, 0.1}, {6, 0.7}}},
+                 {500, {{10, 0.5}}},
+                 {600, {{20, 0.2}, {21, 0.8}}}};
+
+  SearchParam param;
+  param.topk = 4;
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // one rpc per region of every partition
+  EXPECT_EQ(search_requests.size(), 4);
+  EXPECT_EQ(SearchedRegionIds(), std::set<int64_t>({300, 400, 500, 600}));
+
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(HitIds(results[0]), std::vector<int64_t>({5, 20, 1, 10}));
+  EXPECT_EQ(HitDistances(results[0]), std::vector<float>({0.1, 0.2, 0.3, 0.5}));
+  EXPECT_EQ(results[0].vector_datas[0].vector_data.vector.float_values, std::vector<float>({5, 5}));
+  EXPECT_TRUE(results[0].missing_part_ids.empty());
+}
+
+TEST_F(SDKVectorSearchTaskTest, SplitTargetVectorsIntoBatches) {
+  FLAGS_vector_search_batch_max_count = 2;
+  region_hits = {{300, {{1, 0.3}}}, {400, {{5, 0.1}}}, {500, {{10, 0.5}}}, {600, {{20, 0.2}}}};
+
+  SearchParam param;
+  param.topk = 2;
+  auto targets = TargetVectors(5);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // batches of 2, 2 and 1 target vectors to each of 4 regions
+  ASSERT_EQ(search_requests.size(), 12);
+  std::map<int64_t, std::multiset<int>> region_batch_sizes;
+  for (const auto& request : search_requests) {
+    region_batch_sizes[request.context().region_id()].insert(request.vector_with_ids_size());
+  }
+  EXPECT_EQ(region_batch_sizes.size(), 4);
+  for (const auto& [region_id, batch_sizes] : region_batch_sizes) {
+    EXPECT_EQ(batch_sizes, std::multiset<int>({1, 2, 2})) << "region:" << region_id;
+  }
+
+  // hits of every batch go back to their own target vectors
+  ASSERT_EQ(results.size(), targets.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i].id.vector.float_values, targets[i].vector.float_values);
+    EXPECT_EQ(HitIds(results[i]), std::vector<int64_t>({5, 20}));
+    EXPECT_EQ(HitDistances(results[i]), std::vector<float>({0.1f + i, 0.2f + i}));
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, MergeInterleavedPartitionsIntoTopK) {
+  // distances of partitions interleave and tie, none of them holds a prefix of the topk
+  region_hits = {{300, {{1, 0.1}, {2, 0.5}, {3, 0.9}}},
+                 {400, {{5, 0.2}, {6, 0.5}, {7, 0.8}}},
+                 {500, {{10, 0.3}, {11, 0.4}, {12, 1.0}}},
+                 {600, {{20, 0.05}, {21, 0.6}, {22, 0.7}}}};
+
+  SearchParam param;
+  param.topk = 5;
+  auto targets = TargetVectors(3);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  ASSERT_EQ(results.size(), targets.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& distances = HitDistances(results[i]);
+    ASSERT_EQ(distances.size(), 5);
+    EXPECT_TRUE(std::is_sorted(distances.begin(), distances.end()));
+    EXPECT_EQ(HitIds(results[i]), std::vector<int64_t>({20, 1, 5, 10, 11}));
+    EXPECT_FLOAT_EQ(distances.back(), 0.4f + i);
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, TopKLargerThanHits) {
+  region_hits = {{300, {{1, 0.3}}}, {500, {{10, 0.1}, {11, 0.2}}}};
+
+  SearchParam param;
+  param.topk = 10;
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(HitIds(results[0]), std::vector<int64_t>({10, 11, 1}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, UnboundedSearchKeepsAllHits) {
+  region_hits = {{300, {{1, 0.4}, {2, 0.1}}}, {400, {{5, 0.3}}}, {600, {{20, 0.2}, {21, 0.5}}}};
+
+  for (bool enable_range_search : {true, false}) {
+    SearchParam param;
+    if (enable_range_search) {
+      param.topk = 2;
+      param.enable_range_search = true;
+      param.radius = 1.0;
+    } else {
+      param.topk = 0;
+    }
+    auto targets = TargetVectors(1);
+    std::vector<SearchResult> results;
+
+    VectorSearchTask task(*stub, kIndexId, param, targets, results);
+    ASSERT_TRUE(task.Run().ok());
+
+    // no bound by topk, hits of all partitions sorted by distance
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(HitIds(results[0]), std::vector<int64_t>({2, 20, 5, 1, 21})) << "range search:" << enable_range_search;
+  }
+}
+
+static std::vector<RequestTemplate<pb::index::VectorSearchRequest>> SearchRequestTemplates(
+    const std::vector<VectorWithId>& targets, int64_t top_n) {
+  std::vector<RequestTemplate<pb::index::VectorSearchRequest>> request_templates(1);
+  auto* request = request_templates[0].Mutable();
+  request->mutable_parameter()->set_top_n(top_n);
+  for (const auto& target : targets) {
+    FillVectorWithIdPB(request->add_vector_with_ids(), target, false);
+  }
+  return request_templates;
+}
+
+static std::vector<int64_t> SortedHitIds(std::vector<VectorWithDistance> hits) {
+  std::sort(hits.begin(), hits.end(),
+            [](const VectorWithDistance& a, const VectorWithDistance& b) { return a.distance < b.distance; });
+  std::vector<int64_t> ids;
+  for (const auto& hit : hits) {
+    ids.push_back(hit.vector_data.id);
+  }
+  return ids;
+}
+
+TEST_F(SDKVectorSearchTaskTest, PartTaskSkipsCandidatesWorseThanThreshold) {
+  region_hits = {{300, {{1, 0.1}, {2, 0.4}, {3, 0.6}, {4, 0.2}}}};
+
+  auto targets = TargetVectors(2);
+  auto request_templates = SearchRequestTemplates(targets, 2);
+  std::vector<int64_t> batch_offsets = {0};
+  // other partitions already have topk of target 0 not farther than 0.15, target 1 has none yet
+  std::vector<std::atomic<float>> distance_thresholds(targets.size());
+  distance_thresholds[0].store(0.15);
+  distance_thresholds[1].store(std::numeric_limits<float>::max());
+
+  VectorSearchPartTask task(*stub, vector_index, 3, request_templates, batch_offsets, distance_thresholds);
+  ASSERT_TRUE(task.Run().ok());
+
+  ASSERT_EQ(search_requests.size(), 1);
+  EXPECT_EQ(search_requests[0].context().region_id(), 300);
+
+  auto& search_result = task.GetSearchResult();
+  ASSERT_EQ(search_result.size(), 2);
+  // only candidates better than the threshold, at most top_n of them
+  EXPECT_EQ(SortedHitIds(search_result[0]), std::vector<int64_t>({1}));
+  EXPECT_EQ(SortedHitIds(search_result[1]), std::vector<int64_t>({1, 4}));
+  EXPECT_EQ(search_result[1][0].vector_data.vector.float_values.size(), 2);
+}
+
+TEST_F(SDKVectorSearchTaskTest, PartTaskKeepsResponsesUnconverted) {
+  region_hits = {{300, {{1, 0.1}, {2, 0.4}, {4, 0.2}}}};
+
+  auto targets = TargetVectors(1);
+  auto request_templates = SearchRequestTemplates(targets, 2);
+  std::vector<int64_t> batch_offsets = {0};
+  std::vector<std::atomic<float>> distance_thresholds(targets.size());
+  distance_thresholds[0].store(std::numeric_limits<float>::max());
+
+  VectorSearchPartTask task(*stub, vector_index, 3, request_templates, batch_offsets, distance_thresholds, nullptr,
+                            true);
+  ASSERT_TRUE(task.Run().ok());
+
+  // candidates point into the responses, nothing is converted
+  EXPECT_TRUE(task.GetSearchResult().empty());
+  auto& candidates = task.GetCandidates();
+  ASSERT_EQ(candidates.size(), 1);
+  ASSERT_EQ(candidates[0].size(), 2);
+
+  auto responses = task.TakeResponses();
+  ASSERT_NE(responses, nullptr);
+  std::set<int64_t> ids;
+  for (const auto* candidate : candidates[0]) {
+    ids.insert(candidate->vector_with_id().id());
+  }
+  EXPECT_EQ(ids, std::set<int64_t>({1, 4}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, TwoPhaseFetchPayloadOfTopK) {
+  FLAGS_vector_search_two_phase_fetch = true;
+  region_hits = {{300, {{1, 0.1}, {2, 0.9}}},
+                 {400, {{5, 0.2}, {6, 0.8}}},
+                 {500, {{10, 0.3}, {11, 0.7}}},
+                 {600, {{20, 0.4}, {21, 0.6}}}};
+  // deleted between search and fetch
+  deleted_ids = {10};
+
+  SearchParam param;
+  param.topk = 3;
+  param.with_scalar_data = true;
+  auto targets = TargetVectors(2);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // candidates are searched without payload
+  ASSERT_EQ(search_requests.size(), 4);
+  for (const auto& request : search_requests) {
+    EXPECT_TRUE(request.parameter().without_vector_data());
+    EXPECT_TRUE(request.parameter().without_scalar_data());
+    EXPECT_TRUE(request.parameter().without_table_data());
+  }
+
+  // payload of the final topk only, ids shared by target vectors are queried once
+  std::multiset<int64_t> queried_ids;
+  for (const auto& request : query_requests) {
+    queried_ids.insert(request.vector_ids().begin(), request.vector_ids().end());
+  }
+  EXPECT_EQ(queried_ids, std::multiset<int64_t>({1, 5, 10}));
+
+  ASSERT_EQ(results.size(), targets.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& hits = results[i].vector_datas;
+    EXPECT_EQ(HitIds(results[i]), std::vector<int64_t>({1, 5, 10}));
+    EXPECT_EQ(HitDistances(results[i]), std::vector<float>({0.1f + i, 0.2f + i, 0.3f + i}));
+
+    for (size_t j = 0; j < 2; j++) {
+      auto id = hits[j].vector_data.id;
+      auto value = static_cast<float>(id);
+      EXPECT_EQ(hits[j].vector_data.vector.float_values, std::vector<float>({value, value}));
+      ASSERT_EQ(hits[j].vector_data.scalar_data.count("key"), 1);
+      EXPECT_EQ(hits[j].vector_data.scalar_data.at("key").fields[0].long_data, id);
+    }
+
+    // a deleted one keeps id and distance only
+    EXPECT_TRUE(hits[2].vector_data.vector.float_values.empty());
+    EXPECT_TRUE(hits[2].vector_data.scalar_data.empty());
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, TargetVectorsEncodedOnceForAllRegions) {
+  SearchParam param;
+  param.topk = 3;
+  auto targets = TargetVectors(3);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  pb::index::VectorSearchRequest expected;
+  for (const auto& target : targets) {
+    FillVectorWithIdPB(expected.add_vector_with_ids(), target, false);
+  }
+
+  // every region gets the same encoded target vectors and parameter
+  ASSERT_EQ(search_requests.size(), 4);
+  for (const auto& request : search_requests) {
+    ASSERT_EQ(request.vector_with_ids_size(), expected.vector_with_ids_size());
+    for (int i = 0; i < request.vector_with_ids_size(); i++) {
+      EXPECT_EQ(request.vector_with_ids(i).SerializeAsString(), expected.vector_with_ids(i).SerializeAsString());
+    }
+    EXPECT_EQ(request.parameter().SerializeAsString(), search_requests[0].parameter().SerializeAsString());
+    EXPECT_EQ(request.parameter().top_n(), param.topk);
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, RequestTemplateFillsRegionContext) {
+  SearchParam param;
+  param.topk = 3;
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> search_results;
+
+  VectorSearchTask search_task(*stub, kIndexId, param, targets, search_results);
+  ASSERT_TRUE(search_task.Run().ok());
+
+  QueryParam query_param;
+  query_param.vector_ids = {1, 5, 10, 20};
+  QueryResult query_result;
+
+  VectorBatchQueryTask query_task(*stub, kIndexId, query_param, query_result);
+  ASSERT_TRUE(query_task.Run().ok());
+  EXPECT_EQ(query_result.vectors.size(), query_param.vector_ids.size());
+
+  // requests copied from one template differ only in region id and epoch
+  ASSERT_EQ(search_requests.size(), 4);
+  for (const auto& request : search_requests) {
+    int64_t region_id = request.context().region_id();
+    EXPECT_EQ(request.context().region_epoch().version(), region_id);
+    EXPECT_EQ(request.context().region_epoch().conf_version(), 1);
+  }
+
+  ASSERT_EQ(query_requests.size(), 4);
+  std::set<int64_t> queried_region_ids;
+  for (const auto& request : query_requests) {
+    int64_t region_id = request.context().region_id();
+    queried_region_ids.insert(region_id);
+    EXPECT_EQ(request.context().region_epoch().version(), region_id);
+    ASSERT_EQ(request.vector_ids_size(), 1);
+    EXPECT_EQ(vector_index->GetPartitionId(request.vector_ids(0)) * 100, region_id);
+  }
+  EXPECT_EQ(queried_region_ids, std::set<int64_t>({300, 400, 500, 600}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, PrunePartitionsByVectorIds) {
+  region_hits = {{300, {{1, 0.3}}}, {400, {{6, 0.1}, {7, 0.2}}}};
+
+  SearchParam param;
+  param.topk = 3;
+  param.filter_source = FilterSource::kVectorIdFilter;
+  param.vector_ids = {1, 6, 7};
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // partitions without any of the ids are not searched
+  EXPECT_EQ(SearchedRegionIds(), std::set<int64_t>({300, 400}));
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(HitIds(results[0]), std::vector<int64_t>({6, 7, 1}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, PruneRegionsByVectorIds) {
+  SplitPartitionRegion(5, 15, 510, 520);
+
+  {
+    SearchParam param;
+    param.topk = 3;
+    param.filter_source = FilterSource::kVectorIdFilter;
+    param.vector_ids = {12, 13};
+    auto targets = TargetVectors(1);
+    std::vector<SearchResult> results;
+
+    VectorSearchTask task(*stub, kIndexId, param, targets, results);
+    ASSERT_TRUE(task.Run().ok());
+    EXPECT_EQ(SearchedRegionIds(), std::set<int64_t>({510}));
+  }
+
+  search_requests.clear();
+
+  {
+    SearchParam param;
+    param.topk = 3;
+    param.filter_source = FilterSource::kVectorIdFilter;
+    param.vector_ids = {12, 16};
+    auto targets = TargetVectors(1);
+    std::vector<SearchResult> results;
+
+    VectorSearchTask task(*stub, kIndexId, param, targets, results);
+    ASSERT_TRUE(task.Run().ok());
+    EXPECT_EQ(SearchedRegionIds(), std::set<int64_t>({510, 520}));
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, NegationSearchesAllPartitions) {
+  SearchParam param;
+  param.topk = 3;
+  param.filter_source = FilterSource::kVectorIdFilter;
+  param.is_negation = true;
+  param.vector_ids = {1, 6};
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // excluded ids tell nothing about where candidates are
+  EXPECT_EQ(SearchedRegionIds(), std::set<int64_t>({300, 400, 500, 600}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, InvalidVectorIdsSearchNothing) {
+  SearchParam param;
+  param.topk = 3;
+  param.filter_source = FilterSource::kVectorIdFilter;
+  param.vector_ids = {0, -1};
+  auto targets = TargetVectors(2);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  EXPECT_TRUE(search_requests.empty());
+  ASSERT_EQ(results.size(), targets.size());
+  for (const auto& result : results) {
+    EXPECT_TRUE(result.vector_datas.empty());
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, SplitTargetVectorsIntoBatchesByBytes) {
+  region_hits = {{300, {{1, 0.3}}}, {600, {{20, 0.2}}}};
+  auto targets = TargetVectors(5);
+
+  // a batch is full once it reaches the bytes of two target vectors
+  pb::common::VectorWithId encoded;
+  FillVectorWithIdPB(&encoded, targets[0], false);
+  FLAGS_vector_search_batch_max_bytes = 2 * encoded.ByteSizeLong();
+
+  SearchParam param;
+  param.topk = 2;
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  ASSERT_EQ(search_requests.size(), 12);
+  std::map<int64_t, std::multiset<int>> region_batch_sizes;
+  for (const auto& request : search_requests) {
+    region_batch_sizes[request.context().region_id()].insert(request.vector_with_ids_size());
+  }
+  for (const auto& [region_id, batch_sizes] : region_batch_sizes) {
+    EXPECT_EQ(batch_sizes, std::multiset<int>({1, 2, 2})) << "region:" << region_id;
+  }
+
+  ASSERT_EQ(results.size(), targets.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(HitIds(results[i]), std::vector<int64_t>({20, 1}));
+    EXPECT_EQ(HitDistances(results[i]), std::vector<float>({0.2f + i, 0.3f + i}));
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, BatchFullByCountOrBytes) {
+  auto targets = TargetVectors(3);
+  // bytes allow all target vectors in one batch, count does not
+  FLAGS_vector_search_batch_max_bytes = 1024 * 1024;
+  FLAGS_vector_search_batch_max_count = 1;
+
+  SearchParam param;
+  param.topk = 2;
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  ASSERT_EQ(search_requests.size(), 12);
+  for (const auto& request : search_requests) {
+    EXPECT_EQ(request.vector_with_ids_size(), 1);
+  }
+  EXPECT_EQ(results.size(), targets.size());
+}
+
+TEST_F(SDKVectorSearchTaskTest, SearchIntoResultView) {
+  region_hits = {{300, {{1, 0.1}, {2, 0.5}}},
+                 {400, {{5, 0.2}, {6, 0.6}}},
+                 {500, {{10, 0.3}, {11, 0.4}}},
+                 {600, {{20, 0.05}}}};
+
+  SearchParam param;
+  param.topk = 4;
+  auto targets = TargetVectors(2);
+  SearchResultView view;
+
+  {
+    VectorSearchTask task(*stub, kIndexId, param, targets, view);
+    ASSERT_TRUE(task.Run().ok());
+  }
+
+  // hits outlive the task, the view owns the responses
+  ASSERT_EQ(view.TargetCount(), static_cast<int64_t>(targets.size()));
+  for (int64_t target = 0; target < view.TargetCount(); target++) {
+    ASSERT_EQ(view.HitCount(target), 4);
+    std::vector<int64_t> ids;
+    std::vector<float> distances;
+    for (int64_t hit = 0; hit < view.HitCount(target); hit++) {
+      ids.push_back(view.GetId(target, hit));
+      distances.push_back(view.GetDistance(target, hit));
+    }
+    EXPECT_EQ(ids, std::vector<int64_t>({20, 1, 5, 10}));
+    EXPECT_EQ(distances, std::vector<float>({0.05f + target, 0.1f + target, 0.2f + target, 0.3f + target}));
+    EXPECT_EQ(view.GetVector(target, 1).float_values, std::vector<float>({1, 1}));
+  }
+
+  auto results = view.ToSearchResults();
+  ASSERT_EQ(results.size(), targets.size());
+  EXPECT_EQ(HitIds(results[1]), std::vector<int64_t>({20, 1, 5, 10}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, ResultViewRejectsPostFilterAndPartialResult) {
+  auto targets = TargetVectors(1);
+
+  {
+    SearchParam param;
+    param.topk = 3;
+    param.filter = Filter::Compare(Filter::kEq, "key", int64_t{1});
+    param.post_filter = true;
+    SearchResultView view;
+
+    VectorSearchTask task(*stub, kIndexId, param, targets, view);
+    EXPECT_TRUE(task.Run().IsInvalidArgument());
+  }
+
+  {
+    SearchParam param;
+    param.topk = 3;
+    param.partial_result = true;
+    SearchResultView view;
+
+    VectorSearchTask task(*stub, kIndexId, param, targets, view);
+    EXPECT_TRUE(task.Run().IsInvalidArgument());
+  }
+
+  EXPECT_TRUE(search_requests.empty());
+}
+
+TEST_F(SDKVectorSearchTaskTest, PartialResultWithoutFailedRegion) {
+  SplitPartitionRegion(5, 15, 510, 520);
+  region_hits = {{300, {{1, 0.1}}}, {510, {{10, 0.05}}}, {520, {{16, 0.01}}}, {600, {{20, 0.2}}}};
+  failed_region_ids = {520};
+
+  SearchParam param;
+  param.topk = 3;
+  param.partial_result = true;
+  auto targets = TargetVectors(2);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // the failed region is not retried, topk of the regions answered
+  ASSERT_EQ(results.size(), targets.size());
+  for (const auto& result : results) {
+    EXPECT_EQ(HitIds(result), std::vector<int64_t>({10, 1, 20}));
+    EXPECT_EQ(result.missing_part_ids, std::vector<int64_t>({5}));
+    EXPECT_EQ(result.missing_region_ids, std::vector<int64_t>({520}));
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, FailedRegionFailsSearch) {
+  region_hits = {{300, {{1, 0.1}}}, {600, {{20, 0.2}}}};
+  failed_region_ids = {500};
+
+  SearchParam param;
+  param.topk = 3;
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  EXPECT_FALSE(task.Run().ok());
+}
+
+TEST_F(SDKVectorSearchTaskTest, CompleteResultHasNoMissingParts) {
+  region_hits = {{300, {{1, 0.1}}}, {600, {{20, 0.2}}}};
+
+  SearchParam param;
+  param.topk = 3;
+  param.partial_result = true;
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(HitIds(results[0]), std::vector<int64_t>({1, 20}));
+  EXPECT_TRUE(results[0].missing_part_ids.empty());
+  EXPECT_TRUE(results[0].missing_region_ids.empty());
+}
+
+TEST_F(SDKVectorSearchTaskTest, ClientExactSearchOfFewVectorIds) {
+  FLAGS_vector_search_client_exact_max_ids = 8;
+  deleted_ids = {6};
+
+  SearchParam param;
+  param.topk = 3;
+  param.filter_source = FilterSource::kVectorIdFilter;
+  param.vector_ids = {20, 1, 6, 12, 1};
+  auto targets = TargetVectors(2);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // no index search, the ids are queried once each
+  EXPECT_TRUE(search_requests.empty());
+  std::multiset<int64_t> queried_ids;
+  for (const auto& request : query_requests) {
+    EXPECT_FALSE(request.without_vector_data());
+    queried_ids.insert(request.vector_ids().begin(), request.vector_ids().end());
+  }
+  EXPECT_EQ(queried_ids, std::multiset<int64_t>({1, 6, 12, 20}));
+
+  // exact distances of the vectors not deleted
+  ASSERT_EQ(results.size(), targets.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(HitIds(results[i]), std::vector<int64_t>({1, 12, 20}));
+    const auto& target = targets[i].vector.float_values;
+    for (const auto& hit : results[i].vector_datas) {
+      const auto& values = hit.vector_data.vector.float_values;
+      ASSERT_EQ(values.size(), 2);
+      EXPECT_FLOAT_EQ(hit.distance,
+                      vector_distance::ExactDistance(MetricType::kL2, target.data(), values.data(), values.size()));
+    }
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, ManyVectorIdsSearchIndex) {
+  FLAGS_vector_search_client_exact_max_ids = 2;
+
+  SearchParam param;
+  param.topk = 3;
+  param.filter_source = FilterSource::kVectorIdFilter;
+  param.vector_ids = {1, 6, 12};
+  auto targets = TargetVectors(1);
+  std::vector<SearchResult> results;
+
+  VectorSearchTask task(*stub, kIndexId, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  EXPECT_TRUE(query_requests.empty());
+  EXPECT_EQ(SearchedRegionIds(), std::set<int64_t>({300, 400, 500}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, RangeSearchStreamDeliversEveryRegion) {
+  region_hits = {{300, {{2, 0.9}, {1, 0.3}}},
+                 {400, {{5, 0.1}}},
+                 {500, {{11, 0.7}, {10, 0.5}}},
+                 {600, {{21, 0.8}, {20, 0.2}}}};
+
+  SearchParam param;
+  param.enable_range_search = true;
+  param.radius = 1.0;
+  auto targets = TargetVectors(2);
+  RangeSearchStreamOption option;
+  option.sorted = true;
+
+  int deliveries = 0;
+  std::vector<std::multiset<int64_t>> ids(targets.size());
+  auto handler = [&](std::vector<std::vector<VectorWithDistance>>& hits) {
+    deliveries++;
+    EXPECT_EQ(hits.size(), targets.size());
+    for (size_t i = 0; i < hits.size(); i++) {
+      auto distances = HitDistances(hits[i]);
+      EXPECT_TRUE(std::is_sorted(distances.begin(), distances.end()));
+      for (const auto& hit : hits[i]) {
+        ids[i].insert(hit.vector_data.id);
+      }
+    }
+    return true;
+  };
+
+  VectorRangeSearchTask task(*stub, kIndexId, param, targets, option, handler);
+  ASSERT_TRUE(task.Run().ok());
+
+  // one delivery per region response
+  EXPECT_EQ(search_requests.size(), 4);
+  EXPECT_EQ(deliveries, 4);
+  for (const auto& target_ids : ids) {
+    EXPECT_EQ(target_ids, std::multiset<int64_t>({1, 2, 5, 10, 11, 20, 21}));
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, RangeSearchStreamStopsAtMaxResults) {
+  region_hits = {{300, {{1, 0.3}, {2, 0.9}}},
+                 {400, {{5, 0.1}, {6, 0.6}}},
+                 {500, {{10, 0.5}, {11, 0.7}}},
+                 {600, {{20, 0.2}, {21, 0.8}}}};
+
+  SearchParam param;
+  param.enable_range_search = true;
+  param.radius = 1.0;
+  auto targets = TargetVectors(1);
+  RangeSearchStreamOption option;
+  option.max_results = 3;
+
+  int64_t delivered = 0;
+  VectorRangeSearchTask task(*stub, kIndexId, param, targets, option,
+                             [&](std::vector<std::vector<VectorWithDistance>>& hits) {
+                               delivered += hits[0].size();
+                               return true;
+                             });
+  ASSERT_TRUE(task.Run().ok());
+
+  EXPECT_EQ(delivered, option.max_results);
+}
+
+TEST_F(SDKVectorSearchTaskTest, RangeSearchStreamStopsByHandler) {
+  region_hits = {{300, {{1, 0.3}}}, {400, {{5, 0.1}}}, {500, {{10, 0.5}}}, {600, {{20, 0.2}}}};
+
+  SearchParam param;
+  param.enable_range_search = true;
+  param.radius = 1.0;
+  auto targets = TargetVectors(1);
+  RangeSearchStreamOption option;
+
+  int deliveries = 0;
+  VectorRangeSearchTask task(*stub, kIndexId, param, targets, option,
+                             [&](std::vector<std::vector<VectorWithDistance>>& hits) {
+                               deliveries++;
+                               return false;
+                             });
+  ASSERT_TRUE(task.Run().ok());
+
+  EXPECT_EQ(deliveries, 1);
+}
+
+TEST_F(SDKVectorSearchTaskTest, RangeSearchStreamNeedsRangeSearch) {
+  SearchParam param;
+  param.topk = 3;
+  auto targets = TargetVectors(1);
+  RangeSearchStreamOption option;
+
+  VectorRangeSearchTask task(*stub, kIndexId, param, targets, option,
+                             [](std::vector<std::vector<VectorWithDistance>>& hits) { return true; });
+  EXPECT_TRUE(task.Run().IsInvalidArgument());
+  EXPECT_TRUE(search_requests.empty());
+}
+
+TEST_F(SDKVectorSearchTaskTest, MultiIndexSearch) {
+  int64_t other_index_id = 12;
+  AddFakeVectorIndex(CreateFakeVectorIndex("other", {other_index_id, 13, 14, 15, 16}));
+  region_hits = {{300, {{1, 0.3}}}, {400, {{5, 0.1}}}, {1300, {{1, 0.15}}}, {1600, {{20, 0.05}}}};
+
+  SearchParam param;
+  param.topk = 3;
+  auto targets = TargetVectors(2);
+  std::vector<int64_t> index_ids = {kIndexId, other_index_id};
+  std::vector<MultiIndexSearchResult> results;
+
+  VectorMultiSearchTask task(*stub, index_ids, param, targets, results);
+  ASSERT_TRUE(task.Run().ok());
+
+  // every partition of both indexes is searched
+  EXPECT_EQ(SearchedRegionIds(), std::set<int64_t>({300, 400, 500, 600, 1300, 1400, 1500, 1600}));
+
+  // one global topk, hits tagged with their index
+  ASSERT_EQ(results.size(), 2);
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& hits = results[i].vector_datas;
+    ASSERT_EQ(hits.size(), 3);
+    EXPECT_EQ(hits[0].index_id, other_index_id);
+    EXPECT_EQ(hits[0].vector_with_distance.vector_data.id, 20);
+    EXPECT_FLOAT_EQ(hits[0].vector_with_distance.distance, 0.05f + i);
+    EXPECT_EQ(hits[1].index_id, kIndexId);
+    EXPECT_EQ(hits[1].vector_with_distance.vector_data.id, 5);
+    EXPECT_EQ(hits[2].index_id, other_index_id);
+    EXPECT_EQ(hits[2].vector_with_distance.vector_data.id, 1);
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, MultiIndexSearchDuplicateIndex) {
+  SearchParam param;
+  param.topk = 3;
+  auto targets = TargetVectors(1);
+  std::vector<int64_t> index_ids = {kIndexId, kIndexId};
+  std::vector<MultiIndexSearchResult> results;
+
+  VectorMultiSearchTask task(*stub, index_ids, param, targets, results);
+  EXPECT_TRUE(task.Run().IsInvalidArgument());
+  EXPECT_TRUE(search_requests.empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb